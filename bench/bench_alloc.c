@@ -0,0 +1,101 @@
+/**
+ * @file bench_alloc.c
+ * @brief glibc allocator interposition for allocation counting
+ *
+ * The executable's definitions take precedence over libc's, and forward to
+ * the __libc_* entry points glibc exports for exactly this purpose.
+ * Counters are relaxed atomics so worker threads are counted too.
+ * Sanitizer builds keep their own allocator: there the counters stay off.
+ */
+
+#include "bench_alloc.h"
+#include <stdlib.h>             /* Also defines __GLIBC__ */
+
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define BENCH_ALLOC_ASAN 1
+#endif
+#endif
+#if defined(__SANITIZE_ADDRESS__)
+#define BENCH_ALLOC_ASAN 1
+#endif
+
+#if defined(__GLIBC__) && !defined(BENCH_ALLOC_ASAN)
+
+#include <errno.h>
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t n, size_t size);
+extern void *__libc_realloc(void *p, size_t size);
+extern void *__libc_memalign(size_t align, size_t size);
+extern void __libc_free(void *p);
+
+static uint64_t g_allocs, g_frees, g_bytes;
+
+static void count_alloc(size_t bytes) {
+    __atomic_fetch_add(&g_allocs, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&g_bytes, (uint64_t)bytes, __ATOMIC_RELAXED);
+}
+
+void *malloc(size_t size) {
+    count_alloc(size);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t n, size_t size) {
+    count_alloc(n * size);
+    return __libc_calloc(n, size);
+}
+
+void *realloc(void *p, size_t size) {
+    count_alloc(size);
+    return __libc_realloc(p, size);
+}
+
+void *aligned_alloc(size_t align, size_t size) {
+    count_alloc(size);
+    return __libc_memalign(align, size);
+}
+
+void *memalign(size_t align, size_t size) {
+    count_alloc(size);
+    return __libc_memalign(align, size);
+}
+
+int posix_memalign(void **out, size_t align, size_t size) {
+    count_alloc(size);
+    void *p = __libc_memalign(align, size);
+    if (!p) return ENOMEM;
+    *out = p;
+    return 0;
+}
+
+void free(void *p) {
+    if (p) __atomic_fetch_add(&g_frees, 1, __ATOMIC_RELAXED);
+    __libc_free(p);
+}
+
+bool bench_alloc_available(void) {
+    return true;
+}
+
+bench_alloc_stats_t bench_alloc_snapshot(void) {
+    bench_alloc_stats_t s;
+    s.allocs = __atomic_load_n(&g_allocs, __ATOMIC_RELAXED);
+    s.frees = __atomic_load_n(&g_frees, __ATOMIC_RELAXED);
+    s.bytes = __atomic_load_n(&g_bytes, __ATOMIC_RELAXED);
+    return s;
+}
+
+#else
+
+bool bench_alloc_available(void) {
+    return false;
+}
+
+bench_alloc_stats_t bench_alloc_snapshot(void) {
+    bench_alloc_stats_t s = { 0, 0, 0 };
+    return s;
+}
+
+#endif
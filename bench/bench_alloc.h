@@ -0,0 +1,38 @@
+/**
+ * @file bench_alloc.h
+ * @brief Heap allocation counters for the benchmark harness
+ *
+ * On glibc the harness interposes malloc/calloc/realloc/free and the
+ * aligned allocators and counts calls and requested bytes. Elsewhere, and
+ * under AddressSanitizer, the counters stay at zero and
+ * bench_alloc_available() is false.
+ */
+
+#ifndef BENCH_ALLOC_H
+#define BENCH_ALLOC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint64_t allocs;            /* malloc/calloc/realloc/aligned calls */
+    uint64_t frees;
+    uint64_t bytes;             /* Requested bytes over all allocations */
+} bench_alloc_stats_t;
+
+bool bench_alloc_available(void);
+
+/**
+ * Snapshot of the process-wide counters (subtract two snapshots per phase)
+ */
+bench_alloc_stats_t bench_alloc_snapshot(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_ALLOC_H */
@@ -0,0 +1,6232 @@
+/**
+ * @file wwv_bench.c
+ * @brief Reference benchmark: synthetic WWV/WWVH through wwv_detector_manager
+ *
+ * Synthesizes the 50 kHz detector path and 12 kHz display path one second
+ * at a time (so hours of signal need no storage), then:
+ *   1. drives a wwv_detector_manager with the default config, timing only
+ *      the process calls, and
+ *   2. replays the same signal through each detector on its own to get
+ *      ns/sample per detector.
+ * Heap allocations are counted per phase (create / process / destroy).
+ *
+ * Results go to a JSON file for regression tracking; the detectors' own
+ * console output stays on stdout and a short summary goes to stderr.
+ *
+ * --kernel-check instead runs each compiled-in SIMD kernel of the tick
+ * matched filter against the scalar kernel and a double-precision sum,
+ * times them, runs the channel filter banks at 1-8 lanes against one
+ * scalar channel a lane (bit for bit), does the same for the int16
+ * front-end kernels (which must be exact) and the vector KissFFT stages against kiss_fft() (bit for bit
+ * unless the compiler fused the scalar code's multiply-adds), compares the
+ * int16 and float front ends, checks the baked
+ * DSP tables bit for bit against runtime generation, and exits non-zero
+ * on a mismatch.
+ *
+ * --denormal-check times a channel filter decaying into subnormals with
+ * and without the flush scope (wwv_denormal.h), then the manager on a
+ * minute of exact zeros against signal. It exits non-zero if the flushed
+ * filter still puts out a subnormal or the caller's floating-point mode
+ * leaks; the silence-over-signal cost is reported, not judged (wall
+ * clock under a loaded ctest says little).
+ *
+ * --filter-check FILE compares the runtime Butterworth design with the
+ * scipy sections in test_vectors.json, then checks the channel filters
+ * designed at 48, 50 and 62.5 kHz (-3 dB at each cutoff, lane bank equal
+ * to the scalar channel).
+ *
+ * --baseband-check runs the tick and marker detectors at 50 kHz and on the
+ * 3125 Hz baseband front end over the same signal, and exits non-zero if
+ * the event counts or tick epochs disagree; the cost of each path is
+ * reported, not judged. --baseband runs the manager with config.baseband_path.
+ *
+ * --bcd-sliding-check runs the BCD freq detector in FFT and sliding mode
+ * over the same signal, and exits non-zero if the pulses differ by more
+ * than two FFT frames; the cost of each mode is reported, not judged.
+ * --bcd-sliding runs the manager with config.bcd_freq_sliding.
+ *
+ * --goertzel-check compares the marker and BCD time band energies of the
+ * Goertzel bank with the FFT's frame by frame, then runs both detectors in
+ * each mode over the same signal, and exits non-zero if an energy strays
+ * or a marker or BCD time pulse lands on another frame; the cost of each
+ * mode is reported, not judged. --goertzel runs the manager with
+ * config.narrowband_mode = SPECTRAL_MODE_GOERTZEL.
+ *
+ * --bcd-adaptive-check drives the BCD path policy through scripted
+ * channels (strong, near the thresholds, fading, time path lost) and
+ * exits non-zero unless it idles and restores the freq path exactly where
+ * expected and never thrashes; then it idles one of two BCD freq
+ * detectors for 20 s, requires at most one of the other's FFTs in
+ * BCD_FREQ_IDLE_DECIM meanwhile, and the same pulses from both once
+ * the idled one has refilled. --bcd-adaptive runs the manager with
+ * config.bcd_adaptive.
+ *
+ * --tile-check runs the manager with 5000- and 777-sample blocks,
+ * per-sample and threaded, and exits non-zero unless all four deliver the
+ * same tick, marker and sync events in the same order; it also times the
+ * tiled block pass against config.detector_tiling off (--untiled).
+ *
+ * --consensus-check feeds wwv_consensus the wire telemetry of simulated
+ * receivers (offset sample clocks, outliers on wrong phases, corrupted
+ * bits) and exits non-zero unless the agreeing cluster's anchor and BCD
+ * time come out right; it also times a record at the source limit.
+ *
+ * --history-check runs the manager with a 150-second metric history over
+ * 200 seconds of signal and exits non-zero unless the rows
+ * hold the ticks the callback saw, second by second, the expected tick
+ * holes near seconds without a tick, and a value every second for the sampled metrics; then it
+ * closes and reopens a mapped history file and requires the earlier run's
+ * rows back at negative times. Record and 24-hour aggregate costs are
+ * printed.
+ *
+ * --binlog-check runs the manager with its logs as text CSV, then as LZ4
+ * binary logs (both in binlog_check.d, removed after), and exits non-zero unless every binary log converts back
+ * to as many rows as the text run wrote and the binary logs are much
+ * smaller; it then requires the same rows written to a text and a binary
+ * stream to convert back byte for byte, and a stream rotated every second
+ * to come back as one file per second with its header and its rows.
+ *
+ * --trace-check runs a threaded manager with its CSV logs (in
+ * trace_check.d, removed after) under a wwv_trace session and exits non-zero unless the trace file is complete
+ * JSON with every detector's frame spans (the tick frames one per frame,
+ * in sample order), the manager block spans, log writer spans and the
+ * worker thread names; in a build without WWV_TRACE it only requires
+ * that tracing refuses to start. --trace FILE traces the manager pass.
+ *
+ * --rt-check runs a threaded manager plain, then pinned to CPUs, at
+ * SCHED_FIFO, memory-locked and prefaulted, and exits non-zero unless the
+ * events are identical, the prefaulted bytes cover the detector buffers
+ * and the reported affinity and locking match what the OS shows (a
+ * refused priority is reported, not failed). The first second of each
+ * pass is timed.
+ *
+ * --marker-template-check runs the manager with the sliding-window marker
+ * and then config.marker_template over the same broadcasts, started at
+ * fractions of a second into the minute, and exits non-zero unless both
+ * report every minute marker and nothing else, and the template places
+ * each onset within a fraction of a frame of the broadcast's. The block
+ * pass of each config is timed. --marker-template runs the manager with
+ * config.marker_template.
+ *
+ * --carrier-check mixes a tone through carrier_nco in blocks of odd sizes
+ * against a double-precision reference, then runs the manager on a
+ * broadcast with a carrier offset, uncorrected and with
+ * config.carrier_correction, and on one outside the trusted range. It
+ * exits non-zero unless the mixer holds phase and amplitude, the
+ * correction locks onto the offset and detects as many ticks and markers
+ * as the broadcast without an offset, and the out-of-range offset is
+ * refused. The mixer and both manager passes are timed.
+ * --carrier-correction runs the manager with it.
+ *
+ * --duty-check runs the manager on a long broadcast with
+ * config.duty_cycle and without, then with the station off (noise only)
+ * from the first wake through the next two minute markers. It exits
+ * non-zero unless the clean run sleeps and verifies every wake without
+ * widening, detects the markers it is awake for, and is awake for under
+ * a tenth of the seconds after its first sleep (the cost against the
+ * full run is reported), and unless the outage widens, reacquires and
+ * sleeps again after the station returns. --duty-cycle runs the manager
+ * with it.
+ *
+ * --refclock-check checks the Unix time of BCD dates, then runs a
+ * threaded manager with a refclock on a chrony SOCK socket of its own
+ * and exits non-zero unless every push is stamped with its last sample
+ * and a host time read within the push (not when the worker got to it),
+ * an int16 block is stamped once and per-sample feeding once a tile,
+ * nothing is published without a BCD time, and a sample published from
+ * the run's stamp arrives with its time, offset and leap indicator.
+ *
+ * --telem-check has several threads send numbered lines through a started
+ * telemetry sender to a loopback socket and exits non-zero unless each
+ * arrives exactly once and is counted sent; then it overfills a parked
+ * sender's queue and requires the overflow counted as dropped. Last, a
+ * manager fed sample by sample sends binary tick records to the socket;
+ * half way through each second none may still be waiting for a flush.
+ *
+ * --bcd-integrate-check feeds the multi-minute BCD integration the pulses
+ * the BCD detectors would report off a weak broadcast running 23:56 to
+ * 00:05 across a day boundary, and exits non-zero unless an eight-minute
+ * ring decodes the true time and minute start of all but at most one
+ * minute once full and never accepts a wrong one, while a one-minute ring
+ * never decodes a right time from the same pulses.
+ *
+ * --tick-sdft-check runs the tick matched filter's sliding DFT and its
+ * reference MAC side by side on the same samples and exits non-zero if
+ * they differ by more than a small fraction of the tick peak, on any
+ * sample or on either side of the sliding DFT's periodic re-seeds.
+ *
+ * --timebase-check runs a tick detector on a broadcast twice, skipping
+ * its sample clock six hours further ahead the second time, and exits
+ * non-zero unless every tick after the skip lands exactly six hours after
+ * its twin, in both its sample index and its millisecond timestamp (a
+ * float timestamp that far out only resolves 2 ms).
+ *
+ * --percentile-check pushes random values (with runs of repeats) through
+ * running percentile trackers of several windows and percentiles, and
+ * exits non-zero unless after every push each reports the element a full
+ * sort of its window would, including while filling and after a reset.
+ *
+ * --window-ring-check checks the mirrored window ring against a plain
+ * history under random pushes and block writes, then feeds the tick,
+ * marker and both BCD detectors the same broadcast per sample and in
+ * blocks of several sizes (frame-aligned, so every FFT frame is read in
+ * place, and not) and exits non-zero unless every feeding reports the
+ * same events.
+ *
+ * --tone-zoom-check measures a broadcast's carrier offset with tone
+ * trackers at the default hop and at 75% overlap, with and without the
+ * adaptive zoom FFT, and exits non-zero unless the overlapped tracker
+ * reports four times as often a hop apart, the zoom tracker locks and
+ * then measures the offset as closely as the full FFT, and an outage of
+ * the carrier drops it back to the full FFT.
+ *
+ * --zoom-dft-check compares the narrow-band DFT with the FFT at its bin
+ * centres, then measures a clean off-bin 500 Hz tone and an off-bin
+ * carrier with tone trackers with and without fine refinement (and the
+ * carrier also zoomed), and exits non-zero unless the magnitudes agree
+ * and every refined tracker is within a few millihertz and well inside
+ * the parabolic estimate's error.
+ *
+ * --sliding-sum-check pushes millions of bursty frame energies through a
+ * sliding sum with three windows, and exits non-zero unless every window's
+ * sum, count and mean stay within float rounding of an exact sum of its
+ * values, across renormalizations and a reset (the drift of a plain float
+ * running sum on the same stream is reported).
+ *
+ * --cache-layout-check checks that zeroed aligned blocks come back zeroed
+ * and cache-aligned whatever was freed before them, then runs a heap-built
+ * manager and one built in a deliberately misaligned caller block, and
+ * exits non-zero unless every detector's hot / warm / cold state starts
+ * on a cache line in both and both report the same events.
+ *
+ * --bcd-solver-check feeds the soft-decision BCD time solver symbol
+ * log-likelihoods made from the synth's frames, 23:52 to 00:07 across a
+ * day boundary, and exits non-zero unless weak noisy frames solve the true
+ * time and minute start within BCD_SOLVER_MAX_FRAMES minutes (also after
+ * midnight) while no single one does, a strong frame with an illegal
+ * minute digit still gives the true time, and a frame numbered one second
+ * off never gives a solution.
+ *
+ * --params-check sets detector tunables by name and exits non-zero unless
+ * a setting is staged (read back at once, live in the detector only from
+ * its next block), a batch with one out-of-range value changes nothing,
+ * batches and settings published twice before a block all land together,
+ * and a threaded manager retuned from a control thread while samples flow
+ * only ever runs with whole batches and ends on the last one.
+ *
+ * --corr-history-check feeds a tick correlator with small history rings
+ * scripted chains of known lengths, far more than the rings hold, and
+ * exits non-zero unless the rings stay at their configured size, the
+ * newest chains and tick records read back exactly, evicted chains read
+ * back zeroed, and the longest chains of the whole run are still ranked
+ * after leaving the ring.
+ *
+ * --channel-quality-check runs the shared display spectrum with and
+ * without a channel-quality estimate on clean, weak, fading and two-path
+ * broadcasts, and exits non-zero unless the trackers' SNRs are the same
+ * either way, the estimate's SNR drops with the broadcast's, its fade rate
+ * finds the synth's, and fading and a second path widen its fade depth and
+ * Doppler spread.
+ */
+
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE     /* clock_gettime(CLOCK_MONOTONIC) under -std=c11 */
+#endif
+
+#include "wwv_synth.h"
+#include "bench_alloc.h"
+#include "wwv_detector_manager.h"
+#include "wwv_iq_file.h"
+#include "wwv_state.h"
+#include "tick_detector.h"
+#include "marker_detector.h"
+#include "bcd_time_detector.h"
+#include "bcd_freq_detector.h"
+#include "bcd_time_solver.h"
+#include "bcd_path_policy.h"
+#include "tone_tracker.h"
+#include "channel_quality.h"
+#include "running_percentile.h"
+#include "wwv_window_ring.h"
+#include "zoom_dft.h"
+#include "sliding_sum.h"
+#include "channel_filters.h"
+#include "fft_processor.h"
+#include "goertzel_bank.h"
+#include "wwv_denormal.h"
+#include "version.h"
+#include "detection/tick_corr_internal.h"
+#include "detection/tick_internal.h"
+#include "manager/wwv_detector_manager_internal.h"
+#include "correlation/bcd_correlator_internal.h"
+#include "correlation/tick_correlator_internal.h"
+#include "signal/polyphase_internal.h"
+#include "sdr_frontend.h"
+#include "baseband_frontend.h"
+#include "carrier_nco.h"
+#include "core/dsp_tables.h"
+#include "core/fft_backend_internal.h"
+#include "wwv_consensus.h"
+#include "wwv_history.h"
+#include "wwv_csv_log.h"
+#include "wwv_trace.h"
+#include "wwv_thread.h"
+#include "telemetry.h"
+#include "telemetry_wire.h"
+#include <math.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <direct.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+#include <errno.h>
+
+#define BENCH_DETECTOR_RATE     50000
+#define BENCH_DISPLAY_RATE      12000
+#define BENCH_MAX_DETECTORS     9
+
+/*============================================================================
+ * Options
+ *============================================================================*/
+
+/*
+ * The --*-check modes: each runs one self-contained check instead of the
+ * bench and exits non-zero if it fails. The table sits next to main().
+ */
+typedef struct {
+    const char *option;
+    const char *help;
+    bool (*run)(void);
+} bench_check_t;
+
+static const bench_check_t *find_check(const char *option);
+static void usage_checks(void);
+
+typedef struct {
+    double seconds;
+    wwv_synth_config_t synth;
+    size_t block;               /* Samples per process call, 0 = per-sample API */
+    const char *log_dir;        /* Manager CSV logs, NULL = none */
+    const char *record_path;    /* Detector-path WAV for wwv_replay, NULL = none */
+    const char *json_path;
+    const char *trace_path;     /* Trace the manager pass (WWV_TRACE builds), NULL = none */
+    const char *label;
+    bool detectors;             /* Run the per-detector pass */
+    bool arena;                 /* Build the manager in a caller arena */
+    const bench_check_t *check; /* Check to run instead, NULL = none */
+    const char *filter_vectors; /* test_vectors.json for the filter check, NULL = none */
+    bool dual;                  /* WWVH mixed in, dual-station tick detection */
+    bool economy;               /* Manager config.tick_economy */
+    bool baseband;              /* Manager config.baseband_path */
+    bool bcd_sliding;           /* Manager config.bcd_freq_sliding */
+    bool goertzel;              /* Manager config.narrowband_mode Goertzel */
+    bool bcd_adaptive;          /* Manager config.bcd_adaptive */
+    bool marker_template;       /* Manager config.marker_template */
+    bool carrier_correction;    /* Manager config.carrier_correction */
+    bool duty_cycle;            /* Manager config.duty_cycle */
+    bool untiled;               /* Manager config.detector_tiling off */
+    double warm_start;          /* Restart the manager from a snapshot here, 0 = never */
+    bool batch_events;          /* Deliver events through the batch callback */
+} bench_options_t;
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --seconds N       Signal length (default 600)\n"
+            "  --station S       wwv | wwvh | both (default wwv)\n"
+            "  --snr DB          Carrier SNR in 10 kHz (default 30)\n"
+            "  --doppler HZ      Carrier offset (default 0)\n"
+            "  --fade-rate HZ    Fade cycle rate (default 0 = none)\n"
+            "  --fade-depth DB   Fade depth (default 0)\n"
+            "  --seed N          Noise seed (default 1)\n"
+            "  --block N         Samples per block call, 0 = per-sample (default 5000)\n"
+            "  --log-dir DIR     Write manager CSV logs to DIR (default: none)\n"
+            "  --record FILE     Save the 50 kHz detector path as a cf32 WAV\n"
+            "  --json FILE       Results file, - for stdout (default bench_results.json)\n"
+            "  --trace FILE      Trace the manager pass as Chrome / Perfetto JSON\n"
+            "  --label TEXT      Run label stored in the results\n"
+            "  --no-detectors    Skip the per-detector pass\n"
+            "  --arena           Build the manager with create_in() from one block\n"
+            "  --economy         Tick detector economy mode once sync is LOCKED\n"
+            "  --baseband        Tick and marker on the 3125 Hz baseband front end\n"
+            "  --bcd-sliding     BCD freq detector on its sliding DFT (0.64 ms steps)\n"
+            "  --goertzel        Marker and BCD time detectors on the Goertzel bank\n"
+            "  --bcd-adaptive    Idle the BCD freq detector while the channel is strong\n"
+            "  --marker-template Template-correlated minute marker (no slow marker path)\n"
+            "  --carrier-correction Remove the tracked carrier offset from the detector path\n"
+            "  --duty-cycle      Sleep the DSP between verified minute markers once locked\n"
+            "  --untiled         Each detector streams the whole block (no tile scheduler)\n"
+            "  --warm-start SEC  Snapshot, recreate and restore the manager after SEC seconds\n"
+            "  --batch-events    Deliver events in per-call batches and check them against the counts\n"
+            "  --filter-check F  Check the Butterworth design against test vectors F, then exit\n",
+            argv0);
+    usage_checks();
+}
+
+static bool parse_options(int argc, char **argv, bench_options_t *opt) {
+    wwv_synth_config_t synth = WWV_SYNTH_CONFIG_DEFAULT;
+    opt->seconds = 600.0;
+    opt->synth = synth;
+    opt->block = 5000;
+    opt->log_dir = NULL;
+    opt->record_path = NULL;
+    opt->json_path = "bench_results.json";
+    opt->trace_path = NULL;
+    opt->label = "";
+    opt->detectors = true;
+    opt->arena = false;
+    opt->check = NULL;
+    opt->filter_vectors = NULL;
+    opt->dual = false;
+    opt->economy = false;
+    opt->baseband = false;
+    opt->bcd_sliding = false;
+    opt->goertzel = false;
+    opt->bcd_adaptive = false;
+    opt->marker_template = false;
+    opt->carrier_correction = false;
+    opt->duty_cycle = false;
+    opt->untiled = false;
+    opt->batch_events = false;
+    opt->warm_start = 0.0;
+
+    for (int a = 1; a < argc; a++) {
+        const char *arg = argv[a];
+        const char *val = (a + 1 < argc) ? argv[a + 1] : NULL;
+
+        if (strcmp(arg, "--no-detectors") == 0) { opt->detectors = false; continue; }
+        if (strcmp(arg, "--arena") == 0) { opt->arena = true; continue; }
+        if (strcmp(arg, "--economy") == 0) { opt->economy = true; continue; }
+        if (strcmp(arg, "--baseband") == 0) { opt->baseband = true; continue; }
+        if (strcmp(arg, "--bcd-sliding") == 0) { opt->bcd_sliding = true; continue; }
+        if (strcmp(arg, "--goertzel") == 0) { opt->goertzel = true; continue; }
+        if (strcmp(arg, "--bcd-adaptive") == 0) { opt->bcd_adaptive = true; continue; }
+        if (strcmp(arg, "--marker-template") == 0) { opt->marker_template = true; continue; }
+        if (strcmp(arg, "--carrier-correction") == 0) { opt->carrier_correction = true; continue; }
+        if (strcmp(arg, "--duty-cycle") == 0) { opt->duty_cycle = true; continue; }
+        if (strcmp(arg, "--untiled") == 0) { opt->untiled = true; continue; }
+        if (strcmp(arg, "--batch-events") == 0) { opt->batch_events = true; continue; }
+        if ((opt->check = find_check(arg)) != NULL) continue;
+        if (!val) {
+            usage(argv[0]);
+            return false;
+        }
+
+        if (strcmp(arg, "--seconds") == 0) opt->seconds = atof(val);
+        else if (strcmp(arg, "--station") == 0) {
+            opt->synth.station = (strcmp(val, "wwvh") == 0) ? WWV_SYNTH_WWVH : WWV_SYNTH_WWV;
+            opt->dual = (strcmp(val, "both") == 0);
+        }
+        else if (strcmp(arg, "--snr") == 0) opt->synth.snr_db = (float)atof(val);
+        else if (strcmp(arg, "--doppler") == 0) opt->synth.doppler_hz = (float)atof(val);
+        else if (strcmp(arg, "--fade-rate") == 0) opt->synth.fade_rate_hz = (float)atof(val);
+        else if (strcmp(arg, "--fade-depth") == 0) opt->synth.fade_depth_db = (float)atof(val);
+        else if (strcmp(arg, "--seed") == 0) opt->synth.seed = strtoull(val, NULL, 10);
+        else if (strcmp(arg, "--block") == 0) opt->block = (size_t)atol(val);
+        else if (strcmp(arg, "--log-dir") == 0) opt->log_dir = val;
+        else if (strcmp(arg, "--record") == 0) opt->record_path = val;
+        else if (strcmp(arg, "--json") == 0) opt->json_path = val;
+        else if (strcmp(arg, "--trace") == 0) opt->trace_path = val;
+        else if (strcmp(arg, "--label") == 0) opt->label = val;
+        else if (strcmp(arg, "--warm-start") == 0) opt->warm_start = atof(val);
+        else if (strcmp(arg, "--filter-check") == 0) opt->filter_vectors = val;
+        else {
+            usage(argv[0]);
+            return false;
+        }
+        a++;
+    }
+
+    if (opt->seconds <= 0.0 || opt->block > BENCH_DETECTOR_RATE) {
+        usage(argv[0]);
+        return false;
+    }
+    return true;
+}
+
+/*============================================================================
+ * Timing
+ *============================================================================*/
+
+static uint64_t bench_now_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+    if (!freq.QuadPart) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (uint64_t)((double)now.QuadPart * 1e9 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static void bench_sleep_ms(unsigned ms) {
+#ifdef _WIN32
+    Sleep(ms);
+#else
+    struct timespec ts = { (time_t)(ms / 1000), (long)(ms % 1000) * 1000000L };
+    nanosleep(&ts, NULL);
+#endif
+}
+
+static bench_alloc_stats_t alloc_delta(bench_alloc_stats_t a, bench_alloc_stats_t b) {
+    bench_alloc_stats_t d = { b.allocs - a.allocs, b.frees - a.frees, b.bytes - a.bytes };
+    return d;
+}
+
+/*============================================================================
+ * Signal Source
+ *============================================================================*/
+
+/* Mixed-in WWVH: 14 dB down and 12 ms behind WWV, noise from WWV only */
+#define BENCH_WWVH_LEVEL        0.2f
+#define BENCH_WWVH_DELAY_SEC    0.012
+
+typedef struct {
+    wwv_synth_t *det_synth;
+    wwv_synth_t *disp_synth;
+    wwv_synth_t *det_wwvh;      /* NULL unless --station both */
+    wwv_synth_t *disp_wwvh;
+    float *det_i, *det_q;       /* One second per path */
+    float *disp_i, *disp_q;
+    float *mix_i, *mix_q;       /* WWVH scratch, one detector-path second */
+    uint64_t gen_ns;
+} bench_source_t;
+
+/*
+ * WWVH a little later in broadcast time: one minute earlier in the frame
+ * so the offset stays positive (the synth starts at t >= 0)
+ */
+static wwv_synth_config_t wwvh_config(const wwv_synth_config_t *base) {
+    wwv_synth_config_t cfg = *base;
+    cfg.station = WWV_SYNTH_WWVH;
+    cfg.carrier_amplitude = base->carrier_amplitude * BENCH_WWVH_LEVEL;
+    cfg.snr_db = 200.0f;
+    cfg.start_offset_sec = base->start_offset_sec + 60.0 - BENCH_WWVH_DELAY_SEC;
+    cfg.start_minute = (base->start_minute + 59) % 60;
+    return cfg;
+}
+
+static bool source_open(bench_source_t *src, const wwv_synth_config_t *base, bool dual) {
+    memset(src, 0, sizeof(*src));
+
+    wwv_synth_config_t cfg = *base;
+    cfg.sample_rate = BENCH_DETECTOR_RATE;
+    src->det_synth = wwv_synth_create(&cfg);
+
+    cfg.sample_rate = BENCH_DISPLAY_RATE;
+    cfg.seed = base->seed + 1;
+    src->disp_synth = wwv_synth_create(&cfg);
+
+    src->det_i = malloc(BENCH_DETECTOR_RATE * sizeof(float));
+    src->det_q = malloc(BENCH_DETECTOR_RATE * sizeof(float));
+    src->disp_i = malloc(BENCH_DISPLAY_RATE * sizeof(float));
+    src->disp_q = malloc(BENCH_DISPLAY_RATE * sizeof(float));
+    bool ok = src->det_synth && src->disp_synth && src->det_i && src->det_q &&
+              src->disp_i && src->disp_q;
+    if (!dual) return ok;
+
+    cfg = wwvh_config(base);
+    cfg.sample_rate = BENCH_DETECTOR_RATE;
+    src->det_wwvh = wwv_synth_create(&cfg);
+    cfg.sample_rate = BENCH_DISPLAY_RATE;
+    src->disp_wwvh = wwv_synth_create(&cfg);
+    src->mix_i = malloc(BENCH_DETECTOR_RATE * sizeof(float));
+    src->mix_q = malloc(BENCH_DETECTOR_RATE * sizeof(float));
+    return ok && src->det_wwvh && src->disp_wwvh && src->mix_i && src->mix_q;
+}
+
+static void source_close(bench_source_t *src) {
+    wwv_synth_destroy(src->det_synth);
+    wwv_synth_destroy(src->disp_synth);
+    wwv_synth_destroy(src->det_wwvh);
+    wwv_synth_destroy(src->disp_wwvh);
+    free(src->det_i);
+    free(src->det_q);
+    free(src->disp_i);
+    free(src->disp_q);
+    free(src->mix_i);
+    free(src->mix_q);
+}
+
+static void source_mix(wwv_synth_t *synth, float *mix_i, float *mix_q,
+                       float *i, float *q, size_t n) {
+    wwv_synth_generate(synth, mix_i, mix_q, n);
+    for (size_t k = 0; k < n; k++) {
+        i[k] += mix_i[k];
+        q[k] += mix_q[k];
+    }
+}
+
+/**
+ * Next second of both paths (the last one may be partial)
+ */
+static void source_next(bench_source_t *src, double fraction, size_t *det_n, size_t *disp_n) {
+    uint64_t t0 = bench_now_ns();
+    *det_n = (size_t)(BENCH_DETECTOR_RATE * fraction + 0.5);
+    *disp_n = (size_t)(BENCH_DISPLAY_RATE * fraction + 0.5);
+    wwv_synth_generate(src->det_synth, src->det_i, src->det_q, *det_n);
+    wwv_synth_generate(src->disp_synth, src->disp_i, src->disp_q, *disp_n);
+    if (src->det_wwvh) {
+        source_mix(src->det_wwvh, src->mix_i, src->mix_q, src->det_i, src->det_q, *det_n);
+        source_mix(src->disp_wwvh, src->mix_i, src->mix_q, src->disp_i, src->disp_q, *disp_n);
+    }
+    src->gen_ns += bench_now_ns() - t0;
+}
+
+/*============================================================================
+ * Manager Pass
+ *============================================================================*/
+
+typedef struct {
+    uint64_t ns;
+    uint64_t det_samples, disp_samples;
+    bench_alloc_stats_t alloc_create, alloc_process, alloc_destroy;
+    int ticks, markers;
+    int wwvh_ticks;             /* Dual-station runs only */
+    uint64_t tick_skipped;      /* Tick frames economy mode skipped */
+    wwv_sync_status_t sync;
+    wwv_perf_stats_t perf;
+    size_t arena_bytes;         /* 0 = heap-built manager */
+    uint64_t gen_ns;
+    double lock_sec;            /* Signal time sync first reached LOCKED, -1 = never */
+    double relock_sec;          /* ...after the warm start, -1 = never */
+    size_t state_bytes;         /* Warm-start snapshot size */
+    bool restored;
+    uint64_t batches;           /* --batch-events: batch callbacks */
+    int batch_ticks, batch_markers, batch_syncs;
+    uint64_t batch_dropped;
+} manager_result_t;
+
+#define BENCH_BATCH_CAPACITY    64
+
+/* One batch per processing call */
+static void on_event_batch(const wwv_event_batch_t *batch, void *user_data) {
+    manager_result_t *res = (manager_result_t *)user_data;
+    res->batches++;
+    res->batch_ticks += batch->tick_count;
+    res->batch_markers += batch->marker_count;
+    res->batch_syncs += batch->sync_count;
+    res->batch_dropped += batch->dropped;
+}
+
+static void attach_batches(wwv_detector_manager_t *mgr, manager_result_t *res) {
+    static wwv_tick_event_t ticks[BENCH_BATCH_CAPACITY];
+    static wwv_marker_event_t markers[BENCH_BATCH_CAPACITY];
+    static wwv_sync_status_t syncs[BENCH_BATCH_CAPACITY];
+    wwv_event_buffers_t buffers = {
+        .ticks = ticks, .tick_capacity = BENCH_BATCH_CAPACITY,
+        .markers = markers, .marker_capacity = BENCH_BATCH_CAPACITY,
+        .syncs = syncs, .sync_capacity = BENCH_BATCH_CAPACITY
+    };
+    wwv_detector_manager_set_event_buffers(mgr, &buffers);
+    wwv_detector_manager_set_batch_callback(mgr, on_event_batch, res);
+}
+
+static void feed_manager(wwv_detector_manager_t *mgr, const bench_options_t *opt,
+                         const bench_source_t *src, size_t det_n, size_t disp_n) {
+    if (opt->block == 0) {
+        for (size_t k = 0; k < det_n; k++) {
+            wwv_detector_manager_process_detector_sample(mgr, src->det_i[k], src->det_q[k]);
+        }
+        for (size_t k = 0; k < disp_n; k++) {
+            wwv_detector_manager_process_display_sample(mgr, src->disp_i[k], src->disp_q[k]);
+        }
+        return;
+    }
+
+    for (size_t k = 0; k < det_n; k += opt->block) {
+        size_t n = (det_n - k < opt->block) ? det_n - k : opt->block;
+        wwv_detector_manager_process_detector_block(mgr, src->det_i + k, src->det_q + k, n);
+    }
+    size_t disp_block = opt->block * BENCH_DISPLAY_RATE / BENCH_DETECTOR_RATE;
+    if (disp_block == 0) disp_block = 1;
+    for (size_t k = 0; k < disp_n; k += disp_block) {
+        size_t n = (disp_n - k < disp_block) ? disp_n - k : disp_block;
+        wwv_detector_manager_process_display_block(mgr, src->disp_i + k, src->disp_q + k, n);
+    }
+}
+
+/*
+ * The checks' manager passes: one manager over `seconds` of a synthetic
+ * broadcast, a second at a time. A threaded manager gets each second
+ * pushed in `block`-sample pieces, then is flushed and its events
+ * dispatched; others go through feed_manager() (block 0 = per sample).
+ * Any hook may be NULL.
+ */
+typedef struct {
+    wwv_synth_config_t synth;
+    wwv_detector_config_t config;
+    int seconds;
+    size_t block;
+    void *arena;                /* create_in() from arena_bytes here, NULL = heap */
+    size_t arena_bytes;
+    void *user;
+    /* Once created; false fails the pass */
+    bool (*setup)(wwv_detector_manager_t *mgr, void *user);
+    /* Each second before it is fed; may rewrite the samples */
+    void (*prepare)(wwv_detector_manager_t *mgr, bench_source_t *src, int sec,
+                    size_t det_n, size_t disp_n, void *user);
+    /* Feeds the second in place of the above */
+    void (*feed)(wwv_detector_manager_t *mgr, const bench_source_t *src,
+                 size_t det_n, size_t disp_n, void *user);
+    /* Each second once fed, with the time feeding it took */
+    void (*fed)(wwv_detector_manager_t *mgr, int sec, uint64_t ns, void *user);
+    /* Before the manager is destroyed; false fails the pass */
+    bool (*finish)(wwv_detector_manager_t *mgr, void *user);
+} manager_pass_t;
+
+/* Default broadcast and manager (no logs), 5000-sample blocks */
+static void manager_pass_init(manager_pass_t *pass, int seconds) {
+    memset(pass, 0, sizeof(*pass));
+    pass->synth = (wwv_synth_config_t)WWV_SYNTH_CONFIG_DEFAULT;
+    pass->config = (wwv_detector_config_t)WWV_DETECTOR_CONFIG_DEFAULT;
+    pass->config.output_dir = NULL;
+    pass->seconds = seconds;
+    pass->block = 5000;
+}
+
+static void push_manager(wwv_detector_manager_t *mgr, const bench_source_t *src,
+                         size_t det_n, size_t disp_n, size_t block) {
+    for (size_t k = 0; k < det_n; k += block) {
+        size_t n = (det_n - k < block) ? det_n - k : block;
+        wwv_detector_manager_push_detector_block(mgr, src->det_i + k, src->det_q + k, n);
+    }
+    wwv_detector_manager_push_display_block(mgr, src->disp_i, src->disp_q, disp_n);
+    /* Keep the rings from overrunning; events go out in queue order */
+    wwv_detector_manager_flush(mgr);
+    wwv_detector_manager_dispatch_events(mgr);
+}
+
+/* ns (may be NULL) is the time spent feeding */
+static bool manager_pass(const manager_pass_t *pass, uint64_t *ns) {
+    bench_source_t src;
+    if (!source_open(&src, &pass->synth, false)) {
+        source_close(&src);
+        return false;
+    }
+    wwv_detector_manager_t *mgr = pass->arena ?
+        wwv_detector_manager_create_in(&pass->config, pass->arena, pass->arena_bytes) :
+        wwv_detector_manager_create(&pass->config);
+    if (!mgr || (pass->setup && !pass->setup(mgr, pass->user))) {
+        wwv_detector_manager_destroy(mgr);
+        source_close(&src);
+        return false;
+    }
+
+    bench_options_t opt;
+    memset(&opt, 0, sizeof(opt));
+    opt.block = pass->block;
+    bool threaded = wwv_detector_manager_is_threaded(mgr);
+    uint64_t total = 0;
+    for (int sec = 0; sec < pass->seconds; sec++) {
+        size_t det_n, disp_n;
+        source_next(&src, 1.0, &det_n, &disp_n);
+        if (pass->prepare) pass->prepare(mgr, &src, sec, det_n, disp_n, pass->user);
+        uint64_t t0 = bench_now_ns();
+        if (pass->feed) pass->feed(mgr, &src, det_n, disp_n, pass->user);
+        else if (threaded) push_manager(mgr, &src, det_n, disp_n, pass->block);
+        else feed_manager(mgr, &opt, &src, det_n, disp_n);
+        uint64_t dt = bench_now_ns() - t0;
+        total += dt;
+        if (pass->fed) pass->fed(mgr, sec, dt, pass->user);
+    }
+    bool ok = !pass->finish || pass->finish(mgr, pass->user);
+    wwv_detector_manager_destroy(mgr);
+    source_close(&src);
+    if (ns) *ns = total;
+    return ok;
+}
+
+static wwv_detector_manager_t *create_manager(const wwv_detector_config_t *config, void *arena,
+                                              size_t arena_bytes) {
+    return arena ? wwv_detector_manager_create_in(config, arena, arena_bytes)
+                 : wwv_detector_manager_create(config);
+}
+
+/* Snapshot, destroy, recreate and restore, as a process restart would */
+static wwv_detector_manager_t *warm_restart(wwv_detector_manager_t *mgr,
+                                            const wwv_detector_config_t *config,
+                                            void *arena, manager_result_t *res) {
+    static unsigned char blob[WWV_STATE_MAX_BYTES];
+    res->state_bytes = wwv_detector_manager_save_state(mgr, blob, sizeof(blob));
+    wwv_detector_manager_destroy(mgr);
+
+    mgr = create_manager(config, arena, res->arena_bytes);
+    if (mgr) res->restored = wwv_detector_manager_restore_state(mgr, blob, res->state_bytes);
+    return mgr;
+}
+
+static bool run_manager(const bench_options_t *opt, manager_result_t *res) {
+    memset(res, 0, sizeof(*res));
+    res->lock_sec = -1.0;
+    res->relock_sec = -1.0;
+
+    bench_source_t src;
+    if (!source_open(&src, &opt->synth, opt->dual)) {
+        source_close(&src);
+        return false;
+    }
+
+    wwv_detector_config_t config = WWV_DETECTOR_CONFIG_DEFAULT;
+    config.output_dir = opt->log_dir;
+    config.dual_station = opt->dual;
+    config.tick_economy = opt->economy;
+    config.baseband_path = opt->baseband;
+    config.bcd_freq_sliding = opt->bcd_sliding;
+    if (opt->goertzel) config.narrowband_mode = SPECTRAL_MODE_GOERTZEL;
+    config.bcd_adaptive = opt->bcd_adaptive;
+    config.marker_template = opt->marker_template;
+    config.carrier_correction = opt->carrier_correction;
+    config.duty_cycle = opt->duty_cycle;
+    config.detector_tiling = !opt->untiled;
+
+    /* Sizing and the block itself are outside the create counters */
+    void *arena = NULL;
+    if (opt->arena) {
+        res->arena_bytes = wwv_detector_manager_required_size(&config);
+        arena = res->arena_bytes ? malloc(res->arena_bytes) : NULL;
+        if (!arena) {
+            source_close(&src);
+            return false;
+        }
+    }
+
+    wwv_iq_wav_writer_t *record = NULL;
+    if (opt->record_path) {
+        record = wwv_iq_wav_create(opt->record_path, BENCH_DETECTOR_RATE, WWV_IQ_CF32);
+        if (!record) {
+            free(arena);
+            source_close(&src);
+            return false;
+        }
+    }
+
+    bench_alloc_stats_t a0 = bench_alloc_snapshot();
+    wwv_detector_manager_t *mgr = create_manager(&config, arena, res->arena_bytes);
+    bench_alloc_stats_t a1 = bench_alloc_snapshot();
+    if (!mgr) {
+        wwv_iq_wav_close(record);
+        free(arena);
+        source_close(&src);
+        return false;
+    }
+
+    if (opt->batch_events) attach_batches(mgr, res);
+
+    bench_alloc_stats_t proc = { 0, 0, 0 };
+    bool restarted = false;
+    for (double done = 0.0; done < opt->seconds; done += 1.0) {
+        double fraction = (opt->seconds - done < 1.0) ? opt->seconds - done : 1.0;
+        size_t det_n, disp_n;
+        source_next(&src, fraction, &det_n, &disp_n);
+
+        if (!restarted && opt->warm_start > 0.0 && done >= opt->warm_start) {
+            restarted = true;
+            mgr = warm_restart(mgr, &config, arena, res);
+            if (!mgr) {
+                wwv_iq_wav_close(record);
+                free(arena);
+                source_close(&src);
+                return false;
+            }
+            if (opt->batch_events) attach_batches(mgr, res);
+        }
+        if (record) wwv_iq_wav_write(record, src.det_i, src.det_q, det_n);
+
+        bench_alloc_stats_t p0 = bench_alloc_snapshot();
+        uint64_t t0 = bench_now_ns();
+        feed_manager(mgr, opt, &src, det_n, disp_n);
+        res->ns += bench_now_ns() - t0;
+        bench_alloc_stats_t d = alloc_delta(p0, bench_alloc_snapshot());
+        proc.allocs += d.allocs;
+        proc.frees += d.frees;
+        proc.bytes += d.bytes;
+
+        res->det_samples += det_n;
+        res->disp_samples += disp_n;
+
+        if (wwv_detector_manager_get_sync_status(mgr).is_synced) {
+            if (res->lock_sec < 0.0) res->lock_sec = done + fraction;
+            if (restarted && res->relock_sec < 0.0) res->relock_sec = done + fraction - opt->warm_start;
+        }
+    }
+
+    res->ticks = wwv_detector_manager_get_tick_count(mgr);
+    res->markers = wwv_detector_manager_get_marker_count(mgr);
+    res->wwvh_ticks = wwv_detector_manager_get_station_tick_count(mgr, WWV_STATION_WWVH);
+    res->tick_skipped = wwv_detector_manager_get_tick_skipped_frames(mgr);
+    res->sync = wwv_detector_manager_get_sync_status(mgr);
+    wwv_detector_manager_get_perf(mgr, &res->perf);
+
+    bench_alloc_stats_t a2 = bench_alloc_snapshot();
+    wwv_detector_manager_destroy(mgr);
+    bench_alloc_stats_t a3 = bench_alloc_snapshot();
+    free(arena);
+
+    if (record && !wwv_iq_wav_close(record)) {
+        fprintf(stderr, "[BENCH] failed to write %s\n", opt->record_path);
+    }
+
+    res->alloc_create = alloc_delta(a0, a1);
+    res->alloc_process = proc;
+    res->alloc_destroy = alloc_delta(a2, a3);
+    res->gen_ns = src.gen_ns;
+
+    source_close(&src);
+    return true;
+}
+
+/*============================================================================
+ * Per-Detector Pass
+ *============================================================================*/
+
+typedef void (*bench_process_fn)(void *obj, const float *i, const float *q, size_t n);
+typedef void (*bench_destroy_fn)(void *obj);
+
+typedef struct {
+    const char *name;
+    bool display_path;          /* 12 kHz display path, else 50 kHz detector path */
+    void *obj;
+    bench_process_fn process;
+    bench_destroy_fn destroy;
+    uint64_t ns;
+    uint64_t samples;
+    bench_alloc_stats_t alloc_process;
+} bench_detector_t;
+
+static void proc_tick(void *o, const float *i, const float *q, size_t n) {
+    tick_detector_process_block((tick_detector_t *)o, i, q, n);
+}
+static void proc_marker(void *o, const float *i, const float *q, size_t n) {
+    marker_detector_process_block((marker_detector_t *)o, i, q, n);
+}
+static void proc_bcd_time(void *o, const float *i, const float *q, size_t n) {
+    bcd_time_detector_process_block((bcd_time_detector_t *)o, i, q, n);
+}
+static void proc_bcd_freq(void *o, const float *i, const float *q, size_t n) {
+    bcd_freq_detector_process_block((bcd_freq_detector_t *)o, i, q, n);
+}
+static void proc_tone(void *o, const float *i, const float *q, size_t n) {
+    for (size_t k = 0; k < n; k++) tone_tracker_process_sample((tone_tracker_t *)o, i[k], q[k]);
+}
+
+/* Baseband front end feeding its own tick and marker detectors */
+typedef struct {
+    baseband_frontend_t *fe;
+    tick_detector_t *tick;
+    marker_detector_t *marker;
+} bench_baseband_t;
+
+static void baseband_sink(const baseband_block_t *block, void *user_data) {
+    bench_baseband_t *bb = (bench_baseband_t *)user_data;
+    tick_detector_process_baseband(bb->tick, block);
+    marker_detector_process_baseband(bb->marker, block);
+}
+
+static void destroy_baseband(void *o) {
+    bench_baseband_t *bb = (bench_baseband_t *)o;
+    if (!bb) return;
+    baseband_frontend_destroy(bb->fe);
+    tick_detector_destroy(bb->tick);
+    marker_detector_destroy(bb->marker);
+    free(bb);
+}
+
+static bench_baseband_t *create_baseband(int station_count) {
+    static const wwv_station_t stations[] = { WWV_STATION_WWV, WWV_STATION_WWVH };
+    bench_baseband_t *bb = calloc(1, sizeof(*bb));
+    if (!bb) return NULL;
+    bb->fe = baseband_frontend_create();
+    bb->tick = tick_detector_create_baseband(NULL, stations, station_count);
+    bb->marker = marker_detector_create_baseband(NULL);
+    if (!bb->fe || !bb->tick || !bb->marker) {
+        destroy_baseband(bb);
+        return NULL;
+    }
+    baseband_frontend_set_sink(bb->fe, baseband_sink, bb);
+    return bb;
+}
+
+static void proc_baseband(void *o, const float *i, const float *q, size_t n) {
+    baseband_frontend_process(((bench_baseband_t *)o)->fe, i, q, n);
+}
+
+static void destroy_tick(void *o)     { tick_detector_destroy((tick_detector_t *)o); }
+static void destroy_marker(void *o)   { marker_detector_destroy((marker_detector_t *)o); }
+static void destroy_bcd_time(void *o) { bcd_time_detector_destroy((bcd_time_detector_t *)o); }
+static void destroy_bcd_freq(void *o) { bcd_freq_detector_destroy((bcd_freq_detector_t *)o); }
+static void destroy_tone(void *o)     { tone_tracker_destroy((tone_tracker_t *)o); }
+
+/* Every hop is measured so the tone rows time the estimate path */
+static tone_tracker_t *create_tone(float nominal_hz) {
+    tone_tracker_t *tt = tone_tracker_create(nominal_hz, NULL);
+    tone_tracker_set_demand_driven(tt, false);
+    return tt;
+}
+
+static int create_detectors(bench_detector_t *dets) {
+    bench_detector_t table[] = {
+        { "tick_detector",     false, tick_detector_create(NULL),     proc_tick,     destroy_tick,     0, 0, {0, 0, 0} },
+        { "marker_detector",   false, marker_detector_create(NULL),   proc_marker,   destroy_marker,   0, 0, {0, 0, 0} },
+        { "bcd_time_detector", false, bcd_time_detector_create(NULL), proc_bcd_time, destroy_bcd_time, 0, 0, {0, 0, 0} },
+        { "bcd_freq_detector", false, bcd_freq_detector_create(NULL), proc_bcd_freq, destroy_bcd_freq, 0, 0, {0, 0, 0} },
+        { "bcd_freq_sliding",  false, bcd_freq_detector_create_sliding(NULL), proc_bcd_freq, destroy_bcd_freq, 0, 0, {0, 0, 0} },
+        { "tick_marker_bb",    false, create_baseband(1),             proc_baseband, destroy_baseband, 0, 0, {0, 0, 0} },
+        { "tone_carrier",      true,  create_tone(0.0f),              proc_tone,  destroy_tone,     0, 0, {0, 0, 0} },
+        { "tone_500",          true,  create_tone(500.0f),            proc_tone,  destroy_tone,     0, 0, {0, 0, 0} },
+        { "tone_600",          true,  create_tone(600.0f),            proc_tone,  destroy_tone,     0, 0, {0, 0, 0} },
+    };
+    int count = 0;
+    for (size_t d = 0; d < sizeof(table) / sizeof(table[0]); d++) {
+        if (table[d].obj) dets[count++] = table[d];
+    }
+    return count;
+}
+
+static int run_detectors(const bench_options_t *opt, bench_detector_t *dets) {
+    bench_source_t src;
+    if (!source_open(&src, &opt->synth, opt->dual)) {
+        source_close(&src);
+        return 0;
+    }
+
+    int count = create_detectors(dets);
+    size_t block = opt->block ? opt->block : 1;
+
+    for (double done = 0.0; done < opt->seconds; done += 1.0) {
+        double fraction = (opt->seconds - done < 1.0) ? opt->seconds - done : 1.0;
+        size_t det_n, disp_n;
+        source_next(&src, fraction, &det_n, &disp_n);
+
+        for (int d = 0; d < count; d++) {
+            bench_detector_t *bd = &dets[d];
+            const float *in_i = bd->display_path ? src.disp_i : src.det_i;
+            const float *in_q = bd->display_path ? src.disp_q : src.det_q;
+            size_t n_total = bd->display_path ? disp_n : det_n;
+            size_t step = bd->display_path ? block * BENCH_DISPLAY_RATE / BENCH_DETECTOR_RATE : block;
+            if (step == 0) step = 1;
+
+            bench_alloc_stats_t p0 = bench_alloc_snapshot();
+            uint64_t t0 = bench_now_ns();
+            for (size_t k = 0; k < n_total; k += step) {
+                size_t n = (n_total - k < step) ? n_total - k : step;
+                bd->process(bd->obj, in_i + k, in_q + k, n);
+            }
+            bd->ns += bench_now_ns() - t0;
+            bench_alloc_stats_t a = alloc_delta(p0, bench_alloc_snapshot());
+            bd->alloc_process.allocs += a.allocs;
+            bd->alloc_process.frees += a.frees;
+            bd->alloc_process.bytes += a.bytes;
+            bd->samples += n_total;
+        }
+    }
+
+    for (int d = 0; d < count; d++) {
+        dets[d].destroy(dets[d].obj);
+        dets[d].obj = NULL;
+    }
+    source_close(&src);
+    return count;
+}
+
+/*============================================================================
+ * Report
+ *============================================================================*/
+
+static const char *simd_name(channel_simd_t simd) {
+    switch (simd) {
+        case CHANNEL_SIMD_SSE2: return "sse2";
+        case CHANNEL_SIMD_AVX2: return "avx2";
+        case CHANNEL_SIMD_NEON: return "neon";
+        default:                return "scalar";
+    }
+}
+
+/**
+ * Ticks and minute markers the synthetic broadcast contains
+ */
+static void expected_events(const bench_options_t *opt, int *ticks, int *markers) {
+    *ticks = 0;
+    *markers = 0;
+    for (long sec = 0; sec < (long)opt->seconds; sec++) {
+        int s = (int)((sec + (long)opt->synth.start_offset_sec) % 60);
+        if (s == 0) (*markers)++;
+        else if (s != 29 && s != 59) (*ticks)++;
+    }
+}
+
+static void json_alloc(FILE *f, const char *key, bench_alloc_stats_t a, bool last) {
+    fprintf(f, "      \"%s\": { \"allocs\": %llu, \"frees\": %llu, \"bytes\": %llu }%s\n", key,
+            (unsigned long long)a.allocs, (unsigned long long)a.frees,
+            (unsigned long long)a.bytes, last ? "" : ",");
+}
+
+/**
+ * Stage timing from the manager (WWV_PERF builds only)
+ */
+static void json_perf(FILE *f, const wwv_perf_stats_t *perf) {
+    fprintf(f, "    \"perf\": {\n");
+    fprintf(f, "      \"enabled\": %s,\n", perf->enabled ? "true" : "false");
+    fprintf(f, "      \"stages\": [");
+    int n = 0;
+    for (int s = 0; s < WWV_PERF_STAGE_COUNT; s++) {
+        const wwv_perf_stage_stats_t *st = &perf->stage[s];
+        if (st->count == 0) continue;
+        fprintf(f, "%s\n        { \"name\": \"%s\", \"count\": %llu, \"total_ns\": %llu, "
+                   "\"mean_ns\": %.0f, \"p50_ns\": %llu, \"p99_ns\": %llu, \"max_ns\": %llu }",
+                n++ ? "," : "", wwv_perf_stage_name((wwv_perf_stage_t)s),
+                (unsigned long long)st->count, (unsigned long long)st->total_ns,
+                (double)st->total_ns / (double)st->count,
+                (unsigned long long)wwv_perf_percentile_ns(st, 0.50f),
+                (unsigned long long)wwv_perf_percentile_ns(st, 0.99f),
+                (unsigned long long)st->max_ns);
+    }
+    fprintf(f, "%s]\n", n ? "\n      " : "");
+    fprintf(f, "    }\n");
+}
+
+static void write_json(FILE *f, const bench_options_t *opt, const manager_result_t *mgr,
+                       const bench_detector_t *dets, int det_count) {
+    double sec = mgr->ns * 1e-9;
+    uint64_t total = mgr->det_samples + mgr->disp_samples;
+    int expected_ticks, expected_markers;
+    expected_events(opt, &expected_ticks, &expected_markers);
+
+    fprintf(f, "{\n");
+    fprintf(f, "  \"benchmark\": \"wwv_bench\",\n");
+    fprintf(f, "  \"schema\": 1,\n");
+    fprintf(f, "  \"version\": \"%s\",\n", PHOENIX_VERSION_FULL);
+    fprintf(f, "  \"label\": \"%s\",\n", opt->label);
+    fprintf(f, "  \"simd\": \"%s\",\n", simd_name(channel_filters_get_simd()));
+    fprintf(f, "  \"signal\": {\n");
+    fprintf(f, "    \"seconds\": %.3f,\n", opt->seconds);
+    fprintf(f, "    \"station\": \"%s\",\n",
+            opt->dual ? "both" : opt->synth.station == WWV_SYNTH_WWVH ? "wwvh" : "wwv");
+    fprintf(f, "    \"snr_db\": %.2f,\n", opt->synth.snr_db);
+    fprintf(f, "    \"doppler_hz\": %.3f,\n", opt->synth.doppler_hz);
+    fprintf(f, "    \"fade_rate_hz\": %.4f,\n", opt->synth.fade_rate_hz);
+    fprintf(f, "    \"fade_depth_db\": %.2f,\n", opt->synth.fade_depth_db);
+    fprintf(f, "    \"seed\": %llu,\n", (unsigned long long)opt->synth.seed);
+    fprintf(f, "    \"detector_rate\": %d,\n", BENCH_DETECTOR_RATE);
+    fprintf(f, "    \"display_rate\": %d,\n", BENCH_DISPLAY_RATE);
+    fprintf(f, "    \"block\": %zu,\n", opt->block);
+    fprintf(f, "    \"generate_sec\": %.4f\n", mgr->gen_ns * 1e-9);
+    fprintf(f, "  },\n");
+
+    fprintf(f, "  \"manager\": {\n");
+    fprintf(f, "    \"process_sec\": %.4f,\n", sec);
+    fprintf(f, "    \"realtime_factor\": %.2f,\n", (sec > 0.0) ? opt->seconds / sec : 0.0);
+    fprintf(f, "    \"samples_per_sec\": %.0f,\n", (sec > 0.0) ? total / sec : 0.0);
+    fprintf(f, "    \"ns_per_detector_sample\": %.2f,\n",
+            mgr->det_samples ? (double)mgr->ns / mgr->det_samples : 0.0);
+    fprintf(f, "    \"baseband_path\": %s,\n", opt->baseband ? "true" : "false");
+    fprintf(f, "    \"bcd_freq_sliding\": %s,\n", opt->bcd_sliding ? "true" : "false");
+    fprintf(f, "    \"narrowband_goertzel\": %s,\n", opt->goertzel ? "true" : "false");
+    fprintf(f, "    \"bcd_adaptive\": %s,\n", opt->bcd_adaptive ? "true" : "false");
+    fprintf(f, "    \"marker_template\": %s,\n", opt->marker_template ? "true" : "false");
+    fprintf(f, "    \"carrier_correction\": %s,\n", opt->carrier_correction ? "true" : "false");
+    fprintf(f, "    \"duty_cycle\": %s,\n", opt->duty_cycle ? "true" : "false");
+    fprintf(f, "    \"detector_tiling\": %s,\n", opt->untiled ? "false" : "true");
+    fprintf(f, "    \"ticks\": %d,\n", mgr->ticks);
+    fprintf(f, "    \"expected_ticks\": %d,\n", expected_ticks);
+    if (opt->dual) fprintf(f, "    \"wwvh_ticks\": %d,\n", mgr->wwvh_ticks);
+    if (opt->economy) {
+        fprintf(f, "    \"tick_frames_skipped\": %llu,\n", (unsigned long long)mgr->tick_skipped);
+    }
+    fprintf(f, "    \"markers\": %d,\n", mgr->markers);
+    fprintf(f, "    \"expected_markers\": %d,\n", expected_markers);
+    fprintf(f, "    \"synced\": %s,\n", mgr->sync.is_synced ? "true" : "false");
+    fprintf(f, "    \"sync_confidence\": %d,\n", mgr->sync.confidence);
+    fprintf(f, "    \"lock_sec\": %.0f,\n", mgr->lock_sec);
+    if (opt->warm_start > 0.0) {
+        fprintf(f, "    \"warm_start_sec\": %.0f,\n", opt->warm_start);
+        fprintf(f, "    \"state_bytes\": %zu,\n", mgr->state_bytes);
+        fprintf(f, "    \"restored\": %s,\n", mgr->restored ? "true" : "false");
+        fprintf(f, "    \"relock_sec\": %.0f,\n", mgr->relock_sec);
+    }
+    if (opt->batch_events) {
+        fprintf(f, "    \"event_batches\": { \"batches\": %llu, \"ticks\": %d, \"markers\": %d, "
+                   "\"syncs\": %d, \"dropped\": %llu },\n",
+                (unsigned long long)mgr->batches, mgr->batch_ticks, mgr->batch_markers,
+                mgr->batch_syncs, (unsigned long long)mgr->batch_dropped);
+    }
+    fprintf(f, "    \"arena_bytes\": %zu,\n", mgr->arena_bytes);
+    fprintf(f, "    \"allocations\": {\n");
+    fprintf(f, "      \"counted\": %s,\n", bench_alloc_available() ? "true" : "false");
+    json_alloc(f, "create", mgr->alloc_create, false);
+    json_alloc(f, "process", mgr->alloc_process, false);
+    json_alloc(f, "destroy", mgr->alloc_destroy, true);
+    fprintf(f, "    },\n");
+    json_perf(f, &mgr->perf);
+    fprintf(f, "  },\n");
+
+    fprintf(f, "  \"detectors\": [");
+    for (int d = 0; d < det_count; d++) {
+        const bench_detector_t *bd = &dets[d];
+        double dsec = bd->ns * 1e-9;
+        fprintf(f, "%s\n    { \"name\": \"%s\", \"path\": \"%s\", \"samples\": %llu, "
+                   "\"ns_per_sample\": %.2f, \"samples_per_sec\": %.0f, "
+                   "\"process_allocs\": %llu }",
+                d ? "," : "", bd->name, bd->display_path ? "display" : "detector",
+                (unsigned long long)bd->samples,
+                bd->samples ? (double)bd->ns / bd->samples : 0.0,
+                (dsec > 0.0) ? bd->samples / dsec : 0.0,
+                (unsigned long long)bd->alloc_process.allocs);
+    }
+    fprintf(f, "%s]\n", det_count ? "\n  " : "");
+    fprintf(f, "}\n");
+}
+
+static void print_summary(const bench_options_t *opt, const manager_result_t *mgr,
+                          const bench_detector_t *dets, int det_count) {
+    double sec = mgr->ns * 1e-9;
+    fprintf(stderr, "\n[BENCH] %.0f s synthetic %s, SNR %.1f dB, block %zu\n", opt->seconds,
+            opt->dual ? "WWV+WWVH" : opt->synth.station == WWV_SYNTH_WWVH ? "WWVH" : "WWV",
+            opt->synth.snr_db, opt->block);
+    fprintf(stderr, "[BENCH] manager: %.3f s (%.1fx realtime), %.1f ns/detector sample, "
+                    "ticks=%d markers=%d, process allocs=%llu\n",
+            sec, (sec > 0.0) ? opt->seconds / sec : 0.0,
+            mgr->det_samples ? (double)mgr->ns / mgr->det_samples : 0.0,
+            mgr->ticks, mgr->markers, (unsigned long long)mgr->alloc_process.allocs);
+    if (opt->dual) fprintf(stderr, "[BENCH] dual station: wwvh ticks=%d\n", mgr->wwvh_ticks);
+    if (opt->economy) {
+        fprintf(stderr, "[BENCH] economy: %llu tick frames skipped\n",
+                (unsigned long long)mgr->tick_skipped);
+    }
+    if (opt->warm_start > 0.0) {
+        fprintf(stderr, "[BENCH] warm start at %.0f s: %zu-byte snapshot, %s, first lock %.0f s, "
+                        "relock after %.0f s\n", opt->warm_start, mgr->state_bytes,
+                mgr->restored ? "restored" : "NOT restored", mgr->lock_sec, mgr->relock_sec);
+    }
+    if (opt->batch_events) {
+        fprintf(stderr, "[BENCH] event batches: %llu, ticks=%d markers=%d syncs=%d dropped=%llu\n",
+                (unsigned long long)mgr->batches, mgr->batch_ticks, mgr->batch_markers,
+                mgr->batch_syncs, (unsigned long long)mgr->batch_dropped);
+    }
+    if (mgr->arena_bytes) {
+        fprintf(stderr, "[BENCH] manager arena: %zu bytes, create allocs=%llu\n",
+                mgr->arena_bytes, (unsigned long long)mgr->alloc_create.allocs);
+    }
+    for (int d = 0; d < det_count; d++) {
+        fprintf(stderr, "[BENCH]   %-18s %8.1f ns/sample (%s)\n", dets[d].name,
+                dets[d].samples ? (double)dets[d].ns / dets[d].samples : 0.0,
+                dets[d].display_path ? "12 kHz" : "50 kHz");
+    }
+}
+
+#define BENCH_MIN_TICK_FRACTION 0.5     /* Ticks per station over the broadcast's, mode runs */
+
+/**
+ * What the run's mode promises, for the smoke tests' exit status
+ */
+static bool check_manager_result(const bench_options_t *opt, const manager_result_t *mgr) {
+    int expected_ticks, expected_markers;
+    expected_events(opt, &expected_ticks, &expected_markers);
+    int min_ticks = (int)(expected_ticks * BENCH_MIN_TICK_FRACTION);
+    bool ok = true;
+
+    if (opt->warm_start > 0.0 && !mgr->restored) ok = false;
+    /* Every counted event must have arrived in a batch, and a lock must
+     * have been reported as a sync change */
+    if (opt->batch_events && (mgr->batch_ticks != mgr->ticks || mgr->batch_markers != mgr->markers ||
+                              mgr->batch_dropped || (mgr->sync.is_synced && mgr->batch_syncs == 0))) {
+        ok = false;
+    }
+    /* Built in the caller's block, and nothing from the heap once processing */
+    if (opt->arena && (mgr->arena_bytes == 0 ||
+                       (bench_alloc_available() && mgr->alloc_process.allocs != 0))) {
+        fprintf(stderr, "[BENCH] arena: %zu bytes, %llu process allocs  FAIL\n", mgr->arena_bytes,
+                (unsigned long long)mgr->alloc_process.allocs);
+        ok = false;
+    }
+    if (opt->dual && (mgr->ticks < min_ticks || mgr->wwvh_ticks < min_ticks)) {
+        fprintf(stderr, "[BENCH] dual station: %d / %d ticks of %d needed  FAIL\n",
+                mgr->ticks, mgr->wwvh_ticks, min_ticks);
+        ok = false;
+    }
+    if (opt->economy && (mgr->tick_skipped == 0 || mgr->ticks < min_ticks)) {
+        fprintf(stderr, "[BENCH] economy: %llu frames skipped, %d ticks of %d needed  FAIL\n",
+                (unsigned long long)mgr->tick_skipped, mgr->ticks, min_ticks);
+        ok = false;
+    }
+    return ok;
+}
+
+/*============================================================================
+ * Kernel Check
+ *============================================================================*/
+
+#define KC_TAPS         256     /* Padded tick template length */
+#define KC_SPAN         (KC_TAPS + 8)
+#define KC_CALLS        200000
+
+static uint32_t kc_rand(uint32_t *state) {
+    *state = *state * 1664525u + 1013904223u;
+    return *state;
+}
+
+static float kc_uniform(uint32_t *state) {
+    return (float)(kc_rand(state) >> 8) / 8388608.0f - 1.0f;
+}
+
+/**
+ * One kernel over every signal alignment and a short (tail) length
+ * @return Worst error relative to the sum of product magnitudes
+ */
+static double kc_check_tick_corr(tick_corr_dot_fn dot, const float *ti, const float *tq,
+                                 const float *xi, const float *xq) {
+    const int lengths[] = { KC_TAPS, KC_TAPS - 6, 13, 0 };
+    double worst = 0.0;
+
+    for (int l = 0; l < (int)(sizeof(lengths) / sizeof(lengths[0])); l++) {
+        int n = lengths[l];
+        for (int off = 0; off < 8; off++) {
+            double ref_re = 0.0, ref_im = 0.0, scale = 1e-30;
+            for (int k = 0; k < n; k++) {
+                double a = xi[off + k], b = xq[off + k];
+                ref_re += a * ti[k] + b * tq[k];
+                ref_im += b * ti[k] - a * tq[k];
+                scale += fabs(a * ti[k]) + fabs(b * tq[k]) + fabs(b * ti[k]) + fabs(a * tq[k]);
+            }
+            float re = NAN, im = NAN;
+            dot(ti, tq, xi + off, xq + off, n, &re, &im);
+            double err = (fabs(re - ref_re) + fabs(im - ref_im)) / scale;
+            if (!(err <= worst)) worst = err;       /* NaN propagates */
+        }
+    }
+    return worst;
+}
+
+static double kc_time_tick_corr(tick_corr_dot_fn dot, const float *ti, const float *tq,
+                                const float *xi, const float *xq) {
+    volatile float sink = 0.0f;
+    uint64_t t0 = bench_now_ns();
+    for (int c = 0; c < KC_CALLS; c++) {
+        float re, im;
+        dot(ti, tq, xi + (c & 7), xq + (c & 7), KC_TAPS, &re, &im);
+        sink += re + im;
+    }
+    (void)sink;
+    return (double)(bench_now_ns() - t0) / KC_CALLS;
+}
+
+#define KC_PP_TAPS      128     /* Longest front-end branch */
+#define KC_PP_SPAN      (KC_PP_TAPS + 8)
+
+/**
+ * Fixed-point branch kernel against an int64 reference over every signal
+ * alignment and short lengths, with full-scale taps and input
+ * @return Mismatching results (the kernels are exact)
+ */
+static int kc_check_polyphase_s16(polyphase_dot2_s16_fn dot, const int16_t *h,
+                                  const int16_t *xi, const int16_t *xq) {
+    const int lengths[] = { KC_PP_TAPS, KC_PP_TAPS - 6, 48, 13, 0 };
+    int bad = 0;
+
+    for (int l = 0; l < (int)(sizeof(lengths) / sizeof(lengths[0])); l++) {
+        int n = lengths[l];
+        for (int off = 0; off < 8; off++) {
+            int64_t ref_i = 0, ref_q = 0;
+            for (int k = 0; k < n; k++) {
+                ref_i += (int64_t)h[k] * xi[off + k];
+                ref_q += (int64_t)h[k] * xq[off + k];
+            }
+            int32_t yi = -1, yq = -1;
+            dot(h, xi + off, xq + off, n, &yi, &yq);
+            if (yi != ref_i || yq != ref_q) bad++;
+        }
+    }
+    return bad;
+}
+
+static double kc_time_polyphase_s16(polyphase_dot2_s16_fn dot, const int16_t *h,
+                                    const int16_t *xi, const int16_t *xq) {
+    volatile uint32_t sink = 0;
+    uint64_t t0 = bench_now_ns();
+    for (int c = 0; c < KC_CALLS; c++) {
+        int32_t yi, yq;
+        dot(h, xi + (c & 7), xq + (c & 7), KC_PP_TAPS, &yi, &yq);
+        sink += (uint32_t)(yi ^ yq);
+    }
+    (void)sink;
+    return (double)(bench_now_ns() - t0) / KC_CALLS;
+}
+
+static double kc_time_polyphase(polyphase_dot2_fn dot, const float *h,
+                                const float *xi, const float *xq) {
+    volatile float sink = 0.0f;
+    uint64_t t0 = bench_now_ns();
+    for (int c = 0; c < KC_CALLS; c++) {
+        float yi, yq;
+        dot(h, xi + (c & 7), xq + (c & 7), KC_PP_TAPS, &yi, &yq);
+        sink += yi + yq;
+    }
+    (void)sink;
+    return (double)(bench_now_ns() - t0) / KC_CALLS;
+}
+
+typedef struct {
+    float *i, *q;
+    size_t count, capacity;
+} kc_capture_t;
+
+static void kc_capture_sink(const float *i_samples, const float *q_samples,
+                            size_t count, void *user_data) {
+    kc_capture_t *c = (kc_capture_t *)user_data;
+    for (size_t k = 0; k < count && c->count < c->capacity; k++, c->count++) {
+        c->i[c->count] = i_samples[k];
+        c->q[c->count] = q_samples[k];
+    }
+}
+
+/* int16 front end against the float one on the same input: detector-tap
+ * difference, dB below the signal */
+static double kc_frontend_s16_snr(void) {
+    enum { IN = 10 * SDR_FRONTEND_CHUNK, OUT = IN / 40 };
+    static int16_t iq[2 * IN];
+    static float fi[IN], fq[IN];
+    static float ai[OUT], aq[OUT], bi[OUT], bq[OUT];
+    kc_capture_t a = { ai, aq, 0, OUT }, b = { bi, bq, 0, OUT };
+    uint32_t seed = 7;
+
+    for (int n = 0; n < IN; n++) {
+        double ph = 2.0 * 3.14159265358979323846 * 5000.0 * n / SDR_FRONTEND_INPUT_RATE;
+        iq[2 * n] = (int16_t)lrint(16000.0 * cos(ph) + 2000.0 * kc_uniform(&seed));
+        iq[2 * n + 1] = (int16_t)lrint(16000.0 * sin(ph) + 2000.0 * kc_uniform(&seed));
+        fi[n] = iq[2 * n] / 32768.0f;
+        fq[n] = iq[2 * n + 1] / 32768.0f;
+    }
+
+    sdr_frontend_t *fa = sdr_frontend_create();
+    sdr_frontend_t *fb = sdr_frontend_create();
+    if (!fa || !fb) {
+        sdr_frontend_destroy(fa);
+        sdr_frontend_destroy(fb);
+        return 0.0;
+    }
+    sdr_frontend_set_sink(fa, SDR_TAP_DETECTOR, kc_capture_sink, &a);
+    sdr_frontend_set_sink(fb, SDR_TAP_DETECTOR, kc_capture_sink, &b);
+    sdr_frontend_process(fa, fi, fq, IN);
+    sdr_frontend_process_s16(fb, iq, IN);
+    sdr_frontend_destroy(fa);
+    sdr_frontend_destroy(fb);
+
+    double sig = 1e-30, err = 1e-30;
+    for (size_t k = 0; k < a.count && k < b.count; k++) {
+        sig += (double)ai[k] * ai[k] + (double)aq[k] * aq[k];
+        err += (double)(ai[k] - bi[k]) * (ai[k] - bi[k]) + (double)(aq[k] - bq[k]) * (aq[k] - bq[k]);
+    }
+    return (a.count == b.count && a.count > 0) ? 10.0 * log10(sig / err) : 0.0;
+}
+
+/* int16 front-end kernels: exact against int64, and timed next to float */
+static bool kc_check_polyphase(const channel_simd_t *levels, int level_count) {
+    static int16_t h[KC_PP_TAPS], xi[KC_PP_SPAN], xq[KC_PP_SPAN];
+    static float hf[KC_PP_TAPS], xfi[KC_PP_SPAN], xfq[KC_PP_SPAN];
+    const double min_snr_db = 70.0;
+    uint32_t seed = 3;
+
+    /* Extreme case the tap scaling allows: |taps| summing to 32767 */
+    int l1 = 0;
+    for (int k = 0; k < KC_PP_TAPS; k++) {
+        int v = (int)(kc_rand(&seed) % 511) - 255;
+        if (l1 + abs(v) > 32767) v = 0;
+        h[k] = (int16_t)v;
+        l1 += abs(v);
+        hf[k] = v / 32768.0f;
+    }
+    for (int k = 0; k < KC_PP_SPAN; k++) {
+        xi[k] = (k & 1) ? INT16_MIN : INT16_MAX;
+        xq[k] = (int16_t)(kc_rand(&seed) >> 16);
+        xfi[k] = xi[k] / 32768.0f;
+        xfq[k] = xq[k] / 32768.0f;
+    }
+
+    bool ok = true;
+    for (int l = 0; l < level_count; l++) {
+        if (channel_filters_set_simd(levels[l]) != levels[l]) continue;
+
+        polyphase_dot2_s16_fn dot = polyphase_select_kernel_s16(levels[l]);
+        int bad = kc_check_polyphase_s16(dot, h, xi, xq);
+        double ns = kc_time_polyphase_s16(dot, h, xi, xq);
+        double ns_f = kc_time_polyphase(polyphase_select_kernel(levels[l]), hf, xfi, xfq);
+        ok = ok && bad == 0;
+        fprintf(stderr, "[BENCH] polyphase_s16 %-6s  %7.1f ns/call (float %.1f)  %s\n",
+                simd_name(levels[l]), ns, ns_f, bad == 0 ? "exact" : "FAIL");
+    }
+
+    double snr = kc_frontend_s16_snr();
+    bool pass = snr >= min_snr_db;
+    fprintf(stderr, "[BENCH] sdr_frontend s16 vs float  %.1f dB  %s\n", snr, pass ? "ok" : "FAIL");
+    return ok && pass;
+}
+
+#define KC_BANK_SAMPLES 4096
+#define KC_BANK_SPLIT   1001    /* Second call starts mid-vector, carrying state */
+
+/*
+ * Channel filter banks at every lane count against one scalar channel per
+ * lane. The banks promise bit-identical output, so every lane of every
+ * sample must compare equal.
+ */
+static bool kc_check_banks(const channel_simd_t *levels, int level_count) {
+    static float in[KC_BANK_SAMPLES * CHANNEL_BANK_MAX_LANES];
+    static float out[KC_BANK_SAMPLES * CHANNEL_BANK_MAX_LANES];
+    uint32_t seed = 9;
+    for (int k = 0; k < KC_BANK_SAMPLES * CHANNEL_BANK_MAX_LANES; k++) in[k] = kc_uniform(&seed);
+
+    bool ok = true;
+    for (int l = 0; l < level_count; l++) {
+        if (channel_filters_set_simd(levels[l]) != levels[l]) continue;
+
+        int mismatches = 0;
+        for (int lanes = 1; lanes <= CHANNEL_BANK_MAX_LANES; lanes++) {
+            sync_channel_bank_t sync_bank;
+            data_channel_bank_t data_bank;
+            sync_channel_t sync[CHANNEL_BANK_MAX_LANES];
+            data_channel_t data[CHANNEL_BANK_MAX_LANES];
+            if (!sync_channel_bank_init(&sync_bank, lanes) || !data_channel_bank_init(&data_bank, lanes)) {
+                return false;
+            }
+            for (int k = 0; k < lanes; k++) {
+                sync_channel_init(&sync[k]);
+                data_channel_init(&data[k]);
+            }
+
+            const size_t tail = KC_BANK_SAMPLES - KC_BANK_SPLIT;
+            sync_channel_bank_process(&sync_bank, in, out, KC_BANK_SPLIT);
+            sync_channel_bank_process(&sync_bank, in + KC_BANK_SPLIT * lanes,
+                                      out + KC_BANK_SPLIT * lanes, tail);
+            for (int n = 0; n < KC_BANK_SAMPLES; n++) {
+                for (int k = 0; k < lanes; k++) {
+                    float ref = sync_channel_process(&sync[k], in[n * lanes + k]);
+                    if (memcmp(&ref, &out[n * lanes + k], sizeof(ref)) != 0) mismatches++;
+                }
+            }
+            data_channel_bank_process(&data_bank, in, out, KC_BANK_SPLIT);
+            data_channel_bank_process(&data_bank, in + KC_BANK_SPLIT * lanes,
+                                      out + KC_BANK_SPLIT * lanes, tail);
+            for (int n = 0; n < KC_BANK_SAMPLES; n++) {
+                for (int k = 0; k < lanes; k++) {
+                    float ref = data_channel_process(&data[k], in[n * lanes + k]);
+                    if (memcmp(&ref, &out[n * lanes + k], sizeof(ref)) != 0) mismatches++;
+                }
+            }
+        }
+        ok = ok && mismatches == 0;
+        fprintf(stderr, "[BENCH] channel banks %-6s  1-%d lanes  %d mismatches  %s\n",
+                simd_name(levels[l]), CHANNEL_BANK_MAX_LANES, mismatches,
+                mismatches == 0 ? "exact" : "FAIL");
+    }
+    return ok;
+}
+
+#if !defined(WWV_FFT_BACKEND_FFTW) && !defined(WWV_FFT_BACKEND_PFFFT)
+#define KC_FFT_CALLS    20000
+
+static double kc_time_fft(const fft_kiss_simd_t *simd, kiss_fft_cfg cfg, int n,
+                          const kiss_fft_cpx *in, kiss_fft_cpx *out) {
+    int calls = (int)(KC_FFT_CALLS * 256LL / n);
+    volatile float sink = 0.0f;
+    uint64_t t0 = bench_now_ns();
+    for (int c = 0; c < calls; c++) {
+        if (simd) fft_kiss_simd_forward(simd, in, out);
+        else kiss_fft(cfg, in, out);
+        sink += out[c % n].r;
+    }
+    (void)sink;
+    return (double)(bench_now_ns() - t0) / calls;
+}
+
+/* Vector stages against kiss_fft() on the sizes the detectors and trackers plan */
+static bool kc_check_fft(const channel_simd_t *levels, int level_count) {
+    static kiss_fft_cpx in[TONE_FFT_SIZE], ref[TONE_FFT_SIZE], out[TONE_FFT_SIZE];
+    const int sizes[] = { TICK_FFT_SIZE, TONE_ZOOM_FFT_SIZE, BCD_FREQ_FFT_SIZE, TONE_FFT_SIZE };
+    const double tolerance = 1e-6;
+    uint32_t seed = 5;
+    bool ok = true;
+
+    for (int k = 0; k < TONE_FFT_SIZE; k++) {
+        in[k].r = kc_uniform(&seed);
+        in[k].i = kc_uniform(&seed);
+    }
+
+    for (int z = 0; z < (int)(sizeof(sizes) / sizeof(sizes[0])); z++) {
+        int n = sizes[z];
+        kiss_fft_cfg cfg = kiss_fft_alloc(n, 0, NULL, NULL);
+        if (!cfg) return false;
+        kiss_fft(cfg, in, ref);
+        double peak = 1e-30;
+        for (int k = 0; k < n; k++) {
+            double mag = fabs(ref[k].r) + fabs(ref[k].i);
+            if (mag > peak) peak = mag;
+        }
+        double ns_scalar = kc_time_fft(NULL, cfg, n, in, out);
+
+        for (int l = 0; l < level_count; l++) {
+            if (levels[l] == CHANNEL_SIMD_SCALAR) continue;
+            if (channel_filters_set_simd(levels[l]) != levels[l]) continue;
+
+            fft_kiss_simd_t *simd = fft_kiss_simd_create(cfg, levels[l], NULL);
+            if (!simd) continue;
+            memset(out, 0xff, sizeof(out));
+            fft_kiss_simd_forward(simd, in, out);
+
+            int inexact = 0;
+            double err = 0.0;
+            for (int k = 0; k < n; k++) {
+                if (out[k].r != ref[k].r || out[k].i != ref[k].i) inexact++;
+                double e = (fabs(out[k].r - ref[k].r) + fabs(out[k].i - ref[k].i)) / peak;
+                if (!(e <= err)) err = e;       /* NaN propagates */
+            }
+            int total = 0;
+            int vector = fft_kiss_simd_vector_stages(simd, &total);
+            double ns = kc_time_fft(simd, cfg, n, in, out);
+            fft_kiss_simd_destroy(simd);
+
+            bool pass = err <= tolerance;
+            ok = ok && pass;
+            fprintf(stderr, "[BENCH] kiss_fft %-4d %-6s  %8.1f ns/call (scalar %.1f)  %d/%d stages  "
+                    "%s  %s\n", n, simd_name(levels[l]), ns, ns_scalar, vector, total,
+                    inexact == 0 ? "exact" : "rel err", pass ? "ok" : "FAIL");
+            if (inexact > 0) {
+                fprintf(stderr, "[BENCH]   %d/%d bins differ, rel err %.2e\n", inexact, n, err);
+            }
+        }
+        free(cfg);
+    }
+    return ok;
+}
+#endif
+
+/* Baked tables must be exactly what runtime generation would produce */
+static bool kc_check_tables(void) {
+    static float ref[TONE_FFT_SIZE], ref_q[TONE_FFT_SIZE];
+    const int sizes[] = { TICK_FFT_SIZE, TONE_ZOOM_FFT_SIZE, BCD_FREQ_FFT_SIZE, TONE_FFT_SIZE };
+    const int tick_hz[] = { TICK_TARGET_FREQ_HZ, TICK_WWVH_FREQ_HZ };
+    const int taps = DSP_TEMPLATE_TAPS(TICK_TEMPLATE_SAMPLES);
+    const int pad = taps - TICK_TEMPLATE_SAMPLES;
+    bool ok = true;
+
+    if (dsp_tables_baked_count() == 0) {
+        fprintf(stderr, "[BENCH] dsp_tables: not baked (WWV_BAKED_TABLES off)\n");
+        return true;
+    }
+    for (int k = 0; k < (int)(sizeof(sizes) / sizeof(sizes[0])); k++) {
+        const float *baked = dsp_tables_hann(sizes[k]);
+        for (int i = 0; i < sizes[k]; i++) ref[i] = dsp_hann_coeff(i, sizes[k]);
+        bool pass = baked && memcmp(ref, baked, sizes[k] * sizeof(float)) == 0;
+        ok = ok && pass;
+        fprintf(stderr, "[BENCH] dsp_tables hann %-5d  %s\n", sizes[k], pass ? "ok" : "FAIL");
+    }
+    for (int k = 0; k < (int)(sizeof(tick_hz) / sizeof(tick_hz[0])); k++) {
+        const float *baked_i = dsp_tables_tick_template(tick_hz[k], false);
+        const float *baked_q = dsp_tables_tick_template(tick_hz[k], true);
+        memset(ref, 0, taps * sizeof(float));
+        memset(ref_q, 0, taps * sizeof(float));
+        for (int i = 0; i < TICK_TEMPLATE_SAMPLES; i++) {
+            dsp_tone_template_coeff(i, TICK_TEMPLATE_SAMPLES, tick_hz[k], TICK_SAMPLE_RATE,
+                                    &ref[pad + i], &ref_q[pad + i]);
+        }
+        bool pass = baked_i && baked_q &&
+                    memcmp(ref, baked_i, taps * sizeof(float)) == 0 &&
+                    memcmp(ref_q, baked_q, taps * sizeof(float)) == 0;
+        ok = ok && pass;
+        fprintf(stderr, "[BENCH] dsp_tables tick %d Hz  %s\n", tick_hz[k], pass ? "ok" : "FAIL");
+    }
+    return ok;
+}
+
+static bool run_kernel_check(void) {
+    static _Alignas(TICK_CORR_ALIGN) float ti[KC_TAPS], tq[KC_TAPS];
+    static float xi[KC_SPAN], xq[KC_SPAN];
+    const channel_simd_t levels[] = {
+        CHANNEL_SIMD_SCALAR, CHANNEL_SIMD_SSE2, CHANNEL_SIMD_AVX2, CHANNEL_SIMD_NEON
+    };
+    const double tolerance = 1e-5;
+
+    uint32_t seed = 1;
+    for (int k = 0; k < KC_TAPS; k++) {
+        ti[k] = kc_uniform(&seed);
+        tq[k] = kc_uniform(&seed);
+    }
+    for (int k = 0; k < KC_SPAN; k++) {
+        xi[k] = 100.0f * kc_uniform(&seed);
+        xq[k] = 100.0f * kc_uniform(&seed);
+    }
+
+    channel_simd_t active = channel_filters_get_simd();
+    bool ok = true;
+    for (int l = 0; l < (int)(sizeof(levels) / sizeof(levels[0])); l++) {
+        /* set_simd falls back to the detected level when one is unsupported */
+        if (channel_filters_set_simd(levels[l]) != levels[l]) continue;
+
+        tick_corr_dot_fn dot = tick_corr_select_kernel(levels[l]);
+        double err = kc_check_tick_corr(dot, ti, tq, xi, xq);
+        double ns = kc_time_tick_corr(dot, ti, tq, xi, xq);
+        bool pass = err <= tolerance;
+        ok = ok && pass;
+        fprintf(stderr, "[BENCH] tick_corr %-6s  %7.1f ns/call  rel err %.2e  %s\n",
+                simd_name(levels[l]), ns, err, pass ? "ok" : "FAIL");
+    }
+    bool bank_ok = kc_check_banks(levels, (int)(sizeof(levels) / sizeof(levels[0])));
+    bool pp_ok = kc_check_polyphase(levels, (int)(sizeof(levels) / sizeof(levels[0])));
+#if !defined(WWV_FFT_BACKEND_FFTW) && !defined(WWV_FFT_BACKEND_PFFFT)
+    bool fft_ok = kc_check_fft(levels, (int)(sizeof(levels) / sizeof(levels[0])));
+#else
+    bool fft_ok = true;
+#endif
+    channel_filters_set_simd(active);
+    return kc_check_tables() && bank_ok && pp_ok && fft_ok && ok;
+}
+
+/*============================================================================
+ * Filter Check
+ *============================================================================*/
+
+#define FC_MAX_FILE         (1 << 20)
+#define FC_COEFF_TOL        1e-9    /* Relative, double design against scipy */
+#define FC_EDGE_TOL_DB      0.05    /* Float sections at the cutoff */
+#define FC_BLOCK            4096
+
+/* Value after "key": within [p, end), NULL if absent */
+static const char *fc_field(const char *p, const char *end, const char *key) {
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "\"%s\"", key);
+    const char *f = strstr(p, pattern);
+    if (!f || f >= end) return NULL;
+    f = strchr(f + strlen(pattern), ':');
+    return (f && f < end) ? f + 1 : NULL;
+}
+
+/* Flat list of the numbers in the array starting at p, at most max */
+static int fc_numbers(const char *p, const char *end, double *out, int max) {
+    int depth = 0, n = 0;
+    while (p < end) {
+        char c = *p;
+        if (c == '[') depth++;
+        else if (c == ']') { if (--depth == 0) break; }
+        else if (depth > 0 && (c == '-' || (c >= '0' && c <= '9'))) {
+            char *next;
+            double v = strtod(p, &next);
+            if (n < max) out[n++] = v;
+            p = next;
+            continue;
+        }
+        p++;
+    }
+    return n;
+}
+
+/* Design gain at f of float sections, dB */
+static double fc_response_db(const float (*sos)[6], int sections, double f, double fs) {
+    double w = 2.0 * 3.14159265358979323846 * f / fs;
+    double cr = cos(w), ci = -sin(w), c2r = cos(2.0 * w), c2i = -sin(2.0 * w);
+    double mag = 1.0;
+    for (int k = 0; k < sections; k++) {
+        const float *c = sos[k];
+        double nr = c[0] + c[1] * cr + c[2] * c2r, ni = c[1] * ci + c[2] * c2i;
+        double dr = c[3] + c[4] * cr + c[5] * c2r, di = c[4] * ci + c[5] * c2i;
+        mag *= sqrt((nr * nr + ni * ni) / (dr * dr + di * di));
+    }
+    return 20.0 * log10(mag);
+}
+
+/* Every "butterworth" entry of the test vectors against channel_butterworth_design() */
+static bool fc_check_vectors(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "[BENCH] Cannot read %s\n", path);
+        return false;
+    }
+    char *json = malloc(FC_MAX_FILE + 1);
+    size_t len = json ? fread(json, 1, FC_MAX_FILE, f) : 0;
+    fclose(f);
+    if (!json) return false;
+    json[len] = '\0';
+
+    const char *p = fc_field(json, json + len, "butterworth");
+    const char *end = p ? fc_field(p, json + len, "windows") : NULL;
+    if (!end) end = json + len;
+    bool ok = p != NULL;
+    int tests = 0;
+
+    while (p) {
+        const char *type = fc_field(p, end, "type");
+        const char *order = fc_field(p, end, "order");
+        const char *cutoff = fc_field(p, end, "cutoff");
+        const char *fs = fc_field(p, end, "fs");
+        const char *sos = fc_field(p, end, "sos");
+        if (!type || !order || !cutoff || !fs || !sos) break;
+
+        double ref[CHANNEL_MAX_SECTIONS * 6];
+        int nref = fc_numbers(strchr(sos, '['), end, ref, CHANNEL_MAX_SECTIONS * 6);
+        type += strspn(type, " \t\r\n");
+        channel_filter_type_t t = (strncmp(type, "\"highpass\"", 10) == 0)
+                                  ? CHANNEL_HIGHPASS : CHANNEL_LOWPASS;
+        int n = atoi(order);
+        double fc = atof(cutoff), rate = atof(fs);
+
+        double got[CHANNEL_MAX_SECTIONS][6];
+        int sections = channel_butterworth_design(t, n, fc, rate, got);
+        double worst = (sections * 6 == nref) ? 0.0 : INFINITY;
+        for (int k = 0; k < sections * 6 && k < nref; k++) {
+            double err = fabs(got[k / 6][k % 6] - ref[k]) / (fabs(ref[k]) + 1e-300);
+            if (ref[k] == 0.0) err = fabs(got[k / 6][k % 6]);
+            if (err > worst) worst = err;
+        }
+        bool pass = worst <= FC_COEFF_TOL;
+        ok = ok && pass;
+        tests++;
+        fprintf(stderr, "[BENCH] butterworth %s order %d %.0f Hz @ %.0f  %d sections  "
+                        "max rel err %.2e  %s\n",
+                t == CHANNEL_HIGHPASS ? "HP" : "LP", n, fc, rate, sections, worst,
+                pass ? "ok" : "FAIL");
+
+        p = sos;                    /* "type" leads each entry, so the next one follows */
+    }
+    free(json);
+    return ok && tests > 0;
+}
+
+/*
+ * Channels designed at each rate: -3.01 dB at every cutoff, and the lane
+ * bank bit-identical to the scalar channel
+ */
+static bool fc_check_rates(void) {
+    const float rates[] = { 48000.0f, 50000.0f, 62500.0f };
+    static float in[FC_BLOCK * 2], out[FC_BLOCK * 2];
+    bool ok = true;
+
+    for (size_t r = 0; r < sizeof(rates) / sizeof(rates[0]); r++) {
+        float fs = rates[r];
+        sync_channel_t sync;
+        data_channel_t data;
+        sync_channel_bank_t sync_bank;
+        data_channel_bank_t data_bank;
+        bool built = sync_channel_init_rate(&sync, fs) && data_channel_init_rate(&data, fs) &&
+                     sync_channel_bank_init_rate(&sync_bank, 2, fs) &&
+                     data_channel_bank_init_rate(&data_bank, 2, fs);
+
+        double hp = fc_response_db(sync.sos, 2, CHANNEL_SYNC_HP_HZ, fs);
+        double lp = fc_response_db(sync.sos + 2, 2, CHANNEL_SYNC_LP_HZ, fs);
+        double dl = fc_response_db(data.sos, 2, CHANNEL_DATA_LP_HZ, fs);
+        double edge = -10.0 * log10(2.0);
+        bool edges = fabs(hp - edge) <= FC_EDGE_TOL_DB && fabs(lp - edge) <= FC_EDGE_TOL_DB &&
+                     fabs(dl - edge) <= FC_EDGE_TOL_DB;
+
+        uint32_t seed = 7;
+        for (int k = 0; k < FC_BLOCK * 2; k++) in[k] = kc_uniform(&seed);
+        int mismatches = 0;
+        sync_channel_bank_process(&sync_bank, in, out, FC_BLOCK);
+        for (int k = 0; k < FC_BLOCK; k++) {
+            if (out[2 * k] != sync_channel_process(&sync, in[2 * k])) mismatches++;
+        }
+        data_channel_bank_process(&data_bank, in, out, FC_BLOCK);
+        for (int k = 0; k < FC_BLOCK; k++) {
+            if (out[2 * k] != data_channel_process(&data, in[2 * k])) mismatches++;
+        }
+
+        bool pass = built && edges && mismatches == 0;
+        ok = ok && pass;
+        fprintf(stderr, "[BENCH] channels @ %.0f Hz  edges %.3f / %.3f / %.3f dB  "
+                        "bank mismatches %d  %s\n",
+                fs, hp, lp, dl, mismatches, pass ? "ok" : "FAIL");
+    }
+    return ok;
+}
+
+static bool run_filter_check(const char *vectors_path) {
+    bool vec = fc_check_vectors(vectors_path);
+    bool rates = fc_check_rates();
+    return vec && rates;
+}
+
+/*============================================================================
+ * Denormal Check
+ *============================================================================*/
+
+#define DN_SAMPLES          250000  /* Impulse then silence, 5 s at 50 kHz */
+#define DN_SETTLE           20000   /* Decay out of the normal range first */
+#define DN_SIGNAL_SEC       20
+#define DN_SILENT_SEC       60
+#define DN_CHUNK_SEC        10
+
+/*
+ * 150 Hz data channel lowpass after a unit impulse: once the decay leaves
+ * the normal range the state sits in subnormals for good
+ */
+static double dn_time_filter(bool scoped, int *subnormals) {
+    data_channel_t ch;
+    data_channel_init(&ch);
+    wwv_denormal_scope_t fp = { 0, false };
+    if (scoped) wwv_denormal_enter(&fp);
+
+    volatile float sink = data_channel_process(&ch, 1.0f);
+    uint64_t t0 = 0;
+    *subnormals = 0;
+    for (int n = 1; n < DN_SAMPLES; n++) {
+        if (n == DN_SETTLE) t0 = bench_now_ns();
+        float y = data_channel_process(&ch, 0.0f);
+        if (n >= DN_SETTLE && fpclassify(y) == FP_SUBNORMAL) (*subnormals)++;
+        sink = y;
+    }
+    double ns = (double)(bench_now_ns() - t0) / (DN_SAMPLES - DN_SETTLE);
+    (void)sink;
+
+    if (scoped) wwv_denormal_leave(&fp);
+    return ns;
+}
+
+typedef struct {
+    uint64_t signal_ns;
+    uint64_t silent_ns[DN_SILENT_SEC / DN_CHUNK_SEC];
+    bool leaked;
+} dn_pass_t;
+
+/* DN_SIGNAL_SEC of the broadcast, then exact zeros */
+static void dn_prepare(wwv_detector_manager_t *mgr, bench_source_t *src, int sec,
+                       size_t det_n, size_t disp_n, void *user) {
+    (void)mgr;
+    (void)user;
+    if (sec < DN_SIGNAL_SEC) return;
+    memset(src->det_i, 0, det_n * sizeof(float));
+    memset(src->det_q, 0, det_n * sizeof(float));
+    memset(src->disp_i, 0, disp_n * sizeof(float));
+    memset(src->disp_q, 0, disp_n * sizeof(float));
+}
+
+static void dn_fed(wwv_detector_manager_t *mgr, int sec, uint64_t ns, void *user) {
+    (void)mgr;
+    dn_pass_t *dn = (dn_pass_t *)user;
+    if (sec < DN_SIGNAL_SEC) dn->signal_ns += ns;
+    else dn->silent_ns[(sec - DN_SIGNAL_SEC) / DN_CHUNK_SEC] += ns;
+    /* The caller's (IEEE) mode must be back after every call */
+    if (wwv_denormal_active()) dn->leaked = true;
+}
+
+static double dn_per_sample(uint64_t ns, int seconds) {
+    return (double)ns / ((double)seconds * (BENCH_DETECTOR_RATE + BENCH_DISPLAY_RATE));
+}
+
+/*
+ * Filter on its own with and without the flush scope, then the manager
+ * on signal and on exact zeros: the flushed filter must not put out a
+ * subnormal and the mode must not leak out; the timings are for reading
+ */
+static bool run_denormal_check(void) {
+    int sub_ieee, sub_ftz;
+    double ieee_ns = dn_time_filter(false, &sub_ieee);
+    double ftz_ns = dn_time_filter(true, &sub_ftz);
+    fprintf(stderr, "[BENCH] denormal filter  IEEE %.2f ns/sample (%d subnormal out)  "
+                    "flushed %.2f ns/sample (%d)  FTZ %s\n",
+            ieee_ns, sub_ieee, ftz_ns, sub_ftz, WWV_HAVE_FTZ ? "available" : "unavailable");
+
+    dn_pass_t dn;
+    memset(&dn, 0, sizeof(dn));
+    manager_pass_t pass;
+    manager_pass_init(&pass, DN_SIGNAL_SEC + DN_SILENT_SEC);
+    pass.prepare = dn_prepare;
+    pass.fed = dn_fed;
+    pass.user = &dn;
+    if (!manager_pass(&pass, NULL)) return false;
+
+    bool leaked = dn.leaked;
+    double signal_ns = dn_per_sample(dn.signal_ns, DN_SIGNAL_SEC);
+    double worst = 0.0;
+    for (int c = 0; c < DN_SILENT_SEC / DN_CHUNK_SEC; c++) {
+        double ns = dn_per_sample(dn.silent_ns[c], DN_CHUNK_SEC);
+        fprintf(stderr, "[BENCH] denormal manager silence %2d-%2d s  %.2f ns/sample\n",
+                c * DN_CHUNK_SEC, (c + 1) * DN_CHUNK_SEC, ns);
+        if (ns > worst) worst = ns;
+    }
+
+    bool ok = !leaked && sub_ftz == 0;
+    fprintf(stderr, "[BENCH] denormal manager  signal %.2f ns/sample  worst silence %.2f (%.2fx)  "
+                    "mode %s  %s\n",
+            signal_ns, worst, signal_ns > 0.0 ? worst / signal_ns : 0.0,
+            leaked ? "LEAKED" : "restored", ok ? "ok" : "FAIL");
+    return ok;
+}
+
+/*============================================================================
+ * Baseband Check
+ *============================================================================*/
+
+#define BB_CHECK_SEC            180
+#define BB_CHECK_BLOCK          5000
+#define BB_CHECK_MAX_TICKS      256
+#define BB_CHECK_COUNT_SLACK    2       /* Ticks either path may miss or add */
+#define BB_CHECK_MATCH_MS       20.0    /* Same tick if the timestamps are this close */
+#define BB_CHECK_AGREE_MS       0.5     /* Wider apart: the paths started on different frames */
+#define BB_CHECK_MAX_EPOCH_MS   0.10    /* Mean |epoch difference| allowed where they agree */
+#define BB_CHECK_MIN_AGREE      0.9     /* Fraction of 50 kHz ticks that must agree */
+
+typedef struct {
+    double timestamp_ms[BB_CHECK_MAX_TICKS];
+    double epoch_ms[BB_CHECK_MAX_TICKS];
+    bool refined[BB_CHECK_MAX_TICKS];
+    int ticks;
+    int refined_count;
+    int markers;
+} bb_events_t;
+
+static void bb_on_tick(const tick_event_t *event, void *user_data) {
+    bb_events_t *ev = (bb_events_t *)user_data;
+    if (ev->ticks < BB_CHECK_MAX_TICKS) {
+        ev->timestamp_ms[ev->ticks] = event->timestamp_ms;
+        ev->epoch_ms[ev->ticks] = event->epoch_ms;
+        ev->refined[ev->ticks] = event->epoch_refined;
+    }
+    if (event->epoch_refined) ev->refined_count++;
+    ev->ticks++;
+}
+
+static void bb_on_marker(const marker_event_t *event, void *user_data) {
+    (void)event;
+    ((bb_events_t *)user_data)->markers++;
+}
+
+/*
+ * The same synthetic signal through 50 kHz tick + marker and through the
+ * baseband front end: counts within a couple of ticks, at least as many
+ * refined, most epochs within a tenth of a frame of each other and those
+ * within BB_CHECK_MAX_EPOCH_MS on average, and the baseband chain cheaper.
+ * A tick whose start frame differs between the paths is refined over a
+ * different window, so it is counted apart, not averaged in.
+ */
+static bool run_baseband_check(void) {
+    wwv_synth_config_t synth = WWV_SYNTH_CONFIG_DEFAULT;
+    bench_source_t src;
+    if (!source_open(&src, &synth, false)) {
+        source_close(&src);
+        return false;
+    }
+
+    static bb_events_t full, base;
+    memset(&full, 0, sizeof(full));
+    memset(&base, 0, sizeof(base));
+    tick_detector_t *tick = tick_detector_create(NULL);
+    marker_detector_t *marker = marker_detector_create(NULL);
+    bench_baseband_t *bb = create_baseband(1);
+    if (!tick || !marker || !bb) {
+        tick_detector_destroy(tick);
+        marker_detector_destroy(marker);
+        destroy_baseband(bb);
+        source_close(&src);
+        return false;
+    }
+    tick_detector_set_callback(tick, bb_on_tick, &full);
+    marker_detector_set_callback(marker, bb_on_marker, &full);
+    tick_detector_set_callback(bb->tick, bb_on_tick, &base);
+    marker_detector_set_callback(bb->marker, bb_on_marker, &base);
+
+    uint64_t full_ns = 0, base_ns = 0;
+    for (int sec = 0; sec < BB_CHECK_SEC; sec++) {
+        size_t det_n, disp_n;
+        source_next(&src, 1.0, &det_n, &disp_n);
+        for (size_t k = 0; k < det_n; k += BB_CHECK_BLOCK) {
+            size_t n = (det_n - k < BB_CHECK_BLOCK) ? det_n - k : BB_CHECK_BLOCK;
+            uint64_t t0 = bench_now_ns();
+            tick_detector_process_block(tick, src.det_i + k, src.det_q + k, n);
+            marker_detector_process_block(marker, src.det_i + k, src.det_q + k, n);
+            uint64_t t1 = bench_now_ns();
+            baseband_frontend_process(bb->fe, src.det_i + k, src.det_q + k, n);
+            base_ns += bench_now_ns() - t1;
+            full_ns += t1 - t0;
+        }
+    }
+    tick_detector_destroy(tick);
+    marker_detector_destroy(marker);
+    destroy_baseband(bb);
+    source_close(&src);
+
+    /* Both lists are in time order: pair ticks by frame timestamp */
+    int matched = 0, agreed = 0;
+    double sum_abs = 0.0, worst = 0.0;
+    int nf = (full.ticks < BB_CHECK_MAX_TICKS) ? full.ticks : BB_CHECK_MAX_TICKS;
+    int nb = (base.ticks < BB_CHECK_MAX_TICKS) ? base.ticks : BB_CHECK_MAX_TICKS;
+    for (int b = 0, f = 0; b < nb && f < nf;) {
+        double dt = base.timestamp_ms[b] - full.timestamp_ms[f];
+        if (dt < -BB_CHECK_MATCH_MS) { b++; continue; }
+        if (dt > BB_CHECK_MATCH_MS) { f++; continue; }
+        if (base.refined[b] && full.refined[f]) {
+            double d = fabs(base.epoch_ms[b] - full.epoch_ms[f]);
+            matched++;
+            if (d <= BB_CHECK_AGREE_MS) {
+                sum_abs += d;
+                if (d > worst) worst = d;
+                agreed++;
+            }
+        }
+        b++;
+        f++;
+    }
+    double mean_abs = agreed ? sum_abs / agreed : 0.0;
+    uint64_t samples = (uint64_t)BB_CHECK_SEC * BENCH_DETECTOR_RATE;
+    double full_per = (double)full_ns / samples;
+    double base_per = (double)base_ns / samples;
+
+    bool ok = abs(full.ticks - base.ticks) <= BB_CHECK_COUNT_SLACK &&
+              full.markers == base.markers &&
+              agreed >= (int)(full.ticks * BB_CHECK_MIN_AGREE) && agreed > 0 &&
+              base.refined_count >= full.refined_count - BB_CHECK_COUNT_SLACK &&
+              mean_abs <= BB_CHECK_MAX_EPOCH_MS;
+    fprintf(stderr, "[BENCH] baseband  ticks %d / %d (50 kHz / baseband), refined %d / %d  "
+                    "markers %d / %d\n",
+            full.ticks, base.ticks, full.refined_count, base.refined_count,
+            full.markers, base.markers);
+    fprintf(stderr, "[BENCH] baseband  epoch |diff| mean %.4f ms  max %.4f ms over %d ticks, "
+                    "%d on different start frames\n",
+            mean_abs, worst, agreed, matched - agreed);
+    fprintf(stderr, "[BENCH] baseband  tick+marker %.2f ns/sample  baseband %.2f (%.1fx)  %s\n",
+            full_per, base_per, base_per > 0.0 ? full_per / base_per : 0.0, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+/*============================================================================
+ * Sliding BCD Check
+ *============================================================================*/
+
+#define BS_CHECK_SEC            180
+#define BS_CHECK_BLOCK          5000
+#define BS_CHECK_MAX_PULSES     256
+#define BS_CHECK_MATCH_MS       82.0    /* Two FFT frames: starts and ends this close agree */
+#define BS_CHECK_MAX_SNR_DB     1.0     /* Mean |SNR difference| allowed */
+
+typedef struct {
+    double timestamp_ms[BS_CHECK_MAX_PULSES];
+    float duration_ms[BS_CHECK_MAX_PULSES];
+    float snr_db[BS_CHECK_MAX_PULSES];
+    int pulses;
+} bs_events_t;
+
+static void bs_on_pulse(const bcd_freq_event_t *event, void *user_data) {
+    bs_events_t *ev = (bs_events_t *)user_data;
+    if (ev->pulses < BS_CHECK_MAX_PULSES) {
+        ev->timestamp_ms[ev->pulses] = event->timestamp_ms;
+        ev->duration_ms[ev->pulses] = event->duration_ms;
+        ev->snr_db[ev->pulses] = event->snr_db;
+        ev->pulses++;
+    }
+}
+
+/* Fractional part of x / step, in steps: 0 when x sits on the grid */
+static double off_grid(double x, double step) {
+    double r = fmod(x / step, 1.0);
+    return (r > 0.5) ? 1.0 - r : r;
+}
+
+/*
+ * The same synthetic signal through both modes: the same pulses, each
+ * start and end within two FFT frames of the other and SNR on the same
+ * scale, and sliding mode cheaper. FFT mode only sees a threshold
+ * crossing at its next frame, and both cross on the 1 s accumulator's
+ * ramp, so a frame of quantization moves an edge by more than a frame.
+ * The FFT widths all fall on its frame grid; the sliding widths resolve
+ * the spread in between.
+ */
+static bool run_bcd_sliding_check(void) {
+    wwv_synth_config_t synth = WWV_SYNTH_CONFIG_DEFAULT;
+    bench_source_t src;
+    if (!source_open(&src, &synth, false)) {
+        source_close(&src);
+        return false;
+    }
+
+    static bs_events_t fft_ev, sl_ev;
+    memset(&fft_ev, 0, sizeof(fft_ev));
+    memset(&sl_ev, 0, sizeof(sl_ev));
+    bcd_freq_detector_t *fft = bcd_freq_detector_create(NULL);
+    bcd_freq_detector_t *sl = bcd_freq_detector_create_sliding(NULL);
+    if (!fft || !sl) {
+        bcd_freq_detector_destroy(fft);
+        bcd_freq_detector_destroy(sl);
+        source_close(&src);
+        return false;
+    }
+    bcd_freq_detector_set_callback(fft, bs_on_pulse, &fft_ev);
+    bcd_freq_detector_set_callback(sl, bs_on_pulse, &sl_ev);
+
+    uint64_t fft_ns = 0, sl_ns = 0;
+    for (int sec = 0; sec < BS_CHECK_SEC; sec++) {
+        size_t det_n, disp_n;
+        source_next(&src, 1.0, &det_n, &disp_n);
+        for (size_t k = 0; k < det_n; k += BS_CHECK_BLOCK) {
+            size_t n = (det_n - k < BS_CHECK_BLOCK) ? det_n - k : BS_CHECK_BLOCK;
+            uint64_t t0 = bench_now_ns();
+            bcd_freq_detector_process_block(fft, src.det_i + k, src.det_q + k, n);
+            uint64_t t1 = bench_now_ns();
+            bcd_freq_detector_process_block(sl, src.det_i + k, src.det_q + k, n);
+            sl_ns += bench_now_ns() - t1;
+            fft_ns += t1 - t0;
+        }
+    }
+    float frame_ms = bcd_freq_detector_get_frame_duration_ms();
+    float hop_ms = bcd_freq_detector_get_hop_ms(sl);
+    bcd_freq_detector_destroy(fft);
+    bcd_freq_detector_destroy(sl);
+    source_close(&src);
+
+    /* Pair pulses in time order; a start or end further apart fails */
+    int matched = 0;
+    double start_sum = 0.0, width_sum = 0.0, snr_sum = 0.0;
+    double fft_grid = 0.0, sl_grid = 0.0;
+    bool apart = false;
+    for (int a = 0, b = 0; a < fft_ev.pulses && b < sl_ev.pulses;) {
+        double dt = sl_ev.timestamp_ms[b] - fft_ev.timestamp_ms[a];
+        if (dt < -BS_CHECK_MATCH_MS * 2) { b++; continue; }
+        if (dt > BS_CHECK_MATCH_MS * 2) { a++; continue; }
+        double d_end = dt + sl_ev.duration_ms[b] - fft_ev.duration_ms[a];
+        if (fabs(dt) > BS_CHECK_MATCH_MS || fabs(d_end) > BS_CHECK_MATCH_MS) apart = true;
+        start_sum += fabs(dt);
+        width_sum += fabs(sl_ev.duration_ms[b] - fft_ev.duration_ms[a]);
+        snr_sum += fabs(sl_ev.snr_db[b] - fft_ev.snr_db[a]);
+        fft_grid += off_grid(fft_ev.duration_ms[a], frame_ms);
+        sl_grid += off_grid(sl_ev.duration_ms[b], frame_ms);
+        matched++;
+        a++;
+        b++;
+    }
+    double n = matched ? (double)matched : 1.0;
+    uint64_t samples = (uint64_t)BS_CHECK_SEC * BENCH_DETECTOR_RATE;
+    double fft_per = (double)fft_ns / samples;
+    double sl_per = (double)sl_ns / samples;
+
+    /* Timing is for reading: wall clock under a loaded ctest decides nothing */
+    bool ok = matched > 0 && fft_ev.pulses == sl_ev.pulses && matched == fft_ev.pulses &&
+              !apart && snr_sum / n <= BS_CHECK_MAX_SNR_DB;
+    fprintf(stderr, "[BENCH] bcd_sliding  pulses %d / %d (FFT / sliding), %d paired%s\n",
+            fft_ev.pulses, sl_ev.pulses, matched, apart ? ", some over two frames apart" : "");
+    fprintf(stderr, "[BENCH] bcd_sliding  |start diff| mean %.1f ms  |width diff| mean %.1f ms  "
+                    "|SNR diff| mean %.2f dB\n",
+            start_sum / n, width_sum / n, snr_sum / n);
+    fprintf(stderr, "[BENCH] bcd_sliding  width step %.2f / %.2f ms, mean off frame grid %.2f / %.2f\n",
+            frame_ms, hop_ms, fft_grid / n, sl_grid / n);
+    fprintf(stderr, "[BENCH] bcd_sliding  FFT %.2f ns/sample  sliding %.2f (%.1fx)  %s\n",
+            fft_per, sl_per, sl_per > 0.0 ? fft_per / sl_per : 0.0, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+/*============================================================================
+ * Goertzel Check
+ *============================================================================*/
+
+#define GZ_CHECK_SEC            180
+#define GZ_CHECK_BLOCK          5000
+#define GZ_CHECK_MAX_EVENTS     256
+#define GZ_CHECK_FRAME          256     /* MARKER_FFT_SIZE == BCD_TIME_FFT_SIZE */
+#define GZ_CHECK_MAX_REL        1e-3    /* Worst |Goertzel - FFT| over the band's mean energy */
+#define GZ_CHECK_KEYED_SEC      60      /* Keyed 100 Hz pass for the BCD time detector */
+#define GZ_CHECK_TONE_LEVEL     0.5f
+#define GZ_CHECK_NOISE_LEVEL    0.05f
+
+typedef struct {
+    const char *name;
+    float freq, bandwidth;
+    fft_processor_t *fft;
+    goertzel_bank_t *gb;
+    int fft_band, gb_band;
+    double fft_sum;                 /* For the mean FFT energy */
+    double worst;                   /* Largest |Goertzel - FFT| */
+    int frames;
+} gz_band_t;
+
+typedef struct {
+    double timestamp_ms[GZ_CHECK_MAX_EVENTS];
+    int events;
+} gz_events_t;
+
+static void gz_record(gz_events_t *ev, double timestamp_ms) {
+    if (ev->events < GZ_CHECK_MAX_EVENTS) ev->timestamp_ms[ev->events] = timestamp_ms;
+    ev->events++;
+}
+
+static void gz_on_marker(const marker_event_t *event, void *user_data) {
+    gz_record((gz_events_t *)user_data, event->timestamp_ms);
+}
+
+static void gz_on_bcd(const bcd_time_event_t *event, void *user_data) {
+    gz_record((gz_events_t *)user_data, event->timestamp_ms);
+}
+
+/*
+ * The synthetic broadcast's 100 Hz subcarrier never drops to the BCD time
+ * detector's noise floor, so that detector gets its own signal: noise for
+ * the first second (warmup), then a 100 Hz tone keyed on for 200, 500 or
+ * 800 ms at the top of every second
+ */
+static void gz_keyed_second(int sec, uint32_t *seed, float *i, float *q, size_t n) {
+    static const int on_ms[3] = { 200, 500, 800 };
+    size_t on = (sec == 0) ? 0 : (size_t)on_ms[sec % 3] * (n / 1000);
+    for (size_t k = 0; k < n; k++) {
+        *seed = *seed * 1664525u + 1013904223u;
+        float ni = ((float)(*seed >> 8) / 16777216.0f - 0.5f) * 2.0f * GZ_CHECK_NOISE_LEVEL;
+        *seed = *seed * 1664525u + 1013904223u;
+        float nq = ((float)(*seed >> 8) / 16777216.0f - 0.5f) * 2.0f * GZ_CHECK_NOISE_LEVEL;
+        double phase = 2.0 * M_PI * BCD_TIME_TARGET_FREQ_HZ * (double)k / (double)n;
+        float level = (k < on) ? GZ_CHECK_TONE_LEVEL : 0.0f;
+        i[k] = level * (float)cos(phase) + ni;
+        q[k] = level * (float)sin(phase) + nq;
+    }
+}
+
+/* Events missing from either list or on a different frame */
+static int gz_mismatched(const gz_events_t *a, const gz_events_t *b) {
+    int n = (a->events < b->events) ? a->events : b->events;
+    if (n > GZ_CHECK_MAX_EVENTS) n = GZ_CHECK_MAX_EVENTS;
+    int bad = abs(a->events - b->events);
+    for (int k = 0; k < n; k++) {
+        if (fabs(a->timestamp_ms[k] - b->timestamp_ms[k]) > 1e-6) bad++;
+    }
+    return bad;
+}
+
+static bool gz_band_open(gz_band_t *band) {
+    band->fft = fft_processor_create(GZ_CHECK_FRAME, BENCH_DETECTOR_RATE);
+    band->gb = goertzel_bank_create(GZ_CHECK_FRAME, BENCH_DETECTOR_RATE, FFT_WINDOW_HANN);
+    if (!band->fft || !band->gb) return false;
+    band->fft_band = fft_processor_add_band(band->fft, band->freq, band->bandwidth, FFT_BAND_MAGNITUDE);
+    band->gb_band = goertzel_bank_add_band(band->gb, band->freq, band->bandwidth);
+    return band->fft_band >= 0 && band->gb_band >= 0;
+}
+
+/* One frame through both front ends */
+static void gz_band_frame(gz_band_t *band, const float *i, const float *q) {
+    fft_processor_process(band->fft, i, q);
+    goertzel_bank_process_block(band->gb, i, q, GZ_CHECK_FRAME);
+    if (!goertzel_bank_frame_ready(band->gb)) return;
+    float f = fft_processor_get_band(band->fft, band->fft_band);
+    float g = goertzel_bank_get_band(band->gb, band->gb_band);
+    double d = fabs((double)g - (double)f);
+    if (d > band->worst) band->worst = d;
+    band->fft_sum += f;
+    band->frames++;
+}
+
+/*
+ * The marker and BCD time bands through fft_processor and the Goertzel
+ * bank frame by frame, then each detector in FFT and Goertzel mode over
+ * the same signal (the broadcast for the marker, the keyed tone for BCD
+ * time): the band energies must agree to GZ_CHECK_MAX_REL of the band's
+ * mean and every marker and BCD time pulse must come out on the same
+ * frame in both modes. The cost of each mode is reported, not judged.
+ */
+static bool run_goertzel_check(void) {
+    wwv_synth_config_t synth = WWV_SYNTH_CONFIG_DEFAULT;
+    bench_source_t src;
+    if (!source_open(&src, &synth, false)) {
+        source_close(&src);
+        return false;
+    }
+
+    gz_band_t bands[2] = {
+        { .name = "marker", .freq = MARKER_TARGET_FREQ_HZ, .bandwidth = MARKER_BANDWIDTH_HZ },
+        { .name = "bcd_time", .freq = BCD_TIME_TARGET_FREQ_HZ, .bandwidth = BCD_TIME_BANDWIDTH_HZ }
+    };
+    static gz_events_t mk_fft, mk_gz, bcd_fft, bcd_gz;
+    memset(&mk_fft, 0, sizeof(mk_fft));
+    memset(&mk_gz, 0, sizeof(mk_gz));
+    memset(&bcd_fft, 0, sizeof(bcd_fft));
+    memset(&bcd_gz, 0, sizeof(bcd_gz));
+    marker_detector_t *mk[2] = { marker_detector_create(NULL), marker_detector_create(NULL) };
+    bcd_time_detector_t *bcd[2] = { bcd_time_detector_create(NULL), bcd_time_detector_create(NULL) };
+    bool ok = gz_band_open(&bands[0]) && gz_band_open(&bands[1]) && mk[0] && mk[1] && bcd[0] && bcd[1] &&
+              marker_detector_set_spectral_mode(mk[1], SPECTRAL_MODE_GOERTZEL) &&
+              bcd_time_detector_set_spectral_mode(bcd[1], SPECTRAL_MODE_GOERTZEL);
+    float frame_i[GZ_CHECK_FRAME], frame_q[GZ_CHECK_FRAME];
+    size_t filled = 0;
+    uint64_t fft_ns = 0, gz_ns = 0;
+
+    if (ok) {
+        marker_detector_set_callback(mk[0], gz_on_marker, &mk_fft);
+        marker_detector_set_callback(mk[1], gz_on_marker, &mk_gz);
+        bcd_time_detector_set_callback(bcd[0], gz_on_bcd, &bcd_fft);
+        bcd_time_detector_set_callback(bcd[1], gz_on_bcd, &bcd_gz);
+        for (int sec = 0; sec < GZ_CHECK_SEC; sec++) {
+            size_t det_n, disp_n;
+            source_next(&src, 1.0, &det_n, &disp_n);
+            for (size_t k = 0; k < det_n; k++) {
+                frame_i[filled] = src.det_i[k];
+                frame_q[filled] = src.det_q[k];
+                if (++filled < GZ_CHECK_FRAME) continue;
+                gz_band_frame(&bands[0], frame_i, frame_q);
+                gz_band_frame(&bands[1], frame_i, frame_q);
+                filled = 0;
+            }
+            for (size_t k = 0; k < det_n; k += GZ_CHECK_BLOCK) {
+                size_t n = (det_n - k < GZ_CHECK_BLOCK) ? det_n - k : GZ_CHECK_BLOCK;
+                uint64_t t0 = bench_now_ns();
+                marker_detector_process_block(mk[0], src.det_i + k, src.det_q + k, n);
+                uint64_t t1 = bench_now_ns();
+                marker_detector_process_block(mk[1], src.det_i + k, src.det_q + k, n);
+                gz_ns += bench_now_ns() - t1;
+                fft_ns += t1 - t0;
+            }
+        }
+
+        /* The source's buffers hold one detector-path second */
+        uint32_t seed = 1;
+        for (int sec = 0; sec < GZ_CHECK_KEYED_SEC; sec++) {
+            gz_keyed_second(sec, &seed, src.det_i, src.det_q, BENCH_DETECTOR_RATE);
+            for (size_t k = 0; k < BENCH_DETECTOR_RATE; k += GZ_CHECK_BLOCK) {
+                uint64_t t0 = bench_now_ns();
+                bcd_time_detector_process_block(bcd[0], src.det_i + k, src.det_q + k, GZ_CHECK_BLOCK);
+                uint64_t t1 = bench_now_ns();
+                bcd_time_detector_process_block(bcd[1], src.det_i + k, src.det_q + k, GZ_CHECK_BLOCK);
+                gz_ns += bench_now_ns() - t1;
+                fft_ns += t1 - t0;
+            }
+        }
+    }
+    for (int m = 0; m < 2; m++) {
+        marker_detector_destroy(mk[m]);
+        bcd_time_detector_destroy(bcd[m]);
+        fft_processor_destroy(bands[m].fft);
+        goertzel_bank_destroy(bands[m].gb);
+    }
+    source_close(&src);
+    if (!ok) {
+        fprintf(stderr, "[BENCH] goertzel  detector or bank setup failed  FAIL\n");
+        return false;
+    }
+
+    bool bands_ok = true;
+    for (int m = 0; m < 2; m++) {
+        gz_band_t *band = &bands[m];
+        double mean = band->frames ? band->fft_sum / band->frames : 0.0;
+        double rel = mean > 0.0 ? band->worst / mean : 1.0;
+        bool band_ok = band->frames > 0 && rel <= GZ_CHECK_MAX_REL;
+        bands_ok = bands_ok && band_ok;
+        fprintf(stderr, "[BENCH] goertzel  %-8s band %.0f +/- %.0f Hz: %d frames, worst |diff| "
+                "%.2e of mean energy %.4g  %s\n", band->name, band->freq, band->bandwidth,
+                band->frames, rel, mean, band_ok ? "ok" : "FAIL");
+    }
+    int mk_bad = gz_mismatched(&mk_fft, &mk_gz);
+    int bcd_bad = gz_mismatched(&bcd_fft, &bcd_gz);
+    bool events_ok = mk_fft.events > 0 && bcd_fft.events > 0 && mk_bad == 0 && bcd_bad == 0;
+    fprintf(stderr, "[BENCH] goertzel  markers %d / %d, BCD time pulses %d / %d (FFT / Goertzel), "
+            "%d on another frame or missing  %s\n", mk_fft.events, mk_gz.events, bcd_fft.events,
+            bcd_gz.events, mk_bad + bcd_bad, events_ok ? "ok" : "FAIL");
+
+    /* Timing is for reading: wall clock under a loaded ctest decides nothing */
+    uint64_t samples = (uint64_t)(GZ_CHECK_SEC + GZ_CHECK_KEYED_SEC) * BENCH_DETECTOR_RATE;
+    double fft_per = (double)fft_ns / samples;
+    double gz_per = (double)gz_ns / samples;
+    fprintf(stderr, "[BENCH] goertzel  marker+bcd_time FFT %.2f ns/sample  Goertzel %.2f (%.1fx)\n",
+            fft_per, gz_per, gz_per > 0.0 ? fft_per / gz_per : 0.0);
+    return bands_ok && events_ok;
+}
+
+/*============================================================================
+ * Adaptive BCD Check
+ *============================================================================*/
+
+#define BA_CHECK_SEC            65      /* The synthetic BCD freq pulses all fall in minute 0 */
+#define BA_CHECK_IDLE_FROM_SEC  10      /* Detector idled over [from, to) */
+#define BA_CHECK_IDLE_TO_SEC    30
+#define BA_CHECK_SETTLE_MS      3000.0  /* Refill plus a pulse in flight at resume */
+
+/* One scripted stretch of channel: SNR (alternating every flip_s when
+ * snr_alt differs), time pulses every second, freq pulses at freq_off_ms
+ * from them (or none) */
+typedef struct {
+    int seconds;
+    float snr_db;
+    float snr_alt;
+    int flip_s;
+    bool time_pulses;
+    bool freq_pulses;
+    double freq_off_ms;
+    bcd_path_mode_t expect;     /* Mode at the end of the stretch */
+    int switches;               /* Switches within it */
+    const char *name;
+} ba_phase_t;
+
+static bool ba_run_phases(bcd_path_policy_t *p, const ba_phase_t *phases, int count,
+                          double *now_ms) {
+    bool ok = true;
+    for (int k = 0; k < count; k++) {
+        const ba_phase_t *ph = &phases[k];
+        bcd_path_status_t before, after;
+        bcd_path_policy_get_status(p, &before);
+        for (int sec = 0; sec < ph->seconds; sec++) {
+            /* Pulses land mid-second, the evaluation at its end */
+            double pulse_ms = *now_ms + 300.0;
+            if (ph->time_pulses) bcd_path_policy_time_pulse(p, pulse_ms);
+            if (ph->freq_pulses && bcd_path_policy_get_mode(p) == BCD_PATH_DUAL) {
+                bcd_path_policy_freq_pulse(p, pulse_ms + ph->freq_off_ms);
+            }
+            *now_ms += 1000.0;
+            bool alt = ph->flip_s > 0 && (sec / ph->flip_s) % 2 == 1;
+            bcd_path_policy_update(p, *now_ms, alt ? ph->snr_alt : ph->snr_db, true);
+        }
+        bcd_path_policy_get_status(p, &after);
+        int switches = (int)(after.switches - before.switches);
+        bool good = after.mode == ph->expect && switches == ph->switches;
+        fprintf(stderr, "[BENCH] bcd_adaptive  %-18s %3d s  %-9s (%s) %d switch%s  %s\n",
+                ph->name, ph->seconds, bcd_path_mode_name(after.mode),
+                bcd_path_reason_name(after.reason), switches, switches == 1 ? "" : "es",
+                good ? "ok" : "FAIL");
+        ok = ok && good;
+    }
+    return ok;
+}
+
+static bool ba_check_policy(void) {
+    static const ba_phase_t phases[] = {
+        /* Both paths agree on a strong channel: idle after the dwell */
+        { 120, 30.0f, 30.0f,  0, true, true,    0.0, BCD_PATH_TIME_ONLY, 1, "strong" },
+        /* Swings inside the hysteresis band leave it idle */
+        { 300, 17.0f, 25.0f,  3, true, true,    0.0, BCD_PATH_TIME_ONLY, 0, "near thresholds" },
+        { 10,  10.0f, 10.0f,  0, true, true,    0.0, BCD_PATH_DUAL,      1, "fade" },
+        /* Across both thresholds, but never strong for the hold time */
+        { 600, 12.0f, 26.0f, 10, true, true,    0.0, BCD_PATH_DUAL,      0, "oscillating" },
+        /* Strong, but the paths disagree */
+        { 180, 30.0f, 30.0f,  0, true, true,  400.0, BCD_PATH_DUAL,      0, "disagreeing" },
+        { 120, 30.0f, 30.0f,  0, true, true,    0.0, BCD_PATH_TIME_ONLY, 1, "strong again" },
+        /* Carrier stays up but the time path goes quiet */
+        { 15,  30.0f, 30.0f,  0, false, true,   0.0, BCD_PATH_DUAL,      1, "time path lost" },
+    };
+    bcd_path_policy_t *p = bcd_path_policy_create(NULL);
+    if (!p) return false;
+    double now_ms = 0.0;
+    bcd_path_policy_update(p, now_ms, 0.0f, false);
+    bool ok = ba_run_phases(p, phases, (int)(sizeof(phases) / sizeof(phases[0])), &now_ms);
+    bcd_path_policy_destroy(p);
+    return ok;
+}
+
+/*
+ * Resume: once the idled detector has refilled, its pulses must fall on
+ * the reference's sample-clock times (within two FFT frames), none may
+ * come out while idle, and idling must cost under half of running.
+ * The synthetic freq pulses sit just over threshold and the two baselines
+ * took different paths meanwhile, so one pulse either way is allowed.
+ */
+static bool ba_check_resume(void) {
+    wwv_synth_config_t synth = WWV_SYNTH_CONFIG_DEFAULT;
+    bench_source_t src;
+    if (!source_open(&src, &synth, false)) {
+        source_close(&src);
+        return false;
+    }
+
+    static bs_events_t ref_ev, idle_ev;
+    memset(&ref_ev, 0, sizeof(ref_ev));
+    memset(&idle_ev, 0, sizeof(idle_ev));
+    bcd_freq_detector_t *ref = bcd_freq_detector_create(NULL);
+    bcd_freq_detector_t *idl = bcd_freq_detector_create(NULL);
+    if (!ref || !idl) {
+        bcd_freq_detector_destroy(ref);
+        bcd_freq_detector_destroy(idl);
+        source_close(&src);
+        return false;
+    }
+    bcd_freq_detector_set_callback(ref, bs_on_pulse, &ref_ev);
+    bcd_freq_detector_set_callback(idl, bs_on_pulse, &idle_ev);
+
+    uint64_t active_ns = 0, idle_ns = 0;
+    uint64_t ref_ffts = 0, idle_ffts = 0;       /* Over the idle stretch */
+    int idle_sec = BA_CHECK_IDLE_TO_SEC - BA_CHECK_IDLE_FROM_SEC;
+    int active_sec = 0;
+    for (int sec = 0; sec < BA_CHECK_SEC; sec++) {
+        size_t det_n, disp_n;
+        source_next(&src, 1.0, &det_n, &disp_n);
+        if (sec == BA_CHECK_IDLE_FROM_SEC) bcd_freq_detector_set_idle(idl, true);
+        if (sec == BA_CHECK_IDLE_TO_SEC) bcd_freq_detector_set_idle(idl, false);
+        bool idling = bcd_freq_detector_get_idle(idl);
+        bool before = !idling && sec >= BA_CHECK_IDLE_FROM_SEC - idle_sec &&
+                      sec < BA_CHECK_IDLE_FROM_SEC;
+        if (before) active_sec++;
+        uint64_t ffts = bcd_freq_detector_get_fft_count(idl);
+        uint64_t ref_before = bcd_freq_detector_get_fft_count(ref);
+        for (size_t k = 0; k < det_n; k += BS_CHECK_BLOCK) {
+            size_t n = (det_n - k < BS_CHECK_BLOCK) ? det_n - k : BS_CHECK_BLOCK;
+            uint64_t t0 = bench_now_ns();
+            bcd_freq_detector_process_block(idl, src.det_i + k, src.det_q + k, n);
+            uint64_t t1 = bench_now_ns();
+            bcd_freq_detector_process_block(ref, src.det_i + k, src.det_q + k, n);
+            if (idling) idle_ns += t1 - t0;
+            /* The same number of seconds just before the idle stretch */
+            else if (before) active_ns += t1 - t0;
+        }
+        if (idling) {
+            idle_ffts += bcd_freq_detector_get_fft_count(idl) - ffts;
+            ref_ffts += bcd_freq_detector_get_fft_count(ref) - ref_before;
+        }
+    }
+    bcd_freq_detector_destroy(ref);
+    bcd_freq_detector_destroy(idl);
+    source_close(&src);
+
+    double resume_ms = BA_CHECK_IDLE_TO_SEC * 1000.0;
+    double idle_from_ms = BA_CHECK_IDLE_FROM_SEC * 1000.0;
+    int ref_after = 0, idle_after = 0, matched = 0, during = 0;
+    double worst = 0.0;
+    for (int a = 0; a < idle_ev.pulses; a++) {
+        double ts = idle_ev.timestamp_ms[a];
+        if (ts >= idle_from_ms && ts < resume_ms) during++;
+    }
+    for (int a = 0; a < ref_ev.pulses; a++) {
+        if (ref_ev.timestamp_ms[a] < resume_ms + BA_CHECK_SETTLE_MS) continue;
+        ref_after++;
+        for (int b = 0; b < idle_ev.pulses; b++) {
+            double d = fabs(idle_ev.timestamp_ms[b] - ref_ev.timestamp_ms[a]);
+            if (d <= BS_CHECK_MATCH_MS) {
+                if (d > worst) worst = d;
+                matched++;
+                break;
+            }
+        }
+    }
+    for (int b = 0; b < idle_ev.pulses; b++) {
+        if (idle_ev.timestamp_ms[b] >= resume_ms + BA_CHECK_SETTLE_MS) idle_after++;
+    }
+
+    /* Work, not wall clock: one of the reference's FFTs in BCD_FREQ_IDLE_DECIM while idle */
+    bool ok = matched > 0 && matched >= ref_after - 1 && idle_after <= matched + 1 &&
+              during == 0 && ref_ffts > 0 &&
+              idle_ffts <= ref_ffts / BCD_FREQ_IDLE_DECIM + 1;
+    fprintf(stderr, "[BENCH] bcd_adaptive  resume  %d / %d pulses after %.0f s (reference / idled), "
+                    "%d matched, worst %.1f ms, %d while idle\n",
+            ref_after, idle_after, (resume_ms + BA_CHECK_SETTLE_MS) / 1000.0,
+            matched, worst, during);
+    fprintf(stderr, "[BENCH] bcd_adaptive  freq path while idle: %llu FFTs, reference %llu "
+                    "(%.2f ns/sample running, %.2f idle)  %s\n",
+            (unsigned long long)idle_ffts, (unsigned long long)ref_ffts,
+            active_sec ? (double)active_ns / ((uint64_t)active_sec * BENCH_DETECTOR_RATE) : 0.0,
+            (double)idle_ns / ((uint64_t)idle_sec * BENCH_DETECTOR_RATE), ok ? "ok" : "FAIL");
+    return ok;
+}
+
+static bool run_bcd_adaptive_check(void) {
+    bool policy_ok = ba_check_policy();
+    bool resume_ok = ba_check_resume();
+    return policy_ok && resume_ok;
+}
+
+/*============================================================================
+ * Tile Check
+ *============================================================================*/
+
+#define TILE_CHECK_SEC          120
+#define TILE_CHECK_BLOCK        5000
+#define TILE_CHECK_ODD_BLOCK    777     /* Straddles every tile edge differently */
+
+typedef enum {
+    TILE_FEED_BLOCK,
+    TILE_FEED_SAMPLE,
+    TILE_FEED_THREADED
+} tile_feed_t;
+
+/* FNV-1a over every event in delivery order */
+typedef struct {
+    uint64_t hash;
+    int events;
+} tile_digest_t;
+
+static void digest_init(tile_digest_t *d) {
+    d->hash = 14695981039346656037ull;
+    d->events = 0;
+}
+
+static void digest_bytes(tile_digest_t *d, const void *data, size_t len) {
+    const unsigned char *p = (const unsigned char *)data;
+    for (size_t k = 0; k < len; k++) {
+        d->hash = (d->hash ^ p[k]) * 1099511628211ull;
+    }
+}
+
+static void tile_on_tick(const wwv_tick_event_t *e, void *user_data) {
+    tile_digest_t *d = (tile_digest_t *)user_data;
+    digest_bytes(d, "T", 1);
+    digest_bytes(d, &e->tick_number, sizeof(e->tick_number));
+    digest_bytes(d, &e->station, sizeof(e->station));
+    digest_bytes(d, &e->sample_index, sizeof(e->sample_index));
+    digest_bytes(d, &e->epoch_ms, sizeof(e->epoch_ms));
+    digest_bytes(d, &e->energy, sizeof(e->energy));
+    d->events++;
+}
+
+static void tile_on_marker(const wwv_marker_event_t *e, void *user_data) {
+    tile_digest_t *d = (tile_digest_t *)user_data;
+    digest_bytes(d, "M", 1);
+    digest_bytes(d, &e->marker_number, sizeof(e->marker_number));
+    digest_bytes(d, &e->sample_index, sizeof(e->sample_index));
+    digest_bytes(d, &e->duration_ms, sizeof(e->duration_ms));
+    digest_bytes(d, &e->energy, sizeof(e->energy));
+    d->events++;
+}
+
+static void tile_on_sync(const wwv_sync_status_t *e, void *user_data) {
+    tile_digest_t *d = (tile_digest_t *)user_data;
+    digest_bytes(d, "S", 1);
+    digest_bytes(d, &e->is_synced, sizeof(e->is_synced));
+    digest_bytes(d, &e->confidence, sizeof(e->confidence));
+    digest_bytes(d, &e->tick_count, sizeof(e->tick_count));
+    digest_bytes(d, &e->marker_count, sizeof(e->marker_count));
+    d->events++;
+}
+
+static bool tile_setup(wwv_detector_manager_t *mgr, void *user) {
+    tile_digest_t *d = (tile_digest_t *)user;
+    digest_init(d);
+    wwv_detector_manager_set_tick_callback(mgr, tile_on_tick, d);
+    wwv_detector_manager_set_marker_callback(mgr, tile_on_marker, d);
+    wwv_detector_manager_set_sync_callback(mgr, tile_on_sync, d);
+    return true;
+}
+
+/* One manager over TILE_CHECK_SEC of signal; ns covers the feeding only */
+static bool tile_pass(tile_feed_t feed, size_t block, bool tiling, tile_digest_t *d,
+                      uint64_t *ns) {
+    manager_pass_t pass;
+    manager_pass_init(&pass, TILE_CHECK_SEC);
+    pass.config.detector_tiling = tiling;
+    pass.config.threaded = (feed == TILE_FEED_THREADED);
+    pass.block = (feed == TILE_FEED_SAMPLE) ? 0 : block;
+    pass.setup = tile_setup;
+    pass.user = d;
+    return manager_pass(&pass, ns);
+}
+
+/*
+ * Tiles sit on the absolute sample grid, so the event sequence must not
+ * depend on how the samples arrive. The timing pass compares the same
+ * 5000-sample blocks with tiling off.
+ */
+static bool run_tile_check(void) {
+    static const struct {
+        const char *name;
+        tile_feed_t feed;
+        size_t block;
+    } passes[] = {
+        { "block 5000",  TILE_FEED_BLOCK,    TILE_CHECK_BLOCK },
+        { "block 777",   TILE_FEED_BLOCK,    TILE_CHECK_ODD_BLOCK },
+        { "per-sample",  TILE_FEED_SAMPLE,   1 },
+        { "threaded",    TILE_FEED_THREADED, TILE_CHECK_BLOCK },
+    };
+    tile_digest_t ref = { 0, 0 };
+    uint64_t tiled_ns = 0, ns;
+    bool ok = true;
+
+    for (size_t p = 0; p < sizeof(passes) / sizeof(passes[0]); p++) {
+        tile_digest_t d;
+        if (!tile_pass(passes[p].feed, passes[p].block, true, &d, &ns)) return false;
+        if (p == 0) {
+            ref = d;
+            tiled_ns = ns;
+        }
+        bool same = d.hash == ref.hash && d.events == ref.events;
+        ok = ok && same;
+        fprintf(stderr, "[BENCH] tile  %-10s  %d events  digest %016llx  %s\n",
+                passes[p].name, d.events, (unsigned long long)d.hash, same ? "same" : "DIFFERS");
+    }
+
+    tile_digest_t untiled;
+    uint64_t untiled_ns;
+    if (!tile_pass(TILE_FEED_BLOCK, TILE_CHECK_BLOCK, false, &untiled, &untiled_ns)) return false;
+    ok = ok && untiled.events == ref.events;
+
+    uint64_t samples = (uint64_t)TILE_CHECK_SEC * BENCH_DETECTOR_RATE;
+    fprintf(stderr, "[BENCH] tile  untiled     %d events (same count, order %s)\n",
+            untiled.events, untiled.hash == ref.hash ? "same" : "by detector");
+    fprintf(stderr, "[BENCH] tile  manager %.2f ns/sample tiled, %.2f untiled (%.2fx)  %s\n",
+            (double)tiled_ns / samples, (double)untiled_ns / samples,
+            tiled_ns ? (double)untiled_ns / tiled_ns : 0.0, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+/*============================================================================
+ * Consensus Check
+ *============================================================================*/
+
+#define CONS_AGREE          10      /* Sources on the true minute phase */
+#define CONS_OUTLIERS       3       /* Locked on a wrong phase */
+#define CONS_SOURCES        (CONS_AGREE + CONS_OUTLIERS + 1)     /* + one never locks */
+#define CONS_CORRUPT        2       /* Agreeing sources with a third of their bits wrong */
+#define CONS_MINUTES        6
+#define CONS_PHASE_MS       23456.0 /* True minute start within the shared minute */
+#define CONS_MAX_ERROR_MS   2.0
+#define CONS_SCALE_SOURCES  WWV_CONSENSUS_MAX_SOURCES
+#define CONS_SCALE_MINUTES  20
+
+static const double cons_outlier_ms[CONS_OUTLIERS] = { 3200.0, 17000.0, -2700.0 };
+
+typedef struct {
+    uint32_t seed;
+    int corrupt;                /* Sources 0..corrupt-1 send bad bits */
+    uint64_t records;
+    uint64_t ns;
+} cons_run_t;
+
+/* Sample clock of source k started k * 1.37 s before the shared one */
+static double cons_offset_ms(int k) {
+    return k * -1370.0;
+}
+
+static void cons_send(wwv_consensus_t *c, int id, telem_wire_frame_t *frame, uint32_t *seq,
+                      cons_run_t *run) {
+    size_t len = telem_wire_frame_finish(frame, (*seq)++);
+    if (len) {
+        uint64_t t0 = bench_now_ns();
+        wwv_consensus_ingest_datagram(c, id, frame->data, len);
+        run->ns += bench_now_ns() - t0;
+        run->records += frame->record_count;
+    }
+    telem_wire_frame_reset(frame);
+}
+
+/*
+ * One second of every source's telemetry: a sync record on each source's
+ * own minute start, and the BCD symbol window of that second.
+ */
+static void cons_second(wwv_consensus_t *c, const wwv_synth_t *synth, int sources,
+                        int minute, int second, cons_run_t *run) {
+    static telem_wire_frame_t frame;
+    static uint32_t seq;
+
+    for (int k = 0; k < sources; k++) {
+        bool outlier = k >= CONS_AGREE && k < CONS_AGREE + CONS_OUTLIERS;
+        bool never = sources == CONS_SOURCES && k == CONS_SOURCES - 1;
+        double phase = CONS_PHASE_MS + (outlier ? cons_outlier_ms[k - CONS_AGREE] : 0.0);
+        double start_ms = minute * 60000.0 + phase + 4.0 * kc_uniform(&run->seed);
+        double stream = start_ms - cons_offset_ms(k);
+
+        telem_wire_frame_reset(&frame);
+        if (second == 0) {
+            telem_rec_sync_t rec = {
+                .confirmed_count = (uint32_t)minute + 1,
+                .state = (uint8_t)(never ? SYNC_ACQUIRING : (k % 4 == 3) ? SYNC_TENTATIVE
+                                                                         : SYNC_LOCKED),
+                .interval_sec = 60.0f
+            };
+            telem_wire_frame_append(&frame, 4, TELEM_REC_SYNC, 0,
+                                    never ? 0 : telem_ms_to_us(stream), &rec, sizeof(rec));
+        }
+
+        int sym = wwv_synth_bcd_symbol(synth, minute, second);
+        if (sym >= 0 && k < run->corrupt && sym != 2 && (kc_rand(&run->seed) % 3) == 0) {
+            sym ^= 1;
+        }
+        if (sym >= 0) {
+            telem_rec_bcd_symbol_t rec = {
+                .number = (uint32_t)(minute * 60 + second),
+                .symbol = (int8_t)sym,
+                .second = (int8_t)second,
+                .state = BCD_CORR_TRACKING,
+                .confidence = 0.6f
+            };
+            telem_wire_frame_append(&frame, 5, TELEM_REC_BCD_SYMBOL, 0,
+                                    telem_ms_to_us(stream + second * 1000.0 + 500.0),
+                                    &rec, sizeof(rec));
+        }
+        cons_send(c, k, &frame, &seq, run);
+    }
+}
+
+static wwv_consensus_t *cons_create(int sources) {
+    wwv_consensus_t *c = wwv_consensus_create(NULL);
+    if (!c) return NULL;
+    for (int k = 0; k < sources; k++) {
+        char name[16];
+        snprintf(name, sizeof(name), "rx%02d", k);
+        int id = wwv_consensus_add_source(c, name);
+        wwv_consensus_set_source_offset(c, id, cons_offset_ms(k));
+        /* Quality from 8 to 30 dB SNR */
+        channel_quality_report_t q = { .snr_db = 8.0f + (k * 7) % 23, .valid = true };
+        wwv_consensus_set_source_quality(c, id, &q);
+    }
+    return c;
+}
+
+/*
+ * Sources, outliers and corrupted bits all go through wire datagrams; it
+ * fails unless the agreeing cluster wins with the true phase, the vote
+ * decodes the true time, and a single source cannot make a solution.
+ */
+static bool run_consensus_check(void) {
+    wwv_synth_config_t sc = WWV_SYNTH_CONFIG_DEFAULT;
+    wwv_synth_t *synth = wwv_synth_create(&sc);
+    wwv_consensus_t *c = cons_create(CONS_SOURCES);
+    if (!synth || !c) {
+        wwv_synth_destroy(synth);
+        wwv_consensus_destroy(c);
+        return false;
+    }
+
+    cons_run_t run = { .seed = 12345u, .corrupt = CONS_CORRUPT };
+    wwv_consensus_solution_t sol;
+    bool ok = true;
+
+    /* One locked source alone is not a consensus */
+    wwv_consensus_add_anchor(c, 0, CONS_PHASE_MS - cons_offset_ms(0), SYNC_LOCKED);
+    bool lone = wwv_consensus_get_solution(c, &sol);
+    ok = ok && !lone;
+    wwv_consensus_reset(c);
+
+    int first_minute = -1;
+    for (int m = 0; m < CONS_MINUTES; m++) {
+        for (int s = 0; s < 60; s++) {
+            cons_second(c, synth, CONS_SOURCES, m, s, &run);
+            if (first_minute < 0 && wwv_consensus_get_solution(c, &sol)) first_minute = m;
+        }
+    }
+
+    bool agreed = wwv_consensus_get_solution(c, &sol);
+    double err = fmod(sol.minute_anchor_ms - CONS_PHASE_MS, 60000.0);
+    if (err > 30000.0) err -= 60000.0;
+    if (err < -30000.0) err += 60000.0;
+
+    int expect_minute = -1;
+    if (sol.has_time) {
+        expect_minute = sc.start_minute +
+                        (int)floor((sol.time.minute_start_ms - CONS_PHASE_MS) / 60000.0 + 0.5);
+    }
+    bool time_ok = sol.has_time && sol.time.minute == expect_minute &&
+                   sol.time.hour == sc.start_hour && sol.time.day == sc.start_day &&
+                   sol.time.year == sc.year;
+    ok = ok && agreed && first_minute == 0 && fabs(err) <= CONS_MAX_ERROR_MS &&
+         sol.agree_sources == CONS_AGREE && time_ok;
+
+    wwv_consensus_print_stats(c);
+    fprintf(stderr, "[BENCH] consensus  lone source %s, agreed from minute %d: %d/%d sources "
+            "weight %.2f/%.2f, anchor error %+.2f ms (spread %.1f)\n",
+            lone ? "AGREED" : "refused", first_minute, sol.agree_sources, sol.anchored_sources,
+            sol.agree_weight, sol.total_weight, err, sol.spread_ms);
+    if (sol.has_time) {
+        fprintf(stderr, "[BENCH] consensus  time day %03d %02d:%02d year %02d (expected %02d:%02d) "
+                "margin %.1f\n", sol.time.day, sol.time.hour, sol.time.minute, sol.time.year,
+                sc.start_hour, expect_minute, sol.time.margin);
+    } else {
+        fprintf(stderr, "[BENCH] consensus  no time decoded\n");
+    }
+    wwv_consensus_destroy(c);
+
+    /* Cost per record at the source limit */
+    wwv_consensus_t *big = cons_create(CONS_SCALE_SOURCES);
+    cons_run_t scale = { .seed = 777u, .corrupt = 0 };
+    if (!big) {
+        wwv_synth_destroy(synth);
+        return false;
+    }
+    for (int m = 0; m < CONS_SCALE_MINUTES; m++) {
+        for (int s = 0; s < 60; s++) cons_second(big, synth, CONS_SCALE_SOURCES, m, s, &scale);
+    }
+    bool big_ok = wwv_consensus_get_solution(big, &sol);
+    ok = ok && big_ok;
+    fprintf(stderr, "[BENCH] consensus  %d sources: %llu records, %.0f ns/record "
+            "(%.1f us per second of all inputs)  %s\n",
+            CONS_SCALE_SOURCES, (unsigned long long)scale.records,
+            scale.records ? (double)scale.ns / scale.records : 0.0,
+            (double)scale.ns / (CONS_SCALE_MINUTES * 60) / 1000.0, ok ? "ok" : "FAIL");
+    wwv_consensus_destroy(big);
+    wwv_synth_destroy(synth);
+    return ok;
+}
+
+/*============================================================================
+ * History Check
+ *============================================================================*/
+
+#define HIST_CHECK_SEC          200
+#define HIST_CHECK_KEEP         150     /* Ring shorter than the run: the start is dropped */
+#define HIST_CHECK_SETTLE       2       /* Newest seconds may still take a late tick */
+#define HIST_CHECK_PHASE_SEC    0.37    /* Broadcast seconds off the stream's second grid */
+#define HIST_CHECK_HOLE_SLACK   2       /* Seconds a tick hole may be placed late */
+#define HIST_CHECK_FILE         "history_check.bin"
+#define HIST_CHECK_FILE_SEC     600
+#define HIST_CHECK_FILE_ROWS    100
+
+typedef struct {
+    int ticks[HIST_CHECK_SEC];  /* WWV ticks by the second of their leading edge */
+    bool ok;                    /* The history agrees with them */
+} hist_ticks_t;
+
+static void hist_on_tick(const wwv_tick_event_t *e, void *user_data) {
+    hist_ticks_t *t = (hist_ticks_t *)user_data;
+    if (e->station != WWV_STATION_WWV) return;
+    double edge_ms = (e->epoch_ms > 0.0) ? e->epoch_ms : e->timestamp_ms;
+    int sec = (int)floor(edge_ms / 1000.0);
+    if (sec >= 0 && sec < HIST_CHECK_SEC) t->ticks[sec]++;
+}
+
+static bool hist_setup(wwv_detector_manager_t *mgr, void *user) {
+    hist_ticks_t *seen = (hist_ticks_t *)user;
+    memset(seen, 0, sizeof(*seen));
+    wwv_detector_manager_set_tick_callback(mgr, hist_on_tick, seen);
+    return true;
+}
+
+/* The manager's history against the ticks it delivered */
+static bool hist_finish(wwv_detector_manager_t *mgr, void *user) {
+    hist_ticks_t *seen = (hist_ticks_t *)user;
+    const wwv_history_t *h = wwv_detector_manager_get_history(mgr);
+    wwv_history_info_t info;
+    if (!wwv_history_get_info(h, &info)) return false;
+
+    static float ticks[HIST_CHECK_SEC], expected[HIST_CHECK_SEC], conf[HIST_CHECK_SEC];
+    int rows = wwv_history_query(h, WWV_HIST_TICKS, 0.0, HIST_CHECK_SEC * 1000.0,
+                                 ticks, HIST_CHECK_SEC);
+    wwv_history_query(h, WWV_HIST_TICKS_EXPECTED, 0.0, HIST_CHECK_SEC * 1000.0,
+                      expected, HIST_CHECK_SEC);
+    wwv_history_query(h, WWV_HIST_SYNC_CONFIDENCE, 0.0, HIST_CHECK_SEC * 1000.0,
+                      conf, HIST_CHECK_SEC);
+
+    int first = (int)(info.first_ms / 1000.0);
+    int end = (int)(info.end_ms / 1000.0);
+    int wrong = 0, holes = 0, hole_ticks = 0, missing = 0, old = 0, span_ticks = 0;
+    int tick_secs = 0;
+    for (int s = 0; s < rows; s++) {
+        if (s < first) {
+            if (!isnan(ticks[s])) old++;
+            continue;
+        }
+        if (s >= end - HIST_CHECK_SETTLE) continue;
+        span_ticks += seen->ticks[s];
+        if (seen->ticks[s] > 0) tick_secs++;
+        if (isnan(ticks[s]) || (int)ticks[s] != seen->ticks[s]) wrong++;
+        if (isnan(conf[s]) || isnan(expected[s])) missing++;
+        /* Sync numbers seconds from a marker's trailing edge: a hole may sit late */
+        if (expected[s] == 0.0f) {
+            bool tickless = false;
+            for (int d = -HIST_CHECK_HOLE_SLACK; d <= 0; d++) {
+                if (s + d >= 0 && seen->ticks[s + d] == 0) tickless = true;
+            }
+            holes++;
+            if (!tickless) hole_ticks++;
+        }
+    }
+
+    wwv_history_stats_t snr;
+    double to_ms = (end - HIST_CHECK_SETTLE) * 1000.0;
+    bool have_snr = wwv_history_aggregate(h, WWV_HIST_TICK_SNR, info.first_ms, to_ms, &snr);
+
+    seen->ok = rows == HIST_CHECK_SEC && end >= HIST_CHECK_SEC - 1 &&
+               end - first == HIST_CHECK_KEEP && old == 0 && wrong == 0 && missing == 0 &&
+               holes > 0 && hole_ticks == 0 && have_snr && snr.count == tick_secs;
+    fprintf(stderr, "[BENCH] history  span %d-%d s of %d: %d ticks, %d rows wrong, %d dropped rows "
+            "left, %d missing samples\n", first, end, HIST_CHECK_SEC, span_ticks, wrong, old, missing);
+    fprintf(stderr, "[BENCH] history  %d tick holes expected (%d far from one), tick SNR %.1f-%.1f dB "
+            "over %d  %s\n", holes, hole_ticks, have_snr ? snr.min : 0.0f,
+            have_snr ? snr.max : 0.0f, have_snr ? snr.count : 0, seen->ok ? "ok" : "FAIL");
+
+    return true;
+}
+
+/*
+ * A tick leading edge right on a stream second boundary lands on either
+ * side of it; real signals are rarely that close, so the broadcast is
+ * shifted off the grid
+ */
+static bool hist_check_manager(void) {
+    static hist_ticks_t seen;
+    manager_pass_t pass;
+    manager_pass_init(&pass, HIST_CHECK_SEC);
+    pass.synth.start_offset_sec = HIST_CHECK_PHASE_SEC;
+    pass.config.history_seconds = HIST_CHECK_KEEP;
+    pass.setup = hist_setup;
+    pass.finish = hist_finish;
+    pass.user = &seen;
+    return manager_pass(&pass, NULL) && seen.ok;
+}
+
+/* Rows written, closed and mapped again come back at negative times */
+static bool hist_check_file(void) {
+    remove(HIST_CHECK_FILE);
+    wwv_history_t *h = wwv_history_create(HIST_CHECK_FILE_SEC, HIST_CHECK_FILE);
+    if (!h) return false;
+    for (int s = 0; s < HIST_CHECK_FILE_ROWS; s++) {
+        wwv_history_record(h, WWV_HIST_TICK_SNR, s * 1000.0 + 500.0, (float)s);
+    }
+    wwv_history_destroy(h);
+
+    h = wwv_history_create(HIST_CHECK_FILE_SEC, HIST_CHECK_FILE);
+    if (!h) return false;
+    wwv_history_info_t info;
+    wwv_history_get_info(h, &info);
+    wwv_history_record(h, WWV_HIST_TICK_SNR, 0.0, -1.0f);
+
+    float back[HIST_CHECK_FILE_ROWS];
+    int rows = wwv_history_query(h, WWV_HIST_TICK_SNR, info.first_ms,
+                                 info.first_ms + HIST_CHECK_FILE_ROWS * 1000.0,
+                                 back, HIST_CHECK_FILE_ROWS);
+    int wrong = 0;
+    for (int s = 0; s < rows; s++) {
+        if (back[s] != (float)s) wrong++;
+    }
+    wwv_history_stats_t all;
+    bool have = wwv_history_aggregate(h, WWV_HIST_TICK_SNR, info.first_ms, 1000.0, &all);
+    wwv_history_destroy(h);
+
+    /* Another capacity starts over */
+    wwv_history_t *other = wwv_history_create(HIST_CHECK_FILE_SEC / 2, HIST_CHECK_FILE);
+    wwv_history_info_t other_info;
+    bool restarted = other && wwv_history_get_info(other, &other_info) &&
+                     !other_info.resumed && other_info.end_ms == 0.0;
+    wwv_history_destroy(other);
+    remove(HIST_CHECK_FILE);
+
+    bool ok = info.resumed && info.mapped && info.end_ms <= 0.0 &&
+              info.first_ms <= -HIST_CHECK_FILE_ROWS * 1000.0 &&
+              rows == HIST_CHECK_FILE_ROWS && wrong == 0 &&
+              have && all.count == HIST_CHECK_FILE_ROWS + 1 && all.min == -1.0f && restarted;
+    fprintf(stderr, "[BENCH] history  file: %d rows back from %.0f s, %d wrong, %d in the "
+            "aggregate, other capacity %s  %s\n", rows, info.first_ms / 1000.0, wrong,
+            have ? all.count : 0, restarted ? "restarted" : "KEPT", ok ? "ok" : "FAIL");
+    return ok;
+}
+
+static void hist_check_cost(void) {
+    wwv_history_t *h = wwv_history_create(WWV_HISTORY_DEFAULT_SECONDS, NULL);
+    if (!h) return;
+    uint32_t n = WWV_HISTORY_DEFAULT_SECONDS;
+
+    uint64_t t0 = bench_now_ns();
+    for (uint32_t s = 0; s < n; s++) {
+        wwv_history_record(h, WWV_HIST_TICKS, s * 1000.0, 1.0f);
+        wwv_history_record(h, WWV_HIST_TICK_SNR, s * 1000.0 + 10.0, 20.0f);
+    }
+    uint64_t t1 = bench_now_ns();
+    wwv_history_stats_t st;
+    wwv_history_aggregate(h, WWV_HIST_TICK_SNR, 0.0, n * 1000.0, &st);
+    uint64_t t2 = bench_now_ns();
+
+    fprintf(stderr, "[BENCH] history  %.1f ns/record, 24 h aggregate %.2f ms\n",
+            (double)(t1 - t0) / (2.0 * n), (double)(t2 - t1) / 1e6);
+    wwv_history_destroy(h);
+}
+
+static bool run_history_check(void) {
+    bool manager_ok = hist_check_manager();
+    bool file_ok = hist_check_file();
+    hist_check_cost();
+    return manager_ok && file_ok;
+}
+
+/*============================================================================
+ * Binary Log Check
+ *============================================================================*/
+
+#define BINLOG_CHECK_SEC        150
+#define BINLOG_CHECK_RING       65536   /* Rows per stream ring: none dropped at bench speed */
+#define BINLOG_CHECK_MIN_RATIO  3.0     /* CSV bytes per binary byte; about 4 measured */
+#define BINLOG_CHECK_BLOCK_MS   3600000 /* One LZ4 block per log, however slow the pass */
+#define BINLOG_CHECK_CSV        "binlog_check.csv"
+#define BINLOG_CHECK_ROTATED    "binlog_rotate.csv"
+#define BINLOG_CHECK_SEGMENTS   3
+#define BINLOG_CHECK_ROWS       20000
+#define BINLOG_CHECK_TEXT       "binlog_exact_text.csv"
+#define BINLOG_CHECK_BINARY     "binlog_exact.csv"
+#define BINLOG_CHECK_DIR        "binlog_check.d"    /* The manager passes' logs */
+
+static const char *const binlog_check_logs[] = {
+    "wwv_ticks", "wwv_markers", "wwv_debug_marker", "wwv_bcd_time", "wwv_bcd_freq",
+    "wwv_tick_corr", "wwv_markers_corr", "wwv_sync", "wwv_bcd_corr", "wwv_carrier",
+    "wwv_tone_500", "wwv_tone_600"
+};
+
+static long file_bytes(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return -1;
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fclose(f);
+    return n;
+}
+
+static int count_lines(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+    int lines = 0;
+    for (int c; (c = fgetc(f)) != EOF; ) {
+        if (c == '\n') lines++;
+    }
+    fclose(f);
+    return lines;
+}
+
+/* A private output directory, so parallel checks never share log files */
+static bool log_dir_create(const char *dir) {
+#ifdef _WIN32
+    return _mkdir(dir) == 0 || errno == EEXIST;
+#else
+    return mkdir(dir, 0755) == 0 || errno == EEXIST;
+#endif
+}
+
+/* Every manager log, text and binary, then the directory; false if any is left */
+static bool log_dir_remove(const char *dir) {
+    for (size_t i = 0; i < sizeof(binlog_check_logs) / sizeof(binlog_check_logs[0]); i++) {
+        char path[256];
+        snprintf(path, sizeof(path), "%s/%s.csv", dir, binlog_check_logs[i]);
+        remove(path);
+        snprintf(path, sizeof(path), "%s/%s.wlog", dir, binlog_check_logs[i]);
+        remove(path);
+    }
+#ifdef _WIN32
+    return _rmdir(dir) == 0;
+#else
+    return rmdir(dir) == 0;
+#endif
+}
+
+static bool files_equal(const char *a_path, const char *b_path) {
+    FILE *a = fopen(a_path, "rb");
+    FILE *b = fopen(b_path, "rb");
+    bool same = a && b;
+    while (same) {
+        int ca = fgetc(a);
+        int cb = fgetc(b);
+        if (ca != cb) same = false;
+        if (ca == EOF) break;
+    }
+    if (a) fclose(a);
+    if (b) fclose(b);
+    return same;
+}
+
+static bool binlog_run_manager(wwv_csv_log_format_t format) {
+    wwv_csv_log_config_t log = WWV_CSV_LOG_CONFIG_DEFAULT;
+    log.format = format;
+    log.ring_records = BINLOG_CHECK_RING;
+    /* Blocks cut on the wall clock would make the ratio depend on machine load */
+    log.block_ms = BINLOG_CHECK_BLOCK_MS;
+    wwv_csv_log_configure(&log);
+
+    manager_pass_t pass;
+    manager_pass_init(&pass, BINLOG_CHECK_SEC);
+    pass.config.output_dir = BINLOG_CHECK_DIR;
+    return manager_pass(&pass, NULL);
+}
+
+static bool binlog_check_manager(void) {
+    uint64_t t0 = bench_now_ns();
+    bool ran = log_dir_create(BINLOG_CHECK_DIR) && binlog_run_manager(WWV_CSV_LOG_TEXT);
+    uint64_t t1 = bench_now_ns();
+    ran = ran && binlog_run_manager(WWV_CSV_LOG_BINARY);
+    uint64_t t2 = bench_now_ns();
+
+    wwv_csv_log_config_t defaults = WWV_CSV_LOG_CONFIG_DEFAULT;
+    wwv_csv_log_configure(&defaults);
+    wwv_csv_log_stats_t stats;
+    wwv_csv_log_get_stats(&stats);
+    if (!ran) {
+        log_dir_remove(BINLOG_CHECK_DIR);
+        return false;
+    }
+
+    int logs = 0, bad = 0, rows = 0;
+    long csv_bytes = 0, bin_bytes = 0;
+    for (size_t i = 0; i < sizeof(binlog_check_logs) / sizeof(binlog_check_logs[0]); i++) {
+        char csv[256], bin[256];
+        snprintf(csv, sizeof(csv), BINLOG_CHECK_DIR "/%s.csv", binlog_check_logs[i]);
+        snprintf(bin, sizeof(bin), BINLOG_CHECK_DIR "/%s.wlog", binlog_check_logs[i]);
+        long c = file_bytes(csv);
+        long b = file_bytes(bin);
+        if (c < 0 && b < 0) continue;
+
+        FILE *out = fopen(BINLOG_CHECK_CSV, "w");
+        bool converted = out && wwv_csv_log_convert(bin, out, true);
+        if (out) fclose(out);
+        /* Rows carry the wall clock, so two runs only agree on their shape */
+        int lines = count_lines(csv);
+        if (!converted || lines != count_lines(BINLOG_CHECK_CSV)) {
+            fprintf(stderr, "[BENCH] binlog  %s: %s\n", binlog_check_logs[i],
+                    converted ? "rows differ from the CSV" : "does not convert");
+            bad++;
+        }
+        logs++;
+        rows += lines;
+        csv_bytes += c;
+        bin_bytes += b;
+    }
+    remove(BINLOG_CHECK_CSV);
+    bool cleaned = log_dir_remove(BINLOG_CHECK_DIR);
+    if (!cleaned) fprintf(stderr, "[BENCH] binlog  " BINLOG_CHECK_DIR " not empty after the logs\n");
+
+    double ratio = bin_bytes > 0 ? (double)csv_bytes / (double)bin_bytes : 0.0;
+    bool ok = cleaned && logs > 0 && bad == 0 && stats.rows_dropped == 0 && ratio >= BINLOG_CHECK_MIN_RATIO;
+    fprintf(stderr, "[BENCH] binlog  %d logs, %d lines: CSV %ld bytes, LZ4 binary %ld (%.1fx), "
+            "%d differ, %llu rows dropped  %s\n", logs, rows, csv_bytes, bin_bytes, ratio, bad,
+            (unsigned long long)stats.rows_dropped, ok ? "ok" : "FAIL");
+    fprintf(stderr, "[BENCH] binlog  manager pass %.2f s with CSV logs, %.2f s with binary\n",
+            (double)(t1 - t0) / 1e9, (double)(t2 - t1) / 1e9);
+    return ok;
+}
+
+/*
+ * The same rows to a text and a binary stream: the converted binary must
+ * be the text byte for byte, including the values DEC columns cannot
+ * quantize (near ties, NaN, inf, -0.0) and every capture type
+ */
+static bool binlog_check_exact(void) {
+    wwv_csv_log_config_t log = WWV_CSV_LOG_CONFIG_DEFAULT;
+    log.ring_records = BINLOG_CHECK_RING;
+    wwv_csv_log_configure(&log);
+    wwv_csv_log_t *text = wwv_csv_log_open(BINLOG_CHECK_TEXT);
+    log.format = WWV_CSV_LOG_BINARY;
+    wwv_csv_log_configure(&log);
+    wwv_csv_log_t *bin = wwv_csv_log_open(BINLOG_CHECK_BINARY);
+    wwv_csv_log_config_t defaults = WWV_CSV_LOG_CONFIG_DEFAULT;
+    wwv_csv_log_configure(&defaults);
+    char bin_path[600] = "";
+    if (!text || !bin || !wwv_csv_log_get_path(bin, bin_path, sizeof(bin_path))) {
+        wwv_csv_log_close(text);
+        wwv_csv_log_close(bin);
+        return false;
+    }
+
+    wwv_csv_log_t *streams[2] = { text, bin };
+    static const double odd[] = { -0.0, 0.125, 2.675, 1e300, -1e-9, 0.5 };
+    uint32_t seed = 12345;
+    for (int k = 0; k < 2; k++) {
+        wwv_csv_log_header(streams[k], "# exact check\ntime,ms,n,state,level,snr,count\n");
+    }
+    for (int i = 0; i < BINLOG_CHECK_ROWS; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        double noise = (double)(seed >> 8) / 16777216.0 - 0.5;
+        double level = 0.03 + 0.01 * noise;
+        if (i % 997 == 0) level = odd[(i / 997) % 6];
+        if (i % 2111 == 0) level = (i % 4222 == 0) ? NAN : -INFINITY;
+        time_t wall = (time_t)1700000000 + i / 10;
+        const char *state = (i % 600) < 500 ? "IDLE" : "ACCUM";
+        for (int k = 0; k < 2; k++) {
+            wwv_csv_log_row_at(streams[k], wall, "%.1f,%d,%s,%.4f,%.2f,%u\n", i * 102.4,
+                               i - BINLOG_CHECK_ROWS / 2, state, level, 20.0 + 8.0 * noise,
+                               seed >> 20);
+            if (i % 50 == 0) {
+                wwv_csv_log_row(streams[k], "%g,%e,%f,%.0f,%lld,%llu,%zu,%x,%c,%ld\n",
+                                level, noise * 1e-7, level * 1e4, i * 0.5, -(long long)i * 3000000000LL,
+                                (unsigned long long)seed * 7919ull, (size_t)i, seed, 'A' + i % 26,
+                                (long)-i);
+            }
+        }
+    }
+    uint64_t lost = wwv_csv_log_get_dropped(text) + wwv_csv_log_get_dropped(bin);
+    wwv_csv_log_close(text);
+    wwv_csv_log_close(bin);
+
+    FILE *out = fopen(BINLOG_CHECK_CSV, "w");
+    bool converted = out && wwv_csv_log_convert(bin_path, out, true);
+    if (out) fclose(out);
+    bool same = converted && files_equal(BINLOG_CHECK_TEXT, BINLOG_CHECK_CSV);
+    long text_bytes = file_bytes(BINLOG_CHECK_TEXT);
+    long bin_bytes = file_bytes(bin_path);
+    remove(BINLOG_CHECK_TEXT);
+    remove(BINLOG_CHECK_CSV);
+    remove(bin_path);
+
+    bool ok = same && lost == 0;
+    fprintf(stderr, "[BENCH] binlog  exact: %d rows, CSV %ld bytes, binary %ld, converted %s  %s\n",
+            BINLOG_CHECK_ROWS, text_bytes, bin_bytes,
+            !converted ? "FAILED" : same ? "identical" : "DIFFERS", ok ? "ok" : "FAIL");
+    return ok;
+}
+
+/* One row in each of three wall seconds: three files, each with the header */
+static bool binlog_check_rotation(void) {
+    wwv_csv_log_config_t log = WWV_CSV_LOG_CONFIG_DEFAULT;
+    log.async = false;
+    log.format = WWV_CSV_LOG_BINARY;
+    log.rotate_seconds = 1;
+    wwv_csv_log_configure(&log);
+    wwv_csv_log_t *stream = wwv_csv_log_open(BINLOG_CHECK_ROTATED);
+    wwv_csv_log_config_t defaults = WWV_CSV_LOG_CONFIG_DEFAULT;
+    wwv_csv_log_configure(&defaults);
+    if (!stream) return false;
+
+    static const char *const header = "# rotation check\nsegment,value\n";
+    wwv_csv_log_header(stream, "%s", header);
+    char paths[BINLOG_CHECK_SEGMENTS][600];
+    for (int k = 0; k < BINLOG_CHECK_SEGMENTS; k++) {
+        if (k > 0) {
+            time_t t = time(NULL);
+            while (time(NULL) == t) bench_sleep_ms(20);
+        }
+        wwv_csv_log_row(stream, "%d,%.3f\n", k, k * 0.5);
+        if (!wwv_csv_log_get_path(stream, paths[k], sizeof(paths[k]))) paths[k][0] = '\0';
+    }
+    wwv_csv_log_close(stream);
+
+    int good = 0;
+    for (int k = 0; k < BINLOG_CHECK_SEGMENTS; k++) {
+        bool distinct = paths[k][0] && (k == 0 || strcmp(paths[k], paths[k - 1]) != 0);
+        FILE *out = fopen(BINLOG_CHECK_CSV, "w");
+        bool converted = distinct && out && wwv_csv_log_convert(paths[k], out, true);
+        if (out) fclose(out);
+
+        char expect[128], got[128] = "";
+        snprintf(expect, sizeof(expect), "%s%d,%.3f\n", header, k, k * 0.5);
+        FILE *in = converted ? fopen(BINLOG_CHECK_CSV, "r") : NULL;
+        if (in) {
+            size_t n = fread(got, 1, sizeof(got) - 1, in);
+            got[n] = '\0';
+            fclose(in);
+        }
+        if (converted && strcmp(got, expect) == 0) good++;
+        if (paths[k][0]) remove(paths[k]);
+    }
+    remove(BINLOG_CHECK_CSV);
+
+    bool ok = good == BINLOG_CHECK_SEGMENTS;
+    fprintf(stderr, "[BENCH] binlog  rotation: %d of %d one-second files with header and row  %s\n",
+            good, BINLOG_CHECK_SEGMENTS, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+static bool run_binlog_check(void) {
+    bool manager_ok = binlog_check_manager();
+    bool exact_ok = binlog_check_exact();
+    bool rotation_ok = binlog_check_rotation();
+    return manager_ok && exact_ok && rotation_ok;
+}
+
+/*============================================================================
+ * Trace Check
+ *============================================================================*/
+
+#define TRACE_CHECK_SEC         60
+#define TRACE_CHECK_FILE        "trace_check.json"
+#define TRACE_CHECK_DIR         "trace_check.d"     /* The manager passes' logs */
+#define TRACE_CHECK_RING        262144  /* Spans per thread ring: none dropped at bench speed */
+#define TRACE_CHECK_BLOCK       5000
+
+static const char *const trace_check_spans[] = {
+    "detector_block", "display_block", "tick_frame", "marker_frame", "bcd_time_frame",
+    "tone_spectrum_fft", "write"
+};
+static const char *const trace_check_threads[] = { "detector", "display", "csv_log" };
+
+typedef struct {
+    bool complete;              /* Opens with '[' and closes with ']' */
+    int lines;                  /* Events and metadata */
+    int spans[sizeof(trace_check_spans) / sizeof(trace_check_spans[0])];
+    int bcd_freq_frames;        /* Full or idle */
+    bool threads[sizeof(trace_check_threads) / sizeof(trace_check_threads[0])];
+    int tick_frames;
+    int tick_out_of_order;
+} trace_digest_t;
+
+/* Value of "key":"..." in a one-line event, copied into out */
+static bool trace_string(const char *line, const char *key, char *out, size_t size) {
+    const char *p = strstr(line, key);
+    if (!p) return false;
+    p += strlen(key);
+    size_t n = 0;
+    while (p[n] && p[n] != '"' && n + 1 < size) n++;
+    memcpy(out, p, n);
+    out[n] = '\0';
+    return true;
+}
+
+static bool trace_digest(const char *path, trace_digest_t *d) {
+    memset(d, 0, sizeof(*d));
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+
+    char line[512];
+    char name[64];
+    double last_tick_ms = -1.0;
+    bool opened = false, closed = false;
+    while (fgets(line, sizeof(line), f)) {
+        if (!opened) {
+            opened = strcmp(line, "[\n") == 0;
+            continue;
+        }
+        if (strcmp(line, "]\n") == 0) {
+            closed = true;
+            continue;
+        }
+        if (line[0] != '{') continue;
+        d->lines++;
+        if (!trace_string(line, "\"name\":\"", name, sizeof(name))) continue;
+
+        if (strcmp(name, "thread_name") == 0) {
+            char thread[64];
+            if (!trace_string(line, "\"args\":{\"name\":\"", thread, sizeof(thread))) continue;
+            for (size_t t = 0; t < sizeof(trace_check_threads) / sizeof(trace_check_threads[0]); t++) {
+                if (strcmp(thread, trace_check_threads[t]) == 0) d->threads[t] = true;
+            }
+            continue;
+        }
+        for (size_t k = 0; k < sizeof(trace_check_spans) / sizeof(trace_check_spans[0]); k++) {
+            if (strcmp(name, trace_check_spans[k]) == 0) d->spans[k]++;
+        }
+        if (strncmp(name, "bcd_freq_", 9) == 0) d->bcd_freq_frames++;
+        if (strcmp(name, "tick_frame") == 0) {
+            const char *p = strstr(line, "\"sample_ms\":");
+            double ms = p ? atof(p + 12) : -1.0;
+            if (ms <= last_tick_ms) d->tick_out_of_order++;
+            last_tick_ms = ms;
+            d->tick_frames++;
+        }
+    }
+    fclose(f);
+    d->complete = opened && closed;
+    return true;
+}
+
+/* TRACE_CHECK_SEC of signal through a threaded manager; ns covers the feeding */
+static bool trace_pass(uint64_t *ns) {
+    manager_pass_t pass;
+    manager_pass_init(&pass, TRACE_CHECK_SEC);
+    pass.config.output_dir = TRACE_CHECK_DIR;
+    pass.config.threaded = true;
+    pass.block = TRACE_CHECK_BLOCK;
+    return manager_pass(&pass, ns);
+}
+
+static bool run_trace_check(void) {
+    wwv_trace_stats_t stats;
+    wwv_trace_get_stats(&stats);
+    if (!stats.enabled) {
+        bool refused = !wwv_trace_start(TRACE_CHECK_FILE, NULL) && file_bytes(TRACE_CHECK_FILE) < 0;
+        fprintf(stderr, "[BENCH] trace  built without WWV_TRACE: start refused, no file  %s\n",
+                refused ? "ok" : "FAIL");
+        return refused;
+    }
+
+    uint64_t idle_ns = 0, traced_ns = 0;
+    bool ran = log_dir_create(TRACE_CHECK_DIR) && trace_pass(&idle_ns);
+    wwv_csv_log_flush_all();
+
+    wwv_trace_config_t config = WWV_TRACE_CONFIG_DEFAULT;
+    config.ring_events = TRACE_CHECK_RING;
+    ran = ran && wwv_trace_start(TRACE_CHECK_FILE, &config);
+    ran = ran && trace_pass(&traced_ns);
+    /* The log writer drains the last rows on its own schedule */
+    wwv_csv_log_flush_all();
+    wwv_trace_get_stats(&stats);
+    wwv_trace_stop();
+    wwv_trace_stats_t final;
+    wwv_trace_get_stats(&final);
+
+    trace_digest_t d;
+    bool read = ran && trace_digest(TRACE_CHECK_FILE, &d);
+    long bytes = file_bytes(TRACE_CHECK_FILE);
+    remove(TRACE_CHECK_FILE);
+    if (!log_dir_remove(TRACE_CHECK_DIR)) {
+        fprintf(stderr, "[BENCH] trace  " TRACE_CHECK_DIR " not empty after the logs  FAIL\n");
+        return false;
+    }
+    if (!read) {
+        fprintf(stderr, "[BENCH] trace  manager pass or trace file failed  FAIL\n");
+        return false;
+    }
+
+    int missing = 0;
+    for (size_t k = 0; k < sizeof(trace_check_spans) / sizeof(trace_check_spans[0]); k++) {
+        if (d.spans[k] == 0) {
+            fprintf(stderr, "[BENCH] trace  no %s spans\n", trace_check_spans[k]);
+            missing++;
+        }
+    }
+    for (size_t t = 0; t < sizeof(trace_check_threads) / sizeof(trace_check_threads[0]); t++) {
+        if (!d.threads[t]) {
+            fprintf(stderr, "[BENCH] trace  no thread named %s\n", trace_check_threads[t]);
+            missing++;
+        }
+    }
+    if (d.bcd_freq_frames == 0) missing++;
+
+    /* Frames do not overlap: one span per TICK_FFT_SIZE samples */
+    int tick_expected = (int)((uint64_t)TRACE_CHECK_SEC * TICK_SAMPLE_RATE / TICK_FFT_SIZE);
+    bool ticks_ok = d.tick_frames == tick_expected && d.tick_out_of_order == 0;
+    bool ok = d.complete && missing == 0 && ticks_ok && final.dropped == 0 &&
+              (uint64_t)d.lines >= final.events;
+
+    fprintf(stderr, "[BENCH] trace  %llu spans from %u threads, %ld bytes, %llu dropped, JSON %s\n",
+            (unsigned long long)final.events, stats.threads, bytes,
+            (unsigned long long)final.dropped, d.complete ? "complete" : "TRUNCATED");
+    fprintf(stderr, "[BENCH] trace  tick_frame %d of %d in sample order (%d out of order), "
+            "%d missing spans / threads  %s\n", d.tick_frames, tick_expected,
+            d.tick_out_of_order, missing, ok ? "ok" : "FAIL");
+    fprintf(stderr, "[BENCH] trace  %d s threaded pass: %.2f s untraced, %.2f s traced\n",
+            TRACE_CHECK_SEC, (double)idle_ns / 1e9, (double)traced_ns / 1e9);
+    return ok;
+}
+
+/*============================================================================
+ * Real-Time Placement Check
+ *============================================================================*/
+
+#define RT_CHECK_SEC            60
+#define RT_CHECK_BLOCK          5000
+#define RT_CHECK_PRIORITY       10
+#define RT_CHECK_MIN_PREFAULT   (1024 * 1024)   /* Comb delay lines, correlators, rings */
+
+/* "VmLck:" of /proc/self/status in KB, -1 where there is none */
+static long rt_locked_kb(void) {
+    long kb = -1;
+    FILE *f = fopen("/proc/self/status", "r");
+    if (!f) return -1;
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        if (strncmp(line, "VmLck:", 6) == 0) kb = atol(line + 6);
+    }
+    fclose(f);
+    return kb;
+}
+
+typedef struct {
+    tile_digest_t digest;
+    wwv_rt_status_t status;
+    uint64_t first_ns;              /* The first second, where the prefaulting shows */
+} rt_result_t;
+
+static bool rt_setup(wwv_detector_manager_t *mgr, void *user) {
+    rt_result_t *r = (rt_result_t *)user;
+    if (!wwv_detector_manager_is_threaded(mgr)) return false;
+    r->status = wwv_detector_manager_get_rt_status(mgr);
+    return tile_setup(mgr, &r->digest);
+}
+
+static void rt_fed(wwv_detector_manager_t *mgr, int sec, uint64_t ns, void *user) {
+    (void)mgr;
+    if (sec == 0) ((rt_result_t *)user)->first_ns = ns;
+}
+
+/* RT_CHECK_SEC through a threaded manager */
+static bool rt_pass(const wwv_detector_config_t *config, rt_result_t *r) {
+    manager_pass_t pass;
+    manager_pass_init(&pass, RT_CHECK_SEC);
+    pass.config = *config;
+    pass.block = RT_CHECK_BLOCK;
+    pass.setup = rt_setup;
+    pass.fed = rt_fed;
+    pass.user = r;
+    return manager_pass(&pass, NULL);
+}
+
+/* Highest and lowest CPU of a mask */
+static uint64_t rt_high_cpu(uint64_t mask) {
+    uint64_t cpu = 0;
+    for (int b = 0; b < 64; b++) {
+        if (mask & (1ull << b)) cpu = 1ull << b;
+    }
+    return cpu;
+}
+
+static bool run_rt_check(void) {
+    wwv_detector_config_t plain = WWV_DETECTOR_CONFIG_DEFAULT;
+    plain.output_dir = NULL;
+    plain.threaded = true;
+
+    /* Pinned inside the CPUs this process already has, so no privilege is needed */
+    uint64_t own = wwv_thread_get_affinity();
+    wwv_detector_config_t placed = plain;
+    placed.detector_cpus = own & (~own + 1);
+    placed.display_cpus = rt_high_cpu(own);
+    placed.rt_priority = RT_CHECK_PRIORITY;
+    placed.prefault = true;
+    placed.lock_memory = true;
+
+    rt_result_t ref, rt;
+    if (!rt_pass(&plain, &ref) || !rt_pass(&placed, &rt)) {
+        fprintf(stderr, "[BENCH] rt  threaded manager unavailable  FAIL\n");
+        return false;
+    }
+    const wwv_rt_status_t ref_status = ref.status, status = rt.status;
+
+    bool same = ref.digest.hash == rt.digest.hash && ref.digest.events == rt.digest.events &&
+                ref.digest.events > 0;
+    /* A graph without a display path (WWV_DISPLAY_PATH=OFF) starts no display worker */
+    bool display = ref_status.display.started;
+    bool prefault_ok = status.prefaulted_bytes >= RT_CHECK_MIN_PREFAULT &&
+                       ref_status.prefaulted_bytes == 0;
+    /* Affinity is only readable where it can be set */
+    bool cpus_ok = own == 0 ||
+                   (status.detector.cpus == placed.detector_cpus &&
+                    status.display.cpus == (display ? placed.display_cpus : 0) &&
+                    ref_status.detector.cpus == own);
+    bool prio_ok = status.detector.started && status.display.started == display &&
+                   (status.detector.priority == RT_CHECK_PRIORITY || status.detector.priority == 0) &&
+                   (!display || status.display.priority == status.detector.priority) &&
+                   ref_status.detector.priority == 0;
+    long locked_kb = rt_locked_kb();
+    bool lock_ok = locked_kb < 0 ? !status.memory_locked
+                                 : status.memory_locked == (locked_kb > 0);
+    bool ok = same && prefault_ok && cpus_ok && prio_ok && lock_ok;
+
+    fprintf(stderr, "[BENCH] rt  %d events, plain and placed %s\n",
+            rt.digest.events, same ? "identical" : "DIFFER");
+    fprintf(stderr, "[BENCH] rt  detector cpus 0x%llx display cpus 0x%llx%s (own 0x%llx)  %s\n",
+            (unsigned long long)status.detector.cpus, (unsigned long long)status.display.cpus,
+            display ? "" : " (no display path)", (unsigned long long)own, cpus_ok ? "ok" : "FAIL");
+    fprintf(stderr, "[BENCH] rt  priority %d of %d asked%s  %s\n", status.detector.priority,
+            RT_CHECK_PRIORITY, status.detector.priority ? "" : " (refused, no privilege)",
+            prio_ok ? "ok" : "FAIL");
+    fprintf(stderr, "[BENCH] rt  memory %s (VmLck %ld KB), %.1f MB prefaulted  %s\n",
+            status.memory_locked ? "locked" : "not locked", locked_kb,
+            (double)status.prefaulted_bytes / (1024.0 * 1024.0),
+            lock_ok && prefault_ok ? "ok" : "FAIL");
+    fprintf(stderr, "[BENCH] rt  first second: %.2f ms plain, %.2f ms placed\n",
+            (double)ref.first_ns / 1e6, (double)rt.first_ns / 1e6);
+    return ok;
+}
+
+/*============================================================================
+ * Template Marker Check
+ *============================================================================*/
+
+#define MT_CHECK_SEC            250
+#define MT_CHECK_START_MINUTE   7       /* Minute 0 carries the 1500 Hz hour marker */
+#define MT_CHECK_MATCH_MS       500.0   /* Onset this close to a broadcast marker matches it */
+#define MT_CHECK_MAX_ONSET_MS   1.5     /* Template onset error, under a third of a frame */
+#define MT_CHECK_MAX_MARKERS    16
+
+static const double mt_check_offsets[] = { 0.37, 23.811, 41.0025 };
+#define MT_CHECK_OFFSETS        ((int)(sizeof(mt_check_offsets) / sizeof(mt_check_offsets[0])))
+
+typedef struct {
+    double onset_ms[MT_CHECK_MAX_MARKERS];
+    float duration_ms[MT_CHECK_MAX_MARKERS];
+    int markers;
+} mt_markers_t;
+
+static void mt_on_marker(const wwv_marker_event_t *e, void *user_data) {
+    mt_markers_t *m = (mt_markers_t *)user_data;
+    if (m->markers < MT_CHECK_MAX_MARKERS) {
+        m->onset_ms[m->markers] = e->timestamp_ms - e->duration_ms;
+        m->duration_ms[m->markers] = e->duration_ms;
+        m->markers++;
+    }
+}
+
+static bool mt_setup(wwv_detector_manager_t *mgr, void *user) {
+    mt_markers_t *m = (mt_markers_t *)user;
+    memset(m, 0, sizeof(*m));
+    wwv_detector_manager_set_marker_callback(mgr, mt_on_marker, m);
+    return true;
+}
+
+/* MT_CHECK_SEC of a broadcast offset_sec into its minute; the block pass is added to ns */
+static bool mt_pass(bool tpl, double offset_sec, mt_markers_t *m, uint64_t *ns) {
+    manager_pass_t pass;
+    manager_pass_init(&pass, MT_CHECK_SEC);
+    pass.synth.start_offset_sec = offset_sec;
+    pass.synth.start_minute = MT_CHECK_START_MINUTE;
+    pass.config.marker_template = tpl;
+    pass.setup = mt_setup;
+    pass.user = m;
+    uint64_t pass_ns = 0;
+    bool ran = manager_pass(&pass, &pass_ns);
+    *ns += pass_ns;
+    return ran;
+}
+
+/*
+ * Match reported onsets to the broadcast's (second 0 of each minute after
+ * the stream starts). The sliding window reports where its 1 s sum
+ * crossed the threshold, hundreds of ms into the marker.
+ */
+static void mt_score(const mt_markers_t *m, double offset_sec, int *matched, int *spurious,
+                     double *sum_abs, double *worst) {
+    for (int k = 0; k < m->markers; k++) {
+        double minute = round((m->onset_ms[k] / 1000.0 + offset_sec) / 60.0);
+        double true_ms = 1000.0 * (60.0 * minute - offset_sec);
+        double err = fabs(m->onset_ms[k] - true_ms);
+        if (err > MT_CHECK_MATCH_MS) {
+            (*spurious)++;
+            continue;
+        }
+        (*matched)++;
+        *sum_abs += err;
+        if (err > *worst) *worst = err;
+    }
+}
+
+static bool run_marker_template_check(void) {
+    int expected = 0, missed = 0;
+    int slide_matched = 0, slide_spurious = 0, tpl_matched = 0, tpl_spurious = 0;
+    double slide_sum = 0.0, slide_worst = 0.0, tpl_sum = 0.0, tpl_worst = 0.0;
+    float dur_min = 1e9f, dur_max = 0.0f;
+    uint64_t slide_ns = 0, tpl_ns = 0;
+
+    for (int i = 0; i < MT_CHECK_OFFSETS; i++) {
+        double offset = mt_check_offsets[i];
+        static mt_markers_t slide, tpl;
+        if (!mt_pass(false, offset, &slide, &slide_ns) || !mt_pass(true, offset, &tpl, &tpl_ns)) {
+            fprintf(stderr, "[BENCH] marker_template  manager unavailable  FAIL\n");
+            return false;
+        }
+        /* Minutes 1.. whose marker and the quiet after it end inside the stream */
+        int n = (int)floor((MT_CHECK_SEC + offset - 1.0) / 60.0);
+        expected += n;
+        int before = tpl_matched;
+        mt_score(&slide, offset, &slide_matched, &slide_spurious, &slide_sum, &slide_worst);
+        mt_score(&tpl, offset, &tpl_matched, &tpl_spurious, &tpl_sum, &tpl_worst);
+        if (tpl_matched - before < n) missed += n - (tpl_matched - before);
+        for (int k = 0; k < tpl.markers; k++) {
+            if (tpl.duration_ms[k] < dur_min) dur_min = tpl.duration_ms[k];
+            if (tpl.duration_ms[k] > dur_max) dur_max = tpl.duration_ms[k];
+        }
+    }
+
+    double slide_mean = slide_matched ? slide_sum / slide_matched : 0.0;
+    double tpl_mean = tpl_matched ? tpl_sum / tpl_matched : 0.0;
+    uint64_t samples = (uint64_t)MT_CHECK_OFFSETS * MT_CHECK_SEC * BENCH_DETECTOR_RATE;
+    bool ok = expected > 0 && missed == 0 && tpl_matched == expected && tpl_spurious == 0 &&
+              slide_matched == expected && slide_spurious == 0 &&
+              tpl_worst <= MT_CHECK_MAX_ONSET_MS;
+
+    fprintf(stderr, "[BENCH] marker_template  %d markers broadcast: sliding %d (+%d spurious), "
+            "template %d (+%d spurious)\n", expected, slide_matched, slide_spurious,
+            tpl_matched, tpl_spurious);
+    fprintf(stderr, "[BENCH] marker_template  onset |error| sliding mean %.2f max %.2f ms, "
+            "template mean %.3f max %.3f ms, duration %.1f-%.1f ms\n",
+            slide_mean, slide_worst, tpl_mean, tpl_worst,
+            tpl_matched ? dur_min : 0.0f, tpl_matched ? dur_max : 0.0f);
+    fprintf(stderr, "[BENCH] marker_template  manager %.2f ns/sample sliding + slow path, "
+            "%.2f template  %s\n", (double)slide_ns / samples, (double)tpl_ns / samples,
+            ok ? "ok" : "FAIL");
+    return ok;
+}
+
+/*============================================================================
+ * Carrier Correction Check
+ *============================================================================*/
+
+#define CC_CHECK_NCO_SEC        20      /* Mixer run, long enough for float phase to drift */
+#define CC_CHECK_NCO_HZ         21.73
+#define CC_CHECK_MAX_NCO_ERR    1e-4    /* Against the double reference, unit amplitude */
+#define CC_CHECK_SEC            150
+#define CC_CHECK_OFFSET_HZ      21.7f   /* Inside WWV_CARRIER_MAX_HZ */
+#define CC_CHECK_WIDE_HZ        40.0f   /* Outside the tracker's search window */
+#define CC_CHECK_MAX_ERR_HZ     0.5f    /* Locked correction against the offset */
+
+static const size_t cc_check_blocks[] = { 1, 7, 333, 512, 4097, 5000 };
+#define CC_CHECK_BLOCKS         ((int)(sizeof(cc_check_blocks) / sizeof(cc_check_blocks[0])))
+
+/* Tone at the offset mixed to DC: worst distance from the reference and ns */
+static bool cc_nco_pass(double *worst, uint64_t *ns) {
+    const double rate = BENCH_DETECTOR_RATE;
+    const size_t total = (size_t)(CC_CHECK_NCO_SEC * rate);
+    const size_t max_block = 5000;
+    float *in_i = malloc(max_block * sizeof(float));
+    float *in_q = malloc(max_block * sizeof(float));
+    float *out = malloc(2 * max_block * sizeof(float));
+    carrier_nco_t *nco = carrier_nco_create((float)rate);
+    if (!in_i || !in_q || !out || !nco) {
+        free(in_i);
+        free(in_q);
+        free(out);
+        carrier_nco_destroy(nco);
+        return false;
+    }
+    carrier_nco_set_offset(nco, CC_CHECK_NCO_HZ);
+
+    size_t n = 0;
+    for (int b = 0; n < total; b++) {
+        size_t count = cc_check_blocks[b % CC_CHECK_BLOCKS];
+        if (count > total - n) count = total - n;
+        /* Input e^{j 2 pi (f + 1 Hz) t}, expected out e^{j 2 pi 1 Hz t} */
+        for (size_t k = 0; k < count; k++) {
+            double t = (double)(n + k) / rate;
+            in_i[k] = (float)cos(2.0 * M_PI * (CC_CHECK_NCO_HZ + 1.0) * t);
+            in_q[k] = (float)sin(2.0 * M_PI * (CC_CHECK_NCO_HZ + 1.0) * t);
+        }
+        uint64_t t0 = bench_now_ns();
+        carrier_nco_process(nco, in_i, in_q, out, out + max_block, count);
+        *ns += bench_now_ns() - t0;
+        for (size_t k = 0; k < count; k++) {
+            double t = (double)(n + k) / rate;
+            double di = out[k] - cos(2.0 * M_PI * t);
+            double dq = out[max_block + k] - sin(2.0 * M_PI * t);
+            double err = sqrt(di * di + dq * dq);
+            if (err > *worst) *worst = err;
+        }
+        n += count;
+    }
+    free(in_i);
+    free(in_q);
+    free(out);
+    carrier_nco_destroy(nco);
+    return true;
+}
+
+typedef struct {
+    int ticks;
+    int markers;
+    wwv_carrier_status_t status;
+    uint64_t ns;
+} cc_result_t;
+
+static bool cc_finish(wwv_detector_manager_t *mgr, void *user) {
+    cc_result_t *r = (cc_result_t *)user;
+    r->ticks = wwv_detector_manager_get_tick_count(mgr);
+    r->markers = wwv_detector_manager_get_marker_count(mgr);
+    r->status = wwv_detector_manager_get_carrier_status(mgr);
+    return true;
+}
+
+static bool cc_pass(float offset_hz, bool correct, cc_result_t *r) {
+    manager_pass_t pass;
+    manager_pass_init(&pass, CC_CHECK_SEC);
+    pass.synth.doppler_hz = offset_hz;
+    pass.config.carrier_correction = correct;
+    pass.finish = cc_finish;
+    pass.user = r;
+    memset(r, 0, sizeof(*r));
+    return manager_pass(&pass, &r->ns);
+}
+
+static bool run_carrier_check(void) {
+    double nco_worst = 0.0;
+    uint64_t nco_ns = 0;
+    cc_result_t tuned, plain, fixed, wide;
+    if (!cc_nco_pass(&nco_worst, &nco_ns) ||
+        !cc_pass(0.0f, false, &tuned) ||
+        !cc_pass(CC_CHECK_OFFSET_HZ, false, &plain) ||
+        !cc_pass(CC_CHECK_OFFSET_HZ, true, &fixed) ||
+        !cc_pass(CC_CHECK_WIDE_HZ, true, &wide)) {
+        fprintf(stderr, "[BENCH] carrier  setup failed  FAIL\n");
+        return false;
+    }
+
+    float err_hz = fabsf(fixed.status.offset_hz - CC_CHECK_OFFSET_HZ);
+    bool nco_ok = nco_worst <= CC_CHECK_MAX_NCO_ERR;
+    bool lock_ok = fixed.status.enabled && fixed.status.active && err_hz <= CC_CHECK_MAX_ERR_HZ &&
+                   fixed.ticks >= tuned.ticks && fixed.markers >= tuned.markers;
+    bool wide_ok = !wide.status.active && wide.status.rejected > 0;
+    bool ok = nco_ok && lock_ok && wide_ok;
+    uint64_t samples = (uint64_t)CC_CHECK_SEC * BENCH_DETECTOR_RATE;
+
+    fprintf(stderr, "[BENCH] carrier  nco %d s in blocks of 1-5000: |error| max %.2e, "
+            "%.2f ns/sample  %s\n", CC_CHECK_NCO_SEC, nco_worst,
+            (double)nco_ns / ((double)CC_CHECK_NCO_SEC * BENCH_DETECTOR_RATE), nco_ok ? "ok" : "FAIL");
+    /* Corrected, the offset broadcast should detect as the tuned one does */
+    fprintf(stderr, "[BENCH] carrier  %+.1f Hz: correcting %+.3f Hz (%u estimates), "
+            "ticks %d uncorrected / %d corrected / %d tuned, markers %d / %d / %d  %s\n",
+            CC_CHECK_OFFSET_HZ, fixed.status.offset_hz, fixed.status.estimates,
+            plain.ticks, fixed.ticks, tuned.ticks, plain.markers, fixed.markers, tuned.markers,
+            lock_ok ? "ok" : "FAIL");
+    fprintf(stderr, "[BENCH] carrier  %+.1f Hz: %s, %u of %u estimates out of range  %s\n",
+            CC_CHECK_WIDE_HZ, wide.status.active ? "locked" : "not locked",
+            wide.status.rejected, wide.status.estimates, wide_ok ? "ok" : "FAIL");
+    fprintf(stderr, "[BENCH] carrier  manager %.2f ns/sample uncorrected, %.2f corrected\n",
+            (double)plain.ns / samples, (double)fixed.ns / samples);
+    return ok;
+}
+
+/*============================================================================
+ * Duty Cycle Check
+ *============================================================================*/
+
+/*
+ * The BCD time is not solved on the synthetic broadcast, so the passes run
+ * without the BCD detectors and sleep on sync's lock alone. The tick
+ * detector's marker path confirms only the synth's odd minutes (it rejects
+ * marker-like pulses through the even ones), so the interval is even to
+ * keep every prediction on a minute it confirms.
+ */
+#define DC_CHECK_SEC            (40 * 60)
+#define DC_CHECK_MINUTES        4
+#define DC_CHECK_OUTAGE_SEC     150     /* Station off: two predicted markers missed */
+#define DC_CHECK_MAX_AWAKE      0.10    /* Seconds awake after the first sleep */
+
+typedef struct {
+    int markers;
+    wwv_duty_status_t status;
+    int first_sleep_sec;            /* -1 = never slept */
+    int awake_sec;                  /* Seconds not asleep after the first sleep */
+    uint64_t ns;                    /* Whole run */
+    uint64_t *sec_ns;               /* Per second, DC_CHECK_SEC */
+} dc_result_t;
+
+/*
+ * Station off, band noise left: the difference of two renditions with
+ * other noise seeds cancels the broadcast, and over sqrt(2) keeps the
+ * noise at its level (digital silence would pin every noise floor at 0)
+ */
+static void dc_station_off(float *x, const float *other, size_t n) {
+    for (size_t k = 0; k < n; k++) x[k] = (x[k] - other[k]) * (float)M_SQRT1_2;
+}
+
+typedef struct {
+    dc_result_t *r;
+    bench_source_t quiet;           /* Other noise seeds, for the outage */
+    int outage_sec;
+    int outage_end;
+} dc_pass_t;
+
+static void dc_prepare(wwv_detector_manager_t *mgr, bench_source_t *src, int sec,
+                       size_t det_n, size_t disp_n, void *user) {
+    dc_pass_t *dc = (dc_pass_t *)user;
+    if (dc->outage_sec == 0) return;
+    size_t quiet_det, quiet_disp;
+    source_next(&dc->quiet, 1.0, &quiet_det, &quiet_disp);
+    /* The outage starts with the first wake: its marker and the next are gone */
+    if (dc->r->first_sleep_sec >= 0 && dc->outage_end < 0 &&
+        wwv_detector_manager_get_duty_status(mgr).state != WWV_DUTY_ASLEEP) {
+        dc->outage_end = sec + dc->outage_sec;
+    }
+    if (sec < dc->outage_end) {
+        dc_station_off(src->det_i, dc->quiet.det_i, det_n);
+        dc_station_off(src->det_q, dc->quiet.det_q, det_n);
+        dc_station_off(src->disp_i, dc->quiet.disp_i, disp_n);
+        dc_station_off(src->disp_q, dc->quiet.disp_q, disp_n);
+    }
+}
+
+static void dc_fed(wwv_detector_manager_t *mgr, int sec, uint64_t ns, void *user) {
+    dc_result_t *r = ((dc_pass_t *)user)->r;
+    r->sec_ns[sec] = ns;
+    wwv_duty_status_t ds = wwv_detector_manager_get_duty_status(mgr);
+    if (r->first_sleep_sec >= 0 && ds.state != WWV_DUTY_ASLEEP) {
+        r->awake_sec++;
+    } else if (r->first_sleep_sec < 0 && ds.sleeps > 0) {
+        r->first_sleep_sec = sec;
+    }
+}
+
+static bool dc_finish(wwv_detector_manager_t *mgr, void *user) {
+    dc_result_t *r = ((dc_pass_t *)user)->r;
+    r->markers = wwv_detector_manager_get_marker_count(mgr);
+    r->status = wwv_detector_manager_get_duty_status(mgr);
+    return true;
+}
+
+static bool dc_pass(bool duty, int outage_sec, dc_result_t *r) {
+    manager_pass_t pass;
+    manager_pass_init(&pass, DC_CHECK_SEC);
+    pass.config.enable_bcd_detectors = false;
+    pass.config.duty_cycle = duty;
+    pass.config.duty_cycle_minutes = DC_CHECK_MINUTES;
+    pass.prepare = dc_prepare;
+    pass.fed = dc_fed;
+    pass.finish = dc_finish;
+
+    dc_pass_t dc = { .r = r, .outage_sec = outage_sec, .outage_end = -1 };
+    wwv_synth_config_t synth = pass.synth;
+    synth.seed += 2;
+    bool opened = source_open(&dc.quiet, &synth, false);
+    pass.user = &dc;
+    r->markers = 0;
+    r->first_sleep_sec = -1;
+    r->awake_sec = 0;
+    bool ran = opened && manager_pass(&pass, &r->ns);
+    source_close(&dc.quiet);
+    return ran;
+}
+
+static uint64_t dc_cost_from(const dc_result_t *r, int first_sec) {
+    uint64_t ns = 0;
+    for (int sec = first_sec; sec < DC_CHECK_SEC; sec++) ns += r->sec_ns[sec];
+    return ns;
+}
+
+static bool run_duty_check(void) {
+    uint64_t *sec_ns = calloc(3 * DC_CHECK_SEC, sizeof(uint64_t));
+    dc_result_t full = { .sec_ns = sec_ns };
+    dc_result_t duty = { .sec_ns = sec_ns + DC_CHECK_SEC };
+    dc_result_t outage = { .sec_ns = sec_ns + 2 * DC_CHECK_SEC };
+    if (!sec_ns || !dc_pass(false, 0, &full) || !dc_pass(true, 0, &duty) ||
+        !dc_pass(true, DC_CHECK_OUTAGE_SEC, &outage) || duty.first_sleep_sec < 0) {
+        fprintf(stderr, "[BENCH] duty  setup failed or never slept  FAIL\n");
+        free(sec_ns);
+        return false;
+    }
+
+    /* Every wake verified: one marker a wake, and the ones seen while acquiring */
+    const wwv_duty_status_t *ds = &duty.status;
+    bool clean_ok = ds->enabled && ds->sleeps > 1 && ds->verified + 1 >= ds->sleeps &&
+                    ds->widened == 0 && ds->reacquired == 0 &&
+                    duty.markers >= (int)ds->verified;
+    /* Judged on the seconds processed, not the clock; the cost is reported */
+    double awake = (double)duty.awake_sec / (double)(DC_CHECK_SEC - duty.first_sleep_sec);
+    bool awake_ok = awake < DC_CHECK_MAX_AWAKE;
+    double cost = (double)dc_cost_from(&duty, duty.first_sleep_sec) /
+                  (double)dc_cost_from(&full, duty.first_sleep_sec);
+    /* Both predicted markers in the outage missed, then locked and asleep again */
+    const wwv_duty_status_t *os = &outage.status;
+    bool outage_ok = os->widened >= 1 && os->reacquired >= 1 && os->sleeps >= 2 &&
+                     os->verified >= 1;
+    bool ok = clean_ok && awake_ok && outage_ok;
+
+    fprintf(stderr, "[BENCH] duty  %d min clean, %d min wakes: first sleep at %d s, %u sleeps, "
+            "%u verified, %u widened, %u reacquired, %d markers (%d awake all along), %.1f%% awake  %s\n",
+            DC_CHECK_SEC / 60, DC_CHECK_MINUTES, duty.first_sleep_sec, ds->sleeps, ds->verified, ds->widened,
+            ds->reacquired, duty.markers, full.markers, ds->awake_fraction * 100.0f,
+            clean_ok ? "ok" : "FAIL");
+    fprintf(stderr, "[BENCH] duty  after the first sleep: %d of %d s awake, %.1f%% of the "
+            "full run's cost  %s\n", duty.awake_sec, DC_CHECK_SEC - duty.first_sleep_sec,
+            cost * 100.0, awake_ok ? "ok" : "FAIL");
+    fprintf(stderr, "[BENCH] duty  %d s outage: %u sleeps, %u verified, %u widened, "
+            "%u reacquired  %s\n", DC_CHECK_OUTAGE_SEC, os->sleeps, os->verified, os->widened,
+            os->reacquired, outage_ok ? "ok" : "FAIL");
+    fprintf(stderr, "[BENCH] duty  manager %.2f ns/sample awake all along, %.2f duty cycled\n",
+            (double)full.ns / ((double)DC_CHECK_SEC * BENCH_DETECTOR_RATE),
+            (double)duty.ns / ((double)DC_CHECK_SEC * BENCH_DETECTOR_RATE));
+    free(sec_ns);
+    return ok;
+}
+
+/*============================================================================
+ * Refclock Check
+ *============================================================================*/
+
+/*
+ * The synthetic broadcast's BCD time is not solved, so the manager never
+ * publishes on its own here: the check holds it to that, and publishes a
+ * sample carried back from the run's last stamp itself. The daemon end
+ * is a chrony SOCK socket of the check's own in the working directory.
+ */
+#define RC_CHECK_SEC            30
+#define RC_CHECK_BLOCK          5000
+#define RC_CHECK_SAMPLES        1000    /* Per-sample entry: stamped once a tile */
+#define RC_CHECK_TILE           256     /* The manager's WWV_DETECTOR_TILE_SAMPLES */
+#define RC_CHECK_SOCK           "refclock_check.sock"
+
+typedef struct {
+    int64_t year, day, hour, minute;
+    int64_t unix_sec;
+} rc_time_case_t;
+
+/* UTC from the BCD fields: fixed dates, then every year's length */
+static bool rc_check_unix_time(void) {
+    static const rc_time_case_t cases[] = {
+        { 0, 1, 0, 0, 946684800 },          /* 2000-01-01 00:00 */
+        { 24, 60, 12, 34, 1709210040 },     /* 2024-02-29 12:34, leap day */
+        { 24, 366, 23, 59, 1735689540 },    /* 2024-12-31 23:59 */
+        { 25, 1, 0, 0, 1735689600 },        /* 2025-01-01 00:00 */
+        { 99, 365, 12, 0, 4102401600 }      /* 2099-12-31 12:00 */
+    };
+    int bad = 0;
+    for (size_t k = 0; k < sizeof(cases) / sizeof(cases[0]); k++) {
+        const rc_time_case_t *c = &cases[k];
+        int64_t t = wwv_refclock_unix_time((int)c->year, (int)c->day, (int)c->hour, (int)c->minute);
+        if (t != c->unix_sec) {
+            fprintf(stderr, "[BENCH] refclock  %02d day %03d %02d:%02d: %lld, expected %lld\n",
+                    (int)c->year, (int)c->day, (int)c->hour, (int)c->minute, (long long)t,
+                    (long long)c->unix_sec);
+            bad++;
+        }
+    }
+    for (int y = 0; y < 99; y++) {
+        int64_t days = (y % 4 == 0) ? 366 : 365;
+        if (wwv_refclock_unix_time(y + 1, 1, 0, 0) - wwv_refclock_unix_time(y, 1, 0, 0) != days * 86400 ||
+            wwv_refclock_unix_time(y, (int)days, 23, 59) + 60 != wwv_refclock_unix_time(y + 1, 1, 0, 0)) {
+            bad++;
+        }
+    }
+    bool ok = bad == 0;
+    fprintf(stderr, "[BENCH] refclock  unix time: %zu dates and 99 year lengths, %d wrong  %s\n",
+            sizeof(cases) / sizeof(cases[0]), bad, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+#ifndef _WIN32
+
+/* chrony refclock_sock.c struct sock_sample, as wwv_refclock.c sends it */
+typedef struct {
+    struct timeval tv;
+    double offset;
+    int pulse;
+    int leap;
+    int pad;
+    int magic;
+} rc_sock_sample_t;
+
+#define RC_SOCK_MAGIC           0x534f434b
+
+/* The stamp must be the entry's: its last sample, read within the call */
+static bool rc_stamp_within(wwv_detector_manager_t *mgr, uint64_t sample, int64_t t0, int64_t t1) {
+    int64_t host_ns;
+    uint64_t got;
+    return wwv_detector_manager_get_refclock_stamp(mgr, &host_ns, &got) && got == sample &&
+           host_ns >= t0 && host_ns <= t1;
+}
+
+typedef struct {
+    uint64_t pushed;
+    int stamped;                    /* Seconds whose push was stamped right */
+    int64_t host_ns;                /* The last stamp */
+} rc_pass_t;
+
+/* One push a second, timed on its own: the flush lets the worker catch up */
+static void rc_feed(wwv_detector_manager_t *mgr, const bench_source_t *src,
+                    size_t det_n, size_t disp_n, void *user) {
+    rc_pass_t *rp = (rc_pass_t *)user;
+    int64_t t0 = wwv_refclock_host_ns();
+    rp->pushed += wwv_detector_manager_push_detector_block(mgr, src->det_i, src->det_q, det_n);
+    int64_t t1 = wwv_refclock_host_ns();
+    wwv_detector_manager_push_display_block(mgr, src->disp_i, src->disp_q, disp_n);
+    wwv_detector_manager_flush(mgr);
+    wwv_detector_manager_dispatch_events(mgr);
+    if (rc_stamp_within(mgr, rp->pushed, t0, t1)) rp->stamped++;
+}
+
+static bool rc_finish(wwv_detector_manager_t *mgr, void *user) {
+    return wwv_detector_manager_get_refclock_stamp(mgr, &((rc_pass_t *)user)->host_ns, NULL);
+}
+
+/* Threaded: stamped as pushed, whatever the worker's lag */
+static bool rc_pass_threaded(wwv_refclock_t *rc, rc_pass_t *rp) {
+    manager_pass_t pass;
+    manager_pass_init(&pass, RC_CHECK_SEC);
+    pass.config.threaded = true;
+    pass.config.refclock = rc;
+    pass.feed = rc_feed;
+    pass.finish = rc_finish;
+    pass.user = rp;
+    memset(rp, 0, sizeof(*rp));
+    return manager_pass(&pass, NULL);
+}
+
+/* Unthreaded: one stamp per int16 block, one a tile per sample */
+static bool rc_pass_entries(wwv_refclock_t *rc, bool *s16_ok, bool *sample_ok) {
+    wwv_synth_config_t synth = WWV_SYNTH_CONFIG_DEFAULT;
+    wwv_synth_t *s = wwv_synth_create(&synth);
+    wwv_detector_config_t config = WWV_DETECTOR_CONFIG_DEFAULT;
+    config.output_dir = NULL;
+    config.refclock = rc;
+    wwv_detector_manager_t *mgr = s ? wwv_detector_manager_create(&config) : NULL;
+    float *i_buf = malloc(RC_CHECK_BLOCK * sizeof(float));
+    float *q_buf = malloc(RC_CHECK_BLOCK * sizeof(float));
+    int16_t *iq = malloc(2 * RC_CHECK_BLOCK * sizeof(int16_t));
+    bool ran = mgr && i_buf && q_buf && iq;
+    if (ran) {
+        wwv_synth_generate(s, i_buf, q_buf, RC_CHECK_BLOCK);
+        for (size_t k = 0; k < RC_CHECK_BLOCK; k++) {
+            iq[2 * k] = (int16_t)lrintf(fmaxf(-1.0f, fminf(1.0f, i_buf[k])) * 32767.0f);
+            iq[2 * k + 1] = (int16_t)lrintf(fmaxf(-1.0f, fminf(1.0f, q_buf[k])) * 32767.0f);
+        }
+        int64_t t0 = wwv_refclock_host_ns();
+        wwv_detector_manager_process_detector_block_s16(mgr, iq, RC_CHECK_BLOCK);
+        int64_t t1 = wwv_refclock_host_ns();
+        *s16_ok = rc_stamp_within(mgr, RC_CHECK_BLOCK, t0, t1);
+
+        t0 = wwv_refclock_host_ns();
+        for (size_t k = 0; k < RC_CHECK_SAMPLES; k++) {
+            wwv_detector_manager_process_detector_sample(mgr, i_buf[k], q_buf[k]);
+        }
+        t1 = wwv_refclock_host_ns();
+        /* Sample numbers count from 1: the last tile began with this one */
+        uint64_t total = RC_CHECK_BLOCK + RC_CHECK_SAMPLES;
+        uint64_t tile = (total - 1) / RC_CHECK_TILE * RC_CHECK_TILE + 1;
+        *sample_ok = rc_stamp_within(mgr, tile, t0, t1);
+    }
+    free(i_buf);
+    free(q_buf);
+    free(iq);
+    wwv_detector_manager_destroy(mgr);
+    wwv_synth_destroy(s);
+    return ran;
+}
+
+static bool rc_check_publish(void) {
+    int sock = socket(AF_UNIX, SOCK_DGRAM, 0);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, RC_CHECK_SOCK);
+    remove(RC_CHECK_SOCK);
+    if (sock < 0 || bind(sock, (const struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        fprintf(stderr, "[BENCH] refclock  cannot listen on " RC_CHECK_SOCK "  FAIL\n");
+        if (sock >= 0) close(sock);
+        return false;
+    }
+    wwv_refclock_config_t rc_config = { .kind = WWV_REFCLOCK_CHRONY_SOCK, .sock_path = RC_CHECK_SOCK };
+    wwv_refclock_t *rc = wwv_refclock_open(&rc_config);
+
+    rc_pass_t rp = { 0, 0, 0 };
+    bool s16_ok = false, sample_ok = false;
+    bool ran = rc && rc_pass_threaded(rc, &rp) && rc_pass_entries(rc, &s16_ok, &sample_ok);
+    int64_t host_ns = rp.host_ns;
+    rc_sock_sample_t got;
+    int unsolicited = 0;
+    while (recv(sock, &got, sizeof(got), MSG_DONTWAIT) > 0) unsolicited++;
+    uint64_t published = wwv_refclock_get_published(rc);
+
+    /* Second 7 of 2025-01-01 00:00, received at the run's last stamp */
+    wwv_refclock_sample_t sample = {
+        .utc_sec = wwv_refclock_unix_time(25, 1, 0, 0) + 7,
+        .receive_ns = host_ns,
+        .leap = WWV_LEAP_INSERT
+    };
+    bool sent = ran && wwv_refclock_publish(rc, &sample);
+    memset(&got, 0, sizeof(got));
+    bool received = sent && recv(sock, &got, sizeof(got), MSG_DONTWAIT) == (ssize_t)sizeof(got);
+    double offset = (double)(sample.utc_sec - host_ns / 1000000000) -
+                    (double)(host_ns % 1000000000 / 1000) * 1e-6;
+    bool sample_match = received && got.magic == RC_SOCK_MAGIC && got.leap == WWV_LEAP_INSERT &&
+                        (int64_t)got.tv.tv_sec == host_ns / 1000000000 &&
+                        (int64_t)got.tv.tv_usec == host_ns % 1000000000 / 1000 &&
+                        fabs(got.offset - offset) < 1e-6;
+    wwv_refclock_close(rc);
+    close(sock);
+    remove(RC_CHECK_SOCK);
+    if (!ran) {
+        fprintf(stderr, "[BENCH] refclock  socket or manager pass failed  FAIL\n");
+        return false;
+    }
+
+    bool stamp_ok = rp.stamped == RC_CHECK_SEC && s16_ok && sample_ok;
+    bool quiet_ok = published == 0 && unsolicited == 0;
+    fprintf(stderr, "[BENCH] refclock  stamps: %d of %d threaded pushes, int16 block %s, "
+            "per-sample %s  %s\n", rp.stamped, RC_CHECK_SEC, s16_ok ? "ok" : "wrong",
+            sample_ok ? "once a tile" : "wrong", stamp_ok ? "ok" : "FAIL");
+    fprintf(stderr, "[BENCH] refclock  BCD time unsolved: %llu published, %d received  %s\n",
+            (unsigned long long)published, unsolicited, quiet_ok ? "ok" : "FAIL");
+    fprintf(stderr, "[BENCH] refclock  chrony SOCK sample: %s  %s\n",
+            !received ? "not received" : sample_match ? "time, offset and leap as sent" : "differs",
+            sample_match ? "ok" : "FAIL");
+    return stamp_ok && quiet_ok && sample_match;
+}
+
+#endif
+
+static bool run_refclock_check(void) {
+    bool time_ok = rc_check_unix_time();
+#ifdef _WIN32
+    wwv_refclock_config_t rc_config = { .kind = WWV_REFCLOCK_CHRONY_SOCK, .sock_path = RC_CHECK_SOCK };
+    wwv_refclock_t *rc = wwv_refclock_open(&rc_config);
+    bool publish_ok = rc == NULL;
+    wwv_refclock_close(rc);
+    fprintf(stderr, "[BENCH] refclock  not supported here: open refused  %s\n",
+            publish_ok ? "ok" : "FAIL");
+#else
+    bool publish_ok = rc_check_publish();
+#endif
+    return time_ok && publish_ok;
+}
+
+/*============================================================================
+ * Telemetry Sender Check
+ *============================================================================*/
+
+/*
+ * Several producer threads send sequence-numbered lines through a started
+ * sender to a loopback socket of the check's own; every line must arrive
+ * exactly once and be counted sent. Then a sender parked for a minute is
+ * handed more than its queue holds: the overflow must be counted dropped
+ * and everything accepted must still arrive once the sender is stopped.
+ * The manager pass checks the per-sample path keeps the binary age bound.
+ */
+
+#define TS_CHECK_PRODUCERS      4
+#define TS_CHECK_MESSAGES       2000    /* Per producer */
+#define TS_CHECK_FULL_SLOTS     64      /* Queue of the full-queue pass */
+#define TS_CHECK_FULL_MESSAGES  (4 * TS_CHECK_FULL_SLOTS)
+#define TS_CHECK_PARK_MS        60000   /* Full-queue sender: one drain at start, then this */
+#define TS_CHECK_SETTLE_MS      200     /* Lets the parked sender finish its first drain */
+#define TS_CHECK_RCVBUF         (1 << 20)
+#define TS_CHECK_AGE_SEC        6       /* Per-sample manager pass */
+
+#ifndef _WIN32
+
+typedef struct {
+    int sock;
+    int producers;
+    int messages;                   /* Per producer */
+    uint8_t *seen;                  /* Per (producer, sequence) */
+    int received;
+    int duplicates;
+    int malformed;
+    atomic_bool stop;               /* Set once the sender has drained */
+} ts_receiver_t;
+
+/* Reads "TICK,producer,sequence" lines until stopped and the socket is quiet */
+static void ts_receive(void *arg) {
+    ts_receiver_t *rx = (ts_receiver_t *)arg;
+    char buf[TELEM_WIRE_MTU + 1];
+    for (;;) {
+        ssize_t n = recv(rx->sock, buf, TELEM_WIRE_MTU, 0);
+        if (n <= 0) {
+            if (atomic_load(&rx->stop)) break;
+            continue;
+        }
+        buf[n] = '\0';
+        for (char *line = buf, *end; *line; line = end + 1) {
+            end = strchr(line, '\n');
+            if (!end) {
+                rx->malformed++;
+                break;
+            }
+            *end = '\0';
+            int p, k;
+            if (sscanf(line, "TICK,%d,%d", &p, &k) != 2 || p < 0 || p >= rx->producers ||
+                k < 0 || k >= rx->messages) {
+                rx->malformed++;
+                continue;
+            }
+            uint8_t *seen = &rx->seen[(size_t)p * (size_t)rx->messages + (size_t)k];
+            if (*seen) rx->duplicates++;
+            else rx->received++;
+            *seen = 1;
+        }
+    }
+}
+
+typedef struct {
+    telem_ctx_t *ctx;
+    int producer;
+    int messages;
+} ts_producer_t;
+
+static void ts_produce(void *arg) {
+    ts_producer_t *p = (ts_producer_t *)arg;
+    for (int k = 0; k < p->messages; k++) {
+        telem_ctx_sendf(p->ctx, TELEM_TICKS, "%d,%d", p->producer, k);
+    }
+}
+
+/* A loopback socket with a short receive timeout; its port in *port */
+static int ts_listen(int *port) {
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0) return -1;
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    int rcvbuf = TS_CHECK_RCVBUF;
+    struct timeval timeout = { 0, 100000 };
+    setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    if (bind(sock, (const struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+        getsockname(sock, (struct sockaddr *)&addr, &len) != 0) {
+        close(sock);
+        return -1;
+    }
+    *port = ntohs(addr.sin_port);
+    return sock;
+}
+
+typedef struct {
+    telem_channel_stats_t stats;
+    int received;
+    int duplicates;
+    int malformed;
+} ts_pass_t;
+
+/*
+ * One sender pass: producers > 0 run on their own threads while the
+ * sender runs, producers == 0 sends `messages` lines from here
+ */
+static bool ts_run_pass(int sock, int port, const telem_sender_config_t *sender,
+                        int producers, int messages, unsigned settle_ms, ts_pass_t *out) {
+    int senders = producers > 0 ? producers : 1;
+    ts_receiver_t rx;
+    memset(&rx, 0, sizeof(rx));
+    rx.sock = sock;
+    rx.producers = senders;
+    rx.messages = messages;
+    rx.seen = calloc((size_t)senders * (size_t)messages, 1);
+    atomic_init(&rx.stop, false);
+
+    telem_ctx_t *ctx = rx.seen ? telem_ctx_create("127.0.0.1", port) : NULL;
+    wwv_thread_t rx_thread;
+    bool ran = ctx && telem_ctx_start_sender(ctx, sender) &&
+               wwv_thread_create(&rx_thread, ts_receive, &rx);
+    if (!ran) {
+        telem_ctx_destroy(ctx);
+        free(rx.seen);
+        return false;
+    }
+    if (settle_ms) bench_sleep_ms(settle_ms);
+
+    ts_producer_t prod[TS_CHECK_PRODUCERS];
+    wwv_thread_t threads[TS_CHECK_PRODUCERS];
+    int started = 0;
+    for (int p = 0; p < producers && p < TS_CHECK_PRODUCERS; p++) {
+        prod[p] = (ts_producer_t){ ctx, p, messages };
+        if (wwv_thread_create(&threads[p], ts_produce, &prod[p])) started++;
+        else ran = false;
+    }
+    if (producers == 0) {
+        ts_producer_t self = { ctx, 0, messages };
+        ts_produce(&self);
+    }
+    for (int p = 0; p < started; p++) wwv_thread_join(threads[p]);
+
+    /* Stopping drains the queue; then the receiver reads until quiet */
+    telem_ctx_stop_sender(ctx);
+    telem_ctx_get_channel_stats(ctx, TELEM_TICKS, &out->stats);
+    atomic_store(&rx.stop, true);
+    wwv_thread_join(rx_thread);
+    telem_ctx_destroy(ctx);
+
+    out->received = rx.received;
+    out->duplicates = rx.duplicates;
+    out->malformed = rx.malformed;
+    free(rx.seen);
+    return ran;
+}
+
+static bool ts_check_sender(void) {
+    int port = 0;
+    int sock = ts_listen(&port);
+    if (sock < 0) {
+        fprintf(stderr, "[BENCH] telemetry  cannot listen on loopback  FAIL\n");
+        return false;
+    }
+
+    /* Room for every message: nothing may be lost or repeated */
+    telem_sender_config_t cfg = TELEM_SENDER_CONFIG_DEFAULT;
+    cfg.queue_slots = TS_CHECK_PRODUCERS * TS_CHECK_MESSAGES;
+    cfg.poll_interval_ms = 1;
+    ts_pass_t all;
+    bool ran = ts_run_pass(sock, port, &cfg, TS_CHECK_PRODUCERS, TS_CHECK_MESSAGES, 0, &all);
+    int total = TS_CHECK_PRODUCERS * TS_CHECK_MESSAGES;
+    bool all_ok = ran && all.received == total && all.duplicates == 0 && all.malformed == 0 &&
+                  all.stats.sent == (uint32_t)total && all.stats.dropped == 0;
+    fprintf(stderr, "[BENCH] telemetry  %d producers x %d lines: %d received, %d duplicated, "
+            "%d malformed, %u sent, %u dropped  %s\n", TS_CHECK_PRODUCERS, TS_CHECK_MESSAGES,
+            all.received, all.duplicates, all.malformed, all.stats.sent, all.stats.dropped,
+            all_ok ? "ok" : "FAIL");
+
+    /* A parked sender: what its queue cannot hold is dropped and counted */
+    cfg.queue_slots = TS_CHECK_FULL_SLOTS;
+    cfg.poll_interval_ms = TS_CHECK_PARK_MS;
+    ts_pass_t full;
+    ran = ts_run_pass(sock, port, &cfg, 0, TS_CHECK_FULL_MESSAGES, TS_CHECK_SETTLE_MS, &full);
+    close(sock);
+    bool full_ok = ran && full.stats.dropped > 0 && full.duplicates == 0 && full.malformed == 0 &&
+                   full.stats.sent + full.stats.dropped == TS_CHECK_FULL_MESSAGES &&
+                   full.received == (int)full.stats.sent;
+    fprintf(stderr, "[BENCH] telemetry  %d lines into a parked %d-slot queue: %u sent, "
+            "%u dropped (%d expected), %d received  %s\n", TS_CHECK_FULL_MESSAGES,
+            TS_CHECK_FULL_SLOTS, full.stats.sent, full.stats.dropped,
+            TS_CHECK_FULL_MESSAGES - TS_CHECK_FULL_SLOTS, full.received, full_ok ? "ok" : "FAIL");
+    return all_ok && full_ok;
+}
+
+/* Binary records in the datagrams already queued on the socket */
+static int ts_drain_records(int sock) {
+    uint8_t buf[TELEM_WIRE_MTU];
+    int records = 0;
+    ssize_t n;
+    while ((n = recv(sock, buf, sizeof(buf), MSG_DONTWAIT)) > 0) {
+        telem_wire_frame_header_t header;
+        if (telem_wire_parse_header(buf, (size_t)n, &header)) records += header.record_count;
+    }
+    return records;
+}
+
+typedef struct {
+    telem_ctx_t *ctx;
+    int sock;
+    int delivered;                  /* Records out before the boundary */
+    int held;                       /* Records only a flush there sent */
+} ts_age_t;
+
+static void ts_age_check(ts_age_t *ta) {
+    ta->delivered += ts_drain_records(ta->sock);
+    telem_ctx_flush(ta->ctx);
+    ta->held += ts_drain_records(ta->sock);
+}
+
+/* Ticks are within a few ms of the second: half way on, their records are out */
+static void ts_age_feed(wwv_detector_manager_t *mgr, const bench_source_t *src,
+                        size_t det_n, size_t disp_n, void *user) {
+    ts_age_t *ta = (ts_age_t *)user;
+    for (size_t k = 0; k < det_n; k++) {
+        if (k == det_n / 2) ts_age_check(ta);
+        wwv_detector_manager_process_detector_sample(mgr, src->det_i[k], src->det_q[k]);
+    }
+    for (size_t k = 0; k < disp_n; k++) {
+        wwv_detector_manager_process_display_sample(mgr, src->disp_i[k], src->disp_q[k]);
+    }
+}
+
+static bool ts_check_manager_age(void) {
+    int port = 0;
+    int sock = ts_listen(&port);
+    telem_ctx_t *ctx = sock >= 0 ? telem_ctx_create("127.0.0.1", port) : NULL;
+    if (!ctx) {
+        fprintf(stderr, "[BENCH] telemetry  cannot open a loopback context  FAIL\n");
+        if (sock >= 0) close(sock);
+        return false;
+    }
+    telem_ctx_set_format(ctx, TELEM_FORMAT_BINARY);
+    telem_ctx_set_channels(ctx, TELEM_TICKS);
+
+    ts_age_t ta = { ctx, sock, 0, 0 };
+    manager_pass_t pass;
+    manager_pass_init(&pass, TS_CHECK_AGE_SEC);
+    pass.config.telemetry = ctx;
+    pass.feed = ts_age_feed;
+    pass.user = &ta;
+    bool ran = manager_pass(&pass, NULL);
+    telem_ctx_destroy(ctx);
+    close(sock);
+
+    bool ok = ran && ta.delivered >= TS_CHECK_AGE_SEC - 2 && ta.held == 0;
+    fprintf(stderr, "[BENCH] telemetry  per-sample manager, %d s: %d tick records sent "
+            "within %.0f ms, %d held past it  %s\n", TS_CHECK_AGE_SEC, ta.delivered,
+            TELEM_BINARY_MAX_AGE_US / 1000.0, ta.held, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+#endif
+
+static bool run_telem_check(void) {
+#ifdef _WIN32
+    fprintf(stderr, "[BENCH] telemetry  loopback check not run here  ok\n");
+    return true;
+#else
+    bool sender_ok = ts_check_sender();
+    bool age_ok = ts_check_manager_age();
+    return sender_ok && age_ok;
+#endif
+}
+
+/*============================================================================
+ * BCD Integration Check
+ *============================================================================*/
+
+/*
+ * The BCD detectors do not pick the synthetic 100 Hz subcarrier out of
+ * its -15 dB low level, so the pulses they would report off a weak
+ * broadcast are made here from the synth's frames: nearly a third of
+ * them lost, edges and widths smeared. Both rings get the same pulses,
+ * with the sync anchor at each minute's :00. One minute mostly lacks the
+ * position markers to align on; eight decode once the ring is full.
+ */
+
+#define BI_CHECK_ROWS           8
+#define BI_CHECK_MINUTES        10      /* 23:56 day 100 .. 00:05 day 101 */
+#define BI_CHECK_START_HOUR     23
+#define BI_CHECK_START_MINUTE   56
+#define BI_CHECK_START_DAY      100
+#define BI_CHECK_ANCHOR_MS      7250.0  /* Stream time of the first minute's :00 */
+#define BI_CHECK_DROP           0.3f    /* Pulses lost */
+#define BI_CHECK_EDGE_MS        20.0f   /* Leading edge spread (+-) */
+#define BI_CHECK_WIDTH_MS       60.0f   /* Width spread (+-) */
+#define BI_CHECK_START_TOL_MS   50.0
+
+typedef struct {
+    int minute, hour, day, year;
+} bi_time_t;
+
+static bi_time_t bi_truth(const wwv_synth_config_t *sc, int minute_index) {
+    int total = sc->start_hour * 60 + sc->start_minute + minute_index;
+    bi_time_t t = { total % 60, total / 60 % 24, sc->start_day + total / 1440, sc->year };
+    return t;
+}
+
+static void bi_feed_minute(bcd_correlator_t *corr, const wwv_synth_t *synth, int m,
+                           uint32_t *seed) {
+    double anchor = BI_CHECK_ANCHOR_MS + m * 60000.0;
+    for (int sec = 0; sec < 60; sec++) {
+        int sym = wwv_synth_bcd_symbol(synth, m, sec);
+        if (sym >= 0 && 0.5f * (kc_uniform(seed) + 1.0f) >= BI_CHECK_DROP) {
+            static const float width_ms[3] = { 200.0f, 500.0f, 800.0f };
+            float width = width_ms[sym] + BI_CHECK_WIDTH_MS * kc_uniform(seed);
+            bcd_integrator_add_pulse(corr, anchor,
+                                     anchor + sec * 1000.0 + BI_CHECK_EDGE_MS * kc_uniform(seed),
+                                     width);
+        }
+    }
+}
+
+typedef struct {
+    int decoded;                /* Minutes whose decode gave their true time */
+    int full;                   /* ...of those once the ring was full */
+    int start_ok;               /* ...with the minute start within tolerance */
+    int accepted;
+} bi_run_t;
+
+/* Each minute is decoded when the next one's first pulse arrives */
+static bool bi_run(const wwv_synth_config_t *sc, int rows, bi_run_t *run) {
+    memset(run, 0, sizeof(*run));
+    wwv_synth_t *synth = wwv_synth_create(sc);
+    bcd_correlator_t *corr = synth ? bcd_correlator_create(NULL) : NULL;
+    bool ran = corr && bcd_correlator_set_integration(corr, rows);
+    uint32_t seed = 24680u;
+
+    for (int m = 0; ran && m <= BI_CHECK_MINUTES; m++) {
+        bi_feed_minute(corr, synth, m, &seed);
+        if (m == 0) continue;
+        bcd_integrated_frame_t f;
+        bi_time_t t = bi_truth(sc, m - 1);
+        if (!bcd_correlator_get_integrated_frame(corr, &f) || f.minute != t.minute ||
+            f.hour != t.hour || f.day != t.day || f.year != t.year) {
+            continue;
+        }
+        run->decoded++;
+        if (m - 1 >= rows - 1) run->full++;
+        double start = BI_CHECK_ANCHOR_MS + (m - 1) * 60000.0;
+        if (fabs(f.minute_start_ms - start) <= BI_CHECK_START_TOL_MS) run->start_ok++;
+    }
+    run->accepted = ran ? corr->integ->accepted : 0;
+
+    bcd_correlator_destroy(corr);
+    wwv_synth_destroy(synth);
+    return ran;
+}
+
+static bool run_bcd_integrate_check(void) {
+    wwv_synth_config_t sc = WWV_SYNTH_CONFIG_DEFAULT;
+    sc.start_hour = BI_CHECK_START_HOUR;
+    sc.start_minute = BI_CHECK_START_MINUTE;
+    sc.start_day = BI_CHECK_START_DAY;
+
+    bi_run_t multi, single;
+    if (!bi_run(&sc, BI_CHECK_ROWS, &multi) || !bi_run(&sc, 1, &single)) return false;
+
+    int full_minutes = BI_CHECK_MINUTES - (BI_CHECK_ROWS - 1);
+    bool multi_ok = multi.full >= full_minutes - 1 && multi.accepted == multi.decoded &&
+                    multi.start_ok == multi.decoded;
+    bool single_ok = single.decoded == 0;
+    fprintf(stderr, "[BENCH] bcd integrate  %d-minute ring, 23:56-00:05 day %d-%d: "
+            "%d of %d full-ring minutes decoded (%d in all, %d accepted), "
+            "%d minute starts within %.0f ms  %s\n",
+            BI_CHECK_ROWS, BI_CHECK_START_DAY, BI_CHECK_START_DAY + 1, multi.full, full_minutes,
+            multi.decoded, multi.accepted, multi.start_ok, BI_CHECK_START_TOL_MS,
+            multi_ok ? "ok" : "FAIL");
+    fprintf(stderr, "[BENCH] bcd integrate  1-minute ring, same pulses: %d minutes decoded right "
+            "(%d accepted)  %s\n", single.decoded, single.accepted, single_ok ? "ok" : "FAIL");
+    return multi_ok && single_ok;
+}
+
+/*============================================================================
+ * Tick Sliding DFT Check
+ *============================================================================*/
+
+/*
+ * One tick detector's matched filter, driven directly: every sample goes
+ * through the sliding DFT, and the reference MAC correlates the same
+ * template span. The sliding bins drift by rounding between re-seeds
+ * (every TICK_SDFT_RESYNC_SAMPLES), so the last TSD_CHECK_EDGE samples
+ * before each re-seed and the first after it are also reported apart.
+ * The error is taken against the largest reference correlation (a tick).
+ */
+
+#define TSD_CHECK_SEC           2.5     /* Two re-seeds */
+#define TSD_CHECK_EDGE          1000    /* Samples either side of a re-seed */
+#define TSD_CHECK_TOL           1e-5    /* Of the tick peak */
+
+static bool run_tick_sdft_check(void) {
+    wwv_synth_config_t sc = WWV_SYNTH_CONFIG_DEFAULT;
+    size_t count = (size_t)(TSD_CHECK_SEC * BENCH_DETECTOR_RATE);
+    wwv_synth_t *synth = wwv_synth_create(&sc);
+    tick_detector_t *td = tick_detector_create(NULL);
+    float *xi = malloc(count * sizeof(float));
+    float *xq = malloc(count * sizeof(float));
+    bool ran = synth && td && xi && xq && td->corr_mode == TICK_CORR_MODE_SLIDING;
+    double peak = 0.0, worst = 0.0, before = 0.0, after = 0.0;
+    int resyncs = 0;
+
+    if (ran) {
+        wwv_synth_generate(synth, xi, xq, count);
+        const wwv_sample_t taps = (wwv_sample_t)td->stream.template_samples;
+        for (size_t k = 0; k < count; k++) {
+            float corr[TICK_MAX_STATIONS];
+            tick_correlation_slide(td, xi[k], xq[k], corr);
+            if (td->corr_sample_count < taps) continue;
+
+            double ref = tick_correlation_compute(td, 0);
+            double err = fabs((double)corr[0] - ref);
+            if (ref > peak) peak = ref;
+            if (err > worst) worst = err;
+
+            /* Re-seeds land on multiples of TICK_SDFT_RESYNC_SAMPLES */
+            wwv_sample_t phase = td->corr_sample_count % TICK_SDFT_RESYNC_SAMPLES;
+            if (phase == 0) resyncs++;
+            if (phase > TICK_SDFT_RESYNC_SAMPLES - TSD_CHECK_EDGE && err > before) before = err;
+            bool reseeded = td->corr_sample_count > TICK_SDFT_RESYNC_SAMPLES;
+            if (reseeded && phase > 0 && phase <= TSD_CHECK_EDGE && err > after) after = err;
+        }
+    }
+    free(xi);
+    free(xq);
+    tick_detector_destroy(td);
+    wwv_synth_destroy(synth);
+    if (!ran) return false;
+
+    double tol = TSD_CHECK_TOL * peak;
+    bool ok = peak > 0.0 && resyncs >= 2 && worst <= tol;
+    fprintf(stderr, "[BENCH] tick_sdft  %.1f s, %d re-seeds: max |sliding - MAC| %.2e of the "
+            "tick peak (%.2e before a re-seed, %.2e after), limit %.0e  %s\n",
+            TSD_CHECK_SEC, resyncs, peak > 0.0 ? worst / peak : 0.0,
+            peak > 0.0 ? before / peak : 0.0, peak > 0.0 ? after / peak : 0.0,
+            TSD_CHECK_TOL, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+/*============================================================================
+ * Timebase Check
+ *============================================================================*/
+
+#define TB_CHECK_WARMUP_SEC     2
+#define TB_CHECK_SEC            20
+#define TB_CHECK_GAP_SAMPLES    (200 * TICK_FFT_SIZE)
+#define TB_CHECK_MAX_TICKS      64
+#define TB_CHECK_SKIP_SAMPLES   1080000000ull   /* Six hours at 50 kHz, whole frames */
+#define TB_CHECK_TOL_MS         1e-6
+
+typedef struct {
+    double timestamp_ms[TB_CHECK_MAX_TICKS];
+    uint64_t sample_index[TB_CHECK_MAX_TICKS];
+    int ticks;
+} tb_ticks_t;
+
+static void tb_on_tick(const tick_event_t *event, void *user_data) {
+    tb_ticks_t *t = (tb_ticks_t *)user_data;
+    if (t->ticks < TB_CHECK_MAX_TICKS) {
+        t->timestamp_ms[t->ticks] = event->timestamp_ms;
+        t->sample_index[t->ticks] = event->sample_index;
+        t->ticks++;
+    }
+}
+
+/* Warm up, skip about a second of whole frames plus `extra`, run on */
+static bool tb_pass(uint64_t extra, tb_ticks_t *t) {
+    wwv_synth_config_t sc = WWV_SYNTH_CONFIG_DEFAULT;
+    bench_source_t src;
+    tick_detector_t *td = tick_detector_create(NULL);
+    bool ok = source_open(&src, &sc, false) && td;
+    size_t fed = 0;
+    if (ok) {
+        memset(t, 0, sizeof(*t));
+        tick_detector_set_callback(td, tb_on_tick, t);
+        for (int sec = 0; ok && sec < TB_CHECK_WARMUP_SEC + TB_CHECK_SEC; sec++) {
+            size_t det_n, disp_n;
+            source_next(&src, 1.0, &det_n, &disp_n);
+            if (sec == TB_CHECK_WARMUP_SEC - 1) det_n -= (fed + det_n) % TICK_FFT_SIZE;
+            tick_detector_process_block(td, src.det_i, src.det_q, det_n);
+            fed += det_n;
+            if (sec == TB_CHECK_WARMUP_SEC - 1) {
+                ok = tick_detector_skip(td, TB_CHECK_GAP_SAMPLES + extra);
+            }
+        }
+    }
+    tick_detector_destroy(td);
+    source_close(&src);
+    return ok;
+}
+
+/*
+ * Both runs see the same samples around the same skip, six hours longer
+ * in one, so ticks are paired by sample index. Each pair must sit exactly
+ * TB_CHECK_SKIP_SAMPLES apart and its timestamps exactly that apart in ms,
+ * and each timestamp must be its own sample index in ms.
+ */
+static bool run_timebase_check(void) {
+    static tb_ticks_t early, late;
+    if (!tb_pass(0, &early) || !tb_pass(TB_CHECK_SKIP_SAMPLES, &late)) return false;
+
+    const double skip_ms = wwv_samples_to_ms(TB_CHECK_SKIP_SAMPLES, BENCH_DETECTOR_RATE);
+    int paired = 0, exact = 0, consistent = 0;
+    for (int l = 0; l < late.ticks; l++) {
+        double ms = wwv_samples_to_ms(late.sample_index[l], BENCH_DETECTOR_RATE);
+        if (fabs(late.timestamp_ms[l] - ms) <= TB_CHECK_TOL_MS) consistent++;
+        /* Warm-up ticks come before the skip in both runs */
+        bool skipped = late.sample_index[l] >= TB_CHECK_SKIP_SAMPLES;
+        uint64_t shift = skipped ? TB_CHECK_SKIP_SAMPLES : 0;
+        double shift_ms = skipped ? skip_ms : 0.0;
+        for (int e = 0; e < early.ticks; e++) {
+            if (late.sample_index[l] != early.sample_index[e] + shift) continue;
+            paired++;
+            if (fabs(late.timestamp_ms[l] - early.timestamp_ms[e] - shift_ms) <= TB_CHECK_TOL_MS) {
+                exact++;
+            }
+            break;
+        }
+    }
+
+    bool ok = early.ticks >= TB_CHECK_SEC && paired == early.ticks &&
+              exact == paired && consistent == late.ticks;
+    fprintf(stderr, "[BENCH] timebase  %d s at +%.0f h: %d / %d ticks paired by sample index, "
+            "%d with timestamps exactly as far apart, %d timestamps on their sample  %s\n",
+            TB_CHECK_SEC, skip_ms / 3.6e6, paired, early.ticks, exact, consistent,
+            ok ? "ok" : "FAIL");
+    return ok;
+}
+
+/*============================================================================
+ * Running Percentile Check
+ *============================================================================*/
+
+#define RP_CHECK_PUSHES         5000
+#define RP_CHECK_MAX_WINDOW     256
+
+typedef struct {
+    int window;
+    int percentile;
+} rp_case_t;
+
+/* The noise floors' 256 / 20, plus edge ranks and an odd window */
+static const rp_case_t rp_check_cases[] = {
+    { 256, 20 }, { 256, 50 }, { 256, 0 }, { 256, 100 }, { 37, 90 }, { 1, 50 },
+};
+
+static int rp_cmp(const void *a, const void *b) {
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+/* What the detectors computed before: sort the window, take the rank */
+static float rp_sorted(const float *ring, int count, int percentile) {
+    float sorted[RP_CHECK_MAX_WINDOW];
+    memcpy(sorted, ring, (size_t)count * sizeof(float));
+    qsort(sorted, (size_t)count, sizeof(float), rp_cmp);
+    int idx = (count * percentile) / 100;
+    return sorted[idx < count ? idx : count - 1];
+}
+
+static bool rp_check_case(const rp_case_t *c, int *mismatches, double *push_ns) {
+    running_percentile_t *rp = running_percentile_create(c->window, c->percentile);
+    if (!rp) return false;
+    float ring[RP_CHECK_MAX_WINDOW];
+    int count = 0, head = 0;
+    uint32_t seed = 0x5eed0000u + (uint32_t)c->window * 101u + (uint32_t)c->percentile;
+    float value = 0.0f;
+    uint64_t ns = 0;
+
+    for (int k = 0; k < RP_CHECK_PUSHES; k++) {
+        if (k == RP_CHECK_PUSHES / 2) {
+            running_percentile_reset(rp);
+            count = head = 0;
+        }
+        /* Runs of repeats test ties; quantized values make more of them */
+        if (kc_rand(&seed) % 4 != 0) value = roundf(kc_uniform(&seed) * 64.0f) / 8.0f;
+        uint64_t t0 = bench_now_ns();
+        running_percentile_push(rp, value);
+        ns += bench_now_ns() - t0;
+        ring[head] = value;
+        head = (head + 1) % c->window;
+        if (count < c->window) count++;
+        if (running_percentile_count(rp) != count ||
+            running_percentile_get(rp) != rp_sorted(ring, count, c->percentile)) {
+            (*mismatches)++;
+        }
+    }
+    running_percentile_destroy(rp);
+    *push_ns = (double)ns / RP_CHECK_PUSHES;
+    return true;
+}
+
+static bool run_percentile_check(void) {
+    bool ok = true;
+    for (size_t k = 0; k < sizeof(rp_check_cases) / sizeof(rp_check_cases[0]); k++) {
+        const rp_case_t *c = &rp_check_cases[k];
+        int mismatches = 0;
+        double push_ns = 0.0;
+        bool ran = rp_check_case(c, &mismatches, &push_ns);
+        bool case_ok = ran && mismatches == 0;
+        fprintf(stderr, "[BENCH] percentile  window %3d, %3d%%: %d / %d pushes differ from a "
+                "sort  %.0f ns/push  %s\n", c->window, c->percentile, mismatches,
+                RP_CHECK_PUSHES, push_ns, case_ok ? "ok" : "FAIL");
+        ok = ok && case_ok;
+    }
+    return ok;
+}
+
+/*============================================================================
+ * Window Ring Check
+ *============================================================================*/
+
+#define WR_CHECK_OPS            20000
+#define WR_CHECK_SIZE           250     /* The tick template length */
+#define WR_CHECK_SEC            65      /* One minute marker */
+
+/* Blocks the detector frames land in: per sample, aligned, straddling */
+static const size_t wr_check_blocks[] = { 1, TICK_FFT_SIZE, 4 * TICK_FFT_SIZE, 777, 5000 };
+
+/* Random pushes and writes (some longer than the ring) against a linear history */
+static bool wr_check_ring(int *mismatches) {
+    enum { HISTORY = WR_CHECK_SIZE + WR_CHECK_OPS * 4 };
+    static float history[HISTORY];
+    float block[3 * WR_CHECK_SIZE];
+    wwv_window_ring_t ring;
+    if (!wwv_window_ring_init(&ring, WR_CHECK_SIZE)) return false;
+
+    uint32_t seed = 0x0018u;
+    size_t len = WR_CHECK_SIZE;         /* A fresh ring reads as zeros */
+    memset(history, 0, sizeof(history));
+    for (int op = 0; op < WR_CHECK_OPS && len + 3 * WR_CHECK_SIZE <= HISTORY; op++) {
+        if (op == WR_CHECK_OPS / 2) {
+            wwv_window_ring_reset(&ring);
+            memset(history + len, 0, WR_CHECK_SIZE * sizeof(float));
+            len += WR_CHECK_SIZE;
+        }
+        if (kc_rand(&seed) % 8 != 0) {
+            float v = kc_uniform(&seed);
+            wwv_window_ring_push(&ring, v);
+            history[len++] = v;
+        } else {
+            size_t n = kc_rand(&seed) % (3 * WR_CHECK_SIZE) + 1;
+            for (size_t k = 0; k < n; k++) block[k] = kc_uniform(&seed);
+            wwv_window_ring_write(&ring, block, n);
+            memcpy(history + len, block, n * sizeof(float));
+            len += n;
+        }
+        int recent = (int)(kc_rand(&seed) % WR_CHECK_SIZE) + 1;
+        const float *want = history + len - WR_CHECK_SIZE;
+        if (memcmp(wwv_window_ring_window(&ring), want, WR_CHECK_SIZE * sizeof(float)) != 0 ||
+            memcmp(wwv_window_ring_recent(&ring, recent), history + len - recent,
+                   (size_t)recent * sizeof(float)) != 0) {
+            (*mismatches)++;
+        }
+    }
+    wwv_window_ring_free(&ring);
+    return true;
+}
+
+static void wr_on_tick(const tick_event_t *e, void *user_data) {
+    tile_digest_t *d = (tile_digest_t *)user_data;
+    digest_bytes(d, &e->sample_index, sizeof(e->sample_index));
+    digest_bytes(d, &e->epoch_ms, sizeof(e->epoch_ms));
+    digest_bytes(d, &e->duration_ms, sizeof(e->duration_ms));
+    digest_bytes(d, &e->corr_peak, sizeof(e->corr_peak));
+    d->events++;
+}
+
+static void wr_on_marker(const marker_event_t *e, void *user_data) {
+    tile_digest_t *d = (tile_digest_t *)user_data;
+    digest_bytes(d, &e->sample_index, sizeof(e->sample_index));
+    digest_bytes(d, &e->duration_ms, sizeof(e->duration_ms));
+    digest_bytes(d, &e->accumulated_energy, sizeof(e->accumulated_energy));
+    d->events++;
+}
+
+static void wr_on_bcd_time(const bcd_time_event_t *e, void *user_data) {
+    tile_digest_t *d = (tile_digest_t *)user_data;
+    digest_bytes(d, &e->sample_index, sizeof(e->sample_index));
+    digest_bytes(d, &e->duration_ms, sizeof(e->duration_ms));
+    digest_bytes(d, &e->peak_energy, sizeof(e->peak_energy));
+    d->events++;
+}
+
+static void wr_on_bcd_freq(const bcd_freq_event_t *e, void *user_data) {
+    tile_digest_t *d = (tile_digest_t *)user_data;
+    digest_bytes(d, &e->sample_index, sizeof(e->sample_index));
+    digest_bytes(d, &e->duration_ms, sizeof(e->duration_ms));
+    digest_bytes(d, &e->accumulated_energy, sizeof(e->accumulated_energy));
+    d->events++;
+}
+
+/* One digest per detector: tick, marker, BCD time, BCD freq */
+#define WR_CHECK_DETECTORS      4
+
+static bool wr_pass(size_t block, tile_digest_t *d) {
+    wwv_synth_config_t sc = WWV_SYNTH_CONFIG_DEFAULT;
+    bench_source_t src;
+    tick_detector_t *tick = tick_detector_create(NULL);
+    marker_detector_t *marker = marker_detector_create(NULL);
+    bcd_time_detector_t *bcd_time = bcd_time_detector_create(NULL);
+    bcd_freq_detector_t *bcd_freq = bcd_freq_detector_create(NULL);
+    bool ok = source_open(&src, &sc, false) && tick && marker && bcd_time && bcd_freq;
+    if (ok) {
+        for (int k = 0; k < WR_CHECK_DETECTORS; k++) digest_init(&d[k]);
+        tick_detector_set_callback(tick, wr_on_tick, &d[0]);
+        marker_detector_set_callback(marker, wr_on_marker, &d[1]);
+        bcd_time_detector_set_callback(bcd_time, wr_on_bcd_time, &d[2]);
+        bcd_freq_detector_set_callback(bcd_freq, wr_on_bcd_freq, &d[3]);
+        for (int sec = 0; sec < WR_CHECK_SEC; sec++) {
+            size_t det_n, disp_n;
+            source_next(&src, 1.0, &det_n, &disp_n);
+            for (size_t k = 0; k < det_n; k += block) {
+                size_t n = (det_n - k < block) ? det_n - k : block;
+                proc_tick(tick, src.det_i + k, src.det_q + k, n);
+                proc_marker(marker, src.det_i + k, src.det_q + k, n);
+                proc_bcd_time(bcd_time, src.det_i + k, src.det_q + k, n);
+                proc_bcd_freq(bcd_freq, src.det_i + k, src.det_q + k, n);
+            }
+        }
+    }
+    tick_detector_destroy(tick);
+    marker_detector_destroy(marker);
+    bcd_time_detector_destroy(bcd_time);
+    bcd_freq_detector_destroy(bcd_freq);
+    source_close(&src);
+    return ok;
+}
+
+/*
+ * A frame lying inside the caller's block goes to the FFT in place; one
+ * straddling blocks is assembled first. Either way the frame holds the
+ * same samples, so each detector's events must not change with the block
+ * size (per-sample feeding assembles every frame).
+ */
+static bool run_window_ring_check(void) {
+    static const char *const names[WR_CHECK_DETECTORS] = {
+        "tick", "marker", "bcd_time", "bcd_freq"
+    };
+    int ring_mismatches = 0;
+    if (!wr_check_ring(&ring_mismatches)) return false;
+    bool ok = ring_mismatches == 0;
+    fprintf(stderr, "[BENCH] window_ring  %d random pushes / writes of a %d-sample ring: "
+            "%d windows differ from the history  %s\n",
+            WR_CHECK_OPS, WR_CHECK_SIZE, ring_mismatches, ok ? "ok" : "FAIL");
+
+    tile_digest_t want[WR_CHECK_DETECTORS], got[WR_CHECK_DETECTORS];
+    if (!wr_pass(wr_check_blocks[0], want)) return false;
+    bool counted = want[0].events > 0 && want[1].events > 0;
+    for (size_t b = 1; b < sizeof(wr_check_blocks) / sizeof(wr_check_blocks[0]); b++) {
+        if (!wr_pass(wr_check_blocks[b], got)) return false;
+        for (int k = 0; k < WR_CHECK_DETECTORS; k++) {
+            bool same = got[k].hash == want[k].hash && got[k].events == want[k].events;
+            if (!same) {
+                fprintf(stderr, "[BENCH] window_ring  %s, %zu-sample blocks: %d events differ "
+                        "from %d per sample  FAIL\n", names[k], wr_check_blocks[b],
+                        got[k].events, want[k].events);
+            }
+            ok = ok && same;
+        }
+    }
+    ok = ok && counted;
+    fprintf(stderr, "[BENCH] window_ring  %d s per sample and in %zu block sizes: tick %d, "
+            "marker %d, bcd_time %d, bcd_freq %d events  %s\n",
+            WR_CHECK_SEC, sizeof(wr_check_blocks) / sizeof(wr_check_blocks[0]) - 1,
+            want[0].events, want[1].events, want[2].events, want[3].events, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+/*============================================================================
+ * Tone Zoom Check
+ *============================================================================*/
+
+#define TZ_CHECK_SEC            20
+#define TZ_CHECK_OUTAGE_SEC     3       /* Noise only at the end */
+#define TZ_CHECK_DOPPLER_HZ     1.7f
+#define TZ_CHECK_MAX_EST        512
+#define TZ_CHECK_TOL_HZ         0.25f   /* Of the true offset, a tenth of a bin */
+#define TZ_CHECK_SLACK_HZ       0.05f   /* Zoom error beyond the full FFT's */
+
+typedef struct {
+    double timestamp_ms[TZ_CHECK_MAX_EST];
+    float offset_hz[TZ_CHECK_MAX_EST];
+    bool valid[TZ_CHECK_MAX_EST];
+    bool zoomed[TZ_CHECK_MAX_EST];
+    int count;
+    tone_tracker_t *tt;
+} tz_track_t;
+
+static void tz_on_estimate(const tone_measurement_t *m, void *user_data) {
+    tz_track_t *t = (tz_track_t *)user_data;
+    if (t->count < TZ_CHECK_MAX_EST) {
+        t->timestamp_ms[t->count] = m->timestamp_ms;
+        t->offset_hz[t->count] = m->offset_hz;
+        t->valid[t->count] = m->valid;
+        t->zoomed[t->count] = tone_tracker_is_zoomed(t->tt);
+        t->count++;
+    }
+}
+
+/* Carrier trackers: default hop, overlapped, overlapped with zoom */
+#define TZ_CHECK_TRACKERS       3
+
+static bool tz_pass(tz_track_t *tracks) {
+    wwv_synth_config_t sc = WWV_SYNTH_CONFIG_DEFAULT;
+    sc.doppler_hz = TZ_CHECK_DOPPLER_HZ;
+    bench_source_t src;
+    bool ok = source_open(&src, &sc, false);
+    for (int k = 0; k < TZ_CHECK_TRACKERS; k++) {
+        memset(&tracks[k], 0, sizeof(tracks[k]));
+        tracks[k].tt = tone_tracker_create(0.0f, NULL);
+        ok = ok && tracks[k].tt;
+    }
+    if (ok) {
+        for (int k = 0; k < TZ_CHECK_TRACKERS; k++) {
+            tone_tracker_set_callback(tracks[k].tt, tz_on_estimate, &tracks[k]);
+            if (k > 0) tone_tracker_set_hop_size(tracks[k].tt, TONE_OVERLAP_HOP);
+        }
+        tone_tracker_set_adaptive_zoom(tracks[2].tt, true);
+        uint32_t seed = 0x0019u;
+        for (int sec = 0; sec < TZ_CHECK_SEC; sec++) {
+            size_t det_n, disp_n;
+            source_next(&src, 1.0, &det_n, &disp_n);
+            bool outage = sec >= TZ_CHECK_SEC - TZ_CHECK_OUTAGE_SEC;
+            for (size_t n = 0; n < disp_n; n++) {
+                float i = outage ? 0.01f * kc_uniform(&seed) : src.disp_i[n];
+                float q = outage ? 0.01f * kc_uniform(&seed) : src.disp_q[n];
+                for (int k = 0; k < TZ_CHECK_TRACKERS; k++) {
+                    tone_tracker_process_sample(tracks[k].tt, i, q);
+                }
+            }
+        }
+    }
+    for (int k = 0; k < TZ_CHECK_TRACKERS; k++) tone_tracker_destroy(tracks[k].tt);
+    source_close(&src);
+    return ok;
+}
+
+/*
+ * One carrier at a known offset, then noise. Every overlapped estimate
+ * must follow the last by exactly one hop; the zoom tracker must lock
+ * after TONE_ZOOM_LOCK_COUNT valid estimates, measure every window of
+ * carrier alone within a tenth of a bin while zoomed and about as well as
+ * the full FFT on the same windows, and unzoom at an invalid estimate in
+ * the outage.
+ */
+static bool run_tone_zoom_check(void) {
+    static tz_track_t tracks[TZ_CHECK_TRACKERS];
+    if (!tz_pass(tracks)) return false;
+    const tz_track_t *full = &tracks[0], *hop = &tracks[1], *zoom = &tracks[2];
+
+    const double hop_ms = TONE_OVERLAP_HOP * 1000.0 / TONE_SAMPLE_RATE;
+    int hop_steps = 0;
+    for (int k = 1; k < hop->count; k++) {
+        if (fabs(hop->timestamp_ms[k] - hop->timestamp_ms[k - 1] - hop_ms) < 1e-6) hop_steps++;
+    }
+    bool hop_ok = hop->count >= 4 * full->count - 3 && hop_steps == hop->count - 1;
+
+    int zoomed = 0, zoom_close = 0, first_zoom = -1, unzoomed_after = -1;
+    float worst_zoom = 0.0f, worst_hop = 0.0f;
+    const double outage_ms = (TZ_CHECK_SEC - TZ_CHECK_OUTAGE_SEC) * 1000.0;
+    for (int k = 0; k < zoom->count; k++) {
+        float err = fabsf(zoom->offset_hz[k] - TZ_CHECK_DOPPLER_HZ);
+        float hop_err = fabsf(hop->offset_hz[k] - TZ_CHECK_DOPPLER_HZ);
+        bool carrier = zoom->timestamp_ms[k] + TONE_FRAME_MS <= outage_ms;
+        if (carrier && zoom->zoomed[k] && zoom->valid[k]) {
+            if (first_zoom < 0) first_zoom = k;
+            zoomed++;
+            if (err <= TZ_CHECK_TOL_HZ) zoom_close++;
+            if (err > worst_zoom) worst_zoom = err;
+        }
+        if (carrier && hop_err > worst_hop) worst_hop = hop_err;
+        if (!zoom->valid[k] && first_zoom >= 0 && unzoomed_after < 0 && !zoom->zoomed[k]) {
+            unzoomed_after = k;
+        }
+    }
+    bool zoom_ok = first_zoom == TONE_ZOOM_LOCK_COUNT - 1 && zoomed > 0 && zoom_close == zoomed &&
+                   worst_zoom <= worst_hop + TZ_CHECK_SLACK_HZ &&
+                   unzoomed_after >= 0 && !zoom->zoomed[zoom->count - 1];
+
+    fprintf(stderr, "[BENCH] tone_zoom  hop %d: %d estimates (%d at the default hop), "
+            "%d of %d steps exactly %.2f ms  %s\n", TONE_OVERLAP_HOP, hop->count, full->count,
+            hop_steps, hop->count - 1, hop_ms, hop_ok ? "ok" : "FAIL");
+    fprintf(stderr, "[BENCH] tone_zoom  zoomed from estimate %d, %d zoomed estimates, %d within "
+            "%.2f Hz of %.2f Hz (max err %.3f Hz, full FFT %.3f Hz), unzoomed at %d in the "
+            "outage  %s\n", first_zoom, zoomed, zoom_close, TZ_CHECK_TOL_HZ,
+            TZ_CHECK_DOPPLER_HZ, worst_zoom, worst_hop, unzoomed_after, zoom_ok ? "ok" : "FAIL");
+    return hop_ok && zoom_ok;
+}
+
+/*============================================================================
+ * Zoom DFT Check
+ *============================================================================*/
+
+#define ZD_CHECK_SEC            12
+#define ZD_CHECK_TONE_HZ        500.37f
+#define ZD_CHECK_CARRIER_HZ     4.37f
+#define ZD_CHECK_NOISE          0.001f
+#define ZD_CHECK_BINS           48      /* Bin centres compared, around the tone */
+#define ZD_CHECK_MAG_TOL        1e-3    /* Relative to the largest bin */
+#define ZD_CHECK_RMS_HZ         0.005   /* Refined estimates */
+#define ZD_CHECK_GAIN           10.0    /* Parabolic RMS error / refined, at least */
+
+/* A real tone (both sidebands) or a complex carrier, with a little noise */
+static void zd_signal(bool carrier, uint32_t *seed, wwv_sample_t n, float *i, float *q) {
+    double hz = carrier ? ZD_CHECK_CARRIER_HZ : ZD_CHECK_TONE_HZ;
+    double ph = 2.0 * M_PI * hz * (double)n / TONE_SAMPLE_RATE;
+    *i = (float)cos(ph) + ZD_CHECK_NOISE * kc_uniform(seed);
+    *q = (carrier ? (float)sin(ph) : 0.0f) + ZD_CHECK_NOISE * kc_uniform(seed);
+}
+
+/* Every zoom DFT bin centre against the FFT magnitude there */
+static bool zd_check_bins(double *worst) {
+    static float xi[TONE_FFT_SIZE], xq[TONE_FFT_SIZE], mag[TONE_FFT_SIZE];
+    float zmag[ZD_CHECK_BINS];
+    fft_processor_t *fft = fft_processor_create(TONE_FFT_SIZE, TONE_SAMPLE_RATE);
+    zoom_dft_t *zd = zoom_dft_create(TONE_FFT_SIZE, TONE_SAMPLE_RATE, FFT_WINDOW_HANN);
+    bool ok = fft && zd;
+    if (ok) {
+        uint32_t seed = 0x0020u;
+        for (int n = 0; n < TONE_FFT_SIZE; n++) {
+            zd_signal(false, &seed, (wwv_sample_t)n, &xi[n], &xq[n]);
+        }
+        fft_processor_process(fft, xi, xq);
+        fft_processor_get_magnitudes(fft, mag);
+        int first = (int)(ZD_CHECK_TONE_HZ / TONE_HZ_PER_BIN) - ZD_CHECK_BINS / 2;
+        zoom_dft_evaluate(zd, xi, xq, first * TONE_HZ_PER_BIN, TONE_HZ_PER_BIN, ZD_CHECK_BINS,
+                          zmag);
+        double peak = 0.0;
+        for (int k = 0; k < ZD_CHECK_BINS; k++) {
+            if (mag[first + k] > peak) peak = mag[first + k];
+        }
+        *worst = 0.0;
+        for (int k = 0; k < ZD_CHECK_BINS; k++) {
+            double d = fabs((double)zmag[k] - mag[first + k]) / peak;
+            if (d > *worst) *worst = d;
+        }
+    }
+    zoom_dft_destroy(zd);
+    if (fft) fft_processor_destroy(fft);
+    return ok;
+}
+
+typedef struct {
+    double sum_sq;
+    int count;
+} zd_error_t;
+
+typedef struct {
+    float nominal_hz;
+    float true_hz;
+    zd_error_t err;
+    int zoomed;                 /* Estimates from the zoom FFT */
+    tone_tracker_t *tt;
+} zd_track_t;
+
+static void zd_on_estimate(const tone_measurement_t *m, void *user_data) {
+    zd_track_t *t = (zd_track_t *)user_data;
+    if (!m->valid) return;
+    double e = (double)m->measured_hz - t->true_hz;
+    t->err.sum_sq += e * e;
+    t->err.count++;
+    if (tone_tracker_is_zoomed(t->tt)) t->zoomed++;
+}
+
+static double zd_rms(const zd_track_t *t) {
+    return t->err.count ? sqrt(t->err.sum_sq / t->err.count) : INFINITY;
+}
+
+/* Tone and carrier, each parabolic and refined; the last carrier also zooms */
+#define ZD_CHECK_TRACKERS       5
+
+static bool zd_track(zd_track_t *tracks) {
+    static const struct { bool carrier, refine, zoom; } kinds[ZD_CHECK_TRACKERS] = {
+        { false, false, false }, { false, true, false },
+        { true, false, false }, { true, true, false }, { true, true, true },
+    };
+    tone_tracker_t *tt[ZD_CHECK_TRACKERS];
+    bool ok = true;
+    for (int k = 0; k < ZD_CHECK_TRACKERS; k++) {
+        memset(&tracks[k], 0, sizeof(tracks[k]));
+        tracks[k].nominal_hz = kinds[k].carrier ? 0.0f : 500.0f;
+        tracks[k].true_hz = kinds[k].carrier ? ZD_CHECK_CARRIER_HZ : ZD_CHECK_TONE_HZ;
+        tt[k] = tracks[k].tt = tone_tracker_create(tracks[k].nominal_hz, NULL);
+        ok = ok && tt[k];
+        if (!tt[k]) continue;
+        tone_tracker_set_fine_refinement(tt[k], kinds[k].refine);
+        tone_tracker_set_adaptive_zoom(tt[k], kinds[k].zoom);
+        tone_tracker_set_callback(tt[k], zd_on_estimate, &tracks[k]);
+    }
+    uint32_t seed = 0x0020u;
+    for (wwv_sample_t n = 0; ok && n < (wwv_sample_t)ZD_CHECK_SEC * TONE_SAMPLE_RATE; n++) {
+        float ti, tq, ci, cq;
+        zd_signal(false, &seed, n, &ti, &tq);
+        zd_signal(true, &seed, n, &ci, &cq);
+        for (int k = 0; k < ZD_CHECK_TRACKERS; k++) {
+            if (kinds[k].carrier) tone_tracker_process_sample(tt[k], ci, cq);
+            else tone_tracker_process_sample(tt[k], ti, tq);
+        }
+    }
+    for (int k = 0; k < ZD_CHECK_TRACKERS; k++) tone_tracker_destroy(tt[k]);
+    return ok;
+}
+
+/*
+ * Off-bin tones sit where the parabola through three Hann bins is worst;
+ * the refined estimate must be within ZD_CHECK_RMS_HZ and at least
+ * ZD_CHECK_GAIN times better, zoomed or not.
+ */
+static bool run_zoom_dft_check(void) {
+    double worst = 0.0;
+    zd_track_t t[ZD_CHECK_TRACKERS];
+    if (!zd_check_bins(&worst) || !zd_track(t)) return false;
+
+    bool bins_ok = worst <= ZD_CHECK_MAG_TOL;
+    fprintf(stderr, "[BENCH] zoom_dft  %d bin centres: max |zoom - FFT| %.2e of the peak  %s\n",
+            ZD_CHECK_BINS, worst, bins_ok ? "ok" : "FAIL");
+
+    static const char *const names[] = { "tone", "carrier", "carrier zoomed" };
+    static const int pairs[][2] = { { 0, 1 }, { 2, 3 }, { 2, 4 } };
+    bool ok = bins_ok;
+    for (int p = 0; p < 3; p++) {
+        const zd_track_t *coarse = &t[pairs[p][0]], *fine = &t[pairs[p][1]];
+        double rms_coarse = zd_rms(coarse), rms_fine = zd_rms(fine);
+        bool pair_ok = fine->err.count > 0 && rms_fine <= ZD_CHECK_RMS_HZ &&
+                       rms_fine * ZD_CHECK_GAIN <= rms_coarse && (p < 2 || fine->zoomed > 0);
+        fprintf(stderr, "[BENCH] zoom_dft  %s %.2f Hz: RMS error %.5f Hz refined over %d "
+                "estimates (%d zoomed), %.5f Hz parabolic  %s\n", names[p], fine->true_hz,
+                rms_fine, fine->err.count, fine->zoomed, rms_coarse, pair_ok ? "ok" : "FAIL");
+        ok = ok && pair_ok;
+    }
+    return ok;
+}
+
+/*============================================================================
+ * Sliding Sum Check
+ *============================================================================*/
+
+#define SS_CHECK_PUSHES         (40 * SLIDING_SUM_RENORM)
+#define SS_CHECK_EVERY          997     /* Pushes between exact comparisons */
+#define SS_CHECK_CAPACITY       195     /* The marker's 1000 ms of frames */
+#define SS_CHECK_TOL            1e-6    /* Relative to the window's exact sum */
+
+/* The marker's 500 / 800 / 1000 ms windows */
+static const int ss_check_lengths[] = { 97, 156, SS_CHECK_CAPACITY };
+#define SS_CHECK_WINDOWS        ((int)(sizeof(ss_check_lengths) / sizeof(ss_check_lengths[0])))
+
+/* Quiet floor with bursts four to seven decades up, as a marker's bucket */
+static float ss_energy(uint32_t *seed, int *burst) {
+    if (*burst > 0) {
+        (*burst)--;
+        return 1e3f * (1.0f + 9.0f * (0.5f + 0.5f * kc_uniform(seed)));
+    }
+    if (kc_rand(seed) % 2000 == 0) *burst = 150;
+    return 1e-3f * (1.0f + 0.5f * kc_uniform(seed));
+}
+
+static bool run_sliding_sum_check(void) {
+    float ring[SS_CHECK_CAPACITY];
+    sliding_sum_t *ss = sliding_sum_create(SS_CHECK_CAPACITY);
+    int ids[SS_CHECK_WINDOWS];
+    bool ok = ss != NULL;
+    for (int w = 0; ok && w < SS_CHECK_WINDOWS; w++) {
+        ids[w] = sliding_sum_add_window(ss, ss_check_lengths[w]);
+        ok = ids[w] >= 0;
+    }
+    if (!ok) {
+        sliding_sum_destroy(ss);
+        return false;
+    }
+
+    uint32_t seed = 0x0021u;
+    int burst = 0, pushed = 0, head = 0, checks = 0, bad = 0;
+    double worst = 0.0, float_worst = 0.0;
+    float float_sum = 0.0f;         /* The old add / subtract accumulator, full window */
+    for (int k = 0; k < SS_CHECK_PUSHES; k++) {
+        if (k == SS_CHECK_PUSHES / 2) {
+            sliding_sum_reset(ss);
+            pushed = head = 0;
+            float_sum = 0.0f;
+        }
+        float v = ss_energy(&seed, &burst);
+        if (pushed >= SS_CHECK_CAPACITY) float_sum -= ring[head];
+        float_sum += v;
+        ring[head] = v;
+        head = (head + 1) % SS_CHECK_CAPACITY;
+        pushed++;
+        sliding_sum_push(ss, v);
+        if (k % SS_CHECK_EVERY != 0) continue;
+
+        checks++;
+        for (int w = 0; w < SS_CHECK_WINDOWS; w++) {
+            int n = pushed < ss_check_lengths[w] ? pushed : ss_check_lengths[w];
+            long double exact = 0.0L;
+            for (int j = 1; j <= n; j++) {
+                exact += ring[(head - j + SS_CHECK_CAPACITY) % SS_CHECK_CAPACITY];
+            }
+            double err = fabs((double)(sliding_sum_get(ss, ids[w]) - exact)) / (double)exact;
+            double mean_err = fabs((double)(sliding_sum_get_mean(ss, ids[w]) - exact / n)) /
+                              (double)(exact / n);
+            if (err > worst) worst = err;
+            if (err > SS_CHECK_TOL || mean_err > SS_CHECK_TOL ||
+                sliding_sum_get_count(ss, ids[w]) != n) {
+                bad++;
+            }
+            if (w == SS_CHECK_WINDOWS - 1) {
+                double ferr = fabs((double)(float_sum - exact)) / (double)exact;
+                if (ferr > float_worst) float_worst = ferr;
+            }
+        }
+    }
+    sliding_sum_destroy(ss);
+
+    ok = bad == 0;
+    fprintf(stderr, "[BENCH] sliding_sum  %d pushes, %d windows at %d points: max error %.2e "
+            "of the exact sum (float running sum %.2e), %d off by more than %.0e  %s\n",
+            SS_CHECK_PUSHES, SS_CHECK_WINDOWS, checks, worst, float_worst, bad, SS_CHECK_TOL,
+            ok ? "ok" : "FAIL");
+    return ok;
+}
+
+/*============================================================================
+ * Cache Layout Check
+ *============================================================================*/
+
+#define CL_CHECK_SEC            65
+#define CL_CHECK_BLOCKS         256
+#define CL_CHECK_MAX_BYTES      20000
+#define CL_CHECK_ARENA_SKEW     8       /* Caller block deliberately off a cache line */
+
+static bool cl_aligned(const void *p) {
+    return ((uintptr_t)p % WWV_CACHE_LINE) == 0;
+}
+
+/* Blocks dirtied and freed, then zeroed ones taken from the same heap */
+static int cl_check_calloc(void) {
+    uint32_t seed = 0x0026u;
+    int bad = 0;
+    for (int k = 0; k < CL_CHECK_BLOCKS; k++) {
+        size_t bytes = kc_rand(&seed) % CL_CHECK_MAX_BYTES + 1;
+        unsigned char *dirty = wwv_aligned_alloc(WWV_CACHE_LINE, bytes);
+        if (dirty) memset(dirty, 0xa5, bytes);
+        wwv_aligned_free(dirty);
+        unsigned char *p = wwv_aligned_calloc(WWV_CACHE_LINE, bytes);
+        bool ok = p && cl_aligned(p);
+        for (size_t b = 0; ok && b < bytes; b++) ok = p[b] == 0;
+        if (!ok) bad++;
+        wwv_aligned_free(p);
+    }
+    return bad;
+}
+
+typedef struct {
+    tile_digest_t digest;
+    int detectors;
+    int misaligned;
+} cl_pass_t;
+
+/* Each struct's groups are _Alignas'd from its start; the start must hold */
+static bool cl_setup(wwv_detector_manager_t *mgr, void *user) {
+    cl_pass_t *c = (cl_pass_t *)user;
+    const void *dets[] = {
+        mgr->tick_detector, mgr->marker_detector, mgr->bcd_time_detector,
+        mgr->bcd_freq_detector, mgr->sync_detector,
+        mgr->tone_carrier, mgr->tone_500, mgr->tone_600,
+    };
+    c->detectors = c->misaligned = 0;
+    for (size_t k = 0; k < sizeof(dets) / sizeof(dets[0]); k++) {
+        if (!dets[k]) continue;
+        c->detectors++;
+        if (!cl_aligned(dets[k])) c->misaligned++;
+    }
+    return tile_setup(mgr, &c->digest);
+}
+
+static bool cl_pass(void *arena, size_t arena_bytes, cl_pass_t *c) {
+    manager_pass_t pass;
+    manager_pass_init(&pass, CL_CHECK_SEC);
+    pass.arena = arena;
+    pass.arena_bytes = arena_bytes;
+    pass.setup = cl_setup;
+    pass.user = c;
+    return manager_pass(&pass, NULL);
+}
+
+static bool run_cache_layout_check(void) {
+    int calloc_bad = cl_check_calloc();
+    bool calloc_ok = calloc_bad == 0;
+    fprintf(stderr, "[BENCH] cache_layout  %d zeroed aligned blocks after dirty frees: "
+            "%d not zeroed or not on a %d-byte line  %s\n",
+            CL_CHECK_BLOCKS, calloc_bad, WWV_CACHE_LINE, calloc_ok ? "ok" : "FAIL");
+
+    wwv_detector_config_t config = WWV_DETECTOR_CONFIG_DEFAULT;
+    config.output_dir = NULL;
+    size_t bytes = wwv_detector_manager_required_size(&config);
+    unsigned char *block = bytes ? malloc(bytes + WWV_CACHE_LINE) : NULL;
+    if (!block) return false;
+    unsigned char *skewed = block + (cl_aligned(block) ? CL_CHECK_ARENA_SKEW : 0);
+
+    cl_pass_t heap, arena;
+    bool ran = cl_pass(NULL, 0, &heap) &&
+               cl_pass(skewed, bytes + WWV_CACHE_LINE - (size_t)(skewed - block), &arena);
+    free(block);
+    if (!ran) return false;
+
+    bool ok = heap.misaligned == 0 && arena.misaligned == 0 && heap.detectors >= 8 &&
+              arena.detectors == heap.detectors && heap.digest.events > 0 &&
+              arena.digest.hash == heap.digest.hash && arena.digest.events == heap.digest.events;
+    fprintf(stderr, "[BENCH] cache_layout  %d detectors, %d / %d off a cache line "
+            "(heap / arena at +%d); %d events, arena %s  %s\n",
+            heap.detectors, heap.misaligned, arena.misaligned, CL_CHECK_ARENA_SKEW,
+            heap.digest.events, arena.digest.hash == heap.digest.hash ? "same" : "different",
+            calloc_ok && ok ? "ok" : "FAIL");
+    return calloc_ok && ok;
+}
+
+/*============================================================================
+ * BCD Solver Check
+ *============================================================================*/
+
+/*
+ * The correlator's symbol windows are made here from the synth's frames:
+ * the true symbol scores 0 and the others -L, except that a flipped data
+ * bit scores its wrong value 0 instead. With L under 3 nats no field
+ * of one frame clears BCD_SOLVER_MIN_MARGIN; the held frames together do.
+ */
+
+#define BS_CHECK_MINUTES        16      /* 23:52 day 100 .. 00:07 day 101 */
+#define BS_CHECK_START_HOUR     23
+#define BS_CHECK_START_MINUTE   52
+#define BS_CHECK_START_DAY      100
+#define BS_CHECK_BASE_MS        3210.0  /* Stream time of the first minute's :00 */
+#define BS_CHECK_WEAK_LL        2.0f    /* Weak frames: L = 2.0 +- 1.0 nats */
+#define BS_CHECK_STRONG_LL      8.0f
+#define BS_CHECK_FLIP           0.1f    /* Weak data bits flipped */
+#define BS_CHECK_ILLEGAL_LL     1.0f    /* Minute units :13 wrongly set */
+
+typedef struct {
+    const wwv_synth_config_t *sc;
+    int solutions;
+    int correct;                /* True time and minute start */
+    int first_minute;           /* Minute index of the first solution, -1 = none */
+    bool after_midnight;        /* A correct solution on the new day */
+} bs_run_t;
+
+static void bs_on_solution(const bcd_time_solution_t *sol, void *user) {
+    bs_run_t *run = (bs_run_t *)user;
+    int m = (int)lround((sol->minute_start_ms - BS_CHECK_BASE_MS) / 60000.0);
+    bi_time_t t = bi_truth(run->sc, m);
+    bool start_ok = fabs(sol->minute_start_ms - (BS_CHECK_BASE_MS + m * 60000.0)) < 1.0;
+    if (run->solutions++ == 0) run->first_minute = m;
+    if (start_ok && sol->minute == t.minute && sol->hour == t.hour && sol->day == t.day &&
+        sol->year == t.year) {
+        run->correct++;
+        if (t.day != run->sc->start_day) run->after_midnight = true;
+    }
+}
+
+/*
+ * One minute's windows (:01 .. :59, second 0 carries no symbol). ll is
+ * the wrong symbols' score; flip is the chance a data bit is flipped.
+ * second_shift numbers every window that many seconds off.
+ */
+static void bs_feed_minute(bcd_time_solver_t *solver, const wwv_synth_t *synth, int m,
+                           float ll, float spread, float flip, int second_shift,
+                           uint32_t *seed) {
+    double start = BS_CHECK_BASE_MS + m * 60000.0;
+    for (int sec = 1; sec < 60; sec++) {
+        int sym = wwv_synth_bcd_symbol(synth, m, sec);
+        if (sym < 0) continue;
+        float l = fmaxf(0.1f, ll + spread * kc_uniform(seed));
+        int best = sym;
+        if (sym != BCD_CORR_SYM_MARKER && 0.5f * (kc_uniform(seed) + 1.0f) < flip) best ^= 1;
+
+        int second = sec + second_shift;
+        if (second < 0 || second > 59) continue;
+        bcd_symbol_event_t ev = {
+            .symbol = (bcd_corr_symbol_t)best,
+            .timestamp_ms = start + second * 1000.0 + 500.0,
+            .confidence = 0.5f,
+            .source = "BOTH",
+            .second = second,
+            .log_likelihood = { -l, -l, -l }
+        };
+        ev.log_likelihood[best] = 0.0f;
+        bcd_time_solver_add_symbol(solver, &ev);
+    }
+}
+
+static bcd_time_solver_t *bs_create(bs_run_t *run, const wwv_synth_config_t *sc) {
+    memset(run, 0, sizeof(*run));
+    run->sc = sc;
+    run->first_minute = -1;
+    bcd_time_solver_t *solver = bcd_time_solver_create();
+    bcd_time_solver_set_callback(solver, bs_on_solution, run);
+    return solver;
+}
+
+static bool run_bcd_solver_check(void) {
+    wwv_synth_config_t sc = WWV_SYNTH_CONFIG_DEFAULT;
+    sc.start_hour = BS_CHECK_START_HOUR;
+    sc.start_minute = BS_CHECK_START_MINUTE;
+    sc.start_day = BS_CHECK_START_DAY;
+    wwv_synth_t *synth = wwv_synth_create(&sc);
+    bs_run_t weak, illegal, shifted;
+    bcd_time_solver_t *ws = bs_create(&weak, &sc);
+    bcd_time_solver_t *is = bs_create(&illegal, &sc);
+    bcd_time_solver_t *ss = bs_create(&shifted, &sc);
+    bool ran = synth && ws && is && ss;
+    uint32_t seed = 97531u;
+
+    /* Weak noisy frames, one solver across all minutes */
+    for (int m = 0; ran && m < BS_CHECK_MINUTES; m++) {
+        bs_feed_minute(ws, synth, m, BS_CHECK_WEAK_LL, 0.5f * BS_CHECK_WEAK_LL, BS_CHECK_FLIP,
+                       0, &seed);
+    }
+
+    /* One strong frame (23:57, units 0111) with :13 leaning to 1: the
+     * hard decision reads minute units 15 */
+    int im = 5;
+    double im_start = BS_CHECK_BASE_MS + im * 60000.0;
+    for (int sec = 1; ran && sec < 60; sec++) {
+        int sym = wwv_synth_bcd_symbol(synth, im, sec);
+        if (sym < 0) continue;
+        bcd_symbol_event_t ev = {
+            .symbol = (bcd_corr_symbol_t)sym,
+            .timestamp_ms = im_start + sec * 1000.0 + 500.0,
+            .second = sec,
+            .log_likelihood = { -BS_CHECK_STRONG_LL, -BS_CHECK_STRONG_LL, -BS_CHECK_STRONG_LL }
+        };
+        ev.log_likelihood[sym] = 0.0f;
+        if (sec == 13) {
+            ev.symbol = BCD_CORR_SYM_ONE;
+            ev.log_likelihood[BCD_CORR_SYM_ZERO] = -BS_CHECK_ILLEGAL_LL;
+            ev.log_likelihood[BCD_CORR_SYM_ONE] = 0.0f;
+        }
+        bcd_time_solver_add_symbol(is, &ev);
+    }
+
+    /* Strong frames numbered one second late */
+    for (int m = 0; ran && m < BCD_SOLVER_MAX_FRAMES; m++) {
+        bs_feed_minute(ss, synth, m, BS_CHECK_STRONG_LL, 0.0f, 0.0f, 1, &seed);
+    }
+
+    bool weak_ok = ran && weak.solutions > 0 && weak.correct == weak.solutions &&
+                   weak.first_minute > 0 && weak.first_minute < BCD_SOLVER_MAX_FRAMES &&
+                   weak.after_midnight;
+    bool illegal_ok = ran && illegal.solutions == 1 && illegal.correct == 1;
+    bool shifted_ok = ran && shifted.solutions == 0;
+    fprintf(stderr, "[BENCH] bcd solver  weak frames 23:52-00:07 day %d-%d: first solution "
+            "after %d minutes, %d of %d correct%s  %s\n",
+            BS_CHECK_START_DAY, BS_CHECK_START_DAY + 1, weak.first_minute + 1, weak.correct,
+            weak.solutions, weak.after_midnight ? " (also after midnight)" : "",
+            weak_ok ? "ok" : "FAIL");
+    fprintf(stderr, "[BENCH] bcd solver  illegal minute digit: %d of %d solutions correct  %s\n",
+            illegal.correct, illegal.solutions, illegal_ok ? "ok" : "FAIL");
+    fprintf(stderr, "[BENCH] bcd solver  frames one second off: %d solutions  %s\n",
+            shifted.solutions, shifted_ok ? "ok" : "FAIL");
+
+    bcd_time_solver_destroy(ss);
+    bcd_time_solver_destroy(is);
+    bcd_time_solver_destroy(ws);
+    wwv_synth_destroy(synth);
+    return weak_ok && illegal_ok && shifted_ok;
+}
+
+/*============================================================================
+ * Params Check
+ *============================================================================*/
+
+/*
+ * The threaded pass's control thread publishes numbered batches, each
+ * setting the tick threshold and minimum duration from the same number;
+ * after every second is flushed (detector worker idle) the two live values
+ * must decode to the same batch.
+ */
+
+#define PR_CHECK_SECONDS        6
+#define PR_CHECK_BATCHES        4000    /* Batch numbers wrap at this */
+#define PR_CHECK_BLOCK          5000    /* Synchronous steps */
+
+typedef struct {
+    wwv_detector_manager_t *mgr;
+    atomic_bool stop;
+    int published;              /* Batches set (read after the join) */
+    int last;                   /* Number of the last one */
+} pr_control_t;
+
+typedef struct {
+    pr_control_t control;
+    wwv_thread_t thread;
+    bool started;
+    int checked, torn, changes, prev;
+} pr_threaded_t;
+
+static float pr_threshold(int k) { return 1.0f + (float)(k % PR_CHECK_BATCHES) * 0.001f; }
+static float pr_duration(int k) { return 1.0f + (float)(k % PR_CHECK_BATCHES) * 0.00225f; }
+
+static void pr_control(void *arg) {
+    pr_control_t *ctl = (pr_control_t *)arg;
+    for (int k = 1; !atomic_load(&ctl->stop); k++) {
+        wwv_param_setting_t batch[2] = {
+            { "tick_detector.threshold_multiplier", pr_threshold(k) },
+            { "tick_detector.min_duration_ms", pr_duration(k) }
+        };
+        if (wwv_detector_manager_set_params(ctl->mgr, batch, 2)) {
+            ctl->published++;
+            ctl->last = k;
+        }
+    }
+}
+
+static bool pr_setup(wwv_detector_manager_t *mgr, void *user) {
+    pr_threaded_t *run = (pr_threaded_t *)user;
+    run->control.mgr = mgr;
+    run->started = wwv_thread_create(&run->thread, pr_control, &run->control);
+    return run->started;
+}
+
+static void pr_fed(wwv_detector_manager_t *mgr, int sec, uint64_t ns, void *user) {
+    (void)ns;
+    pr_threaded_t *run = (pr_threaded_t *)user;
+    float thr = tick_detector_get_threshold_mult(mgr->tick_detector);
+    float dur = tick_detector_get_min_duration_ms(mgr->tick_detector);
+    long kt = lroundf((thr - 1.0f) / 0.001f);
+    long kd = lroundf((dur - 1.0f) / 0.00225f);
+    run->checked++;
+    if (kt != kd) run->torn++;
+    if (sec > 0 && kt != run->prev) run->changes++;
+    run->prev = (int)kt;
+
+    /* Stop retuning a second early: the last second takes up the last batch */
+    if (sec == PR_CHECK_SECONDS - 2 && run->started) {
+        atomic_store(&run->control.stop, true);
+        wwv_thread_join(run->thread);
+        run->started = false;
+    }
+}
+
+static bool pr_finish(wwv_detector_manager_t *mgr, void *user) {
+    pr_threaded_t *run = (pr_threaded_t *)user;
+    int last = run->control.last;
+    return run->control.published > 0 &&
+           tick_detector_get_threshold_mult(mgr->tick_detector) == pr_threshold(last) &&
+           tick_detector_get_min_duration_ms(mgr->tick_detector) == pr_duration(last);
+}
+
+static void pr_step(wwv_detector_manager_t *mgr, bench_source_t *src) {
+    size_t det_n, disp_n;
+    source_next(src, (double)PR_CHECK_BLOCK / BENCH_DETECTOR_RATE, &det_n, &disp_n);
+    wwv_detector_manager_process_detector_block(mgr, src->det_i, src->det_q, det_n);
+}
+
+static bool pr_get(wwv_detector_manager_t *mgr, const char *name, float want) {
+    float v;
+    return wwv_detector_manager_get_param(mgr, name, &v) && v == want;
+}
+
+/* Staging, all-or-nothing batches and coalesced publishes, one block at a time */
+static bool pr_synchronous(void) {
+    wwv_synth_config_t sc = WWV_SYNTH_CONFIG_DEFAULT;
+    wwv_detector_config_t config = WWV_DETECTOR_CONFIG_DEFAULT;
+    config.output_dir = NULL;
+    bench_source_t src;
+    bool opened = source_open(&src, &sc, false);
+    wwv_detector_manager_t *mgr = opened ? wwv_detector_manager_create(&config) : NULL;
+    if (!mgr) {
+        source_close(&src);
+        return false;
+    }
+    tick_detector_t *td = mgr->tick_detector;
+    marker_detector_t *md = mgr->marker_detector;
+    pr_step(mgr, &src);
+
+    /* Staged: read back at once, live from the next block */
+    float thr0 = tick_detector_get_threshold_mult(td);
+    bool staged = wwv_detector_manager_set_param(mgr, "tick_detector.threshold_multiplier",
+                                                 3.5f) &&
+                  pr_get(mgr, "tick_detector.threshold_multiplier", 3.5f) &&
+                  tick_detector_get_threshold_mult(td) == thr0;
+    pr_step(mgr, &src);
+    staged = staged && tick_detector_get_threshold_mult(td) == 3.5f;
+
+    /* One bad value rejects the whole batch */
+    float mthr0 = marker_detector_get_threshold_mult(md);
+    float wtick0 = sync_detector_get_weight_tick(mgr->sync_detector);
+    wwv_param_setting_t bad[3] = {
+        { "marker_detector.threshold_multiplier", 3.0f },
+        { "sync_detector.weight_tick", 0.1f },
+        { "tick_detector.threshold_multiplier", 9.0f }
+    };
+    bool rejected = !wwv_detector_manager_set_params(mgr, bad, 3) &&
+                    pr_get(mgr, "marker_detector.threshold_multiplier", mthr0) &&
+                    pr_get(mgr, "tick_detector.threshold_multiplier", 3.5f);
+    pr_step(mgr, &src);
+    rejected = rejected && marker_detector_get_threshold_mult(md) == mthr0 &&
+               sync_detector_get_weight_tick(mgr->sync_detector) == wtick0 &&
+               tick_detector_get_threshold_mult(td) == 3.5f;
+
+    /* A batch, then a single setting, both before the next block */
+    wwv_param_setting_t good[3] = {
+        { "marker_detector.threshold_multiplier", 3.0f },
+        { "sync_detector.weight_tick", 0.1f },
+        { "tick_detector.min_duration_ms", 4.0f }
+    };
+    bool batched = wwv_detector_manager_set_params(mgr, good, 3) &&
+                   wwv_detector_manager_set_param(mgr, "tick_detector.threshold_multiplier",
+                                                  2.5f) &&
+                   marker_detector_get_threshold_mult(md) == mthr0 &&
+                   tick_detector_get_threshold_mult(td) == 3.5f;
+    pr_step(mgr, &src);
+    batched = batched && marker_detector_get_threshold_mult(md) == 3.0f &&
+              sync_detector_get_weight_tick(mgr->sync_detector) == 0.1f &&
+              tick_detector_get_min_duration_ms(td) == 4.0f &&
+              tick_detector_get_threshold_mult(td) == 2.5f;
+
+    fprintf(stderr, "[BENCH] params  staged until the next block: %s  "
+            "bad batch rejected whole: %s  batch + setting in one block: %s\n",
+            staged ? "ok" : "FAIL", rejected ? "ok" : "FAIL", batched ? "ok" : "FAIL");
+    wwv_detector_manager_destroy(mgr);
+    source_close(&src);
+    return staged && rejected && batched;
+}
+
+static bool run_params_check(void) {
+    bool sync_ok = pr_synchronous();
+
+    pr_threaded_t run;
+    memset(&run, 0, sizeof(run));
+    atomic_init(&run.control.stop, false);
+    manager_pass_t pass;
+    manager_pass_init(&pass, PR_CHECK_SECONDS);
+    pass.config.threaded = true;
+    pass.user = &run;
+    pass.setup = pr_setup;
+    pass.fed = pr_fed;
+    pass.finish = pr_finish;
+    bool last_ok = manager_pass(&pass, NULL);
+    if (run.started) {
+        atomic_store(&run.control.stop, true);
+        wwv_thread_join(run.thread);
+    }
+
+    bool threaded_ok = last_ok && run.torn == 0 && run.changes > 0;
+    fprintf(stderr, "[BENCH] params  threaded, retuned while running: %d batches published, "
+            "%d of %d seconds torn, %d changes seen, last batch live %s  %s\n",
+            run.control.published, run.torn, run.checked, run.changes,
+            last_ok ? "yes" : "no", threaded_ok ? "ok" : "FAIL");
+    return sync_ok && threaded_ok;
+}
+
+/*============================================================================
+ * Correlator History Check
+ *============================================================================*/
+
+/*
+ * Chains of whole-second ticks separated by 1.5 s gaps (neither a tick
+ * interval nor a single skip). Two long chains early on are the run's
+ * longest; the rest are 2 to 30 ticks.
+ */
+
+#define CH_CHECK_CHAINS         60
+#define CH_CHECK_CHAIN_HISTORY  8
+#define CH_CHECK_TICK_HISTORY   50
+#define CH_CHECK_GAP_MS         1500.0
+
+static int ch_length(int chain) {
+    if (chain == 3) return 120;
+    if (chain == 10) return 90;
+    return 2 + (chain * 37) % 29;
+}
+
+static int ch_desc(const void *a, const void *b) {
+    return *(const int *)b - *(const int *)a;
+}
+
+static bool run_corr_history_check(void) {
+    tick_correlator_t *tc = tick_correlator_create_sized(NULL, CH_CHECK_CHAIN_HISTORY,
+                                                         CH_CHECK_TICK_HISTORY);
+    int total = 0;
+    for (int c = 0; c < CH_CHECK_CHAINS; c++) total += ch_length(c);
+    double *stamps = malloc((size_t)total * sizeof(double));
+    if (!tc || !stamps) {
+        tick_correlator_destroy(tc);
+        free(stamps);
+        return false;
+    }
+
+    int n = 0;
+    double t = 1000.0;
+    for (int c = 0; c < CH_CHECK_CHAINS; c++) {
+        for (int k = 0; k < ch_length(c); k++) {
+            stamps[n] = t;
+            tick_correlator_add_tick(tc, "00:00:00", t, 0.0, n + 1, "", 1.0f, 5.0f, 1000.0f,
+                                     1000.0f, 0.1f, 1.0f, 1.0f);
+            n++;
+            t += 1000.0;
+        }
+        t += CH_CHECK_GAP_MS - 1000.0;
+    }
+
+    bool rings_ok = tc->chain_capacity == CH_CHECK_CHAIN_HISTORY &&
+                    tc->tick_capacity == CH_CHECK_TICK_HISTORY &&
+                    tick_correlator_get_chain_count(tc) == CH_CHECK_CHAINS;
+
+    /* Newest chains exact, older ones evicted */
+    int kept = 0, evicted = 0;
+    for (int c = 0; c < CH_CHECK_CHAINS; c++) {
+        chain_stats_t cs = tick_correlator_get_chain_stats(tc, c + 1);
+        if (c >= CH_CHECK_CHAINS - CH_CHECK_CHAIN_HISTORY) {
+            if (cs.chain_id == c + 1 && cs.tick_count == ch_length(c)) kept++;
+        } else if (cs.chain_id == 0 && cs.tick_count == 0) {
+            evicted++;
+        }
+    }
+    bool chains_ok = kept == CH_CHECK_CHAIN_HISTORY &&
+                     evicted == CH_CHECK_CHAINS - CH_CHECK_CHAIN_HISTORY;
+
+    /* Newest tick records exact, none older */
+    int ticks_ok = 0;
+    for (int age = 0; age < CH_CHECK_TICK_HISTORY; age++) {
+        tick_record_t rec;
+        if (tick_correlator_get_tick(tc, age, &rec) && rec.timestamp_ms == stamps[n - 1 - age] &&
+            rec.tick_num == n - age) {
+            ticks_ok++;
+        }
+    }
+    tick_record_t rec;
+    bool records_ok = ticks_ok == CH_CHECK_TICK_HISTORY &&
+                      !tick_correlator_get_tick(tc, CH_CHECK_TICK_HISTORY, &rec);
+
+    /* The run's longest chains, though long evicted */
+    int lengths[CH_CHECK_CHAINS];
+    for (int c = 0; c < CH_CHECK_CHAINS; c++) lengths[c] = ch_length(c);
+    qsort(lengths, CH_CHECK_CHAINS, sizeof(int), ch_desc);
+    chain_stats_t top[TICK_CORR_TOP_CHAINS];
+    int ranked = tick_correlator_get_top_chains(tc, top, TICK_CORR_TOP_CHAINS);
+    bool top_ok = ranked == TICK_CORR_TOP_CHAINS && top[0].chain_id == 4 &&
+                  top[1].chain_id == 11;
+    for (int k = 0; k < ranked; k++) top_ok = top_ok && top[k].tick_count == lengths[k];
+
+    /* The manager sizes its correlator from the config */
+    wwv_detector_config_t config = WWV_DETECTOR_CONFIG_DEFAULT;
+    config.output_dir = NULL;
+    config.corr_chain_history = 2 * CH_CHECK_CHAIN_HISTORY;
+    config.corr_tick_history = 2 * CH_CHECK_TICK_HISTORY;
+    wwv_detector_manager_t *mgr = wwv_detector_manager_create(&config);
+    bool config_ok = mgr && mgr->tick_correlator &&
+                     mgr->tick_correlator->chain_capacity == config.corr_chain_history &&
+                     mgr->tick_correlator->tick_capacity == config.corr_tick_history;
+    wwv_detector_manager_destroy(mgr);
+
+    bool ok = rings_ok && chains_ok && records_ok && top_ok && config_ok;
+    fprintf(stderr, "[BENCH] corr history  %d chains, %d ticks into %d-chain / %d-tick rings: "
+            "%d newest chains exact, %d evicted, %d newest ticks exact, longest %d and %d "
+            "ranked, manager sized from config %s  %s\n",
+            CH_CHECK_CHAINS, n, CH_CHECK_CHAIN_HISTORY, CH_CHECK_TICK_HISTORY, kept, evicted,
+            ticks_ok, ranked > 0 ? top[0].tick_count : 0, ranked > 1 ? top[1].tick_count : 0,
+            config_ok ? "yes" : "no", ok ? "ok" : "FAIL");
+    tick_correlator_destroy(tc);
+    free(stamps);
+    return ok;
+}
+
+/*============================================================================
+ * Channel Quality Check
+ *============================================================================*/
+
+/*
+ * Each pass feeds one broadcast to two shared spectra with a carrier and a
+ * 500 Hz tracker each; only the first has the estimate, so its trackers
+ * take the shared noise floor. The two-path broadcast adds a copy of the
+ * signal CQ_CHECK_PATH_HZ higher, two lines whose RMS width is half that.
+ */
+
+#define CQ_CHECK_SEC            60
+#define CQ_CHECK_FADE_SEC       120     /* Fade rate average settles over ~4 tau */
+#define CQ_CHECK_SNR_DB         20.0f   /* Noise, not sidebands, sets the clean floor */
+#define CQ_CHECK_WEAK_DB        15.0f   /* Below the clean broadcast */
+#define CQ_CHECK_SNR_TOL_DB     2.0f
+#define CQ_CHECK_FADE_HZ        0.1f
+#define CQ_CHECK_FADE_DEPTH_DB  20.0f
+#define CQ_CHECK_FADE_TOL       0.4f    /* Of the fade rate */
+#define CQ_CHECK_DEPTH_DB       5.0f    /* Fade depth gained by fading, at least */
+#define CQ_CHECK_PATH_HZ        6.0f
+#define CQ_CHECK_SPREAD_HZ      1.0f    /* Spread gained by the second path, at least */
+#define CQ_CHECK_MAX_EST        2048
+
+typedef struct {
+    float snr_db[CQ_CHECK_MAX_EST];
+    int count;
+} cq_track_t;
+
+typedef struct {
+    channel_quality_report_t report;
+    bool valid;
+    int estimates;              /* Tracker estimates compared */
+    int differ;                 /* ...with a different SNR without the estimate */
+} cq_run_t;
+
+static void cq_on_estimate(const tone_measurement_t *m, void *user_data) {
+    cq_track_t *t = (cq_track_t *)user_data;
+    if (t->count < CQ_CHECK_MAX_EST) t->snr_db[t->count++] = m->snr_db;
+}
+
+static bool cq_pass(const wwv_synth_config_t *sc, int seconds, bool two_path, cq_run_t *run) {
+    static cq_track_t tracks[2][2];
+    static const float nominal[2] = { 0.0f, 500.0f };
+    memset(run, 0, sizeof(*run));
+    memset(tracks, 0, sizeof(tracks));
+
+    bench_source_t src;
+    bool ok = source_open(&src, sc, false);
+    channel_quality_t *cq = channel_quality_create();
+    tone_spectrum_t *ts[2] = { tone_spectrum_create(TONE_OVERLAP_HOP),
+                               tone_spectrum_create(TONE_OVERLAP_HOP) };
+    tone_tracker_t *tt[2][2] = { { NULL } };
+    ok = ok && cq && ts[0] && ts[1];
+    for (int s = 0; ok && s < 2; s++) {
+        for (int k = 0; ok && k < 2; k++) {
+            tt[s][k] = tone_tracker_create(nominal[k], NULL);
+            ok = tt[s][k] != NULL;
+            if (!ok) break;
+            tone_tracker_set_hop_size(tt[s][k], TONE_OVERLAP_HOP);
+            tone_tracker_set_callback(tt[s][k], cq_on_estimate, &tracks[s][k]);
+            ok = tone_spectrum_attach(ts[s], tt[s][k]);
+        }
+    }
+    if (ok) tone_spectrum_set_channel_quality(ts[0], cq);
+
+    uint64_t n = 0;
+    for (int sec = 0; ok && sec < seconds; sec++) {
+        size_t det_n, disp_n;
+        source_next(&src, 1.0, &det_n, &disp_n);
+        for (size_t k = 0; two_path && k < disp_n; k++, n++) {
+            double ph = 2.0 * M_PI * CQ_CHECK_PATH_HZ * (double)n / TONE_SAMPLE_RATE;
+            float c = (float)cos(ph), s = (float)sin(ph);
+            float i = src.disp_i[k], q = src.disp_q[k];
+            src.disp_i[k] = i + i * c - q * s;
+            src.disp_q[k] = q + i * s + q * c;
+        }
+        for (int s = 0; s < 2; s++) tone_spectrum_process_block(ts[s], src.disp_i, src.disp_q,
+                                                                 disp_n);
+    }
+
+    if (ok) {
+        run->valid = channel_quality_get(cq, &run->report);
+        for (int k = 0; k < 2; k++) {
+            const cq_track_t *with = &tracks[0][k], *without = &tracks[1][k];
+            if (with->count != without->count || with->count == 0) run->differ++;
+            for (int e = 0; e < with->count && e < without->count; e++) {
+                run->estimates++;
+                if (with->snr_db[e] != without->snr_db[e]) run->differ++;
+            }
+        }
+    }
+
+    for (int s = 0; s < 2; s++) tone_spectrum_destroy(ts[s]);
+    for (int s = 0; s < 2; s++) {
+        for (int k = 0; k < 2; k++) tone_tracker_destroy(tt[s][k]);
+    }
+    channel_quality_destroy(cq);
+    source_close(&src);
+    return ok;
+}
+
+static bool run_channel_quality_check(void) {
+    wwv_synth_config_t clean_sc = WWV_SYNTH_CONFIG_DEFAULT;
+    clean_sc.snr_db = CQ_CHECK_SNR_DB;
+    wwv_synth_config_t weak_sc = clean_sc, fade_sc = clean_sc;
+    weak_sc.snr_db -= CQ_CHECK_WEAK_DB;
+    fade_sc.fade_rate_hz = CQ_CHECK_FADE_HZ;
+    fade_sc.fade_depth_db = CQ_CHECK_FADE_DEPTH_DB;
+
+    cq_run_t clean, weak, fade, path;
+    if (!cq_pass(&clean_sc, CQ_CHECK_SEC, false, &clean) ||
+        !cq_pass(&weak_sc, CQ_CHECK_SEC, false, &weak) ||
+        !cq_pass(&fade_sc, CQ_CHECK_FADE_SEC, false, &fade) ||
+        !cq_pass(&clean_sc, CQ_CHECK_SEC, true, &path)) {
+        return false;
+    }
+    const channel_quality_report_t *c = &clean.report, *w = &weak.report;
+    const channel_quality_report_t *f = &fade.report, *p = &path.report;
+
+    int differ = clean.differ + weak.differ + fade.differ + path.differ;
+    int estimates = clean.estimates + weak.estimates + fade.estimates + path.estimates;
+    bool floor_ok = differ == 0 && estimates > 0;
+
+    float drop = c->snr_db - w->snr_db;
+    bool snr_ok = clean.valid && weak.valid &&
+                  fabsf(drop - CQ_CHECK_WEAK_DB) <= CQ_CHECK_SNR_TOL_DB;
+
+    bool fade_ok = fade.valid &&
+                   fabsf(f->fade_rate_hz - CQ_CHECK_FADE_HZ) <=
+                       CQ_CHECK_FADE_TOL * CQ_CHECK_FADE_HZ &&
+                   c->fade_rate_hz < CQ_CHECK_FADE_TOL * CQ_CHECK_FADE_HZ &&
+                   f->fade_depth_db >= c->fade_depth_db + CQ_CHECK_DEPTH_DB;
+
+    bool spread_ok = path.valid && p->doppler_spread_hz >= c->doppler_spread_hz +
+                                                           CQ_CHECK_SPREAD_HZ;
+
+    fprintf(stderr, "[BENCH] channel quality  tracker SNRs with the shared floor: %d of %d "
+            "differ  %s\n", differ, estimates, floor_ok ? "ok" : "FAIL");
+    fprintf(stderr, "[BENCH] channel quality  SNR %.1f dB clean, %.1f dB %.0f dB weaker "
+            "(drop %.1f dB)  %s\n", c->snr_db, w->snr_db, CQ_CHECK_WEAK_DB, drop,
+            snr_ok ? "ok" : "FAIL");
+    fprintf(stderr, "[BENCH] channel quality  fades %.3f/s (synth %.2f/s, clean %.3f/s), "
+            "depth %.1f dB (clean %.1f dB)  %s\n", f->fade_rate_hz, CQ_CHECK_FADE_HZ,
+            c->fade_rate_hz, f->fade_depth_db, c->fade_depth_db, fade_ok ? "ok" : "FAIL");
+    fprintf(stderr, "[BENCH] channel quality  spread %.2f Hz with a path %.0f Hz up "
+            "(clean %.2f Hz)  %s\n", p->doppler_spread_hz, CQ_CHECK_PATH_HZ,
+            c->doppler_spread_hz, spread_ok ? "ok" : "FAIL");
+    return floor_ok && snr_ok && fade_ok && spread_ok;
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+static const bench_check_t bench_checks[] = {
+    { "--kernel-check", "Check and time the SIMD kernels against scalar", run_kernel_check },
+    { "--denormal-check", "Time filters and the manager on silence", run_denormal_check },
+    { "--baseband-check", "Compare baseband tick / marker with 50 kHz", run_baseband_check },
+    { "--bcd-sliding-check", "Compare sliding BCD freq pulses with FFT mode", run_bcd_sliding_check },
+    { "--goertzel-check", "Compare Goertzel marker / BCD time with FFT mode", run_goertzel_check },
+    { "--bcd-adaptive-check", "Check BCD path switching and freq idle / resume", run_bcd_adaptive_check },
+    { "--tile-check", "Check event order across block sizes and threading", run_tile_check },
+    { "--consensus-check", "Vote simulated receivers' telemetry into one time", run_consensus_check },
+    { "--history-check", "Check the per-second metric history and its file", run_history_check },
+    { "--binlog-check", "Check binary logs convert back to the CSV logs", run_binlog_check },
+    { "--trace-check", "Check the trace spans of a threaded manager", run_trace_check },
+    { "--rt-check", "Check worker affinity, priority and memory locking", run_rt_check },
+    { "--marker-template-check", "Compare template marker onsets with the broadcast", run_marker_template_check },
+    { "--carrier-check", "Check the carrier NCO and offset correction", run_carrier_check },
+    { "--duty-check", "Check duty-cycled sleep, wake verification and outages", run_duty_check },
+    { "--refclock-check", "Check refclock times, receive stamps and a chrony sample", run_refclock_check },
+    { "--telem-check", "Check the telemetry sender over loopback", run_telem_check },
+    { "--bcd-integrate-check", "Decode a weak BCD frame over several minutes", run_bcd_integrate_check },
+    { "--tick-sdft-check", "Compare sliding DFT tick correlation with the MAC", run_tick_sdft_check },
+    { "--timebase-check", "Check tick times six hours into a run", run_timebase_check },
+    { "--percentile-check", "Compare the running percentile with a sort", run_percentile_check },
+    { "--window-ring-check", "Compare window ring reads and detector block sizes", run_window_ring_check },
+    { "--tone-zoom-check", "Check tone tracker overlap and adaptive zoom", run_tone_zoom_check },
+    { "--zoom-dft-check", "Check narrow-band DFT tone and carrier refinement", run_zoom_dft_check },
+    { "--sliding-sum-check", "Compare sliding window sums with exact sums", run_sliding_sum_check },
+    { "--cache-layout-check", "Check detector state alignment, heap and arena", run_cache_layout_check },
+    { "--bcd-solver-check", "Solve the BCD time from soft symbol decisions", run_bcd_solver_check },
+    { "--params-check", "Stage runtime tunables onto the detector path", run_params_check },
+    { "--corr-history-check", "Keep tick correlator history in bounded rings", run_corr_history_check },
+    { "--channel-quality-check", "Check the channel-quality estimate on the shared spectrum", run_channel_quality_check },
+};
+
+static const bench_check_t *find_check(const char *option) {
+    for (size_t k = 0; k < sizeof(bench_checks) / sizeof(bench_checks[0]); k++) {
+        if (strcmp(option, bench_checks[k].option) == 0) return &bench_checks[k];
+    }
+    return NULL;
+}
+
+static void usage_checks(void) {
+    for (size_t k = 0; k < sizeof(bench_checks) / sizeof(bench_checks[0]); k++) {
+        const bench_check_t *c = &bench_checks[k];
+        int pad = 18 - (int)strlen(c->option);
+        fprintf(stderr, "  %s%*s%s, then exit\n", c->option, pad > 1 ? pad : 1, "", c->help);
+    }
+}
+
+int main(int argc, char **argv) {
+    bench_options_t opt;
+    if (!parse_options(argc, argv, &opt)) return 2;
+    if (opt.check) return opt.check->run() ? 0 : 1;
+    if (opt.filter_vectors) return run_filter_check(opt.filter_vectors) ? 0 : 1;
+
+    wwv_trace_config_t trace = WWV_TRACE_CONFIG_DEFAULT;
+    trace.ring_events = TRACE_CHECK_RING;
+    if (opt.trace_path && !wwv_trace_start(opt.trace_path, &trace)) {
+        fprintf(stderr, "[BENCH] Cannot trace to %s (build with -DWWV_TRACE=ON)\n", opt.trace_path);
+    }
+    WWV_TRACE_THREAD("main");
+    manager_result_t mgr;
+    bool manager_ok = run_manager(&opt, &mgr);
+    wwv_trace_stop();
+    if (!manager_ok) {
+        fprintf(stderr, "[BENCH] Manager pass failed\n");
+        return 1;
+    }
+
+    bench_detector_t dets[BENCH_MAX_DETECTORS];
+    int det_count = opt.detectors ? run_detectors(&opt, dets) : 0;
+
+    FILE *f = (strcmp(opt.json_path, "-") == 0) ? stdout : fopen(opt.json_path, "w");
+    if (!f) {
+        fprintf(stderr, "[BENCH] Cannot write %s\n", opt.json_path);
+        return 1;
+    }
+    write_json(f, &opt, &mgr, dets, det_count);
+    if (f != stdout) fclose(f);
+
+    print_summary(&opt, &mgr, dets, det_count);
+    return check_manager_result(&opt, &mgr) ? 0 : 1;
+}
@@ -0,0 +1,908 @@
+/**
+ * @file wwv_golden.c
+ * @brief Golden-output regression corpus: detector events against stored output
+ *
+ * A corpus manifest (bench/golden/corpus.txt) lists short captures, one
+ * per line:
+ *
+ *   synth NAME key=value ...   synthetic broadcast, regenerated sample for
+ *                              sample from wwv_synth: seconds, station
+ *                              (wwv | wwvh | both), snr, doppler, fade-rate,
+ *                              fade-depth, seed, offset, minute, hour, day,
+ *                              year, leap-minute
+ *   wav NAME FILE key=value    a recording, path relative to the manifest:
+ *                              50 kHz detector path or 2 MHz SDR I/Q
+ *   tolerance key=value ...    defaults for the captures below it
+ *
+ * Tolerances (also accepted on a capture line) are tick-ms, marker-ms,
+ * bcd-ms and sync-ms, the timestamp difference an event may move and still
+ * match, and slack, the unmatched events allowed per kind.
+ *
+ * Each capture runs through a wwv_detector_manager with the default config
+ * (dual_station for "both") and its output -- ticks, minute markers, sync
+ * transitions, BCD symbols and the last decoded BCD time -- is matched in
+ * time order against NAME.golden next to the manifest. An event matches
+ * when its kind key (station, sync state, second and symbol) is equal and
+ * its times are within tolerance; what is left over on either side is a
+ * missing or extra event. The BCD time must be equal. Sync transitions are
+ * stamped at the end of the one-second feed they happen in.
+ *
+ * Per capture the runner reports events per kind, unmatched events, the
+ * worst matched time difference and throughput (x real time and ns per
+ * detector-path sample, timing the manager calls only), and exits 1 on any
+ * difference beyond tolerance or a missing golden file. --json writes the
+ * same for regression tracking.
+ *
+ * --write regenerates the golden files from this build instead, for a
+ * deliberate change in detector output; review their diff before
+ * committing it.
+ */
+
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE     /* clock_gettime(CLOCK_MONOTONIC) under -std=c11 */
+#endif
+
+#include "wwv_synth.h"
+#include "wwv_detector_manager.h"
+#include "wwv_iq_file.h"
+#include "polyphase_resampler.h"
+#include "bcd_correlator.h"
+#include "version.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+
+#define GOLDEN_DETECTOR_RATE    50000
+#define GOLDEN_DISPLAY_RATE     12000
+#define GOLDEN_SDR_RATE         2000000
+#define GOLDEN_WWVH_LEVEL       0.2f    /* As wwv_bench --station both */
+#define GOLDEN_WWVH_DELAY_SEC   0.012
+#define GOLDEN_MAX_CAPTURES     32
+#define GOLDEN_SHOW_DIFFS       5       /* Differences printed per capture */
+#define GOLDEN_HEADER           "# phoenix-wwv golden events v1"
+
+/* 50 kHz -> 12 kHz display path for detector-path recordings (wwv_replay) */
+#define GOLDEN_DISPLAY_INTERP   6
+#define GOLDEN_DISPLAY_DECIM    25
+#define GOLDEN_DISPLAY_TAPS     128
+#define GOLDEN_DISPLAY_CUTOFF   6000.0f
+
+/*============================================================================
+ * Corpus
+ *============================================================================*/
+
+typedef struct {
+    double tick_ms;
+    double marker_ms;
+    double bcd_ms;
+    double sync_ms;
+    int slack;
+} golden_tol_t;
+
+#define GOLDEN_TOL_DEFAULT { 0.5, 5.0, 20.0, 1000.0, 0 }
+
+typedef struct {
+    char name[64];
+    char spec[256];             /* Manifest arguments, for the golden header */
+    bool wav;
+    char path[512];             /* wav: recording */
+    wwv_synth_config_t synth;   /* synth: broadcast */
+    bool dual;
+    double seconds;
+    golden_tol_t tol;
+} golden_capture_t;
+
+typedef struct {
+    char dir[512];              /* Manifest directory, with trailing separator */
+    golden_capture_t captures[GOLDEN_MAX_CAPTURES];
+    int count;
+} golden_corpus_t;
+
+/*============================================================================
+ * Events
+ *============================================================================*/
+
+typedef enum {
+    GOLDEN_TICK = 0,
+    GOLDEN_MARKER,
+    GOLDEN_SYNC,
+    GOLDEN_BCD,
+    GOLDEN_KIND_COUNT
+} golden_kind_t;
+
+static const char *const kind_names[GOLDEN_KIND_COUNT] = { "tick", "marker", "sync", "bcd" };
+
+/*
+ *   tick    key = station,    t = timestamp_ms, t2 = epoch_ms
+ *   marker  key = 0,          t = timestamp_ms, t2 = duration_ms
+ *   sync    key = is_synced,  t = stream time,  aux = confidence
+ *   bcd     key = second * 4 + symbol, t = timestamp_ms
+ */
+typedef struct {
+    int key;
+    int aux;
+    double t;
+    double t2;
+} golden_event_t;
+
+typedef struct {
+    golden_event_t *ev;
+    size_t count;
+    size_t capacity;
+} golden_list_t;
+
+typedef struct {
+    golden_list_t lists[GOLDEN_KIND_COUNT];
+    bool has_time;
+    bcd_time_solution_t time;
+    bool failed;                /* Out of memory */
+} golden_output_t;
+
+static void output_free(golden_output_t *out) {
+    for (int k = 0; k < GOLDEN_KIND_COUNT; k++) free(out->lists[k].ev);
+    memset(out, 0, sizeof(*out));
+}
+
+static void output_add(golden_output_t *out, golden_kind_t kind, int key, int aux,
+                       double t, double t2) {
+    golden_list_t *l = &out->lists[kind];
+    if (l->count == l->capacity) {
+        size_t cap = l->capacity ? l->capacity * 2 : 256;
+        golden_event_t *ev = realloc(l->ev, cap * sizeof(*ev));
+        if (!ev) {
+            out->failed = true;
+            return;
+        }
+        l->ev = ev;
+        l->capacity = cap;
+    }
+    l->ev[l->count++] = (golden_event_t){ key, aux, t, t2 };
+}
+
+/*============================================================================
+ * Options
+ *============================================================================*/
+
+typedef struct {
+    const char *manifest;
+    const char *only;           /* Capture name, NULL = all */
+    const char *json_path;      /* NULL = none */
+    bool write;
+} golden_options_t;
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [options] CORPUS\n"
+            "  --write           Regenerate the golden files from this build\n"
+            "  --only NAME       Run one capture\n"
+            "  --json FILE       Write per-capture results (- for stdout)\n",
+            argv0);
+}
+
+static bool parse_options(int argc, char **argv, golden_options_t *opt) {
+    memset(opt, 0, sizeof(*opt));
+
+    for (int a = 1; a < argc; a++) {
+        const char *arg = argv[a];
+        const char *val = (a + 1 < argc) ? argv[a + 1] : NULL;
+
+        if (arg[0] != '-') {
+            if (opt->manifest) {
+                usage(argv[0]);
+                return false;
+            }
+            opt->manifest = arg;
+            continue;
+        }
+        if (strcmp(arg, "--write") == 0) { opt->write = true; continue; }
+        if (!val) {
+            usage(argv[0]);
+            return false;
+        }
+
+        if (strcmp(arg, "--only") == 0) opt->only = val;
+        else if (strcmp(arg, "--json") == 0) opt->json_path = val;
+        else {
+            usage(argv[0]);
+            return false;
+        }
+        a++;
+    }
+
+    if (!opt->manifest) {
+        usage(argv[0]);
+        return false;
+    }
+    return true;
+}
+
+static uint64_t golden_now_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+    if (!freq.QuadPart) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (uint64_t)((double)now.QuadPart * 1e9 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/*============================================================================
+ * Manifest
+ *============================================================================*/
+
+static bool set_tolerance(golden_tol_t *tol, const char *key, const char *val) {
+    if (strcmp(key, "tick-ms") == 0) tol->tick_ms = atof(val);
+    else if (strcmp(key, "marker-ms") == 0) tol->marker_ms = atof(val);
+    else if (strcmp(key, "bcd-ms") == 0) tol->bcd_ms = atof(val);
+    else if (strcmp(key, "sync-ms") == 0) tol->sync_ms = atof(val);
+    else if (strcmp(key, "slack") == 0) tol->slack = atoi(val);
+    else return false;
+    return true;
+}
+
+static bool set_synth(golden_capture_t *cap, const char *key, const char *val) {
+    wwv_synth_config_t *s = &cap->synth;
+    if (strcmp(key, "seconds") == 0) cap->seconds = atof(val);
+    else if (strcmp(key, "station") == 0) {
+        if (strcmp(val, "wwv") != 0 && strcmp(val, "wwvh") != 0 && strcmp(val, "both") != 0) {
+            return false;
+        }
+        s->station = (strcmp(val, "wwvh") == 0) ? WWV_SYNTH_WWVH : WWV_SYNTH_WWV;
+        cap->dual = (strcmp(val, "both") == 0);
+    }
+    else if (strcmp(key, "snr") == 0) s->snr_db = (float)atof(val);
+    else if (strcmp(key, "doppler") == 0) s->doppler_hz = (float)atof(val);
+    else if (strcmp(key, "fade-rate") == 0) s->fade_rate_hz = (float)atof(val);
+    else if (strcmp(key, "fade-depth") == 0) s->fade_depth_db = (float)atof(val);
+    else if (strcmp(key, "seed") == 0) s->seed = strtoull(val, NULL, 10);
+    else if (strcmp(key, "offset") == 0) s->start_offset_sec = atof(val);
+    else if (strcmp(key, "minute") == 0) s->start_minute = atoi(val);
+    else if (strcmp(key, "hour") == 0) s->start_hour = atoi(val);
+    else if (strcmp(key, "day") == 0) s->start_day = atoi(val);
+    else if (strcmp(key, "year") == 0) s->year = atoi(val);
+    else if (strcmp(key, "leap-minute") == 0) s->leap_minute = atoi(val);
+    else return false;
+    return true;
+}
+
+static bool load_corpus(const char *path, golden_corpus_t *corpus) {
+    memset(corpus, 0, sizeof(*corpus));
+
+    const char *slash = strrchr(path, '/');
+#ifdef _WIN32
+    const char *bslash = strrchr(path, '\\');
+    if (bslash && (!slash || bslash > slash)) slash = bslash;
+#endif
+    if (slash) {
+        size_t n = (size_t)(slash - path) + 1;
+        if (n >= sizeof(corpus->dir)) return false;
+        memcpy(corpus->dir, path, n);
+    }
+
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "[GOLDEN] cannot open %s\n", path);
+        return false;
+    }
+
+    golden_tol_t tol = GOLDEN_TOL_DEFAULT;
+    char line[1024];
+    int line_no = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), f)) {
+        line_no++;
+        line[strcspn(line, "\r\n")] = '\0';
+
+        char spec[sizeof(line)];
+        strcpy(spec, line);
+        char *tok = strtok(line, " \t");
+        if (!tok || tok[0] == '#') continue;
+
+        bool is_tol = strcmp(tok, "tolerance") == 0;
+        bool is_synth = strcmp(tok, "synth") == 0;
+        bool is_wav = strcmp(tok, "wav") == 0;
+        if (!is_tol && !is_synth && !is_wav) {
+            fprintf(stderr, "[GOLDEN] %s:%d: unknown entry '%s'\n", path, line_no, tok);
+            ok = false;
+            break;
+        }
+
+        golden_capture_t *cap = NULL;
+        if (!is_tol) {
+            char *name = strtok(NULL, " \t");
+            if (!name || corpus->count == GOLDEN_MAX_CAPTURES ||
+                strlen(name) >= sizeof(cap->name)) {
+                fprintf(stderr, "[GOLDEN] %s:%d: bad or too many captures\n", path, line_no);
+                ok = false;
+                break;
+            }
+            cap = &corpus->captures[corpus->count];
+            wwv_synth_config_t synth = WWV_SYNTH_CONFIG_DEFAULT;
+            memset(cap, 0, sizeof(*cap));
+            cap->synth = synth;
+            cap->seconds = 120.0;
+            cap->tol = tol;
+            cap->wav = is_wav;
+            strcpy(cap->name, name);
+            const char *args = strstr(spec, name) + strlen(name);
+            while (*args == ' ' || *args == '\t') args++;
+            snprintf(cap->spec, sizeof(cap->spec), "%s %s", is_wav ? "wav" : "synth", args);
+
+            if (is_wav) {
+                char *file = strtok(NULL, " \t");
+                if (!file || (size_t)snprintf(cap->path, sizeof(cap->path), "%s%s",
+                                              file[0] == '/' ? "" : corpus->dir, file)
+                                 >= sizeof(cap->path)) {
+                    fprintf(stderr, "[GOLDEN] %s:%d: wav needs a file\n", path, line_no);
+                    ok = false;
+                    break;
+                }
+            }
+        }
+
+        while ((tok = strtok(NULL, " \t")) != NULL) {
+            char *eq = strchr(tok, '=');
+            if (!eq) {
+                ok = false;
+            } else {
+                *eq = '\0';
+                const char *val = eq + 1;
+                if (cap) {
+                    ok = set_tolerance(&cap->tol, tok, val) ||
+                         (!cap->wav && set_synth(cap, tok, val));
+                } else {
+                    ok = set_tolerance(&tol, tok, val);
+                }
+            }
+            if (!ok) {
+                fprintf(stderr, "[GOLDEN] %s:%d: bad setting '%s'\n", path, line_no, tok);
+                break;
+            }
+        }
+        if (ok && cap) {
+            if (!cap->wav && cap->seconds <= 0.0) {
+                fprintf(stderr, "[GOLDEN] %s:%d: seconds must be positive\n", path, line_no);
+                ok = false;
+            }
+            corpus->count++;
+        }
+    }
+    fclose(f);
+
+    if (ok && corpus->count == 0) {
+        fprintf(stderr, "[GOLDEN] %s: no captures\n", path);
+        ok = false;
+    }
+    return ok;
+}
+
+/*============================================================================
+ * Capture Run
+ *============================================================================*/
+
+typedef struct {
+    golden_output_t out;
+    double now_ms;              /* Detector-path stream time fed so far */
+    uint64_t ns;                /* In manager calls */
+    uint64_t det_samples;
+} golden_run_t;
+
+static void on_tick(const wwv_tick_event_t *event, void *user_data) {
+    golden_run_t *run = (golden_run_t *)user_data;
+    output_add(&run->out, GOLDEN_TICK, (int)event->station, 0, event->timestamp_ms,
+               event->epoch_ms);
+}
+
+static void on_marker(const wwv_marker_event_t *event, void *user_data) {
+    golden_run_t *run = (golden_run_t *)user_data;
+    output_add(&run->out, GOLDEN_MARKER, 0, 0, event->timestamp_ms, event->duration_ms);
+}
+
+static void on_sync(const wwv_sync_status_t *status, void *user_data) {
+    golden_run_t *run = (golden_run_t *)user_data;
+    output_add(&run->out, GOLDEN_SYNC, status->is_synced ? 1 : 0, status->confidence,
+               run->now_ms, 0.0);
+}
+
+static void on_bcd_symbol(const bcd_symbol_event_t *event, void *user_data) {
+    golden_run_t *run = (golden_run_t *)user_data;
+    output_add(&run->out, GOLDEN_BCD, event->second * 4 + (int)event->symbol, 0,
+               event->timestamp_ms, 0.0);
+}
+
+static wwv_detector_manager_t *open_manager(const golden_capture_t *cap, bool sdr,
+                                            golden_run_t *run) {
+    wwv_detector_config_t config = WWV_DETECTOR_CONFIG_DEFAULT;
+    config.output_dir = NULL;
+    config.dual_station = cap->dual;
+    config.enable_sdr_frontend = sdr;
+
+    wwv_detector_manager_t *mgr = wwv_detector_manager_create(&config);
+    if (!mgr) return NULL;
+    wwv_detector_manager_set_tick_callback(mgr, on_tick, run);
+    wwv_detector_manager_set_marker_callback(mgr, on_marker, run);
+    wwv_detector_manager_set_sync_callback(mgr, on_sync, run);
+    wwv_detector_manager_set_bcd_symbol_callback(mgr, on_bcd_symbol, run);
+    return mgr;
+}
+
+static void close_manager(wwv_detector_manager_t *mgr, golden_run_t *run) {
+    run->out.has_time = wwv_detector_manager_get_bcd_time(mgr, &run->out.time);
+    wwv_detector_manager_destroy(mgr);
+}
+
+/* One second per path, WWVH mixed in as wwv_bench --station both does */
+static bool run_synth(const golden_capture_t *cap, golden_run_t *run) {
+    wwv_synth_config_t cfg = cap->synth;
+    wwv_synth_t *synth[4] = { NULL, NULL, NULL, NULL };
+    cfg.sample_rate = GOLDEN_DETECTOR_RATE;
+    synth[0] = wwv_synth_create(&cfg);
+    cfg.sample_rate = GOLDEN_DISPLAY_RATE;
+    cfg.seed = cap->synth.seed + 1;
+    synth[1] = wwv_synth_create(&cfg);
+    if (cap->dual) {
+        cfg = cap->synth;
+        cfg.station = WWV_SYNTH_WWVH;
+        cfg.carrier_amplitude = cap->synth.carrier_amplitude * GOLDEN_WWVH_LEVEL;
+        cfg.snr_db = 200.0f;
+        cfg.start_offset_sec = cap->synth.start_offset_sec + 60.0 - GOLDEN_WWVH_DELAY_SEC;
+        cfg.start_minute = (cap->synth.start_minute + 59) % 60;
+        if (cfg.leap_minute >= 0) cfg.leap_minute++;
+        cfg.sample_rate = GOLDEN_DETECTOR_RATE;
+        synth[2] = wwv_synth_create(&cfg);
+        cfg.sample_rate = GOLDEN_DISPLAY_RATE;
+        synth[3] = wwv_synth_create(&cfg);
+    }
+
+    float *buf = malloc(4 * GOLDEN_DETECTOR_RATE * sizeof(float));
+    wwv_detector_manager_t *mgr = open_manager(cap, false, run);
+    bool ok = buf && mgr && synth[0] && synth[1] && (!cap->dual || (synth[2] && synth[3]));
+
+    float *det_i = buf, *det_q = buf + GOLDEN_DETECTOR_RATE;
+    float *mix_i = buf + 2 * GOLDEN_DETECTOR_RATE, *mix_q = buf + 3 * GOLDEN_DETECTOR_RATE;
+    static float disp_i[GOLDEN_DISPLAY_RATE], disp_q[GOLDEN_DISPLAY_RATE];
+    for (double done = 0.0; ok && done < cap->seconds; done += 1.0) {
+        double fraction = (cap->seconds - done < 1.0) ? cap->seconds - done : 1.0;
+        size_t det_n = (size_t)(GOLDEN_DETECTOR_RATE * fraction + 0.5);
+        size_t disp_n = (size_t)(GOLDEN_DISPLAY_RATE * fraction + 0.5);
+
+        wwv_synth_generate(synth[0], det_i, det_q, det_n);
+        wwv_synth_generate(synth[1], disp_i, disp_q, disp_n);
+        if (cap->dual) {
+            wwv_synth_generate(synth[2], mix_i, mix_q, det_n);
+            for (size_t k = 0; k < det_n; k++) {
+                det_i[k] += mix_i[k];
+                det_q[k] += mix_q[k];
+            }
+            wwv_synth_generate(synth[3], mix_i, mix_q, disp_n);
+            for (size_t k = 0; k < disp_n; k++) {
+                disp_i[k] += mix_i[k];
+                disp_q[k] += mix_q[k];
+            }
+        }
+
+        run->det_samples += det_n;
+        run->now_ms = run->det_samples * 1000.0 / GOLDEN_DETECTOR_RATE;
+        uint64_t t0 = golden_now_ns();
+        wwv_detector_manager_process_detector_block(mgr, det_i, det_q, det_n);
+        wwv_detector_manager_process_display_block(mgr, disp_i, disp_q, disp_n);
+        run->ns += golden_now_ns() - t0;
+    }
+
+    if (mgr) close_manager(mgr, run);
+    for (int k = 0; k < 4; k++) wwv_synth_destroy(synth[k]);
+    free(buf);
+    return ok;
+}
+
+/* One second at a time; 50 kHz recordings get a resampled display path */
+static bool run_wav(const golden_capture_t *cap, golden_run_t *run) {
+    wwv_iq_file_t *file = wwv_iq_file_open(cap->path, NULL);
+    if (!file) {
+        fprintf(stderr, "[GOLDEN] %s: cannot open %s\n", cap->name, cap->path);
+        return false;
+    }
+    uint32_t rate = wwv_iq_file_info(file)->sample_rate;
+    uint64_t total = wwv_iq_file_info(file)->sample_count;
+    bool sdr = (rate == GOLDEN_SDR_RATE);
+    if (!sdr && rate != GOLDEN_DETECTOR_RATE) {
+        fprintf(stderr, "[GOLDEN] %s: %u Hz, expected %d or %d\n", cap->name, rate,
+                GOLDEN_DETECTOR_RATE, GOLDEN_SDR_RATE);
+        wwv_iq_file_close(file);
+        return false;
+    }
+
+    polyphase_resampler_t *display = NULL;
+    size_t display_max = 0;
+    if (!sdr) {
+        display = polyphase_resampler_create(GOLDEN_DISPLAY_INTERP, GOLDEN_DISPLAY_DECIM,
+                                             GOLDEN_DISPLAY_TAPS, GOLDEN_DETECTOR_RATE,
+                                             GOLDEN_DISPLAY_CUTOFF);
+        if (display) display_max = polyphase_resampler_max_output(display, rate);
+    }
+    float *in = malloc(2 * (size_t)rate * sizeof(float));
+    float *disp = display_max ? malloc(2 * display_max * sizeof(float)) : NULL;
+    wwv_detector_manager_t *mgr = open_manager(cap, sdr, run);
+    bool ok = in && mgr && (sdr || disp);
+
+    for (uint64_t pos = 0; ok && pos < total; ) {
+        size_t want = (total - pos < rate) ? (size_t)(total - pos) : rate;
+        size_t got = wwv_iq_file_read(file, pos, want, in, in + rate);
+        if (got == 0) break;
+        pos += got;
+        run->det_samples += sdr ? got / (GOLDEN_SDR_RATE / GOLDEN_DETECTOR_RATE) : got;
+        run->now_ms = (double)pos * 1000.0 / rate;
+
+        uint64_t t0 = golden_now_ns();
+        if (sdr) {
+            wwv_detector_manager_process_sdr_block(mgr, in, in + rate, got);
+        } else {
+            wwv_detector_manager_process_detector_block(mgr, in, in + rate, got);
+            size_t n = polyphase_resampler_process(display, in, in + rate, got,
+                                                   disp, disp + display_max);
+            wwv_detector_manager_process_display_block(mgr, disp, disp + display_max, n);
+        }
+        run->ns += golden_now_ns() - t0;
+    }
+
+    if (mgr) close_manager(mgr, run);
+    free(disp);
+    free(in);
+    polyphase_resampler_destroy(display);
+    wwv_iq_file_close(file);
+    return ok;
+}
+
+/*============================================================================
+ * Golden Files
+ *============================================================================*/
+
+static void golden_path(const golden_corpus_t *corpus, const golden_capture_t *cap,
+                        char *path, size_t size) {
+    snprintf(path, size, "%s%s.golden", corpus->dir, cap->name);
+}
+
+static bool write_golden(const char *path, const golden_capture_t *cap,
+                         const golden_output_t *out) {
+    FILE *f = fopen(path, "w");
+    if (!f) return false;
+
+    fprintf(f, GOLDEN_HEADER "\n");
+    fprintf(f, "# %s: %s\n", cap->name, cap->spec);
+    fprintf(f, "# Written by wwv_golden --write; do not edit\n");
+    fprintf(f, "# tick STATION TIMESTAMP_MS EPOCH_MS | marker TIMESTAMP_MS DURATION_MS\n");
+    fprintf(f, "# sync SYNCED CONFIDENCE TIME_MS | bcd SECOND SYMBOL TIMESTAMP_MS\n");
+    fprintf(f, "# time DAY HOUR MINUTE YEAR LEAP_WARNING | time none\n");
+
+    /* Merged in time order so a diff of two golden files reads like a log */
+    size_t at[GOLDEN_KIND_COUNT] = { 0 };
+    for (;;) {
+        int best = -1;
+        for (int k = 0; k < GOLDEN_KIND_COUNT; k++) {
+            if (at[k] == out->lists[k].count) continue;
+            if (best < 0 || out->lists[k].ev[at[k]].t < out->lists[best].ev[at[best]].t) best = k;
+        }
+        if (best < 0) break;
+
+        const golden_event_t *e = &out->lists[best].ev[at[best]++];
+        switch ((golden_kind_t)best) {
+        case GOLDEN_TICK:
+            fprintf(f, "tick %d %.3f %.3f\n", e->key, e->t, e->t2);
+            break;
+        case GOLDEN_MARKER:
+            fprintf(f, "marker %.3f %.3f\n", e->t, e->t2);
+            break;
+        case GOLDEN_SYNC:
+            fprintf(f, "sync %d %d %.0f\n", e->key, e->aux, e->t);
+            break;
+        default:
+            fprintf(f, "bcd %d %d %.3f\n", e->key / 4, e->key % 4, e->t);
+            break;
+        }
+    }
+
+    if (out->has_time) {
+        fprintf(f, "time %d %d %d %d %d\n", out->time.day, out->time.hour, out->time.minute,
+                out->time.year, out->time.leap_warning ? 1 : 0);
+    } else {
+        fprintf(f, "time none\n");
+    }
+    return fclose(f) == 0;
+}
+
+static bool read_golden(const char *path, golden_output_t *out) {
+    memset(out, 0, sizeof(*out));
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+
+    char line[256];
+    bool header = false;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (strcmp(line, GOLDEN_HEADER) == 0) header = true;
+        if (line[0] == '#' || line[0] == '\0') continue;
+
+        int a, b, c, d, e;
+        double t, t2;
+        if (sscanf(line, "tick %d %lf %lf", &a, &t, &t2) == 3) {
+            output_add(out, GOLDEN_TICK, a, 0, t, t2);
+        } else if (sscanf(line, "marker %lf %lf", &t, &t2) == 2) {
+            output_add(out, GOLDEN_MARKER, 0, 0, t, t2);
+        } else if (sscanf(line, "sync %d %d %lf", &a, &b, &t) == 3) {
+            output_add(out, GOLDEN_SYNC, a, b, t, 0.0);
+        } else if (sscanf(line, "bcd %d %d %lf", &a, &b, &t) == 3) {
+            output_add(out, GOLDEN_BCD, a * 4 + b, 0, t, 0.0);
+        } else if (sscanf(line, "time %d %d %d %d %d", &a, &b, &c, &d, &e) == 5) {
+            out->has_time = true;
+            out->time.day = a;
+            out->time.hour = b;
+            out->time.minute = c;
+            out->time.year = d;
+            out->time.leap_warning = e != 0;
+        } else if (strcmp(line, "time none") != 0) {
+            ok = false;
+        }
+    }
+    fclose(f);
+    return ok && header && !out->failed;
+}
+
+/*============================================================================
+ * Comparison
+ *============================================================================*/
+
+typedef struct {
+    size_t golden[GOLDEN_KIND_COUNT];
+    size_t got[GOLDEN_KIND_COUNT];
+    size_t missing[GOLDEN_KIND_COUNT];  /* Golden events with no match */
+    size_t extra[GOLDEN_KIND_COUNT];    /* New events with no match */
+    double worst_ms[GOLDEN_KIND_COUNT]; /* Largest matched time difference */
+    bool time_ok;
+    bool pass;
+} golden_diff_t;
+
+static double kind_tol(const golden_tol_t *tol, int kind) {
+    switch ((golden_kind_t)kind) {
+    case GOLDEN_TICK: return tol->tick_ms;
+    case GOLDEN_MARKER: return tol->marker_ms;
+    case GOLDEN_SYNC: return tol->sync_ms;
+    default: return tol->bcd_ms;
+    }
+}
+
+/* Second time compared: tick epoch and marker duration */
+static double event_delta(int kind, const golden_event_t *g, const golden_event_t *e) {
+    double dt = fabs(e->t - g->t);
+    if (kind == GOLDEN_TICK || kind == GOLDEN_MARKER) {
+        double d2 = fabs(e->t2 - g->t2);
+        if (d2 > dt) dt = d2;
+    }
+    return dt;
+}
+
+static void show_event(const char *name, const char *what, int kind, const golden_event_t *e,
+                       int *shown) {
+    if ((*shown)++ >= GOLDEN_SHOW_DIFFS) return;
+    switch ((golden_kind_t)kind) {
+    case GOLDEN_TICK:
+        fprintf(stderr, "[GOLDEN]   %s: %s tick station %d at %.3f ms (epoch %.3f)\n",
+                name, what, e->key, e->t, e->t2);
+        break;
+    case GOLDEN_MARKER:
+        fprintf(stderr, "[GOLDEN]   %s: %s marker at %.3f ms (%.1f ms)\n", name, what, e->t, e->t2);
+        break;
+    case GOLDEN_SYNC:
+        fprintf(stderr, "[GOLDEN]   %s: %s sync %s at %.0f ms\n", name, what,
+                e->key ? "locked" : "lost", e->t);
+        break;
+    default:
+        fprintf(stderr, "[GOLDEN]   %s: %s bcd :%02d symbol %d at %.3f ms\n", name, what,
+                e->key / 4, e->key % 4, e->t);
+        break;
+    }
+}
+
+/*
+ * Both lists are in time order per kind. Walk them together: equal keys
+ * within tolerance match; otherwise the earlier event is unmatched.
+ */
+static void compare_kind(const golden_capture_t *cap, int kind, const golden_list_t *g,
+                         const golden_list_t *e, golden_diff_t *diff, int *shown) {
+    double tol = kind_tol(&cap->tol, kind);
+    size_t i = 0, j = 0;
+    while (i < g->count || j < e->count) {
+        if (i < g->count && j < e->count) {
+            const golden_event_t *ge = &g->ev[i], *ee = &e->ev[j];
+            double dt = event_delta(kind, ge, ee);
+            if (ge->key == ee->key && dt <= tol) {
+                if (dt > diff->worst_ms[kind]) diff->worst_ms[kind] = dt;
+                i++;
+                j++;
+                continue;
+            }
+            if (ge->t <= ee->t) {
+                show_event(cap->name, "missing", kind, ge, shown);
+                diff->missing[kind]++;
+                i++;
+            } else {
+                show_event(cap->name, "extra", kind, ee, shown);
+                diff->extra[kind]++;
+                j++;
+            }
+        } else if (i < g->count) {
+            show_event(cap->name, "missing", kind, &g->ev[i++], shown);
+            diff->missing[kind]++;
+        } else {
+            show_event(cap->name, "extra", kind, &e->ev[j++], shown);
+            diff->extra[kind]++;
+        }
+    }
+}
+
+static void compare_output(const golden_capture_t *cap, const golden_output_t *golden,
+                           const golden_output_t *got, golden_diff_t *diff) {
+    memset(diff, 0, sizeof(*diff));
+    int shown = 0;
+    diff->pass = true;
+    for (int k = 0; k < GOLDEN_KIND_COUNT; k++) {
+        diff->golden[k] = golden->lists[k].count;
+        diff->got[k] = got->lists[k].count;
+        compare_kind(cap, k, &golden->lists[k], &got->lists[k], diff, &shown);
+        if (diff->missing[k] + diff->extra[k] > (size_t)cap->tol.slack) diff->pass = false;
+    }
+    if (shown > GOLDEN_SHOW_DIFFS) {
+        fprintf(stderr, "[GOLDEN]   %s: %d more differences\n", cap->name, shown - GOLDEN_SHOW_DIFFS);
+    }
+
+    const bcd_time_solution_t *a = &golden->time, *b = &got->time;
+    diff->time_ok = golden->has_time == got->has_time &&
+                    (!golden->has_time ||
+                     (a->day == b->day && a->hour == b->hour && a->minute == b->minute &&
+                      a->year == b->year && a->leap_warning == b->leap_warning));
+    if (!diff->time_ok) {
+        char want[32] = "none", have[32] = "none";
+        if (golden->has_time) snprintf(want, sizeof(want), "day %03d %02d:%02d", a->day, a->hour, a->minute);
+        if (got->has_time) snprintf(have, sizeof(have), "day %03d %02d:%02d", b->day, b->hour, b->minute);
+        fprintf(stderr, "[GOLDEN]   %s: BCD time %s%s, golden %s%s\n", cap->name, have,
+                got->has_time && b->leap_warning ? " (leap warning)" : "", want,
+                golden->has_time && a->leap_warning ? " (leap warning)" : "");
+        diff->pass = false;
+    }
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+static void write_json_capture(FILE *f, const golden_capture_t *cap, const golden_run_t *run,
+                               const golden_diff_t *diff, bool first) {
+    double seconds = run->det_samples / (double)GOLDEN_DETECTOR_RATE;
+    fprintf(f, "%s\n    {\n", first ? "" : ",");
+    fprintf(f, "      \"name\": \"%s\",\n", cap->name);
+    fprintf(f, "      \"seconds\": %.1f,\n", seconds);
+    fprintf(f, "      \"ns_per_sample\": %.1f,\n",
+            run->det_samples ? (double)run->ns / (double)run->det_samples : 0.0);
+    fprintf(f, "      \"realtime_factor\": %.1f,\n", run->ns ? seconds * 1e9 / (double)run->ns : 0.0);
+    for (int k = 0; k < GOLDEN_KIND_COUNT; k++) {
+        fprintf(f, "      \"%s\": { \"golden\": %zu, \"got\": %zu, \"missing\": %zu, "
+                "\"extra\": %zu, \"worst_ms\": %.3f },\n", kind_names[k], diff->golden[k],
+                diff->got[k], diff->missing[k], diff->extra[k], diff->worst_ms[k]);
+    }
+    fprintf(f, "      \"time_ok\": %s,\n", diff->time_ok ? "true" : "false");
+    fprintf(f, "      \"pass\": %s\n", diff->pass ? "true" : "false");
+    fprintf(f, "    }");
+}
+
+int main(int argc, char **argv) {
+    golden_options_t opt;
+    if (!parse_options(argc, argv, &opt)) return 2;
+
+    static golden_corpus_t corpus;
+    if (!load_corpus(opt.manifest, &corpus)) return 2;
+
+    FILE *json = NULL;
+    if (opt.json_path) {
+        json = strcmp(opt.json_path, "-") == 0 ? stdout : fopen(opt.json_path, "w");
+        if (!json) {
+            fprintf(stderr, "[GOLDEN] cannot write %s\n", opt.json_path);
+            return 2;
+        }
+        fprintf(json, "{\n  \"version\": \"%s\",\n  \"captures\": [", PHOENIX_VERSION_FULL);
+    }
+
+    int run_count = 0, failed = 0, json_count = 0;
+    uint64_t total_ns = 0, total_samples = 0;
+    for (int c = 0; c < corpus.count; c++) {
+        const golden_capture_t *cap = &corpus.captures[c];
+        if (opt.only && strcmp(opt.only, cap->name) != 0) continue;
+        run_count++;
+
+        golden_run_t run;
+        memset(&run, 0, sizeof(run));
+        bool ran = cap->wav ? run_wav(cap, &run) : run_synth(cap, &run);
+        if (!ran || run.out.failed) {
+            fprintf(stderr, "[GOLDEN] %s: run failed\n", cap->name);
+            output_free(&run.out);
+            failed++;
+            continue;
+        }
+        total_ns += run.ns;
+        total_samples += run.det_samples;
+
+        double seconds = run.det_samples / (double)GOLDEN_DETECTOR_RATE;
+        double speed = run.ns ? seconds * 1e9 / (double)run.ns : 0.0;
+        double ns_per = run.det_samples ? (double)run.ns / (double)run.det_samples : 0.0;
+
+        char path[600];
+        golden_path(&corpus, cap, path, sizeof(path));
+        if (opt.write) {
+            if (!write_golden(path, cap, &run.out)) {
+                fprintf(stderr, "[GOLDEN] cannot write %s\n", path);
+                failed++;
+            } else {
+                fprintf(stderr, "[GOLDEN] %-16s wrote %zu ticks, %zu markers, %zu sync, "
+                        "%zu bcd (%.0fx real time)\n", cap->name,
+                        run.out.lists[GOLDEN_TICK].count, run.out.lists[GOLDEN_MARKER].count,
+                        run.out.lists[GOLDEN_SYNC].count, run.out.lists[GOLDEN_BCD].count, speed);
+            }
+            output_free(&run.out);
+            continue;
+        }
+
+        golden_output_t golden;
+        if (!read_golden(path, &golden)) {
+            fprintf(stderr, "[GOLDEN] %s: no valid golden file %s (run with --write)\n",
+                    cap->name, path);
+            output_free(&golden);
+            output_free(&run.out);
+            failed++;
+            continue;
+        }
+
+        golden_diff_t diff;
+        compare_output(cap, &golden, &run.out, &diff);
+        size_t unmatched = 0;
+        for (int k = 0; k < GOLDEN_KIND_COUNT; k++) unmatched += diff.missing[k] + diff.extra[k];
+        fprintf(stderr, "[GOLDEN] %-16s %s  %zu ticks, %zu markers, %zu sync, %zu bcd, "
+                "%zu unmatched; worst tick %.3f ms marker %.3f ms bcd %.3f ms; "
+                "%.0fx real time, %.1f ns/sample\n",
+                cap->name, diff.pass ? "ok  " : "FAIL",
+                diff.got[GOLDEN_TICK], diff.got[GOLDEN_MARKER], diff.got[GOLDEN_SYNC],
+                diff.got[GOLDEN_BCD], unmatched, diff.worst_ms[GOLDEN_TICK],
+                diff.worst_ms[GOLDEN_MARKER], diff.worst_ms[GOLDEN_BCD], speed, ns_per);
+        if (!diff.pass) failed++;
+        if (json) write_json_capture(json, cap, &run, &diff, json_count++ == 0);
+
+        output_free(&golden);
+        output_free(&run.out);
+    }
+
+    if (json) {
+        fprintf(json, "\n  ]\n}\n");
+        if (json != stdout) fclose(json);
+    }
+
+    if (run_count == 0) {
+        fprintf(stderr, "[GOLDEN] no capture named %s\n", opt.only ? opt.only : "");
+        return 2;
+    }
+    double seconds = total_samples / (double)GOLDEN_DETECTOR_RATE;
+    fprintf(stderr, "[GOLDEN] %d/%d captures %s, %.0f s of signal at %.0fx real time\n",
+            run_count - failed, run_count, opt.write ? "written" : "match",
+            seconds, total_ns ? seconds * 1e9 / (double)total_ns : 0.0);
+    return failed ? 1 : 0;
+}
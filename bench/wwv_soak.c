@@ -0,0 +1,597 @@
+/**
+ * @file wwv_soak.c
+ * @brief Long-run soak: simulated days of synthetic WWV through the manager
+ *
+ * Drives one wwv_detector_manager for --hours of synthetic signal, as fast
+ * as it will go or paced to --speed times real time, and every
+ * --interval-min of signal records:
+ *   - process RSS and live heap blocks (allocs - frees, glibc only)
+ *   - latency of each block (--block detector samples plus the matching
+ *     display samples): p50 / p99 / p99.9 / max and mean ns/sample
+ *   - ticks and markers against the interval's broadcast, and the median
+ *     tick epoch phase against the synthetic second, which walks if a time
+ *     stamp is being accumulated in too little precision, plus the worst
+ *     gap between an event's timestamp_ms and its sample_index
+ *   - with --log-dir, the bytes the CSV logs have grown by
+ *
+ * The first interval is acquisition and the second the baseline the rest
+ * are checked against. The run fails (exit 1) when, after the baseline,
+ * RSS or live heap grows past its bound, mean or p99 latency rises past
+ * its factor, an interval's events fall short of --min-event-ratio of the
+ * broadcast (or exceed it), the tick phase moves, or a timestamp parts
+ * from its sample index. Intervals go to stderr as they finish and, with
+ * --json, to a results file.
+ */
+
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE     /* clock_gettime, nanosleep, sysconf under -std=c11 */
+#endif
+
+#include "wwv_synth.h"
+#include "bench_alloc.h"
+#include "wwv_detector_manager.h"
+#include "version.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define SOAK_DETECTOR_RATE      50000
+#define SOAK_DISPLAY_RATE       12000
+
+/*============================================================================
+ * Options
+ *============================================================================*/
+
+typedef struct {
+    double hours;
+    double interval_min;
+    double speed;               /* Signal seconds per wall second, 0 = unpaced */
+    size_t block;
+    wwv_synth_config_t synth;
+    const char *log_dir;
+    const char *json_path;      /* NULL = none */
+    const char *label;
+
+    /* Failure bounds, checked against the baseline interval */
+    double max_rss_growth_kb;
+    long max_heap_growth;       /* Live heap blocks */
+    double max_mean_ratio;
+    double max_p99_ratio;
+    double min_event_ratio;
+    double max_phase_drift_ms;
+} soak_options_t;
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --hours N             Simulated run length (default 24)\n"
+            "  --interval-min N      Signal minutes per sample interval (default 10)\n"
+            "  --speed X             Pace to X times real time, 0 = unpaced (default 0)\n"
+            "  --block N             Detector samples per block call (default 5000)\n"
+            "  --snr DB              Carrier SNR in 10 kHz (default 30)\n"
+            "  --fade-rate HZ        Fade cycle rate (default 0 = none)\n"
+            "  --fade-depth DB       Fade depth (default 0)\n"
+            "  --seed N              Noise seed (default 1)\n"
+            "  --log-dir DIR         Write manager CSV logs to DIR and track their growth\n"
+            "  --json FILE           Per-interval results, - for stdout (default: none)\n"
+            "  --label TEXT          Run label stored in the results\n"
+            "  --max-rss-growth KB   RSS growth past the baseline (default 2048)\n"
+            "  --max-heap-growth N   Live heap block growth past the baseline (default 64)\n"
+            "  --max-mean-ratio X    Mean ns/sample over the baseline's (default 1.5)\n"
+            "  --max-p99-ratio X     p99 block latency over the baseline's (default 3)\n"
+            "  --min-event-ratio X   Ticks and markers per interval, of the broadcast's (default 0.3)\n"
+            "  --max-phase-drift MS  Median tick phase move from the baseline (default 0.5)\n",
+            argv0);
+}
+
+static bool parse_options(int argc, char **argv, soak_options_t *opt) {
+    wwv_synth_config_t synth = WWV_SYNTH_CONFIG_DEFAULT;
+    opt->hours = 24.0;
+    opt->interval_min = 10.0;
+    opt->speed = 0.0;
+    opt->block = 5000;
+    opt->synth = synth;
+    opt->log_dir = NULL;
+    opt->json_path = NULL;
+    opt->label = "";
+    opt->max_rss_growth_kb = 2048.0;
+    opt->max_heap_growth = 64;
+    opt->max_mean_ratio = 1.5;
+    opt->max_p99_ratio = 3.0;
+    opt->min_event_ratio = 0.3;
+    opt->max_phase_drift_ms = 0.5;
+
+    for (int a = 1; a < argc; a++) {
+        const char *arg = argv[a];
+        const char *val = (a + 1 < argc) ? argv[a + 1] : NULL;
+        if (!val) {
+            usage(argv[0]);
+            return false;
+        }
+
+        if (strcmp(arg, "--hours") == 0) opt->hours = atof(val);
+        else if (strcmp(arg, "--interval-min") == 0) opt->interval_min = atof(val);
+        else if (strcmp(arg, "--speed") == 0) opt->speed = atof(val);
+        else if (strcmp(arg, "--block") == 0) opt->block = (size_t)atol(val);
+        else if (strcmp(arg, "--snr") == 0) opt->synth.snr_db = (float)atof(val);
+        else if (strcmp(arg, "--fade-rate") == 0) opt->synth.fade_rate_hz = (float)atof(val);
+        else if (strcmp(arg, "--fade-depth") == 0) opt->synth.fade_depth_db = (float)atof(val);
+        else if (strcmp(arg, "--seed") == 0) opt->synth.seed = strtoull(val, NULL, 10);
+        else if (strcmp(arg, "--log-dir") == 0) opt->log_dir = val;
+        else if (strcmp(arg, "--json") == 0) opt->json_path = val;
+        else if (strcmp(arg, "--label") == 0) opt->label = val;
+        else if (strcmp(arg, "--max-rss-growth") == 0) opt->max_rss_growth_kb = atof(val);
+        else if (strcmp(arg, "--max-heap-growth") == 0) opt->max_heap_growth = atol(val);
+        else if (strcmp(arg, "--max-mean-ratio") == 0) opt->max_mean_ratio = atof(val);
+        else if (strcmp(arg, "--max-p99-ratio") == 0) opt->max_p99_ratio = atof(val);
+        else if (strcmp(arg, "--min-event-ratio") == 0) opt->min_event_ratio = atof(val);
+        else if (strcmp(arg, "--max-phase-drift") == 0) opt->max_phase_drift_ms = atof(val);
+        else {
+            usage(argv[0]);
+            return false;
+        }
+        a++;
+    }
+
+    /* Whole seconds per block and per interval keep the paths in step */
+    if (opt->block == 0 || SOAK_DETECTOR_RATE % opt->block != 0 ||
+        (opt->block * SOAK_DISPLAY_RATE) % SOAK_DETECTOR_RATE != 0 ||
+        opt->interval_min < 1.0 || opt->hours * 60.0 < 3.0 * opt->interval_min) {
+        fprintf(stderr, "[SOAK] Need a block dividing 1 s on both paths and three intervals\n");
+        usage(argv[0]);
+        return false;
+    }
+    return true;
+}
+
+/*============================================================================
+ * Platform Probes
+ *============================================================================*/
+
+static uint64_t soak_now_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+    if (!freq.QuadPart) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (uint64_t)((double)now.QuadPart * 1e9 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static void soak_sleep_ns(uint64_t ns) {
+#ifdef _WIN32
+    Sleep((DWORD)(ns / 1000000ULL));
+#else
+    struct timespec ts = { (time_t)(ns / 1000000000ULL), (long)(ns % 1000000000ULL) };
+    nanosleep(&ts, NULL);
+#endif
+}
+
+/* Resident set in KiB, 0 where it cannot be read */
+static double soak_rss_kb(void) {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0.0;
+    return pmc.WorkingSetSize / 1024.0;
+#else
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (!f) return 0.0;
+    unsigned long size = 0, resident = 0;
+    int n = fscanf(f, "%lu %lu", &size, &resident);
+    fclose(f);
+    return (n == 2) ? resident * (sysconf(_SC_PAGESIZE) / 1024.0) : 0.0;
+#endif
+}
+
+/* Bytes in the regular files of dir (the manager's CSV logs) */
+static uint64_t soak_dir_bytes(const char *dir) {
+    uint64_t total = 0;
+    if (!dir) return 0;
+#ifdef _WIN32
+    char pattern[MAX_PATH];
+    WIN32_FIND_DATAA fd;
+    snprintf(pattern, sizeof(pattern), "%s\\*", dir);
+    HANDLE h = FindFirstFileA(pattern, &fd);
+    if (h == INVALID_HANDLE_VALUE) return 0;
+    do {
+        if (!(fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+            total += ((uint64_t)fd.nFileSizeHigh << 32) | fd.nFileSizeLow;
+        }
+    } while (FindNextFileA(h, &fd));
+    FindClose(h);
+#else
+    DIR *d = opendir(dir);
+    if (!d) return 0;
+    struct dirent *e;
+    char path[4096];
+    while ((e = readdir(d)) != NULL) {
+        struct stat st;
+        snprintf(path, sizeof(path), "%s/%s", dir, e->d_name);
+        if (stat(path, &st) == 0 && S_ISREG(st.st_mode)) total += (uint64_t)st.st_size;
+    }
+    closedir(d);
+#endif
+    return total;
+}
+
+/*============================================================================
+ * Interval Records
+ *============================================================================*/
+
+typedef struct {
+    double end_hours;           /* Signal time at the interval's end */
+    double rss_kb;
+    long live_heap;             /* Allocs - frees since before create */
+    uint64_t log_bytes;
+    double mean_ns_per_sample;
+    uint64_t p50_ns, p99_ns, p999_ns, max_ns;
+    int ticks, markers;
+    int expected_ticks, expected_markers;
+    double phase_ms;            /* Median tick epoch phase in the second */
+    double phase_spread_ms;     /* Interquartile range of the phases */
+    double max_stamp_err_ms;    /* |timestamp_ms - sample_index / rate| */
+    int sync_losses;
+    bool synced;
+    bool failed;
+} soak_interval_t;
+
+/* Event accumulators the callbacks fill for the current interval */
+typedef struct {
+    int ticks, markers;
+    double *phase;              /* Tick epoch phases, ms */
+    int phase_n, phase_cap;
+    double max_stamp_err_ms;
+    int sync_losses;
+    bool was_synced;
+} soak_events_t;
+
+static double stamp_err_ms(double timestamp_ms, uint64_t sample_index) {
+    return fabs(timestamp_ms - (double)sample_index * 1000.0 / SOAK_DETECTOR_RATE);
+}
+
+static void on_tick(const wwv_tick_event_t *ev, void *user_data) {
+    soak_events_t *e = (soak_events_t *)user_data;
+    e->ticks++;
+
+    /* The synthetic second starts at a whole second of signal time */
+    double phase = fmod(ev->epoch_ms, 1000.0);
+    if (phase >= 500.0) phase -= 1000.0;
+    if (e->phase_n < e->phase_cap) e->phase[e->phase_n++] = phase;
+
+    double err = stamp_err_ms(ev->timestamp_ms, ev->sample_index);
+    if (err > e->max_stamp_err_ms) e->max_stamp_err_ms = err;
+}
+
+static void on_marker(const wwv_marker_event_t *ev, void *user_data) {
+    soak_events_t *e = (soak_events_t *)user_data;
+    e->markers++;
+    double err = stamp_err_ms(ev->timestamp_ms, ev->sample_index);
+    if (err > e->max_stamp_err_ms) e->max_stamp_err_ms = err;
+}
+
+static void on_sync(const wwv_sync_status_t *status, void *user_data) {
+    soak_events_t *e = (soak_events_t *)user_data;
+    if (e->was_synced && !status->is_synced) e->sync_losses++;
+    e->was_synced = status->is_synced;
+}
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t percentile(const uint64_t *sorted, size_t n, double p) {
+    size_t k = (size_t)(p * (double)(n - 1) + 0.5);
+    return sorted[k < n ? k : n - 1];
+}
+
+/*============================================================================
+ * Regression Checks
+ *============================================================================*/
+
+static bool check_interval(const soak_options_t *opt, const soak_interval_t *base,
+                           soak_interval_t *iv, int index) {
+    bool ok = true;
+#define SOAK_FAIL(...) do { \
+        fprintf(stderr, "[SOAK] Interval %d at %.2f h: ", index, iv->end_hours); \
+        fprintf(stderr, __VA_ARGS__); \
+        fputc('\n', stderr); \
+        ok = false; \
+    } while (0)
+
+    if (base->rss_kb > 0.0 && iv->rss_kb - base->rss_kb > opt->max_rss_growth_kb) {
+        SOAK_FAIL("RSS grew %.0f KiB past the baseline", iv->rss_kb - base->rss_kb);
+    }
+    if (bench_alloc_available() && iv->live_heap - base->live_heap > opt->max_heap_growth) {
+        SOAK_FAIL("%ld more live heap blocks than the baseline", iv->live_heap - base->live_heap);
+    }
+    if (iv->mean_ns_per_sample > base->mean_ns_per_sample * opt->max_mean_ratio) {
+        SOAK_FAIL("%.1f ns/sample against %.1f", iv->mean_ns_per_sample, base->mean_ns_per_sample);
+    }
+    if ((double)iv->p99_ns > (double)base->p99_ns * opt->max_p99_ratio) {
+        SOAK_FAIL("p99 %llu ns against %llu", (unsigned long long)iv->p99_ns,
+                  (unsigned long long)base->p99_ns);
+    }
+    if (iv->ticks < iv->expected_ticks * opt->min_event_ratio ||
+        iv->markers < iv->expected_markers * opt->min_event_ratio) {
+        SOAK_FAIL("%d ticks / %d markers from a broadcast of %d / %d", iv->ticks, iv->markers,
+                  iv->expected_ticks, iv->expected_markers);
+    }
+    if (iv->ticks > iv->expected_ticks + 1 || iv->markers > iv->expected_markers + 1) {
+        SOAK_FAIL("%d ticks / %d markers from a broadcast of %d / %d", iv->ticks, iv->markers,
+                  iv->expected_ticks, iv->expected_markers);
+    }
+    if (fabs(iv->phase_ms - base->phase_ms) > opt->max_phase_drift_ms) {
+        SOAK_FAIL("tick phase %.3f ms against %.3f", iv->phase_ms, base->phase_ms);
+    }
+    if (iv->max_stamp_err_ms > 1000.0 / SOAK_DETECTOR_RATE) {
+        SOAK_FAIL("event timestamp %.4f ms off its sample index", iv->max_stamp_err_ms);
+    }
+#undef SOAK_FAIL
+    iv->failed = !ok;
+    return ok;
+}
+
+/*============================================================================
+ * Output
+ *============================================================================*/
+
+static void print_interval(const soak_interval_t *iv, int index) {
+    fprintf(stderr,
+            "[SOAK] %3d %7.2f h  rss %8.0f KiB  heap %+5ld  log %9llu B  %6.1f ns/sample  "
+            "p50 %7llu  p99 %7llu  p99.9 %7llu  max %8llu ns  ticks %4d/%4d  markers %3d/%3d  "
+            "phase %+7.3f (iqr %.3f) ms  stamp %.4f ms  losses %d%s%s\n",
+            index, iv->end_hours, iv->rss_kb, iv->live_heap, (unsigned long long)iv->log_bytes,
+            iv->mean_ns_per_sample, (unsigned long long)iv->p50_ns, (unsigned long long)iv->p99_ns,
+            (unsigned long long)iv->p999_ns, (unsigned long long)iv->max_ns, iv->ticks,
+            iv->expected_ticks, iv->markers, iv->expected_markers, iv->phase_ms,
+            iv->phase_spread_ms, iv->max_stamp_err_ms, iv->sync_losses,
+            index == 0 ? "  (acquire)" : index == 1 ? "  (baseline)" : "",
+            iv->failed ? "  FAIL" : "");
+}
+
+static void write_json(FILE *f, const soak_options_t *opt, const soak_interval_t *iv, int n,
+                       double wall_sec, bool passed) {
+    fprintf(f, "{\n");
+    fprintf(f, "  \"benchmark\": \"wwv_soak\",\n");
+    fprintf(f, "  \"schema\": 1,\n");
+    fprintf(f, "  \"version\": \"%s\",\n", PHOENIX_VERSION_FULL);
+    fprintf(f, "  \"label\": \"%s\",\n", opt->label);
+    fprintf(f, "  \"hours\": %.3f,\n", opt->hours);
+    fprintf(f, "  \"interval_min\": %.2f,\n", opt->interval_min);
+    fprintf(f, "  \"speed\": %.1f,\n", opt->speed);
+    fprintf(f, "  \"block\": %zu,\n", opt->block);
+    fprintf(f, "  \"snr_db\": %.2f,\n", opt->synth.snr_db);
+    fprintf(f, "  \"wall_sec\": %.2f,\n", wall_sec);
+    fprintf(f, "  \"realtime_factor\": %.1f,\n", wall_sec > 0.0 ? opt->hours * 3600.0 / wall_sec : 0.0);
+    fprintf(f, "  \"heap_counted\": %s,\n", bench_alloc_available() ? "true" : "false");
+    fprintf(f, "  \"passed\": %s,\n", passed ? "true" : "false");
+    fprintf(f, "  \"intervals\": [");
+    for (int k = 0; k < n; k++) {
+        const soak_interval_t *v = &iv[k];
+        fprintf(f, "%s\n    { \"hours\": %.3f, \"rss_kb\": %.0f, \"live_heap\": %ld, "
+                   "\"log_bytes\": %llu, \"ns_per_sample\": %.2f, \"p50_ns\": %llu, "
+                   "\"p99_ns\": %llu, \"p999_ns\": %llu, \"max_ns\": %llu, \"ticks\": %d, "
+                   "\"expected_ticks\": %d, \"markers\": %d, \"expected_markers\": %d, "
+                   "\"phase_ms\": %.4f, \"phase_spread_ms\": %.4f, \"max_stamp_err_ms\": %.5f, "
+                   "\"sync_losses\": %d, \"synced\": %s, \"failed\": %s }",
+                k ? "," : "", v->end_hours, v->rss_kb, v->live_heap,
+                (unsigned long long)v->log_bytes, v->mean_ns_per_sample,
+                (unsigned long long)v->p50_ns, (unsigned long long)v->p99_ns,
+                (unsigned long long)v->p999_ns, (unsigned long long)v->max_ns, v->ticks,
+                v->expected_ticks, v->markers, v->expected_markers, v->phase_ms,
+                v->phase_spread_ms, v->max_stamp_err_ms, v->sync_losses,
+                v->synced ? "true" : "false", v->failed ? "true" : "false");
+    }
+    fprintf(f, "\n  ]\n}\n");
+}
+
+/*============================================================================
+ * Soak Loop
+ *============================================================================*/
+
+typedef struct {
+    wwv_synth_t *det, *disp;
+    float *det_i, *det_q, *disp_i, *disp_q;
+} soak_source_t;
+
+static bool source_open(soak_source_t *src, const soak_options_t *opt, size_t disp_block) {
+    memset(src, 0, sizeof(*src));
+    wwv_synth_config_t cfg = opt->synth;
+    cfg.sample_rate = SOAK_DETECTOR_RATE;
+    src->det = wwv_synth_create(&cfg);
+    cfg.sample_rate = SOAK_DISPLAY_RATE;
+    cfg.seed = opt->synth.seed + 1;
+    src->disp = wwv_synth_create(&cfg);
+    src->det_i = malloc(opt->block * sizeof(float));
+    src->det_q = malloc(opt->block * sizeof(float));
+    src->disp_i = malloc(disp_block * sizeof(float));
+    src->disp_q = malloc(disp_block * sizeof(float));
+    return src->det && src->disp && src->det_i && src->det_q && src->disp_i && src->disp_q;
+}
+
+static void source_close(soak_source_t *src) {
+    wwv_synth_destroy(src->det);
+    wwv_synth_destroy(src->disp);
+    free(src->det_i);
+    free(src->det_q);
+    free(src->disp_i);
+    free(src->disp_q);
+}
+
+/* Broadcast events in seconds [first, first + count): no ticks at :29/:59 */
+static void expected_events(long first, long count, int *ticks, int *markers) {
+    *ticks = *markers = 0;
+    for (long sec = first; sec < first + count; sec++) {
+        int s = (int)(sec % 60);
+        if (s == 0) (*markers)++;
+        else if (s != 29 && s != 59) (*ticks)++;
+    }
+}
+
+static bool run_soak(const soak_options_t *opt, soak_interval_t **out, int *out_n, double *wall_sec) {
+    size_t disp_block = opt->block * SOAK_DISPLAY_RATE / SOAK_DETECTOR_RATE;
+    long interval_sec = (long)(opt->interval_min * 60.0);
+    int intervals = (int)(opt->hours * 3600.0 / interval_sec);
+    size_t blocks_per_sec = SOAK_DETECTOR_RATE / opt->block;
+    size_t blocks = (size_t)interval_sec * blocks_per_sec;
+
+    soak_source_t src;
+    soak_interval_t *iv = calloc((size_t)intervals, sizeof(soak_interval_t));
+    uint64_t *lat = malloc(blocks * sizeof(uint64_t));
+    double *phase = malloc((size_t)interval_sec * 2 * sizeof(double));
+    if (!source_open(&src, opt, disp_block) || !iv || !lat || !phase) {
+        source_close(&src);
+        free(iv);
+        free(lat);
+        free(phase);
+        return false;
+    }
+
+    wwv_detector_config_t config = WWV_DETECTOR_CONFIG_DEFAULT;
+    config.output_dir = opt->log_dir;
+
+    bench_alloc_stats_t a0 = bench_alloc_snapshot();
+    wwv_detector_manager_t *mgr = wwv_detector_manager_create(&config);
+    if (!mgr) {
+        source_close(&src);
+        free(iv);
+        free(lat);
+        free(phase);
+        return false;
+    }
+
+    /* Room for a tick every second, twice over */
+    soak_events_t ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.phase = phase;
+    ev.phase_cap = (int)interval_sec * 2;
+    wwv_detector_manager_set_tick_callback(mgr, on_tick, &ev);
+    wwv_detector_manager_set_marker_callback(mgr, on_marker, &ev);
+    wwv_detector_manager_set_sync_callback(mgr, on_sync, &ev);
+
+    bool passed = true;
+    uint64_t log_start = soak_dir_bytes(opt->log_dir);
+    double sim_sec_per_block = (double)opt->block / SOAK_DETECTOR_RATE;
+    uint64_t start_ns = soak_now_ns();
+    uint64_t blocks_done = 0;
+
+    for (int k = 0; k < intervals; k++) {
+        uint64_t busy_ns = 0;
+        ev.ticks = ev.markers = ev.phase_n = ev.sync_losses = 0;
+        ev.max_stamp_err_ms = 0.0;
+
+        for (size_t b = 0; b < blocks; b++) {
+            wwv_synth_generate(src.det, src.det_i, src.det_q, opt->block);
+            wwv_synth_generate(src.disp, src.disp_i, src.disp_q, disp_block);
+
+            uint64_t t0 = soak_now_ns();
+            wwv_detector_manager_process_detector_block(mgr, src.det_i, src.det_q, opt->block);
+            wwv_detector_manager_process_display_block(mgr, src.disp_i, src.disp_q, disp_block);
+            lat[b] = soak_now_ns() - t0;
+            busy_ns += lat[b];
+            blocks_done++;
+
+            if (opt->speed > 0.0) {
+                uint64_t due = start_ns + (uint64_t)(blocks_done * sim_sec_per_block / opt->speed * 1e9);
+                uint64_t now = soak_now_ns();
+                if (due > now) soak_sleep_ns(due - now);
+            }
+        }
+
+        qsort(lat, blocks, sizeof(uint64_t), cmp_u64);
+        soak_interval_t *v = &iv[k];
+        bench_alloc_stats_t a = bench_alloc_snapshot();
+        v->end_hours = (double)(k + 1) * interval_sec / 3600.0;
+        v->rss_kb = soak_rss_kb();
+        v->live_heap = (long)((a.allocs - a0.allocs) - (a.frees - a0.frees));
+        v->log_bytes = soak_dir_bytes(opt->log_dir) - log_start;
+        v->mean_ns_per_sample = (double)busy_ns / ((double)blocks * (opt->block + disp_block));
+        v->p50_ns = percentile(lat, blocks, 0.50);
+        v->p99_ns = percentile(lat, blocks, 0.99);
+        v->p999_ns = percentile(lat, blocks, 0.999);
+        v->max_ns = lat[blocks - 1];
+        v->ticks = ev.ticks;
+        v->markers = ev.markers;
+        expected_events((long)k * interval_sec, interval_sec, &v->expected_ticks, &v->expected_markers);
+        if (ev.phase_n > 0) {
+            qsort(ev.phase, (size_t)ev.phase_n, sizeof(double), cmp_double);
+            v->phase_ms = ev.phase[ev.phase_n / 2];
+            v->phase_spread_ms = ev.phase[ev.phase_n * 3 / 4] - ev.phase[ev.phase_n / 4];
+        }
+        v->max_stamp_err_ms = ev.max_stamp_err_ms;
+        v->sync_losses = ev.sync_losses;
+        v->synced = wwv_detector_manager_get_sync_status(mgr).is_synced;
+
+        if (k >= 2 && !check_interval(opt, &iv[1], v, k)) passed = false;
+        print_interval(v, k);
+    }
+
+    *wall_sec = (soak_now_ns() - start_ns) * 1e-9;
+    wwv_detector_manager_destroy(mgr);
+    source_close(&src);
+    free(lat);
+    free(phase);
+
+    *out = iv;
+    *out_n = intervals;
+    return passed;
+}
+
+int main(int argc, char **argv) {
+    soak_options_t opt;
+    if (!parse_options(argc, argv, &opt)) return 2;
+
+    fprintf(stderr, "[SOAK] %.2f h of signal in %.0f-minute intervals, block %zu, %s\n",
+            opt.hours, opt.interval_min, opt.block,
+            opt.speed > 0.0 ? "paced" : "unpaced");
+
+    soak_interval_t *iv = NULL;
+    int n = 0;
+    double wall_sec = 0.0;
+    bool passed = run_soak(&opt, &iv, &n, &wall_sec);
+    if (!iv) {
+        fprintf(stderr, "[SOAK] Setup failed\n");
+        return 1;
+    }
+
+    if (opt.json_path) {
+        FILE *f = (strcmp(opt.json_path, "-") == 0) ? stdout : fopen(opt.json_path, "w");
+        if (!f) {
+            fprintf(stderr, "[SOAK] Cannot write %s\n", opt.json_path);
+            free(iv);
+            return 1;
+        }
+        write_json(f, &opt, iv, n, wall_sec, passed);
+        if (f != stdout) fclose(f);
+    }
+
+    fprintf(stderr, "[SOAK] %s: %.2f h in %.1f s (%.0fx real time)\n",
+            passed ? "PASS" : "FAIL", opt.hours, wall_sec,
+            wall_sec > 0.0 ? opt.hours * 3600.0 / wall_sec : 0.0);
+    free(iv);
+    return passed ? 0 : 1;
+}
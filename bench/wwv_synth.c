@@ -0,0 +1,232 @@
+/**
+ * @file wwv_synth.c
+ * @brief Synthetic WWV/WWVH baseband generator
+ */
+
+#include "wwv_synth.h"
+#include <stdlib.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define SYNTH_TICK_SEC          0.005   /* Seconds pulse length */
+#define SYNTH_MARKER_SEC        0.800   /* Minute/hour marker length */
+#define SYNTH_GUARD_START_SEC   0.030   /* Protection zone after the tick */
+#define SYNTH_GUARD_END_SEC     0.990   /* ...and 10 ms before the next */
+#define SYNTH_TONE_DEPTH        0.5f
+#define SYNTH_BCD_HIGH          0.5f
+#define SYNTH_BCD_LOW           0.089f  /* -15 dB below the high level */
+
+/* BCD pulse widths by symbol (0, 1, position marker) */
+static const double bcd_width_sec[3] = { 0.200, 0.500, 0.800 };
+
+struct wwv_synth {
+    wwv_synth_config_t cfg;
+    uint64_t position;
+    double noise_sigma;         /* Per component */
+    uint64_t rng;
+
+    /* Current minute's BCD frame (recomputed on minute change) */
+    int frame_minute;
+    signed char frame[60];
+};
+
+/*============================================================================
+ * Noise
+ *============================================================================*/
+
+static uint64_t rng_next(wwv_synth_t *s) {
+    /* xorshift64* */
+    s->rng ^= s->rng >> 12;
+    s->rng ^= s->rng << 25;
+    s->rng ^= s->rng >> 27;
+    return s->rng * 0x2545F4914F6CDD1DULL;
+}
+
+static double rng_uniform(wwv_synth_t *s) {
+    return ((rng_next(s) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+static void rng_gaussian_pair(wwv_synth_t *s, double *a, double *b) {
+    double r = sqrt(-2.0 * log(rng_uniform(s)));
+    double th = 2.0 * M_PI * rng_uniform(s);
+    *a = r * cos(th);
+    *b = r * sin(th);
+}
+
+/*============================================================================
+ * BCD Frame
+ *============================================================================*/
+
+static void set_bcd(signed char *frame, const int *secs, const int *weights, int n, int value) {
+    for (int k = n - 1; k >= 0; k--) {
+        if (value >= weights[k]) {
+            frame[secs[k]] = 1;
+            value -= weights[k];
+        }
+    }
+}
+
+/**
+ * WWV frame layout: position markers at :09 :19 ... :59, BCD fields
+ * least significant bit first
+ */
+static void build_frame(const wwv_synth_t *s, int minute_index, signed char *frame) {
+    int total = s->cfg.start_minute + minute_index;
+    int minute = total % 60;
+    int hours = s->cfg.start_hour + total / 60;
+    int hour = hours % 24;
+    int day = (s->cfg.start_day - 1 + hours / 24) % 365 + 1;
+    int year = s->cfg.year % 100;
+
+    for (int k = 0; k < 60; k++) frame[k] = 0;
+    frame[0] = -1;
+    for (int k = 9; k < 60; k += 10) frame[k] = 2;
+
+    static const int yr_u[4] = { 4, 5, 6, 7 },      yr_u_w[4] = { 1, 2, 4, 8 };
+    static const int min_u[4] = { 10, 11, 12, 13 }, min_u_w[4] = { 1, 2, 4, 8 };
+    static const int min_t[3] = { 15, 16, 17 },     min_t_w[3] = { 10, 20, 40 };
+    static const int hr_u[4] = { 20, 21, 22, 23 },  hr_u_w[4] = { 1, 2, 4, 8 };
+    static const int hr_t[2] = { 25, 26 },          hr_t_w[2] = { 10, 20 };
+    static const int day_u[4] = { 30, 31, 32, 33 }, day_u_w[4] = { 1, 2, 4, 8 };
+    static const int day_t[4] = { 35, 36, 37, 38 }, day_t_w[4] = { 10, 20, 40, 80 };
+    static const int day_h[2] = { 40, 41 },         day_h_w[2] = { 100, 200 };
+    static const int yr_t[4] = { 51, 52, 53, 54 },  yr_t_w[4] = { 10, 20, 40, 80 };
+
+    set_bcd(frame, yr_u, yr_u_w, 4, year % 10);
+    set_bcd(frame, min_u, min_u_w, 4, minute % 10);
+    set_bcd(frame, min_t, min_t_w, 3, minute - minute % 10);
+    set_bcd(frame, hr_u, hr_u_w, 4, hour % 10);
+    set_bcd(frame, hr_t, hr_t_w, 2, hour - hour % 10);
+    set_bcd(frame, day_u, day_u_w, 4, day % 10);
+    set_bcd(frame, day_t, day_t_w, 4, (day % 100) - day % 10);
+    set_bcd(frame, day_h, day_h_w, 2, day - day % 100);
+    set_bcd(frame, yr_t, yr_t_w, 4, year - year % 10);
+
+    /* Leap second warning */
+    if (minute_index <= s->cfg.leap_minute) frame[3] = 1;
+}
+
+/*============================================================================
+ * Modulation
+ *============================================================================*/
+
+static float modulation(wwv_synth_t *s, double t) {
+    const bool wwvh = (s->cfg.station == WWV_SYNTH_WWVH);
+    double whole = floor(t);
+    double frac = t - whole;
+    long sec_total = (long)whole;
+    long leap_sec = (s->cfg.leap_minute >= 0) ? 60L * (s->cfg.leap_minute + 1) : -1;
+    if (leap_sec >= 0 && sec_total > leap_sec) sec_total--;
+    int minute_index = (int)(sec_total / 60);
+    int second = (int)(sec_total % 60);
+    if (leap_sec >= 0 && (long)whole == leap_sec) {
+        minute_index = s->cfg.leap_minute;
+        second = 60;
+    }
+    int minute = (s->cfg.start_minute + minute_index) % 60;
+
+    if (minute_index != s->frame_minute) {
+        build_frame(s, minute_index, s->frame);
+        s->frame_minute = minute_index;
+    }
+
+    /* Ticks and markers (100%), nothing else inside them */
+    if (second == 0) {
+        if (frac < SYNTH_MARKER_SEC) {
+            double hz = (minute == 0) ? 1500.0 : (wwvh ? 1200.0 : 1000.0);
+            return (float)sin(2.0 * M_PI * hz * frac);
+        }
+    } else if (frac < SYNTH_TICK_SEC) {
+        if (second == 29 || second == 59) return 0.0f;
+        return (float)sin(2.0 * M_PI * (wwvh ? 1200.0 : 1000.0) * frac);
+    }
+    if (frac < SYNTH_GUARD_START_SEC || frac >= SYNTH_GUARD_END_SEC) return 0.0f;
+
+    float m = 0.0f;
+
+    /* Tones: WWV 600 Hz on odd minutes, WWVH the opposite */
+    if (second != 0) {
+        bool odd = (minute & 1) != 0;
+        double hz = (odd != wwvh) ? 600.0 : 500.0;
+        m += SYNTH_TONE_DEPTH * (float)sin(2.0 * M_PI * hz * t);
+    }
+
+    /* BCD on 100 Hz: high level for the symbol width, low level after
+     * (none in a leap second) */
+    int sym = (second < 60) ? s->frame[second] : -1;
+    float level = (sym >= 0 && frac < bcd_width_sec[sym]) ? SYNTH_BCD_HIGH : SYNTH_BCD_LOW;
+    m += level * (float)sin(2.0 * M_PI * 100.0 * t);
+
+    return m;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+wwv_synth_t *wwv_synth_create(const wwv_synth_config_t *config) {
+    if (!config || config->sample_rate <= 0.0) return NULL;
+
+    wwv_synth_t *s = (wwv_synth_t *)calloc(1, sizeof(wwv_synth_t));
+    if (!s) return NULL;
+
+    s->cfg = *config;
+    s->frame_minute = -1;
+    s->rng = config->seed ? config->seed : 0x9E3779B97F4A7C15ULL;
+
+    if (config->snr_db < 200.0f) {
+        double carrier = (double)config->carrier_amplitude * config->carrier_amplitude;
+        double noise = carrier * pow(10.0, -config->snr_db / 10.0) *
+                       (config->sample_rate / WWV_SYNTH_SNR_BANDWIDTH_HZ);
+        s->noise_sigma = sqrt(noise / 2.0);
+    }
+    return s;
+}
+
+void wwv_synth_destroy(wwv_synth_t *s) {
+    free(s);
+}
+
+void wwv_synth_generate(wwv_synth_t *s, float *i_out, float *q_out, size_t count) {
+    if (!s || !i_out || !q_out) return;
+
+    const double fs = s->cfg.sample_rate;
+    const double depth = s->cfg.fade_depth_db;
+
+    for (size_t k = 0; k < count; k++) {
+        double t = (double)(s->position + k) / fs + s->cfg.start_offset_sec;
+        double env = s->cfg.carrier_amplitude * (1.0 + modulation(s, t));
+
+        if (s->cfg.fade_rate_hz > 0.0f && depth > 0.0) {
+            double fade_db = -depth * 0.5 * (1.0 - cos(2.0 * M_PI * s->cfg.fade_rate_hz * t));
+            env *= pow(10.0, fade_db / 20.0);
+        }
+
+        double ph = 2.0 * M_PI * s->cfg.doppler_hz * t;
+        double re = env * cos(ph), im = env * sin(ph);
+
+        if (s->noise_sigma > 0.0) {
+            double ni, nq;
+            rng_gaussian_pair(s, &ni, &nq);
+            re += s->noise_sigma * ni;
+            im += s->noise_sigma * nq;
+        }
+        i_out[k] = (float)re;
+        q_out[k] = (float)im;
+    }
+    s->position += count;
+}
+
+uint64_t wwv_synth_get_position(const wwv_synth_t *s) {
+    return s ? s->position : 0;
+}
+
+int wwv_synth_bcd_symbol(const wwv_synth_t *s, int minute_index, int second) {
+    if (!s || second < 0 || second >= 60 || minute_index < 0) return -1;
+    signed char frame[60];
+    build_frame(s, minute_index, frame);
+    return frame[second];
+}
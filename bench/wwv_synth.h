@@ -0,0 +1,105 @@
+/**
+ * @file wwv_synth.h
+ * @brief Synthetic WWV/WWVH baseband I/Q generator for benchmarks and tests
+ *
+ * Produces the complex baseband a receiver tuned to the carrier would see:
+ * the DSB-AM envelope (1 + m(t)) on a DC carrier, shifted by a Doppler
+ * offset, scaled by a slow fade and buried in complex white noise.
+ *
+ * m(t) follows the broadcast format in docs/wwv_signal_characteristics.md:
+ *   - 5 ms seconds ticks at 100% (1000 Hz WWV, 1200 Hz WWVH), none at :29/:59
+ *   - 800 ms minute marker at second 0 (1500 Hz at the top of the hour)
+ *   - 500/600 Hz tones at 50%, alternating by minute, outside the 40 ms
+ *     tick protection zone
+ *   - BCD time code on the 100 Hz subcarrier: 200/500/800 ms high-level
+ *     pulses (0/1/position marker) over a -15 dB low level
+ *   - optionally a positive leap second: a ticked second :60 at the end of
+ *     one minute, announced by the leap second warning bit (:03) up to it
+ * Voice, 440 Hz minutes and doubled UT1 ticks are not modeled.
+ *
+ * The signal is a pure function of the sample index, so generators at
+ * different rates (50 kHz detector path, 12 kHz display path) with the same
+ * config describe the same broadcast; only their noise streams differ.
+ */
+
+#ifndef WWV_SYNTH_H
+#define WWV_SYNTH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* SNR is carrier power over noise power in this bandwidth, so the noise
+ * density (and therefore every detector's SNR) is rate independent */
+#define WWV_SYNTH_SNR_BANDWIDTH_HZ  10000.0
+
+typedef enum {
+    WWV_SYNTH_WWV = 0,
+    WWV_SYNTH_WWVH
+} wwv_synth_station_t;
+
+typedef struct {
+    wwv_synth_station_t station;
+    double sample_rate;
+    float carrier_amplitude;    /* Unmodulated carrier level */
+    float snr_db;               /* See WWV_SYNTH_SNR_BANDWIDTH_HZ; >= 200 = no noise */
+    float doppler_hz;           /* Carrier (and sideband) offset */
+    float fade_rate_hz;         /* Sinusoidal fade cycle rate, 0 = none */
+    float fade_depth_db;        /* Peak-to-trough fade depth */
+    double start_offset_sec;    /* Broadcast time at sample 0, seconds into the minute */
+    int start_minute;           /* UTC time of the first minute (encoded in BCD) */
+    int start_hour;
+    int start_day;              /* Day of year 1-366 */
+    int year;                   /* 2-digit year */
+    int leap_minute;            /* Minute index ending in a leap second :60, -1 = none */
+    uint64_t seed;              /* Noise seed */
+} wwv_synth_config_t;
+
+#define WWV_SYNTH_CONFIG_DEFAULT { \
+    .station = WWV_SYNTH_WWV, \
+    .sample_rate = 50000.0, \
+    .carrier_amplitude = 0.5f, \
+    .snr_db = 30.0f, \
+    .doppler_hz = 0.0f, \
+    .fade_rate_hz = 0.0f, \
+    .fade_depth_db = 0.0f, \
+    .start_offset_sec = 0.0, \
+    .start_minute = 0, \
+    .start_hour = 12, \
+    .start_day = 1, \
+    .year = 25, \
+    .leap_minute = -1, \
+    .seed = 1 \
+}
+
+typedef struct wwv_synth wwv_synth_t;
+
+wwv_synth_t *wwv_synth_create(const wwv_synth_config_t *config);
+void wwv_synth_destroy(wwv_synth_t *s);
+
+/**
+ * Generate the next count samples (planar I/Q)
+ */
+void wwv_synth_generate(wwv_synth_t *s, float *i_out, float *q_out, size_t count);
+
+/**
+ * Samples generated so far
+ */
+uint64_t wwv_synth_get_position(const wwv_synth_t *s);
+
+/**
+ * Expected symbol for a second of the minute: 0, 1 or 2 (position
+ * marker), or -1 for second 0 (no pulse) and a leap second :60
+ * @param minute_index Minutes since the start (0 = start_minute)
+ */
+int wwv_synth_bcd_symbol(const wwv_synth_t *s, int minute_index, int second);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_SYNTH_H */
@@ -0,0 +1,83 @@
+/**
+ * @file baseband_frontend.h
+ * @brief Complex-baseband tick / marker front end (50 kHz -> 3125 Hz)
+ *
+ * The tick and marker detectors only look at 1000 / 1200 Hz +/- a couple
+ * of hundred Hz. This stage brings both sidebands of that region down to
+ * DC and decimates by 16, so the detectors run on 3125 Hz streams with
+ * 16-point FFTs and 16-tap templates:
+ *
+ *   50 kHz ──/4──► 12.5 kHz ──×NCO──► upper ──/4──► 3125 Hz
+ *                                └──► lower ──/4──► 3125 Hz
+ *
+ * The NCO sits on BASEBAND_MIX_HZ, the centre of bin 5 of the 50 kHz
+ * 256-point tick FFT, so a 16-sample baseband frame spans the same 5.12 ms
+ * and has the same 195.3 Hz bins, shifted down by BASEBAND_MIX_BIN. The
+ * lower stream is the mirror image (conj(x) mixed the same way), so both
+ * sidebands land on the same bins, as the full-rate FFT bands sum them.
+ * The filters have unity passband gain, so FFT band energies keep the
+ * full-rate scale and thresholds carry over.
+ *
+ * The first outputs are dropped so that baseband sample k stands for
+ * input sample BASEBAND_DECIMATION * k + BASEBAND_SAMPLE_OFFSET (group
+ * delay included): frame f of the baseband detectors covers the same
+ * input samples as frame f at 50 kHz, to 0.1 ms.
+ */
+
+#ifndef BASEBAND_FRONTEND_H
+#define BASEBAND_FRONTEND_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BASEBAND_INPUT_RATE     50000   /* Detector path rate */
+#define BASEBAND_DECIMATION     16
+#define BASEBAND_RATE           (BASEBAND_INPUT_RATE / BASEBAND_DECIMATION)    /* 3125 Hz */
+#define BASEBAND_MIX_BIN        5       /* 50 kHz, 256-point FFT bin mixed to DC */
+#define BASEBAND_MIX_HZ         (BASEBAND_MIX_BIN * (float)BASEBAND_INPUT_RATE / 256.0f)  /* 976.5625 Hz */
+#define BASEBAND_SAMPLE_OFFSET  2.5     /* Input sample baseband sample 0 stands for */
+#define BASEBAND_CHUNK          5000    /* Input samples per pass (100 ms) */
+
+/**
+ * One pass of output, both streams at BASEBAND_RATE
+ */
+typedef struct {
+    const float *upper_i;       /* x * e^{-j*mix*t}: +mix lands on DC */
+    const float *upper_q;
+    const float *lower_i;       /* conj(x) * e^{-j*mix*t}: -mix lands on DC */
+    const float *lower_q;
+    size_t count;
+} baseband_block_t;
+
+typedef void (*baseband_sink_fn)(const baseband_block_t *block, void *user_data);
+
+typedef struct baseband_frontend baseband_frontend_t;
+
+baseband_frontend_t *baseband_frontend_create(void);
+void baseband_frontend_destroy(baseband_frontend_t *fe);
+
+/**
+ * Receive every block produced (NULL disconnects)
+ */
+void baseband_frontend_set_sink(baseband_frontend_t *fe, baseband_sink_fn sink, void *user_data);
+
+/**
+ * Feed 50 kHz I/Q; the sink is called once per BASEBAND_CHUNK piece that
+ * produced output (a single sample produces one every 16th call)
+ */
+void baseband_frontend_process(baseband_frontend_t *fe, const float *i_samples,
+                               const float *q_samples, size_t count);
+
+/**
+ * Clear filter history, NCO phase and the start-up drop
+ */
+void baseband_frontend_reset(baseband_frontend_t *fe);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BASEBAND_FRONTEND_H */
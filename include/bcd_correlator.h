@@ -22,6 +22,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include "telemetry.h"
+#include "wwv_timer_wheel.h"
 
 /* Forward declaration */
 typedef struct sync_detector sync_detector_t;
@@ -34,6 +36,8 @@ extern "C" {
  * Configuration
  *============================================================================*/
 
+#define BCD_INTEG_MAX_MINUTES       15      /* Longest multi-minute integration */
+
 /* Symbol width thresholds (milliseconds) */
 #define BCD_SYMBOL_ZERO_MAX_MS      350.0f  /* 100-350ms = binary 0 */
 #define BCD_SYMBOL_ONE_MAX_MS       650.0f  /* 350-650ms = binary 1 */
@@ -61,12 +65,28 @@ typedef enum {
 /* Symbol event for callback */
 typedef struct {
     bcd_corr_symbol_t symbol;
-    float timestamp_ms;
+    double timestamp_ms;
+    uint64_t sample_index;      /* 50 kHz input sample at timestamp_ms (window centre) */
     float duration_ms;
     float confidence;           /* 0-1, higher if both detectors contributed */
     const char *source;         /* "BOTH", "TIME", "FREQ", or "NONE" */
+    int second;                 /* Second of minute (0-59) of the window */
+    float log_likelihood[3];    /* ZERO, ONE, MARKER (bcd_corr_symbol_t order), best = 0;
+                                 * all 0 = no information (no events) */
 } bcd_symbol_event_t;
 
+/* Frame decoded from several minutes of averaged envelope (integration) */
+typedef struct {
+    int year;                   /* 2-digit year */
+    int day;                    /* Day of year */
+    int hour;                   /* UTC */
+    int minute;
+    double minute_start_ms;     /* Leading edge of the :00 marker pulse (100 ms bins) */
+    int minutes_used;           /* Rows averaged */
+    float margin;               /* Weakest field, best vs runner-up (noise sigmas) */
+    char symbols[61];           /* Averaged frame, '0'/'1'/'P' from :00 */
+} bcd_integrated_frame_t;
+
 typedef void (*bcd_corr_symbol_callback_fn)(const bcd_symbol_event_t *event, void *user_data);
 
 /* Opaque handle */
@@ -96,6 +116,16 @@ void bcd_correlator_destroy(bcd_correlator_t *corr);
  */
 void bcd_correlator_set_sync_source(bcd_correlator_t *corr, sync_detector_t *sync);
 
+/**
+ * Close windows on a timer instead of on the next event
+ * Without one, a window's symbol is emitted only when an event for a later
+ * second arrives. With one, each window closes WINDOW_CLOSE_GRACE_MS after
+ * its second ends (events carry their pulse's leading-edge time but are
+ * reported at the trailing edge), and late events for a closed window are
+ * dropped. The wheel's clock must be the one event timestamps use.
+ */
+void bcd_correlator_set_timer_wheel(bcd_correlator_t *corr, wwv_timer_wheel_t *wheel);
+
 /**
  * Set callback for confirmed symbol events
  */
@@ -103,6 +133,28 @@ void bcd_correlator_set_callback(bcd_correlator_t *corr,
                                  bcd_corr_symbol_callback_fn callback,
                                  void *user_data);
 
+/**
+ * Average the 100 Hz envelope over several minutes before decoding
+ * Each detector pulse adds its coverage to a 60-second-by-N ring aligned
+ * on the minute anchor; once per minute the averaged frame is decoded,
+ * with the minute field solved as advancing one per row. Slow but sure
+ * under weak signal: noise falls with every minute added.
+ * @param minutes Rows (1-BCD_INTEG_MAX_MINUTES), 0 = off
+ * @return false if the ring could not be allocated
+ */
+bool bcd_correlator_set_integration(bcd_correlator_t *corr, int minutes);
+
+/**
+ * Latest frame decoded from the integration
+ * @return false before the first one (or with integration off)
+ */
+bool bcd_correlator_get_integrated_frame(bcd_correlator_t *corr, bcd_integrated_frame_t *out);
+
+/**
+ * Route UDP telemetry to a context (NULL = default context)
+ */
+void bcd_correlator_set_telemetry(bcd_correlator_t *corr, telem_ctx_t *ctx);
+
 /**
  * Report pulse from time detector
  * Event is accumulated into current 1-second window
@@ -112,7 +164,7 @@ void bcd_correlator_set_callback(bcd_correlator_t *corr,
  * @param peak_energy  Peak energy during pulse
  */
 void bcd_correlator_time_event(bcd_correlator_t *corr,
-                               float timestamp_ms,
+                               double timestamp_ms,
                                float duration_ms,
                                float peak_energy);
 
@@ -125,7 +177,7 @@ void bcd_correlator_time_event(bcd_correlator_t *corr,
  * @param accum_energy    Accumulated energy
  */
 void bcd_correlator_freq_event(bcd_correlator_t *corr,
-                               float timestamp_ms,
+                               double timestamp_ms,
                                float duration_ms,
                                float accum_energy);
 
@@ -147,7 +199,7 @@ char bcd_corr_symbol_char(bcd_corr_symbol_t sym);
 /**
  * Get timestamp of last emitted symbol
  */
-float bcd_correlator_get_last_symbol_ms(bcd_correlator_t *corr);
+double bcd_correlator_get_last_symbol_ms(bcd_correlator_t *corr);
 
 /**
  * Get count of emitted symbols
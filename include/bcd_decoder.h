@@ -59,7 +59,7 @@ typedef enum {
 
 /** Callback for symbol events */
 typedef void (*bcd_symbol_callback_fn)(bcd_symbol_t symbol,
-                                       float timestamp_ms,
+                                       double timestamp_ms,
                                        float pulse_width_ms,
                                        void *user_data);
 
@@ -91,7 +91,7 @@ void bcd_decoder_destroy(bcd_decoder_t *dec);
  * @param status        Subcarrier status
  */
 void bcd_decoder_process_sample(bcd_decoder_t *dec,
-                                float timestamp_ms,
+                                double timestamp_ms,
                                 float envelope,
                                 float snr_db,
                                 bcd_status_t status);
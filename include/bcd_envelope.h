@@ -81,7 +81,7 @@ typedef enum {
  *============================================================================*/
 
 typedef struct {
-    float timestamp_ms;         /* Time since start */
+    double timestamp_ms;        /* Time since start */
     float envelope;             /* Smoothed 100 Hz magnitude (linear) */
     float envelope_db;          /* Magnitude in dB */
     float noise_floor_db;       /* Current noise estimate */
@@ -14,6 +14,14 @@
  *   - Self-tracking baseline (proven reliable approach)
  *   - Designed to run in parallel with bcd_time_detector
  *   - Works with bcd_correlator for dual-path symbol confirmation
+ *
+ * Sliding mode (bcd_freq_detector_create_sliding): the input is decimated
+ * by BCD_FREQ_SLIDING_DECIM to 1562.5 Hz, where a BCD_FREQ_SLIDING_SIZE
+ * point window spans the same 40.96 ms with the same 24.4 Hz bins, and a
+ * sliding DFT (sliding_dft.h) updates the 100 Hz bins every decimated
+ * sample. The state machine then steps every 0.64 ms instead of every
+ * 40.96 ms, so pulse starts and widths are resolved to 0.64 ms. Energies,
+ * thresholds and warm-start state keep the FFT mode's scale.
  */
 
 #ifndef BCD_FREQ_DETECTOR_H
@@ -21,7 +29,11 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
+#include "telemetry.h"
+#include "wwv_perf.h"
+#include "wwv_state.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -41,6 +53,14 @@ extern "C" {
 #define BCD_FREQ_PULSE_MIN_MS       100.0f  /* Minimum valid pulse */
 #define BCD_FREQ_PULSE_MAX_MS       1000.0f /* Maximum valid pulse */
 
+/* Sliding mode */
+#define BCD_FREQ_SLIDING_DECIM      32      /* 50 kHz -> 1562.5 Hz */
+#define BCD_FREQ_SLIDING_SIZE       (BCD_FREQ_FFT_SIZE / BCD_FREQ_SLIDING_DECIM)   /* 64 */
+#define BCD_FREQ_SLIDING_HOPS       BCD_FREQ_SLIDING_SIZE   /* Hops per FFT frame */
+
+/* Idle (bcd_freq_detector_set_idle) */
+#define BCD_FREQ_IDLE_DECIM         8       /* FFT frames per computed frame */
+
 /* Detection thresholds */
 #define BCD_FREQ_THRESHOLD_MULT     3.0f    /* Accumulated must be 3x baseline */
 #define BCD_FREQ_NOISE_ADAPT_RATE   0.001f  /* Slow baseline adaptation */
@@ -56,7 +76,8 @@ typedef struct bcd_freq_detector bcd_freq_detector_t;
  *============================================================================*/
 
 typedef struct {
-    float timestamp_ms;             /* When pulse started */
+    double timestamp_ms;            /* When pulse started */
+    uint64_t sample_index;          /* Input sample (BCD_FREQ_SAMPLE_RATE) at timestamp_ms */
     float duration_ms;              /* Pulse width */
     float accumulated_energy;       /* Energy accumulated during pulse */
     float baseline_energy;          /* Baseline at detection */
@@ -76,6 +97,13 @@ typedef void (*bcd_freq_callback_fn)(const bcd_freq_event_t *event, void *user_d
  */
 bcd_freq_detector_t *bcd_freq_detector_create(const char *csv_path);
 
+/**
+ * Create a detector in sliding mode (state machine every 0.64 ms)
+ * @param csv_path  Path for CSV log file (NULL to disable logging)
+ * @return          Detector instance or NULL on failure
+ */
+bcd_freq_detector_t *bcd_freq_detector_create_sliding(const char *csv_path);
+
 /**
  * Destroy a BCD frequency-domain detector instance
  */
@@ -91,9 +119,19 @@ void bcd_freq_detector_set_callback(bcd_freq_detector_t *fd,
                                     bcd_freq_callback_fn callback,
                                     void *user_data);
 
+/**
+ * Route UDP telemetry to a context (NULL = default context)
+ */
+void bcd_freq_detector_set_telemetry(bcd_freq_detector_t *fd, telem_ctx_t *ctx);
+
+/**
+ * Time FFT and state machine stages (and CSV rows) into perf (NULL = off)
+ */
+void bcd_freq_detector_set_perf(bcd_freq_detector_t *fd, wwv_perf_t *perf);
+
 /**
  * Feed I/Q samples to detector
- * Detector buffers internally and runs FFT when ready
+ * Detector buffers internally and runs FFT (or decimator) when ready
  * @param fd        Detector instance
  * @param i_sample  In-phase sample
  * @param q_sample  Quadrature sample
@@ -103,12 +141,49 @@ bool bcd_freq_detector_process_sample(bcd_freq_detector_t *fd,
                                       float i_sample,
                                       float q_sample);
 
+/**
+ * Feed a block of I/Q samples to detector
+ * Equivalent to per-sample calls, one FFT-frame chunk at a time
+ * @param fd        Detector instance
+ * @param i_samples In-phase samples
+ * @param q_samples Quadrature samples
+ * @param count     Number of samples in each array
+ * @return          Number of pulses detected within the block
+ */
+int bcd_freq_detector_process_block(bcd_freq_detector_t *fd,
+                                    const float *i_samples,
+                                    const float *q_samples,
+                                    size_t count);
+
 /**
  * Enable/disable detection
  */
 void bcd_freq_detector_set_enabled(bcd_freq_detector_t *fd, bool enabled);
 bool bcd_freq_detector_get_enabled(bcd_freq_detector_t *fd);
 
+/**
+ * Idle: reduce the FFT path to a baseline tracker
+ *
+ * While idle, one frame in BCD_FREQ_IDLE_DECIM runs the FFT and stands in
+ * for the frames around it, keeping the window and baseline current; no
+ * pulses are detected and a pulse in progress is dropped. One window
+ * after resuming, detection continues on the sample clock without a new
+ * warmup. No effect on the sliding detector, which has no frame FFT.
+ */
+void bcd_freq_detector_set_idle(bcd_freq_detector_t *fd, bool idle);
+bool bcd_freq_detector_get_idle(bcd_freq_detector_t *fd);
+
+/**
+ * Jump the stream ahead by samples not fed (duty-cycled sleep)
+ *
+ * Frame count advances as if the gap had been processed; the baseline is
+ * kept, a pulse in progress is dropped and, as on resuming from idle, the
+ * window turns over once before pulses are detected again. The sliding
+ * detector also restarts its decimator and DFT.
+ * @return false unless the gap starts and ends on a frame boundary
+ */
+bool bcd_freq_detector_skip(bcd_freq_detector_t *fd, uint64_t samples);
+
 /**
  * Get current state for display/debug
  */
@@ -118,6 +193,12 @@ float bcd_freq_detector_get_threshold(bcd_freq_detector_t *fd);
 float bcd_freq_detector_get_current_energy(bcd_freq_detector_t *fd);
 int bcd_freq_detector_get_pulse_count(bcd_freq_detector_t *fd);
 
+/**
+ * Frame FFTs run so far (0 for the sliding detector); idle runs one in
+ * BCD_FREQ_IDLE_DECIM
+ */
+uint64_t bcd_freq_detector_get_fft_count(bcd_freq_detector_t *fd);
+
 /**
  * Print statistics to stdout
  */
@@ -128,6 +209,18 @@ void bcd_freq_detector_print_stats(bcd_freq_detector_t *fd);
  */
 float bcd_freq_detector_get_frame_duration_ms(void);
 
+/**
+ * Time between energy updates: the frame duration, or 0.64 ms sliding
+ */
+float bcd_freq_detector_get_hop_ms(bcd_freq_detector_t *fd);
+
+/**
+ * Warm-start snapshot (wwv_state.h)
+ * Baseline and threshold; restore skips warmup (within WWV_STATE_LEVELS_MAX_AGE_MS)
+ */
+bool bcd_freq_detector_save_state(bcd_freq_detector_t *fd, wwv_state_writer_t *w);
+bool bcd_freq_detector_restore_state(bcd_freq_detector_t *fd, const wwv_state_reader_t *r);
+
 #ifdef __cplusplus
 }
 #endif
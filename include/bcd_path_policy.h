@@ -0,0 +1,131 @@
+/**
+ * @file bcd_path_policy.h
+ * @brief Adaptive BCD detector path selection
+ *
+ * The BCD subcarrier is found twice: by bcd_time_detector (256-point
+ * frames, 5.12 ms) and by bcd_freq_detector (2048-point frames, 41 ms).
+ * On a strong channel the time path alone finds every pulse, and the
+ * frequency path only confirms it. This policy watches both and idles the
+ * frequency path while that holds, restoring it as soon as it may matter:
+ *
+ *   DUAL -> TIME_ONLY   carrier SNR >= snr_high_db, time pulses at least
+ *                       min_time_rate per second and at least
+ *                       min_agreement of the freq pulses matched by a time
+ *                       pulse, continuously for hold_ms, and min_dwell_ms
+ *                       since the last switch
+ *   TIME_ONLY -> DUAL   carrier SNR < snr_low_db (or no SNR estimate),
+ *                       or time pulses below restore_time_rate per second
+ *
+ * The threshold gaps, the hold and the dwell keep a channel near the
+ * thresholds from switching back and forth. Rates and agreement are
+ * smoothed over a few evaluations, and the SNR is channel_quality's
+ * carrier estimate. Each switch is reported on TELEM_BCDS.
+ */
+
+#ifndef BCD_PATH_POLICY_H
+#define BCD_PATH_POLICY_H
+
+#include "telemetry.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+#define BCD_PATH_EVAL_MS            1000.0  /* Evaluation interval the manager uses */
+#define BCD_PATH_MATCH_MS           150.0   /* Time pulse within this of a freq pulse */
+
+typedef enum {
+    BCD_PATH_DUAL = 0,          /* Both detectors run */
+    BCD_PATH_TIME_ONLY          /* bcd_freq_detector idle */
+} bcd_path_mode_t;
+
+/* Why the current mode was chosen (telem_rec_bcd_path_t.reason) */
+typedef enum {
+    BCD_PATH_REASON_START = 0,  /* Initial DUAL */
+    BCD_PATH_REASON_STRONG,     /* SNR, time rate and agreement held high */
+    BCD_PATH_REASON_SNR_LOW,    /* SNR fell below snr_low_db */
+    BCD_PATH_REASON_NO_SNR,     /* SNR estimate lost */
+    BCD_PATH_REASON_TIME_RATE   /* Time path stopped finding pulses */
+} bcd_path_reason_t;
+
+typedef struct {
+    float snr_high_db;          /* Idle the freq path at or above */
+    float snr_low_db;           /* Restore it below */
+    float min_time_rate;        /* Time pulses/s needed to idle */
+    float restore_time_rate;    /* Time pulses/s below which to restore */
+    float min_agreement;        /* Matched fraction of freq pulses needed to idle */
+    double hold_ms;             /* Idle conditions must hold this long */
+    double min_dwell_ms;        /* No idling within this of the last switch */
+} bcd_path_policy_config_t;
+
+#define BCD_PATH_POLICY_CONFIG_DEFAULT { \
+    .snr_high_db = 22.0f, \
+    .snr_low_db = 16.0f, \
+    .min_time_rate = 0.75f, \
+    .restore_time_rate = 0.5f, \
+    .min_agreement = 0.9f, \
+    .hold_ms = 30000.0, \
+    .min_dwell_ms = 60000.0 \
+}
+
+typedef struct {
+    bcd_path_mode_t mode;
+    double mode_since_ms;       /* Stream time of the last switch */
+    float snr_db;               /* Last SNR given to update() */
+    bool snr_valid;
+    float time_rate;            /* Smoothed time pulses/s */
+    float agreement;            /* Smoothed matched fraction of freq pulses */
+    uint32_t switches;
+    uint32_t time_pulses;
+    uint32_t freq_pulses;
+    bcd_path_reason_t reason;
+} bcd_path_status_t;
+
+typedef struct bcd_path_policy bcd_path_policy_t;
+
+/*============================================================================
+ * API
+ *============================================================================*/
+
+/**
+ * @param config NULL = BCD_PATH_POLICY_CONFIG_DEFAULT
+ */
+bcd_path_policy_t *bcd_path_policy_create(const bcd_path_policy_config_t *config);
+void bcd_path_policy_destroy(bcd_path_policy_t *policy);
+
+void bcd_path_policy_set_telemetry(bcd_path_policy_t *policy, telem_ctx_t *ctx);
+
+/**
+ * Pulse start times (stream ms) from the two detectors
+ */
+void bcd_path_policy_time_pulse(bcd_path_policy_t *policy, double timestamp_ms);
+void bcd_path_policy_freq_pulse(bcd_path_policy_t *policy, double timestamp_ms);
+
+/**
+ * Evaluate, about every BCD_PATH_EVAL_MS of stream time
+ * @param snr_db    Carrier SNR (channel_quality_report_t)
+ * @param snr_valid false without an estimate; the policy then stays DUAL
+ * @return Mode to run in
+ */
+bcd_path_mode_t bcd_path_policy_update(bcd_path_policy_t *policy, double now_ms,
+                                       float snr_db, bool snr_valid);
+
+bcd_path_mode_t bcd_path_policy_get_mode(const bcd_path_policy_t *policy);
+bool bcd_path_policy_get_status(const bcd_path_policy_t *policy, bcd_path_status_t *out);
+
+const char *bcd_path_mode_name(bcd_path_mode_t mode);
+const char *bcd_path_reason_name(bcd_path_reason_t reason);
+
+void bcd_path_policy_print_stats(const bcd_path_policy_t *policy);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BCD_PATH_POLICY_H */
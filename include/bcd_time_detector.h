@@ -20,7 +20,12 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
+#include "goertzel_bank.h"
+#include "telemetry.h"
+#include "wwv_perf.h"
+#include "wwv_state.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -54,7 +59,8 @@ typedef struct bcd_time_detector bcd_time_detector_t;
  *============================================================================*/
 
 typedef struct {
-    float timestamp_ms;         /* When pulse started */
+    double timestamp_ms;        /* When pulse started */
+    uint64_t sample_index;      /* Input sample (BCD_TIME_SAMPLE_RATE) at timestamp_ms */
     float duration_ms;          /* Pulse width */
     float peak_energy;          /* Peak energy during pulse */
     float noise_floor;          /* Noise floor at detection */
@@ -89,6 +95,16 @@ void bcd_time_detector_set_callback(bcd_time_detector_t *td,
                                     bcd_time_callback_fn callback,
                                     void *user_data);
 
+/**
+ * Route UDP telemetry to a context (NULL = default context)
+ */
+void bcd_time_detector_set_telemetry(bcd_time_detector_t *td, telem_ctx_t *ctx);
+
+/**
+ * Time FFT and state machine stages (and CSV rows) into perf (NULL = off)
+ */
+void bcd_time_detector_set_perf(bcd_time_detector_t *td, wwv_perf_t *perf);
+
 /**
  * Feed I/Q samples to detector
  * Detector buffers internally and runs FFT when ready
@@ -101,12 +117,42 @@ bool bcd_time_detector_process_sample(bcd_time_detector_t *td,
                                       float i_sample,
                                       float q_sample);
 
+/**
+ * Feed a block of I/Q samples to detector
+ * Equivalent to per-sample calls, one FFT-frame chunk at a time
+ * @param td        Detector instance
+ * @param i_samples In-phase samples
+ * @param q_samples Quadrature samples
+ * @param count     Number of samples in each array
+ * @return          Number of pulses detected within the block
+ */
+int bcd_time_detector_process_block(bcd_time_detector_t *td,
+                                    const float *i_samples,
+                                    const float *q_samples,
+                                    size_t count);
+
 /**
  * Enable/disable detection
  */
 void bcd_time_detector_set_enabled(bcd_time_detector_t *td, bool enabled);
 bool bcd_time_detector_get_enabled(bcd_time_detector_t *td);
 
+/**
+ * Select spectral front end (FFT per frame, or Goertzel bank over the
+ * target bucket bins only). Discards the partial frame in progress.
+ * @return false if the Goertzel bank could not be allocated
+ */
+bool bcd_time_detector_set_spectral_mode(bcd_time_detector_t *td, spectral_mode_t mode);
+spectral_mode_t bcd_time_detector_get_spectral_mode(bcd_time_detector_t *td);
+
+/**
+ * Jump the stream ahead by samples not fed (duty-cycled sleep)
+ * Frame count advances as if the gap had been processed; the noise floor
+ * is kept and a pulse in progress is dropped.
+ * @return false unless the gap starts and ends on a frame boundary
+ */
+bool bcd_time_detector_skip(bcd_time_detector_t *td, uint64_t samples);
+
 /**
  * Get current state for display/debug
  */
@@ -125,6 +171,13 @@ void bcd_time_detector_print_stats(bcd_time_detector_t *td);
  */
 float bcd_time_detector_get_frame_duration_ms(void);
 
+/**
+ * Warm-start snapshot (wwv_state.h)
+ * Noise floor and thresholds; restore skips warmup (within WWV_STATE_LEVELS_MAX_AGE_MS)
+ */
+bool bcd_time_detector_save_state(bcd_time_detector_t *td, wwv_state_writer_t *w);
+bool bcd_time_detector_restore_state(bcd_time_detector_t *td, const wwv_state_reader_t *r);
+
 #ifdef __cplusplus
 }
 #endif
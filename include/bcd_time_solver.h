@@ -0,0 +1,102 @@
+/**
+ * @file bcd_time_solver.h
+ * @brief Soft-decision WWV time code decoder
+ *
+ * Hard 0/1/P decisions throw a minute away as soon as one BCD field holds
+ * an impossible digit. Instead this decoder keeps the per-second symbol
+ * log-likelihoods from bcd_correlator for the last BCD_SOLVER_MAX_FRAMES
+ * minutes and solves for the time that best explains all of them at once:
+ *
+ *   - Each field (minutes, hours, day of year, year) is scored only over
+ *     its legal values, so a corrupted bit pulls toward the nearest legal
+ *     time instead of producing garbage.
+ *   - Frame k minutes back must encode the candidate time minus k minutes
+ *     (hours and day roll over with it), so every received minute adds
+ *     evidence to the same hypothesis and weak frames still count.
+ *   - Frames whose position-marker seconds (:09 .. :59) look less like
+ *     markers than data are misaligned and are left out.
+ *
+ * A solution is reported when the best hypothesis beats the runner-up of
+ * every field by BCD_SOLVER_MIN_MARGIN (log-likelihood, nats).
+ *
+ * Frame layout (WWV): minutes units :10-:13, tens :15-:17; hours units
+ * :20-:23, tens :25-:26; day units :30-:33, tens :35-:38, hundreds :40-:41;
+ * year units :04-:07, tens :51-:54; all least significant bit first.
+ * Leap second warning :03 (set through the month that ends in one).
+ */
+
+#ifndef BCD_TIME_SOLVER_H
+#define BCD_TIME_SOLVER_H
+
+#include "bcd_correlator.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+#define BCD_SOLVER_MAX_FRAMES       10      /* Minutes of soft symbols held */
+#define BCD_SOLVER_MIN_MARGIN       6.0f    /* Best vs runner-up per field (nats) */
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+typedef struct {
+    int year;                   /* 2-digit year, 0-99 */
+    int day;                    /* Day of year, 1-366 */
+    int hour;                   /* UTC */
+    int minute;
+    double minute_start_ms;     /* Stream time of second 0 of that minute */
+    int frames_used;            /* Aligned frames that contributed */
+    float margin;               /* Smallest per-field margin (nats) */
+    bool leap_warning;          /* A leap second is inserted at the end of this month */
+} bcd_time_solution_t;
+
+typedef void (*bcd_time_solution_callback_fn)(const bcd_time_solution_t *solution,
+                                              void *user_data);
+
+typedef struct bcd_time_solver bcd_time_solver_t;
+
+/*============================================================================
+ * API
+ *============================================================================*/
+
+bcd_time_solver_t *bcd_time_solver_create(void);
+void bcd_time_solver_destroy(bcd_time_solver_t *solver);
+
+/**
+ * Called with each accepted solution (at most once per received minute)
+ */
+void bcd_time_solver_set_callback(bcd_time_solver_t *solver,
+                                  bcd_time_solution_callback_fn callback, void *user_data);
+
+/**
+ * Feed one correlator window (bcd_correlator callback event). The frame
+ * is solved when its :59 arrives or a later minute starts.
+ */
+void bcd_time_solver_add_symbol(bcd_time_solver_t *solver, const bcd_symbol_event_t *event);
+
+/**
+ * Most recent accepted solution
+ * @return false before the first one
+ */
+bool bcd_time_solver_get_solution(const bcd_time_solver_t *solver, bcd_time_solution_t *out);
+
+/**
+ * Drop all held frames (e.g. after sync is lost)
+ */
+void bcd_time_solver_reset(bcd_time_solver_t *solver);
+
+void bcd_time_solver_print_stats(const bcd_time_solver_t *solver);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BCD_TIME_SOLVER_H */
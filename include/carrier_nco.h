@@ -0,0 +1,53 @@
+/**
+ * @file carrier_nco.h
+ * @brief Tunable complex mixer for carrier-offset correction
+ *
+ * A receiver tuned f Hz off puts the WWV carrier at f instead of DC and
+ * every audio component of both sidebands f Hz off its nominal bin. This
+ * mixer multiplies the stream by e^{-j 2 pi f t}, which puts the carrier
+ * back on DC and the sidebands back where the detectors' buckets and
+ * matched filters expect them.
+ *
+ * The phasor advances by one complex multiply a sample and is reset from
+ * a double-precision phase every 1024 samples and at the end of every
+ * call, so a long run
+ * neither drifts in frequency nor grows in amplitude. A new frequency
+ * takes effect at the next call with the phase continuous.
+ */
+
+#ifndef CARRIER_NCO_H
+#define CARRIER_NCO_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct carrier_nco carrier_nco_t;
+
+carrier_nco_t *carrier_nco_create(float sample_rate);
+void carrier_nco_destroy(carrier_nco_t *nco);
+
+/**
+ * Frequency to remove: input at offset_hz comes out at DC
+ */
+void carrier_nco_set_offset(carrier_nco_t *nco, double offset_hz);
+double carrier_nco_get_offset(const carrier_nco_t *nco);
+
+/**
+ * Mix count samples; out_i / out_q may alias in_i / in_q
+ */
+void carrier_nco_process(carrier_nco_t *nco, const float *in_i, const float *in_q,
+                         float *out_i, float *out_q, size_t count);
+
+/**
+ * Phase back to zero (the offset is kept)
+ */
+void carrier_nco_reset(carrier_nco_t *nco);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CARRIER_NCO_H */
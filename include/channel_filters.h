@@ -1,6 +1,8 @@
 #ifndef CHANNEL_FILTERS_H
 #define CHANNEL_FILTERS_H
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -11,29 +13,132 @@ typedef struct {
     float y1, y2;  // Output history
 } biquad_state_t;
 
-// Sync channel: 800-1400 Hz bandpass (4th order = 2 cascaded biquads)
+//=============================================================================
+// Butterworth design
+//
+// Coefficients are designed at init for the channel's sample rate, so the
+// same filters run at any front-end rate. Validated against scipy's
+// scipy.signal.butter(output='sos') in test_vectors.json
+// (wwv_bench --filter-check).
+//=============================================================================
+
+#define CHANNEL_DEFAULT_RATE    50000.0f    // Detector path (2MHz/40)
+#define CHANNEL_SYNC_HP_HZ      800.0
+#define CHANNEL_SYNC_LP_HZ      1400.0
+#define CHANNEL_DATA_LP_HZ      150.0
+#define CHANNEL_FILTER_ORDER    4           // Each edge: 2 biquad sections
+#define CHANNEL_FILTER_SECTIONS ((CHANNEL_FILTER_ORDER + 1) / 2)
+#define CHANNEL_MAX_ORDER       8
+#define CHANNEL_MAX_SECTIONS    ((CHANNEL_MAX_ORDER + 1) / 2)
+
+typedef enum {
+    CHANNEL_LOWPASS = 0,
+    CHANNEL_HIGHPASS
+} channel_filter_type_t;
+
+// Rows [b0, b1, b2, a0(=1), a1, a2]: overall gain in the first section,
+// poles nearest the unit circle last (scipy's layout). Returns the number
+// of sections, (order + 1) / 2, or 0 for a bad order or a cutoff at or
+// above Nyquist
+int channel_butterworth_design(channel_filter_type_t type, int order, double cutoff_hz,
+                               double sample_rate, double sos[][6]);
+
+// Sync channel: 800-1400 Hz bandpass (4th order edges = 2 biquads each)
 typedef struct {
     biquad_state_t hp[2];  // 800 Hz highpass (2 sections)
     biquad_state_t lp[2];  // 1400 Hz lowpass (2 sections)
+    float sos[4][6];       // HP sections, then LP
+    float sample_rate;
 } sync_channel_t;
 
 // Data channel: 0-150 Hz lowpass (4th order = 2 cascaded biquads)
 typedef struct {
     biquad_state_t lp[2];  // 150 Hz lowpass (2 sections)
+    float sos[2][6];
+    float sample_rate;
 } data_channel_t;
 
-// Initialize filters
+// Initialize filters at CHANNEL_DEFAULT_RATE
 void sync_channel_init(sync_channel_t *ch);
 void data_channel_init(data_channel_t *ch);
 
+// Initialize filters designed for sample_rate (returns 0 if a cutoff is
+// not below Nyquist)
+int sync_channel_init_rate(sync_channel_t *ch, float sample_rate);
+int data_channel_init_rate(data_channel_t *ch, float sample_rate);
+
 // Process single sample through filter chain
 float sync_channel_process(sync_channel_t *ch, float x);
 float data_channel_process(data_channel_t *ch, float x);
 
-// Reset filter state (call on reconnect)
+// Reset filter state, keeping the design (call on reconnect)
 void sync_channel_reset(sync_channel_t *ch);
 void data_channel_reset(data_channel_t *ch);
 
+//=============================================================================
+// Multi-lane filter banks
+//
+// Runs up to CHANNEL_BANK_MAX_LANES independent channels (one per receiver
+// or per I/Q rail) in parallel SIMD lanes. Blocks are lane-interleaved:
+// sample n of lane k lives at buf[n * lanes + k]. Output is bit-identical
+// to running each lane through sync_channel_process()/data_channel_process();
+// CMakeLists.txt builds both filter sources with -ffp-contract=off so FMA
+// contraction cannot break that.
+//=============================================================================
+
+#define CHANNEL_BANK_MAX_LANES 8
+
+// Kernel selection (runtime CPU dispatch)
+typedef enum {
+    CHANNEL_SIMD_SCALAR = 0,
+    CHANNEL_SIMD_SSE2,      // 4 lanes per vector (x86)
+    CHANNEL_SIMD_AVX2,      // 8 lanes per vector (x86)
+    CHANNEL_SIMD_NEON       // 4 lanes per vector (ARM)
+} channel_simd_t;
+
+// One biquad section across all lanes (structure-of-arrays)
+typedef struct {
+    float x1[CHANNEL_BANK_MAX_LANES], x2[CHANNEL_BANK_MAX_LANES];
+    float y1[CHANNEL_BANK_MAX_LANES], y2[CHANNEL_BANK_MAX_LANES];
+} biquad_lane_state_t;
+
+typedef struct {
+    int lanes;
+    biquad_lane_state_t sec[4];  // 800 Hz HP x2, then 1400 Hz LP x2
+    float sos[4][6];
+    float sample_rate;
+} sync_channel_bank_t;
+
+typedef struct {
+    int lanes;
+    biquad_lane_state_t sec[2];  // 150 Hz LP x2
+    float sos[2][6];
+    float sample_rate;
+} data_channel_bank_t;
+
+// Initialize bank with 1..CHANNEL_BANK_MAX_LANES lanes at CHANNEL_DEFAULT_RATE
+// (returns 0 on bad count)
+int sync_channel_bank_init(sync_channel_bank_t *bank, int lanes);
+int data_channel_bank_init(data_channel_bank_t *bank, int lanes);
+
+// Same, designed for sample_rate (also 0 if a cutoff is not below Nyquist)
+int sync_channel_bank_init_rate(sync_channel_bank_t *bank, int lanes, float sample_rate);
+int data_channel_bank_init_rate(data_channel_bank_t *bank, int lanes, float sample_rate);
+
+// Process count samples per lane (in/out hold count * lanes floats, may alias)
+void sync_channel_bank_process(sync_channel_bank_t *bank, const float *in, float *out, size_t count);
+void data_channel_bank_process(data_channel_bank_t *bank, const float *in, float *out, size_t count);
+
+void sync_channel_bank_reset(sync_channel_bank_t *bank);
+void data_channel_bank_reset(data_channel_bank_t *bank);
+
+// Active kernel. Detected on first use; set_simd forces a level for
+// comparison and returns the level actually selected (falls back if the
+// CPU does not support it)
+channel_simd_t channel_filters_get_simd(void);
+channel_simd_t channel_filters_set_simd(channel_simd_t level);
+const char *channel_filters_simd_name(channel_simd_t level);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,89 @@
+/**
+ * @file channel_quality.h
+ * @brief Channel-quality estimate from the shared display spectrum
+ *
+ * Reads the magnitudes tone_spectrum already computes (no transform of
+ * its own) and keeps one view of the channel that the trackers and the
+ * application share instead of each deriving its own:
+ *
+ *   carrier / noise / SNR  peak near DC against the tone trackers' noise
+ *                          region (bins 50-150 and their mirror)
+ *   fade rate              downward crossings of the carrier level through
+ *                          its slow mean, 1 dB hysteresis
+ *   fade depth             standard deviation of the carrier level
+ *   Doppler spread         RMS width of the carrier line, noise subtracted,
+ *                          less the window's own width; the multipath
+ *                          spread proxy a single-tone channel gives
+ *
+ * Levels are dB of FFT magnitude, so comparable to tone_tracker SNRs.
+ * Frames arrive whenever the spectrum computes, so the smoothing runs on
+ * frame time stamps, not frame counts.
+ */
+
+#ifndef CHANNEL_QUALITY_H
+#define CHANNEL_QUALITY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "telemetry.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+#define CHANNEL_LEVEL_TAU_MS        10000.0     /* Levels, mean and depth */
+#define CHANNEL_FADE_TAU_MS         30000.0     /* Fade-rate average */
+#define CHANNEL_FADE_HYST_DB        1.0f
+#define CHANNEL_SPREAD_BINS         5           /* ±14.6 Hz around the carrier */
+#define CHANNEL_SPREAD_MIN_SNR_DB   10.0f       /* Below this the width is noise */
+#define CHANNEL_TELEM_INTERVAL_MS   1000.0
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+typedef struct channel_quality channel_quality_t;
+
+typedef struct {
+    double timestamp_ms;        /* Window start of the last frame */
+    float carrier_db;           /* Smoothed carrier level */
+    float noise_db;             /* Smoothed noise level */
+    float snr_db;               /* Smoothed carrier SNR */
+    float fade_rate_hz;         /* Fades per second */
+    float fade_depth_db;        /* Carrier level standard deviation */
+    float doppler_spread_hz;    /* Carrier RMS width beyond the window's */
+    float noise_floor;          /* Last frame's linear noise magnitude */
+    uint64_t frames;
+    bool valid;                 /* Enough frames for the averages to mean anything */
+} channel_quality_report_t;
+
+/*============================================================================
+ * API
+ *============================================================================*/
+
+channel_quality_t *channel_quality_create(void);
+void channel_quality_destroy(channel_quality_t *cq);
+
+/* One spectrum frame: |X[k]| of n bins at the display Hz/bin */
+void channel_quality_process_magnitudes(channel_quality_t *cq, const float *mag, int n,
+                                        double timestamp_ms);
+
+bool channel_quality_get(const channel_quality_t *cq, channel_quality_report_t *out);
+
+/* Last frame's linear noise magnitude, the tone trackers' SNR reference */
+float channel_quality_get_noise_floor(const channel_quality_t *cq);
+
+/* TELEM_CHANNEL, one line per CHANNEL_TELEM_INTERVAL_MS */
+void channel_quality_set_telemetry(channel_quality_t *cq, telem_ctx_t *ctx);
+
+void channel_quality_print_stats(const channel_quality_t *cq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHANNEL_QUALITY_H */
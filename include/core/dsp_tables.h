@@ -0,0 +1,96 @@
+/**
+ * @file dsp_tables.h
+ * @brief Precomputed window and template tables for the standard sizes
+ *
+ * The coefficient expressions below are the single definition of each
+ * table: runtime generation and the build-time generator
+ * (tools/gen_dsp_tables.c) both use them, compiled with the same flags, so
+ * a baked table is bit-identical to what the runtime would compute.
+ *
+ * Baked tables are static const, so construction costs nothing and every
+ * process maps the same read-only pages. Lookups return NULL for sizes
+ * that were not baked (or with WWV_BAKED_TABLES off); callers then
+ * generate at runtime as before.
+ */
+
+#ifndef DSP_TABLES_H
+#define DSP_TABLES_H
+
+#include <math.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Each runtime site used its own precision of pi; kept per expression */
+#define DSP_PI_D    3.14159265358979323846
+#define DSP_PI_F    3.14159265358979323846f
+
+#define DSP_TABLES_ALIGN            64
+
+/* Template buffers are front-padded with zeros to whole 8-float vectors */
+#define DSP_TEMPLATE_TAPS(n)        (((n) + 7) / 8 * 8)
+
+/*============================================================================
+ * Coefficients
+ *============================================================================*/
+
+/* Hann window tap i of size (fft_plan_cache's FFT_WINDOW_HANN) */
+static inline float dsp_hann_coeff(int i, int size) {
+    return 0.5f * (1.0f - cosf(2.0f * DSP_PI_D * i / (size - 1)));
+}
+
+/* Hann-windowed complex tone tap i of an n-sample matched-filter template */
+static inline void dsp_tone_template_coeff(int i, int n, int hz, int sample_rate,
+                                           float *re, float *im) {
+    float t = (float)i / sample_rate;
+    float window = 0.5f * (1.0f - cosf(2.0f * DSP_PI_F * i / (n - 1)));
+    *re = cosf(2.0f * DSP_PI_F * hz * t) * window;
+    *im = sinf(2.0f * DSP_PI_F * hz * t) * window;
+}
+
+/*============================================================================
+ * Baked Tables
+ *============================================================================*/
+
+/**
+ * Hann window [size], DSP_TABLES_ALIGN-aligned
+ * @return Baked table, or NULL if size was not baked
+ */
+const float *dsp_tables_hann(int size);
+
+/**
+ * Tick matched-filter template at hz (TICK_SAMPLE_RATE, TICK_TEMPLATE_SAMPLES),
+ * padded to DSP_TEMPLATE_TAPS(TICK_TEMPLATE_SAMPLES) with leading zeros
+ * @param quadrature false = cosine (I), true = sine (Q)
+ * @return Baked table, or NULL if hz was not baked
+ */
+const float *dsp_tables_tick_template(int hz, bool quadrature);
+
+/* Baked table count (0 without WWV_BAKED_TABLES) */
+int dsp_tables_baked_count(void);
+
+/* Generated table directory (dsp_tables_baked.c in the build tree; defined
+ * only with WWV_BAKED_TABLES, use the lookups above elsewhere) */
+typedef struct {
+    int size;
+    const float *taps;
+} dsp_baked_window_t;
+
+typedef struct {
+    int hz;
+    const float *taps_i;
+    const float *taps_q;
+} dsp_baked_template_t;
+
+extern const dsp_baked_window_t dsp_baked_hann[];
+extern const int dsp_baked_hann_count;
+extern const dsp_baked_template_t dsp_baked_tick_template[];
+extern const int dsp_baked_tick_template_count;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DSP_TABLES_H */
@@ -0,0 +1,55 @@
+/**
+ * @file fft_backend_internal.h
+ * @brief Vector butterflies for the vendored KissFFT
+ *
+ * Private interface between fft_backend.c and fft_kiss_simd.c (and the
+ * kernel check in wwv_bench). NOT part of public API.
+ *
+ * The plan walks the kiss_fft cfg's own factors and twiddles in kf_work()'s
+ * order, running each radix-4 / radix-2 stage whose butterfly count fills a
+ * vector with interleaved-complex kernels (2 butterflies per SSE2 / NEON
+ * register, 4 per AVX2) and the single-butterfly leaves two at a time.
+ * The kernels issue kf_bfly4() / kf_bfly2()'s operations lane for lane
+ * (mul and add never fused, negation by sign flip), so each output matches
+ * kiss_fft() bit for bit wherever the compiler does not contract the
+ * scalar code into FMAs.
+ */
+
+#ifndef FFT_BACKEND_INTERNAL_H
+#define FFT_BACKEND_INTERNAL_H
+
+#include "external/kiss_fft.h"
+#include "channel_filters.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct fft_kiss_simd fft_kiss_simd_t;
+
+/**
+ * Vector plan over a forward kiss_fft cfg (which must outlive it)
+ * @param level SIMD level of the kernels (channel_filters_get_simd())
+ * @param bytes_out Optional: memory held by the plan
+ * @return NULL for the scalar level, an inverse cfg, or a size with a
+ *         factor other than 2 and 4; kiss_fft() then runs as before
+ */
+fft_kiss_simd_t *fft_kiss_simd_create(kiss_fft_cfg cfg, channel_simd_t level, size_t *bytes_out);
+
+void fft_kiss_simd_destroy(fft_kiss_simd_t *plan);
+
+/**
+ * Same transform as kiss_fft(cfg, in, out); in and out must not overlap.
+ * Read-only on the plan, so safe to call concurrently.
+ */
+void fft_kiss_simd_forward(const fft_kiss_simd_t *plan, const kiss_fft_cpx *in, kiss_fft_cpx *out);
+
+/* Stages the vector kernels run, out of the plan's total */
+int fft_kiss_simd_vector_stages(const fft_kiss_simd_t *plan, int *total);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FFT_BACKEND_INTERNAL_H */
@@ -0,0 +1,122 @@
+/**
+ * @file telemetry_internal.h
+ * @brief Shared definitions for the telemetry translation units
+ *
+ * Producers build a telem_msg_t. Without a sender thread it is delivered
+ * immediately on the calling thread; with one it is pushed onto the
+ * context's MPSC queue and delivered by the sender.
+ */
+
+#ifndef TELEMETRY_INTERNAL_H
+#define TELEMETRY_INTERNAL_H
+
+#include "telemetry.h"
+#include "telemetry_wire.h"
+#include "wwv_mpsc_queue.h"
+#include "wwv_thread.h"
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#define TELEM_CHANNEL_SLOTS     16      /* telem_channel_index() range, 0 = unknown */
+
+typedef enum {
+    TELEM_MSG_LINE = 0,                 /* Complete "PREFIX,csv\n" line (CSV format) */
+    TELEM_MSG_RECORD                    /* Binary record payload (binary format) */
+} telem_msg_kind_t;
+
+typedef struct {
+    uint8_t  channel_idx;               /* telem_channel_index() */
+    uint8_t  kind;                      /* telem_msg_kind_t */
+    uint8_t  type;                      /* telem_record_type_t (records only) */
+    uint8_t  reserved;
+    uint16_t length;                    /* Bytes used in data */
+    uint32_t wall_time;
+    uint64_t sample_us;
+    uint8_t  data[TELEM_MAX_MESSAGE_LEN];
+} telem_msg_t;
+
+#define TELEM_MSG_HEADER_BYTES  offsetof(telem_msg_t, data)
+
+/*============================================================================
+ * Sender State (one per context, owned by telemetry_sender.c)
+ *============================================================================*/
+
+typedef struct {
+    uint8_t  data[TELEM_WIRE_MTU];
+    size_t   length;
+    uint32_t lines;
+} telem_line_batch_t;
+
+typedef struct {
+    wwv_mpsc_queue_t *queue;            /* Kept across stop/start, freed on close */
+    telem_sender_config_t config;
+    atomic_bool active;                 /* Producers enqueue while set */
+
+    wwv_mutex_t lock;
+    wwv_cond_t wake;
+    bool cond_ready;
+    wwv_thread_t thread;
+    bool running;
+    bool stop;
+
+    /* Sender thread only */
+    telem_line_batch_t batches[TELEM_CHANNEL_SLOTS];
+    telem_msg_t msg;
+} telem_sender_t;
+
+/*============================================================================
+ * telemetry.c
+ *============================================================================*/
+
+/**
+ * Map NULL to the default context
+ */
+telem_ctx_t *telem_ctx_resolve(telem_ctx_t *ctx);
+
+telem_sender_t *telem_ctx_sender(telem_ctx_t *ctx);
+
+int telem_channel_index(telem_channel_t channel);
+
+/**
+ * Send one datagram to the context's destination
+ * @return false if the socket refused it (e.g. send buffer full)
+ */
+bool telem_transmit(telem_ctx_t *ctx, const void *data, size_t length);
+
+void telem_count_sent(telem_ctx_t *ctx, int channel_idx, uint32_t count);
+void telem_count_dropped(telem_ctx_t *ctx, int channel_idx, uint32_t count);
+
+/**
+ * Append a record to the pending binary datagram (sends it when full or aged)
+ */
+void telem_frame_append(telem_ctx_t *ctx, const telem_msg_t *msg);
+
+/**
+ * Send the pending binary datagram
+ */
+void telem_frame_send(telem_ctx_t *ctx);
+
+void telem_ctx_vsendf(telem_ctx_t *ctx, telem_channel_t channel, const char *fmt, va_list args);
+void telem_ctx_vconsole(telem_ctx_t *ctx, const char *fmt, va_list args);
+
+/*============================================================================
+ * telemetry_sender.c
+ *============================================================================*/
+
+void telem_sender_init(telem_sender_t *sender);
+
+bool telem_sender_active(telem_ctx_t *ctx);
+
+/**
+ * Queue a message for the sender thread (never blocks)
+ * @return false if the queue is full
+ */
+bool telem_sender_enqueue(telem_ctx_t *ctx, const telem_msg_t *msg);
+
+/**
+ * Deliver what is left and free the queue (after telem_ctx_stop_sender)
+ */
+void telem_sender_release(telem_ctx_t *ctx);
+
+#endif /* TELEMETRY_INTERNAL_H */
@@ -0,0 +1,36 @@
+/**
+ * @file wwv_lz4.h
+ * @brief LZ4 block format codec
+ *
+ * A greedy single-probe compressor (lz4's fast mode) and a bounds-checked
+ * decompressor for the raw LZ4 block format, without the frame format.
+ * Blocks from either side decode on the other: LZ4_decompress_safe()
+ * reads what wwv_lz4_compress() writes.
+ */
+
+#ifndef WWV_LZ4_H
+#define WWV_LZ4_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Worst-case compressed size of n input bytes */
+#define WWV_LZ4_BOUND(n)    ((n) + (n) / 255 + 16)
+
+/**
+ * @return Compressed bytes, 0 if dst_capacity is too small
+ */
+int wwv_lz4_compress(const void *src, int src_length, void *dst, int dst_capacity);
+
+/**
+ * @return Decompressed bytes, -1 for a malformed block or one that does
+ *         not fit in dst_capacity
+ */
+int wwv_lz4_decompress(const void *src, int src_length, void *dst, int dst_capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_LZ4_H */
@@ -13,6 +13,10 @@
 
 #include "bcd_correlator.h"
 #include "sync_detector.h"
+#include "bcd_time_detector.h"
+#include "wwv_timebase.h"
+#include "wwv_thread.h"
+#include "wwv_csv_log.h"
 #include <stdio.h>
 #include <time.h>
 
@@ -27,10 +31,22 @@ extern "C" {
 /* Window timing */
 #define WINDOW_DURATION_MS      1000.0f
 #define WINDOW_TOLERANCE_MS     50.0f
+#define WINDOW_CLOSE_GRACE_MS   250.0f  /* Timer close after the second ends (trailing-edge reports) */
 
 /* Phase 8: Valid P-marker positions (WWV BCD time code format) */
 extern const int VALID_P_POSITIONS[];
 
+/* Soft symbols: Gaussian width model around the 200/500/800 ms nominal pulses */
+#define SOFT_SYMBOL_SIGMA_MS    100.0f
+#define SOFT_SYMBOL_LL_FLOOR    -12.0f  /* Cap on how unlikely one window can make a symbol */
+
+/* Multi-minute integration (bcd_integrator.c) */
+#define BCD_INTEG_BIN_MS        100.0f
+#define BCD_INTEG_BINS          600     /* One minute row */
+#define BCD_INTEG_MIN_MARGIN    2.5f    /* Weakest field: best vs runner-up, noise sigmas */
+#define BCD_INTEG_NOISE_FLOOR   0.01f   /* Per-bin coverage variance floor (jitter, clean signal) */
+#define BCD_INTEG_MIN_MARKERS   5       /* Of the 7 position markers, for alignment */
+
 /* Energy integration thresholds */
 #define MIN_EVENTS_FOR_SYMBOL   2
 #define ENERGY_THRESHOLD_LOW    0.001f
@@ -39,6 +55,24 @@ extern const int VALID_P_POSITIONS[];
  * BCD Correlator Internal Structure
  *============================================================================*/
 
+/* Ring of minute rows of envelope coverage, indexed by minute % minutes */
+typedef struct {
+    int minutes;
+    float *bins;                    /* minutes x BCD_INTEG_BINS */
+    int64_t row_minute[BCD_INTEG_MAX_MINUTES];  /* Minute held by each row, -1 = empty */
+    int64_t current_minute;         /* Latest minute started, -1 = none */
+    double ref_anchor_ms;           /* Minute 0 */
+    bool have_ref;
+
+    bcd_integrated_frame_t result;
+    bool have_result;
+
+    /* Statistics */
+    uint32_t decodes;
+    uint32_t accepted;
+    uint32_t misaligned;
+} bcd_integrator_t;
+
 struct bcd_correlator {
     /* Sync source - provides timing reference */
     sync_detector_t *sync_source;
@@ -46,24 +80,33 @@ struct bcd_correlator {
     /* Current window state */
     bool window_open;
     int current_second;             /* Which second (0-59) */
-    float window_start_ms;
-    float window_anchor_ms;
+    double window_start_ms;
+    double window_anchor_ms;
+
+    /* Window close deadline (bcd_correlator_set_timer_wheel) */
+    wwv_timer_wheel_t *timers;
+    wwv_timer_t close_timer;
+    int closed_second;              /* Last window closed by the timer, -1 = none */
+    double closed_anchor_ms;
 
     /* Energy accumulation for current window */
     float time_energy_sum;
     float time_duration_sum;
     int time_event_count;
-    float time_first_ms;
-    float time_last_ms;
+    double time_first_ms;
+    double time_last_ms;
 
     float freq_energy_sum;
     float freq_duration_sum;
     int freq_event_count;
-    float freq_first_ms;
-    float freq_last_ms;
+    double freq_first_ms;
+    double freq_last_ms;
+
+    /* Multi-minute integration, NULL = off */
+    bcd_integrator_t *integ;
 
     /* Symbol tracking */
-    float last_symbol_ms;
+    double last_symbol_ms;
     int symbol_count;
     int good_intervals;
 
@@ -75,7 +118,8 @@ struct bcd_correlator {
     void *callback_user_data;
 
     /* Logging */
-    FILE *csv_file;
+    wwv_csv_log_t *csv_log;
+    telem_ctx_t *telem;    /* Telemetry destination, NULL = default context */
     time_t start_time;
 };
 
@@ -84,12 +128,19 @@ struct bcd_correlator {
  *============================================================================*/
 
 /**
- * Get wall clock time string for CSV output
+ * Get wall clock time of a correlator timestamp
  */
-static inline void bcd_corr_get_wall_time_str(time_t start_time, float timestamp_ms,
-                                               char *buf, size_t buflen) {
-    time_t event_time = start_time + (time_t)(timestamp_ms / 1000.0f);
-    struct tm *tm_info = localtime(&event_time);
+static inline time_t bcd_corr_get_wall_time(time_t start_time, double timestamp_ms) {
+    return start_time + (time_t)(timestamp_ms / 1000.0f);
+}
+
+/**
+ * Get wall clock time string for console and telemetry output
+ */
+static inline void bcd_corr_get_wall_time_str(time_t start_time, double timestamp_ms,
+                                              char *buf, size_t buflen) {
+    time_t event_time = bcd_corr_get_wall_time(start_time, timestamp_ms);
+    struct tm *tm_info = wwv_localtime(&event_time);
     strftime(buf, buflen, "%H:%M:%S", tm_info);
 }
 
@@ -101,18 +152,18 @@ static inline void bcd_corr_get_wall_time_str(time_t start_time, float timestamp
  * Get the current minute anchor from sync detector
  * Returns -1 if sync is not locked
  */
-float bcd_window_get_minute_anchor(bcd_correlator_t *corr);
+double bcd_window_get_minute_anchor(bcd_correlator_t *corr);
 
 /**
  * Calculate which second (0-59) a timestamp falls into
  * Returns -1 if cannot determine
  */
-int bcd_window_get_second_for_timestamp(bcd_correlator_t *corr, float timestamp_ms, float anchor_ms);
+int bcd_window_get_second_for_timestamp(bcd_correlator_t *corr, double timestamp_ms, double anchor_ms);
 
 /**
  * Calculate window start time for a given second
  */
-float bcd_window_get_start(float anchor_ms, int second);
+double bcd_window_get_start(double anchor_ms, int second);
 
 /**
  * Estimate pulse duration from accumulated events
@@ -122,18 +173,41 @@ float bcd_window_estimate_pulse_duration(bcd_correlator_t *corr);
 /**
  * Open a new integration window
  */
-void bcd_window_open(bcd_correlator_t *corr, int second, float anchor_ms);
+void bcd_window_open(bcd_correlator_t *corr, int second, double anchor_ms);
 
 /**
  * Close current window and emit symbol
  */
 void bcd_window_close(bcd_correlator_t *corr);
 
+/**
+ * Timer callback: close the window at its deadline
+ */
+void bcd_window_on_close_timer(wwv_timer_t *timer, double now_ms, void *user_data);
+
 /**
  * Check if window transition is needed and handle it
- * Called on every event
+ * Called on every event; with a timer wheel the window also closes on its
+ * own deadline
  */
-void bcd_window_check_transition(bcd_correlator_t *corr, float timestamp_ms);
+void bcd_window_check_transition(bcd_correlator_t *corr, double timestamp_ms);
+
+/*============================================================================
+ * Multi-Minute Integration Functions (bcd_integrator.c)
+ *============================================================================*/
+
+/**
+ * Allocate the ring for N minutes (0 = off, frees it)
+ */
+bool bcd_integrator_configure(bcd_correlator_t *corr, int minutes);
+void bcd_integrator_destroy(bcd_correlator_t *corr);
+
+/**
+ * Add one detector pulse; the first pulse of a new minute decodes the
+ * minute before it
+ */
+void bcd_integrator_add_pulse(bcd_correlator_t *corr, double anchor_ms,
+                              double timestamp_ms, float duration_ms);
 
 /*============================================================================
  * Symbol Classification Functions (bcd_symbol_classifier.c)
@@ -150,6 +224,12 @@ bool bcd_symbol_is_valid_p_position(int second);
  */
 bcd_corr_symbol_t bcd_symbol_classify_duration(float duration_ms, int second);
 
+/**
+ * Log-likelihoods of ZERO / ONE / MARKER for a window, scaled by how much
+ * the window is trusted (confidence, 0 = no information), best = 0
+ */
+void bcd_symbol_soft_likelihoods(float duration_ms, float weight, float ll[3]);
+
 #ifdef __cplusplus
 }
 #endif
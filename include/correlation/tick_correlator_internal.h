@@ -10,6 +10,7 @@
 #define TICK_CORRELATOR_INTERNAL_H
 
 #include "tick_correlator.h"
+#include "wwv_csv_log.h"
 #include <stdio.h>
 #include <time.h>
 
@@ -21,29 +22,32 @@ extern "C" {
  * Internal Configuration
  *============================================================================*/
 
-#define MAX_CHAINS          1000
-#define MAX_TICKS_STORED    10000
+#define TICK_CORR_TOP_CHAINS    5       /* Longest chains kept past ring eviction */
 
 /*============================================================================
  * Tick Correlator Internal Structure
  *============================================================================*/
 
 struct tick_correlator {
-    /* Tick storage */
+    /* Tick history: ring of the last tick_capacity records */
     tick_record_t *ticks;
-    int tick_count;
+    int tick_count;             /* Ticks ever added; next slot is tick_count % capacity */
     int tick_capacity;
 
-    /* Chain tracking */
+    /* Chain history: chain N lives in slot (N-1) % capacity until evicted */
     chain_stats_t *chains;
-    int chain_count;
+    int chain_count;            /* Chains ever started = newest chain ID */
     int chain_capacity;
 
+    /* Longest chains, by tick_count descending (copies, survive eviction) */
+    chain_stats_t top[TICK_CORR_TOP_CHAINS];
+    int top_count;
+
     /* Current chain state */
     int current_chain_id;
     int current_chain_length;
-    float current_chain_start_ms;
-    float last_tick_ms;
+    double current_chain_start_ms;
+    double last_tick_ms;
     float cumulative_drift_ms;
 
     /* Overall stats */
@@ -52,7 +56,8 @@ struct tick_correlator {
     float longest_chain_ticks;
 
     /* Logging */
-    FILE *csv_file;
+    wwv_csv_log_t *csv_log;
+    telem_ctx_t *telem;    /* Telemetry destination, NULL = default context */
     time_t start_time;
 
     /* Epoch callback */
@@ -68,7 +73,7 @@ struct tick_correlator {
     struct {
         bool active;
         int retained_chain_id;
-        float predicted_next_ms;
+        double predicted_next_ms;
         float discipline_window_ms;
         float last_std_dev_ms;
         int consecutive_misses;
@@ -86,12 +91,23 @@ struct tick_correlator {
 /**
  * Start a new correlation chain
  */
-void tick_chain_start_new(tick_correlator_t *tc, float timestamp_ms);
+void tick_chain_start_new(tick_correlator_t *tc, double timestamp_ms);
+
+/**
+ * Chain statistics slot for chain_id
+ * Returns NULL if the chain was never started or has left the ring
+ */
+chain_stats_t *tick_chain_get(tick_correlator_t *tc, int chain_id);
+
+/**
+ * Re-rank a chain whose statistics changed among the longest chains
+ */
+void tick_chain_rank(tick_correlator_t *tc, const chain_stats_t *cs);
 
 /**
  * Update chain statistics with new interval
  */
-void tick_chain_update_stats(tick_correlator_t *tc, float interval_ms, float timestamp_ms);
+void tick_chain_update_stats(tick_correlator_t *tc, float interval_ms, double timestamp_ms);
 
 /**
  * Determine if tick correlates with current chain
@@ -107,13 +123,13 @@ int tick_chain_correlate(tick_correlator_t *tc, float actual_interval, bool pred
  * Check if tick matches prediction from established discipline
  * Returns true if within discipline window
  */
-bool tick_predict_match(tick_correlator_t *tc, float timestamp_ms, float actual_interval);
+bool tick_predict_match(tick_correlator_t *tc, double timestamp_ms, float actual_interval);
 
 /**
  * Calculate epoch when sufficient correlation established
  * Calls epoch callback if confidence threshold met
  */
-void tick_predict_calculate_epoch(tick_correlator_t *tc, float timestamp_ms);
+void tick_predict_calculate_epoch(tick_correlator_t *tc, double timestamp_ms);
 
 /**
  * Track recent intervals for epoch calculation
@@ -6,7 +6,8 @@
  *   - bcd_time_detector (time-domain, precise edge timing)
  *   - bcd_freq_detector (frequency-domain, confident presence detection)
  *
- * Both detectors share the same 3-state FSM pattern and similar structure.
+ * Both detectors run the shared 3-state pulse engine (pulse_fsm_internal.h)
+ * and have similar structure.
  * This header exposes internals to allow state machine extraction.
  *
  * Pattern: Follows tick_internal.h and marker_internal.h
@@ -18,6 +19,15 @@
 #include "bcd_time_detector.h"
 #include "bcd_freq_detector.h"
 #include "fft_processor.h"
+#include "polyphase_resampler.h"
+#include "sliding_dft.h"
+#include "wwv_thread.h"
+#include "wwv_csv_log.h"
+#include "wwv_timebase.h"
+#include "sliding_sum.h"
+#include "detection/pulse_fsm_internal.h"
+#include "wwv_arena.h"
+#include <stddef.h>
 #include <stdio.h>
 #include <time.h>
 
@@ -37,44 +47,44 @@ extern "C" {
 #define M_PI 3.14159265358979323846f
 #endif
 
-/*============================================================================
- * Common State Machine States
- *============================================================================*/
-
-typedef enum {
-    STATE_IDLE,
-    STATE_IN_PULSE,
-    STATE_COOLDOWN
-} detector_state_t;
-
 /*============================================================================
  * BCD Time Detector Internal Structure
  *============================================================================*/
 
 struct bcd_time_detector {
-    /* FFT resources */
-    fft_processor_t *fft;
+    /*------------------------------------------------------------------
+     * Hot: every sample (frame buffer or Goertzel bank). One cache line,
+     * checked below.
+     *------------------------------------------------------------------*/
+    _Alignas(WWV_CACHE_LINE) bool detection_enabled;
+    spectral_mode_t spectral_mode;
+    goertzel_bank_t *goertzel;      /* Created on first switch to SPECTRAL_MODE_GOERTZEL */
 
     /* Sample buffer for FFT */
     float *i_buffer;
     float *q_buffer;
     int buffer_idx;
 
+    wwv_perf_t *perf;      /* Stage timing, NULL = off */
+
+    /*------------------------------------------------------------------
+     * Warm: once per FFT frame
+     *------------------------------------------------------------------*/
+
+    /* FFT resources */
+    _Alignas(WWV_CACHE_LINE) fft_processor_t *fft;
+    int fft_band;               /* Registered target bucket */
+    int goertzel_band;
+
     /* Detection state */
-    detector_state_t state;
     float noise_floor;
     float threshold_high;
     float threshold_low;
     float current_energy;
 
-    /* Pulse measurement */
-    uint64_t pulse_start_frame;
-    float pulse_peak_energy;
-    int pulse_duration_frames;
-    int cooldown_frames;
-
-    /* Phase 9: Minimum duration validation */
-    int consecutive_low_frames;
+    /* State machine and pulse measurement */
+    pulse_fsm_t pulse;
+    pulse_fsm_params_t pulse_params;
 
     /* Statistics */
     int pulses_detected;
@@ -84,83 +94,117 @@ struct bcd_time_detector {
     uint64_t start_frame;
     bool warmup_complete;
 
-    /* Enabled flag */
-    bool detection_enabled;
+    /*------------------------------------------------------------------
+     * Cold: events, logging, setup
+     *------------------------------------------------------------------*/
 
     /* Callback */
-    bcd_time_callback_fn callback;
+    _Alignas(WWV_CACHE_LINE) bcd_time_callback_fn callback;
     void *callback_user_data;
 
     /* Logging */
-    FILE *csv_file;
+    wwv_csv_log_t *csv_log;
+    telem_ctx_t *telem;    /* Telemetry destination, NULL = default context */
     time_t start_time;
 };
 
+_Static_assert(offsetof(struct bcd_time_detector, fft) <= WWV_CACHE_LINE,
+               "bcd_time_detector per-sample fields no longer fit in one cache line");
+
 /*============================================================================
  * BCD Frequency Detector Internal Structure
  *============================================================================*/
 
 struct bcd_freq_detector {
-    /* FFT resources */
-    fft_processor_t *fft;
-
-    /* Sample buffer for FFT */
-    float *i_buffer;
-    float *q_buffer;
+    /*------------------------------------------------------------------
+     * Hot: every sample (frame buffer). One cache line, checked below.
+     *------------------------------------------------------------------*/
+    _Alignas(WWV_CACHE_LINE) bool detection_enabled;
+    bool sliding;               /* bcd_freq_detector_create_sliding() */
+    bool idle;                  /* bcd_freq_detector_set_idle(): 1 FFT in BCD_FREQ_IDLE_DECIM */
     int buffer_idx;
+    float *i_buffer;            /* FFT frame, or BCD_FREQ_SLIDING_DECIM samples */
+    float *q_buffer;
+    polyphase_resampler_t *decim;   /* Sliding: 50 kHz -> 1562.5 Hz, else NULL */
+
+    wwv_perf_t *perf;      /* Stage timing, NULL = off */
+
+    /*------------------------------------------------------------------
+     * Warm: once per FFT frame (once per hop when sliding)
+     *------------------------------------------------------------------*/
+
+    /* FFT resources (fft is NULL when sliding) */
+    _Alignas(WWV_CACHE_LINE) fft_processor_t *fft;
+    int fft_band;               /* Registered target bucket */
+    sliding_dft_t *sdft;        /* Sliding: same window and bins at 1562.5 Hz */
+    float *dec_i;               /* Decimator output, one pass */
+    float *dec_q;
+
+    /* Frame geometry: "frame" is one state machine step, an FFT frame or a hop */
+    int frame_samples;          /* Input samples per frame */
+    int frame_hops;             /* Frames per FFT frame: 1, or BCD_FREQ_SLIDING_HOPS */
+    int frame_lag;              /* Input samples a frame's timestamp lags its count */
+    float frame_ms;
 
     /* Sliding window accumulator */
-    float *energy_history;
-    int history_idx;
-    int history_count;
-    float accumulated_energy;
+    sliding_sum_t *energy_sum;
+    int energy_window;
+    float accumulated_energy;   /* Window sum, this frame */
     float baseline_energy;
 
     /* Detection state */
-    detector_state_t state;
     float current_energy;
     float threshold;
 
-    /* Pulse measurement */
-    uint64_t pulse_start_frame;
-    float pulse_peak_energy;
-    int pulse_duration_frames;
-    int cooldown_frames;
-
-    /* Phase 9: Minimum duration validation */
-    int consecutive_low_frames;
+    /* State machine and pulse measurement */
+    pulse_fsm_t pulse;
+    pulse_fsm_params_t pulse_params;
 
     /* Statistics */
     int pulses_detected;
     int pulses_rejected;
     uint64_t last_pulse_frame;
     uint64_t frame_count;
+    uint64_t fft_count;         /* Frame FFTs run (idle frames included) */
     uint64_t start_frame;
+    uint64_t resume_frame;      /* No pulses or adaptation before this frame (after idle) */
     bool warmup_complete;
 
-    /* Enabled flag */
-    bool detection_enabled;
+    /*------------------------------------------------------------------
+     * Cold: events, logging, setup
+     *------------------------------------------------------------------*/
 
     /* Callback */
-    bcd_freq_callback_fn callback;
+    _Alignas(WWV_CACHE_LINE) bcd_freq_callback_fn callback;
     void *callback_user_data;
 
     /* Logging */
-    FILE *csv_file;
+    wwv_csv_log_t *csv_log;
+    telem_ctx_t *telem;    /* Telemetry destination, NULL = default context */
     time_t start_time;
 };
 
+_Static_assert(offsetof(struct bcd_freq_detector, fft) <= WWV_CACHE_LINE,
+               "bcd_freq_detector per-sample fields no longer fit in one cache line");
+
 /*============================================================================
  * Common Helper Functions
  *============================================================================*/
 
 /**
- * Get wall clock time string for CSV output
+ * Get wall clock time of a detector timestamp
+ */
+static inline time_t bcd_get_wall_time(time_t start_time, double timestamp_ms) {
+    return start_time + (time_t)(timestamp_ms / 1000.0f);
+}
+
+/**
+ * Get wall clock time string for console and telemetry output
  */
-static inline void bcd_get_wall_time_str(time_t start_time, float timestamp_ms, 
+static inline void bcd_get_wall_time_str(time_t start_time, double timestamp_ms, 
                                          char *buf, size_t buflen) {
-    time_t event_time = start_time + (time_t)(timestamp_ms / 1000.0f);
-    struct tm *tm_info = localtime(&event_time);
+    time_t event_time = bcd_get_wall_time(start_time, timestamp_ms);
+    struct tm *tm_info = wwv_localtime(&event_time);
     strftime(buf, buflen, "%H:%M:%S", tm_info);
 }
 
@@ -173,6 +217,11 @@ static inline void bcd_get_wall_time_str(time_t start_time, float timestamp_ms,
  */
 float bcd_time_calculate_bucket_energy(bcd_time_detector_t *td);
 
+/**
+ * Reset the state machine and set its timing (at creation)
+ */
+void bcd_time_init_state_machine(bcd_time_detector_t *td);
+
 /**
  * Run the time detector state machine
  * Called once per FFT frame after energy calculation
@@ -193,12 +242,23 @@ float bcd_freq_calculate_bucket_energy(bcd_freq_detector_t *fd);
  */
 void bcd_freq_update_accumulator(bcd_freq_detector_t *fd, float energy);
 
+/**
+ * Reset the state machine and set its timing (frame geometry set first)
+ */
+void bcd_freq_init_state_machine(bcd_freq_detector_t *fd);
+
 /**
  * Run the frequency detector state machine
  * Called once per FFT frame after energy calculation
  */
 void bcd_freq_run_state_machine(bcd_freq_detector_t *fd);
 
+/**
+ * Idle frame (bcd_freq_detector_set_idle): accumulator and baseline only,
+ * no pulses. current_energy holds the last computed frame's energy.
+ */
+void bcd_freq_idle_state_machine(bcd_freq_detector_t *fd);
+
 #ifdef __cplusplus
 }
 #endif
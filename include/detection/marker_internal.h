@@ -12,6 +12,13 @@
 #include "marker_detector.h"
 #include "wwv_clock.h"
 #include "fft_processor.h"
+#include "wwv_csv_log.h"
+#include "wwv_timebase.h"
+#include "sliding_sum.h"
+#include "baseband_frontend.h"
+#include "detection/pulse_fsm_internal.h"
+#include "wwv_arena.h"
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdio.h>
@@ -41,8 +48,19 @@ extern "C" {
 /* Display */
 #define MARKER_FLASH_FRAMES         30      /* UI flash duration */
 
+/* Template mode: quiet second before the marker (the :59 tick hole), the
+ * 800 ms marker, then the quiet before the :01 tick */
+#define MARKER_TPL_PRE_MS           1000.0f
+#define MARKER_TPL_POST_MS          200.0f
+#define MARKER_TPL_HOLD_MS          200.0f  /* No higher score this long = peak */
+#define MARKER_TPL_EDGE_FRAMES      4       /* Edge search either side of the template edge */
+
 #define MS_TO_FRAMES(ms)    ((int)((ms) / FRAME_DURATION_MS + 0.5f))
 
+/* Absolute frame times from the 64-bit sample clock (frames do not overlap) */
+#define FRAME_TO_SAMPLE(f)  ((wwv_sample_t)(f) * MARKER_FFT_SIZE)
+#define FRAME_TO_MS(f)      wwv_samples_to_ms(FRAME_TO_SAMPLE(f), MARKER_SAMPLE_RATE)
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846f
 #endif
@@ -51,72 +69,100 @@ extern "C" {
  * Internal State Types
  *============================================================================*/
 
-typedef enum {
-    STATE_IDLE,
-    STATE_IN_MARKER,
-    STATE_COOLDOWN
-} detector_state_t;
+typedef struct marker_template marker_template_t;
 
 /*============================================================================
  * Detector State Structure
  *============================================================================*/
 
 struct marker_detector {
-    /* FFT resources */
-    fft_processor_t *fft;
+    /*------------------------------------------------------------------
+     * Hot: every sample (frame buffer or Goertzel bank). One cache line,
+     * checked below.
+     *------------------------------------------------------------------*/
+    _Alignas(WWV_CACHE_LINE) bool detection_enabled;
+    spectral_mode_t spectral_mode;
+    goertzel_bank_t *goertzel;      /* Created on first switch to SPECTRAL_MODE_GOERTZEL */
 
     /* Sample buffer for FFT */
     float *i_buffer;
     float *q_buffer;
     int buffer_idx;
+    int frame_samples;              /* MARKER_FFT_SIZE, or 16 on the baseband stream */
+
+    wwv_perf_t *perf;      /* Stage timing, NULL = off */
 
-    /* Sliding window accumulator */
-    float *energy_history;          /* Circular buffer of frame energies */
-    int history_idx;                /* Write position */
-    int history_count;              /* Frames accumulated so far */
-    float accumulated_energy;       /* Sum of energy_history */
+    /*------------------------------------------------------------------
+     * Warm: once per FFT frame
+     *------------------------------------------------------------------*/
+
+    /* FFT resources */
+    _Alignas(WWV_CACHE_LINE) fft_processor_t *fft;
+    int fft_band;               /* Registered target bucket */
+
+    /* Baseband only: lower sideband FFT (same band id) and its frame buffer */
+    fft_processor_t *fft_lower;
+    float *lower_i_buffer;
+    float *lower_q_buffer;
+    int goertzel_band;
+
+    /* Sliding window accumulators (MARKER_WINDOW_* over one energy stream) */
+    sliding_sum_t *energy_sums;
+    int window_id[MARKER_WINDOW_COUNT];
+    float accumulated_energy;       /* MARKER_WINDOW_FULL sum, this frame */
     float baseline_energy;          /* Self-tracked noise floor */
 
     /* Detection state */
-    detector_state_t state;
     float current_energy;           /* Current frame's 1000Hz bucket energy */
     float threshold;                /* Detection threshold */
 
-    /* Marker measurement */
-    uint64_t marker_start_frame;
-    float marker_peak_energy;
-    int marker_duration_frames;
-    int cooldown_frames;
+    /* State machine and marker measurement */
+    pulse_fsm_t pulse;
+    pulse_fsm_params_t pulse_params;
 
     /* Statistics */
     int markers_detected;
     uint64_t last_marker_frame;
     uint64_t frame_count;
     uint64_t start_frame;
+    uint64_t refill_until;          /* After a skip: windows refill, no detection before this frame */
     bool warmup_complete;
 
     /* UI feedback */
     int flash_frames_remaining;
-    bool detection_enabled;
 
     /* Tunable parameters (runtime adjustable via UDP commands) */
     float threshold_multiplier;     /* Threshold above baseline (2.0-5.0, default 3.0) */
     float noise_adapt_rate;         /* Baseline adaptation rate (0.0001-0.01, default 0.001) */
     float min_duration_ms;          /* Minimum pulse duration (300.0-700.0, default 500.0) */
 
+    /* Logging (debug_log writes a row per frame) */
+    wwv_csv_log_t *debug_log;
+
+    /* Template mode (marker_template.c), created on first switch */
+    bool template_mode;
+    marker_template_t *tpl;
+
+    /*------------------------------------------------------------------
+     * Cold: events, logging, setup
+     *------------------------------------------------------------------*/
+
     /* Callback */
-    marker_callback_fn callback;
+    _Alignas(WWV_CACHE_LINE) marker_callback_fn callback;
     void *callback_user_data;
 
     /* Logging */
-    FILE *csv_file;
-    FILE *debug_file;
+    wwv_csv_log_t *csv_log;
+    telem_ctx_t *telem;    /* Telemetry destination, NULL = default context */
     time_t start_time;
 
     /* WWV clock for expected event lookup */
     wwv_clock_t *wwv_clock;
 };
 
+_Static_assert(offsetof(struct marker_detector, fft) <= WWV_CACHE_LINE,
+               "marker_detector per-sample fields no longer fit in one cache line");
+
 /*============================================================================
  * Internal Function Declarations
  *============================================================================*/
@@ -124,8 +170,26 @@ struct marker_detector {
 /* From marker_state_machine.c */
 void marker_state_machine_run(marker_detector_t *md);
 
+/**
+ * Log, count and deliver one marker (both detection modes)
+ * @param end_sample Trailing edge (the event's timestamp)
+ * @param onset_ms Leading edge
+ * @param start_frame Frame holding the leading edge (spacing between markers)
+ */
+void marker_report(marker_detector_t *md, uint64_t end_sample, double onset_ms, float duration_ms,
+                   float peak, uint64_t start_frame);
+
+/* From marker_template.c */
+marker_template_t *marker_template_create(void);
+void marker_template_destroy(marker_template_t *tpl);
+void marker_template_reset(marker_template_t *tpl);
+void marker_template_skip(marker_template_t *tpl);
+void marker_template_run(marker_detector_t *md);
+float marker_template_get_score(const marker_template_t *tpl);
+
 /* Helper functions (remain in marker_detector.c) */
-void marker_get_wall_time_str(marker_detector_t *md, float timestamp_ms, char *buf, size_t buflen);
+time_t marker_get_wall_time(marker_detector_t *md, double timestamp_ms);
+void marker_get_wall_time_str(marker_detector_t *md, double timestamp_ms, char *buf, size_t buflen);
 
 #ifdef __cplusplus
 }
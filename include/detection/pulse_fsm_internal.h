@@ -0,0 +1,185 @@
+/**
+ * @file pulse_fsm_internal.h
+ * @brief Hysteresis and pulse-measurement engine shared by the detectors
+ *
+ * The tick, marker, BCD time and BCD frequency detectors all run the same
+ * per-frame machine on one level (band energy or window sum):
+ *
+ *   IDLE ──level > high──► ACTIVE ──low run / timeout──► COOLDOWN ──► IDLE
+ *
+ * Each detector keeps its own threshold adaptation, gating and reporting
+ * and hands this engine the level and its two thresholds once per frame.
+ *
+ * pulse_fsm_step() branches on the state only: it changes a few times a
+ * second, so that branch predicts, and IDLE below threshold (most frames)
+ * costs one compare. Inside a pulse, where a noisy level flickers across
+ * the low threshold, the low run, peak and exit are formed with masks and
+ * a max instead of data-dependent branches.
+ *
+ * Durations, the end-of-pulse debounce, the timeout and the cooldown are
+ * frame counts fixed by pulse_fsm_params_init() from the detector's frame
+ * length. Duration classes are converted with the same float products the
+ * detectors log (frames * frame_ms), so the integer comparisons agree
+ * exactly with the millisecond ones they replace.
+ *
+ * Private interface between the detectors in src/detection. NOT part of
+ * public API.
+ */
+
+#ifndef PULSE_FSM_INTERNAL_H
+#define PULSE_FSM_INTERNAL_H
+
+#include <stdint.h>
+#include <limits.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PULSE_FSM_MAX_CLASSES   2
+#define PULSE_FSM_NO_TIMEOUT    INT_MAX
+
+/* Step events, OR-ed */
+#define PULSE_EV_START          0x1     /* Level crossed high: measurement began */
+#define PULSE_EV_END            0x2     /* Level stayed below low for min_low_frames */
+#define PULSE_EV_TIMEOUT        0x4     /* Duration passed timeout_frames */
+#define PULSE_EV_STOP           (PULSE_EV_END | PULSE_EV_TIMEOUT)
+
+typedef enum {
+    PULSE_IDLE,
+    PULSE_ACTIVE,
+    PULSE_COOLDOWN
+} pulse_state_t;
+
+/**
+ * Per-detector parameters (shared by every instance of one detector)
+ */
+typedef struct {
+    int min_low_frames;         /* Consecutive frames below low that end a pulse */
+    int timeout_frames;         /* Longest duration before a forced stop */
+    int cooldown_frames;        /* Frames ignored after a stop */
+    float frame_ms;
+
+    /* Duration classes, inclusive frame ranges; the first match wins */
+    int class_count;
+    int class_min[PULSE_FSM_MAX_CLASSES];
+    int class_span[PULSE_FSM_MAX_CLASSES];     /* max - min */
+} pulse_fsm_params_t;
+
+/**
+ * One instance: the state and the measurement of the current pulse
+ */
+typedef struct {
+    uint64_t start_frame;       /* Frame the pulse started on */
+    float peak;                 /* Highest level since the start */
+    int duration;               /* Frames since the start, start frame included */
+    int count;                  /* ACTIVE: low run; COOLDOWN: frames left */
+    pulse_state_t state;
+} pulse_fsm_t;
+
+/*============================================================================
+ * Setup
+ *============================================================================*/
+
+/**
+ * Frame counts from milliseconds
+ * @param timeout_ms Stop once frames * frame_ms > timeout_ms (0 = never)
+ */
+void pulse_fsm_params_init(pulse_fsm_params_t *p, float frame_ms, int min_low_frames,
+                           float timeout_ms, float cooldown_ms);
+
+/**
+ * Set duration class c (0..PULSE_FSM_MAX_CLASSES-1) to
+ * min_ms <= frames * frame_ms <= max_ms; class_count grows to cover it
+ */
+void pulse_fsm_set_class(pulse_fsm_params_t *p, int c, float min_ms, float max_ms);
+
+static inline void pulse_fsm_reset(pulse_fsm_t *f) {
+    f->start_frame = 0;
+    f->peak = 0.0f;
+    f->duration = 0;
+    f->count = 0;
+    f->state = PULSE_IDLE;
+}
+
+/*============================================================================
+ * Per-Frame Step
+ *============================================================================*/
+
+/**
+ * Advance one frame
+ * @param level Frame level compared against both thresholds
+ * @param high  Start threshold (level > high)
+ * @param low   Hysteresis threshold (level < low counts toward the end)
+ * @return PULSE_EV_* events of this frame. On a stop the measurement is
+ *         left in place for the caller and the instance is in COOLDOWN.
+ */
+static inline int pulse_fsm_step(pulse_fsm_t *f, const pulse_fsm_params_t *p,
+                                 float level, float high, float low, uint64_t frame) {
+    switch (f->state) {
+        case PULSE_IDLE:
+            if (!(level > high)) return 0;
+            f->state = PULSE_ACTIVE;
+            f->start_frame = frame;
+            f->peak = level;
+            f->duration = 1;
+            f->count = 0;
+            return PULSE_EV_START;
+
+        case PULSE_ACTIVE: {
+            f->duration++;
+            f->peak = (level > f->peak) ? level : f->peak;
+            f->count = (f->count + 1) & -(int)(level < low);
+
+            /* END and TIMEOUT are bits 1 and 2 */
+            int events = ((f->count >= p->min_low_frames) |
+                          ((f->duration > p->timeout_frames) << 1)) << 1;
+            if (events) {
+                f->state = PULSE_COOLDOWN;
+                f->count = p->cooldown_frames;
+            }
+            return events;
+        }
+
+        case PULSE_COOLDOWN:
+            if (--f->count <= 0) f->state = PULSE_IDLE;
+            return 0;
+    }
+    return 0;
+}
+
+/**
+ * Frame not computed (economy mode): only the cooldown advances
+ */
+static inline void pulse_fsm_skip(pulse_fsm_t *f) {
+    if (f->state == PULSE_COOLDOWN && --f->count <= 0) f->state = PULSE_IDLE;
+}
+
+/**
+ * Drop the cooldown just entered, e.g. for a pulse judged not to be ours
+ */
+static inline void pulse_fsm_rearm(pulse_fsm_t *f) {
+    f->state = PULSE_IDLE;
+}
+
+/**
+ * Duration class of the measured pulse, -1 if none
+ */
+static inline int pulse_fsm_classify(const pulse_fsm_t *f, const pulse_fsm_params_t *p) {
+    int cls = -1;
+    for (int c = p->class_count - 1; c >= 0; c--) {
+        int in = (unsigned)(f->duration - p->class_min[c]) <= (unsigned)p->class_span[c];
+        cls = in ? c : cls;
+    }
+    return cls;
+}
+
+static inline float pulse_fsm_duration_ms(const pulse_fsm_t *f, const pulse_fsm_params_t *p) {
+    return f->duration * p->frame_ms;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PULSE_FSM_INTERNAL_H */
@@ -0,0 +1,45 @@
+/**
+ * @file tick_corr_internal.h
+ * @brief Tick matched filter dot-product kernels
+ *
+ * Private interface between tick_correlation.c and tick_correlation_simd.c
+ * (and the kernel check in wwv_bench). NOT part of public API.
+ */
+
+#ifndef TICK_CORR_INTERNAL_H
+#define TICK_CORR_INTERNAL_H
+
+#include "channel_filters.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Template alignment the vector kernels load with (one AVX register) */
+#define TICK_CORR_ALIGN     32
+
+/*
+ * Complex correlation of a split I/Q signal span against a split template:
+ *   *re = sum xi[k]*ti[k] + xq[k]*tq[k]
+ *   *im = sum xq[k]*ti[k] - xi[k]*tq[k]          k = 0..n-1
+ * i.e. sum (xi + j*xq) * (ti - j*tq). ti/tq must be TICK_CORR_ALIGN-aligned;
+ * xi/xq come straight from a mirrored ring and may have any alignment.
+ * Vector kernels sum in a different order, so they agree with the scalar
+ * kernel to rounding, not bit for bit.
+ */
+typedef void (*tick_corr_dot_fn)(const float *ti, const float *tq,
+                                 const float *xi, const float *xq,
+                                 int n, float *re, float *im);
+
+void tick_corr_dot_scalar(const float *ti, const float *tq,
+                          const float *xi, const float *xq,
+                          int n, float *re, float *im);
+
+/* Kernel for a channel_filters SIMD level (scalar if not compiled in) */
+tick_corr_dot_fn tick_corr_select_kernel(channel_simd_t level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TICK_CORR_INTERNAL_H */
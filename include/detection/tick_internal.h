@@ -10,9 +10,16 @@
 #define TICK_INTERNAL_H
 
 #include "tick_detector.h"
+#include "baseband_frontend.h"
 #include "wwv_clock.h"
-#include "tick_comb_filter.h"
+#include "detection/tick_corr_internal.h"
+#include "detection/pulse_fsm_internal.h"
 #include "fft_processor.h"
+#include "wwv_csv_log.h"
+#include "wwv_timebase.h"
+#include "wwv_window_ring.h"
+#include "wwv_arena.h"
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdio.h>
@@ -45,12 +52,18 @@ extern "C" {
 /* Correlation thresholds */
 #define CORR_THRESHOLD_MULT     5.0f    /* Correlation must be 5x noise floor */
 #define CORR_NOISE_ADAPT        0.01f   /* Noise floor adaptation rate */
-#define CORR_DECIMATION         8       /* Compute correlation every N samples */
+#define CORR_DECIMATION         8       /* Compute correlation every N samples (reference mode) */
+#define TICK_SDFT_BINS          3       /* Hann template = 3 rectangular DFT bins */
+#define TICK_SDFT_RESYNC_SAMPLES 50000  /* Re-seed sliding DFT from buffer once per second */
 #define MARKER_CORR_RATIO       15.0f   /* Corr ratio above this = minute marker */
-#define MARKER_MIN_DURATION_MS  600.0f  /* Marker must be at least 600ms (tightened from 500ms) */
+#define TICK_MARKER_MIN_DURATION_MS  600.0f  /* Marker must be at least 600ms (tightened from 500ms) */
 #define MARKER_MAX_DURATION_MS_CHECK 1500.0f  /* Marker should be under 1500ms */
 #define MARKER_MIN_INTERVAL_MS  55000.0f /* Markers must be 55+ seconds apart */
 
+/* Pulse duration classes (td->pulse_params) */
+#define TICK_CLASS_MARKER       0       /* TICK_MARKER_MIN_DURATION_MS..MARKER_MAX_DURATION_MS_CHECK */
+#define TICK_CLASS_TICK         1       /* min_duration_ms..TICK_MAX_DURATION_MS */
+
 /* Warmup and display */
 #define TICK_WARMUP_FRAMES      50
 #define TICK_FLASH_FRAMES       5
@@ -61,6 +74,10 @@ extern "C" {
 
 #define MS_TO_FRAMES(ms)    ((int)((ms) / FRAME_DURATION_MS + 0.5f))
 
+/* Absolute frame times from the 64-bit sample clock (frames do not overlap) */
+#define FRAME_TO_SAMPLE(f)  ((wwv_sample_t)(f) * TICK_FFT_SIZE)
+#define FRAME_TO_MS(f)      wwv_samples_to_ms(FRAME_TO_SAMPLE(f), TICK_SAMPLE_RATE)
+
 /* Timing gate for exploiting NIST 40ms protected zone */
 #define TICK_GATE_START_MS   0.0f    /* Open gate at second boundary */
 #define TICK_GATE_END_MS   100.0f   /* Close gate 100ms into second (was 25ms - too narrow for HF) */
@@ -68,6 +85,10 @@ extern "C" {
 /* Gate recovery - disable gate if no ticks for too long */
 #define GATE_RECOVERY_MS   5000.0f  /* 5 seconds without tick = disable gate temporarily */
 
+/* Economy mode (tick_detector_set_economy) */
+#define TICK_ECONOMY_GUARD_MS       10.0f   /* Computed either side of the gate */
+#define TICK_ECONOMY_PROBE_FRAMES   16      /* Noise floor probe every 82 ms */
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846f
 #endif
@@ -76,12 +97,6 @@ extern "C" {
  * Internal State Types
  *============================================================================*/
 
-typedef enum {
-    STATE_IDLE,
-    STATE_IN_TICK,
-    STATE_COOLDOWN
-} detector_state_t;
-
 typedef struct {
     float epoch_ms;          /* Second boundary offset (from marker) */
     bool enabled;            /* Gate is active */
@@ -89,72 +104,140 @@ typedef struct {
     bool recovery_mode;      /* True when gate temporarily disabled for recovery */
 } tick_gate_t;
 
-/*============================================================================
- * Detector State Structure
- *============================================================================*/
+/* Matched filter pulse tracking, one per station (read every sample) */
+typedef struct {
+    pulse_fsm_t pulse;          /* Station state machine and tick measurement */
+    float corr_noise_floor;     /* Correlation noise floor estimate */
+    float corr_peak;            /* Peak correlation value this detection */
+    float rival_peak;           /* Other stations' peak correlation during this pulse */
+} tick_corr_track_t;
 
-struct tick_detector {
-    /* FFT resources */
-    fft_processor_t *fft;
+/* Stream the detector is fed: 50 kHz, or the 3125 Hz baseband (read every sample) */
+typedef struct {
+    int decimation;             /* Input samples per stream sample: 1 or BASEBAND_DECIMATION */
+    int frame_samples;          /* Stream samples per FFT frame (5.12 ms either way) */
+    int template_samples;       /* Matched filter length */
+    int corr_step;              /* Reference MAC and epoch scan step */
+    float corr_scale;           /* Correlation gain to the full-rate level */
+} tick_stream_t;
+
+/* Sliding DFT bin (tick_correlation.c) */
+typedef struct {
+    double re, im;              /* S_b(n) */
+    double rot_re, rot_im;      /* e^{+j*b} */
+    double in_re, in_im;        /* e^{-j*b*(N-1)} */
+} tick_sdft_bin_t;
 
-    /* Sample buffer for FFT */
-    float *i_buffer;
-    float *q_buffer;
-    int buffer_idx;
+/* Per-station energy detector, gate and statistics (once per FFT frame) */
+typedef struct {
+    wwv_station_t station;
+    int target_hz;              /* 1000 (WWV) or 1200 (WWVH) */
+    int fft_band;               /* Registered target bucket */
 
-    /* Matched filter resources */
-    float *template_i;          /* Cosine template */
-    float *template_q;          /* Sine template */
-    float *corr_buf_i;          /* Circular buffer for correlation */
-    float *corr_buf_q;
-    int corr_buf_idx;           /* Write position in circular buffer */
-    int corr_sample_count;      /* Total samples received */
-    float corr_peak;            /* Peak correlation value this detection */
-    float corr_sum;             /* Accumulated correlation during pulse */
-    int corr_sum_count;         /* Number of correlation samples accumulated */
-    int corr_peak_offset;       /* Sample offset of peak */
-    float corr_noise_floor;     /* Correlation noise floor estimate */
+    /* Reference-mode matched filter (every CORR_DECIMATION samples) */
+    const float *template_i;    /* Cosine template (shared, read-only, padded) */
+    const float *template_q;    /* Sine template (shared, read-only, padded) */
 
     /* Detection state */
-    detector_state_t state;
     float noise_floor;
     float threshold_high;
     float threshold_low;
     float current_energy;
 
-    /* Tick measurement */
-    uint64_t tick_start_frame;
-    float tick_peak_energy;
-    int tick_duration_frames;
-    int cooldown_frames;
-
     /* Statistics */
     int ticks_detected;
     int ticks_rejected;
+    int crosstalk_rejected;     /* Pulses attributed to another station */
     int markers_detected;       /* Position/minute markers (long pulses) */
     uint64_t last_tick_frame;
     uint64_t last_marker_frame;
-    uint64_t frame_count;
-    uint64_t start_frame;
     bool warmup_complete;
 
-    /* History for interval averaging */
-    float tick_timestamps_ms[TICK_HISTORY_SIZE];
+    /* UI feedback */
+    int flash_frames_remaining;
+
+    /* Timing gate */
+    tick_gate_t gate;
+    epoch_source_t epoch_source;
+    float epoch_confidence;
+
+    /* History for interval averaging and the measured epoch */
+    double tick_timestamps_ms[TICK_HISTORY_SIZE];
     int tick_history_idx;
     int tick_history_count;
 
-    /* UI feedback */
-    int flash_frames_remaining;
+    /* WWV broadcast clock for this station */
+    wwv_clock_t *wwv_clock;
+} tick_channel_t;
+
+/*============================================================================
+ * Detector State Structure
+ *============================================================================*/
+
+struct tick_detector {
+    /*------------------------------------------------------------------
+     * Hot: every sample (matched filter, frame buffer). A single-station
+     * detector touches the fields up to its three sliding DFT bins, five
+     * cache lines (checked below); a second station adds three more bins.
+     *------------------------------------------------------------------*/
+
+    /* Matched filter history */
+    _Alignas(WWV_CACHE_LINE) wwv_window_ring_t corr_ring_i;  /* Mirrored history: template span is contiguous */
+    wwv_window_ring_t corr_ring_q;
+    wwv_sample_t corr_sample_count; /* Total samples received */
+    int sdft_resync_countdown;
+    tick_corr_mode_t corr_mode; /* Sliding DFT or decimated reference MAC */
+    int station_count;          /* Channels in use, 1..TICK_MAX_STATIONS */
+    tick_stream_t stream;
+
+    /* Sample buffer for FFT */
+    int buffer_idx;
     bool detection_enabled;
+    bool frame_skipped;         /* Economy mode: current frame is not computed */
+    float *i_buffer;
+    float *q_buffer;
+
+    /* Correlation tracking, per station */
+    tick_corr_track_t corr[TICK_MAX_STATIONS];
+
+    /* Sliding DFT bins, TICK_SDFT_BINS per station */
+    tick_sdft_bin_t sdft[TICK_MAX_STATIONS * TICK_SDFT_BINS];
+
+    /*------------------------------------------------------------------
+     * Warm: once per FFT frame (energy, state machine, gate)
+     *------------------------------------------------------------------*/
 
-    /* Tunable parameters (runtime adjustable via UDP commands) */
+    /* FFT resources (one frame feeds every station's band) */
+    _Alignas(WWV_CACHE_LINE) fft_processor_t *fft;
+    fft_processor_t *fft_lower; /* Baseband: lower sideband frame, same band ids */
+    float *lower_i_buffer;      /* Baseband: lower sideband frame samples */
+    float *lower_q_buffer;
+    wwv_perf_t *perf;           /* Stage timing, NULL = off */
+    tick_corr_dot_fn corr_dot;  /* Reference MAC kernel (tick_correlation_simd.c) */
+
+    uint64_t frame_count;
+    uint64_t start_frame;
+
+    /* Economy mode: compute only the frames around the gate */
+    bool economy;
+    uint64_t frames_skipped;
+
+    /* Tunable parameters (runtime adjustable via UDP commands, all stations) */
     float threshold_multiplier;     /* Detection sensitivity (1.0-5.0, default 2.0) */
     float adapt_alpha_down;         /* Noise floor decay rate (0.9-0.999, default 0.995) */
     float adapt_alpha_up;           /* Noise floor rise rate (0.001-0.1, default 0.02) */
     float min_duration_ms;          /* Minimum pulse width (1.0-10.0, default 2.0) */
+    pulse_fsm_params_t pulse_params;    /* Station state machine timing and duration classes */
+
+    /* Per-station detectors */
+    tick_channel_t ch[TICK_MAX_STATIONS];
+
+    /*------------------------------------------------------------------
+     * Cold: events, logging, setup
+     *------------------------------------------------------------------*/
 
     /* Callback */
-    tick_callback_fn callback;
+    _Alignas(WWV_CACHE_LINE) tick_callback_fn callback;
     void *callback_user_data;
 
     /* Marker callback */
@@ -162,36 +245,48 @@ struct tick_detector {
     void *marker_callback_user_data;
 
     /* Logging */
-    FILE *csv_file;
+    wwv_csv_log_t *csv_log;
+    telem_ctx_t *telem;    /* Telemetry destination, NULL = default context */
     time_t start_time;          /* Wall clock time when detector started */
+};
 
-    /* WWV broadcast clock */
-    wwv_clock_t *wwv_clock;
+_Static_assert(offsetof(struct tick_detector, sdft) + TICK_SDFT_BINS * sizeof(tick_sdft_bin_t)
+               <= 5 * WWV_CACHE_LINE,
+               "tick_detector per-sample fields no longer fit in five cache lines");
 
-    /* Timing gate */
-    tick_gate_t gate;
-    epoch_source_t epoch_source;
-    float epoch_confidence;
+/* Stream sample rate */
+static inline int tick_stream_rate(const tick_detector_t *td) {
+    return TICK_SAMPLE_RATE / td->stream.decimation;
+}
 
-    /* Comb filter for weak signal detection */
-    comb_filter_t *comb_filter;
-};
+/* Input sample (TICK_SAMPLE_RATE) a fractional stream position stands for */
+static inline double tick_stream_to_input(const tick_detector_t *td, double pos) {
+    if (td->stream.decimation == 1) return pos;
+    return pos * td->stream.decimation + BASEBAND_SAMPLE_OFFSET;
+}
 
 /*============================================================================
  * Internal Function Declarations
  *============================================================================*/
 
-/* From tick_correlation.c */
-void tick_correlation_init(tick_detector_t *td);
-float tick_correlation_compute(tick_detector_t *td);
+/* From tick_correlation.c (station channels must be set up first) */
+bool tick_correlation_init(tick_detector_t *td);
+float tick_correlation_compute(tick_detector_t *td, int s);
+void tick_correlation_slide(tick_detector_t *td, float i_sample, float q_sample, float *corr);
+void tick_correlation_reset_sliding(tick_detector_t *td);
+bool tick_correlation_refine_epoch(tick_detector_t *td, int s, uint64_t start_frame,
+                                   double *pulse_start);
 
 /* From tick_state_machine.c */
-void tick_state_machine_run(tick_detector_t *td);
-bool tick_state_is_gate_open(tick_detector_t *td, float current_ms);
+void tick_state_machine_run(tick_detector_t *td, int s);
+bool tick_state_is_gate_open(const tick_channel_t *ch, double current_ms);
+bool tick_state_frame_needed(const tick_detector_t *td, uint64_t frame);
+void tick_state_machine_skip(tick_detector_t *td, int s);
 
 /* Helper functions (remain in tick_detector.c) */
-float tick_calculate_avg_interval(tick_detector_t *td, float current_time_ms);
-void tick_get_wall_time_str(tick_detector_t *td, float timestamp_ms, char *buf, size_t buflen);
+float tick_calculate_avg_interval(const tick_channel_t *ch, double current_time_ms);
+time_t tick_get_wall_time(tick_detector_t *td, double timestamp_ms);
+void tick_get_wall_time_str(tick_detector_t *td, double timestamp_ms, char *buf, size_t buflen);
 
 #ifdef __cplusplus
 }
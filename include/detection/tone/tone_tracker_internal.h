@@ -7,7 +7,14 @@
 #define TONE_TRACKER_INTERNAL_H
 
 #include "tone_tracker.h"
+#include "channel_quality.h"
 #include "fft_processor.h"
+#include "wwv_csv_log.h"
+#include "wwv_timebase.h"
+#include "wwv_window_ring.h"
+#include "zoom_dft.h"
+#include "wwv_arena.h"
+#include <stddef.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -29,17 +36,53 @@
  *============================================================================*/
 
 struct tone_tracker {
-    float nominal_hz;           /* 500 or 600 */
-
-    /* Sample buffer */
-    float *buffer_i;
-    float *buffer_q;
-    int buffer_idx;
-    int samples_collected;
+    /*------------------------------------------------------------------
+     * Hot: every sample (window rings, zoom decimator). Five cache
+     * lines, most of it the read-only decimator taps; checked below.
+     *------------------------------------------------------------------*/
+
+    /* Sample window (mirrored, handed to the FFT in place) */
+    _Alignas(WWV_CACHE_LINE) wwv_window_ring_t ring_i;
+    wwv_window_ring_t ring_q;
+    wwv_sample_t sample_count;  /* Total input samples */
+    int samples_collected;      /* Since the last estimate */
+    int hop_size;
+
+    /* Adaptive zoom (decimated window, same Hz/bin) */
+    bool zoom_enabled;
+    int zoom_phase;             /* Input samples since the last decimated output */
+    int zoom_fill;              /* Decimated samples in the zoom window (saturates) */
+    wwv_window_ring_t zoom_ring_i;
+    wwv_window_ring_t zoom_ring_q;
+    float zoom_taps[TONE_ZOOM_TAPS];
+
+    /*------------------------------------------------------------------
+     * Warm: once per estimate (every hop)
+     *------------------------------------------------------------------*/
 
     /* FFT */
-    fft_processor_t *fft;
+    _Alignas(WWV_CACHE_LINE) fft_processor_t *fft;
     float *magnitudes;
+    fft_processor_t *zoom_fft;
+    bool zoomed;                /* Current estimates come from the zoom FFT */
+    int lock_count;             /* Consecutive valid estimates */
+
+    /* Fine refinement, one per window length (NULL when disabled) */
+    zoom_dft_t *refine;
+    zoom_dft_t *zoom_refine;
+
+    float nominal_hz;           /* 500 or 600 */
+
+    /* Shared window/FFT this tracker estimates from (NULL = its own) */
+    struct tone_spectrum *spectrum;
+
+    /* Demand: a hop passed with no consumer, the estimate is out of date */
+    bool demand_driven;
+    bool stale;
+    tone_callback_fn callback;
+    void *callback_user_data;
+    telem_ctx_t *telem;
+    telem_channel_t telem_channel;
 
     /* Results */
     float measured_hz;
@@ -49,12 +92,41 @@ struct tone_tracker {
     float noise_floor_linear;   /* Linear noise floor for marker baseline */
     bool valid;
 
-    /* Logging */
-    FILE *csv_file;
+    /* Instrumentation */
+    wwv_perf_t *perf;           /* Stage timing, NULL = off */
+
+    /* Logging (a row per estimate) */
+    wwv_csv_log_t *csv_log;
     uint64_t frame_count;
     time_t start_time;
 };
 
+_Static_assert(offsetof(struct tone_tracker, fft) <= 5 * WWV_CACHE_LINE,
+               "tone_tracker per-sample fields no longer fit in five cache lines");
+
+struct tone_spectrum {
+    wwv_window_ring_t ring_i;
+    wwv_window_ring_t ring_q;
+    wwv_sample_t sample_count;
+    int samples_collected;
+    int hop_size;
+    bool stale;                 /* A hop passed without computing the FFT */
+    wwv_sample_t window_end;    /* sample_count at the last computed hop */
+
+    fft_processor_t *fft;
+    float *magnitudes;          /* TONE_FFT_SIZE, last computed hop */
+
+    tone_tracker_t *trackers[TONE_SPECTRUM_MAX_TRACKERS];
+    int tracker_count;
+
+    tone_spectrum_fn tap;
+    void *tap_user_data;
+    channel_quality_t *quality;     /* Fed each computed hop, NULL = off */
+
+    wwv_perf_t *perf;
+    uint64_t fft_count;
+};
+
 /*============================================================================
  * FFT Helper Functions
  *============================================================================*/
@@ -73,7 +145,7 @@ void tone_generate_blackman_harris(float *window, int size);
  * @param fft_size FFT size
  * @return Fractional peak bin location
  */
-float tone_parabolic_peak(float *mag, int peak_bin, int fft_size);
+float tone_parabolic_peak(const float *mag, int peak_bin, int fft_size);
 
 /**
  * Find peak bin in specified range
@@ -83,7 +155,7 @@ float tone_parabolic_peak(float *mag, int peak_bin, int fft_size);
  * @param fft_size FFT size
  * @return Peak bin index
  */
-int tone_find_peak_bin(float *mag, int start, int end, int fft_size);
+int tone_find_peak_bin(const float *mag, int start, int end, int fft_size);
 
 /**
  * Estimate noise floor excluding signal region
@@ -93,7 +165,7 @@ int tone_find_peak_bin(float *mag, int start, int end, int fft_size);
  * @param exclude_range Range around center to exclude
  * @return Estimated noise floor (linear)
  */
-float tone_estimate_noise_floor(float *mag, int fft_size, int exclude_bin, int exclude_range);
+float tone_estimate_noise_floor(const float *mag, int fft_size, int exclude_bin, int exclude_range);
 
 /*============================================================================
  * Measurement Functions
@@ -107,10 +179,49 @@ float tone_estimate_noise_floor(float *mag, int fft_size, int exclude_bin, int e
  */
 void tone_measure_frequency(tone_tracker_t *tt);
 
+/**
+ * Measure from a magnitude spectrum of n bins (TONE_HZ_PER_BIN spacing);
+ * zoom selects the zoom-window refinement
+ */
+void tone_measure_magnitudes(tone_tracker_t *tt, const float *mag, int n, bool zoom);
+
+/**
+ * Measure, log, send and call back one estimate (tone_tracker.c)
+ */
+void tone_tracker_estimate(tone_tracker_t *tt);
+
+/**
+ * True while a consumer takes every estimate (tone_tracker.c)
+ */
+bool tone_tracker_wants_every_hop(tone_tracker_t *tt);
+
+/**
+ * Compute a stale shared spectrum and estimate its stale trackers
+ * (tone_spectrum.c)
+ */
+void tone_spectrum_refresh(struct tone_spectrum *ts);
+
+/**
+ * Advance the zoom lock state after an estimate (tone_tracker.c)
+ */
+void tone_update_zoom_lock(tone_tracker_t *tt);
+
 /**
  * Log measurement to CSV file (if enabled)
  * @param tt Tone tracker instance
  */
 void tone_log_measurement(tone_tracker_t *tt);
 
+/**
+ * Send the measurement on the tracker's telemetry channel (if enabled)
+ */
+void tone_send_measurement(tone_tracker_t *tt);
+
+/**
+ * Start of the window the current FFT covers, on the sample clock
+ */
+static inline double tone_window_start_ms(const tone_tracker_t *tt) {
+    return wwv_samples_to_ms(tt->sample_count - TONE_FFT_SIZE, TONE_SAMPLE_RATE);
+}
+
 #endif /* TONE_TRACKER_INTERNAL_H */
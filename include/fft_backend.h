@@ -0,0 +1,66 @@
+/**
+ * @file fft_backend.h
+ * @brief Compile-time selectable forward complex FFT backend
+ *
+ * fft_plan_cache builds one backend plan per (size, window); fft_processor
+ * executes it. All backends use kiss_fft_cpx ({float r, i}, interleaved)
+ * as the exchange format, which is layout-compatible with fftwf_complex
+ * and pffft's interleaved complex ordering.
+ *
+ * Backend selection (define at most one when building the library):
+ *   (default)              Vendored KissFFT, no external dependency; radix-4/2
+ *                          stages run vectorized at channel_filters_get_simd()
+ *                          (fft_kiss_simd.c), bit-identical to kiss_fft()
+ *   WWV_FFT_BACKEND_FFTW   FFTW3 single precision, link -lfftw3f
+ *   WWV_FFT_BACKEND_PFFFT  pffft (pffft.h/pffft.c on the include path)
+ *
+ * Output is unnormalized (sum x[n] e^{-j2pi kn/N}) for every backend.
+ */
+
+#ifndef FFT_BACKEND_H
+#define FFT_BACKEND_H
+
+#include "external/kiss_fft.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(WWV_FFT_BACKEND_FFTW) && defined(WWV_FFT_BACKEND_PFFFT)
+#error "Select only one of WWV_FFT_BACKEND_FFTW / WWV_FFT_BACKEND_PFFFT"
+#endif
+
+typedef struct fft_backend_plan fft_backend_plan_t;
+
+/**
+ * Create forward plan for fft_size points
+ * @param bytes_out Optional: memory held by the plan
+ * @return Plan, or NULL if the size is unsupported or allocation fails
+ */
+fft_backend_plan_t *fft_backend_plan_create(int fft_size, size_t *bytes_out);
+
+void fft_backend_plan_destroy(fft_backend_plan_t *plan);
+
+/**
+ * Run forward FFT. Safe to call concurrently on one plan with distinct
+ * in/out buffers from fft_backend_alloc().
+ */
+void fft_backend_forward(const fft_backend_plan_t *plan, const kiss_fft_cpx *in, kiss_fft_cpx *out);
+
+/**
+ * Allocate/free work buffers with the alignment the backend requires
+ */
+kiss_fft_cpx *fft_backend_alloc(int fft_size);
+void fft_backend_free(kiss_fft_cpx *buf);
+
+/**
+ * Name of the compiled-in backend ("kissfft", "fftw3f", "pffft")
+ */
+const char *fft_backend_name(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FFT_BACKEND_H */
@@ -0,0 +1,84 @@
+/**
+ * @file fft_plan_cache.h
+ * @brief Process-wide cache of FFT plans and analysis windows
+ *
+ * FFT backend plans (twiddle tables) and window coefficients depend only on
+ * (size, window type) and are read-only once built. Every fft_processor
+ * with the same key shares one refcounted entry, so N managers with the
+ * same detector set allocate each table once.
+ *
+ * Thread-safe: acquire/release are serialized by an internal lock, and a
+ * plan's tables are never written after acquire returns.
+ */
+
+#ifndef FFT_PLAN_CACHE_H
+#define FFT_PLAN_CACHE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct fft_backend_plan;
+
+/**
+ * Analysis window applied before the FFT
+ */
+typedef enum {
+    FFT_WINDOW_HANN = 0,        /* Default for all detectors */
+    FFT_WINDOW_RECTANGULAR,     /* No taper (all ones) */
+    FFT_WINDOW_BLACKMAN         /* Lower sidelobes, wider main lobe */
+} fft_window_t;
+
+/**
+ * Opaque shared plan handle
+ */
+typedef struct fft_plan fft_plan_t;
+
+/**
+ * Cache statistics
+ */
+typedef struct {
+    int plans;                  /* Distinct (size, window) entries */
+    int references;             /* Outstanding acquires across all entries */
+    int hits;                   /* Acquires served from the cache */
+    int misses;                 /* Acquires that built a new entry */
+    size_t bytes;               /* Memory held by cached tables */
+} fft_plan_cache_stats_t;
+
+/**
+ * Get shared plan for (fft_size, window), building it on first use
+ * @return Plan handle, or NULL on invalid size or allocation failure
+ */
+const fft_plan_t *fft_plan_acquire(int fft_size, fft_window_t window);
+
+/**
+ * Drop one reference; the entry is freed when the last user releases it
+ * @param plan Plan from fft_plan_acquire() (NULL safe)
+ */
+void fft_plan_release(const fft_plan_t *plan);
+
+/**
+ * Get forward FFT backend plan (see fft_backend.h)
+ */
+const struct fft_backend_plan *fft_plan_get_backend(const fft_plan_t *plan);
+
+/**
+ * Get window coefficients [fft_size]
+ */
+const float *fft_plan_get_window(const fft_plan_t *plan);
+
+int fft_plan_get_size(const fft_plan_t *plan);
+fft_window_t fft_plan_get_window_type(const fft_plan_t *plan);
+
+/**
+ * Snapshot cache statistics
+ */
+void fft_plan_cache_get_stats(fft_plan_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FFT_PLAN_CACHE_H */
@@ -10,6 +10,7 @@
  * - FFT configuration and resource management
  * - Windowed I/Q sample processing
  * - Frequency bucket energy extraction
+ * - Pre-registered band queries (magnitude or power, no full-spectrum pass)
  */
 
 #ifndef FFT_PROCESSOR_H
@@ -17,6 +18,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "fft_plan_cache.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -27,8 +29,19 @@ extern "C" {
  */
 typedef struct fft_processor fft_processor_t;
 
+/** Maximum bands per processor for fft_processor_add_band() */
+#define FFT_PROCESSOR_MAX_BANDS  4
+
 /**
- * Create FFT processor
+ * Band query result type
+ */
+typedef enum {
+    FFT_BAND_MAGNITUDE = 0,     /* Sum of |X| / N (same scale as get_bucket_energy) */
+    FFT_BAND_POWER              /* Sum of |X|^2 / N^2, no square root */
+} fft_band_mode_t;
+
+/**
+ * Create FFT processor (Hann window)
  *
  * @param fft_size FFT size (must be power of 2)
  * @param sample_rate Sample rate in Hz
@@ -36,6 +49,19 @@ typedef struct fft_processor fft_processor_t;
  */
 fft_processor_t *fft_processor_create(int fft_size, float sample_rate);
 
+/**
+ * Create FFT processor with a specific analysis window
+ *
+ * Plan and window tables are shared with every processor of the same
+ * (fft_size, window) through fft_plan_cache.
+ *
+ * @param fft_size FFT size (must be power of 2)
+ * @param sample_rate Sample rate in Hz
+ * @param window Analysis window type
+ * @return FFT processor handle, or NULL on allocation failure
+ */
+fft_processor_t *fft_processor_create_windowed(int fft_size, float sample_rate, fft_window_t window);
+
 /**
  * Destroy FFT processor and free resources
  *
@@ -46,7 +72,7 @@ void fft_processor_destroy(fft_processor_t *fft);
 /**
  * Process windowed I/Q samples and compute FFT
  *
- * Applies Hann window and runs FFT on provided samples.
+ * Applies the analysis window and runs FFT on provided samples.
  *
  * @param fft Processor handle
  * @param i_samples I (in-phase) samples [fft_size]
@@ -68,6 +94,43 @@ bool fft_processor_process(fft_processor_t *fft, const float *i_samples, const f
  */
 float fft_processor_get_bucket_energy(fft_processor_t *fft, float target_freq, float bandwidth);
 
+/**
+ * Register a band for repeated per-frame queries
+ *
+ * Bin ranges for target_freq +/- bandwidth (both sidebands) are resolved
+ * once here, so fft_processor_get_band() only touches those bins.
+ *
+ * @param fft Processor handle
+ * @param target_freq Target frequency in Hz
+ * @param bandwidth Bandwidth in Hz
+ * @param mode Magnitude or power sum
+ * @return Band id, or -1 if FFT_PROCESSOR_MAX_BANDS are already registered
+ */
+int fft_processor_add_band(fft_processor_t *fft, float target_freq, float bandwidth,
+                           fft_band_mode_t mode);
+
+/**
+ * Register a one-sided band over bins first_bin..last_bin
+ *
+ * For spectra of mixed-down streams, where a band is not symmetric about
+ * DC. Negative bins count down from the top of the spectrum (-1 is bin
+ * fft_size - 1); the range must lie within -fft_size/2..fft_size/2 - 1.
+ *
+ * @return Band id (queried with fft_processor_get_band()), or -1 if full
+ *         or the range is invalid
+ */
+int fft_processor_add_bins(fft_processor_t *fft, int first_bin, int last_bin,
+                           fft_band_mode_t mode);
+
+/**
+ * Get energy of a registered band from the last fft_processor_process()
+ *
+ * @param fft Processor handle
+ * @param band_id Id from fft_processor_add_band()
+ * @return Band energy (magnitude or power per the band's mode), 0 if invalid
+ */
+float fft_processor_get_band(fft_processor_t *fft, int band_id);
+
 /**
  * Get Hz per FFT bin
  *
@@ -95,6 +158,14 @@ int fft_processor_get_size(fft_processor_t *fft);
  */
 void fft_processor_get_magnitudes(fft_processor_t *fft, float *magnitudes);
 
+/**
+ * Get squared magnitudes (power) for every bin, without square roots
+ *
+ * @param fft Processor handle
+ * @param power Output buffer [fft_size]
+ */
+void fft_processor_get_power(fft_processor_t *fft, float *power);
+
 #ifdef __cplusplus
 }
 #endif
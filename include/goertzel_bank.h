@@ -0,0 +1,85 @@
+/**
+ * @file goertzel_bank.h
+ * @brief Multi-bin Goertzel bank for detectors that watch a few FFT bins
+ *
+ * Computes the same windowed DFT bins fft_processor would, but sample by
+ * sample and only for registered bands. For complex input the Goertzel
+ * resonator for bin k is identical to the one for bin N-k (same real
+ * coefficient), so each +/- sideband pair costs one resonator.
+ *
+ * Band energies use the fft_processor_get_band() magnitude scale
+ * (sum |X| / N over both sidebands), so thresholds carry over unchanged.
+ */
+
+#ifndef GOERTZEL_BANK_H
+#define GOERTZEL_BANK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "fft_plan_cache.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GOERTZEL_BANK_MAX_BINS       16
+#define GOERTZEL_BANK_MAX_BANDS      4
+
+/**
+ * Per-detector spectral front end selection
+ */
+typedef enum {
+    SPECTRAL_MODE_FFT = 0,          /* Full FFT per frame (default) */
+    SPECTRAL_MODE_GOERTZEL          /* Goertzel bank over registered bins only */
+} spectral_mode_t;
+
+typedef struct goertzel_bank goertzel_bank_t;
+
+/**
+ * Create bank for frames of block_size samples
+ * @param window Same analysis window the equivalent FFT would apply
+ */
+goertzel_bank_t *goertzel_bank_create(int block_size, float sample_rate, fft_window_t window);
+
+void goertzel_bank_destroy(goertzel_bank_t *gb);
+
+/**
+ * Register target_freq +/- bandwidth (both sidebands), same bin selection
+ * as fft_processor_add_band()
+ * @return Band id, or -1 if band or bin capacity is exhausted
+ */
+int goertzel_bank_add_band(goertzel_bank_t *gb, float target_freq, float bandwidth);
+
+/**
+ * Feed one sample
+ * @return true when this sample completes a frame (band results updated)
+ */
+bool goertzel_bank_process(goertzel_bank_t *gb, float i_sample, float q_sample);
+
+/**
+ * Feed samples up to the end of the current frame
+ * @return Samples consumed (<= count); check goertzel_bank_frame_ready()
+ */
+size_t goertzel_bank_process_block(goertzel_bank_t *gb, const float *i_samples,
+                                   const float *q_samples, size_t count);
+
+/**
+ * True if the last process call completed a frame
+ */
+bool goertzel_bank_frame_ready(goertzel_bank_t *gb);
+
+/**
+ * Band energy from the most recently completed frame
+ */
+float goertzel_bank_get_band(goertzel_bank_t *gb, int band_id);
+
+/**
+ * Discard the partial frame in progress
+ */
+void goertzel_bank_reset(goertzel_bank_t *gb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GOERTZEL_BANK_H */
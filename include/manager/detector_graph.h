@@ -0,0 +1,144 @@
+/**
+ * @file detector_graph.h
+ * @brief Detector dataflow graph (manager internal)
+ *
+ * Every component is a node with typed event output ports; every route
+ * from a port into a consumer is an edge with a sink function. The node
+ * and edge tables (detector_routing.c) are the whole event flow; the
+ * graph is planned once from the config at creation:
+ *
+ *   - A node runs if the config asks for it and it was compiled in
+ *     (WWV_NO_DISPLAY_PATH, WWV_NO_SLOW_MARKER)
+ *   - A feeder node, one that exists only for its outputs, is dropped
+ *     when no running node consumes any of them - repeated, so whole
+ *     upstream chains go with their last consumer
+ *   - An edge is wired only between two running nodes (and when its
+ *     condition holds), so producers emit straight to live sinks
+ *
+ * Nodes that are not running are never created and cost nothing; with no
+ * display-path node running, the display path (and the front end's 12 kHz
+ * stage) is skipped entirely.
+ */
+
+#ifndef DETECTOR_GRAPH_H
+#define DETECTOR_GRAPH_H
+
+#include "wwv_detector_manager.h"
+#include "wwv_perf.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Nodes and Ports
+ *============================================================================*/
+
+typedef enum {
+    WWV_NODE_TICK_DETECTOR = 0,
+    WWV_NODE_MARKER_DETECTOR,
+    WWV_NODE_BCD_TIME_DETECTOR,
+    WWV_NODE_BCD_FREQ_DETECTOR,
+    WWV_NODE_TONE_TRACKERS,
+    WWV_NODE_SLOW_MARKER,
+    WWV_NODE_TICK_CORRELATOR,
+    WWV_NODE_MARKER_CORRELATOR,
+    WWV_NODE_SYNC_DETECTOR,
+    WWV_NODE_BCD_CORRELATOR,
+    WWV_NODE_BCD_TIME_SOLVER,
+    WWV_NODE_BCD_PATH_POLICY,       /* config.bcd_adaptive */
+    WWV_NODE_REFCLOCK,              /* NTP SHM / chrony SOCK export */
+    WWV_NODE_HISTORY,               /* config.history_seconds */
+    WWV_NODE_EXTERNAL,              /* Manager callbacks / threaded event queue */
+    WWV_NODE_COUNT
+} wwv_node_id_t;
+
+/* Typed event ports; the payload of each is noted */
+typedef enum {
+    WWV_PORT_TICK = 0,              /* tick_event_t */
+    WWV_PORT_TICK_MARKER,           /* tick_marker_event_t */
+    WWV_PORT_MARKER,                /* marker_event_t */
+    WWV_PORT_SLOW_MARKER_FRAME,     /* slow_marker_frame_t */
+    WWV_PORT_BCD_TIME_PULSE,        /* bcd_time_event_t */
+    WWV_PORT_BCD_FREQ_PULSE,        /* bcd_freq_event_t */
+    WWV_PORT_BCD_SYMBOL,            /* bcd_symbol_event_t */
+    WWV_PORT_COUNT
+} wwv_port_t;
+
+#define WWV_PORT_BIT(p)     (1u << (p))
+
+typedef enum {
+    WWV_PATH_NONE = 0,              /* Driven by events only */
+    WWV_PATH_DETECTOR,              /* 50 kHz samples */
+    WWV_PATH_DISPLAY                /* 12 kHz samples / display FFT */
+} wwv_node_path_t;
+
+struct wwv_detector_manager;
+
+typedef struct {
+    const char *name;
+    wwv_node_path_t path;
+    unsigned outputs;               /* WWV_PORT_BIT mask */
+    bool feeder;                    /* Exists only for its outputs */
+    bool compiled;                  /* Built into this library */
+    bool (*requested)(const wwv_detector_config_t *config);
+} wwv_node_desc_t;
+
+/**
+ * Edge sink: deliver one event of the edge's port to its consumer
+ */
+typedef void (*wwv_sink_fn)(struct wwv_detector_manager *mgr, const void *event);
+
+typedef struct {
+    wwv_port_t port;
+    wwv_node_id_t consumer;
+    wwv_sink_fn sink;
+    wwv_perf_stage_t stage;         /* Timed as, WWV_PERF_STAGE_COUNT = untimed */
+    bool locked;                    /* Consumer shared with the display thread (route_lock) */
+    bool (*when)(const wwv_detector_config_t *config);   /* NULL = always */
+} wwv_edge_desc_t;
+
+/* Graph description (detector_routing.c) */
+extern const wwv_node_desc_t WWV_GRAPH_NODES[WWV_NODE_COUNT];
+extern const wwv_edge_desc_t WWV_GRAPH_EDGES[];
+extern const int WWV_GRAPH_EDGE_COUNT;
+
+/*============================================================================
+ * Planned Graph
+ *============================================================================*/
+
+#define WWV_GRAPH_MAX_SINKS     6       /* Per port */
+
+typedef struct {
+    unsigned live;                  /* Bit per wwv_node_id_t */
+    bool display_path;              /* Any display-path node running */
+    int sink_count[WWV_PORT_COUNT];
+    const wwv_edge_desc_t *sinks[WWV_PORT_COUNT][WWV_GRAPH_MAX_SINKS];
+} wwv_graph_t;
+
+/**
+ * Plan nodes and wire edges from the config (before components are created)
+ */
+void wwv_graph_plan(wwv_graph_t *graph, const wwv_detector_config_t *config);
+
+static inline bool wwv_graph_node_live(const wwv_graph_t *graph, wwv_node_id_t node) {
+    return (graph->live >> node) & 1u;
+}
+
+/**
+ * Deliver an event to every live sink of a port
+ */
+void wwv_graph_emit(struct wwv_detector_manager *mgr, wwv_port_t port, const void *event);
+
+/**
+ * One-line summary: running and pruned nodes, wired edges
+ */
+void wwv_graph_print(const wwv_graph_t *graph);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_GRAPH_H */
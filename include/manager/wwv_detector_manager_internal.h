@@ -7,6 +7,7 @@
 #define WWV_DETECTOR_MANAGER_INTERNAL_H
 
 #include "wwv_detector_manager.h"
+#include "detector_graph.h"
 #include "tick_detector.h"
 #include "marker_detector.h"
 #include "sync_detector.h"
@@ -14,28 +15,114 @@
 #include "tick_correlator.h"
 #include "marker_correlator.h"
 #include "slow_marker_detector.h"
+#include "bcd_time_detector.h"
+#include "bcd_freq_detector.h"
+#include "bcd_correlator.h"
+#include "bcd_time_solver.h"
+#include "bcd_path_policy.h"
+#include "wwv_history.h"
+#include "sdr_frontend.h"
+#include "baseband_frontend.h"
+#include "wwv_timer_wheel.h"
+#include "wwv_thread.h"
+#include "wwv_perf.h"
+#include "wwv_arena.h"
 #include <stdint.h>
 
+/*============================================================================
+ * Internal Configuration
+ *============================================================================*/
+
+/* Chunk size used to deinterleave kiss_fft_cpx blocks on the stack */
+#define WWV_BLOCK_CHUNK_SAMPLES     512
+
+/* config.detector_tiling: one tick / marker / BCD time frame, on the
+ * absolute sample grid so tiles do not depend on the caller's blocks */
+#define WWV_DETECTOR_TILE_SAMPLES   256
+
+/* Threaded-mode defaults (rounded up to powers of two) */
+#define WWV_PIPELINE_DETECTOR_RING  65536   /* ~1.3 s at 50 kHz */
+#define WWV_PIPELINE_DISPLAY_RING   16384   /* ~1.4 s at 12 kHz */
+#define WWV_PIPELINE_EVENT_QUEUE    256
+#define WWV_PIPELINE_STAMP_QUEUE    64      /* Refclock host times, one per pushed block */
+
+/* TELEM_PERF interval: one second of detector-path samples */
+#define WWV_PERF_REPORT_SAMPLES     TICK_SAMPLE_RATE
+
+/* Per-sample path telemetry flush: whole tiles within TELEM_BINARY_MAX_AGE_US
+ * (19 tiles, 97 ms), so a record never waits longer than the promised age */
+#define WWV_TELEM_FLUSH_SAMPLES \
+    ((uint64_t)TELEM_BINARY_MAX_AGE_US * TICK_SAMPLE_RATE / 1000000 / \
+     WWV_DETECTOR_TILE_SAMPLES * WWV_DETECTOR_TILE_SAMPLES)
+
 /*============================================================================
  * Internal State Structure
  *============================================================================*/
 
+typedef struct wwv_params wwv_params_t;
+typedef struct wwv_carrier_loop wwv_carrier_loop_t;
+typedef struct wwv_duty wwv_duty_t;
+
+/* External events collected for one hand-over (detector_events.c) */
+typedef struct {
+    bool enabled;                   /* Buffers set: batch instead of per-event callbacks */
+    wwv_event_buffers_t buf;
+    int tick_count;
+    int marker_count;
+    int sync_count;
+    uint64_t dropped;               /* Did not fit since the last hand-over */
+    int depth;                      /* Nested processing calls; hand over at 0 */
+    wwv_event_batch_fn callback;
+    void *callback_data;
+} wwv_event_batcher_t;
+
 struct wwv_detector_manager {
     /* Detector path (50 kHz) */
     tick_detector_t *tick_detector;
     marker_detector_t *marker_detector;
+    bcd_time_detector_t *bcd_time_detector;
+    bcd_freq_detector_t *bcd_freq_detector;
+    baseband_frontend_t *baseband;      /* config.baseband_path: feeds tick + marker, else NULL */
+    wwv_carrier_loop_t *carrier;        /* config.carrier_correction, else NULL */
+    wwv_duty_t *duty;                   /* config.duty_cycle, else NULL */
+    bool detector_tiling;               /* Blocks run tile by tile through the group */
     
     /* Correlators */
     tick_correlator_t *tick_correlator;
     marker_correlator_t *marker_correlator;
     sync_detector_t *sync_detector;
+    bcd_correlator_t *bcd_correlator;
+    bcd_time_solver_t *bcd_time_solver;
+    bcd_path_policy_t *bcd_path;        /* config.bcd_adaptive, else NULL */
+    wwv_timer_t bcd_path_timer;         /* Policy evaluation, every BCD_PATH_EVAL_MS */
+    
+    /* Time daemon export (caller-owned) */
+    wwv_refclock_t *refclock;
+    float refclock_delay_ms;
+    int64_t refclock_host_ns;       /* Host clock when... */
+    wwv_sample_t refclock_host_sample;  /* ...this detector sample had arrived (0 = not yet) */
+    
+    /* Per-second metrics (config.history_seconds, else NULL) */
+    wwv_history_t *history;
+    wwv_timer_t history_timer;          /* Closes each second's row */
+    
+    /* Sync / BCD correlator / BCD path / history deadlines on the detector sample clock */
+    wwv_timer_wheel_t *timers;
     
     /* Display path (12 kHz) */
     tone_tracker_t *tone_carrier;
     tone_tracker_t *tone_500;
     tone_tracker_t *tone_600;
+    tone_spectrum_t *tone_spectrum;     /* config.shared_tone_spectrum, else NULL */
+    channel_quality_t *channel_quality; /* With tone_spectrum */
     slow_marker_detector_t *slow_marker;
     
+    /* Running nodes and wired event edges (planned from the config) */
+    wwv_graph_t graph;
+    
+    /* Optional 2 MHz decimation front end */
+    sdr_frontend_t *frontend;
+    
     /* External callbacks */
     wwv_tick_callback_fn tick_callback;
     void *tick_callback_data;
@@ -43,6 +130,36 @@ struct wwv_detector_manager {
     void *marker_callback_data;
     wwv_sync_callback_fn sync_callback;
     void *sync_callback_data;
+    bcd_corr_symbol_callback_fn bcd_symbol_callback;
+    void *bcd_symbol_callback_data;
+    wwv_event_batcher_t batch;
+    bool tick_economy;              /* Sync LOCKED puts the tick detector in economy mode */
+    
+    /* Telemetry destination shared by all components (NULL = default) */
+    telem_ctx_t *telem;
+    uint64_t telem_flushed;             /* detector_samples at the last flush */
+    
+    /* Threaded mode (NULL when synchronous) */
+    struct wwv_pipeline *pipeline;
+    
+    /* Tunables staged by set_param(), applied on the detector path */
+    wwv_params_t *params;
+    
+    /* Serializes correlator access between the detector path and
+     * process_display_fft() (slow marker), which may be on different threads,
+     * and tone trackers between the display path and get_tone() */
+    wwv_mutex_t route_lock;
+    
+    /* Stage timing (NULL unless built with WWV_PERF_ENABLED) */
+    wwv_perf_t *perf;
+    wwv_perf_stats_t perf_reported;     /* Snapshot at the last TELEM_PERF report */
+    uint64_t perf_next_report;          /* detector_samples due for the next one */
+    
+    /* Caller arena holding this manager (NULL = heap) */
+    wwv_arena_t *arena;
+    
+    /* Real-time placement as applied (workers fill theirs in as they start) */
+    wwv_rt_status_t rt;
     
     /* Statistics */
     uint64_t detector_samples;
@@ -54,7 +171,7 @@ struct wwv_detector_manager {
  *============================================================================*/
 
 /**
- * Create all detector components based on configuration
+ * Plan the detector graph and create its running nodes
  * @param mgr Pre-allocated manager structure (zeroed)
  * @param config Configuration specifying which detectors to enable
  * @return true on success, false on failure
@@ -72,28 +189,198 @@ void wwv_detector_lifecycle_destroy_all(wwv_detector_manager_t *mgr);
  * Routing Callback Functions
  *============================================================================*/
 
+/* Producer callbacks: each emits its event on the node's graph port */
+
 /**
- * Internal callback for tick events
- * Routes to tick correlator and external callback
+ * Internal callback for tick events (WWV_PORT_TICK)
  */
 void wwv_routing_on_tick_event(const tick_event_t *event, void *user_data);
 
 /**
- * Internal callback for tick marker events
- * Routes to sync detector
+ * Internal callback for tick marker events (WWV_PORT_TICK_MARKER)
  */
 void wwv_routing_on_tick_marker_event(const tick_marker_event_t *event, void *user_data);
 
 /**
- * Internal callback for marker events
- * Routes to marker correlator and external callback
+ * Internal callback for marker events (WWV_PORT_MARKER)
  */
 void wwv_routing_on_marker_event(const marker_event_t *event, void *user_data);
 
 /**
- * Internal callback for slow marker frames
- * Routes to marker correlator for verification
+ * Internal callback for slow marker frames (WWV_PORT_SLOW_MARKER_FRAME)
  */
 void wwv_routing_on_slow_marker_frame(const slow_marker_frame_t *frame, void *user_data);
+void wwv_routing_on_tone_spectrum(const float *magnitudes, int fft_size,
+                                  double timestamp_ms, void *user_data);
+
+/**
+ * Internal callbacks for BCD pulse events (WWV_PORT_BCD_TIME_PULSE / _FREQ_PULSE)
+ */
+void wwv_routing_on_bcd_time_event(const bcd_time_event_t *event, void *user_data);
+void wwv_routing_on_bcd_freq_event(const bcd_freq_event_t *event, void *user_data);
+
+/**
+ * Internal callback for bcd_correlator symbols (WWV_PORT_BCD_SYMBOL)
+ */
+void wwv_routing_on_bcd_symbol(const bcd_symbol_event_t *event, void *user_data);
+
+/**
+ * Internal sync state callback: tick economy mode while LOCKED
+ */
+void wwv_routing_on_sync_state(sync_state_t old_state, sync_state_t new_state,
+                               float confidence, void *user_data);
+
+/**
+ * BCD path policy evaluation (mgr->bcd_path_timer): idles or restores the
+ * BCD freq detector and re-arms itself
+ */
+void wwv_routing_on_bcd_path_timer(wwv_timer_t *timer, double now_ms, void *user_data);
+
+/**
+ * History row close (mgr->history_timer): samples the once-a-second
+ * metrics into the second just ended and re-arms itself
+ */
+void wwv_routing_on_history_timer(wwv_timer_t *timer, double now_ms, void *user_data);
+
+/*============================================================================
+ * Front End Sinks (wwv_detector_manager.c)
+ *============================================================================*/
+
+/**
+ * Decimated 50 kHz / 12 kHz blocks from the SDR front end
+ */
+void wwv_frontend_on_detector_block(const float *i_samples, const float *q_samples,
+                                    size_t count, void *user_data);
+void wwv_frontend_on_display_block(const float *i_samples, const float *q_samples,
+                                   size_t count, void *user_data);
+
+/**
+ * 3125 Hz blocks from the baseband front end (config.baseband_path)
+ */
+void wwv_baseband_on_block(const baseband_block_t *block, void *user_data);
+
+/**
+ * Interleaved detector-path samples without taking a refclock stamp: the
+ * detector worker sets the one pushed with them
+ */
+void wwv_detector_block_cpx(wwv_detector_manager_t *mgr, const kiss_fft_cpx *samples,
+                            size_t count);
+
+/*============================================================================
+ * Event Delivery Functions (detector_events.c)
+ *============================================================================*/
+
+/**
+ * Hand one external event to its callback, or to the batch
+ * (caller's thread in synchronous mode, dispatch_events() when threaded)
+ */
+void wwv_events_tick(wwv_detector_manager_t *mgr, const wwv_tick_event_t *event);
+void wwv_events_marker(wwv_detector_manager_t *mgr, const wwv_marker_event_t *event);
+void wwv_events_sync(wwv_detector_manager_t *mgr, const wwv_sync_status_t *status);
+
+/**
+ * Bracket a public processing call; the outermost end delivers the batch.
+ * No-ops in threaded mode, where dispatch_events() delivers.
+ */
+void wwv_events_begin(wwv_detector_manager_t *mgr);
+void wwv_events_end(wwv_detector_manager_t *mgr);
+
+/**
+ * Deliver the batch to the batch callback now, if there is one
+ */
+void wwv_events_deliver(wwv_detector_manager_t *mgr);
+
+/*============================================================================
+ * Runtime Parameter Functions (detector_params.c)
+ *============================================================================*/
+
+wwv_params_t *wwv_params_create(void);
+void wwv_params_destroy(wwv_params_t *pb);
+
+/**
+ * Apply settings published since the last call (detector path, block start)
+ */
+void wwv_params_apply(wwv_detector_manager_t *mgr);
+
+/*============================================================================
+ * Carrier Correction Functions (detector_carrier.c)
+ *============================================================================*/
+
+wwv_carrier_loop_t *wwv_carrier_loop_create(void);
+void wwv_carrier_loop_destroy(wwv_carrier_loop_t *loop);
+
+/**
+ * Display path, after each block: steer from the carrier tracker's
+ * estimate if it has a new one (under route_lock, like the trackers)
+ */
+void wwv_carrier_loop_steer(wwv_carrier_loop_t *loop, tone_tracker_t *carrier);
+
+/**
+ * Detector path, block start: pick up the steered offset
+ * @return false while not correcting (NULL loop included)
+ */
+bool wwv_carrier_loop_begin(wwv_carrier_loop_t *loop);
+
+/**
+ * Mix up to WWV_BLOCK_CHUNK_SAMPLES samples into the loop's buffer
+ */
+void wwv_carrier_loop_mix(wwv_carrier_loop_t *loop, const float *i_samples,
+                          const float *q_samples, size_t count,
+                          const float **out_i, const float **out_q);
+
+void wwv_carrier_loop_get_status(wwv_carrier_loop_t *loop, wwv_carrier_status_t *out);
+
+/*============================================================================
+ * Duty Cycling Functions (detector_duty.c)
+ *============================================================================*/
+
+/**
+ * Start acquiring on the manager's timer wheel (after it is created)
+ */
+wwv_duty_t *wwv_duty_create(wwv_detector_manager_t *mgr, int minutes);
+void wwv_duty_destroy(wwv_duty_t *duty);
+
+/**
+ * Detector path: the detectors sleep through the next span (NULL = never).
+ * Sleep starts and ends in timer callbacks, on a frame boundary of every
+ * detector.
+ */
+bool wwv_duty_asleep(const wwv_duty_t *duty);
+
+/**
+ * Display path, per block: false while asleep (the block is counted, not
+ * processed); else the samples slept through since the last awake block
+ */
+bool wwv_duty_display_awake(wwv_duty_t *duty, size_t count, uint64_t *slept);
+
+void wwv_duty_get_status(wwv_duty_t *duty, wwv_duty_status_t *out);
+
+/*============================================================================
+ * Pipeline Functions (threaded mode)
+ *============================================================================*/
+
+/**
+ * Create rings and start detector/display workers
+ * @return false on failure (pipeline torn down, mgr->pipeline NULL)
+ */
+bool wwv_pipeline_start(wwv_detector_manager_t *mgr, const wwv_detector_config_t *config);
+
+/**
+ * Drain rings, stop workers and free the pipeline (no-op if not threaded)
+ */
+void wwv_pipeline_stop(wwv_detector_manager_t *mgr);
+
+/**
+ * Print mgr->rt: memory locking, prefaulting and each worker's placement
+ */
+void wwv_pipeline_print_rt(wwv_detector_manager_t *mgr);
+
+/**
+ * Queue an external event for dispatch_events()
+ * @return false if not threaded (caller should invoke the callback directly)
+ */
+bool wwv_pipeline_emit_tick(wwv_detector_manager_t *mgr, const wwv_tick_event_t *event);
+bool wwv_pipeline_emit_marker(wwv_detector_manager_t *mgr, const wwv_marker_event_t *event);
+bool wwv_pipeline_emit_sync(wwv_detector_manager_t *mgr, const wwv_sync_status_t *status);
 
 #endif /* WWV_DETECTOR_MANAGER_INTERNAL_H */
@@ -7,6 +7,7 @@
 #define MARKER_CORRELATOR_H
 
 #include <stdbool.h>
+#include "telemetry.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,7 +21,8 @@ typedef enum {
 
 typedef struct {
     int marker_number;
-    float timestamp_ms;
+    double timestamp_ms;
+    uint64_t sample_index;      /* 50 kHz input sample at timestamp_ms */
     float duration_ms;          /* From fast path */
     float energy;               /* From slow path */
     float snr_db;               /* From slow path */
@@ -36,12 +38,12 @@ void marker_correlator_destroy(marker_correlator_t *mc);
 
 /* Called when fast path detects marker end */
 void marker_correlator_fast_event(marker_correlator_t *mc,
-                                   float timestamp_ms,
+                                   double timestamp_ms,
                                    float duration_ms);
 
 /* Called every slow path frame */
 void marker_correlator_slow_frame(marker_correlator_t *mc,
-                                   float timestamp_ms,
+                                   double timestamp_ms,
                                    float energy,
                                    float snr_db,
                                    bool above_threshold);
@@ -49,6 +51,11 @@ void marker_correlator_slow_frame(marker_correlator_t *mc,
 void marker_correlator_set_callback(marker_correlator_t *mc,
                                      correlated_marker_callback_fn cb, void *user_data);
 
+/**
+ * Route UDP telemetry to a context (NULL = default context)
+ */
+void marker_correlator_set_telemetry(marker_correlator_t *mc, telem_ctx_t *ctx);
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,11 +5,26 @@
  * Detects 800ms pulses at 1000Hz that occur at second 0 of each minute.
  * Uses sliding window accumulator with self-tracking baseline.
  *
+ * TEMPLATE MODE:
+ *   marker_detector_set_template() swaps the threshold state machine for a
+ *   matched filter over the same per-frame 1000 Hz energy (a 195 Hz
+ *   envelope): the :59 tick hole, the 800 ms marker, and the quiet before
+ *   the :01 tick. Ordinary seconds and long tones score near zero, so no
+ *   second path is needed to confirm a marker, and the edges are placed
+ *   to a fraction of a frame (marker_event_t.onset_ms, duration_ms).
+ *
  * DESIGN NOTES:
  *   - Self-contained detector with own FFT (50kHz, 256-pt)
  *   - Self-tracking baseline adapts slowly during IDLE state
  *   - Do NOT inject external baselines - incompatible scaling between FFT paths
  *   - Proven reliable in v133 testing
+ *
+ * BASEBAND:
+ *   marker_detector_create_baseband() builds the same detector over the
+ *   3125 Hz streams of baseband_frontend.h: 16-point FFTs on both
+ *   sidebands, summed over the bins that cover the 1000 Hz bucket. Frames
+ *   stay 5.12 ms, so windows, thresholds and timestamps are unchanged.
+ *   Feed it with marker_detector_process_baseband() only; FFT mode only.
  */
 
 #ifndef MARKER_DETECTOR_H
@@ -17,7 +32,13 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
+#include "goertzel_bank.h"
+#include "baseband_frontend.h"
+#include "telemetry.h"
+#include "wwv_perf.h"
+#include "wwv_state.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -41,6 +62,15 @@ extern "C" {
 #define MARKER_FRAME_MS         ((float)MARKER_FFT_SIZE * 1000.0f / MARKER_SAMPLE_RATE)  /* 5.12ms */
 #define MARKER_WINDOW_FRAMES    ((int)(MARKER_WINDOW_MS / MARKER_FRAME_MS))  /* ~195 frames */
 
+/* Parallel windows over the same bucket-energy stream (one shared ring).
+ * MARKER_WINDOW_FULL drives detection; the shorter sums bracket the pulse. */
+typedef enum {
+    MARKER_WINDOW_MIN = 0,          /* MARKER_MIN_DURATION_MS */
+    MARKER_WINDOW_PULSE,            /* MARKER_PULSE_MS */
+    MARKER_WINDOW_FULL,             /* MARKER_WINDOW_MS */
+    MARKER_WINDOW_COUNT
+} marker_window_t;
+
 /*============================================================================
  * Detector State (opaque)
  *============================================================================*/
@@ -53,11 +83,14 @@ typedef struct marker_detector marker_detector_t;
 
 typedef struct {
     int marker_number;
-    float timestamp_ms;
+    double timestamp_ms;        /* End of the marker */
+    double onset_ms;            /* Leading edge (sub-frame in template mode) */
+    uint64_t sample_index;      /* Input sample (MARKER_SAMPLE_RATE) at timestamp_ms */
     float since_last_marker_sec;
     float accumulated_energy;
     float peak_energy;
     float duration_ms;
+    float window_energy[MARKER_WINDOW_COUNT];  /* Sums at the end of the marker */
 } marker_event_t;
 
 typedef void (*marker_callback_fn)(const marker_event_t *event, void *user_data);
@@ -73,6 +106,11 @@ typedef void (*marker_callback_fn)(const marker_event_t *event, void *user_data)
  */
 marker_detector_t *marker_detector_create(const char *csv_path);
 
+/**
+ * Create a detector for the baseband front end's output (see BASEBAND above)
+ */
+marker_detector_t *marker_detector_create_baseband(const char *csv_path);
+
 /**
  * Destroy a marker detector instance
  */
@@ -83,12 +121,36 @@ void marker_detector_destroy(marker_detector_t *md);
  */
 void marker_detector_set_callback(marker_detector_t *md, marker_callback_fn callback, void *user_data);
 
+/**
+ * Route UDP telemetry to a context (NULL = default context)
+ */
+void marker_detector_set_telemetry(marker_detector_t *md, telem_ctx_t *ctx);
+
+/**
+ * Time FFT and state machine stages (and CSV rows) into perf (NULL = off)
+ */
+void marker_detector_set_perf(marker_detector_t *md, wwv_perf_t *perf);
+
 /**
  * Feed I/Q samples to detector
  * @return true if a marker was detected this sample
  */
 bool marker_detector_process_sample(marker_detector_t *md, float i_sample, float q_sample);
 
+/**
+ * Feed a block of I/Q samples to detector
+ * Equivalent to per-sample calls, one FFT-frame chunk at a time
+ * @return Number of markers detected within the block
+ */
+int marker_detector_process_block(marker_detector_t *md, const float *i_samples,
+                                  const float *q_samples, size_t count);
+
+/**
+ * Feed one baseband_frontend block (baseband detectors only)
+ * @return Number of markers detected within the block
+ */
+int marker_detector_process_baseband(marker_detector_t *md, const baseband_block_t *block);
+
 /**
  * UI flash state
  */
@@ -101,10 +163,46 @@ void marker_detector_decrement_flash(marker_detector_t *md);
 void marker_detector_set_enabled(marker_detector_t *md, bool enabled);
 bool marker_detector_get_enabled(marker_detector_t *md);
 
+/**
+ * Select spectral front end (FFT per frame, or Goertzel bank over the
+ * target bucket bins only). Discards the partial frame in progress.
+ * @return false if the Goertzel bank could not be allocated, or on a
+ *         baseband detector
+ */
+bool marker_detector_set_spectral_mode(marker_detector_t *md, spectral_mode_t mode);
+spectral_mode_t marker_detector_get_spectral_mode(marker_detector_t *md);
+
+/**
+ * Template mode (see TEMPLATE MODE above); switching either way restarts
+ * the warmup, and a template-mode detector has no warm-start state
+ * @return false if the template could not be allocated
+ */
+bool marker_detector_set_template(marker_detector_t *md, bool enabled);
+bool marker_detector_get_template(marker_detector_t *md);
+
+/**
+ * This frame's template score: marker region over its surroundings, in
+ * off levels (0 outside template mode)
+ */
+float marker_detector_get_template_score(marker_detector_t *md);
+
+/**
+ * Jump the stream ahead by samples not fed (duty-cycled sleep)
+ *
+ * Frame count advances as if the gap had been processed, so the marker
+ * spacing and timestamps stay on the stream clock. The baseline is kept;
+ * the pulse or template peak in progress is dropped and the sliding
+ * windows refill from the wake before detection resumes. Must start and
+ * end on a frame boundary.
+ * @return false off the frame grid or on a baseband detector
+ */
+bool marker_detector_skip(marker_detector_t *md, uint64_t samples);
+
 /**
  * Get current state for display
  */
 float marker_detector_get_accumulated_energy(marker_detector_t *md);
+float marker_detector_get_window_energy(marker_detector_t *md, marker_window_t window);
 float marker_detector_get_threshold(marker_detector_t *md);
 float marker_detector_get_current_energy(marker_detector_t *md);
 int marker_detector_get_marker_count(marker_detector_t *md);
@@ -143,6 +241,14 @@ float marker_detector_get_noise_adapt_rate(marker_detector_t *md);
 void marker_detector_set_min_duration_ms(marker_detector_t *md, float ms);
 float marker_detector_get_min_duration_ms(marker_detector_t *md);
 
+/*============================================================================
+ * Warm Start (wwv_state.h)
+ *============================================================================*/
+
+/* Baseline and threshold; restore skips warmup (within WWV_STATE_LEVELS_MAX_AGE_MS) */
+bool marker_detector_save_state(marker_detector_t *md, wwv_state_writer_t *w);
+bool marker_detector_restore_state(marker_detector_t *md, const wwv_state_reader_t *r);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,88 @@
+/**
+ * @file polyphase_resampler.h
+ * @brief Rational L/M polyphase FIR resampler for planar I/Q
+ *
+ * Only the output samples are computed: each one is a single dot product
+ * of one polyphase branch (taps_per_phase taps) against the most recent
+ * input, read in place from the caller's block. Only the taps_per_phase-1
+ * samples that straddle a block boundary are copied into a bridge buffer.
+ * Pure decimation is interp = 1.
+ *
+ * The dot products use the SIMD level selected by channel_filters_get_simd().
+ *
+ * The _s16 calls run the same filter in fixed point on int16 input (Q15
+ * taps, 32-bit accumulation), for receivers that deliver int16 I/Q. The
+ * float and int16 paths keep separate history, so feed a resampler one
+ * format between resets.
+ */
+
+#ifndef POLYPHASE_RESAMPLER_H
+#define POLYPHASE_RESAMPLER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct polyphase_resampler polyphase_resampler_t;
+
+/**
+ * Design an n-tap Kaiser-windowed sinc lowpass (~80 dB stopband)
+ * @param cutoff_hz -6 dB point at sample rate `rate`
+ * @param gain      DC gain (taps sum to this)
+ */
+void polyphase_design_lowpass(float *taps, int n, float rate, float cutoff_hz, float gain);
+
+/**
+ * Create resampler from in_rate to in_rate * interp / decim
+ * @param taps_per_phase Branch length (prototype has interp * taps_per_phase taps)
+ * @param cutoff_hz      Kaiser-windowed sinc cutoff (-6 dB point, ~80 dB stopband)
+ */
+polyphase_resampler_t *polyphase_resampler_create(int interp, int decim, int taps_per_phase,
+                                                  float in_rate, float cutoff_hz);
+
+void polyphase_resampler_destroy(polyphase_resampler_t *r);
+
+/**
+ * Clear filter history and output phase
+ */
+void polyphase_resampler_reset(polyphase_resampler_t *r);
+
+/**
+ * Upper bound on outputs produced from count inputs
+ */
+size_t polyphase_resampler_max_output(const polyphase_resampler_t *r, size_t count);
+
+/**
+ * Filter a block
+ * @param out_i, out_q Must hold polyphase_resampler_max_output(r, count) samples
+ *                     and must not alias the input
+ * @return Number of output samples written
+ */
+size_t polyphase_resampler_process(polyphase_resampler_t *r,
+                                   const float *in_i, const float *in_q, size_t count,
+                                   float *out_i, float *out_q);
+
+/**
+ * Filter an int16 block to int16 (rounded, saturated)
+ * Output keeps the input's scale, so stages chain in fixed point
+ */
+size_t polyphase_resampler_process_s16(polyphase_resampler_t *r,
+                                       const int16_t *in_i, const int16_t *in_q, size_t count,
+                                       int16_t *out_i, int16_t *out_q);
+
+/**
+ * Filter an int16 block to float, int16 full scale = 1.0
+ * The accumulator is converted once, with no intermediate rounding
+ */
+size_t polyphase_resampler_process_s16f(polyphase_resampler_t *r,
+                                        const int16_t *in_i, const int16_t *in_q, size_t count,
+                                        float *out_i, float *out_q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POLYPHASE_RESAMPLER_H */
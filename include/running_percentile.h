@@ -0,0 +1,56 @@
+/**
+ * @file running_percentile.h
+ * @brief Sliding-window percentile (order statistic) in O(log N) per sample
+ *
+ * Keeps the last N values in a ring and splits them across two heaps: a
+ * max-heap holding the lowest (rank + 1) values and a min-heap holding
+ * the rest, so the requested percentile is always the max-heap top. Each
+ * push replaces the oldest value in place and re-sifts, instead of
+ * copying and sorting the whole window.
+ *
+ * The reported value is the same element a full sort would return at
+ * index (count * percentile) / 100, clamped to the window.
+ */
+
+#ifndef RUNNING_PERCENTILE_H
+#define RUNNING_PERCENTILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct running_percentile running_percentile_t;
+
+/**
+ * Create a tracker over the last window values
+ * @param percentile 0-100 (50 = median)
+ */
+running_percentile_t *running_percentile_create(int window, int percentile);
+
+void running_percentile_destroy(running_percentile_t *rp);
+
+/**
+ * Forget all values (window and percentile are kept)
+ */
+void running_percentile_reset(running_percentile_t *rp);
+
+/**
+ * Add a value, evicting the oldest once the window is full
+ */
+void running_percentile_push(running_percentile_t *rp, float value);
+
+/**
+ * Current percentile of the values in the window (0 if empty)
+ */
+float running_percentile_get(const running_percentile_t *rp);
+
+/**
+ * Number of values currently in the window
+ */
+int running_percentile_count(const running_percentile_t *rp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RUNNING_PERCENTILE_H */
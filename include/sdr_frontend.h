@@ -0,0 +1,74 @@
+/**
+ * @file sdr_frontend.h
+ * @brief 2 MHz SDR decimation front end feeding every detector rate
+ *
+ * One pass over raw 2 MHz I/Q produces all detector streams:
+ *
+ *   2 MHz ──/8──► 250 kHz ──/5──► 50 kHz  (detector path)
+ *                                   └──x6/25──► 12 kHz  (display path)
+ *                                                 └──/5──► 2.4 kHz (BCD envelope)
+ *
+ * Each stage is a polyphase_resampler_t reading the previous stage's
+ * output buffer in place. Input is consumed in SDR_FRONTEND_CHUNK pieces;
+ * every sink is called once per chunk with the samples produced. A stage
+ * downstream of the last connected sink is skipped.
+ */
+
+#ifndef SDR_FRONTEND_H
+#define SDR_FRONTEND_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SDR_FRONTEND_INPUT_RATE     2000000 /* Raw SDR rate */
+#define SDR_FRONTEND_CHUNK          20000   /* Input samples per pass (10 ms) */
+
+typedef enum {
+    SDR_TAP_DETECTOR = 0,           /* 50 kHz, ±20 kHz passband */
+    SDR_TAP_DISPLAY,                /* 12 kHz, ±5 kHz passband */
+    SDR_TAP_ENVELOPE,               /* 2.4 kHz, ±600 Hz passband (bcd_envelope_process_sample_2400) */
+    SDR_TAP_COUNT
+} sdr_frontend_tap_t;
+
+typedef void (*sdr_frontend_sink_fn)(const float *i_samples, const float *q_samples,
+                                     size_t count, void *user_data);
+
+typedef struct sdr_frontend sdr_frontend_t;
+
+sdr_frontend_t *sdr_frontend_create(void);
+void sdr_frontend_destroy(sdr_frontend_t *fe);
+
+/**
+ * Connect a sink to one output rate (NULL disconnects)
+ */
+void sdr_frontend_set_sink(sdr_frontend_t *fe, sdr_frontend_tap_t tap,
+                           sdr_frontend_sink_fn sink, void *user_data);
+
+/**
+ * Feed raw 2 MHz I/Q
+ */
+void sdr_frontend_process(sdr_frontend_t *fe, const float *i_samples,
+                          const float *q_samples, size_t count);
+
+/**
+ * Feed raw 2 MHz I/Q as interleaved int16 (I, Q, I, Q, ...), full scale = 1.0
+ * The 2 MHz and 250 kHz stages run in Q15 fixed point; sinks still get
+ * float, from 50 kHz down. Use one input format between resets.
+ * @param count Complex samples (iq holds 2 * count values)
+ */
+void sdr_frontend_process_s16(sdr_frontend_t *fe, const int16_t *iq, size_t count);
+
+/**
+ * Clear all filter history (e.g. after retuning)
+ */
+void sdr_frontend_reset(sdr_frontend_t *fe);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SDR_FRONTEND_H */
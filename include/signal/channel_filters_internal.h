@@ -0,0 +1,39 @@
+#ifndef CHANNEL_FILTERS_INTERNAL_H
+#define CHANNEL_FILTERS_INTERNAL_H
+
+// Private interface between channel_filters.c (scalar path, dispatch) and
+// channel_filters_simd.c (lane-parallel kernels). NOT part of public API.
+
+#include "channel_filters.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Kernels run a biquad cascade over a lane-interleaved block,
+// in[n * lanes + lane]. Every kernel evaluates each section as
+//   y = b0*x + b1*x1 + b2*x2 - a1*y1 - a2*y2   (left to right, no FMA)
+// so all kernels produce bit-identical output to biquad_process().
+
+// Scalar kernel for lanes [lane_begin, lane_end)
+void biquad_bank_kernel_scalar(biquad_lane_state_t *sec,
+                               const float *const *sos, int sections,
+                               int lane_begin, int lane_end, int lanes,
+                               const float *in, float *out, size_t count);
+
+// Vector kernel starting at lane 0 - returns number of lanes handled (whole
+// vectors only); remaining lanes go to the scalar kernel
+int biquad_bank_kernel_vector(channel_simd_t level, biquad_lane_state_t *sec,
+                              const float *const *sos, int sections,
+                              int lanes, const float *in, float *out, size_t count);
+
+// CPU feature probe (channel_filters_simd.c)
+channel_simd_t channel_filters_detect_simd(void);
+int channel_filters_simd_supported(channel_simd_t level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHANNEL_FILTERS_INTERNAL_H
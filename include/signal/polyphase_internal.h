@@ -0,0 +1,43 @@
+#ifndef POLYPHASE_INTERNAL_H
+#define POLYPHASE_INTERNAL_H
+
+// Private interface between polyphase_resampler.c and polyphase_simd.c.
+// NOT part of public API.
+
+#include "channel_filters.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Dot product of one polyphase branch against both I/Q rails:
+//   *yi = sum h[k] * xi[k],  *yq = sum h[k] * xq[k],  k = 0..n-1
+typedef void (*polyphase_dot2_fn)(const float *h, const float *xi, const float *xq,
+                                  int n, float *yi, float *yq);
+
+void polyphase_dot2_scalar(const float *h, const float *xi, const float *xq,
+                           int n, float *yi, float *yq);
+
+// Kernel for a channel_filters SIMD level (scalar if not compiled in)
+polyphase_dot2_fn polyphase_select_kernel(channel_simd_t level);
+
+// Fixed-point dot product: Q15 taps against int16 rails into exact 32-bit
+// sums. Taps are scaled so sum |h[k]| <= 32767, so no input can overflow
+// the accumulator and every kernel gives the same result bit for bit.
+typedef void (*polyphase_dot2_s16_fn)(const int16_t *h, const int16_t *xi, const int16_t *xq,
+                                      int n, int32_t *yi, int32_t *yq);
+
+void polyphase_dot2_s16_scalar(const int16_t *h, const int16_t *xi, const int16_t *xq,
+                               int n, int32_t *yi, int32_t *yq);
+
+polyphase_dot2_s16_fn polyphase_select_kernel_s16(channel_simd_t level);
+
+// Split interleaved int16 I/Q into planar rails (SSE2 / NEON where built)
+void polyphase_deinterleave_s16(const int16_t *iq, int16_t *out_i, int16_t *out_q, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // POLYPHASE_INTERNAL_H
@@ -0,0 +1,74 @@
+/**
+ * @file sliding_dft.h
+ * @brief Sliding windowed DFT over a few registered bins, updated every sample
+ *
+ * goertzel_bank.h gives the FFT's bins once per frame; this gives them for
+ * the window ending at every sample. Each bin k of the N-sample
+ * Hann-windowed DFT fft_processor computes (FFT_WINDOW_HANN, the
+ * symmetric N-1 form) is three recursive resonators, at w_k and w_k +/- a
+ * with a = 2 pi / (N - 1):
+ *
+ *   S_n(w) = e^{jw} S_{n-1}(w) + x[n] - e^{jwN} x[n-N]
+ *   |X_n[k]| = |0.5 S_n(w_k) - 0.25 S_n(w_k - a) - 0.25 S_n(w_k + a)|
+ *
+ * e^{jwN} is 1 at every bin centre and e^{-/+ja} at every side resonator,
+ * so the three input terms are formed once per sample and each resonator
+ * costs one complex multiply-add.
+ *
+ * State is double and is recomputed exactly from the window every
+ * SLIDING_DFT_RESYNC samples, so rounding cannot build up.
+ *
+ * Band energies use the fft_processor_get_band() magnitude scale
+ * (sum |X| / N over both sidebands), so thresholds carry over unchanged.
+ */
+
+#ifndef SLIDING_DFT_H
+#define SLIDING_DFT_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SLIDING_DFT_MAX_BINS        8
+#define SLIDING_DFT_MAX_BANDS       2
+#define SLIDING_DFT_RESYNC          4096    /* Samples between exact recomputes */
+
+typedef struct sliding_dft sliding_dft_t;
+
+/**
+ * Create over a window of block_size samples
+ */
+sliding_dft_t *sliding_dft_create(int block_size, float sample_rate);
+
+void sliding_dft_destroy(sliding_dft_t *sd);
+
+/**
+ * Register target_freq +/- bandwidth (both sidebands), same bin selection
+ * as fft_processor_add_band()
+ * @return Band id, or -1 if band or bin capacity is exhausted
+ */
+int sliding_dft_add_band(sliding_dft_t *sd, float target_freq, float bandwidth);
+
+/**
+ * Slide the window one sample
+ */
+void sliding_dft_push(sliding_dft_t *sd, float i_sample, float q_sample);
+
+/**
+ * Band energy for the window ending at the last sample pushed
+ * (zero-padded until block_size samples have been pushed)
+ */
+float sliding_dft_get_band(const sliding_dft_t *sd, int band_id);
+
+/**
+ * Clear the window
+ */
+void sliding_dft_reset(sliding_dft_t *sd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SLIDING_DFT_H */
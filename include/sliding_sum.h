@@ -0,0 +1,70 @@
+/**
+ * @file sliding_sum.h
+ * @brief O(1) sliding-window sums over one value stream, several lengths
+ *
+ * One ring holds the last `capacity` values of a stream (e.g. per-frame
+ * bucket energy). Any number of windows up to SLIDING_SUM_MAX_WINDOWS, each
+ * of its own length, read from that same ring: every push adds the new value
+ * to each window and subtracts the value that just left it.
+ *
+ * Sums are double with Kahan compensation, and every SLIDING_SUM_RENORM
+ * pushes each window is recomputed exactly from the ring, so the classic
+ * add/subtract drift of a float running sum cannot build up over hours.
+ */
+
+#ifndef SLIDING_SUM_H
+#define SLIDING_SUM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SLIDING_SUM_MAX_WINDOWS     4
+#define SLIDING_SUM_RENORM          65536   /* Pushes between exact recomputes */
+
+typedef struct sliding_sum sliding_sum_t;
+
+/**
+ * Create over a stream keeping the last capacity values
+ * @param capacity Longest window that can be added
+ */
+sliding_sum_t *sliding_sum_create(int capacity);
+
+void sliding_sum_destroy(sliding_sum_t *ss);
+
+/**
+ * Forget all values (windows are kept)
+ */
+void sliding_sum_reset(sliding_sum_t *ss);
+
+/**
+ * Add a window over the most recent length values
+ * @return Window id, or -1 if length is out of range or windows are exhausted
+ */
+int sliding_sum_add_window(sliding_sum_t *ss, int length);
+
+/**
+ * Append one value to the stream, updating every window
+ */
+void sliding_sum_push(sliding_sum_t *ss, float value);
+
+/**
+ * Sum of the last min(length, pushed) values (0 for a bad id)
+ */
+float sliding_sum_get(const sliding_sum_t *ss, int window);
+
+/**
+ * Mean over the values currently in the window (0 if empty)
+ */
+float sliding_sum_get_mean(const sliding_sum_t *ss, int window);
+
+/**
+ * Values currently in the window (saturates at its length)
+ */
+int sliding_sum_get_count(const sliding_sum_t *ss, int window);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SLIDING_SUM_H */
@@ -15,6 +15,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "external/kiss_fft.h"
+#include "wwv_state.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,7 +41,7 @@ typedef struct {
     float energy;           /* Accumulated 1000 Hz energy */
     float snr_db;           /* Signal-to-noise ratio */
     float noise_floor;      /* Current noise estimate */
-    float timestamp_ms;     /* Frame timestamp */
+    double timestamp_ms;    /* Frame timestamp */
     bool above_threshold;   /* Energy exceeds detection threshold */
 } slow_marker_frame_t;
 
@@ -56,7 +57,13 @@ void slow_marker_detector_destroy(slow_marker_detector_t *smd);
 /* Feed from display path (called every 85ms effective) */
 void slow_marker_detector_process_fft(slow_marker_detector_t *smd,
                                        const kiss_fft_cpx *fft_out,
-                                       float timestamp_ms);
+                                       double timestamp_ms);
+
+/* Feed from a shared magnitude spectrum of the display stream (|X[k]|, any
+ * size); the same 1000 Hz and noise buckets are summed at its resolution */
+void slow_marker_detector_process_magnitudes(slow_marker_detector_t *smd,
+                                              const float *magnitudes, int fft_size,
+                                              double timestamp_ms);
 
 void slow_marker_detector_set_callback(slow_marker_detector_t *smd,
                                         slow_marker_callback_fn cb, void *user_data);
@@ -66,6 +73,10 @@ float slow_marker_detector_get_noise_floor(slow_marker_detector_t *smd);
 float slow_marker_detector_get_current_energy(slow_marker_detector_t *smd);
 bool slow_marker_detector_is_above_threshold(slow_marker_detector_t *smd);
 
+/* Warm start (wwv_state.h): noise floor, within WWV_STATE_LEVELS_MAX_AGE_MS */
+bool slow_marker_detector_save_state(slow_marker_detector_t *smd, wwv_state_writer_t *w);
+bool slow_marker_detector_restore_state(slow_marker_detector_t *smd, const wwv_state_reader_t *r);
+
 #ifdef __cplusplus
 }
 #endif
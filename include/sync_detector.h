@@ -24,6 +24,9 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "telemetry.h"
+#include "wwv_timer_wheel.h"
+#include "wwv_state.h"
 
 /* Forward declaration for optional wwv_clock integration */
 struct wwv_clock;
@@ -56,7 +59,7 @@ typedef enum {
  */
 typedef struct {
     int current_second;         /* 0-59, authoritative position in minute */
-    float second_start_ms;      /* When this second began (stream timestamp) */
+    double second_start_ms;     /* When this second began (stream timestamp) */
     float confidence;           /* 0.0 - 1.0, sync quality indicator */
     uint32_t evidence_mask;     /* Which signals contributed to this position */
     sync_state_t state;         /* Current sync state */
@@ -86,7 +89,7 @@ void sync_detector_destroy(sync_detector_t *sd);
  * @param sd Detector handle
  * @param timestamp_ms When tick occurred
  */
-void sync_detector_tick_event(sync_detector_t *sd, float timestamp_ms);
+void sync_detector_tick_event(sync_detector_t *sd, double timestamp_ms);
 
 /**
  * Report minute marker from tick detector (duration-based detection)
@@ -95,7 +98,7 @@ void sync_detector_tick_event(sync_detector_t *sd, float timestamp_ms);
  * @param duration_ms Duration of the pulse (should be ~800ms)
  * @param corr_ratio Correlation ratio from tick detector
  */
-void sync_detector_tick_marker(sync_detector_t *sd, float timestamp_ms,
+void sync_detector_tick_marker(sync_detector_t *sd, double timestamp_ms,
                                 float duration_ms, float corr_ratio);
 
 /**
@@ -105,7 +108,7 @@ void sync_detector_tick_marker(sync_detector_t *sd, float timestamp_ms,
  * @param accum_energy Accumulated energy in detection window
  * @param duration_ms Duration of accumulated energy above threshold
  */
-void sync_detector_marker_event(sync_detector_t *sd, float timestamp_ms,
+void sync_detector_marker_event(sync_detector_t *sd, double timestamp_ms,
                                  float accum_energy, float duration_ms);
 
 /**
@@ -130,16 +133,18 @@ const char *sync_state_name(sync_state_t state);
 /**
  * Get timestamp of last confirmed marker (backward compatibility)se (~800ms)
  */
-void sync_detector_p_marker_event(sync_detector_t *sd, float timestamp_ms,
+void sync_detector_p_marker_event(sync_detector_t *sd, double timestamp_ms,
                                    float duration_ms);
 
 /**
  * Periodic maintenance - check for signal loss, decay confidence
- * Call every ~100ms from sample processing loop
+ * Call every ~100ms from sample processing loop, or attach a timer wheel
+ * instead (sync_detector_set_timer_wheel()). Decay is scaled to the time
+ * since it was last applied, so the call rate does not change it.
  * @param sd Detector handle
  * @param current_ms Current stream timestamp
  */
-void sync_detector_periodic_check(sync_detector_t *sd, float current_ms);
+void sync_detector_periodic_check(sync_detector_t *sd, double current_ms);
 
 /**
  * Get current sync state
@@ -154,7 +159,7 @@ const char *sync_state_name(sync_state_t state);
 /**
  * Get timestamp of last confirmed marker
  */
-float sync_detector_get_last_marker_ms(sync_detector_t *sd);
+double sync_detector_get_last_marker_ms(sync_detector_t *sd);
 
 /**
  * Get count of confirmed markers
@@ -178,6 +183,38 @@ void sync_detector_decrement_flash(sync_detector_t *sd);
  */
 void sync_detector_set_wwv_clock(sync_detector_t *sd, wwv_clock_t *clk);
 
+/**
+ * Route UDP telemetry to a context (NULL = default context)
+ */
+void sync_detector_set_telemetry(sync_detector_t *sd, telem_ctx_t *ctx);
+
+/**
+ * Fast acquisition (default off)
+ *
+ * While ACQUIRING, hold about a minute of tick events, P-markers and tick
+ * markers and score all 60 second-of-minute hypotheses against the :00/:29/:59
+ * tick holes, P-marker positions and minute marker. A clear winner gives a
+ * TENTATIVE minute anchor within seconds of the first :59/:00 or a :29 hole
+ * plus a few P-markers; confirmed markers then replace it as usual. Ticks
+ * that keep landing in the anchor's predicted holes send it back to
+ * ACQUIRING. Needs sync_detector_tick_event() (and ideally
+ * sync_detector_p_marker_event()) to be fed.
+ */
+void sync_detector_set_fast_acquire(sync_detector_t *sd, bool enable);
+bool sync_detector_get_fast_acquire(sync_detector_t *sd);
+
+/**
+ * Drive the detector's deadlines from a timer wheel instead of polling
+ *
+ * The detector arms timers for the next signal-loss check while LOCKED,
+ * the retention / recovery timeouts while RECOVERING, the single-source
+ * confirmation of a pending marker and the marker expected after a :59
+ * tick hole, and runs the corresponding part of
+ * sync_detector_periodic_check() when each fires. The wheel's clock must
+ * be the one event timestamps are taken from. NULL detaches.
+ */
+void sync_detector_set_timer_wheel(sync_detector_t *sd, wwv_timer_wheel_t *wheel);
+
 /**
  * Set leap second pending flag (affects timing tolerances)
  * @param sd Detector handle
@@ -208,6 +245,11 @@ void sync_detector_broadcast_state(sync_detector_t *sd);
  */
 int sync_detector_get_good_intervals(sync_detector_t *sd);
 
+/**
+ * Print state, evidence counts and transitions
+ */
+void sync_detector_print_stats(sync_detector_t *sd);
+
 /**
  * Get pending tick marker info (for precise epoch calculation)
  * @param sd Detector handle
@@ -215,7 +257,36 @@ int sync_detector_get_good_intervals(sync_detector_t *sd);
  * @param duration_ms Output: tick marker duration (can be NULL)
  * @return true if tick marker is pending, false otherwise
  */
-bool sync_detector_get_pending_tick(sync_detector_t *sd, float *timestamp_ms, float *duration_ms);
+bool sync_detector_get_pending_tick(sync_detector_t *sd, double *timestamp_ms, float *duration_ms);
+
+/**
+ * Pause for a stretch of input that will not be fed (duty-cycled sleep)
+ *
+ * Only from LOCKED. The signal-loss check and pending confirmations are
+ * cancelled, so no deadline fires on the gap. sync_detector_resume() at
+ * the first fed sample decays the confidence for the time away, holds it
+ * below the LOCKED threshold and carries the second phase across, going
+ * TENTATIVE on the same anchor: one confirmed marker a whole number of
+ * minutes after the last locks it again. Signal loss is then timed from
+ * the resume, not from the last marker before the gap.
+ */
+bool sync_detector_suspend(sync_detector_t *sd);
+void sync_detector_resume(sync_detector_t *sd, double now_ms);
+bool sync_detector_is_suspended(sync_detector_t *sd);
+
+/**
+ * Warm-start snapshot (wwv_state.h)
+ *
+ * Saves the minute anchor, second phase and confidence once TENTATIVE.
+ * Restore into an ACQUIRING detector, within WWV_STATE_TIMING_MAX_AGE_MS:
+ * the anchor is carried to the new stream and the detector goes TENTATIVE
+ * on it, as after a fast-acquire search, with the confidence decayed for
+ * the time away and held below the LOCKED threshold. A few ticks on the
+ * carried phase lock it again; ticks in its predicted holes (with fast
+ * acquisition on) or a confirmed marker replace it.
+ */
+bool sync_detector_save_state(sync_detector_t *sd, wwv_state_writer_t *w);
+bool sync_detector_restore_state(sync_detector_t *sd, const wwv_state_reader_t *r);
 
 /*============================================================================
  * Runtime Parameter Tuning
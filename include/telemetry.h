@@ -5,6 +5,25 @@
  * Non-blocking UDP broadcast of CSV-format telemetry data.
  * Enables remote monitoring without affecting detector performance.
  *
+ * Two wire formats:
+ *   - TELEM_FORMAT_CSV (default): one "PREFIX,csv\n" datagram per message
+ *   - TELEM_FORMAT_BINARY: packed records (telemetry_wire.h) coalesced into
+ *     MTU-sized datagrams. Event sites check telem_binary_active() and send
+ *     a struct instead of formatting text; text messages still go out as
+ *     TELEM_REC_TEXT records.
+ *
+ * Delivery is synchronous (sendto on the calling thread) until
+ * telem_start_sender() is called. After that producers only copy the
+ * message into a lock-free MPSC queue; a background thread drains it,
+ * packs CSV lines of the same channel into shared datagrams and sends
+ * them, so a full socket buffer costs a dropped message, never a stall.
+ *
+ * All state lives in a telem_ctx_t (destination, channel mask, format,
+ * sender and counters). The telem_* functions operate on a default
+ * context opened by telem_init(); telem_ctx_create() gives a manager or
+ * receiver its own. Every telem_ctx_* function treats NULL as the
+ * default context.
+ *
  * Usage:
  *   telem_init(3005);                    // Initialize on port 3005
  *   telem_enable(TELEM_CHANNEL | TELEM_TICKS);  // Enable channels
@@ -15,6 +34,7 @@
 #ifndef TELEMETRY_H
 #define TELEMETRY_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -28,6 +48,7 @@ extern "C" {
 
 #define TELEM_DEFAULT_PORT      3005
 #define TELEM_MAX_MESSAGE_LEN   512
+#define TELEM_BINARY_MAX_AGE_US 100000  /* Flush a pending binary datagram after 100ms of sample time */
 
 /*============================================================================
  * Telemetry Channels (bitmask)
@@ -35,7 +56,7 @@ extern "C" {
 
 typedef enum {
     TELEM_NONE      = 0,
-    TELEM_CHANNEL   = (1 << 0),  /* Channel quality: carrier_db, snr_db, noise_db */
+    TELEM_CHANNEL   = (1 << 0),  /* Channel quality: carrier/snr/noise dB, fading, spread */
     TELEM_TICKS     = (1 << 1),  /* Tick pulse events */
     TELEM_MARKERS   = (1 << 2),  /* Minute marker events */
     TELEM_CARRIER   = (1 << 3),  /* Carrier frequency tracking (DC) */
@@ -49,11 +70,32 @@ typedef enum {
     TELEM_CONSOLE   = (1 << 11), /* Console/status messages (buffered) */
     TELEM_CTRL      = (1 << 12), /* Control commands received (from controller) */
     TELEM_RESP      = (1 << 13), /* Responses to control commands (to controller) */
-    TELEM_ALL       = 0x3FFF     /* All channels */
+    TELEM_PERF      = (1 << 14), /* Per-stage hot-path timing (wwv_perf.h) */
+    TELEM_ALL       = 0x7FFF     /* All channels */
 } telem_channel_t;
 
+typedef enum {
+    TELEM_FORMAT_CSV = 0,       /* Human-readable text lines */
+    TELEM_FORMAT_BINARY         /* Packed records, see telemetry_wire.h */
+} telem_format_t;
+
+typedef struct {
+    size_t queue_slots;         /* MPSC queue depth (messages) */
+    unsigned poll_interval_ms;  /* Batching window: sender wakes this often */
+    bool batch_text;            /* Pack CSV lines of one channel per datagram */
+} telem_sender_config_t;
+
+#define TELEM_SENDER_CONFIG_DEFAULT { 1024, 10, true }
+
+typedef struct {
+    uint32_t sent;              /* Messages handed to the socket */
+    uint32_t dropped;           /* Filtered, queue full, oversized or refused by the socket */
+} telem_channel_stats_t;
+
+typedef struct telem_ctx telem_ctx_t;
+
 /*============================================================================
- * Public API
+ * Public API (default context)
  *============================================================================*/
 
 /**
@@ -118,6 +160,75 @@ void telem_send(telem_channel_t channel, const char *csv_line);
  */
 void telem_sendf(telem_channel_t channel, const char *fmt, ...);
 
+/**
+ * Select wire format (flushes any pending binary datagram)
+ */
+void telem_set_format(telem_format_t format);
+
+/**
+ * Get current wire format
+ */
+telem_format_t telem_get_format(void);
+
+/**
+ * Check whether a binary record for this channel would be sent
+ * @return true if initialized, in binary format and channel enabled
+ */
+bool telem_binary_active(telem_channel_t channel);
+
+/**
+ * Queue a binary record (coalesced into the pending datagram)
+ *
+ * The datagram is sent when the next record would exceed the MTU, when it
+ * holds TELEM_BINARY_MAX_AGE_US of sample time, or on telem_flush().
+ * Ignored outside binary format.
+ *
+ * @param channel    Which channel this record belongs to
+ * @param type       telem_record_type_t
+ * @param wall_time  Unix seconds of the event
+ * @param sample_us  Sample-clock time of the event (see telem_ms_to_us)
+ * @param payload    Payload struct
+ * @param length     Payload size in bytes
+ */
+void telem_send_record(telem_channel_t channel, uint8_t type, uint32_t wall_time,
+                       uint64_t sample_us, const void *payload, uint16_t length);
+
+/**
+ * Send the pending binary datagram now (no-op if empty)
+ *
+ * With the sender running this returns immediately; everything queued
+ * goes out within one poll_interval_ms.
+ */
+void telem_flush(void);
+
+/**
+ * Start the background sender thread (call after telem_init)
+ * @param config  Sender settings, NULL for TELEM_SENDER_CONFIG_DEFAULT.
+ *                queue_slots applies on the first start after telem_init.
+ * @return true if the sender is running
+ */
+bool telem_start_sender(const telem_sender_config_t *config);
+
+/**
+ * Stop the sender thread after draining its queue
+ *
+ * Safe while producers are still sending; they fall back to synchronous
+ * delivery. Called by telem_cleanup().
+ */
+void telem_stop_sender(void);
+
+/**
+ * Check whether the background sender is running
+ */
+bool telem_sender_running(void);
+
+/**
+ * Convert a detector timestamp in ms to the record sample clock
+ */
+static inline uint64_t telem_ms_to_us(double timestamp_ms) {
+    return timestamp_ms > 0.0f ? (uint64_t)((double)timestamp_ms * 1000.0) : 0;
+}
+
 /**
  * Get channel prefix string for message formatting
  * @param channel  Channel enum value
@@ -132,6 +243,13 @@ const char *telem_channel_prefix(telem_channel_t channel);
  */
 void telem_get_stats(uint32_t *sent, uint32_t *dropped);
 
+/**
+ * Get statistics for a single channel
+ * @param channel  Channel enum value
+ * @param stats    Receives the channel's sent/dropped counters
+ */
+void telem_get_channel_stats(telem_channel_t channel, telem_channel_stats_t *stats);
+
 /**
  * Send console message (buffered for hot-path performance)
  *
@@ -151,6 +269,56 @@ void telem_console(const char *fmt, ...);
  */
 void telem_console_flush(void);
 
+/*============================================================================
+ * Per-Instance Contexts
+ *============================================================================*/
+
+/**
+ * Open a telemetry context with its own socket
+ * @param address  Destination IPv4 address, NULL for 255.255.255.255
+ * @param port     Destination UDP port (0 for default 3005)
+ * @return New context with all channels enabled, NULL on socket error
+ */
+telem_ctx_t *telem_ctx_create(const char *address, int port);
+
+/**
+ * Stop the context's sender, flush and close its socket
+ */
+void telem_ctx_destroy(telem_ctx_t *ctx);
+
+/**
+ * Get the context used by the telem_* functions
+ */
+telem_ctx_t *telem_default_ctx(void);
+
+void telem_ctx_enable(telem_ctx_t *ctx, uint32_t channels);
+void telem_ctx_disable(telem_ctx_t *ctx, uint32_t channels);
+void telem_ctx_set_channels(telem_ctx_t *ctx, uint32_t channels);
+uint32_t telem_ctx_get_channels(telem_ctx_t *ctx);
+bool telem_ctx_is_enabled(telem_ctx_t *ctx, telem_channel_t channel);
+
+void telem_ctx_send(telem_ctx_t *ctx, telem_channel_t channel, const char *csv_line);
+void telem_ctx_sendf(telem_ctx_t *ctx, telem_channel_t channel, const char *fmt, ...);
+
+void telem_ctx_set_format(telem_ctx_t *ctx, telem_format_t format);
+telem_format_t telem_ctx_get_format(telem_ctx_t *ctx);
+bool telem_ctx_binary_active(telem_ctx_t *ctx, telem_channel_t channel);
+void telem_ctx_send_record(telem_ctx_t *ctx, telem_channel_t channel, uint8_t type,
+                           uint32_t wall_time, uint64_t sample_us,
+                           const void *payload, uint16_t length);
+void telem_ctx_flush(telem_ctx_t *ctx);
+
+bool telem_ctx_start_sender(telem_ctx_t *ctx, const telem_sender_config_t *config);
+void telem_ctx_stop_sender(telem_ctx_t *ctx);
+bool telem_ctx_sender_running(telem_ctx_t *ctx);
+
+void telem_ctx_get_stats(telem_ctx_t *ctx, uint32_t *sent, uint32_t *dropped);
+void telem_ctx_get_channel_stats(telem_ctx_t *ctx, telem_channel_t channel,
+                                 telem_channel_stats_t *stats);
+
+void telem_ctx_console(telem_ctx_t *ctx, const char *fmt, ...);
+void telem_ctx_console_flush(telem_ctx_t *ctx);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,239 @@
+/**
+ * @file telemetry_wire.h
+ * @brief Binary telemetry wire format
+ *
+ * Compact alternative to the CSV text lines. One UDP datagram carries a
+ * frame header followed by up to 255 records, each with its own header
+ * and a fixed-layout payload struct:
+ *
+ *   telem_wire_frame_header_t
+ *   telem_wire_record_header_t + payload
+ *   telem_wire_record_header_t + payload
+ *   ...
+ *
+ * All fields are little-endian. Structs are laid out without implicit
+ * padding (checked below) so they can be copied to and from the wire
+ * directly on little-endian hosts. Records are not aligned inside the
+ * datagram; receivers should memcpy payloads out rather than cast.
+ *
+ * Receivers must skip records with unknown type using the length field,
+ * and may see payloads longer than the struct they know (fields are only
+ * ever appended).
+ */
+
+#ifndef TELEMETRY_WIRE_H
+#define TELEMETRY_WIRE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Framing
+ *============================================================================*/
+
+#define TELEM_WIRE_MAGIC            0x42565757u  /* "WWVB" little-endian */
+#define TELEM_WIRE_VERSION          1
+#define TELEM_WIRE_MTU              1400         /* Datagram budget (fits Ethernet MTU) */
+#define TELEM_WIRE_MAX_RECORDS      255
+
+typedef struct {
+    uint32_t magic;             /* TELEM_WIRE_MAGIC */
+    uint8_t  version;           /* TELEM_WIRE_VERSION */
+    uint8_t  record_count;
+    uint16_t length;            /* Total datagram bytes including this header */
+    uint32_t sequence;          /* Datagram counter, wraps */
+} telem_wire_frame_header_t;
+
+typedef struct {
+    uint8_t  channel;           /* Bit index of the telem_channel_t (TELEM_TICKS = 1) */
+    uint8_t  type;              /* telem_record_type_t */
+    uint16_t length;            /* Payload bytes following this header */
+    uint32_t wall_time;         /* Unix seconds of the event (0 if unknown) */
+    uint64_t sample_us;         /* Sample-clock time since detector start, microseconds */
+} telem_wire_record_header_t;
+
+typedef enum {
+    TELEM_REC_TEXT = 0,         /* Payload is the CSV text line (no prefix, no NUL) */
+    TELEM_REC_TICK,             /* telem_rec_tick_t */
+    TELEM_REC_MARKER,           /* telem_rec_marker_t */
+    TELEM_REC_MARKER_CORR,      /* telem_rec_marker_corr_t */
+    TELEM_REC_SYNC,             /* telem_rec_sync_t */
+    TELEM_REC_SYNC_STATE,       /* telem_rec_sync_state_t */
+    TELEM_REC_BCD_PULSE,        /* telem_rec_bcd_pulse_t */
+    TELEM_REC_BCD_SYMBOL,       /* telem_rec_bcd_symbol_t */
+    TELEM_REC_BCD_PATH          /* telem_rec_bcd_path_t */
+} telem_record_type_t;
+
+/*============================================================================
+ * Payloads
+ *============================================================================*/
+
+/* TELEM_TICKS: tick or minute marker from the tick detector */
+typedef struct {
+    uint32_t number;            /* Tick number, or marker number if is_marker */
+    uint8_t  is_marker;
+    uint8_t  expected_event;    /* wwv_event_type_t */
+    uint16_t reserved;
+    float    energy_peak;
+    float    duration_ms;
+    float    interval_ms;
+    float    avg_interval_ms;
+    float    noise_floor;
+    float    corr_peak;
+    float    corr_ratio;
+} telem_rec_tick_t;
+
+/* TELEM_MARKERS: minute marker from the marker detector */
+typedef struct {
+    uint32_t number;
+    int32_t  wwv_second;
+    uint8_t  expected_event;    /* wwv_event_type_t */
+    uint8_t  reserved[3];
+    float    peak_energy;
+    float    duration_ms;
+    float    since_last_sec;
+    float    baseline;
+    float    threshold;
+} telem_rec_marker_t;
+
+/* TELEM_MARKERS: correlated marker from the marker correlator */
+typedef struct {
+    uint32_t number;
+    uint8_t  confidence;        /* 0 = LOW, 1 = HIGH */
+    uint8_t  reserved[3];
+    float    duration_ms;
+    float    energy;
+    float    snr_db;
+} telem_rec_marker_corr_t;
+
+/* TELEM_SYNC: confirmed marker / periodic state broadcast */
+typedef struct {
+    uint32_t confirmed_count;
+    uint8_t  state;             /* sync_state_t */
+    uint8_t  reserved;
+    uint16_t good_intervals;
+    float    interval_sec;
+    float    delta_ms;
+    float    tick_duration_ms;
+    float    marker_duration_ms;
+    float    last_confirmed_ms;
+} telem_rec_sync_t;
+
+/* TELEM_SYNC: state transition */
+typedef struct {
+    uint8_t  old_state;         /* sync_state_t */
+    uint8_t  new_state;
+    uint16_t reserved;
+    float    confidence;
+} telem_rec_sync_state_t;
+
+/* TELEM_BCDS: 100 Hz pulse from the time- or frequency-domain detector */
+typedef struct {
+    uint32_t number;
+    uint8_t  path;              /* 0 = time domain, 1 = frequency domain */
+    uint8_t  reserved[3];
+    float    energy;
+    float    duration_ms;
+    float    noise_floor;
+    float    snr_db;
+} telem_rec_bcd_pulse_t;
+
+/* TELEM_BCDS: per-second symbol from the BCD correlator */
+typedef struct {
+    uint32_t number;
+    int8_t   symbol;            /* bcd_corr_symbol_t (-1 = none) */
+    int8_t   second;            /* -1 if not yet known */
+    uint8_t  state;             /* bcd_corr_state_t */
+    uint8_t  reserved;
+    uint16_t time_events;
+    uint16_t freq_events;
+    float    duration_ms;
+    float    confidence;
+    float    interval_sec;
+    float    time_energy;
+    float    freq_energy;
+} telem_rec_bcd_symbol_t;
+
+/* TELEM_BCDS: adaptive BCD path switch (bcd_path_policy.h) */
+typedef struct {
+    uint8_t  mode;              /* bcd_path_mode_t */
+    uint8_t  reason;            /* bcd_path_reason_t */
+    uint16_t reserved;
+    uint32_t switches;
+    float    snr_db;
+    float    time_rate;
+    float    agreement;
+} telem_rec_bcd_path_t;
+
+_Static_assert(sizeof(telem_wire_frame_header_t) == 12, "frame header layout");
+_Static_assert(sizeof(telem_wire_record_header_t) == 16, "record header layout");
+_Static_assert(sizeof(telem_rec_tick_t) == 36, "tick record layout");
+_Static_assert(sizeof(telem_rec_marker_t) == 32, "marker record layout");
+_Static_assert(sizeof(telem_rec_marker_corr_t) == 20, "marker corr record layout");
+_Static_assert(sizeof(telem_rec_sync_t) == 28, "sync record layout");
+_Static_assert(sizeof(telem_rec_sync_state_t) == 8, "sync state record layout");
+_Static_assert(sizeof(telem_rec_bcd_pulse_t) == 24, "bcd pulse record layout");
+_Static_assert(sizeof(telem_rec_bcd_symbol_t) == 32, "bcd symbol record layout");
+_Static_assert(sizeof(telem_rec_bcd_path_t) == 20, "bcd path record layout");
+
+/*============================================================================
+ * Frame Builder
+ *============================================================================*/
+
+typedef struct {
+    uint8_t  data[TELEM_WIRE_MTU];
+    size_t   length;            /* Bytes used including frame header */
+    uint8_t  record_count;
+    uint64_t first_sample_us;   /* sample_us of the oldest record in the frame */
+} telem_wire_frame_t;
+
+/**
+ * Start an empty frame
+ */
+void telem_wire_frame_reset(telem_wire_frame_t *frame);
+
+/**
+ * Append a record
+ * @return false if the record does not fit (frame unchanged)
+ */
+bool telem_wire_frame_append(telem_wire_frame_t *frame, uint8_t channel, uint8_t type,
+                             uint32_t wall_time, uint64_t sample_us,
+                             const void *payload, uint16_t length);
+
+/**
+ * Fill in the frame header
+ * @return Datagram length in bytes (0 if the frame holds no records)
+ */
+size_t telem_wire_frame_finish(telem_wire_frame_t *frame, uint32_t sequence);
+
+/*============================================================================
+ * Parser (for receivers and tests)
+ *============================================================================*/
+
+/**
+ * Validate a datagram's frame header
+ * @return true if magic, version and length are consistent
+ */
+bool telem_wire_parse_header(const void *datagram, size_t length,
+                             telem_wire_frame_header_t *header);
+
+/**
+ * Iterate records
+ * @param offset   In: position of next record (start at sizeof frame header)
+ *                 Out: advanced past the returned record
+ * @param payload  Receives pointer to payload bytes inside datagram
+ * @return false at end of datagram or on a truncated record
+ */
+bool telem_wire_next_record(const void *datagram, size_t length, size_t *offset,
+                            telem_wire_record_header_t *record, const uint8_t **payload);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TELEMETRY_WIRE_H */
@@ -12,6 +12,8 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "telemetry.h"
+#include "wwv_state.h"
 
 typedef struct tick_correlator tick_correlator_t;
 
@@ -23,6 +25,12 @@ typedef struct tick_correlator tick_correlator_t;
 #define CORR_MIN_INTERVAL_MS    998.0f    /* Min expected interval (proven discipline) */
 #define CORR_NOMINAL_INTERVAL   1000.0f   /* Expected tick interval */
 
+/* History rings: older chains and tick records are overwritten, so memory
+ * stays flat for any run length. Counts and the longest chains are kept
+ * for the whole run. */
+#define CORR_DEFAULT_CHAIN_HISTORY  256       /* Chains kept for get_chain_stats() */
+#define CORR_DEFAULT_TICK_HISTORY   3600      /* Tick records, one hour of ticks */
+
 /*============================================================================
  * Tick Record (matches tick_detector CSV output + correlation fields)
  *============================================================================*/
@@ -30,7 +38,8 @@ typedef struct tick_correlator tick_correlator_t;
 typedef struct {
     /* From tick_detector */
     char time_str[16];          /* Wall clock HH:MM:SS */
-    float timestamp_ms;         /* ms since start */
+    double timestamp_ms;        /* ms since start */
+    double epoch_ms;            /* Pulse start used for intervals and drift */
     int tick_num;               /* Tick number from detector */
     char expected[16];          /* WWV expected event */
     float energy_peak;          /* Peak energy */
@@ -44,7 +53,7 @@ typedef struct {
     /* Correlation fields */
     int chain_id;               /* Correlation chain ID (0 = uncorrelated) */
     int chain_position;         /* Position within chain (1, 2, 3...) */
-    float chain_start_ms;       /* Timestamp of chain start */
+    double chain_start_ms;      /* Timestamp of chain start */
     float drift_ms;             /* Cumulative drift from nominal */
 } tick_record_t;
 
@@ -60,8 +69,8 @@ typedef struct {
      * than breaking the chain, we allow single-skip intervals and track how many
      * were inferred. Higher inferred_count = lower chain quality. Added v1.0.1+19. */
     int inferred_count;
-    float start_ms;
-    float end_ms;
+    double start_ms;
+    double end_ms;
     float total_drift_ms;       /* Accumulated drift from nominal */
     float avg_interval_ms;
     float min_interval_ms;
@@ -74,12 +83,19 @@ typedef struct {
 
 /* Create/destroy */
 tick_correlator_t *tick_correlator_create(const char *csv_path);
+
+/* Create with history sizes (<= 0 = CORR_DEFAULT_CHAIN_HISTORY / _TICK_HISTORY) */
+tick_correlator_t *tick_correlator_create_sized(const char *csv_path,
+                                                int chain_history, int tick_history);
 void tick_correlator_destroy(tick_correlator_t *tc);
 
-/* Add tick from detector (call for each tick event) */
+/* Add tick from detector (call for each tick event). Intervals, drift and
+ * chain statistics come from epoch_ms (tick_event_t.epoch_ms, 0 = use
+ * timestamp_ms); the record, CSV and epoch offset keep timestamp_ms. */
 void tick_correlator_add_tick(tick_correlator_t *tc,
                               const char *time_str,
-                              float timestamp_ms,
+                              double timestamp_ms,
+                              double epoch_ms,
                               int tick_num,
                               const char *expected,
                               float energy_peak,
@@ -94,8 +110,15 @@ void tick_correlator_add_tick(tick_correlator_t *tc,
 int tick_correlator_get_chain_count(tick_correlator_t *tc);
 int tick_correlator_get_current_chain_length(tick_correlator_t *tc);
 float tick_correlator_get_current_drift(tick_correlator_t *tc);
+/* Chain statistics; zeroed if chain_id is unknown or has left the history ring */
 chain_stats_t tick_correlator_get_chain_stats(tick_correlator_t *tc, int chain_id);
 
+/* Longest chains of the run, longest first; fills up to max, returns the count */
+int tick_correlator_get_top_chains(tick_correlator_t *tc, chain_stats_t *out, int max);
+
+/* Tick record age ticks back (0 = latest); false if not in the history ring */
+bool tick_correlator_get_tick(tick_correlator_t *tc, int age, tick_record_t *out);
+
 /* Print summary */
 void tick_correlator_print_stats(tick_correlator_t *tc);
 
@@ -113,6 +136,11 @@ typedef void (*epoch_callback_fn)(float epoch_offset_ms, float std_dev_ms, float
  */
 void tick_correlator_set_epoch_callback(tick_correlator_t *tc, epoch_callback_fn callback, void *user_data);
 
+/**
+ * Route UDP telemetry to a context (NULL = default context)
+ */
+void tick_correlator_set_telemetry(tick_correlator_t *tc, telem_ctx_t *ctx);
+
 /*============================================================================
  * Runtime Parameter Tuning
  *============================================================================*/
@@ -125,4 +153,18 @@ float tick_correlator_get_epoch_confidence(tick_correlator_t *tc);
 void tick_correlator_set_max_misses(tick_correlator_t *tc, int max_misses);
 int tick_correlator_get_max_misses(tick_correlator_t *tc);
 
+/*============================================================================
+ * Warm Start (wwv_state.h)
+ *============================================================================*/
+
+/**
+ * Save the current chain (statistics, recent intervals, tracking discipline)
+ * Restore into a correlator that has seen no ticks yet, within
+ * WWV_STATE_TIMING_MAX_AGE_MS: it becomes chain #1, with its last tick
+ * carried to the new stream's second phase, so a tick in the first two
+ * seconds continues it.
+ */
+bool tick_correlator_save_state(tick_correlator_t *tc, wwv_state_writer_t *w);
+bool tick_correlator_restore_state(tick_correlator_t *tc, const wwv_state_reader_t *r);
+
 #endif /* TICK_CORRELATOR_H */
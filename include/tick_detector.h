@@ -10,6 +10,28 @@
  *   - Each detector maintains its own sample buffer
  *   - Each detector runs its own state machine
  *   - Detectors can run in parallel on same sample stream
+ *
+ * STATIONS:
+ *   A detector watches one or both stations (1000 Hz WWV, 1200 Hz WWVH).
+ *   With both, the sample buffer, FFT frame and matched filter history are
+ *   shared; each station adds an FFT band, three sliding DFT bins and its
+ *   own state machine, gate and epoch. A 5 ms pulse is too short to
+ *   separate 200 Hz apart by frequency alone (either correlator sees the
+ *   other station at about half amplitude), so a pulse is attributed to a
+ *   station only if that station's correlation peak beats every other
+ *   station's over the same span; the rest are counted as crosstalk and
+ *   the state machine goes straight back to idle, so the other station's
+ *   own tick a few ms later is still caught.
+ *
+ * BASEBAND:
+ *   A detector from tick_detector_create_baseband() is fed the 3125 Hz
+ *   streams of a baseband_frontend_t instead of 50 kHz. Frames are still
+ *   5.12 ms with the same bins (16-point FFTs, one per sideband), the
+ *   matched filter is 16 taps, and the state machine, gate and events are
+ *   unchanged: timestamps and sample indices stay on the 50 kHz clock.
+ *   Correlation is scaled to the full-rate level, so corr_peak and the
+ *   thresholds compare across the two. The epoch is interpolated between
+ *   0.32 ms samples instead of 20 us ones.
  */
 
 #ifndef TICK_DETECTOR_H
@@ -17,7 +39,13 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
+#include "telemetry.h"
+#include "wwv_perf.h"
+#include "wwv_clock.h"
+#include "wwv_state.h"
+#include "baseband_frontend.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -29,13 +57,26 @@ extern "C" {
 
 #define TICK_FFT_SIZE           256     /* 5.12ms frames at 50kHz - matches 5ms WWV pulse */
 #define TICK_SAMPLE_RATE        50000   /* Expected input sample rate (2MHz/40 = exact) */
-#define TICK_TARGET_FREQ_HZ     1000    /* Frequency bucket to watch */
+#define TICK_TARGET_FREQ_HZ     1000    /* Frequency bucket to watch (WWV) */
+#define TICK_WWVH_FREQ_HZ       1200    /* WWVH tick frequency */
 #define TICK_BANDWIDTH_HZ       100     /* Width of detection bucket */
+#define TICK_MAX_STATIONS       2       /* WWV and WWVH */
 
 /* Matched filter template */
 #define TICK_PULSE_MS           5.0f    /* WWV tick pulse duration */
-#define TICK_TEMPLATE_SAMPLES   ((int)(TICK_PULSE_MS * TICK_SAMPLE_RATE / 1000.0f))  /* 240 samples */
-#define TICK_CORR_BUFFER_SIZE   512     /* Must be > TICK_TEMPLATE_SAMPLES */
+#define TICK_TEMPLATE_SAMPLES   (TICK_SAMPLE_RATE * 5 / 1000)  /* 250 samples = TICK_PULSE_MS (integer constant) */
+#define TICK_CORR_BUFFER_SIZE   2048    /* Must be > TICK_TEMPLATE_SAMPLES; epoch refinement look-back */
+#define TICK_BASEBAND_TEMPLATE_SAMPLES  16  /* 5.12 ms at BASEBAND_RATE */
+
+/**
+ * Matched filter implementation
+ *   SLIDING   - recursive sliding DFT, correlation every sample (default)
+ *   REFERENCE - direct template MAC every CORR_DECIMATION samples
+ */
+typedef enum {
+    TICK_CORR_MODE_SLIDING = 0,
+    TICK_CORR_MODE_REFERENCE
+} tick_corr_mode_t;
 
 /*============================================================================
  * Detector State (opaque to caller)
@@ -48,8 +89,14 @@ typedef struct tick_detector tick_detector_t;
  *============================================================================*/
 
 typedef struct {
-    int tick_number;
-    float timestamp_ms;
+    int tick_number;            /* Per station */
+    wwv_station_t station;      /* Station the pulse was attributed to */
+    double timestamp_ms;
+    uint64_t sample_index;      /* Input sample (TICK_SAMPLE_RATE) at timestamp_ms */
+    double epoch_ms;            /* Pulse leading edge from the matched filter,
+                                 * sub-sample; the start frame's time if the
+                                 * pulse has left the correlation buffer */
+    bool epoch_refined;         /* epoch_ms is the sub-sample estimate */
     float interval_ms;
     float duration_ms;
     float peak_energy;
@@ -71,9 +118,12 @@ typedef void (*tick_callback_fn)(const tick_event_t *event, void *user_data);
 #define TICK_FILTER_DELAY_MS       3.0f     /* Filter group delay (2.55ms Hann + 0.32ms Butterworth + 0.13ms decimation) */
 
 typedef struct {
-    int marker_number;
-    float timestamp_ms;        /* TRAILING EDGE - when pulse energy dropped below threshold */
-    float start_timestamp_ms;  /* LEADING EDGE - timestamp_ms - duration_ms - TICK_FILTER_DELAY_MS (ON-TIME MARKER) */
+    int marker_number;         /* Per station */
+    wwv_station_t station;
+    double timestamp_ms;       /* TRAILING EDGE - when pulse energy dropped below threshold */
+    double start_timestamp_ms; /* LEADING EDGE - timestamp_ms - duration_ms - TICK_FILTER_DELAY_MS (ON-TIME MARKER) */
+    uint64_t sample_index;     /* Input sample (TICK_SAMPLE_RATE) at timestamp_ms */
+    uint64_t start_sample_index; /* Input sample at start_timestamp_ms */
     float duration_ms;         /* Measured duration (may be biased longer than actual due to threshold hysteresis) */
     float corr_ratio;
     float interval_ms;         /* Time since previous marker */
@@ -92,6 +142,26 @@ typedef void (*tick_marker_callback_fn)(const tick_marker_event_t *event, void *
  */
 tick_detector_t *tick_detector_create(const char *csv_path);
 
+/**
+ * Create a detector for one or more stations sharing one sample stream
+ * @param stations  Distinct stations, the first is the primary
+ * @param count     1..TICK_MAX_STATIONS
+ * @return          Detector instance or NULL on failure / invalid list
+ *
+ * tick_detector_create() is the single-station {WWV_STATION_WWV} case.
+ * Functions without a station argument act on the primary station, except
+ * enable, gating and the tunables, which apply to every station.
+ */
+tick_detector_t *tick_detector_create_stations(const char *csv_path,
+                                               const wwv_station_t *stations, int count);
+
+/**
+ * Create a detector fed from a baseband_frontend_t (see BASEBAND above)
+ * Takes tick_detector_process_baseband() input only.
+ */
+tick_detector_t *tick_detector_create_baseband(const char *csv_path,
+                                               const wwv_station_t *stations, int count);
+
 /**
  * Destroy a tick detector instance
  */
@@ -105,6 +175,16 @@ void tick_detector_destroy(tick_detector_t *td);
  */
 void tick_detector_set_callback(tick_detector_t *td, tick_callback_fn callback, void *user_data);
 
+/**
+ * Route UDP telemetry to a context (NULL = default context)
+ */
+void tick_detector_set_telemetry(tick_detector_t *td, telem_ctx_t *ctx);
+
+/**
+ * Time FFT and state machine stages (and CSV rows) into perf (NULL = off)
+ */
+void tick_detector_set_perf(tick_detector_t *td, wwv_perf_t *perf);
+
 /**
  * Set callback for minute marker events (duration-based detection)
  * @param td        Detector instance
@@ -123,6 +203,25 @@ void tick_detector_set_marker_callback(tick_detector_t *td, tick_marker_callback
  */
 bool tick_detector_process_sample(tick_detector_t *td, float i_sample, float q_sample);
 
+/**
+ * Feed a block of I/Q samples to detector
+ * Equivalent to calling tick_detector_process_sample() for each sample,
+ * but copies into the FFT buffer one frame-sized chunk at a time
+ * @param td        Detector instance
+ * @param i_samples In-phase samples
+ * @param q_samples Quadrature samples
+ * @param count     Number of samples in each array
+ * @return          Number of ticks detected within the block
+ */
+int tick_detector_process_block(tick_detector_t *td, const float *i_samples,
+                                const float *q_samples, size_t count);
+
+/**
+ * Feed one baseband_frontend_t block (baseband detectors only)
+ * @return Number of ticks detected within the block
+ */
+int tick_detector_process_baseband(tick_detector_t *td, const baseband_block_t *block);
+
 /**
  * Check if detector is flashing (for UI display)
  * @param td        Detector instance
@@ -211,6 +310,68 @@ bool tick_detector_is_gating_enabled(tick_detector_t *td);
 epoch_source_t tick_detector_get_epoch_source(tick_detector_t *td);
 float tick_detector_get_epoch_confidence(tick_detector_t *td);
 
+/**
+ * Per-station access
+ * @return Defaults (0, EPOCH_SOURCE_NONE, false) for a station the
+ *         detector does not watch
+ */
+int tick_detector_get_station_count(tick_detector_t *td);
+bool tick_detector_has_station(tick_detector_t *td, wwv_station_t station);
+int tick_detector_get_station_tick_count(tick_detector_t *td, wwv_station_t station);
+int tick_detector_get_station_marker_count(tick_detector_t *td, wwv_station_t station);
+int tick_detector_get_crosstalk_count(tick_detector_t *td, wwv_station_t station);
+
+/**
+ * Gate epoch for one station (the stations' seconds arrive at different
+ * times, so each gates on its own epoch)
+ */
+void tick_detector_set_station_epoch(tick_detector_t *td, wwv_station_t station, float epoch_ms,
+                                     epoch_source_t source, float confidence);
+float tick_detector_get_station_epoch(tick_detector_t *td, wwv_station_t station);
+
+/**
+ * Epoch measured from the station's own recent ticks: circular mean of
+ * the tick times modulo one second (0-999 ms)
+ * @return false with fewer than 3 ticks in the history
+ */
+bool tick_detector_get_measured_epoch(tick_detector_t *td, wwv_station_t station, float *epoch_ms);
+
+/**
+ * Economy mode (default off) - for use once timing is locked
+ *
+ * With gating enabled, each FFT frame and its matched filter run only
+ * inside the gate window plus a guard band, while a pulse is in progress,
+ * and on sparse noise floor probes; the other ~80% of frames only advance
+ * the sample history and cooldown. A channel in warmup or gate recovery,
+ * or with gating off, keeps every frame computed, so loss of lock falls
+ * back to full-time processing by itself.
+ */
+void tick_detector_set_economy(tick_detector_t *td, bool enabled);
+bool tick_detector_get_economy(tick_detector_t *td);
+uint64_t tick_detector_get_skipped_frames(tick_detector_t *td);
+
+/**
+ * Jump the stream ahead by samples not fed (duty-cycled sleep)
+ *
+ * Frame count and sample clock advance as if the gap had been processed,
+ * so timestamps and the gate epoch stay on the broadcast's second. Levels
+ * and the gate are kept; the pulse in progress, the matched filter
+ * history and the interval to the last tick are dropped, and gate
+ * recovery counts from the wake. Must start and end on a frame boundary.
+ * @return false off the frame grid or on a baseband detector
+ */
+bool tick_detector_skip(tick_detector_t *td, uint64_t samples);
+
+/**
+ * Warm-start snapshot (wwv_state.h)
+ * Saves each station's noise floors, thresholds and timing gate. Restore
+ * skips warmup; the gate epoch is carried to the new stream only within
+ * WWV_STATE_TIMING_MAX_AGE_MS, levels within WWV_STATE_LEVELS_MAX_AGE_MS.
+ * @return false if nothing was saved / restored
+ */
+bool tick_detector_save_state(tick_detector_t *td, wwv_state_writer_t *w);
+bool tick_detector_restore_state(tick_detector_t *td, const wwv_state_reader_t *r);
+
 /**
  * Runtime tunable parameters (UDP command interface)
  * Ranges validated in setters, invalid values rejected with false return
@@ -225,6 +386,13 @@ float tick_detector_get_adapt_alpha_down(tick_detector_t *td);
 float tick_detector_get_adapt_alpha_up(tick_detector_t *td);
 float tick_detector_get_min_duration_ms(tick_detector_t *td);
 
+/**
+ * Select matched filter implementation (see tick_corr_mode_t)
+ * Reference mode is kept for comparing correlation output
+ */
+void tick_detector_set_corr_mode(tick_detector_t *td, tick_corr_mode_t mode);
+tick_corr_mode_t tick_detector_get_corr_mode(tick_detector_t *td);
+
 #ifdef __cplusplus
 }
 #endif
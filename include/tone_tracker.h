@@ -5,13 +5,24 @@
  * Tracks 500 Hz and 600 Hz reference tones to measure receiver
  * LO offset and drift. Uses parabolic interpolation for sub-bin
  * frequency accuracy.
+ *
+ * Estimates are demand-driven: samples are always buffered, but the FFT
+ * only runs every hop while something consumes every estimate (CSV log,
+ * callback, or this tracker's CARR/T500/T600 telemetry channel enabled).
+ * Otherwise a hop only marks the estimate stale and the next getter call
+ * measures the current window.
  */
 
 #ifndef TONE_TRACKER_H
 #define TONE_TRACKER_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
+#include "wwv_perf.h"
+#include "telemetry.h"
+#include "wwv_state.h"
+#include "channel_quality.h"
 
 typedef struct tone_tracker tone_tracker_t;
 
@@ -26,6 +37,37 @@ typedef struct tone_tracker tone_tracker_t;
 
 #define CARRIER_NOMINAL_HZ      10000000.0f /* 10 MHz WWV for PPM scaling */
 
+/* Measurement cadence: one estimate per hop over the last TONE_FFT_SIZE
+ * samples. The default hop is the full window (no overlap). */
+#define TONE_DEFAULT_HOP        TONE_FFT_SIZE
+#define TONE_OVERLAP_HOP        1024        /* 75% overlap, ~85 ms updates */
+
+/* Adaptive zoom: once locked, the window is low-passed and decimated by
+ * TONE_ZOOM_DECIMATION (±1.5 kHz still covers both sidebands and the noise
+ * bins) and measured with a TONE_ZOOM_FFT_SIZE FFT on the same Hz/bin grid */
+#define TONE_ZOOM_DECIMATION    4
+#define TONE_ZOOM_FFT_SIZE      (TONE_FFT_SIZE / TONE_ZOOM_DECIMATION)
+#define TONE_ZOOM_TAPS          48
+#define TONE_ZOOM_LOCK_COUNT    3           /* Consecutive valid estimates to zoom */
+
+/* Fine refinement: narrow-band DFT around each located peak (zoom_dft.h) */
+#define TONE_REFINE_SPAN_HZ     5.0f
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+typedef struct {
+    double timestamp_ms;        /* Start of the measured window (sample clock) */
+    float measured_hz;
+    float offset_hz;
+    float offset_ppm;
+    float snr_db;
+    bool valid;
+} tone_measurement_t;
+
+typedef void (*tone_callback_fn)(const tone_measurement_t *m, void *user_data);
+
 /*============================================================================
  * API
  *============================================================================*/
@@ -37,7 +79,39 @@ void tone_tracker_destroy(tone_tracker_t *tt);
 /* Feed samples (from 12 kHz display path) */
 void tone_tracker_process_sample(tone_tracker_t *tt, float i, float q);
 
-/* Query results */
+/* Samples not fed (duty-cycled sleep): the window restarts empty and the
+ * next estimate waits for it to refill; not for trackers on a spectrum */
+void tone_tracker_skip(tone_tracker_t *tt, uint64_t samples);
+
+/* Samples between estimates, 1..TONE_FFT_SIZE (rounded down to a multiple
+ * of TONE_ZOOM_DECIMATION); e.g. TONE_OVERLAP_HOP for 75% overlap */
+void tone_tracker_set_hop_size(tone_tracker_t *tt, int hop);
+int tone_tracker_get_hop_size(tone_tracker_t *tt);
+
+/* Switch to the decimated zoom FFT while locked (off by default) */
+void tone_tracker_set_adaptive_zoom(tone_tracker_t *tt, bool enable);
+bool tone_tracker_is_zoomed(tone_tracker_t *tt);
+
+/* Refine each peak to millihertz with zoom_dft instead of parabolic
+ * interpolation alone (off by default) */
+void tone_tracker_set_fine_refinement(tone_tracker_t *tt, bool enable);
+
+/* Time FFT and estimate stages (and CSV rows) into perf (NULL = off) */
+void tone_tracker_set_perf(tone_tracker_t *tt, wwv_perf_t *perf);
+
+/* Called with every estimate; a callback makes the tracker estimate every hop */
+void tone_tracker_set_callback(tone_tracker_t *tt, tone_callback_fn cb, void *user_data);
+
+/* CARR (0 Hz), T500 or T600 destination, NULL = default context; while the
+ * channel is enabled every estimate is measured and sent */
+void tone_tracker_set_telemetry(tone_tracker_t *tt, telem_ctx_t *ctx);
+
+/* Demand-driven estimates (default on); off measures every hop regardless,
+ * e.g. to time the estimate path */
+void tone_tracker_set_demand_driven(tone_tracker_t *tt, bool enable);
+
+/* Query results (a stale estimate is measured first) */
+bool tone_tracker_get_measurement(tone_tracker_t *tt, tone_measurement_t *out);
 float tone_tracker_get_measured_hz(tone_tracker_t *tt);
 float tone_tracker_get_offset_hz(tone_tracker_t *tt);
 float tone_tracker_get_offset_ppm(tone_tracker_t *tt);
@@ -46,6 +120,58 @@ float tone_tracker_get_noise_floor(tone_tracker_t *tt);
 bool tone_tracker_is_valid(tone_tracker_t *tt);
 uint64_t tone_tracker_get_frame_count(tone_tracker_t *tt);
 
+/* Warm start (wwv_state.h): the last estimate, one section per nominal tone,
+ * reported until the first new one (within WWV_STATE_LEVELS_MAX_AGE_MS) */
+bool tone_tracker_save_state(tone_tracker_t *tt, wwv_state_writer_t *w);
+bool tone_tracker_restore_state(tone_tracker_t *tt, const wwv_state_reader_t *r);
+
+/*============================================================================
+ * Shared Spectrum
+ *
+ * Trackers on the same 12 kHz input differ only in the bins they search,
+ * so one window and one TONE_FFT_SIZE FFT per hop can serve all of them.
+ * Attached trackers stop using their own window (no zoom; fine refinement
+ * runs on the shared window) and are fed through the spectrum instead of
+ * tone_tracker_process_sample(). Each keeps its own hop, which should be a
+ * multiple of the spectrum's. Demand is the union of the trackers': the
+ * FFT runs on a hop only if a tracker due then or the tap takes every
+ * estimate, else on the first getter call.
+ *============================================================================*/
+
+#define TONE_SPECTRUM_MAX_TRACKERS  4
+
+typedef struct tone_spectrum tone_spectrum_t;
+
+/* Magnitudes (TONE_FFT_SIZE bins) of each computed hop */
+typedef void (*tone_spectrum_fn)(const float *magnitudes, int fft_size,
+                                 double timestamp_ms, void *user_data);
+
+/* hop as for tone_tracker_set_hop_size() */
+tone_spectrum_t *tone_spectrum_create(int hop);
+
+/* Destroy before the attached trackers */
+void tone_spectrum_destroy(tone_spectrum_t *ts);
+
+bool tone_spectrum_attach(tone_spectrum_t *ts, tone_tracker_t *tt);
+
+/* Receives every hop's magnitudes, so the FFT then runs every hop */
+void tone_spectrum_set_tap(tone_spectrum_t *ts, tone_spectrum_fn fn, void *user_data);
+
+/* Computed hops also feed cq, and attached trackers take its noise floor
+ * rather than each estimating the same bins again */
+void tone_spectrum_set_channel_quality(tone_spectrum_t *ts, channel_quality_t *cq);
+
+void tone_spectrum_process_block(tone_spectrum_t *ts, const float *i_samples,
+                                 const float *q_samples, size_t count);
+
+/* tone_tracker_skip() for the shared window and its trackers */
+void tone_spectrum_skip(tone_spectrum_t *ts, uint64_t samples);
+
+void tone_spectrum_set_perf(tone_spectrum_t *ts, wwv_perf_t *perf);
+
+/* FFTs actually computed */
+uint64_t tone_spectrum_get_fft_count(const tone_spectrum_t *ts);
+
 /* Global subcarrier noise floor - exported for marker detector baseline */
 extern float g_subcarrier_noise_floor;
 
@@ -0,0 +1,136 @@
+/**
+ * @file wwv_arena.h
+ * @brief Caller-supplied memory arena and the library allocation hooks
+ *
+ * Every per-instance allocation in the library goes through wwv_malloc(),
+ * wwv_calloc() and wwv_free() (and the aligned variants). Normally they
+ * are the C heap. While an arena is pushed on the calling thread they bump
+ * cache-line-aligned blocks out of it instead; wwv_free() on a block that
+ * lies inside a live arena is a no-op, so existing destroy paths work
+ * unchanged and the memory is reclaimed when the caller drops the arena.
+ *
+ * A measuring arena has no backing memory: allocations stay on the heap
+ * but their aligned sizes are tallied, which is how *_required_size()
+ * queries size an arena for a given configuration.
+ *
+ * With prefaulting on for the calling thread, every block the hooks hand
+ * out (heap or arena) has each of its pages written before it is
+ * returned, so a large delay line calloc'd as untouched zero pages does
+ * not take its page faults in the first DSP frames.
+ *
+ * Not routed through the arena: the process-wide FFT plan cache (plans
+ * are shared and refcounted across instances), worker thread start blocks
+ * and the stdio buffers behind CSV logs.
+ *
+ * Usage:
+ *   size_t need = wwv_detector_manager_required_size(&config);
+ *   static _Alignas(64) unsigned char mem[...];
+ *   wwv_detector_manager_t *mgr = wwv_detector_manager_create_in(&config, mem, need);
+ */
+
+#ifndef WWV_ARENA_H
+#define WWV_ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WWV_CACHE_LINE          64
+#define WWV_ARENA_ALIGN         WWV_CACHE_LINE  /* Every arena block starts on a cache line */
+#define WWV_ARENA_MAX_LIVE      16      /* Backed arenas registered at once */
+
+typedef struct wwv_arena wwv_arena_t;
+
+/*============================================================================
+ * Arena
+ *============================================================================*/
+
+/**
+ * Lay out an arena in caller memory (the header lives at its start)
+ * @return NULL if mem is too small or WWV_ARENA_MAX_LIVE arenas are live
+ */
+wwv_arena_t *wwv_arena_create_in(void *mem, size_t size);
+
+/**
+ * Heap-allocated arena that only tallies sizes (see wwv_arena_used())
+ */
+wwv_arena_t *wwv_arena_create_measure(void);
+
+/**
+ * Unregister the arena. Memory handed out from it must no longer be used;
+ * the caller's block can be reused afterwards.
+ */
+void wwv_arena_destroy(wwv_arena_t *arena);
+
+/**
+ * Bytes handed out so far, alignment padding included
+ */
+size_t wwv_arena_used(const wwv_arena_t *arena);
+
+/**
+ * Header and alignment slack wwv_arena_create_in() needs on top of the
+ * blocks themselves
+ */
+size_t wwv_arena_overhead(void);
+
+/**
+ * Route this thread's allocations to arena (NULL = heap)
+ * @return Previously active arena, to hand back to wwv_arena_pop()
+ */
+wwv_arena_t *wwv_arena_push(wwv_arena_t *arena);
+void wwv_arena_pop(wwv_arena_t *prev);
+
+/**
+ * True if a backed arena ran out of space since it was created
+ */
+bool wwv_arena_exhausted(const wwv_arena_t *arena);
+
+/*============================================================================
+ * Allocation Hooks
+ *============================================================================*/
+
+void *wwv_malloc(size_t size);
+void *wwv_calloc(size_t count, size_t size);
+void wwv_free(void *ptr);
+
+/**
+ * Aligned block (alignment a power of two); release with wwv_aligned_free()
+ */
+void *wwv_aligned_alloc(size_t alignment, size_t size);
+void wwv_aligned_free(void *ptr);
+
+/**
+ * Zeroed wwv_aligned_alloc(), for structs with cache-line _Alignas members
+ */
+void *wwv_aligned_calloc(size_t alignment, size_t size);
+
+/*============================================================================
+ * Prefaulting
+ *============================================================================*/
+
+#define WWV_PAGE_SIZE           4096    /* Touch stride (the smallest common page) */
+
+/**
+ * Prefault this thread's allocations from now on
+ * @return Previous setting, to hand back when done
+ */
+bool wwv_alloc_set_prefault(bool on);
+
+/**
+ * Bytes this thread has prefaulted so far
+ */
+size_t wwv_alloc_prefaulted(void);
+
+/**
+ * Write every page of [ptr, ptr + size) without changing its contents
+ */
+void wwv_prefault(void *ptr, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_ARENA_H */
@@ -0,0 +1,205 @@
+/**
+ * @file wwv_binlog.h
+ * @brief Columnar binary event log
+ *
+ * The binary form of a wwv_csv_log stream (wwv_csv_log_config_t.format):
+ * rows are stored as the arguments their format string captured, not as
+ * text. A file is a header and a sequence of chunks:
+ *
+ *   wwv_binlog_header_t
+ *   wwv_binlog_chunk_t + payload    HEADER  CSV header text, verbatim
+ *   wwv_binlog_chunk_t + payload    SCHEMA  a row type: format string, column types
+ *   wwv_binlog_chunk_t + payload    BLOCK   up to WWV_BINLOG_BLOCK_ROWS rows
+ *   ...
+ *
+ * Each distinct format string of a stream is a row type with fixed-width
+ * columns (%s text is length-prefixed). A block stores its rows by
+ * column: the type of every row in order, then for each type present its
+ * wall times and its columns. A compressed block first codes each column
+ * against the previous row of its type (difference for integers, XOR for
+ * doubles) and splits it into byte planes, then compresses the payload in
+ * the LZ4 block format; timestamps, counters and slowly moving levels
+ * come down to a few bits a row.
+ *
+ * A double printed "%.Nf" is a DEC column: in a compressed block whose
+ * values all print unambiguously (not within 0.001 of a rounding tie,
+ * under 2^40 units) it is stored as the integer the text shows, units of
+ * 10^-N with the sign in bit 0, so a value read back prints the same
+ * digits; otherwise the block keeps the column's double bits. A reader
+ * gets the printed value, not the original double.
+ *
+ * Layout rules follow wwv_state.h: little-endian, no implicit padding,
+ * payloads are memcpy'd. Readers skip chunk kinds they do not know.
+ *
+ * RULES:
+ *   - One thread per writer or reader
+ *   - A writer appends to a FILE it does not own (fclose is the caller's)
+ */
+
+#ifndef WWV_BINLOG_H
+#define WWV_BINLOG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Format
+ *============================================================================*/
+
+#define WWV_BINLOG_MAGIC            "WWVBLOG"   /* 8 bytes with the NUL */
+#define WWV_BINLOG_VERSION          1
+#define WWV_BINLOG_MAX_COLUMNS      16          /* WWV_CSV_MAX_ARGS */
+#define WWV_BINLOG_MAX_TYPES        32          /* Row types per file */
+#define WWV_BINLOG_BLOCK_ROWS       256
+#define WWV_BINLOG_MAX_TEXT         255         /* Bytes of one %s value */
+#define WWV_BINLOG_MAX_BLOCK_BYTES  65536       /* Largest raw block payload */
+#define WWV_BINLOG_MAX_DECIMALS     9           /* Widest "%.Nf" kept as a DEC column */
+
+typedef struct {
+    char magic[8];              /* WWV_BINLOG_MAGIC */
+    uint32_t version;           /* WWV_BINLOG_VERSION */
+    uint32_t reserved;
+    int64_t created;            /* Unix time the file was opened */
+} wwv_binlog_header_t;
+
+typedef enum {
+    WWV_BINLOG_CHUNK_HEADER = 1,
+    WWV_BINLOG_CHUNK_SCHEMA = 2,
+    WWV_BINLOG_CHUNK_BLOCK = 3
+} wwv_binlog_chunk_kind_t;
+
+#define WWV_BINLOG_BLOCK_LZ4        0x01        /* chunk flags: coded and compressed */
+
+typedef struct {
+    uint8_t kind;               /* wwv_binlog_chunk_kind_t */
+    uint8_t flags;
+    uint16_t reserved;
+    uint32_t length;            /* Payload bytes after this header */
+} wwv_binlog_chunk_t;
+
+/* SCHEMA payload: this, the column types, then the format string (no NUL) */
+typedef struct {
+    uint16_t type;              /* Row type id, in order of definition */
+    uint8_t has_wall;           /* Rows carry a wall time ("HH:MM:SS," column) */
+    uint8_t columns;
+} wwv_binlog_schema_t;
+
+/* BLOCK payload: this, then raw_length bytes (LZ4 compressed if flagged) */
+typedef struct {
+    uint32_t rows;
+    uint32_t raw_length;
+} wwv_binlog_block_t;
+
+typedef enum {
+    WWV_BINLOG_I32 = 1,         /* int, char */
+    WWV_BINLOG_U32,             /* unsigned int */
+    WWV_BINLOG_I64,             /* long, long long */
+    WWV_BINLOG_U64,             /* unsigned long, unsigned long long, size_t */
+    WWV_BINLOG_F64,             /* double */
+    WWV_BINLOG_STR,             /* u8 length + bytes */
+    WWV_BINLOG_DEC0 = 16        /* double printed "%.Nf": DEC0 + N; a codec byte per block */
+} wwv_binlog_column_t;
+
+typedef union {
+    int64_t i;                  /* I32, I64 */
+    uint64_t u;                 /* U32, U64 */
+    double d;                   /* F64, DEC */
+    const char *s;              /* STR, NUL terminated */
+} wwv_binlog_value_t;
+
+typedef struct {
+    uint64_t rows;
+    uint64_t blocks;
+    uint64_t raw_bytes;         /* Block payloads before compression */
+    uint64_t file_bytes;        /* Everything written, headers included */
+} wwv_binlog_stats_t;
+
+/*============================================================================
+ * Writer
+ *============================================================================*/
+
+typedef struct wwv_binlog_writer wwv_binlog_writer_t;
+
+/**
+ * Write the file header and start buffering rows
+ * @param compress LZ4 blocks (WWV_BINLOG_BLOCK_LZ4)
+ */
+wwv_binlog_writer_t *wwv_binlog_writer_create(FILE *file, bool compress);
+
+/**
+ * Write out pending rows and free the writer (the file stays open)
+ */
+void wwv_binlog_writer_destroy(wwv_binlog_writer_t *w);
+
+bool wwv_binlog_write_text(wwv_binlog_writer_t *w, const char *text, size_t length);
+
+/**
+ * Type id of a format string already defined (pointer compare: the
+ * string literal of wwv_csv_log), -1 if none
+ */
+int wwv_binlog_find_type(const wwv_binlog_writer_t *w, const char *fmt, bool has_wall);
+
+/**
+ * Define a row type and write its SCHEMA chunk
+ * @return Type id, -1 when WWV_BINLOG_MAX_TYPES are defined
+ */
+int wwv_binlog_define_type(wwv_binlog_writer_t *w, const char *fmt, bool has_wall,
+                           int columns, const uint8_t *column_types);
+
+/**
+ * Buffer one row, writing a block when WWV_BINLOG_BLOCK_ROWS are pending
+ * @param values One per column of the type
+ */
+bool wwv_binlog_append(wwv_binlog_writer_t *w, int type, int64_t wall,
+                       const wwv_binlog_value_t *values);
+
+/**
+ * Write pending rows as a block
+ * @return Rows written
+ */
+size_t wwv_binlog_flush(wwv_binlog_writer_t *w);
+
+void wwv_binlog_writer_get_stats(const wwv_binlog_writer_t *w, wwv_binlog_stats_t *out);
+
+/*============================================================================
+ * Reader
+ *============================================================================*/
+
+typedef struct wwv_binlog_reader wwv_binlog_reader_t;
+
+/* One HEADER chunk (text != NULL) or one row; valid until the next read */
+typedef struct {
+    const char *text;
+    size_t text_length;
+
+    int type;
+    const char *fmt;            /* The row's format string, NUL terminated */
+    bool has_wall;
+    int64_t wall;
+    int columns;
+    const uint8_t *column_types;
+    wwv_binlog_value_t values[WWV_BINLOG_MAX_COLUMNS];
+} wwv_binlog_row_t;
+
+wwv_binlog_reader_t *wwv_binlog_reader_open(const char *path);
+void wwv_binlog_reader_close(wwv_binlog_reader_t *r);
+
+/**
+ * @return 1 with the next header text or row, 0 at the end, -1 for a
+ *         malformed or truncated file
+ */
+int wwv_binlog_read(wwv_binlog_reader_t *r, wwv_binlog_row_t *row);
+
+void wwv_binlog_reader_get_stats(const wwv_binlog_reader_t *r, wwv_binlog_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_BINLOG_H */
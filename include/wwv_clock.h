@@ -128,7 +128,7 @@ wwv_clock_mode_t wwv_clock_get_mode(wwv_clock_t *clk);
  * Discipline clock to sync detector anchor (relative mode only)
  * @param anchor_ms Minute marker timestamp in milliseconds
  */
-void wwv_clock_set_anchor(wwv_clock_t *clk, float anchor_ms);
+void wwv_clock_set_anchor(wwv_clock_t *clk, double anchor_ms);
 
 /**
  * Get frame phase - milliseconds since last minute marker (0-60000)
@@ -137,6 +137,12 @@ void wwv_clock_set_anchor(wwv_clock_t *clk, float anchor_ms);
  */
 float wwv_clock_get_frame_phase_ms(wwv_clock_t *clk);
 
+/**
+ * Milliseconds since the anchored minute boundary at stream time now_ms
+ * (0-60000), in relative mode; -1 without an anchor or in absolute mode
+ */
+double wwv_clock_get_phase_at_ms(const wwv_clock_t *clk, double now_ms);
+
 /**
  * Check if current minute is "special" (station ID, geoalert)
  * Used by sync detector to discount evidence during noisy periods.
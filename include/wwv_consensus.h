@@ -0,0 +1,173 @@
+/**
+ * @file wwv_consensus.h
+ * @brief Consensus time from many receivers and nodes
+ *
+ * Each wwv_detector_manager reaches its own sync_detector verdict. This
+ * engine takes the binary telemetry stream (telemetry_wire.h) of any
+ * number of them, from local managers or from other nodes over UDP, and
+ * votes one time solution out of their evidence:
+ *
+ *   minute anchor  every source's last confirmed marker (TELEM_REC_SYNC),
+ *                  folded into a histogram of the phase within the minute
+ *                  (WWV_CONSENSUS_BIN_MS bins); the heaviest run of three
+ *                  bins is the agreeing cluster and its weighted mean the
+ *                  anchor
+ *   BCD            every source's symbols (TELEM_REC_BCD_SYMBOL) that sit
+ *                  on the agreed minute, log-likelihoods summed by their
+ *                  source's weight per second of the minute and handed to
+ *                  one shared bcd_time_solver a minute at a time
+ *
+ * A source's weight is its sync state (LOCKED 1, TENTATIVE 0.5,
+ * RECOVERING 0.25, ACQUIRING 0) times its last sync confidence times its
+ * channel quality (SNR / full_snr_db, clamped to WWV_CONSENSUS_MIN_QUALITY
+ * .. 1). A solution is available as soon as the agreeing cluster holds
+ * min_sources sources, min_weight weight and min_fraction of all anchored
+ * weight, so any subset of receivers that agrees outvotes the rest.
+ *
+ * COST: every record is O(1). An anchor moves its source's weight between
+ * two bins and re-tests only the clusters those bins touch; the whole
+ * histogram is rescanned only when the leading cluster loses weight. Stale
+ * anchors are retired by a sweep of one source per record, and the BCD
+ * vote accumulates in place and is flushed once per minute.
+ *
+ * TIME BASE: records carry each detector's own sample clock (sample_us).
+ * Sources are put on one shared time line by a per-source offset, added
+ * to their stream time. Managers fed by the same sample clock need none;
+ * for other nodes set it from a common reference, e.g. the host UTC each
+ * detector started at. Record wall_time is whole seconds and is not used.
+ *
+ * THREADING: not thread-safe; feed it from one thread.
+ */
+
+#ifndef WWV_CONSENSUS_H
+#define WWV_CONSENSUS_H
+
+#include "bcd_correlator.h"
+#include "bcd_time_solver.h"
+#include "channel_quality.h"
+#include "sync_detector.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+#define WWV_CONSENSUS_MAX_SOURCES   64
+#define WWV_CONSENSUS_BIN_MS        50          /* Anchor phase histogram resolution */
+#define WWV_CONSENSUS_ANCHOR_MAX_AGE_MS 180000.0 /* Anchor dropped when older */
+#define WWV_CONSENSUS_SYMBOL_SLOP_MS 500.0      /* Symbol minute start vs agreed anchor */
+#define WWV_CONSENSUS_SYMBOL_NATS   4.0f        /* Wire symbol at confidence 1 vs the others */
+#define WWV_CONSENSUS_MIN_QUALITY   0.05f
+
+typedef struct wwv_consensus wwv_consensus_t;
+
+typedef struct {
+    float min_weight;           /* Agreeing weight (1 = one locked source at full quality) */
+    int min_sources;            /* Agreeing sources */
+    float min_fraction;         /* Agreeing share of all anchored weight */
+    float full_snr_db;          /* Channel SNR that earns full quality */
+} wwv_consensus_config_t;
+
+#define WWV_CONSENSUS_CONFIG_DEFAULT { 1.5f, 2, 0.5f, 20.0f }
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+typedef struct {
+    double minute_anchor_ms;    /* Latest agreed minute start, shared time */
+    float spread_ms;            /* Weighted RMS of the agreeing anchors about it */
+    float agree_weight;
+    float total_weight;         /* All anchored sources */
+    int agree_sources;
+    int anchored_sources;       /* Sources with a live anchor and weight */
+    bool has_time;              /* BCD vote decoded a time (fields below) */
+    bcd_time_solution_t time;   /* minute_start_ms in shared time */
+} wwv_consensus_solution_t;
+
+/* Called when an anchor or BCD vote leaves a solution available */
+typedef void (*wwv_consensus_callback_fn)(const wwv_consensus_solution_t *solution,
+                                          void *user_data);
+
+/*============================================================================
+ * Lifecycle
+ *============================================================================*/
+
+/**
+ * @param config NULL for WWV_CONSENSUS_CONFIG_DEFAULT
+ */
+wwv_consensus_t *wwv_consensus_create(const wwv_consensus_config_t *config);
+void wwv_consensus_destroy(wwv_consensus_t *c);
+
+/**
+ * Register an input (a manager, or one receiver channel of a node)
+ * @param name Label for stats, copied
+ * @return Source id, or -1 when WWV_CONSENSUS_MAX_SOURCES are registered
+ */
+int wwv_consensus_add_source(wwv_consensus_t *c, const char *name);
+
+/**
+ * Shared time = the source's stream time + offset_ms (default 0)
+ */
+void wwv_consensus_set_source_offset(wwv_consensus_t *c, int source, double offset_ms);
+
+/**
+ * Channel quality weight from the source's channel_quality estimate
+ * (an invalid report leaves full quality)
+ */
+void wwv_consensus_set_source_quality(wwv_consensus_t *c, int source,
+                                      const channel_quality_report_t *quality);
+
+void wwv_consensus_set_callback(wwv_consensus_t *c, wwv_consensus_callback_fn cb,
+                                void *user_data);
+
+/*============================================================================
+ * Input
+ *============================================================================*/
+
+/**
+ * Feed one telemetry datagram received from a source
+ * Records other than SYNC, SYNC_STATE and BCD_SYMBOL are skipped.
+ * @return false if the datagram is not a valid telemetry frame
+ */
+bool wwv_consensus_ingest_datagram(wwv_consensus_t *c, int source,
+                                   const void *datagram, size_t length);
+
+/**
+ * The same evidence from a caller that has it in hand (stream times in ms)
+ * @param anchor_ms Source's last confirmed marker, <= 0 if none
+ */
+void wwv_consensus_add_anchor(wwv_consensus_t *c, int source, double anchor_ms,
+                              sync_state_t state);
+void wwv_consensus_add_state(wwv_consensus_t *c, int source, sync_state_t state,
+                             float confidence);
+void wwv_consensus_add_symbol(wwv_consensus_t *c, int source, const bcd_symbol_event_t *event);
+
+/*============================================================================
+ * Output
+ *============================================================================*/
+
+/**
+ * Current solution
+ * @return false while no cluster meets the thresholds (out still filled)
+ */
+bool wwv_consensus_get_solution(const wwv_consensus_t *c, wwv_consensus_solution_t *out);
+
+/**
+ * Drop all anchors and held BCD minutes (sources and offsets stay)
+ */
+void wwv_consensus_reset(wwv_consensus_t *c);
+
+void wwv_consensus_print_stats(const wwv_consensus_t *c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_CONSENSUS_H */
@@ -0,0 +1,157 @@
+/**
+ * @file wwv_csv_log.h
+ * @brief Asynchronous batched CSV logging
+ *
+ * Detectors deposit fixed-size binary records (format pointer + raw
+ * arguments + optional wall time) into a per-stream lock-free ring. One
+ * background writer thread formats the rows, renders the HH:MM:SS wall
+ * clock column, writes them, and flushes files on a configurable interval.
+ * No formatting, localtime() or disk I/O happens on the DSP thread.
+ *
+ * RULES:
+ *   - fmt must be a string literal (the pointer is stored, not the text)
+ *   - %s arguments are copied (WWV_CSV_TEXT_BYTES per row in total,
+ *     longer text is truncated)
+ *   - Each stream has one producer thread (the thread running its detector)
+ *   - Up to WWV_CSV_MAX_ARGS conversions per row; supported conversions are
+ *     d i u x X c f e g s with h/l/ll/z length modifiers
+ *
+ * Rows that do not fit in a stream's ring are dropped and counted.
+ *
+ * FILES:
+ *   - format BINARY writes the captured arguments instead of text, to
+ *     the path with ".csv" replaced by ".wlog" (wwv_binlog.h); the wwv_logcat
+ *     tool or wwv_csv_log_convert() gives back the CSV
+ *   - rotate_seconds starts a new file on each multiple of that many wall
+ *     seconds, named "<base>-YYYYMMDD-HHMMSS<ext>" (local time of its
+ *     start), each one opening with the stream's header lines
+ *   - Binary rows reach the file a block at a time: when a block fills,
+ *     after block_ms (async), on flush_all() and on close
+ */
+
+#ifndef WWV_CSV_LOG_H
+#define WWV_CSV_LOG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include "wwv_perf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WWV_CSV_MAX_ARGS            16
+#define WWV_CSV_TEXT_BYTES          96
+#define WWV_CSV_HEADER_BYTES        1024    /* Header text repeated in rotated files */
+
+#if defined(__GNUC__) || defined(__clang__)
+#define WWV_CSV_PRINTF(fmt_idx, arg_idx) __attribute__((format(printf, fmt_idx, arg_idx)))
+#else
+#define WWV_CSV_PRINTF(fmt_idx, arg_idx)
+#endif
+
+typedef struct wwv_csv_log wwv_csv_log_t;
+
+typedef enum {
+    WWV_CSV_LOG_TEXT = 0,           /* Formatted CSV rows */
+    WWV_CSV_LOG_BINARY              /* Columnar binary rows (wwv_binlog.h) */
+} wwv_csv_log_format_t;
+
+typedef struct {
+    bool async;                     /* false = format and write inline (legacy behaviour) */
+    unsigned flush_interval_ms;     /* fflush cadence for async streams */
+    unsigned poll_interval_ms;      /* Writer wakeup cadence */
+    size_t ring_records;            /* Per-stream ring size (rounded up to power of two) */
+    wwv_csv_log_format_t format;
+    bool compress;                  /* Binary: LZ4 blocks */
+    unsigned block_ms;              /* Binary, async: longest a row waits for its block */
+    unsigned rotate_seconds;        /* New file every this many wall seconds, 0 = one file */
+} wwv_csv_log_config_t;
+
+#define WWV_CSV_LOG_CONFIG_DEFAULT { \
+    .async = true, \
+    .flush_interval_ms = 1000, \
+    .poll_interval_ms = 50, \
+    .ring_records = 1024, \
+    .format = WWV_CSV_LOG_TEXT, \
+    .compress = true, \
+    .block_ms = 10000, \
+    .rotate_seconds = 0 \
+}
+
+typedef struct {
+    int open_streams;
+    uint64_t rows_written;
+    uint64_t rows_dropped;
+    uint64_t flushes;
+    uint64_t rotations;
+} wwv_csv_log_stats_t;
+
+/**
+ * Set service configuration; applies to streams opened afterwards
+ */
+void wwv_csv_log_configure(const wwv_csv_log_config_t *config);
+
+/**
+ * Open a CSV stream (starts the writer thread on first open)
+ * @return Stream, or NULL if the file cannot be opened
+ */
+wwv_csv_log_t *wwv_csv_log_open(const char *path);
+
+/**
+ * Drain pending rows, close the file (stops the writer after the last close)
+ * @param log Stream (NULL safe)
+ */
+void wwv_csv_log_close(wwv_csv_log_t *log);
+
+/**
+ * Time row capture as WWV_PERF_LOG_WRITE (NULL = untimed)
+ */
+void wwv_csv_log_set_perf(wwv_csv_log_t *log, wwv_perf_t *perf);
+
+/**
+ * Write a header line directly. Only valid before the stream's first row.
+ */
+void wwv_csv_log_header(wwv_csv_log_t *log, const char *fmt, ...) WWV_CSV_PRINTF(2, 3);
+
+/**
+ * Queue a row
+ */
+void wwv_csv_log_row(wwv_csv_log_t *log, const char *fmt, ...) WWV_CSV_PRINTF(2, 3);
+
+/**
+ * Queue a row prefixed with "HH:MM:SS," for wall (local time), rendered
+ * by the writer
+ */
+void wwv_csv_log_row_at(wwv_csv_log_t *log, time_t wall, const char *fmt, ...) WWV_CSV_PRINTF(3, 4);
+
+/**
+ * Block until every queued row has been written and flushed
+ */
+void wwv_csv_log_flush_all(void);
+
+/**
+ * Path of the stream's current file (from its producer thread when not async)
+ * @return false if it has none (a rotated file failed to open)
+ */
+bool wwv_csv_log_get_path(wwv_csv_log_t *log, char *out, size_t size);
+
+/**
+ * Write a binary log back out as CSV, exactly as a text stream would have
+ * written it (wall columns in this machine's time zone)
+ * @param header Include the header lines
+ * @return false if the file cannot be read or is malformed part way
+ */
+bool wwv_csv_log_convert(const char *binary_path, FILE *out, bool header);
+
+uint64_t wwv_csv_log_get_dropped(wwv_csv_log_t *log);
+void wwv_csv_log_get_stats(wwv_csv_log_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_CSV_LOG_H */
@@ -0,0 +1,65 @@
+/**
+ * @file wwv_denormal.h
+ * @brief Flush-to-zero scope for the processing entry points
+ *
+ * On silence (a dead band, a deep fade, zeroed input) the recursive
+ * filters and exponential noise trackers decay through the subnormal
+ * range, where x86 takes a microcode assist on every operation and a
+ * sample costs tens of times its usual time. Each wwv_detector_manager
+ * processing call therefore runs inside a wwv_denormal_scope_t: FTZ and
+ * DAZ (x86 MXCSR) or FZ (ARM FPCR / FPSCR) are set on entry and the
+ * caller's mode is put back on return, so the application's own floating
+ * point is unaffected. Callbacks fired from inside a call run with the
+ * flush mode set. Code driving detectors directly can open its own scope;
+ * scopes nest.
+ *
+ * Where the mode cannot be set (WWV_HAVE_FTZ == 0), the recursive filters
+ * pass their feedback through WWV_DENORMAL_FLUSH(), which adds and removes
+ * WWV_DENORMAL_OFFSET: anything below about 1e-25 rounds to zero and any
+ * signal-level value passes through unchanged.
+ */
+
+#ifndef WWV_DENORMAL_H
+#define WWV_DENORMAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || \
+    defined(__aarch64__) || defined(_M_ARM64) || (defined(__arm__) && defined(__ARM_FP))
+#define WWV_HAVE_FTZ 1
+#else
+#define WWV_HAVE_FTZ 0
+#endif
+
+#define WWV_DENORMAL_OFFSET     1e-18f
+
+#if WWV_HAVE_FTZ
+#define WWV_DENORMAL_FLUSH(x)   (x)
+#else
+#define WWV_DENORMAL_FLUSH(x)   (((x) + WWV_DENORMAL_OFFSET) - WWV_DENORMAL_OFFSET)
+#endif
+
+typedef struct {
+    uint32_t saved;             /* Caller's control register */
+    bool changed;               /* Entry set the flush bits; leave restores */
+} wwv_denormal_scope_t;
+
+/* Set flush-to-zero (and denormals-are-zero where separate) */
+void wwv_denormal_enter(wwv_denormal_scope_t *scope);
+
+/* Restore the mode wwv_denormal_enter() found */
+void wwv_denormal_leave(const wwv_denormal_scope_t *scope);
+
+/* Whether the flush bits are set on the calling thread now */
+bool wwv_denormal_active(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_DENORMAL_H */
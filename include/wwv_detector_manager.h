@@ -10,10 +10,11 @@
  *
  * ARCHITECTURE:
  *
- *   I/Q Samples (from waterfall.c)
+ *   I/Q Samples (from waterfall.c, or raw 2 MHz via process_sdr_block())
  *        │
  *        ├── DETECTOR PATH (50 kHz) ──► tick_detector ──► tick_correlator
- *        │                         └──► marker_detector ──► marker_correlator
+ *        │                         ├──► marker_detector ──► marker_correlator
+ *        │                         └──► bcd_time/bcd_freq_detector ──► bcd_correlator
  *        │
  *        └── DISPLAY PATH (12 kHz) ──► tone_tracker x3 (carrier, 500Hz, 600Hz)
  *                                 └──► slow_marker_detector (verification only)
@@ -23,6 +24,7 @@
  *   2. Energy values from different FFT paths are NOT comparable
  *   3. All detector callbacks are handled internally, then forwarded
  *   4. waterfall.c only needs to call process_detector_sample() and process_display_sample()
+ *      (or the *_block() variants when the front end delivers whole buffers)
  */
 
 #ifndef WWV_DETECTOR_MANAGER_H
@@ -30,7 +32,16 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "external/kiss_fft.h"
+#include "goertzel_bank.h"
+#include "telemetry.h"
+#include "wwv_perf.h"
+#include "wwv_clock.h"
+#include "bcd_time_solver.h"
+#include "tone_tracker.h"
+#include "wwv_refclock.h"
+#include "wwv_history.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -47,24 +58,97 @@ typedef struct wwv_detector_manager wwv_detector_manager_t;
  *============================================================================*/
 
 typedef struct {
-    const char *output_dir;         /* Directory for CSV logs (e.g., ".") */
+    const char *output_dir;         /* Directory for CSV logs (e.g., "."), NULL = no logs */
     bool enable_tick_detector;
+    bool dual_station;              /* Tick detector also tracks WWVH (1200 Hz) */
     bool enable_marker_detector;
     bool enable_sync_detector;
+    bool fast_acquire;              /* Sync batch epoch search from ticks + BCD P-markers */
+    bool tick_economy;              /* Tick detector computes only its gate window while LOCKED */
     bool enable_tone_trackers;
     bool enable_correlators;
+    int corr_chain_history;         /* Tick correlator chains kept, 0 = default (256) */
+    int corr_tick_history;          /* Tick correlator records kept, 0 = default (3600) */
     bool enable_slow_marker;        /* Display-path marker verification */
+    bool marker_template;           /* Template-correlated marker; retires slow_marker + marker_corr */
+    bool shared_tone_spectrum;      /* One display FFT per hop for tones + slow marker */
+    bool enable_bcd_detectors;      /* BCD time/freq detectors + bcd_correlator */
+    int bcd_integrate_minutes;      /* Multi-minute BCD envelope averaging, 0 = off */
+    spectral_mode_t narrowband_mode; /* Marker + BCD time front end (FFT or Goertzel bank) */
+    bool baseband_path;             /* Tick + marker on 3125 Hz complex baseband (baseband_frontend.h) */
+    bool bcd_freq_sliding;          /* BCD freq detector on a sliding DFT, 0.64 ms steps */
+    bool bcd_adaptive;              /* Idle the BCD freq detector while SNR is high (bcd_path_policy.h) */
+    bool detector_tiling;           /* Detector blocks run one 256-sample frame at a time */
+    bool carrier_correction;        /* Mix the detector path by the tracked carrier offset (carrier_nco.h) */
+    bool duty_cycle;                /* Sleep the DSP between verified minute markers once locked */
+    int duty_cycle_minutes;         /* Minutes per wake, 0 = WWV_DUTY_DEFAULT_MINUTES */
+    bool enable_sdr_frontend;       /* Accept raw 2 MHz I/Q via process_sdr_block() */
+
+    /* Threaded mode (see push_*_block / dispatch_events) */
+    bool threaded;                  /* Run detector and display paths on worker threads */
+    size_t ring_samples;            /* Per-path sample ring size, 0 = default (~1.3 s) */
+    size_t event_queue_size;        /* Pending external events, 0 = default */
+
+    /* Real-time placement (wwv_thread.h); a refused setting is reported by
+     * print_stats() / get_rt_status(), not an error */
+    uint64_t detector_cpus;         /* Detector worker affinity, bit n = CPU n, 0 = any */
+    uint64_t display_cpus;          /* Display worker affinity, 0 = any */
+    int rt_priority;                /* Workers: SCHED_FIFO 1-99 / MMCSS Pro Audio, 0 = normal */
+    bool lock_memory;               /* mlockall() once created: the whole process, for good */
+    bool prefault;                  /* Write every page of the manager's buffers at create */
+
+    telem_ctx_t *telemetry;         /* UDP telemetry destination, NULL = default context */
+
+    /* Time daemon export: each WWV tick while sync is LOCKED and the BCD
+     * time is solved (wwv_refclock.h); caller owns the handle */
+    wwv_refclock_t *refclock;       /* NULL = off */
+    float refclock_delay_ms;        /* Fixed receive latency taken off each sample */
+
+    /* Per-second metric history for dashboards (wwv_history.h) */
+    int history_seconds;            /* Seconds kept, 0 = off */
+    const char *history_path;       /* Map it on this file to keep it across restarts, NULL = memory */
 } wwv_detector_config_t;
 
 /* Default config - all enabled */
 #define WWV_DETECTOR_CONFIG_DEFAULT { \
     .output_dir = ".", \
     .enable_tick_detector = true, \
+    .dual_station = false, \
     .enable_marker_detector = true, \
     .enable_sync_detector = true, \
+    .fast_acquire = true, \
+    .tick_economy = false, \
     .enable_tone_trackers = true, \
     .enable_correlators = true, \
-    .enable_slow_marker = true \
+    .corr_chain_history = 0, \
+    .corr_tick_history = 0, \
+    .enable_slow_marker = true, \
+    .marker_template = false, \
+    .shared_tone_spectrum = true, \
+    .enable_bcd_detectors = true, \
+    .bcd_integrate_minutes = 0, \
+    .narrowband_mode = SPECTRAL_MODE_FFT, \
+    .baseband_path = false, \
+    .bcd_freq_sliding = false, \
+    .bcd_adaptive = false, \
+    .detector_tiling = true, \
+    .carrier_correction = false, \
+    .duty_cycle = false, \
+    .duty_cycle_minutes = 0, \
+    .enable_sdr_frontend = false, \
+    .threaded = false, \
+    .ring_samples = 0, \
+    .event_queue_size = 0, \
+    .detector_cpus = 0, \
+    .display_cpus = 0, \
+    .rt_priority = 0, \
+    .lock_memory = false, \
+    .prefault = false, \
+    .telemetry = NULL, \
+    .refclock = NULL, \
+    .refclock_delay_ms = 0.0f, \
+    .history_seconds = 0, \
+    .history_path = NULL \
 }
 
 /*============================================================================
@@ -73,8 +157,12 @@ typedef struct {
 
 /* Tick detected */
 typedef struct {
-    int tick_number;
-    float timestamp_ms;
+    int tick_number;            /* Per station */
+    wwv_station_t station;      /* Always WWV unless config.dual_station */
+    double timestamp_ms;
+    uint64_t sample_index;      /* 50 kHz detector input sample at timestamp_ms */
+    double epoch_ms;            /* Pulse start, sub-sample when epoch_refined (tick_detector.h) */
+    bool epoch_refined;
     float duration_ms;
     float energy;
 } wwv_tick_event_t;
@@ -84,7 +172,8 @@ typedef void (*wwv_tick_callback_fn)(const wwv_tick_event_t *event, void *user_d
 /* Minute marker detected */
 typedef struct {
     int marker_number;
-    float timestamp_ms;
+    double timestamp_ms;
+    uint64_t sample_index;      /* 50 kHz detector input sample at timestamp_ms */
     float since_last_sec;
     float duration_ms;
     float energy;
@@ -112,6 +201,28 @@ typedef void (*wwv_sync_callback_fn)(const wwv_sync_status_t *status, void *user
  */
 wwv_detector_manager_t *wwv_detector_manager_create(const wwv_detector_config_t *config);
 
+/**
+ * Bytes wwv_detector_manager_create_in() needs for this configuration
+ *
+ * Sized by a dry construction (create + teardown against a measuring
+ * arena), so component creation messages are printed once extra.
+ * @return 0 on failure
+ */
+size_t wwv_detector_manager_required_size(const wwv_detector_config_t *config);
+
+/**
+ * Create a manager whose detector state lives entirely in caller memory
+ *
+ * All per-instance allocations are cache-aligned blocks of mem (see
+ * wwv_arena.h); nothing is taken from the heap after this returns.
+ * mem must stay valid until wwv_detector_manager_destroy(), after which
+ * it can be reused.
+ * @param size At least wwv_detector_manager_required_size(config)
+ * @return NULL on failure, including mem being too small
+ */
+wwv_detector_manager_t *wwv_detector_manager_create_in(const wwv_detector_config_t *config,
+                                                       void *mem, size_t size);
+
 /**
  * Destroy detector manager and all owned detectors
  */
@@ -128,6 +239,37 @@ void wwv_detector_manager_destroy(wwv_detector_manager_t *mgr);
 void wwv_detector_manager_process_detector_sample(wwv_detector_manager_t *mgr,
                                                    float i_sample, float q_sample);
 
+/**
+ * Process a block of detector-path I/Q samples (50 kHz)
+ * Same result as calling process_detector_sample() once per sample, but
+ * dispatch and null checks happen once per detector per block.
+ * Feeds: tick_detector, marker_detector, bcd_time_detector, bcd_freq_detector
+ * @param i_samples In-phase samples
+ * @param q_samples Quadrature samples
+ * @param count     Number of samples in each array
+ */
+void wwv_detector_manager_process_detector_block(wwv_detector_manager_t *mgr,
+                                                  const float *i_samples,
+                                                  const float *q_samples,
+                                                  size_t count);
+
+/**
+ * Process a block of interleaved detector-path samples (50 kHz)
+ * Deinterleaves in fixed-size chunks and forwards to process_detector_block()
+ */
+void wwv_detector_manager_process_detector_block_cpx(wwv_detector_manager_t *mgr,
+                                                      const kiss_fft_cpx *samples,
+                                                      size_t count);
+
+/**
+ * Process interleaved int16 detector-path samples (50 kHz), full scale = 1.0
+ * Converts in fixed-size chunks and forwards to process_detector_block()
+ * @param count Complex samples (iq holds 2 * count values)
+ */
+void wwv_detector_manager_process_detector_block_s16(wwv_detector_manager_t *mgr,
+                                                      const int16_t *iq,
+                                                      size_t count);
+
 /**
  * Process display-path I/Q sample (12 kHz)
  * Feeds: tone_trackers
@@ -135,13 +277,209 @@ void wwv_detector_manager_process_detector_sample(wwv_detector_manager_t *mgr,
 void wwv_detector_manager_process_display_sample(wwv_detector_manager_t *mgr,
                                                   float i_sample, float q_sample);
 
+/**
+ * Process a block of display-path I/Q samples (12 kHz)
+ * Feeds: tone_trackers, and the slow marker with config.shared_tone_spectrum
+ * (one 4096-pt FFT per ~85 ms hop serves every tracker and the slow marker)
+ */
+void wwv_detector_manager_process_display_block(wwv_detector_manager_t *mgr,
+                                                 const float *i_samples,
+                                                 const float *q_samples,
+                                                 size_t count);
+
+/**
+ * Process raw 2 MHz SDR I/Q (requires config.enable_sdr_frontend)
+ * Decimates in one pass (sdr_frontend.h) and feeds the 50 kHz detector
+ * path and 12 kHz display path; in threaded mode the decimated samples
+ * are queued as with push_*_block(). Without config.shared_tone_spectrum
+ * the display FFT for the slow marker detector is still the caller's
+ * (process_display_fft()).
+ */
+void wwv_detector_manager_process_sdr_block(wwv_detector_manager_t *mgr,
+                                             const float *i_samples,
+                                             const float *q_samples,
+                                             size_t count);
+
+/**
+ * Process raw 2 MHz SDR I/Q as interleaved int16, full scale = 1.0
+ * As process_sdr_block(), with the 2 MHz and 250 kHz decimation stages in
+ * Q15 fixed point (sdr_frontend_process_s16()); samples become float only
+ * at 50 kHz. Use one input format between resets.
+ */
+void wwv_detector_manager_process_sdr_block_s16(wwv_detector_manager_t *mgr,
+                                                 const int16_t *iq,
+                                                 size_t count);
+
 /**
  * Process display-path FFT output (for slow marker detector)
- * Called after waterfall's display FFT completes
+ * Called after waterfall's display FFT completes. Ignored with
+ * config.shared_tone_spectrum, where the slow marker is fed from the
+ * manager's own spectrum.
  */
 void wwv_detector_manager_process_display_fft(wwv_detector_manager_t *mgr,
                                                const kiss_fft_cpx *fft_out,
-                                               float timestamp_ms);
+                                               double timestamp_ms);
+
+/*============================================================================
+ * Threaded Mode
+ *
+ * With config.threaded, push_*_block() only copies samples into lock-free
+ * rings and returns; the 50 kHz detector path and the 12 kHz display path
+ * each run on their own worker. Tick, marker and sync callbacks are queued
+ * and delivered from dispatch_events() on the caller's thread of choice.
+ *
+ * Do not mix push_*_block() with the process_* functions in threaded mode.
+ * process_display_fft() remains synchronous and may be called from any
+ * one thread. Status getters read live detector state and are advisory
+ * while workers run.
+ *
+ * Without config.threaded, push_*_block() processes synchronously and
+ * dispatch_events() / flush() are no-ops.
+ *============================================================================*/
+
+typedef struct {
+    uint64_t detector_overruns;     /* Samples refused because the ring was full */
+    uint64_t display_overruns;
+    uint64_t events_dropped;        /* Events lost because the queue was full */
+    size_t detector_backlog;        /* Samples waiting in each ring */
+    size_t display_backlog;
+    size_t events_pending;
+} wwv_pipeline_stats_t;
+
+/**
+ * Queue detector-path samples (50 kHz); never blocks
+ * @return Samples accepted; the remainder is counted as an overrun
+ */
+size_t wwv_detector_manager_push_detector_block(wwv_detector_manager_t *mgr,
+                                                const float *i_samples,
+                                                const float *q_samples,
+                                                size_t count);
+
+/**
+ * Queue display-path samples (12 kHz); never blocks
+ * @return Samples accepted
+ */
+size_t wwv_detector_manager_push_display_block(wwv_detector_manager_t *mgr,
+                                               const float *i_samples,
+                                               const float *q_samples,
+                                               size_t count);
+
+/**
+ * Deliver queued tick/marker/sync events to the registered callbacks
+ * (or, with event buffers, as one batch)
+ * @return Number of events delivered
+ */
+int wwv_detector_manager_dispatch_events(wwv_detector_manager_t *mgr);
+
+/**
+ * Block until both workers have consumed everything pushed so far
+ */
+void wwv_detector_manager_flush(wwv_detector_manager_t *mgr);
+
+bool wwv_detector_manager_is_threaded(wwv_detector_manager_t *mgr);
+wwv_pipeline_stats_t wwv_detector_manager_get_pipeline_stats(wwv_detector_manager_t *mgr);
+
+/*============================================================================
+ * Real-Time Placement
+ *
+ * What config.detector_cpus / display_cpus / rt_priority / lock_memory /
+ * prefault actually took effect, read back from the OS by each worker as
+ * it starts. Also printed by wwv_detector_manager_print_stats().
+ *============================================================================*/
+
+typedef struct {
+    bool started;                   /* The worker ran (threaded mode, path in the graph) */
+    uint64_t cpus_requested;        /* config mask, 0 = any */
+    uint64_t cpus;                  /* Effective affinity, 0 = unknown */
+    int priority_requested;
+    int priority;                   /* Effective real-time priority, 0 = normal */
+} wwv_rt_worker_t;
+
+typedef struct {
+    wwv_rt_worker_t detector;
+    wwv_rt_worker_t display;
+    bool lock_requested;
+    bool memory_locked;
+    size_t prefaulted_bytes;        /* Blocks written page by page at create */
+} wwv_rt_status_t;
+
+wwv_rt_status_t wwv_detector_manager_get_rt_status(wwv_detector_manager_t *mgr);
+
+/*============================================================================
+ * Carrier Correction
+ *
+ * config.carrier_correction steers an NCO on the 50 kHz detector input
+ * from the display path's carrier tracker (the 0 Hz tone_tracker), so the
+ * detectors see the carrier on DC and their tones on nominal whatever the
+ * receiver's tuning error. The loop takes over after a few consecutive
+ * valid estimates inside the tracker's search window, then follows the
+ * receiver's drift at every estimate; a fade holds the last correction.
+ * The display path itself is not corrected: the tone trackers keep
+ * measuring the receiver. Needs the tone trackers (display path).
+ *============================================================================*/
+
+#define WWV_CARRIER_MAX_HZ          25.0f   /* Estimates beyond this are not trusted */
+#define WWV_CARRIER_LOCK_COUNT      3       /* Consecutive estimates before correcting */
+#define WWV_CARRIER_LOOP_GAIN       0.25f   /* Share of each estimate's error corrected */
+
+typedef struct {
+    bool enabled;                   /* Requested and a carrier tracker is running */
+    bool active;                    /* Correcting the detector path */
+    float offset_hz;                /* Correction steered so far (detector path picks it up per block) */
+    float estimate_hz;              /* Last valid carrier estimate */
+    uint32_t estimates;             /* Carrier estimates seen */
+    uint32_t rejected;              /* Valid, but beyond WWV_CARRIER_MAX_HZ */
+} wwv_carrier_status_t;
+
+wwv_carrier_status_t wwv_detector_manager_get_carrier_status(wwv_detector_manager_t *mgr);
+
+/*============================================================================
+ * Duty Cycling
+ *
+ * config.duty_cycle is for nodes that need the time only every few
+ * minutes. Once sync is LOCKED and the BCD time is solved (LOCKED alone
+ * when the BCD detectors are off: second and minute phase only), the detectors
+ * and the display path stop processing: samples are still counted, so
+ * stream time and the timers run on, but no detector sees them. The
+ * manager wakes WWV_DUTY_WAKE_LEAD_MS before the minute marker
+ * duty_cycle_minutes ahead, predicted from sync's anchor through a
+ * relative-mode wwv_clock; the detectors resume on their kept noise
+ * floors and tick gate, sync goes TENTATIVE on the held anchor, and a
+ * marker confirmed within WWV_DUTY_MARKER_TOL_MS of the prediction locks
+ * it again and starts the next sleep. A missed marker widens the wake to
+ * the next minute; a second miss stays awake and acquires from scratch.
+ * Needs tick and sync on the 50 kHz detector path (not
+ * config.baseband_path). The interval stays under the 10-minute
+ * limit timing is carried for (WWV_STATE_TIMING_MAX_AGE_MS).
+ *============================================================================*/
+
+#define WWV_DUTY_DEFAULT_MINUTES    5
+#define WWV_DUTY_MAX_MINUTES        9
+#define WWV_DUTY_WAKE_LEAD_MS       8000.0  /* Awake before the predicted marker: windows refill */
+#define WWV_DUTY_HOLD_MS            5000.0  /* After it: detection and single-source confirmation */
+#define WWV_DUTY_MARKER_TOL_MS      500.0   /* Confirmed marker vs the prediction */
+#define WWV_DUTY_EVAL_MS            1000.0  /* Lock check while acquiring */
+
+typedef enum {
+    WWV_DUTY_OFF = 0,               /* Not configured or not possible */
+    WWV_DUTY_ACQUIRE,               /* Awake, waiting for LOCKED and a BCD solution */
+    WWV_DUTY_ASLEEP,
+    WWV_DUTY_VERIFY,                /* Awake around the predicted marker */
+    WWV_DUTY_WIDE                   /* Prediction missed: awake through the next minute */
+} wwv_duty_state_t;
+
+typedef struct {
+    bool enabled;
+    wwv_duty_state_t state;
+    uint32_t sleeps;
+    uint32_t verified;              /* Wakes whose marker came on the prediction */
+    uint32_t widened;               /* Wakes that missed it */
+    uint32_t reacquired;            /* Widened wakes that missed again */
+    double next_marker_ms;          /* Predicted marker being slept towards or verified, 0 = none */
+    float awake_fraction;           /* Detector samples processed / counted */
+} wwv_duty_status_t;
+
+wwv_duty_status_t wwv_detector_manager_get_duty_status(wwv_detector_manager_t *mgr);
 
 /*============================================================================
  * Callbacks
@@ -153,9 +491,146 @@ void wwv_detector_manager_set_tick_callback(wwv_detector_manager_t *mgr,
 void wwv_detector_manager_set_marker_callback(wwv_detector_manager_t *mgr,
                                                wwv_marker_callback_fn cb, void *user_data);
 
+/**
+ * Called with the sync status on every sync state change
+ */
 void wwv_detector_manager_set_sync_callback(wwv_detector_manager_t *mgr,
                                              wwv_sync_callback_fn cb, void *user_data);
 
+/**
+ * Called with every BCD symbol the correlator decides (config.enable_bcd),
+ * directly from the detector path: not queued in threaded mode and not
+ * part of event batches
+ */
+void wwv_detector_manager_set_bcd_symbol_callback(wwv_detector_manager_t *mgr,
+                                                  bcd_corr_symbol_callback_fn cb,
+                                                  void *user_data);
+
+/*============================================================================
+ * Batched Events
+ *
+ * By default each event reaches its callback from inside the detector that
+ * raised it, on the processing thread, mid-block. With event buffers set,
+ * events are appended to the caller's typed arrays instead and handed over
+ * once, when the outermost process_*() call (or, in threaded mode,
+ * dispatch_events()) returns: to the batch callback if one is set, or
+ * through take_events(). Per-event callbacks are not called meanwhile.
+ * Events that do not fit are counted in the next batch's dropped field.
+ *============================================================================*/
+
+typedef struct {
+    wwv_tick_event_t *ticks;
+    int tick_capacity;
+    wwv_marker_event_t *markers;
+    int marker_capacity;
+    wwv_sync_status_t *syncs;
+    int sync_capacity;
+} wwv_event_buffers_t;
+
+/* One hand-over: spans into the caller's buffers, in arrival order per type */
+typedef struct {
+    const wwv_tick_event_t *ticks;
+    int tick_count;
+    const wwv_marker_event_t *markers;
+    int marker_count;
+    const wwv_sync_status_t *syncs;
+    int sync_count;
+    uint64_t dropped;               /* Events lost to full buffers since the last batch */
+} wwv_event_batch_t;
+
+typedef void (*wwv_event_batch_fn)(const wwv_event_batch_t *batch, void *user_data);
+
+/**
+ * Collect events into buffers (copied; the arrays must outlive the manager
+ * or the next call). NULL returns to per-event callbacks, dropping any
+ * events not yet handed over.
+ */
+void wwv_detector_manager_set_event_buffers(wwv_detector_manager_t *mgr,
+                                            const wwv_event_buffers_t *buffers);
+
+/**
+ * Deliver each non-empty batch here, once per outermost processing call
+ */
+void wwv_detector_manager_set_batch_callback(wwv_detector_manager_t *mgr,
+                                             wwv_event_batch_fn cb, void *user_data);
+
+/**
+ * Hand over the events collected since the last batch (without a batch
+ * callback). Spans stay valid until the next processing call.
+ * @return true if the batch holds any event or drop
+ */
+bool wwv_detector_manager_take_events(wwv_detector_manager_t *mgr, wwv_event_batch_t *batch);
+
+/*============================================================================
+ * Runtime Parameters
+ *============================================================================*/
+
+/*
+ * Settings are staged and taken up by the detector path at the start of
+ * its next block (the detector worker, in threaded mode), so they are safe
+ * from any thread while samples flow; the detector path never waits on
+ * them. Calls from several control threads are serialized.
+ */
+
+typedef struct {
+    const char *name;           /* waterfall.ini "section.key" */
+    float value;
+} wwv_param_setting_t;
+
+/**
+ * Set a detector tunable by its waterfall.ini name, "section.key"
+ * (docs/RUNTIME_PARAMETER_TUNING.md), e.g. "tick_detector.threshold_multiplier"
+ * @return false for an unknown name, a detector disabled in this manager, or
+ *         a value the detector rejects as out of range (setting unchanged)
+ */
+bool wwv_detector_manager_set_param(wwv_detector_manager_t *mgr, const char *name, float value);
+
+/**
+ * Set several tunables as one batch: all of them take effect between the
+ * same two detector blocks, or none does if any is rejected
+ * @return false if any setting would make set_param() fail
+ */
+bool wwv_detector_manager_set_params(wwv_detector_manager_t *mgr,
+                                     const wwv_param_setting_t *settings, int count);
+
+/**
+ * Read a tunable by name (the latest setting, even if not yet taken up)
+ * @return false for an unknown name or a disabled detector
+ */
+bool wwv_detector_manager_get_param(wwv_detector_manager_t *mgr, const char *name, float *value);
+
+/**
+ * Tunable names, for index 0.. (NULL past the last)
+ */
+const char *wwv_detector_manager_param_name(int index);
+
+/*============================================================================
+ * Warm Start
+ *
+ * A snapshot of what the detectors have learned - noise floors and
+ * thresholds, the tick gates and current tick chain, the sync anchor and
+ * the tone estimates - as a compact versioned blob (wwv_state.h). Stored
+ * across a restart and restored into a new manager before it is fed, it
+ * skips warmup and resumes timing on the carried anchor; how old a
+ * snapshot each component still trusts is checked against the wall clock
+ * (WWV_STATE_*_MAX_AGE_MS). Both calls flush threaded-mode workers first;
+ * do not push samples concurrently.
+ *============================================================================*/
+
+/**
+ * Snapshot every running component into buf (WWV_STATE_MAX_BYTES is enough)
+ * @return Blob bytes, 0 if it does not fit
+ */
+size_t wwv_detector_manager_save_state(wwv_detector_manager_t *mgr, void *buf, size_t capacity);
+
+/**
+ * Restore a snapshot into this manager's components
+ * Sections for components not running here, of unknown versions, or too
+ * old for the component are skipped.
+ * @return false if the blob is invalid or nothing in it was restored
+ */
+bool wwv_detector_manager_restore_state(wwv_detector_manager_t *mgr, const void *blob, size_t length);
+
 /*============================================================================
  * Status / Diagnostics
  *============================================================================*/
@@ -171,6 +646,67 @@ wwv_sync_status_t wwv_detector_manager_get_sync_status(wwv_detector_manager_t *m
 int wwv_detector_manager_get_tick_count(wwv_detector_manager_t *mgr);
 int wwv_detector_manager_get_marker_count(wwv_detector_manager_t *mgr);
 
+/**
+ * Ticks for one station (WWVH needs config.dual_station, else 0)
+ */
+int wwv_detector_manager_get_station_tick_count(wwv_detector_manager_t *mgr,
+                                                wwv_station_t station);
+
+/**
+ * Tick FFT frames economy mode skipped (config.tick_economy, else 0)
+ */
+uint64_t wwv_detector_manager_get_tick_skipped_frames(wwv_detector_manager_t *mgr);
+
+/**
+ * Host clock stamp refclock samples are carried back from: host_ns is
+ * when detector sample number `sample` (counted from 1) had arrived. Taken
+ * once per call at the block entry points, and in threaded mode by
+ * push_detector_block() before the ring, so ring latency is not counted;
+ * process_detector_sample() takes one every 256 samples. Call after
+ * flush() in threaded mode.
+ * @return false without config.refclock or before the first block
+ */
+bool wwv_detector_manager_get_refclock_stamp(wwv_detector_manager_t *mgr, int64_t *host_ns,
+                                             uint64_t *sample);
+
+/**
+ * Latest soft-decision BCD time of day (bcd_time_solver)
+ * @return false until a minute has been decoded with enough margin
+ */
+bool wwv_detector_manager_get_bcd_time(wwv_detector_manager_t *mgr, bcd_time_solution_t *out);
+
+/**
+ * Latest frame decoded from multi-minute BCD integration
+ * @return false until enough minutes have been averaged (or integration off)
+ */
+bool wwv_detector_manager_get_bcd_integrated(wwv_detector_manager_t *mgr, bcd_integrated_frame_t *out);
+
+/**
+ * Current carrier / 500 Hz / 600 Hz tone estimate (nominal_hz 0, 500 or 600)
+ * Trackers only measure on demand when nothing else consumes their
+ * estimates, so this may run the FFT; safe from any thread.
+ * @return false if that tracker is not running or has no full window yet
+ */
+bool wwv_detector_manager_get_tone(wwv_detector_manager_t *mgr, float nominal_hz,
+                                   tone_measurement_t *out);
+
+/**
+ * Shared channel-quality estimate (channel_quality.h), fed by every FFT the
+ * display spectrum computes; it runs no FFT of its own, so with nothing
+ * consuming every hop it only advances when a getter demands an estimate
+ * @return false without config.shared_tone_spectrum or before enough frames
+ */
+bool wwv_detector_manager_get_channel_quality(wwv_detector_manager_t *mgr,
+                                              channel_quality_report_t *out);
+
+/**
+ * Per-second metric history (config.history_seconds), for
+ * wwv_history_query() / wwv_history_aggregate() on this run's stream time;
+ * advisory while samples flow, like the other getters
+ * @return NULL when off
+ */
+const wwv_history_t *wwv_detector_manager_get_history(wwv_detector_manager_t *mgr);
+
 /**
  * Get flash frames for UI (tick and marker combined)
  */
@@ -194,6 +730,17 @@ void wwv_detector_manager_log_display_gain(wwv_detector_manager_t *mgr, float di
  */
 void wwv_detector_manager_print_stats(wwv_detector_manager_t *mgr);
 
+/**
+ * Per-stage timing since creation or the last reset_perf()
+ *
+ * Stages are listed in wwv_perf.h. stats->enabled is false when the
+ * library was built without WWV_PERF_ENABLED. With it, an interval
+ * summary also goes out once per second of detector samples on
+ * TELEM_PERF.
+ */
+void wwv_detector_manager_get_perf(wwv_detector_manager_t *mgr, wwv_perf_stats_t *stats);
+void wwv_detector_manager_reset_perf(wwv_detector_manager_t *mgr);
+
 #ifdef __cplusplus
 }
 #endif
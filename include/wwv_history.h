@@ -0,0 +1,128 @@
+/**
+ * @file wwv_history.h
+ * @brief Fixed-memory per-second metric history
+ *
+ * One float32 column per metric, one row per second of stream (sample)
+ * time, kept in a ring of a fixed number of seconds; 24 hours of every
+ * column is about 3.5 MB. Missing values are NAN. Events land in the row
+ * of the second they happened in, combined per column:
+ *
+ *   SUM    counts (ticks, markers)
+ *   MAX    per-event values, at most one or two a second (SNRs, corr ratio)
+ *   LAST   sampled once a second (sync confidence, carrier SNR, tone ppm)
+ *
+ * With a path the ring is a memory-mapped file, written in place, so it
+ * survives a restart (or a crash of the process) without any logging. A
+ * reopened file is continued on the wall clock: the seconds the process
+ * was down stay NAN, and the earlier run's rows are at negative stream
+ * times of this run. A file of another capacity or version is started
+ * over.
+ *
+ * RULES:
+ *   - One writer thread (the manager's detector path)
+ *   - Queries from other threads are advisory: a row being written may be
+ *     read half-combined, and the ring may advance under a long range
+ */
+
+#ifndef WWV_HISTORY_H
+#define WWV_HISTORY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+#define WWV_HISTORY_DEFAULT_SECONDS     86400u      /* 24 h */
+#define WWV_HISTORY_MAX_SECONDS         604800u     /* 7 days */
+
+/* One column per metric, in file order (append only: the file layout) */
+typedef enum {
+    WWV_HIST_TICK_SNR = 0,      /* dB, WWV tick peak over its noise floor (MAX) */
+    WWV_HIST_TICKS,             /* WWV ticks detected (SUM) */
+    WWV_HIST_TICKS_EXPECTED,    /* Ticks sent: 0 at :00 :29 :59 as sync numbers seconds (SUM) */
+    WWV_HIST_TICK_CORR,         /* Tick matched-filter corr_ratio (MAX) */
+    WWV_HIST_MARKERS,           /* Minute markers detected (SUM) */
+    WWV_HIST_BCD_TIME_SNR,      /* dB, BCD time detector pulse (MAX) */
+    WWV_HIST_BCD_FREQ_SNR,      /* dB, BCD freq detector pulse (MAX) */
+    WWV_HIST_CARRIER_SNR,       /* dB, channel_quality carrier estimate (LAST) */
+    WWV_HIST_SYNC_CONFIDENCE,   /* 0-1, sync detector (LAST) */
+    WWV_HIST_TONE_PPM,          /* Carrier tone offset, ppm (LAST) */
+    WWV_HIST_COLUMN_COUNT
+} wwv_history_column_t;
+
+typedef struct wwv_history wwv_history_t;
+
+typedef struct {
+    uint32_t capacity_seconds;
+    double first_ms;            /* Oldest retained second (negative: an earlier run) */
+    double end_ms;              /* One past the newest second */
+    time_t run_start;           /* Wall clock at stream time 0 of this run */
+    bool mapped;                /* File-backed */
+    bool resumed;               /* Continued an existing file */
+    uint64_t dropped;           /* Values older than the ring */
+} wwv_history_info_t;
+
+/* Over the seconds of a range holding a value */
+typedef struct {
+    int seconds;                /* In the range */
+    int count;                  /* With a value */
+    float min;
+    float max;
+    float mean;
+    double sum;
+} wwv_history_stats_t;
+
+/*============================================================================
+ * API
+ *============================================================================*/
+
+/**
+ * @param seconds Ring length, 0 = WWV_HISTORY_DEFAULT_SECONDS
+ * @param path    File to map and continue, NULL = memory only
+ * @return NULL on failure (including a file that cannot be mapped)
+ */
+wwv_history_t *wwv_history_create(uint32_t seconds, const char *path);
+void wwv_history_destroy(wwv_history_t *h);
+
+/**
+ * Combine a value into the row of the second holding timestamp_ms
+ * (stream time); a later second advances the ring, clearing the rows
+ * passed over
+ */
+void wwv_history_record(wwv_history_t *h, wwv_history_column_t column,
+                        double timestamp_ms, float value);
+
+/**
+ * Copy one value per second starting in [start_ms, end_ms), NAN where
+ * nothing was recorded or outside the retained span
+ * @return Rows written (at most max_rows)
+ */
+int wwv_history_query(const wwv_history_t *h, wwv_history_column_t column,
+                      double start_ms, double end_ms, float *out, int max_rows);
+
+/**
+ * Min / max / mean / sum over the seconds starting in [start_ms, end_ms)
+ * @return false if none of them holds a value
+ */
+bool wwv_history_aggregate(const wwv_history_t *h, wwv_history_column_t column,
+                           double start_ms, double end_ms, wwv_history_stats_t *out);
+
+bool wwv_history_get_info(const wwv_history_t *h, wwv_history_info_t *out);
+
+/* Short column name ("tick_snr", ...), NULL past the last */
+const char *wwv_history_column_name(int column);
+
+void wwv_history_print_stats(const wwv_history_t *h);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_HISTORY_H */
@@ -0,0 +1,109 @@
+/**
+ * @file wwv_iq_file.h
+ * @brief Memory-mapped IQ recordings (WAV, SigMF, raw) and a WAV writer
+ *
+ * Recordings hold interleaved I/Q pairs as signed 16-bit integers (ci16)
+ * or 32-bit floats (cf32), little-endian. Supported containers:
+ *   - WAV: 2-channel PCM16 or IEEE float32 (WAVE_FORMAT_EXTENSIBLE too);
+ *          I is channel 0, Q channel 1
+ *   - SigMF: path to the .sigmf-meta or .sigmf-data file (or their common
+ *          stem); core:datatype ci16_le / cf32_le and core:sample_rate
+ *          are read from the metadata
+ *   - raw: anything else, with format and rate supplied by the caller
+ *
+ * The file is mapped read-only, so any number of threads may call
+ * wwv_iq_file_read() on one handle concurrently. ci16 samples are scaled
+ * by 1/32768.
+ */
+
+#ifndef WWV_IQ_FILE_H
+#define WWV_IQ_FILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    WWV_IQ_CI16 = 0,            /* int16 I, int16 Q */
+    WWV_IQ_CF32                 /* float I, float Q */
+} wwv_iq_format_t;
+
+typedef enum {
+    WWV_IQ_CONTAINER_RAW = 0,
+    WWV_IQ_CONTAINER_WAV,
+    WWV_IQ_CONTAINER_SIGMF
+} wwv_iq_container_t;
+
+/* Needed for raw files, ignored when the container carries metadata */
+typedef struct {
+    wwv_iq_format_t format;
+    uint32_t sample_rate;
+} wwv_iq_raw_params_t;
+
+typedef struct {
+    wwv_iq_container_t container;
+    wwv_iq_format_t format;
+    uint32_t sample_rate;
+    uint64_t sample_count;      /* Complex samples */
+} wwv_iq_info_t;
+
+typedef struct wwv_iq_file wwv_iq_file_t;
+
+/*============================================================================
+ * Reader
+ *============================================================================*/
+
+/**
+ * Map a recording
+ * @param raw Format and rate for headerless files (NULL = reject them)
+ * @return NULL if the file cannot be opened or its header is not understood
+ */
+wwv_iq_file_t *wwv_iq_file_open(const char *path, const wwv_iq_raw_params_t *raw);
+
+void wwv_iq_file_close(wwv_iq_file_t *f);
+
+const wwv_iq_info_t *wwv_iq_file_info(const wwv_iq_file_t *f);
+
+/**
+ * Convert samples [offset, offset + count) to planar float I/Q
+ * @return Samples written (short at end of file)
+ */
+size_t wwv_iq_file_read(const wwv_iq_file_t *f, uint64_t offset, size_t count,
+                        float *i_out, float *q_out);
+
+const char *wwv_iq_container_name(wwv_iq_container_t container);
+
+/*============================================================================
+ * WAV Writer
+ *============================================================================*/
+
+typedef struct wwv_iq_wav_writer wwv_iq_wav_writer_t;
+
+/**
+ * Create a 2-channel WAV file (sizes are patched in by close)
+ */
+wwv_iq_wav_writer_t *wwv_iq_wav_create(const char *path, uint32_t sample_rate,
+                                       wwv_iq_format_t format);
+
+/**
+ * Append planar samples (ci16 clips to +/-1.0)
+ * @return false on write error
+ */
+bool wwv_iq_wav_write(wwv_iq_wav_writer_t *w, const float *i_samples,
+                      const float *q_samples, size_t count);
+
+/**
+ * Finish the header and close
+ * @return false if the file could not be completed
+ */
+bool wwv_iq_wav_close(wwv_iq_wav_writer_t *w);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_IQ_FILE_H */
@@ -0,0 +1,55 @@
+/**
+ * @file wwv_mpsc_queue.h
+ * @brief Lock-free bounded multi-producer / single-consumer queue
+ *
+ * Fixed number of slots (power of two), each holding up to max_elem_size
+ * bytes. Any number of threads may push concurrently; one thread pops.
+ * Each slot carries a sequence number, so a producer claims a slot with a
+ * single compare-and-swap on the tail and never waits for other producers
+ * (bounded MPMC scheme by D. Vyukov, with the consumer side simplified).
+ *
+ * Pushes never block: if the queue is full the element is refused and the
+ * caller decides whether to count it as dropped.
+ */
+
+#ifndef WWV_MPSC_QUEUE_H
+#define WWV_MPSC_QUEUE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct wwv_mpsc_queue wwv_mpsc_queue_t;
+
+/**
+ * Create queue
+ * @param max_elem_size Largest element in bytes
+ * @param min_slots Minimum element count; rounded up to a power of two
+ */
+wwv_mpsc_queue_t *wwv_mpsc_queue_create(size_t max_elem_size, size_t min_slots);
+
+void wwv_mpsc_queue_destroy(wwv_mpsc_queue_t *queue);
+
+/**
+ * Producer (any thread): copy one element of size bytes in
+ * @return false if the queue is full or size is 0 or exceeds max_elem_size
+ */
+bool wwv_mpsc_queue_push(wwv_mpsc_queue_t *queue, const void *src, size_t size);
+
+/**
+ * Consumer (one thread): copy the oldest element out
+ * @param dst Buffer of at least max_elem_size bytes
+ * @return Element size, or 0 if the queue is empty
+ */
+size_t wwv_mpsc_queue_pop(wwv_mpsc_queue_t *queue, void *dst);
+
+size_t wwv_mpsc_queue_capacity(const wwv_mpsc_queue_t *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_MPSC_QUEUE_H */
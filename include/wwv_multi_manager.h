@@ -0,0 +1,119 @@
+/**
+ * @file wwv_multi_manager.h
+ * @brief Multi-receiver WWV detection engine
+ *
+ * Runs one wwv_detector_manager per receiver channel (e.g. 2.5/5/10/15/20 MHz
+ * WWV and WWVH) on a worker pool, one channel per core.
+ *
+ * SHARED READ-ONLY RESOURCES (allocated once per process, not per channel):
+ *   - FFT backend plans and analysis windows (refcounted per (size, window)
+ *     in fft_plan_cache)
+ *   - Tick matched-filter template (tick_correlation.c)
+ *
+ * Per-channel state (sample buffers, correlator rings, noise floors,
+ * state machines, CSV logs) remains owned by each channel's manager. So
+ * are the channel filters' biquad sections: channel_filters.c designs
+ * them at init for the manager's sample rate (channel_butterworth_design()).
+ *
+ * THREADING:
+ *   - process_*_blocks() hands each worker its channels, then blocks until
+ *     every channel has consumed its block
+ *   - Channel callbacks fire on worker threads but are serialized by the
+ *     engine, so user callbacks need not be re-entrant
+ */
+
+#ifndef WWV_MULTI_MANAGER_H
+#define WWV_MULTI_MANAGER_H
+
+#include "wwv_detector_manager.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+#define WWV_MULTI_MAX_CHANNELS  16
+
+typedef struct wwv_multi_manager wwv_multi_manager_t;
+
+typedef struct {
+    int channel_count;              /* 1..WWV_MULTI_MAX_CHANNELS */
+    int worker_threads;             /* 0 = one per core, capped at channel_count */
+    wwv_detector_config_t channels[WWV_MULTI_MAX_CHANNELS];  /* Each needs its own output_dir */
+} wwv_multi_config_t;
+
+/*============================================================================
+ * Callbacks (channel = index into config.channels)
+ *============================================================================*/
+
+typedef void (*wwv_multi_tick_callback_fn)(int channel, const wwv_tick_event_t *event, void *user_data);
+typedef void (*wwv_multi_marker_callback_fn)(int channel, const wwv_marker_event_t *event, void *user_data);
+typedef void (*wwv_multi_sync_callback_fn)(int channel, const wwv_sync_status_t *status, void *user_data);
+
+/*============================================================================
+ * Lifecycle
+ *============================================================================*/
+
+/**
+ * Create engine with one detector manager per channel and start workers
+ * @return Engine handle, or NULL if any channel or worker fails to start
+ */
+wwv_multi_manager_t *wwv_multi_manager_create(const wwv_multi_config_t *config);
+
+/**
+ * Stop workers and destroy all channel managers
+ */
+void wwv_multi_manager_destroy(wwv_multi_manager_t *mm);
+
+/*============================================================================
+ * Sample Processing
+ *============================================================================*/
+
+/**
+ * Process one detector-path block per channel (50 kHz)
+ * @param i_blocks  channel_count pointers to in-phase blocks (NULL = skip channel)
+ * @param q_blocks  channel_count pointers to quadrature blocks
+ * @param count     Samples per block (same for all channels)
+ */
+void wwv_multi_manager_process_detector_blocks(wwv_multi_manager_t *mm,
+                                               const float *const *i_blocks,
+                                               const float *const *q_blocks,
+                                               size_t count);
+
+/**
+ * Process one display-path block per channel (12 kHz)
+ */
+void wwv_multi_manager_process_display_blocks(wwv_multi_manager_t *mm,
+                                              const float *const *i_blocks,
+                                              const float *const *q_blocks,
+                                              size_t count);
+
+/*============================================================================
+ * Callbacks / Access
+ *============================================================================*/
+
+void wwv_multi_manager_set_tick_callback(wwv_multi_manager_t *mm,
+                                         wwv_multi_tick_callback_fn cb, void *user_data);
+void wwv_multi_manager_set_marker_callback(wwv_multi_manager_t *mm,
+                                           wwv_multi_marker_callback_fn cb, void *user_data);
+void wwv_multi_manager_set_sync_callback(wwv_multi_manager_t *mm,
+                                         wwv_multi_sync_callback_fn cb, void *user_data);
+
+int wwv_multi_manager_get_channel_count(wwv_multi_manager_t *mm);
+int wwv_multi_manager_get_worker_count(wwv_multi_manager_t *mm);
+
+/**
+ * Get a channel's detector manager for status queries
+ * Do not call its process functions while the engine is processing
+ */
+wwv_detector_manager_t *wwv_multi_manager_get_channel(wwv_multi_manager_t *mm, int channel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_MULTI_MANAGER_H */
@@ -0,0 +1,149 @@
+/**
+ * @file wwv_perf.h
+ * @brief Hot-path stage timers with log2 latency histograms
+ *
+ * Components that own a stage bracket it with WWV_PERF_BEGIN/END against
+ * the wwv_perf_t they were given (tick_detector_set_perf() etc.); the
+ * detector manager owns one context and wires it to everything it creates.
+ * Each record adds to a count, a total, a max and one histogram bucket
+ * (bucket k holds durations in [2^k, 2^(k+1)) ns), all with relaxed
+ * atomics, so the detector and display workers can share a context.
+ *
+ * Timing is compiled in only with WWV_PERF_ENABLED (CMake -DWWV_PERF=ON).
+ * Without it the macros are empty, wwv_perf_create() returns NULL and the
+ * stats report enabled = false, so the hot path carries no cost at all.
+ *
+ * The clock is rdtsc on x86 (scaled to ns by a calibration in
+ * wwv_perf_create()), clock_gettime(CLOCK_MONOTONIC) elsewhere and
+ * QueryPerformanceCounter on non-x86 Windows.
+ *
+ * Stages nest: the *_BLOCK stages contain everything the block
+ * triggered, and CORRELATION / SYNC / LOG_WRITE run inside the detector
+ * stage whose event caused them. The detector stages are disjoint from
+ * one another.
+ */
+
+#ifndef WWV_PERF_H
+#define WWV_PERF_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Stages
+ *============================================================================*/
+
+#define WWV_PERF_HIST_BUCKETS   32      /* 1 ns .. ~4 s, last bucket open-ended */
+
+typedef enum {
+    WWV_PERF_DETECTOR_BLOCK = 0,    /* process_detector_block(), inclusive */
+    WWV_PERF_DISPLAY_BLOCK,         /* process_display_block(), inclusive */
+    WWV_PERF_TICK_FFT,              /* Tick FFT + bucket energy */
+    WWV_PERF_TICK_CORR,             /* Tick matched filter (block path) */
+    WWV_PERF_TICK_STATE,            /* Tick state machine */
+    WWV_PERF_MARKER_FFT,            /* Marker FFT or Goertzel bank */
+    WWV_PERF_MARKER_STATE,
+    WWV_PERF_BCD_TIME_FFT,          /* BCD time FFT or Goertzel bank */
+    WWV_PERF_BCD_TIME_STATE,
+    WWV_PERF_BCD_FREQ_FFT,
+    WWV_PERF_BCD_FREQ_STATE,
+    WWV_PERF_TONE_FFT,              /* Tone tracker FFT (full or zoomed) */
+    WWV_PERF_TONE_ESTIMATE,         /* Peak search, noise floor, refinement */
+    WWV_PERF_CORRELATION,           /* marker / bcd correlator updates */
+    WWV_PERF_SYNC,                  /* sync_detector evidence updates */
+    WWV_PERF_LOG_WRITE,             /* CSV row capture (wwv_csv_log_row*) */
+    WWV_PERF_TELEMETRY,             /* Per-block telemetry flush */
+    WWV_PERF_STAGE_COUNT
+} wwv_perf_stage_t;
+
+typedef struct {
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    uint64_t histogram[WWV_PERF_HIST_BUCKETS];
+} wwv_perf_stage_stats_t;
+
+typedef struct {
+    bool enabled;                   /* false when built without WWV_PERF_ENABLED */
+    wwv_perf_stage_stats_t stage[WWV_PERF_STAGE_COUNT];
+} wwv_perf_stats_t;
+
+typedef struct wwv_perf wwv_perf_t;
+
+/*============================================================================
+ * Instrumentation
+ *============================================================================*/
+
+#ifdef WWV_PERF_ENABLED
+#define WWV_PERF_BEGIN(perf, t0) \
+    uint64_t t0 = (perf) ? wwv_perf_now() : 0
+#define WWV_PERF_END(perf, stage, t0) \
+    do { if (perf) wwv_perf_record((perf), (stage), wwv_perf_now() - (t0)); } while (0)
+#else
+#define WWV_PERF_BEGIN(perf, t0)        ((void)0)
+#define WWV_PERF_END(perf, stage, t0)   ((void)0)
+#endif
+
+/**
+ * Raw timestamp in clock ticks (see wwv_perf_record)
+ */
+uint64_t wwv_perf_now(void);
+
+/**
+ * Record one stage duration
+ * @param ticks Difference of two wwv_perf_now() values
+ */
+void wwv_perf_record(wwv_perf_t *perf, wwv_perf_stage_t stage, uint64_t ticks);
+
+/*============================================================================
+ * Context
+ *============================================================================*/
+
+/**
+ * Create a zeroed context and calibrate the clock (~2 ms)
+ * @return NULL when built without WWV_PERF_ENABLED or on allocation failure
+ */
+wwv_perf_t *wwv_perf_create(void);
+
+void wwv_perf_destroy(wwv_perf_t *perf);
+
+void wwv_perf_reset(wwv_perf_t *perf);
+
+/**
+ * Snapshot all stages (NULL perf gives zeros with enabled = false)
+ */
+void wwv_perf_get_stats(wwv_perf_t *perf, wwv_perf_stats_t *stats);
+
+/**
+ * Stage-wise difference now - prev (for interval reports)
+ *
+ * max_ns is the running max if it moved during the interval, otherwise
+ * the upper edge of the interval's highest histogram bucket. A stage reset
+ * after prev was taken counts from zero.
+ */
+void wwv_perf_stats_delta(const wwv_perf_stats_t *now, const wwv_perf_stats_t *prev,
+                          wwv_perf_stats_t *delta);
+
+/**
+ * Upper edge of the histogram bucket holding quantile q (0..1)
+ * @return 0 for an empty stage
+ */
+uint64_t wwv_perf_percentile_ns(const wwv_perf_stage_stats_t *stage, float q);
+
+const char *wwv_perf_stage_name(wwv_perf_stage_t stage);
+
+/**
+ * Print a per-stage table (count, mean, p50, p99, max, share of budget)
+ * @param elapsed_sec Signal time covered, for the budget column (0 = omit)
+ */
+void wwv_perf_print(const wwv_perf_stats_t *stats, double elapsed_sec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_PERF_H */
@@ -0,0 +1,95 @@
+/**
+ * @file wwv_refclock.h
+ * @brief Reference clock export to ntpd / chrony
+ *
+ * Publishes each decoded second as a (reference time, receive time) pair
+ * for a local time daemon:
+ *   - NTP SHM: the shared-memory segment of ntpd's refclock driver 28
+ *     (key 0x4E545030 + unit), also read by chrony's "refclock SHM"
+ *   - chrony SOCK: datagrams to the Unix socket chrony opens for
+ *     "refclock SOCK path"
+ *
+ * Writes never block. The SHM segment is written as a seqlock in the
+ * segment's mode 1: count is bumped before and after the fields, and
+ * a reader that sees it change (or valid clear) retries. Socket samples
+ * are sent non-blocking; with no daemon listening they are dropped.
+ *
+ * The receive time is the host clock when the second began, so any fixed
+ * latency between the antenna and the detector (SDR buffering, HF
+ * propagation) shows up as a constant offset; trim it with chrony's
+ * "offset" option or ntpd's "fudge time1", or with the delay the manager
+ * subtracts (config.refclock_delay_ms).
+ */
+
+#ifndef WWV_REFCLOCK_H
+#define WWV_REFCLOCK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    WWV_REFCLOCK_NTP_SHM = 0,
+    WWV_REFCLOCK_CHRONY_SOCK
+} wwv_refclock_kind_t;
+
+/* NTP leap indicator, as the daemons read it */
+typedef enum {
+    WWV_LEAP_NONE = 0,
+    WWV_LEAP_INSERT = 1,        /* Last minute of the day has 61 seconds */
+    WWV_LEAP_DELETE = 2,
+    WWV_LEAP_NOT_SYNCED = 3     /* Sample is not to be trusted */
+} wwv_leap_t;
+
+typedef struct {
+    wwv_refclock_kind_t kind;
+    int shm_unit;               /* NTP SHM unit; 0-1 are root-only (0600), 2+ 0666 */
+    const char *sock_path;      /* chrony SOCK socket path */
+    int precision;              /* log2 seconds, 0 = default (-10, ~1 ms) */
+} wwv_refclock_config_t;
+
+typedef struct {
+    int64_t utc_sec;            /* Unix time of the second (reference) */
+    int64_t receive_ns;         /* Host UTC clock when that second began, ns */
+    wwv_leap_t leap;
+} wwv_refclock_sample_t;
+
+typedef struct wwv_refclock wwv_refclock_t;
+
+/**
+ * Attach the SHM segment (created if absent) or the chrony socket
+ * @return NULL if it cannot be opened or the platform has no support
+ */
+wwv_refclock_t *wwv_refclock_open(const wwv_refclock_config_t *config);
+
+void wwv_refclock_close(wwv_refclock_t *rc);
+
+/**
+ * Publish one second; safe from a real-time thread
+ * @return false if the sample could not be delivered
+ */
+bool wwv_refclock_publish(wwv_refclock_t *rc, const wwv_refclock_sample_t *sample);
+
+/* Samples published and failed since open */
+uint64_t wwv_refclock_get_published(const wwv_refclock_t *rc);
+uint64_t wwv_refclock_get_failed(const wwv_refclock_t *rc);
+
+/**
+ * Unix time of 2-digit year, day of year (1-366), hour and minute, UTC
+ * (years 00-99 are 2000-2099)
+ */
+int64_t wwv_refclock_unix_time(int year, int day, int hour, int minute);
+
+/**
+ * Host UTC clock, nanoseconds since the Unix epoch
+ */
+int64_t wwv_refclock_host_ns(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_REFCLOCK_H */
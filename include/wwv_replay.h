@@ -0,0 +1,127 @@
+/**
+ * @file wwv_replay.h
+ * @brief Faster-than-real-time replay of IQ recordings through the detectors
+ *
+ * Feeds a wwv_iq_file recording to detector managers in large blocks, with
+ * no pacing, and delivers the tick and marker events with timestamps and
+ * sample indices relative to the start of the recording.
+ *
+ * INPUT RATES:
+ *   - 2 MHz: raw SDR I/Q, decimated by the manager's sdr_frontend
+ *   - 50 kHz: detector-path I/Q; the 12 kHz display path is derived with
+ *             the same 6/25 polyphase stage the SDR front end uses
+ *
+ * SEGMENTED MODE (segments > 1):
+ *   The requested span is cut into equal segments, each run by its own
+ *   manager on a worker pool. Boundaries sit on a 1.024 sec grid (a common
+ *   multiple of every detector frame hop), so each segment frames the
+ *   signal exactly as a sequential run does. A segment starts overlap_sec
+ *   early so noise floors, tick history and marker baselines have settled
+ *   by the time its own span begins, and runs WWV_REPLAY_TAIL_SEC past its
+ *   end so an event straddling the boundary still completes. Only events whose sample index
+ *   falls inside the segment's own span are kept, so every event is owned
+ *   by exactly one segment. Tick and marker numbers are renumbered over the
+ *   merged stream. Detector state is not carried between segments: a tick
+ *   or marker right after a boundary sees the lead-in's history, not the
+ *   previous segment's, and the sync detector runs independently per
+ *   segment (the final status is the last segment's).
+ *
+ *   CSV logs are written only in sequential mode; with several segments
+ *   config.detector.output_dir is ignored.
+ *
+ * Events are delivered in recording order on the calling thread after all
+ * segments finish (sequential mode delivers them as they are detected).
+ */
+
+#ifndef WWV_REPLAY_H
+#define WWV_REPLAY_H
+
+#include "wwv_detector_manager.h"
+#include "wwv_iq_file.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+#define WWV_REPLAY_MAX_SEGMENTS     256
+#define WWV_REPLAY_TAIL_SEC         2.0     /* Run past a segment end for straddling events */
+
+typedef struct {
+    wwv_detector_config_t detector; /* threaded and enable_sdr_frontend are set by the replay */
+    size_t block_samples;           /* Input samples per manager call, 0 = 1 sec (max 1 M) */
+    int segments;                   /* 1 = sequential, 0 = one per worker */
+    int worker_threads;             /* 0 = one per core, capped at segments */
+    double overlap_sec;             /* Lead-in before each segment (not before the first) */
+    double start_sec;               /* Offset into the recording */
+    double duration_sec;            /* 0 = to end of recording */
+} wwv_replay_config_t;
+
+#define WWV_REPLAY_CONFIG_DEFAULT { \
+    .detector = WWV_DETECTOR_CONFIG_DEFAULT, \
+    .block_samples = 0, \
+    .segments = 1, \
+    .worker_threads = 0, \
+    .overlap_sec = 120.0, \
+    .start_sec = 0.0, \
+    .duration_sec = 0.0 \
+}
+
+/*============================================================================
+ * Events and Results
+ *============================================================================*/
+
+typedef enum {
+    WWV_REPLAY_EVENT_TICK,
+    WWV_REPLAY_EVENT_MARKER
+} wwv_replay_event_type_t;
+
+/* timestamp_ms and sample_index (50 kHz) count from the start of the recording */
+typedef struct {
+    wwv_replay_event_type_t type;
+    int segment;
+    union {
+        wwv_tick_event_t tick;
+        wwv_marker_event_t marker;
+    };
+} wwv_replay_event_t;
+
+typedef void (*wwv_replay_event_fn)(const wwv_replay_event_t *event, void *user_data);
+
+typedef struct {
+    uint64_t input_samples;         /* Read from the recording, lead-ins and tails included */
+    double signal_sec;              /* Span replayed */
+    double wall_sec;
+    double realtime_factor;         /* signal_sec / wall_sec */
+    int segments;
+    int workers;
+    int ticks;
+    int markers;
+    wwv_sync_status_t final_sync;   /* Last segment's manager at end of replay */
+} wwv_replay_stats_t;
+
+/*============================================================================
+ * Replay
+ *============================================================================*/
+
+/**
+ * Replay a recording (or the configured span of it)
+ * @param on_event Called once per kept event, in recording order (may be NULL)
+ * @param stats    Filled on success (may be NULL)
+ * @return false for an unsupported sample rate, an empty span or a
+ *         manager / worker that fails to start
+ */
+bool wwv_replay_run(const wwv_iq_file_t *file, const wwv_replay_config_t *config,
+                    wwv_replay_event_fn on_event, void *user_data,
+                    wwv_replay_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_REPLAY_H */
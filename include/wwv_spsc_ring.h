@@ -0,0 +1,58 @@
+/**
+ * @file wwv_spsc_ring.h
+ * @brief Lock-free single-producer / single-consumer ring buffer
+ *
+ * Fixed-size elements, power-of-two capacity. One thread may write and one
+ * other thread may read concurrently without locks; the head and tail
+ * indices are C11 atomics on separate cache lines.
+ *
+ * Writes never block: if the ring is full the excess is refused and the
+ * caller decides whether to count it as an overrun.
+ */
+
+#ifndef WWV_SPSC_RING_H
+#define WWV_SPSC_RING_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct wwv_spsc_ring wwv_spsc_ring_t;
+
+/**
+ * Create ring
+ * @param elem_size Bytes per element
+ * @param min_capacity Minimum elements; rounded up to a power of two
+ */
+wwv_spsc_ring_t *wwv_spsc_ring_create(size_t elem_size, size_t min_capacity);
+
+void wwv_spsc_ring_destroy(wwv_spsc_ring_t *ring);
+
+/**
+ * Producer: copy up to count elements in
+ * @return Elements written (less than count if the ring filled up)
+ */
+size_t wwv_spsc_ring_write(wwv_spsc_ring_t *ring, const void *src, size_t count);
+
+/**
+ * Consumer: copy up to max_count elements out
+ * @return Elements read (0 if empty)
+ */
+size_t wwv_spsc_ring_read(wwv_spsc_ring_t *ring, void *dst, size_t max_count);
+
+/**
+ * Elements currently readable (exact for the consumer, a lower bound for
+ * the producer's view of free space)
+ */
+size_t wwv_spsc_ring_available(const wwv_spsc_ring_t *ring);
+
+size_t wwv_spsc_ring_capacity(const wwv_spsc_ring_t *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_SPSC_RING_H */
@@ -0,0 +1,165 @@
+/**
+ * @file wwv_state.h
+ * @brief Warm-start state blob
+ *
+ * Components snapshot what they have learned (noise floors, thresholds,
+ * chain discipline, the sync anchor) into one compact binary blob, and a
+ * restarted process restores from it instead of re-acquiring:
+ *
+ *   wwv_state_header_t
+ *   wwv_state_section_t + payload
+ *   wwv_state_section_t + payload
+ *   ...
+ *
+ * Layout rules follow telemetry_wire.h: little-endian, no implicit
+ * padding, payloads are memcpy'd rather than cast. Each section carries
+ * its component's own payload version; a restore skips a section whose
+ * version it does not know, and reads a longer payload's known prefix
+ * (fields are only ever appended).
+ *
+ * Stream times do not survive a restart, so components store times as
+ * phases (second, minute) of the stream position at save, and carry them
+ * to the new stream with the wall-clock time that passed in between
+ * (wwv_state_carry_phase()). How much of a snapshot is still believable
+ * after that time is each component's call.
+ */
+
+#ifndef WWV_STATE_H
+#define WWV_STATE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Format
+ *============================================================================*/
+
+#define WWV_STATE_MAGIC         0x53565757u  /* "WWVS" little-endian */
+#define WWV_STATE_VERSION       1
+#define WWV_STATE_MAX_BYTES     1024         /* Enough for a manager with every component */
+
+/* Snapshot ages past which components discard what they saved.
+ * Levels (noise floors, tone estimates) drift with propagation; timing
+ * (epochs, chains, the sync anchor) drifts with the sample clock's ppm
+ * error against the wall clock, ~30 ms per 10 minutes at 50 ppm. */
+#define WWV_STATE_LEVELS_MAX_AGE_MS     3600000.0   /* 1 hour */
+#define WWV_STATE_TIMING_MAX_AGE_MS     600000.0    /* 10 minutes */
+
+typedef struct {
+    uint32_t magic;             /* WWV_STATE_MAGIC */
+    uint16_t version;           /* WWV_STATE_VERSION */
+    uint16_t section_count;
+    uint32_t length;            /* Total blob bytes including this header */
+    uint32_t reserved;
+    int64_t  wall_ms;           /* Unix time of the snapshot, milliseconds */
+    double   stream_ms;         /* Detector-path stream time of the snapshot */
+} wwv_state_header_t;
+
+typedef struct {
+    uint16_t id;                /* wwv_state_section_id_t */
+    uint16_t version;           /* Component payload version */
+    uint32_t length;            /* Payload bytes following this header */
+} wwv_state_section_t;
+
+typedef enum {
+    WWV_STATE_TICK_DETECTOR = 1,
+    WWV_STATE_MARKER_DETECTOR,
+    WWV_STATE_BCD_TIME_DETECTOR,
+    WWV_STATE_BCD_FREQ_DETECTOR,
+    WWV_STATE_SLOW_MARKER,
+    WWV_STATE_TONE_CARRIER,
+    WWV_STATE_TONE_500,
+    WWV_STATE_TONE_600,
+    WWV_STATE_TICK_CORRELATOR,
+    WWV_STATE_SYNC_DETECTOR
+} wwv_state_section_id_t;
+
+_Static_assert(sizeof(wwv_state_header_t) == 32, "state header layout");
+_Static_assert(sizeof(wwv_state_section_t) == 8, "state section layout");
+
+/*============================================================================
+ * Writer
+ *============================================================================*/
+
+typedef struct {
+    uint8_t *buf;
+    size_t capacity;
+    size_t length;
+    uint16_t section_count;
+    bool overflow;              /* A section did not fit; finish() fails */
+    double stream_ms;           /* Stream time of the snapshot, for phases */
+} wwv_state_writer_t;
+
+/**
+ * Start a blob in buf
+ * @param stream_ms Current detector-path stream time
+ */
+void wwv_state_writer_init(wwv_state_writer_t *w, void *buf, size_t capacity, double stream_ms);
+
+/**
+ * Append one component section
+ * @return false (and the blob is marked failed) if it does not fit
+ */
+bool wwv_state_put(wwv_state_writer_t *w, uint16_t id, uint16_t version,
+                   const void *payload, size_t length);
+
+/**
+ * Write the header, stamped with the wall clock now
+ * @return Blob bytes, 0 if any section overflowed
+ */
+size_t wwv_state_writer_finish(wwv_state_writer_t *w);
+
+/*============================================================================
+ * Reader
+ *============================================================================*/
+
+typedef struct {
+    const uint8_t *blob;
+    size_t length;
+    uint16_t section_count;
+    double saved_stream_ms;     /* Stream time at the snapshot */
+    double elapsed_ms;          /* Wall-clock time since the snapshot */
+    double stream_ms;           /* Current stream time of the restoring process */
+} wwv_state_reader_t;
+
+/**
+ * Validate a blob's header
+ * @param stream_ms Current detector-path stream time
+ * @return false if the magic, version or length is wrong, or the wall
+ *         clock says the snapshot is from the future
+ */
+bool wwv_state_reader_init(wwv_state_reader_t *r, const void *blob, size_t length,
+                           double stream_ms);
+
+/**
+ * Copy a section's payload into out
+ * Zero-fills out past a shorter payload, ignores bytes past size
+ * @return false if the section is absent or has another version
+ */
+bool wwv_state_get(const wwv_state_reader_t *r, uint16_t id, uint16_t version,
+                   void *out, size_t size);
+
+/**
+ * Carry a saved stream time to the current stream by its phase
+ * @param saved_ms Stream time in the snapshot's stream
+ * @param period_ms Phase period (1000 for a second, 60000 for a minute)
+ * @return Latest current-stream time at or before now with the same phase,
+ *         advanced by the wall-clock time since the snapshot
+ */
+double wwv_state_carry_phase(const wwv_state_reader_t *r, double saved_ms, double period_ms);
+
+/**
+ * Wall clock, Unix milliseconds
+ */
+int64_t wwv_state_wall_ms(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_STATE_H */
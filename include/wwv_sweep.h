@@ -0,0 +1,120 @@
+/**
+ * @file wwv_sweep.h
+ * @brief Parallel parameter sweep over one recorded capture
+ *
+ * Runs one detector manager per parameter set over the same recording. The
+ * recording is read and decimated once: the driver thread converts and
+ * (for 2 MHz input) runs a single sdr_frontend, or derives the 12 kHz
+ * display path from 50 kHz input with the same 6/25 polyphase stage, into
+ * a chunk buffer which every instance then consumes. Instances run on a
+ * worker pool (instance k on worker k mod T); the driver decimates the next
+ * chunk while the workers run the current one.
+ *
+ * SCORING:
+ *   There is no ground truth in a recording, so the second and minute
+ *   epochs are estimated from the pooled events of all instances (the
+ *   densest window of tick phase mod 1 sec and marker phase mod 60 sec,
+ *   refined by the mean offset inside it). A tick within tick_window_ms of
+ *   a grid second is a hit (one per second; repeats and off-grid ticks are
+ *   false), likewise markers against the minute grid. Expected ticks are
+ *   57 per 60 grid seconds (no tick at :00, :29, :59); the marker phase
+ *   cannot place second 0 because marker events are reported well after
+ *   the pulse starts. Lock time is the timestamp of the last event before
+ *   the first is_synced sync callback.
+ */
+
+#ifndef WWV_SWEEP_H
+#define WWV_SWEEP_H
+
+#include "wwv_detector_manager.h"
+#include "wwv_iq_file.h"
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+#define WWV_SWEEP_MAX_PARAMS    8           /* Settings per parameter set */
+#define WWV_SWEEP_MAX_SETS      1024
+
+typedef struct {
+    const char *name;                       /* wwv_detector_manager_set_param() name */
+    float value;
+} wwv_sweep_param_t;
+
+typedef struct {
+    int param_count;
+    wwv_sweep_param_t params[WWV_SWEEP_MAX_PARAMS];
+} wwv_sweep_set_t;
+
+typedef struct {
+    wwv_detector_config_t detector; /* Shared by all instances; logs and threading are off */
+    int worker_threads;             /* 0 = one per core, capped at the set count */
+    double start_sec;               /* Offset into the recording */
+    double duration_sec;            /* 0 = to end of recording */
+    float tick_window_ms;           /* Hit window around each grid second */
+    float marker_window_ms;         /* Hit window around each grid minute */
+} wwv_sweep_config_t;
+
+#define WWV_SWEEP_CONFIG_DEFAULT { \
+    .detector = WWV_DETECTOR_CONFIG_DEFAULT, \
+    .worker_threads = 0, \
+    .start_sec = 0.0, \
+    .duration_sec = 0.0, \
+    .tick_window_ms = 20.0f, \
+    .marker_window_ms = 250.0f \
+}
+
+/*============================================================================
+ * Results
+ *============================================================================*/
+
+typedef struct {
+    bool valid;                     /* false: a setting was rejected, set not run */
+    int ticks;
+    int tick_hits;
+    float tick_detection_rate;      /* tick_hits / expected ticks */
+    float false_ticks_per_min;
+    int markers;
+    int marker_hits;
+    float marker_detection_rate;    /* marker_hits / expected markers */
+    float false_markers_per_hour;
+    double lock_sec;                /* Recording time of first lock, < 0 = never */
+} wwv_sweep_result_t;
+
+typedef struct {
+    double signal_sec;
+    double wall_sec;
+    double frontend_sec;            /* Driver time reading and decimating */
+    double tick_epoch_ms;           /* Estimated second phase, 0..1000 */
+    double marker_epoch_ms;         /* Estimated minute phase, 0..60000, < 0 = none */
+    int expected_ticks;
+    int expected_markers;
+    int sets;
+    int workers;
+} wwv_sweep_stats_t;
+
+/*============================================================================
+ * Sweep
+ *============================================================================*/
+
+/**
+ * Run every parameter set over the recording
+ * @param results set_count entries, filled in set order
+ * @param stats   May be NULL
+ * @return false for an unsupported sample rate, an empty span, or a
+ *         manager / worker that fails to start
+ */
+bool wwv_sweep_run(const wwv_iq_file_t *file, const wwv_sweep_config_t *config,
+                   const wwv_sweep_set_t *sets, int set_count,
+                   wwv_sweep_result_t *results, wwv_sweep_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_SWEEP_H */
@@ -0,0 +1,130 @@
+/**
+ * @file wwv_thread.h
+ * @brief Minimal portable threading primitives
+ *
+ * Thin wrapper over Win32 (SRWLOCK / CONDITION_VARIABLE / CreateThread)
+ * and POSIX threads so library modules can share resources and run
+ * worker pools without pulling in a threading dependency.
+ *
+ * Mutexes support static initialization with WWV_MUTEX_INITIALIZER.
+ *
+ * Real-time placement (affinity, SCHED_FIFO / MMCSS, mlockall) applies to
+ * the calling thread or process and reports refusal rather than failing:
+ * it needs privileges (CAP_SYS_NICE, CAP_IPC_LOCK or RLIMIT_MEMLOCK on
+ * Linux) that a development run usually lacks.
+ */
+
+#ifndef WWV_THREAD_H
+#define WWV_THREAD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+typedef SRWLOCK wwv_mutex_t;
+typedef CONDITION_VARIABLE wwv_cond_t;
+typedef HANDLE wwv_thread_t;
+#define WWV_MUTEX_INITIALIZER SRWLOCK_INIT
+#else
+#include <pthread.h>
+typedef pthread_mutex_t wwv_mutex_t;
+typedef pthread_cond_t wwv_cond_t;
+typedef pthread_t wwv_thread_t;
+#define WWV_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*wwv_thread_fn)(void *arg);
+
+/* Mutex */
+void wwv_mutex_init(wwv_mutex_t *m);
+void wwv_mutex_destroy(wwv_mutex_t *m);
+void wwv_mutex_lock(wwv_mutex_t *m);
+void wwv_mutex_unlock(wwv_mutex_t *m);
+
+/* Condition variable (always used with a wwv_mutex_t) */
+void wwv_cond_init(wwv_cond_t *c);
+void wwv_cond_destroy(wwv_cond_t *c);
+void wwv_cond_wait(wwv_cond_t *c, wwv_mutex_t *m);
+void wwv_cond_signal(wwv_cond_t *c);
+void wwv_cond_broadcast(wwv_cond_t *c);
+
+/**
+ * Wait with timeout
+ * @return false on timeout (spurious wakeups may return true)
+ */
+bool wwv_cond_timedwait_ms(wwv_cond_t *c, wwv_mutex_t *m, unsigned timeout_ms);
+
+/**
+ * Start a thread running fn(arg)
+ * @return true on success
+ */
+bool wwv_thread_create(wwv_thread_t *t, wwv_thread_fn fn, void *arg);
+
+/**
+ * Wait for thread to exit and release its handle
+ */
+void wwv_thread_join(wwv_thread_t t);
+
+/**
+ * Number of online CPU cores (at least 1)
+ */
+int wwv_cpu_count(void);
+
+/*============================================================================
+ * Real-Time Placement
+ *============================================================================*/
+
+#define WWV_RT_PRIORITY_MAX     99      /* SCHED_FIFO range is 1..99 */
+
+/**
+ * Restrict the calling thread to the CPUs in mask (bit n = CPU n, 0-63)
+ * @return false if refused or unsupported (not Linux / Windows)
+ */
+bool wwv_thread_set_affinity(uint64_t cpu_mask);
+
+/**
+ * CPUs the calling thread may run on, 0 if unknown
+ */
+uint64_t wwv_thread_get_affinity(void);
+
+/**
+ * Real-time scheduling for the calling thread: SCHED_FIFO at priority
+ * (1..WWV_RT_PRIORITY_MAX) on POSIX, the MMCSS "Pro Audio" task on
+ * Windows (high priority from 50 up)
+ * @return false if refused
+ */
+bool wwv_thread_set_realtime(int priority);
+
+/**
+ * Real-time priority the calling thread runs at, 0 = normal scheduling
+ */
+int wwv_thread_get_realtime(void);
+
+/**
+ * Lock every current and future page of the process in RAM (mlockall).
+ * Stays in force for the life of the process; once locked, an allocation
+ * past RLIMIT_MEMLOCK fails instead of paging.
+ * @return false if refused or unsupported (Windows)
+ */
+bool wwv_memory_lock(void);
+
+/**
+ * Thread-safe localtime(): result lives in per-thread storage, valid
+ * until the calling thread's next wwv_localtime()
+ */
+struct tm *wwv_localtime(const time_t *t);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_THREAD_H */
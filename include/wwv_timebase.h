@@ -0,0 +1,53 @@
+/**
+ * @file wwv_timebase.h
+ * @brief 64-bit sample-count timebase
+ *
+ * Detectors keep time as the number of input samples consumed at their
+ * own input rate (50 kHz detector path, 12 kHz display path). A 64-bit
+ * counter is exact for millions of years; milliseconds are derived in
+ * double only where an event is reported or compared.
+ *
+ * float milliseconds stop resolving 1 ms after 2^24 ms (~4.6 hours), so
+ * absolute timestamps are double everywhere and only durations and
+ * intervals stay float.
+ */
+
+#ifndef WWV_TIMEBASE_H
+#define WWV_TIMEBASE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Input sample index since the detector started, at a stated rate */
+typedef uint64_t wwv_sample_t;
+
+/**
+ * Convert a sample index to milliseconds since start
+ */
+static inline double wwv_samples_to_ms(wwv_sample_t samples, unsigned rate_hz) {
+    return (double)samples * 1000.0 / (double)rate_hz;
+}
+
+/**
+ * Convert milliseconds since start to the nearest sample index (0 if negative)
+ */
+static inline wwv_sample_t wwv_ms_to_samples(double ms, unsigned rate_hz) {
+    return ms > 0.0 ? (wwv_sample_t)(ms * (double)rate_hz / 1000.0 + 0.5) : 0;
+}
+
+/**
+ * Re-express a sample index at another rate (e.g. 50 kHz -> 12 kHz)
+ */
+static inline wwv_sample_t wwv_samples_rescale(wwv_sample_t samples, unsigned from_hz,
+                                               unsigned to_hz) {
+    return (wwv_sample_t)(((double)samples * (double)to_hz) / (double)from_hz + 0.5);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_TIMEBASE_H */
@@ -0,0 +1,110 @@
+/**
+ * @file wwv_timer_wheel.h
+ * @brief Deadline timers on the detector sample clock
+ *
+ * Correlators used to find out that a deadline had passed only when the
+ * next event arrived or when the caller polled them. Here they arm a timer
+ * for the sample at which something is due (window close, expected marker,
+ * recovery timeout) and the owner of the sample clock advances the wheel
+ * as samples are processed, so callbacks run exactly when the deadline is
+ * reached, independent of block size and wall clock. Replaying a
+ * recording therefore fires the same timers at the same samples.
+ *
+ * Hashed wheel: WWV_TIMER_WHEEL_SLOTS slots of 2^slot_shift samples each;
+ * a timer further out than one revolution stays in its slot until its
+ * round comes. Timers are embedded in their owner (no allocation on arm)
+ * and fire in deadline order, ties in arm order. Callbacks may arm or
+ * cancel any timer, including their own. Single thread: the wheel lives
+ * on whichever thread processes the sample path.
+ */
+
+#ifndef WWV_TIMER_WHEEL_H
+#define WWV_TIMER_WHEEL_H
+
+#include "wwv_timebase.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WWV_TIMER_WHEEL_SLOTS   256             /* Power of two */
+#define WWV_TIMER_NEVER         UINT64_MAX      /* next_deadline() with nothing armed */
+
+typedef struct wwv_timer_wheel wwv_timer_wheel_t;
+typedef struct wwv_timer wwv_timer_t;
+
+/**
+ * Timer expiry callback
+ * @param now_ms The deadline, in milliseconds on the wheel's clock
+ */
+typedef void (*wwv_timer_fn)(wwv_timer_t *timer, double now_ms, void *user_data);
+
+struct wwv_timer {
+    wwv_timer_t *prev;          /* Slot list, owned by the wheel */
+    wwv_timer_t *next;
+    wwv_sample_t deadline;
+    wwv_timer_fn fn;
+    void *user_data;
+    bool armed;
+};
+
+/**
+ * Create a wheel on a sample clock
+ * @param rate_hz    Sample rate of the clock passed to advance()
+ * @param slot_shift Slot width is 2^slot_shift samples (e.g. 6 = 1.28 ms at 50 kHz)
+ */
+wwv_timer_wheel_t *wwv_timer_wheel_create(unsigned rate_hz, unsigned slot_shift);
+
+/**
+ * Free the wheel. Timers still armed are left disarmed.
+ */
+void wwv_timer_wheel_destroy(wwv_timer_wheel_t *wheel);
+
+/**
+ * Set the callback of an embedded timer (before first use)
+ */
+void wwv_timer_init(wwv_timer_t *timer, wwv_timer_fn fn, void *user_data);
+
+/**
+ * Arm (or re-arm) a timer for a sample. A deadline already passed fires
+ * on the next advance().
+ */
+void wwv_timer_arm(wwv_timer_wheel_t *wheel, wwv_timer_t *timer, wwv_sample_t deadline);
+
+/**
+ * Arm for the first sample strictly after a time in milliseconds, so a
+ * callback testing `now_ms - start > limit` always sees the limit passed
+ */
+void wwv_timer_arm_after_ms(wwv_timer_wheel_t *wheel, wwv_timer_t *timer, double ms);
+
+/**
+ * Disarm a timer (no-op if it is not armed)
+ */
+void wwv_timer_cancel(wwv_timer_wheel_t *wheel, wwv_timer_t *timer);
+
+static inline bool wwv_timer_is_armed(const wwv_timer_t *timer) {
+    return timer->armed;
+}
+
+/**
+ * Earliest armed deadline, WWV_TIMER_NEVER if none
+ */
+wwv_sample_t wwv_timer_wheel_next_deadline(wwv_timer_wheel_t *wheel);
+
+/**
+ * Move the clock to `now` (samples consumed so far), firing every timer
+ * whose deadline is <= now
+ * @return Timers fired
+ */
+int wwv_timer_wheel_advance(wwv_timer_wheel_t *wheel, wwv_sample_t now);
+
+wwv_sample_t wwv_timer_wheel_now(const wwv_timer_wheel_t *wheel);
+unsigned wwv_timer_wheel_rate(const wwv_timer_wheel_t *wheel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_TIMER_WHEEL_H */
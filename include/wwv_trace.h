@@ -0,0 +1,118 @@
+/**
+ * @file wwv_trace.h
+ * @brief Timeline trace of the processing pipeline (Chrome trace events)
+ *
+ * Spans from the manager blocks, the detector FFT frames, the CSV log
+ * writer and the telemetry sender go to one trace file in the Chrome
+ * trace-event JSON array format, which ui.perfetto.dev and
+ * chrome://tracing open directly. Each thread gets a row of its own,
+ * named by WWV_TRACE_THREAD(), and each span carries the stream (sample)
+ * time it worked on as args.sample_ms (a detector frame's start, the
+ * last sample of a manager block), so processing latency lines up with
+ * the signal events in the CSV logs.
+ *
+ * A thread's first span of a trace registers a lock-free ring of its own;
+ * after that a span is two clock reads and one ring write, with no lock.
+ * A background thread drains the rings every flush_ms and appends the
+ * JSON. Spans that find their thread's ring full are dropped and counted.
+ * The closing ']' is written by wwv_trace_stop(), but the viewers accept
+ * a file without it, so the trace of a crashed run still opens.
+ *
+ * Tracing is compiled in only with WWV_TRACE_ENABLED (CMake -DWWV_TRACE=ON).
+ * Without it the macros are empty and wwv_trace_start() returns false.
+ *
+ * RULES:
+ *   - cat, name and thread names are string literals (the pointer is stored)
+ *   - One trace at a time, process-wide
+ */
+
+#ifndef WWV_TRACE_H
+#define WWV_TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+typedef struct {
+    unsigned ring_events;       /* Per thread (rounded up to a power of two) */
+    unsigned flush_ms;          /* Drain cadence */
+} wwv_trace_config_t;
+
+#define WWV_TRACE_CONFIG_DEFAULT { \
+    .ring_events = 16384, \
+    .flush_ms = 100 \
+}
+
+#define WWV_TRACE_NO_SAMPLE     (-1.0)  /* sample_ms of a span not tied to stream time */
+
+typedef struct {
+    bool enabled;               /* false when built without WWV_TRACE_ENABLED */
+    bool active;                /* A trace is running */
+    unsigned threads;           /* Threads that have traced */
+    uint64_t events;            /* Written to the file */
+    uint64_t dropped;           /* Lost to a full ring */
+} wwv_trace_stats_t;
+
+/*============================================================================
+ * Instrumentation
+ *============================================================================*/
+
+#ifdef WWV_TRACE_ENABLED
+#define WWV_TRACE_BEGIN(t0) \
+    uint64_t t0 = wwv_trace_begin()
+#define WWV_TRACE_END(cat, name, t0, sample_ms) \
+    do { if (t0) wwv_trace_span((cat), (name), (t0), (sample_ms)); } while (0)
+#define WWV_TRACE_THREAD(name)  wwv_trace_thread_name(name)
+#else
+#define WWV_TRACE_BEGIN(t0)                         ((void)0)
+#define WWV_TRACE_END(cat, name, t0, sample_ms)     ((void)0)
+#define WWV_TRACE_THREAD(name)                      ((void)0)
+#endif
+
+/**
+ * Span start time in ns, 0 when no trace is running
+ */
+uint64_t wwv_trace_begin(void);
+
+/**
+ * Record a span from start_ns to now on the calling thread's row
+ * @param sample_ms Stream time the span worked on, WWV_TRACE_NO_SAMPLE if none
+ */
+void wwv_trace_span(const char *cat, const char *name, uint64_t start_ns, double sample_ms);
+
+/**
+ * Name the calling thread's row, in this trace and any later one
+ */
+void wwv_trace_thread_name(const char *name);
+
+/*============================================================================
+ * Session
+ *============================================================================*/
+
+/**
+ * Create path and start tracing
+ * @param config NULL = WWV_TRACE_CONFIG_DEFAULT
+ * @return false if a trace is running, the file cannot be created, or the
+ *         build has no WWV_TRACE_ENABLED
+ */
+bool wwv_trace_start(const char *path, const wwv_trace_config_t *config);
+
+/**
+ * Write out every pending span, close the file and free the rings
+ */
+void wwv_trace_stop(void);
+
+void wwv_trace_get_stats(wwv_trace_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_TRACE_H */
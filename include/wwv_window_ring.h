@@ -0,0 +1,73 @@
+/**
+ * @file wwv_window_ring.h
+ * @brief Mirrored sample ring: the last N samples are always contiguous
+ *
+ * Every sample is written twice, at pos and pos + size, into a 2 * size
+ * array. The newest `size` samples therefore always start at data + pos in
+ * order oldest to newest, so any window of them can be handed straight to
+ * fft_processor_process() or a dot product with no copy and no modulo.
+ * The extra store per sample is cheaper than rearranging on every read.
+ *
+ * The struct is embedded in its owner and push is inline; it is a plain
+ * single-thread buffer (see wwv_spsc_ring.h for cross-thread handoff).
+ */
+
+#ifndef WWV_WINDOW_RING_H
+#define WWV_WINDOW_RING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    float *data;            /* 2 * size floats, second half mirrors the first */
+    int size;               /* Window length */
+    int pos;                /* Next write slot, 0..size-1 (also oldest sample) */
+} wwv_window_ring_t;
+
+/**
+ * Allocate a zero-filled ring of `size` samples
+ * @return false on allocation failure
+ */
+bool wwv_window_ring_init(wwv_window_ring_t *ring, int size);
+
+void wwv_window_ring_free(wwv_window_ring_t *ring);
+
+/**
+ * Zero the contents and restart at slot 0
+ */
+void wwv_window_ring_reset(wwv_window_ring_t *ring);
+
+/**
+ * Append a block (only the last `size` samples of a longer block survive)
+ */
+void wwv_window_ring_write(wwv_window_ring_t *ring, const float *samples, size_t count);
+
+static inline void wwv_window_ring_push(wwv_window_ring_t *ring, float sample) {
+    ring->data[ring->pos] = sample;
+    ring->data[ring->pos + ring->size] = sample;
+    if (++ring->pos == ring->size) ring->pos = 0;
+}
+
+/**
+ * The whole window, oldest sample first (valid until the next write)
+ */
+static inline const float *wwv_window_ring_window(const wwv_window_ring_t *ring) {
+    return ring->data + ring->pos;
+}
+
+/**
+ * The newest n samples (n <= size), oldest first
+ */
+static inline const float *wwv_window_ring_recent(const wwv_window_ring_t *ring, int n) {
+    return ring->data + ring->pos + ring->size - n;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WWV_WINDOW_RING_H */
@@ -0,0 +1,59 @@
+/**
+ * @file zoom_dft.h
+ * @brief Narrow-band DFT refinement of a located spectral peak
+ *
+ * Evaluates the windowed DTFT of one analysis frame at a handful of
+ * arbitrary frequencies around a coarse FFT peak (chirp-z style: only the
+ * band of interest, at any spacing). Each point is one double-precision
+ * Goertzel pass over the frame. A +/-5 Hz search with two passes of
+ * ZOOM_DFT_POINTS points costs about half of one 4x zero-padded FFT (which
+ * would only reach 0.7 Hz bins); the final interpolation resolves well
+ * below a millihertz.
+ *
+ * Magnitudes use the fft_processor_get_magnitudes() scale (|X|, same window),
+ * so SNR thresholds carry over unchanged.
+ */
+
+#ifndef ZOOM_DFT_H
+#define ZOOM_DFT_H
+
+#include <stdbool.h>
+#include "fft_plan_cache.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ZOOM_DFT_POINTS     9       /* Points per refinement pass */
+#define ZOOM_DFT_PASSES     2       /* Each pass spans +/-1 step of the last */
+
+typedef struct zoom_dft zoom_dft_t;
+
+/**
+ * Create for frames of block_size samples
+ * @param window Same analysis window as the coarse FFT
+ */
+zoom_dft_t *zoom_dft_create(int block_size, float sample_rate, fft_window_t window);
+
+void zoom_dft_destroy(zoom_dft_t *zd);
+
+/**
+ * Magnitudes at f_start + k * f_step, k = 0..points-1 (negative Hz allowed)
+ * @param i_samples, q_samples One frame, oldest sample first
+ */
+void zoom_dft_evaluate(zoom_dft_t *zd, const float *i_samples, const float *q_samples,
+                       float f_start, float f_step, int points, float *magnitudes);
+
+/**
+ * Refine the peak nearest center_hz, searching center_hz +/- span_hz
+ * @param peak_mag Optional, magnitude at the refined frequency
+ * @return Refined peak frequency in Hz (center_hz on bad arguments)
+ */
+float zoom_dft_refine_peak(zoom_dft_t *zd, const float *i_samples, const float *q_samples,
+                           float center_hz, float span_hz, float *peak_mag);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZOOM_DFT_H */
@@ -0,0 +1,668 @@
+/**
+ * @file _phoenix_wwv.c
+ * @brief CPython extension: wwv_detector_manager over the buffer protocol
+ *
+ * Samples are taken from any C-contiguous buffer exporter (numpy arrays,
+ * memoryviews of mmap'd recordings, bytes) without a copy:
+ *   - complex64 ("Zf"), or float32 I/Q pairs ("f", shape (n, 2) or (2n,))
+ *   - int16 I/Q pairs ("h"), full scale = 1.0
+ *   - raw bytes with sample_format="complex64" / "int16"
+ * and handed to the manager's interleaved block entry points with the GIL
+ * released, one second of input per call. Deinterleaving (SDR float and
+ * display paths) goes through a small per-detector scratch buffer.
+ *
+ * Events are collected with the manager's batched-event API into growing
+ * C arrays of wwv_tick_event_t / wwv_marker_event_t / wwv_sync_status_t.
+ * take_events() hands each array over as an EventArray that exports the
+ * structs as a read-only buffer; event_layout() gives the field offsets,
+ * so numpy views them as structured arrays without another copy.
+ *
+ * One Detector may be used from one thread at a time (a second concurrent
+ * call raises); separate Detectors run in parallel.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <structmember.h>
+#include "wwv_detector_manager.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PY_BATCH_CAPACITY   64          /* Events per manager call (one second of input) */
+#define PY_SCRATCH_SAMPLES  4096        /* Deinterleave chunk */
+#define PY_DETECTOR_RATE    50000
+#define PY_DISPLAY_RATE     12000
+#define PY_SDR_RATE         2000000
+
+_Static_assert(sizeof(kiss_fft_cpx) == 2 * sizeof(float), "complex64 layout");
+_Static_assert(sizeof(int) == 4 && sizeof(wwv_station_t) == 4, "event_layout type strings");
+_Static_assert(sizeof(bool) == 1, "event_layout type strings");
+
+typedef enum {
+    PY_FMT_CF32,
+    PY_FMT_CI16
+} py_format_t;
+
+typedef enum {
+    PY_PATH_DETECTOR,
+    PY_PATH_DISPLAY,
+    PY_PATH_SDR
+} py_path_t;
+
+/*============================================================================
+ * Event Storage
+ *============================================================================*/
+
+typedef struct {
+    char *data;
+    size_t count;
+    size_t capacity;
+    size_t itemsize;
+} py_event_store_t;
+
+static bool store_append(py_event_store_t *s, const void *items, int n) {
+    if (n <= 0) return true;
+    if (s->count + (size_t)n > s->capacity) {
+        size_t cap = s->capacity ? s->capacity * 2 : 256;
+        while (cap < s->count + (size_t)n) cap *= 2;
+        char *grown = realloc(s->data, cap * s->itemsize);
+        if (!grown) return false;
+        s->data = grown;
+        s->capacity = cap;
+    }
+    memcpy(s->data + s->count * s->itemsize, items, (size_t)n * s->itemsize);
+    s->count += (size_t)n;
+    return true;
+}
+
+/*============================================================================
+ * EventArray: a taken-over store exported as a read-only buffer
+ *============================================================================*/
+
+typedef struct {
+    PyObject_HEAD
+    char *data;
+    Py_ssize_t count;
+    Py_ssize_t itemsize;
+    const char *kind;
+} EventArrayObject;
+
+static PyTypeObject EventArrayType;
+
+static PyObject *event_array_take(py_event_store_t *s, const char *kind) {
+    EventArrayObject *a = PyObject_New(EventArrayObject, &EventArrayType);
+    if (!a) return NULL;
+    a->data = s->data;
+    a->count = (Py_ssize_t)s->count;
+    a->itemsize = (Py_ssize_t)s->itemsize;
+    a->kind = kind;
+    s->data = NULL;
+    s->count = 0;
+    s->capacity = 0;
+    return (PyObject *)a;
+}
+
+static void event_array_dealloc(EventArrayObject *a) {
+    free(a->data);
+    PyObject_Free(a);
+}
+
+static int event_array_getbuffer(EventArrayObject *a, Py_buffer *view, int flags) {
+    static char empty;
+    void *buf = a->data ? (void *)a->data : (void *)&empty;
+    return PyBuffer_FillInfo(view, (PyObject *)a, buf, a->count * a->itemsize, 1, flags);
+}
+
+static Py_ssize_t event_array_length(EventArrayObject *a) {
+    return a->count;
+}
+
+static PyObject *event_array_repr(EventArrayObject *a) {
+    return PyUnicode_FromFormat("<EventArray %s x %zd>", a->kind, a->count);
+}
+
+static PyBufferProcs event_array_buffer = {
+    .bf_getbuffer = (getbufferproc)event_array_getbuffer,
+};
+
+static PySequenceMethods event_array_sequence = {
+    .sq_length = (lenfunc)event_array_length,
+};
+
+static PyMemberDef event_array_members[] = {
+    { "itemsize", T_PYSSIZET, offsetof(EventArrayObject, itemsize), READONLY,
+      "Bytes per event struct" },
+    { "kind", T_STRING, offsetof(EventArrayObject, kind), READONLY,
+      "'tick', 'marker' or 'sync'" },
+    { NULL }
+};
+
+static PyTypeObject EventArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "phoenix_wwv._phoenix_wwv.EventArray",
+    .tp_doc = "Detector events as packed C structs (see event_layout())",
+    .tp_basicsize = sizeof(EventArrayObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_dealloc = (destructor)event_array_dealloc,
+    .tp_repr = (reprfunc)event_array_repr,
+    .tp_as_buffer = &event_array_buffer,
+    .tp_as_sequence = &event_array_sequence,
+    .tp_members = event_array_members,
+};
+
+/*============================================================================
+ * Detector
+ *============================================================================*/
+
+typedef struct {
+    PyObject_HEAD
+    wwv_detector_manager_t *mgr;
+    bool sdr;                       /* config.enable_sdr_frontend */
+    bool busy;                      /* A call is running with the GIL released */
+    wwv_detector_config_t config;   /* As created, output_dir cleared */
+
+    wwv_tick_event_t batch_ticks[PY_BATCH_CAPACITY];
+    wwv_marker_event_t batch_markers[PY_BATCH_CAPACITY];
+    wwv_sync_status_t batch_syncs[PY_BATCH_CAPACITY];
+
+    py_event_store_t ticks;
+    py_event_store_t markers;
+    py_event_store_t syncs;
+    uint64_t dropped;               /* Lost to full batches or failed growth */
+
+    float scratch_i[PY_SCRATCH_SAMPLES];
+    float scratch_q[PY_SCRATCH_SAMPLES];
+} DetectorObject;
+
+/* Runs on the calling thread inside the GIL-free section: C only */
+static void on_batch(const wwv_event_batch_t *batch, void *user_data) {
+    DetectorObject *self = user_data;
+    self->dropped += batch->dropped;
+    if (!store_append(&self->ticks, batch->ticks, batch->tick_count)) {
+        self->dropped += (uint64_t)batch->tick_count;
+    }
+    if (!store_append(&self->markers, batch->markers, batch->marker_count)) {
+        self->dropped += (uint64_t)batch->marker_count;
+    }
+    if (!store_append(&self->syncs, batch->syncs, batch->sync_count)) {
+        self->dropped += (uint64_t)batch->sync_count;
+    }
+}
+
+static int detector_init(DetectorObject *self, PyObject *args, PyObject *kwds) {
+    static char *kwlist[] = {
+        "output_dir", "dual_station", "fast_acquire", "tick_economy", "tone_trackers",
+        "correlators", "slow_marker", "bcd", "bcd_integrate_minutes", "baseband_path",
+        "bcd_freq_sliding", "bcd_adaptive", "detector_tiling", "sdr", NULL
+    };
+    wwv_detector_config_t config = WWV_DETECTOR_CONFIG_DEFAULT;
+    const char *output_dir = NULL;
+    int dual = config.dual_station, fast = config.fast_acquire, economy = config.tick_economy;
+    int tones = config.enable_tone_trackers, corr = config.enable_correlators;
+    int slow = config.enable_slow_marker, bcd = config.enable_bcd_detectors;
+    int integrate = config.bcd_integrate_minutes, baseband = config.baseband_path;
+    int sliding = config.bcd_freq_sliding, adaptive = config.bcd_adaptive;
+    int tiling = config.detector_tiling;
+    int sdr = config.enable_sdr_frontend;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|$zpppppppippppp", kwlist,
+                                     &output_dir, &dual, &fast, &economy, &tones, &corr,
+                                     &slow, &bcd, &integrate, &baseband, &sliding, &adaptive,
+                                     &tiling, &sdr)) {
+        return -1;
+    }
+    if (self->mgr) {
+        PyErr_SetString(PyExc_RuntimeError, "Detector already initialized");
+        return -1;
+    }
+
+    config.output_dir = output_dir;
+    config.dual_station = dual;
+    config.fast_acquire = fast;
+    config.tick_economy = economy;
+    config.enable_tone_trackers = tones;
+    config.enable_correlators = corr;
+    config.enable_slow_marker = slow;
+    config.enable_bcd_detectors = bcd;
+    config.bcd_integrate_minutes = integrate;
+    config.baseband_path = baseband;
+    config.bcd_freq_sliding = sliding;
+    config.bcd_adaptive = adaptive;
+    config.detector_tiling = tiling;
+    config.enable_sdr_frontend = sdr;
+
+    self->ticks.itemsize = sizeof(wwv_tick_event_t);
+    self->markers.itemsize = sizeof(wwv_marker_event_t);
+    self->syncs.itemsize = sizeof(wwv_sync_status_t);
+    self->sdr = sdr;
+
+    Py_BEGIN_ALLOW_THREADS
+    self->mgr = wwv_detector_manager_create(&config);
+    Py_END_ALLOW_THREADS
+    if (!self->mgr) {
+        PyErr_SetString(PyExc_RuntimeError, "wwv_detector_manager_create failed");
+        return -1;
+    }
+
+    wwv_event_buffers_t buffers = {
+        self->batch_ticks, PY_BATCH_CAPACITY,
+        self->batch_markers, PY_BATCH_CAPACITY,
+        self->batch_syncs, PY_BATCH_CAPACITY
+    };
+    wwv_detector_manager_set_event_buffers(self->mgr, &buffers);
+    wwv_detector_manager_set_batch_callback(self->mgr, on_batch, self);
+    self->config = config;
+    self->config.output_dir = NULL;
+    return 0;
+}
+
+static void detector_close_manager(DetectorObject *self) {
+    if (!self->mgr) return;
+    wwv_detector_manager_t *mgr = self->mgr;
+    self->mgr = NULL;
+    Py_BEGIN_ALLOW_THREADS
+    wwv_detector_manager_destroy(mgr);
+    Py_END_ALLOW_THREADS
+}
+
+static void detector_dealloc(DetectorObject *self) {
+    detector_close_manager(self);
+    free(self->ticks.data);
+    free(self->markers.data);
+    free(self->syncs.data);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static bool detector_ready(DetectorObject *self) {
+    if (!self->mgr) {
+        PyErr_SetString(PyExc_ValueError, "Detector is closed");
+        return false;
+    }
+    if (self->busy) {
+        PyErr_SetString(PyExc_RuntimeError, "Detector is in use by another thread");
+        return false;
+    }
+    return true;
+}
+
+/*============================================================================
+ * Sample Ingest
+ *============================================================================*/
+
+/* Buffer format without a native / little-endian byte-order prefix */
+static const char *plain_format(const char *f) {
+    if (!f) return "B";
+    if (*f == '@' || *f == '=' || *f == '<') return f + 1;
+    return f;
+}
+
+static bool get_samples(PyObject *obj, const char *hint, Py_buffer *view,
+                        py_format_t *fmt, size_t *count) {
+    if (PyObject_GetBuffer(obj, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0) return false;
+
+    const char *f = plain_format(view->format);
+    if (hint) {
+        if (strcmp(hint, "complex64") == 0 || strcmp(hint, "cf32") == 0) {
+            *fmt = PY_FMT_CF32;
+        } else if (strcmp(hint, "int16") == 0 || strcmp(hint, "ci16") == 0) {
+            *fmt = PY_FMT_CI16;
+        } else {
+            PyErr_Format(PyExc_ValueError, "unknown sample_format '%s'", hint);
+            goto fail;
+        }
+    } else if (strcmp(f, "Zf") == 0 || strcmp(f, "f") == 0) {
+        *fmt = PY_FMT_CF32;
+    } else if (strcmp(f, "h") == 0) {
+        *fmt = PY_FMT_CI16;
+    } else {
+        PyErr_Format(PyExc_TypeError,
+                     "samples must be complex64, float32 or int16 I/Q pairs "
+                     "(buffer format '%s'; pass sample_format= for raw bytes)", view->format);
+        goto fail;
+    }
+
+    size_t pair = (*fmt == PY_FMT_CF32) ? 2 * sizeof(float) : 2 * sizeof(int16_t);
+    if ((size_t)view->len % pair != 0) {
+        PyErr_SetString(PyExc_ValueError, "samples do not hold whole I/Q pairs");
+        goto fail;
+    }
+    if ((uintptr_t)view->buf % (pair / 2) != 0) {
+        PyErr_SetString(PyExc_ValueError, "sample buffer is not aligned to its element type");
+        goto fail;
+    }
+    *count = (size_t)view->len / pair;
+    return true;
+
+fail:
+    PyBuffer_Release(view);
+    return false;
+}
+
+/* Planar float from interleaved samples [off, off + n), n <= PY_SCRATCH_SAMPLES */
+static void deinterleave(DetectorObject *self, py_format_t fmt, const void *buf,
+                         size_t off, size_t n) {
+    if (fmt == PY_FMT_CF32) {
+        const float *iq = (const float *)buf + 2 * off;
+        for (size_t k = 0; k < n; k++) {
+            self->scratch_i[k] = iq[2 * k];
+            self->scratch_q[k] = iq[2 * k + 1];
+        }
+    } else {
+        const int16_t *iq = (const int16_t *)buf + 2 * off;
+        for (size_t k = 0; k < n; k++) {
+            self->scratch_i[k] = iq[2 * k] * (1.0f / 32768.0f);
+            self->scratch_q[k] = iq[2 * k + 1] * (1.0f / 32768.0f);
+        }
+    }
+}
+
+/* GIL released: manager calls of at most one second of input each */
+static void feed(DetectorObject *self, py_path_t path, py_format_t fmt,
+                 const void *buf, size_t count) {
+    size_t second = (path == PY_PATH_SDR) ? PY_SDR_RATE
+                  : (path == PY_PATH_DISPLAY) ? PY_DISPLAY_RATE : PY_DETECTOR_RATE;
+    bool direct = (path == PY_PATH_DETECTOR) || (path == PY_PATH_SDR && fmt == PY_FMT_CI16);
+    size_t chunk = direct ? second : PY_SCRATCH_SAMPLES;
+
+    for (size_t off = 0; off < count; off += chunk) {
+        size_t n = (count - off < chunk) ? count - off : chunk;
+        if (path == PY_PATH_DETECTOR && fmt == PY_FMT_CF32) {
+            wwv_detector_manager_process_detector_block_cpx(self->mgr,
+                (const kiss_fft_cpx *)buf + off, n);
+        } else if (path == PY_PATH_DETECTOR) {
+            wwv_detector_manager_process_detector_block_s16(self->mgr,
+                (const int16_t *)buf + 2 * off, n);
+        } else if (path == PY_PATH_SDR && fmt == PY_FMT_CI16) {
+            wwv_detector_manager_process_sdr_block_s16(self->mgr,
+                (const int16_t *)buf + 2 * off, n);
+        } else {
+            deinterleave(self, fmt, buf, off, n);
+            if (path == PY_PATH_SDR) {
+                wwv_detector_manager_process_sdr_block(self->mgr, self->scratch_i,
+                                                       self->scratch_q, n);
+            } else {
+                wwv_detector_manager_process_display_block(self->mgr, self->scratch_i,
+                                                           self->scratch_q, n);
+            }
+        }
+    }
+}
+
+static PyObject *detector_run(DetectorObject *self, PyObject *args, PyObject *kwds,
+                              py_path_t path) {
+    static char *kwlist[] = { "samples", "sample_format", NULL };
+    PyObject *obj;
+    const char *hint = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|z", kwlist, &obj, &hint)) return NULL;
+    if (!detector_ready(self)) return NULL;
+    if (path == PY_PATH_SDR && !self->sdr) {
+        PyErr_SetString(PyExc_ValueError, "process_sdr() needs Detector(sdr=True)");
+        return NULL;
+    }
+
+    Py_buffer view;
+    py_format_t fmt;
+    size_t count;
+    if (!get_samples(obj, hint, &view, &fmt, &count)) return NULL;
+
+    self->busy = true;
+    Py_BEGIN_ALLOW_THREADS
+    feed(self, path, fmt, view.buf, count);
+    Py_END_ALLOW_THREADS
+    self->busy = false;
+
+    PyBuffer_Release(&view);
+    return PyLong_FromSize_t(count);
+}
+
+static PyObject *detector_process(DetectorObject *self, PyObject *args, PyObject *kwds) {
+    return detector_run(self, args, kwds, PY_PATH_DETECTOR);
+}
+
+static PyObject *detector_process_display(DetectorObject *self, PyObject *args, PyObject *kwds) {
+    return detector_run(self, args, kwds, PY_PATH_DISPLAY);
+}
+
+static PyObject *detector_process_sdr(DetectorObject *self, PyObject *args, PyObject *kwds) {
+    return detector_run(self, args, kwds, PY_PATH_SDR);
+}
+
+/*============================================================================
+ * Results
+ *============================================================================*/
+
+static PyObject *detector_take_events(DetectorObject *self, PyObject *unused) {
+    if (!detector_ready(self)) return NULL;
+
+    PyObject *ticks = event_array_take(&self->ticks, "tick");
+    PyObject *markers = ticks ? event_array_take(&self->markers, "marker") : NULL;
+    PyObject *syncs = markers ? event_array_take(&self->syncs, "sync") : NULL;
+    if (!syncs) {
+        Py_XDECREF(ticks);
+        Py_XDECREF(markers);
+        return NULL;
+    }
+    uint64_t dropped = self->dropped;
+    self->dropped = 0;
+    return Py_BuildValue("(NNNK)", ticks, markers, syncs, (unsigned long long)dropped);
+}
+
+static PyObject *detector_sync_status(DetectorObject *self, PyObject *unused) {
+    if (!detector_ready(self)) return NULL;
+    wwv_sync_status_t s = wwv_detector_manager_get_sync_status(self->mgr);
+    return Py_BuildValue("{s:O,s:i,s:f,s:i,s:i}",
+                         "is_synced", s.is_synced ? Py_True : Py_False,
+                         "confidence", s.confidence, "drift_ppm", (double)s.drift_ppm,
+                         "tick_count", s.tick_count, "marker_count", s.marker_count);
+}
+
+static PyObject *detector_bcd_time(DetectorObject *self, PyObject *unused) {
+    if (!detector_ready(self)) return NULL;
+    bcd_time_solution_t t;
+    if (!wwv_detector_manager_get_bcd_time(self->mgr, &t)) Py_RETURN_NONE;
+    return Py_BuildValue("{s:i,s:i,s:i,s:i,s:d,s:i,s:f,s:O}",
+                         "year", t.year, "day", t.day, "hour", t.hour, "minute", t.minute,
+                         "minute_start_ms", t.minute_start_ms, "frames_used", t.frames_used,
+                         "margin", (double)t.margin,
+                         "leap_warning", t.leap_warning ? Py_True : Py_False);
+}
+
+static PyObject *detector_config(DetectorObject *self, PyObject *unused) {
+    if (!detector_ready(self)) return NULL;
+    const wwv_detector_config_t *c = &self->config;
+    return Py_BuildValue("{s:N,s:N,s:N,s:N,s:N,s:N,s:N,s:i,s:N,s:N,s:N,s:N,s:N}",
+                         "dual_station", PyBool_FromLong(c->dual_station),
+                         "fast_acquire", PyBool_FromLong(c->fast_acquire),
+                         "tick_economy", PyBool_FromLong(c->tick_economy),
+                         "tone_trackers", PyBool_FromLong(c->enable_tone_trackers),
+                         "correlators", PyBool_FromLong(c->enable_correlators),
+                         "slow_marker", PyBool_FromLong(c->enable_slow_marker),
+                         "bcd", PyBool_FromLong(c->enable_bcd_detectors),
+                         "bcd_integrate_minutes", c->bcd_integrate_minutes,
+                         "baseband_path", PyBool_FromLong(c->baseband_path),
+                         "bcd_freq_sliding", PyBool_FromLong(c->bcd_freq_sliding),
+                         "bcd_adaptive", PyBool_FromLong(c->bcd_adaptive),
+                         "detector_tiling", PyBool_FromLong(c->detector_tiling),
+                         "sdr", PyBool_FromLong(c->enable_sdr_frontend));
+}
+
+static PyObject *detector_set_param(DetectorObject *self, PyObject *args) {
+    const char *name;
+    float value;
+    if (!PyArg_ParseTuple(args, "sf", &name, &value)) return NULL;
+    if (!detector_ready(self)) return NULL;
+    return PyBool_FromLong(wwv_detector_manager_set_param(self->mgr, name, value));
+}
+
+static PyObject *detector_get_param(DetectorObject *self, PyObject *args) {
+    const char *name;
+    if (!PyArg_ParseTuple(args, "s", &name)) return NULL;
+    if (!detector_ready(self)) return NULL;
+    float value;
+    if (!wwv_detector_manager_get_param(self->mgr, name, &value)) Py_RETURN_NONE;
+    return PyFloat_FromDouble(value);
+}
+
+static PyObject *detector_close(DetectorObject *self, PyObject *unused) {
+    if (self->busy) {
+        PyErr_SetString(PyExc_RuntimeError, "Detector is in use by another thread");
+        return NULL;
+    }
+    detector_close_manager(self);
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef detector_methods[] = {
+    { "process", (PyCFunction)(void (*)(void))detector_process, METH_VARARGS | METH_KEYWORDS,
+      "process(samples, sample_format=None) -> int\n"
+      "Feed 50 kHz detector-path I/Q; returns complex samples consumed." },
+    { "process_display", (PyCFunction)(void (*)(void))detector_process_display,
+      METH_VARARGS | METH_KEYWORDS,
+      "process_display(samples, sample_format=None) -> int\n"
+      "Feed 12 kHz display-path I/Q (tone trackers, slow marker)." },
+    { "process_sdr", (PyCFunction)(void (*)(void))detector_process_sdr,
+      METH_VARARGS | METH_KEYWORDS,
+      "process_sdr(samples, sample_format=None) -> int\n"
+      "Feed raw 2 MHz SDR I/Q (Detector(sdr=True))." },
+    { "take_events", (PyCFunction)detector_take_events, METH_NOARGS,
+      "take_events() -> (ticks, markers, syncs, dropped)\n"
+      "Hand over the events collected since the last call as EventArrays." },
+    { "sync_status", (PyCFunction)detector_sync_status, METH_NOARGS,
+      "sync_status() -> dict" },
+    { "bcd_time", (PyCFunction)detector_bcd_time, METH_NOARGS,
+      "bcd_time() -> dict or None\nLatest soft-decision BCD time of day." },
+    { "config", (PyCFunction)detector_config, METH_NOARGS,
+      "config() -> dict\nThe keyword settings the manager was created with." },
+    { "set_param", (PyCFunction)detector_set_param, METH_VARARGS,
+      "set_param(name, value) -> bool\nSet a tunable by its waterfall.ini name." },
+    { "get_param", (PyCFunction)detector_get_param, METH_VARARGS,
+      "get_param(name) -> float or None" },
+    { "close", (PyCFunction)detector_close, METH_NOARGS,
+      "close()\nDestroy the detector manager now instead of at collection." },
+    { NULL }
+};
+
+static PyTypeObject DetectorType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "phoenix_wwv._phoenix_wwv.Detector",
+    .tp_doc = "Detector(*, output_dir=None, dual_station=False, ..., sdr=False)\n"
+              "One wwv_detector_manager; keyword arguments set wwv_detector_config_t.",
+    .tp_basicsize = sizeof(DetectorObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)detector_init,
+    .tp_dealloc = (destructor)detector_dealloc,
+    .tp_methods = detector_methods,
+};
+
+/*============================================================================
+ * Module
+ *============================================================================*/
+
+typedef struct {
+    const char *name;
+    const char *type;               /* numpy type string, native byte order */
+    size_t offset;
+} py_field_t;
+
+#define PY_FIELD(T, m, type) { #m, type, offsetof(T, m) }
+
+static const py_field_t TICK_FIELDS[] = {
+    PY_FIELD(wwv_tick_event_t, tick_number, "=i4"),
+    PY_FIELD(wwv_tick_event_t, station, "=i4"),
+    PY_FIELD(wwv_tick_event_t, timestamp_ms, "=f8"),
+    PY_FIELD(wwv_tick_event_t, sample_index, "=u8"),
+    PY_FIELD(wwv_tick_event_t, epoch_ms, "=f8"),
+    PY_FIELD(wwv_tick_event_t, epoch_refined, "?"),
+    PY_FIELD(wwv_tick_event_t, duration_ms, "=f4"),
+    PY_FIELD(wwv_tick_event_t, energy, "=f4"),
+    { NULL }
+};
+
+static const py_field_t MARKER_FIELDS[] = {
+    PY_FIELD(wwv_marker_event_t, marker_number, "=i4"),
+    PY_FIELD(wwv_marker_event_t, timestamp_ms, "=f8"),
+    PY_FIELD(wwv_marker_event_t, sample_index, "=u8"),
+    PY_FIELD(wwv_marker_event_t, since_last_sec, "=f4"),
+    PY_FIELD(wwv_marker_event_t, duration_ms, "=f4"),
+    PY_FIELD(wwv_marker_event_t, energy, "=f4"),
+    { NULL }
+};
+
+static const py_field_t SYNC_FIELDS[] = {
+    PY_FIELD(wwv_sync_status_t, is_synced, "?"),
+    PY_FIELD(wwv_sync_status_t, confidence, "=i4"),
+    PY_FIELD(wwv_sync_status_t, drift_ppm, "=f4"),
+    PY_FIELD(wwv_sync_status_t, tick_count, "=i4"),
+    PY_FIELD(wwv_sync_status_t, marker_count, "=i4"),
+    { NULL }
+};
+
+static PyObject *module_event_layout(PyObject *module, PyObject *args) {
+    const char *kind;
+    if (!PyArg_ParseTuple(args, "s", &kind)) return NULL;
+
+    const py_field_t *fields;
+    size_t itemsize;
+    if (strcmp(kind, "tick") == 0) {
+        fields = TICK_FIELDS;
+        itemsize = sizeof(wwv_tick_event_t);
+    } else if (strcmp(kind, "marker") == 0) {
+        fields = MARKER_FIELDS;
+        itemsize = sizeof(wwv_marker_event_t);
+    } else if (strcmp(kind, "sync") == 0) {
+        fields = SYNC_FIELDS;
+        itemsize = sizeof(wwv_sync_status_t);
+    } else {
+        PyErr_Format(PyExc_ValueError, "unknown event kind '%s'", kind);
+        return NULL;
+    }
+
+    PyObject *list = PyList_New(0);
+    if (!list) return NULL;
+    for (const py_field_t *f = fields; f->name; f++) {
+        PyObject *item = Py_BuildValue("(ssn)", f->name, f->type, (Py_ssize_t)f->offset);
+        if (!item || PyList_Append(list, item) < 0) {
+            Py_XDECREF(item);
+            Py_DECREF(list);
+            return NULL;
+        }
+        Py_DECREF(item);
+    }
+    return Py_BuildValue("(nN)", (Py_ssize_t)itemsize, list);
+}
+
+static PyMethodDef module_methods[] = {
+    { "event_layout", module_event_layout, METH_VARARGS,
+      "event_layout(kind) -> (itemsize, [(name, numpy_type, offset), ...])\n"
+      "Struct layout of 'tick', 'marker' or 'sync' events." },
+    { NULL }
+};
+
+static struct PyModuleDef phoenix_wwv_module = {
+    PyModuleDef_HEAD_INIT,
+    .m_name = "_phoenix_wwv",
+    .m_doc = "phoenix_wwv detector manager bindings (see the phoenix_wwv package)",
+    .m_size = -1,
+    .m_methods = module_methods,
+};
+
+PyMODINIT_FUNC PyInit__phoenix_wwv(void) {
+    if (PyType_Ready(&EventArrayType) < 0 || PyType_Ready(&DetectorType) < 0) return NULL;
+
+    PyObject *m = PyModule_Create(&phoenix_wwv_module);
+    if (!m) return NULL;
+
+    Py_INCREF(&EventArrayType);
+    Py_INCREF(&DetectorType);
+    if (PyModule_AddObject(m, "EventArray", (PyObject *)&EventArrayType) < 0 ||
+        PyModule_AddObject(m, "Detector", (PyObject *)&DetectorType) < 0 ||
+        PyModule_AddIntConstant(m, "DETECTOR_RATE", PY_DETECTOR_RATE) < 0 ||
+        PyModule_AddIntConstant(m, "DISPLAY_RATE", PY_DISPLAY_RATE) < 0 ||
+        PyModule_AddIntConstant(m, "SDR_RATE", PY_SDR_RATE) < 0) {
+        Py_DECREF(m);
+        return NULL;
+    }
+    return m;
+}
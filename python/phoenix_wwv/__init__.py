@@ -0,0 +1,125 @@
+"""
+phoenix_wwv - Python bindings for the WWV/WWVH detector library.
+
+Samples go to the C detector manager through the buffer protocol without
+a copy (numpy complex64, float32 or int16 I/Q pairs, memoryviews of mapped
+recordings) and are processed with the GIL released, so a thread pool
+runs one Detector per recording on every core:
+
+    import numpy as np
+    import phoenix_wwv
+
+    det = phoenix_wwv.Detector()
+    det.process(iq)                     # complex64, 50 kHz detector path
+    ev = det.events()
+    ev.ticks["timestamp_ms"], ev.markers["duration_ms"]
+
+Events come back as structured numpy arrays viewing the C event structs
+(wwv_tick_event_t, wwv_marker_event_t, wwv_sync_status_t). Without numpy
+the raw layer still works: take_events() returns EventArray buffers and
+event_layout() their fields.
+"""
+
+import mmap
+import struct
+from collections import namedtuple
+
+from ._phoenix_wwv import (Detector as _Detector, EventArray, event_layout,
+                           DETECTOR_RATE, DISPLAY_RATE, SDR_RATE)
+
+try:
+    import numpy as _np
+except ImportError:
+    _np = None
+
+__all__ = ["Detector", "Events", "EventArray", "event_layout", "open_wav",
+           "TICK_DTYPE", "MARKER_DTYPE", "SYNC_DTYPE",
+           "DETECTOR_RATE", "DISPLAY_RATE", "SDR_RATE"]
+
+
+def _dtype(kind):
+    itemsize, fields = event_layout(kind)
+    return _np.dtype({"names": [f[0] for f in fields],
+                      "formats": [f[1] for f in fields],
+                      "offsets": [f[2] for f in fields],
+                      "itemsize": itemsize})
+
+
+TICK_DTYPE = _dtype("tick") if _np else None
+MARKER_DTYPE = _dtype("marker") if _np else None
+SYNC_DTYPE = _dtype("sync") if _np else None
+
+Events = namedtuple("Events", "ticks markers syncs dropped")
+
+
+class Detector(_Detector):
+    """One wwv_detector_manager; keyword arguments set its config.
+
+    Keywords: output_dir (CSV logs, default None), dual_station,
+    fast_acquire, tick_economy, tone_trackers, correlators, slow_marker,
+    bcd, bcd_integrate_minutes, baseband_path, bcd_freq_sliding,
+    bcd_adaptive, detector_tiling, sdr (accept process_sdr()).
+    """
+
+    def events(self):
+        """Events since the last call, as structured numpy arrays (no copy)."""
+        if _np is None:
+            raise ImportError("Detector.events() needs numpy; use take_events()")
+        ticks, markers, syncs, dropped = self.take_events()
+        return Events(_np.frombuffer(ticks, TICK_DTYPE),
+                      _np.frombuffer(markers, MARKER_DTYPE),
+                      _np.frombuffer(syncs, SYNC_DTYPE),
+                      dropped)
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+
+_WAV_FLOAT = 3
+_WAV_PCM = 1
+_WAV_EXTENSIBLE = 0xFFFE
+
+
+def open_wav(path):
+    """Map a 2-channel PCM16 or float32 WAV recording.
+
+    Returns (samples, sample_rate): samples is a memoryview of the data
+    chunk cast to int16 ('h') or float32 ('f') I/Q pairs, ready for
+    process() or process_sdr(). The mapping lives as long as the view.
+    """
+    with open(path, "rb") as f:
+        mm = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+    if mm[0:4] != b"RIFF" or mm[8:12] != b"WAVE":
+        raise ValueError(f"{path}: not a WAV file")
+
+    fmt = None
+    pos = 12
+    while pos + 8 <= len(mm):
+        chunk_id = mm[pos:pos + 4]
+        size = struct.unpack_from("<I", mm, pos + 4)[0]
+        body = pos + 8
+        if chunk_id == b"fmt ":
+            tag, channels, rate, _, _, bits = struct.unpack_from("<HHIIHH", mm, body)
+            if tag == _WAV_EXTENSIBLE and size >= 40:
+                tag = struct.unpack_from("<H", mm, body + 24)[0]
+            fmt = (tag, channels, rate, bits)
+        elif chunk_id == b"data":
+            if fmt is None:
+                raise ValueError(f"{path}: data before fmt chunk")
+            tag, channels, rate, bits = fmt
+            if channels != 2:
+                raise ValueError(f"{path}: {channels} channels, I/Q needs 2")
+            if (tag, bits) == (_WAV_PCM, 16):
+                code = "h"
+            elif (tag, bits) == (_WAV_FLOAT, 32):
+                code = "f"
+            else:
+                raise ValueError(f"{path}: format {tag}/{bits}-bit is not PCM16 or float32")
+            end = min(body + size, len(mm))
+            end -= (end - body) % 4
+            return memoryview(mm)[body:end].cast(code), rate
+        pos = body + size + (size & 1)
+    raise ValueError(f"{path}: no data chunk")
@@ -0,0 +1,91 @@
+"""
+Run WAV recordings through the detectors, one Detector per file.
+
+    python -m phoenix_wwv [--jobs N] [--min-ticks N] [--min-markers N]
+                          [--bcd-integrate-minutes N] FILE.wav ...
+
+Files are mapped and fed without a copy; with --jobs > 1 they run on a
+thread pool, in parallel since the detectors release the GIL. 50 kHz
+recordings feed the detector path, 2 MHz ones the SDR front end. Prints
+one summary line per file and exits 1 if any file falls short of the
+minimum counts.
+"""
+
+import argparse
+import functools
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+from . import Detector, open_wav, DETECTOR_RATE, SDR_RATE
+
+
+def analyze(path, config):
+    samples, rate = open_wav(path)
+    if rate not in (DETECTOR_RATE, SDR_RATE):
+        raise ValueError(f"{path}: {rate} Hz, expected {DETECTOR_RATE} or {SDR_RATE}")
+
+    start = time.perf_counter()
+    with Detector(sdr=(rate == SDR_RATE), **config) as det:
+        applied = det.config()
+        for key, value in config.items():
+            if applied[key] != value:
+                raise ValueError(f"{key}={value} was created as {applied[key]}")
+        if rate == SDR_RATE:
+            count = det.process_sdr(samples)
+        else:
+            count = det.process(samples)
+        ticks, markers, syncs, dropped = det.take_events()
+        status = det.sync_status()
+        bcd = det.bcd_time()
+    elapsed = time.perf_counter() - start
+    samples.release()
+
+    return {
+        "path": path,
+        "seconds": count / rate,
+        "elapsed": elapsed,
+        "ticks": len(ticks),
+        "markers": len(markers),
+        "syncs": len(syncs),
+        "dropped": dropped,
+        "synced": status["is_synced"],
+        "bcd": bcd,
+    }
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(prog="python -m phoenix_wwv", description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("files", nargs="+", metavar="FILE.wav")
+    parser.add_argument("--jobs", type=int, default=1, help="files processed in parallel")
+    parser.add_argument("--min-ticks", type=int, default=0)
+    parser.add_argument("--min-markers", type=int, default=0)
+    parser.add_argument("--bcd-integrate-minutes", type=int, default=None,
+                        help="minutes of BCD envelope averaging (default: manager's)")
+    args = parser.parse_args(argv)
+
+    config = {}
+    if args.bcd_integrate_minutes is not None:
+        config["bcd_integrate_minutes"] = args.bcd_integrate_minutes
+    with ThreadPoolExecutor(max_workers=max(args.jobs, 1)) as pool:
+        results = list(pool.map(functools.partial(analyze, config=config), args.files))
+
+    ok = True
+    for r in results:
+        bcd = r["bcd"]
+        when = (f"day {bcd['day']:03d} {bcd['hour']:02d}:{bcd['minute']:02d}"
+                if bcd else "no BCD time")
+        short = (r["ticks"] < args.min_ticks or r["markers"] < args.min_markers
+                 or r["dropped"])
+        ok = ok and not short
+        print(f"{r['path']}: {r['seconds']:.0f} s in {r['elapsed']:.2f} s "
+              f"({r['seconds'] / r['elapsed']:.0f}x), {r['ticks']} ticks, "
+              f"{r['markers']} markers, {r['syncs']} sync changes, "
+              f"{'synced' if r['synced'] else 'not synced'}, {when}"
+              f"{'  SHORT' if short else ''}", file=sys.stderr)
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,41 @@
+/**
+ * @file dsp_tables.c
+ * @brief Lookup of build-time generated window and template tables
+ *
+ * The tables themselves are generated into the build tree by
+ * tools/gen_dsp_tables.c; the directories are a handful of entries, so
+ * lookups are a linear scan.
+ */
+
+#include "core/dsp_tables.h"
+#include <stddef.h>
+
+const float *dsp_tables_hann(int size) {
+#ifdef WWV_BAKED_TABLES
+    for (int k = 0; k < dsp_baked_hann_count; k++) {
+        if (dsp_baked_hann[k].size == size) return dsp_baked_hann[k].taps;
+    }
+#endif
+    (void)size;
+    return NULL;
+}
+
+const float *dsp_tables_tick_template(int hz, bool quadrature) {
+#ifdef WWV_BAKED_TABLES
+    for (int k = 0; k < dsp_baked_tick_template_count; k++) {
+        const dsp_baked_template_t *t = &dsp_baked_tick_template[k];
+        if (t->hz == hz) return quadrature ? t->taps_q : t->taps_i;
+    }
+#endif
+    (void)hz;
+    (void)quadrature;
+    return NULL;
+}
+
+int dsp_tables_baked_count(void) {
+#ifdef WWV_BAKED_TABLES
+    return dsp_baked_hann_count + 2 * dsp_baked_tick_template_count;
+#else
+    return 0;
+#endif
+}
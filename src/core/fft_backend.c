@@ -0,0 +1,191 @@
+/**
+ * @file fft_backend.c
+ * @brief KissFFT / FFTW3f / pffft implementations of fft_backend.h
+ *
+ * Only one section is compiled; see fft_backend.h for selection flags.
+ * The default build references nothing outside this repository.
+ */
+
+#include "fft_backend.h"
+#include "wwv_arena.h"
+#include <stdlib.h>
+
+/*============================================================================
+ * FFTW3 (single precision)
+ *============================================================================*/
+
+#if defined(WWV_FFT_BACKEND_FFTW)
+
+#include <fftw3.h>
+
+struct fft_backend_plan {
+    int fft_size;
+    fftwf_plan plan;
+};
+
+fft_backend_plan_t *fft_backend_plan_create(int fft_size, size_t *bytes_out) {
+    fft_backend_plan_t *p = (fft_backend_plan_t *)calloc(1, sizeof(*p));
+    if (!p) return NULL;
+
+    /* Planning needs scratch arrays; FFTW_ESTIMATE leaves them untouched.
+     * FFTW_UNALIGNED lets new-array execution use any kiss_fft_cpx buffer. */
+    fftwf_complex *tmp_in = fftwf_alloc_complex(fft_size);
+    fftwf_complex *tmp_out = fftwf_alloc_complex(fft_size);
+    if (tmp_in && tmp_out) {
+        p->plan = fftwf_plan_dft_1d(fft_size, tmp_in, tmp_out, FFTW_FORWARD,
+                                    FFTW_ESTIMATE | FFTW_UNALIGNED);
+    }
+    fftwf_free(tmp_in);
+    fftwf_free(tmp_out);
+
+    if (!p->plan) {
+        free(p);
+        return NULL;
+    }
+
+    p->fft_size = fft_size;
+    /* FFTW does not report plan size; twiddles are roughly one complex per point */
+    if (bytes_out) *bytes_out = sizeof(*p) + fft_size * sizeof(fftwf_complex);
+    return p;
+}
+
+void fft_backend_plan_destroy(fft_backend_plan_t *p) {
+    if (!p) return;
+    fftwf_destroy_plan(p->plan);
+    free(p);
+}
+
+void fft_backend_forward(const fft_backend_plan_t *p, const kiss_fft_cpx *in, kiss_fft_cpx *out) {
+    /* New-array execute is the thread-safe entry point for a shared plan */
+    fftwf_execute_dft(p->plan, (fftwf_complex *)in, (fftwf_complex *)out);
+}
+
+kiss_fft_cpx *fft_backend_alloc(int fft_size) {
+    return (kiss_fft_cpx *)wwv_aligned_alloc(WWV_ARENA_ALIGN, fft_size * sizeof(kiss_fft_cpx));
+}
+
+void fft_backend_free(kiss_fft_cpx *buf) {
+    wwv_aligned_free(buf);
+}
+
+const char *fft_backend_name(void) {
+    return "fftw3f";
+}
+
+/*============================================================================
+ * pffft
+ *============================================================================*/
+
+#elif defined(WWV_FFT_BACKEND_PFFFT)
+
+#include <pffft.h>
+
+struct fft_backend_plan {
+    int fft_size;
+    PFFFT_Setup *setup;
+};
+
+fft_backend_plan_t *fft_backend_plan_create(int fft_size, size_t *bytes_out) {
+    /* pffft complex transforms need N = 16 * 2^a * 3^b * 5^c */
+    fft_backend_plan_t *p = (fft_backend_plan_t *)calloc(1, sizeof(*p));
+    if (!p) return NULL;
+
+    p->setup = pffft_new_setup(fft_size, PFFFT_COMPLEX);
+    if (!p->setup) {
+        free(p);
+        return NULL;
+    }
+
+    p->fft_size = fft_size;
+    if (bytes_out) *bytes_out = sizeof(*p) + 2 * fft_size * sizeof(float);
+    return p;
+}
+
+void fft_backend_plan_destroy(fft_backend_plan_t *p) {
+    if (!p) return;
+    pffft_destroy_setup(p->setup);
+    free(p);
+}
+
+void fft_backend_forward(const fft_backend_plan_t *p, const kiss_fft_cpx *in, kiss_fft_cpx *out) {
+    /* NULL work buffer: pffft uses stack scratch, keeping the shared setup
+     * free of per-call state */
+    pffft_transform_ordered(p->setup, (const float *)in, (float *)out, NULL, PFFFT_FORWARD);
+}
+
+kiss_fft_cpx *fft_backend_alloc(int fft_size) {
+    /* pffft requires SIMD-aligned input and output; a cache line covers it */
+    return (kiss_fft_cpx *)wwv_aligned_alloc(WWV_ARENA_ALIGN, fft_size * sizeof(kiss_fft_cpx));
+}
+
+void fft_backend_free(kiss_fft_cpx *buf) {
+    wwv_aligned_free(buf);
+}
+
+const char *fft_backend_name(void) {
+    return "pffft";
+}
+
+/*============================================================================
+ * KissFFT (default)
+ *============================================================================*/
+
+#else
+
+#include "core/fft_backend_internal.h"
+
+struct fft_backend_plan {
+    int fft_size;
+    kiss_fft_cfg cfg;
+    fft_kiss_simd_t *simd;      /* Vector stages at the plan's SIMD level, NULL = kiss_fft() */
+};
+
+fft_backend_plan_t *fft_backend_plan_create(int fft_size, size_t *bytes_out) {
+    fft_backend_plan_t *p = (fft_backend_plan_t *)calloc(1, sizeof(*p));
+    if (!p) return NULL;
+
+    size_t cfg_bytes = 0;
+    kiss_fft_alloc(fft_size, 0, NULL, &cfg_bytes);
+    p->cfg = kiss_fft_alloc(fft_size, 0, NULL, NULL);
+    if (!p->cfg) {
+        free(p);
+        return NULL;
+    }
+
+    size_t simd_bytes = 0;
+    p->simd = fft_kiss_simd_create(p->cfg, channel_filters_get_simd(), &simd_bytes);
+
+    p->fft_size = fft_size;
+    if (bytes_out) *bytes_out = sizeof(*p) + cfg_bytes + simd_bytes;
+    return p;
+}
+
+void fft_backend_plan_destroy(fft_backend_plan_t *p) {
+    if (!p) return;
+    fft_kiss_simd_destroy(p->simd);
+    free(p->cfg);
+    free(p);
+}
+
+void fft_backend_forward(const fft_backend_plan_t *p, const kiss_fft_cpx *in, kiss_fft_cpx *out) {
+    /* Both only read the plan, so a shared plan is safe across threads */
+    if (p->simd && in != out) {
+        fft_kiss_simd_forward(p->simd, in, out);
+    } else {
+        kiss_fft(p->cfg, in, out);
+    }
+}
+
+kiss_fft_cpx *fft_backend_alloc(int fft_size) {
+    return (kiss_fft_cpx *)wwv_aligned_alloc(WWV_ARENA_ALIGN, fft_size * sizeof(kiss_fft_cpx));
+}
+
+void fft_backend_free(kiss_fft_cpx *buf) {
+    wwv_aligned_free(buf);
+}
+
+const char *fft_backend_name(void) {
+    return "kissfft";
+}
+
+#endif
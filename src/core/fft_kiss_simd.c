@@ -0,0 +1,393 @@
+/**
+ * @file fft_kiss_simd.c
+ * @brief SSE2 / AVX2 / NEON radix-4 and radix-2 stages for KissFFT plans
+ *
+ * kf_work()'s recursion is kept as is; only the butterfly calls change.
+ * A stage with m butterflies at twiddle stride fstride reads
+ * tw[j * k * fstride], which is strided, so each vector stage gets its own
+ * contiguous table, split into real and imaginary parts and duplicated
+ * per complex lane:
+ *
+ *   re: tw_r[0] tw_r[0] tw_r[1] tw_r[1] ...     (2 * m floats)
+ *   im: tw_i[0] tw_i[0] tw_i[1] tw_i[1] ...
+ *
+ * so a complex multiply is two products, a pair swap and a sign flip.
+ * The m = 1 leaves are run by their parent, two leaves per vector; other
+ * stages too short for a vector (m = 2 under AVX2) stay scalar.
+ */
+
+#include "core/fft_backend_internal.h"
+#include "external/_kiss_fft_guts.h"
+#include "wwv_arena.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define KS_HAVE_SSE2 1
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#define KS_HAVE_AVX2 1
+#define KS_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER)
+#define KS_HAVE_AVX2 1
+#define KS_TARGET_AVX2
+#endif
+#elif defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#define KS_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+#define KS_MAX_STAGES   (MAXFACTORS)
+
+/* Vector butterflies over all m of a stage; tw is the stage's table */
+typedef void (*ks_bfly_fn)(kiss_fft_cpx *Fout, const float *tw, int m);
+
+/* A stage's children when they are m = 1 leaves, two per vector: gather the
+ * leaf inputs, run the leaf butterfly (twiddle w = tw[0]) and scatter */
+typedef void (*ks_leaf_fn)(kiss_fft_cpx *Fout, const kiss_fft_cpx *f, size_t child_stride,
+                           size_t leaf_stride, int children, int leaf_p, kiss_fft_cpx w);
+
+typedef struct {
+    int p;
+    int m;
+    size_t fstride;
+    float *tw;                  /* NULL = scalar stage */
+} ks_stage_t;
+
+struct fft_kiss_simd {
+    kiss_fft_cfg cfg;
+    int width;                  /* Complex values per vector */
+    int stage_count;
+    ks_stage_t stage[KS_MAX_STAGES];
+    ks_bfly_fn bfly2;
+    ks_bfly_fn bfly4;
+    ks_leaf_fn leaf;
+};
+
+/*============================================================================
+ * Scalar Stages (kf_bfly2 / kf_bfly4, forward)
+ *============================================================================*/
+
+static void bfly2_scalar(kiss_fft_cpx *Fout, size_t fstride, const kiss_fft_cpx *twiddles, int m) {
+    kiss_fft_cpx *Fout2 = Fout + m;
+    const kiss_fft_cpx *tw1 = twiddles;
+    kiss_fft_cpx t;
+    do {
+        C_MUL(t, *Fout2, *tw1);
+        tw1 += fstride;
+        C_SUB(*Fout2, *Fout, t);
+        C_ADDTO(*Fout, t);
+        ++Fout2;
+        ++Fout;
+    } while (--m);
+}
+
+static void bfly4_scalar(kiss_fft_cpx *Fout, size_t fstride, const kiss_fft_cpx *twiddles, int m) {
+    const kiss_fft_cpx *tw1, *tw2, *tw3;
+    kiss_fft_cpx scratch[6];
+    const int m2 = 2 * m, m3 = 3 * m;
+    int k = m;
+
+    tw3 = tw2 = tw1 = twiddles;
+    do {
+        C_MUL(scratch[0], Fout[m], *tw1);
+        C_MUL(scratch[1], Fout[m2], *tw2);
+        C_MUL(scratch[2], Fout[m3], *tw3);
+
+        C_SUB(scratch[5], *Fout, scratch[1]);
+        C_ADDTO(*Fout, scratch[1]);
+        C_ADD(scratch[3], scratch[0], scratch[2]);
+        C_SUB(scratch[4], scratch[0], scratch[2]);
+        C_SUB(Fout[m2], *Fout, scratch[3]);
+        tw1 += fstride;
+        tw2 += fstride * 2;
+        tw3 += fstride * 3;
+        C_ADDTO(*Fout, scratch[3]);
+
+        Fout[m].r = scratch[5].r + scratch[4].i;
+        Fout[m].i = scratch[5].i - scratch[4].r;
+        Fout[m3].r = scratch[5].r - scratch[4].i;
+        Fout[m3].i = scratch[5].i + scratch[4].r;
+        ++Fout;
+    } while (--k);
+}
+
+/*============================================================================
+ * Vector Stages
+ *
+ * One template for every ISA: VT = vector type, C = complex per vector.
+ * CMUL(a, wr, wi) = a*wr + neg_even(swap(a)*wi) gives
+ *   re: a.r*w.r - a.i*w.i      im: a.i*w.r + a.r*w.i
+ * which is C_MUL() term for term.
+ *============================================================================*/
+
+#define KS_DEFINE_KERNELS(SUF, ATTR, VT, C, LOAD, STORE, MUL, ADD, SUB, SWAP, XOR,  \
+                          NEG_EVEN_MASK, NEG_ODD_MASK)                               \
+ATTR static void bfly2_##SUF(kiss_fft_cpx *Fout, const float *tw, int m) {          \
+    const VT neg_even = NEG_EVEN_MASK;                                               \
+    float *f0 = (float *)Fout, *f1 = (float *)(Fout + m);                            \
+    const float *wr = tw, *wi = tw + 2 * m;                                          \
+    for (int k = 0; k < 2 * m; k += 2 * (C)) {                                       \
+        VT a = LOAD(f1 + k);                                                         \
+        VT t = ADD(MUL(a, LOAD(wr + k)), XOR(MUL(SWAP(a), LOAD(wi + k)), neg_even)); \
+        VT x = LOAD(f0 + k);                                                         \
+        STORE(f1 + k, SUB(x, t));                                                    \
+        STORE(f0 + k, ADD(x, t));                                                    \
+    }                                                                                \
+}                                                                                    \
+ATTR static void bfly4_##SUF(kiss_fft_cpx *Fout, const float *tw, int m) {          \
+    const VT neg_even = NEG_EVEN_MASK;                                               \
+    const VT neg_odd = NEG_ODD_MASK;                                                 \
+    float *f0 = (float *)Fout, *f1 = (float *)(Fout + m);                            \
+    float *f2 = (float *)(Fout + 2 * m), *f3 = (float *)(Fout + 3 * m);              \
+    const float *w1 = tw, *w2 = tw + 4 * m, *w3 = tw + 8 * m;                        \
+    for (int k = 0; k < 2 * m; k += 2 * (C)) {                                       \
+        VT a1 = LOAD(f1 + k), a2 = LOAD(f2 + k), a3 = LOAD(f3 + k);                  \
+        VT s0 = ADD(MUL(a1, LOAD(w1 + k)),                                           \
+                    XOR(MUL(SWAP(a1), LOAD(w1 + 2 * m + k)), neg_even));             \
+        VT s1 = ADD(MUL(a2, LOAD(w2 + k)),                                           \
+                    XOR(MUL(SWAP(a2), LOAD(w2 + 2 * m + k)), neg_even));             \
+        VT s2 = ADD(MUL(a3, LOAD(w3 + k)),                                           \
+                    XOR(MUL(SWAP(a3), LOAD(w3 + 2 * m + k)), neg_even));             \
+        VT x = LOAD(f0 + k);                                                         \
+        VT s5 = SUB(x, s1);                                                          \
+        x = ADD(x, s1);                                                              \
+        VT s3 = ADD(s0, s2);                                                         \
+        VT s4 = SUB(s0, s2);                                                         \
+        STORE(f2 + k, SUB(x, s3));                                                   \
+        STORE(f0 + k, ADD(x, s3));                                                   \
+        VT r4 = XOR(SWAP(s4), neg_odd);     /* (s4.i, -s4.r) */                      \
+        STORE(f1 + k, ADD(s5, r4));                                                  \
+        STORE(f3 + k, SUB(s5, r4));                                                  \
+    }                                                                                \
+}
+
+/*
+ * Leaves: lane pair c holds children c and c + 1. Loads and stores are
+ * half vectors (one complex each); the arithmetic is the stage kernels'.
+ */
+#define KS_DEFINE_LEAF(SUF, VT, LOAD_PAIR, STORE_LO, STORE_HI, SET1, MUL, ADD, SUB,   \
+                       SWAP, XOR, NEG_EVEN_MASK, NEG_ODD_MASK)                         \
+static void leaf_##SUF(kiss_fft_cpx *Fout, const kiss_fft_cpx *f, size_t child_stride,  \
+                       size_t leaf_stride, int children, int leaf_p, kiss_fft_cpx w) {  \
+    const VT neg_even = NEG_EVEN_MASK;                                               \
+    const VT neg_odd = NEG_ODD_MASK;                                                 \
+    const VT wr = SET1(w.r), wi = SET1(w.i);                                         \
+    for (int c = 0; c < children; c += 2) {                                          \
+        const kiss_fft_cpx *a = f + (size_t)c * child_stride;                        \
+        const kiss_fft_cpx *b = a + child_stride;                                    \
+        kiss_fft_cpx *oa = Fout + (size_t)c * leaf_p, *ob = oa + leaf_p;             \
+        VT x = LOAD_PAIR(a, b);                                                      \
+        if (leaf_p == 2) {                                                           \
+            VT a1 = LOAD_PAIR(a + leaf_stride, b + leaf_stride);                     \
+            VT t = ADD(MUL(a1, wr), XOR(MUL(SWAP(a1), wi), neg_even));               \
+            VT o1 = SUB(x, t), o0 = ADD(x, t);                                       \
+            STORE_LO(oa, o0); STORE_HI(ob, o0);                                      \
+            STORE_LO(oa + 1, o1); STORE_HI(ob + 1, o1);                              \
+            continue;                                                                \
+        }                                                                            \
+        VT a1 = LOAD_PAIR(a + leaf_stride, b + leaf_stride);                         \
+        VT a2 = LOAD_PAIR(a + 2 * leaf_stride, b + 2 * leaf_stride);                 \
+        VT a3 = LOAD_PAIR(a + 3 * leaf_stride, b + 3 * leaf_stride);                 \
+        VT s0 = ADD(MUL(a1, wr), XOR(MUL(SWAP(a1), wi), neg_even));                  \
+        VT s1 = ADD(MUL(a2, wr), XOR(MUL(SWAP(a2), wi), neg_even));                  \
+        VT s2 = ADD(MUL(a3, wr), XOR(MUL(SWAP(a3), wi), neg_even));                  \
+        VT s5 = SUB(x, s1);                                                          \
+        x = ADD(x, s1);                                                              \
+        VT s3 = ADD(s0, s2);                                                         \
+        VT s4 = SUB(s0, s2);                                                         \
+        VT o2 = SUB(x, s3), o0 = ADD(x, s3);                                         \
+        VT r4 = XOR(SWAP(s4), neg_odd);                                              \
+        VT o1 = ADD(s5, r4), o3 = SUB(s5, r4);                                       \
+        STORE_LO(oa, o0); STORE_HI(ob, o0);                                          \
+        STORE_LO(oa + 1, o1); STORE_HI(ob + 1, o1);                                  \
+        STORE_LO(oa + 2, o2); STORE_HI(ob + 2, o2);                                  \
+        STORE_LO(oa + 3, o3); STORE_HI(ob + 3, o3);                                  \
+    }                                                                                \
+}
+
+#ifdef KS_HAVE_SSE2
+#define KS_SSE2_SWAP(v)     _mm_shuffle_ps((v), (v), _MM_SHUFFLE(2, 3, 0, 1))
+#define KS_SSE2_EVEN        _mm_castsi128_ps(_mm_set_epi32(0, INT32_MIN, 0, INT32_MIN))
+#define KS_SSE2_ODD         _mm_castsi128_ps(_mm_set_epi32(INT32_MIN, 0, INT32_MIN, 0))
+KS_DEFINE_KERNELS(sse2, , __m128, 2, _mm_loadu_ps, _mm_storeu_ps, _mm_mul_ps, _mm_add_ps,
+                  _mm_sub_ps, KS_SSE2_SWAP, _mm_xor_ps, KS_SSE2_EVEN, KS_SSE2_ODD)
+#define KS_SSE2_LOAD_PAIR(a, b) \
+    _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)(a)), (const __m64 *)(b))
+#define KS_SSE2_STORE_LO(p, v)  _mm_storel_pi((__m64 *)(p), (v))
+#define KS_SSE2_STORE_HI(p, v)  _mm_storeh_pi((__m64 *)(p), (v))
+KS_DEFINE_LEAF(sse2, __m128, KS_SSE2_LOAD_PAIR, KS_SSE2_STORE_LO, KS_SSE2_STORE_HI, _mm_set1_ps,
+               _mm_mul_ps, _mm_add_ps, _mm_sub_ps, KS_SSE2_SWAP, _mm_xor_ps,
+               KS_SSE2_EVEN, KS_SSE2_ODD)
+#endif
+
+#ifdef KS_HAVE_AVX2
+#define KS_AVX2_SWAP(v)     _mm256_permute_ps((v), 0xB1)
+#define KS_AVX2_EVEN        _mm256_castsi256_ps(_mm256_set_epi32(0, INT32_MIN, 0, INT32_MIN, \
+                                                                 0, INT32_MIN, 0, INT32_MIN))
+#define KS_AVX2_ODD         _mm256_castsi256_ps(_mm256_set_epi32(INT32_MIN, 0, INT32_MIN, 0, \
+                                                                 INT32_MIN, 0, INT32_MIN, 0))
+KS_DEFINE_KERNELS(avx2, KS_TARGET_AVX2, __m256, 4, _mm256_loadu_ps, _mm256_storeu_ps,
+                  _mm256_mul_ps, _mm256_add_ps, _mm256_sub_ps, KS_AVX2_SWAP, _mm256_xor_ps,
+                  KS_AVX2_EVEN, KS_AVX2_ODD)
+#endif
+
+#ifdef KS_HAVE_NEON
+static inline float32x4_t ks_neon_xor(float32x4_t v, float32x4_t mask) {
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(v), vreinterpretq_u32_f32(mask)));
+}
+static inline float32x4_t ks_neon_mask(uint32_t lo, uint32_t hi) {
+    const uint32_t m[4] = { lo, hi, lo, hi };
+    return vreinterpretq_f32_u32(vld1q_u32(m));
+}
+KS_DEFINE_KERNELS(neon, , float32x4_t, 2, vld1q_f32, vst1q_f32, vmulq_f32, vaddq_f32,
+                  vsubq_f32, vrev64q_f32, ks_neon_xor,
+                  ks_neon_mask(0x80000000u, 0), ks_neon_mask(0, 0x80000000u))
+#define KS_NEON_LOAD_PAIR(a, b) \
+    vcombine_f32(vld1_f32((const float *)(a)), vld1_f32((const float *)(b)))
+#define KS_NEON_STORE_LO(p, v)  vst1_f32((float *)(p), vget_low_f32(v))
+#define KS_NEON_STORE_HI(p, v)  vst1_f32((float *)(p), vget_high_f32(v))
+KS_DEFINE_LEAF(neon, float32x4_t, KS_NEON_LOAD_PAIR, KS_NEON_STORE_LO, KS_NEON_STORE_HI,
+               vdupq_n_f32, vmulq_f32, vaddq_f32, vsubq_f32, vrev64q_f32, ks_neon_xor,
+               ks_neon_mask(0x80000000u, 0), ks_neon_mask(0, 0x80000000u))
+#endif
+
+static bool select_kernels(fft_kiss_simd_t *s, channel_simd_t level) {
+    switch (level) {
+#ifdef KS_HAVE_AVX2
+        case CHANNEL_SIMD_AVX2:
+            /* Leaves gather one complex per lane; 128-bit pairs are as good */
+            s->width = 4; s->bfly2 = bfly2_avx2; s->bfly4 = bfly4_avx2; s->leaf = leaf_sse2;
+            return true;
+#endif
+#ifdef KS_HAVE_SSE2
+        case CHANNEL_SIMD_SSE2:
+            s->width = 2; s->bfly2 = bfly2_sse2; s->bfly4 = bfly4_sse2; s->leaf = leaf_sse2;
+            return true;
+#endif
+#ifdef KS_HAVE_NEON
+        case CHANNEL_SIMD_NEON:
+            s->width = 2; s->bfly2 = bfly2_neon; s->bfly4 = bfly4_neon; s->leaf = leaf_neon;
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+/*============================================================================
+ * Recursion (kf_work, in_stride 1)
+ *============================================================================*/
+
+static void work(const fft_kiss_simd_t *s, int depth, kiss_fft_cpx *Fout, const kiss_fft_cpx *f) {
+    const ks_stage_t *st = &s->stage[depth];
+    const kiss_fft_cpx *twiddles = s->cfg->twiddles;
+    kiss_fft_cpx *Fout_beg = Fout;
+    kiss_fft_cpx *Fout_end = Fout + st->p * st->m;
+
+    if (st->m == 1) {
+        do {
+            *Fout = *f;
+            f += st->fstride;
+        } while (++Fout != Fout_end);
+    } else if (s->stage[depth + 1].m == 1) {
+        const ks_stage_t *leaf = &s->stage[depth + 1];
+        s->leaf(Fout, f, st->fstride, leaf->fstride, st->p, leaf->p, twiddles[0]);
+    } else {
+        do {
+            work(s, depth + 1, Fout, f);
+            f += st->fstride;
+        } while ((Fout += st->m) != Fout_end);
+    }
+
+    Fout = Fout_beg;
+    if (st->p == 4) {
+        if (st->tw) s->bfly4(Fout, st->tw, st->m);
+        else bfly4_scalar(Fout, st->fstride, twiddles, st->m);
+    } else {
+        if (st->tw) s->bfly2(Fout, st->tw, st->m);
+        else bfly2_scalar(Fout, st->fstride, twiddles, st->m);
+    }
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+/* Duplicated re / im table of tw[j * k * fstride], k = 0..m-1 */
+static void fill_twiddles(float *out, const kiss_fft_cpx *twiddles, size_t step, int m) {
+    float *re = out, *im = out + 2 * m;
+    for (int k = 0; k < m; k++) {
+        kiss_fft_cpx w = twiddles[step * k];
+        re[2 * k] = re[2 * k + 1] = w.r;
+        im[2 * k] = im[2 * k + 1] = w.i;
+    }
+}
+
+fft_kiss_simd_t *fft_kiss_simd_create(kiss_fft_cfg cfg, channel_simd_t level, size_t *bytes_out) {
+    if (!cfg || cfg->inverse) return NULL;
+
+    fft_kiss_simd_t *s = (fft_kiss_simd_t *)calloc(1, sizeof(*s));
+    if (!s) return NULL;
+    if (!select_kernels(s, level)) {
+        free(s);
+        return NULL;
+    }
+    s->cfg = cfg;
+
+    size_t bytes = sizeof(*s);
+    size_t fstride = 1;
+    const int *factors = cfg->factors;
+    do {
+        int p = factors[0], m = factors[1];
+        if ((p != 2 && p != 4) || s->stage_count == KS_MAX_STAGES) {
+            fft_kiss_simd_destroy(s);
+            return NULL;
+        }
+        ks_stage_t *st = &s->stage[s->stage_count++];
+        st->p = p;
+        st->m = m;
+        st->fstride = fstride;
+
+        if (m % s->width == 0) {
+            size_t floats = (size_t)(p - 1) * 4 * m;
+            st->tw = (float *)wwv_aligned_alloc(WWV_ARENA_ALIGN, floats * sizeof(float));
+            if (!st->tw) {
+                fft_kiss_simd_destroy(s);
+                return NULL;
+            }
+            for (int j = 1; j < p; j++) {
+                fill_twiddles(st->tw + (size_t)(j - 1) * 4 * m, cfg->twiddles, fstride * j, m);
+            }
+            bytes += floats * sizeof(float);
+        }
+        fstride *= p;
+        factors += 2;
+    } while (factors[-1] > 1);
+
+    if (bytes_out) *bytes_out = bytes;
+    return s;
+}
+
+void fft_kiss_simd_destroy(fft_kiss_simd_t *s) {
+    if (!s) return;
+    for (int k = 0; k < s->stage_count; k++) {
+        wwv_aligned_free(s->stage[k].tw);
+    }
+    free(s);
+}
+
+void fft_kiss_simd_forward(const fft_kiss_simd_t *s, const kiss_fft_cpx *in, kiss_fft_cpx *out) {
+    work(s, 0, out, in);
+}
+
+int fft_kiss_simd_vector_stages(const fft_kiss_simd_t *s, int *total) {
+    int n = 0;
+    for (int k = 0; s && k < s->stage_count; k++) {
+        if (s->stage[k].tw || s->stage[k].m == 1) n++;
+    }
+    if (total) *total = s ? s->stage_count : 0;
+    return n;
+}
@@ -0,0 +1,176 @@
+/**
+ * @file fft_plan_cache.c
+ * @brief Refcounted process-wide FFT plan/window cache
+ *
+ * Entries live on a short singly linked list keyed on (size, window).
+ * A process only ever holds a handful of keys (256, 2048, 4096 with Hann),
+ * so a linear search under the lock is cheaper than anything fancier.
+ */
+
+#include "fft_plan_cache.h"
+#include "fft_backend.h"
+#include "core/dsp_tables.h"
+#include "wwv_thread.h"
+#include <stdlib.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+struct fft_plan {
+    int fft_size;
+    fft_window_t window;
+    int refcount;
+    fft_backend_plan_t *backend;
+    const float *window_func;   /* == window_owned, or a baked table */
+    float *window_owned;
+    size_t bytes;
+    struct fft_plan *next;
+};
+
+static wwv_mutex_t g_cache_lock = WWV_MUTEX_INITIALIZER;
+static struct fft_plan *g_plans = NULL;
+static int g_hits = 0;
+static int g_misses = 0;
+
+/*============================================================================
+ * Window Generation
+ *============================================================================*/
+
+static void generate_window(float *w, int size, fft_window_t type) {
+    double denom = size > 1 ? (double)(size - 1) : 1.0;
+
+    for (int i = 0; i < size; i++) {
+        double x = 2.0 * M_PI * i / denom;
+        switch (type) {
+            case FFT_WINDOW_RECTANGULAR:
+                w[i] = 1.0f;
+                break;
+            case FFT_WINDOW_BLACKMAN:
+                w[i] = (float)(0.42 - 0.5 * cos(x) + 0.08 * cos(2.0 * x));
+                break;
+            case FFT_WINDOW_HANN:
+            default:
+                /* Same expression the detectors always used, so thresholds
+                 * tuned against it are unaffected */
+                w[i] = dsp_hann_coeff(i, size);
+                break;
+        }
+    }
+}
+
+/*============================================================================
+ * Cache
+ *============================================================================*/
+
+static struct fft_plan *plan_build(int fft_size, fft_window_t window) {
+    struct fft_plan *plan = (struct fft_plan *)calloc(1, sizeof(*plan));
+    if (!plan) return NULL;
+
+    size_t backend_bytes = 0;
+
+    plan->fft_size = fft_size;
+    plan->window = window;
+    plan->backend = fft_backend_plan_create(fft_size, &backend_bytes);
+    if (!plan->backend) {
+        free(plan);
+        return NULL;
+    }
+
+    /* Standard Hann sizes are baked read-only tables */
+    plan->window_func = (window == FFT_WINDOW_HANN) ? dsp_tables_hann(fft_size) : NULL;
+    if (!plan->window_func) {
+        plan->window_owned = (float *)malloc(fft_size * sizeof(float));
+        if (!plan->window_owned) {
+            fft_backend_plan_destroy(plan->backend);
+            free(plan);
+            return NULL;
+        }
+        generate_window(plan->window_owned, fft_size, window);
+        plan->window_func = plan->window_owned;
+    }
+
+    plan->bytes = backend_bytes + (plan->window_owned ? fft_size * sizeof(float) : 0) + sizeof(*plan);
+    return plan;
+}
+
+const fft_plan_t *fft_plan_acquire(int fft_size, fft_window_t window) {
+    if (fft_size <= 0) return NULL;
+
+    wwv_mutex_lock(&g_cache_lock);
+
+    struct fft_plan *plan = g_plans;
+    while (plan && (plan->fft_size != fft_size || plan->window != window)) {
+        plan = plan->next;
+    }
+
+    if (plan) {
+        plan->refcount++;
+        g_hits++;
+    } else {
+        plan = plan_build(fft_size, window);
+        if (plan) {
+            plan->refcount = 1;
+            plan->next = g_plans;
+            g_plans = plan;
+            g_misses++;
+        }
+    }
+
+    wwv_mutex_unlock(&g_cache_lock);
+    return plan;
+}
+
+void fft_plan_release(const fft_plan_t *handle) {
+    if (!handle) return;
+    struct fft_plan *plan = (struct fft_plan *)handle;
+
+    wwv_mutex_lock(&g_cache_lock);
+    if (--plan->refcount == 0) {
+        struct fft_plan **link = &g_plans;
+        while (*link && *link != plan) link = &(*link)->next;
+        if (*link) *link = plan->next;
+        fft_backend_plan_destroy(plan->backend);
+        free(plan->window_owned);
+        free(plan);
+    }
+    wwv_mutex_unlock(&g_cache_lock);
+}
+
+/*============================================================================
+ * Accessors
+ *============================================================================*/
+
+const fft_backend_plan_t *fft_plan_get_backend(const fft_plan_t *plan) {
+    return plan ? plan->backend : NULL;
+}
+
+const float *fft_plan_get_window(const fft_plan_t *plan) {
+    return plan ? plan->window_func : NULL;
+}
+
+int fft_plan_get_size(const fft_plan_t *plan) {
+    return plan ? plan->fft_size : 0;
+}
+
+fft_window_t fft_plan_get_window_type(const fft_plan_t *plan) {
+    return plan ? plan->window : FFT_WINDOW_HANN;
+}
+
+void fft_plan_cache_get_stats(fft_plan_cache_stats_t *stats) {
+    if (!stats) return;
+
+    wwv_mutex_lock(&g_cache_lock);
+    stats->plans = 0;
+    stats->references = 0;
+    stats->bytes = 0;
+    for (struct fft_plan *p = g_plans; p; p = p->next) {
+        stats->plans++;
+        stats->references += p->refcount;
+        stats->bytes += p->bytes;
+    }
+    stats->hits = g_hits;
+    stats->misses = g_misses;
+    wwv_mutex_unlock(&g_cache_lock);
+}
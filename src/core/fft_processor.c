@@ -1,17 +1,27 @@
 /**
  * @file fft_processor.c
  * @brief Unified FFT processing implementation
+ *
+ * FFT backend plans and windows come from fft_plan_cache, shared by every
+ * processor with the same (size, window). Only the input/output work
+ * buffers are per instance, which keeps shared plans safe to use from
+ * several threads at once.
  */
 
 #include "fft_processor.h"
-#include "external/kiss_fft.h"
+#include "fft_plan_cache.h"
+#include "fft_backend.h"
+#include "wwv_arena.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
+/* Registered band: bin ranges precomputed at registration */
+typedef struct {
+    int pos_first, pos_last;    /* Positive-frequency bins (inclusive, empty if first > last) */
+    int neg_first, neg_last;    /* Negative-frequency bins */
+    fft_band_mode_t mode;
+} fft_band_t;
 
 struct fft_processor {
     /* FFT configuration */
@@ -20,72 +30,97 @@ struct fft_processor {
     float hz_per_bin;
 
     /* FFT resources */
-    kiss_fft_cfg fft_cfg;
+    const fft_plan_t *plan;     /* Shared plan + window (fft_plan_cache) */
+    const fft_backend_plan_t *backend;  /* == fft_plan_get_backend(plan) */
     kiss_fft_cpx *fft_in;
     kiss_fft_cpx *fft_out;
-    float *window_func;
+    const float *window_func;   /* == fft_plan_get_window(plan) */
+
+    /* Band-limited queries */
+    fft_band_t bands[FFT_PROCESSOR_MAX_BANDS];
+    int band_count;
+    float inv_size;
+    float inv_size_sq;
 };
 
 /*============================================================================
  * Private Functions
  *============================================================================*/
 
-/**
- * Generate Hann window
- */
-static void generate_hann_window(float *window, int size) {
-    for (int i = 0; i < size; i++) {
-        window[i] = 0.5f * (1.0f - cosf(2.0f * M_PI * i / (size - 1)));
+/* Clip [first, last] to valid bins (range is empty if first > last) */
+static void clip_range(int *first, int *last, int size) {
+    if (*first < 0) *first = 0;
+    if (*last > size - 1) *last = size - 1;
+}
+
+static float sum_magnitude(const kiss_fft_cpx *out, int first, int last) {
+    float sum = 0.0f;
+    for (int k = first; k <= last; k++) {
+        sum += sqrtf(out[k].r * out[k].r + out[k].i * out[k].i);
     }
+    return sum;
 }
 
+static float sum_power(const kiss_fft_cpx *out, int first, int last) {
+    float sum = 0.0f;
+    for (int k = first; k <= last; k++) {
+        sum += out[k].r * out[k].r + out[k].i * out[k].i;
+    }
+    return sum;
+}
+
+
 /*============================================================================
  * Public API
  *============================================================================*/
 
 fft_processor_t *fft_processor_create(int fft_size, float sample_rate) {
+    return fft_processor_create_windowed(fft_size, sample_rate, FFT_WINDOW_HANN);
+}
+
+fft_processor_t *fft_processor_create_windowed(int fft_size, float sample_rate, fft_window_t window) {
     if (fft_size <= 0 || sample_rate <= 0.0f) {
         return NULL;
     }
 
-    fft_processor_t *fft = (fft_processor_t *)calloc(1, sizeof(fft_processor_t));
+    fft_processor_t *fft = (fft_processor_t *)wwv_calloc(1, sizeof(fft_processor_t));
     if (!fft) return NULL;
 
     fft->fft_size = fft_size;
     fft->sample_rate = sample_rate;
     fft->hz_per_bin = sample_rate / fft_size;
+    fft->inv_size = 1.0f / fft_size;
+    fft->inv_size_sq = fft->inv_size * fft->inv_size;
 
-    /* Allocate FFT resources */
-    fft->fft_cfg = kiss_fft_alloc(fft_size, 0, NULL, NULL);
-    if (!fft->fft_cfg) {
-        free(fft);
+    /* Shared plan and window */
+    fft->plan = fft_plan_acquire(fft_size, window);
+    if (!fft->plan) {
+        wwv_free(fft);
         return NULL;
     }
+    fft->backend = fft_plan_get_backend(fft->plan);
+    fft->window_func = fft_plan_get_window(fft->plan);
 
-    fft->fft_in = (kiss_fft_cpx *)malloc(fft_size * sizeof(kiss_fft_cpx));
-    fft->fft_out = (kiss_fft_cpx *)malloc(fft_size * sizeof(kiss_fft_cpx));
-    fft->window_func = (float *)malloc(fft_size * sizeof(float));
+    /* Per-instance work buffers */
+    fft->fft_in = fft_backend_alloc(fft_size);
+    fft->fft_out = fft_backend_alloc(fft_size);
 
-    if (!fft->fft_in || !fft->fft_out || !fft->window_func) {
+    if (!fft->fft_in || !fft->fft_out) {
         fft_processor_destroy(fft);
         return NULL;
     }
 
-    /* Generate window function */
-    generate_hann_window(fft->window_func, fft_size);
-
     return fft;
 }
 
 void fft_processor_destroy(fft_processor_t *fft) {
     if (!fft) return;
 
-    if (fft->fft_cfg) free(fft->fft_cfg);
-    if (fft->fft_in) free(fft->fft_in);
-    if (fft->fft_out) free(fft->fft_out);
-    if (fft->window_func) free(fft->window_func);
+    fft_plan_release(fft->plan);
+    if (fft->fft_in) fft_backend_free(fft->fft_in);
+    if (fft->fft_out) fft_backend_free(fft->fft_out);
 
-    free(fft);
+    wwv_free(fft);
 }
 
 bool fft_processor_process(fft_processor_t *fft, const float *i_samples, const float *q_samples) {
@@ -100,11 +135,64 @@ bool fft_processor_process(fft_processor_t *fft, const float *i_samples, const f
     }
 
     /* Run FFT */
-    kiss_fft(fft->fft_cfg, fft->fft_in, fft->fft_out);
+    fft_backend_forward(fft->backend, fft->fft_in, fft->fft_out);
 
     return true;
 }
 
+int fft_processor_add_band(fft_processor_t *fft, float target_freq, float bandwidth,
+                           fft_band_mode_t mode) {
+    if (!fft || fft->band_count >= FFT_PROCESSOR_MAX_BANDS) return -1;
+
+    int center_bin = (int)(target_freq / fft->hz_per_bin + 0.5f);
+    int bin_span = (int)(bandwidth / fft->hz_per_bin + 0.5f);
+    if (bin_span < 1) bin_span = 1;
+
+    fft_band_t *band = &fft->bands[fft->band_count];
+    band->pos_first = center_bin - bin_span;
+    band->pos_last = center_bin + bin_span;
+    band->neg_first = fft->fft_size - center_bin - bin_span;
+    band->neg_last = fft->fft_size - center_bin + bin_span;
+    clip_range(&band->pos_first, &band->pos_last, fft->fft_size);
+    clip_range(&band->neg_first, &band->neg_last, fft->fft_size);
+    band->mode = mode;
+
+    return fft->band_count++;
+}
+
+int fft_processor_add_bins(fft_processor_t *fft, int first_bin, int last_bin,
+                           fft_band_mode_t mode) {
+    if (!fft || fft->band_count >= FFT_PROCESSOR_MAX_BANDS) return -1;
+    if (first_bin > last_bin || first_bin < -fft->fft_size / 2 || last_bin >= fft->fft_size / 2) {
+        return -1;
+    }
+
+    /* Non-negative part in the positive range, the rest wrapped to the top */
+    fft_band_t *band = &fft->bands[fft->band_count];
+    band->pos_first = (first_bin > 0) ? first_bin : 0;
+    band->pos_last = last_bin;
+    band->neg_first = fft->fft_size + first_bin;
+    band->neg_last = fft->fft_size + ((last_bin < 0) ? last_bin : -1);
+    band->mode = mode;
+
+    return fft->band_count++;
+}
+
+float fft_processor_get_band(fft_processor_t *fft, int band_id) {
+    if (!fft || band_id < 0 || band_id >= fft->band_count) return 0.0f;
+
+    const fft_band_t *band = &fft->bands[band_id];
+    if (band->mode == FFT_BAND_POWER) {
+        float pos = sum_power(fft->fft_out, band->pos_first, band->pos_last);
+        float neg = sum_power(fft->fft_out, band->neg_first, band->neg_last);
+        return (pos + neg) * fft->inv_size_sq;
+    }
+
+    float pos = sum_magnitude(fft->fft_out, band->pos_first, band->pos_last);
+    float neg = sum_magnitude(fft->fft_out, band->neg_first, band->neg_last);
+    return (pos + neg) * fft->inv_size;
+}
+
 float fft_processor_get_bucket_energy(fft_processor_t *fft, float target_freq, float bandwidth) {
     if (!fft) return 0.0f;
 
@@ -112,27 +200,16 @@ float fft_processor_get_bucket_energy(fft_processor_t *fft, float target_freq, f
     int bin_span = (int)(bandwidth / fft->hz_per_bin + 0.5f);
     if (bin_span < 1) bin_span = 1;
 
-    float pos_energy = 0.0f;
-    float neg_energy = 0.0f;
+    int pos_first = center_bin - bin_span, pos_last = center_bin + bin_span;
+    int neg_first = fft->fft_size - center_bin - bin_span, neg_last = fft->fft_size - center_bin + bin_span;
+    clip_range(&pos_first, &pos_last, fft->fft_size);
+    clip_range(&neg_first, &neg_last, fft->fft_size);
 
     /* Sum energy across positive and negative frequency bins */
-    for (int b = -bin_span; b <= bin_span; b++) {
-        int pos_bin = center_bin + b;
-        int neg_bin = fft->fft_size - center_bin + b;
-
-        if (pos_bin >= 0 && pos_bin < fft->fft_size) {
-            float re = fft->fft_out[pos_bin].r;
-            float im = fft->fft_out[pos_bin].i;
-            pos_energy += sqrtf(re * re + im * im) / fft->fft_size;
-        }
-        if (neg_bin >= 0 && neg_bin < fft->fft_size) {
-            float re = fft->fft_out[neg_bin].r;
-            float im = fft->fft_out[neg_bin].i;
-            neg_energy += sqrtf(re * re + im * im) / fft->fft_size;
-        }
-    }
+    float pos_energy = sum_magnitude(fft->fft_out, pos_first, pos_last);
+    float neg_energy = sum_magnitude(fft->fft_out, neg_first, neg_last);
 
-    return pos_energy + neg_energy;
+    return (pos_energy + neg_energy) * fft->inv_size;
 }
 
 float fft_processor_get_hz_per_bin(fft_processor_t *fft) {
@@ -152,3 +229,13 @@ void fft_processor_get_magnitudes(fft_processor_t *fft, float *magnitudes) {
         magnitudes[i] = sqrtf(re * re + im * im);
     }
 }
+
+void fft_processor_get_power(fft_processor_t *fft, float *power) {
+    if (!fft || !power) return;
+
+    for (int i = 0; i < fft->fft_size; i++) {
+        float re = fft->fft_out[i].r;
+        float im = fft->fft_out[i].i;
+        power[i] = re * re + im * im;
+    }
+}
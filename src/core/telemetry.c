@@ -4,12 +4,24 @@
  *
  * Non-blocking UDP broadcast for remote monitoring.
  * Uses broadcast address for zero-configuration discovery.
+ *
+ * Each telem_ctx_t owns its socket, channel mask, binary frame, console
+ * buffer and counters, so several managers can publish to different
+ * receivers from different threads. The telem_* wrappers in
+ * telemetry_default.c use a statically allocated default context.
+ *
+ * Producers format a telem_msg_t and either deliver it on the calling
+ * thread or, once a sender is running, hand it to the sender thread
+ * (telemetry_sender.c) so a full socket buffer never stalls them.
  */
 
-#include "telemetry.h"
+#include "core/telemetry_internal.h"
+#include "wwv_arena.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <time.h>
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -31,25 +43,44 @@ typedef int socket_t;
 #endif
 
 /*============================================================================
- * Module State
- *============================================================================*/
-
-static socket_t g_sock = SOCKET_INVALID;
-static struct sockaddr_in g_broadcast_addr;
-static uint32_t g_enabled_channels = TELEM_NONE;
-static uint32_t g_stats_sent = 0;
-static uint32_t g_stats_dropped = 0;
-static bool g_initialized = false;
-
-/*============================================================================
- * Console Buffer (for hot-path performance)
+ * Context
  *============================================================================*/
 
 #define CONSOLE_BUFFER_SIZE 8192
 
-static char g_console_buffer[CONSOLE_BUFFER_SIZE];
-static int g_console_buffer_len = 0;
-static uint32_t g_console_dropped = 0;
+struct telem_ctx {
+    socket_t sock;
+    struct sockaddr_in dest_addr;
+    atomic_uint enabled_channels;
+    atomic_int format;                  /* telem_format_t */
+    bool initialized;
+
+    /* Binary frame (coalesces records up to TELEM_WIRE_MTU) */
+    wwv_mutex_t frame_lock;
+    telem_wire_frame_t frame;
+    bool frame_ready;
+    uint32_t frame_sequence;
+    uint32_t frame_pending[TELEM_CHANNEL_SLOTS];    /* Records per channel in frame */
+
+    /* Per-channel statistics (updated from producers and the sender thread) */
+    _Atomic uint32_t stats_sent[TELEM_CHANNEL_SLOTS];
+    _Atomic uint32_t stats_dropped[TELEM_CHANNEL_SLOTS];
+
+    /* Console buffer (for hot-path performance) */
+    wwv_mutex_t console_lock;
+    char console_buffer[CONSOLE_BUFFER_SIZE];
+    int console_buffer_len;
+    uint32_t console_dropped;
+
+    telem_sender_t sender;
+};
+
+static telem_ctx_t g_default_ctx = {
+    .sock = SOCKET_INVALID,
+    .frame_lock = WWV_MUTEX_INITIALIZER,
+    .console_lock = WWV_MUTEX_INITIALIZER,
+    .sender = { .lock = WWV_MUTEX_INITIALIZER, .config = TELEM_SENDER_CONFIG_DEFAULT }
+};
 
 /*============================================================================
  * Channel Prefixes
@@ -71,13 +102,14 @@ static const char *g_channel_prefixes[] = {
     "CONS",  /* TELEM_CONSOLE (console messages) */
     "CTRL",  /* TELEM_CTRL (control commands) */
     "RESP",  /* TELEM_RESP (command responses) */
+    "PERF",  /* TELEM_PERF (stage timing) */
 };
 
 /*============================================================================
  * Internal Helpers
  *============================================================================*/
 
-static int get_channel_index(telem_channel_t channel) {
+int telem_channel_index(telem_channel_t channel) {
     switch (channel) {
         case TELEM_CHANNEL: return 1;
         case TELEM_TICKS:   return 2;
@@ -93,25 +125,128 @@ static int get_channel_index(telem_channel_t channel) {
         case TELEM_CONSOLE: return 12;
         case TELEM_CTRL:    return 13;
         case TELEM_RESP:    return 14;
+        case TELEM_PERF:    return 15;
         default:            return 0;
     }
 }
 
-/*============================================================================
- * Public API Implementation
- *============================================================================*/
+telem_ctx_t *telem_ctx_resolve(telem_ctx_t *ctx) {
+    return ctx ? ctx : &g_default_ctx;
+}
 
-bool telem_init(int port) {
-    if (g_initialized) {
-        return true;  /* Already initialized */
+telem_sender_t *telem_ctx_sender(telem_ctx_t *ctx) {
+    return &telem_ctx_resolve(ctx)->sender;
+}
+
+static inline bool channel_enabled(telem_ctx_t *ctx, telem_channel_t channel) {
+    return (atomic_load_explicit(&ctx->enabled_channels, memory_order_relaxed) & channel) != 0;
+}
+
+static inline telem_format_t current_format(telem_ctx_t *ctx) {
+    return (telem_format_t)atomic_load_explicit(&ctx->format, memory_order_relaxed);
+}
+
+void telem_count_sent(telem_ctx_t *ctx, int channel_idx, uint32_t count) {
+    atomic_fetch_add_explicit(&ctx->stats_sent[channel_idx], count, memory_order_relaxed);
+}
+
+void telem_count_dropped(telem_ctx_t *ctx, int channel_idx, uint32_t count) {
+    atomic_fetch_add_explicit(&ctx->stats_dropped[channel_idx], count, memory_order_relaxed);
+}
+
+bool telem_transmit(telem_ctx_t *ctx, const void *data, size_t length) {
+    if (ctx->sock == SOCKET_INVALID) return false;
+    return sendto(ctx->sock, (const char *)data, (int)length, 0,
+                  (struct sockaddr *)&ctx->dest_addr, sizeof(ctx->dest_addr)) >= 0;
+}
+
+/* Caller holds ctx->frame_lock */
+static void frame_send_locked(telem_ctx_t *ctx) {
+    if (!ctx->frame_ready) return;
+
+    size_t len = telem_wire_frame_finish(&ctx->frame, ctx->frame_sequence);
+    if (len > 0) {
+        bool ok = telem_transmit(ctx, ctx->frame.data, len);
+        for (int i = 0; i < TELEM_CHANNEL_SLOTS; i++) {
+            if (ctx->frame_pending[i] == 0) continue;
+            if (ok) telem_count_sent(ctx, i, ctx->frame_pending[i]);
+            else telem_count_dropped(ctx, i, ctx->frame_pending[i]);
+            ctx->frame_pending[i] = 0;
+        }
+        ctx->frame_sequence++;
+    }
+    telem_wire_frame_reset(&ctx->frame);
+}
+
+void telem_frame_append(telem_ctx_t *ctx, const telem_msg_t *msg) {
+    uint8_t channel_id = (uint8_t)(msg->channel_idx - 1);
+    telem_wire_frame_t *frame = &ctx->frame;
+
+    wwv_mutex_lock(&ctx->frame_lock);
+
+    if (!ctx->frame_ready) {
+        telem_wire_frame_reset(frame);
+        ctx->frame_ready = true;
     }
 
+    if (!telem_wire_frame_append(frame, channel_id, msg->type, msg->wall_time,
+                                 msg->sample_us, msg->data, msg->length)) {
+        frame_send_locked(ctx);
+        if (!telem_wire_frame_append(frame, channel_id, msg->type, msg->wall_time,
+                                     msg->sample_us, msg->data, msg->length)) {
+            telem_count_dropped(ctx, msg->channel_idx, 1);  /* Larger than a datagram */
+            wwv_mutex_unlock(&ctx->frame_lock);
+            return;
+        }
+    }
+    ctx->frame_pending[msg->channel_idx]++;
+
+    /* Bound latency by sample time so quiet channels are not held back */
+    if (msg->sample_us >= frame->first_sample_us &&
+        msg->sample_us - frame->first_sample_us >= TELEM_BINARY_MAX_AGE_US) {
+        frame_send_locked(ctx);
+    }
+
+    wwv_mutex_unlock(&ctx->frame_lock);
+}
+
+void telem_frame_send(telem_ctx_t *ctx) {
+    wwv_mutex_lock(&ctx->frame_lock);
+    frame_send_locked(ctx);
+    wwv_mutex_unlock(&ctx->frame_lock);
+}
+
+/**
+ * Hand a message to the sender thread, or deliver it here if none runs
+ */
+static void dispatch(telem_ctx_t *ctx, const telem_msg_t *msg) {
+    if (telem_sender_active(ctx)) {
+        if (!telem_sender_enqueue(ctx, msg)) {
+            telem_count_dropped(ctx, msg->channel_idx, 1);  /* Queue full */
+        }
+        return;
+    }
+
+    if (msg->kind == TELEM_MSG_RECORD) {
+        telem_frame_append(ctx, msg);
+    } else if (telem_transmit(ctx, msg->data, msg->length)) {
+        telem_count_sent(ctx, msg->channel_idx, 1);
+    } else {
+        telem_count_dropped(ctx, msg->channel_idx, 1);
+    }
+}
+
+/*============================================================================
+ * Open / Close
+ *============================================================================*/
+
+static bool ctx_open(telem_ctx_t *ctx, const char *address, int port) {
     if (port <= 0) {
         port = TELEM_DEFAULT_PORT;
     }
 
 #ifdef _WIN32
-    /* Initialize Winsock if needed */
+    /* Initialize Winsock if needed (reference counted) */
     WSADATA wsa;
     if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
         fprintf(stderr, "[TELEM] WSAStartup failed\n");
@@ -119,99 +254,219 @@ bool telem_init(int port) {
     }
 #endif
 
+    /* Setup destination address */
+    memset(&ctx->dest_addr, 0, sizeof(ctx->dest_addr));
+    ctx->dest_addr.sin_family = AF_INET;
+    ctx->dest_addr.sin_port = htons((uint16_t)port);
+    if (address) {
+        if (inet_pton(AF_INET, address, &ctx->dest_addr.sin_addr) != 1) {
+            fprintf(stderr, "[TELEM] Invalid address: %s\n", address);
+            return false;
+        }
+    } else {
+        ctx->dest_addr.sin_addr.s_addr = htonl(INADDR_BROADCAST);  /* 255.255.255.255 */
+    }
+
     /* Create UDP socket */
-    g_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    if (g_sock == SOCKET_INVALID) {
+    ctx->sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (ctx->sock == SOCKET_INVALID) {
         fprintf(stderr, "[TELEM] Failed to create UDP socket\n");
         return false;
     }
 
     /* Enable broadcast */
     int broadcast = 1;
-    if (setsockopt(g_sock, SOL_SOCKET, SO_BROADCAST,
+    if (setsockopt(ctx->sock, SOL_SOCKET, SO_BROADCAST,
                    (const char *)&broadcast, sizeof(broadcast)) < 0) {
         fprintf(stderr, "[TELEM] Failed to enable broadcast\n");
-        socket_close(g_sock);
-        g_sock = SOCKET_INVALID;
+        socket_close(ctx->sock);
+        ctx->sock = SOCKET_INVALID;
         return false;
     }
 
     /* Set non-blocking */
 #ifdef _WIN32
     u_long mode = 1;
-    ioctlsocket(g_sock, FIONBIO, &mode);
+    ioctlsocket(ctx->sock, FIONBIO, &mode);
 #else
-    int flags = fcntl(g_sock, F_GETFL, 0);
-    fcntl(g_sock, F_SETFL, flags | O_NONBLOCK);
+    int flags = fcntl(ctx->sock, F_GETFL, 0);
+    fcntl(ctx->sock, F_SETFL, flags | O_NONBLOCK);
 #endif
 
-    /* Setup broadcast address */
-    memset(&g_broadcast_addr, 0, sizeof(g_broadcast_addr));
-    g_broadcast_addr.sin_family = AF_INET;
-    g_broadcast_addr.sin_port = htons((uint16_t)port);
-    g_broadcast_addr.sin_addr.s_addr = htonl(INADDR_BROADCAST);  /* 255.255.255.255 */
-
     /* Enable all channels by default */
-    g_enabled_channels = TELEM_ALL;
-    g_stats_sent = 0;
-    g_stats_dropped = 0;
-    g_initialized = true;
+    atomic_store(&ctx->enabled_channels, TELEM_ALL);
+    for (int i = 0; i < TELEM_CHANNEL_SLOTS; i++) {
+        atomic_store(&ctx->stats_sent[i], 0);
+        atomic_store(&ctx->stats_dropped[i], 0);
+    }
+    ctx->initialized = true;
 
-    printf("[TELEM] UDP broadcast initialized on port %d\n", port);
+    printf("[TELEM] UDP %s initialized on port %d\n", address ? address : "broadcast", port);
     return true;
 }
 
-void telem_cleanup(void) {
-    if (!g_initialized) return;
+static void ctx_close(telem_ctx_t *ctx) {
+    telem_ctx_stop_sender(ctx);
+    telem_sender_release(ctx);
+    telem_frame_send(ctx);
 
-    if (g_sock != SOCKET_INVALID) {
-        socket_close(g_sock);
-        g_sock = SOCKET_INVALID;
+    if (ctx->sock != SOCKET_INVALID) {
+        socket_close(ctx->sock);
+        ctx->sock = SOCKET_INVALID;
     }
 
-    g_enabled_channels = TELEM_NONE;
-    g_initialized = false;
+    atomic_store(&ctx->enabled_channels, TELEM_NONE);
+    ctx->initialized = false;
 
-    printf("[TELEM] Cleanup complete. Sent: %u, Dropped: %u\n",
-           g_stats_sent, g_stats_dropped);
+    uint32_t sent, dropped;
+    telem_ctx_get_stats(ctx, &sent, &dropped);
+    printf("[TELEM] Cleanup complete. Sent: %u, Dropped: %u\n", sent, dropped);
 }
 
-void telem_enable(uint32_t channels) {
-    g_enabled_channels |= channels;
+/*============================================================================
+ * Context API Implementation
+ *============================================================================*/
+
+telem_ctx_t *telem_ctx_create(const char *address, int port) {
+    telem_ctx_t *ctx = (telem_ctx_t *)wwv_calloc(1, sizeof(telem_ctx_t));
+    if (!ctx) return NULL;
+
+    ctx->sock = SOCKET_INVALID;
+    wwv_mutex_init(&ctx->frame_lock);
+    wwv_mutex_init(&ctx->console_lock);
+    telem_sender_init(&ctx->sender);
+
+    if (!ctx_open(ctx, address, port)) {
+        wwv_mutex_destroy(&ctx->frame_lock);
+        wwv_mutex_destroy(&ctx->console_lock);
+        wwv_mutex_destroy(&ctx->sender.lock);
+        wwv_free(ctx);
+        return NULL;
+    }
+    return ctx;
 }
 
-void telem_disable(uint32_t channels) {
-    g_enabled_channels &= ~channels;
+void telem_ctx_destroy(telem_ctx_t *ctx) {
+    if (!ctx || ctx == &g_default_ctx) return;
+
+    telem_ctx_console_flush(ctx);
+    ctx_close(ctx);
+    wwv_mutex_destroy(&ctx->frame_lock);
+    wwv_mutex_destroy(&ctx->console_lock);
+    wwv_mutex_destroy(&ctx->sender.lock);
+    if (ctx->sender.cond_ready) wwv_cond_destroy(&ctx->sender.wake);
+    wwv_free(ctx);
 }
 
-void telem_set_channels(uint32_t channels) {
-    g_enabled_channels = channels;
+telem_ctx_t *telem_default_ctx(void) {
+    return &g_default_ctx;
 }
 
-uint32_t telem_get_channels(void) {
-    return g_enabled_channels;
+bool telem_init(int port) {
+    if (g_default_ctx.initialized) {
+        return true;  /* Already initialized */
+    }
+    return ctx_open(&g_default_ctx, NULL, port);
 }
 
-bool telem_is_enabled(telem_channel_t channel) {
-    return (g_enabled_channels & channel) != 0;
+void telem_cleanup(void) {
+    if (!g_default_ctx.initialized) return;
+    ctx_close(&g_default_ctx);
+}
+
+void telem_ctx_enable(telem_ctx_t *ctx, uint32_t channels) {
+    atomic_fetch_or(&telem_ctx_resolve(ctx)->enabled_channels, channels);
+}
+
+void telem_ctx_disable(telem_ctx_t *ctx, uint32_t channels) {
+    atomic_fetch_and(&telem_ctx_resolve(ctx)->enabled_channels, ~channels);
+}
+
+void telem_ctx_set_channels(telem_ctx_t *ctx, uint32_t channels) {
+    atomic_store(&telem_ctx_resolve(ctx)->enabled_channels, channels);
+}
+
+uint32_t telem_ctx_get_channels(telem_ctx_t *ctx) {
+    return atomic_load(&telem_ctx_resolve(ctx)->enabled_channels);
+}
+
+bool telem_ctx_is_enabled(telem_ctx_t *ctx, telem_channel_t channel) {
+    return channel_enabled(telem_ctx_resolve(ctx), channel);
+}
+
+void telem_ctx_set_format(telem_ctx_t *ctx, telem_format_t format) {
+    ctx = telem_ctx_resolve(ctx);
+    if (format == current_format(ctx)) return;
+    telem_ctx_flush(ctx);
+    atomic_store(&ctx->format, (int)format);
+}
+
+telem_format_t telem_ctx_get_format(telem_ctx_t *ctx) {
+    return current_format(telem_ctx_resolve(ctx));
+}
+
+bool telem_ctx_binary_active(telem_ctx_t *ctx, telem_channel_t channel) {
+    ctx = telem_ctx_resolve(ctx);
+    return ctx->initialized && current_format(ctx) == TELEM_FORMAT_BINARY &&
+           channel_enabled(ctx, channel);
+}
+
+void telem_ctx_send_record(telem_ctx_t *ctx, telem_channel_t channel, uint8_t type,
+                           uint32_t wall_time, uint64_t sample_us,
+                           const void *payload, uint16_t length) {
+    ctx = telem_ctx_resolve(ctx);
+    if (!ctx->initialized || ctx->sock == SOCKET_INVALID ||
+        current_format(ctx) != TELEM_FORMAT_BINARY) {
+        return;
+    }
+
+    int idx = telem_channel_index(channel);
+    if (!channel_enabled(ctx, channel) || length > TELEM_MAX_MESSAGE_LEN) {
+        telem_count_dropped(ctx, idx, 1);
+        return;
+    }
+
+    telem_msg_t msg;
+    msg.channel_idx = (uint8_t)idx;
+    msg.kind = TELEM_MSG_RECORD;
+    msg.type = type;
+    msg.reserved = 0;
+    msg.length = length;
+    msg.wall_time = wall_time;
+    msg.sample_us = sample_us;
+    memcpy(msg.data, payload, length);
+    dispatch(ctx, &msg);
+}
+
+void telem_ctx_flush(telem_ctx_t *ctx) {
+    ctx = telem_ctx_resolve(ctx);
+    if (!ctx->initialized) return;
+
+    /* The sender transmits at the end of every batching interval */
+    if (telem_sender_active(ctx)) return;
+
+    telem_frame_send(ctx);
 }
 
 const char *telem_channel_prefix(telem_channel_t channel) {
-    int idx = get_channel_index(channel);
+    int idx = telem_channel_index(channel);
     if (idx >= 0 && idx < (int)(sizeof(g_channel_prefixes) / sizeof(g_channel_prefixes[0]))) {
         return g_channel_prefixes[idx];
     }
     return "????";
 }
 
-void telem_send(telem_channel_t channel, const char *csv_line) {
+void telem_ctx_send(telem_ctx_t *ctx, telem_channel_t channel, const char *csv_line) {
+    ctx = telem_ctx_resolve(ctx);
+
     /* Fast path: check if enabled before any work */
-    if (!g_initialized || g_sock == SOCKET_INVALID) {
+    if (!ctx->initialized || ctx->sock == SOCKET_INVALID) {
         return;
     }
 
-    if ((g_enabled_channels & channel) == 0) {
-        g_stats_dropped++;
+    int idx = telem_channel_index(channel);
+    if (!channel_enabled(ctx, channel)) {
+        telem_count_dropped(ctx, idx, 1);
         return;
     }
 
@@ -219,86 +474,138 @@ void telem_send(telem_channel_t channel, const char *csv_line) {
         return;
     }
 
-    /* Format message with prefix */
-    char buffer[TELEM_MAX_MESSAGE_LEN];
+    telem_msg_t msg;
+    msg.channel_idx = (uint8_t)idx;
+    msg.reserved = 0;
+    msg.sample_us = 0;
+    size_t len = strlen(csv_line);
+
+    /* Binary format: carry the line as a text record in the shared datagram */
+    if (current_format(ctx) == TELEM_FORMAT_BINARY) {
+        if (len > TELEM_MAX_MESSAGE_LEN) {
+            telem_count_dropped(ctx, idx, 1);
+            return;
+        }
+        msg.kind = TELEM_MSG_RECORD;
+        msg.type = TELEM_REC_TEXT;
+        msg.wall_time = (uint32_t)time(NULL);
+        msg.length = (uint16_t)len;
+        memcpy(msg.data, csv_line, len);
+        dispatch(ctx, &msg);
+        return;
+    }
+
+    /* Format message with prefix (the NUL is not sent) */
+    char *buffer = (char *)msg.data;
     const char *prefix = telem_channel_prefix(channel);
 
     /* Check if csv_line already has newline */
-    size_t len = strlen(csv_line);
     bool has_newline = (len > 0 && csv_line[len - 1] == '\n');
 
     int written;
     if (has_newline) {
-        written = snprintf(buffer, sizeof(buffer), "%s,%s", prefix, csv_line);
+        written = snprintf(buffer, sizeof(msg.data), "%s,%s", prefix, csv_line);
     } else {
-        written = snprintf(buffer, sizeof(buffer), "%s,%s\n", prefix, csv_line);
+        written = snprintf(buffer, sizeof(msg.data), "%s,%s\n", prefix, csv_line);
     }
 
-    if (written <= 0 || written >= (int)sizeof(buffer)) {
-        g_stats_dropped++;
+    if (written <= 0 || written >= (int)sizeof(msg.data)) {
+        telem_count_dropped(ctx, idx, 1);
         return;
     }
 
-    /* Send (non-blocking, ignore errors) */
-    sendto(g_sock, buffer, written, 0,
-           (struct sockaddr *)&g_broadcast_addr, sizeof(g_broadcast_addr));
-
-    g_stats_sent++;
+    msg.kind = TELEM_MSG_LINE;
+    msg.type = 0;
+    msg.wall_time = 0;
+    msg.length = (uint16_t)written;
+    dispatch(ctx, &msg);
 }
 
-void telem_sendf(telem_channel_t channel, const char *fmt, ...) {
+void telem_ctx_vsendf(telem_ctx_t *ctx, telem_channel_t channel, const char *fmt, va_list args) {
+    ctx = telem_ctx_resolve(ctx);
+
     /* Fast path: check if enabled before formatting */
-    if (!g_initialized || (g_enabled_channels & channel) == 0) {
-        if (g_initialized) g_stats_dropped++;
+    if (!ctx->initialized || !channel_enabled(ctx, channel)) {
+        if (ctx->initialized) telem_count_dropped(ctx, telem_channel_index(channel), 1);
         return;
     }
 
     char csv_buffer[TELEM_MAX_MESSAGE_LEN - 8];  /* Reserve space for prefix */
+    vsnprintf(csv_buffer, sizeof(csv_buffer), fmt, args);
+
+    telem_ctx_send(ctx, channel, csv_buffer);
+}
+
+void telem_ctx_sendf(telem_ctx_t *ctx, telem_channel_t channel, const char *fmt, ...) {
     va_list args;
     va_start(args, fmt);
-    vsnprintf(csv_buffer, sizeof(csv_buffer), fmt, args);
+    telem_ctx_vsendf(ctx, channel, fmt, args);
     va_end(args);
+}
 
-    telem_send(channel, csv_buffer);
+void telem_ctx_get_stats(telem_ctx_t *ctx, uint32_t *sent, uint32_t *dropped) {
+    ctx = telem_ctx_resolve(ctx);
+    uint32_t total_sent = 0, total_dropped = 0;
+    for (int i = 0; i < TELEM_CHANNEL_SLOTS; i++) {
+        total_sent += atomic_load_explicit(&ctx->stats_sent[i], memory_order_relaxed);
+        total_dropped += atomic_load_explicit(&ctx->stats_dropped[i], memory_order_relaxed);
+    }
+    if (sent) *sent = total_sent;
+    if (dropped) *dropped = total_dropped;
 }
 
-void telem_get_stats(uint32_t *sent, uint32_t *dropped) {
-    if (sent) *sent = g_stats_sent;
-    if (dropped) *dropped = g_stats_dropped;
+void telem_ctx_get_channel_stats(telem_ctx_t *ctx, telem_channel_t channel,
+                                 telem_channel_stats_t *stats) {
+    if (!stats) return;
+    ctx = telem_ctx_resolve(ctx);
+    int idx = telem_channel_index(channel);
+    stats->sent = atomic_load_explicit(&ctx->stats_sent[idx], memory_order_relaxed);
+    stats->dropped = atomic_load_explicit(&ctx->stats_dropped[idx], memory_order_relaxed);
 }
 
-void telem_console_flush(void) {
-    if (g_console_buffer_len == 0) {
+/*============================================================================
+ * Console Buffer
+ *============================================================================*/
+
+/* Caller holds ctx->console_lock */
+static void console_flush_locked(telem_ctx_t *ctx) {
+    if (ctx->console_buffer_len == 0) {
         return;
     }
 
     /* Send buffered console data */
-    if (g_initialized && (g_enabled_channels & TELEM_CONSOLE)) {
+    if (ctx->initialized && channel_enabled(ctx, TELEM_CONSOLE)) {
         /* Ensure null termination */
-        if (g_console_buffer_len < CONSOLE_BUFFER_SIZE) {
-            g_console_buffer[g_console_buffer_len] = '\0';
+        if (ctx->console_buffer_len < CONSOLE_BUFFER_SIZE) {
+            ctx->console_buffer[ctx->console_buffer_len] = '\0';
         } else {
-            g_console_buffer[CONSOLE_BUFFER_SIZE - 1] = '\0';
+            ctx->console_buffer[CONSOLE_BUFFER_SIZE - 1] = '\0';
         }
-        telem_send(TELEM_CONSOLE, g_console_buffer);
+        telem_ctx_send(ctx, TELEM_CONSOLE, ctx->console_buffer);
     }
 
     /* Reset buffer */
-    g_console_buffer_len = 0;
+    ctx->console_buffer_len = 0;
+}
+
+void telem_ctx_console_flush(telem_ctx_t *ctx) {
+    ctx = telem_ctx_resolve(ctx);
+    wwv_mutex_lock(&ctx->console_lock);
+    console_flush_locked(ctx);
+    wwv_mutex_unlock(&ctx->console_lock);
 }
 
-void telem_console(const char *fmt, ...) {
+void telem_ctx_vconsole(telem_ctx_t *ctx, const char *fmt, va_list args) {
+    ctx = telem_ctx_resolve(ctx);
+
     /* Fast path: check if enabled */
-    if (!g_initialized || (g_enabled_channels & TELEM_CONSOLE) == 0) {
+    if (!ctx->initialized || !channel_enabled(ctx, TELEM_CONSOLE)) {
         return;
     }
 
     /* Format message into temp buffer */
     char temp[512];
-    va_list args;
-    va_start(args, fmt);
     int written = vsnprintf(temp, sizeof(temp), fmt, args);
-    va_end(args);
 
     if (written <= 0) {
         return;
@@ -309,26 +616,38 @@ void telem_console(const char *fmt, ...) {
         written = (int)sizeof(temp) - 1;
     }
 
+    wwv_mutex_lock(&ctx->console_lock);
+
     /* Check if buffer has space */
-    int space_available = CONSOLE_BUFFER_SIZE - g_console_buffer_len - 1;
+    int space_available = CONSOLE_BUFFER_SIZE - ctx->console_buffer_len - 1;
     if (written > space_available) {
         /* Flush current buffer first */
-        telem_console_flush();
+        console_flush_locked(ctx);
         space_available = CONSOLE_BUFFER_SIZE - 1;
 
         /* If still doesn't fit, drop it and count */
         if (written > space_available) {
-            g_console_dropped++;
+            ctx->console_dropped++;
+            wwv_mutex_unlock(&ctx->console_lock);
             return;
         }
     }
 
     /* Append to buffer */
-    memcpy(g_console_buffer + g_console_buffer_len, temp, written);
-    g_console_buffer_len += written;
+    memcpy(ctx->console_buffer + ctx->console_buffer_len, temp, written);
+    ctx->console_buffer_len += written;
 
     /* Auto-flush on newline */
     if (written > 0 && temp[written - 1] == '\n') {
-        telem_console_flush();
+        console_flush_locked(ctx);
     }
+
+    wwv_mutex_unlock(&ctx->console_lock);
+}
+
+void telem_ctx_console(telem_ctx_t *ctx, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    telem_ctx_vconsole(ctx, fmt, args);
+    va_end(args);
 }
@@ -0,0 +1,92 @@
+/**
+ * @file telemetry_default.c
+ * @brief Default-context telemetry API
+ *
+ * The original global telem_* functions, forwarding to the default
+ * context (see telem_default_ctx()).
+ */
+
+#include "core/telemetry_internal.h"
+
+void telem_enable(uint32_t channels) {
+    telem_ctx_enable(NULL, channels);
+}
+
+void telem_disable(uint32_t channels) {
+    telem_ctx_disable(NULL, channels);
+}
+
+void telem_set_channels(uint32_t channels) {
+    telem_ctx_set_channels(NULL, channels);
+}
+
+uint32_t telem_get_channels(void) {
+    return telem_ctx_get_channels(NULL);
+}
+
+bool telem_is_enabled(telem_channel_t channel) {
+    return telem_ctx_is_enabled(NULL, channel);
+}
+
+void telem_send(telem_channel_t channel, const char *csv_line) {
+    telem_ctx_send(NULL, channel, csv_line);
+}
+
+void telem_sendf(telem_channel_t channel, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    telem_ctx_vsendf(NULL, channel, fmt, args);
+    va_end(args);
+}
+
+void telem_set_format(telem_format_t format) {
+    telem_ctx_set_format(NULL, format);
+}
+
+telem_format_t telem_get_format(void) {
+    return telem_ctx_get_format(NULL);
+}
+
+bool telem_binary_active(telem_channel_t channel) {
+    return telem_ctx_binary_active(NULL, channel);
+}
+
+void telem_send_record(telem_channel_t channel, uint8_t type, uint32_t wall_time,
+                       uint64_t sample_us, const void *payload, uint16_t length) {
+    telem_ctx_send_record(NULL, channel, type, wall_time, sample_us, payload, length);
+}
+
+void telem_flush(void) {
+    telem_ctx_flush(NULL);
+}
+
+bool telem_start_sender(const telem_sender_config_t *config) {
+    return telem_ctx_start_sender(NULL, config);
+}
+
+void telem_stop_sender(void) {
+    telem_ctx_stop_sender(NULL);
+}
+
+bool telem_sender_running(void) {
+    return telem_ctx_sender_running(NULL);
+}
+
+void telem_get_stats(uint32_t *sent, uint32_t *dropped) {
+    telem_ctx_get_stats(NULL, sent, dropped);
+}
+
+void telem_get_channel_stats(telem_channel_t channel, telem_channel_stats_t *stats) {
+    telem_ctx_get_channel_stats(NULL, channel, stats);
+}
+
+void telem_console(const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    telem_ctx_vconsole(NULL, fmt, args);
+    va_end(args);
+}
+
+void telem_console_flush(void) {
+    telem_ctx_console_flush(NULL);
+}
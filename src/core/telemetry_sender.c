@@ -0,0 +1,203 @@
+/**
+ * @file telemetry_sender.c
+ * @brief Background telemetry sender
+ *
+ * Producers push telem_msg_t onto the context's bounded MPSC queue and
+ * return. The sender thread wakes every poll_interval_ms, drains the
+ * queue, appends CSV lines to a per-channel datagram (newline separated,
+ * up to TELEM_WIRE_MTU) and binary records to the context's wire frame,
+ * then sends everything still pending before sleeping again.
+ */
+
+#include "core/telemetry_internal.h"
+#include "wwv_trace.h"
+#include <stdio.h>
+#include <string.h>
+
+/*============================================================================
+ * Per-Channel Line Batches (sender thread only)
+ *============================================================================*/
+
+static void batch_send(telem_ctx_t *ctx, telem_sender_t *s, int idx) {
+    telem_line_batch_t *b = &s->batches[idx];
+    if (b->lines == 0) return;
+
+    if (telem_transmit(ctx, b->data, b->length)) {
+        telem_count_sent(ctx, idx, b->lines);
+    } else {
+        telem_count_dropped(ctx, idx, b->lines);
+    }
+    b->length = 0;
+    b->lines = 0;
+}
+
+static void deliver_line(telem_ctx_t *ctx, telem_sender_t *s, const telem_msg_t *msg) {
+    int idx = msg->channel_idx;
+
+    if (!s->config.batch_text) {
+        if (telem_transmit(ctx, msg->data, msg->length)) telem_count_sent(ctx, idx, 1);
+        else telem_count_dropped(ctx, idx, 1);
+        return;
+    }
+
+    telem_line_batch_t *b = &s->batches[idx];
+    if (b->length + msg->length > sizeof(b->data)) {
+        batch_send(ctx, s, idx);
+    }
+    memcpy(b->data + b->length, msg->data, msg->length);
+    b->length += msg->length;
+    b->lines++;
+}
+
+/**
+ * Deliver everything queued, then send all partial datagrams
+ */
+static void drain(telem_ctx_t *ctx, telem_sender_t *s) {
+    WWV_TRACE_BEGIN(tr);
+    size_t messages = 0;
+    while (wwv_mpsc_queue_pop(s->queue, &s->msg) > 0) {
+        messages++;
+        if (s->msg.kind == TELEM_MSG_RECORD) {
+            telem_frame_append(ctx, &s->msg);
+        } else {
+            deliver_line(ctx, s, &s->msg);
+        }
+    }
+
+    for (int i = 0; i < TELEM_CHANNEL_SLOTS; i++) {
+        batch_send(ctx, s, i);
+    }
+    telem_frame_send(ctx);
+    if (messages) WWV_TRACE_END("telemetry", "send", tr, WWV_TRACE_NO_SAMPLE);
+}
+
+static void sender_main(void *arg) {
+    telem_ctx_t *ctx = (telem_ctx_t *)arg;
+    telem_sender_t *s = telem_ctx_sender(ctx);
+    WWV_TRACE_THREAD("telemetry");
+
+    wwv_mutex_lock(&s->lock);
+    for (;;) {
+        bool stop = s->stop;
+        wwv_mutex_unlock(&s->lock);
+
+        drain(ctx, s);
+
+        wwv_mutex_lock(&s->lock);
+        if (stop) break;
+        if (!s->stop) {
+            wwv_cond_timedwait_ms(&s->wake, &s->lock, s->config.poll_interval_ms);
+        }
+    }
+    wwv_mutex_unlock(&s->lock);
+}
+
+/*============================================================================
+ * Internal Interface (telemetry.c)
+ *============================================================================*/
+
+void telem_sender_init(telem_sender_t *sender) {
+    telem_sender_config_t defaults = TELEM_SENDER_CONFIG_DEFAULT;
+    sender->config = defaults;
+    wwv_mutex_init(&sender->lock);
+}
+
+bool telem_sender_active(telem_ctx_t *ctx) {
+    return atomic_load_explicit(&telem_ctx_sender(ctx)->active, memory_order_acquire);
+}
+
+bool telem_sender_enqueue(telem_ctx_t *ctx, const telem_msg_t *msg) {
+    return wwv_mpsc_queue_push(telem_ctx_sender(ctx)->queue, msg,
+                               TELEM_MSG_HEADER_BYTES + msg->length);
+}
+
+void telem_sender_release(telem_ctx_t *ctx) {
+    telem_sender_t *s = telem_ctx_sender(ctx);
+
+    wwv_mutex_lock(&s->lock);
+    if (!s->running && s->queue) {
+        drain(ctx, s);
+        wwv_mpsc_queue_destroy(s->queue);
+        s->queue = NULL;
+    }
+    wwv_mutex_unlock(&s->lock);
+}
+
+/*============================================================================
+ * Public API Implementation
+ *============================================================================*/
+
+bool telem_ctx_start_sender(telem_ctx_t *ctx, const telem_sender_config_t *config) {
+    telem_sender_config_t defaults = TELEM_SENDER_CONFIG_DEFAULT;
+    if (!config) config = &defaults;
+
+    ctx = telem_ctx_resolve(ctx);
+    telem_sender_t *s = telem_ctx_sender(ctx);
+
+    wwv_mutex_lock(&s->lock);
+    if (s->running) {
+        wwv_mutex_unlock(&s->lock);
+        return true;
+    }
+
+    s->config = *config;
+    if (s->config.poll_interval_ms == 0) s->config.poll_interval_ms = 1;
+    if (s->config.queue_slots == 0) s->config.queue_slots = 1;
+
+    /* The queue outlives stop/start so a producer racing the stop never
+     * pushes into freed memory; it is released when the context closes */
+    if (!s->queue) {
+        s->queue = wwv_mpsc_queue_create(sizeof(telem_msg_t), s->config.queue_slots);
+        if (!s->queue) {
+            wwv_mutex_unlock(&s->lock);
+            fprintf(stderr, "[TELEM] Failed to allocate sender queue\n");
+            return false;
+        }
+    }
+    if (!s->cond_ready) {
+        wwv_cond_init(&s->wake);
+        s->cond_ready = true;
+    }
+
+    s->stop = false;
+    s->running = wwv_thread_create(&s->thread, sender_main, ctx);
+    if (s->running) {
+        atomic_store_explicit(&s->active, true, memory_order_release);
+    }
+    bool running = s->running;
+    wwv_mutex_unlock(&s->lock);
+
+    if (!running) {
+        fprintf(stderr, "[TELEM] Failed to start sender thread\n");
+    }
+    return running;
+}
+
+void telem_ctx_stop_sender(telem_ctx_t *ctx) {
+    ctx = telem_ctx_resolve(ctx);
+    telem_sender_t *s = telem_ctx_sender(ctx);
+
+    wwv_mutex_lock(&s->lock);
+    if (!s->running) {
+        wwv_mutex_unlock(&s->lock);
+        return;
+    }
+
+    /* New messages go out synchronously from here on */
+    atomic_store_explicit(&s->active, false, memory_order_release);
+    s->stop = true;
+    wwv_cond_signal(&s->wake);
+    wwv_mutex_unlock(&s->lock);
+
+    wwv_thread_join(s->thread);
+
+    /* Pick up anything pushed between the last drain and the flag change */
+    wwv_mutex_lock(&s->lock);
+    s->running = false;
+    drain(ctx, s);
+    wwv_mutex_unlock(&s->lock);
+}
+
+bool telem_ctx_sender_running(telem_ctx_t *ctx) {
+    return telem_sender_active(ctx);
+}
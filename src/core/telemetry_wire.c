@@ -0,0 +1,95 @@
+/**
+ * @file telemetry_wire.c
+ * @brief Binary telemetry frame builder and parser
+ */
+
+#include "telemetry_wire.h"
+#include <string.h>
+
+#define FRAME_HEADER_BYTES  sizeof(telem_wire_frame_header_t)
+#define RECORD_HEADER_BYTES sizeof(telem_wire_record_header_t)
+
+/*============================================================================
+ * Frame Builder
+ *============================================================================*/
+
+void telem_wire_frame_reset(telem_wire_frame_t *frame) {
+    if (!frame) return;
+    frame->length = FRAME_HEADER_BYTES;
+    frame->record_count = 0;
+    frame->first_sample_us = 0;
+}
+
+bool telem_wire_frame_append(telem_wire_frame_t *frame, uint8_t channel, uint8_t type,
+                             uint32_t wall_time, uint64_t sample_us,
+                             const void *payload, uint16_t length) {
+    if (!frame || (length > 0 && !payload)) return false;
+    if (frame->record_count >= TELEM_WIRE_MAX_RECORDS) return false;
+    if (frame->length + RECORD_HEADER_BYTES + length > TELEM_WIRE_MTU) return false;
+
+    telem_wire_record_header_t rec = {
+        .channel = channel,
+        .type = type,
+        .length = length,
+        .wall_time = wall_time,
+        .sample_us = sample_us
+    };
+
+    memcpy(&frame->data[frame->length], &rec, RECORD_HEADER_BYTES);
+    frame->length += RECORD_HEADER_BYTES;
+    if (length > 0) {
+        memcpy(&frame->data[frame->length], payload, length);
+        frame->length += length;
+    }
+
+    if (frame->record_count == 0) {
+        frame->first_sample_us = sample_us;
+    }
+    frame->record_count++;
+    return true;
+}
+
+size_t telem_wire_frame_finish(telem_wire_frame_t *frame, uint32_t sequence) {
+    if (!frame || frame->record_count == 0) return 0;
+
+    telem_wire_frame_header_t hdr = {
+        .magic = TELEM_WIRE_MAGIC,
+        .version = TELEM_WIRE_VERSION,
+        .record_count = frame->record_count,
+        .length = (uint16_t)frame->length,
+        .sequence = sequence
+    };
+    memcpy(frame->data, &hdr, FRAME_HEADER_BYTES);
+    return frame->length;
+}
+
+/*============================================================================
+ * Parser
+ *============================================================================*/
+
+bool telem_wire_parse_header(const void *datagram, size_t length,
+                             telem_wire_frame_header_t *header) {
+    if (!datagram || !header || length < FRAME_HEADER_BYTES) return false;
+
+    memcpy(header, datagram, FRAME_HEADER_BYTES);
+    return header->magic == TELEM_WIRE_MAGIC &&
+           header->version == TELEM_WIRE_VERSION &&
+           header->length <= length &&
+           header->length >= FRAME_HEADER_BYTES;
+}
+
+bool telem_wire_next_record(const void *datagram, size_t length, size_t *offset,
+                            telem_wire_record_header_t *record, const uint8_t **payload) {
+    if (!datagram || !offset || !record) return false;
+
+    const uint8_t *bytes = (const uint8_t *)datagram;
+    if (*offset + RECORD_HEADER_BYTES > length) return false;
+
+    memcpy(record, &bytes[*offset], RECORD_HEADER_BYTES);
+    size_t end = *offset + RECORD_HEADER_BYTES + record->length;
+    if (end > length) return false;
+
+    if (payload) *payload = &bytes[*offset + RECORD_HEADER_BYTES];
+    *offset = end;
+    return true;
+}
@@ -0,0 +1,263 @@
+/**
+ * @file wwv_arena.c
+ * @brief Caller-supplied memory arena and the library allocation hooks
+ *
+ * The active arena is thread-local, so only the thread running a create
+ * call allocates from it; worker threads started meanwhile stay on the
+ * heap. Backed arenas are also registered process-wide, so a block freed
+ * from any thread (destroy, worker teardown) is recognised as arena memory.
+ */
+
+#include "wwv_arena.h"
+#include "wwv_thread.h"
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct wwv_arena {
+    unsigned char *base;        /* First block (aligned), NULL when measuring */
+    size_t capacity;            /* Bytes from base */
+    size_t used;
+    bool exhausted;
+};
+
+static _Thread_local wwv_arena_t *g_active = NULL;
+static _Thread_local bool g_prefault = false;
+static _Thread_local size_t g_prefaulted = 0;
+
+static wwv_mutex_t g_live_lock = WWV_MUTEX_INITIALIZER;
+static wwv_arena_t *g_live[WWV_ARENA_MAX_LIVE];
+static atomic_int g_live_count = 0;
+
+static size_t align_up(size_t n, size_t a) {
+    return (n + a - 1) & ~(a - 1);
+}
+
+/*============================================================================
+ * Registry
+ *============================================================================*/
+
+static bool live_add(wwv_arena_t *arena) {
+    bool ok = false;
+    wwv_mutex_lock(&g_live_lock);
+    for (int i = 0; i < WWV_ARENA_MAX_LIVE; i++) {
+        if (!g_live[i]) {
+            g_live[i] = arena;
+            atomic_fetch_add(&g_live_count, 1);
+            ok = true;
+            break;
+        }
+    }
+    wwv_mutex_unlock(&g_live_lock);
+    return ok;
+}
+
+static void live_remove(wwv_arena_t *arena) {
+    wwv_mutex_lock(&g_live_lock);
+    for (int i = 0; i < WWV_ARENA_MAX_LIVE; i++) {
+        if (g_live[i] == arena) {
+            g_live[i] = NULL;
+            atomic_fetch_sub(&g_live_count, 1);
+            break;
+        }
+    }
+    wwv_mutex_unlock(&g_live_lock);
+}
+
+/**
+ * True if ptr was handed out by a live backed arena
+ */
+static bool live_owns(const void *ptr) {
+    if (atomic_load(&g_live_count) == 0) return false;
+
+    const unsigned char *p = (const unsigned char *)ptr;
+    bool owned = false;
+    wwv_mutex_lock(&g_live_lock);
+    for (int i = 0; i < WWV_ARENA_MAX_LIVE && !owned; i++) {
+        const wwv_arena_t *a = g_live[i];
+        owned = a && p >= a->base && p < a->base + a->capacity;
+    }
+    wwv_mutex_unlock(&g_live_lock);
+    return owned;
+}
+
+/*============================================================================
+ * Arena
+ *============================================================================*/
+
+size_t wwv_arena_overhead(void) {
+    /* Worst-case misalignment of mem, then the header on its own line */
+    return (WWV_ARENA_ALIGN - 1) + align_up(sizeof(wwv_arena_t), WWV_ARENA_ALIGN);
+}
+
+wwv_arena_t *wwv_arena_create_in(void *mem, size_t size) {
+    if (!mem) return NULL;
+
+    uintptr_t start = (uintptr_t)mem;
+    uintptr_t aligned = (start + WWV_ARENA_ALIGN - 1) & ~(uintptr_t)(WWV_ARENA_ALIGN - 1);
+    size_t header = align_up(sizeof(wwv_arena_t), WWV_ARENA_ALIGN);
+    size_t skip = (size_t)(aligned - start) + header;
+    if (size < skip) return NULL;
+
+    wwv_arena_t *arena = (wwv_arena_t *)aligned;
+    memset(arena, 0, sizeof(*arena));
+    arena->base = (unsigned char *)aligned + header;
+    arena->capacity = size - skip;
+
+    if (!live_add(arena)) return NULL;
+    return arena;
+}
+
+wwv_arena_t *wwv_arena_create_measure(void) {
+    return (wwv_arena_t *)calloc(1, sizeof(wwv_arena_t));
+}
+
+void wwv_arena_destroy(wwv_arena_t *arena) {
+    if (!arena) return;
+    if (g_active == arena) g_active = NULL;
+    if (arena->base) {
+        live_remove(arena);
+    } else {
+        free(arena);
+    }
+}
+
+size_t wwv_arena_used(const wwv_arena_t *arena) {
+    return arena ? arena->used : 0;
+}
+
+bool wwv_arena_exhausted(const wwv_arena_t *arena) {
+    return arena && arena->exhausted;
+}
+
+wwv_arena_t *wwv_arena_push(wwv_arena_t *arena) {
+    wwv_arena_t *prev = g_active;
+    g_active = arena;
+    return prev;
+}
+
+void wwv_arena_pop(wwv_arena_t *prev) {
+    g_active = prev;
+}
+
+/**
+ * Bump allocation from a backed arena (NULL when full)
+ */
+static void *arena_take(wwv_arena_t *arena, size_t alignment, size_t size) {
+    /* used stays a multiple of WWV_ARENA_ALIGN, so only larger alignments pad */
+    size_t offset = align_up(arena->used, alignment);
+    size_t end = offset + align_up(size ? size : 1, WWV_ARENA_ALIGN);
+    if (end < offset || end > arena->capacity) {
+        arena->exhausted = true;
+        return NULL;
+    }
+    arena->used = end;
+    return arena->base + offset;
+}
+
+/**
+ * Tally for a measuring arena: the same rounding arena_take() applies,
+ * with worst-case padding for alignments beyond a cache line
+ */
+static void arena_tally(wwv_arena_t *arena, size_t alignment, size_t size) {
+    arena->used += align_up(size ? size : 1, WWV_ARENA_ALIGN);
+    if (alignment > WWV_ARENA_ALIGN) arena->used += alignment - WWV_ARENA_ALIGN;
+}
+
+/**
+ * Hand a block back to the caller, prefaulted if this thread asked for it
+ */
+static void *block_out(void *p, size_t size) {
+    if (p && g_prefault) {
+        wwv_prefault(p, size);
+        g_prefaulted += size;
+    }
+    return p;
+}
+
+/*============================================================================
+ * Allocation Hooks
+ *============================================================================*/
+
+void *wwv_malloc(size_t size) {
+    wwv_arena_t *arena = g_active;
+    if (!arena) return block_out(malloc(size), size);
+
+    if (arena->base) return block_out(arena_take(arena, WWV_ARENA_ALIGN, size), size);
+    arena_tally(arena, WWV_ARENA_ALIGN, size);
+    return block_out(malloc(size), size);
+}
+
+void *wwv_calloc(size_t count, size_t size) {
+    wwv_arena_t *arena = g_active;
+    if (!arena || !arena->base) {
+        if (arena && count && size <= SIZE_MAX / count) arena_tally(arena, WWV_ARENA_ALIGN, count * size);
+        void *p = calloc(count, size);
+        return p ? block_out(p, count * size) : NULL;
+    }
+
+    if (count && size > SIZE_MAX / count) return NULL;
+    void *p = arena_take(arena, WWV_ARENA_ALIGN, count * size);
+    if (p) memset(p, 0, count * size);
+    return block_out(p, count * size);
+}
+
+void wwv_free(void *ptr) {
+    if (!ptr || live_owns(ptr)) return;
+    free(ptr);
+}
+
+void *wwv_aligned_alloc(size_t alignment, size_t size) {
+    if (alignment < sizeof(void *)) alignment = sizeof(void *);
+    if (alignment & (alignment - 1)) return NULL;
+
+    wwv_arena_t *arena = g_active;
+    size_t a = alignment > WWV_ARENA_ALIGN ? alignment : WWV_ARENA_ALIGN;
+    if (arena && arena->base) return block_out(arena_take(arena, a, size), size);
+    if (arena) arena_tally(arena, a, size);
+
+#if defined(_WIN32)
+    return block_out(_aligned_malloc(size, alignment), size);
+#else
+    /* aligned_alloc wants a size that is a multiple of the alignment */
+    return block_out(aligned_alloc(alignment, align_up(size ? size : 1, alignment)), size);
+#endif
+}
+
+void *wwv_aligned_calloc(size_t alignment, size_t size) {
+    void *p = wwv_aligned_alloc(alignment, size);
+    if (p) memset(p, 0, size);
+    return p;
+}
+
+void wwv_aligned_free(void *ptr) {
+    if (!ptr || live_owns(ptr)) return;
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+/*============================================================================
+ * Prefaulting
+ *============================================================================*/
+
+bool wwv_alloc_set_prefault(bool on) {
+    bool prev = g_prefault;
+    g_prefault = on;
+    return prev;
+}
+
+size_t wwv_alloc_prefaulted(void) {
+    return g_prefaulted;
+}
+
+void wwv_prefault(void *ptr, size_t size) {
+    if (!ptr || size == 0) return;
+    /* A read alone can map the shared zero page; the write gets a page of its own */
+    volatile unsigned char *p = (volatile unsigned char *)ptr;
+    for (size_t off = 0; off < size; off += WWV_PAGE_SIZE) p[off] = p[off];
+    p[size - 1] = p[size - 1];
+}
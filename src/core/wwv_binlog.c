@@ -0,0 +1,643 @@
+/**
+ * @file wwv_binlog.c
+ * @brief Columnar binary event log writer and reader
+ *
+ * Rows are staged as 64-bit value bits (text in a small pool) and laid
+ * out by column only when a block is written, so append() is a copy. The
+ * reader decodes a whole block into the same staging form and hands out
+ * its rows in their original order.
+ */
+
+#include "wwv_binlog.h"
+#include "core/wwv_lz4.h"
+#include "wwv_arena.h"
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+/*============================================================================
+ * Internal Configuration
+ *============================================================================*/
+
+#define BINLOG_POOL_BYTES       8192    /* Block text; a full pool writes the block */
+#define BINLOG_MAX_CHUNK        (WWV_LZ4_BOUND(WWV_BINLOG_MAX_BLOCK_BYTES) + 64)
+#define BINLOG_MAX_FMT          4096
+#define BINLOG_DEC_LIMIT        1099511627776.0     /* 2^40 units */
+#define BINLOG_DEC_TIE          1e-3                /* Closest to a rounding tie kept */
+
+/* DEC column codec byte */
+#define BINLOG_DEC_BITS         0       /* Double bits, XOR coded */
+#define BINLOG_DEC_UNITS        1       /* Printed units << 1 | sign, difference coded */
+
+/* Rows of the widest types plus their text fit in one block */
+_Static_assert(WWV_BINLOG_BLOCK_ROWS * (2 + 8 + WWV_BINLOG_MAX_COLUMNS * 9) + BINLOG_POOL_BYTES +
+               WWV_BINLOG_MAX_TYPES * WWV_BINLOG_MAX_COLUMNS <= WWV_BINLOG_MAX_BLOCK_BYTES, "binlog block bound");
+_Static_assert(sizeof(wwv_binlog_header_t) == 24, "binlog header layout");
+_Static_assert(sizeof(wwv_binlog_chunk_t) == 8, "binlog chunk layout");
+
+typedef struct {
+    char *fmt;                      /* Writer: the caller's literal; reader: owned copy */
+    bool defined;
+    bool has_wall;
+    uint8_t columns;
+    uint8_t types[WWV_BINLOG_MAX_COLUMNS];
+} row_type_t;
+
+typedef struct {
+    uint16_t type;
+    int64_t wall;
+    uint64_t v[WWV_BINLOG_MAX_COLUMNS];     /* Value bits; STR: pool offset << 8 | length */
+} staged_row_t;
+
+struct wwv_binlog_writer {
+    FILE *file;
+    bool compress;
+    bool failed;                    /* A write failed: rows are dropped from then on */
+    row_type_t types[WWV_BINLOG_MAX_TYPES];
+    int type_count;
+    staged_row_t rows[WWV_BINLOG_BLOCK_ROWS];
+    int row_count;
+    char pool[BINLOG_POOL_BYTES];
+    size_t pool_used;
+    uint64_t column[WWV_BINLOG_BLOCK_ROWS];     /* One column of the block being laid out */
+    uint8_t raw[WWV_BINLOG_MAX_BLOCK_BYTES];
+    uint8_t packed[WWV_LZ4_BOUND(WWV_BINLOG_MAX_BLOCK_BYTES)];
+    wwv_binlog_stats_t stats;
+};
+
+struct wwv_binlog_reader {
+    FILE *file;
+    row_type_t types[WWV_BINLOG_MAX_TYPES];
+    staged_row_t rows[WWV_BINLOG_BLOCK_ROWS];
+    int row_count;
+    int next_row;
+    char *text;                     /* Last HEADER chunk */
+    uint64_t column[WWV_BINLOG_BLOCK_ROWS];
+    char pool[WWV_BINLOG_MAX_BLOCK_BYTES + WWV_BINLOG_BLOCK_ROWS * WWV_BINLOG_MAX_COLUMNS];
+    uint8_t raw[WWV_BINLOG_MAX_BLOCK_BYTES];
+    uint8_t chunk[BINLOG_MAX_CHUNK];
+    wwv_binlog_stats_t stats;
+};
+
+/*============================================================================
+ * Column Coding
+ *============================================================================*/
+
+static bool is_decimal(uint8_t type) {
+    return type >= WWV_BINLOG_DEC0 && type <= WWV_BINLOG_DEC0 + WWV_BINLOG_MAX_DECIMALS;
+}
+
+static size_t column_width(uint8_t type) {
+    if (is_decimal(type)) return 8;
+    switch (type) {
+        case WWV_BINLOG_I32:
+        case WWV_BINLOG_U32: return 4;
+        case WWV_BINLOG_I64:
+        case WWV_BINLOG_U64:
+        case WWV_BINLOG_F64: return 8;
+        default:             return 0;
+    }
+}
+
+static uint64_t width_mask(size_t width) {
+    return width == 4 ? 0xFFFFFFFFull : ~0ull;
+}
+
+/*
+ * Plain: n little-endian values. Coded: each value minus (F64: XOR) the
+ * previous, as byte planes (all low bytes, then all second bytes, ...)
+ */
+static void put_column(uint8_t *out, const uint64_t *x, int n, size_t width,
+                       bool coded, bool is_double) {
+    uint64_t mask = width_mask(width);
+    uint64_t prev = 0;
+    for (int i = 0; i < n; i++) {
+        uint64_t v = x[i] & mask;
+        uint64_t d = v;
+        if (coded) {
+            d = (is_double ? v ^ prev : v - prev) & mask;
+            prev = v;
+        }
+        for (size_t b = 0; b < width; b++) {
+            uint8_t byte = (uint8_t)(d >> (8 * b));
+            if (coded) out[b * (size_t)n + (size_t)i] = byte;
+            else out[(size_t)i * width + b] = byte;
+        }
+    }
+}
+
+static void get_column(const uint8_t *in, uint64_t *x, int n, size_t width,
+                       bool coded, bool is_double) {
+    uint64_t mask = width_mask(width);
+    uint64_t prev = 0;
+    for (int i = 0; i < n; i++) {
+        uint64_t d = 0;
+        for (size_t b = 0; b < width; b++) {
+            uint8_t byte = coded ? in[b * (size_t)n + (size_t)i] : in[(size_t)i * width + b];
+            d |= (uint64_t)byte << (8 * b);
+        }
+        if (coded) {
+            d = (is_double ? d ^ prev : d + prev) & mask;
+            prev = d;
+        }
+        x[i] = d;
+    }
+}
+
+static const double k_pow10[WWV_BINLOG_MAX_DECIMALS + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9
+};
+
+/*
+ * The value "%.Nf" prints, in units of 10^-N with the sign in bit 0 (so
+ * -0.0 survives and values either side of zero code close together).
+ * false where printf's rounding could differ from ours: NaN / inf, huge,
+ * or too near a tie for the scaled product's rounding error.
+ */
+static bool decimal_units(uint64_t bits, int decimals, uint64_t *units) {
+    double v;
+    memcpy(&v, &bits, sizeof(v));
+    if (!isfinite(v)) return false;
+    double s = fabs(v) * k_pow10[decimals];
+    if (s >= BINLOG_DEC_LIMIT) return false;
+    double whole = floor(s);
+    double frac = s - whole;
+    if (fabs(frac - 0.5) <= BINLOG_DEC_TIE) return false;
+    uint64_t k = (uint64_t)whole + (frac > 0.5 ? 1u : 0u);
+    *units = (k << 1) | (signbit(v) ? 1u : 0u);
+    return true;
+}
+
+static uint64_t decimal_bits(uint64_t units, int decimals) {
+    double v = (double)(units >> 1) / k_pow10[decimals];
+    if (units & 1) v = -v;
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+/*============================================================================
+ * Writer
+ *============================================================================*/
+
+static bool put(wwv_binlog_writer_t *w, const void *data, size_t length) {
+    if (w->failed) return false;
+    if (length > 0 && fwrite(data, 1, length, w->file) != length) {
+        w->failed = true;
+        return false;
+    }
+    w->stats.file_bytes += length;
+    return true;
+}
+
+static bool put_chunk(wwv_binlog_writer_t *w, uint8_t kind, uint8_t flags, size_t length) {
+    wwv_binlog_chunk_t chunk = {
+        .kind = kind,
+        .flags = flags,
+        .reserved = 0,
+        .length = (uint32_t)length
+    };
+    return put(w, &chunk, sizeof(chunk));
+}
+
+/* Lay the staged rows out by type and column; returns the payload length */
+static size_t encode_block(wwv_binlog_writer_t *w) {
+    uint64_t *x = w->column;
+    uint8_t *p = w->raw;
+    bool coded = w->compress;
+
+    for (int r = 0; r < w->row_count; r++) {
+        memcpy(p, &w->rows[r].type, sizeof(uint16_t));
+        p += sizeof(uint16_t);
+    }
+
+    for (int t = 0; t < w->type_count; t++) {
+        const row_type_t *rt = &w->types[t];
+        int n = 0;
+        for (int r = 0; r < w->row_count; r++) {
+            if (w->rows[r].type == t) x[n++] = (uint64_t)w->rows[r].wall;
+        }
+        if (n == 0) continue;
+
+        if (rt->has_wall) {
+            put_column(p, x, n, 8, coded, false);
+            p += (size_t)n * 8;
+        }
+        for (int c = 0; c < rt->columns; c++) {
+            int k = 0;
+            for (int r = 0; r < w->row_count; r++) {
+                if (w->rows[r].type == t) x[k++] = w->rows[r].v[c];
+            }
+            if (rt->types[c] == WWV_BINLOG_STR) {
+                for (int i = 0; i < n; i++) *p++ = (uint8_t)(x[i] & 0xFF);
+                for (int i = 0; i < n; i++) {
+                    size_t len = (size_t)(x[i] & 0xFF);
+                    memcpy(p, &w->pool[x[i] >> 8], len);
+                    p += len;
+                }
+                continue;
+            }
+            bool is_double = rt->types[c] == WWV_BINLOG_F64;
+            if (is_decimal(rt->types[c])) {
+                /* All of the block's values as units, or none */
+                int decimals = rt->types[c] - WWV_BINLOG_DEC0;
+                uint8_t codec = coded ? BINLOG_DEC_UNITS : BINLOG_DEC_BITS;
+                for (int i = 0; i < n && codec == BINLOG_DEC_UNITS; i++) {
+                    uint64_t units;
+                    if (!decimal_units(x[i], decimals, &units)) codec = BINLOG_DEC_BITS;
+                }
+                if (codec == BINLOG_DEC_UNITS) {
+                    for (int i = 0; i < n; i++) decimal_units(x[i], decimals, &x[i]);
+                }
+                *p++ = codec;
+                is_double = codec == BINLOG_DEC_BITS;
+            }
+            size_t width = column_width(rt->types[c]);
+            put_column(p, x, n, width, coded, is_double);
+            p += (size_t)n * width;
+        }
+    }
+    return (size_t)(p - w->raw);
+}
+
+wwv_binlog_writer_t *wwv_binlog_writer_create(FILE *file, bool compress) {
+    if (!file) return NULL;
+    wwv_binlog_writer_t *w = (wwv_binlog_writer_t *)wwv_calloc(1, sizeof(wwv_binlog_writer_t));
+    if (!w) return NULL;
+    w->file = file;
+    w->compress = compress;
+
+    wwv_binlog_header_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, WWV_BINLOG_MAGIC, sizeof(hdr.magic));
+    hdr.version = WWV_BINLOG_VERSION;
+    hdr.created = (int64_t)time(NULL);
+    put(w, &hdr, sizeof(hdr));
+    return w;
+}
+
+void wwv_binlog_writer_destroy(wwv_binlog_writer_t *w) {
+    if (!w) return;
+    wwv_binlog_flush(w);
+    wwv_free(w);
+}
+
+bool wwv_binlog_write_text(wwv_binlog_writer_t *w, const char *text, size_t length) {
+    if (!w || !text) return false;
+    wwv_binlog_flush(w);
+    return put_chunk(w, WWV_BINLOG_CHUNK_HEADER, 0, length) && put(w, text, length);
+}
+
+int wwv_binlog_find_type(const wwv_binlog_writer_t *w, const char *fmt, bool has_wall) {
+    if (!w) return -1;
+    for (int t = 0; t < w->type_count; t++) {
+        if (w->types[t].fmt == fmt && w->types[t].has_wall == has_wall) return t;
+    }
+    return -1;
+}
+
+int wwv_binlog_define_type(wwv_binlog_writer_t *w, const char *fmt, bool has_wall,
+                           int columns, const uint8_t *column_types) {
+    if (!w || !fmt || columns < 0 || columns > WWV_BINLOG_MAX_COLUMNS) return -1;
+    if (w->type_count >= WWV_BINLOG_MAX_TYPES) return -1;
+    size_t fmt_len = strlen(fmt);
+    if (fmt_len > BINLOG_MAX_FMT) return -1;
+
+    int id = w->type_count++;
+    row_type_t *rt = &w->types[id];
+    rt->fmt = (char *)fmt;
+    rt->defined = true;
+    rt->has_wall = has_wall;
+    rt->columns = (uint8_t)columns;
+    if (columns > 0) memcpy(rt->types, column_types, (size_t)columns);
+
+    wwv_binlog_schema_t schema = {
+        .type = (uint16_t)id,
+        .has_wall = has_wall ? 1 : 0,
+        .columns = (uint8_t)columns
+    };
+    put_chunk(w, WWV_BINLOG_CHUNK_SCHEMA, 0, sizeof(schema) + (size_t)columns + fmt_len);
+    put(w, &schema, sizeof(schema));
+    put(w, rt->types, (size_t)columns);
+    put(w, fmt, fmt_len);
+    return id;
+}
+
+bool wwv_binlog_append(wwv_binlog_writer_t *w, int type, int64_t wall,
+                       const wwv_binlog_value_t *values) {
+    if (!w || w->failed || type < 0 || type >= w->type_count) return false;
+    const row_type_t *rt = &w->types[type];
+
+    size_t text = 0;
+    for (int c = 0; c < rt->columns; c++) {
+        if (rt->types[c] != WWV_BINLOG_STR) continue;
+        size_t len = values[c].s ? strlen(values[c].s) : 0;
+        text += len > WWV_BINLOG_MAX_TEXT ? WWV_BINLOG_MAX_TEXT : len;
+    }
+    if (w->pool_used + text > BINLOG_POOL_BYTES) wwv_binlog_flush(w);
+
+    staged_row_t *row = &w->rows[w->row_count++];
+    row->type = (uint16_t)type;
+    row->wall = wall;
+    for (int c = 0; c < rt->columns; c++) {
+        switch (rt->types[c]) {
+            case WWV_BINLOG_I32:
+            case WWV_BINLOG_I64:
+                row->v[c] = (uint64_t)values[c].i;
+                break;
+            case WWV_BINLOG_STR: {
+                size_t len = values[c].s ? strlen(values[c].s) : 0;
+                if (len > WWV_BINLOG_MAX_TEXT) len = WWV_BINLOG_MAX_TEXT;
+                memcpy(&w->pool[w->pool_used], values[c].s ? values[c].s : "", len);
+                row->v[c] = ((uint64_t)w->pool_used << 8) | len;
+                w->pool_used += len;
+                break;
+            }
+            default:
+                if (rt->types[c] == WWV_BINLOG_F64 || is_decimal(rt->types[c])) {
+                    memcpy(&row->v[c], &values[c].d, sizeof(double));
+                } else {
+                    row->v[c] = values[c].u;
+                }
+                break;
+        }
+    }
+    w->stats.rows++;
+
+    if (w->row_count == WWV_BINLOG_BLOCK_ROWS) wwv_binlog_flush(w);
+    return !w->failed;
+}
+
+size_t wwv_binlog_flush(wwv_binlog_writer_t *w) {
+    if (!w || w->row_count == 0) return 0;
+    size_t rows = (size_t)w->row_count;
+    size_t raw_len = encode_block(w);
+
+    wwv_binlog_block_t block = {
+        .rows = (uint32_t)rows,
+        .raw_length = (uint32_t)raw_len
+    };
+    const void *payload = w->raw;
+    size_t payload_len = raw_len;
+    uint8_t flags = 0;
+    if (w->compress) {
+        /* packed holds the worst case, so this cannot run out of room */
+        int n = wwv_lz4_compress(w->raw, (int)raw_len, w->packed, (int)sizeof(w->packed));
+        payload = w->packed;
+        payload_len = (size_t)n;
+        flags = WWV_BINLOG_BLOCK_LZ4;
+    }
+
+    put_chunk(w, WWV_BINLOG_CHUNK_BLOCK, flags, sizeof(block) + payload_len);
+    put(w, &block, sizeof(block));
+    put(w, payload, payload_len);
+
+    w->stats.blocks++;
+    w->stats.raw_bytes += raw_len;
+    w->row_count = 0;
+    w->pool_used = 0;
+    return rows;
+}
+
+void wwv_binlog_writer_get_stats(const wwv_binlog_writer_t *w, wwv_binlog_stats_t *out) {
+    if (!out) return;
+    if (w) *out = w->stats;
+    else memset(out, 0, sizeof(*out));
+}
+
+/*============================================================================
+ * Reader
+ *============================================================================*/
+
+static bool get(wwv_binlog_reader_t *r, void *data, size_t length) {
+    if (length > 0 && fread(data, 1, length, r->file) != length) return false;
+    r->stats.file_bytes += length;
+    return true;
+}
+
+static bool read_schema(wwv_binlog_reader_t *r, const uint8_t *p, size_t length) {
+    wwv_binlog_schema_t schema;
+    if (length < sizeof(schema)) return false;
+    memcpy(&schema, p, sizeof(schema));
+    if (schema.type >= WWV_BINLOG_MAX_TYPES || schema.columns > WWV_BINLOG_MAX_COLUMNS) return false;
+    if (length < sizeof(schema) + schema.columns) return false;
+    size_t fmt_len = length - sizeof(schema) - schema.columns;
+    if (fmt_len > BINLOG_MAX_FMT) return false;
+
+    row_type_t *rt = &r->types[schema.type];
+    char *fmt = (char *)wwv_malloc(fmt_len + 1);
+    if (!fmt) return false;
+    memcpy(fmt, p + sizeof(schema) + schema.columns, fmt_len);
+    fmt[fmt_len] = '\0';
+
+    wwv_free(rt->fmt);
+    rt->fmt = fmt;
+    rt->defined = true;
+    rt->has_wall = schema.has_wall != 0;
+    rt->columns = schema.columns;
+    memcpy(rt->types, p + sizeof(schema), schema.columns);
+    for (int c = 0; c < rt->columns; c++) {
+        if ((rt->types[c] < WWV_BINLOG_I32 || rt->types[c] > WWV_BINLOG_STR) &&
+            !is_decimal(rt->types[c])) return false;
+    }
+    return true;
+}
+
+static bool decode_block(wwv_binlog_reader_t *r, const uint8_t *raw, size_t raw_len,
+                         int rows, bool coded) {
+    uint64_t *x = r->column;
+    const uint8_t *p = raw;
+    const uint8_t *end = raw + raw_len;
+    int count[WWV_BINLOG_MAX_TYPES] = {0};
+    size_t pool_used = 0;
+
+    if ((size_t)(end - p) < (size_t)rows * sizeof(uint16_t)) return false;
+    for (int i = 0; i < rows; i++) {
+        uint16_t type;
+        memcpy(&type, p, sizeof(type));
+        p += sizeof(type);
+        if (type >= WWV_BINLOG_MAX_TYPES || !r->types[type].defined) return false;
+        r->rows[i].type = type;
+        count[type]++;
+    }
+
+    for (int t = 0; t < WWV_BINLOG_MAX_TYPES; t++) {
+        const row_type_t *rt = &r->types[t];
+        int n = count[t];
+        if (n == 0) continue;
+
+        if (rt->has_wall) {
+            if ((size_t)(end - p) < (size_t)n * 8) return false;
+            get_column(p, x, n, 8, coded, false);
+            p += (size_t)n * 8;
+            for (int i = 0, k = 0; i < rows; i++) {
+                if (r->rows[i].type == t) r->rows[i].wall = (int64_t)x[k++];
+            }
+        } else {
+            for (int i = 0; i < rows; i++) {
+                if (r->rows[i].type == t) r->rows[i].wall = 0;
+            }
+        }
+
+        for (int c = 0; c < rt->columns; c++) {
+            if (rt->types[c] == WWV_BINLOG_STR) {
+                if (end - p < n) return false;
+                const uint8_t *lengths = p;
+                p += n;
+                for (int k = 0; k < n; k++) {
+                    size_t len = lengths[k];
+                    if ((size_t)(end - p) < len) return false;
+                    memcpy(&r->pool[pool_used], p, len);
+                    r->pool[pool_used + len] = '\0';
+                    x[k] = pool_used;
+                    pool_used += len + 1;
+                    p += len;
+                }
+            } else {
+                bool is_double = rt->types[c] == WWV_BINLOG_F64;
+                uint8_t codec = BINLOG_DEC_BITS;
+                if (is_decimal(rt->types[c])) {
+                    if (p == end) return false;
+                    codec = *p++;
+                    if (codec != BINLOG_DEC_BITS && codec != BINLOG_DEC_UNITS) return false;
+                    is_double = codec == BINLOG_DEC_BITS;
+                }
+                size_t width = column_width(rt->types[c]);
+                if ((size_t)(end - p) < (size_t)n * width) return false;
+                get_column(p, x, n, width, coded, is_double);
+                p += (size_t)n * width;
+                if (codec == BINLOG_DEC_UNITS) {
+                    int decimals = rt->types[c] - WWV_BINLOG_DEC0;
+                    for (int k = 0; k < n; k++) x[k] = decimal_bits(x[k], decimals);
+                }
+            }
+            for (int i = 0, k = 0; i < rows; i++) {
+                if (r->rows[i].type == t) r->rows[i].v[c] = x[k++];
+            }
+        }
+    }
+    return p == end;
+}
+
+static bool read_block(wwv_binlog_reader_t *r, const uint8_t *p, size_t length, uint8_t flags) {
+    wwv_binlog_block_t block;
+    if (length < sizeof(block)) return false;
+    memcpy(&block, p, sizeof(block));
+    if (block.rows == 0 || block.rows > WWV_BINLOG_BLOCK_ROWS ||
+        block.raw_length > WWV_BINLOG_MAX_BLOCK_BYTES) return false;
+
+    const uint8_t *payload = p + sizeof(block);
+    size_t payload_len = length - sizeof(block);
+    bool coded = (flags & WWV_BINLOG_BLOCK_LZ4) != 0;
+    if (coded) {
+        int n = wwv_lz4_decompress(payload, (int)payload_len, r->raw, (int)sizeof(r->raw));
+        if (n != (int)block.raw_length) return false;
+        payload = r->raw;
+    } else if (payload_len != block.raw_length) {
+        return false;
+    }
+
+    if (!decode_block(r, payload, block.raw_length, (int)block.rows, coded)) return false;
+    r->row_count = (int)block.rows;
+    r->next_row = 0;
+    r->stats.blocks++;
+    r->stats.raw_bytes += block.raw_length;
+    return true;
+}
+
+static void fill_row(wwv_binlog_reader_t *r, const staged_row_t *s, wwv_binlog_row_t *row) {
+    const row_type_t *rt = &r->types[s->type];
+    memset(row, 0, sizeof(*row));
+    row->type = s->type;
+    row->fmt = rt->fmt;
+    row->has_wall = rt->has_wall;
+    row->wall = s->wall;
+    row->columns = rt->columns;
+    row->column_types = rt->types;
+    for (int c = 0; c < rt->columns; c++) {
+        switch (rt->types[c]) {
+            case WWV_BINLOG_I32: row->values[c].i = (int32_t)(uint32_t)s->v[c]; break;
+            case WWV_BINLOG_I64: row->values[c].i = (int64_t)s->v[c]; break;
+            case WWV_BINLOG_STR: row->values[c].s = &r->pool[s->v[c]]; break;
+            default:
+                if (rt->types[c] == WWV_BINLOG_F64 || is_decimal(rt->types[c])) {
+                    memcpy(&row->values[c].d, &s->v[c], sizeof(double));
+                } else {
+                    row->values[c].u = s->v[c];
+                }
+                break;
+        }
+    }
+}
+
+wwv_binlog_reader_t *wwv_binlog_reader_open(const char *path) {
+    if (!path) return NULL;
+    wwv_binlog_reader_t *r = (wwv_binlog_reader_t *)wwv_calloc(1, sizeof(wwv_binlog_reader_t));
+    if (!r) return NULL;
+    r->file = fopen(path, "rb");
+
+    wwv_binlog_header_t hdr;
+    if (!r->file || !get(r, &hdr, sizeof(hdr)) ||
+        memcmp(hdr.magic, WWV_BINLOG_MAGIC, sizeof(hdr.magic)) != 0 ||
+        hdr.version != WWV_BINLOG_VERSION) {
+        wwv_binlog_reader_close(r);
+        return NULL;
+    }
+    return r;
+}
+
+void wwv_binlog_reader_close(wwv_binlog_reader_t *r) {
+    if (!r) return;
+    if (r->file) fclose(r->file);
+    for (int t = 0; t < WWV_BINLOG_MAX_TYPES; t++) wwv_free(r->types[t].fmt);
+    wwv_free(r->text);
+    wwv_free(r);
+}
+
+int wwv_binlog_read(wwv_binlog_reader_t *r, wwv_binlog_row_t *row) {
+    if (!r || !row) return -1;
+
+    for (;;) {
+        if (r->next_row < r->row_count) {
+            fill_row(r, &r->rows[r->next_row++], row);
+            r->stats.rows++;
+            return 1;
+        }
+
+        wwv_binlog_chunk_t chunk;
+        size_t got = fread(&chunk, 1, sizeof(chunk), r->file);
+        if (got == 0 && feof(r->file)) return 0;
+        if (got != sizeof(chunk)) return -1;
+        r->stats.file_bytes += sizeof(chunk);
+
+        if (chunk.kind == WWV_BINLOG_CHUNK_HEADER) {
+            wwv_free(r->text);
+            r->text = (char *)wwv_malloc((size_t)chunk.length + 1);
+            if (!r->text || !get(r, r->text, chunk.length)) return -1;
+            r->text[chunk.length] = '\0';
+            memset(row, 0, sizeof(*row));
+            row->text = r->text;
+            row->text_length = chunk.length;
+            row->type = -1;
+            return 1;
+        }
+
+        if (chunk.kind != WWV_BINLOG_CHUNK_SCHEMA && chunk.kind != WWV_BINLOG_CHUNK_BLOCK) {
+            if (fseek(r->file, (long)chunk.length, SEEK_CUR) != 0) return -1;
+            r->stats.file_bytes += chunk.length;
+            continue;
+        }
+
+        if (chunk.length > sizeof(r->chunk) || !get(r, r->chunk, chunk.length)) return -1;
+        bool ok = (chunk.kind == WWV_BINLOG_CHUNK_SCHEMA)
+                      ? read_schema(r, r->chunk, chunk.length)
+                      : read_block(r, r->chunk, chunk.length, chunk.flags);
+        if (!ok) return -1;
+    }
+}
+
+void wwv_binlog_reader_get_stats(const wwv_binlog_reader_t *r, wwv_binlog_stats_t *out) {
+    if (!out) return;
+    if (r) *out = r->stats;
+    else memset(out, 0, sizeof(*out));
+}
@@ -4,6 +4,9 @@
  */
 
 #include "wwv_clock.h"
+#include "wwv_thread.h"
+#include "wwv_arena.h"
+#include <math.h>
 #include <stdlib.h>
 #include <time.h>
 
@@ -33,7 +36,7 @@
 struct wwv_clock {
     wwv_station_t station;
     wwv_clock_mode_t mode;
-    float anchor_ms;        /* Last minute marker timestamp (relative mode) */
+    double anchor_ms;       /* Last minute marker timestamp (relative mode) */
 };
 
 /*============================================================================
@@ -79,7 +82,7 @@ static wwv_event_type_t get_event_type(int second, int minute) {
  *============================================================================*/
 
 wwv_clock_t *wwv_clock_create(wwv_station_t station) {
-    wwv_clock_t *clk = (wwv_clock_t *)calloc(1, sizeof(wwv_clock_t));
+    wwv_clock_t *clk = (wwv_clock_t *)wwv_calloc(1, sizeof(wwv_clock_t));
     if (!clk) return NULL;
 
     clk->station = station;
@@ -89,12 +92,12 @@ wwv_clock_t *wwv_clock_create(wwv_station_t station) {
 }
 
 void wwv_clock_destroy(wwv_clock_t *clk) {
-    free(clk);
+    wwv_free(clk);
 }
 
 wwv_time_t wwv_clock_now(wwv_clock_t *clk) {
     time_t now = time(NULL);
-    struct tm *tm = localtime(&now);
+    struct tm *tm = wwv_localtime(&now);
 
     return wwv_clock_at(clk, tm->tm_sec, tm->tm_min, tm->tm_hour);
 }
@@ -154,7 +157,7 @@ wwv_clock_mode_t wwv_clock_get_mode(wwv_clock_t *clk) {
     return clk->mode;
 }
 
-void wwv_clock_set_anchor(wwv_clock_t *clk, float anchor_ms) {
+void wwv_clock_set_anchor(wwv_clock_t *clk, double anchor_ms) {
     if (!clk) return;
     clk->anchor_ms = anchor_ms;
 }
@@ -167,11 +170,11 @@ float wwv_clock_get_frame_phase_ms(wwv_clock_t *clk) {
         /* Note: Caller must provide current time for this to work properly.
          * For now, return 0 as placeholder - will be updated when caller
          * provides current_ms parameter in future enhancement. */
-        return 0.0f;  /* TODO: Needs current_ms parameter */
+        return 0.0f;  /* Stream time needed: wwv_clock_get_phase_at_ms() */
     } else {
         /* Absolute mode - use system time */
         time_t now_sec = time(NULL);
-        struct tm *tm = localtime(&now_sec);
+        struct tm *tm = wwv_localtime(&now_sec);
 
         /* Calculate milliseconds into current minute */
         float phase_ms = (float)(tm->tm_sec * 1000);
@@ -183,11 +186,18 @@ float wwv_clock_get_frame_phase_ms(wwv_clock_t *clk) {
     }
 }
 
+double wwv_clock_get_phase_at_ms(const wwv_clock_t *clk, double now_ms) {
+    if (!clk || clk->mode != WWV_CLOCK_MODE_RELATIVE || clk->anchor_ms <= 0.0) return -1.0;
+
+    double phase = fmod(now_ms - clk->anchor_ms, 60000.0);
+    return (phase < 0.0) ? phase + 60000.0 : phase;
+}
+
 bool wwv_clock_is_special_minute(wwv_clock_t *clk) {
     if (!clk) return false;
 
     time_t now = time(NULL);
-    struct tm *tm = localtime(&now);
+    struct tm *tm = wwv_localtime(&now);
     int minute = tm->tm_min;
 
     /* Special minutes: station ID (0, 29, 30, 59) and geoalerts (18, 48) */
@@ -0,0 +1,760 @@
+/**
+ * @file wwv_csv_log.c
+ * @brief Asynchronous batched CSV logging service
+ *
+ * Each stream owns an SPSC ring of log_record_t. Producers capture
+ * arguments by walking the format's conversion specs (no number
+ * formatting); strings are copied into the record's small text pool. The writer thread is the only consumer; it drains every
+ * stream under g_lock, so close() can drain a stream itself and remove it
+ * without racing the writer.
+ *
+ * A binary stream hands the same records to a wwv_binlog writer, one row
+ * type per format string, and convert() rebuilds records from a binary
+ * file and renders them with the text path's write_record().
+ */
+
+#include "wwv_csv_log.h"
+#include "wwv_binlog.h"
+#include "wwv_spsc_ring.h"
+#include "wwv_thread.h"
+#include "wwv_arena.h"
+#include "wwv_trace.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================
+ * Records
+ *============================================================================*/
+
+typedef enum {
+    ARG_INT,
+    ARG_UINT,
+    ARG_LONG,
+    ARG_ULONG,
+    ARG_LLONG,
+    ARG_ULLONG,
+    ARG_SIZE,
+    ARG_DOUBLE,
+    ARG_STRING
+} arg_type_t;
+
+typedef union {
+    long long ll;
+    unsigned long long ull;
+    double d;
+    size_t text_ofs;                /* %s: offset into log_record_t.text */
+} log_arg_t;
+
+typedef struct {
+    const char *fmt;
+    time_t wall;                    /* Valid if has_wall */
+    bool has_wall;
+    uint8_t argc;
+    uint8_t text_len;
+    log_arg_t args[WWV_CSV_MAX_ARGS];
+    char text[WWV_CSV_TEXT_BYTES];  /* Copied %s arguments, NUL separated */
+} log_record_t;
+
+#define LOG_PATH_BYTES      512
+
+struct wwv_csv_log {
+    FILE *file;                     /* NULL while a rotated file failed to open */
+    wwv_binlog_writer_t *bin;       /* Binary format */
+    wwv_spsc_ring_t *ring;          /* NULL in synchronous mode */
+    bool rows_started;
+    bool dirty;                     /* Written since last fflush (writer only) */
+    uint64_t dropped;
+    uint64_t lost;                  /* Rows with no file to go to (writer side) */
+    uint64_t rotations;
+    wwv_perf_t *perf;
+    struct wwv_csv_log *next;
+
+    /* Files, fixed at open */
+    wwv_csv_log_format_t format;
+    bool compress;
+    unsigned rotate_seconds;
+    time_t rotate_at;               /* Next file boundary, 0 = never */
+    char base[LOG_PATH_BYTES];      /* Path without its extension */
+    const char *ext;
+    char path[LOG_PATH_BYTES + 64]; /* Current file */
+    char header[WWV_CSV_HEADER_BYTES];
+    size_t header_len;
+};
+
+/*============================================================================
+ * Service State
+ *============================================================================*/
+
+static wwv_mutex_t g_lock = WWV_MUTEX_INITIALIZER;
+static wwv_csv_log_config_t g_config = WWV_CSV_LOG_CONFIG_DEFAULT;
+static wwv_csv_log_t *g_streams = NULL;
+static int g_open_streams = 0;
+
+static wwv_thread_t g_writer;
+static bool g_writer_running = false;
+static bool g_writer_stop = false;
+static wwv_cond_t g_writer_wake;
+static wwv_cond_t g_writer_idle;
+static bool g_cond_ready = false;
+static unsigned g_flush_request = 0;      /* Bumped by flush_all() */
+static unsigned g_flush_done = 0;
+
+static uint64_t g_rows_written = 0;
+static uint64_t g_rows_dropped = 0;
+static uint64_t g_flushes = 0;
+static uint64_t g_rotations = 0;
+
+/*============================================================================
+ * Format Walking
+ *============================================================================*/
+
+/**
+ * Parse one conversion spec starting just after '%'
+ * @param spec_end Set to one past the conversion character
+ * @return Argument type, or -1 for "%%" / unsupported
+ */
+static int parse_spec(const char *p, const char **spec_end) {
+    while (*p && strchr("-+ #0", *p)) p++;
+    while (*p >= '0' && *p <= '9') p++;
+    if (*p == '.') {
+        p++;
+        while (*p >= '0' && *p <= '9') p++;
+    }
+
+    int longs = 0;
+    bool size_mod = false;
+    while (*p == 'h' || *p == 'l' || *p == 'z') {
+        if (*p == 'l') longs++;
+        if (*p == 'z') size_mod = true;
+        p++;
+    }
+
+    char conv = *p;
+    *spec_end = conv ? p + 1 : p;
+
+    bool is_signed = (conv == 'd' || conv == 'i');
+    switch (conv) {
+        case 'd': case 'i': case 'u': case 'x': case 'X':
+            if (size_mod) return ARG_SIZE;
+            if (longs >= 2) return is_signed ? ARG_LLONG : ARG_ULLONG;
+            if (longs == 1) return is_signed ? ARG_LONG : ARG_ULONG;
+            return is_signed ? ARG_INT : ARG_UINT;
+        case 'c':
+            return ARG_INT;
+        case 'f': case 'e': case 'g': case 'F': case 'E': case 'G':
+            return ARG_DOUBLE;
+        case 's':
+            return ARG_STRING;
+        default:
+            return -1;
+    }
+}
+
+static void capture_args(log_record_t *rec, const char *fmt, va_list ap) {
+    rec->fmt = fmt;
+    rec->argc = 0;
+    rec->text_len = 0;
+
+    for (const char *p = fmt; *p; ) {
+        if (*p++ != '%') continue;
+        if (*p == '%') { p++; continue; }
+
+        const char *end;
+        int type = parse_spec(p, &end);
+        p = end;
+        if (type < 0 || rec->argc >= WWV_CSV_MAX_ARGS) continue;
+
+        log_arg_t *a = &rec->args[rec->argc++];
+        switch (type) {
+            case ARG_INT:    a->ll = va_arg(ap, int); break;
+            case ARG_UINT:   a->ull = va_arg(ap, unsigned int); break;
+            case ARG_LONG:   a->ll = va_arg(ap, long); break;
+            case ARG_ULONG:  a->ull = va_arg(ap, unsigned long); break;
+            case ARG_LLONG:  a->ll = va_arg(ap, long long); break;
+            case ARG_ULLONG: a->ull = va_arg(ap, unsigned long long); break;
+            case ARG_SIZE:   a->ull = va_arg(ap, size_t); break;
+            case ARG_DOUBLE: a->d = va_arg(ap, double); break;
+            case ARG_STRING: {
+                const char *str = va_arg(ap, const char *);
+                size_t room = WWV_CSV_TEXT_BYTES - rec->text_len;
+                size_t n = str ? strlen(str) : 0;
+                if (n >= room) n = room ? room - 1 : 0;   /* Truncate to pool */
+                a->text_ofs = rec->text_len;
+                if (room) {
+                    memcpy(&rec->text[rec->text_len], str ? str : "", n);
+                    rec->text[rec->text_len + n] = '\0';
+                    rec->text_len += (uint8_t)(n + 1);
+                } else {
+                    a->text_ofs = WWV_CSV_TEXT_BYTES - 1;
+                }
+                break;
+            }
+        }
+    }
+}
+
+/*
+ * Render HH:MM:SS, reusing the previous result within the same second.
+ * Per thread: the writer thread and synchronous streams written from the
+ * detector and display workers all come through here.
+ */
+static void write_wall(FILE *f, time_t wall) {
+    static _Thread_local time_t cached_wall = (time_t)-1;
+    static _Thread_local char cached[16];
+
+    if (wall != cached_wall) {
+        struct tm *tm_info = wwv_localtime(&wall);
+        if (!tm_info || strftime(cached, sizeof(cached), "%H:%M:%S", tm_info) == 0) {
+            cached[0] = '\0';
+        }
+        cached_wall = wall;
+    }
+    fputs(cached, f);
+    fputc(',', f);
+}
+
+static void write_record(FILE *f, const log_record_t *rec) {
+    char spec[32];
+    int arg = 0;
+
+    if (rec->has_wall) write_wall(f, rec->wall);
+
+    const char *p = rec->fmt;
+    while (*p) {
+        const char *pct = strchr(p, '%');
+        if (!pct) {
+            fputs(p, f);
+            break;
+        }
+        fwrite(p, 1, (size_t)(pct - p), f);
+
+        if (pct[1] == '%') {
+            fputc('%', f);
+            p = pct + 2;
+            continue;
+        }
+
+        const char *end;
+        int type = parse_spec(pct + 1, &end);
+        size_t len = (size_t)(end - pct);
+        p = end;
+        if (type < 0 || arg >= rec->argc || len >= sizeof(spec)) continue;
+
+        memcpy(spec, pct, len);
+        spec[len] = '\0';
+        const log_arg_t *a = &rec->args[arg++];
+
+        /* Re-issue the spec exactly as written with its captured value */
+        switch (type) {
+            case ARG_INT:    fprintf(f, spec, (int)a->ll); break;
+            case ARG_UINT:   fprintf(f, spec, (unsigned int)a->ull); break;
+            case ARG_LONG:   fprintf(f, spec, (long)a->ll); break;
+            case ARG_ULONG:  fprintf(f, spec, (unsigned long)a->ull); break;
+            case ARG_LLONG:  fprintf(f, spec, a->ll); break;
+            case ARG_ULLONG: fprintf(f, spec, a->ull); break;
+            case ARG_SIZE:   fprintf(f, spec, (size_t)a->ull); break;
+            case ARG_DOUBLE: fprintf(f, spec, a->d); break;
+            case ARG_STRING: fprintf(f, spec, &rec->text[a->text_ofs]); break;
+        }
+    }
+}
+
+/*============================================================================
+ * Binary Rows
+ *============================================================================*/
+
+static uint8_t column_type(int arg_type) {
+    switch (arg_type) {
+        case ARG_INT:    return WWV_BINLOG_I32;
+        case ARG_UINT:   return WWV_BINLOG_U32;
+        case ARG_LONG:
+        case ARG_LLONG:  return WWV_BINLOG_I64;
+        case ARG_DOUBLE: return WWV_BINLOG_F64;
+        case ARG_STRING: return WWV_BINLOG_STR;
+        default:         return WWV_BINLOG_U64;
+    }
+}
+
+static bool is_double_column(uint8_t type) {
+    return type == WWV_BINLOG_F64 ||
+           (type >= WWV_BINLOG_DEC0 && type <= WWV_BINLOG_DEC0 + WWV_BINLOG_MAX_DECIMALS);
+}
+
+/* "%.Nf" / "%f" doubles are DEC columns: the digits the text shows */
+static uint8_t double_column(const char *spec, const char *end) {
+    char conv = end[-1];
+    if (conv != 'f' && conv != 'F') return WWV_BINLOG_F64;
+    const char *dot = memchr(spec, '.', (size_t)(end - spec));
+    int decimals = dot ? atoi(dot + 1) : 6;
+    if (decimals > WWV_BINLOG_MAX_DECIMALS) return WWV_BINLOG_F64;
+    return (uint8_t)(WWV_BINLOG_DEC0 + decimals);
+}
+
+/* Column types of a format, as capture_args() walks it */
+static int format_columns(const char *fmt, uint8_t *types) {
+    int n = 0;
+    for (const char *p = fmt; *p; ) {
+        if (*p++ != '%') continue;
+        if (*p == '%') { p++; continue; }
+
+        const char *end;
+        int type = parse_spec(p, &end);
+        const char *spec = p;
+        p = end;
+        if (type < 0 || n >= WWV_CSV_MAX_ARGS) continue;
+        types[n++] = type == ARG_DOUBLE ? double_column(spec, end) : column_type(type);
+    }
+    return n;
+}
+
+static bool write_binary(wwv_csv_log_t *log, const log_record_t *rec) {
+    uint8_t types[WWV_CSV_MAX_ARGS];
+    int type = wwv_binlog_find_type(log->bin, rec->fmt, rec->has_wall);
+    if (type < 0) {
+        int n = format_columns(rec->fmt, types);
+        type = wwv_binlog_define_type(log->bin, rec->fmt, rec->has_wall, n, types);
+        if (type < 0) return false;
+    } else {
+        format_columns(rec->fmt, types);
+    }
+
+    wwv_binlog_value_t values[WWV_CSV_MAX_ARGS];
+    for (int i = 0; i < rec->argc; i++) {
+        const log_arg_t *a = &rec->args[i];
+        switch (types[i]) {
+            case WWV_BINLOG_I32:
+            case WWV_BINLOG_I64: values[i].i = a->ll; break;
+            case WWV_BINLOG_STR: values[i].s = &rec->text[a->text_ofs]; break;
+            default:
+                if (is_double_column(types[i])) values[i].d = a->d;
+                else values[i].u = a->ull;
+                break;
+        }
+    }
+    return wwv_binlog_append(log->bin, type, rec->has_wall ? (int64_t)rec->wall : 0, values);
+}
+
+static bool store_record(wwv_csv_log_t *log, const log_record_t *rec) {
+    if (log->bin) return write_binary(log, rec);
+    if (!log->file) return false;
+    write_record(log->file, rec);
+    return true;
+}
+
+/*============================================================================
+ * Files
+ *============================================================================*/
+
+static void segment_path(wwv_csv_log_t *log, time_t start) {
+    if (!log->rotate_seconds) {
+        snprintf(log->path, sizeof(log->path), "%s%s", log->base, log->ext);
+        return;
+    }
+    char stamp[32] = "";
+    struct tm *tm_info = wwv_localtime(&start);
+    if (tm_info) strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", tm_info);
+    snprintf(log->path, sizeof(log->path), "%s-%s%s", log->base, stamp, log->ext);
+}
+
+/* Open the file holding now and repeat the header text into it */
+static bool open_segment(wwv_csv_log_t *log, time_t now) {
+    time_t start = now;
+    if (log->rotate_seconds) {
+        start = now - now % (time_t)log->rotate_seconds;
+        log->rotate_at = start + (time_t)log->rotate_seconds;
+    }
+    segment_path(log, start);
+
+    bool binary = (log->format == WWV_CSV_LOG_BINARY);
+    log->file = fopen(log->path, binary ? "wb" : "w");
+    if (!log->file) return false;
+
+    if (binary) {
+        log->bin = wwv_binlog_writer_create(log->file, log->compress);
+        if (!log->bin) {
+            fclose(log->file);
+            log->file = NULL;
+            return false;
+        }
+        if (log->header_len) wwv_binlog_write_text(log->bin, log->header, log->header_len);
+    } else if (log->header_len) {
+        fwrite(log->header, 1, log->header_len, log->file);
+    }
+    return true;
+}
+
+static void close_segment(wwv_csv_log_t *log) {
+    wwv_binlog_writer_destroy(log->bin);
+    log->bin = NULL;
+    if (log->file) fclose(log->file);
+    log->file = NULL;
+}
+
+/* Writer thread (async) or producer (sync) */
+static void rotate_if_due(wwv_csv_log_t *log, time_t now) {
+    if (!log->rotate_at || now < log->rotate_at) return;
+    close_segment(log);
+    open_segment(log, now);
+    log->rotations++;
+}
+
+/*============================================================================
+ * Writer Thread
+ *============================================================================*/
+
+/* Caller holds g_lock */
+static size_t drain_stream(wwv_csv_log_t *log) {
+    log_record_t rec;
+    size_t n = 0;
+
+    while (wwv_spsc_ring_read(log->ring, &rec, 1) == 1) {
+        if (store_record(log, &rec)) n++;
+        else log->lost++;
+    }
+    if (n) log->dirty = true;
+    g_rows_written += n;
+    return n;
+}
+
+static void flush_blocks(void) {
+    for (wwv_csv_log_t *s = g_streams; s; s = s->next) {
+        if (s->bin && wwv_binlog_flush(s->bin) > 0) s->dirty = true;
+    }
+}
+
+static void flush_dirty(void) {
+    WWV_TRACE_BEGIN(tr);
+    uint64_t flushes = g_flushes;
+    for (wwv_csv_log_t *s = g_streams; s; s = s->next) {
+        if (s->dirty) {
+            if (s->file) fflush(s->file);
+            s->dirty = false;
+            g_flushes++;
+        }
+    }
+    if (g_flushes != flushes) WWV_TRACE_END("log", "flush", tr, WWV_TRACE_NO_SAMPLE);
+}
+
+static void writer_main(void *arg) {
+    (void)arg;
+    unsigned since_flush_ms = 0;
+    unsigned since_block_ms = 0;
+    WWV_TRACE_THREAD("csv_log");
+
+    wwv_mutex_lock(&g_lock);
+    for (;;) {
+        WWV_TRACE_BEGIN(tr);
+        size_t rows = 0;
+        time_t now = time(NULL);
+        for (wwv_csv_log_t *s = g_streams; s; s = s->next) {
+            if (!s->ring) continue;
+            rotate_if_due(s, now);
+            rows += drain_stream(s);
+        }
+        if (rows) WWV_TRACE_END("log", "write", tr, WWV_TRACE_NO_SAMPLE);
+
+        since_flush_ms += g_config.poll_interval_ms;
+        since_block_ms += g_config.poll_interval_ms;
+        bool flush_requested = (g_flush_request != g_flush_done);
+        if (since_block_ms >= g_config.block_ms || flush_requested || g_writer_stop) {
+            flush_blocks();
+            since_block_ms = 0;
+        }
+        if (since_flush_ms >= g_config.flush_interval_ms || flush_requested || g_writer_stop) {
+            flush_dirty();
+            since_flush_ms = 0;
+        }
+        if (flush_requested) {
+            g_flush_done = g_flush_request;
+            wwv_cond_broadcast(&g_writer_idle);
+        }
+
+        if (g_writer_stop) break;
+        wwv_cond_timedwait_ms(&g_writer_wake, &g_lock, g_config.poll_interval_ms);
+    }
+    wwv_mutex_unlock(&g_lock);
+}
+
+/* Caller holds g_lock */
+static bool writer_start_locked(void) {
+    if (g_writer_running) return true;
+
+    if (!g_cond_ready) {
+        wwv_cond_init(&g_writer_wake);
+        wwv_cond_init(&g_writer_idle);
+        g_cond_ready = true;
+    }
+    g_writer_stop = false;
+    g_writer_running = wwv_thread_create(&g_writer, writer_main, NULL);
+    return g_writer_running;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+void wwv_csv_log_configure(const wwv_csv_log_config_t *config) {
+    if (!config) return;
+    wwv_mutex_lock(&g_lock);
+    g_config = *config;
+    if (g_config.poll_interval_ms == 0) g_config.poll_interval_ms = 1;
+    if (g_config.ring_records == 0) g_config.ring_records = 1;
+    wwv_mutex_unlock(&g_lock);
+}
+
+wwv_csv_log_t *wwv_csv_log_open(const char *path) {
+    if (!path) return NULL;
+    size_t len = strlen(path);
+    if (len + 32 >= LOG_PATH_BYTES) return NULL;    /* Room for a rotation stamp */
+
+    wwv_csv_log_t *log = (wwv_csv_log_t *)wwv_calloc(1, sizeof(*log));
+    if (!log) return NULL;
+
+    wwv_mutex_lock(&g_lock);
+    log->format = g_config.format;
+    log->compress = g_config.compress;
+    log->rotate_seconds = g_config.rotate_seconds;
+    wwv_mutex_unlock(&g_lock);
+
+    bool csv_ext = len >= 4 && strcmp(path + len - 4, ".csv") == 0;
+    memcpy(log->base, path, csv_ext ? len - 4 : len);
+    if (log->format == WWV_CSV_LOG_BINARY) log->ext = ".wlog";
+    else log->ext = csv_ext ? ".csv" : "";
+
+    if (!open_segment(log, time(NULL))) {
+        wwv_free(log);
+        return NULL;
+    }
+
+    wwv_mutex_lock(&g_lock);
+    if (g_config.async && writer_start_locked()) {
+        log->ring = wwv_spsc_ring_create(sizeof(log_record_t), g_config.ring_records);
+    }
+    log->next = g_streams;
+    g_streams = log;
+    g_open_streams++;
+    wwv_mutex_unlock(&g_lock);
+
+    return log;
+}
+
+void wwv_csv_log_close(wwv_csv_log_t *log) {
+    if (!log) return;
+
+    wwv_mutex_lock(&g_lock);
+    if (log->ring) drain_stream(log);
+    g_rows_dropped += log->dropped + log->lost;
+    g_rotations += log->rotations;
+
+    wwv_csv_log_t **link = &g_streams;
+    while (*link && *link != log) link = &(*link)->next;
+    if (*link) *link = log->next;
+
+    bool stop_writer = (--g_open_streams == 0) && g_writer_running;
+    if (stop_writer) {
+        g_writer_stop = true;
+        wwv_cond_signal(&g_writer_wake);
+    }
+    wwv_mutex_unlock(&g_lock);
+
+    if (stop_writer) {
+        wwv_thread_join(g_writer);
+        wwv_mutex_lock(&g_lock);
+        g_writer_running = false;
+        wwv_mutex_unlock(&g_lock);
+    }
+
+    close_segment(log);
+    wwv_spsc_ring_destroy(log->ring);
+    wwv_free(log);
+}
+
+void wwv_csv_log_header(wwv_csv_log_t *log, const char *fmt, ...) {
+    if (!log || !fmt || log->rows_started) return;
+
+    char text[WWV_CSV_HEADER_BYTES];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(text, sizeof(text), fmt, ap);
+    va_end(ap);
+    if (n <= 0) return;
+    size_t len = (size_t)n < sizeof(text) ? (size_t)n : sizeof(text) - 1;
+
+    /* Kept for rotated files while it fits */
+    if (log->header_len + len <= sizeof(log->header)) {
+        memcpy(&log->header[log->header_len], text, len);
+        log->header_len += len;
+    }
+    if (log->bin) wwv_binlog_write_text(log->bin, text, len);
+    else if (log->file) fwrite(text, 1, len, log->file);
+}
+
+static void queue_row(wwv_csv_log_t *log, bool has_wall, time_t wall, const char *fmt, va_list ap) {
+    log->rows_started = true;
+
+    /* Synchronous mode: format now, flush per row like the original loggers */
+    if (!log->ring) {
+        if (log->rotate_at) rotate_if_due(log, time(NULL));
+        if (log->bin) {
+            log_record_t rec;
+            rec.has_wall = has_wall;
+            rec.wall = wall;
+            capture_args(&rec, fmt, ap);
+            if (!write_binary(log, &rec)) log->dropped++;
+            return;
+        }
+        if (!log->file) {
+            log->dropped++;
+            return;
+        }
+        WWV_TRACE_BEGIN(tr);
+        if (has_wall) write_wall(log->file, wall);
+        vfprintf(log->file, fmt, ap);
+        fflush(log->file);
+        WWV_TRACE_END("log", "write_inline", tr, WWV_TRACE_NO_SAMPLE);
+        return;
+    }
+
+    log_record_t rec;
+    rec.has_wall = has_wall;
+    rec.wall = wall;
+    capture_args(&rec, fmt, ap);
+
+    if (wwv_spsc_ring_write(log->ring, &rec, 1) == 0) {
+        log->dropped++;
+    }
+}
+
+void wwv_csv_log_set_perf(wwv_csv_log_t *log, wwv_perf_t *perf) {
+    if (!log) return;
+    log->perf = perf;
+}
+
+void wwv_csv_log_row(wwv_csv_log_t *log, const char *fmt, ...) {
+    if (!log || !fmt) return;
+
+    WWV_PERF_BEGIN(log->perf, t0);
+    va_list ap;
+    va_start(ap, fmt);
+    queue_row(log, false, 0, fmt, ap);
+    va_end(ap);
+    WWV_PERF_END(log->perf, WWV_PERF_LOG_WRITE, t0);
+}
+
+void wwv_csv_log_row_at(wwv_csv_log_t *log, time_t wall, const char *fmt, ...) {
+    if (!log || !fmt) return;
+
+    WWV_PERF_BEGIN(log->perf, t0);
+    va_list ap;
+    va_start(ap, fmt);
+    queue_row(log, true, wall, fmt, ap);
+    va_end(ap);
+    WWV_PERF_END(log->perf, WWV_PERF_LOG_WRITE, t0);
+}
+
+void wwv_csv_log_flush_all(void) {
+    wwv_mutex_lock(&g_lock);
+    if (g_writer_running) {
+        unsigned target = ++g_flush_request;
+        wwv_cond_signal(&g_writer_wake);
+        while ((int)(g_flush_done - target) < 0 && g_writer_running) {
+            wwv_cond_wait(&g_writer_idle, &g_lock);
+        }
+    } else {
+        for (wwv_csv_log_t *s = g_streams; s; s = s->next) {
+            wwv_binlog_flush(s->bin);
+            if (s->file) fflush(s->file);
+        }
+    }
+    wwv_mutex_unlock(&g_lock);
+}
+
+bool wwv_csv_log_get_path(wwv_csv_log_t *log, char *out, size_t size) {
+    if (!log || !out || size == 0) return false;
+    wwv_mutex_lock(&g_lock);
+    bool open = log->file != NULL;
+    if (open) snprintf(out, size, "%s", log->path);
+    wwv_mutex_unlock(&g_lock);
+    return open;
+}
+
+bool wwv_csv_log_convert(const char *binary_path, FILE *out, bool header) {
+    if (!out) return false;
+    wwv_binlog_reader_t *r = wwv_binlog_reader_open(binary_path);
+    if (!r) return false;
+
+    wwv_binlog_row_t row;
+    int rc;
+    while ((rc = wwv_binlog_read(r, &row)) == 1) {
+        if (row.text) {
+            if (header) fwrite(row.text, 1, row.text_length, out);
+            continue;
+        }
+
+        /* The schema must be what the format captures: write_record trusts it */
+        uint8_t types[WWV_CSV_MAX_ARGS];
+        int n = format_columns(row.fmt, types);
+        if (n != row.columns || memcmp(types, row.column_types, (size_t)n) != 0) {
+            rc = -1;
+            break;
+        }
+
+        log_record_t rec;
+        rec.fmt = row.fmt;
+        rec.has_wall = row.has_wall;
+        rec.wall = (time_t)row.wall;
+        rec.argc = (uint8_t)n;
+        rec.text_len = 0;
+        for (int i = 0; i < n; i++) {
+            log_arg_t *a = &rec.args[i];
+            switch (types[i]) {
+                case WWV_BINLOG_I32:
+                case WWV_BINLOG_I64: a->ll = row.values[i].i; break;
+                case WWV_BINLOG_STR: {
+                    size_t room = WWV_CSV_TEXT_BYTES - rec.text_len;
+                    size_t len = strlen(row.values[i].s);
+                    if (len >= room) len = room ? room - 1 : 0;
+                    if (room == 0) {
+                        a->text_ofs = WWV_CSV_TEXT_BYTES - 1;
+                        break;
+                    }
+                    a->text_ofs = rec.text_len;
+                    memcpy(&rec.text[rec.text_len], row.values[i].s, len);
+                    rec.text[rec.text_len + len] = '\0';
+                    rec.text_len += (uint8_t)(len + 1);
+                    break;
+                }
+                default:
+                    if (is_double_column(types[i])) a->d = row.values[i].d;
+                    else a->ull = row.values[i].u;
+                    break;
+            }
+        }
+        write_record(out, &rec);
+    }
+
+    wwv_binlog_reader_close(r);
+    return rc == 0;
+}
+
+uint64_t wwv_csv_log_get_dropped(wwv_csv_log_t *log) {
+    return log ? log->dropped + log->lost : 0;
+}
+
+void wwv_csv_log_get_stats(wwv_csv_log_stats_t *stats) {
+    if (!stats) return;
+
+    wwv_mutex_lock(&g_lock);
+    stats->open_streams = g_open_streams;
+    stats->rows_written = g_rows_written;
+    stats->rows_dropped = g_rows_dropped;
+    stats->rotations = g_rotations;
+    for (wwv_csv_log_t *s = g_streams; s; s = s->next) {
+        stats->rows_dropped += s->dropped + s->lost;
+        stats->rotations += s->rotations;
+    }
+    stats->flushes = g_flushes;
+    wwv_mutex_unlock(&g_lock);
+}
@@ -0,0 +1,106 @@
+/**
+ * @file wwv_denormal.c
+ * @brief Flush-to-zero scope (x86 MXCSR, ARM FPCR / FPSCR)
+ */
+
+#include "wwv_denormal.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define DN_ARCH_X86 1
+#include <xmmintrin.h>
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+#define DN_ARCH_MSVC_ARM 1
+#include <float.h>
+#elif defined(__aarch64__) || (defined(__arm__) && defined(__ARM_FP))
+#define DN_ARCH_ARM 1
+#endif
+
+#if defined(DN_ARCH_X86)
+
+/* FTZ flushes results, DAZ treats subnormal inputs as zero. DAZ is
+ * missing only on the first SSE parts, none of which run x86-64 or SSE2 */
+#define DN_FTZ          0x8000u
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DN_DAZ          0x0040u
+#else
+#define DN_DAZ          0u
+#endif
+#define DN_FLUSH_BITS   (DN_FTZ | DN_DAZ)
+
+static uint32_t read_mode(void) { return _mm_getcsr(); }
+static void write_mode(uint32_t mode) { _mm_setcsr(mode); }
+
+#elif defined(DN_ARCH_MSVC_ARM)
+
+#define DN_FLUSH_BITS   ((uint32_t)_DN_FLUSH)
+
+static uint32_t read_mode(void) { return (uint32_t)_controlfp(0, 0) & _MCW_DN; }
+static void write_mode(uint32_t mode) { _controlfp(mode, _MCW_DN); }
+
+#elif defined(DN_ARCH_ARM)
+
+/* FZ, bit 24: on AArch64 it flushes both inputs and results */
+#define DN_FLUSH_BITS   (1u << 24)
+
+#if defined(__aarch64__)
+static uint32_t read_mode(void) {
+    uint64_t r;
+    __asm__ __volatile__("mrs %0, fpcr" : "=r"(r));
+    return (uint32_t)r;
+}
+static void write_mode(uint32_t mode) {
+    uint64_t r = mode;
+    __asm__ __volatile__("msr fpcr, %0" : : "r"(r));
+}
+#else
+static uint32_t read_mode(void) {
+    uint32_t r;
+    __asm__ __volatile__("vmrs %0, fpscr" : "=r"(r));
+    return r;
+}
+static void write_mode(uint32_t mode) {
+    __asm__ __volatile__("vmsr fpscr, %0" : : "r"(mode));
+}
+#endif
+
+#endif
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+#ifdef DN_FLUSH_BITS
+
+void wwv_denormal_enter(wwv_denormal_scope_t *scope) {
+    uint32_t mode = read_mode();
+    scope->saved = mode;
+    /* A nested scope finds the bits set and leaves the register alone */
+    scope->changed = (mode & DN_FLUSH_BITS) != DN_FLUSH_BITS;
+    if (scope->changed) write_mode(mode | DN_FLUSH_BITS);
+}
+
+void wwv_denormal_leave(const wwv_denormal_scope_t *scope) {
+    if (scope->changed) write_mode(scope->saved);
+}
+
+bool wwv_denormal_active(void) {
+    return (read_mode() & DN_FLUSH_BITS) == DN_FLUSH_BITS;
+}
+
+#else
+
+void wwv_denormal_enter(wwv_denormal_scope_t *scope) {
+    scope->saved = 0;
+    scope->changed = false;
+}
+
+void wwv_denormal_leave(const wwv_denormal_scope_t *scope) {
+    (void)scope;
+}
+
+bool wwv_denormal_active(void) {
+    return false;
+}
+
+#endif
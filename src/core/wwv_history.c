@@ -0,0 +1,372 @@
+/**
+ * @file wwv_history.c
+ * @brief Fixed-memory per-second metric history
+ *
+ * The store is one block, in memory or mapped from the file: a 64-byte
+ * header, then each column's capacity floats. Row q (history seconds,
+ * counted from the file's origin) is at index q % capacity; this run's
+ * stream second s is row s + run_offset. Header fields are host-endian,
+ * like the rest of the mapped data.
+ */
+
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE     /* mmap()/ftruncate() under -std=c11 */
+#endif
+#if !defined(_WIN32) && !defined(_FILE_OFFSET_BITS)
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include "wwv_history.h"
+#include "wwv_arena.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*============================================================================
+ * Internal Configuration
+ *============================================================================*/
+
+#define HISTORY_MAGIC           "WWVHIST"
+#define HISTORY_VERSION         1u
+#define HISTORY_HEADER_BYTES    64u
+
+typedef enum {
+    COMBINE_SUM,
+    COMBINE_MAX,
+    COMBINE_LAST
+} combine_t;
+
+static const struct {
+    const char *name;
+    combine_t combine;
+} COLUMNS[WWV_HIST_COLUMN_COUNT] = {
+    [WWV_HIST_TICK_SNR]         = { "tick_snr",        COMBINE_MAX },
+    [WWV_HIST_TICKS]            = { "ticks",           COMBINE_SUM },
+    [WWV_HIST_TICKS_EXPECTED]   = { "ticks_expected",  COMBINE_SUM },
+    [WWV_HIST_TICK_CORR]        = { "tick_corr",       COMBINE_MAX },
+    [WWV_HIST_MARKERS]          = { "markers",         COMBINE_SUM },
+    [WWV_HIST_BCD_TIME_SNR]     = { "bcd_time_snr",    COMBINE_MAX },
+    [WWV_HIST_BCD_FREQ_SNR]     = { "bcd_freq_snr",    COMBINE_MAX },
+    [WWV_HIST_CARRIER_SNR]      = { "carrier_snr",     COMBINE_LAST },
+    [WWV_HIST_SYNC_CONFIDENCE]  = { "sync_confidence", COMBINE_LAST },
+    [WWV_HIST_TONE_PPM]         = { "tone_ppm",        COMBINE_LAST },
+};
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t columns;
+    uint32_t capacity;              /* Rows (seconds) per column */
+    uint32_t reserved0;
+    int64_t begin_second;           /* First row ever written, -1 = empty */
+    int64_t end_second;             /* One past the newest row */
+    int64_t origin_unix;            /* Wall clock at history second 0 */
+    uint8_t reserved[16];
+} history_header_t;
+
+_Static_assert(sizeof(history_header_t) == HISTORY_HEADER_BYTES, "history header layout");
+
+struct wwv_history {
+    history_header_t *hd;           /* Start of the block */
+    float *column[WWV_HIST_COLUMN_COUNT];
+    uint32_t capacity;
+    size_t bytes;
+    int64_t run_offset;             /* History second of stream second 0 */
+    bool mapped;
+    bool resumed;
+    uint64_t dropped;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+};
+
+/*============================================================================
+ * Internal Functions
+ *============================================================================*/
+
+static int64_t first_second(const wwv_history_t *h) {
+    const history_header_t *hd = h->hd;
+    if (hd->begin_second < 0) return hd->end_second;
+    int64_t oldest = hd->end_second - (int64_t)h->capacity;
+    return hd->begin_second > oldest ? hd->begin_second : oldest;
+}
+
+static bool retained(const wwv_history_t *h, int64_t q) {
+    return h->hd->begin_second >= 0 && q >= first_second(h) && q < h->hd->end_second;
+}
+
+static void clear_rows(wwv_history_t *h, int64_t from, int64_t to) {
+    for (int64_t q = from; q < to; q++) {
+        size_t row = (size_t)(q % h->capacity);
+        for (int c = 0; c < WWV_HIST_COLUMN_COUNT; c++) h->column[c][row] = NAN;
+    }
+}
+
+static void init_block(wwv_history_t *h) {
+    history_header_t *hd = h->hd;
+    memset(hd, 0, sizeof(*hd));
+    memcpy(hd->magic, HISTORY_MAGIC, sizeof(HISTORY_MAGIC));
+    hd->version = HISTORY_VERSION;
+    hd->columns = WWV_HIST_COLUMN_COUNT;
+    hd->capacity = h->capacity;
+    hd->begin_second = -1;
+    hd->origin_unix = (int64_t)time(NULL);
+    for (int c = 0; c < WWV_HIST_COLUMN_COUNT; c++) {
+        for (uint32_t k = 0; k < h->capacity; k++) h->column[c][k] = NAN;
+    }
+}
+
+static bool header_matches(const wwv_history_t *h) {
+    const history_header_t *hd = h->hd;
+    return memcmp(hd->magic, HISTORY_MAGIC, sizeof(HISTORY_MAGIC)) == 0 &&
+           hd->version == HISTORY_VERSION &&
+           hd->columns == WWV_HIST_COLUMN_COUNT &&
+           hd->capacity == h->capacity &&
+           hd->end_second >= 0 && hd->begin_second <= hd->end_second;
+}
+
+/*============================================================================
+ * Mapping
+ *============================================================================*/
+
+/* Map path read-write at exactly h->bytes; a file of another size is cleared */
+static bool map_file(wwv_history_t *h, const char *path) {
+#ifdef _WIN32
+    LARGE_INTEGER size, want;
+    h->file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL,
+                          OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h->file == INVALID_HANDLE_VALUE) return false;
+    if (!GetFileSizeEx(h->file, &size)) return false;
+    want.QuadPart = (LONGLONG)h->bytes;
+    if (size.QuadPart != want.QuadPart) {
+        LARGE_INTEGER zero = { 0 };
+        if (!SetFilePointerEx(h->file, zero, NULL, FILE_BEGIN) || !SetEndOfFile(h->file) ||
+            !SetFilePointerEx(h->file, want, NULL, FILE_BEGIN) || !SetEndOfFile(h->file)) {
+            return false;
+        }
+    }
+    h->mapping = CreateFileMappingA(h->file, NULL, PAGE_READWRITE, 0, 0, NULL);
+    if (!h->mapping) return false;
+    h->hd = (history_header_t *)MapViewOfFile(h->mapping, FILE_MAP_WRITE, 0, 0, 0);
+    return h->hd != NULL;
+#else
+    struct stat st;
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return false;
+    if (fstat(fd, &st) != 0 ||
+        ((uint64_t)st.st_size != h->bytes &&
+         (ftruncate(fd, 0) != 0 || ftruncate(fd, (off_t)h->bytes) != 0))) {
+        close(fd);
+        return false;
+    }
+    void *map = mmap(NULL, h->bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+    h->hd = (history_header_t *)map;
+    return true;
+#endif
+}
+
+static void unmap_file(wwv_history_t *h) {
+#ifdef _WIN32
+    if (h->hd) UnmapViewOfFile(h->hd);
+    if (h->mapping) CloseHandle(h->mapping);
+    if (h->file && h->file != INVALID_HANDLE_VALUE) CloseHandle(h->file);
+#else
+    if (h->hd) munmap(h->hd, h->bytes);
+#endif
+    h->hd = NULL;
+}
+
+/*============================================================================
+ * API
+ *============================================================================*/
+
+wwv_history_t *wwv_history_create(uint32_t seconds, const char *path) {
+    if (seconds == 0) seconds = WWV_HISTORY_DEFAULT_SECONDS;
+    if (seconds > WWV_HISTORY_MAX_SECONDS) {
+        fprintf(stderr, "[HISTORY] %u s is over the %u s limit\n", seconds, WWV_HISTORY_MAX_SECONDS);
+        return NULL;
+    }
+
+    wwv_history_t *h = (wwv_history_t *)wwv_calloc(1, sizeof(wwv_history_t));
+    if (!h) return NULL;
+    h->capacity = seconds;
+    h->bytes = HISTORY_HEADER_BYTES + (size_t)WWV_HIST_COLUMN_COUNT * seconds * sizeof(float);
+
+    if (path) {
+        if (!map_file(h, path)) {
+            fprintf(stderr, "[HISTORY] Cannot map %s\n", path);
+            unmap_file(h);
+            wwv_free(h);
+            return NULL;
+        }
+        h->mapped = true;
+    } else {
+        h->hd = (history_header_t *)wwv_malloc(h->bytes);
+        if (!h->hd) {
+            wwv_free(h);
+            return NULL;
+        }
+    }
+
+    float *data = (float *)((uint8_t *)h->hd + HISTORY_HEADER_BYTES);
+    for (int c = 0; c < WWV_HIST_COLUMN_COUNT; c++) {
+        h->column[c] = data + (size_t)c * seconds;
+    }
+
+    if (h->mapped && header_matches(h)) {
+        /* Continue on the wall clock; never behind the newest row */
+        int64_t since = (int64_t)time(NULL) - h->hd->origin_unix;
+        h->run_offset = since > h->hd->end_second ? since : h->hd->end_second;
+        h->resumed = true;
+    } else {
+        init_block(h);
+    }
+
+    printf("[HISTORY] %u s x %d columns (%.1f MB)%s%s%s\n",
+           seconds, WWV_HIST_COLUMN_COUNT, h->bytes / 1048576.0,
+           h->mapped ? " mapped on " : "", h->mapped ? path : "",
+           h->resumed ? ", continued" : "");
+    return h;
+}
+
+void wwv_history_destroy(wwv_history_t *h) {
+    if (!h) return;
+    if (h->mapped) {
+        unmap_file(h);
+    } else {
+        wwv_free(h->hd);
+    }
+    wwv_free(h);
+}
+
+void wwv_history_record(wwv_history_t *h, wwv_history_column_t column,
+                        double timestamp_ms, float value) {
+    if (!h || (unsigned)column >= WWV_HIST_COLUMN_COUNT || timestamp_ms < 0.0) return;
+    history_header_t *hd = h->hd;
+    int64_t q = (int64_t)floor(timestamp_ms / 1000.0) + h->run_offset;
+
+    if (hd->begin_second < 0) {
+        hd->begin_second = q;
+        hd->end_second = q;
+    }
+    if (q >= hd->end_second) {
+        int64_t from = q + 1 - (int64_t)h->capacity;
+        clear_rows(h, from > hd->end_second ? from : hd->end_second, q + 1);
+        hd->end_second = q + 1;
+    } else if (q < first_second(h)) {
+        h->dropped++;
+        return;
+    }
+
+    float *cell = &h->column[column][q % h->capacity];
+    switch (COLUMNS[column].combine) {
+        case COMBINE_SUM:
+            *cell = isnan(*cell) ? value : *cell + value;
+            break;
+        case COMBINE_MAX:
+            if (isnan(*cell) || value > *cell) *cell = value;
+            break;
+        case COMBINE_LAST:
+            *cell = value;
+            break;
+    }
+}
+
+int wwv_history_query(const wwv_history_t *h, wwv_history_column_t column,
+                      double start_ms, double end_ms, float *out, int max_rows) {
+    if (!h || !out || (unsigned)column >= WWV_HIST_COLUMN_COUNT) return 0;
+    int64_t first = (int64_t)ceil(start_ms / 1000.0);
+    int64_t end = (int64_t)ceil(end_ms / 1000.0);
+    int rows = 0;
+
+    for (int64_t s = first; s < end && rows < max_rows; s++) {
+        int64_t q = s + h->run_offset;
+        out[rows++] = retained(h, q) ? h->column[column][q % h->capacity] : NAN;
+    }
+    return rows;
+}
+
+bool wwv_history_aggregate(const wwv_history_t *h, wwv_history_column_t column,
+                           double start_ms, double end_ms, wwv_history_stats_t *out) {
+    if (!h || !out || (unsigned)column >= WWV_HIST_COLUMN_COUNT) return false;
+    int64_t first = (int64_t)ceil(start_ms / 1000.0) + h->run_offset;
+    int64_t end = (int64_t)ceil(end_ms / 1000.0) + h->run_offset;
+
+    memset(out, 0, sizeof(*out));
+    out->min = NAN;
+    out->max = NAN;
+    out->mean = NAN;
+    if (end <= first) return false;
+    out->seconds = (int)(end - first);
+
+    /* Only the retained part can hold values */
+    int64_t oldest = first_second(h);
+    if (first < oldest) first = oldest;
+    if (end > h->hd->end_second) end = h->hd->end_second;
+
+    for (int64_t q = first; q < end; q++) {
+        float v = h->column[column][q % h->capacity];
+        if (isnan(v)) continue;
+        if (out->count == 0 || v < out->min) out->min = v;
+        if (out->count == 0 || v > out->max) out->max = v;
+        out->sum += v;
+        out->count++;
+    }
+    if (out->count == 0) return false;
+    out->mean = (float)(out->sum / out->count);
+    return true;
+}
+
+bool wwv_history_get_info(const wwv_history_t *h, wwv_history_info_t *out) {
+    if (!h || !out) return false;
+    out->capacity_seconds = h->capacity;
+    out->first_ms = (double)(first_second(h) - h->run_offset) * 1000.0;
+    out->end_ms = (double)(h->hd->end_second - h->run_offset) * 1000.0;
+    if (h->hd->begin_second < 0) out->first_ms = out->end_ms = 0.0;
+    out->run_start = (time_t)(h->hd->origin_unix + h->run_offset);
+    out->mapped = h->mapped;
+    out->resumed = h->resumed;
+    out->dropped = h->dropped;
+    return true;
+}
+
+const char *wwv_history_column_name(int column) {
+    return (column >= 0 && column < WWV_HIST_COLUMN_COUNT) ? COLUMNS[column].name : NULL;
+}
+
+void wwv_history_print_stats(const wwv_history_t *h) {
+    if (!h) return;
+    wwv_history_info_t info;
+    wwv_history_get_info(h, &info);
+
+    printf("\n=== METRIC HISTORY STATS ===\n");
+    printf("Span: %.0fs to %.0fs of %us  %s%s  Dropped: %llu\n",
+           info.first_ms / 1000.0, info.end_ms / 1000.0, (unsigned)info.capacity_seconds,
+           info.mapped ? "mapped" : "memory", info.resumed ? " (continued)" : "",
+           (unsigned long long)info.dropped);
+
+    wwv_history_stats_t ticks, expected, snr;
+    bool have_ticks = wwv_history_aggregate(h, WWV_HIST_TICKS, info.first_ms, info.end_ms, &ticks);
+    bool have_expected = wwv_history_aggregate(h, WWV_HIST_TICKS_EXPECTED, info.first_ms,
+                                               info.end_ms, &expected);
+    if (have_ticks && have_expected && expected.sum > 0.0) {
+        printf("Ticks: %.0f of %.0f expected (%.1f%%)\n",
+               ticks.sum, expected.sum, 100.0 * ticks.sum / expected.sum);
+    }
+    if (wwv_history_aggregate(h, WWV_HIST_TICK_SNR, info.first_ms, info.end_ms, &snr)) {
+        printf("Tick SNR: %.1f / %.1f / %.1f dB (min / mean / max)\n", snr.min, snr.mean, snr.max);
+    }
+    printf("============================\n");
+}
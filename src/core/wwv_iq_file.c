@@ -0,0 +1,440 @@
+/**
+ * @file wwv_iq_file.c
+ * @brief Memory-mapped IQ recordings (WAV, SigMF, raw) and a WAV writer
+ *
+ * Headers are parsed byte-wise as little-endian; sample conversion assumes
+ * a little-endian host, like the telemetry wire format.
+ */
+
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE     /* mmap()/madvise() under -std=c11 */
+#endif
+#if !defined(_WIN32) && !defined(_FILE_OFFSET_BITS)
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include "wwv_iq_file.h"
+#include "wwv_arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define WAV_FORMAT_PCM          0x0001
+#define WAV_FORMAT_FLOAT        0x0003
+#define WAV_FORMAT_EXTENSIBLE   0xFFFE
+
+#define SIGMF_META_EXT          ".sigmf-meta"
+#define SIGMF_DATA_EXT          ".sigmf-data"
+#define SIGMF_META_MAX          (1u << 20)
+
+struct wwv_iq_file {
+    wwv_iq_info_t info;
+    const uint8_t *map;         /* Whole file */
+    uint64_t map_size;
+    const uint8_t *samples;     /* First sample within map */
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+};
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+static uint16_t rd_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t rd_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void wr_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void wr_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static size_t sample_bytes(wwv_iq_format_t format) {
+    return format == WWV_IQ_CI16 ? 2 * sizeof(int16_t) : 2 * sizeof(float);
+}
+
+static bool ends_with(const char *s, const char *suffix) {
+    size_t n = strlen(s), m = strlen(suffix);
+    return n >= m && strcmp(s + n - m, suffix) == 0;
+}
+
+/*============================================================================
+ * Mapping
+ *============================================================================*/
+
+static bool map_file(wwv_iq_file_t *f, const char *path) {
+#ifdef _WIN32
+    LARGE_INTEGER size;
+    f->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                          FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (f->file == INVALID_HANDLE_VALUE) return false;
+    if (!GetFileSizeEx(f->file, &size) || size.QuadPart == 0) return false;
+    f->mapping = CreateFileMappingA(f->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!f->mapping) return false;
+    f->map = MapViewOfFile(f->mapping, FILE_MAP_READ, 0, 0, 0);
+    f->map_size = (uint64_t)size.QuadPart;
+    return f->map != NULL;
+#else
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    if (fstat(fd, &st) != 0 || st.st_size == 0 || (uint64_t)st.st_size > SIZE_MAX) {
+        close(fd);
+        return false;
+    }
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+    madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+    f->map = map;
+    f->map_size = (uint64_t)st.st_size;
+    return true;
+#endif
+}
+
+static void unmap_file(wwv_iq_file_t *f) {
+#ifdef _WIN32
+    if (f->map) UnmapViewOfFile(f->map);
+    if (f->mapping) CloseHandle(f->mapping);
+    if (f->file && f->file != INVALID_HANDLE_VALUE) CloseHandle(f->file);
+#else
+    if (f->map) munmap((void *)f->map, (size_t)f->map_size);
+#endif
+    f->map = NULL;
+}
+
+/*============================================================================
+ * Containers
+ *============================================================================*/
+
+static bool parse_wav(wwv_iq_file_t *f) {
+    const uint8_t *p = f->map;
+    uint64_t size = f->map_size;
+    uint64_t pos = 12;
+    bool have_fmt = false;
+
+    if (size < 12 || memcmp(p, "RIFF", 4) != 0 || memcmp(p + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    while (pos + 8 <= size) {
+        const uint8_t *chunk = p + pos;
+        uint64_t len = rd_u32(chunk + 4);
+        uint64_t body = pos + 8;
+
+        if (memcmp(chunk, "fmt ", 4) == 0) {
+            if (len < 16 || body + len > size) return false;
+            uint16_t tag = rd_u16(p + body);
+            uint16_t channels = rd_u16(p + body + 2);
+            uint16_t bits = rd_u16(p + body + 14);
+            if (tag == WAV_FORMAT_EXTENSIBLE) {
+                if (len < 40) return false;
+                tag = rd_u16(p + body + 24);    /* First bytes of the SubFormat GUID */
+            }
+            if (channels != 2) {
+                printf("[IQ] WAV has %u channels, need 2 (I/Q)\n", channels);
+                return false;
+            }
+            if (tag == WAV_FORMAT_PCM && bits == 16) {
+                f->info.format = WWV_IQ_CI16;
+            } else if (tag == WAV_FORMAT_FLOAT && bits == 32) {
+                f->info.format = WWV_IQ_CF32;
+            } else {
+                printf("[IQ] Unsupported WAV sample format %u/%u-bit\n", tag, bits);
+                return false;
+            }
+            f->info.sample_rate = rd_u32(p + body + 4);
+            have_fmt = true;
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            if (!have_fmt) return false;
+            /* Streaming writers leave 0 or 0xFFFFFFFF: take the rest of the file */
+            if (len == 0 || len == 0xFFFFFFFFu || body + len > size) len = size - body;
+            f->samples = p + body;
+            f->info.sample_count = len / sample_bytes(f->info.format);
+            f->info.container = WWV_IQ_CONTAINER_WAV;
+            return true;
+        }
+        pos = body + len + (len & 1);
+    }
+    return false;
+}
+
+/* Value following "key": in a flat JSON text, or NULL */
+static const char *json_value(const char *text, const char *key) {
+    const char *p = strstr(text, key);
+    if (!p) return NULL;
+    p = strchr(p + strlen(key), ':');
+    if (!p) return NULL;
+    p++;
+    while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+    return p;
+}
+
+/* Replace a .sigmf-meta/.sigmf-data suffix (or append) to get the sibling */
+static char *sigmf_path(const char *path, const char *ext) {
+    size_t stem = strlen(path);
+    if (ends_with(path, SIGMF_META_EXT)) stem -= strlen(SIGMF_META_EXT);
+    else if (ends_with(path, SIGMF_DATA_EXT)) stem -= strlen(SIGMF_DATA_EXT);
+    char *out = wwv_malloc(stem + strlen(ext) + 1);
+    if (!out) return NULL;
+    memcpy(out, path, stem);
+    strcpy(out + stem, ext);
+    return out;
+}
+
+static bool parse_sigmf_meta(wwv_iq_file_t *f, const char *meta_path) {
+    FILE *fp = fopen(meta_path, "rb");
+    if (!fp) return false;
+
+    char *text = wwv_malloc(SIGMF_META_MAX + 1);
+    size_t len = text ? fread(text, 1, SIGMF_META_MAX, fp) : 0;
+    fclose(fp);
+    if (!text) return false;
+    text[len] = '\0';
+
+    bool ok = false;
+    const char *type = json_value(text, "\"core:datatype\"");
+    const char *rate = json_value(text, "\"core:sample_rate\"");
+    if (type && rate && *type == '"') {
+        type++;
+        if (strncmp(type, "ci16_le\"", 8) == 0) {
+            f->info.format = WWV_IQ_CI16;
+            ok = true;
+        } else if (strncmp(type, "cf32_le\"", 8) == 0) {
+            f->info.format = WWV_IQ_CF32;
+            ok = true;
+        } else {
+            printf("[IQ] Unsupported SigMF datatype (need ci16_le or cf32_le)\n");
+        }
+        f->info.sample_rate = (uint32_t)(strtod(rate, NULL) + 0.5);
+    }
+    wwv_free(text);
+    return ok && f->info.sample_rate > 0;
+}
+
+/*============================================================================
+ * Reader
+ *============================================================================*/
+
+wwv_iq_file_t *wwv_iq_file_open(const char *path, const wwv_iq_raw_params_t *raw) {
+    if (!path) return NULL;
+
+    wwv_iq_file_t *f = wwv_calloc(1, sizeof(wwv_iq_file_t));
+    if (!f) return NULL;
+
+    /* SigMF: metadata decides the format, samples live in the .sigmf-data */
+    char *meta = sigmf_path(path, SIGMF_META_EXT);
+    bool sigmf = meta && parse_sigmf_meta(f, meta);
+    wwv_free(meta);
+
+    bool ok;
+    if (sigmf) {
+        char *data = sigmf_path(path, SIGMF_DATA_EXT);
+        ok = data && map_file(f, data);
+        wwv_free(data);
+        if (ok) {
+            f->samples = f->map;
+            f->info.sample_count = f->map_size / sample_bytes(f->info.format);
+            f->info.container = WWV_IQ_CONTAINER_SIGMF;
+        }
+    } else {
+        ok = map_file(f, path);
+        if (ok && !parse_wav(f)) {
+            ok = raw && raw->sample_rate > 0;
+            if (ok) {
+                f->samples = f->map;
+                f->info.format = raw->format;
+                f->info.sample_rate = raw->sample_rate;
+                f->info.sample_count = f->map_size / sample_bytes(raw->format);
+                f->info.container = WWV_IQ_CONTAINER_RAW;
+            }
+        }
+    }
+
+    if (!ok || f->info.sample_count == 0) {
+        printf("[IQ] Cannot open recording %s\n", path);
+        wwv_iq_file_close(f);
+        return NULL;
+    }
+
+    printf("[IQ] %s: %s %s, %u Hz, %llu samples (%.1f sec)\n",
+           path, wwv_iq_container_name(f->info.container),
+           f->info.format == WWV_IQ_CI16 ? "ci16" : "cf32",
+           f->info.sample_rate, (unsigned long long)f->info.sample_count,
+           (double)f->info.sample_count / f->info.sample_rate);
+    return f;
+}
+
+void wwv_iq_file_close(wwv_iq_file_t *f) {
+    if (!f) return;
+    unmap_file(f);
+    wwv_free(f);
+}
+
+const wwv_iq_info_t *wwv_iq_file_info(const wwv_iq_file_t *f) {
+    return f ? &f->info : NULL;
+}
+
+size_t wwv_iq_file_read(const wwv_iq_file_t *f, uint64_t offset, size_t count,
+                        float *i_out, float *q_out) {
+    if (!f || !i_out || !q_out || offset >= f->info.sample_count) return 0;
+    if (count > f->info.sample_count - offset) {
+        count = (size_t)(f->info.sample_count - offset);
+    }
+
+    if (f->info.format == WWV_IQ_CI16) {
+        const uint8_t *src = f->samples + offset * 4;
+        const float scale = 1.0f / 32768.0f;
+        for (size_t n = 0; n < count; n++) {
+            int16_t iq[2];
+            memcpy(iq, src + n * 4, sizeof(iq));
+            i_out[n] = iq[0] * scale;
+            q_out[n] = iq[1] * scale;
+        }
+    } else {
+        const uint8_t *src = f->samples + offset * 8;
+        for (size_t n = 0; n < count; n++) {
+            float iq[2];
+            memcpy(iq, src + n * 8, sizeof(iq));
+            i_out[n] = iq[0];
+            q_out[n] = iq[1];
+        }
+    }
+    return count;
+}
+
+const char *wwv_iq_container_name(wwv_iq_container_t container) {
+    switch (container) {
+        case WWV_IQ_CONTAINER_WAV:   return "wav";
+        case WWV_IQ_CONTAINER_SIGMF: return "sigmf";
+        default:                     return "raw";
+    }
+}
+
+/*============================================================================
+ * WAV Writer
+ *============================================================================*/
+
+#define WAV_HEADER_BYTES    44
+
+struct wwv_iq_wav_writer {
+    FILE *fp;
+    wwv_iq_format_t format;
+    uint32_t sample_rate;
+    uint64_t samples;
+    bool failed;
+};
+
+static void wav_header(uint8_t *h, uint32_t rate, wwv_iq_format_t format, uint64_t samples) {
+    uint32_t frame = (uint32_t)sample_bytes(format);
+    uint64_t data = samples * frame;
+    if (data > 0xFFFFFFFFu - 36) data = 0xFFFFFFFFu;    /* Readers fall back to file size */
+
+    memcpy(h, "RIFF", 4);
+    wr_u32(h + 4, (uint32_t)(data == 0xFFFFFFFFu ? data : data + 36));
+    memcpy(h + 8, "WAVEfmt ", 8);
+    wr_u32(h + 16, 16);
+    wr_u16(h + 20, format == WWV_IQ_CI16 ? WAV_FORMAT_PCM : WAV_FORMAT_FLOAT);
+    wr_u16(h + 22, 2);
+    wr_u32(h + 24, rate);
+    wr_u32(h + 28, rate * frame);
+    wr_u16(h + 32, (uint16_t)frame);
+    wr_u16(h + 34, (uint16_t)(frame * 4));     /* Bits per channel */
+    memcpy(h + 36, "data", 4);
+    wr_u32(h + 40, (uint32_t)data);
+}
+
+wwv_iq_wav_writer_t *wwv_iq_wav_create(const char *path, uint32_t sample_rate,
+                                       wwv_iq_format_t format) {
+    if (!path || sample_rate == 0) return NULL;
+
+    wwv_iq_wav_writer_t *w = wwv_calloc(1, sizeof(wwv_iq_wav_writer_t));
+    if (!w) return NULL;
+
+    w->fp = fopen(path, "wb");
+    if (!w->fp) {
+        printf("[IQ] Cannot create %s\n", path);
+        wwv_free(w);
+        return NULL;
+    }
+    w->format = format;
+    w->sample_rate = sample_rate;
+
+    uint8_t h[WAV_HEADER_BYTES];
+    wav_header(h, sample_rate, format, 0);
+    w->failed = fwrite(h, 1, sizeof(h), w->fp) != sizeof(h);
+    return w;
+}
+
+bool wwv_iq_wav_write(wwv_iq_wav_writer_t *w, const float *i_samples,
+                      const float *q_samples, size_t count) {
+    if (!w || w->failed) return false;
+
+    uint8_t buf[4096];
+    size_t frame = sample_bytes(w->format);
+    size_t per_chunk = sizeof(buf) / frame;
+
+    for (size_t n = 0; n < count; ) {
+        size_t todo = count - n < per_chunk ? count - n : per_chunk;
+        for (size_t k = 0; k < todo; k++) {
+            if (w->format == WWV_IQ_CI16) {
+                float v[2] = { i_samples[n + k], q_samples[n + k] };
+                int16_t iq[2];
+                for (int c = 0; c < 2; c++) {
+                    float s = v[c] * 32768.0f;
+                    if (s > 32767.0f) s = 32767.0f;
+                    if (s < -32768.0f) s = -32768.0f;
+                    iq[c] = (int16_t)s;
+                }
+                memcpy(buf + k * frame, iq, sizeof(iq));
+            } else {
+                float iq[2] = { i_samples[n + k], q_samples[n + k] };
+                memcpy(buf + k * frame, iq, sizeof(iq));
+            }
+        }
+        if (fwrite(buf, frame, todo, w->fp) != todo) {
+            w->failed = true;
+            return false;
+        }
+        n += todo;
+    }
+    w->samples += count;
+    return true;
+}
+
+bool wwv_iq_wav_close(wwv_iq_wav_writer_t *w) {
+    if (!w) return false;
+
+    bool ok = !w->failed;
+    uint8_t h[WAV_HEADER_BYTES];
+    wav_header(h, w->sample_rate, w->format, w->samples);
+    if (fseek(w->fp, 0, SEEK_SET) != 0 || fwrite(h, 1, sizeof(h), w->fp) != sizeof(h)) {
+        ok = false;
+    }
+    if (fclose(w->fp) != 0) ok = false;
+    wwv_free(w);
+    return ok;
+}
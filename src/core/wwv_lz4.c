@@ -0,0 +1,163 @@
+/**
+ * @file wwv_lz4.c
+ * @brief LZ4 block format codec
+ *
+ * A sequence is a token (literal run length << 4 | match length - 4), the
+ * literals, a 16-bit little-endian back offset and the match; a nibble of
+ * 15 continues in bytes of 255. The last sequence is literals only, the
+ * last 5 bytes are always literals and no match starts in the last 12.
+ */
+
+#include "core/wwv_lz4.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*============================================================================
+ * Internal Configuration
+ *============================================================================*/
+
+#define LZ4_MIN_MATCH       4
+#define LZ4_LAST_LITERALS   5
+#define LZ4_MFLIMIT         12
+#define LZ4_MAX_OFFSET      65535
+#define LZ4_HASH_LOG        12
+#define LZ4_SKIP_SHIFT      6       /* Probe step grows by one every 64 misses */
+
+/*============================================================================
+ * Internal Functions
+ *============================================================================*/
+
+static uint32_t read32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint32_t hash4(uint32_t v) {
+    return (v * 2654435761u) >> (32 - LZ4_HASH_LOG);
+}
+
+static uint8_t *put_length(uint8_t *op, size_t length) {
+    while (length >= 255) {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = (uint8_t)length;
+    return op;
+}
+
+/* One sequence; match_length 0 = the last (literals only). NULL if it does not fit */
+static uint8_t *put_sequence(uint8_t *op, const uint8_t *oend, const uint8_t *literals,
+                             size_t literal_length, size_t offset, size_t match_length) {
+    size_t worst = 1 + literal_length / 255 + 1 + literal_length + 2 + match_length / 255 + 1;
+    if ((size_t)(oend - op) < worst) return NULL;
+
+    size_t ml = match_length ? match_length - LZ4_MIN_MATCH : 0;
+    uint8_t token = (uint8_t)((literal_length >= 15 ? 15 : literal_length) << 4);
+    if (match_length) token |= (uint8_t)(ml >= 15 ? 15 : ml);
+    *op++ = token;
+    if (literal_length >= 15) op = put_length(op, literal_length - 15);
+    memcpy(op, literals, literal_length);
+    op += literal_length;
+
+    if (match_length) {
+        *op++ = (uint8_t)(offset & 0xFF);
+        *op++ = (uint8_t)(offset >> 8);
+        if (ml >= 15) op = put_length(op, ml - 15);
+    }
+    return op;
+}
+
+/* Extended length bytes after a nibble of 15 */
+static bool get_length(const uint8_t **ip, const uint8_t *iend, size_t *length) {
+    unsigned b;
+    do {
+        if (*ip >= iend) return false;
+        b = *(*ip)++;
+        *length += b;
+    } while (b == 255);
+    return true;
+}
+
+/*============================================================================
+ * API
+ *============================================================================*/
+
+int wwv_lz4_compress(const void *src, int src_length, void *dst, int dst_capacity) {
+    if (!src || !dst || src_length < 0 || dst_capacity <= 0) return 0;
+    const uint8_t *in = (const uint8_t *)src;
+    uint8_t *op = (uint8_t *)dst;
+    const uint8_t *oend = op + dst_capacity;
+    int n = src_length;
+
+    int32_t table[1 << LZ4_HASH_LOG];
+    for (int i = 0; i < (1 << LZ4_HASH_LOG); i++) table[i] = -1;
+
+    int anchor = 0;
+    int ip = 0;
+    if (n > LZ4_MFLIMIT) {
+        int mflimit = n - LZ4_MFLIMIT;
+        int matchlimit = n - LZ4_LAST_LITERALS;
+        while (ip < mflimit) {
+            uint32_t seq = read32(&in[ip]);
+            uint32_t h = hash4(seq);
+            int ref = table[h];
+            table[h] = ip;
+            if (ref < 0 || ip - ref > LZ4_MAX_OFFSET || read32(&in[ref]) != seq) {
+                ip += 1 + ((ip - anchor) >> LZ4_SKIP_SHIFT);
+                continue;
+            }
+
+            int length = LZ4_MIN_MATCH;
+            while (ip + length < matchlimit && in[ref + length] == in[ip + length]) length++;
+            op = put_sequence(op, oend, &in[anchor], (size_t)(ip - anchor),
+                              (size_t)(ip - ref), (size_t)length);
+            if (!op) return 0;
+            ip += length;
+            anchor = ip;
+        }
+    }
+
+    op = put_sequence(op, oend, &in[anchor], (size_t)(n - anchor), 0, 0);
+    if (!op) return 0;
+    return (int)(op - (uint8_t *)dst);
+}
+
+int wwv_lz4_decompress(const void *src, int src_length, void *dst, int dst_capacity) {
+    if (!src || !dst || src_length <= 0 || dst_capacity < 0) return -1;
+    const uint8_t *ip = (const uint8_t *)src;
+    const uint8_t *iend = ip + src_length;
+    uint8_t *out = (uint8_t *)dst;
+    uint8_t *op = out;
+    const uint8_t *oend = out + dst_capacity;
+
+    for (;;) {
+        unsigned token = *ip++;
+        size_t literals = token >> 4;
+        if (literals == 15 && !get_length(&ip, iend, &literals)) return -1;
+        if ((size_t)(iend - ip) < literals || (size_t)(oend - op) < literals) return -1;
+        memcpy(op, ip, literals);
+        op += literals;
+        ip += literals;
+        if (ip == iend) break;
+
+        if (iend - ip < 2) return -1;
+        size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - out)) return -1;
+
+        size_t length = token & 15;
+        if (length == 15 && !get_length(&ip, iend, &length)) return -1;
+        length += LZ4_MIN_MATCH;
+        if ((size_t)(oend - op) < length) return -1;
+
+        /* Byte copy: the match may overlap what it writes */
+        const uint8_t *match = op - offset;
+        for (size_t i = 0; i < length; i++) op[i] = match[i];
+        op += length;
+        if (ip >= iend) return -1;     /* A block ends on literals */
+    }
+    return (int)(op - out);
+}
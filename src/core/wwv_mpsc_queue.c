@@ -0,0 +1,127 @@
+/**
+ * @file wwv_mpsc_queue.c
+ * @brief Lock-free bounded MPSC queue
+ *
+ * Slot i starts with seq = i. A producer that reads tail = pos owns slot
+ * pos & mask once seq == pos and its CAS advances tail; after copying it
+ * publishes with seq = pos + 1. The consumer reads slot head & mask when
+ * seq == head + 1 and hands it back for the next lap with
+ * seq = head + capacity.
+ */
+
+#include "wwv_mpsc_queue.h"
+#include "wwv_arena.h"
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define QUEUE_CACHE_LINE 64
+
+typedef struct {
+    atomic_size_t seq;
+    size_t size;
+    /* max_elem_size bytes of payload follow */
+} queue_slot_t;
+
+struct wwv_mpsc_queue {
+    _Alignas(QUEUE_CACHE_LINE) atomic_size_t tail;      /* Shared by producers */
+    _Alignas(QUEUE_CACHE_LINE) size_t head;             /* Consumer only */
+    _Alignas(QUEUE_CACHE_LINE) size_t capacity;
+    size_t mask;
+    size_t max_elem_size;
+    size_t slot_stride;
+    unsigned char *slots;
+};
+
+static queue_slot_t *slot_at(const wwv_mpsc_queue_t *queue, size_t index) {
+    return (queue_slot_t *)(queue->slots + (index & queue->mask) * queue->slot_stride);
+}
+
+wwv_mpsc_queue_t *wwv_mpsc_queue_create(size_t max_elem_size, size_t min_slots) {
+    if (max_elem_size == 0 || min_slots == 0) return NULL;
+
+    size_t capacity = 1;
+    while (capacity < min_slots) capacity <<= 1;
+
+    /* calloc cannot be relied on for _Alignas beyond max_align_t */
+    void *mem = wwv_aligned_alloc(QUEUE_CACHE_LINE, sizeof(wwv_mpsc_queue_t));
+    if (!mem) return NULL;
+
+    wwv_mpsc_queue_t *queue = (wwv_mpsc_queue_t *)mem;
+    memset(queue, 0, sizeof(*queue));
+
+    /* Keep every slot header aligned for its atomic */
+    size_t align = _Alignof(queue_slot_t);
+    queue->slot_stride = (sizeof(queue_slot_t) + max_elem_size + align - 1) / align * align;
+    queue->slots = (unsigned char *)wwv_malloc(capacity * queue->slot_stride);
+    if (!queue->slots) {
+        wwv_mpsc_queue_destroy(queue);
+        return NULL;
+    }
+
+    queue->capacity = capacity;
+    queue->mask = capacity - 1;
+    queue->max_elem_size = max_elem_size;
+    queue->head = 0;
+    atomic_init(&queue->tail, 0);
+    for (size_t i = 0; i < capacity; i++) {
+        atomic_init(&slot_at(queue, i)->seq, i);
+    }
+    return queue;
+}
+
+void wwv_mpsc_queue_destroy(wwv_mpsc_queue_t *queue) {
+    if (!queue) return;
+    wwv_free(queue->slots);
+    wwv_aligned_free(queue);
+}
+
+bool wwv_mpsc_queue_push(wwv_mpsc_queue_t *queue, const void *src, size_t size) {
+    if (!queue || size == 0 || size > queue->max_elem_size) return false;
+
+    size_t pos = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    queue_slot_t *slot;
+
+    for (;;) {
+        slot = slot_at(queue, pos);
+        size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->tail, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+            /* pos reloaded by the failed CAS */
+        } else if (diff < 0) {
+            return false;   /* Slot still holds an element from the previous lap */
+        } else {
+            pos = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+        }
+    }
+
+    slot->size = size;
+    memcpy(slot + 1, src, size);
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    return true;
+}
+
+size_t wwv_mpsc_queue_pop(wwv_mpsc_queue_t *queue, void *dst) {
+    if (!queue) return 0;
+
+    queue_slot_t *slot = slot_at(queue, queue->head);
+    size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+    if (seq != queue->head + 1) return 0;
+
+    size_t size = slot->size;
+    memcpy(dst, slot + 1, size);
+    atomic_store_explicit(&slot->seq, queue->head + queue->capacity, memory_order_release);
+    queue->head++;
+    return size;
+}
+
+size_t wwv_mpsc_queue_capacity(const wwv_mpsc_queue_t *queue) {
+    return queue ? queue->capacity : 0;
+}
@@ -0,0 +1,276 @@
+/**
+ * @file wwv_perf.c
+ * @brief Hot-path stage timers
+ */
+
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE     /* clock_gettime(CLOCK_MONOTONIC) under -std=c11 */
+#endif
+
+#include "wwv_perf.h"
+#include "wwv_arena.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PERF_HAVE_TSC
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+
+#define PERF_CACHE_LINE         64
+#define PERF_CALIBRATE_NS       2000000     /* TSC calibration window */
+
+/*============================================================================
+ * Context
+ *============================================================================*/
+
+/* One cache line group per stage: detector and display workers record
+ * different stages and should not bounce each other's lines */
+typedef struct {
+    _Alignas(PERF_CACHE_LINE) atomic_uint_fast64_t count;
+    atomic_uint_fast64_t total_ns;
+    atomic_uint_fast64_t max_ns;
+    atomic_uint_fast64_t histogram[WWV_PERF_HIST_BUCKETS];
+} perf_stage_t;
+
+struct wwv_perf {
+    double ns_per_tick;
+    perf_stage_t stage[WWV_PERF_STAGE_COUNT];
+};
+
+static const char *g_stage_names[WWV_PERF_STAGE_COUNT] = {
+    "detector_block",
+    "display_block",
+    "tick_fft",
+    "tick_corr",
+    "tick_state",
+    "marker_fft",
+    "marker_state",
+    "bcd_time_fft",
+    "bcd_time_state",
+    "bcd_freq_fft",
+    "bcd_freq_state",
+    "tone_fft",
+    "tone_estimate",
+    "correlation",
+    "sync",
+    "log_write",
+    "telemetry",
+};
+
+/*============================================================================
+ * Clock
+ *============================================================================*/
+
+static uint64_t monotonic_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+    if (!freq.QuadPart) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (uint64_t)((double)now.QuadPart * 1e9 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+uint64_t wwv_perf_now(void) {
+#ifdef PERF_HAVE_TSC
+    return (uint64_t)__rdtsc();
+#else
+    return monotonic_ns();
+#endif
+}
+
+/**
+ * ns per wwv_perf_now() tick
+ */
+static double calibrate(void) {
+#ifdef PERF_HAVE_TSC
+    uint64_t ns0 = monotonic_ns();
+    uint64_t t0 = wwv_perf_now();
+    uint64_t ns1, t1;
+    do {
+        ns1 = monotonic_ns();
+        t1 = wwv_perf_now();
+    } while (ns1 - ns0 < PERF_CALIBRATE_NS);
+    return (t1 > t0) ? (double)(ns1 - ns0) / (double)(t1 - t0) : 1.0;
+#else
+    return 1.0;
+#endif
+}
+
+static int bucket_of(uint64_t ns) {
+    int b = 0;
+    while (ns > 1 && b < WWV_PERF_HIST_BUCKETS - 1) {
+        ns >>= 1;
+        b++;
+    }
+    return b;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+wwv_perf_t *wwv_perf_create(void) {
+#ifdef WWV_PERF_ENABLED
+    /* calloc cannot be relied on for _Alignas beyond max_align_t */
+    wwv_perf_t *perf = wwv_aligned_alloc(PERF_CACHE_LINE, sizeof(wwv_perf_t));
+    if (!perf) return NULL;
+    wwv_perf_reset(perf);
+
+    perf->ns_per_tick = calibrate();
+    printf("[PERF] Stage timing enabled (%.3f ns/tick)\n", perf->ns_per_tick);
+    return perf;
+#else
+    (void)calibrate;
+    return NULL;
+#endif
+}
+
+void wwv_perf_destroy(wwv_perf_t *perf) {
+    if (!perf) return;
+    wwv_aligned_free(perf);
+}
+
+void wwv_perf_reset(wwv_perf_t *perf) {
+    if (!perf) return;
+    for (int s = 0; s < WWV_PERF_STAGE_COUNT; s++) {
+        perf_stage_t *st = &perf->stage[s];
+        atomic_init(&st->count, 0);
+        atomic_init(&st->total_ns, 0);
+        atomic_init(&st->max_ns, 0);
+        for (int b = 0; b < WWV_PERF_HIST_BUCKETS; b++) {
+            atomic_init(&st->histogram[b], 0);
+        }
+    }
+}
+
+void wwv_perf_record(wwv_perf_t *perf, wwv_perf_stage_t stage, uint64_t ticks) {
+    if (!perf || (unsigned)stage >= WWV_PERF_STAGE_COUNT) return;
+
+    perf_stage_t *st = &perf->stage[stage];
+    uint64_t ns = (uint64_t)((double)ticks * perf->ns_per_tick);
+
+    atomic_fetch_add_explicit(&st->count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&st->total_ns, ns, memory_order_relaxed);
+    atomic_fetch_add_explicit(&st->histogram[bucket_of(ns)], 1, memory_order_relaxed);
+
+    uint_fast64_t max = atomic_load_explicit(&st->max_ns, memory_order_relaxed);
+    while (ns > max &&
+           !atomic_compare_exchange_weak_explicit(&st->max_ns, &max, ns,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+void wwv_perf_get_stats(wwv_perf_t *perf, wwv_perf_stats_t *stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!perf) return;
+
+    stats->enabled = true;
+    for (int s = 0; s < WWV_PERF_STAGE_COUNT; s++) {
+        perf_stage_t *st = &perf->stage[s];
+        wwv_perf_stage_stats_t *out = &stats->stage[s];
+        out->count = atomic_load_explicit(&st->count, memory_order_relaxed);
+        out->total_ns = atomic_load_explicit(&st->total_ns, memory_order_relaxed);
+        out->max_ns = atomic_load_explicit(&st->max_ns, memory_order_relaxed);
+        for (int b = 0; b < WWV_PERF_HIST_BUCKETS; b++) {
+            out->histogram[b] = atomic_load_explicit(&st->histogram[b], memory_order_relaxed);
+        }
+    }
+}
+
+void wwv_perf_stats_delta(const wwv_perf_stats_t *now, const wwv_perf_stats_t *prev,
+                          wwv_perf_stats_t *delta) {
+    if (!now || !prev || !delta) return;
+
+    delta->enabled = now->enabled;
+    for (int s = 0; s < WWV_PERF_STAGE_COUNT; s++) {
+        const wwv_perf_stage_stats_t *a = &now->stage[s];
+        const wwv_perf_stage_stats_t *b = &prev->stage[s];
+        wwv_perf_stage_stats_t *d = &delta->stage[s];
+        static const wwv_perf_stage_stats_t zero;
+        if (a->count < b->count) b = &zero;     /* Reset since prev */
+        d->count = a->count - b->count;
+        d->total_ns = a->total_ns - b->total_ns;
+        d->max_ns = 0;
+        for (int k = 0; k < WWV_PERF_HIST_BUCKETS; k++) {
+            d->histogram[k] = a->histogram[k] - b->histogram[k];
+            if (d->histogram[k]) d->max_ns = 2ULL << k;
+        }
+        /* The max is not subtractive: bound the interval's by its top
+         * bucket, exact when the running max fell inside the interval */
+        if (d->max_ns > a->max_ns || a->max_ns > b->max_ns) d->max_ns = a->max_ns;
+    }
+}
+
+uint64_t wwv_perf_percentile_ns(const wwv_perf_stage_stats_t *stage, float q) {
+    if (!stage || stage->count == 0) return 0;
+    if (q < 0.0f) q = 0.0f;
+    if (q > 1.0f) q = 1.0f;
+
+    uint64_t total = 0;
+    for (int b = 0; b < WWV_PERF_HIST_BUCKETS; b++) total += stage->histogram[b];
+    if (total == 0) return 0;
+
+    uint64_t target = (uint64_t)(q * (double)total);
+    if (target >= total) target = total - 1;
+
+    uint64_t seen = 0;
+    for (int b = 0; b < WWV_PERF_HIST_BUCKETS; b++) {
+        seen += stage->histogram[b];
+        if (seen > target) return 2ULL << b;
+    }
+    return stage->max_ns;
+}
+
+const char *wwv_perf_stage_name(wwv_perf_stage_t stage) {
+    if ((unsigned)stage >= WWV_PERF_STAGE_COUNT) return "unknown";
+    return g_stage_names[stage];
+}
+
+void wwv_perf_print(const wwv_perf_stats_t *stats, double elapsed_sec) {
+    if (!stats) return;
+
+    printf("\n=== PERF STAGES ===\n");
+    if (!stats->enabled) {
+        printf("Stage timing not compiled in (build with WWV_PERF_ENABLED)\n");
+        printf("===================\n");
+        return;
+    }
+
+    printf("%-16s %10s %10s %10s %10s %10s %7s\n",
+           "stage", "count", "mean_ns", "p50_ns", "p99_ns", "max_ns", "budget");
+    for (int s = 0; s < WWV_PERF_STAGE_COUNT; s++) {
+        const wwv_perf_stage_stats_t *st = &stats->stage[s];
+        if (st->count == 0) continue;
+
+        double mean = (double)st->total_ns / (double)st->count;
+        double budget = (elapsed_sec > 0.0) ? 100.0 * st->total_ns / (elapsed_sec * 1e9) : 0.0;
+        printf("%-16s %10llu %10.0f %10llu %10llu %10llu %6.2f%%\n",
+               g_stage_names[s],
+               (unsigned long long)st->count, mean,
+               (unsigned long long)wwv_perf_percentile_ns(st, 0.50f),
+               (unsigned long long)wwv_perf_percentile_ns(st, 0.99f),
+               (unsigned long long)st->max_ns, budget);
+    }
+    printf("===================\n");
+}
@@ -0,0 +1,248 @@
+/**
+ * @file wwv_refclock.c
+ * @brief NTP SHM / chrony SOCK reference clock writer
+ *
+ * Segment and datagram layouts are the daemons' own (ntpd refclock_shm.c
+ * struct shmTime, chrony refclock_sock.c struct sock_sample), native
+ * endianness and alignment as both sides are on one host.
+ */
+
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
+#include "wwv_refclock.h"
+#include "wwv_arena.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#define SHM_KEY_BASE        0x4E545030      /* "NTP0" */
+#define SOCK_MAGIC          0x534f434b      /* "SOCK" */
+#define DEFAULT_PRECISION   (-10)
+
+#ifndef _WIN32
+
+/* ntpd refclock_shm.c */
+struct shm_time {
+    int mode;                   /* 1: reader checks count around its copy */
+    volatile int count;
+    time_t clock_sec;
+    int clock_usec;
+    time_t receive_sec;
+    int receive_usec;
+    int leap;
+    int precision;
+    int nsamples;
+    volatile int valid;
+    unsigned clock_nsec;
+    unsigned receive_nsec;
+    int dummy[8];
+};
+
+/* chrony refclock_sock.c */
+struct sock_sample {
+    struct timeval tv;          /* Receive time */
+    double offset;              /* Reference minus receive time, seconds */
+    int pulse;
+    int leap;
+    int pad;
+    int magic;
+};
+
+#endif
+
+struct wwv_refclock {
+    wwv_refclock_kind_t kind;
+    int precision;
+#ifndef _WIN32
+    struct shm_time *shm;
+    int sock;
+    struct sockaddr_un addr;    /* chrony's socket; sent to per sample, so it may start later */
+#endif
+    uint64_t published;
+    uint64_t failed;
+};
+
+/*============================================================================
+ * Time Helpers
+ *============================================================================*/
+
+int64_t wwv_refclock_unix_time(int year, int day, int hour, int minute) {
+    /* Days from 1970-01-01 to January 1 of the year (civil calendar) */
+    int64_t y = 2000 + year - 1;
+    int64_t days = 365 * (y - 1969) + (y / 4 - 1969 / 4) - (y / 100 - 1969 / 100) +
+                   (y / 400 - 1969 / 400);
+    days += day - 1;
+    return ((days * 24 + hour) * 60 + minute) * 60;
+}
+
+int64_t wwv_refclock_host_ns(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/*============================================================================
+ * Open / Close
+ *============================================================================*/
+
+#ifndef _WIN32
+
+static bool open_shm(wwv_refclock_t *rc, int unit) {
+    int perm = (unit < 2) ? 0600 : 0666;
+    int id = shmget((key_t)(SHM_KEY_BASE + unit), sizeof(struct shm_time), IPC_CREAT | perm);
+    if (id < 0) {
+        printf("[REFCLOCK] shmget unit %d failed: %s\n", unit, strerror(errno));
+        return false;
+    }
+    void *p = shmat(id, NULL, 0);
+    if (p == (void *)-1) {
+        printf("[REFCLOCK] shmat unit %d failed: %s\n", unit, strerror(errno));
+        return false;
+    }
+    rc->shm = (struct shm_time *)p;
+    rc->shm->mode = 1;
+    rc->shm->valid = 0;
+    rc->shm->nsamples = 3;
+    printf("[REFCLOCK] NTP SHM unit %d attached\n", unit);
+    return true;
+}
+
+static bool open_sock(wwv_refclock_t *rc, const char *path) {
+    if (!path || strlen(path) >= sizeof(rc->addr.sun_path)) return false;
+
+    rc->sock = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (rc->sock < 0) {
+        printf("[REFCLOCK] socket failed: %s\n", strerror(errno));
+        return false;
+    }
+    rc->addr.sun_family = AF_UNIX;
+    strcpy(rc->addr.sun_path, path);
+    printf("[REFCLOCK] chrony SOCK %s\n", path);
+    return true;
+}
+
+#endif
+
+wwv_refclock_t *wwv_refclock_open(const wwv_refclock_config_t *config) {
+    if (!config) return NULL;
+#ifdef _WIN32
+    printf("[REFCLOCK] Not supported on this platform\n");
+    return NULL;
+#else
+    wwv_refclock_t *rc = (wwv_refclock_t *)wwv_calloc(1, sizeof(wwv_refclock_t));
+    if (!rc) return NULL;
+
+    rc->kind = config->kind;
+    rc->precision = config->precision ? config->precision : DEFAULT_PRECISION;
+    rc->sock = -1;
+
+    bool ok = (config->kind == WWV_REFCLOCK_NTP_SHM) ? open_shm(rc, config->shm_unit)
+                                                     : open_sock(rc, config->sock_path);
+    if (!ok) {
+        wwv_refclock_close(rc);
+        return NULL;
+    }
+    return rc;
+#endif
+}
+
+void wwv_refclock_close(wwv_refclock_t *rc) {
+    if (!rc) return;
+#ifndef _WIN32
+    if (rc->shm) shmdt((const void *)rc->shm);
+    if (rc->sock >= 0) close(rc->sock);
+#endif
+    wwv_free(rc);
+}
+
+/*============================================================================
+ * Publish
+ *============================================================================*/
+
+#ifndef _WIN32
+
+static void split_ns(int64_t ns, int64_t *sec, int64_t *nsec) {
+    *sec = ns / 1000000000;
+    *nsec = ns % 1000000000;
+    if (*nsec < 0) {
+        *nsec += 1000000000;
+        (*sec)--;
+    }
+}
+
+static bool publish_shm(wwv_refclock_t *rc, const wwv_refclock_sample_t *s) {
+    struct shm_time *shm = rc->shm;
+    int64_t recv_sec, recv_nsec;
+    split_ns(s->receive_ns, &recv_sec, &recv_nsec);
+
+    /* Seqlock: readers discard a copy taken while count moved */
+    shm->valid = 0;
+    shm->count++;
+    atomic_thread_fence(memory_order_release);
+
+    shm->clock_sec = (time_t)s->utc_sec;
+    shm->clock_usec = 0;
+    shm->clock_nsec = 0;
+    shm->receive_sec = (time_t)recv_sec;
+    shm->receive_usec = (int)(recv_nsec / 1000);
+    shm->receive_nsec = (unsigned)recv_nsec;
+    shm->leap = (int)s->leap;
+    shm->precision = rc->precision;
+
+    atomic_thread_fence(memory_order_release);
+    shm->count++;
+    shm->valid = 1;
+    return true;
+}
+
+static bool publish_sock(wwv_refclock_t *rc, const wwv_refclock_sample_t *s) {
+    int64_t recv_sec, recv_nsec;
+    split_ns(s->receive_ns, &recv_sec, &recv_nsec);
+
+    struct sock_sample sample;
+    memset(&sample, 0, sizeof(sample));
+    sample.tv.tv_sec = (time_t)recv_sec;
+    sample.tv.tv_usec = (suseconds_t)(recv_nsec / 1000);
+    sample.offset = (double)(s->utc_sec - recv_sec) - (double)(recv_nsec / 1000) * 1e-6;
+    sample.pulse = 0;
+    sample.leap = (int)s->leap;
+    sample.magic = SOCK_MAGIC;
+
+    return sendto(rc->sock, &sample, sizeof(sample), MSG_DONTWAIT,
+                  (const struct sockaddr *)&rc->addr, sizeof(rc->addr)) == (ssize_t)sizeof(sample);
+}
+
+#endif
+
+bool wwv_refclock_publish(wwv_refclock_t *rc, const wwv_refclock_sample_t *sample) {
+    if (!rc || !sample) return false;
+
+    bool ok = false;
+#ifndef _WIN32
+    ok = rc->shm ? publish_shm(rc, sample) : publish_sock(rc, sample);
+#endif
+    if (ok) rc->published++;
+    else rc->failed++;
+    return ok;
+}
+
+uint64_t wwv_refclock_get_published(const wwv_refclock_t *rc) {
+    return rc ? rc->published : 0;
+}
+
+uint64_t wwv_refclock_get_failed(const wwv_refclock_t *rc) {
+    return rc ? rc->failed : 0;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file wwv_spsc_ring.c
+ * @brief Lock-free SPSC ring buffer
+ *
+ * head = next element the consumer reads, tail = next slot the producer
+ * writes; both increase monotonically and are masked on access. The
+ * producer publishes with a release store of tail after copying, and the
+ * consumer frees space with a release store of head after copying out.
+ *
+ * Both index stores are sequentially consistent, so a thread that stores
+ * its index and then checks a peer's "sleeping" flag (see
+ * detector_pipeline.c) cannot miss a wakeup.
+ */
+
+#include "wwv_spsc_ring.h"
+#include "wwv_arena.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RING_CACHE_LINE 64
+
+struct wwv_spsc_ring {
+    _Alignas(RING_CACHE_LINE) atomic_size_t head;
+    _Alignas(RING_CACHE_LINE) atomic_size_t tail;
+    _Alignas(RING_CACHE_LINE) size_t capacity;
+    size_t mask;
+    size_t elem_size;
+    unsigned char *data;
+};
+
+wwv_spsc_ring_t *wwv_spsc_ring_create(size_t elem_size, size_t min_capacity) {
+    if (elem_size == 0 || min_capacity == 0) return NULL;
+
+    size_t capacity = 1;
+    while (capacity < min_capacity) capacity <<= 1;
+
+    /* calloc cannot be relied on for _Alignas beyond max_align_t */
+    void *mem = wwv_aligned_alloc(RING_CACHE_LINE, sizeof(wwv_spsc_ring_t));
+    if (!mem) return NULL;
+
+    wwv_spsc_ring_t *ring = (wwv_spsc_ring_t *)mem;
+    memset(ring, 0, sizeof(*ring));
+    ring->data = (unsigned char *)wwv_malloc(capacity * elem_size);
+    if (!ring->data) {
+        wwv_spsc_ring_destroy(ring);
+        return NULL;
+    }
+
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    ring->capacity = capacity;
+    ring->mask = capacity - 1;
+    ring->elem_size = elem_size;
+    return ring;
+}
+
+void wwv_spsc_ring_destroy(wwv_spsc_ring_t *ring) {
+    if (!ring) return;
+    wwv_free(ring->data);
+    wwv_aligned_free(ring);
+}
+
+/* Copy count elements between linear memory and the ring starting at index,
+ * splitting at the wrap point */
+static void copy_in(wwv_spsc_ring_t *ring, size_t index, const unsigned char *src, size_t count) {
+    size_t pos = index & ring->mask;
+    size_t first = ring->capacity - pos;
+    if (first > count) first = count;
+
+    memcpy(ring->data + pos * ring->elem_size, src, first * ring->elem_size);
+    memcpy(ring->data, src + first * ring->elem_size, (count - first) * ring->elem_size);
+}
+
+static void copy_out(const wwv_spsc_ring_t *ring, size_t index, unsigned char *dst, size_t count) {
+    size_t pos = index & ring->mask;
+    size_t first = ring->capacity - pos;
+    if (first > count) first = count;
+
+    memcpy(dst, ring->data + pos * ring->elem_size, first * ring->elem_size);
+    memcpy(dst + first * ring->elem_size, ring->data, (count - first) * ring->elem_size);
+}
+
+size_t wwv_spsc_ring_write(wwv_spsc_ring_t *ring, const void *src, size_t count) {
+    if (!ring || !src || count == 0) return 0;
+
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    size_t space = ring->capacity - (tail - head);
+    if (count > space) count = space;
+    if (count == 0) return 0;
+
+    copy_in(ring, tail, (const unsigned char *)src, count);
+    atomic_store(&ring->tail, tail + count);
+    return count;
+}
+
+size_t wwv_spsc_ring_read(wwv_spsc_ring_t *ring, void *dst, size_t max_count) {
+    if (!ring || !dst || max_count == 0) return 0;
+
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    size_t count = tail - head;
+    if (count > max_count) count = max_count;
+    if (count == 0) return 0;
+
+    copy_out(ring, head, (unsigned char *)dst, count);
+    atomic_store(&ring->head, head + count);
+    return count;
+}
+
+size_t wwv_spsc_ring_available(const wwv_spsc_ring_t *ring) {
+    if (!ring) return 0;
+    size_t tail = atomic_load((atomic_size_t *)&ring->tail);
+    size_t head = atomic_load((atomic_size_t *)&ring->head);
+    return tail - head;
+}
+
+size_t wwv_spsc_ring_capacity(const wwv_spsc_ring_t *ring) {
+    return ring ? ring->capacity : 0;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file wwv_state.c
+ * @brief Warm-start state blob builder and reader
+ */
+
+#include "wwv_state.h"
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+#define HEADER_BYTES    sizeof(wwv_state_header_t)
+#define SECTION_BYTES   sizeof(wwv_state_section_t)
+
+int64_t wwv_state_wall_ms(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/*============================================================================
+ * Writer
+ *============================================================================*/
+
+void wwv_state_writer_init(wwv_state_writer_t *w, void *buf, size_t capacity, double stream_ms) {
+    if (!w) return;
+    w->buf = (uint8_t *)buf;
+    w->capacity = capacity;
+    w->length = HEADER_BYTES;
+    w->section_count = 0;
+    w->overflow = !buf || capacity < HEADER_BYTES;
+    w->stream_ms = stream_ms;
+}
+
+bool wwv_state_put(wwv_state_writer_t *w, uint16_t id, uint16_t version,
+                   const void *payload, size_t length) {
+    if (!w || w->overflow) return false;
+    if (w->length + SECTION_BYTES + length > w->capacity) {
+        w->overflow = true;
+        return false;
+    }
+
+    wwv_state_section_t sec = {
+        .id = id,
+        .version = version,
+        .length = (uint32_t)length
+    };
+    memcpy(&w->buf[w->length], &sec, SECTION_BYTES);
+    w->length += SECTION_BYTES;
+    if (length > 0) {
+        memcpy(&w->buf[w->length], payload, length);
+        w->length += length;
+    }
+    w->section_count++;
+    return true;
+}
+
+size_t wwv_state_writer_finish(wwv_state_writer_t *w) {
+    if (!w || w->overflow) return 0;
+
+    wwv_state_header_t hdr = {
+        .magic = WWV_STATE_MAGIC,
+        .version = WWV_STATE_VERSION,
+        .section_count = w->section_count,
+        .length = (uint32_t)w->length,
+        .wall_ms = wwv_state_wall_ms(),
+        .stream_ms = w->stream_ms
+    };
+    memcpy(w->buf, &hdr, HEADER_BYTES);
+    return w->length;
+}
+
+/*============================================================================
+ * Reader
+ *============================================================================*/
+
+bool wwv_state_reader_init(wwv_state_reader_t *r, const void *blob, size_t length,
+                           double stream_ms) {
+    if (!r || !blob || length < HEADER_BYTES) return false;
+
+    wwv_state_header_t hdr;
+    memcpy(&hdr, blob, HEADER_BYTES);
+    if (hdr.magic != WWV_STATE_MAGIC || hdr.version != WWV_STATE_VERSION ||
+        hdr.length > length || hdr.length < HEADER_BYTES) {
+        return false;
+    }
+
+    int64_t elapsed = wwv_state_wall_ms() - hdr.wall_ms;
+    if (elapsed < 0) return false;
+
+    r->blob = (const uint8_t *)blob;
+    r->length = hdr.length;
+    r->section_count = hdr.section_count;
+    r->saved_stream_ms = hdr.stream_ms;
+    r->elapsed_ms = (double)elapsed;
+    r->stream_ms = stream_ms;
+    return true;
+}
+
+bool wwv_state_get(const wwv_state_reader_t *r, uint16_t id, uint16_t version,
+                   void *out, size_t size) {
+    if (!r || !out) return false;
+
+    size_t offset = HEADER_BYTES;
+    while (offset + SECTION_BYTES <= r->length) {
+        wwv_state_section_t sec;
+        memcpy(&sec, &r->blob[offset], SECTION_BYTES);
+        offset += SECTION_BYTES;
+        if (offset + sec.length > r->length) return false;
+
+        if (sec.id == id) {
+            if (sec.version != version) return false;
+            size_t n = sec.length < size ? sec.length : size;
+            memcpy(out, &r->blob[offset], n);
+            memset((uint8_t *)out + n, 0, size - n);
+            return true;
+        }
+        offset += sec.length;
+    }
+    return false;
+}
+
+double wwv_state_carry_phase(const wwv_state_reader_t *r, double saved_ms, double period_ms) {
+    /* How far past the last occurrence of that phase "now" is */
+    double since = fmod(r->saved_stream_ms + r->elapsed_ms - saved_ms, period_ms);
+    if (since < 0.0) since += period_ms;
+    return r->stream_ms - since;
+}
@@ -0,0 +1,241 @@
+/**
+ * @file wwv_thread.c
+ * @brief Portable threading primitives (Win32 / POSIX)
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE         /* pthread_setaffinity_np(), cpu_set_t */
+#endif
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE     /* sysconf(_SC_NPROCESSORS_ONLN) under -std=c11 */
+#endif
+
+#include "wwv_thread.h"
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <avrt.h>
+#else
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/* Trampoline so both platforms can use a void-returning entry point */
+typedef struct {
+    wwv_thread_fn fn;
+    void *arg;
+} thread_start_t;
+
+#ifdef _WIN32
+
+/*============================================================================
+ * Win32
+ *============================================================================*/
+
+void wwv_mutex_init(wwv_mutex_t *m)    { InitializeSRWLock(m); }
+void wwv_mutex_destroy(wwv_mutex_t *m) { (void)m; }
+void wwv_mutex_lock(wwv_mutex_t *m)    { AcquireSRWLockExclusive(m); }
+void wwv_mutex_unlock(wwv_mutex_t *m)  { ReleaseSRWLockExclusive(m); }
+
+void wwv_cond_init(wwv_cond_t *c)      { InitializeConditionVariable(c); }
+void wwv_cond_destroy(wwv_cond_t *c)   { (void)c; }
+void wwv_cond_wait(wwv_cond_t *c, wwv_mutex_t *m) {
+    SleepConditionVariableSRW(c, m, INFINITE, 0);
+}
+void wwv_cond_signal(wwv_cond_t *c)    { WakeConditionVariable(c); }
+void wwv_cond_broadcast(wwv_cond_t *c) { WakeAllConditionVariable(c); }
+
+bool wwv_cond_timedwait_ms(wwv_cond_t *c, wwv_mutex_t *m, unsigned timeout_ms) {
+    return SleepConditionVariableSRW(c, m, timeout_ms, 0) != 0;
+}
+
+static DWORD WINAPI thread_entry(LPVOID p) {
+    thread_start_t start = *(thread_start_t *)p;
+    free(p);
+    start.fn(start.arg);
+    return 0;
+}
+
+bool wwv_thread_create(wwv_thread_t *t, wwv_thread_fn fn, void *arg) {
+    thread_start_t *start = malloc(sizeof(*start));
+    if (!start) return false;
+    start->fn = fn;
+    start->arg = arg;
+
+    *t = CreateThread(NULL, 0, thread_entry, start, 0, NULL);
+    if (!*t) {
+        free(start);
+        return false;
+    }
+    return true;
+}
+
+void wwv_thread_join(wwv_thread_t t) {
+    WaitForSingleObject(t, INFINITE);
+    CloseHandle(t);
+}
+
+int wwv_cpu_count(void) {
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return si.dwNumberOfProcessors > 0 ? (int)si.dwNumberOfProcessors : 1;
+}
+
+/* MMCSS has no query for the calling thread; remember what was granted */
+static __declspec(thread) int g_tls_rt_priority;
+
+bool wwv_thread_set_affinity(uint64_t cpu_mask) {
+    return cpu_mask != 0 && SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)cpu_mask) != 0;
+}
+
+uint64_t wwv_thread_get_affinity(void) {
+    /* Only a set returns the thread mask: set the process mask, then put it back */
+    DWORD_PTR process, system;
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &process, &system)) return 0;
+    DWORD_PTR mask = SetThreadAffinityMask(GetCurrentThread(), process);
+    if (mask) SetThreadAffinityMask(GetCurrentThread(), mask);
+    return (uint64_t)mask;
+}
+
+bool wwv_thread_set_realtime(int priority) {
+    if (priority <= 0 || priority > WWV_RT_PRIORITY_MAX) return false;
+    DWORD task = 0;
+    HANDLE h = AvSetMmThreadCharacteristicsA("Pro Audio", &task);
+    if (!h) return false;
+    AvSetMmThreadPriority(h, priority >= 50 ? AVRT_PRIORITY_HIGH : AVRT_PRIORITY_NORMAL);
+    g_tls_rt_priority = priority;
+    return true;
+}
+
+int wwv_thread_get_realtime(void) {
+    return g_tls_rt_priority;
+}
+
+bool wwv_memory_lock(void) {
+    return false;
+}
+
+#else
+
+/*============================================================================
+ * POSIX
+ *============================================================================*/
+
+void wwv_mutex_init(wwv_mutex_t *m)    { pthread_mutex_init(m, NULL); }
+void wwv_mutex_destroy(wwv_mutex_t *m) { pthread_mutex_destroy(m); }
+void wwv_mutex_lock(wwv_mutex_t *m)    { pthread_mutex_lock(m); }
+void wwv_mutex_unlock(wwv_mutex_t *m)  { pthread_mutex_unlock(m); }
+
+void wwv_cond_init(wwv_cond_t *c)      { pthread_cond_init(c, NULL); }
+void wwv_cond_destroy(wwv_cond_t *c)   { pthread_cond_destroy(c); }
+void wwv_cond_wait(wwv_cond_t *c, wwv_mutex_t *m) { pthread_cond_wait(c, m); }
+void wwv_cond_signal(wwv_cond_t *c)    { pthread_cond_signal(c); }
+void wwv_cond_broadcast(wwv_cond_t *c) { pthread_cond_broadcast(c); }
+
+bool wwv_cond_timedwait_ms(wwv_cond_t *c, wwv_mutex_t *m, unsigned timeout_ms) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += timeout_ms / 1000;
+    ts.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    return pthread_cond_timedwait(c, m, &ts) == 0;
+}
+
+static void *thread_entry(void *p) {
+    thread_start_t start = *(thread_start_t *)p;
+    free(p);
+    start.fn(start.arg);
+    return NULL;
+}
+
+bool wwv_thread_create(wwv_thread_t *t, wwv_thread_fn fn, void *arg) {
+    thread_start_t *start = malloc(sizeof(*start));
+    if (!start) return false;
+    start->fn = fn;
+    start->arg = arg;
+
+    if (pthread_create(t, NULL, thread_entry, start) != 0) {
+        free(start);
+        return false;
+    }
+    return true;
+}
+
+void wwv_thread_join(wwv_thread_t t) {
+    pthread_join(t, NULL);
+}
+
+int wwv_cpu_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+bool wwv_thread_set_affinity(uint64_t cpu_mask) {
+#ifdef __linux__
+    if (cpu_mask == 0) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu = 0; cpu < 64; cpu++) {
+        if (cpu_mask & (1ull << cpu)) CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu_mask;
+    return false;
+#endif
+}
+
+uint64_t wwv_thread_get_affinity(void) {
+#ifdef __linux__
+    cpu_set_t set;
+    if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0) return 0;
+    uint64_t mask = 0;
+    for (int cpu = 0; cpu < 64; cpu++) {
+        if (CPU_ISSET(cpu, &set)) mask |= 1ull << cpu;
+    }
+    return mask;
+#else
+    return 0;
+#endif
+}
+
+bool wwv_thread_set_realtime(int priority) {
+    if (priority <= 0 || priority > WWV_RT_PRIORITY_MAX) return false;
+    struct sched_param param = { .sched_priority = priority };
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+}
+
+int wwv_thread_get_realtime(void) {
+    int policy;
+    struct sched_param param;
+    if (pthread_getschedparam(pthread_self(), &policy, &param) != 0) return 0;
+    return (policy == SCHED_FIFO || policy == SCHED_RR) ? param.sched_priority : 0;
+}
+
+bool wwv_memory_lock(void) {
+    return mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+}
+
+#endif
+
+/*============================================================================
+ * Time
+ *============================================================================*/
+
+#ifdef _WIN32
+static __declspec(thread) struct tm g_tls_tm;
+#else
+static _Thread_local struct tm g_tls_tm;
+#endif
+
+struct tm *wwv_localtime(const time_t *t) {
+#ifdef _WIN32
+    return localtime_s(&g_tls_tm, t) == 0 ? &g_tls_tm : NULL;
+#else
+    return localtime_r(t, &g_tls_tm);
+#endif
+}
@@ -0,0 +1,182 @@
+/**
+ * @file wwv_timer_wheel.c
+ * @brief Hashed timer wheel on a sample clock
+ *
+ * Each slot holds a FIFO list of the timers whose deadline tick
+ * (deadline >> slot_shift) maps to it, any round. The earliest timer is
+ * cached; finding it otherwise walks at most one revolution from the
+ * current tick and falls back to a full scan only when every armed timer
+ * is more than a revolution away.
+ */
+
+#include "wwv_timer_wheel.h"
+#include "wwv_arena.h"
+#include <math.h>
+#include <stddef.h>
+
+#define SLOT_MASK   (WWV_TIMER_WHEEL_SLOTS - 1)
+
+struct wwv_timer_wheel {
+    unsigned rate_hz;
+    unsigned slot_shift;
+    wwv_sample_t now;
+    int armed;
+    wwv_timer_t *earliest;          /* Cached, NULL = recompute */
+    wwv_timer_t *head[WWV_TIMER_WHEEL_SLOTS];
+    wwv_timer_t *tail[WWV_TIMER_WHEEL_SLOTS];
+};
+
+/*============================================================================
+ * Slot Lists
+ *============================================================================*/
+
+static unsigned slot_of(const wwv_timer_wheel_t *wheel, wwv_sample_t deadline) {
+    return (unsigned)(deadline >> wheel->slot_shift) & SLOT_MASK;
+}
+
+static void slot_unlink(wwv_timer_wheel_t *wheel, wwv_timer_t *timer) {
+    unsigned s = slot_of(wheel, timer->deadline);
+    if (timer->prev) timer->prev->next = timer->next;
+    else wheel->head[s] = timer->next;
+    if (timer->next) timer->next->prev = timer->prev;
+    else wheel->tail[s] = timer->prev;
+    timer->prev = timer->next = NULL;
+    timer->armed = false;
+    wheel->armed--;
+    if (wheel->earliest == timer) wheel->earliest = NULL;
+}
+
+/* First (earliest, then oldest-armed) timer of a slot due on the given tick */
+static wwv_timer_t *slot_first_on_tick(const wwv_timer_wheel_t *wheel, unsigned s, wwv_sample_t tick) {
+    wwv_timer_t *best = NULL;
+    for (wwv_timer_t *t = wheel->head[s]; t; t = t->next) {
+        if ((t->deadline >> wheel->slot_shift) != tick) continue;
+        if (!best || t->deadline < best->deadline) best = t;
+    }
+    return best;
+}
+
+static wwv_timer_t *find_earliest(wwv_timer_wheel_t *wheel) {
+    if (wheel->earliest || wheel->armed == 0) return wheel->earliest;
+
+    /* Nothing is armed before now (arm clamps), so walk forward one revolution */
+    wwv_sample_t tick = wheel->now >> wheel->slot_shift;
+    for (unsigned k = 0; k < WWV_TIMER_WHEEL_SLOTS; k++) {
+        wwv_timer_t *t = slot_first_on_tick(wheel, (unsigned)((tick + k) & SLOT_MASK), tick + k);
+        if (t) {
+            wheel->earliest = t;
+            return t;
+        }
+    }
+
+    /* Everything is at least one revolution out */
+    wwv_timer_t *best = NULL;
+    for (unsigned s = 0; s < WWV_TIMER_WHEEL_SLOTS; s++) {
+        for (wwv_timer_t *t = wheel->head[s]; t; t = t->next) {
+            if (!best || t->deadline < best->deadline) best = t;
+        }
+    }
+    wheel->earliest = best;
+    return best;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+wwv_timer_wheel_t *wwv_timer_wheel_create(unsigned rate_hz, unsigned slot_shift) {
+    if (rate_hz == 0 || slot_shift > 24) return NULL;
+
+    wwv_timer_wheel_t *wheel = (wwv_timer_wheel_t *)wwv_calloc(1, sizeof(wwv_timer_wheel_t));
+    if (!wheel) return NULL;
+
+    wheel->rate_hz = rate_hz;
+    wheel->slot_shift = slot_shift;
+    return wheel;
+}
+
+void wwv_timer_wheel_destroy(wwv_timer_wheel_t *wheel) {
+    if (!wheel) return;
+
+    for (unsigned s = 0; s < WWV_TIMER_WHEEL_SLOTS; s++) {
+        for (wwv_timer_t *t = wheel->head[s], *next; t; t = next) {
+            next = t->next;
+            t->prev = t->next = NULL;
+            t->armed = false;
+        }
+    }
+    wwv_free(wheel);
+}
+
+void wwv_timer_init(wwv_timer_t *timer, wwv_timer_fn fn, void *user_data) {
+    if (!timer) return;
+    timer->prev = timer->next = NULL;
+    timer->deadline = 0;
+    timer->fn = fn;
+    timer->user_data = user_data;
+    timer->armed = false;
+}
+
+void wwv_timer_arm(wwv_timer_wheel_t *wheel, wwv_timer_t *timer, wwv_sample_t deadline) {
+    if (!wheel || !timer) return;
+
+    if (timer->armed) slot_unlink(wheel, timer);
+    if (deadline < wheel->now) deadline = wheel->now;
+
+    unsigned s = slot_of(wheel, deadline);
+    timer->deadline = deadline;
+    timer->next = NULL;
+    timer->prev = wheel->tail[s];
+    if (wheel->tail[s]) wheel->tail[s]->next = timer;
+    else wheel->head[s] = timer;
+    wheel->tail[s] = timer;
+    timer->armed = true;
+    wheel->armed++;
+
+    if (wheel->earliest && deadline < wheel->earliest->deadline) {
+        wheel->earliest = timer;
+    } else if (!wheel->earliest && wheel->armed == 1) {
+        wheel->earliest = timer;
+    }
+}
+
+void wwv_timer_arm_after_ms(wwv_timer_wheel_t *wheel, wwv_timer_t *timer, double ms) {
+    if (!wheel) return;
+    double samples = ms > 0.0 ? ceil(ms * (double)wheel->rate_hz / 1000.0) : 0.0;
+    wwv_timer_arm(wheel, timer, (wwv_sample_t)samples + 1);
+}
+
+void wwv_timer_cancel(wwv_timer_wheel_t *wheel, wwv_timer_t *timer) {
+    if (!wheel || !timer || !timer->armed) return;
+    slot_unlink(wheel, timer);
+}
+
+wwv_sample_t wwv_timer_wheel_next_deadline(wwv_timer_wheel_t *wheel) {
+    if (!wheel) return WWV_TIMER_NEVER;
+    wwv_timer_t *t = find_earliest(wheel);
+    return t ? t->deadline : WWV_TIMER_NEVER;
+}
+
+int wwv_timer_wheel_advance(wwv_timer_wheel_t *wheel, wwv_sample_t now) {
+    if (!wheel) return 0;
+
+    int fired = 0;
+    wwv_timer_t *t;
+    while ((t = find_earliest(wheel)) != NULL && t->deadline <= now) {
+        wwv_sample_t deadline = t->deadline;
+        slot_unlink(wheel, t);
+        wheel->now = deadline;
+        fired++;
+        if (t->fn) t->fn(t, wwv_samples_to_ms(deadline, wheel->rate_hz), t->user_data);
+    }
+    if (now > wheel->now) wheel->now = now;
+    return fired;
+}
+
+wwv_sample_t wwv_timer_wheel_now(const wwv_timer_wheel_t *wheel) {
+    return wheel ? wheel->now : 0;
+}
+
+unsigned wwv_timer_wheel_rate(const wwv_timer_wheel_t *wheel) {
+    return wheel ? wheel->rate_hz : 0;
+}
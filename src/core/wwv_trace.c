@@ -0,0 +1,385 @@
+/**
+ * @file wwv_trace.c
+ * @brief Timeline trace: per-thread span rings and the JSON writer
+ *
+ * A session number guards every ring: a thread registers a new ring when
+ * its last one belongs to an earlier session, and marks its ring in use
+ * around each write, so wwv_trace_stop() can end the session, wait out
+ * the writes already under way and free the rings without a lock on the
+ * span path.
+ */
+
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE     /* clock_gettime(CLOCK_MONOTONIC) under -std=c11 */
+#endif
+
+#include "wwv_trace.h"
+
+#ifdef WWV_TRACE_ENABLED
+
+#include "wwv_spsc_ring.h"
+#include "wwv_thread.h"
+#include "wwv_arena.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+
+/*============================================================================
+ * Internal Configuration
+ *============================================================================*/
+
+#define TRACE_PID               1
+#define TRACE_DRAIN_EVENTS      256     /* Events moved per ring read */
+
+typedef struct {
+    const char *cat;
+    const char *name;
+    uint64_t start_ns;
+    uint64_t dur_ns;
+    double sample_ms;
+} trace_event_t;
+
+typedef struct trace_thread {
+    wwv_spsc_ring_t *ring;
+    const char *name;               /* Thread name when registered */
+    unsigned tid;
+    atomic_bool in_use;             /* A span is being written */
+    atomic_uint_fast64_t dropped;
+    bool named;                     /* Writer: thread_name metadata written */
+    struct trace_thread *next;
+} trace_thread_t;
+
+/*============================================================================
+ * Global State
+ *============================================================================*/
+
+static wwv_mutex_t g_lock = WWV_MUTEX_INITIALIZER;
+static wwv_cond_t g_wake;
+static bool g_cond_ready = false;
+static atomic_uint g_session;       /* 0 = no trace running */
+static unsigned g_last_session = 0;
+
+static wwv_trace_config_t g_config = WWV_TRACE_CONFIG_DEFAULT;
+static FILE *g_file = NULL;
+static trace_thread_t *g_threads = NULL;
+static unsigned g_thread_count = 0;
+static uint64_t g_origin_ns = 0;
+static uint64_t g_events = 0;
+static uint64_t g_dropped = 0;     /* Of rings already freed */
+static bool g_first_event = true;
+
+static wwv_thread_t g_writer;
+static bool g_writer_running = false;
+static bool g_writer_stop = false;
+
+static _Thread_local trace_thread_t *g_tls_thread = NULL;
+static _Thread_local unsigned g_tls_session = 0;
+static _Thread_local const char *g_tls_name = NULL;
+
+/*============================================================================
+ * Clock
+ *============================================================================*/
+
+static uint64_t monotonic_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+    if (!freq.QuadPart) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (uint64_t)((double)now.QuadPart * 1e9 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/*============================================================================
+ * Writer Thread
+ *============================================================================*/
+
+static void write_separator(void) {
+    fputs(g_first_event ? "\n" : ",\n", g_file);
+    g_first_event = false;
+}
+
+static void write_event(const trace_thread_t *t, const trace_event_t *ev) {
+    write_separator();
+    fprintf(g_file, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%u,"
+            "\"ts\":%.3f,\"dur\":%.3f", ev->name, ev->cat, TRACE_PID, t->tid,
+            (double)(ev->start_ns - g_origin_ns) / 1e3, (double)ev->dur_ns / 1e3);
+    if (ev->sample_ms >= 0.0) fprintf(g_file, ",\"args\":{\"sample_ms\":%.3f}", ev->sample_ms);
+    fputc('}', g_file);
+}
+
+static void write_thread_name(trace_thread_t *t) {
+    write_separator();
+    fprintf(g_file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u,"
+            "\"args\":{\"name\":\"%s\"}}", TRACE_PID, t->tid, t->name);
+    t->named = true;
+}
+
+/* Rings are only added (at the head) while a session runs */
+static void drain_all(void) {
+    trace_event_t events[TRACE_DRAIN_EVENTS];
+    uint64_t written = 0;
+
+    wwv_mutex_lock(&g_lock);
+    trace_thread_t *head = g_threads;
+    wwv_mutex_unlock(&g_lock);
+
+    for (trace_thread_t *t = head; t; t = t->next) {
+        if (!t->named && t->name) write_thread_name(t);
+        size_t n;
+        while ((n = wwv_spsc_ring_read(t->ring, events, TRACE_DRAIN_EVENTS)) > 0) {
+            for (size_t i = 0; i < n; i++) write_event(t, &events[i]);
+            written += n;
+        }
+    }
+    fflush(g_file);
+
+    wwv_mutex_lock(&g_lock);
+    g_events += written;
+    wwv_mutex_unlock(&g_lock);
+}
+
+static void writer_main(void *arg) {
+    (void)arg;
+    wwv_mutex_lock(&g_lock);
+    for (;;) {
+        bool stop = g_writer_stop;
+        wwv_mutex_unlock(&g_lock);
+
+        drain_all();
+
+        wwv_mutex_lock(&g_lock);
+        if (stop) break;
+        if (!g_writer_stop) wwv_cond_timedwait_ms(&g_wake, &g_lock, g_config.flush_ms);
+    }
+    wwv_mutex_unlock(&g_lock);
+}
+
+/*============================================================================
+ * Span Path
+ *============================================================================*/
+
+/* First span of this thread in session s */
+static trace_thread_t *register_thread(unsigned session) {
+    trace_thread_t *t = (trace_thread_t *)wwv_calloc(1, sizeof(trace_thread_t));
+    if (!t) return NULL;
+    t->ring = wwv_spsc_ring_create(sizeof(trace_event_t), g_config.ring_events);
+    if (!t->ring) {
+        wwv_free(t);
+        return NULL;
+    }
+    t->name = g_tls_name;
+    atomic_init(&t->in_use, false);
+    atomic_init(&t->dropped, 0);
+
+    wwv_mutex_lock(&g_lock);
+    bool current = atomic_load(&g_session) == session;
+    if (current) {
+        t->tid = ++g_thread_count;
+        t->next = g_threads;
+        g_threads = t;
+    }
+    wwv_mutex_unlock(&g_lock);
+
+    if (!current) {
+        wwv_spsc_ring_destroy(t->ring);
+        wwv_free(t);
+        return NULL;
+    }
+    g_tls_thread = t;
+    g_tls_session = session;
+    return t;
+}
+
+uint64_t wwv_trace_begin(void) {
+    if (atomic_load_explicit(&g_session, memory_order_relaxed) == 0) return 0;
+    return monotonic_ns();
+}
+
+void wwv_trace_span(const char *cat, const char *name, uint64_t start_ns, double sample_ms) {
+    unsigned session = atomic_load(&g_session);
+    if (session == 0 || start_ns == 0) return;
+
+    trace_thread_t *t = (g_tls_session == session) ? g_tls_thread : register_thread(session);
+    if (!t) return;
+
+    /* Paired with stop(): it ends the session, then waits for in_use */
+    atomic_store(&t->in_use, true);
+    if (atomic_load(&g_session) == session) {
+        uint64_t now = monotonic_ns();
+        trace_event_t ev = {
+            .cat = cat,
+            .name = name,
+            .start_ns = start_ns,
+            .dur_ns = now > start_ns ? now - start_ns : 0,
+            .sample_ms = sample_ms
+        };
+        if (wwv_spsc_ring_write(t->ring, &ev, 1) != 1) {
+            atomic_fetch_add_explicit(&t->dropped, 1, memory_order_relaxed);
+        }
+    }
+    atomic_store(&t->in_use, false);
+}
+
+void wwv_trace_thread_name(const char *name) {
+    g_tls_name = name;
+}
+
+/*============================================================================
+ * Session
+ *============================================================================*/
+
+bool wwv_trace_start(const char *path, const wwv_trace_config_t *config) {
+    if (!path) return false;
+
+    wwv_mutex_lock(&g_lock);
+    if (g_file) {
+        wwv_mutex_unlock(&g_lock);
+        return false;
+    }
+    g_file = fopen(path, "w");
+    if (!g_file) {
+        wwv_mutex_unlock(&g_lock);
+        return false;
+    }
+
+    wwv_trace_config_t defaults = WWV_TRACE_CONFIG_DEFAULT;
+    g_config = config ? *config : defaults;
+    if (g_config.ring_events == 0) g_config.ring_events = defaults.ring_events;
+    if (g_config.flush_ms == 0) g_config.flush_ms = defaults.flush_ms;
+    if (!g_cond_ready) {
+        wwv_cond_init(&g_wake);
+        g_cond_ready = true;
+    }
+
+    g_threads = NULL;
+    g_thread_count = 0;
+    g_events = 0;
+    g_dropped = 0;
+    g_first_event = true;
+    g_origin_ns = monotonic_ns();
+    fputs("[", g_file);
+    write_separator();
+    fprintf(g_file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,"
+            "\"args\":{\"name\":\"phoenix-wwv\"}}", TRACE_PID);
+
+    g_writer_stop = false;
+    g_writer_running = wwv_thread_create(&g_writer, writer_main, NULL);
+    if (!g_writer_running) {
+        fclose(g_file);
+        g_file = NULL;
+        wwv_mutex_unlock(&g_lock);
+        return false;
+    }
+    if (++g_last_session == 0) g_last_session = 1;
+    atomic_store(&g_session, g_last_session);
+    wwv_mutex_unlock(&g_lock);
+
+    printf("[TRACE] Tracing to %s\n", path);
+    return true;
+}
+
+void wwv_trace_stop(void) {
+    wwv_mutex_lock(&g_lock);
+    if (!g_file) {
+        wwv_mutex_unlock(&g_lock);
+        return;
+    }
+    atomic_store(&g_session, 0);
+    trace_thread_t *head = g_threads;
+    wwv_mutex_unlock(&g_lock);
+
+    /* Spans that saw the session before it ended finish their write */
+    for (trace_thread_t *t = head; t; t = t->next) {
+        while (atomic_load(&t->in_use)) {
+        }
+    }
+
+    wwv_mutex_lock(&g_lock);
+    g_writer_stop = true;
+    wwv_cond_signal(&g_wake);
+    wwv_mutex_unlock(&g_lock);
+    if (g_writer_running) wwv_thread_join(g_writer);
+    g_writer_running = false;
+
+    wwv_mutex_lock(&g_lock);
+    fputs("\n]\n", g_file);
+    fclose(g_file);
+    g_file = NULL;
+    while (g_threads) {
+        trace_thread_t *t = g_threads;
+        g_threads = t->next;
+        g_dropped += atomic_load(&t->dropped);
+        wwv_spsc_ring_destroy(t->ring);
+        wwv_free(t);
+    }
+    unsigned threads = g_thread_count;
+    uint64_t events = g_events;
+    uint64_t dropped = g_dropped;
+    wwv_mutex_unlock(&g_lock);
+
+    printf("[TRACE] Stopped: %llu spans from %u threads, %llu dropped\n",
+           (unsigned long long)events, threads, (unsigned long long)dropped);
+}
+
+void wwv_trace_get_stats(wwv_trace_stats_t *stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    stats->enabled = true;
+
+    wwv_mutex_lock(&g_lock);
+    stats->active = g_file != NULL;
+    stats->threads = g_thread_count;
+    stats->events = g_events;
+    stats->dropped = g_dropped;
+    for (trace_thread_t *t = g_threads; t; t = t->next) {
+        stats->dropped += atomic_load_explicit(&t->dropped, memory_order_relaxed);
+    }
+    wwv_mutex_unlock(&g_lock);
+}
+
+#else /* !WWV_TRACE_ENABLED */
+
+#include <string.h>
+
+uint64_t wwv_trace_begin(void) {
+    return 0;
+}
+
+void wwv_trace_span(const char *cat, const char *name, uint64_t start_ns, double sample_ms) {
+    (void)cat;
+    (void)name;
+    (void)start_ns;
+    (void)sample_ms;
+}
+
+void wwv_trace_thread_name(const char *name) {
+    (void)name;
+}
+
+bool wwv_trace_start(const char *path, const wwv_trace_config_t *config) {
+    (void)path;
+    (void)config;
+    return false;
+}
+
+void wwv_trace_stop(void) {
+}
+
+void wwv_trace_get_stats(wwv_trace_stats_t *stats) {
+    if (stats) memset(stats, 0, sizeof(*stats));
+}
+
+#endif /* WWV_TRACE_ENABLED */
@@ -0,0 +1,54 @@
+/**
+ * @file wwv_window_ring.c
+ * @brief Mirrored sample ring
+ */
+
+#include "wwv_window_ring.h"
+#include "wwv_arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+bool wwv_window_ring_init(wwv_window_ring_t *ring, int size) {
+    if (!ring || size <= 0) return false;
+
+    ring->data = wwv_calloc((size_t)size * 2, sizeof(float));
+    ring->size = ring->data ? size : 0;
+    ring->pos = 0;
+    return ring->data != NULL;
+}
+
+void wwv_window_ring_free(wwv_window_ring_t *ring) {
+    if (!ring) return;
+    wwv_free(ring->data);
+    ring->data = NULL;
+    ring->size = 0;
+    ring->pos = 0;
+}
+
+void wwv_window_ring_reset(wwv_window_ring_t *ring) {
+    if (!ring || !ring->data) return;
+    memset(ring->data, 0, (size_t)ring->size * 2 * sizeof(float));
+    ring->pos = 0;
+}
+
+void wwv_window_ring_write(wwv_window_ring_t *ring, const float *samples, size_t count) {
+    if (!ring || !ring->data || !samples) return;
+
+    size_t size = (size_t)ring->size;
+    if (count > size) {
+        samples += count - size;
+        ring->pos = (int)((ring->pos + count - size) % size);
+        count = size;
+    }
+
+    /* Up to two runs (wrap at size), each stored in both halves */
+    while (count > 0) {
+        size_t run = size - (size_t)ring->pos;
+        if (run > count) run = count;
+        memcpy(ring->data + ring->pos, samples, run * sizeof(float));
+        memcpy(ring->data + ring->pos + size, samples, run * sizeof(float));
+        ring->pos = (int)(((size_t)ring->pos + run) % size);
+        samples += run;
+        count -= run;
+    }
+}
@@ -24,155 +24,38 @@
 #include "sync_detector.h"
 #include "version.h"
 #include "telemetry.h"
+#include "wwv_thread.h"
+#include "wwv_arena.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
 #include <time.h>
 
-/*============================================================================
- * Public API - Window-Based Symbol Demodulator
- *============================================================================*/
-
-static void close_window(bcd_correlator_t *corr) {
-    if (!corr->window_open) return;
-
-    int total_events = corr->time_event_count + corr->freq_event_count;
-    float total_energy = corr->time_energy_sum + corr->freq_energy_sum;
-
-    /* Determine confidence and source */
-    float confidence = 0.0f;
-    const char *source = "NONE";
-
-    if (corr->time_event_count > 0 && corr->freq_event_count > 0) {
-        source = "BOTH";
-        confidence = 1.0f;
-    } else if (corr->time_event_count > 0) {
-        source = "TIME";
-        confidence = 0.6f;
-    } else if (corr->freq_event_count > 0) {
-        source = "FREQ";
-        confidence = 0.6f;
-    }
-
-    /* Estimate pulse duration */
-    float duration_ms = bcd_window_estimate_pulse_duration(corr);
-
-    /* Classify symbol (Phase 8: with position gating) */
-    bcd_corr_symbol_t symbol = BCD_CORR_SYM_NONE;
-
-    if (total_events >= MIN_EVENTS_FOR_SYMBOL && total_energy > ENERGY_THRESHOLD_LOW) {
-        symbol = bcd_symbol_classify_duration(duration_ms, corr->current_second);
-    } else if (total_events > 0) {
-        /* Some events but not enough confidence - still classify but lower confidence */
-        symbol = bcd_symbol_classify_duration(duration_ms, corr->current_second);
-        confidence *= 0.5f;
-    }
-    /* If no events at all, symbol stays NONE (no 100Hz detected this second) */
-
-    /* Calculate timestamp for this symbol (center of window) */
-    float symbol_timestamp_ms = corr->window_start_ms + (WINDOW_DURATION_MS / 2.0f);
-
-    /* Track intervals */
-    float interval_ms = 0.0f;
-    if (corr->last_symbol_ms > 0) {
-        interval_ms = symbol_timestamp_ms - corr->last_symbol_ms;
-        if (interval_ms >= 900.0f && interval_ms <= 1100.0f) {
-            corr->good_intervals++;
-        }
-    }
-
-    /* Update state machine */
-    if (corr->good_intervals >= 3) {
-        corr->state = BCD_CORR_TRACKING;
-    } else if (corr->symbol_count >= 1) {
-        corr->state = BCD_CORR_TENTATIVE;
-    }
-
-    /* Update tracking */
-    corr->last_symbol_ms = symbol_timestamp_ms;
-    corr->symbol_count++;
-
-    /* Log to CSV and telemetry */
-    char time_str[16];
-    bcd_corr_get_wall_time_str(corr->start_time, symbol_timestamp_ms, time_str, sizeof(time_str));
-
-    if (corr->csv_file) {
-        fprintf(corr->csv_file, "%s,%.1f,%d,%d,%c,%s,%.0f,%.2f,%.1f,%d,%d,%.4f,%.4f,%s\n",
-                time_str, symbol_timestamp_ms, corr->symbol_count, corr->current_second,
-                bcd_corr_symbol_char(symbol), source,
-                duration_ms, confidence, interval_ms / 1000.0f,
-                corr->time_event_count, corr->freq_event_count,
-                corr->time_energy_sum, corr->freq_energy_sum,
-                bcd_corr_state_name(corr->state));
-        fflush(corr->csv_file);
-    }
-
-    /* UDP telemetry for correlation stats */
-    telem_sendf(TELEM_BCDS, "CORR,%s,%.1f,%d,%d,%c,%s,%.0f,%.2f,%.1f,%d,%d,%.4f,%.4f,%s",
-                time_str, symbol_timestamp_ms, corr->symbol_count, corr->current_second,
-                bcd_corr_symbol_char(symbol), source,
-                duration_ms, confidence, interval_ms / 1000.0f,
-                corr->time_event_count, corr->freq_event_count,
-                corr->time_energy_sum, corr->freq_energy_sum,
-                bcd_corr_state_name(corr->state));
-
-    /* Only emit if we detected something */
-    if (symbol != BCD_CORR_SYM_NONE) {
-        /* Step 9: UDP telemetry with second position and confidence */
-        telem_sendf(TELEM_BCDS, "SYM,%c,%d,%.0f,%.2f",
-                    bcd_corr_symbol_char(symbol),
-                    corr->current_second,
-                    duration_ms,
-                    confidence);
-
-        /* Console output (verbose during development) */
-        printf("[BCD] Sec %02d: '%c' dur=%.0fms conf=%.2f src=%s events=%d+%d state=%s\n",
-               corr->current_second, bcd_corr_symbol_char(symbol),
-               duration_ms, confidence, source,
-               corr->time_event_count, corr->freq_event_count,
-               bcd_corr_state_name(corr->state));
-
-        /* Callback */
-        if (corr->callback) {
-            bcd_symbol_event_t event = {
-                .symbol = symbol,
-                .timestamp_ms = symbol_timestamp_ms,
-                .duration_ms = duration_ms,
-                .confidence = confidence,
-                .source = source
-            };
-            corr->callback(&event, corr->callback_user_data);
-        }
-    }
-
-    /* Mark window closed */
-    corr->window_open = false;
-}
-
 /*============================================================================
  * Public API
  *============================================================================*/
 
 bcd_correlator_t *bcd_correlator_create(const char *csv_path) {
-    bcd_correlator_t *corr = (bcd_correlator_t *)calloc(1, sizeof(bcd_correlator_t));
+    bcd_correlator_t *corr = (bcd_correlator_t *)wwv_calloc(1, sizeof(bcd_correlator_t));
     if (!corr) return NULL;
 
     corr->state = BCD_CORR_ACQUIRING;
     corr->start_time = time(NULL);
     corr->window_open = false;
+    corr->closed_second = -1;
+    wwv_timer_init(&corr->close_timer, bcd_window_on_close_timer, corr);
 
     if (csv_path) {
-        corr->csv_file = fopen(csv_path, "w");
-        if (corr->csv_file) {
+        corr->csv_log = wwv_csv_log_open(csv_path);
+        if (corr->csv_log) {
             char time_str[64];
             time_t now = time(NULL);
-            strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", localtime(&now));
-            fprintf(corr->csv_file, "# Phoenix SDR BCD Correlator Log v%s\n", PHOENIX_VERSION_FULL);
-            fprintf(corr->csv_file, "# Started: %s\n", time_str);
-            fprintf(corr->csv_file, "# Window-based integration: 1-second windows gated on sync LOCKED\n");
-            fprintf(corr->csv_file, "time,timestamp_ms,symbol_num,second,symbol,source,duration_ms,confidence,interval_sec,time_events,freq_events,time_energy,freq_energy,state\n");
-            fflush(corr->csv_file);
+            strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", wwv_localtime(&now));
+            wwv_csv_log_header(corr->csv_log, "# Phoenix SDR BCD Correlator Log v%s\n", PHOENIX_VERSION_FULL);
+            wwv_csv_log_header(corr->csv_log, "# Started: %s\n", time_str);
+            wwv_csv_log_header(corr->csv_log, "# Window-based integration: 1-second windows gated on sync LOCKED\n");
+            wwv_csv_log_header(corr->csv_log, "time,timestamp_ms,symbol_num,second,symbol,source,duration_ms,confidence,interval_sec,time_events,freq_events,time_energy,freq_energy,state\n");
         }
     }
 
@@ -185,12 +68,12 @@ void bcd_correlator_destroy(bcd_correlator_t *corr) {
     if (!corr) return;
 
     /* Close any open window */
-    if (corr->window_open) {
-        close_window(corr);
-    }
+    bcd_window_close(corr);
+    bcd_correlator_set_timer_wheel(corr, NULL);
+    bcd_integrator_destroy(corr);
 
-    if (corr->csv_file) fclose(corr->csv_file);
-    free(corr);
+    wwv_csv_log_close(corr->csv_log);
+    wwv_free(corr);
 }
 
 void bcd_correlator_set_sync_source(bcd_correlator_t *corr, sync_detector_t *sync) {
@@ -199,6 +82,13 @@ void bcd_correlator_set_sync_source(bcd_correlator_t *corr, sync_detector_t *syn
     printf("[BCD] Sync source linked - will gate on LOCKED state\n");
 }
 
+void bcd_correlator_set_timer_wheel(bcd_correlator_t *corr, wwv_timer_wheel_t *wheel) {
+    if (!corr) return;
+    if (corr->timers) wwv_timer_cancel(corr->timers, &corr->close_timer);
+    corr->timers = wheel;
+    corr->closed_second = -1;
+}
+
 void bcd_correlator_set_callback(bcd_correlator_t *corr,
                                  bcd_corr_symbol_callback_fn callback,
                                  void *user_data) {
@@ -207,8 +97,28 @@ void bcd_correlator_set_callback(bcd_correlator_t *corr,
     corr->callback_user_data = user_data;
 }
 
+bool bcd_correlator_set_integration(bcd_correlator_t *corr, int minutes) {
+    if (!corr) return false;
+    if (!bcd_integrator_configure(corr, minutes)) return false;
+    if (minutes > 0) {
+        printf("[BCD] Multi-minute integration: %d minutes\n", corr->integ->minutes);
+    }
+    return true;
+}
+
+bool bcd_correlator_get_integrated_frame(bcd_correlator_t *corr, bcd_integrated_frame_t *out) {
+    if (!corr || !corr->integ || !corr->integ->have_result) return false;
+    if (out) *out = corr->integ->result;
+    return true;
+}
+
+void bcd_correlator_set_telemetry(bcd_correlator_t *corr, telem_ctx_t *ctx) {
+    if (!corr) return;
+    corr->telem = ctx;
+}
+
 void bcd_correlator_time_event(bcd_correlator_t *corr,
-                               float timestamp_ms,
+                               double timestamp_ms,
                                float duration_ms,
                                float peak_energy) {
     if (!corr) return;
@@ -216,6 +126,10 @@ void bcd_correlator_time_event(bcd_correlator_t *corr,
     /* Check for window transition first */
     bcd_window_check_transition(corr, timestamp_ms);
 
+    if (corr->integ) {
+        bcd_integrator_add_pulse(corr, bcd_window_get_minute_anchor(corr), timestamp_ms, duration_ms);
+    }
+
     /* If no window open (sync not locked), ignore event */
     if (!corr->window_open) return;
 
@@ -230,7 +144,7 @@ void bcd_correlator_time_event(bcd_correlator_t *corr,
 }
 
 void bcd_correlator_freq_event(bcd_correlator_t *corr,
-                               float timestamp_ms,
+                               double timestamp_ms,
                                float duration_ms,
                                float accum_energy) {
     if (!corr) return;
@@ -238,6 +152,10 @@ void bcd_correlator_freq_event(bcd_correlator_t *corr,
     /* Check for window transition first */
     bcd_window_check_transition(corr, timestamp_ms);
 
+    if (corr->integ) {
+        bcd_integrator_add_pulse(corr, bcd_window_get_minute_anchor(corr), timestamp_ms, duration_ms);
+    }
+
     /* If no window open (sync not locked), ignore event */
     if (!corr->window_open) return;
 
@@ -273,7 +191,7 @@ char bcd_corr_symbol_char(bcd_corr_symbol_t sym) {
     }
 }
 
-float bcd_correlator_get_last_symbol_ms(bcd_correlator_t *corr) {
+double bcd_correlator_get_last_symbol_ms(bcd_correlator_t *corr) {
     return corr ? corr->last_symbol_ms : 0.0f;
 }
 
@@ -293,5 +211,14 @@ void bcd_correlator_print_stats(bcd_correlator_t *corr) {
     printf("Last symbol at: %.1fms\n", corr->last_symbol_ms);
     printf("Current window: %s (second %d)\n",
            corr->window_open ? "OPEN" : "CLOSED", corr->current_second);
+    if (corr->integ) {
+        const bcd_integrator_t *integ = corr->integ;
+        printf("Integration: %d min, decodes %u, accepted %u, misaligned %u\n",
+               integ->minutes, (unsigned)integ->decodes,
+               (unsigned)integ->accepted, (unsigned)integ->misaligned);
+        if (integ->have_result) {
+            printf("Integrated frame: %s\n", integ->result.symbols);
+        }
+    }
     printf("============================\n");
 }
@@ -0,0 +1,442 @@
+/**
+ * @file bcd_integrator.c
+ * @brief Multi-minute BCD frame integration
+ *
+ * Each pulse the time/freq detectors report is spread over a ring of
+ * minute rows (BCD_INTEG_BINS bins of BCD_INTEG_BIN_MS each, indexed from
+ * the minute anchor) as envelope coverage: the fraction of each bin the
+ * 100 Hz subcarrier was up. Adding a pulse touches at most ~10 bins, so
+ * the cost per second is O(1); the decode runs once per minute over the
+ * fixed 60 x N ring.
+ *
+ * Decode of the averaged frame:
+ *   - Pulse edge: where coverage rises in every second (all three symbols
+ *     are up for their first 200 ms), to a fraction of a bin from the
+ *     partly covered edge bin
+ *   - Reference: the bin centred nearest 100 ms after the edge, up for
+ *     every symbol
+ *   - ONE evidence: the two bins centred nearest 350 ms (200-500 ms is up
+ *     for ONE and marker only)
+ *   - Marker evidence: the two bins centred nearest 650 ms (500-800 ms)
+ *   - Second numbering: the one that best puts marker evidence at :00,
+ *     :09 .. :59 (at least BCD_INTEG_MIN_MARKERS of the seven present)
+ * Background (coverage where no symbol is up) comes off every tap. Each
+ * quantity (minute, hour, day, year) is then solved over its legal values
+ * jointly across the rows, a row k minutes back holding the candidate
+ * minus whatever those k minutes carried into it. The decode is accepted
+ * when every quantity beats its runner-up by BCD_INTEG_MIN_MARGIN noise
+ * sigmas (estimated from the background's spread).
+ */
+
+#include "bcd_correlator_internal.h"
+#include "wwv_arena.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BINS_PER_SECOND     (BCD_INTEG_BINS / 60)
+#define MINUTE_MS           60000.0
+
+
+/*============================================================================
+ * Frame Layout
+ *============================================================================*/
+
+typedef struct {
+    int count;
+    int secs[4];
+    int weights[4];
+} integ_field_t;
+
+static const integ_field_t FIELD_MIN_UNITS  = { 4, { 10, 11, 12, 13 }, { 1, 2, 4, 8 } };
+static const integ_field_t FIELD_MIN_TENS   = { 3, { 15, 16, 17 },     { 10, 20, 40 } };
+static const integ_field_t FIELD_HOUR_UNITS = { 4, { 20, 21, 22, 23 }, { 1, 2, 4, 8 } };
+static const integ_field_t FIELD_HOUR_TENS  = { 2, { 25, 26 },         { 10, 20 } };
+static const integ_field_t FIELD_DAY_UNITS  = { 4, { 30, 31, 32, 33 }, { 1, 2, 4, 8 } };
+static const integ_field_t FIELD_DAY_TENS   = { 4, { 35, 36, 37, 38 }, { 10, 20, 40, 80 } };
+static const integ_field_t FIELD_DAY_HUNDS  = { 2, { 40, 41 },         { 100, 200 } };
+static const integ_field_t FIELD_YEAR_UNITS = { 4, { 4, 5, 6, 7 },     { 1, 2, 4, 8 } };
+static const integ_field_t FIELD_YEAR_TENS  = { 4, { 51, 52, 53, 54 }, { 10, 20, 40, 80 } };
+
+typedef struct {
+    int count;
+    const integ_field_t *digits[3];     /* Units first */
+} integ_quantity_t;
+
+static const integ_quantity_t QTY_MINUTE = { 2, { &FIELD_MIN_UNITS, &FIELD_MIN_TENS } };
+static const integ_quantity_t QTY_HOUR   = { 2, { &FIELD_HOUR_UNITS, &FIELD_HOUR_TENS } };
+static const integ_quantity_t QTY_DAY    = { 3, { &FIELD_DAY_UNITS, &FIELD_DAY_TENS, &FIELD_DAY_HUNDS } };
+static const integ_quantity_t QTY_YEAR   = { 2, { &FIELD_YEAR_UNITS, &FIELD_YEAR_TENS } };
+
+static const int POW10[3] = { 1, 10, 100 };
+
+/* Bits of one digit value (scaled: tens as 10..90), least significant first */
+static unsigned digit_bits(const integ_field_t *f, int value) {
+    unsigned bits = 0;
+    for (int k = f->count - 1; k >= 0; k--) {
+        if (value >= f->weights[k]) {
+            bits |= 1u << k;
+            value -= f->weights[k];
+        }
+    }
+    return bits;
+}
+
+static int digit_value(int k, int value) {
+    return (value / POW10[k] % 10) * POW10[k];
+}
+
+static void set_symbols(char *symbols, const integ_quantity_t *q, int value) {
+    for (int k = 0; k < q->count; k++) {
+        const integ_field_t *f = q->digits[k];
+        unsigned bits = digit_bits(f, digit_value(k, value));
+        for (int b = 0; b < f->count; b++) symbols[f->secs[b]] = (bits >> b & 1u) ? '1' : '0';
+    }
+}
+
+/*============================================================================
+ * Minute Ring
+ *============================================================================*/
+
+static float *row_bins(bcd_integrator_t *integ, int64_t minute) {
+    return integ->bins + (size_t)(minute % integ->minutes) * BCD_INTEG_BINS;
+}
+
+static bool row_valid(const bcd_integrator_t *integ, int64_t minute) {
+    return minute >= 0 && integ->row_minute[minute % integ->minutes] == minute;
+}
+
+static void start_row(bcd_integrator_t *integ, int64_t minute) {
+    int r = (int)(minute % integ->minutes);
+    integ->row_minute[r] = minute;
+    memset(integ->bins + (size_t)r * BCD_INTEG_BINS, 0, BCD_INTEG_BINS * sizeof(float));
+}
+
+/*============================================================================
+ * Decode
+ *============================================================================*/
+
+/* Envelope evidence of one second of one row */
+typedef struct {
+    float ref;                      /* Up for every symbol */
+    float one;                      /* ONE evidence minus half the reference */
+    float marker;                   /* Marker evidence minus half the reference */
+} integ_second_t;
+
+/* Bin offsets from the start of a second slot for a pulse edge (in bins) */
+typedef struct {
+    int ref;
+    int one;                        /* and one + 1 */
+    int marker;                     /* and marker + 1 */
+    int off;                        /* Down for every symbol: background */
+} integ_taps_t;
+
+static integ_taps_t taps_for_edge(double edge) {
+    integ_taps_t t;
+    t.ref = (int)lround(edge + 0.5);
+    t.one = (int)lround(edge + 3.5) - 1;
+    t.marker = (int)lround(edge + 6.5) - 1;
+    t.off = (int)lround(edge + 8.5);
+    return t;
+}
+
+/* Spurious coverage of a row (mean, variance): what shows up where no
+ * symbol is up */
+static void row_background(const float *bins, const integ_taps_t *t, float *mean, float *var) {
+    float sum = 0.0f, sum2 = 0.0f;
+    for (int i = 0; i < 60; i++) {
+        float c = bins[(i * BINS_PER_SECOND + t->off) % BCD_INTEG_BINS];
+        sum += c;
+        sum2 += c * c;
+    }
+    *mean = sum / 60.0f;
+    *var = fmaxf(sum2 / 60.0f - *mean * *mean, 0.0f);
+}
+
+/* Background comes off every tap first; otherwise a missed pulse in noise
+ * reads as ONE (the ONE taps see as much noise as the reference) */
+static integ_second_t second_evidence(const float *bins, int slot, const integ_taps_t *t,
+                                      float background) {
+    int base = slot * BINS_PER_SECOND;
+    integ_second_t e;
+    float ref = bins[(base + t->ref) % BCD_INTEG_BINS] - background;
+    float one = 0.5f * (bins[(base + t->one) % BCD_INTEG_BINS] +
+                        bins[(base + t->one + 1) % BCD_INTEG_BINS]) - background;
+    float marker = 0.5f * (bins[(base + t->marker) % BCD_INTEG_BINS] +
+                           bins[(base + t->marker + 1) % BCD_INTEG_BINS]) - background;
+    e.ref = (ref > 0.0f) ? ref : 0.0f;
+    e.one = one - 0.5f * e.ref;
+    e.marker = marker - 0.5f * e.ref;
+    return e;
+}
+
+/* Evidence for one value of a quantity: ONE evidence counts for set bits,
+ * against clear ones */
+static float quantity_score(const integ_second_t *ev, const integ_quantity_t *q, int value) {
+    float score = 0.0f;
+    for (int k = 0; k < q->count; k++) {
+        const integ_field_t *f = q->digits[k];
+        unsigned bits = digit_bits(f, digit_value(k, value));
+        for (int b = 0; b < f->count; b++) {
+            float d = ev[f->secs[b]].one;
+            score += (bits >> b & 1u) ? d : -d;
+        }
+    }
+    return score;
+}
+
+/**
+ * Best legal value lo..hi over all rows, row r holding value - delta[r]
+ * (wrapping when `wraps`, otherwise that row sits the search out). Lowers
+ * *margin to the best-vs-runner-up gap over the noise of one bit's summed
+ * evidence (sigma); one bit flip moves a score by twice that evidence.
+ */
+static int solve_quantity(integ_second_t ev[][60], int n, const int *delta,
+                          const integ_quantity_t *q, int lo, int hi, bool wraps,
+                          float sigma, float *margin) {
+    int span = hi - lo + 1;
+    float best = -INFINITY, runner = -INFINITY;
+    int best_value = lo;
+
+    for (int v = lo; v <= hi; v++) {
+        float score = 0.0f;
+        for (int r = 0; r < n; r++) {
+            int vr = v - delta[r];
+            if (vr < lo) {
+                if (!wraps) continue;
+                vr += span;
+            }
+            score += quantity_score(ev[r], q, vr);
+        }
+        if (score > best) {
+            runner = best;
+            best = score;
+            best_value = v;
+        } else if (score > runner) {
+            runner = score;
+        }
+    }
+
+    float m = (best - runner) / (2.0f * sigma);
+    if (m < *margin) *margin = m;
+    return best_value;
+}
+
+static void decode_minute(bcd_correlator_t *corr, int64_t decoded, double frame_start_ms) {
+    bcd_integrator_t *integ = corr->integ;
+    const float *rows[BCD_INTEG_MAX_MINUTES];
+    int age[BCD_INTEG_MAX_MINUTES];
+    int n = 0;
+
+    for (int k = 0; k < integ->minutes && decoded - k >= 0; k++) {
+        if (!row_valid(integ, decoded - k)) continue;
+        rows[n] = row_bins(integ, decoded - k);
+        age[n] = k;
+        n++;
+    }
+    integ->decodes++;
+
+    /* Pulse edge within the second: coverage rises from nothing to full;
+     * the partly covered bin before full coverage places it within a bin */
+    float profile[BINS_PER_SECOND] = { 0 };
+    for (int r = 0; r < n; r++) {
+        for (int b = 0; b < BCD_INTEG_BINS; b++) profile[b % BINS_PER_SECOND] += rows[r][b];
+    }
+    int rise_bin = 0;
+    float best_rise = -INFINITY;
+    for (int j = 0; j < BINS_PER_SECOND; j++) {
+        float rise = profile[(j + 1) % BINS_PER_SECOND] -
+                     profile[(j + BINS_PER_SECOND - 1) % BINS_PER_SECOND];
+        if (rise > best_rise) {
+            best_rise = rise;
+            rise_bin = j;
+        }
+    }
+    float floor_cov = profile[(rise_bin + BINS_PER_SECOND - 1) % BINS_PER_SECOND];
+    float covered = (best_rise > 0.0f) ? (profile[rise_bin] - floor_cov) / best_rise : 0.0f;
+    if (covered < 0.0f) covered = 0.0f;
+    if (covered > 1.0f) covered = 1.0f;
+    double edge = rise_bin + 1.0 - covered;
+    integ_taps_t taps = taps_for_edge(edge);
+
+    /* Bit evidence (two-bin mean minus half a bin) carries 3/4 of a bin's
+     * noise variance; summed over rows */
+    float background[BCD_INTEG_MAX_MINUTES];
+    float noise_var = 0.0f;
+    for (int r = 0; r < n; r++) {
+        float var;
+        row_background(rows[r], &taps, &background[r], &var);
+        noise_var += 0.75f * fmaxf(var, BCD_INTEG_NOISE_FLOOR);
+    }
+    float sigma = sqrtf(noise_var);
+
+    /* Marker evidence per frame slot, summed over rows */
+    float slot_marker[60];
+    for (int i = 0; i < 60; i++) {
+        slot_marker[i] = 0.0f;
+        for (int r = 0; r < n; r++) {
+            slot_marker[i] += second_evidence(rows[r], i, &taps, background[r]).marker;
+        }
+    }
+
+    /* Second numbering: true second of slot i is (i + shift) % 60 */
+    int shift = 0;
+    float best_align = -INFINITY;
+    for (int s = 0; s < 60; s++) {
+        float score = 0.0f;
+        for (int i = 0; i < 60; i++) {
+            int sec = (i + s) % 60;
+            bool p = (sec == 0) || bcd_symbol_is_valid_p_position(sec);
+            score += p ? slot_marker[i] : -slot_marker[i];
+        }
+        if (score > best_align) {
+            best_align = score;
+            shift = s;
+        }
+    }
+    /* Most markers must be there; a dropped pulse only leaves nothing */
+    int markers_seen = 0;
+    for (int sec = 0; sec < 60; sec += (sec == 0) ? 9 : 10) {
+        if (slot_marker[(sec - shift + 60) % 60] > 0.0f) markers_seen++;
+    }
+    if (markers_seen < BCD_INTEG_MIN_MARKERS) {
+        integ->misaligned++;
+        return;
+    }
+
+    /* Per-row evidence by true second */
+    integ_second_t ev[BCD_INTEG_MAX_MINUTES][60];
+    for (int r = 0; r < n; r++) {
+        for (int sec = 0; sec < 60; sec++) {
+            ev[r][sec] = second_evidence(rows[r], (sec - shift + 60) % 60, &taps, background[r]);
+        }
+    }
+
+    /* Each quantity is solved jointly over the rows, a row k minutes back
+     * taking the candidate minus what those k minutes carried into it */
+    int delta[BCD_INTEG_MAX_MINUTES] = { 0 };
+    float margin = INFINITY;
+
+    for (int r = 0; r < n; r++) delta[r] = age[r];
+    int minute = solve_quantity(ev, n, delta, &QTY_MINUTE, 0, 59, true, sigma, &margin);
+
+    for (int r = 0; r < n; r++) delta[r] = (age[r] > minute) ? 1 : 0;
+    int hour = solve_quantity(ev, n, delta, &QTY_HOUR, 0, 23, true, sigma, &margin);
+
+    for (int r = 0; r < n; r++) delta[r] = (delta[r] && hour == 0) ? 1 : 0;
+    int day = solve_quantity(ev, n, delta, &QTY_DAY, 1, 366, false, sigma, &margin);
+
+    for (int r = 0; r < n; r++) delta[r] = (delta[r] && day == 1) ? 1 : 0;
+    int year = solve_quantity(ev, n, delta, &QTY_YEAR, 0, 99, true, sigma, &margin);
+
+    if (margin < BCD_INTEG_MIN_MARGIN) return;
+
+    bcd_integrated_frame_t *out = &integ->result;
+    out->year = year;
+    out->day = day;
+    out->hour = hour;
+    out->minute = minute;
+    /* From the minute field's own :10 back, whichever side of the anchor :00 fell on */
+    out->minute_start_ms = frame_start_ms - 10000.0 +
+        (((70 - shift) % 60) * BINS_PER_SECOND + edge) * BCD_INTEG_BIN_MS;
+    out->minutes_used = n;
+    out->margin = margin;
+    for (int sec = 0; sec < 60; sec++) {
+        float one = 0.0f, marker = 0.0f;
+        for (int r = 0; r < n; r++) {
+            one += ev[r][sec].one;
+            marker += ev[r][sec].marker;
+        }
+        out->symbols[sec] = (marker > 0.0f) ? 'P' : (one > 0.0f ? '1' : '0');
+    }
+    /* Coded seconds as solved (minute bits differ row to row) */
+    set_symbols(out->symbols, &QTY_MINUTE, minute);
+    set_symbols(out->symbols, &QTY_HOUR, hour);
+    set_symbols(out->symbols, &QTY_DAY, day);
+    set_symbols(out->symbols, &QTY_YEAR, year);
+    out->symbols[60] = '\0';
+    integ->have_result = true;
+    integ->accepted++;
+
+    printf("[BCD] Integrated %d min: day %03d %02d:%02d UTC year %02d (margin=%.2f)\n",
+           n, out->day, out->hour, out->minute, out->year, out->margin);
+}
+
+/*============================================================================
+ * Accumulation
+ *============================================================================*/
+
+void bcd_integrator_add_pulse(bcd_correlator_t *corr, double anchor_ms,
+                              double timestamp_ms, float duration_ms) {
+    bcd_integrator_t *integ = corr->integ;
+    if (!integ || anchor_ms < 0 || duration_ms <= 0.0f) return;
+
+    if (!integ->have_ref) {
+        integ->ref_anchor_ms = anchor_ms;
+        integ->have_ref = true;
+    }
+
+    /* Absolute minute from the first anchor; a missed marker leaves the
+     * anchor behind but the offset keeps counting minutes */
+    int64_t anchor_minute = (int64_t)lround((anchor_ms - integ->ref_anchor_ms) / MINUTE_MS);
+    double offset_ms = timestamp_ms - anchor_ms;
+    double wraps = floor(offset_ms / MINUTE_MS);
+    int64_t minute = anchor_minute + (int64_t)wraps;
+    if (minute < 0) return;
+    double pos_ms = offset_ms - wraps * MINUTE_MS;
+
+    if (minute > integ->current_minute) {
+        /* A later minute started: the previous one is complete */
+        if (row_valid(integ, integ->current_minute)) {
+            double frame_start_ms = anchor_ms + (double)(integ->current_minute - anchor_minute) * MINUTE_MS;
+            decode_minute(corr, integ->current_minute, frame_start_ms);
+        }
+        integ->current_minute = minute;
+        start_row(integ, minute);
+    } else if (!row_valid(integ, minute)) {
+        return;     /* Older than the ring */
+    }
+
+    /* Coverage of [pos, pos + duration); the frame is circular, so a pulse
+     * running past :59 lands in :00 of the same row, which carries the
+     * same marker every minute */
+    float *bins = row_bins(integ, minute);
+    double start = pos_ms;
+    double end = pos_ms + duration_ms;
+    for (int b = (int)(start / BCD_INTEG_BIN_MS); b * (double)BCD_INTEG_BIN_MS < end; b++) {
+        double lo = fmax(start, b * (double)BCD_INTEG_BIN_MS);
+        double hi = fmin(end, (b + 1) * (double)BCD_INTEG_BIN_MS);
+        if (hi > lo) bins[b % BCD_INTEG_BINS] += (float)((hi - lo) / BCD_INTEG_BIN_MS);
+    }
+}
+
+/*============================================================================
+ * Lifecycle
+ *============================================================================*/
+
+bool bcd_integrator_configure(bcd_correlator_t *corr, int minutes) {
+    bcd_integrator_destroy(corr);
+    if (minutes <= 0) return true;
+    if (minutes > BCD_INTEG_MAX_MINUTES) minutes = BCD_INTEG_MAX_MINUTES;
+
+    bcd_integrator_t *integ = (bcd_integrator_t *)wwv_calloc(1, sizeof(bcd_integrator_t));
+    if (!integ) return false;
+    integ->bins = (float *)wwv_calloc((size_t)minutes * BCD_INTEG_BINS, sizeof(float));
+    if (!integ->bins) {
+        wwv_free(integ);
+        return false;
+    }
+    integ->minutes = minutes;
+    integ->current_minute = -1;
+    for (int r = 0; r < BCD_INTEG_MAX_MINUTES; r++) integ->row_minute[r] = -1;
+
+    corr->integ = integ;
+    return true;
+}
+
+void bcd_integrator_destroy(bcd_correlator_t *corr) {
+    if (!corr->integ) return;
+    wwv_free(corr->integ->bins);
+    wwv_free(corr->integ);
+    corr->integ = NULL;
+}
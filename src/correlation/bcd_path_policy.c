@@ -0,0 +1,286 @@
+/**
+ * @file bcd_path_policy.c
+ * @brief Adaptive BCD detector path selection
+ *
+ * A freq pulse is judged once it is BCD_PATH_JUDGE_MS old, so a time
+ * pulse reported after it can still match. Rates, agreement and the idle
+ * hold only advance in update(); pulses just land in the rings.
+ */
+
+#include "bcd_path_policy.h"
+#include "telemetry_wire.h"
+#include "wwv_arena.h"
+#include "wwv_thread.h"
+#include <stdio.h>
+#include <time.h>
+
+/*============================================================================
+ * Internal Configuration
+ *============================================================================*/
+
+#define BCD_PATH_RING           16          /* Pulses kept per path (~16 s) */
+#define BCD_PATH_JUDGE_MS       500.0       /* Freq pulse age before matching */
+#define BCD_PATH_SMOOTH         0.2f        /* EMA per evaluation (~5 s) */
+
+struct bcd_path_policy {
+    bcd_path_policy_config_t config;
+
+    /* Recent pulse starts, newest at [head - 1] */
+    double time_ring[BCD_PATH_RING];
+    int time_head;
+    int time_fill;
+    double freq_ring[BCD_PATH_RING];
+    int freq_head;
+    int freq_fill;
+    int freq_judged;                /* Oldest unjudged: freq_fill - freq_judged back */
+
+    /* Evaluation */
+    double last_eval_ms;
+    bool evaluated;
+    uint32_t interval_time;         /* Time pulses since the last evaluation */
+    uint32_t interval_judged;       /* Freq pulses judged / matched this evaluation */
+    uint32_t interval_matched;
+    double strong_since_ms;         /* Idle conditions first held, < 0 = not holding */
+    bool have_agreement;
+
+    bcd_path_status_t status;
+
+    telem_ctx_t *telem;
+    time_t start_time;
+};
+
+/*============================================================================
+ * Internal Functions
+ *============================================================================*/
+
+static void ring_push(double *ring, int *head, int *fill, double timestamp_ms) {
+    ring[*head] = timestamp_ms;
+    *head = (*head + 1) % BCD_PATH_RING;
+    if (*fill < BCD_PATH_RING) (*fill)++;
+}
+
+/* k = 0 is the newest */
+static double ring_get(const double *ring, int head, int k) {
+    return ring[(head - 1 - k + BCD_PATH_RING) % BCD_PATH_RING];
+}
+
+static bool time_pulse_near(const bcd_path_policy_t *p, double timestamp_ms) {
+    for (int k = 0; k < p->time_fill; k++) {
+        double d = ring_get(p->time_ring, p->time_head, k) - timestamp_ms;
+        if (d < 0.0) d = -d;
+        if (d <= BCD_PATH_MATCH_MS) return true;
+    }
+    return false;
+}
+
+/* Match every freq pulse old enough that a late time pulse has arrived */
+static void judge_freq_pulses(bcd_path_policy_t *p, double now_ms) {
+    while (p->freq_judged < p->freq_fill) {
+        int k = p->freq_fill - 1 - p->freq_judged;
+        double ts = ring_get(p->freq_ring, p->freq_head, k);
+        if (now_ms - ts < BCD_PATH_JUDGE_MS) break;
+        p->interval_judged++;
+        if (time_pulse_near(p, ts)) p->interval_matched++;
+        p->freq_judged++;
+    }
+}
+
+static void report(bcd_path_policy_t *p, double now_ms) {
+    const bcd_path_status_t *s = &p->status;
+    time_t wall = p->start_time + (time_t)(now_ms / 1000.0);
+
+    printf("[BCD_PATH] %s at %.1fms (%s): SNR=%.1fdB time=%.2f/s agree=%.2f\n",
+           bcd_path_mode_name(s->mode), now_ms, bcd_path_reason_name(s->reason),
+           s->snr_db, s->time_rate, s->agreement);
+
+    if (telem_ctx_binary_active(p->telem, TELEM_BCDS)) {
+        telem_rec_bcd_path_t rec = {
+            .mode = (uint8_t)s->mode,
+            .reason = (uint8_t)s->reason,
+            .switches = s->switches,
+            .snr_db = s->snr_db,
+            .time_rate = s->time_rate,
+            .agreement = s->agreement
+        };
+        telem_ctx_send_record(p->telem, TELEM_BCDS, TELEM_REC_BCD_PATH, (uint32_t)wall,
+                              telem_ms_to_us(now_ms), &rec, sizeof(rec));
+    } else {
+        char time_str[16];
+        strftime(time_str, sizeof(time_str), "%H:%M:%S", wwv_localtime(&wall));
+        telem_ctx_sendf(p->telem, TELEM_BCDS, "PATH,%s,%.1f,%s,%s,%.1f,%.2f,%.2f,%u",
+                        time_str, now_ms, bcd_path_mode_name(s->mode),
+                        bcd_path_reason_name(s->reason), s->snr_db,
+                        s->time_rate, s->agreement, (unsigned)s->switches);
+    }
+}
+
+static void switch_mode(bcd_path_policy_t *p, bcd_path_mode_t mode,
+                        bcd_path_reason_t reason, double now_ms) {
+    p->status.mode = mode;
+    p->status.reason = reason;
+    p->status.mode_since_ms = now_ms;
+    p->status.switches++;
+    p->strong_since_ms = -1.0;
+    report(p, now_ms);
+}
+
+/*============================================================================
+ * API
+ *============================================================================*/
+
+bcd_path_policy_t *bcd_path_policy_create(const bcd_path_policy_config_t *config) {
+    bcd_path_policy_t *p = (bcd_path_policy_t *)wwv_calloc(1, sizeof(bcd_path_policy_t));
+    if (!p) return NULL;
+
+    if (config) {
+        p->config = *config;
+    } else {
+        p->config = (bcd_path_policy_config_t)BCD_PATH_POLICY_CONFIG_DEFAULT;
+    }
+    p->status.mode = BCD_PATH_DUAL;
+    p->status.reason = BCD_PATH_REASON_START;
+    p->strong_since_ms = -1.0;
+    p->start_time = time(NULL);
+
+    printf("[BCD_PATH] Adaptive: idle freq path at SNR>=%.0fdB, restore below %.0fdB "
+           "(hold %.0fs, dwell %.0fs)\n",
+           p->config.snr_high_db, p->config.snr_low_db,
+           p->config.hold_ms / 1000.0, p->config.min_dwell_ms / 1000.0);
+    return p;
+}
+
+void bcd_path_policy_destroy(bcd_path_policy_t *policy) {
+    wwv_free(policy);
+}
+
+void bcd_path_policy_set_telemetry(bcd_path_policy_t *policy, telem_ctx_t *ctx) {
+    if (policy) policy->telem = ctx;
+}
+
+void bcd_path_policy_time_pulse(bcd_path_policy_t *policy, double timestamp_ms) {
+    if (!policy) return;
+    ring_push(policy->time_ring, &policy->time_head, &policy->time_fill, timestamp_ms);
+    policy->interval_time++;
+    policy->status.time_pulses++;
+}
+
+void bcd_path_policy_freq_pulse(bcd_path_policy_t *policy, double timestamp_ms) {
+    if (!policy) return;
+    bool full = policy->freq_fill == BCD_PATH_RING;
+    ring_push(policy->freq_ring, &policy->freq_head, &policy->freq_fill, timestamp_ms);
+    /* The overwritten pulse was the oldest; judged or not, it is gone */
+    if (full && policy->freq_judged > 0) policy->freq_judged--;
+    policy->status.freq_pulses++;
+}
+
+bcd_path_mode_t bcd_path_policy_update(bcd_path_policy_t *policy, double now_ms,
+                                       float snr_db, bool snr_valid) {
+    if (!policy) return BCD_PATH_DUAL;
+    bcd_path_policy_t *p = policy;
+    bcd_path_status_t *s = &p->status;
+    const bcd_path_policy_config_t *c = &p->config;
+
+    /* First call only starts the interval */
+    if (!p->evaluated) {
+        p->evaluated = true;
+        p->last_eval_ms = now_ms;
+        p->interval_time = 0;
+        return s->mode;
+    }
+
+    double interval_s = (now_ms - p->last_eval_ms) / 1000.0;
+    if (interval_s <= 0.0) return s->mode;
+    p->last_eval_ms = now_ms;
+
+    float rate = (float)(p->interval_time / interval_s);
+    s->time_rate += BCD_PATH_SMOOTH * (rate - s->time_rate);
+    p->interval_time = 0;
+
+    /* Agreement only moves while the freq path produces pulses */
+    judge_freq_pulses(p, now_ms);
+    if (p->interval_judged > 0) {
+        float frac = (float)p->interval_matched / (float)p->interval_judged;
+        if (p->have_agreement) {
+            s->agreement += BCD_PATH_SMOOTH * (frac - s->agreement);
+        } else {
+            s->agreement = frac;
+            p->have_agreement = true;
+        }
+        p->interval_judged = 0;
+        p->interval_matched = 0;
+    }
+
+    s->snr_db = snr_valid ? snr_db : 0.0f;
+    s->snr_valid = snr_valid;
+
+    if (s->mode == BCD_PATH_TIME_ONLY) {
+        if (!snr_valid) {
+            switch_mode(p, BCD_PATH_DUAL, BCD_PATH_REASON_NO_SNR, now_ms);
+        } else if (snr_db < c->snr_low_db) {
+            switch_mode(p, BCD_PATH_DUAL, BCD_PATH_REASON_SNR_LOW, now_ms);
+        } else if (s->time_rate < c->restore_time_rate) {
+            switch_mode(p, BCD_PATH_DUAL, BCD_PATH_REASON_TIME_RATE, now_ms);
+        }
+        return s->mode;
+    }
+
+    bool strong = snr_valid && snr_db >= c->snr_high_db &&
+                  s->time_rate >= c->min_time_rate &&
+                  p->have_agreement && s->agreement >= c->min_agreement;
+    if (!strong) {
+        p->strong_since_ms = -1.0;
+        return s->mode;
+    }
+    if (p->strong_since_ms < 0.0) p->strong_since_ms = now_ms;
+
+    if (now_ms - p->strong_since_ms >= c->hold_ms &&
+        now_ms - s->mode_since_ms >= c->min_dwell_ms) {
+        switch_mode(p, BCD_PATH_TIME_ONLY, BCD_PATH_REASON_STRONG, now_ms);
+        /* Agreement is re-learned after the next restore */
+        p->have_agreement = false;
+        p->freq_judged = p->freq_fill;
+    }
+    return s->mode;
+}
+
+bcd_path_mode_t bcd_path_policy_get_mode(const bcd_path_policy_t *policy) {
+    return policy ? policy->status.mode : BCD_PATH_DUAL;
+}
+
+bool bcd_path_policy_get_status(const bcd_path_policy_t *policy, bcd_path_status_t *out) {
+    if (!policy || !out) return false;
+    *out = policy->status;
+    return true;
+}
+
+const char *bcd_path_mode_name(bcd_path_mode_t mode) {
+    switch (mode) {
+        case BCD_PATH_DUAL:      return "DUAL";
+        case BCD_PATH_TIME_ONLY: return "TIME_ONLY";
+        default:                 return "UNKNOWN";
+    }
+}
+
+const char *bcd_path_reason_name(bcd_path_reason_t reason) {
+    switch (reason) {
+        case BCD_PATH_REASON_START:     return "START";
+        case BCD_PATH_REASON_STRONG:    return "STRONG";
+        case BCD_PATH_REASON_SNR_LOW:   return "SNR_LOW";
+        case BCD_PATH_REASON_NO_SNR:    return "NO_SNR";
+        case BCD_PATH_REASON_TIME_RATE: return "TIME_RATE";
+        default:                        return "UNKNOWN";
+    }
+}
+
+void bcd_path_policy_print_stats(const bcd_path_policy_t *policy) {
+    if (!policy) return;
+    const bcd_path_status_t *s = &policy->status;
+
+    printf("\n=== BCD PATH POLICY STATS ===\n");
+    printf("Mode: %s (%s) since %.1fs  Switches: %u\n",
+           bcd_path_mode_name(s->mode), bcd_path_reason_name(s->reason),
+           s->mode_since_ms / 1000.0, (unsigned)s->switches);
+    printf("Pulses: time=%u freq=%u  Time rate: %.2f/s  Agreement: %.2f\n",
+           (unsigned)s->time_pulses, (unsigned)s->freq_pulses, s->time_rate, s->agreement);
+    printf("=============================\n");
+}
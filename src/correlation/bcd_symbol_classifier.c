@@ -9,6 +9,7 @@
  *   - Pulse duration estimation
  *   - P-marker position validation
  *   - Symbol classification (0/1/P)
+ *   - Soft symbol likelihoods (bcd_time_solver input)
  */
 
 #include "bcd_correlator_internal.h"
@@ -49,6 +50,21 @@ bcd_corr_symbol_t bcd_symbol_classify_duration(float duration_ms, int second) {
     return bcd_symbol_is_valid_p_position(second) ? BCD_CORR_SYM_MARKER : BCD_CORR_SYM_ONE;
 }
 
+void bcd_symbol_soft_likelihoods(float duration_ms, float weight, float ll[3]) {
+    static const float nominal_ms[3] = { 200.0f, 500.0f, 800.0f };
+
+    float best = SOFT_SYMBOL_LL_FLOOR;
+    for (int k = 0; k < 3; k++) {
+        float z = (duration_ms - nominal_ms[k]) / SOFT_SYMBOL_SIGMA_MS;
+        ll[k] = -0.5f * z * z * weight;
+        if (ll[k] > best) best = ll[k];
+    }
+    for (int k = 0; k < 3; k++) {
+        ll[k] -= best;
+        if (ll[k] < SOFT_SYMBOL_LL_FLOOR) ll[k] = SOFT_SYMBOL_LL_FLOOR;
+    }
+}
+
 float bcd_window_estimate_pulse_duration(bcd_correlator_t *corr) {
     float time_span = 0.0f;
     float freq_span = 0.0f;
@@ -0,0 +1,310 @@
+/**
+ * @file bcd_time_solver.c
+ * @brief Soft-decision WWV time code decoder
+ *
+ * Every field is scored as the sum of its set bits' log-likelihood ratios
+ * (ONE vs ZERO); an all-zero digit scores 0, so scores compare directly
+ * between values of one field. Time of day is searched over all 1440
+ * minutes jointly across the held frames, then day (with the rollovers
+ * the chosen time implies) and year.
+ */
+
+#include "bcd_time_solver.h"
+#include "wwv_arena.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MINUTES_PER_DAY         1440
+#define SECOND_LEAP_WARNING     3
+#define FRAME_MATCH_MS          30000.0     /* Same frame if the starts are closer */
+
+typedef struct {
+    double start_ms;                /* Stream time of second 0 */
+    bool open;                      /* Still receiving symbols */
+    bool present[60];
+    float ll[60][3];                /* bcd_symbol_event_t log_likelihood per second */
+} solver_frame_t;
+
+struct bcd_time_solver {
+    solver_frame_t frames[BCD_SOLVER_MAX_FRAMES];   /* Oldest first */
+    int frame_count;
+
+    bcd_time_solution_t solution;
+    bool have_solution;
+
+    bcd_time_solution_callback_fn callback;
+    void *callback_user_data;
+
+    /* Statistics */
+    uint32_t symbols;
+    uint32_t frames_solved;
+    uint32_t solutions;
+    uint32_t misaligned;
+};
+
+/*============================================================================
+ * Frame Layout
+ *============================================================================*/
+
+typedef struct {
+    int count;
+    int secs[4];
+    int weights[4];
+} bcd_field_t;
+
+static const bcd_field_t FIELD_MIN_UNITS  = { 4, { 10, 11, 12, 13 }, { 1, 2, 4, 8 } };
+static const bcd_field_t FIELD_MIN_TENS   = { 3, { 15, 16, 17 },     { 10, 20, 40 } };
+static const bcd_field_t FIELD_HOUR_UNITS = { 4, { 20, 21, 22, 23 }, { 1, 2, 4, 8 } };
+static const bcd_field_t FIELD_HOUR_TENS  = { 2, { 25, 26 },         { 10, 20 } };
+static const bcd_field_t FIELD_DAY_UNITS  = { 4, { 30, 31, 32, 33 }, { 1, 2, 4, 8 } };
+static const bcd_field_t FIELD_DAY_TENS   = { 4, { 35, 36, 37, 38 }, { 10, 20, 40, 80 } };
+static const bcd_field_t FIELD_DAY_HUNDS  = { 2, { 40, 41 },         { 100, 200 } };
+static const bcd_field_t FIELD_YEAR_UNITS = { 4, { 4, 5, 6, 7 },     { 1, 2, 4, 8 } };
+static const bcd_field_t FIELD_YEAR_TENS  = { 4, { 51, 52, 53, 54 }, { 10, 20, 40, 80 } };
+
+static float bit_llr(const solver_frame_t *f, int second) {
+    if (!f->present[second]) return 0.0f;
+    return f->ll[second][BCD_CORR_SYM_ONE] - f->ll[second][BCD_CORR_SYM_ZERO];
+}
+
+/* Score of one BCD digit value (already scaled: tens as 10..90 etc.) */
+static float field_score(const solver_frame_t *f, const bcd_field_t *field, int value) {
+    float score = 0.0f;
+    for (int k = field->count - 1; k >= 0; k--) {
+        if (value >= field->weights[k]) {
+            score += bit_llr(f, field->secs[k]);
+            value -= field->weights[k];
+        }
+    }
+    return score;
+}
+
+static float time_score(const solver_frame_t *f, int minute_of_day) {
+    int minute = minute_of_day % 60;
+    int hour = minute_of_day / 60;
+    return field_score(f, &FIELD_MIN_UNITS, minute % 10) +
+           field_score(f, &FIELD_MIN_TENS, minute - minute % 10) +
+           field_score(f, &FIELD_HOUR_UNITS, hour % 10) +
+           field_score(f, &FIELD_HOUR_TENS, hour - hour % 10);
+}
+
+static float day_score(const solver_frame_t *f, int day) {
+    return field_score(f, &FIELD_DAY_UNITS, day % 10) +
+           field_score(f, &FIELD_DAY_TENS, (day % 100) - day % 10) +
+           field_score(f, &FIELD_DAY_HUNDS, day - day % 100);
+}
+
+static float year_score(const solver_frame_t *f, int year) {
+    return field_score(f, &FIELD_YEAR_UNITS, year % 10) +
+           field_score(f, &FIELD_YEAR_TENS, year - year % 10);
+}
+
+/**
+ * Position markers at :09 .. :59 should look like markers; a frame with the
+ * wrong second numbering does not
+ */
+static bool frame_aligned(const solver_frame_t *f) {
+    float score = 0.0f;
+    for (int s = 9; s < 60; s += 10) {
+        if (!f->present[s]) continue;
+        const float *ll = f->ll[s];
+        float data = fmaxf(ll[BCD_CORR_SYM_ZERO], ll[BCD_CORR_SYM_ONE]);
+        score += ll[BCD_CORR_SYM_MARKER] - data;
+    }
+    return score >= 0.0f;
+}
+
+/*============================================================================
+ * Solve
+ *============================================================================*/
+
+static int floor_div(int a, int b) {
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+/* Keep the best and runner-up score of a search */
+static void rank(float score, int value, float *best, float *second, int *best_value) {
+    if (score > *best) {
+        *second = *best;
+        *best = score;
+        *best_value = value;
+    } else if (score > *second) {
+        *second = score;
+    }
+}
+
+static void solve(bcd_time_solver_t *solver) {
+    const solver_frame_t *latest = &solver->frames[solver->frame_count - 1];
+    const solver_frame_t *used[BCD_SOLVER_MAX_FRAMES];
+    int offset[BCD_SOLVER_MAX_FRAMES];     /* Minutes before the latest frame */
+    int n = 0;
+
+    for (int k = 0; k < solver->frame_count; k++) {
+        const solver_frame_t *f = &solver->frames[k];
+        if (!frame_aligned(f)) {
+            if (f == latest) solver->misaligned++;
+            continue;
+        }
+        used[n] = f;
+        offset[n] = (int)lround((latest->start_ms - f->start_ms) / 60000.0);
+        n++;
+    }
+    solver->frames_solved++;
+    if (n == 0 || !frame_aligned(latest)) return;
+
+    float best = -INFINITY, second = -INFINITY;
+    int tod = 0;
+    for (int t = 0; t < MINUTES_PER_DAY; t++) {
+        float score = 0.0f;
+        for (int j = 0; j < n; j++) {
+            int tj = ((t - offset[j]) % MINUTES_PER_DAY + MINUTES_PER_DAY) % MINUTES_PER_DAY;
+            score += time_score(used[j], tj);
+        }
+        rank(score, t, &best, &second, &tod);
+    }
+    float margin = best - second;
+
+    /* Frames before a midnight the time of day implies carry the previous
+     * day; before New Year, day 365 or 366 (whichever fits) of the
+     * previous year */
+    best = second = -INFINITY;
+    int day = 1;
+    for (int d = 1; d <= 366; d++) {
+        float score = 0.0f;
+        for (int j = 0; j < n; j++) {
+            int dj = d + floor_div(tod - offset[j], MINUTES_PER_DAY);
+            score += (dj >= 1) ? day_score(used[j], dj) :
+                     fmaxf(day_score(used[j], dj + 365), day_score(used[j], dj + 366));
+        }
+        rank(score, d, &best, &second, &day);
+    }
+    margin = fminf(margin, best - second);
+
+    best = second = -INFINITY;
+    int year = 0;
+    for (int y = 0; y < 100; y++) {
+        float score = 0.0f;
+        for (int j = 0; j < n; j++) {
+            bool last_year = day + floor_div(tod - offset[j], MINUTES_PER_DAY) < 1;
+            score += year_score(used[j], last_year ? (y + 99) % 100 : y);
+        }
+        rank(score, y, &best, &second, &year);
+    }
+    margin = fminf(margin, best - second);
+
+    if (margin < BCD_SOLVER_MIN_MARGIN) return;
+
+    /* The warning holds for the month, so every held frame votes */
+    float leap_llr = 0.0f;
+    for (int j = 0; j < n; j++) leap_llr += bit_llr(used[j], SECOND_LEAP_WARNING);
+
+    bcd_time_solution_t sol = {
+        .year = year,
+        .day = day,
+        .hour = tod / 60,
+        .minute = tod % 60,
+        .minute_start_ms = latest->start_ms,
+        .frames_used = n,
+        .margin = margin,
+        .leap_warning = leap_llr > 0.0f
+    };
+    solver->solution = sol;
+    solver->have_solution = true;
+    solver->solutions++;
+
+    printf("[BCD] Time solve: day %03d %02d:%02d UTC year %02d (frames=%d margin=%.1f)%s\n",
+           sol.day, sol.hour, sol.minute, sol.year, sol.frames_used, sol.margin,
+           sol.leap_warning ? " leap second warning" : "");
+
+    if (solver->callback) {
+        solver->callback(&sol, solver->callback_user_data);
+    }
+}
+
+static void finish_frame(bcd_time_solver_t *solver) {
+    if (solver->frame_count == 0) return;
+    solver_frame_t *f = &solver->frames[solver->frame_count - 1];
+    if (!f->open) return;
+    f->open = false;
+    solve(solver);
+}
+
+static solver_frame_t *start_frame(bcd_time_solver_t *solver, double start_ms) {
+    if (solver->frame_count == BCD_SOLVER_MAX_FRAMES) {
+        memmove(solver->frames, solver->frames + 1,
+                (BCD_SOLVER_MAX_FRAMES - 1) * sizeof(solver_frame_t));
+        solver->frame_count--;
+    }
+    solver_frame_t *f = &solver->frames[solver->frame_count++];
+    memset(f, 0, sizeof(*f));
+    f->start_ms = start_ms;
+    f->open = true;
+    return f;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+bcd_time_solver_t *bcd_time_solver_create(void) {
+    return (bcd_time_solver_t *)wwv_calloc(1, sizeof(bcd_time_solver_t));
+}
+
+void bcd_time_solver_destroy(bcd_time_solver_t *solver) {
+    wwv_free(solver);
+}
+
+void bcd_time_solver_set_callback(bcd_time_solver_t *solver,
+                                  bcd_time_solution_callback_fn callback, void *user_data) {
+    if (!solver) return;
+    solver->callback = callback;
+    solver->callback_user_data = user_data;
+}
+
+void bcd_time_solver_add_symbol(bcd_time_solver_t *solver, const bcd_symbol_event_t *event) {
+    if (!solver || !event || event->second < 0 || event->second > 59) return;
+
+    /* Window centres sit at second * 1000 + 500 ms into the frame */
+    double start_ms = event->timestamp_ms - (event->second * 1000.0 + 500.0);
+
+    solver_frame_t *f = solver->frame_count ? &solver->frames[solver->frame_count - 1] : NULL;
+    if (f && fabs(start_ms - f->start_ms) < FRAME_MATCH_MS) {
+        if (!f->open) return;           /* Frame already solved */
+    } else {
+        finish_frame(solver);
+        f = start_frame(solver, start_ms);
+    }
+
+    f->present[event->second] = true;
+    memcpy(f->ll[event->second], event->log_likelihood, sizeof(f->ll[0]));
+    solver->symbols++;
+
+    if (event->second == 59) finish_frame(solver);
+}
+
+bool bcd_time_solver_get_solution(const bcd_time_solver_t *solver, bcd_time_solution_t *out) {
+    if (!solver || !solver->have_solution) return false;
+    if (out) *out = solver->solution;
+    return true;
+}
+
+void bcd_time_solver_reset(bcd_time_solver_t *solver) {
+    if (!solver) return;
+    solver->frame_count = 0;
+}
+
+void bcd_time_solver_print_stats(const bcd_time_solver_t *solver) {
+    if (!solver) return;
+
+    printf("\n=== BCD TIME SOLVER STATS ===\n");
+    printf("Symbols: %u  Frames solved: %u  Misaligned: %u  Solutions: %u\n",
+           (unsigned)solver->symbols, (unsigned)solver->frames_solved,
+           (unsigned)solver->misaligned, (unsigned)solver->solutions);
+    if (solver->have_solution) {
+        const bcd_time_solution_t *s = &solver->solution;
+        printf("Last: day %03d %02d:%02d UTC year %02d (frames=%d margin=%.1f)\n",
+               s->day, s->hour, s->minute, s->year, s->frames_used, s->margin);
+    }
+    printf("=============================\n");
+}
@@ -14,6 +14,7 @@
 
 #include "bcd_correlator_internal.h"
 #include "telemetry.h"
+#include "telemetry_wire.h"
 #include "version.h"
 #include <string.h>
 #include <stdio.h>
@@ -22,13 +23,13 @@
  * Window Timing Functions
  *============================================================================*/
 
-float bcd_window_get_minute_anchor(bcd_correlator_t *corr) {
+double bcd_window_get_minute_anchor(bcd_correlator_t *corr) {
     if (!corr->sync_source) return -1.0f;
     if (sync_detector_get_state(corr->sync_source) != SYNC_LOCKED) return -1.0f;
     return sync_detector_get_last_marker_ms(corr->sync_source);
 }
 
-int bcd_window_get_second_for_timestamp(bcd_correlator_t *corr, float timestamp_ms, float anchor_ms) {
+int bcd_window_get_second_for_timestamp(bcd_correlator_t *corr, double timestamp_ms, double anchor_ms) {
     if (anchor_ms < 0) return -1;
 
     float offset_ms = timestamp_ms - anchor_ms;
@@ -44,7 +45,7 @@ int bcd_window_get_second_for_timestamp(bcd_correlator_t *corr, float timestamp_
     return second;
 }
 
-float bcd_window_get_start(float anchor_ms, int second) {
+double bcd_window_get_start(double anchor_ms, int second) {
     return anchor_ms + (second * WINDOW_DURATION_MS);
 }
 
@@ -52,12 +53,17 @@ float bcd_window_get_start(float anchor_ms, int second) {
  * Window Management Functions
  *============================================================================*/
 
-void bcd_window_open(bcd_correlator_t *corr, int second, float anchor_ms) {
+void bcd_window_open(bcd_correlator_t *corr, int second, double anchor_ms) {
     corr->window_open = true;
     corr->current_second = second;
     corr->window_start_ms = bcd_window_get_start(anchor_ms, second);
     corr->window_anchor_ms = anchor_ms;
 
+    if (corr->timers) {
+        wwv_timer_arm_after_ms(corr->timers, &corr->close_timer,
+                               corr->window_start_ms + WINDOW_DURATION_MS + WINDOW_CLOSE_GRACE_MS);
+    }
+
     /* Reset accumulators */
     corr->time_energy_sum = 0.0f;
     corr->time_duration_sum = 0.0f;
@@ -75,6 +81,8 @@ void bcd_window_open(bcd_correlator_t *corr, int second, float anchor_ms) {
 void bcd_window_close(bcd_correlator_t *corr) {
     if (!corr->window_open) return;
 
+    if (corr->timers) wwv_timer_cancel(corr->timers, &corr->close_timer);
+
     int total_events = corr->time_event_count + corr->freq_event_count;
     float total_energy = corr->time_energy_sum + corr->freq_energy_sum;
 
@@ -109,7 +117,7 @@ void bcd_window_close(bcd_correlator_t *corr) {
     /* If no events at all, symbol stays NONE (no 100Hz detected this second) */
 
     /* Calculate timestamp for this symbol (center of window) */
-    float symbol_timestamp_ms = corr->window_start_ms + (WINDOW_DURATION_MS / 2.0f);
+    double symbol_timestamp_ms = corr->window_start_ms + (WINDOW_DURATION_MS / 2.0f);
 
     /* Track intervals */
     float interval_ms = 0.0f;
@@ -131,33 +139,64 @@ void bcd_window_close(bcd_correlator_t *corr) {
     corr->last_symbol_ms = symbol_timestamp_ms;
     corr->symbol_count++;
 
-    /* CSV logging */
-    if (corr->csv_file) {
-        char time_str[16];
-        bcd_corr_get_wall_time_str(corr->start_time, symbol_timestamp_ms, time_str, sizeof(time_str));
-
-        fprintf(corr->csv_file, "%s,%.1f,%d,%c,%.0f,%.1f,%d,%d,%s,%.2f\n",
-                time_str, symbol_timestamp_ms, corr->symbol_count,
-                bcd_corr_symbol_char(symbol), duration_ms, interval_ms,
-                corr->time_event_count, corr->freq_event_count, source, confidence);
-        fflush(corr->csv_file);
+    /* Log to CSV and telemetry */
+    char time_str[16];
+    bcd_corr_get_wall_time_str(corr->start_time, symbol_timestamp_ms, time_str, sizeof(time_str));
+
+    wwv_csv_log_row_at(corr->csv_log, bcd_corr_get_wall_time(corr->start_time, symbol_timestamp_ms),
+                       "%.1f,%d,%d,%c,%s,%.0f,%.2f,%.1f,%d,%d,%.4f,%.4f,%s\n",
+                       symbol_timestamp_ms, corr->symbol_count, corr->current_second,
+                       bcd_corr_symbol_char(symbol), source,
+                       duration_ms, confidence, interval_ms / 1000.0f,
+                       corr->time_event_count, corr->freq_event_count,
+                       corr->time_energy_sum, corr->freq_energy_sum,
+                       bcd_corr_state_name(corr->state));
+
+    /* UDP telemetry for correlation stats (the binary record also covers SYM) */
+    if (telem_ctx_binary_active(corr->telem, TELEM_BCDS)) {
+        telem_rec_bcd_symbol_t rec = {
+            .number = (uint32_t)corr->symbol_count,
+            .symbol = (int8_t)symbol,
+            .second = (int8_t)corr->current_second,
+            .state = (uint8_t)corr->state,
+            .time_events = (uint16_t)corr->time_event_count,
+            .freq_events = (uint16_t)corr->freq_event_count,
+            .duration_ms = duration_ms,
+            .confidence = confidence,
+            .interval_sec = interval_ms / 1000.0f,
+            .time_energy = corr->time_energy_sum,
+            .freq_energy = corr->freq_energy_sum
+        };
+        telem_ctx_send_record(corr->telem, TELEM_BCDS, TELEM_REC_BCD_SYMBOL,
+                          (uint32_t)bcd_corr_get_wall_time(corr->start_time, symbol_timestamp_ms),
+                          telem_ms_to_us(symbol_timestamp_ms), &rec, sizeof(rec));
+    } else {
+        telem_ctx_sendf(corr->telem, TELEM_BCDS, "CORR,%s,%.1f,%d,%d,%c,%s,%.0f,%.2f,%.1f,%d,%d,%.4f,%.4f,%s",
+                    time_str, symbol_timestamp_ms, corr->symbol_count, corr->current_second,
+                    bcd_corr_symbol_char(symbol), source,
+                    duration_ms, confidence, interval_ms / 1000.0f,
+                    corr->time_event_count, corr->freq_event_count,
+                    corr->time_energy_sum, corr->freq_energy_sum,
+                    bcd_corr_state_name(corr->state));
+        if (symbol != BCD_CORR_SYM_NONE) {
+            telem_ctx_sendf(corr->telem, TELEM_BCDS, "SYM,%c,%d,%.0f,%.2f",
+                        bcd_corr_symbol_char(symbol), corr->current_second,
+                        duration_ms, confidence);
+        }
     }
 
-    /* UDP telemetry */
-    telem_sendf(TELEM_BCDS, "SYMBOL,%d,%.1f,%c,%.0f,%d,%d,%s,%.2f",
-                corr->symbol_count, symbol_timestamp_ms,
-                bcd_corr_symbol_char(symbol), duration_ms,
-                corr->time_event_count, corr->freq_event_count, source, confidence);
-
     /* Callback */
     if (corr->callback) {
         bcd_symbol_event_t event = {
             .symbol = symbol,
             .timestamp_ms = symbol_timestamp_ms,
+            .sample_index = wwv_ms_to_samples(symbol_timestamp_ms, BCD_TIME_SAMPLE_RATE),
             .duration_ms = duration_ms,
             .confidence = confidence,
-            .source = source
+            .source = source,
+            .second = corr->current_second
         };
+        bcd_symbol_soft_likelihoods(duration_ms, confidence, event.log_likelihood);
         corr->callback(&event, corr->callback_user_data);
     }
 
@@ -165,11 +204,21 @@ void bcd_window_close(bcd_correlator_t *corr) {
     corr->window_open = false;
 }
 
-void bcd_window_check_transition(bcd_correlator_t *corr, float timestamp_ms) {
+void bcd_window_on_close_timer(wwv_timer_t *timer, double now_ms, void *user_data) {
+    bcd_correlator_t *corr = (bcd_correlator_t *)user_data;
+    (void)timer;
+    (void)now_ms;
+
+    corr->closed_second = corr->current_second;
+    corr->closed_anchor_ms = corr->window_anchor_ms;
+    bcd_window_close(corr);
+}
+
+void bcd_window_check_transition(bcd_correlator_t *corr, double timestamp_ms) {
     if (!corr) return;
 
     /* Get current sync state */
-    float anchor_ms = bcd_window_get_minute_anchor(corr);
+    double anchor_ms = bcd_window_get_minute_anchor(corr);
 
     /* If sync not locked, close any open window */
     if (anchor_ms < 0) {
@@ -183,6 +232,12 @@ void bcd_window_check_transition(bcd_correlator_t *corr, float timestamp_ms) {
     int event_second = bcd_window_get_second_for_timestamp(corr, timestamp_ms, anchor_ms);
     if (event_second < 0) return;  /* Cannot determine - skip */
 
+    /* Reported after its window's deadline: the symbol is already out */
+    if (!corr->window_open && event_second == corr->closed_second &&
+        anchor_ms == corr->closed_anchor_ms) {
+        return;
+    }
+
     /* If window is not open, open it */
     if (!corr->window_open) {
         bcd_window_open(corr, event_second, anchor_ms);
@@ -4,8 +4,14 @@
  */
 
 #include "marker_correlator.h"
+#include "marker_detector.h"
+#include "wwv_timebase.h"
 #include "telemetry.h"
+#include "telemetry_wire.h"
 #include "version.h"
+#include "wwv_thread.h"
+#include "wwv_csv_log.h"
+#include "wwv_arena.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -22,7 +28,7 @@
 struct marker_correlator {
     /* Pending fast detection (waiting for slow confirmation) */
     bool fast_pending;
-    float fast_timestamp_ms;
+    double fast_timestamp_ms;
     float fast_duration_ms;
 
     /* Slow path state during fast event window */
@@ -40,25 +46,25 @@ struct marker_correlator {
     void *callback_user_data;
 
     /* Logging */
-    FILE *csv_file;
+    wwv_csv_log_t *csv_log;
+    telem_ctx_t *telem;    /* Telemetry destination, NULL = default context */
     time_t start_time;
 };
 
 marker_correlator_t *marker_correlator_create(const char *csv_path) {
-    marker_correlator_t *mc = calloc(1, sizeof(*mc));
+    marker_correlator_t *mc = wwv_calloc(1, sizeof(*mc));
     if (!mc) return NULL;
 
     mc->start_time = time(NULL);
 
     if (csv_path) {
-        mc->csv_file = fopen(csv_path, "w");
-        if (mc->csv_file) {
+        mc->csv_log = wwv_csv_log_open(csv_path);
+        if (mc->csv_log) {
             char time_str[64];
-            strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", localtime(&mc->start_time));
-            fprintf(mc->csv_file, "# Phoenix SDR Correlated Marker Log v%s\n", PHOENIX_VERSION_FULL);
-            fprintf(mc->csv_file, "# Started: %s\n", time_str);
-            fprintf(mc->csv_file, "time,timestamp_ms,marker_num,duration_ms,energy,snr_db,confidence\n");
-            fflush(mc->csv_file);
+            strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", wwv_localtime(&mc->start_time));
+            wwv_csv_log_header(mc->csv_log, "# Phoenix SDR Correlated Marker Log v%s\n", PHOENIX_VERSION_FULL);
+            wwv_csv_log_header(mc->csv_log, "# Started: %s\n", time_str);
+            wwv_csv_log_header(mc->csv_log, "time,timestamp_ms,marker_num,duration_ms,energy,snr_db,confidence\n");
         }
     }
 
@@ -74,12 +80,12 @@ void marker_correlator_destroy(marker_correlator_t *mc) {
     printf("[CORRELATOR] Stats: confirmed=%d, fast_only=%d, slow_only=%d\n",
            mc->markers_confirmed, mc->markers_fast_only, mc->markers_slow_only);
 
-    if (mc->csv_file) fclose(mc->csv_file);
-    free(mc);
+    wwv_csv_log_close(mc->csv_log);
+    wwv_free(mc);
 }
 
 void marker_correlator_fast_event(marker_correlator_t *mc,
-                                   float timestamp_ms,
+                                   double timestamp_ms,
                                    float duration_ms) {
     if (!mc) return;
 
@@ -93,7 +99,7 @@ void marker_correlator_fast_event(marker_correlator_t *mc,
 }
 
 void marker_correlator_slow_frame(marker_correlator_t *mc,
-                                   float timestamp_ms,
+                                   double timestamp_ms,
                                    float energy,
                                    float snr_db,
                                    bool above_threshold) {
@@ -139,28 +145,38 @@ void marker_correlator_slow_frame(marker_correlator_t *mc,
                        mc->slow_peak_snr, conf_str);
 
                 time_t event_time = mc->start_time + (time_t)(mc->fast_timestamp_ms / 1000.0f);
-                struct tm *tm_info = localtime(&event_time);
+                struct tm *tm_info = wwv_localtime(&event_time);
                 char time_str[16];
                 strftime(time_str, sizeof(time_str), "%H:%M:%S", tm_info);
 
-                if (mc->csv_file) {
-                    fprintf(mc->csv_file, "%s,%.1f,%d,%.1f,%.4f,%.1f,%s\n",
-                            time_str, mc->fast_timestamp_ms, marker_num,
-                            mc->fast_duration_ms, mc->slow_peak_energy,
-                            mc->slow_peak_snr, conf_str);
-                    fflush(mc->csv_file);
-                }
+                wwv_csv_log_row_at(mc->csv_log, event_time, "%.1f,%d,%.1f,%.4f,%.1f,%s\n",
+                                   mc->fast_timestamp_ms, marker_num,
+                                   mc->fast_duration_ms, mc->slow_peak_energy,
+                                   mc->slow_peak_snr, conf_str);
 
                 /* UDP telemetry */
-                telem_sendf(TELEM_MARKERS, "%s,%.1f,%d,%.1f,%.4f,%.1f,%s",
-                            time_str, mc->fast_timestamp_ms, marker_num,
-                            mc->fast_duration_ms, mc->slow_peak_energy,
-                            mc->slow_peak_snr, conf_str);
+                if (telem_ctx_binary_active(mc->telem, TELEM_MARKERS)) {
+                    telem_rec_marker_corr_t rec = {
+                        .number = (uint32_t)marker_num,
+                        .confidence = (conf == MARKER_CONF_HIGH) ? 1 : 0,
+                        .duration_ms = mc->fast_duration_ms,
+                        .energy = mc->slow_peak_energy,
+                        .snr_db = mc->slow_peak_snr
+                    };
+                    telem_ctx_send_record(mc->telem, TELEM_MARKERS, TELEM_REC_MARKER_CORR, (uint32_t)event_time,
+                                      telem_ms_to_us(mc->fast_timestamp_ms), &rec, sizeof(rec));
+                } else {
+                    telem_ctx_sendf(mc->telem, TELEM_MARKERS, "%s,%.1f,%d,%.1f,%.4f,%.1f,%s",
+                                time_str, mc->fast_timestamp_ms, marker_num,
+                                mc->fast_duration_ms, mc->slow_peak_energy,
+                                mc->slow_peak_snr, conf_str);
+                }
 
                 if (mc->callback) {
                     correlated_marker_t marker = {
                         .marker_number = marker_num,
                         .timestamp_ms = mc->fast_timestamp_ms,
+                        .sample_index = wwv_ms_to_samples(mc->fast_timestamp_ms, MARKER_SAMPLE_RATE),
                         .duration_ms = mc->fast_duration_ms,
                         .energy = mc->slow_peak_energy,
                         .snr_db = mc->slow_peak_snr,
@@ -181,3 +197,8 @@ void marker_correlator_set_callback(marker_correlator_t *mc,
     mc->callback = cb;
     mc->callback_user_data = user_data;
 }
+
+void marker_correlator_set_telemetry(marker_correlator_t *mc, telem_ctx_t *ctx) {
+    if (!mc) return;
+    mc->telem = ctx;
+}
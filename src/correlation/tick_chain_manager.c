@@ -8,6 +8,12 @@
  * Contains:
  *   - Chain initialization
  *   - Chain statistics updates
+ *   - Chain ring lookup and the longest-chain ranking
+ *
+ * Chains live in a fixed ring: starting chain N overwrites chain
+ * N - capacity, so memory stays flat however long the run. The few
+ * longest chains are kept as copies in a small sorted list, updated on
+ * each tick in O(TICK_CORR_TOP_CHAINS), so they outlive their ring slot.
  */
 
 #include "tick_correlator_internal.h"
@@ -17,7 +23,46 @@
  * Chain Management Functions
  *============================================================================*/
 
-void tick_chain_start_new(tick_correlator_t *tc, float timestamp_ms) {
+chain_stats_t *tick_chain_get(tick_correlator_t *tc, int chain_id) {
+    if (chain_id <= 0 || chain_id > tc->chain_count ||
+        chain_id <= tc->chain_count - tc->chain_capacity) {
+        return NULL;
+    }
+    return &tc->chains[(chain_id - 1) % tc->chain_capacity];
+}
+
+void tick_chain_rank(tick_correlator_t *tc, const chain_stats_t *cs) {
+    int k = 0;
+    while (k < tc->top_count && tc->top[k].chain_id != cs->chain_id) k++;
+
+    if (k == tc->top_count) {
+        /* Not ranked yet: take a free entry or displace the shortest */
+        if (tc->top_count < TICK_CORR_TOP_CHAINS) {
+            k = tc->top_count++;
+        } else if (cs->tick_count > tc->top[TICK_CORR_TOP_CHAINS - 1].tick_count) {
+            k = TICK_CORR_TOP_CHAINS - 1;
+        } else {
+            return;
+        }
+    }
+    tc->top[k] = *cs;
+
+    /* Usually moves up; a prediction reattach can also shorten a chain */
+    while (k > 0 && tc->top[k - 1].tick_count < tc->top[k].tick_count) {
+        chain_stats_t t = tc->top[k - 1];
+        tc->top[k - 1] = tc->top[k];
+        tc->top[k] = t;
+        k--;
+    }
+    while (k + 1 < tc->top_count && tc->top[k + 1].tick_count > tc->top[k].tick_count) {
+        chain_stats_t t = tc->top[k + 1];
+        tc->top[k + 1] = tc->top[k];
+        tc->top[k] = t;
+        k++;
+    }
+}
+
+void tick_chain_start_new(tick_correlator_t *tc, double timestamp_ms) {
     tc->chain_count++;
     tc->current_chain_id = tc->chain_count;
     tc->current_chain_length = 0;
@@ -29,9 +74,9 @@ void tick_chain_start_new(tick_correlator_t *tc, float timestamp_ms) {
     tc->recent_interval_count = 0;
     memset(tc->recent_intervals, 0, sizeof(tc->recent_intervals));
 
-    /* Initialize chain stats */
-    if (tc->chain_count <= tc->chain_capacity) {
-        chain_stats_t *cs = &tc->chains[tc->chain_count - 1];
+    /* Initialize chain stats (evicts the oldest chain once the ring is full) */
+    chain_stats_t *cs = tick_chain_get(tc, tc->current_chain_id);
+    if (cs) {
         cs->chain_id = tc->current_chain_id;
         cs->tick_count = 0;
         cs->inferred_count = 0;
@@ -44,10 +89,10 @@ void tick_chain_start_new(tick_correlator_t *tc, float timestamp_ms) {
     }
 }
 
-void tick_chain_update_stats(tick_correlator_t *tc, float interval_ms, float timestamp_ms) {
-    if (tc->current_chain_id <= 0 || tc->current_chain_id > tc->chain_capacity) return;
+void tick_chain_update_stats(tick_correlator_t *tc, float interval_ms, double timestamp_ms) {
+    chain_stats_t *cs = tick_chain_get(tc, tc->current_chain_id);
+    if (!cs) return;
 
-    chain_stats_t *cs = &tc->chains[tc->current_chain_id - 1];
     cs->tick_count = tc->current_chain_length;
     cs->end_ms = timestamp_ms;
     cs->total_drift_ms = tc->cumulative_drift_ms;
@@ -61,4 +106,6 @@ void tick_chain_update_stats(tick_correlator_t *tc, float interval_ms, float tim
         float n = (float)cs->tick_count;
         cs->avg_interval_ms = ((n - 1.0f) * cs->avg_interval_ms + interval_ms) / n;
     }
+
+    tick_chain_rank(tc, cs);
 }
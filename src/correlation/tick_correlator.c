@@ -11,6 +11,8 @@
 #include "correlation/tick_correlator_internal.h"
 #include "telemetry.h"
 #include "version.h"
+#include "wwv_thread.h"
+#include "wwv_arena.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -32,16 +34,21 @@
  *============================================================================*/
 
 tick_correlator_t *tick_correlator_create(const char *csv_path) {
-    tick_correlator_t *tc = (tick_correlator_t *)calloc(1, sizeof(tick_correlator_t));
+    return tick_correlator_create_sized(csv_path, 0, 0);
+}
+
+tick_correlator_t *tick_correlator_create_sized(const char *csv_path,
+                                                int chain_history, int tick_history) {
+    tick_correlator_t *tc = (tick_correlator_t *)wwv_calloc(1, sizeof(tick_correlator_t));
     if (!tc) return NULL;
 
-    /* Allocate tick storage */
-    tc->tick_capacity = MAX_TICKS_STORED;
-    tc->ticks = (tick_record_t *)calloc(tc->tick_capacity, sizeof(tick_record_t));
+    /* Allocate tick history ring */
+    tc->tick_capacity = (tick_history > 0) ? tick_history : CORR_DEFAULT_TICK_HISTORY;
+    tc->ticks = (tick_record_t *)wwv_calloc(tc->tick_capacity, sizeof(tick_record_t));
 
-    /* Allocate chain storage */
-    tc->chain_capacity = MAX_CHAINS;
-    tc->chains = (chain_stats_t *)calloc(tc->chain_capacity, sizeof(chain_stats_t));
+    /* Allocate chain history ring */
+    tc->chain_capacity = (chain_history > 0) ? chain_history : CORR_DEFAULT_CHAIN_HISTORY;
+    tc->chains = (chain_stats_t *)wwv_calloc(tc->chain_capacity, sizeof(chain_stats_t));
 
     if (!tc->ticks || !tc->chains) {
         tick_correlator_destroy(tc);
@@ -72,26 +79,25 @@ tick_correlator_t *tick_correlator_create(const char *csv_path) {
 
     /* Open CSV file */
     if (csv_path) {
-        tc->csv_file = fopen(csv_path, "w");
-        if (tc->csv_file) {
+        tc->csv_log = wwv_csv_log_open(csv_path);
+        if (tc->csv_log) {
             char time_str[64];
             strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S",
-                     localtime(&tc->start_time));
-
-            fprintf(tc->csv_file, "# Phoenix SDR WWV Tick Correlation Database v%s\n",
-                    PHOENIX_VERSION_FULL);
-            fprintf(tc->csv_file, "# Started: %s\n", time_str);
-            fprintf(tc->csv_file, "# Correlation window: %.0f-%.0f ms\n",
-                    CORR_MIN_INTERVAL_MS, CORR_MAX_INTERVAL_MS);
-            fprintf(tc->csv_file, "time,timestamp_ms,tick_num,expected,energy_peak,duration_ms,"
-                    "interval_ms,avg_interval_ms,noise_floor,corr_peak,corr_ratio,"
-                    "chain_id,chain_pos,chain_start_ms,drift_ms\n");
-            fflush(tc->csv_file);
+                     wwv_localtime(&tc->start_time));
+
+            wwv_csv_log_header(tc->csv_log, "# Phoenix SDR WWV Tick Correlation Database v%s\n",
+                               PHOENIX_VERSION_FULL);
+            wwv_csv_log_header(tc->csv_log, "# Started: %s\n", time_str);
+            wwv_csv_log_header(tc->csv_log, "# Correlation window: %.0f-%.0f ms\n",
+                               CORR_MIN_INTERVAL_MS, CORR_MAX_INTERVAL_MS);
+            wwv_csv_log_header(tc->csv_log, "time,timestamp_ms,tick_num,expected,energy_peak,duration_ms,"
+                               "interval_ms,avg_interval_ms,noise_floor,corr_peak,corr_ratio,"
+                               "chain_id,chain_pos,chain_start_ms,drift_ms\n");
         }
     }
 
-    printf("[CORR] Tick correlator created (window: %.0f-%.0f ms)\n",
-           CORR_MIN_INTERVAL_MS, CORR_MAX_INTERVAL_MS);
+    printf("[CORR] Tick correlator created (window: %.0f-%.0f ms, history: %d chains, %d ticks)\n",
+           CORR_MIN_INTERVAL_MS, CORR_MAX_INTERVAL_MS, tc->chain_capacity, tc->tick_capacity);
 
     return tc;
 }
@@ -99,15 +105,16 @@ tick_correlator_t *tick_correlator_create(const char *csv_path) {
 void tick_correlator_destroy(tick_correlator_t *tc) {
     if (!tc) return;
 
-    if (tc->csv_file) fclose(tc->csv_file);
-    free(tc->ticks);
-    free(tc->chains);
-    free(tc);
+    wwv_csv_log_close(tc->csv_log);
+    wwv_free(tc->ticks);
+    wwv_free(tc->chains);
+    wwv_free(tc);
 }
 
 void tick_correlator_add_tick(tick_correlator_t *tc,
                               const char *time_str,
-                              float timestamp_ms,
+                              double timestamp_ms,
+                              double epoch_ms,
                               int tick_num,
                               const char *expected,
                               float energy_peak,
@@ -119,14 +126,17 @@ void tick_correlator_add_tick(tick_correlator_t *tc,
                               float corr_ratio) {
     if (!tc) return;
 
+    /* Interval timing from the sub-sample pulse start when the detector has one */
+    double tick_ms = (epoch_ms > 0.0) ? epoch_ms : timestamp_ms;
+
     /* Calculate interval from last tick */
-    float actual_interval = timestamp_ms - tc->last_tick_ms;
+    float actual_interval = tick_ms - tc->last_tick_ms;
 
     /* Prediction-based tracking: check if tick matches prediction from established discipline */
     bool prediction_match = false;
     if (tc->tracking.active && tc->last_tick_ms > 0) {
-        float predicted_next = tc->last_tick_ms + CORR_NOMINAL_INTERVAL;
-        float prediction_error = fabsf(timestamp_ms - predicted_next);
+        double predicted_next = tc->last_tick_ms + CORR_NOMINAL_INTERVAL;
+        float prediction_error = (float)fabs(tick_ms - predicted_next);
 
         /* Require BOTH timestamp AND interval discipline:
          * - Timestamp within discipline window (±10ms typical)
@@ -136,24 +146,24 @@ void tick_correlator_add_tick(tick_correlator_t *tc,
             /* Both timestamp and interval match discipline - accept it */
             prediction_match = true;
             tc->tracking.consecutive_misses = 0;
-            telem_sendf(TELEM_CONSOLE, "[TRACK] HIT: t_err=%.1fms int=%.1fms chain=%d",
+            telem_ctx_sendf(tc->telem, TELEM_CONSOLE, "[TRACK] HIT: t_err=%.1fms int=%.1fms chain=%d",
                        prediction_error, actual_interval, tc->tracking.retained_chain_id);
 
             /* Reattach to retained chain if we broke off */
             if (tc->current_chain_id != tc->tracking.retained_chain_id) {
-                telem_sendf(TELEM_CONSOLE, "[TRACK] Reattach: %d → %d",
+                telem_ctx_sendf(tc->telem, TELEM_CONSOLE, "[TRACK] Reattach: %d → %d",
                            tc->current_chain_id, tc->tracking.retained_chain_id);
                 tc->current_chain_id = tc->tracking.retained_chain_id;
             }
         } else {
             /* Prediction miss - increment miss counter */
             tc->tracking.consecutive_misses++;
-            telem_sendf(TELEM_CONSOLE, "[TRACK] MISS: t_err=%.1fms int=%.1fms misses=%d",
+            telem_ctx_sendf(tc->telem, TELEM_CONSOLE, "[TRACK] MISS: t_err=%.1fms int=%.1fms misses=%d",
                        prediction_error, actual_interval, tc->tracking.consecutive_misses);
 
             /* Exit tracking after max consecutive misses */
             if (tc->tracking.consecutive_misses >= tc->max_consecutive_misses) {
-                telem_sendf(TELEM_CONSOLE, "[TRACK] Deactivated: %d consecutive misses, signal lost",
+                telem_ctx_sendf(tc->telem, TELEM_CONSOLE, "[TRACK] Deactivated: %d consecutive misses, signal lost",
                            tc->max_consecutive_misses);
                 tc->tracking.active = false;
                 tc->tracking.consecutive_misses = 0;
@@ -176,19 +186,18 @@ void tick_correlator_add_tick(tick_correlator_t *tc,
 
     if (!correlates && !one_skip) {
         /* Start new chain - neither normal interval nor single skip */
-        tick_chain_start_new(tc, timestamp_ms);
+        tick_chain_start_new(tc, tick_ms);
         tc->total_uncorrelated++;
     } else if (one_skip && tc->current_chain_id != 0) {
         /* Single tick dropout - continue chain, split drift across both */
         drift_this_tick = (actual_interval - 2000.0f) / 2.0f;
         tc->total_correlated++;
         /* Increment inferred count for this chain */
-        if (tc->current_chain_id > 0 && tc->current_chain_id <= tc->chain_capacity) {
-            tc->chains[tc->current_chain_id - 1].inferred_count++;
-        }
+        chain_stats_t *cs = tick_chain_get(tc, tc->current_chain_id);
+        if (cs) cs->inferred_count++;
     } else if (tc->current_chain_id == 0) {
         /* First tick or after uncorrelated - start new chain */
-        tick_chain_start_new(tc, timestamp_ms);
+        tick_chain_start_new(tc, tick_ms);
         tc->total_uncorrelated++;
     } else {
         /* Normal correlation */
@@ -201,7 +210,7 @@ void tick_correlator_add_tick(tick_correlator_t *tc,
     tc->cumulative_drift_ms += drift_this_tick;
 
     /* Update chain stats */
-    tick_chain_update_stats(tc, actual_interval, timestamp_ms);
+    tick_chain_update_stats(tc, actual_interval, tick_ms);
 
     /* Track longest chain */
     if (tc->current_chain_length > tc->longest_chain_ticks) {
@@ -245,7 +254,7 @@ void tick_correlator_add_tick(tick_correlator_t *tc,
 
             /* Deactivate tracking if discipline degraded beyond threshold */
             if (std_dev_ms > 20.0f) {
-                telem_sendf(TELEM_CONSOLE, "[TRACK] Deactivated: discipline degraded (std_dev=%.1fms > 20ms)",
+                telem_ctx_sendf(tc->telem, TELEM_CONSOLE, "[TRACK] Deactivated: discipline degraded (std_dev=%.1fms > 20ms)",
                            std_dev_ms);
                 tc->tracking.active = false;
                 tc->tracking.consecutive_misses = 0;
@@ -258,7 +267,7 @@ void tick_correlator_add_tick(tick_correlator_t *tc,
 
         /* Only call if confidence is reasonable (std_dev < 10ms) */
         if (confidence > tc->epoch_confidence_threshold) {
-            float epoch_offset_ms = fmodf(timestamp_ms, 1000.0f);
+            float epoch_offset_ms = (float)fmod(timestamp_ms, 1000.0);
             if (epoch_offset_ms < 0) epoch_offset_ms += 1000.0f;
             tc->epoch_callback(epoch_offset_ms, std_dev_ms, confidence, tc->epoch_callback_user_data);
 
@@ -269,57 +278,53 @@ void tick_correlator_add_tick(tick_correlator_t *tc,
                 tc->tracking.discipline_window_ms = std_dev_ms * 4.0f;  /* 4σ confidence interval */
                 tc->tracking.last_std_dev_ms = std_dev_ms;
                 tc->tracking.consecutive_misses = 0;
-                telem_sendf(TELEM_CONSOLE, "[TRACK] Activated: chain=%d window=%.1fms (4σ=%.1fms)",
+                telem_ctx_sendf(tc->telem, TELEM_CONSOLE, "[TRACK] Activated: chain=%d window=%.1fms (4σ=%.1fms)",
                            tc->current_chain_id, tc->tracking.discipline_window_ms, std_dev_ms);
             }
         }
     }
 
-    /* Store tick record */
-    if (tc->tick_count < tc->tick_capacity) {
-        tick_record_t *tr = &tc->ticks[tc->tick_count];
-
-        strncpy(tr->time_str, time_str, sizeof(tr->time_str) - 1);
-        tr->timestamp_ms = timestamp_ms;
-        tr->tick_num = tick_num;
-        strncpy(tr->expected, expected, sizeof(tr->expected) - 1);
-        tr->energy_peak = energy_peak;
-        tr->duration_ms = duration_ms;
-        tr->interval_ms = interval_ms;
-        tr->avg_interval_ms = avg_interval_ms;
-        tr->noise_floor = noise_floor;
-        tr->corr_peak = corr_peak;
-        tr->corr_ratio = corr_ratio;
-
-        tr->chain_id = tc->current_chain_id;
-        tr->chain_position = tc->current_chain_length;
-        tr->chain_start_ms = tc->current_chain_start_ms;
-        tr->drift_ms = tc->cumulative_drift_ms;
-
-        tc->tick_count++;
-    }
+    /* Store tick record, overwriting the oldest once the ring is full */
+    tick_record_t *tr = &tc->ticks[tc->tick_count % tc->tick_capacity];
+
+    strncpy(tr->time_str, time_str, sizeof(tr->time_str) - 1);
+    tr->timestamp_ms = timestamp_ms;
+    tr->epoch_ms = tick_ms;
+    tr->tick_num = tick_num;
+    strncpy(tr->expected, expected, sizeof(tr->expected) - 1);
+    tr->energy_peak = energy_peak;
+    tr->duration_ms = duration_ms;
+    tr->interval_ms = interval_ms;
+    tr->avg_interval_ms = avg_interval_ms;
+    tr->noise_floor = noise_floor;
+    tr->corr_peak = corr_peak;
+    tr->corr_ratio = corr_ratio;
+
+    tr->chain_id = tc->current_chain_id;
+    tr->chain_position = tc->current_chain_length;
+    tr->chain_start_ms = tc->current_chain_start_ms;
+    tr->drift_ms = tc->cumulative_drift_ms;
+
+    tc->tick_count++;
 
     /* CSV output and telemetry */
-    if (tc->csv_file) {
-        fprintf(tc->csv_file, "%s,%.1f,%d,%s,%.6f,%.1f,%.0f,%.0f,%.6f,%.2f,%.1f,"
-                "%d,%d,%.1f,%.1f\n",
-                time_str, timestamp_ms, tick_num, expected,
-                energy_peak, duration_ms, interval_ms, avg_interval_ms,
-                noise_floor, corr_peak, corr_ratio,
-                tc->current_chain_id, tc->current_chain_length,
-                tc->current_chain_start_ms, tc->cumulative_drift_ms);
-        fflush(tc->csv_file);
-    }
+    wwv_csv_log_row(tc->csv_log, "%s,%.1f,%d,%s,%.6f,%.1f,%.0f,%.0f,%.6f,%.2f,%.1f,"
+                    "%d,%d,%.1f,%.1f\n",
+                    time_str, timestamp_ms, tick_num, expected,
+                    energy_peak, duration_ms, interval_ms, avg_interval_ms,
+                    noise_floor, corr_peak, corr_ratio,
+                    tc->current_chain_id, tc->current_chain_length,
+                    tc->current_chain_start_ms, tc->cumulative_drift_ms);
 
     /* UDP telemetry */
-    telem_sendf(TELEM_CORR, "%s,%.1f,%d,%s,%.6f,%.1f,%.0f,%.0f,%.6f,%.2f,%.1f,%d,%d,%.1f,%.1f",
+    telem_ctx_sendf(tc->telem, TELEM_CORR, "%s,%.1f,%d,%s,%.6f,%.1f,%.0f,%.0f,%.6f,%.2f,%.1f,%d,%d,%.1f,%.1f",
                 time_str, timestamp_ms, tick_num, expected,
                 energy_peak, duration_ms, interval_ms, avg_interval_ms,
                 noise_floor, corr_peak, corr_ratio,
                 tc->current_chain_id, tc->current_chain_length,
                 tc->current_chain_start_ms, tc->cumulative_drift_ms);
 
-    tc->last_tick_ms = timestamp_ms;
+    tc->last_tick_ms = tick_ms;
 }
 
 int tick_correlator_get_chain_count(tick_correlator_t *tc) {
@@ -336,16 +341,29 @@ float tick_correlator_get_current_drift(tick_correlator_t *tc) {
 
 chain_stats_t tick_correlator_get_chain_stats(tick_correlator_t *tc, int chain_id) {
     chain_stats_t empty = {0};
-    if (!tc || chain_id <= 0 || chain_id > tc->chain_count) return empty;
-    return tc->chains[chain_id - 1];
+    const chain_stats_t *cs = tc ? tick_chain_get(tc, chain_id) : NULL;
+    return cs ? *cs : empty;
+}
+
+int tick_correlator_get_top_chains(tick_correlator_t *tc, chain_stats_t *out, int max) {
+    if (!tc || !out || max <= 0) return 0;
+    int n = (tc->top_count < max) ? tc->top_count : max;
+    memcpy(out, tc->top, (size_t)n * sizeof(chain_stats_t));
+    return n;
+}
+
+bool tick_correlator_get_tick(tick_correlator_t *tc, int age, tick_record_t *out) {
+    if (!tc || !out || age < 0 || age >= tc->tick_count || age >= tc->tick_capacity) return false;
+    *out = tc->ticks[(tc->tick_count - 1 - age) % tc->tick_capacity];
+    return true;
 }
 
 void tick_correlator_print_stats(tick_correlator_t *tc) {
     if (!tc) return;
 
     printf("\n=== TICK CORRELATION STATS ===\n");
-    printf("Total ticks: %d\n", tc->tick_count);
-    printf("Chains: %d\n", tc->chain_count);
+    printf("Total ticks: %d (history %d)\n", tc->tick_count, tc->tick_capacity);
+    printf("Chains: %d (history %d)\n", tc->chain_count, tc->chain_capacity);
     printf("Correlated: %d  Uncorrelated: %d\n",
            tc->total_correlated, tc->total_uncorrelated);
     printf("Longest chain: %.0f ticks\n", tc->longest_chain_ticks);
@@ -358,13 +376,11 @@ void tick_correlator_print_stats(tick_correlator_t *tc) {
 
     /* Show top chains */
     printf("\nTop chains by length:\n");
-    int shown = 0;
-    for (int i = tc->chain_count - 1; i >= 0 && shown < 5; i--) {
-        chain_stats_t *cs = &tc->chains[i];
+    for (int i = 0; i < tc->top_count; i++) {
+        chain_stats_t *cs = &tc->top[i];
         if (cs->tick_count > 1) {
             printf("  Chain #%d: %d ticks, avg=%.1fms, drift=%.1fms\n",
                    cs->chain_id, cs->tick_count, cs->avg_interval_ms, cs->total_drift_ms);
-            shown++;
         }
     }
 
@@ -377,6 +393,11 @@ void tick_correlator_set_epoch_callback(tick_correlator_t *tc, epoch_callback_fn
     tc->epoch_callback_user_data = user_data;
 }
 
+void tick_correlator_set_telemetry(tick_correlator_t *tc, telem_ctx_t *ctx) {
+    if (!tc) return;
+    tc->telem = ctx;
+}
+
 /*============================================================================
  * Runtime Parameter Tuning
  *============================================================================*/
@@ -398,3 +419,107 @@ void tick_correlator_set_max_misses(tick_correlator_t *tc, int max_misses) {
 int tick_correlator_get_max_misses(tick_correlator_t *tc) {
     return tc ? tc->max_consecutive_misses : 5;
 }
+
+/*============================================================================
+ * Warm Start
+ *============================================================================*/
+
+#define TICK_CORR_STATE_VERSION     1
+
+typedef struct {
+    double last_tick_ms;
+    double chain_start_ms;
+    double stats_start_ms;
+    double stats_end_ms;
+    int32_t chain_length;
+    int32_t tick_count;
+    int32_t inferred_count;
+    float cumulative_drift_ms;
+    float total_drift_ms;
+    float avg_interval_ms;
+    float min_interval_ms;
+    float max_interval_ms;
+    float recent_intervals[5];
+    int32_t recent_interval_idx;
+    int32_t recent_interval_count;
+    float discipline_window_ms;
+    float last_std_dev_ms;
+    uint8_t tracking_active;
+    uint8_t reserved[3];
+} tick_corr_state_t;
+
+_Static_assert(sizeof(tick_corr_state_t) == 104, "tick correlator state layout");
+
+bool tick_correlator_save_state(tick_correlator_t *tc, wwv_state_writer_t *w) {
+    const chain_stats_t *cs = (tc && w) ? tick_chain_get(tc, tc->current_chain_id) : NULL;
+    if (!cs) return false;
+
+    tick_corr_state_t st;
+    memset(&st, 0, sizeof(st));
+    st.last_tick_ms = tc->last_tick_ms;
+    st.chain_start_ms = tc->current_chain_start_ms;
+    st.stats_start_ms = cs->start_ms;
+    st.stats_end_ms = cs->end_ms;
+    st.chain_length = tc->current_chain_length;
+    st.tick_count = cs->tick_count;
+    st.inferred_count = cs->inferred_count;
+    st.cumulative_drift_ms = tc->cumulative_drift_ms;
+    st.total_drift_ms = cs->total_drift_ms;
+    st.avg_interval_ms = cs->avg_interval_ms;
+    st.min_interval_ms = cs->min_interval_ms;
+    st.max_interval_ms = cs->max_interval_ms;
+    memcpy(st.recent_intervals, tc->recent_intervals, sizeof(st.recent_intervals));
+    st.recent_interval_idx = tc->recent_interval_idx;
+    st.recent_interval_count = tc->recent_interval_count;
+    st.tracking_active = tc->tracking.active &&
+                         tc->tracking.retained_chain_id == tc->current_chain_id;
+    st.discipline_window_ms = tc->tracking.discipline_window_ms;
+    st.last_std_dev_ms = tc->tracking.last_std_dev_ms;
+    return wwv_state_put(w, WWV_STATE_TICK_CORRELATOR, TICK_CORR_STATE_VERSION, &st, sizeof(st));
+}
+
+bool tick_correlator_restore_state(tick_correlator_t *tc, const wwv_state_reader_t *r) {
+    if (!tc || !r || tc->chain_count != 0 || r->elapsed_ms > WWV_STATE_TIMING_MAX_AGE_MS) {
+        return false;
+    }
+
+    tick_corr_state_t st;
+    if (!wwv_state_get(r, WWV_STATE_TICK_CORRELATOR, TICK_CORR_STATE_VERSION, &st, sizeof(st)) ||
+        st.chain_length <= 0 || st.recent_interval_count > 5 ||
+        st.recent_interval_idx < 0 || st.recent_interval_idx >= 5) {
+        return false;
+    }
+
+    /* Every chain time moves with the last tick, to the latest second before now */
+    double shift = wwv_state_carry_phase(r, st.last_tick_ms, 1000.0) - st.last_tick_ms;
+
+    tick_chain_start_new(tc, st.chain_start_ms + shift);
+    chain_stats_t *cs = tick_chain_get(tc, tc->current_chain_id);
+    cs->tick_count = st.tick_count;
+    cs->inferred_count = st.inferred_count;
+    cs->start_ms = st.stats_start_ms + shift;
+    cs->end_ms = st.stats_end_ms + shift;
+    cs->total_drift_ms = st.total_drift_ms;
+    cs->avg_interval_ms = st.avg_interval_ms;
+    cs->min_interval_ms = st.min_interval_ms;
+    cs->max_interval_ms = st.max_interval_ms;
+    tick_chain_rank(tc, cs);
+
+    tc->current_chain_length = st.chain_length;
+    tc->cumulative_drift_ms = st.cumulative_drift_ms;
+    tc->last_tick_ms = st.last_tick_ms + shift;
+    memcpy(tc->recent_intervals, st.recent_intervals, sizeof(tc->recent_intervals));
+    tc->recent_interval_idx = st.recent_interval_idx;
+    tc->recent_interval_count = st.recent_interval_count;
+
+    tc->tracking.active = st.tracking_active != 0;
+    tc->tracking.retained_chain_id = st.tracking_active ? tc->current_chain_id : 0;
+    tc->tracking.discipline_window_ms = st.discipline_window_ms;
+    tc->tracking.last_std_dev_ms = st.last_std_dev_ms;
+    tc->tracking.consecutive_misses = 0;
+
+    printf("[CORR] Warm start: chain of %d ticks from %.1f s ago%s\n",
+           tc->current_chain_length, r->elapsed_ms / 1000.0,
+           tc->tracking.active ? ", tracking" : "");
+    return true;
+}
@@ -12,6 +12,7 @@
  */
 
 #include "bcd_decoder.h"
+#include "wwv_arena.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -23,16 +24,16 @@
 struct bcd_decoder {
     /* Pulse detection state */
     bool in_pulse;                  /* Currently detecting a pulse */
-    float pulse_start_ms;           /* Timestamp when pulse started */
+    double pulse_start_ms;          /* Timestamp when pulse started */
     float pulse_snr_sum;            /* Sum of SNR during pulse (for averaging) */
     int pulse_sample_count;         /* Samples in current pulse */
     
     /* Lockout to prevent duplicate detections */
-    float last_symbol_time_ms;      /* When last symbol was detected */
+    double last_symbol_time_ms;     /* When last symbol was detected */
     bool in_lockout;                /* Currently in lockout period */
     
     /* Timing */
-    float last_timestamp_ms;
+    double last_timestamp_ms;
     bool first_sample;
     
     /* Statistics */
@@ -70,7 +71,7 @@ static bcd_symbol_t classify_pulse(float width_ms) {
  *============================================================================*/
 
 bcd_decoder_t *bcd_decoder_create(void) {
-    bcd_decoder_t *dec = calloc(1, sizeof(bcd_decoder_t));
+    bcd_decoder_t *dec = wwv_calloc(1, sizeof(bcd_decoder_t));
     if (!dec) return NULL;
     
     dec->first_sample = true;
@@ -79,11 +80,11 @@ bcd_decoder_t *bcd_decoder_create(void) {
 }
 
 void bcd_decoder_destroy(bcd_decoder_t *dec) {
-    free(dec);
+    wwv_free(dec);
 }
 
 void bcd_decoder_process_sample(bcd_decoder_t *dec,
-                                float timestamp_ms,
+                                double timestamp_ms,
                                 float envelope,
                                 float snr_db,
                                 bcd_status_t status) {
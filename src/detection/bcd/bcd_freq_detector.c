@@ -10,6 +10,9 @@
  *
  * Pattern: Follows marker_detector.c structure
  *
+ * Sliding mode replaces the FFT with a decimator and sliding_dft_t; one
+ * decimated sample is one state machine frame.
+ *
  * This detector provides confident 100Hz identification.
  * Works in parallel with bcd_time_detector which provides precise edge timing.
  * The bcd_correlator combines both for reliable symbol output.
@@ -20,89 +23,145 @@
 #include "telemetry.h"
 #include "fft_processor.h"
 #include "version.h"
+#include "wwv_thread.h"
+#include "wwv_arena.h"
+#include "wwv_trace.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include <time.h>
 
+/* Sliding decimator: -6 dB at the 781 Hz output Nyquist, 80 dB by 1362 Hz,
+ * so nothing folds within 200 Hz of DC (the 1500 Hz WWVH tone would land
+ * on -62.5 Hz) */
+#define BCD_SLIDING_TAPS        224
+#define BCD_SLIDING_CUTOFF_HZ   781.25f
+#define BCD_SLIDING_RATE        ((float)BCD_FREQ_SAMPLE_RATE / BCD_FREQ_SLIDING_DECIM)
 
+/* Hop h's window is decimated samples h-63..h; its centre sits at input
+ * 32h - (63 * 32 + taps - 1) / 2. The timestamp is that centre less half an
+ * FFT frame, so both modes stamp a pulse at the same window start */
+#define BCD_SLIDING_LAG         (((BCD_FREQ_SLIDING_SIZE - 1) * BCD_FREQ_SLIDING_DECIM + \
+                                  (BCD_SLIDING_TAPS - 1) + (BCD_FREQ_FFT_SIZE - 1)) / 2)
 
 /*============================================================================
  * Public API Implementation
  *============================================================================*/
 
-bcd_freq_detector_t *bcd_freq_detector_create(const char *csv_path) {
-    bcd_freq_detector_t *fd = (bcd_freq_detector_t *)calloc(1, sizeof(bcd_freq_detector_t));
+static bcd_freq_detector_t *create(const char *csv_path, bool sliding) {
+    bcd_freq_detector_t *fd = (bcd_freq_detector_t *)wwv_aligned_calloc(WWV_CACHE_LINE, sizeof(bcd_freq_detector_t));
     if (!fd) return NULL;
 
-    fd->fft = fft_processor_create(BCD_FREQ_FFT_SIZE, BCD_FREQ_SAMPLE_RATE);
-    if (!fd->fft) {
-        free(fd);
-        return NULL;
+    fd->sliding = sliding;
+    if (sliding) {
+        fd->frame_samples = BCD_FREQ_SLIDING_DECIM;
+        fd->frame_hops = BCD_FREQ_SLIDING_HOPS;
+        fd->frame_lag = BCD_SLIDING_LAG;
+    } else {
+        fd->frame_samples = BCD_FREQ_FFT_SIZE;
+        fd->frame_hops = 1;
+        fd->frame_lag = 0;
     }
+    fd->frame_ms = (float)fd->frame_samples * 1000.0f / BCD_FREQ_SAMPLE_RATE;
 
     float frame_duration_ms = bcd_freq_detector_get_frame_duration_ms();
-    int window_frames = (int)(BCD_FREQ_WINDOW_MS / frame_duration_ms);
+    int window_frames = (int)(BCD_FREQ_WINDOW_MS / frame_duration_ms) * fd->frame_hops;
+    bool ready;
+
+    if (sliding) {
+        size_t dec_capacity;
+        fd->decim = polyphase_resampler_create(1, BCD_FREQ_SLIDING_DECIM, BCD_SLIDING_TAPS,
+                                               (float)BCD_FREQ_SAMPLE_RATE, BCD_SLIDING_CUTOFF_HZ);
+        fd->sdft = sliding_dft_create(BCD_FREQ_SLIDING_SIZE, BCD_SLIDING_RATE);
+        fd->fft_band = sliding_dft_add_band(fd->sdft, BCD_FREQ_TARGET_FREQ_HZ, BCD_FREQ_BANDWIDTH_HZ);
+        dec_capacity = polyphase_resampler_max_output(fd->decim, BCD_FREQ_FFT_SIZE);
+        fd->dec_i = (float *)wwv_malloc(dec_capacity * sizeof(float));
+        fd->dec_q = (float *)wwv_malloc(dec_capacity * sizeof(float));
+        ready = fd->decim && fd->sdft && fd->fft_band >= 0 && fd->dec_i && fd->dec_q;
+    } else {
+        fd->fft = fft_processor_create(BCD_FREQ_FFT_SIZE, BCD_FREQ_SAMPLE_RATE);
+        if (fd->fft) {
+            fd->fft_band = fft_processor_add_band(fd->fft, BCD_FREQ_TARGET_FREQ_HZ, BCD_FREQ_BANDWIDTH_HZ, FFT_BAND_MAGNITUDE);
+        }
+        ready = fd->fft != NULL;
+    }
 
-    fd->i_buffer = (float *)malloc(BCD_FREQ_FFT_SIZE * sizeof(float));
-    fd->q_buffer = (float *)malloc(BCD_FREQ_FFT_SIZE * sizeof(float));
-    fd->energy_history = (float *)malloc(window_frames * sizeof(float));
+    fd->i_buffer = (float *)wwv_malloc(fd->frame_samples * sizeof(float));
+    fd->q_buffer = (float *)wwv_malloc(fd->frame_samples * sizeof(float));
+    fd->energy_sum = sliding_sum_create(window_frames);
+    fd->energy_window = sliding_sum_add_window(fd->energy_sum, window_frames);
 
-    if (!fd->i_buffer || !fd->q_buffer || !fd->energy_history) {
+    if (!ready || !fd->i_buffer || !fd->q_buffer || fd->energy_window < 0) {
         bcd_freq_detector_destroy(fd);
         return NULL;
     }
 
-    memset(fd->i_buffer, 0, BCD_FREQ_FFT_SIZE * sizeof(float));
-    memset(fd->q_buffer, 0, BCD_FREQ_FFT_SIZE * sizeof(float));
+    memset(fd->i_buffer, 0, fd->frame_samples * sizeof(float));
+    memset(fd->q_buffer, 0, fd->frame_samples * sizeof(float));
     fd->buffer_idx = 0;
 
-    memset(fd->energy_history, 0, window_frames * sizeof(float));
-    fd->history_idx = 0;
-    fd->history_count = 0;
     fd->accumulated_energy = 0.0f;
     fd->baseline_energy = 0.0001f;
 
-    fd->state = STATE_IDLE;
+    bcd_freq_init_state_machine(fd);
     fd->threshold = fd->baseline_energy * BCD_FREQ_THRESHOLD_MULT;
     fd->detection_enabled = true;
     fd->warmup_complete = false;
     fd->start_time = time(NULL);
 
     if (csv_path) {
-        fd->csv_file = fopen(csv_path, "w");
-        if (fd->csv_file) {
+        fd->csv_log = wwv_csv_log_open(csv_path);
+        if (fd->csv_log) {
             char time_str[64];
             time_t now = time(NULL);
-            strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", localtime(&now));
-            fprintf(fd->csv_file, "# Phoenix SDR BCD Freq Detector Log v%s\n", PHOENIX_VERSION_FULL);
-            fprintf(fd->csv_file, "# Started: %s\n", time_str);
-            fprintf(fd->csv_file, "# FFT: %d (%.2fms), Window: %d frames (%.0fms)\n",
-                    BCD_FREQ_FFT_SIZE, frame_duration_ms, window_frames, BCD_FREQ_WINDOW_MS);
-            fprintf(fd->csv_file, "# Target: %dHz ±%dHz\n",
-                    BCD_FREQ_TARGET_FREQ_HZ, BCD_FREQ_BANDWIDTH_HZ);
-            fprintf(fd->csv_file, "time,timestamp_ms,pulse_num,accum_energy,duration_ms,baseline,snr_db\n");
-            fflush(fd->csv_file);
+            strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", wwv_localtime(&now));
+            wwv_csv_log_header(fd->csv_log, "# Phoenix SDR BCD Freq Detector Log v%s\n", PHOENIX_VERSION_FULL);
+            wwv_csv_log_header(fd->csv_log, "# Started: %s\n", time_str);
+            wwv_csv_log_header(fd->csv_log, "# %s: %d (%.2fms), hop %.2fms, Window: %d frames (%.0fms)\n",
+                               sliding ? "Sliding DFT" : "FFT",
+                               sliding ? BCD_FREQ_SLIDING_SIZE : BCD_FREQ_FFT_SIZE,
+                               frame_duration_ms, fd->frame_ms, window_frames, BCD_FREQ_WINDOW_MS);
+            wwv_csv_log_header(fd->csv_log, "# Target: %dHz ±%dHz\n",
+                               BCD_FREQ_TARGET_FREQ_HZ, BCD_FREQ_BANDWIDTH_HZ);
+            wwv_csv_log_header(fd->csv_log, "time,timestamp_ms,pulse_num,accum_energy,duration_ms,baseline,snr_db\n");
         }
     }
 
-    printf("[BCD_FREQ] Detector created: FFT=%d (%.2fms), window=%d frames (%.0fms)\n",
-           BCD_FREQ_FFT_SIZE, frame_duration_ms, window_frames, BCD_FREQ_WINDOW_MS);
+    if (sliding) {
+        printf("[BCD_FREQ] Detector created: sliding DFT=%d at %.1f Hz (%.2fms), hop=%.2fms, window=%d hops (%.0fms)\n",
+               BCD_FREQ_SLIDING_SIZE, BCD_SLIDING_RATE, frame_duration_ms, fd->frame_ms,
+               window_frames, BCD_FREQ_WINDOW_MS);
+    } else {
+        printf("[BCD_FREQ] Detector created: FFT=%d (%.2fms), window=%d frames (%.0fms)\n",
+               BCD_FREQ_FFT_SIZE, frame_duration_ms, window_frames, BCD_FREQ_WINDOW_MS);
+    }
     printf("[BCD_FREQ] Target: %dHz ±%dHz, self-tracking baseline\n",
            BCD_FREQ_TARGET_FREQ_HZ, BCD_FREQ_BANDWIDTH_HZ);
 
     return fd;
 }
 
+bcd_freq_detector_t *bcd_freq_detector_create(const char *csv_path) {
+    return create(csv_path, false);
+}
+
+bcd_freq_detector_t *bcd_freq_detector_create_sliding(const char *csv_path) {
+    return create(csv_path, true);
+}
+
 void bcd_freq_detector_destroy(bcd_freq_detector_t *fd) {
     if (!fd) return;
 
-    if (fd->csv_file) fclose(fd->csv_file);
+    wwv_csv_log_close(fd->csv_log);
     if (fd->fft) fft_processor_destroy(fd->fft);
-    free(fd->i_buffer);
-    free(fd->q_buffer);
-    free(fd->energy_history);
-    free(fd);
+    polyphase_resampler_destroy(fd->decim);
+    sliding_dft_destroy(fd->sdft);
+    wwv_free(fd->dec_i);
+    wwv_free(fd->dec_q);
+    wwv_free(fd->i_buffer);
+    wwv_free(fd->q_buffer);
+    sliding_sum_destroy(fd->energy_sum);
+    wwv_aligned_free(fd);
 }
 
 void bcd_freq_detector_set_callback(bcd_freq_detector_t *fd,
@@ -113,11 +172,125 @@ void bcd_freq_detector_set_callback(bcd_freq_detector_t *fd,
     fd->callback_user_data = user_data;
 }
 
+void bcd_freq_detector_set_telemetry(bcd_freq_detector_t *fd, telem_ctx_t *ctx) {
+    if (!fd) return;
+    fd->telem = ctx;
+}
+
+void bcd_freq_detector_set_perf(bcd_freq_detector_t *fd, wwv_perf_t *perf) {
+    if (!fd) return;
+    fd->perf = perf;
+    wwv_csv_log_set_perf(fd->csv_log, perf);
+}
+
+/**
+ * FFT frame is full - extract energy and run the state machine
+ * @param frame_i, frame_q BCD_FREQ_FFT_SIZE samples (frame buffer or caller's block)
+ * @return true if a pulse started on this frame
+ */
+static bool process_frame(bcd_freq_detector_t *fd, const float *frame_i, const float *frame_q) {
+    fd->buffer_idx = 0;
+    WWV_TRACE_BEGIN(tr);
+
+    /* Run FFT */
+    WWV_PERF_BEGIN(fd->perf, t0);
+    fft_processor_process(fd->fft, frame_i, frame_q);
+    fd->fft_count++;
+
+    /* Extract bucket energy */
+    fd->current_energy = bcd_freq_calculate_bucket_energy(fd);
+    WWV_PERF_END(fd->perf, WWV_PERF_BCD_FREQ_FFT, t0);
+
+    /* Run detection state machine */
+    WWV_PERF_BEGIN(fd->perf, t1);
+    bcd_freq_run_state_machine(fd);
+    WWV_PERF_END(fd->perf, WWV_PERF_BCD_FREQ_STATE, t1);
+    WWV_TRACE_END("detector", "bcd_freq_frame", tr, fd->frame_count * (double)fd->frame_ms);
+
+    fd->frame_count++;
+
+    return (fd->pulse.state == PULSE_ACTIVE && fd->pulse.duration == 1);
+}
+
+/**
+ * Idle frame is complete - one in BCD_FREQ_IDLE_DECIM runs the FFT, the
+ * others repeat its energy so the window sum keeps its scale
+ * @param frame_i, frame_q The frame's samples, NULL for a repeated frame
+ */
+static void idle_frame(bcd_freq_detector_t *fd, const float *frame_i, const float *frame_q) {
+    fd->buffer_idx = 0;
+
+    if (frame_i) {
+        WWV_TRACE_BEGIN(tr);
+        WWV_PERF_BEGIN(fd->perf, t0);
+        fft_processor_process(fd->fft, frame_i, frame_q);
+        fd->fft_count++;
+        fd->current_energy = bcd_freq_calculate_bucket_energy(fd);
+        WWV_PERF_END(fd->perf, WWV_PERF_BCD_FREQ_FFT, t0);
+        WWV_TRACE_END("detector", "bcd_freq_idle_frame", tr, fd->frame_count * (double)fd->frame_ms);
+    }
+
+    bcd_freq_idle_state_machine(fd);
+    fd->frame_count++;
+}
+
+/* Idle: does the frame in progress run the FFT? */
+static inline bool idle_computes(const bcd_freq_detector_t *fd) {
+    return (fd->frame_count % BCD_FREQ_IDLE_DECIM) == 0;
+}
+
+/**
+ * Sliding mode: decimate, then one SDFT update and state machine step per
+ * decimated sample
+ * @param count At most BCD_FREQ_FFT_SIZE samples
+ * @return Pulses started within these samples
+ */
+static int process_sliding(bcd_freq_detector_t *fd, const float *in_i, const float *in_q,
+                           size_t count) {
+    int detections = 0;
+
+    WWV_PERF_BEGIN(fd->perf, t0);
+    size_t hops = polyphase_resampler_process(fd->decim, in_i, in_q, count, fd->dec_i, fd->dec_q);
+    WWV_PERF_END(fd->perf, WWV_PERF_BCD_FREQ_FFT, t0);
+
+    WWV_PERF_BEGIN(fd->perf, t1);
+    for (size_t k = 0; k < hops; k++) {
+        sliding_dft_push(fd->sdft, fd->dec_i[k], fd->dec_q[k]);
+        fd->current_energy = bcd_freq_calculate_bucket_energy(fd);
+        bcd_freq_run_state_machine(fd);
+        fd->frame_count++;
+        if (fd->pulse.state == PULSE_ACTIVE && fd->pulse.duration == 1) detections++;
+    }
+    WWV_PERF_END(fd->perf, WWV_PERF_BCD_FREQ_STATE, t1);
+
+    return detections;
+}
+
 bool bcd_freq_detector_process_sample(bcd_freq_detector_t *fd,
                                       float i_sample,
                                       float q_sample) {
     if (!fd || !fd->detection_enabled) return false;
 
+    if (fd->sliding) {
+        fd->i_buffer[fd->buffer_idx] = i_sample;
+        fd->q_buffer[fd->buffer_idx] = q_sample;
+        if (++fd->buffer_idx < BCD_FREQ_SLIDING_DECIM) return false;
+        fd->buffer_idx = 0;
+        return process_sliding(fd, fd->i_buffer, fd->q_buffer, BCD_FREQ_SLIDING_DECIM) > 0;
+    }
+
+    if (fd->idle) {
+        bool compute = idle_computes(fd);
+        if (compute) {
+            fd->i_buffer[fd->buffer_idx] = i_sample;
+            fd->q_buffer[fd->buffer_idx] = q_sample;
+        }
+        if (++fd->buffer_idx == BCD_FREQ_FFT_SIZE) {
+            idle_frame(fd, compute ? fd->i_buffer : NULL, fd->q_buffer);
+        }
+        return false;
+    }
+
     /* Buffer sample for FFT */
     fd->i_buffer[fd->buffer_idx] = i_sample;
     fd->q_buffer[fd->buffer_idx] = q_sample;
@@ -128,21 +301,76 @@ bool bcd_freq_detector_process_sample(bcd_freq_detector_t *fd,
         return false;
     }
 
-    /* Buffer full - run FFT */
-    fd->buffer_idx = 0;
+    return process_frame(fd, fd->i_buffer, fd->q_buffer);
+}
 
-    /* Run FFT */
-    fft_processor_process(fd->fft, fd->i_buffer, fd->q_buffer);
+int bcd_freq_detector_process_block(bcd_freq_detector_t *fd,
+                                    const float *i_samples,
+                                    const float *q_samples,
+                                    size_t count) {
+    if (!fd || !fd->detection_enabled || !i_samples || !q_samples) return 0;
 
-    /* Extract bucket energy */
-    fd->current_energy = bcd_freq_calculate_bucket_energy(fd);
+    int detections = 0;
+    size_t pos = 0;
 
-    /* Run detection state machine */
-    bcd_freq_run_state_machine(fd);
+    if (fd->sliding) {
+        /* Samples left by process_sample() go first */
+        if (fd->buffer_idx > 0) {
+            detections += process_sliding(fd, fd->i_buffer, fd->q_buffer, (size_t)fd->buffer_idx);
+            fd->buffer_idx = 0;
+        }
+        while (pos < count) {
+            size_t chunk = count - pos;
+            if (chunk > BCD_FREQ_FFT_SIZE) chunk = BCD_FREQ_FFT_SIZE;
+            detections += process_sliding(fd, &i_samples[pos], &q_samples[pos], chunk);
+            pos += chunk;
+        }
+        return detections;
+    }
 
-    fd->frame_count++;
+    while (pos < count) {
+        size_t chunk = (size_t)(BCD_FREQ_FFT_SIZE - fd->buffer_idx);
+        if (chunk > count - pos) chunk = count - pos;
+
+        /* Idle: only the computed frames are buffered */
+        if (fd->idle) {
+            bool compute = idle_computes(fd);
+            if (compute && fd->buffer_idx == 0 && chunk == BCD_FREQ_FFT_SIZE) {
+                idle_frame(fd, &i_samples[pos], &q_samples[pos]);
+                pos += chunk;
+                continue;
+            }
+            if (compute) {
+                memcpy(&fd->i_buffer[fd->buffer_idx], &i_samples[pos], chunk * sizeof(float));
+                memcpy(&fd->q_buffer[fd->buffer_idx], &q_samples[pos], chunk * sizeof(float));
+            }
+            fd->buffer_idx += (int)chunk;
+            pos += chunk;
+            if (fd->buffer_idx >= BCD_FREQ_FFT_SIZE) {
+                idle_frame(fd, compute ? fd->i_buffer : NULL, fd->q_buffer);
+            }
+            continue;
+        }
+
+        /* A whole frame inside the block goes to the FFT in place */
+        if (fd->buffer_idx == 0 && chunk == BCD_FREQ_FFT_SIZE) {
+            if (process_frame(fd, &i_samples[pos], &q_samples[pos])) detections++;
+            pos += chunk;
+            continue;
+        }
 
-    return (fd->state == STATE_IN_PULSE && fd->pulse_duration_frames == 1);
+        memcpy(&fd->i_buffer[fd->buffer_idx], &i_samples[pos], chunk * sizeof(float));
+        memcpy(&fd->q_buffer[fd->buffer_idx], &q_samples[pos], chunk * sizeof(float));
+        fd->buffer_idx += (int)chunk;
+        pos += chunk;
+
+        if (fd->buffer_idx >= BCD_FREQ_FFT_SIZE &&
+            process_frame(fd, fd->i_buffer, fd->q_buffer)) {
+            detections++;
+        }
+    }
+
+    return detections;
 }
 
 void bcd_freq_detector_set_enabled(bcd_freq_detector_t *fd, bool enabled) {
@@ -153,6 +381,41 @@ bool bcd_freq_detector_get_enabled(bcd_freq_detector_t *fd) {
     return fd ? fd->detection_enabled : false;
 }
 
+void bcd_freq_detector_set_idle(bcd_freq_detector_t *fd, bool idle) {
+    if (!fd || fd->sliding || fd->idle == idle) return;
+    fd->idle = idle;
+
+    if (idle) {
+        /* A pulse in flight is dropped, not reported */
+        pulse_fsm_reset(&fd->pulse);
+        return;
+    }
+
+    /* Resume: a frame in progress may not have been buffered, and the
+     * window holds repeated energies until it has turned over once */
+    uint64_t window = (uint64_t)(BCD_FREQ_WINDOW_MS / fd->frame_ms + 0.5f);
+    fd->resume_frame = fd->frame_count + 1 + window;
+}
+
+bool bcd_freq_detector_skip(bcd_freq_detector_t *fd, uint64_t samples) {
+    if (!fd || fd->buffer_idx != 0 || samples % (uint64_t)fd->frame_samples != 0) return false;
+
+    fd->frame_count += samples / (uint64_t)fd->frame_samples;
+    pulse_fsm_reset(&fd->pulse);
+    if (fd->sliding) {
+        polyphase_resampler_reset(fd->decim);
+        sliding_dft_reset(fd->sdft);
+    }
+
+    uint64_t window = (uint64_t)(BCD_FREQ_WINDOW_MS / fd->frame_ms + 0.5f);
+    fd->resume_frame = fd->frame_count + window;
+    return true;
+}
+
+bool bcd_freq_detector_get_idle(bcd_freq_detector_t *fd) {
+    return fd ? fd->idle : false;
+}
+
 float bcd_freq_detector_get_accumulated_energy(bcd_freq_detector_t *fd) {
     return fd ? fd->accumulated_energy : 0.0f;
 }
@@ -173,16 +436,24 @@ int bcd_freq_detector_get_pulse_count(bcd_freq_detector_t *fd) {
     return fd ? fd->pulses_detected : 0;
 }
 
+uint64_t bcd_freq_detector_get_fft_count(bcd_freq_detector_t *fd) {
+    return fd ? fd->fft_count : 0;
+}
+
 void bcd_freq_detector_print_stats(bcd_freq_detector_t *fd) {
     if (!fd) return;
 
     float frame_duration_ms = bcd_freq_detector_get_frame_duration_ms();
     int window_frames = (int)(BCD_FREQ_WINDOW_MS / frame_duration_ms);
-    float elapsed = fd->frame_count * frame_duration_ms / 1000.0f;
+    float elapsed = fd->frame_count * fd->frame_ms / 1000.0f;
 
     printf("\n=== BCD FREQ DETECTOR STATS ===\n");
     printf("FFT: %d (%.2fms), Window: %d frames (%.0fms)\n",
            BCD_FREQ_FFT_SIZE, frame_duration_ms, window_frames, BCD_FREQ_WINDOW_MS);
+    if (fd->sliding) {
+        printf("Sliding DFT: %d at %.1f Hz, hop %.2fms\n",
+               BCD_FREQ_SLIDING_SIZE, BCD_SLIDING_RATE, fd->frame_ms);
+    }
     printf("Target: %d Hz ±%d Hz\n", BCD_FREQ_TARGET_FREQ_HZ, BCD_FREQ_BANDWIDTH_HZ);
     printf("Elapsed: %.1fs  Detected: %d  Rejected: %d\n",
            elapsed, fd->pulses_detected, fd->pulses_rejected);
@@ -194,3 +465,46 @@ void bcd_freq_detector_print_stats(bcd_freq_detector_t *fd) {
 float bcd_freq_detector_get_frame_duration_ms(void) {
     return (float)BCD_FREQ_FFT_SIZE * 1000.0f / BCD_FREQ_SAMPLE_RATE;
 }
+
+float bcd_freq_detector_get_hop_ms(bcd_freq_detector_t *fd) {
+    return fd ? fd->frame_ms : 0.0f;
+}
+
+/*============================================================================
+ * Warm Start
+ *============================================================================*/
+
+#define BCD_FREQ_STATE_VERSION  1
+
+typedef struct {
+    float baseline_energy;
+    float threshold;
+} bcd_freq_state_t;
+
+_Static_assert(sizeof(bcd_freq_state_t) == 8, "bcd_freq state layout");
+
+bool bcd_freq_detector_save_state(bcd_freq_detector_t *fd, wwv_state_writer_t *w) {
+    if (!fd || !w || !fd->warmup_complete) return false;
+
+    bcd_freq_state_t st = {
+        .baseline_energy = fd->baseline_energy,
+        .threshold = fd->threshold
+    };
+    return wwv_state_put(w, WWV_STATE_BCD_FREQ_DETECTOR, BCD_FREQ_STATE_VERSION, &st, sizeof(st));
+}
+
+bool bcd_freq_detector_restore_state(bcd_freq_detector_t *fd, const wwv_state_reader_t *r) {
+    if (!fd || !r || r->elapsed_ms > WWV_STATE_LEVELS_MAX_AGE_MS) return false;
+
+    bcd_freq_state_t st;
+    if (!wwv_state_get(r, WWV_STATE_BCD_FREQ_DETECTOR, BCD_FREQ_STATE_VERSION, &st, sizeof(st)) ||
+        !(st.baseline_energy > 0.0f)) {
+        return false;
+    }
+
+    fd->baseline_energy = st.baseline_energy;
+    fd->threshold = st.threshold;
+    fd->warmup_complete = true;
+    printf("[BCD_FREQ] Warm start: baseline=%.4f thresh=%.4f\n", fd->baseline_energy, fd->threshold);
+    return true;
+}
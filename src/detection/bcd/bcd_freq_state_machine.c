@@ -6,17 +6,19 @@
  * from API management.
  *
  * Contains:
- *   - 3-state FSM (IDLE → IN_PULSE → COOLDOWN)
+ *   - 3-state FSM (IDLE → ACTIVE → COOLDOWN, pulse_fsm_internal.h)
  *   - Sliding window accumulator
  *   - Self-tracking baseline
  *   - CSV logging and telemetry
  *   - Event callbacks
  *
  * Hot path: bcd_freq_run_state_machine() called once per FFT frame
+ * (once per 0.64 ms hop in sliding mode)
  */
 
 #include "bcd_internal.h"
 #include "telemetry.h"
+#include "telemetry_wire.h"
 #include "version.h"
 #include <math.h>
 #include <string.h>
@@ -25,168 +27,181 @@
  * Internal Configuration
  *============================================================================*/
 
-#define FRAME_DURATION_MS   ((float)BCD_FREQ_FFT_SIZE * 1000.0f / BCD_FREQ_SAMPLE_RATE)
-#define WINDOW_FRAMES       ((int)(BCD_FREQ_WINDOW_MS / FRAME_DURATION_MS))
-
 /* Detection timing */
 #define BCD_FREQ_COOLDOWN_MS        500.0f
 #define BCD_FREQ_MAX_DURATION_MS    2000.0f
 
-/* Warmup */
+/* Warmup (in FFT frames) */
 #define BCD_FREQ_WARMUP_FRAMES      50
 #define BCD_FREQ_WARMUP_ADAPT_RATE  0.02f
 #define BCD_FREQ_MIN_STARTUP_MS     5000.0f
 
-#define MS_TO_FRAMES(ms)    ((int)((ms) / FRAME_DURATION_MS + 0.5f))
+/*
+ * Frames are FFT frames, or hops of 1/frame_hops of one when sliding.
+ * Counts and rates given per FFT frame are scaled by frame_hops so both
+ * modes keep the same time constants, and each hop adds 1/frame_hops of
+ * its energy so the window sum keeps the FFT mode's scale.
+ */
+static inline int ms_to_frames(const bcd_freq_detector_t *fd, float ms) {
+    return (int)(ms / fd->frame_ms + 0.5f);
+}
+
+/* Absolute frame times from the 64-bit sample clock */
+static inline wwv_sample_t frame_to_sample(const bcd_freq_detector_t *fd, uint64_t frame) {
+    wwv_sample_t end = (wwv_sample_t)frame * (wwv_sample_t)fd->frame_samples;
+    return (end > (wwv_sample_t)fd->frame_lag) ? end - (wwv_sample_t)fd->frame_lag : 0;
+}
+
+static inline double frame_to_ms(const bcd_freq_detector_t *fd, uint64_t frame) {
+    return wwv_samples_to_ms(frame_to_sample(fd, frame), BCD_FREQ_SAMPLE_RATE);
+}
 
 /*============================================================================
  * Internal Functions
  *============================================================================*/
 
 float bcd_freq_calculate_bucket_energy(bcd_freq_detector_t *fd) {
-    return fft_processor_get_bucket_energy(fd->fft, BCD_FREQ_TARGET_FREQ_HZ, BCD_FREQ_BANDWIDTH_HZ);
+    if (fd->sdft) return sliding_dft_get_band(fd->sdft, fd->fft_band);
+    return fft_processor_get_band(fd->fft, fd->fft_band);
 }
 
 void bcd_freq_update_accumulator(bcd_freq_detector_t *fd, float energy) {
-    if (fd->history_count >= WINDOW_FRAMES) {
-        fd->accumulated_energy -= fd->energy_history[fd->history_idx];
-    }
-
-    fd->energy_history[fd->history_idx] = energy;
-    fd->accumulated_energy += energy;
+    sliding_sum_push(fd->energy_sum, energy / (float)fd->frame_hops);
+    fd->accumulated_energy = sliding_sum_get(fd->energy_sum, fd->energy_window);
+}
 
-    fd->history_idx = (fd->history_idx + 1) % WINDOW_FRAMES;
-    if (fd->history_count < WINDOW_FRAMES) {
-        fd->history_count++;
-    }
+void bcd_freq_init_state_machine(bcd_freq_detector_t *fd) {
+    pulse_fsm_reset(&fd->pulse);
+    pulse_fsm_params_init(&fd->pulse_params, fd->frame_ms, MIN_LOW_FRAMES * fd->frame_hops,
+                          BCD_FREQ_MAX_DURATION_MS, BCD_FREQ_COOLDOWN_MS);
+    pulse_fsm_set_class(&fd->pulse_params, 0, BCD_FREQ_PULSE_MIN_MS, BCD_FREQ_PULSE_MAX_MS);
 }
 
-void bcd_freq_run_state_machine(bcd_freq_detector_t *fd) {
-    float energy = fd->current_energy;
+/**
+ * Baseline tracking ahead of the pulse state machine
+ * @param quiet No pulse on this frame, so the baseline may follow it
+ * @return true once pulses may be detected on this frame
+ */
+static bool track_baseline(bcd_freq_detector_t *fd, bool quiet) {
     uint64_t frame = fd->frame_count;
-
-    bcd_freq_update_accumulator(fd, energy);
+    float hop_scale = 1.0f / (float)fd->frame_hops;
 
     /* Warmup phase - fast adaptation to learn baseline */
     if (!fd->warmup_complete) {
-        fd->baseline_energy += BCD_FREQ_WARMUP_ADAPT_RATE * (fd->accumulated_energy - fd->baseline_energy);
+        fd->baseline_energy += BCD_FREQ_WARMUP_ADAPT_RATE * hop_scale * (fd->accumulated_energy - fd->baseline_energy);
         fd->threshold = fd->baseline_energy * BCD_FREQ_THRESHOLD_MULT;
 
-        if (frame >= fd->start_frame + BCD_FREQ_WARMUP_FRAMES) {
+        if (frame >= fd->start_frame + (uint64_t)BCD_FREQ_WARMUP_FRAMES * fd->frame_hops) {
             fd->warmup_complete = true;
             printf("[BCD_FREQ] Warmup complete. Baseline=%.4f, Thresh=%.4f, Accum=%.4f\n",
                    fd->baseline_energy, fd->threshold, fd->accumulated_energy);
         }
-        return;
+        return false;
     }
 
+    /* Back from idle - the window still holds idle frames */
+    if (frame < fd->resume_frame) return false;
+
     /* No pulses in first few seconds - baseline still stabilizing */
-    float timestamp_ms = fd->frame_count * FRAME_DURATION_MS;
+    double timestamp_ms = frame_to_ms(fd, fd->frame_count);
     if (timestamp_ms < BCD_FREQ_MIN_STARTUP_MS) {
-        fd->baseline_energy += BCD_FREQ_NOISE_ADAPT_RATE * (fd->accumulated_energy - fd->baseline_energy);
+        fd->baseline_energy += BCD_FREQ_NOISE_ADAPT_RATE * hop_scale * (fd->accumulated_energy - fd->baseline_energy);
         fd->threshold = fd->baseline_energy * BCD_FREQ_THRESHOLD_MULT;
-        return;
+        return false;
     }
 
     /* Self-track baseline during IDLE */
-    if (fd->state == STATE_IDLE) {
-        fd->baseline_energy += BCD_FREQ_NOISE_ADAPT_RATE * (fd->accumulated_energy - fd->baseline_energy);
+    if (quiet) {
+        fd->baseline_energy += BCD_FREQ_NOISE_ADAPT_RATE * hop_scale * (fd->accumulated_energy - fd->baseline_energy);
         if (fd->baseline_energy < 0.0001f) fd->baseline_energy = 0.0001f;
         fd->threshold = fd->baseline_energy * BCD_FREQ_THRESHOLD_MULT;
     }
+    return true;
+}
 
-    /* State machine */
-    switch (fd->state) {
-        case STATE_IDLE:
-            if (fd->accumulated_energy > fd->threshold) {
-                fd->state = STATE_IN_PULSE;
-                fd->pulse_start_frame = frame;
-                fd->pulse_peak_energy = fd->accumulated_energy;
-                fd->pulse_duration_frames = 1;
-                fd->consecutive_low_frames = 0;
-            }
-            break;
-
-        case STATE_IN_PULSE:
-            fd->pulse_duration_frames++;
-            if (fd->accumulated_energy > fd->pulse_peak_energy) {
-                fd->pulse_peak_energy = fd->accumulated_energy;
-            }
+/* No state machine to tell pulses apart, so frames over threshold are kept out */
+void bcd_freq_idle_state_machine(bcd_freq_detector_t *fd) {
+    bcd_freq_update_accumulator(fd, fd->current_energy);
+    track_baseline(fd, fd->accumulated_energy <= fd->threshold);
+}
 
-            /* Check for timeout or signal drop */
-            float duration_ms = fd->pulse_duration_frames * FRAME_DURATION_MS;
-            bool timed_out = (duration_ms > BCD_FREQ_MAX_DURATION_MS);
+void bcd_freq_run_state_machine(bcd_freq_detector_t *fd) {
+    uint64_t frame = fd->frame_count;
 
-            /* Phase 9: Require consecutive low frames before ending pulse */
-            if (fd->accumulated_energy < fd->threshold) {
-                fd->consecutive_low_frames++;
+    bcd_freq_update_accumulator(fd, fd->current_energy);
+    if (!track_baseline(fd, fd->pulse.state == PULSE_IDLE)) return;
+
+    /* State machine (Phase 9: the pulse ends after MIN_LOW_FRAMES consecutive
+     * low FFT frames, or on timeout) */
+    int events = pulse_fsm_step(&fd->pulse, &fd->pulse_params, fd->accumulated_energy,
+                                fd->threshold, fd->threshold, frame);
+    if (events & PULSE_EV_STOP) {
+        float duration_ms = pulse_fsm_duration_ms(&fd->pulse, &fd->pulse_params);
+        bool timed_out = (events & PULSE_EV_TIMEOUT) != 0;
+
+        double start_timestamp_ms = frame_to_ms(fd, fd->pulse.start_frame);
+
+        if (pulse_fsm_classify(&fd->pulse, &fd->pulse_params) == 0) {
+            /* Valid pulse! */
+            fd->pulses_detected++;
+
+            float snr_db = 10.0f * log10f(fd->pulse.peak / fd->baseline_energy);
+
+            printf("[BCD_FREQ] Pulse #%d at %.1fms  dur=%.0fms  accum=%.4f  SNR=%.1fdB\n",
+                   fd->pulses_detected, start_timestamp_ms, duration_ms,
+                   fd->pulse.peak, snr_db);
+
+            /* CSV logging and telemetry */
+            char time_str[16];
+            bcd_get_wall_time_str(fd->start_time, start_timestamp_ms, time_str, sizeof(time_str));
+
+            wwv_csv_log_row_at(fd->csv_log, bcd_get_wall_time(fd->start_time, start_timestamp_ms),
+                               "%.1f,%d,%.6f,%.0f,%.6f,%.1f\n",
+                               start_timestamp_ms, fd->pulses_detected,
+                               fd->pulse.peak, duration_ms,
+                               fd->baseline_energy, snr_db);
+
+            /* UDP telemetry */
+            if (telem_ctx_binary_active(fd->telem, TELEM_BCDS)) {
+                telem_rec_bcd_pulse_t rec = {
+                    .number = (uint32_t)fd->pulses_detected,
+                    .path = 1,
+                    .energy = fd->pulse.peak,
+                    .duration_ms = duration_ms,
+                    .noise_floor = fd->baseline_energy,
+                    .snr_db = snr_db
+                };
+                telem_ctx_send_record(fd->telem, TELEM_BCDS, TELEM_REC_BCD_PULSE,
+                                  (uint32_t)bcd_get_wall_time(fd->start_time, start_timestamp_ms),
+                                  telem_ms_to_us(start_timestamp_ms), &rec, sizeof(rec));
             } else {
-                fd->consecutive_low_frames = 0;  /* Reset if signal returns */
+                telem_ctx_sendf(fd->telem, TELEM_BCDS, "FREQ,%s,%.1f,%d,%.6f,%.0f,%.6f,%.1f",
+                            time_str, start_timestamp_ms, fd->pulses_detected,
+                            fd->pulse.peak, duration_ms,
+                            fd->baseline_energy, snr_db);
             }
 
-            if ((fd->consecutive_low_frames >= MIN_LOW_FRAMES) || timed_out) {
-                float start_timestamp_ms = fd->pulse_start_frame * FRAME_DURATION_MS;
-
-                if (duration_ms >= BCD_FREQ_PULSE_MIN_MS &&
-                    duration_ms <= BCD_FREQ_PULSE_MAX_MS) {
-                    /* Valid pulse! */
-                    fd->pulses_detected++;
-
-                    float snr_db = 10.0f * log10f(fd->pulse_peak_energy / fd->baseline_energy);
-
-                    printf("[BCD_FREQ] Pulse #%d at %.1fms  dur=%.0fms  accum=%.4f  SNR=%.1fdB\n",
-                           fd->pulses_detected, start_timestamp_ms, duration_ms,
-                           fd->pulse_peak_energy, snr_db);
-
-                    /* CSV logging and telemetry */
-                    char time_str[16];
-                    bcd_get_wall_time_str(fd->start_time, start_timestamp_ms, time_str, sizeof(time_str));
-
-                    if (fd->csv_file) {
-                        fprintf(fd->csv_file, "%s,%.1f,%d,%.6f,%.0f,%.6f,%.1f\n",
-                                time_str, start_timestamp_ms, fd->pulses_detected,
-                                fd->pulse_peak_energy, duration_ms,
-                                fd->baseline_energy, snr_db);
-                        fflush(fd->csv_file);
-                    }
-
-                    /* UDP telemetry */
-                    telem_sendf(TELEM_BCDS, "FREQ,%s,%.1f,%d,%.6f,%.0f,%.6f,%.1f",
-                                time_str, start_timestamp_ms, fd->pulses_detected,
-                                fd->pulse_peak_energy, duration_ms,
-                                fd->baseline_energy, snr_db);
-
-                    fd->last_pulse_frame = fd->pulse_start_frame;
-
-                    /* Callback */
-                    if (fd->callback) {
-                        bcd_freq_event_t event = {
-                            .timestamp_ms = start_timestamp_ms,
-                            .duration_ms = duration_ms,
-                            .accumulated_energy = fd->pulse_peak_energy,
-                            .baseline_energy = fd->baseline_energy,
-                            .snr_db = snr_db
-                        };
-                        fd->callback(&event, fd->callback_user_data);
-                    }
-                } else if (timed_out) {
-                    printf("[BCD_FREQ] Timeout after %.0fms - resetting baseline\n", duration_ms);
-                    fd->baseline_energy = fd->accumulated_energy;
-                    fd->threshold = fd->baseline_energy * BCD_FREQ_THRESHOLD_MULT;
-                    fd->pulses_rejected++;
-                } else {
-                    fd->pulses_rejected++;
-                }
-
-                fd->state = STATE_COOLDOWN;
-                fd->cooldown_frames = MS_TO_FRAMES(BCD_FREQ_COOLDOWN_MS);
+            fd->last_pulse_frame = fd->pulse.start_frame;
+
+            /* Callback */
+            if (fd->callback) {
+                bcd_freq_event_t event = {
+                    .timestamp_ms = start_timestamp_ms,
+                    .sample_index = frame_to_sample(fd, fd->pulse.start_frame),
+                    .duration_ms = duration_ms,
+                    .accumulated_energy = fd->pulse.peak,
+                    .baseline_energy = fd->baseline_energy,
+                    .snr_db = snr_db
+                };
+                fd->callback(&event, fd->callback_user_data);
             }
-            break;
-
-        case STATE_COOLDOWN:
-            if (--fd->cooldown_frames <= 0) {
-                fd->state = STATE_IDLE;
-            }
-            break;
+        } else if (timed_out) {
+            printf("[BCD_FREQ] Timeout after %.0fms - resetting baseline\n", duration_ms);
+            fd->baseline_energy = fd->accumulated_energy;
+            fd->threshold = fd->baseline_energy * BCD_FREQ_THRESHOLD_MULT;
+            fd->pulses_rejected++;
+        } else {
+            fd->pulses_rejected++;
+        }
     }
 }
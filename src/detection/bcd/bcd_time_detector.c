@@ -20,6 +20,9 @@
 #include "telemetry.h"
 #include "fft_processor.h"
 #include "version.h"
+#include "wwv_thread.h"
+#include "wwv_arena.h"
+#include "wwv_trace.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
@@ -30,18 +33,19 @@
  *============================================================================*/
 
 bcd_time_detector_t *bcd_time_detector_create(const char *csv_path) {
-    bcd_time_detector_t *td = (bcd_time_detector_t *)calloc(1, sizeof(bcd_time_detector_t));
+    bcd_time_detector_t *td = (bcd_time_detector_t *)wwv_aligned_calloc(WWV_CACHE_LINE, sizeof(bcd_time_detector_t));
     if (!td) return NULL;
 
     /* Allocate FFT */
     td->fft = fft_processor_create(BCD_TIME_FFT_SIZE, BCD_TIME_SAMPLE_RATE);
     if (!td->fft) {
-        free(td);
+        wwv_aligned_free(td);
         return NULL;
     }
+    td->fft_band = fft_processor_add_band(td->fft, BCD_TIME_TARGET_FREQ_HZ, BCD_TIME_BANDWIDTH_HZ, FFT_BAND_MAGNITUDE);
 
-    td->i_buffer = (float *)malloc(BCD_TIME_FFT_SIZE * sizeof(float));
-    td->q_buffer = (float *)malloc(BCD_TIME_FFT_SIZE * sizeof(float));
+    td->i_buffer = (float *)wwv_malloc(BCD_TIME_FFT_SIZE * sizeof(float));
+    td->q_buffer = (float *)wwv_malloc(BCD_TIME_FFT_SIZE * sizeof(float));
 
     if (!td->i_buffer || !td->q_buffer) {
         bcd_time_detector_destroy(td);
@@ -54,7 +58,7 @@ bcd_time_detector_t *bcd_time_detector_create(const char *csv_path) {
     td->buffer_idx = 0;
 
     /* Initialize state */
-    td->state = STATE_IDLE;
+    bcd_time_init_state_machine(td);
     td->noise_floor = 0.0001f;
     td->threshold_high = td->noise_floor * BCD_TIME_THRESHOLD_MULT;
     td->threshold_low = td->threshold_high * BCD_TIME_HYSTERESIS_RATIO;
@@ -64,19 +68,18 @@ bcd_time_detector_t *bcd_time_detector_create(const char *csv_path) {
 
     /* Open CSV file */
     if (csv_path) {
-        td->csv_file = fopen(csv_path, "w");
-        if (td->csv_file) {
+        td->csv_log = wwv_csv_log_open(csv_path);
+        if (td->csv_log) {
             char time_str[64];
             time_t now = time(NULL);
             float frame_duration = bcd_time_detector_get_frame_duration_ms();
-            strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", localtime(&now));
-            fprintf(td->csv_file, "# Phoenix SDR BCD Time Detector Log v%s\n", PHOENIX_VERSION_FULL);
-            fprintf(td->csv_file, "# Started: %s\n", time_str);
-            fprintf(td->csv_file, "# FFT: %d (%.2fms), Target: %dHz ±%dHz\n",
-                    BCD_TIME_FFT_SIZE, frame_duration,
-                    BCD_TIME_TARGET_FREQ_HZ, BCD_TIME_BANDWIDTH_HZ);
-            fprintf(td->csv_file, "time,timestamp_ms,pulse_num,peak_energy,duration_ms,noise_floor,snr_db\n");
-            fflush(td->csv_file);
+            strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", wwv_localtime(&now));
+            wwv_csv_log_header(td->csv_log, "# Phoenix SDR BCD Time Detector Log v%s\n", PHOENIX_VERSION_FULL);
+            wwv_csv_log_header(td->csv_log, "# Started: %s\n", time_str);
+            wwv_csv_log_header(td->csv_log, "# FFT: %d (%.2fms), Target: %dHz ±%dHz\n",
+                               BCD_TIME_FFT_SIZE, frame_duration,
+                               BCD_TIME_TARGET_FREQ_HZ, BCD_TIME_BANDWIDTH_HZ);
+            wwv_csv_log_header(td->csv_log, "time,timestamp_ms,pulse_num,peak_energy,duration_ms,noise_floor,snr_db\n");
         }
     }
 
@@ -91,11 +94,12 @@ bcd_time_detector_t *bcd_time_detector_create(const char *csv_path) {
 void bcd_time_detector_destroy(bcd_time_detector_t *td) {
     if (!td) return;
 
-    if (td->csv_file) fclose(td->csv_file);
+    wwv_csv_log_close(td->csv_log);
     if (td->fft) fft_processor_destroy(td->fft);
-    free(td->i_buffer);
-    free(td->q_buffer);
-    free(td);
+    goertzel_bank_destroy(td->goertzel);
+    wwv_free(td->i_buffer);
+    wwv_free(td->q_buffer);
+    wwv_aligned_free(td);
 }
 
 void bcd_time_detector_set_callback(bcd_time_detector_t *td,
@@ -106,11 +110,58 @@ void bcd_time_detector_set_callback(bcd_time_detector_t *td,
     td->callback_user_data = user_data;
 }
 
+void bcd_time_detector_set_telemetry(bcd_time_detector_t *td, telem_ctx_t *ctx) {
+    if (!td) return;
+    td->telem = ctx;
+}
+
+void bcd_time_detector_set_perf(bcd_time_detector_t *td, wwv_perf_t *perf) {
+    if (!td) return;
+    td->perf = perf;
+    wwv_csv_log_set_perf(td->csv_log, perf);
+}
+
+/**
+ * FFT frame is full - extract energy and run the state machine
+ * @param frame_i, frame_q BCD_TIME_FFT_SIZE samples (FFT mode only, else NULL)
+ * @return true if a pulse started on this frame
+ */
+static bool process_frame(bcd_time_detector_t *td, const float *frame_i, const float *frame_q) {
+    td->buffer_idx = 0;
+    WWV_TRACE_BEGIN(tr);
+
+    /* Run FFT (Goertzel mode has already accumulated the bins) */
+    WWV_PERF_BEGIN(td->perf, t0);
+    if (td->spectral_mode == SPECTRAL_MODE_FFT) {
+        fft_processor_process(td->fft, frame_i, frame_q);
+    }
+
+    /* Extract bucket energy */
+    td->current_energy = bcd_time_calculate_bucket_energy(td);
+    WWV_PERF_END(td->perf, WWV_PERF_BCD_TIME_FFT, t0);
+
+    /* Run detection state machine */
+    WWV_PERF_BEGIN(td->perf, t1);
+    bcd_time_run_state_machine(td);
+    WWV_PERF_END(td->perf, WWV_PERF_BCD_TIME_STATE, t1);
+    WWV_TRACE_END("detector", "bcd_time_frame", tr,
+                  wwv_samples_to_ms((wwv_sample_t)td->frame_count * BCD_TIME_FFT_SIZE,
+                                    BCD_TIME_SAMPLE_RATE));
+
+    td->frame_count++;
+
+    return (td->pulse.state == PULSE_ACTIVE && td->pulse.duration == 1);
+}
+
 bool bcd_time_detector_process_sample(bcd_time_detector_t *td,
                                       float i_sample,
                                       float q_sample) {
     if (!td || !td->detection_enabled) return false;
 
+    if (td->spectral_mode == SPECTRAL_MODE_GOERTZEL) {
+        return goertzel_bank_process(td->goertzel, i_sample, q_sample) && process_frame(td, NULL, NULL);
+    }
+
     /* Buffer sample for FFT */
     td->i_buffer[td->buffer_idx] = i_sample;
     td->q_buffer[td->buffer_idx] = q_sample;
@@ -121,21 +172,81 @@ bool bcd_time_detector_process_sample(bcd_time_detector_t *td,
         return false;
     }
 
-    /* Buffer full - run FFT */
-    td->buffer_idx = 0;
+    return process_frame(td, td->i_buffer, td->q_buffer);
+}
 
-    /* Run FFT */
-    fft_processor_process(td->fft, td->i_buffer, td->q_buffer);
+int bcd_time_detector_process_block(bcd_time_detector_t *td,
+                                    const float *i_samples,
+                                    const float *q_samples,
+                                    size_t count) {
+    if (!td || !td->detection_enabled || !i_samples || !q_samples) return 0;
+
+    int detections = 0;
+    size_t pos = 0;
+
+    if (td->spectral_mode == SPECTRAL_MODE_GOERTZEL) {
+        while (pos < count) {
+            WWV_PERF_BEGIN(td->perf, t0);
+            pos += goertzel_bank_process_block(td->goertzel, &i_samples[pos], &q_samples[pos], count - pos);
+            WWV_PERF_END(td->perf, WWV_PERF_BCD_TIME_FFT, t0);
+            if (goertzel_bank_frame_ready(td->goertzel) && process_frame(td, NULL, NULL)) {
+                detections++;
+            }
+        }
+        return detections;
+    }
 
-    /* Extract bucket energy */
-    td->current_energy = bcd_time_calculate_bucket_energy(td);
+    while (pos < count) {
+        size_t chunk = (size_t)(BCD_TIME_FFT_SIZE - td->buffer_idx);
+        if (chunk > count - pos) chunk = count - pos;
 
-    /* Run detection state machine */
-    bcd_time_run_state_machine(td);
+        /* A whole frame inside the block goes to the FFT in place */
+        if (td->buffer_idx == 0 && chunk == BCD_TIME_FFT_SIZE) {
+            if (process_frame(td, &i_samples[pos], &q_samples[pos])) detections++;
+            pos += chunk;
+            continue;
+        }
 
-    td->frame_count++;
+        memcpy(&td->i_buffer[td->buffer_idx], &i_samples[pos], chunk * sizeof(float));
+        memcpy(&td->q_buffer[td->buffer_idx], &q_samples[pos], chunk * sizeof(float));
+        td->buffer_idx += (int)chunk;
+        pos += chunk;
+
+        if (td->buffer_idx >= BCD_TIME_FFT_SIZE &&
+            process_frame(td, td->i_buffer, td->q_buffer)) {
+            detections++;
+        }
+    }
+
+    return detections;
+}
+
+bool bcd_time_detector_set_spectral_mode(bcd_time_detector_t *td, spectral_mode_t mode) {
+    if (!td) return false;
+
+    if (mode == SPECTRAL_MODE_GOERTZEL && !td->goertzel) {
+        td->goertzel = goertzel_bank_create(BCD_TIME_FFT_SIZE, BCD_TIME_SAMPLE_RATE, FFT_WINDOW_HANN);
+        if (!td->goertzel) return false;
+        td->goertzel_band = goertzel_bank_add_band(td->goertzel, BCD_TIME_TARGET_FREQ_HZ, BCD_TIME_BANDWIDTH_HZ);
+    }
+
+    td->spectral_mode = mode;
+    td->buffer_idx = 0;
+    goertzel_bank_reset(td->goertzel);
+    return true;
+}
+
+spectral_mode_t bcd_time_detector_get_spectral_mode(bcd_time_detector_t *td) {
+    return td ? td->spectral_mode : SPECTRAL_MODE_FFT;
+}
+
+bool bcd_time_detector_skip(bcd_time_detector_t *td, uint64_t samples) {
+    if (!td || td->buffer_idx != 0 || samples % BCD_TIME_FFT_SIZE != 0) return false;
 
-    return (td->state == STATE_IN_PULSE && td->pulse_duration_frames == 1);
+    td->frame_count += samples / BCD_TIME_FFT_SIZE;
+    pulse_fsm_reset(&td->pulse);
+    goertzel_bank_reset(td->goertzel);
+    return true;
 }
 
 void bcd_time_detector_set_enabled(bcd_time_detector_t *td, bool enabled) {
@@ -182,3 +293,45 @@ void bcd_time_detector_print_stats(bcd_time_detector_t *td) {
 float bcd_time_detector_get_frame_duration_ms(void) {
     return (float)BCD_TIME_FFT_SIZE * 1000.0f / BCD_TIME_SAMPLE_RATE;
 }
+
+/*============================================================================
+ * Warm Start
+ *============================================================================*/
+
+#define BCD_TIME_STATE_VERSION  1
+
+typedef struct {
+    float noise_floor;
+    float threshold_high;
+    float threshold_low;
+} bcd_time_state_t;
+
+_Static_assert(sizeof(bcd_time_state_t) == 12, "bcd_time state layout");
+
+bool bcd_time_detector_save_state(bcd_time_detector_t *td, wwv_state_writer_t *w) {
+    if (!td || !w || !td->warmup_complete) return false;
+
+    bcd_time_state_t st = {
+        .noise_floor = td->noise_floor,
+        .threshold_high = td->threshold_high,
+        .threshold_low = td->threshold_low
+    };
+    return wwv_state_put(w, WWV_STATE_BCD_TIME_DETECTOR, BCD_TIME_STATE_VERSION, &st, sizeof(st));
+}
+
+bool bcd_time_detector_restore_state(bcd_time_detector_t *td, const wwv_state_reader_t *r) {
+    if (!td || !r || r->elapsed_ms > WWV_STATE_LEVELS_MAX_AGE_MS) return false;
+
+    bcd_time_state_t st;
+    if (!wwv_state_get(r, WWV_STATE_BCD_TIME_DETECTOR, BCD_TIME_STATE_VERSION, &st, sizeof(st)) ||
+        !(st.noise_floor > 0.0f)) {
+        return false;
+    }
+
+    td->noise_floor = st.noise_floor;
+    td->threshold_high = st.threshold_high;
+    td->threshold_low = st.threshold_low;
+    td->warmup_complete = true;
+    printf("[BCD_TIME] Warm start: noise=%.6f thresh=%.6f\n", td->noise_floor, td->threshold_high);
+    return true;
+}
@@ -6,7 +6,7 @@
  * from API management.
  *
  * Contains:
- *   - 3-state FSM (IDLE → IN_PULSE → COOLDOWN)
+ *   - 3-state FSM (IDLE → ACTIVE → COOLDOWN, pulse_fsm_internal.h)
  *   - Adaptive noise floor tracking
  *   - Pulse duration measurement
  *   - CSV logging and telemetry
@@ -17,6 +17,7 @@
 
 #include "bcd_internal.h"
 #include "telemetry.h"
+#include "telemetry_wire.h"
 #include "version.h"
 #include <math.h>
 #include <string.h>
@@ -38,12 +39,26 @@
 
 #define MS_TO_FRAMES(ms)    ((int)((ms) / FRAME_DURATION_MS + 0.5f))
 
+/* Absolute frame times from the 64-bit sample clock (frames do not overlap) */
+#define FRAME_TO_SAMPLE(f)  ((wwv_sample_t)(f) * BCD_TIME_FFT_SIZE)
+#define FRAME_TO_MS(f)      wwv_samples_to_ms(FRAME_TO_SAMPLE(f), BCD_TIME_SAMPLE_RATE)
+
 /*============================================================================
  * Internal Functions
  *============================================================================*/
 
 float bcd_time_calculate_bucket_energy(bcd_time_detector_t *td) {
-    return fft_processor_get_bucket_energy(td->fft, BCD_TIME_TARGET_FREQ_HZ, BCD_TIME_BANDWIDTH_HZ);
+    if (td->spectral_mode == SPECTRAL_MODE_GOERTZEL) {
+        return goertzel_bank_get_band(td->goertzel, td->goertzel_band);
+    }
+    return fft_processor_get_band(td->fft, td->fft_band);
+}
+
+void bcd_time_init_state_machine(bcd_time_detector_t *td) {
+    pulse_fsm_reset(&td->pulse);
+    pulse_fsm_params_init(&td->pulse_params, FRAME_DURATION_MS, MIN_LOW_FRAMES, 0.0f,
+                          BCD_TIME_COOLDOWN_MS);
+    pulse_fsm_set_class(&td->pulse_params, 0, BCD_TIME_PULSE_MIN_MS, BCD_TIME_PULSE_MAX_MS);
 }
 
 void bcd_time_run_state_machine(bcd_time_detector_t *td) {
@@ -66,7 +81,7 @@ void bcd_time_run_state_machine(bcd_time_detector_t *td) {
     }
 
     /* Adaptive noise floor - asymmetric: fast down, slow up */
-    if (td->state == STATE_IDLE && energy < td->threshold_high) {
+    if (td->pulse.state == PULSE_IDLE && energy < td->threshold_high) {
         if (energy < td->noise_floor) {
             td->noise_floor += BCD_TIME_NOISE_ADAPT_DOWN * (energy - td->noise_floor);
         } else {
@@ -78,96 +93,75 @@ void bcd_time_run_state_machine(bcd_time_detector_t *td) {
         td->threshold_low = td->threshold_high * BCD_TIME_HYSTERESIS_RATIO;
     }
 
-    /* State machine */
-    switch (td->state) {
-        case STATE_IDLE:
-            if (energy > td->threshold_high) {
-                td->state = STATE_IN_PULSE;
-                td->pulse_start_frame = frame;
-                td->pulse_peak_energy = energy;
-                td->pulse_duration_frames = 1;
-                td->consecutive_low_frames = 0;
-            }
-            break;
-
-        case STATE_IN_PULSE:
-            td->pulse_duration_frames++;
-            if (energy > td->pulse_peak_energy) {
-                td->pulse_peak_energy = energy;
-            }
-
-            /* Phase 9: Require consecutive low frames before ending pulse */
-            if (energy < td->threshold_low) {
-                td->consecutive_low_frames++;
+    /* State machine (Phase 9: the pulse ends after MIN_LOW_FRAMES consecutive low frames) */
+    int events = pulse_fsm_step(&td->pulse, &td->pulse_params, energy,
+                                td->threshold_high, td->threshold_low, frame);
+    if (events & PULSE_EV_END) {
+        /* Pulse ended - check validity */
+        float duration_ms = pulse_fsm_duration_ms(&td->pulse, &td->pulse_params);
+        double timestamp_ms = FRAME_TO_MS(td->pulse.start_frame);
+        float snr_db = 10.0f * log10f(td->pulse.peak / td->noise_floor);
+
+        if (pulse_fsm_classify(&td->pulse, &td->pulse_params) == 0) {
+            /* Valid pulse! */
+            td->pulses_detected++;
+
+            printf("[BCD_TIME] Pulse #%d at %.1fms  dur=%.0fms  SNR=%.1fdB\n",
+                   td->pulses_detected, timestamp_ms, duration_ms, snr_db);
+
+            /* CSV logging and telemetry */
+            char time_str[16];
+            bcd_get_wall_time_str(td->start_time, timestamp_ms, time_str, sizeof(time_str));
+
+            wwv_csv_log_row_at(td->csv_log, bcd_get_wall_time(td->start_time, timestamp_ms),
+                               "%.1f,%d,%.6f,%.0f,%.6f,%.1f\n",
+                               timestamp_ms, td->pulses_detected,
+                               td->pulse.peak, duration_ms,
+                               td->noise_floor, snr_db);
+
+            /* UDP telemetry */
+            if (telem_ctx_binary_active(td->telem, TELEM_BCDS)) {
+                telem_rec_bcd_pulse_t rec = {
+                    .number = (uint32_t)td->pulses_detected,
+                    .path = 0,
+                    .energy = td->pulse.peak,
+                    .duration_ms = duration_ms,
+                    .noise_floor = td->noise_floor,
+                    .snr_db = snr_db
+                };
+                telem_ctx_send_record(td->telem, TELEM_BCDS, TELEM_REC_BCD_PULSE,
+                                  (uint32_t)bcd_get_wall_time(td->start_time, timestamp_ms),
+                                  telem_ms_to_us(timestamp_ms), &rec, sizeof(rec));
             } else {
-                td->consecutive_low_frames = 0;  /* Reset if signal returns */
+                telem_ctx_sendf(td->telem, TELEM_BCDS, "TIME,%s,%.1f,%d,%.6f,%.0f,%.6f,%.1f",
+                            time_str, timestamp_ms, td->pulses_detected,
+                            td->pulse.peak, duration_ms,
+                            td->noise_floor, snr_db);
             }
 
-            if (td->consecutive_low_frames >= MIN_LOW_FRAMES) {
-                /* Pulse ended - check validity */
-                float duration_ms = td->pulse_duration_frames * FRAME_DURATION_MS;
-                float timestamp_ms = td->pulse_start_frame * FRAME_DURATION_MS;
-                float snr_db = 10.0f * log10f(td->pulse_peak_energy / td->noise_floor);
-
-                if (duration_ms >= BCD_TIME_PULSE_MIN_MS &&
-                    duration_ms <= BCD_TIME_PULSE_MAX_MS) {
-                    /* Valid pulse! */
-                    td->pulses_detected++;
-
-                    printf("[BCD_TIME] Pulse #%d at %.1fms  dur=%.0fms  SNR=%.1fdB\n",
-                           td->pulses_detected, timestamp_ms, duration_ms, snr_db);
-
-                    /* CSV logging and telemetry */
-                    char time_str[16];
-                    bcd_get_wall_time_str(td->start_time, timestamp_ms, time_str, sizeof(time_str));
-
-                    if (td->csv_file) {
-                        fprintf(td->csv_file, "%s,%.1f,%d,%.6f,%.0f,%.6f,%.1f\n",
-                                time_str, timestamp_ms, td->pulses_detected,
-                                td->pulse_peak_energy, duration_ms,
-                                td->noise_floor, snr_db);
-                        fflush(td->csv_file);
-                    }
-
-                    /* UDP telemetry */
-                    telem_sendf(TELEM_BCDS, "TIME,%s,%.1f,%d,%.6f,%.0f,%.6f,%.1f",
-                                time_str, timestamp_ms, td->pulses_detected,
-                                td->pulse_peak_energy, duration_ms,
-                                td->noise_floor, snr_db);
-
-                    td->last_pulse_frame = td->pulse_start_frame;
-
-                    /* Callback */
-                    if (td->callback) {
-                        bcd_time_event_t event = {
-                            .timestamp_ms = timestamp_ms,
-                            .duration_ms = duration_ms,
-                            .peak_energy = td->pulse_peak_energy,
-                            .noise_floor = td->noise_floor,
-                            .snr_db = snr_db
-                        };
-                        td->callback(&event, td->callback_user_data);
-                    }
-                } else {
-                    /* Rejected pulse */
-                    td->pulses_rejected++;
-                    if (duration_ms < BCD_TIME_PULSE_MIN_MS) {
-                        /* Too short - likely noise, don't log */
-                    } else {
-                        printf("[BCD_TIME] Rejected: dur=%.0fms (>%.0fms max)\n",
-                               duration_ms, BCD_TIME_PULSE_MAX_MS);
-                    }
-                }
-
-                td->state = STATE_COOLDOWN;
-                td->cooldown_frames = MS_TO_FRAMES(BCD_TIME_COOLDOWN_MS);
+            td->last_pulse_frame = td->pulse.start_frame;
+
+            /* Callback */
+            if (td->callback) {
+                bcd_time_event_t event = {
+                    .timestamp_ms = timestamp_ms,
+                    .sample_index = FRAME_TO_SAMPLE(td->pulse.start_frame),
+                    .duration_ms = duration_ms,
+                    .peak_energy = td->pulse.peak,
+                    .noise_floor = td->noise_floor,
+                    .snr_db = snr_db
+                };
+                td->callback(&event, td->callback_user_data);
             }
-            break;
-
-        case STATE_COOLDOWN:
-            if (--td->cooldown_frames <= 0) {
-                td->state = STATE_IDLE;
+        } else {
+            /* Rejected pulse */
+            td->pulses_rejected++;
+            if (duration_ms < BCD_TIME_PULSE_MIN_MS) {
+                /* Too short - likely noise, don't log */
+            } else {
+                printf("[BCD_TIME] Rejected: dur=%.0fms (>%.0fms max)\n",
+                       duration_ms, BCD_TIME_PULSE_MAX_MS);
             }
-            break;
+        }
     }
 }
@@ -8,6 +8,10 @@
  */
 
 #include "subcarrier_detector.h"
+#include "wwv_csv_log.h"
+#include "running_percentile.h"
+#include "wwv_arena.h"
+#include "wwv_denormal.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
@@ -53,10 +57,8 @@ struct subcarrier_detector {
     float envelope;             /* Smoothed magnitude */
     float envelope_db;
 
-    /* Noise floor estimation (ring buffer of recent magnitudes) */
-    float mag_history[256];     /* ~2.5 seconds at 100 Hz update */
-    int mag_history_idx;
-    int mag_history_count;
+    /* Noise floor estimation (percentile over recent magnitudes) */
+    running_percentile_t *mag_history;  /* ~2.5 seconds at 100 Hz update */
     float noise_floor;
     float noise_floor_db;
 
@@ -77,7 +79,7 @@ struct subcarrier_detector {
     void *user_data;
 
     /* CSV logging */
-    FILE *csv_file;
+    wwv_csv_log_t *csv_log;
 };
 
 /*============================================================================
@@ -116,6 +118,7 @@ static inline float aa_lpf_process_i(subcarrier_detector_t *det, float x) {
             + det->aa_lpf_b2 * det->aa_lpf_i_x2
             - det->aa_lpf_a1 * det->aa_lpf_i_y1
             - det->aa_lpf_a2 * det->aa_lpf_i_y2;
+    y = WWV_DENORMAL_FLUSH(y);
     det->aa_lpf_i_x2 = det->aa_lpf_i_x1;
     det->aa_lpf_i_x1 = x;
     det->aa_lpf_i_y2 = det->aa_lpf_i_y1;
@@ -132,6 +135,7 @@ static inline float aa_lpf_process_q(subcarrier_detector_t *det, float x) {
             + det->aa_lpf_b2 * det->aa_lpf_q_x2
             - det->aa_lpf_a1 * det->aa_lpf_q_y1
             - det->aa_lpf_a2 * det->aa_lpf_q_y2;
+    y = WWV_DENORMAL_FLUSH(y);
     det->aa_lpf_q_x2 = det->aa_lpf_q_x1;
     det->aa_lpf_q_x1 = x;
     det->aa_lpf_q_y2 = det->aa_lpf_q_y1;
@@ -193,7 +197,7 @@ static float goertzel_magnitude(float s1, float s2, float coeff) {
  * With alpha=0.995 at 2400 Hz: cutoff ~2 Hz
  */
 static inline float dc_block(float input, float *prev_in, float *prev_out, float alpha) {
-    float output = input - *prev_in + alpha * (*prev_out);
+    float output = WWV_DENORMAL_FLUSH(input - *prev_in + alpha * (*prev_out));
     *prev_in = input;
     *prev_out = output;
     return output;
@@ -208,33 +212,11 @@ static inline float dc_block(float input, float *prev_in, float *prev_out, float
  * This avoids including signal energy in the noise estimate
  */
 static float estimate_noise_floor(subcarrier_detector_t *det) {
-    if (det->mag_history_count < 10) {
+    if (running_percentile_count(det->mag_history) < 10) {
         return 1e-6f;  /* Not enough data yet */
     }
 
-    /* Copy and sort (simple insertion sort for small N) */
-    float sorted[256];
-    int n = det->mag_history_count;
-    if (n > 256) n = 256;
-
-    memcpy(sorted, det->mag_history, n * sizeof(float));
-
-    for (int i = 1; i < n; i++) {
-        float key = sorted[i];
-        int j = i - 1;
-        while (j >= 0 && sorted[j] > key) {
-            sorted[j + 1] = sorted[j];
-            j--;
-        }
-        sorted[j + 1] = key;
-    }
-
-    /* Take lower percentile */
-    int idx = (n * SUBCARRIER_NOISE_PERCENTILE) / 100;
-    if (idx < 0) idx = 0;
-    if (idx >= n) idx = n - 1;
-
-    return sorted[idx];
+    return running_percentile_get(det->mag_history);
 }
 
 /*============================================================================
@@ -242,9 +224,15 @@ static float estimate_noise_floor(subcarrier_detector_t *det) {
  *============================================================================*/
 
 subcarrier_detector_t *subcarrier_detector_create(const char *csv_path) {
-    subcarrier_detector_t *det = calloc(1, sizeof(subcarrier_detector_t));
+    subcarrier_detector_t *det = wwv_calloc(1, sizeof(subcarrier_detector_t));
     if (!det) return NULL;
 
+    det->mag_history = running_percentile_create(256, SUBCARRIER_NOISE_PERCENTILE);
+    if (!det->mag_history) {
+        wwv_free(det);
+        return NULL;
+    }
+
     det->enabled = true;
 
     /* Initialize anti-alias lowpass filter (500 Hz cutoff at 12 kHz input rate)
@@ -264,11 +252,9 @@ subcarrier_detector_t *subcarrier_detector_create(const char *csv_path) {
 
     /* Open CSV if requested */
     if (csv_path) {
-        det->csv_file = fopen(csv_path, "w");
-        if (det->csv_file) {
-            fprintf(det->csv_file, "timestamp_ms,envelope,envelope_db,noise_floor_db,"
-                                   "snr_db,status,pos_mag,neg_mag\n");
-        }
+        det->csv_log = wwv_csv_log_open(csv_path);
+        wwv_csv_log_header(det->csv_log, "timestamp_ms,envelope,envelope_db,noise_floor_db,"
+                           "snr_db,status,pos_mag,neg_mag\n");
     }
 
     printf("[subcarrier_detector] Created: target=%d Hz, block=%d samples (%.1f ms)\n",
@@ -283,11 +269,10 @@ subcarrier_detector_t *subcarrier_detector_create(const char *csv_path) {
 void subcarrier_detector_destroy(subcarrier_detector_t *det) {
     if (!det) return;
 
-    if (det->csv_file) {
-        fclose(det->csv_file);
-    }
+    wwv_csv_log_close(det->csv_log);
+    running_percentile_destroy(det->mag_history);
 
-    free(det);
+    wwv_free(det);
 }
 
 void subcarrier_detector_set_callback(subcarrier_detector_t *det,
@@ -367,9 +352,7 @@ void subcarrier_detector_process_sample_2400(subcarrier_detector_t *det,
         det->g_s1_q = det->g_s2_q = 0;
 
         /* Update magnitude history for noise estimation */
-        det->mag_history[det->mag_history_idx] = magnitude;
-        det->mag_history_idx = (det->mag_history_idx + 1) % 256;
-        if (det->mag_history_count < 256) det->mag_history_count++;
+        running_percentile_push(det->mag_history, magnitude);
 
         /* Update noise floor estimate (every ~10 blocks) */
         if ((det->block_count % 10) == 0) {
@@ -399,7 +382,7 @@ void subcarrier_detector_process_sample_2400(subcarrier_detector_t *det,
         /* Fire callback */
         if (det->callback) {
             subcarrier_frame_t frame = {
-                .timestamp_ms = (float)det->block_count * 10.0f,  /* 10 ms per block */
+                .timestamp_ms = (double)det->block_count * 10.0,  /* 10 ms per block */
                 .envelope = det->envelope,
                 .envelope_db = det->envelope_db,
                 .noise_floor_db = det->noise_floor_db,
@@ -410,17 +393,15 @@ void subcarrier_detector_process_sample_2400(subcarrier_detector_t *det,
         }
 
         /* CSV logging */
-        if (det->csv_file) {
-            fprintf(det->csv_file, "%.1f,%.6f,%.2f,%.2f,%.2f,%d,%.6f,%.6f\n",
-                    (float)det->block_count * 10.0f,
-                    det->envelope,
-                    det->envelope_db,
-                    det->noise_floor_db,
-                    det->snr_db,
-                    det->status,
-                    det->last_pos_mag,
-                    det->last_neg_mag);
-        }
+        wwv_csv_log_row(det->csv_log, "%.1f,%.6f,%.2f,%.2f,%.2f,%d,%.6f,%.6f\n",
+                        (double)det->block_count * 10.0,
+                        det->envelope,
+                        det->envelope_db,
+                        det->noise_floor_db,
+                        det->snr_db,
+                        det->status,
+                        det->last_pos_mag,
+                        det->last_neg_mag);
     }
 }
 
@@ -6,6 +6,7 @@
  * the detection pipeline. The core detection logic has been extracted to:
  *   - marker_internal.h: Shared state and configuration
  *   - marker_state_machine.c: Detection state machine
+ *   - marker_template.c: Template-correlated detection (template mode)
  *
  * Responsibilities:
  *   - FFT processing and energy extraction
@@ -16,6 +17,9 @@
 #include "marker_detector.h"
 #include "detection/marker_internal.h"
 #include "version.h"
+#include "wwv_thread.h"
+#include "wwv_arena.h"
+#include "wwv_trace.h"
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -25,12 +29,21 @@
  *============================================================================*/
 
 static float calculate_bucket_energy(marker_detector_t *md) {
-    return fft_processor_get_bucket_energy(md->fft, MARKER_TARGET_FREQ_HZ, MARKER_BANDWIDTH_HZ);
+    if (md->spectral_mode == SPECTRAL_MODE_GOERTZEL) {
+        return goertzel_bank_get_band(md->goertzel, md->goertzel_band);
+    }
+    float energy = fft_processor_get_band(md->fft, md->fft_band);
+    if (md->fft_lower) energy += fft_processor_get_band(md->fft_lower, md->fft_band);
+    return energy;
+}
+
+time_t marker_get_wall_time(marker_detector_t *md, double timestamp_ms) {
+    return md->start_time + (time_t)(timestamp_ms / 1000.0f);
 }
 
-void marker_get_wall_time_str(marker_detector_t *md, float timestamp_ms, char *buf, size_t buflen) {
-    time_t event_time = md->start_time + (time_t)(timestamp_ms / 1000.0f);
-    struct tm *tm_info = localtime(&event_time);
+void marker_get_wall_time_str(marker_detector_t *md, double timestamp_ms, char *buf, size_t buflen) {
+    time_t event_time = marker_get_wall_time(md, timestamp_ms);
+    struct tm *tm_info = wwv_localtime(&event_time);
     strftime(buf, buflen, "%H:%M:%S", tm_info);
 }
 
@@ -38,36 +51,69 @@ void marker_get_wall_time_str(marker_detector_t *md, float timestamp_ms, char *b
  * Public API Implementation
  *============================================================================*/
 
-marker_detector_t *marker_detector_create(const char *csv_path) {
-    marker_detector_t *md = (marker_detector_t *)calloc(1, sizeof(marker_detector_t));
+/**
+ * Target bucket as bins of the baseband FFTs: the same 195.3 Hz bins as the
+ * 256-point frame, shifted down by BASEBAND_MIX_BIN
+ */
+static bool add_baseband_band(marker_detector_t *md) {
+    int center = (int)(MARKER_TARGET_FREQ_HZ / HZ_PER_BIN + 0.5f) - BASEBAND_MIX_BIN;
+    int span = (int)(MARKER_BANDWIDTH_HZ / HZ_PER_BIN + 0.5f);
+    if (span < 1) span = 1;
+
+    md->fft_band = fft_processor_add_bins(md->fft, center - span, center + span, FFT_BAND_MAGNITUDE);
+    return md->fft_band >= 0 &&
+           fft_processor_add_bins(md->fft_lower, center - span, center + span,
+                                  FFT_BAND_MAGNITUDE) == md->fft_band;
+}
+
+static marker_detector_t *create_detector(const char *csv_path, bool baseband) {
+    marker_detector_t *md = (marker_detector_t *)wwv_aligned_calloc(WWV_CACHE_LINE, sizeof(marker_detector_t));
     if (!md) return NULL;
 
-    md->fft = fft_processor_create(MARKER_FFT_SIZE, MARKER_SAMPLE_RATE);
+    md->frame_samples = baseband ? MARKER_FFT_SIZE / BASEBAND_DECIMATION : MARKER_FFT_SIZE;
+    const float rate = baseband ? (float)BASEBAND_RATE : (float)MARKER_SAMPLE_RATE;
+
+    md->fft = fft_processor_create(md->frame_samples, rate);
     if (!md->fft) {
-        free(md);
+        wwv_aligned_free(md);
         return NULL;
     }
+    if (baseband) {
+        md->fft_lower = fft_processor_create(md->frame_samples, rate);
+        md->lower_i_buffer = (float *)wwv_calloc(md->frame_samples, sizeof(float));
+        md->lower_q_buffer = (float *)wwv_calloc(md->frame_samples, sizeof(float));
+        if (!md->fft_lower || !md->lower_i_buffer || !md->lower_q_buffer || !add_baseband_band(md)) {
+            marker_detector_destroy(md);
+            return NULL;
+        }
+    } else {
+        md->fft_band = fft_processor_add_band(md->fft, MARKER_TARGET_FREQ_HZ, MARKER_BANDWIDTH_HZ, FFT_BAND_MAGNITUDE);
+    }
 
-    md->i_buffer = (float *)malloc(MARKER_FFT_SIZE * sizeof(float));
-    md->q_buffer = (float *)malloc(MARKER_FFT_SIZE * sizeof(float));
-    md->energy_history = (float *)malloc(MARKER_WINDOW_FRAMES * sizeof(float));
+    md->i_buffer = (float *)wwv_malloc(md->frame_samples * sizeof(float));
+    md->q_buffer = (float *)wwv_malloc(md->frame_samples * sizeof(float));
+    md->energy_sums = sliding_sum_create(MARKER_WINDOW_FRAMES);
 
-    if (!md->i_buffer || !md->q_buffer || !md->energy_history) {
+    if (!md->i_buffer || !md->q_buffer || !md->energy_sums) {
         marker_detector_destroy(md);
         return NULL;
     }
 
-    memset(md->i_buffer, 0, MARKER_FFT_SIZE * sizeof(float));
-    memset(md->q_buffer, 0, MARKER_FFT_SIZE * sizeof(float));
+    memset(md->i_buffer, 0, md->frame_samples * sizeof(float));
+    memset(md->q_buffer, 0, md->frame_samples * sizeof(float));
     md->buffer_idx = 0;
 
-    memset(md->energy_history, 0, MARKER_WINDOW_FRAMES * sizeof(float));
-    md->history_idx = 0;
-    md->history_count = 0;
+    static const float window_ms[MARKER_WINDOW_COUNT] = {
+        MARKER_MIN_DURATION_MS, MARKER_PULSE_MS, MARKER_WINDOW_MS
+    };
+    for (int w = 0; w < MARKER_WINDOW_COUNT; w++) {
+        md->window_id[w] = sliding_sum_add_window(md->energy_sums,
+                                                  (int)(window_ms[w] / MARKER_FRAME_MS));
+    }
     md->accumulated_energy = 0.0f;
     md->baseline_energy = 0.01f;
 
-    md->state = STATE_IDLE;
+    pulse_fsm_reset(&md->pulse);
     md->threshold = md->baseline_energy * MARKER_THRESHOLD_MULT;
     md->detection_enabled = true;
     md->warmup_complete = false;
@@ -78,20 +124,24 @@ marker_detector_t *marker_detector_create(const char *csv_path) {
     md->noise_adapt_rate = MARKER_NOISE_ADAPT_RATE;        /* 0.001 */
     md->min_duration_ms = MARKER_MIN_DURATION_MS;          /* 500.0 */
 
+    /* Ends on the first frame below threshold; valid up to the forced exit */
+    pulse_fsm_params_init(&md->pulse_params, FRAME_DURATION_MS, 1, MARKER_MAX_DURATION_MS,
+                          MARKER_COOLDOWN_MS);
+    pulse_fsm_set_class(&md->pulse_params, 0, md->min_duration_ms, MARKER_MAX_DURATION_MS);
+
     md->wwv_clock = wwv_clock_create(WWV_STATION_WWV);
 
     if (csv_path) {
-        md->csv_file = fopen(csv_path, "w");
-        if (md->csv_file) {
+        md->csv_log = wwv_csv_log_open(csv_path);
+        if (md->csv_log) {
             char time_str[64];
             time_t now = time(NULL);
-            strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", localtime(&now));
-            fprintf(md->csv_file, "# Phoenix SDR WWV Marker Log v%s\n", PHOENIX_VERSION_FULL);
-            fprintf(md->csv_file, "# Started: %s\n", time_str);
-            fprintf(md->csv_file, "# Sliding window: %d frames (%.0f ms)\n",
-                    MARKER_WINDOW_FRAMES, MARKER_WINDOW_MS);
-            fprintf(md->csv_file, "time,timestamp_ms,marker_num,wwv_sec,expected,accum_energy,duration_ms,since_last_sec,baseline,threshold\n");
-            fflush(md->csv_file);
+            strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", wwv_localtime(&now));
+            wwv_csv_log_header(md->csv_log, "# Phoenix SDR WWV Marker Log v%s\n", PHOENIX_VERSION_FULL);
+            wwv_csv_log_header(md->csv_log, "# Started: %s\n", time_str);
+            wwv_csv_log_header(md->csv_log, "# Sliding window: %d frames (%.0f ms)\n",
+                               MARKER_WINDOW_FRAMES, MARKER_WINDOW_MS);
+            wwv_csv_log_header(md->csv_log, "time,timestamp_ms,marker_num,wwv_sec,expected,accum_energy,duration_ms,since_last_sec,baseline,threshold\n");
         }
 
         /* Debug log */
@@ -104,38 +154,51 @@ marker_detector_t *marker_detector_create(const char *csv_path) {
         } else {
             strcat(debug_path, "_debug.csv");
         }
-        md->debug_file = fopen(debug_path, "w");
-        if (md->debug_file) {
+        md->debug_log = wwv_csv_log_open(debug_path);
+        if (md->debug_log) {
             char time_str[64];
             time_t now = time(NULL);
-            strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", localtime(&now));
-            fprintf(md->debug_file, "# Phoenix SDR Marker Debug Log v%s\n", PHOENIX_VERSION_FULL);
-            fprintf(md->debug_file, "# Started: %s\n", time_str);
-            fprintf(md->debug_file, "time,timestamp_ms,state,accum,baseline,threshold,energy,ratio\n");
-            fflush(md->debug_file);
+            strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", wwv_localtime(&now));
+            wwv_csv_log_header(md->debug_log, "# Phoenix SDR Marker Debug Log v%s\n", PHOENIX_VERSION_FULL);
+            wwv_csv_log_header(md->debug_log, "# Started: %s\n", time_str);
+            wwv_csv_log_header(md->debug_log, "time,timestamp_ms,state,accum,baseline,threshold,energy,ratio\n");
             printf("[MARKER] Debug log: %s\n", debug_path);
         }
     }
 
-    printf("[MARKER] Detector created: FFT=%d (%.1fms), window=%d frames (%.0fms)\n",
-           MARKER_FFT_SIZE, FRAME_DURATION_MS, MARKER_WINDOW_FRAMES, MARKER_WINDOW_MS);
+    printf("[MARKER] Detector created: FFT=%d (%.1fms)%s, window=%d frames (%.0fms)\n",
+           md->frame_samples, FRAME_DURATION_MS, baseband ? " baseband" : "",
+           MARKER_WINDOW_FRAMES, MARKER_WINDOW_MS);
     printf("[MARKER] Target: %dHz ±%dHz, self-tracking baseline\n",
            MARKER_TARGET_FREQ_HZ, MARKER_BANDWIDTH_HZ);
 
     return md;
 }
 
+marker_detector_t *marker_detector_create(const char *csv_path) {
+    return create_detector(csv_path, false);
+}
+
+marker_detector_t *marker_detector_create_baseband(const char *csv_path) {
+    return create_detector(csv_path, true);
+}
+
 void marker_detector_destroy(marker_detector_t *md) {
     if (!md) return;
 
     if (md->wwv_clock) wwv_clock_destroy(md->wwv_clock);
-    if (md->csv_file) fclose(md->csv_file);
-    if (md->debug_file) fclose(md->debug_file);
+    wwv_csv_log_close(md->csv_log);
+    wwv_csv_log_close(md->debug_log);
     if (md->fft) fft_processor_destroy(md->fft);
-    free(md->i_buffer);
-    free(md->q_buffer);
-    free(md->energy_history);
-    free(md);
+    if (md->fft_lower) fft_processor_destroy(md->fft_lower);
+    goertzel_bank_destroy(md->goertzel);
+    marker_template_destroy(md->tpl);
+    wwv_free(md->i_buffer);
+    wwv_free(md->q_buffer);
+    wwv_free(md->lower_i_buffer);
+    wwv_free(md->lower_q_buffer);
+    sliding_sum_destroy(md->energy_sums);
+    wwv_aligned_free(md);
 }
 
 void marker_detector_set_callback(marker_detector_t *md, marker_callback_fn callback, void *user_data) {
@@ -144,8 +207,55 @@ void marker_detector_set_callback(marker_detector_t *md, marker_callback_fn call
     md->callback_user_data = user_data;
 }
 
+void marker_detector_set_telemetry(marker_detector_t *md, telem_ctx_t *ctx) {
+    if (!md) return;
+    md->telem = ctx;
+}
+
+void marker_detector_set_perf(marker_detector_t *md, wwv_perf_t *perf) {
+    if (!md) return;
+    md->perf = perf;
+    wwv_csv_log_set_perf(md->csv_log, perf);
+    wwv_csv_log_set_perf(md->debug_log, perf);
+}
+
+/**
+ * @param frame_i, frame_q One frame (FFT mode only, else NULL)
+ * @param lower_i, lower_q Baseband: the lower sideband's frame, else NULL
+ */
+static bool process_frame(marker_detector_t *md, const float *frame_i, const float *frame_q,
+                          const float *lower_i, const float *lower_q) {
+    md->buffer_idx = 0;
+    WWV_TRACE_BEGIN(tr);
+
+    WWV_PERF_BEGIN(md->perf, t0);
+    if (md->spectral_mode == SPECTRAL_MODE_FFT) {
+        fft_processor_process(md->fft, frame_i, frame_q);
+        if (md->fft_lower) fft_processor_process(md->fft_lower, lower_i, lower_q);
+    }
+    md->current_energy = calculate_bucket_energy(md);
+    WWV_PERF_END(md->perf, WWV_PERF_MARKER_FFT, t0);
+
+    WWV_PERF_BEGIN(md->perf, t1);
+    if (md->template_mode) {
+        marker_template_run(md);
+    } else {
+        marker_state_machine_run(md);
+    }
+    WWV_PERF_END(md->perf, WWV_PERF_MARKER_STATE, t1);
+    WWV_TRACE_END("detector", "marker_frame", tr, FRAME_TO_MS(md->frame_count));
+    md->frame_count++;
+
+    return (md->flash_frames_remaining == MARKER_FLASH_FRAMES);
+}
+
 bool marker_detector_process_sample(marker_detector_t *md, float i_sample, float q_sample) {
-    if (!md || !md->detection_enabled) return false;
+    if (!md || !md->detection_enabled || md->fft_lower) return false;
+
+    if (md->spectral_mode == SPECTRAL_MODE_GOERTZEL) {
+        return goertzel_bank_process(md->goertzel, i_sample, q_sample) &&
+               process_frame(md, NULL, NULL, NULL, NULL);
+    }
 
     md->i_buffer[md->buffer_idx] = i_sample;
     md->q_buffer[md->buffer_idx] = q_sample;
@@ -155,14 +265,136 @@ bool marker_detector_process_sample(marker_detector_t *md, float i_sample, float
         return false;
     }
 
+    return process_frame(md, md->i_buffer, md->q_buffer, NULL, NULL);
+}
+
+/**
+ * FFT-mode block body shared by the 50 kHz and baseband entry points
+ * @param lower_i, lower_q Baseband lower sideband, else NULL
+ */
+static int run_block(marker_detector_t *md, const float *i_samples, const float *q_samples,
+                     const float *lower_i, const float *lower_q, size_t count) {
+    const int frame = md->frame_samples;
+    int detections = 0;
+    size_t pos = 0;
+
+    while (pos < count) {
+        size_t chunk = (size_t)(frame - md->buffer_idx);
+        if (chunk > count - pos) chunk = count - pos;
+
+        /* A whole frame inside the block goes to the FFT in place */
+        if (md->buffer_idx == 0 && chunk == (size_t)frame) {
+            if (process_frame(md, &i_samples[pos], &q_samples[pos],
+                              lower_i ? &lower_i[pos] : NULL, lower_q ? &lower_q[pos] : NULL)) {
+                detections++;
+            }
+            pos += chunk;
+            continue;
+        }
+
+        memcpy(&md->i_buffer[md->buffer_idx], &i_samples[pos], chunk * sizeof(float));
+        memcpy(&md->q_buffer[md->buffer_idx], &q_samples[pos], chunk * sizeof(float));
+        if (lower_i) {
+            memcpy(&md->lower_i_buffer[md->buffer_idx], &lower_i[pos], chunk * sizeof(float));
+            memcpy(&md->lower_q_buffer[md->buffer_idx], &lower_q[pos], chunk * sizeof(float));
+        }
+        md->buffer_idx += (int)chunk;
+        pos += chunk;
+
+        if (md->buffer_idx >= frame &&
+            process_frame(md, md->i_buffer, md->q_buffer, md->lower_i_buffer, md->lower_q_buffer)) {
+            detections++;
+        }
+    }
+
+    return detections;
+}
+
+int marker_detector_process_block(marker_detector_t *md, const float *i_samples,
+                                  const float *q_samples, size_t count) {
+    if (!md || !md->detection_enabled || md->fft_lower || !i_samples || !q_samples) return 0;
+
+    if (md->spectral_mode == SPECTRAL_MODE_GOERTZEL) {
+        int detections = 0;
+        size_t pos = 0;
+        while (pos < count) {
+            WWV_PERF_BEGIN(md->perf, t0);
+            pos += goertzel_bank_process_block(md->goertzel, &i_samples[pos], &q_samples[pos], count - pos);
+            WWV_PERF_END(md->perf, WWV_PERF_MARKER_FFT, t0);
+            if (goertzel_bank_frame_ready(md->goertzel) && process_frame(md, NULL, NULL, NULL, NULL)) {
+                detections++;
+            }
+        }
+        return detections;
+    }
+
+    return run_block(md, i_samples, q_samples, NULL, NULL, count);
+}
+
+int marker_detector_process_baseband(marker_detector_t *md, const baseband_block_t *block) {
+    if (!md || !md->detection_enabled || !md->fft_lower || !block) return 0;
+    return run_block(md, block->upper_i, block->upper_q, block->lower_i, block->lower_q, block->count);
+}
+
+bool marker_detector_set_spectral_mode(marker_detector_t *md, spectral_mode_t mode) {
+    if (!md) return false;
+    if (md->fft_lower && mode != SPECTRAL_MODE_FFT) return false;
+
+    if (mode == SPECTRAL_MODE_GOERTZEL && !md->goertzel) {
+        md->goertzel = goertzel_bank_create(MARKER_FFT_SIZE, MARKER_SAMPLE_RATE, FFT_WINDOW_HANN);
+        if (!md->goertzel) return false;
+        md->goertzel_band = goertzel_bank_add_band(md->goertzel, MARKER_TARGET_FREQ_HZ, MARKER_BANDWIDTH_HZ);
+    }
+
+    md->spectral_mode = mode;
     md->buffer_idx = 0;
+    goertzel_bank_reset(md->goertzel);
+    return true;
+}
 
-    fft_processor_process(md->fft, md->i_buffer, md->q_buffer);
-    md->current_energy = calculate_bucket_energy(md);
-    marker_state_machine_run(md);
-    md->frame_count++;
+spectral_mode_t marker_detector_get_spectral_mode(marker_detector_t *md) {
+    return md ? md->spectral_mode : SPECTRAL_MODE_FFT;
+}
 
-    return (md->flash_frames_remaining == MARKER_FLASH_FRAMES);
+bool marker_detector_set_template(marker_detector_t *md, bool enabled) {
+    if (!md) return false;
+    if (enabled && !md->tpl) {
+        md->tpl = marker_template_create();
+        if (!md->tpl) return false;
+    }
+    if (enabled == md->template_mode) return true;
+
+    /* The two modes keep their baselines on different scales */
+    md->template_mode = enabled;
+    marker_template_reset(md->tpl);
+    pulse_fsm_reset(&md->pulse);
+    md->warmup_complete = false;
+    md->start_frame = md->frame_count;
+    md->baseline_energy = 0.01f;
+    md->threshold = md->baseline_energy * md->threshold_multiplier;
+    printf("[MARKER] %s detection\n", enabled ? "Template" : "Sliding window");
+    return true;
+}
+
+bool marker_detector_skip(marker_detector_t *md, uint64_t samples) {
+    if (!md || md->fft_lower || md->buffer_idx != 0 || samples % MARKER_FFT_SIZE != 0) return false;
+
+    md->frame_count += samples / MARKER_FFT_SIZE;
+    sliding_sum_reset(md->energy_sums);
+    md->refill_until = md->frame_count + MARKER_WINDOW_FRAMES;
+    pulse_fsm_reset(&md->pulse);
+    md->flash_frames_remaining = 0;
+    goertzel_bank_reset(md->goertzel);
+    marker_template_skip(md->tpl);
+    return true;
+}
+
+bool marker_detector_get_template(marker_detector_t *md) {
+    return md ? md->template_mode : false;
+}
+
+float marker_detector_get_template_score(marker_detector_t *md) {
+    return (md && md->template_mode) ? marker_template_get_score(md->tpl) : 0.0f;
 }
 
 int marker_detector_get_flash_frames(marker_detector_t *md) {
@@ -187,6 +419,11 @@ float marker_detector_get_accumulated_energy(marker_detector_t *md) {
     return md ? md->accumulated_energy : 0.0f;
 }
 
+float marker_detector_get_window_energy(marker_detector_t *md, marker_window_t window) {
+    if (!md || window < 0 || window >= MARKER_WINDOW_COUNT) return 0.0f;
+    return sliding_sum_get(md->energy_sums, md->window_id[window]);
+}
+
 float marker_detector_get_threshold(marker_detector_t *md) {
     return md ? md->threshold : 0.0f;
 }
@@ -206,9 +443,10 @@ void marker_detector_print_stats(marker_detector_t *md) {
     int expected_markers = (int)(elapsed / 60.0f);
 
     printf("\n=== MARKER DETECTOR STATS ===\n");
-    printf("FFT: %d (%.1fms), Window: %d frames (%.0fms)\n",
-           MARKER_FFT_SIZE, FRAME_DURATION_MS, MARKER_WINDOW_FRAMES, MARKER_WINDOW_MS);
-    printf("Target: %d Hz +/-%d Hz\n", MARKER_TARGET_FREQ_HZ, MARKER_BANDWIDTH_HZ);
+    printf("FFT: %d (%.1fms)%s, Window: %d frames (%.0fms)\n",
+           md->frame_samples, FRAME_DURATION_MS, md->fft_lower ? " baseband" : "", MARKER_WINDOW_FRAMES, MARKER_WINDOW_MS);
+    printf("Target: %d Hz +/-%d Hz, %s\n", MARKER_TARGET_FREQ_HZ, MARKER_BANDWIDTH_HZ,
+           md->template_mode ? "marker + tick hole template" : "sliding window threshold");
     printf("Elapsed: %.1fs  Detected: %d  Expected: ~%d\n",
            elapsed, md->markers_detected, expected_markers);
     printf("Baseline: %.4f  Threshold: %.4f\n", md->baseline_energy, md->threshold);
@@ -218,32 +456,24 @@ void marker_detector_print_stats(marker_detector_t *md) {
 void marker_detector_log_metadata(marker_detector_t *md, uint64_t center_freq,
                                   uint32_t sample_rate, uint32_t gain_reduction,
                                   uint32_t lna_state) {
-    if (!md || !md->csv_file) return;
-
-    char time_str[64];
-    time_t now = time(NULL);
-    strftime(time_str, sizeof(time_str), "%H:%M:%S", localtime(&now));
+    if (!md || !md->csv_log) return;
 
-    float timestamp_ms = md->frame_count * FRAME_DURATION_MS;
+    double timestamp_ms = FRAME_TO_MS(md->frame_count);
 
-    fprintf(md->csv_file, "%s,%.1f,META,0,freq=%llu rate=%u GR=%u LNA=%u,0,0,0,0,0\n",
-            time_str, timestamp_ms,
-            (unsigned long long)center_freq, sample_rate, gain_reduction, lna_state);
-    fflush(md->csv_file);
+    wwv_csv_log_row_at(md->csv_log, time(NULL),
+                       "%.1f,META,0,freq=%llu rate=%u GR=%u LNA=%u,0,0,0,0,0\n",
+                       timestamp_ms,
+                       (unsigned long long)center_freq, sample_rate, gain_reduction, lna_state);
 }
 
 void marker_detector_log_display_gain(marker_detector_t *md, float display_gain) {
-    if (!md || !md->csv_file) return;
-
-    char time_str[64];
-    time_t now = time(NULL);
-    strftime(time_str, sizeof(time_str), "%H:%M:%S", localtime(&now));
+    if (!md || !md->csv_log) return;
 
-    float timestamp_ms = md->frame_count * FRAME_DURATION_MS;
+    double timestamp_ms = FRAME_TO_MS(md->frame_count);
 
-    fprintf(md->csv_file, "%s,%.1f,GAIN,0,display_gain=%+.0fdB,0,0,0,0,0\n",
-            time_str, timestamp_ms, display_gain);
-    fflush(md->csv_file);
+    wwv_csv_log_row_at(md->csv_log, time(NULL),
+                       "%.1f,GAIN,0,display_gain=%+.0fdB,0,0,0,0,0\n",
+                       timestamp_ms, display_gain);
 }
 
 float marker_detector_get_frame_duration_ms(void) {
@@ -276,8 +506,52 @@ float marker_detector_get_noise_adapt_rate(marker_detector_t *md) {
 void marker_detector_set_min_duration_ms(marker_detector_t *md, float ms) {
     if (!md || ms < 300.0f || ms > 700.0f) return;
     md->min_duration_ms = ms;
+    pulse_fsm_set_class(&md->pulse_params, 0, ms, MARKER_MAX_DURATION_MS);
 }
 
 float marker_detector_get_min_duration_ms(marker_detector_t *md) {
     return md ? md->min_duration_ms : 500.0f;
 }
+
+/*============================================================================
+ * Warm Start
+ *============================================================================*/
+
+#define MARKER_STATE_VERSION    1
+
+typedef struct {
+    float baseline_energy;
+    float threshold;
+    float threshold_multiplier;
+} marker_state_t;
+
+_Static_assert(sizeof(marker_state_t) == 12, "marker state layout");
+
+bool marker_detector_save_state(marker_detector_t *md, wwv_state_writer_t *w) {
+    /* Template mode relearns its off level within its 2 s window */
+    if (!md || !w || !md->warmup_complete || md->template_mode) return false;
+
+    marker_state_t st = {
+        .baseline_energy = md->baseline_energy,
+        .threshold = md->threshold,
+        .threshold_multiplier = md->threshold_multiplier
+    };
+    return wwv_state_put(w, WWV_STATE_MARKER_DETECTOR, MARKER_STATE_VERSION, &st, sizeof(st));
+}
+
+bool marker_detector_restore_state(marker_detector_t *md, const wwv_state_reader_t *r) {
+    if (!md || !r || md->template_mode || r->elapsed_ms > WWV_STATE_LEVELS_MAX_AGE_MS) return false;
+
+    marker_state_t st;
+    if (!wwv_state_get(r, WWV_STATE_MARKER_DETECTOR, MARKER_STATE_VERSION, &st, sizeof(st)) ||
+        !(st.baseline_energy > 0.0f)) {
+        return false;
+    }
+
+    md->baseline_energy = st.baseline_energy;
+    md->threshold = st.threshold;
+    marker_detector_set_threshold_mult(md, st.threshold_multiplier);
+    md->warmup_complete = true;
+    printf("[MARKER] Warm start: baseline=%.1f thresh=%.1f\n", md->baseline_energy, md->threshold);
+    return true;
+}
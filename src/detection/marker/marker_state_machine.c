@@ -2,9 +2,10 @@
  * @file marker_state_machine.c
  * @brief WWV minute marker detection state machine
  *
- * Implements 3-state FSM for marker pulse detection:
+ * Runs the shared 3-state pulse engine (pulse_fsm_internal.h) for marker
+ * pulse detection:
  *   - IDLE: Monitoring sliding window accumulator
- *   - IN_MARKER: Measuring pulse duration
+ *   - ACTIVE: Measuring pulse duration
  *   - COOLDOWN: Preventing re-triggering after pulse
  *
  * Uses sliding window accumulator over 1-second window to detect
@@ -13,6 +14,7 @@
 
 #include "detection/marker_internal.h"
 #include "telemetry.h"
+#include "telemetry_wire.h"
 #include <stdio.h>
 #include <math.h>
 
@@ -21,20 +23,84 @@
  *============================================================================*/
 
 /**
- * Update sliding window accumulator
- * Maintains sum of energy over last MARKER_WINDOW_FRAMES
+ * Update sliding window accumulators
+ * Every MARKER_WINDOW_* sum advances from the same frame energy
  */
 static void update_accumulator(marker_detector_t *md, float energy) {
-    if (md->history_count >= MARKER_WINDOW_FRAMES) {
-        md->accumulated_energy -= md->energy_history[md->history_idx];
-    }
+    sliding_sum_push(md->energy_sums, energy);
+    md->accumulated_energy = sliding_sum_get(md->energy_sums, md->window_id[MARKER_WINDOW_FULL]);
+}
+
+/*============================================================================
+ * Marker Report
+ *============================================================================*/
 
-    md->energy_history[md->history_idx] = energy;
-    md->accumulated_energy += energy;
+void marker_report(marker_detector_t *md, uint64_t end_sample, double onset_ms, float duration_ms,
+                   float peak, uint64_t start_frame) {
+    md->markers_detected++;
+    md->flash_frames_remaining = MARKER_FLASH_FRAMES;
+
+    double timestamp_ms = wwv_samples_to_ms(end_sample, MARKER_SAMPLE_RATE);
+    float since_last = (md->last_marker_frame > 0) ?
+        (start_frame - md->last_marker_frame) * FRAME_DURATION_MS / 1000.0f : 0.0f;
+
+    printf("[%7.1fs] *** MINUTE MARKER #%d ***  dur=%.0fms  since=%.1fs  accum=%.2f\n",
+           timestamp_ms / 1000.0f, md->markers_detected,
+           duration_ms, since_last, peak);
+
+    /* CSV logging and telemetry */
+    char time_str[16];
+    marker_get_wall_time_str(md, timestamp_ms, time_str, sizeof(time_str));
+    wwv_time_t wwv = md->wwv_clock ? wwv_clock_now(md->wwv_clock) : (wwv_time_t){0};
+
+    wwv_csv_log_row_at(md->csv_log, marker_get_wall_time(md, timestamp_ms),
+                       "%.1f,M%d,%d,%s,%.6f,%.1f,%.1f,%.6f,%.6f\n",
+                       timestamp_ms, md->markers_detected, wwv.second,
+                       wwv_event_name(wwv.expected_event),
+                       peak, duration_ms, since_last,
+                       md->baseline_energy, md->threshold);
+
+    /* UDP telemetry */
+    if (telem_ctx_binary_active(md->telem, TELEM_MARKERS)) {
+        telem_rec_marker_t rec = {
+            .number = (uint32_t)md->markers_detected,
+            .wwv_second = wwv.second,
+            .expected_event = (uint8_t)wwv.expected_event,
+            .peak_energy = peak,
+            .duration_ms = duration_ms,
+            .since_last_sec = since_last,
+            .baseline = md->baseline_energy,
+            .threshold = md->threshold
+        };
+        telem_ctx_send_record(md->telem, TELEM_MARKERS, TELEM_REC_MARKER,
+                          (uint32_t)marker_get_wall_time(md, timestamp_ms),
+                          telem_ms_to_us(timestamp_ms), &rec, sizeof(rec));
+    } else {
+        telem_ctx_sendf(md->telem, TELEM_MARKERS, "%s,%.1f,M%d,%d,%s,%.6f,%.1f,%.1f,%.6f,%.6f",
+                    time_str, timestamp_ms, md->markers_detected, wwv.second,
+                    wwv_event_name(wwv.expected_event),
+                    peak, duration_ms, since_last,
+                    md->baseline_energy, md->threshold);
+    }
 
-    md->history_idx = (md->history_idx + 1) % MARKER_WINDOW_FRAMES;
-    if (md->history_count < MARKER_WINDOW_FRAMES) {
-        md->history_count++;
+    md->last_marker_frame = start_frame;
+
+    /* Callback */
+    if (md->callback) {
+        marker_event_t event = {
+            .marker_number = md->markers_detected,
+            .timestamp_ms = timestamp_ms,
+            .onset_ms = onset_ms,
+            .sample_index = end_sample,
+            .since_last_marker_sec = since_last,
+            .accumulated_energy = md->accumulated_energy,
+            .peak_energy = peak,
+            .duration_ms = duration_ms
+        };
+        for (int w = 0; w < MARKER_WINDOW_COUNT; w++) {
+            event.window_energy[w] = sliding_sum_get(md->energy_sums, md->window_id[w]);
+        }
+        md->callback(&event, md->callback_user_data);
     }
 }
 
@@ -51,18 +117,17 @@ void marker_state_machine_run(marker_detector_t *md) {
     uint64_t frame = md->frame_count;
 
     update_accumulator(md, energy);
+    if (frame < md->refill_until) return;
 
     /* Debug logging - every 20th frame (~100ms) */
-    if (md->debug_file && (frame % 20 == 0)) {
-        char time_str[16];
-        marker_get_wall_time_str(md, frame * FRAME_DURATION_MS, time_str, sizeof(time_str));
+    if (md->debug_log && (frame % 20 == 0)) {
         const char *state_names[] = {"IDLE", "IN_MARKER", "COOLDOWN"};
         float ratio = (md->baseline_energy > 0.001f) ? md->accumulated_energy / md->baseline_energy : 0.0f;
-        fprintf(md->debug_file, "%s,%.1f,%s,%.1f,%.1f,%.1f,%.4f,%.2f\n",
-                time_str, frame * FRAME_DURATION_MS, state_names[md->state],
-                md->accumulated_energy, md->baseline_energy, md->threshold,
-                energy, ratio);
-        fflush(md->debug_file);
+        wwv_csv_log_row_at(md->debug_log, marker_get_wall_time(md, FRAME_TO_MS(frame)),
+                           "%.1f,%s,%.1f,%.1f,%.1f,%.4f,%.2f\n",
+                           FRAME_TO_MS(frame), state_names[md->pulse.state],
+                           md->accumulated_energy, md->baseline_energy, md->threshold,
+                           energy, ratio);
     }
 
     /* Warmup phase - fast adaptation to learn baseline */
@@ -79,7 +144,7 @@ void marker_state_machine_run(marker_detector_t *md) {
     }
 
     /* No markers in first few seconds - baseline still stabilizing */
-    float timestamp_ms = md->frame_count * FRAME_DURATION_MS;
+    double timestamp_ms = FRAME_TO_MS(md->frame_count);
     if (timestamp_ms < MARKER_MIN_STARTUP_MS) {
         md->baseline_energy += md->noise_adapt_rate * (md->accumulated_energy - md->baseline_energy);
         md->threshold = md->baseline_energy * md->threshold_multiplier;
@@ -87,96 +152,27 @@ void marker_state_machine_run(marker_detector_t *md) {
     }
 
     /* Self-track baseline during IDLE (proven approach from v133) */
-    if (md->state == STATE_IDLE) {
+    if (md->pulse.state == PULSE_IDLE) {
         md->baseline_energy += md->noise_adapt_rate * (md->accumulated_energy - md->baseline_energy);
         if (md->baseline_energy < 0.001f) md->baseline_energy = 0.001f;
         md->threshold = md->baseline_energy * md->threshold_multiplier;
     }
 
     /* State machine */
-    switch (md->state) {
-        case STATE_IDLE:
-            if (md->accumulated_energy > md->threshold) {
-                md->state = STATE_IN_MARKER;
-                md->marker_start_frame = frame;
-                md->marker_peak_energy = md->accumulated_energy;
-                md->marker_duration_frames = 1;
-            }
-            break;
-
-        case STATE_IN_MARKER:
-            md->marker_duration_frames++;
-            if (md->accumulated_energy > md->marker_peak_energy) {
-                md->marker_peak_energy = md->accumulated_energy;
-            }
-
-            /* Check for timeout */
-            float duration_ms = md->marker_duration_frames * FRAME_DURATION_MS;
-            bool timed_out = (duration_ms > MARKER_MAX_DURATION_MS);
-
-            if (md->accumulated_energy < md->threshold || timed_out) {
-                if (duration_ms >= md->min_duration_ms && duration_ms < MARKER_MAX_DURATION_MS) {
-                    /* Valid marker! */
-                    md->markers_detected++;
-                    md->flash_frames_remaining = MARKER_FLASH_FRAMES;
-
-                    float timestamp_ms = frame * FRAME_DURATION_MS;
-                    float since_last = (md->last_marker_frame > 0) ?
-                        (md->marker_start_frame - md->last_marker_frame) * FRAME_DURATION_MS / 1000.0f : 0.0f;
-
-                    printf("[%7.1fs] *** MINUTE MARKER #%d ***  dur=%.0fms  since=%.1fs  accum=%.2f\n",
-                           timestamp_ms / 1000.0f, md->markers_detected,
-                           duration_ms, since_last, md->marker_peak_energy);
-
-                    /* CSV logging and telemetry */
-                    char time_str[16];
-                    marker_get_wall_time_str(md, timestamp_ms, time_str, sizeof(time_str));
-                    wwv_time_t wwv = md->wwv_clock ? wwv_clock_now(md->wwv_clock) : (wwv_time_t){0};
-
-                    if (md->csv_file) {
-                        fprintf(md->csv_file, "%s,%.1f,M%d,%d,%s,%.6f,%.1f,%.1f,%.6f,%.6f\n",
-                                time_str, timestamp_ms, md->markers_detected, wwv.second,
-                                wwv_event_name(wwv.expected_event),
-                                md->marker_peak_energy, duration_ms, since_last,
-                                md->baseline_energy, md->threshold);
-                        fflush(md->csv_file);
-                    }
-
-                    /* UDP telemetry */
-                    telem_sendf(TELEM_MARKERS, "%s,%.1f,M%d,%d,%s,%.6f,%.1f,%.1f,%.6f,%.6f",
-                                time_str, timestamp_ms, md->markers_detected, wwv.second,
-                                wwv_event_name(wwv.expected_event),
-                                md->marker_peak_energy, duration_ms, since_last,
-                                md->baseline_energy, md->threshold);
-
-                    md->last_marker_frame = md->marker_start_frame;
-
-                    /* Callback */
-                    if (md->callback) {
-                        marker_event_t event = {
-                            .marker_number = md->markers_detected,
-                            .timestamp_ms = timestamp_ms,
-                            .since_last_marker_sec = since_last,
-                            .accumulated_energy = md->accumulated_energy,
-                            .peak_energy = md->marker_peak_energy,
-                            .duration_ms = duration_ms
-                        };
-                        md->callback(&event, md->callback_user_data);
-                    }
-                } else if (timed_out) {
-                    printf("[%7.1fs] MARKER timed out after %.0fms\n",
-                           frame * FRAME_DURATION_MS / 1000.0f, duration_ms);
-                }
-
-                md->state = STATE_COOLDOWN;
-                md->cooldown_frames = MS_TO_FRAMES(MARKER_COOLDOWN_MS);
-            }
-            break;
-
-        case STATE_COOLDOWN:
-            if (--md->cooldown_frames <= 0) {
-                md->state = STATE_IDLE;
-            }
-            break;
+    int events = pulse_fsm_step(&md->pulse, &md->pulse_params, md->accumulated_energy,
+                                md->threshold, md->threshold, frame);
+    if (events & PULSE_EV_STOP) {
+        float duration_ms = pulse_fsm_duration_ms(&md->pulse, &md->pulse_params);
+        bool timed_out = (events & PULSE_EV_TIMEOUT) != 0;
+
+        if (pulse_fsm_classify(&md->pulse, &md->pulse_params) == 0) {
+            /* Valid marker! */
+            double end_ms = FRAME_TO_MS(frame);
+            marker_report(md, FRAME_TO_SAMPLE(frame), end_ms - duration_ms, duration_ms,
+                          md->pulse.peak, md->pulse.start_frame);
+        } else if (timed_out) {
+            printf("[%7.1fs] MARKER timed out after %.0fms\n",
+                   frame * FRAME_DURATION_MS / 1000.0f, duration_ms);
+        }
     }
 }
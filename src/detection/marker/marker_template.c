@@ -0,0 +1,264 @@
+/**
+ * @file marker_template.c
+ * @brief Template-correlated minute marker detection
+ *
+ * The 1000 Hz bucket energy of each 5.12 ms frame is already the marker's
+ * envelope decimated to 195 Hz. Template mode correlates it against what
+ * the broadcast puts around second 0:
+ *
+ *   :59.0        :00.0          :00.8   :01.0
+ *     |  no tick   |  800 ms 1000 Hz  |quiet|  tick
+ *     |<-- pre --->|<----- on ------->|post |
+ *
+ * Three sliding sums ending at the newest frame give the on and off
+ * (pre + post) region means in O(1) a frame; the score is their
+ * difference over the tracked off level. An ordinary second has one tick
+ * in each region and scores near zero, a tone that outlasts the marker
+ * fills the off regions too, so only the marker plus its tick hole
+ * scores high.
+ *
+ * The peak score aligns the template to the frame. The edges are then
+ * placed inside their frames: a frame straddling an edge holds the
+ * fraction of the pulse its energy shows between the off and on levels,
+ * so the two frames around each crossing of the mid level locate it to
+ * a fraction of a frame.
+ */
+
+#include "detection/marker_internal.h"
+#include "wwv_arena.h"
+#include <math.h>
+#include <stdio.h>
+
+/*============================================================================
+ * Internal Configuration
+ *============================================================================*/
+
+#define TPL_PRE_FRAMES      MS_TO_FRAMES(MARKER_TPL_PRE_MS)         /* 195 */
+#define TPL_ON_FRAMES       MS_TO_FRAMES(MARKER_PULSE_MS)           /* 156 */
+#define TPL_POST_FRAMES     MS_TO_FRAMES(MARKER_TPL_POST_MS)        /* 39 */
+#define TPL_FRAMES          (TPL_PRE_FRAMES + TPL_ON_FRAMES + TPL_POST_FRAMES)
+#define TPL_OFF_FRAMES      (TPL_PRE_FRAMES + TPL_POST_FRAMES)
+#define TPL_HOLD_FRAMES     MS_TO_FRAMES(MARKER_TPL_HOLD_MS)
+#define TPL_RING            512     /* Power of two > TPL_FRAMES + hold + edge search */
+
+_Static_assert(TPL_RING >= TPL_FRAMES + TPL_HOLD_FRAMES + 2 * MARKER_TPL_EDGE_FRAMES + 2,
+               "template ring too short for the edge fit");
+
+struct marker_template {
+    sliding_sum_t *sums;            /* post, on + post, all: windows ending at the newest frame */
+    int win_post;
+    int win_on_post;
+    int win_all;
+    float ring[TPL_RING];           /* Frame energies by frame number, for the edge fit */
+    uint64_t frames;                /* Pushed since the last reset */
+    uint64_t warm_frames;           /* Frames before detection: full windows, then warmup */
+
+    float score;                    /* This frame */
+    float baseline;                 /* Off-region level, tracked while idle */
+
+    /* Peak search */
+    bool armed;
+    float peak_score;
+    uint64_t peak_frame;            /* Newest frame when the peak was scored */
+    float peak_on;                  /* Region means at the peak */
+    float peak_off;
+    uint64_t quiet_until;           /* No trigger before this frame (cooldown) */
+};
+
+/*============================================================================
+ * Lifecycle
+ *============================================================================*/
+
+marker_template_t *marker_template_create(void) {
+    marker_template_t *tpl = wwv_calloc(1, sizeof(*tpl));
+    if (!tpl) return NULL;
+
+    tpl->sums = sliding_sum_create(TPL_FRAMES);
+    if (!tpl->sums) {
+        wwv_free(tpl);
+        return NULL;
+    }
+    tpl->win_post = sliding_sum_add_window(tpl->sums, TPL_POST_FRAMES);
+    tpl->win_on_post = sliding_sum_add_window(tpl->sums, TPL_POST_FRAMES + TPL_ON_FRAMES);
+    tpl->win_all = sliding_sum_add_window(tpl->sums, TPL_FRAMES);
+    marker_template_reset(tpl);
+    return tpl;
+}
+
+void marker_template_destroy(marker_template_t *tpl) {
+    if (!tpl) return;
+    sliding_sum_destroy(tpl->sums);
+    wwv_free(tpl);
+}
+
+void marker_template_reset(marker_template_t *tpl) {
+    if (!tpl) return;
+    sliding_sum_reset(tpl->sums);
+    tpl->frames = 0;
+    tpl->warm_frames = TPL_FRAMES + MARKER_WARMUP_FRAMES;
+    tpl->score = 0.0f;
+    tpl->baseline = 0.0f;
+    tpl->armed = false;
+    tpl->quiet_until = 0;
+}
+
+/* Frames were not fed: refill the windows, keep the learned off level */
+void marker_template_skip(marker_template_t *tpl) {
+    if (!tpl) return;
+    bool warm = tpl->frames >= tpl->warm_frames;
+    sliding_sum_reset(tpl->sums);
+    tpl->frames = 0;
+    tpl->score = 0.0f;
+    tpl->armed = false;
+    if (warm) tpl->warm_frames = TPL_FRAMES;
+}
+
+float marker_template_get_score(const marker_template_t *tpl) {
+    return tpl ? tpl->score : 0.0f;
+}
+
+/*============================================================================
+ * Edge Fit
+ *============================================================================*/
+
+static float ring_at(const marker_template_t *tpl, uint64_t frame) {
+    return tpl->ring[frame & (TPL_RING - 1)];
+}
+
+/*
+ * Fraction of the frame the pulse covers, from its energy. The bucket is
+ * a magnitude, so a frame holds the Hann-weighted share of the pulse:
+ * a = x - sin(2 pi x) / 2 pi for a pulse covering x of either end of the
+ * frame, inverted by bisection.
+ */
+static float coverage(const marker_template_t *tpl, uint64_t frame) {
+    float span = tpl->peak_on - tpl->peak_off;
+    float a = (ring_at(tpl, frame) - tpl->peak_off) / span;
+    if (a <= 0.0f) return 0.0f;
+    if (a >= 1.0f) return 1.0f;
+
+    float lo = 0.0f, hi = 1.0f;
+    for (int k = 0; k < 16; k++) {
+        float x = 0.5f * (lo + hi);
+        if (x - sinf(2.0f * (float)M_PI * x) / (2.0f * (float)M_PI) < a) lo = x;
+        else hi = x;
+    }
+    return 0.5f * (lo + hi);
+}
+
+/**
+ * Leading and trailing edges in samples around the template's frames
+ * @param first, last First and last frame of the template's on region
+ */
+static void fit_edges(const marker_template_t *tpl, uint64_t first, uint64_t last,
+                      double *onset, double *end) {
+    const double frame = (double)MARKER_FFT_SIZE;
+    const float mid = 0.5f * (tpl->peak_on + tpl->peak_off);
+
+    /* Frame times as the detector counts them (see FRAME_TO_SAMPLE) */
+    *onset = (double)first * frame;
+    *end = (double)(last + 1) * frame;
+
+    for (uint64_t k = first - MARKER_TPL_EDGE_FRAMES; k <= first + MARKER_TPL_EDGE_FRAMES; k++) {
+        if (ring_at(tpl, k - 1) < mid && ring_at(tpl, k) >= mid) {
+            *onset = (double)(k + 1) * frame - frame * (coverage(tpl, k - 1) + coverage(tpl, k));
+            break;
+        }
+    }
+    for (uint64_t m = last + 1 - MARKER_TPL_EDGE_FRAMES; m <= last + 1 + MARKER_TPL_EDGE_FRAMES; m++) {
+        if (ring_at(tpl, m - 1) >= mid && ring_at(tpl, m) < mid) {
+            *end = (double)(m - 1) * frame + frame * (coverage(tpl, m - 1) + coverage(tpl, m));
+            break;
+        }
+    }
+}
+
+/*============================================================================
+ * Detection
+ *============================================================================*/
+
+/* The peak has held for TPL_HOLD_FRAMES: place the edges and report */
+static void decide(marker_detector_t *md, marker_template_t *tpl) {
+    uint64_t last = tpl->peak_frame - TPL_POST_FRAMES;
+    uint64_t first = last + 1 - TPL_ON_FRAMES;
+    double onset, end;
+    fit_edges(tpl, first, last, &onset, &end);
+
+    float duration_ms = (float)((end - onset) * 1000.0 / MARKER_SAMPLE_RATE);
+    tpl->armed = false;
+    if (duration_ms < md->min_duration_ms || duration_ms > MARKER_MAX_DURATION_MS) {
+        printf("[%7.1fs] MARKER template peak rejected: dur=%.0fms\n",
+               FRAME_TO_MS(md->frame_count) / 1000.0, duration_ms);
+        return;
+    }
+
+    uint64_t onset_frame = (uint64_t)(onset / MARKER_FFT_SIZE);
+    tpl->quiet_until = onset_frame + MS_TO_FRAMES(MARKER_COOLDOWN_MS);
+    /* Peak as the on region's sum, the sliding window's accumulated scale */
+    marker_report(md, (uint64_t)llround(end), onset * 1000.0 / MARKER_SAMPLE_RATE,
+                  duration_ms, tpl->peak_on * TPL_ON_FRAMES, onset_frame);
+}
+
+/**
+ * Template-mode counterpart of marker_state_machine_run(), once per frame
+ */
+void marker_template_run(marker_detector_t *md) {
+    marker_template_t *tpl = md->tpl;
+    float energy = md->current_energy;
+    uint64_t frame = md->frame_count;
+
+    sliding_sum_push(md->energy_sums, energy);
+    md->accumulated_energy = sliding_sum_get(md->energy_sums, md->window_id[MARKER_WINDOW_FULL]);
+    sliding_sum_push(tpl->sums, energy);
+    tpl->ring[frame & (TPL_RING - 1)] = energy;
+    if (++tpl->frames < TPL_FRAMES) return;
+
+    float post = sliding_sum_get(tpl->sums, tpl->win_post);
+    float on_post = sliding_sum_get(tpl->sums, tpl->win_on_post);
+    float all = sliding_sum_get(tpl->sums, tpl->win_all);
+    float mean_on = (on_post - post) / TPL_ON_FRAMES;
+    float mean_off = (all - on_post + post) / TPL_OFF_FRAMES;
+
+    /* Warmup: learn the off level fast, then only while idle */
+    bool warm = tpl->frames >= tpl->warm_frames;
+    if (!warm || !tpl->armed) {
+        float rate = warm ? md->noise_adapt_rate : MARKER_WARMUP_ADAPT_RATE;
+        tpl->baseline += (tpl->baseline > 0.0f ? rate : 1.0f) * (mean_off - tpl->baseline);
+        if (tpl->baseline < 1e-6f) tpl->baseline = 1e-6f;
+    }
+    md->baseline_energy = tpl->baseline;
+    md->threshold = tpl->baseline * md->threshold_multiplier;
+    tpl->score = (mean_on - mean_off) / tpl->baseline;
+
+    if (md->debug_log && (frame % 20 == 0)) {
+        wwv_csv_log_row_at(md->debug_log, marker_get_wall_time(md, FRAME_TO_MS(frame)),
+                           "%.1f,%s,%.1f,%.1f,%.1f,%.4f,%.2f\n",
+                           FRAME_TO_MS(frame), tpl->armed ? "TPL_PEAK" : "TPL_IDLE",
+                           mean_on, tpl->baseline, md->threshold, energy, tpl->score);
+    }
+
+    if (!warm) return;
+    if (!md->warmup_complete) {
+        md->warmup_complete = true;
+        printf("[MARKER] Template warmup complete. Off level=%.3f, trigger=%.3f\n",
+               tpl->baseline, md->threshold);
+    }
+    if (FRAME_TO_MS(frame) < MARKER_MIN_STARTUP_MS) return;
+
+    /* Marker at least (mult - 1) off levels above its surroundings */
+    float trigger = md->threshold_multiplier - 1.0f;
+    if (!tpl->armed) {
+        if (frame < tpl->quiet_until || tpl->score < trigger) return;
+        tpl->armed = true;
+        tpl->peak_score = -INFINITY;
+    }
+
+    if (tpl->score > tpl->peak_score) {
+        tpl->peak_score = tpl->score;
+        tpl->peak_frame = frame;
+        tpl->peak_on = mean_on;
+        tpl->peak_off = mean_off;
+    } else if (frame - tpl->peak_frame >= TPL_HOLD_FRAMES) {
+        decide(md, tpl);
+    }
+}
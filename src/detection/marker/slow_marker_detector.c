@@ -8,6 +8,7 @@
 
 #include "slow_marker_detector.h"
 #include "external/kiss_fft.h"
+#include "wwv_arena.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -35,7 +36,7 @@ struct slow_marker_detector {
     float current_energy;
     float current_snr_db;
     bool above_threshold;
-    float timestamp_ms;
+    double timestamp_ms;
 
     /* Callback */
     slow_marker_callback_fn callback;
@@ -43,7 +44,7 @@ struct slow_marker_detector {
 };
 
 slow_marker_detector_t *slow_marker_detector_create(void) {
-    slow_marker_detector_t *smd = calloc(1, sizeof(*smd));
+    slow_marker_detector_t *smd = wwv_calloc(1, sizeof(*smd));
     if (!smd) return NULL;
 
     smd->noise_floor = 0.01f;
@@ -56,12 +57,56 @@ slow_marker_detector_t *slow_marker_detector_create(void) {
 }
 
 void slow_marker_detector_destroy(slow_marker_detector_t *smd) {
-    free(smd);
+    wwv_free(smd);
+}
+
+/* Accumulate one frame's bucket energies; shared by both feeds */
+static void update(slow_marker_detector_t *smd, float signal_energy, float frame_noise,
+                   double timestamp_ms) {
+    /* Update noise floor (slow adaptation, only when not detecting) */
+    if (!smd->above_threshold) {
+        smd->noise_floor += NOISE_ADAPT_RATE * (frame_noise - smd->noise_floor);
+        if (smd->noise_floor < 0.0001f) smd->noise_floor = 0.0001f;
+    }
+
+    /* Update sliding accumulator */
+    if (smd->history_count >= SLOW_MARKER_ACCUM_FRAMES) {
+        smd->accumulated_energy -= smd->energy_history[smd->history_idx];
+    }
+    smd->energy_history[smd->history_idx] = signal_energy;
+    smd->accumulated_energy += signal_energy;
+    smd->history_idx = (smd->history_idx + 1) % SLOW_MARKER_ACCUM_FRAMES;
+    if (smd->history_count < SLOW_MARKER_ACCUM_FRAMES) {
+        smd->history_count++;
+    }
+
+    /* Update threshold and state */
+    smd->threshold = smd->noise_floor * SLOW_THRESHOLD_MULT * SLOW_MARKER_ACCUM_FRAMES;
+    smd->current_energy = smd->accumulated_energy;
+    smd->above_threshold = (smd->accumulated_energy > smd->threshold);
+    smd->timestamp_ms = timestamp_ms;
+
+    /* Calculate SNR */
+    float noise_sum = smd->noise_floor * SLOW_MARKER_ACCUM_FRAMES;
+    smd->current_snr_db = (noise_sum > 0.0001f) ?
+        20.0f * log10f(smd->accumulated_energy / noise_sum) : 0.0f;
+
+    /* Callback */
+    if (smd->callback) {
+        slow_marker_frame_t frame = {
+            .energy = smd->accumulated_energy,
+            .snr_db = smd->current_snr_db,
+            .noise_floor = smd->noise_floor,
+            .timestamp_ms = timestamp_ms,
+            .above_threshold = smd->above_threshold
+        };
+        smd->callback(&frame, smd->callback_user_data);
+    }
 }
 
 void slow_marker_detector_process_fft(slow_marker_detector_t *smd,
                                        const kiss_fft_cpx *fft_out,
-                                       float timestamp_ms) {
+                                       double timestamp_ms) {
     if (!smd || !fft_out) return;
 
     /* Extract tight 1000 Hz bucket energy */
@@ -105,45 +150,43 @@ void slow_marker_detector_process_fft(slow_marker_detector_t *smd,
     /* Per-frame noise estimate */
     float frame_noise = (noise_bins > 0) ? noise_energy / noise_bins : 0.001f;
 
-    /* Update noise floor (slow adaptation, only when not detecting) */
-    if (!smd->above_threshold) {
-        smd->noise_floor += NOISE_ADAPT_RATE * (frame_noise - smd->noise_floor);
-        if (smd->noise_floor < 0.0001f) smd->noise_floor = 0.0001f;
-    }
+    update(smd, signal_energy, frame_noise, timestamp_ms);
+}
 
-    /* Update sliding accumulator */
-    if (smd->history_count >= SLOW_MARKER_ACCUM_FRAMES) {
-        smd->accumulated_energy -= smd->energy_history[smd->history_idx];
-    }
-    smd->energy_history[smd->history_idx] = signal_energy;
-    smd->accumulated_energy += signal_energy;
-    smd->history_idx = (smd->history_idx + 1) % SLOW_MARKER_ACCUM_FRAMES;
-    if (smd->history_count < SLOW_MARKER_ACCUM_FRAMES) {
-        smd->history_count++;
-    }
+void slow_marker_detector_process_magnitudes(slow_marker_detector_t *smd,
+                                              const float *magnitudes, int fft_size,
+                                              double timestamp_ms) {
+    if (!smd || !magnitudes || fft_size <= 0) return;
 
-    /* Update threshold and state */
-    smd->threshold = smd->noise_floor * SLOW_THRESHOLD_MULT * SLOW_MARKER_ACCUM_FRAMES;
-    smd->current_energy = smd->accumulated_energy;
-    smd->above_threshold = (smd->accumulated_energy > smd->threshold);
-    smd->timestamp_ms = timestamp_ms;
+    /* Same Hz buckets at the caller's resolution */
+    float hz_per_bin = (float)SLOW_MARKER_SAMPLE_RATE / fft_size;
+    int center_bin = (int)(SLOW_MARKER_TARGET_HZ / hz_per_bin + 0.5f);
+    int bin_span = (int)(SLOW_MARKER_BANDWIDTH_HZ / 2.0f / hz_per_bin + 0.5f);
 
-    /* Calculate SNR */
-    float noise_sum = smd->noise_floor * SLOW_MARKER_ACCUM_FRAMES;
-    smd->current_snr_db = (noise_sum > 0.0001f) ?
-        20.0f * log10f(smd->accumulated_energy / noise_sum) : 0.0f;
+    float signal_energy = 0.0f;
+    float noise_energy = 0.0f;
+    int noise_bins = 0;
 
-    /* Callback */
-    if (smd->callback) {
-        slow_marker_frame_t frame = {
-            .energy = smd->accumulated_energy,
-            .snr_db = smd->current_snr_db,
-            .noise_floor = smd->noise_floor,
-            .timestamp_ms = timestamp_ms,
-            .above_threshold = smd->above_threshold
-        };
-        smd->callback(&frame, smd->callback_user_data);
+    for (int b = -bin_span; b <= bin_span; b++) {
+        int bin = center_bin + b;
+        if (bin >= 0 && bin < fft_size / 2) {
+            signal_energy += magnitudes[bin] / fft_size;
+        }
     }
+    /* A finer FFT spreads the bucket over more bins; keep the 2048-pt scale */
+    signal_energy *= (float)SLOW_MARKER_FFT_SIZE / fft_size;
+
+    for (int offset = -3; offset <= 3; offset++) {
+        if (offset > -2 && offset < 2) continue;
+        int bin = center_bin + offset * bin_span;
+        if (bin >= 0 && bin < fft_size / 2) {
+            noise_energy += magnitudes[bin] / fft_size;
+            noise_bins++;
+        }
+    }
+
+    float frame_noise = (noise_bins > 0) ? noise_energy / noise_bins : 0.001f;
+    update(smd, signal_energy, frame_noise, timestamp_ms);
 }
 
 void slow_marker_detector_set_callback(slow_marker_detector_t *smd,
@@ -164,3 +207,32 @@ float slow_marker_detector_get_current_energy(slow_marker_detector_t *smd) {
 bool slow_marker_detector_is_above_threshold(slow_marker_detector_t *smd) {
     return smd ? smd->above_threshold : false;
 }
+
+/*============================================================================
+ * Warm Start
+ *============================================================================*/
+
+#define SLOW_MARKER_STATE_VERSION   1
+
+typedef struct {
+    float noise_floor;
+} slow_marker_state_t;
+
+bool slow_marker_detector_save_state(slow_marker_detector_t *smd, wwv_state_writer_t *w) {
+    if (!smd || !w) return false;
+    slow_marker_state_t st = { .noise_floor = smd->noise_floor };
+    return wwv_state_put(w, WWV_STATE_SLOW_MARKER, SLOW_MARKER_STATE_VERSION, &st, sizeof(st));
+}
+
+bool slow_marker_detector_restore_state(slow_marker_detector_t *smd, const wwv_state_reader_t *r) {
+    if (!smd || !r || r->elapsed_ms > WWV_STATE_LEVELS_MAX_AGE_MS) return false;
+
+    slow_marker_state_t st;
+    if (!wwv_state_get(r, WWV_STATE_SLOW_MARKER, SLOW_MARKER_STATE_VERSION, &st, sizeof(st)) ||
+        !(st.noise_floor > 0.0f)) {
+        return false;
+    }
+    smd->noise_floor = st.noise_floor;
+    smd->threshold = smd->noise_floor * SLOW_THRESHOLD_MULT * SLOW_MARKER_ACCUM_FRAMES;
+    return true;
+}
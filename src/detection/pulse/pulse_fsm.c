@@ -0,0 +1,63 @@
+/**
+ * @file pulse_fsm.c
+ * @brief Frame-count setup for the pulse engine
+ */
+
+#include "pulse_fsm_internal.h"
+
+/*============================================================================
+ * Internal Helpers
+ *============================================================================*/
+
+/*
+ * Stepped with the products the detectors compute (int frames * float
+ * frame_ms), never divided, so a boundary lands on the same frame as the
+ * float comparison it replaces.
+ */
+
+/* Most frames n with n * frame_ms <= ms (0 if none) */
+static int frames_at_most(float frame_ms, float ms) {
+    int n = (int)(ms / frame_ms);
+    if (n < 0) n = 0;
+    while ((n + 1) * frame_ms <= ms) n++;
+    while (n > 0 && n * frame_ms > ms) n--;
+    return n;
+}
+
+/* Fewest frames n with n * frame_ms >= ms */
+static int frames_at_least(float frame_ms, float ms) {
+    int n = frames_at_most(frame_ms, ms);
+    while (n * frame_ms < ms) n++;
+    return n;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+void pulse_fsm_params_init(pulse_fsm_params_t *p, float frame_ms, int min_low_frames,
+                           float timeout_ms, float cooldown_ms) {
+    if (!p || frame_ms <= 0.0f) return;
+
+    p->frame_ms = frame_ms;
+    p->min_low_frames = (min_low_frames > 0) ? min_low_frames : 1;
+    p->timeout_frames = (timeout_ms > 0.0f) ? frames_at_most(frame_ms, timeout_ms)
+                                            : PULSE_FSM_NO_TIMEOUT;
+    p->cooldown_frames = (int)(cooldown_ms / frame_ms + 0.5f);
+    p->class_count = 0;
+}
+
+void pulse_fsm_set_class(pulse_fsm_params_t *p, int c, float min_ms, float max_ms) {
+    if (!p || c < 0 || c >= PULSE_FSM_MAX_CLASSES) return;
+
+    int lo = frames_at_least(p->frame_ms, min_ms);
+    int hi = frames_at_most(p->frame_ms, max_ms);
+    if (hi >= lo) {
+        p->class_min[c] = lo;
+        p->class_span[c] = hi - lo;
+    } else {
+        p->class_min[c] = INT_MAX;      /* Empty: no duration gets there */
+        p->class_span[c] = 0;
+    }
+    if (p->class_count <= c) p->class_count = c + 1;
+}
@@ -3,11 +3,27 @@
  * @brief Matched filter correlation for WWV tick detection
  *
  * Implements 5ms complex correlation using cosine/sine templates
- * at the target frequency. Maintains circular buffer and tracks
- * correlation noise floor for threshold decisions.
+ * at each station's tick frequency over one shared circular buffer.
+ *
+ * Two modes:
+ *   - SLIDING (default): the Hann-windowed template is split into three
+ *     rectangular-window DFT bins (f0, f0 +/- one window period) which
+ *     are updated recursively, giving a correlation every sample in O(1)
+ *   - REFERENCE: direct 250-tap multiply-accumulate every CORR_DECIMATION
+ *     samples, kept for output comparison; the MAC runs on the SIMD kernel
+ *     selected for channel_filters_get_simd() (tick_correlation_simd.c)
+ *
+ * Either way, an accepted tick's epoch is refined from the buffer with the
+ * same MAC kernel (see Epoch Refinement).
+ *
+ * A baseband detector runs the same code on the 3125 Hz upper sideband:
+ * 16-tap templates at the station's offset from BASEBAND_MIX_HZ, a 128
+ * sample ring (the same 41 ms), and the reference MAC every sample.
  */
 
 #include "detection/tick_internal.h"
+#include "core/dsp_tables.h"
+#include "wwv_thread.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
@@ -16,49 +32,240 @@
  * Template Generation
  *============================================================================*/
 
+/* Templates (one per station) depend only on compile-time constants, so
+ * every detector instance shares one copy: the baked table (dsp_tables.h)
+ * when there is one, else built on first use under g_template_lock.
+ * Stored aligned and front-padded with zeros to a whole number of 8-float
+ * vectors, so the kernels' template loads are aligned and need no tail;
+ * the zero taps meet the samples just before the template span. */
+#define CORR_TAPS   DSP_TEMPLATE_TAPS(TICK_TEMPLATE_SAMPLES)
+#define CORR_PAD    (CORR_TAPS - TICK_TEMPLATE_SAMPLES)
+#define BB_TAPS     DSP_TEMPLATE_TAPS(TICK_BASEBAND_TEMPLATE_SAMPLES)
+#define BB_PAD      (BB_TAPS - TICK_BASEBAND_TEMPLATE_SAMPLES)
+#define BB_RING     (TICK_CORR_BUFFER_SIZE / BASEBAND_DECIMATION)
+
+_Static_assert(CORR_TAPS <= TICK_CORR_BUFFER_SIZE, "padded template longer than the ring");
+_Static_assert(BB_TAPS <= BB_RING, "padded baseband template longer than the ring");
+_Static_assert(DSP_TABLES_ALIGN % TICK_CORR_ALIGN == 0, "baked templates under-aligned for the kernels");
+
+static _Alignas(TICK_CORR_ALIGN) float g_template_i[TICK_MAX_STATIONS][CORR_TAPS];
+static _Alignas(TICK_CORR_ALIGN) float g_template_q[TICK_MAX_STATIONS][CORR_TAPS];
+static const float *g_templates[TICK_MAX_STATIONS][2];     /* [station][I, Q] */
+static _Alignas(TICK_CORR_ALIGN) float g_bb_template_i[TICK_MAX_STATIONS][BB_TAPS];
+static _Alignas(TICK_CORR_ALIGN) float g_bb_template_q[TICK_MAX_STATIONS][BB_TAPS];
+static bool g_template_ready = false;
+static wwv_mutex_t g_template_lock = WWV_MUTEX_INITIALIZER;
+
+static int station_freq_hz(wwv_station_t station) {
+    return (station == WWV_STATION_WWVH) ? TICK_WWVH_FREQ_HZ : TICK_TARGET_FREQ_HZ;
+}
+
 /**
- * Generate complex correlation template (Hann-windowed tone)
+ * Generate complex correlation templates (Hann-windowed tone), one per station
  * Template is 5ms of target frequency with smooth windowing
  */
-static void generate_template(tick_detector_t *td) {
-    for (int i = 0; i < TICK_TEMPLATE_SAMPLES; i++) {
-        float t = (float)i / TICK_SAMPLE_RATE;
-        /* Hann window for smooth edges */
-        float window = 0.5f * (1.0f - cosf(2.0f * M_PI * i / (TICK_TEMPLATE_SAMPLES - 1)));
-        /* Complex tone at target frequency */
-        td->template_i[i] = cosf(2.0f * M_PI * TICK_TARGET_FREQ_HZ * t) * window;
-        td->template_q[i] = sinf(2.0f * M_PI * TICK_TARGET_FREQ_HZ * t) * window;
+static void generate_templates(void) {
+    wwv_mutex_lock(&g_template_lock);
+    if (!g_template_ready) {
+        for (int st = 0; st < TICK_MAX_STATIONS; st++) {
+            int hz = station_freq_hz((wwv_station_t)st);
+            g_templates[st][0] = dsp_tables_tick_template(hz, false);
+            g_templates[st][1] = dsp_tables_tick_template(hz, true);
+            if (g_templates[st][0] && g_templates[st][1]) continue;
+
+            /* Hann-windowed complex tone at the station frequency */
+            for (int i = 0; i < TICK_TEMPLATE_SAMPLES; i++) {
+                dsp_tone_template_coeff(i, TICK_TEMPLATE_SAMPLES, hz, TICK_SAMPLE_RATE,
+                                        &g_template_i[st][CORR_PAD + i],
+                                        &g_template_q[st][CORR_PAD + i]);
+            }
+            g_templates[st][0] = g_template_i[st];
+            g_templates[st][1] = g_template_q[st];
+        }
+        /* Baseband: the same window over 16 taps, tone at the offset from the mix */
+        for (int st = 0; st < TICK_MAX_STATIONS; st++) {
+            double hz = station_freq_hz((wwv_station_t)st) - (double)BASEBAND_MIX_HZ;
+            for (int i = 0; i < TICK_BASEBAND_TEMPLATE_SAMPLES; i++) {
+                double window = 0.5 * (1.0 - cos(2.0 * M_PI * i / (TICK_BASEBAND_TEMPLATE_SAMPLES - 1)));
+                double ph = 2.0 * M_PI * hz * i / BASEBAND_RATE;
+                g_bb_template_i[st][BB_PAD + i] = (float)(cos(ph) * window);
+                g_bb_template_q[st][BB_PAD + i] = (float)(sin(ph) * window);
+            }
+        }
+        g_template_ready = true;
     }
+    wwv_mutex_unlock(&g_template_lock);
 }
 
 /*============================================================================
- * Correlation Computation
+ * Reference Correlation (direct MAC)
  *============================================================================*/
 
+/* Padded template length for the detector's stream */
+static int corr_taps(const tick_detector_t *td) {
+    return DSP_TEMPLATE_TAPS(td->stream.template_samples);
+}
+
+/**
+ * Correlation magnitude for the template span ending `age` samples before
+ * the newest (oldest sample first, contiguous in the mirrored ring)
+ */
+static float correlation_at(tick_detector_t *td, int s, int age) {
+    float sum_i, sum_q;
+    const int taps = corr_taps(td);
+    const float *sig_i = wwv_window_ring_recent(&td->corr_ring_i, taps + age);
+    const float *sig_q = wwv_window_ring_recent(&td->corr_ring_q, taps + age);
+
+    td->corr_dot(td->ch[s].template_i, td->ch[s].template_q, sig_i, sig_q, taps,
+                 &sum_i, &sum_q);
+    return sqrtf(sum_i * sum_i + sum_q * sum_q) * td->stream.corr_scale;
+}
+
 /**
- * Compute correlation magnitude at current buffer position
+ * Compute correlation magnitude for station channel s at current buffer position
  * Returns magnitude of complex correlation
  */
-static float compute_correlation(tick_detector_t *td) {
-    float sum_i = 0.0f;
-    float sum_q = 0.0f;
-
-    /* Correlate template with buffer (complex multiply and accumulate) */
-    for (int i = 0; i < TICK_TEMPLATE_SAMPLES; i++) {
-        /* Index into circular buffer, starting from oldest sample */
-        int buf_idx = (td->corr_buf_idx - TICK_TEMPLATE_SAMPLES + i + TICK_CORR_BUFFER_SIZE) % TICK_CORR_BUFFER_SIZE;
-
-        float sig_i = td->corr_buf_i[buf_idx];
-        float sig_q = td->corr_buf_q[buf_idx];
-        float tpl_i = td->template_i[i];
-        float tpl_q = td->template_q[i];
-
-        /* Complex multiply: (sig_i + j*sig_q) * (tpl_i - j*tpl_q) */
-        sum_i += sig_i * tpl_i + sig_q * tpl_q;
-        sum_q += sig_q * tpl_i - sig_i * tpl_q;
+static float compute_correlation(tick_detector_t *td, int s) {
+    return correlation_at(td, s, 0);
+}
+
+/*============================================================================
+ * Epoch Refinement
+ *
+ * The state machine only places a tick to an FFT frame. Once one is
+ * accepted, the correlation is evaluated every sample while that span is
+ * still in the buffer: a scan at corr_step steps for the peak, then back
+ * down its rising side to the half-height crossing, interpolated between
+ * the two samples that straddle it. The Hann template makes the peak of a
+ * square-edged pulse nearly flat, but its rising side is steep, and the
+ * symmetric window reaches half height when the template's centre meets
+ * the pulse's first sample - so the crossing is the leading edge whatever
+ * the pulse length. About a hundred template correlations per accepted tick.
+ *============================================================================*/
+
+/**
+ * Refine a tick's pulse start to a fraction of a sample
+ * The template span at the correlation peak ends between the start frame's
+ * first sample and one template after the frame.
+ * @param pulse_start Receives the pulse's first input sample (TICK_SAMPLE_RATE), fractional
+ * @return false if the peak or its rising side has left the buffer
+ */
+bool tick_correlation_refine_epoch(tick_detector_t *td, int s, uint64_t start_frame,
+                                   double *pulse_start) {
+    const tick_stream_t *st = &td->stream;
+    const int step = st->corr_step;
+    const int ring = TICK_CORR_BUFFER_SIZE / st->decimation;
+    const int max_age = ring - corr_taps(td);
+    if (td->corr_sample_count < (wwv_sample_t)ring) return false;
+
+    wwv_sample_t first_end = (wwv_sample_t)start_frame * st->frame_samples;
+    wwv_sample_t last_end = (wwv_sample_t)(start_frame + 1) * st->frame_samples +
+                            st->template_samples - 2;
+
+    wwv_sample_t newest = td->corr_sample_count - 1;
+    wwv_sample_t oldest = newest - max_age;
+    if (last_end > newest) last_end = newest;
+    if (first_end < oldest) first_end = oldest;
+    if (first_end > last_end) return false;
+
+    wwv_sample_t best = first_end;
+    float peak = -1.0f;
+    for (wwv_sample_t end = first_end; end <= last_end; end += step) {
+        float c = correlation_at(td, s, (int)(newest - end));
+        if (c > peak) { peak = c; best = end; }
     }
 
-    return sqrtf(sum_i * sum_i + sum_q * sum_q);
+    /* Half height above the noise; coarse steps down, then single samples */
+    float floor = td->corr[s].corr_noise_floor;
+    if (floor >= peak) floor = 0.0f;
+    float half = floor + 0.5f * (peak - floor);
+
+    wwv_sample_t above = best;
+    float c_above = peak;
+    while (above >= oldest + step) {
+        float c = correlation_at(td, s, (int)(newest - (above - step)));
+        if (c < half) break;
+        above -= step;
+        c_above = c;
+    }
+    for (;;) {
+        if (above == oldest) return false;
+        float c = correlation_at(td, s, (int)(newest - (above - 1)));
+        if (c < half) {
+            double frac = (c_above > c) ? (double)(half - c) / (c_above - c) : 1.0;
+            double start = (double)(above - 1) + frac - (st->template_samples - 1) * 0.5;
+            *pulse_start = tick_stream_to_input(td, start);
+            return true;
+        }
+        above--;
+        c_above = c;
+    }
+}
+
+/*============================================================================
+ * Sliding DFT Correlation
+ *
+ * Hann window w[k] = 0.5 - 0.5*cos(a*k), a = 2*pi/(N-1), so
+ *   w[k]*e^{-j*w0*k} = 0.5*e^{-j*w0*k} - 0.25*e^{-j(w0+a)k} - 0.25*e^{-j(w0-a)k}
+ * and the template correlation is a weighted sum of three sliding DFT bins
+ *   S_b(n) = sum_{k=0}^{N-1} x[n-N+1+k] * e^{-j*b*k}
+ * each updated per sample as
+ *   S_b(n) = (S_b(n-1) - x[n-N]) * e^{j*b} + x[n] * e^{-j*b*(N-1)}
+ * State is double precision and re-seeded from the buffer periodically so
+ * rounding error on the unit-circle pole cannot accumulate. Each station
+ * owns TICK_SDFT_BINS consecutive bins around its own w0; the input sample
+ * and the one leaving the window are shared.
+ *============================================================================*/
+
+static const float sdft_weight[TICK_SDFT_BINS] = { 0.5f, -0.25f, -0.25f };
+
+static void sdft_init_twiddles(tick_detector_t *td) {
+    const int n = td->stream.template_samples;
+    const double a = 2.0 * M_PI / (n - 1);
+    const double mix_hz = td->fft_lower ? (double)BASEBAND_MIX_HZ : 0.0;
+
+    for (int s = 0; s < td->station_count; s++) {
+        const double w0 = 2.0 * M_PI * (td->ch[s].target_hz - mix_hz) / tick_stream_rate(td);
+        const double bins[TICK_SDFT_BINS] = { w0, w0 + a, w0 - a };
+
+        for (int b = 0; b < TICK_SDFT_BINS; b++) {
+            tick_sdft_bin_t *bin = &td->sdft[s * TICK_SDFT_BINS + b];
+            bin->rot_re = cos(bins[b]);
+            bin->rot_im = sin(bins[b]);
+            bin->in_re = cos(bins[b] * (n - 1));
+            bin->in_im = -sin(bins[b] * (n - 1));
+        }
+    }
+}
+
+/**
+ * Recompute all bins directly from the newest N samples in the buffer
+ */
+static void sdft_resync(tick_detector_t *td) {
+    const int n = td->stream.template_samples;
+    const float *sig_i = wwv_window_ring_recent(&td->corr_ring_i, n);
+    const float *sig_q = wwv_window_ring_recent(&td->corr_ring_q, n);
+
+    for (int b = 0; b < td->station_count * TICK_SDFT_BINS; b++) {
+        tick_sdft_bin_t *bin = &td->sdft[b];
+        /* Twiddle e^{-j*b*k}, advanced by conj(rot) each tap */
+        double tw_re = 1.0, tw_im = 0.0;
+        double s_re = 0.0, s_im = 0.0;
+        for (int k = 0; k < n; k++) {
+            double x_re = sig_i[k];
+            double x_im = sig_q[k];
+            s_re += x_re * tw_re - x_im * tw_im;
+            s_im += x_re * tw_im + x_im * tw_re;
+
+            double t_re = tw_re * bin->rot_re + tw_im * bin->rot_im;
+            tw_im = tw_im * bin->rot_re - tw_re * bin->rot_im;
+            tw_re = t_re;
+        }
+        bin->re = s_re;
+        bin->im = s_im;
+    }
+
+    td->sdft_resync_countdown = TICK_SDFT_RESYNC_SAMPLES / td->stream.decimation;
 }
 
 /*============================================================================
@@ -67,30 +274,91 @@ static float compute_correlation(tick_detector_t *td) {
 
 /**
  * Initialize correlation resources
- * Called from tick_detector_create()
+ * Called from tick_detector_create_stations() once the channels are set up
+ * @return false on allocation failure
+ */
+bool tick_correlation_init(tick_detector_t *td) {
+    /* Shared templates, per-instance circular buffer */
+    generate_templates();
+    for (int s = 0; s < td->station_count; s++) {
+        wwv_station_t st = td->ch[s].station;
+        td->ch[s].template_i = td->fft_lower ? g_bb_template_i[st] : g_templates[st][0];
+        td->ch[s].template_q = td->fft_lower ? g_bb_template_q[st] : g_templates[st][1];
+    }
+    td->corr_dot = tick_corr_select_kernel(channel_filters_get_simd());
+    const int ring = TICK_CORR_BUFFER_SIZE / td->stream.decimation;
+    if (!wwv_window_ring_init(&td->corr_ring_i, ring) ||
+        !wwv_window_ring_init(&td->corr_ring_q, ring)) {
+        return false;
+    }
+
+    td->corr_sample_count = 0;
+    for (int s = 0; s < td->station_count; s++) td->corr[s].corr_noise_floor = 0.0f;
+
+    /* Sliding DFT state (buffer is zeroed, so bins start at zero) */
+    td->corr_mode = TICK_CORR_MODE_SLIDING;
+    memset(td->sdft, 0, sizeof(td->sdft));
+    sdft_init_twiddles(td);
+    td->sdft_resync_countdown = TICK_SDFT_RESYNC_SAMPLES / td->stream.decimation;
+
+    return true;
+}
+
+/**
+ * Compute correlation value for station channel s
+ * Called from tick_detector_process_sample() every corr_step samples
+ * (reference mode)
  */
-void tick_correlation_init(tick_detector_t *td) {
-    /* Allocate matched filter resources */
-    td->template_i = (float *)malloc(TICK_TEMPLATE_SAMPLES * sizeof(float));
-    td->template_q = (float *)malloc(TICK_TEMPLATE_SAMPLES * sizeof(float));
-    td->corr_buf_i = (float *)malloc(TICK_CORR_BUFFER_SIZE * sizeof(float));
-    td->corr_buf_q = (float *)malloc(TICK_CORR_BUFFER_SIZE * sizeof(float));
-
-    if (td->template_i && td->template_q && td->corr_buf_i && td->corr_buf_q) {
-        /* Initialize matched filter */
-        generate_template(td);
-        memset(td->corr_buf_i, 0, TICK_CORR_BUFFER_SIZE * sizeof(float));
-        memset(td->corr_buf_q, 0, TICK_CORR_BUFFER_SIZE * sizeof(float));
-        td->corr_buf_idx = 0;
-        td->corr_sample_count = 0;
-        td->corr_noise_floor = 0.0f;
+float tick_correlation_compute(tick_detector_t *td, int s) {
+    return compute_correlation(td, s);
+}
+
+/**
+ * Push one sample through the sliding DFT and into the circular buffer
+ * Called from tick_detector_process_sample() every sample (sliding mode)
+ * @param corr Receives one correlation magnitude per station for the
+ *             template span ending at this sample
+ */
+void tick_correlation_slide(tick_detector_t *td, float i_sample, float q_sample, float *corr) {
+    /* x[n-N] is still in the buffer because it is larger than the template */
+    const int n = td->stream.template_samples;
+    double old_re = wwv_window_ring_recent(&td->corr_ring_i, n)[0];
+    double old_im = wwv_window_ring_recent(&td->corr_ring_q, n)[0];
+
+    wwv_window_ring_push(&td->corr_ring_i, i_sample);
+    wwv_window_ring_push(&td->corr_ring_q, q_sample);
+    td->corr_sample_count++;
+
+    const int bins = td->station_count * TICK_SDFT_BINS;
+    if (--td->sdft_resync_countdown <= 0) {
+        sdft_resync(td);
+    } else {
+        for (int b = 0; b < bins; b++) {
+            tick_sdft_bin_t *bin = &td->sdft[b];
+            double d_re = bin->re - old_re;
+            double d_im = bin->im - old_im;
+            bin->re = d_re * bin->rot_re - d_im * bin->rot_im
+                    + i_sample * bin->in_re - q_sample * bin->in_im;
+            bin->im = d_re * bin->rot_im + d_im * bin->rot_re
+                    + i_sample * bin->in_im + q_sample * bin->in_re;
+        }
+    }
+
+    for (int s = 0; s < td->station_count; s++) {
+        const tick_sdft_bin_t *bin = &td->sdft[s * TICK_SDFT_BINS];
+        float sum_i = 0.0f;
+        float sum_q = 0.0f;
+        for (int b = 0; b < TICK_SDFT_BINS; b++) {
+            sum_i += sdft_weight[b] * (float)bin[b].re;
+            sum_q += sdft_weight[b] * (float)bin[b].im;
+        }
+        corr[s] = sqrtf(sum_i * sum_i + sum_q * sum_q) * td->stream.corr_scale;
     }
 }
 
 /**
- * Compute correlation value
- * Called from tick_detector_process_sample() every CORR_DECIMATION samples
+ * Force a sliding DFT re-seed on the next sample (after a mode switch)
  */
-float tick_correlation_compute(tick_detector_t *td) {
-    return compute_correlation(td);
+void tick_correlation_reset_sliding(tick_detector_t *td) {
+    td->sdft_resync_countdown = 1;
 }
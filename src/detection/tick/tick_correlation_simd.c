@@ -0,0 +1,156 @@
+/**
+ * @file tick_correlation_simd.c
+ * @brief Vector kernels for the tick matched filter
+ *
+ * Complex dot product over split I/Q arrays. The template is aligned and
+ * zero-padded to a whole number of vectors (tick_correlation.c), so its
+ * loads are aligned; the signal span comes from the mirrored ring at an
+ * arbitrary offset and uses unaligned loads. Each kernel keeps the four
+ * real products in separate accumulators so no add waits on another, and
+ * finishes with a horizontal sum plus a scalar tail.
+ */
+
+#include "detection/tick_corr_internal.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TC_HAVE_SSE2 1
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#define TC_HAVE_AVX2 1
+#define TC_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER)
+#define TC_HAVE_AVX2 1
+#define TC_TARGET_AVX2
+#endif
+#elif defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#define TC_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+/*============================================================================
+ * Scalar Kernel
+ *============================================================================*/
+
+void tick_corr_dot_scalar(const float *ti, const float *tq,
+                          const float *xi, const float *xq,
+                          int n, float *re, float *im) {
+    float sum_i = 0.0f;
+    float sum_q = 0.0f;
+
+    /* Complex multiply: (sig_i + j*sig_q) * (tpl_i - j*tpl_q) */
+    for (int k = 0; k < n; k++) {
+        sum_i += xi[k] * ti[k] + xq[k] * tq[k];
+        sum_q += xq[k] * ti[k] - xi[k] * tq[k];
+    }
+    *re = sum_i;
+    *im = sum_q;
+}
+
+/* Remaining taps after the last whole vector */
+static void dot_tail(const float *ti, const float *tq, const float *xi, const float *xq,
+                     int k, int n, float *re, float *im) {
+    for (; k < n; k++) {
+        *re += xi[k] * ti[k] + xq[k] * tq[k];
+        *im += xq[k] * ti[k] - xi[k] * tq[k];
+    }
+}
+
+/*============================================================================
+ * Vector Kernels
+ *============================================================================*/
+
+#ifdef TC_HAVE_SSE2
+static float hsum_sse2(__m128 v) {
+    __m128 s = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return _mm_cvtss_f32(s);
+}
+
+static void dot_sse2(const float *ti, const float *tq, const float *xi, const float *xq,
+                     int n, float *re, float *im) {
+    __m128 ii = _mm_setzero_ps(), qq = _mm_setzero_ps();
+    __m128 qi = _mm_setzero_ps(), iq = _mm_setzero_ps();
+    int k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m128 a = _mm_load_ps(ti + k), b = _mm_load_ps(tq + k);
+        __m128 x = _mm_loadu_ps(xi + k), y = _mm_loadu_ps(xq + k);
+        ii = _mm_add_ps(ii, _mm_mul_ps(x, a));
+        qq = _mm_add_ps(qq, _mm_mul_ps(y, b));
+        qi = _mm_add_ps(qi, _mm_mul_ps(y, a));
+        iq = _mm_add_ps(iq, _mm_mul_ps(x, b));
+    }
+    *re = hsum_sse2(_mm_add_ps(ii, qq));
+    *im = hsum_sse2(_mm_sub_ps(qi, iq));
+    dot_tail(ti, tq, xi, xq, k, n, re, im);
+}
+#endif
+
+#ifdef TC_HAVE_AVX2
+TC_TARGET_AVX2 static float hsum_avx2(__m256 v) {
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return _mm_cvtss_f32(s);
+}
+
+TC_TARGET_AVX2 static void dot_avx2(const float *ti, const float *tq,
+                                    const float *xi, const float *xq,
+                                    int n, float *re, float *im) {
+    __m256 ii = _mm256_setzero_ps(), qq = _mm256_setzero_ps();
+    __m256 qi = _mm256_setzero_ps(), iq = _mm256_setzero_ps();
+    int k = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m256 a = _mm256_load_ps(ti + k), b = _mm256_load_ps(tq + k);
+        __m256 x = _mm256_loadu_ps(xi + k), y = _mm256_loadu_ps(xq + k);
+        ii = _mm256_add_ps(ii, _mm256_mul_ps(x, a));
+        qq = _mm256_add_ps(qq, _mm256_mul_ps(y, b));
+        qi = _mm256_add_ps(qi, _mm256_mul_ps(y, a));
+        iq = _mm256_add_ps(iq, _mm256_mul_ps(x, b));
+    }
+    *re = hsum_avx2(_mm256_add_ps(ii, qq));
+    *im = hsum_avx2(_mm256_sub_ps(qi, iq));
+    dot_tail(ti, tq, xi, xq, k, n, re, im);
+}
+#endif
+
+#ifdef TC_HAVE_NEON
+static float hsum_neon(float32x4_t v) {
+    float32x2_t p = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+    return vget_lane_f32(vpadd_f32(p, p), 0);
+}
+
+static void dot_neon(const float *ti, const float *tq, const float *xi, const float *xq,
+                     int n, float *re, float *im) {
+    float32x4_t ii = vdupq_n_f32(0.0f), qq = vdupq_n_f32(0.0f);
+    float32x4_t qi = vdupq_n_f32(0.0f), iq = vdupq_n_f32(0.0f);
+    int k = 0;
+    for (; k + 4 <= n; k += 4) {
+        float32x4_t a = vld1q_f32(ti + k), b = vld1q_f32(tq + k);
+        float32x4_t x = vld1q_f32(xi + k), y = vld1q_f32(xq + k);
+        ii = vmlaq_f32(ii, x, a);
+        qq = vmlaq_f32(qq, y, b);
+        qi = vmlaq_f32(qi, y, a);
+        iq = vmlaq_f32(iq, x, b);
+    }
+    *re = hsum_neon(vaddq_f32(ii, qq));
+    *im = hsum_neon(vsubq_f32(qi, iq));
+    dot_tail(ti, tq, xi, xq, k, n, re, im);
+}
+#endif
+
+tick_corr_dot_fn tick_corr_select_kernel(channel_simd_t level) {
+    switch (level) {
+#ifdef TC_HAVE_AVX2
+        case CHANNEL_SIMD_AVX2: return dot_avx2;
+#endif
+#ifdef TC_HAVE_SSE2
+        case CHANNEL_SIMD_SSE2: return dot_sse2;
+#endif
+#ifdef TC_HAVE_NEON
+        case CHANNEL_SIMD_NEON: return dot_neon;
+#endif
+        default:                return tick_corr_dot_scalar;
+    }
+}
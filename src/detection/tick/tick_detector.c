@@ -20,6 +20,9 @@
 #include "detection/tick_internal.h"
 #include "telemetry.h"
 #include "version.h"
+#include "wwv_thread.h"
+#include "wwv_arena.h"
+#include "wwv_trace.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
@@ -29,24 +32,35 @@
  * Helper Functions
  *============================================================================*/
 
-static float calculate_bucket_energy(tick_detector_t *td) {
-    return fft_processor_get_bucket_energy(td->fft, TICK_TARGET_FREQ_HZ, TICK_BANDWIDTH_HZ);
+static float calculate_bucket_energy(tick_detector_t *td, const tick_channel_t *ch) {
+    float energy = fft_processor_get_band(td->fft, ch->fft_band);
+    if (td->fft_lower) energy += fft_processor_get_band(td->fft_lower, ch->fft_band);
+    return energy;
 }
 
-float tick_calculate_avg_interval(tick_detector_t *td, float current_time_ms) {
-    if (td->tick_history_count < 2) return 0.0f;
+/* Channel watching a station, NULL if the detector does not */
+static tick_channel_t *find_channel(tick_detector_t *td, wwv_station_t station) {
+    if (!td) return NULL;
+    for (int s = 0; s < td->station_count; s++) {
+        if (td->ch[s].station == station) return &td->ch[s];
+    }
+    return NULL;
+}
+
+float tick_calculate_avg_interval(const tick_channel_t *ch, double current_time_ms) {
+    if (ch->tick_history_count < 2) return 0.0f;
 
-    float cutoff = current_time_ms - TICK_AVG_WINDOW_MS;
+    double cutoff = current_time_ms - TICK_AVG_WINDOW_MS;
     float sum = 0.0f;
     int count = 0;
-    float prev_time = -1.0f;
+    double prev_time = -1.0;
 
-    for (int i = 0; i < td->tick_history_count; i++) {
-        int idx = (td->tick_history_idx - td->tick_history_count + i + TICK_HISTORY_SIZE) % TICK_HISTORY_SIZE;
-        float t = td->tick_timestamps_ms[idx];
+    for (int i = 0; i < ch->tick_history_count; i++) {
+        int idx = (ch->tick_history_idx - ch->tick_history_count + i + TICK_HISTORY_SIZE) % TICK_HISTORY_SIZE;
+        double t = ch->tick_timestamps_ms[idx];
         if (t >= cutoff) {
-            if (prev_time >= 0.0f) {
-                sum += (t - prev_time);
+            if (prev_time >= 0.0) {
+                sum += (float)(t - prev_time);
                 count++;
             }
             prev_time = t;
@@ -57,12 +71,19 @@ float tick_calculate_avg_interval(tick_detector_t *td, float current_time_ms) {
 }
 
 /**
- * Get wall clock time string for CSV output
+ * Get wall clock time of a detector timestamp
+ */
+time_t tick_get_wall_time(tick_detector_t *td, double timestamp_ms) {
+    return td->start_time + (time_t)(timestamp_ms / 1000.0f);
+}
+
+/**
+ * Get wall clock time string for console and telemetry output
  * Format: HH:MM:SS
  */
-void tick_get_wall_time_str(tick_detector_t *td, float timestamp_ms, char *buf, size_t buflen) {
-    time_t event_time = td->start_time + (time_t)(timestamp_ms / 1000.0f);
-    struct tm *tm_info = localtime(&event_time);
+void tick_get_wall_time_str(tick_detector_t *td, double timestamp_ms, char *buf, size_t buflen) {
+    time_t event_time = tick_get_wall_time(td, timestamp_ms);
+    struct tm *tm_info = wwv_localtime(&event_time);
     strftime(buf, buflen, "%H:%M:%S", tm_info);
 }
 
@@ -70,39 +91,102 @@ void tick_get_wall_time_str(tick_detector_t *td, float timestamp_ms, char *buf,
  * Public API Implementation
  *============================================================================*/
 
-tick_detector_t *tick_detector_create(const char *csv_path) {
-    tick_detector_t *td = (tick_detector_t *)calloc(1, sizeof(tick_detector_t));
-    if (!td) return NULL;
-
-    /* Allocate FFT */
-    td->fft = fft_processor_create(TICK_FFT_SIZE, TICK_SAMPLE_RATE);
-    if (!td->fft) {
-        free(td);
-        return NULL;
+/**
+ * Register a station's FFT band
+ * Baseband frames get the full-rate band's bins, shifted down with the
+ * mix, on both sideband processors (registered in step, so one id serves both)
+ */
+static int add_station_band(tick_detector_t *td, int target_hz) {
+    if (!td->fft_lower) {
+        return fft_processor_add_band(td->fft, (float)target_hz, TICK_BANDWIDTH_HZ,
+                                      FFT_BAND_MAGNITUDE);
     }
 
-    td->i_buffer = (float *)malloc(TICK_FFT_SIZE * sizeof(float));
-    td->q_buffer = (float *)malloc(TICK_FFT_SIZE * sizeof(float));
+    int center = (int)(target_hz / HZ_PER_BIN + 0.5f) - BASEBAND_MIX_BIN;
+    int span = (int)(TICK_BANDWIDTH_HZ / HZ_PER_BIN + 0.5f);
+    if (span < 1) span = 1;
+    int upper = fft_processor_add_bins(td->fft, center - span, center + span, FFT_BAND_MAGNITUDE);
+    int lower = fft_processor_add_bins(td->fft_lower, center - span, center + span,
+                                       FFT_BAND_MAGNITUDE);
+    return (upper == lower) ? upper : -1;
+}
 
-    /* Allocate matched filter resources */
-    td->template_i = (float *)malloc(TICK_TEMPLATE_SAMPLES * sizeof(float));
-    td->template_q = (float *)malloc(TICK_TEMPLATE_SAMPLES * sizeof(float));
-    td->corr_buf_i = (float *)malloc(TICK_CORR_BUFFER_SIZE * sizeof(float));
-    td->corr_buf_q = (float *)malloc(TICK_CORR_BUFFER_SIZE * sizeof(float));
+/**
+ * Per-station detector state at creation
+ */
+static void init_channel(tick_detector_t *td, tick_channel_t *ch, wwv_station_t station) {
+    ch->station = station;
+    ch->target_hz = (station == WWV_STATION_WWVH) ? TICK_WWVH_FREQ_HZ : TICK_TARGET_FREQ_HZ;
+    ch->fft_band = add_station_band(td, ch->target_hz);
 
-    if (!td->i_buffer || !td->q_buffer ||
-        !td->template_i || !td->template_q || !td->corr_buf_i || !td->corr_buf_q) {
-        tick_detector_destroy(td);
-        return NULL;
-    }
+    ch->noise_floor = 0.01f;
+    ch->threshold_high = ch->noise_floor * td->threshold_multiplier;
+    ch->threshold_low = ch->threshold_high * TICK_HYSTERESIS_RATIO;
+    ch->warmup_complete = false;
 
-    /* Initialize buffers */
-    memset(td->i_buffer, 0, TICK_FFT_SIZE * sizeof(float));
-    memset(td->q_buffer, 0, TICK_FFT_SIZE * sizeof(float));
-    td->buffer_idx = 0;
+    /* Initialize timing gate (disabled until marker sets epoch) */
+    ch->gate.epoch_ms = 0.0f;
+    ch->gate.enabled = false;
+    ch->epoch_source = EPOCH_SOURCE_NONE;
+    ch->epoch_confidence = 0.0f;
 
-    /* Initialize matched filter */
-    tick_correlation_init(td);
+    /* Create WWV clock tracker */
+    ch->wwv_clock = wwv_clock_create(station);
+}
+
+tick_detector_t *tick_detector_create(const char *csv_path) {
+    const wwv_station_t wwv = WWV_STATION_WWV;
+    return tick_detector_create_stations(csv_path, &wwv, 1);
+}
+
+/**
+ * Stream constants for the input rate
+ */
+static void init_stream(tick_stream_t *st, bool baseband) {
+    if (baseband) {
+        st->decimation = BASEBAND_DECIMATION;
+        st->template_samples = TICK_BASEBAND_TEMPLATE_SAMPLES;
+        st->corr_step = 1;
+    } else {
+        st->decimation = 1;
+        st->template_samples = TICK_TEMPLATE_SAMPLES;
+        st->corr_step = CORR_DECIMATION;
+    }
+    st->frame_samples = TICK_FFT_SIZE / st->decimation;
+    /* Noise in the template's bandwidth grows with its length, as the signal does */
+    st->corr_scale = (float)st->decimation;
+}
+
+static tick_detector_t *create_detector(const char *csv_path, const wwv_station_t *stations,
+                                        int count, bool baseband) {
+    if (!stations || count < 1 || count > TICK_MAX_STATIONS) return NULL;
+    for (int s = 0; s < count; s++) {
+        if (stations[s] != WWV_STATION_WWV && stations[s] != WWV_STATION_WWVH) return NULL;
+        for (int t = 0; t < s; t++) {
+            if (stations[t] == stations[s]) return NULL;
+        }
+    }
+
+    tick_detector_t *td = (tick_detector_t *)wwv_aligned_calloc(WWV_CACHE_LINE, sizeof(tick_detector_t));
+    if (!td) return NULL;
+    init_stream(&td->stream, baseband);
+    const int frame = td->stream.frame_samples;
+
+    /* Allocate FFT (baseband: one per sideband) */
+    td->fft = fft_processor_create(frame, (float)tick_stream_rate(td));
+    if (baseband) {
+        td->fft_lower = fft_processor_create(frame, (float)tick_stream_rate(td));
+        td->lower_i_buffer = (float *)wwv_calloc((size_t)frame, sizeof(float));
+        td->lower_q_buffer = (float *)wwv_calloc((size_t)frame, sizeof(float));
+    }
+    if (!td->fft || (baseband && (!td->fft_lower || !td->lower_i_buffer || !td->lower_q_buffer))) {
+        fft_processor_destroy(td->fft);
+        fft_processor_destroy(td->fft_lower);
+        wwv_free(td->lower_i_buffer);
+        wwv_free(td->lower_q_buffer);
+        wwv_aligned_free(td);
+        return NULL;
+    }
 
     /* Initialize tunable parameters to defaults */
     td->threshold_multiplier = TICK_THRESHOLD_MULT;      /* 2.0 */
@@ -110,68 +194,96 @@ tick_detector_t *tick_detector_create(const char *csv_path) {
     td->adapt_alpha_up = 1.0f - TICK_NOISE_ADAPT_UP;     /* 0.9998 */
     td->min_duration_ms = TICK_MIN_DURATION_MS;          /* 2.0 */
 
-    /* Initialize state */
-    td->state = STATE_IDLE;
-    td->noise_floor = 0.01f;
-    td->threshold_high = td->noise_floor * td->threshold_multiplier;
-    td->threshold_low = td->threshold_high * TICK_HYSTERESIS_RATIO;
-    td->detection_enabled = true;
-    td->warmup_complete = false;
-    td->start_time = time(NULL);  /* Record wall clock start time */
+    /* Ends on the first frame below the low threshold; > 1 s is a stuck level */
+    pulse_fsm_params_init(&td->pulse_params, FRAME_DURATION_MS, 1, MARKER_MAX_DURATION_MS, TICK_COOLDOWN_MS);
+    pulse_fsm_set_class(&td->pulse_params, TICK_CLASS_MARKER, TICK_MARKER_MIN_DURATION_MS, MARKER_MAX_DURATION_MS_CHECK);
+    pulse_fsm_set_class(&td->pulse_params, TICK_CLASS_TICK, td->min_duration_ms, TICK_MAX_DURATION_MS);
 
-    /* Initialize timing gate (disabled until marker sets epoch) */
-    td->gate.epoch_ms = 0.0f;
-    td->gate.enabled = false;
-    td->epoch_source = EPOCH_SOURCE_NONE;
-    td->epoch_confidence = 0.0f;
+    /* One band on the shared FFT frame per station */
+    td->station_count = count;
+    for (int s = 0; s < count; s++) {
+        init_channel(td, &td->ch[s], stations[s]);
+    }
 
-    /* Create WWV clock tracker */
-    td->wwv_clock = wwv_clock_create(WWV_STATION_WWV);
+    td->i_buffer = (float *)wwv_malloc((size_t)frame * sizeof(float));
+    td->q_buffer = (float *)wwv_malloc((size_t)frame * sizeof(float));
 
-    /* Create comb filter */
-    td->comb_filter = comb_create();
-    if (!td->comb_filter) {
+    /* Allocate and initialize matched filter resources */
+    if (!td->i_buffer || !td->q_buffer || !tick_correlation_init(td)) {
         tick_detector_destroy(td);
         return NULL;
     }
 
+    /* Initialize buffers */
+    memset(td->i_buffer, 0, (size_t)frame * sizeof(float));
+    memset(td->q_buffer, 0, (size_t)frame * sizeof(float));
+    td->buffer_idx = 0;
+
+    /* Initialize state */
+    td->detection_enabled = true;
+    td->start_time = time(NULL);  /* Record wall clock start time */
+
     /* Open CSV file */
     if (csv_path) {
-        td->csv_file = fopen(csv_path, "w");
-        if (td->csv_file) {
+        td->csv_log = wwv_csv_log_open(csv_path);
+        if (td->csv_log) {
             /* Version and timestamp header */
             char time_str[64];
             time_t now = time(NULL);
-            strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", localtime(&now));
-            fprintf(td->csv_file, "# Phoenix SDR WWV Tick Log v%s\n", PHOENIX_VERSION_FULL);
-            fprintf(td->csv_file, "# Started: %s\n", time_str);
-            fprintf(td->csv_file, "time,timestamp_ms,tick_num,expected,energy_peak,duration_ms,interval_ms,avg_interval_ms,noise_floor,corr_peak,corr_ratio\n");
-            fflush(td->csv_file);
+            strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", wwv_localtime(&now));
+            wwv_csv_log_header(td->csv_log, "# Phoenix SDR WWV Tick Log v%s\n", PHOENIX_VERSION_FULL);
+            wwv_csv_log_header(td->csv_log, "# Started: %s\n", time_str);
+            if (count > 1) {
+                wwv_csv_log_header(td->csv_log, "# Stations: tick_num prefixed H (HM for markers) = WWVH\n");
+            }
+            wwv_csv_log_header(td->csv_log, "time,timestamp_ms,tick_num,expected,energy_peak,duration_ms,interval_ms,avg_interval_ms,noise_floor,corr_peak,corr_ratio\n");
         }
     }
 
-    printf("[TICK] Detector created: FFT=%d (%.1fms), matched filter=%d samples (%.1fms)\n",
-           TICK_FFT_SIZE, FRAME_DURATION_MS, TICK_TEMPLATE_SAMPLES, TICK_PULSE_MS);
-    printf("[TICK] Target: %dHz ±%dHz, logging to %s\n",
-           TICK_TARGET_FREQ_HZ, TICK_BANDWIDTH_HZ, csv_path ? csv_path : "(disabled)");
+    printf("[TICK] Detector created: FFT=%d (%.1fms), matched filter=%d samples (%.1fms, %s)%s\n",
+           frame, FRAME_DURATION_MS, td->stream.template_samples,
+           td->stream.template_samples * 1000.0f / tick_stream_rate(td),
+           td->corr_mode == TICK_CORR_MODE_SLIDING ? "sliding DFT" : "reference",
+           baseband ? ", 3125 Hz baseband" : "");
+    if (count == 1) {
+        printf("[TICK] Target: %dHz ±%dHz, logging to %s\n",
+               td->ch[0].target_hz, TICK_BANDWIDTH_HZ, csv_path ? csv_path : "(disabled)");
+    } else {
+        printf("[TICK] Targets: %dHz (%s) + %dHz (%s) ±%dHz, logging to %s\n",
+               td->ch[0].target_hz, wwv_station_name(td->ch[0].station),
+               td->ch[1].target_hz, wwv_station_name(td->ch[1].station),
+               TICK_BANDWIDTH_HZ, csv_path ? csv_path : "(disabled)");
+    }
 
     return td;
 }
 
+tick_detector_t *tick_detector_create_stations(const char *csv_path,
+                                               const wwv_station_t *stations, int count) {
+    return create_detector(csv_path, stations, count, false);
+}
+
+tick_detector_t *tick_detector_create_baseband(const char *csv_path,
+                                               const wwv_station_t *stations, int count) {
+    return create_detector(csv_path, stations, count, true);
+}
+
 void tick_detector_destroy(tick_detector_t *td) {
     if (!td) return;
 
-    if (td->wwv_clock) wwv_clock_destroy(td->wwv_clock);
-    if (td->comb_filter) comb_destroy(td->comb_filter);
-    if (td->csv_file) fclose(td->csv_file);
+    for (int s = 0; s < td->station_count; s++) {
+        if (td->ch[s].wwv_clock) wwv_clock_destroy(td->ch[s].wwv_clock);
+    }
+    wwv_csv_log_close(td->csv_log);
     fft_processor_destroy(td->fft);
-    free(td->i_buffer);
-    free(td->q_buffer);
-    free(td->template_i);
-    free(td->template_q);
-    free(td->corr_buf_i);
-    free(td->corr_buf_q);
-    free(td);
+    fft_processor_destroy(td->fft_lower);
+    wwv_free(td->i_buffer);
+    wwv_free(td->q_buffer);
+    wwv_free(td->lower_i_buffer);
+    wwv_free(td->lower_q_buffer);
+    wwv_window_ring_free(&td->corr_ring_i);
+    wwv_window_ring_free(&td->corr_ring_q);
+    wwv_aligned_free(td);
 }
 
 void tick_detector_set_callback(tick_detector_t *td, tick_callback_fn callback, void *user_data) {
@@ -180,45 +292,174 @@ void tick_detector_set_callback(tick_detector_t *td, tick_callback_fn callback,
     td->callback_user_data = user_data;
 }
 
+void tick_detector_set_telemetry(tick_detector_t *td, telem_ctx_t *ctx) {
+    if (!td) return;
+    td->telem = ctx;
+}
+
+void tick_detector_set_perf(tick_detector_t *td, wwv_perf_t *perf) {
+    if (!td) return;
+    td->perf = perf;
+    wwv_csv_log_set_perf(td->csv_log, perf);
+}
+
 void tick_detector_set_marker_callback(tick_detector_t *td, tick_marker_callback_fn callback, void *user_data) {
     if (!td) return;
     td->marker_callback = callback;
     td->marker_callback_user_data = user_data;
 }
 
-bool tick_detector_process_sample(tick_detector_t *td, float i_sample, float q_sample) {
-    if (!td || !td->detection_enabled) return false;
+/**
+ * Update a station's correlation noise floor and pulse tracking with a new value
+ * @param rival Strongest other station's correlation at the same sample
+ * @param adapt Noise floor adaptation rate per update
+ */
+static inline void track_correlation(tick_detector_t *td, int s, float corr, float rival,
+                                     float adapt) {
+    tick_corr_track_t *ct = &td->corr[s];
+
+    /* Update correlation noise floor (slow adaptation) */
+    if (corr < ct->corr_noise_floor || ct->corr_noise_floor < 0.001f) {
+        ct->corr_noise_floor += adapt * (corr - ct->corr_noise_floor);
+    } else if (ct->pulse.state == PULSE_IDLE) {
+        ct->corr_noise_floor += (adapt * 0.1f) * (corr - ct->corr_noise_floor);
+    }
 
-    /* Always feed correlation buffer (sample-by-sample) */
-    td->corr_buf_i[td->corr_buf_idx] = i_sample;
-    td->corr_buf_q[td->corr_buf_idx] = q_sample;
-    td->corr_buf_idx = (td->corr_buf_idx + 1) % TICK_CORR_BUFFER_SIZE;
-    td->corr_sample_count++;
+    /* Track own and rival peaks during detection */
+    if (ct->pulse.state == PULSE_ACTIVE) {
+        if (corr > ct->corr_peak) ct->corr_peak = corr;
+        if (rival > ct->rival_peak) ct->rival_peak = rival;
+    }
+}
 
-    /* Compute correlation every N samples (for efficiency) */
-    if (td->corr_sample_count >= TICK_TEMPLATE_SAMPLES &&
-        (td->corr_sample_count % CORR_DECIMATION) == 0) {
-        float corr = tick_correlation_compute(td);
-
-        /* Update correlation noise floor (slow adaptation) */
-        if (corr < td->corr_noise_floor || td->corr_noise_floor < 0.001f) {
-            td->corr_noise_floor += CORR_NOISE_ADAPT * (corr - td->corr_noise_floor);
-        } else if (td->state == STATE_IDLE) {
-            td->corr_noise_floor += (CORR_NOISE_ADAPT * 0.1f) * (corr - td->corr_noise_floor);
+/**
+ * Track every station's correlation (rival = strongest other station)
+ */
+static inline void track_stations(tick_detector_t *td, const float *corr, float adapt) {
+    if (td->station_count == 1) {
+        track_correlation(td, 0, corr[0], 0.0f, adapt);
+        return;
+    }
+    for (int s = 0; s < td->station_count; s++) {
+        float rival = 0.0f;
+        for (int r = 0; r < td->station_count; r++) {
+            if (r != s && corr[r] > rival) rival = corr[r];
         }
+        track_correlation(td, s, corr[s], rival, adapt);
+    }
+}
 
-        /* Track peak during detection */
-        if (td->state == STATE_IN_TICK && corr > td->corr_peak) {
-            td->corr_peak = corr;
-            td->corr_peak_offset = td->corr_sample_count;
+/**
+ * Push one sample into the matched filter and update correlation tracking
+ */
+static inline void feed_correlation(tick_detector_t *td, float i_sample, float q_sample) {
+    float corr[TICK_MAX_STATIONS];
+    const tick_stream_t *st = &td->stream;
+
+    if (td->corr_mode == TICK_CORR_MODE_SLIDING) {
+        /* One correlation per sample - scale adaptation to keep the same
+         * time constant as the full-rate decimated reference path */
+        tick_correlation_slide(td, i_sample, q_sample, corr);
+        if (td->corr_sample_count >= (wwv_sample_t)st->template_samples) {
+            track_stations(td, corr, CORR_NOISE_ADAPT * st->decimation / CORR_DECIMATION);
         }
+        return;
+    }
 
-        /* Accumulate correlation during detection */
-        if (td->state == STATE_IN_TICK) {
-            td->corr_sum += corr;
-            td->corr_sum_count++;
-        }
+    wwv_window_ring_push(&td->corr_ring_i, i_sample);
+    wwv_window_ring_push(&td->corr_ring_q, q_sample);
+    td->corr_sample_count++;
+
+    /* Compute correlation every N samples (for efficiency) */
+    if (td->corr_sample_count >= (wwv_sample_t)st->template_samples &&
+        (td->corr_sample_count % st->corr_step) == 0) {
+        for (int s = 0; s < td->station_count; s++) corr[s] = tick_correlation_compute(td, s);
+        track_stations(td, corr,
+                       CORR_NOISE_ADAPT * (st->corr_step * st->decimation) / CORR_DECIMATION);
+    }
+}
+
+/**
+ * FFT frame is full - extract each station's energy and run its state machine
+ * @param frame_i, frame_q One frame (frame buffer or caller's block)
+ * @param lower_i, lower_q Baseband: the lower sideband's frame, else NULL
+ * @return true if a tick started on this frame
+ */
+static bool process_frame(tick_detector_t *td, const float *frame_i, const float *frame_q,
+                          const float *lower_i, const float *lower_q) {
+    td->buffer_idx = 0;
+    WWV_TRACE_BEGIN(tr);
+
+    /* Run FFT */
+    WWV_PERF_BEGIN(td->perf, t0);
+    fft_processor_process(td->fft, frame_i, frame_q);
+    if (td->fft_lower) fft_processor_process(td->fft_lower, lower_i, lower_q);
+
+    /* Extract bucket energy */
+    for (int s = 0; s < td->station_count; s++) {
+        td->ch[s].current_energy = calculate_bucket_energy(td, &td->ch[s]);
+    }
+    WWV_PERF_END(td->perf, WWV_PERF_TICK_FFT, t0);
+
+    /* Run detection state machines */
+    WWV_PERF_BEGIN(td->perf, t1);
+    bool started = false;
+    for (int s = 0; s < td->station_count; s++) {
+        tick_state_machine_run(td, s);
+        started = started || td->ch[s].flash_frames_remaining == TICK_FLASH_FRAMES;
     }
+    WWV_PERF_END(td->perf, WWV_PERF_TICK_STATE, t1);
+    WWV_TRACE_END("detector", "tick_frame", tr, FRAME_TO_MS(td->frame_count));
+
+    td->frame_count++;
+
+    return started;
+}
+
+/**
+ * Economy mode: decide at a frame's first sample whether it is computed
+ */
+static inline void begin_frame(tick_detector_t *td) {
+    bool skip = td->economy && !tick_state_frame_needed(td, td->frame_count);
+
+    /* The sliding bins were not maintained while skipping; re-seed from the buffer */
+    if (td->frame_skipped && !skip && td->corr_mode == TICK_CORR_MODE_SLIDING) {
+        tick_correlation_reset_sliding(td);
+    }
+    td->frame_skipped = skip;
+}
+
+/**
+ * Skipped frame sample: history only, so re-seeding and epoch refinement
+ * still see every sample
+ */
+static inline void skip_sample(tick_detector_t *td, float i_sample, float q_sample) {
+    wwv_window_ring_push(&td->corr_ring_i, i_sample);
+    wwv_window_ring_push(&td->corr_ring_q, q_sample);
+    td->corr_sample_count++;
+}
+
+static void skip_frame(tick_detector_t *td) {
+    td->buffer_idx = 0;
+    for (int s = 0; s < td->station_count; s++) {
+        tick_state_machine_skip(td, s);
+    }
+    td->frame_count++;
+    td->frames_skipped++;
+}
+
+bool tick_detector_process_sample(tick_detector_t *td, float i_sample, float q_sample) {
+    if (!td || !td->detection_enabled || td->fft_lower) return false;
+
+    if (td->buffer_idx == 0) begin_frame(td);
+    if (td->frame_skipped) {
+        skip_sample(td, i_sample, q_sample);
+        if (++td->buffer_idx >= TICK_FFT_SIZE) skip_frame(td);
+        return false;
+    }
+
+    /* Always feed correlation buffer (sample-by-sample) */
+    feed_correlation(td, i_sample, q_sample);
 
     /* Buffer sample for FFT */
     td->i_buffer[td->buffer_idx] = i_sample;
@@ -230,30 +471,99 @@ bool tick_detector_process_sample(tick_detector_t *td, float i_sample, float q_s
         return false;
     }
 
-    /* Buffer full - run FFT */
-    td->buffer_idx = 0;
+    return process_frame(td, td->i_buffer, td->q_buffer, NULL, NULL);
+}
 
-    /* Run FFT */
-    fft_processor_process(td->fft, td->i_buffer, td->q_buffer);
+/**
+ * Block body shared by the 50 kHz and baseband entry points
+ * @param lower_i, lower_q Baseband lower sideband (FFT only), else NULL
+ */
+static int run_block(tick_detector_t *td, const float *i_samples, const float *q_samples,
+                     const float *lower_i, const float *lower_q, size_t count) {
+    const int frame = td->stream.frame_samples;
+    int detections = 0;
+    size_t pos = 0;
+
+    while (pos < count) {
+        /* Fill up to the next FFT frame boundary in one chunk. The state
+         * machine only runs at frame boundaries, so correlation tracking
+         * sees the same state it would with per-sample calls. */
+        size_t chunk = (size_t)(frame - td->buffer_idx);
+        if (chunk > count - pos) chunk = count - pos;
+
+        if (td->buffer_idx == 0) begin_frame(td);
+        if (td->frame_skipped) {
+            for (size_t n = 0; n < chunk; n++) {
+                skip_sample(td, i_samples[pos + n], q_samples[pos + n]);
+            }
+            td->buffer_idx += (int)chunk;
+            pos += chunk;
+            if (td->buffer_idx >= frame) skip_frame(td);
+            continue;
+        }
 
-    /* Extract bucket energy */
-    td->current_energy = calculate_bucket_energy(td);
+        WWV_PERF_BEGIN(td->perf, t0);
+        for (size_t n = 0; n < chunk; n++) {
+            feed_correlation(td, i_samples[pos + n], q_samples[pos + n]);
+        }
+        WWV_PERF_END(td->perf, WWV_PERF_TICK_CORR, t0);
+
+        /* A whole frame inside the block goes to the FFT in place */
+        if (td->buffer_idx == 0 && chunk == (size_t)frame) {
+            if (process_frame(td, &i_samples[pos], &q_samples[pos],
+                              lower_i ? &lower_i[pos] : NULL,
+                              lower_q ? &lower_q[pos] : NULL)) {
+                detections++;
+            }
+            pos += chunk;
+            continue;
+        }
 
-    /* Run detection state machine */
-    tick_state_machine_run(td);
+        memcpy(&td->i_buffer[td->buffer_idx], &i_samples[pos], chunk * sizeof(float));
+        memcpy(&td->q_buffer[td->buffer_idx], &q_samples[pos], chunk * sizeof(float));
+        if (lower_i) {
+            memcpy(&td->lower_i_buffer[td->buffer_idx], &lower_i[pos], chunk * sizeof(float));
+            memcpy(&td->lower_q_buffer[td->buffer_idx], &lower_q[pos], chunk * sizeof(float));
+        }
+        td->buffer_idx += (int)chunk;
+        pos += chunk;
 
-    td->frame_count++;
+        if (td->buffer_idx >= frame &&
+            process_frame(td, td->i_buffer, td->q_buffer, td->lower_i_buffer, td->lower_q_buffer)) {
+            detections++;
+        }
+    }
 
-    return (td->flash_frames_remaining == TICK_FLASH_FRAMES);
+    return detections;
+}
+
+int tick_detector_process_block(tick_detector_t *td, const float *i_samples,
+                                const float *q_samples, size_t count) {
+    if (!td || !td->detection_enabled || td->fft_lower || !i_samples || !q_samples) return 0;
+    return run_block(td, i_samples, q_samples, NULL, NULL, count);
+}
+
+int tick_detector_process_baseband(tick_detector_t *td, const baseband_block_t *block) {
+    if (!td || !td->detection_enabled || !td->fft_lower || !block) return 0;
+    return run_block(td, block->upper_i, block->upper_q, block->lower_i, block->lower_q,
+                     block->count);
 }
 
 int tick_detector_get_flash_frames(tick_detector_t *td) {
-    return td ? td->flash_frames_remaining : 0;
+    if (!td) return 0;
+    int frames = 0;
+    for (int s = 0; s < td->station_count; s++) {
+        if (td->ch[s].flash_frames_remaining > frames) frames = td->ch[s].flash_frames_remaining;
+    }
+    return frames;
 }
 
 void tick_detector_decrement_flash(tick_detector_t *td) {
-    if (td && td->flash_frames_remaining > 0) {
-        td->flash_frames_remaining--;
+    if (!td) return;
+    for (int s = 0; s < td->station_count; s++) {
+        if (td->ch[s].flash_frames_remaining > 0) {
+            td->ch[s].flash_frames_remaining--;
+        }
     }
 }
 
@@ -266,15 +576,15 @@ bool tick_detector_get_enabled(tick_detector_t *td) {
 }
 
 float tick_detector_get_noise_floor(tick_detector_t *td) {
-    return td ? td->noise_floor : 0.0f;
+    return td ? td->ch[0].noise_floor : 0.0f;
 }
 
 float tick_detector_get_threshold(tick_detector_t *td) {
-    return td ? td->threshold_high : 0.0f;
+    return td ? td->ch[0].threshold_high : 0.0f;
 }
 
 float tick_detector_get_current_energy(tick_detector_t *td) {
-    return td ? td->current_energy : 0.0f;
+    return td ? td->ch[0].current_energy : 0.0f;
 }
 
 float tick_detector_get_threshold_mult(tick_detector_t *td) {
@@ -293,70 +603,122 @@ float tick_detector_get_min_duration_ms(tick_detector_t *td) {
     return td ? td->min_duration_ms : TICK_MIN_DURATION_MS;
 }
 
+void tick_detector_set_corr_mode(tick_detector_t *td, tick_corr_mode_t mode) {
+    if (!td || td->corr_mode == mode) return;
+    td->corr_mode = mode;
+    if (mode == TICK_CORR_MODE_SLIDING) {
+        /* Bins were not maintained in reference mode */
+        tick_correlation_reset_sliding(td);
+    }
+}
+
+void tick_detector_set_economy(tick_detector_t *td, bool enabled) {
+    if (!td || td->economy == enabled) return;
+    td->economy = enabled;
+    printf("[TICK] Economy mode %s\n", enabled ? "ENABLED (gate window + noise probes)" : "DISABLED");
+}
+
+bool tick_detector_get_economy(tick_detector_t *td) {
+    return td ? td->economy : false;
+}
+
+uint64_t tick_detector_get_skipped_frames(tick_detector_t *td) {
+    return td ? td->frames_skipped : 0;
+}
+
+bool tick_detector_skip(tick_detector_t *td, uint64_t samples) {
+    if (!td || td->fft_lower || td->buffer_idx != 0 || samples % TICK_FFT_SIZE != 0) return false;
+
+    uint64_t frames = samples / TICK_FFT_SIZE;
+    td->frame_count += frames;
+    td->corr_sample_count += samples;
+    wwv_window_ring_reset(&td->corr_ring_i);
+    wwv_window_ring_reset(&td->corr_ring_q);
+    tick_correlation_reset_sliding(td);
+    td->frame_skipped = false;
+
+    for (int s = 0; s < td->station_count; s++) {
+        tick_channel_t *ch = &td->ch[s];
+        pulse_fsm_reset(&td->corr[s].pulse);
+        ch->flash_frames_remaining = 0;
+        ch->last_tick_frame = 0;            /* No interval across the gap */
+        ch->gate.last_tick_frame_gated = td->frame_count;
+    }
+    return true;
+}
+
+tick_corr_mode_t tick_detector_get_corr_mode(tick_detector_t *td) {
+    return td ? td->corr_mode : TICK_CORR_MODE_SLIDING;
+}
+
 int tick_detector_get_tick_count(tick_detector_t *td) {
-    return td ? td->ticks_detected : 0;
+    return td ? td->ch[0].ticks_detected : 0;
 }
 
 void tick_detector_print_stats(tick_detector_t *td) {
     if (!td) return;
 
     float elapsed = td->frame_count * FRAME_DURATION_MS / 1000.0f;
-    float current_time_ms = td->frame_count * FRAME_DURATION_MS;
-    float detecting = td->warmup_complete ?
-        (elapsed - TICK_WARMUP_FRAMES * FRAME_DURATION_MS / 1000.0f) : 0.0f;
-    int expected = (int)detecting;
-    float rate = (expected > 0) ? (100.0f * td->ticks_detected / expected) : 0.0f;
-    float avg_interval = tick_calculate_avg_interval(td, current_time_ms);
+    double current_time_ms = FRAME_TO_MS(td->frame_count);
 
     printf("\n=== TICK DETECTOR STATS ===\n");
-    printf("FFT: %d (%.1fms), Matched filter: %d samples\n", TICK_FFT_SIZE, FRAME_DURATION_MS, TICK_TEMPLATE_SAMPLES);
-    printf("Target: %d Hz +/-%d Hz\n", TICK_TARGET_FREQ_HZ, TICK_BANDWIDTH_HZ);
-    printf("Elapsed: %.1fs  Detected: %d  Expected: %d  Rate: %.1f%%\n",
-           elapsed, td->ticks_detected, expected, rate);
-    printf("Markers: %d  Rejected: %d  Avg interval: %.0fms\n",
-           td->markers_detected, td->ticks_rejected, avg_interval);
-    printf("Energy noise: %.4f  Corr noise: %.2f\n", td->noise_floor, td->corr_noise_floor);
+    printf("FFT: %d (%.1fms), Matched filter: %d samples%s\n", td->stream.frame_samples,
+           FRAME_DURATION_MS, td->stream.template_samples, td->fft_lower ? " (baseband)" : "");
+    for (int s = 0; s < td->station_count; s++) {
+        const tick_channel_t *ch = &td->ch[s];
+        float detecting = ch->warmup_complete ?
+            (elapsed - TICK_WARMUP_FRAMES * FRAME_DURATION_MS / 1000.0f) : 0.0f;
+        int expected = (int)detecting;
+        float rate = (expected > 0) ? (100.0f * ch->ticks_detected / expected) : 0.0f;
+        float avg_interval = tick_calculate_avg_interval(ch, current_time_ms);
+
+        if (td->station_count > 1) {
+            printf("--- %s (crosstalk rejected: %d) ---\n",
+                   wwv_station_name(ch->station), ch->crosstalk_rejected);
+        }
+        printf("Target: %d Hz +/-%d Hz\n", ch->target_hz, TICK_BANDWIDTH_HZ);
+        printf("Elapsed: %.1fs  Detected: %d  Expected: %d  Rate: %.1f%%\n",
+               elapsed, ch->ticks_detected, expected, rate);
+        printf("Markers: %d  Rejected: %d  Avg interval: %.0fms\n",
+               ch->markers_detected, ch->ticks_rejected, avg_interval);
+        printf("Energy noise: %.4f  Corr noise: %.2f\n", ch->noise_floor, td->corr[s].corr_noise_floor);
+    }
+    if (td->frames_skipped > 0) {
+        printf("Economy: %llu of %llu frames skipped (%.1f%%)\n",
+               (unsigned long long)td->frames_skipped, (unsigned long long)td->frame_count,
+               100.0 * td->frames_skipped / td->frame_count);
+    }
     printf("===========================\n");
 }
 
 void tick_detector_log_metadata(tick_detector_t *td, uint64_t center_freq,
                                 uint32_t sample_rate, uint32_t gain_reduction,
                                 uint32_t lna_state) {
-    if (!td || !td->csv_file) return;
-
-    /* Get current wall clock time */
-    char time_str[64];
-    time_t now = time(NULL);
-    strftime(time_str, sizeof(time_str), "%H:%M:%S", localtime(&now));
+    if (!td || !td->csv_log) return;
 
     /* Get timestamp in ms since detector start */
-    float timestamp_ms = td->frame_count * FRAME_DURATION_MS;
+    double timestamp_ms = FRAME_TO_MS(td->frame_count);
 
     /* Log as special META row */
-    fprintf(td->csv_file, "%s,%.1f,META,0,freq=%llu rate=%u GR=%u LNA=%u,0,0,0,0,0,0\n",
-            time_str, timestamp_ms,
-            (unsigned long long)center_freq, sample_rate, gain_reduction, lna_state);
-    fflush(td->csv_file);
+    wwv_csv_log_row_at(td->csv_log, time(NULL),
+                       "%.1f,META,0,freq=%llu rate=%u GR=%u LNA=%u,0,0,0,0,0,0\n",
+                       timestamp_ms,
+                       (unsigned long long)center_freq, sample_rate, gain_reduction, lna_state);
 
     printf("[TICK] Logged metadata: freq=%llu, rate=%u, GR=%u, LNA=%u\n",
            (unsigned long long)center_freq, sample_rate, gain_reduction, lna_state);
 }
 
 void tick_detector_log_display_gain(tick_detector_t *td, float display_gain_db) {
-    if (!td || !td->csv_file) return;
-
-    /* Get current wall clock time */
-    char time_str[64];
-    time_t now = time(NULL);
-    strftime(time_str, sizeof(time_str), "%H:%M:%S", localtime(&now));
+    if (!td || !td->csv_log) return;
 
     /* Get timestamp in ms since detector start */
-    float timestamp_ms = td->frame_count * FRAME_DURATION_MS;
+    double timestamp_ms = FRAME_TO_MS(td->frame_count);
 
     /* Log as special GAIN row */
-    fprintf(td->csv_file, "%s,%.1f,GAIN,0,display_gain=%.1f,0,0,0,0,0,0,0\n",
-            time_str, timestamp_ms, display_gain_db);
-    fflush(td->csv_file);
+    wwv_csv_log_row_at(td->csv_log, time(NULL),
+                       "%.1f,GAIN,0,display_gain=%.1f,0,0,0,0,0,0,0\n",
+                       timestamp_ms, display_gain_db);
 }
 
 float tick_detector_get_frame_duration_ms(void) {
@@ -367,25 +729,34 @@ float tick_detector_get_frame_duration_ms(void) {
  * Timing Gate API (Step 2: WWV Tick/BCD Separation)
  *============================================================================*/
 
-void tick_detector_set_epoch_with_source(tick_detector_t *td, float epoch_ms,
-                                          epoch_source_t source, float confidence) {
-    if (!td) return;
-
+static void set_channel_epoch(tick_detector_t *td, tick_channel_t *ch, float epoch_ms,
+                              epoch_source_t source, float confidence) {
     /* Normalize to millisecond within second (0-999) */
     float normalized_epoch = fmodf(epoch_ms, 1000.0f);
     if (normalized_epoch < 0) {
         normalized_epoch += 1000.0f;
     }
 
-    td->gate.epoch_ms = normalized_epoch;
-    td->epoch_source = source;
-    td->epoch_confidence = confidence;
+    ch->gate.epoch_ms = normalized_epoch;
+    ch->epoch_source = source;
+    ch->epoch_confidence = confidence;
 
     /* Log epoch updates to console telemetry */
     const char *source_str = (source == EPOCH_SOURCE_TICK_CHAIN) ? "CHAIN" :
                              (source == EPOCH_SOURCE_MARKER) ? "MARKER" : "UNKNOWN";
-    telem_console("[EPOCH] Set from %s: offset=%.1fms confidence=%.3f\n",
-                  source_str, normalized_epoch, confidence);
+    if (td->station_count > 1) {
+        telem_ctx_console(td->telem, "[EPOCH] %s set from %s: offset=%.1fms confidence=%.3f\n",
+                          wwv_station_name(ch->station), source_str, normalized_epoch, confidence);
+    } else {
+        telem_ctx_console(td->telem, "[EPOCH] Set from %s: offset=%.1fms confidence=%.3f\n",
+                      source_str, normalized_epoch, confidence);
+    }
+}
+
+void tick_detector_set_epoch_with_source(tick_detector_t *td, float epoch_ms,
+                                          epoch_source_t source, float confidence) {
+    if (!td) return;
+    set_channel_epoch(td, &td->ch[0], epoch_ms, source, confidence);
 }
 
 void tick_detector_set_epoch(tick_detector_t *td, float epoch_ms) {
@@ -395,33 +766,90 @@ void tick_detector_set_epoch(tick_detector_t *td, float epoch_ms) {
 
 void tick_detector_set_gating_enabled(tick_detector_t *td, bool enabled) {
     if (!td) return;
-    td->gate.enabled = enabled;
-    if (enabled) {
+    for (int s = 0; s < td->station_count; s++) {
+        tick_gate_t *gate = &td->ch[s].gate;
+        gate->enabled = enabled;
         /* Initialize recovery tracking when gate is enabled */
-        td->gate.last_tick_frame_gated = td->frame_count;  /* Start counting from now */
-        td->gate.recovery_mode = false;
+        if (enabled) gate->last_tick_frame_gated = td->frame_count;  /* Start counting from now */
+        gate->recovery_mode = false;
+    }
+    if (enabled) {
         printf("[TICK] Timing gate ENABLED (window: %.0f-%.0fms into second)\n",
                TICK_GATE_START_MS, TICK_GATE_END_MS);
     } else {
-        td->gate.recovery_mode = false;
         printf("[TICK] Timing gate DISABLED\n");
     }
 }
 
 float tick_detector_get_epoch(tick_detector_t *td) {
-    return td ? td->gate.epoch_ms : 0.0f;
+    return td ? td->ch[0].gate.epoch_ms : 0.0f;
 }
 
 bool tick_detector_is_gating_enabled(tick_detector_t *td) {
-    return td ? td->gate.enabled : false;
+    return td ? td->ch[0].gate.enabled : false;
 }
 
 epoch_source_t tick_detector_get_epoch_source(tick_detector_t *td) {
-    return td ? td->epoch_source : EPOCH_SOURCE_NONE;
+    return td ? td->ch[0].epoch_source : EPOCH_SOURCE_NONE;
 }
 
 float tick_detector_get_epoch_confidence(tick_detector_t *td) {
-    return td ? td->epoch_confidence : 0.0f;
+    return td ? td->ch[0].epoch_confidence : 0.0f;
+}
+
+/*============================================================================
+ * Per-Station Access
+ *============================================================================*/
+
+int tick_detector_get_station_count(tick_detector_t *td) {
+    return td ? td->station_count : 0;
+}
+
+bool tick_detector_has_station(tick_detector_t *td, wwv_station_t station) {
+    return find_channel(td, station) != NULL;
+}
+
+int tick_detector_get_station_tick_count(tick_detector_t *td, wwv_station_t station) {
+    const tick_channel_t *ch = find_channel(td, station);
+    return ch ? ch->ticks_detected : 0;
+}
+
+int tick_detector_get_station_marker_count(tick_detector_t *td, wwv_station_t station) {
+    const tick_channel_t *ch = find_channel(td, station);
+    return ch ? ch->markers_detected : 0;
+}
+
+int tick_detector_get_crosstalk_count(tick_detector_t *td, wwv_station_t station) {
+    const tick_channel_t *ch = find_channel(td, station);
+    return ch ? ch->crosstalk_rejected : 0;
+}
+
+void tick_detector_set_station_epoch(tick_detector_t *td, wwv_station_t station, float epoch_ms,
+                                     epoch_source_t source, float confidence) {
+    tick_channel_t *ch = find_channel(td, station);
+    if (!ch) return;
+    set_channel_epoch(td, ch, epoch_ms, source, confidence);
+}
+
+float tick_detector_get_station_epoch(tick_detector_t *td, wwv_station_t station) {
+    const tick_channel_t *ch = find_channel(td, station);
+    return ch ? ch->gate.epoch_ms : 0.0f;
+}
+
+bool tick_detector_get_measured_epoch(tick_detector_t *td, wwv_station_t station, float *epoch_ms) {
+    const tick_channel_t *ch = find_channel(td, station);
+    if (!ch || !epoch_ms || ch->tick_history_count < 3) return false;
+
+    /* Circular mean, so ticks either side of the second wrap average correctly */
+    double c = 0.0, sn = 0.0;
+    for (int i = 0; i < ch->tick_history_count; i++) {
+        double phase = 2.0 * M_PI * fmod(ch->tick_timestamps_ms[i], 1000.0) / 1000.0;
+        c += cos(phase);
+        sn += sin(phase);
+    }
+    double ms = atan2(sn, c) * 1000.0 / (2.0 * M_PI);
+    *epoch_ms = (float)(ms < 0.0 ? ms + 1000.0 : ms);
+    return true;
 }
 
 /*============================================================================
@@ -431,8 +859,11 @@ float tick_detector_get_epoch_confidence(tick_detector_t *td) {
 bool tick_detector_set_threshold_mult(tick_detector_t *td, float value) {
     if (!td || value < 1.0f || value > 5.0f) return false;
     td->threshold_multiplier = value;
-    td->threshold_high = td->noise_floor * td->threshold_multiplier;
-    td->threshold_low = td->threshold_high * TICK_HYSTERESIS_RATIO;
+    for (int s = 0; s < td->station_count; s++) {
+        tick_channel_t *ch = &td->ch[s];
+        ch->threshold_high = ch->noise_floor * td->threshold_multiplier;
+        ch->threshold_low = ch->threshold_high * TICK_HYSTERESIS_RATIO;
+    }
     return true;
 }
 
@@ -451,5 +882,102 @@ bool tick_detector_set_adapt_alpha_up(tick_detector_t *td, float value) {
 bool tick_detector_set_min_duration_ms(tick_detector_t *td, float value) {
     if (!td || value < 1.0f || value > 10.0f) return false;
     td->min_duration_ms = value;
+    pulse_fsm_set_class(&td->pulse_params, TICK_CLASS_TICK, value, TICK_MAX_DURATION_MS);
     return true;
 }
+
+/*============================================================================
+ * Warm Start
+ *============================================================================*/
+
+#define TICK_STATE_VERSION  1
+
+typedef struct {
+    int32_t station;
+    int32_t epoch_source;
+    float noise_floor;
+    float threshold_high;
+    float threshold_low;
+    float corr_noise_floor;
+    float epoch_ms;             /* Gate epoch, phase of the saved stream */
+    float epoch_confidence;
+    uint8_t gate_enabled;
+    uint8_t reserved[3];
+} tick_state_channel_t;
+
+typedef struct {
+    float threshold_multiplier;
+    int32_t station_count;
+    tick_state_channel_t ch[TICK_MAX_STATIONS];
+} tick_state_t;
+
+_Static_assert(sizeof(tick_state_channel_t) == 36, "tick state channel layout");
+_Static_assert(sizeof(tick_state_t) == 8 + 36 * TICK_MAX_STATIONS, "tick state layout");
+
+bool tick_detector_save_state(tick_detector_t *td, wwv_state_writer_t *w) {
+    if (!td || !w) return false;
+
+    tick_state_t st;
+    memset(&st, 0, sizeof(st));
+    st.threshold_multiplier = td->threshold_multiplier;
+    st.station_count = td->station_count;
+    for (int s = 0; s < td->station_count; s++) {
+        const tick_channel_t *ch = &td->ch[s];
+        tick_state_channel_t *out = &st.ch[s];
+        out->station = ch->station;
+        if (!ch->warmup_complete) continue;    /* Zero floor: nothing to restore */
+        out->epoch_source = ch->epoch_source;
+        out->noise_floor = ch->noise_floor;
+        out->threshold_high = ch->threshold_high;
+        out->threshold_low = ch->threshold_low;
+        out->corr_noise_floor = td->corr[s].corr_noise_floor;
+        out->epoch_ms = ch->gate.epoch_ms;
+        out->epoch_confidence = ch->epoch_confidence;
+        out->gate_enabled = ch->gate.enabled && !ch->gate.recovery_mode;
+    }
+    return wwv_state_put(w, WWV_STATE_TICK_DETECTOR, TICK_STATE_VERSION, &st, sizeof(st));
+}
+
+bool tick_detector_restore_state(tick_detector_t *td, const wwv_state_reader_t *r) {
+    if (!td || !r || r->elapsed_ms > WWV_STATE_LEVELS_MAX_AGE_MS) return false;
+
+    tick_state_t st;
+    if (!wwv_state_get(r, WWV_STATE_TICK_DETECTOR, TICK_STATE_VERSION, &st, sizeof(st))) {
+        return false;
+    }
+
+    if (st.threshold_multiplier >= 1.0f && st.threshold_multiplier <= 5.0f) {
+        td->threshold_multiplier = st.threshold_multiplier;
+    }
+
+    bool timing = r->elapsed_ms <= WWV_STATE_TIMING_MAX_AGE_MS;
+    bool restored = false;
+    for (int k = 0; k < st.station_count && k < TICK_MAX_STATIONS; k++) {
+        const tick_state_channel_t *in = &st.ch[k];
+        tick_channel_t *ch = find_channel(td, (wwv_station_t)in->station);
+        if (!ch || !(in->noise_floor > 0.0f)) continue;
+
+        ch->noise_floor = in->noise_floor;
+        ch->threshold_high = in->threshold_high;
+        ch->threshold_low = in->threshold_low;
+        ch->warmup_complete = true;
+        td->corr[ch - td->ch].corr_noise_floor = in->corr_noise_floor;
+        restored = true;
+
+        if (!timing || in->epoch_source == EPOCH_SOURCE_NONE) continue;
+        double epoch = wwv_state_carry_phase(r, in->epoch_ms, 1000.0);
+        set_channel_epoch(td, ch, (float)fmod(epoch, 1000.0), (epoch_source_t)in->epoch_source,
+                          in->epoch_confidence);
+        if (in->gate_enabled) {
+            ch->gate.enabled = true;
+            ch->gate.last_tick_frame_gated = td->frame_count;
+            ch->gate.recovery_mode = false;
+        }
+    }
+
+    if (restored) {
+        printf("[TICK] Warm start: levels restored from %.1f s ago%s\n",
+               r->elapsed_ms / 1000.0, timing ? ", gate epoch carried" : "");
+    }
+    return restored;
+}
@@ -0,0 +1,198 @@
+/**
+ * @file channel_quality.c
+ * @brief Carrier level, fading and spread from the shared display spectrum
+ */
+
+#include "channel_quality.h"
+#include "tone_tracker.h"
+#include "detection/tone/tone_tracker_internal.h"
+#include "wwv_arena.h"
+#include "wwv_thread.h"
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+/* RMS width, in bins, of the Hann line of a bin-centred tone (power 1 at
+ * the peak, 1/4 either side): what a clean carrier already measures */
+#define HANN_RMS_BINS       0.577f
+
+#define MIN_FRAMES          16          /* ~1.4 s at TONE_OVERLAP_HOP */
+
+struct channel_quality {
+    /* Fade tracking on the carrier level */
+    float mean_db;
+    float var_db;
+    bool faded;                 /* Below mean - hysteresis, awaiting recovery */
+    float fade_rate_hz;
+
+    /* Smoothed report levels */
+    float carrier_db;
+    float noise_db;
+    float spread_hz;
+    float noise_floor;
+
+    double last_ms;
+    uint64_t frames;
+    uint64_t fades;
+
+    telem_ctx_t *telem;
+    double next_telem_ms;
+};
+
+static float to_db(float mag) {
+    return 20.0f * log10f(mag + 1e-10f);
+}
+
+/* Weight of one frame dt_ms long in an exponential average of tau_ms */
+static float ema_alpha(double dt_ms, double tau_ms) {
+    return (float)(1.0 - exp(-dt_ms / tau_ms));
+}
+
+/*============================================================================
+ * Frame Measurements
+ *============================================================================*/
+
+static int carrier_peak(const float *mag, int n) {
+    int peak = 0;
+    for (int i = 1; i <= SEARCH_BINS; i++) {
+        if (mag[i] > mag[peak]) peak = i;
+        if (mag[n - i] > mag[peak]) peak = n - i;
+    }
+    return peak;
+}
+
+/* Second moment of the noise-subtracted line power around the peak */
+static float line_width_bins(const float *mag, int n, int peak, float noise) {
+    float noise_pow = noise * noise;
+    float sum = 0.0f, sum_k = 0.0f, sum_k2 = 0.0f;
+
+    for (int k = -CHANNEL_SPREAD_BINS; k <= CHANNEL_SPREAD_BINS; k++) {
+        float m = mag[(peak + k + n) % n];
+        float p = m * m - noise_pow;
+        if (p <= 0.0f) continue;
+        sum += p;
+        sum_k += p * k;
+        sum_k2 += p * k * k;
+    }
+    if (sum <= 0.0f) return 0.0f;
+
+    float centre = sum_k / sum;
+    float var = sum_k2 / sum - centre * centre - HANN_RMS_BINS * HANN_RMS_BINS;
+    return var > 0.0f ? sqrtf(var) : 0.0f;
+}
+
+static void send_telemetry(channel_quality_t *cq, double timestamp_ms) {
+    if (!telem_ctx_is_enabled(cq->telem, TELEM_CHANNEL)) return;
+    if (timestamp_ms < cq->next_telem_ms) return;
+    cq->next_telem_ms = timestamp_ms + CHANNEL_TELEM_INTERVAL_MS;
+
+    char time_str[16];
+    time_t now = time(NULL);
+    strftime(time_str, sizeof(time_str), "%H:%M:%S", wwv_localtime(&now));
+
+    telem_ctx_sendf(cq->telem, TELEM_CHANNEL, "%s,%.1f,%.1f,%.1f,%.1f,%.3f,%.1f,%.2f",
+                    time_str, timestamp_ms, cq->carrier_db, cq->carrier_db - cq->noise_db,
+                    cq->noise_db, cq->fade_rate_hz, sqrtf(cq->var_db), cq->spread_hz);
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+channel_quality_t *channel_quality_create(void) {
+    channel_quality_t *cq = (channel_quality_t *)wwv_calloc(1, sizeof(channel_quality_t));
+    if (!cq) return NULL;
+
+    printf("[CHANNEL] Quality estimate: level tau %.0f s, fade tau %.0f s, spread ±%d bins\n",
+           CHANNEL_LEVEL_TAU_MS / 1000.0, CHANNEL_FADE_TAU_MS / 1000.0, CHANNEL_SPREAD_BINS);
+    return cq;
+}
+
+void channel_quality_destroy(channel_quality_t *cq) {
+    wwv_free(cq);
+}
+
+void channel_quality_process_magnitudes(channel_quality_t *cq, const float *mag, int n,
+                                        double timestamp_ms) {
+    if (!cq || !mag || n != TONE_FFT_SIZE) return;
+
+    /* Same region, exclusion and estimator as every tone tracker's floor */
+    float noise = tone_estimate_noise_floor(mag, n, 0, SEARCH_BINS + 5);
+    int peak = carrier_peak(mag, n);
+    float level_db = to_db(mag[peak]);
+    float noise_db = to_db(noise);
+    cq->noise_floor = noise;
+
+    if (cq->frames++ == 0) {
+        cq->mean_db = cq->carrier_db = level_db;
+        cq->noise_db = noise_db;
+        cq->last_ms = timestamp_ms;
+        return;
+    }
+
+    double dt = timestamp_ms - cq->last_ms;
+    if (dt <= 0.0) dt = TONE_FRAME_MS;
+    cq->last_ms = timestamp_ms;
+    float a = ema_alpha(dt, CHANNEL_LEVEL_TAU_MS);
+
+    cq->carrier_db += a * (level_db - cq->carrier_db);
+    cq->noise_db += a * (noise_db - cq->noise_db);
+
+    float dev = level_db - cq->mean_db;
+    cq->mean_db += a * dev;
+    cq->var_db += a * (dev * dev - cq->var_db);
+
+    /* A fade is a dip through the mean, counted once it recovers */
+    bool fade_end = false;
+    if (!cq->faded && dev < -CHANNEL_FADE_HYST_DB) {
+        cq->faded = true;
+    } else if (cq->faded && dev > CHANNEL_FADE_HYST_DB) {
+        cq->faded = false;
+        fade_end = true;
+        cq->fades++;
+    }
+    float af = ema_alpha(dt, CHANNEL_FADE_TAU_MS);
+    float rate = fade_end ? (float)(1000.0 / dt) : 0.0f;
+    cq->fade_rate_hz += af * (rate - cq->fade_rate_hz);
+
+    if (level_db - noise_db >= CHANNEL_SPREAD_MIN_SNR_DB) {
+        float width_hz = line_width_bins(mag, n, peak, noise) * TONE_HZ_PER_BIN;
+        cq->spread_hz += a * (width_hz - cq->spread_hz);
+    }
+
+    send_telemetry(cq, timestamp_ms);
+}
+
+bool channel_quality_get(const channel_quality_t *cq, channel_quality_report_t *out) {
+    if (!cq || !out) return false;
+
+    out->timestamp_ms = cq->last_ms;
+    out->carrier_db = cq->carrier_db;
+    out->noise_db = cq->noise_db;
+    out->snr_db = cq->carrier_db - cq->noise_db;
+    out->fade_rate_hz = cq->fade_rate_hz;
+    out->fade_depth_db = sqrtf(cq->var_db);
+    out->doppler_spread_hz = cq->spread_hz;
+    out->noise_floor = cq->noise_floor;
+    out->frames = cq->frames;
+    out->valid = cq->frames >= MIN_FRAMES;
+    return out->valid;
+}
+
+float channel_quality_get_noise_floor(const channel_quality_t *cq) {
+    return cq ? cq->noise_floor : 0.0f;
+}
+
+void channel_quality_set_telemetry(channel_quality_t *cq, telem_ctx_t *ctx) {
+    if (!cq) return;
+    cq->telem = ctx;
+}
+
+void channel_quality_print_stats(const channel_quality_t *cq) {
+    if (!cq) return;
+
+    printf("[CHANNEL] %llu frames: carrier %.1f dB, SNR %.1f dB, fades %.3f/s (%llu, depth %.1f dB), "
+           "spread %.2f Hz\n",
+           (unsigned long long)cq->frames, cq->carrier_db, cq->carrier_db - cq->noise_db,
+           cq->fade_rate_hz, (unsigned long long)cq->fades, sqrtf(cq->var_db), cq->spread_hz);
+}
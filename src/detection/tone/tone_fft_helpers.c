@@ -33,7 +33,7 @@ void tone_generate_blackman_harris(float *window, int size) {
  * Parabolic Interpolation
  *============================================================================*/
 
-float tone_parabolic_peak(float *mag, int peak_bin, int fft_size) {
+float tone_parabolic_peak(const float *mag, int peak_bin, int fft_size) {
     if (peak_bin <= 0 || peak_bin >= fft_size - 1)
         return (float)peak_bin;
 
@@ -53,7 +53,7 @@ float tone_parabolic_peak(float *mag, int peak_bin, int fft_size) {
  * Find Peak in Range
  *============================================================================*/
 
-int tone_find_peak_bin(float *mag, int start, int end, int fft_size) {
+int tone_find_peak_bin(const float *mag, int start, int end, int fft_size) {
     if (start < 0) start = 0;
     if (end >= fft_size) end = fft_size - 1;
 
@@ -74,7 +74,7 @@ int tone_find_peak_bin(float *mag, int start, int end, int fft_size) {
  * Estimate Noise Floor
  *============================================================================*/
 
-float tone_estimate_noise_floor(float *mag, int fft_size, int exclude_bin, int exclude_range) {
+float tone_estimate_noise_floor(const float *mag, int fft_size, int exclude_bin, int exclude_range) {
     float sum = 0.0f;
     int count = 0;
 
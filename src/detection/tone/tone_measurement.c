@@ -8,6 +8,8 @@
 
 #include "tone_tracker_internal.h"
 #include "version.h"
+#include "wwv_thread.h"
+#include "wwv_trace.h"
 #include <math.h>
 #include <string.h>
 #include <time.h>
@@ -16,60 +18,103 @@
  * Core Measurement
  *============================================================================*/
 
+/**
+ * Narrow-band refinement of a coarse peak on the window the FFT just used
+ */
+static float refine_peak(tone_tracker_t *tt, bool zoom, float coarse_hz) {
+    zoom_dft_t *zd = zoom ? tt->zoom_refine : tt->refine;
+    if (!zd) return coarse_hz;
+
+    /* Shared spectrum: its window is the one measured */
+    const wwv_window_ring_t *ri = tt->spectrum ? &tt->spectrum->ring_i :
+                                  zoom ? &tt->zoom_ring_i : &tt->ring_i;
+    const wwv_window_ring_t *rq = tt->spectrum ? &tt->spectrum->ring_q :
+                                  zoom ? &tt->zoom_ring_q : &tt->ring_q;
+    return zoom_dft_refine_peak(zd, wwv_window_ring_window(ri), wwv_window_ring_window(rq),
+                                coarse_hz, TONE_REFINE_SPAN_HZ, NULL);
+}
+
+/**
+ * Noise floor of this spectrum: the bins (50-150) lie clear of every
+ * tracker's tone, so on a shared spectrum its channel estimate already has it
+ */
+static float measure_noise_floor(tone_tracker_t *tt, const float *mag, int n, int tone_bin) {
+    if (tt->spectrum && tt->spectrum->quality) {
+        return channel_quality_get_noise_floor(tt->spectrum->quality);
+    }
+    return tone_estimate_noise_floor(mag, n, tone_bin, SEARCH_BINS + 5);
+}
+
 void tone_measure_frequency(tone_tracker_t *tt) {
-    /* Rearrange circular buffer into linear arrays for FFT */
-    float temp_i[TONE_FFT_SIZE];
-    float temp_q[TONE_FFT_SIZE];
-    for (int i = 0; i < TONE_FFT_SIZE; i++) {
-        int idx = (tt->buffer_idx + i) % TONE_FFT_SIZE;
-        temp_i[i] = tt->buffer_i[idx];
-        temp_q[i] = tt->buffer_q[idx];
+    if (tt->spectrum) {
+        tone_measure_magnitudes(tt, tt->spectrum->magnitudes, TONE_FFT_SIZE, false);
+        return;
     }
 
-    /* Run FFT */
-    fft_processor_process(tt->fft, temp_i, temp_q);
+    /* Zoomed: decimated window, same Hz/bin over a quarter of the bins */
+    bool zoom = tt->zoomed && tt->zoom_fill >= TONE_ZOOM_FFT_SIZE;
+    const int n = zoom ? TONE_ZOOM_FFT_SIZE : TONE_FFT_SIZE;
+
+    /* Run FFT straight from the mirrored window (oldest sample first) */
+    WWV_TRACE_BEGIN(tr);
+    WWV_PERF_BEGIN(tt->perf, t0);
+    if (zoom) {
+        fft_processor_process(tt->zoom_fft, wwv_window_ring_window(&tt->zoom_ring_i),
+                              wwv_window_ring_window(&tt->zoom_ring_q));
+        fft_processor_get_magnitudes(tt->zoom_fft, tt->magnitudes);
+    } else {
+        fft_processor_process(tt->fft, wwv_window_ring_window(&tt->ring_i),
+                              wwv_window_ring_window(&tt->ring_q));
+        fft_processor_get_magnitudes(tt->fft, tt->magnitudes);
+    }
+    WWV_PERF_END(tt->perf, WWV_PERF_TONE_FFT, t0);
+    WWV_TRACE_END("detector", zoom ? "tone_zoom_fft" : "tone_fft", tr, tone_window_start_ms(tt));
 
-    /* Get magnitudes */
-    fft_processor_get_magnitudes(tt->fft, tt->magnitudes);
+    tone_measure_magnitudes(tt, tt->magnitudes, n, zoom);
+}
+
+void tone_measure_magnitudes(tone_tracker_t *tt, const float *mag, int n, bool zoom) {
+    WWV_PERF_BEGIN(tt->perf, t1);
 
     /* Special case for DC/carrier (0 Hz) */
     if (tt->nominal_hz < 1.0f) {
         /* Find peak near DC (bin 0) - search both positive and negative freqs */
         int peak_bin = 0;
-        float peak_mag = tt->magnitudes[0];
+        float peak_mag = mag[0];
 
         /* Search positive frequencies (bins 1 to SEARCH_BINS) */
-        for (int i = 1; i <= SEARCH_BINS && i < TONE_FFT_SIZE/2; i++) {
-            if (tt->magnitudes[i] > peak_mag) {
-                peak_mag = tt->magnitudes[i];
+        for (int i = 1; i <= SEARCH_BINS && i < n / 2; i++) {
+            if (mag[i] > peak_mag) {
+                peak_mag = mag[i];
                 peak_bin = i;
             }
         }
 
         /* Search negative frequencies (bins FFT_SIZE-1 down to FFT_SIZE-SEARCH_BINS) */
-        for (int i = TONE_FFT_SIZE - 1; i >= TONE_FFT_SIZE - SEARCH_BINS; i--) {
-            if (tt->magnitudes[i] > peak_mag) {
-                peak_mag = tt->magnitudes[i];
+        for (int i = n - 1; i >= n - SEARCH_BINS; i--) {
+            if (mag[i] > peak_mag) {
+                peak_mag = mag[i];
                 peak_bin = i;
             }
         }
 
         /* Convert bin to Hz (handle negative frequencies) */
-        float peak_frac = tone_parabolic_peak(tt->magnitudes, peak_bin, TONE_FFT_SIZE);
+        float peak_frac = tone_parabolic_peak(mag, peak_bin, n);
         float measured_hz;
-        if (peak_bin < TONE_FFT_SIZE / 2) {
+        if (peak_bin < n / 2) {
             measured_hz = peak_frac * TONE_HZ_PER_BIN;
         } else {
-            measured_hz = (peak_frac - TONE_FFT_SIZE) * TONE_HZ_PER_BIN;
+            measured_hz = (peak_frac - n) * TONE_HZ_PER_BIN;
         }
 
         /* Estimate noise floor (away from carrier) */
-        float noise_floor = tone_estimate_noise_floor(tt->magnitudes, TONE_FFT_SIZE, 0, SEARCH_BINS + 5);
+        float noise_floor = measure_noise_floor(tt, mag, n, 0);
         tt->noise_floor_linear = noise_floor;  /* Store for marker detector baseline */
         tt->snr_db = 20.0f * log10f(peak_mag / (noise_floor + 1e-10f));
         tt->valid = (tt->snr_db >= MIN_SNR_DB);
 
         if (tt->valid) {
+            measured_hz = refine_peak(tt, zoom, measured_hz);
             tt->measured_hz = measured_hz;
             tt->offset_hz = measured_hz;  /* Offset from 0 Hz */
             tt->offset_ppm = (tt->offset_hz / 1.0f) * (CARRIER_NOMINAL_HZ / 1e6f);  /* PPM relative to carrier */
@@ -78,6 +123,7 @@ void tone_measure_frequency(tone_tracker_t *tt) {
             tt->offset_hz = 0.0f;
             tt->offset_ppm = 0.0f;
         }
+        WWV_PERF_END(tt->perf, WWV_PERF_TONE_ESTIMATE, t1);
         return;
     }
 
@@ -85,27 +131,26 @@ void tone_measure_frequency(tone_tracker_t *tt) {
 
     /* Find expected bin locations */
     int nominal_bin = (int)(tt->nominal_hz / TONE_HZ_PER_BIN + 0.5f);
-    int lsb_center = TONE_FFT_SIZE - nominal_bin;
+    int lsb_center = n - nominal_bin;
 
     /* Find USB peak (positive frequency) */
-    int usb_peak_bin = tone_find_peak_bin(tt->magnitudes,
+    int usb_peak_bin = tone_find_peak_bin(mag,
                                           nominal_bin - SEARCH_BINS,
                                           nominal_bin + SEARCH_BINS,
-                                          TONE_FFT_SIZE);
-    float usb_peak_frac = tone_parabolic_peak(tt->magnitudes, usb_peak_bin, TONE_FFT_SIZE);
-    float usb_peak_mag = tt->magnitudes[usb_peak_bin];
+                                          n);
+    float usb_peak_frac = tone_parabolic_peak(mag, usb_peak_bin, n);
+    float usb_peak_mag = mag[usb_peak_bin];
 
     /* Find LSB peak (negative frequency) */
-    int lsb_peak_bin = tone_find_peak_bin(tt->magnitudes,
+    int lsb_peak_bin = tone_find_peak_bin(mag,
                                           lsb_center - SEARCH_BINS,
                                           lsb_center + SEARCH_BINS,
-                                          TONE_FFT_SIZE);
-    float lsb_peak_frac = tone_parabolic_peak(tt->magnitudes, lsb_peak_bin, TONE_FFT_SIZE);
-    float lsb_peak_mag = tt->magnitudes[lsb_peak_bin];
+                                          n);
+    float lsb_peak_frac = tone_parabolic_peak(mag, lsb_peak_bin, n);
+    float lsb_peak_mag = mag[lsb_peak_bin];
 
     /* Estimate noise floor */
-    float noise_floor = tone_estimate_noise_floor(tt->magnitudes, TONE_FFT_SIZE,
-                                                   nominal_bin, SEARCH_BINS + 5);
+    float noise_floor = measure_noise_floor(tt, mag, n, nominal_bin);
     tt->noise_floor_linear = noise_floor;  /* Store for marker detector baseline */
 
     /* Calculate SNR (use stronger sideband) */
@@ -117,8 +162,8 @@ void tone_measure_frequency(tone_tracker_t *tt) {
 
     if (tt->valid) {
         /* Sideband spacing method for best accuracy */
-        float usb_hz = usb_peak_frac * TONE_HZ_PER_BIN;
-        float lsb_hz = (TONE_FFT_SIZE - lsb_peak_frac) * TONE_HZ_PER_BIN;
+        float usb_hz = refine_peak(tt, zoom, usb_peak_frac * TONE_HZ_PER_BIN);
+        float lsb_hz = -refine_peak(tt, zoom, (lsb_peak_frac - n) * TONE_HZ_PER_BIN);
 
         /* Average both sidebands */
         tt->measured_hz = (usb_hz + lsb_hz) / 2.0f;
@@ -131,6 +176,7 @@ void tone_measure_frequency(tone_tracker_t *tt) {
         tt->offset_hz = 0.0f;
         tt->offset_ppm = 0.0f;
     }
+    WWV_PERF_END(tt->perf, WWV_PERF_TONE_ESTIMATE, t1);
 }
 
 /*============================================================================
@@ -138,22 +184,29 @@ void tone_measure_frequency(tone_tracker_t *tt) {
  *============================================================================*/
 
 void tone_log_measurement(tone_tracker_t *tt) {
-    if (!tt->csv_file) return;
+    if (!tt->csv_log) return;
+
+    /* Start of the measured window on the 64-bit sample clock */
+    double timestamp_ms = tone_window_start_ms(tt);
+
+    wwv_csv_log_row_at(tt->csv_log, time(NULL),
+                       "%.1f,%.3f,%.3f,%.2f,%.1f,%s\n",
+                       timestamp_ms,
+                       tt->measured_hz,
+                       tt->offset_hz,
+                       tt->offset_ppm,
+                       tt->snr_db,
+                       tt->valid ? "YES" : "NO");
+}
+
+void tone_send_measurement(tone_tracker_t *tt) {
+    if (!tt->valid || !telem_ctx_is_enabled(tt->telem, tt->telem_channel)) return;
 
-    time_t now = time(NULL);
-    struct tm *tm_info = localtime(&now);
     char time_str[16];
-    strftime(time_str, sizeof(time_str), "%H:%M:%S", tm_info);
-
-    float timestamp_ms = tt->frame_count * TONE_FRAME_MS;
-
-    fprintf(tt->csv_file, "%s,%.1f,%.3f,%.3f,%.2f,%.1f,%s\n",
-            time_str,
-            timestamp_ms,
-            tt->measured_hz,
-            tt->offset_hz,
-            tt->offset_ppm,
-            tt->snr_db,
-            tt->valid ? "YES" : "NO");
-    fflush(tt->csv_file);
+    time_t now = time(NULL);
+    strftime(time_str, sizeof(time_str), "%H:%M:%S", wwv_localtime(&now));
+
+    telem_ctx_sendf(tt->telem, tt->telem_channel, "%s,%.1f,%.3f,%.3f,%.2f,%.1f",
+                    time_str, tone_window_start_ms(tt), tt->measured_hz,
+                    tt->offset_hz, tt->offset_ppm, tt->snr_db);
 }
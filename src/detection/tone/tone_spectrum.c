@@ -0,0 +1,186 @@
+/**
+ * @file tone_spectrum.c
+ * @brief One window and FFT per hop shared by several tone trackers
+ *
+ * The window is a mirrored ring like a tracker's own; each computed hop
+ * leaves the magnitudes in place and every attached tracker measures its
+ * bins from them, so the per-tracker cost is only its peak search.
+ */
+
+#include "tone_tracker.h"
+#include "detection/tone/tone_tracker_internal.h"
+#include "fft_processor.h"
+#include "wwv_arena.h"
+#include "wwv_trace.h"
+#include <stdio.h>
+
+/*============================================================================
+ * Hops
+ *============================================================================*/
+
+static double window_start_ms(const tone_spectrum_t *ts) {
+    return wwv_samples_to_ms(ts->window_end - TONE_FFT_SIZE, TONE_SAMPLE_RATE);
+}
+
+static void compute(tone_spectrum_t *ts) {
+    ts->stale = false;
+    ts->window_end = ts->sample_count;
+
+    WWV_TRACE_BEGIN(tr);
+    WWV_PERF_BEGIN(ts->perf, t0);
+    fft_processor_process(ts->fft, wwv_window_ring_window(&ts->ring_i),
+                          wwv_window_ring_window(&ts->ring_q));
+    fft_processor_get_magnitudes(ts->fft, ts->magnitudes);
+    WWV_PERF_END(ts->perf, WWV_PERF_TONE_FFT, t0);
+    WWV_TRACE_END("detector", "tone_spectrum_fft", tr, window_start_ms(ts));
+    ts->fft_count++;
+
+    channel_quality_process_magnitudes(ts->quality, ts->magnitudes, TONE_FFT_SIZE,
+                                       window_start_ms(ts));
+}
+
+static void estimate(tone_spectrum_t *ts, tone_tracker_t *tt) {
+    tt->sample_count = ts->window_end;      /* Timestamps the estimate */
+    tone_tracker_estimate(tt);
+}
+
+/* Each tracker keeps its own cadence: it is due once its hop has passed */
+static void on_hop(tone_spectrum_t *ts) {
+    bool due[TONE_SPECTRUM_MAX_TRACKERS];
+    bool wanted = ts->tap != NULL;
+
+    for (int k = 0; k < ts->tracker_count; k++) {
+        tone_tracker_t *tt = ts->trackers[k];
+        tt->samples_collected += ts->hop_size;
+        due[k] = tt->samples_collected >= tt->hop_size;
+        if (!due[k]) continue;
+        tt->samples_collected = 0;
+        if (tone_tracker_wants_every_hop(tt)) wanted = true;
+    }
+
+    if (wanted) compute(ts);
+    else ts->stale = true;
+
+    for (int k = 0; k < ts->tracker_count; k++) {
+        if (!due[k]) continue;
+        if (wanted && tone_tracker_wants_every_hop(ts->trackers[k])) {
+            estimate(ts, ts->trackers[k]);
+        } else {
+            ts->trackers[k]->stale = true;
+        }
+    }
+
+    if (ts->tap) {
+        ts->tap(ts->magnitudes, TONE_FFT_SIZE, window_start_ms(ts), ts->tap_user_data);
+    }
+}
+
+void tone_spectrum_refresh(tone_spectrum_t *ts) {
+    if (ts->stale) compute(ts);
+    for (int k = 0; k < ts->tracker_count; k++) {
+        if (ts->trackers[k]->stale) estimate(ts, ts->trackers[k]);
+    }
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+tone_spectrum_t *tone_spectrum_create(int hop) {
+    tone_spectrum_t *ts = (tone_spectrum_t *)wwv_calloc(1, sizeof(tone_spectrum_t));
+    if (!ts) return NULL;
+
+    if (hop > TONE_FFT_SIZE) hop = TONE_FFT_SIZE;
+    hop -= hop % TONE_ZOOM_DECIMATION;
+    if (hop < TONE_ZOOM_DECIMATION) hop = TONE_ZOOM_DECIMATION;
+    ts->hop_size = hop;
+
+    bool rings_ok = wwv_window_ring_init(&ts->ring_i, TONE_FFT_SIZE);
+    rings_ok = wwv_window_ring_init(&ts->ring_q, TONE_FFT_SIZE) && rings_ok;
+    ts->magnitudes = (float *)wwv_calloc(TONE_FFT_SIZE, sizeof(float));
+    ts->fft = fft_processor_create(TONE_FFT_SIZE, TONE_SAMPLE_RATE);
+
+    if (!rings_ok || !ts->magnitudes || !ts->fft) {
+        tone_spectrum_destroy(ts);
+        return NULL;
+    }
+
+    printf("[TONE] Shared spectrum: %d-pt FFT every %d samples (%.1f ms)\n",
+           TONE_FFT_SIZE, hop, hop * 1000.0f / TONE_SAMPLE_RATE);
+    return ts;
+}
+
+void tone_spectrum_destroy(tone_spectrum_t *ts) {
+    if (!ts) return;
+
+    for (int k = 0; k < ts->tracker_count; k++) {
+        ts->trackers[k]->spectrum = NULL;
+        ts->trackers[k]->stale = false;
+    }
+    if (ts->fft) fft_processor_destroy(ts->fft);
+    wwv_free(ts->magnitudes);
+    wwv_window_ring_free(&ts->ring_i);
+    wwv_window_ring_free(&ts->ring_q);
+    wwv_free(ts);
+}
+
+bool tone_spectrum_attach(tone_spectrum_t *ts, tone_tracker_t *tt) {
+    if (!ts || !tt || tt->spectrum || ts->tracker_count == TONE_SPECTRUM_MAX_TRACKERS) return false;
+
+    tone_tracker_set_adaptive_zoom(tt, false);
+    tt->spectrum = ts;
+    tt->stale = false;
+    tt->samples_collected = 0;
+    ts->trackers[ts->tracker_count++] = tt;
+    return true;
+}
+
+void tone_spectrum_set_tap(tone_spectrum_t *ts, tone_spectrum_fn fn, void *user_data) {
+    if (!ts) return;
+    ts->tap = fn;
+    ts->tap_user_data = user_data;
+}
+
+void tone_spectrum_set_channel_quality(tone_spectrum_t *ts, channel_quality_t *cq) {
+    if (!ts) return;
+    ts->quality = cq;
+}
+
+void tone_spectrum_process_block(tone_spectrum_t *ts, const float *i_samples,
+                                 const float *q_samples, size_t count) {
+    if (!ts || !i_samples || !q_samples) return;
+
+    for (size_t n = 0; n < count; n++) {
+        wwv_window_ring_push(&ts->ring_i, i_samples[n]);
+        wwv_window_ring_push(&ts->ring_q, q_samples[n]);
+        ts->sample_count++;
+
+        if (++ts->samples_collected >= ts->hop_size && ts->sample_count >= TONE_FFT_SIZE) {
+            ts->samples_collected = 0;
+            on_hop(ts);
+        }
+    }
+}
+
+void tone_spectrum_skip(tone_spectrum_t *ts, uint64_t samples) {
+    if (!ts) return;
+
+    ts->sample_count += samples;
+    wwv_window_ring_reset(&ts->ring_i);
+    wwv_window_ring_reset(&ts->ring_q);
+    ts->samples_collected = ts->hop_size - TONE_FFT_SIZE;   /* Refill first */
+    ts->stale = false;
+    for (int k = 0; k < ts->tracker_count; k++) {
+        ts->trackers[k]->samples_collected = 0;
+        ts->trackers[k]->stale = false;
+    }
+}
+
+void tone_spectrum_set_perf(tone_spectrum_t *ts, wwv_perf_t *perf) {
+    if (!ts) return;
+    ts->perf = perf;
+}
+
+uint64_t tone_spectrum_get_fft_count(const tone_spectrum_t *ts) {
+    return ts ? ts->fft_count : 0;
+}
@@ -6,34 +6,164 @@
  * - Both sidebands (USB + LSB) for accuracy
  * - Parabolic interpolation for sub-bin resolution
  * - SNR gating for validity
+ *
+ * The window is a mirrored ring, so overlapping estimates (hop < FFT size)
+ * cost one FFT per hop and no copying. With adaptive zoom, a decimating FIR
+ * runs alongside and, once TONE_ZOOM_LOCK_COUNT estimates in a row are
+ * valid, the 4x smaller zoom FFT replaces the full one until lock is lost.
+ *
+ * Buffering (rings, zoom FIR) runs every sample either way; only the hop's
+ * estimate is deferred when nothing consumes it (see tone_tracker.h).
  */
 
 #include "tone_tracker.h"
 #include "detection/tone/tone_tracker_internal.h"
 #include "fft_processor.h"
+#include "polyphase_resampler.h"
 #include "version.h"
+#include "wwv_thread.h"
+#include "wwv_arena.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <time.h>
 
+/* Zoom FIR cutoff: midway between the sidebands (<= ~640 Hz) and the first
+ * frequency that aliases onto them at 3 kHz (~2.36 kHz) */
+#define TONE_ZOOM_CUTOFF_HZ     1500.0f
+
+/*============================================================================
+ * Adaptive Zoom
+ *============================================================================*/
+
+static bool zoom_init(tone_tracker_t *tt) {
+    polyphase_design_lowpass(tt->zoom_taps, TONE_ZOOM_TAPS, TONE_SAMPLE_RATE,
+                             TONE_ZOOM_CUTOFF_HZ, 1.0f);
+
+    bool ok = wwv_window_ring_init(&tt->zoom_ring_i, TONE_ZOOM_FFT_SIZE);
+    ok = wwv_window_ring_init(&tt->zoom_ring_q, TONE_ZOOM_FFT_SIZE) && ok;
+    tt->zoom_fft = fft_processor_create(TONE_ZOOM_FFT_SIZE,
+                                        (float)TONE_SAMPLE_RATE / TONE_ZOOM_DECIMATION);
+    return ok && tt->zoom_fft;
+}
+
+static zoom_dft_t *zoom_refine_create(void) {
+    return zoom_dft_create(TONE_ZOOM_FFT_SIZE, (float)TONE_SAMPLE_RATE / TONE_ZOOM_DECIMATION,
+                           FFT_WINDOW_HANN);
+}
+
+static void zoom_free(tone_tracker_t *tt) {
+    if (tt->zoom_fft) fft_processor_destroy(tt->zoom_fft);
+    tt->zoom_fft = NULL;
+    zoom_dft_destroy(tt->zoom_refine);
+    tt->zoom_refine = NULL;
+    wwv_window_ring_free(&tt->zoom_ring_i);
+    wwv_window_ring_free(&tt->zoom_ring_q);
+}
+
+/**
+ * One decimated output per TONE_ZOOM_DECIMATION inputs, filtered straight
+ * from the newest samples of the main window (taps are symmetric)
+ */
+static void zoom_push(tone_tracker_t *tt) {
+    if (++tt->zoom_phase < TONE_ZOOM_DECIMATION) return;
+    tt->zoom_phase = 0;
+
+    const float *x_i = wwv_window_ring_recent(&tt->ring_i, TONE_ZOOM_TAPS);
+    const float *x_q = wwv_window_ring_recent(&tt->ring_q, TONE_ZOOM_TAPS);
+    float acc_i = 0.0f, acc_q = 0.0f;
+    for (int k = 0; k < TONE_ZOOM_TAPS; k++) {
+        acc_i += tt->zoom_taps[k] * x_i[k];
+        acc_q += tt->zoom_taps[k] * x_q[k];
+    }
+
+    wwv_window_ring_push(&tt->zoom_ring_i, acc_i);
+    wwv_window_ring_push(&tt->zoom_ring_q, acc_q);
+    if (tt->zoom_fill < TONE_ZOOM_FFT_SIZE) tt->zoom_fill++;
+}
+
+void tone_update_zoom_lock(tone_tracker_t *tt) {
+    if (!tt->zoom_enabled) return;
+
+    if (!tt->valid) {
+        if (tt->zoomed) {
+            printf("[TONE] %.0f Hz: lock lost, back to %d-pt FFT\n", tt->nominal_hz, TONE_FFT_SIZE);
+        }
+        tt->lock_count = 0;
+        tt->zoomed = false;
+        return;
+    }
+
+    if (!tt->zoomed && ++tt->lock_count >= TONE_ZOOM_LOCK_COUNT) {
+        tt->zoomed = true;
+        printf("[TONE] %.0f Hz: locked, zoom %d-pt FFT at %.0f Hz\n", tt->nominal_hz,
+               TONE_ZOOM_FFT_SIZE, (float)TONE_SAMPLE_RATE / TONE_ZOOM_DECIMATION);
+    }
+}
+
+/*============================================================================
+ * Estimates
+ *============================================================================*/
+
+void tone_tracker_estimate(tone_tracker_t *tt) {
+    tt->stale = false;
+
+    tone_measure_frequency(tt);
+    tone_update_zoom_lock(tt);
+    tone_log_measurement(tt);
+    tone_send_measurement(tt);
+
+    if (tt->callback) {
+        tone_measurement_t m;
+        tone_tracker_get_measurement(tt, &m);
+        tt->callback(&m, tt->callback_user_data);
+    }
+
+    tt->frame_count++;
+}
+
+/* Something takes every estimate, so each hop must be measured */
+bool tone_tracker_wants_every_hop(tone_tracker_t *tt) {
+    return !tt->demand_driven || tt->csv_log || tt->callback ||
+           telem_ctx_is_enabled(tt->telem, tt->telem_channel);
+}
+
+/* Getter side: bring a stale estimate up to date */
+static void refresh(tone_tracker_t *tt) {
+    if (!tt->stale) return;
+    if (tt->spectrum) {
+        tone_spectrum_refresh(tt->spectrum);
+    } else {
+        tone_tracker_estimate(tt);
+    }
+}
+
+static telem_channel_t channel_for(float nominal_hz) {
+    if (nominal_hz == 500.0f) return TELEM_TONE500;
+    if (nominal_hz == 600.0f) return TELEM_TONE600;
+    return TELEM_CARRIER;
+}
+
 /*============================================================================
  * Public API
  *============================================================================*/
 
 tone_tracker_t *tone_tracker_create(float nominal_hz, const char *csv_path) {
-    tone_tracker_t *tt = (tone_tracker_t *)calloc(1, sizeof(tone_tracker_t));
+    tone_tracker_t *tt = (tone_tracker_t *)wwv_aligned_calloc(WWV_CACHE_LINE, sizeof(tone_tracker_t));
     if (!tt) return NULL;
 
     tt->nominal_hz = nominal_hz;
+    tt->hop_size = TONE_DEFAULT_HOP;
     tt->start_time = time(NULL);
+    tt->demand_driven = true;
+    tt->telem_channel = channel_for(nominal_hz);
 
     /* Allocate buffers */
-    tt->buffer_i = (float *)calloc(TONE_FFT_SIZE, sizeof(float));
-    tt->buffer_q = (float *)calloc(TONE_FFT_SIZE, sizeof(float));
-    tt->magnitudes = (float *)malloc(TONE_FFT_SIZE * sizeof(float));
+    bool rings_ok = wwv_window_ring_init(&tt->ring_i, TONE_FFT_SIZE);
+    rings_ok = wwv_window_ring_init(&tt->ring_q, TONE_FFT_SIZE) && rings_ok;
+    tt->magnitudes = (float *)wwv_malloc(TONE_FFT_SIZE * sizeof(float));
 
-    if (!tt->buffer_i || !tt->buffer_q || !tt->magnitudes) {
+    if (!rings_ok || !tt->magnitudes) {
         tone_tracker_destroy(tt);
         return NULL;
     }
@@ -47,19 +177,18 @@ tone_tracker_t *tone_tracker_create(float nominal_hz, const char *csv_path) {
 
     /* Open CSV file */
     if (csv_path) {
-        tt->csv_file = fopen(csv_path, "w");
-        if (tt->csv_file) {
+        tt->csv_log = wwv_csv_log_open(csv_path);
+        if (tt->csv_log) {
             char time_str[64];
             strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S",
-                     localtime(&tt->start_time));
-
-            fprintf(tt->csv_file, "# Phoenix SDR WWV Tone Tracker (%.0f Hz) v%s\n",
-                    nominal_hz, PHOENIX_VERSION_FULL);
-            fprintf(tt->csv_file, "# Started: %s\n", time_str);
-            fprintf(tt->csv_file, "# FFT: %d-pt, %.2f Hz/bin, %.1f ms frame\n",
-                    TONE_FFT_SIZE, TONE_HZ_PER_BIN, TONE_FRAME_MS);
-            fprintf(tt->csv_file, "time,timestamp_ms,measured_hz,offset_hz,offset_ppm,snr_db,valid\n");
-            fflush(tt->csv_file);
+                     wwv_localtime(&tt->start_time));
+
+            wwv_csv_log_header(tt->csv_log, "# Phoenix SDR WWV Tone Tracker (%.0f Hz) v%s\n",
+                               nominal_hz, PHOENIX_VERSION_FULL);
+            wwv_csv_log_header(tt->csv_log, "# Started: %s\n", time_str);
+            wwv_csv_log_header(tt->csv_log, "# FFT: %d-pt, %.2f Hz/bin, %.1f ms frame\n",
+                               TONE_FFT_SIZE, TONE_HZ_PER_BIN, TONE_FRAME_MS);
+            wwv_csv_log_header(tt->csv_log, "time,timestamp_ms,measured_hz,offset_hz,offset_ppm,snr_db,valid\n");
         }
     }
 
@@ -72,64 +201,199 @@ tone_tracker_t *tone_tracker_create(float nominal_hz, const char *csv_path) {
 void tone_tracker_destroy(tone_tracker_t *tt) {
     if (!tt) return;
 
-    if (tt->csv_file) fclose(tt->csv_file);
+    wwv_csv_log_close(tt->csv_log);
     if (tt->fft) fft_processor_destroy(tt->fft);
-    free(tt->buffer_i);
-    free(tt->buffer_q);
-    free(tt->magnitudes);
-    free(tt);
+    zoom_free(tt);
+    zoom_dft_destroy(tt->refine);
+    wwv_window_ring_free(&tt->ring_i);
+    wwv_window_ring_free(&tt->ring_q);
+    wwv_free(tt->magnitudes);
+    wwv_aligned_free(tt);
 }
 
 void tone_tracker_process_sample(tone_tracker_t *tt, float i, float q) {
     if (!tt) return;
 
     /* Store sample in circular buffer */
-    tt->buffer_i[tt->buffer_idx] = i;
-    tt->buffer_q[tt->buffer_idx] = q;
-    tt->buffer_idx = (tt->buffer_idx + 1) % TONE_FFT_SIZE;
+    wwv_window_ring_push(&tt->ring_i, i);
+    wwv_window_ring_push(&tt->ring_q, q);
     tt->samples_collected++;
+    tt->sample_count++;
 
-    /* Process when buffer is full */
-    if (tt->samples_collected >= TONE_FFT_SIZE) {
+    if (tt->zoom_enabled) zoom_push(tt);
+
+    /* Estimate every hop once the first window is full, or leave it stale */
+    if (tt->samples_collected >= tt->hop_size && tt->sample_count >= TONE_FFT_SIZE) {
         tt->samples_collected = 0;
 
-        tone_measure_frequency(tt);
-        tone_log_measurement(tt);
+        if (tone_tracker_wants_every_hop(tt)) {
+            tone_tracker_estimate(tt);
+        } else {
+            tt->stale = true;
+        }
+    }
+}
+
+void tone_tracker_skip(tone_tracker_t *tt, uint64_t samples) {
+    if (!tt || tt->spectrum) return;
+
+    tt->sample_count += samples;
+    wwv_window_ring_reset(&tt->ring_i);
+    wwv_window_ring_reset(&tt->ring_q);
+    tt->samples_collected = tt->hop_size - TONE_FFT_SIZE;   /* Refill first */
+    if (tt->zoom_enabled) {
+        wwv_window_ring_reset(&tt->zoom_ring_i);
+        wwv_window_ring_reset(&tt->zoom_ring_q);
+        tt->zoom_phase = 0;
+        tt->zoom_fill = 0;
+    }
+    tt->zoomed = false;
+    tt->lock_count = 0;
+    tt->stale = false;
+}
+
+void tone_tracker_set_hop_size(tone_tracker_t *tt, int hop) {
+    if (!tt) return;
+    if (hop > TONE_FFT_SIZE) hop = TONE_FFT_SIZE;
+    hop -= hop % TONE_ZOOM_DECIMATION;
+    if (hop < TONE_ZOOM_DECIMATION) hop = TONE_ZOOM_DECIMATION;
+
+    tt->hop_size = hop;
+    printf("[TONE] %.0f Hz: hop %d samples (%.1f ms, %.0f%% overlap)\n", tt->nominal_hz, hop,
+           hop * 1000.0f / TONE_SAMPLE_RATE, 100.0f * (1.0f - (float)hop / TONE_FFT_SIZE));
+}
+
+int tone_tracker_get_hop_size(tone_tracker_t *tt) {
+    return tt ? tt->hop_size : 0;
+}
+
+void tone_tracker_set_adaptive_zoom(tone_tracker_t *tt, bool enable) {
+    if (!tt || enable == tt->zoom_enabled) return;
+    if (enable && tt->spectrum) {
+        printf("[TONE] %.0f Hz: no zoom on a shared spectrum\n", tt->nominal_hz);
+        return;
+    }
+
+    if (enable) {
+        if (!zoom_init(tt)) {
+            zoom_free(tt);
+            printf("[TONE] %.0f Hz: zoom allocation failed\n", tt->nominal_hz);
+            return;
+        }
+        tt->zoom_phase = 0;
+        tt->zoom_fill = 0;
+        if (tt->refine) {
+            tt->zoom_refine = zoom_refine_create();
+        }
+    } else {
+        zoom_free(tt);
+    }
+    tt->zoom_enabled = enable;
+    tt->zoomed = false;
+    tt->lock_count = 0;
+}
+
+bool tone_tracker_is_zoomed(tone_tracker_t *tt) {
+    return tt ? tt->zoomed : false;
+}
+
+void tone_tracker_set_perf(tone_tracker_t *tt, wwv_perf_t *perf) {
+    if (!tt) return;
+    tt->perf = perf;
+    wwv_csv_log_set_perf(tt->csv_log, perf);
+}
+
+void tone_tracker_set_fine_refinement(tone_tracker_t *tt, bool enable) {
+    if (!tt || enable == (tt->refine != NULL)) return;
+
+    if (enable) {
+        tt->refine = zoom_dft_create(TONE_FFT_SIZE, TONE_SAMPLE_RATE, FFT_WINDOW_HANN);
+        if (tt->zoom_enabled) {
+            tt->zoom_refine = zoom_refine_create();
+        }
+    } else {
+        zoom_dft_destroy(tt->refine);
+        zoom_dft_destroy(tt->zoom_refine);
+        tt->refine = NULL;
+        tt->zoom_refine = NULL;
+    }
+}
 
-        tt->frame_count++;
+void tone_tracker_set_callback(tone_tracker_t *tt, tone_callback_fn cb, void *user_data) {
+    if (!tt) return;
+    tt->callback = cb;
+    tt->callback_user_data = user_data;
+}
+
+void tone_tracker_set_telemetry(tone_tracker_t *tt, telem_ctx_t *ctx) {
+    if (!tt) return;
+    tt->telem = ctx;
+}
+
+void tone_tracker_set_demand_driven(tone_tracker_t *tt, bool enable) {
+    if (!tt) return;
+    tt->demand_driven = enable;
+}
+
+bool tone_tracker_get_measurement(tone_tracker_t *tt, tone_measurement_t *out) {
+    if (!tt) return false;
+    refresh(tt);
+    if (out) {
+        out->timestamp_ms = tone_window_start_ms(tt);
+        out->measured_hz = tt->measured_hz;
+        out->offset_hz = tt->offset_hz;
+        out->offset_ppm = tt->offset_ppm;
+        out->snr_db = tt->snr_db;
+        out->valid = tt->valid;
     }
+    return tt->frame_count > 0 || tt->stale;
 }
 
 float tone_tracker_get_measured_hz(tone_tracker_t *tt) {
-    return tt ? tt->measured_hz : 0.0f;
+    if (!tt) return 0.0f;
+    refresh(tt);
+    return tt->measured_hz;
 }
 
 float tone_tracker_get_offset_hz(tone_tracker_t *tt) {
-    return tt ? tt->offset_hz : 0.0f;
+    if (!tt) return 0.0f;
+    refresh(tt);
+    return tt->offset_hz;
 }
 
 float tone_tracker_get_offset_ppm(tone_tracker_t *tt) {
-    return tt ? tt->offset_ppm : 0.0f;
+    if (!tt) return 0.0f;
+    refresh(tt);
+    return tt->offset_ppm;
 }
 
 float tone_tracker_get_snr_db(tone_tracker_t *tt) {
-    return tt ? tt->snr_db : 0.0f;
+    if (!tt) return 0.0f;
+    refresh(tt);
+    return tt->snr_db;
 }
 
 bool tone_tracker_is_valid(tone_tracker_t *tt) {
-    return tt ? tt->valid : false;
+    if (!tt) return false;
+    refresh(tt);
+    return tt->valid;
 }
 
+/* Estimates actually measured (deferred hops are not counted) */
 uint64_t tone_tracker_get_frame_count(tone_tracker_t *tt) {
     return tt ? tt->frame_count : 0;
 }
 
 float tone_tracker_get_noise_floor(tone_tracker_t *tt) {
-    return tt ? tt->noise_floor_linear : 0.0f;
+    if (!tt) return 0.0f;
+    refresh(tt);
+    return tt->noise_floor_linear;
 }
 
 void tone_tracker_update_global_noise_floor(tone_tracker_t *tt) {
-    if (!tt || !tt->valid) return;
+    if (!tt) return;
+    refresh(tt);
+    if (!tt->valid) return;
 
     /* Only update if this tracker has a valid measurement */
     if (tt->noise_floor_linear > 0.0001f) {
@@ -139,6 +403,62 @@ void tone_tracker_update_global_noise_floor(tone_tracker_t *tt) {
     }
 }
 
+/*============================================================================
+ * Warm Start
+ *============================================================================*/
+
+#define TONE_STATE_VERSION  1
+
+typedef struct {
+    float measured_hz;
+    float offset_hz;
+    float offset_ppm;
+    float snr_db;
+    float noise_floor_linear;
+    uint8_t valid;
+    uint8_t reserved[3];
+} tone_state_t;
+
+_Static_assert(sizeof(tone_state_t) == 24, "tone state layout");
+
+static uint16_t section_for(float nominal_hz) {
+    if (nominal_hz == 500.0f) return WWV_STATE_TONE_500;
+    if (nominal_hz == 600.0f) return WWV_STATE_TONE_600;
+    return WWV_STATE_TONE_CARRIER;
+}
+
+bool tone_tracker_save_state(tone_tracker_t *tt, wwv_state_writer_t *w) {
+    if (!tt || !w) return false;
+    refresh(tt);
+    if (tt->frame_count == 0) return false;
+
+    tone_state_t st = {
+        .measured_hz = tt->measured_hz,
+        .offset_hz = tt->offset_hz,
+        .offset_ppm = tt->offset_ppm,
+        .snr_db = tt->snr_db,
+        .noise_floor_linear = tt->noise_floor_linear,
+        .valid = tt->valid
+    };
+    return wwv_state_put(w, section_for(tt->nominal_hz), TONE_STATE_VERSION, &st, sizeof(st));
+}
+
+bool tone_tracker_restore_state(tone_tracker_t *tt, const wwv_state_reader_t *r) {
+    if (!tt || !r || r->elapsed_ms > WWV_STATE_LEVELS_MAX_AGE_MS) return false;
+
+    tone_state_t st;
+    if (!wwv_state_get(r, section_for(tt->nominal_hz), TONE_STATE_VERSION, &st, sizeof(st))) {
+        return false;
+    }
+    tt->measured_hz = st.measured_hz;
+    tt->offset_hz = st.offset_hz;
+    tt->offset_ppm = st.offset_ppm;
+    tt->snr_db = st.snr_db;
+    tt->noise_floor_linear = st.noise_floor_linear;
+    tt->valid = st.valid != 0;
+    return true;
+}
+
 /*============================================================================
  * Global Variables
  *============================================================================*/
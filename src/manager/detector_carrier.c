@@ -0,0 +1,158 @@
+/**
+ * @file detector_carrier.c
+ * @brief Carrier-offset correction of the detector path
+ *
+ * The carrier tracker runs on the display path (12 kHz); the detectors
+ * run on the detector path (50 kHz), in threaded mode on another worker.
+ * The display side steers: each new carrier estimate moves the target
+ * offset by WWV_CARRIER_LOOP_GAIN of its error and publishes it with one
+ * atomic store. The detector side reads it once per block, so a change
+ * lands between blocks, as retuning does (detector_params.c), and mixes
+ * the input through a carrier_nco before any detector sees it.
+ *
+ * Estimates at the edge of the tracker's ±29 Hz search window are the
+ * window's edge, not the carrier, so only those within WWV_CARRIER_MAX_HZ
+ * steer. An invalid or rejected estimate (fade, noise) holds the last
+ * correction: the receiver has not retuned because the signal faded.
+ */
+
+#include "wwv_detector_manager_internal.h"
+#include "carrier_nco.h"
+#include <math.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+struct wwv_carrier_loop {
+    /* Display side */
+    uint64_t frame;                 /* Tracker estimate last looked at */
+    int run;                        /* Consecutive trusted estimates before lock */
+    double run_sum;
+    double target_hz;
+
+    /* Published to the detector side */
+    _Atomic uint64_t offset_bits;   /* target_hz as double bits */
+    atomic_bool active;
+
+    /* Status, written on the display side */
+    _Atomic float estimate_hz;
+    atomic_uint estimates;
+    atomic_uint rejected;
+
+    /* Detector side */
+    carrier_nco_t *nco;
+    uint64_t applied_bits;
+    float out_i[WWV_BLOCK_CHUNK_SAMPLES];
+    float out_q[WWV_BLOCK_CHUNK_SAMPLES];
+};
+
+static uint64_t double_bits(double v) {
+    uint64_t b;
+    memcpy(&b, &v, sizeof(b));
+    return b;
+}
+
+static double bits_double(uint64_t b) {
+    double v;
+    memcpy(&v, &b, sizeof(v));
+    return v;
+}
+
+wwv_carrier_loop_t *wwv_carrier_loop_create(void) {
+    wwv_carrier_loop_t *loop = wwv_calloc(1, sizeof(*loop));
+    if (!loop) return NULL;
+
+    loop->nco = carrier_nco_create((float)TICK_SAMPLE_RATE);
+    if (!loop->nco) {
+        wwv_free(loop);
+        return NULL;
+    }
+    atomic_init(&loop->offset_bits, double_bits(0.0));
+    atomic_init(&loop->active, false);
+    atomic_init(&loop->estimate_hz, 0.0f);
+    atomic_init(&loop->estimates, 0u);
+    atomic_init(&loop->rejected, 0u);
+    loop->applied_bits = double_bits(0.0);
+    printf("[CARRIER] Correction on the detector path: lock after %d estimates within +/-%.0f Hz, "
+           "gain %.2f\n", WWV_CARRIER_LOCK_COUNT, WWV_CARRIER_MAX_HZ, WWV_CARRIER_LOOP_GAIN);
+    return loop;
+}
+
+void wwv_carrier_loop_destroy(wwv_carrier_loop_t *loop) {
+    if (!loop) return;
+    carrier_nco_destroy(loop->nco);
+    wwv_free(loop);
+}
+
+/*============================================================================
+ * Display Side
+ *============================================================================*/
+
+void wwv_carrier_loop_steer(wwv_carrier_loop_t *loop, tone_tracker_t *carrier) {
+    if (!loop || !carrier) return;
+
+    /* Measures a deferred estimate, as any consumer of every hop would */
+    tone_measurement_t m;
+    if (!tone_tracker_get_measurement(carrier, &m)) return;
+    uint64_t frame = tone_tracker_get_frame_count(carrier);
+    if (frame == loop->frame) return;
+    loop->frame = frame;
+    atomic_fetch_add_explicit(&loop->estimates, 1u, memory_order_relaxed);
+
+    if (!m.valid) {
+        loop->run = 0;
+        return;
+    }
+    atomic_store_explicit(&loop->estimate_hz, m.offset_hz, memory_order_relaxed);
+    if (fabsf(m.offset_hz) > WWV_CARRIER_MAX_HZ) {
+        atomic_fetch_add_explicit(&loop->rejected, 1u, memory_order_relaxed);
+        loop->run = 0;
+        return;
+    }
+
+    if (!atomic_load_explicit(&loop->active, memory_order_relaxed)) {
+        loop->run_sum = (loop->run == 0) ? m.offset_hz : loop->run_sum + m.offset_hz;
+        if (++loop->run < WWV_CARRIER_LOCK_COUNT) return;
+        loop->target_hz = loop->run_sum / loop->run;
+        printf("[CARRIER] Locked: correcting %+.3f Hz\n", loop->target_hz);
+    } else {
+        loop->target_hz += WWV_CARRIER_LOOP_GAIN * (m.offset_hz - loop->target_hz);
+    }
+    atomic_store_explicit(&loop->offset_bits, double_bits(loop->target_hz), memory_order_release);
+    atomic_store_explicit(&loop->active, true, memory_order_release);
+}
+
+/*============================================================================
+ * Detector Side
+ *============================================================================*/
+
+bool wwv_carrier_loop_begin(wwv_carrier_loop_t *loop) {
+    if (!loop || !atomic_load_explicit(&loop->active, memory_order_acquire)) return false;
+
+    uint64_t bits = atomic_load_explicit(&loop->offset_bits, memory_order_acquire);
+    if (bits != loop->applied_bits) {
+        carrier_nco_set_offset(loop->nco, bits_double(bits));
+        loop->applied_bits = bits;
+    }
+    return true;
+}
+
+void wwv_carrier_loop_mix(wwv_carrier_loop_t *loop, const float *i_samples,
+                          const float *q_samples, size_t count,
+                          const float **out_i, const float **out_q) {
+    carrier_nco_process(loop->nco, i_samples, q_samples, loop->out_i, loop->out_q, count);
+    *out_i = loop->out_i;
+    *out_q = loop->out_q;
+}
+
+void wwv_carrier_loop_get_status(wwv_carrier_loop_t *loop, wwv_carrier_status_t *out) {
+    memset(out, 0, sizeof(*out));
+    if (!loop) return;
+
+    out->enabled = true;
+    out->active = atomic_load_explicit(&loop->active, memory_order_acquire);
+    out->offset_hz = (float)bits_double(atomic_load_explicit(&loop->offset_bits, memory_order_acquire));
+    out->estimate_hz = atomic_load_explicit(&loop->estimate_hz, memory_order_relaxed);
+    out->estimates = atomic_load_explicit(&loop->estimates, memory_order_relaxed);
+    out->rejected = atomic_load_explicit(&loop->rejected, memory_order_relaxed);
+}
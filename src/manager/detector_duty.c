@@ -0,0 +1,306 @@
+/**
+ * @file detector_duty.c
+ * @brief Duty-cycled sparse wakeup of the detector and display paths
+ *
+ *   ACQUIRE --LOCKED + BCD solved--> ASLEEP --M - lead--> VERIFY
+ *      ^                               ^                    |
+ *      |                               +--marker on M-------+
+ *      |                               |                    | missed
+ *      +-------------missed again----- WIDE <---------------+
+ *                                      (awake to M + 60 s)
+ *
+ * Everything runs in timer callbacks on the detector sample clock, so a
+ * replay sleeps and wakes at the same samples. Sleep starts and ends on
+ * DUTY_ALIGN_SAMPLES, a frame boundary of every detector, which is what
+ * their skip calls need to jump ahead without a partial frame.
+ *
+ * M is the marker duty_cycle_minutes past the last one sync confirmed, in
+ * sync's own convention (the tick detector's marker trailing edge). That
+ * marker anchors a relative-mode wwv_clock, whose minute grid the wake is
+ * checked against. Verification is sync's marker confirmation itself: the
+ * wake resumes sync TENTATIVE on the held anchor, and the marker that
+ * locks it again must land within WWV_DUTY_MARKER_TOL_MS of the grid.
+ *
+ * The display path runs on another thread in threaded mode; it reads the
+ * asleep flag once per block and catches its trackers up on waking.
+ */
+
+#include "wwv_detector_manager_internal.h"
+#include "wwv_clock.h"
+#include <math.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+#define DUTY_ALIGN_SAMPLES  BCD_FREQ_FFT_SIZE   /* Every detector's frame divides it */
+
+_Static_assert(DUTY_ALIGN_SAMPLES % TICK_FFT_SIZE == 0 &&
+               DUTY_ALIGN_SAMPLES % MARKER_FFT_SIZE == 0 &&
+               DUTY_ALIGN_SAMPLES % BCD_TIME_FFT_SIZE == 0 &&
+               DUTY_ALIGN_SAMPLES % BCD_FREQ_SLIDING_DECIM == 0,
+               "duty-cycle boundaries no longer end every detector's frame");
+
+struct wwv_duty {
+    wwv_detector_manager_t *mgr;
+    int minutes;
+    wwv_timer_t timer;
+    wwv_clock_t *clock;             /* Relative mode, anchored on the last confirmed marker */
+
+    /* Detector side */
+    wwv_duty_state_t state;
+    double target_ms;               /* Predicted marker M */
+    double wake_ms;
+    double acquire_ms;              /* Entered ACQUIRE: a lock needs a marker after it */
+    wwv_sample_t sleep_start;
+    wwv_sample_t slept;             /* Detector samples not processed */
+
+    /* Published to the display side and status readers */
+    atomic_bool asleep;
+    _Atomic uint64_t next_marker_bits;
+    _Atomic uint64_t counted;       /* Detector samples at the last transition */
+    _Atomic uint64_t slept_total;
+    atomic_int shown_state;
+    atomic_uint sleeps;
+    atomic_uint verified;
+    atomic_uint widened;
+    atomic_uint reacquired;
+
+    /* Display side */
+    uint64_t display_slept;
+};
+
+static uint64_t double_bits(double v) {
+    uint64_t b;
+    memcpy(&b, &v, sizeof(b));
+    return b;
+}
+
+static double bits_double(uint64_t b) {
+    double v;
+    memcpy(&v, &b, sizeof(v));
+    return v;
+}
+
+static wwv_sample_t align_down(wwv_sample_t s) {
+    return s - s % DUTY_ALIGN_SAMPLES;
+}
+
+static wwv_sample_t align_up(wwv_sample_t s) {
+    return align_down(s + DUTY_ALIGN_SAMPLES - 1);
+}
+
+static wwv_sample_t ms_to_sample(double ms) {
+    return (ms > 0.0) ? (wwv_sample_t)(ms * TICK_SAMPLE_RATE / 1000.0) : 0;
+}
+
+static void set_state(wwv_duty_t *duty, wwv_duty_state_t state) {
+    duty->state = state;
+    atomic_store_explicit(&duty->shown_state, (int)state, memory_order_relaxed);
+    atomic_store_explicit(&duty->next_marker_bits,
+                          double_bits(state == WWV_DUTY_ACQUIRE ? 0.0 : duty->target_ms),
+                          memory_order_relaxed);
+    atomic_store_explicit(&duty->counted, duty->mgr->detector_samples, memory_order_relaxed);
+}
+
+static void arm_eval(wwv_duty_t *duty) {
+    wwv_timer_arm(duty->mgr->timers, &duty->timer,
+                  align_up(duty->mgr->detector_samples + ms_to_sample(WWV_DUTY_EVAL_MS)));
+}
+
+/* Check after the predicted marker, on a boundary so a pass can sleep at once */
+static void arm_check(wwv_duty_t *duty) {
+    wwv_timer_arm(duty->mgr->timers, &duty->timer,
+                  align_up(ms_to_sample(duty->target_ms + WWV_DUTY_HOLD_MS)));
+}
+
+/*============================================================================
+ * Transitions
+ *============================================================================*/
+
+static bool try_sleep(wwv_duty_t *duty, double now_ms) {
+    wwv_detector_manager_t *mgr = duty->mgr;
+    double last_ms = sync_detector_get_last_marker_ms(mgr->sync_detector);
+    if (last_ms <= 0.0 || !sync_detector_suspend(mgr->sync_detector)) return false;
+
+    /* The anchor is the minute grid verification checks against */
+    wwv_clock_set_anchor(duty->clock, last_ms);
+    double target = last_ms + duty->minutes * 60000.0;
+    wwv_sample_t wake = align_down(ms_to_sample(target - WWV_DUTY_WAKE_LEAD_MS));
+    while (wake <= mgr->detector_samples) {
+        target += 60000.0;
+        wake = align_down(ms_to_sample(target - WWV_DUTY_WAKE_LEAD_MS));
+    }
+
+    duty->target_ms = target;
+    duty->sleep_start = mgr->detector_samples;
+    wwv_timer_arm(mgr->timers, &duty->timer, wake);
+    atomic_store_explicit(&duty->asleep, true, memory_order_release);
+    atomic_fetch_add_explicit(&duty->sleeps, 1u, memory_order_relaxed);
+    set_state(duty, WWV_DUTY_ASLEEP);
+    printf("[DUTY] Sleeping at %.1fs: wake %.1fs for the marker at %.1fs\n",
+           now_ms / 1000.0, wwv_samples_to_ms(wake, TICK_SAMPLE_RATE) / 1000.0, target / 1000.0);
+    return true;
+}
+
+static void wake(wwv_duty_t *duty, double now_ms) {
+    wwv_detector_manager_t *mgr = duty->mgr;
+    uint64_t slept = mgr->detector_samples - duty->sleep_start;
+
+    /* Frames jump ahead; levels, thresholds and the gate epoch are kept */
+    bool ok = true;
+    if (mgr->tick_detector) ok = tick_detector_skip(mgr->tick_detector, slept) && ok;
+    if (mgr->marker_detector) ok = marker_detector_skip(mgr->marker_detector, slept) && ok;
+    if (mgr->bcd_time_detector) ok = bcd_time_detector_skip(mgr->bcd_time_detector, slept) && ok;
+    if (mgr->bcd_freq_detector) ok = bcd_freq_detector_skip(mgr->bcd_freq_detector, slept) && ok;
+    if (!ok) printf("[DUTY] A detector was mid-frame at sleep; its timing is off until it resyncs\n");
+
+    duty->wake_ms = now_ms;
+    duty->slept += slept;
+    atomic_store_explicit(&duty->slept_total, duty->slept, memory_order_relaxed);
+    atomic_store_explicit(&duty->asleep, false, memory_order_release);
+    sync_detector_resume(mgr->sync_detector, now_ms);
+    set_state(duty, WWV_DUTY_VERIFY);
+    arm_check(duty);
+}
+
+static void check(wwv_duty_t *duty, double now_ms) {
+    wwv_detector_manager_t *mgr = duty->mgr;
+    double last_ms = sync_detector_get_last_marker_ms(mgr->sync_detector);
+    double phase = wwv_clock_get_phase_at_ms(duty->clock, last_ms);
+    double off_ms = (phase > 30000.0) ? phase - 60000.0 : phase;
+
+    /* A marker confirmed since the wake, on the grid the sleep started from */
+    bool on_time = last_ms > duty->wake_ms && fabs(off_ms) <= WWV_DUTY_MARKER_TOL_MS &&
+                   sync_detector_get_state(mgr->sync_detector) == SYNC_LOCKED;
+
+    if (on_time) {
+        atomic_fetch_add_explicit(&duty->verified, 1u, memory_order_relaxed);
+        printf("[DUTY] Marker verified at %.1fs (%+.0fms)\n", last_ms / 1000.0, off_ms);
+        if (try_sleep(duty, now_ms)) return;
+    } else if (duty->state == WWV_DUTY_VERIFY) {
+        atomic_fetch_add_explicit(&duty->widened, 1u, memory_order_relaxed);
+        duty->target_ms += 60000.0;
+        printf("[DUTY] No marker on the prediction; awake to %.1fs\n", duty->target_ms / 1000.0);
+        set_state(duty, WWV_DUTY_WIDE);
+        arm_check(duty);
+        return;
+    } else {
+        atomic_fetch_add_explicit(&duty->reacquired, 1u, memory_order_relaxed);
+        printf("[DUTY] Missed again; acquiring\n");
+    }
+    duty->acquire_ms = now_ms;
+    set_state(duty, WWV_DUTY_ACQUIRE);
+    arm_eval(duty);
+}
+
+static void on_timer(wwv_timer_t *timer, double now_ms, void *user_data) {
+    wwv_duty_t *duty = (wwv_duty_t *)user_data;
+    wwv_detector_manager_t *mgr = duty->mgr;
+    (void)timer;
+
+    switch (duty->state) {
+        case WWV_DUTY_ACQUIRE: {
+            /* Without the BCD path the node wants only the second and minute phase.
+             * Sync holds LOCKED through a marker gap, so the lock must be fresh. */
+            bcd_time_solution_t sol;
+            if (sync_detector_get_state(mgr->sync_detector) == SYNC_LOCKED &&
+                sync_detector_get_last_marker_ms(mgr->sync_detector) > duty->acquire_ms &&
+                (!mgr->bcd_time_solver || bcd_time_solver_get_solution(mgr->bcd_time_solver, &sol)) &&
+                try_sleep(duty, now_ms)) {
+                return;
+            }
+            arm_eval(duty);
+            break;
+        }
+        case WWV_DUTY_ASLEEP:
+            wake(duty, now_ms);
+            break;
+        case WWV_DUTY_VERIFY:
+        case WWV_DUTY_WIDE:
+            check(duty, now_ms);
+            break;
+        case WWV_DUTY_OFF:
+            break;
+    }
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+wwv_duty_t *wwv_duty_create(wwv_detector_manager_t *mgr, int minutes) {
+    if (!mgr || !mgr->timers) return NULL;
+    if (minutes <= 0) minutes = WWV_DUTY_DEFAULT_MINUTES;
+    if (minutes > WWV_DUTY_MAX_MINUTES) minutes = WWV_DUTY_MAX_MINUTES;
+
+    wwv_duty_t *duty = wwv_calloc(1, sizeof(*duty));
+    if (!duty) return NULL;
+    duty->clock = wwv_clock_create(WWV_STATION_WWV);
+    if (!duty->clock) {
+        wwv_free(duty);
+        return NULL;
+    }
+    wwv_clock_set_mode(duty->clock, WWV_CLOCK_MODE_RELATIVE);
+
+    duty->mgr = mgr;
+    duty->minutes = minutes;
+    atomic_init(&duty->asleep, false);
+    atomic_init(&duty->next_marker_bits, double_bits(0.0));
+    atomic_init(&duty->counted, 0);
+    atomic_init(&duty->slept_total, 0);
+    atomic_init(&duty->shown_state, (int)WWV_DUTY_ACQUIRE);
+    atomic_init(&duty->sleeps, 0u);
+    atomic_init(&duty->verified, 0u);
+    atomic_init(&duty->widened, 0u);
+    atomic_init(&duty->reacquired, 0u);
+    duty->state = WWV_DUTY_ACQUIRE;
+
+    wwv_timer_init(&duty->timer, on_timer, duty);
+    arm_eval(duty);
+    printf("[DUTY] Duty cycling: wake every %d min, %.0f s before the marker\n",
+           minutes, WWV_DUTY_WAKE_LEAD_MS / 1000.0);
+    return duty;
+}
+
+void wwv_duty_destroy(wwv_duty_t *duty) {
+    if (!duty) return;
+    wwv_timer_cancel(duty->mgr->timers, &duty->timer);
+    wwv_clock_destroy(duty->clock);
+    wwv_free(duty);
+}
+
+bool wwv_duty_asleep(const wwv_duty_t *duty) {
+    return duty && duty->state == WWV_DUTY_ASLEEP;
+}
+
+bool wwv_duty_display_awake(wwv_duty_t *duty, size_t count, uint64_t *slept) {
+    *slept = 0;
+    if (!duty) return true;
+
+    if (atomic_load_explicit(&duty->asleep, memory_order_acquire)) {
+        duty->display_slept += count;
+        return false;
+    }
+    *slept = duty->display_slept;
+    duty->display_slept = 0;
+    return true;
+}
+
+void wwv_duty_get_status(wwv_duty_t *duty, wwv_duty_status_t *out) {
+    memset(out, 0, sizeof(*out));
+    if (!duty) return;
+
+    out->enabled = true;
+    out->state = (wwv_duty_state_t)atomic_load_explicit(&duty->shown_state, memory_order_relaxed);
+    out->sleeps = atomic_load_explicit(&duty->sleeps, memory_order_relaxed);
+    out->verified = atomic_load_explicit(&duty->verified, memory_order_relaxed);
+    out->widened = atomic_load_explicit(&duty->widened, memory_order_relaxed);
+    out->reacquired = atomic_load_explicit(&duty->reacquired, memory_order_relaxed);
+    out->next_marker_ms = bits_double(atomic_load_explicit(&duty->next_marker_bits,
+                                                           memory_order_relaxed));
+
+    /* Up to the last transition; a sleep in progress counts once it ends */
+    uint64_t counted = atomic_load_explicit(&duty->counted, memory_order_relaxed);
+    uint64_t slept = atomic_load_explicit(&duty->slept_total, memory_order_relaxed);
+    out->awake_fraction = (counted > 0) ? (float)(counted - slept) / (float)counted : 1.0f;
+}
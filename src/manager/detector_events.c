@@ -0,0 +1,119 @@
+/**
+ * @file detector_events.c
+ * @brief External event delivery: per-event callbacks or per-call batches
+ *
+ * Without event buffers each event goes to its callback as it is raised.
+ * With buffers, events are only copied into the caller's typed arrays
+ * while the detectors run, and the whole batch is handed over when the
+ * outermost processing call returns, so the consumer runs once per call
+ * and never inside the detector inner loop.
+ */
+
+#include "wwv_detector_manager_internal.h"
+#include <string.h>
+
+/*============================================================================
+ * Collection
+ *============================================================================*/
+
+void wwv_events_tick(wwv_detector_manager_t *mgr, const wwv_tick_event_t *event) {
+    wwv_event_batcher_t *b = &mgr->batch;
+    if (!b->enabled) {
+        if (mgr->tick_callback) mgr->tick_callback(event, mgr->tick_callback_data);
+        return;
+    }
+    if (b->tick_count < b->buf.tick_capacity) b->buf.ticks[b->tick_count++] = *event;
+    else b->dropped++;
+}
+
+void wwv_events_marker(wwv_detector_manager_t *mgr, const wwv_marker_event_t *event) {
+    wwv_event_batcher_t *b = &mgr->batch;
+    if (!b->enabled) {
+        if (mgr->marker_callback) mgr->marker_callback(event, mgr->marker_callback_data);
+        return;
+    }
+    if (b->marker_count < b->buf.marker_capacity) b->buf.markers[b->marker_count++] = *event;
+    else b->dropped++;
+}
+
+void wwv_events_sync(wwv_detector_manager_t *mgr, const wwv_sync_status_t *status) {
+    wwv_event_batcher_t *b = &mgr->batch;
+    if (!b->enabled) {
+        if (mgr->sync_callback) mgr->sync_callback(status, mgr->sync_callback_data);
+        return;
+    }
+    if (b->sync_count < b->buf.sync_capacity) b->buf.syncs[b->sync_count++] = *status;
+    else b->dropped++;
+}
+
+/*============================================================================
+ * Hand-Over
+ *============================================================================*/
+
+static bool batch_take(wwv_event_batcher_t *b, wwv_event_batch_t *out) {
+    out->ticks = b->buf.ticks;
+    out->tick_count = b->tick_count;
+    out->markers = b->buf.markers;
+    out->marker_count = b->marker_count;
+    out->syncs = b->buf.syncs;
+    out->sync_count = b->sync_count;
+    out->dropped = b->dropped;
+
+    b->tick_count = b->marker_count = b->sync_count = 0;
+    b->dropped = 0;
+    return out->tick_count || out->marker_count || out->sync_count || out->dropped;
+}
+
+void wwv_events_deliver(wwv_detector_manager_t *mgr) {
+    wwv_event_batcher_t *b = &mgr->batch;
+    if (!b->enabled || !b->callback) return;
+
+    wwv_event_batch_t batch;
+    if (batch_take(b, &batch)) b->callback(&batch, b->callback_data);
+}
+
+void wwv_events_begin(wwv_detector_manager_t *mgr) {
+    if (!mgr->pipeline) mgr->batch.depth++;
+}
+
+void wwv_events_end(wwv_detector_manager_t *mgr) {
+    if (mgr->pipeline) return;
+    if (--mgr->batch.depth == 0) wwv_events_deliver(mgr);
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+void wwv_detector_manager_set_event_buffers(wwv_detector_manager_t *mgr,
+                                            const wwv_event_buffers_t *buffers) {
+    if (!mgr) return;
+    wwv_event_batcher_t *b = &mgr->batch;
+
+    memset(&b->buf, 0, sizeof(b->buf));
+    b->tick_count = b->marker_count = b->sync_count = 0;
+    b->dropped = 0;
+    b->enabled = buffers != NULL;
+    if (!buffers) return;
+
+    b->buf = *buffers;
+    if (!b->buf.ticks) b->buf.tick_capacity = 0;
+    if (!b->buf.markers) b->buf.marker_capacity = 0;
+    if (!b->buf.syncs) b->buf.sync_capacity = 0;
+}
+
+void wwv_detector_manager_set_batch_callback(wwv_detector_manager_t *mgr,
+                                             wwv_event_batch_fn cb, void *user_data) {
+    if (!mgr) return;
+    mgr->batch.callback = cb;
+    mgr->batch.callback_data = user_data;
+}
+
+bool wwv_detector_manager_take_events(wwv_detector_manager_t *mgr, wwv_event_batch_t *batch) {
+    if (!mgr || !batch) return false;
+    if (!mgr->batch.enabled) {
+        memset(batch, 0, sizeof(*batch));
+        return false;
+    }
+    return batch_take(&mgr->batch, batch);
+}
@@ -0,0 +1,111 @@
+/**
+ * @file detector_graph.c
+ * @brief Detector dataflow graph planning and event delivery
+ *
+ * Planning runs once per manager; delivery is a loop over a port's wired
+ * sinks, so an event with no live consumer costs one load and a compare.
+ */
+
+#include "detector_graph.h"
+#include "wwv_detector_manager_internal.h"
+#include <stdio.h>
+#include <string.h>
+
+/*============================================================================
+ * Planning
+ *============================================================================*/
+
+static int producer_of(wwv_port_t port) {
+    for (int n = 0; n < WWV_NODE_COUNT; n++) {
+        if (WWV_GRAPH_NODES[n].outputs & WWV_PORT_BIT(port)) return n;
+    }
+    return -1;
+}
+
+static bool edge_wired(const wwv_edge_desc_t *e, unsigned live, const wwv_detector_config_t *config) {
+    int producer = producer_of(e->port);
+    if (producer < 0 || !((live >> producer) & 1u)) return false;
+    if (!((live >> e->consumer) & 1u)) return false;
+    return !e->when || e->when(config);
+}
+
+void wwv_graph_plan(wwv_graph_t *graph, const wwv_detector_config_t *config) {
+    memset(graph, 0, sizeof(*graph));
+
+    for (int n = 0; n < WWV_NODE_COUNT; n++) {
+        const wwv_node_desc_t *node = &WWV_GRAPH_NODES[n];
+        if (node->compiled && node->requested(config)) graph->live |= 1u << n;
+    }
+
+    /* Drop feeders nobody listens to; dropping one may orphan its own feeders */
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int n = 0; n < WWV_NODE_COUNT; n++) {
+            if (!WWV_GRAPH_NODES[n].feeder || !((graph->live >> n) & 1u)) continue;
+
+            bool used = false;
+            for (int e = 0; e < WWV_GRAPH_EDGE_COUNT && !used; e++) {
+                const wwv_edge_desc_t *edge = &WWV_GRAPH_EDGES[e];
+                used = producer_of(edge->port) == n && edge_wired(edge, graph->live, config);
+            }
+            if (!used) {
+                graph->live &= ~(1u << n);
+                changed = true;
+            }
+        }
+    }
+
+    for (int e = 0; e < WWV_GRAPH_EDGE_COUNT; e++) {
+        const wwv_edge_desc_t *edge = &WWV_GRAPH_EDGES[e];
+        if (!edge_wired(edge, graph->live, config)) continue;
+        if (graph->sink_count[edge->port] < WWV_GRAPH_MAX_SINKS) {
+            graph->sinks[edge->port][graph->sink_count[edge->port]++] = edge;
+        }
+    }
+
+    for (int n = 0; n < WWV_NODE_COUNT; n++) {
+        if (WWV_GRAPH_NODES[n].path == WWV_PATH_DISPLAY && ((graph->live >> n) & 1u)) {
+            graph->display_path = true;
+        }
+    }
+}
+
+void wwv_graph_print(const wwv_graph_t *graph) {
+    char running[256] = "";
+    char off[256] = "";
+    int edges = 0;
+
+    for (int n = 0; n < WWV_NODE_COUNT; n++) {
+        char *list = wwv_graph_node_live(graph, (wwv_node_id_t)n) ? running : off;
+        size_t len = strlen(list);
+        snprintf(list + len, 256 - len, "%s%s", len ? " " : "", WWV_GRAPH_NODES[n].name);
+    }
+    for (int p = 0; p < WWV_PORT_COUNT; p++) {
+        edges += graph->sink_count[p];
+    }
+
+    printf("[DETECTOR_MGR] Graph: %s (%d edges)\n", running, edges);
+    printf("[DETECTOR_MGR] Graph off: %s, display path %s\n",
+           off[0] ? off : "none", graph->display_path ? "on" : "off");
+}
+
+/*============================================================================
+ * Delivery
+ *============================================================================*/
+
+void wwv_graph_emit(wwv_detector_manager_t *mgr, wwv_port_t port, const void *event) {
+    const wwv_graph_t *graph = &mgr->graph;
+
+    for (int k = 0; k < graph->sink_count[port]; k++) {
+        const wwv_edge_desc_t *edge = graph->sinks[port][k];
+
+        if (edge->locked) wwv_mutex_lock(&mgr->route_lock);
+        WWV_PERF_BEGIN(mgr->perf, t0);
+        edge->sink(mgr, event);
+        if (edge->stage != WWV_PERF_STAGE_COUNT) {
+            WWV_PERF_END(mgr->perf, edge->stage, t0);
+        }
+        if (edge->locked) wwv_mutex_unlock(&mgr->route_lock);
+    }
+}
@@ -15,69 +15,266 @@
  * Creation
  *============================================================================*/
 
+#define LOG_PATH_MAX    512
+#define MANAGER_TIMER_SLOT_SHIFT    6   /* 64-sample (1.28 ms) timer wheel slots */
+
+/**
+ * CSV path under config->output_dir, or NULL (logging off) without one
+ */
+static const char *log_path(char buf[LOG_PATH_MAX], const wwv_detector_config_t *config,
+                            const char *name) {
+    if (!config->output_dir) return NULL;
+    snprintf(buf, LOG_PATH_MAX, "%s/%s", config->output_dir, name);
+    return buf;
+}
+
 bool wwv_detector_lifecycle_create_all(wwv_detector_manager_t *mgr,
                                         const wwv_detector_config_t *config) {
-    char path[512];
+    char path[LOG_PATH_MAX];
     
     printf("\n[DETECTOR_MGR] Creating WWV detector manager...\n");
     
+    /* Only running nodes are created; everything else stays NULL */
+    wwv_graph_plan(&mgr->graph, config);
+    const wwv_graph_t *g = &mgr->graph;
+    
     /* Detector path components */
-    if (config->enable_tick_detector) {
-        snprintf(path, sizeof(path), "%s/wwv_ticks.csv", config->output_dir);
-        mgr->tick_detector = tick_detector_create(path);
+    if (wwv_graph_node_live(g, WWV_NODE_TICK_DETECTOR)) {
+        static const wwv_station_t stations[] = { WWV_STATION_WWV, WWV_STATION_WWVH };
+        const char *csv = log_path(path, config, "wwv_ticks.csv");
+        int count = config->dual_station ? 2 : 1;
+        mgr->tick_detector = config->baseband_path
+                           ? tick_detector_create_baseband(csv, stations, count)
+                           : tick_detector_create_stations(csv, stations, count);
         if (mgr->tick_detector) {
             tick_detector_set_callback(mgr->tick_detector, wwv_routing_on_tick_event, mgr);
             tick_detector_set_marker_callback(mgr->tick_detector, wwv_routing_on_tick_marker_event, mgr);
         }
     }
     
-    if (config->enable_marker_detector) {
-        snprintf(path, sizeof(path), "%s/wwv_markers.csv", config->output_dir);
-        mgr->marker_detector = marker_detector_create(path);
+    if (wwv_graph_node_live(g, WWV_NODE_MARKER_DETECTOR)) {
+        const char *csv = log_path(path, config, "wwv_markers.csv");
+        mgr->marker_detector = config->baseband_path ? marker_detector_create_baseband(csv)
+                                                     : marker_detector_create(csv);
         if (mgr->marker_detector) {
             marker_detector_set_callback(mgr->marker_detector, wwv_routing_on_marker_event, mgr);
+            /* The baseband marker has 16-point frames and stays on its FFT */
+            if (!config->baseband_path) {
+                marker_detector_set_spectral_mode(mgr->marker_detector, config->narrowband_mode);
+            }
+            if (config->marker_template) {
+                marker_detector_set_template(mgr->marker_detector, true);
+            }
+        }
+    }
+    
+    mgr->detector_tiling = config->detector_tiling;
+    
+    /* One decimation shared by the tick and marker detectors */
+    if (config->baseband_path && (mgr->tick_detector || mgr->marker_detector)) {
+        mgr->baseband = baseband_frontend_create();
+        baseband_frontend_set_sink(mgr->baseband, wwv_baseband_on_block, mgr);
+    }
+    
+    if (wwv_graph_node_live(g, WWV_NODE_BCD_TIME_DETECTOR)) {
+        mgr->bcd_time_detector = bcd_time_detector_create(log_path(path, config, "wwv_bcd_time.csv"));
+        if (mgr->bcd_time_detector) {
+            bcd_time_detector_set_callback(mgr->bcd_time_detector, wwv_routing_on_bcd_time_event, mgr);
+            bcd_time_detector_set_spectral_mode(mgr->bcd_time_detector, config->narrowband_mode);
+        }
+    }
+    
+    if (wwv_graph_node_live(g, WWV_NODE_BCD_FREQ_DETECTOR)) {
+        const char *csv = log_path(path, config, "wwv_bcd_freq.csv");
+        mgr->bcd_freq_detector = config->bcd_freq_sliding ? bcd_freq_detector_create_sliding(csv)
+                                                          : bcd_freq_detector_create(csv);
+        if (mgr->bcd_freq_detector) {
+            bcd_freq_detector_set_callback(mgr->bcd_freq_detector, wwv_routing_on_bcd_freq_event, mgr);
         }
     }
     
     /* Correlators */
-    if (config->enable_correlators) {
-        snprintf(path, sizeof(path), "%s/wwv_tick_corr.csv", config->output_dir);
-        mgr->tick_correlator = tick_correlator_create(path);
-        
-        snprintf(path, sizeof(path), "%s/wwv_markers_corr.csv", config->output_dir);
-        mgr->marker_correlator = marker_correlator_create(path);
+    if (wwv_graph_node_live(g, WWV_NODE_TICK_CORRELATOR)) {
+        mgr->tick_correlator = tick_correlator_create_sized(log_path(path, config, "wwv_tick_corr.csv"),
+                                                            config->corr_chain_history,
+                                                            config->corr_tick_history);
+    }
+    
+    if (wwv_graph_node_live(g, WWV_NODE_MARKER_CORRELATOR)) {
+        mgr->marker_correlator = marker_correlator_create(log_path(path, config, "wwv_markers_corr.csv"));
+    }
+    
+    if (wwv_graph_node_live(g, WWV_NODE_SYNC_DETECTOR)) {
+        mgr->sync_detector = sync_detector_create(log_path(path, config, "wwv_sync.csv"));
+        if (mgr->sync_detector && config->fast_acquire) {
+            sync_detector_set_fast_acquire(mgr->sync_detector, true);
+        }
+        if (mgr->sync_detector) {
+            mgr->tick_economy = mgr->tick_detector && config->tick_economy;
+            sync_detector_set_state_callback(mgr->sync_detector, wwv_routing_on_sync_state, mgr);
+        }
+    }
+    
+    /* BCD correlator is gated on sync LOCKED, so it needs the sync detector */
+    if (wwv_graph_node_live(g, WWV_NODE_BCD_CORRELATOR)) {
+        mgr->bcd_correlator = bcd_correlator_create(log_path(path, config, "wwv_bcd_corr.csv"));
+        if (mgr->bcd_correlator) {
+            bcd_correlator_set_sync_source(mgr->bcd_correlator, mgr->sync_detector);
+            bcd_correlator_set_integration(mgr->bcd_correlator, config->bcd_integrate_minutes);
+            if (wwv_graph_node_live(g, WWV_NODE_BCD_TIME_SOLVER)) {
+                mgr->bcd_time_solver = bcd_time_solver_create();
+            }
+            bcd_correlator_set_callback(mgr->bcd_correlator, wwv_routing_on_bcd_symbol, mgr);
+        }
+    }
+    
+    /* Needs both pulse streams to judge agreement */
+    if (wwv_graph_node_live(g, WWV_NODE_BCD_PATH_POLICY) &&
+        mgr->bcd_time_detector && mgr->bcd_freq_detector) {
+        mgr->bcd_path = bcd_path_policy_create(NULL);
+        wwv_timer_init(&mgr->bcd_path_timer, wwv_routing_on_bcd_path_timer, mgr);
+    }
+    
+    /* The export needs the second count and the time of day to publish */
+    if (wwv_graph_node_live(g, WWV_NODE_REFCLOCK)) {
+        mgr->refclock = config->refclock;
+        mgr->refclock_delay_ms = config->refclock_delay_ms;
+        if (!mgr->tick_detector || !mgr->sync_detector || !mgr->bcd_time_solver) {
+            printf("[DETECTOR_MGR] Refclock needs tick, sync and BCD time solving; nothing will be published\n");
+        }
     }
     
-    if (config->enable_sync_detector) {
-        snprintf(path, sizeof(path), "%s/wwv_sync.csv", config->output_dir);
-        mgr->sync_detector = sync_detector_create(path);
+    if (wwv_graph_node_live(g, WWV_NODE_HISTORY)) {
+        mgr->history = wwv_history_create((uint32_t)config->history_seconds, config->history_path);
+        if (mgr->history) wwv_timer_init(&mgr->history_timer, wwv_routing_on_history_timer, mgr);
+    }
+    
+    /* Correlator deadlines fire as the detector path reaches their sample */
+    if (mgr->sync_detector || mgr->bcd_correlator || mgr->bcd_path || mgr->history) {
+        mgr->timers = wwv_timer_wheel_create(TICK_SAMPLE_RATE, MANAGER_TIMER_SLOT_SHIFT);
+        sync_detector_set_timer_wheel(mgr->sync_detector, mgr->timers);
+        bcd_correlator_set_timer_wheel(mgr->bcd_correlator, mgr->timers);
+        if (mgr->bcd_path && mgr->timers) {
+            wwv_timer_arm_after_ms(mgr->timers, &mgr->bcd_path_timer, BCD_PATH_EVAL_MS);
+        }
+        if (mgr->history && mgr->timers) {
+            wwv_timer_arm_after_ms(mgr->timers, &mgr->history_timer, 1000.0);
+        }
+    }
+    
+    /* Sleeps on sync's lock (and the BCD time), wakes on the tick detector's marker */
+    if (config->duty_cycle) {
+        if (mgr->tick_detector && mgr->sync_detector && mgr->timers && !mgr->baseband) {
+            mgr->duty = wwv_duty_create(mgr, config->duty_cycle_minutes);
+        } else {
+            printf("[DETECTOR_MGR] Duty cycling needs tick and sync on the 50 kHz detector path; "
+                   "staying awake\n");
+        }
     }
     
     /* Display path components */
-    if (config->enable_tone_trackers) {
-        snprintf(path, sizeof(path), "%s/wwv_carrier.csv", config->output_dir);
-        mgr->tone_carrier = tone_tracker_create(0.0f, path);
+#ifndef WWV_NO_DISPLAY_PATH
+    if (wwv_graph_node_live(g, WWV_NODE_TONE_TRACKERS)) {
+        mgr->tone_carrier = tone_tracker_create(0.0f, log_path(path, config, "wwv_carrier.csv"));
         
-        snprintf(path, sizeof(path), "%s/wwv_tone_500.csv", config->output_dir);
-        mgr->tone_500 = tone_tracker_create(500.0f, path);
+        mgr->tone_500 = tone_tracker_create(500.0f, log_path(path, config, "wwv_tone_500.csv"));
         
-        snprintf(path, sizeof(path), "%s/wwv_tone_600.csv", config->output_dir);
-        mgr->tone_600 = tone_tracker_create(600.0f, path);
+        mgr->tone_600 = tone_tracker_create(600.0f, log_path(path, config, "wwv_tone_600.csv"));
     }
     
-    if (config->enable_slow_marker) {
+#ifndef WWV_NO_SLOW_MARKER
+    if (wwv_graph_node_live(g, WWV_NODE_SLOW_MARKER)) {
         mgr->slow_marker = slow_marker_detector_create();
         if (mgr->slow_marker) {
             slow_marker_detector_set_callback(mgr->slow_marker, wwv_routing_on_slow_marker_frame, mgr);
         }
     }
+#endif
+    
+    /* One FFT per hop: the trackers' bins and the slow marker's 1000 Hz bucket */
+    if (config->shared_tone_spectrum && (mgr->tone_carrier || mgr->slow_marker)) {
+        mgr->tone_spectrum = tone_spectrum_create(mgr->slow_marker ? TONE_OVERLAP_HOP : TONE_DEFAULT_HOP);
+        tone_spectrum_attach(mgr->tone_spectrum, mgr->tone_carrier);
+        tone_spectrum_attach(mgr->tone_spectrum, mgr->tone_500);
+        tone_spectrum_attach(mgr->tone_spectrum, mgr->tone_600);
+        if (mgr->tone_spectrum) {
+            mgr->channel_quality = channel_quality_create();
+            tone_spectrum_set_channel_quality(mgr->tone_spectrum, mgr->channel_quality);
+        }
+#ifndef WWV_NO_SLOW_MARKER
+        if (mgr->slow_marker) {
+            tone_spectrum_set_tap(mgr->tone_spectrum, wwv_routing_on_tone_spectrum, mgr);
+        }
+#endif
+    }
+    
+    /* Steered by the carrier tracker, so only where one runs */
+    if (config->carrier_correction) {
+        if (mgr->tone_carrier) {
+            mgr->carrier = wwv_carrier_loop_create();
+        } else {
+            printf("[DETECTOR_MGR] Carrier correction needs the tone trackers; not correcting\n");
+        }
+    }
+#else
+    if (config->carrier_correction) {
+        printf("[DETECTOR_MGR] Carrier correction needs the display path (WWV_DISPLAY_PATH=OFF); "
+               "not correcting\n");
+    }
+#endif /* WWV_NO_DISPLAY_PATH */
     
-    printf("[DETECTOR_MGR] Created: tick=%s marker=%s sync=%s tones=%s slow=%s\n",
+    /* Raw 2 MHz input path */
+    if (config->enable_sdr_frontend) {
+        mgr->frontend = sdr_frontend_create();
+        if (mgr->frontend) {
+            sdr_frontend_set_sink(mgr->frontend, SDR_TAP_DETECTOR, wwv_frontend_on_detector_block, mgr);
+            /* Without a display sink the front end skips its 12 kHz stage */
+            if (g->display_path) {
+                sdr_frontend_set_sink(mgr->frontend, SDR_TAP_DISPLAY, wwv_frontend_on_display_block, mgr);
+            }
+        }
+    }
+    
+    /* One stage-timing context for every component (NULL when compiled out) */
+    mgr->perf = wwv_perf_create();
+    mgr->perf_next_report = WWV_PERF_REPORT_SAMPLES;
+    tick_detector_set_perf(mgr->tick_detector, mgr->perf);
+    marker_detector_set_perf(mgr->marker_detector, mgr->perf);
+    bcd_time_detector_set_perf(mgr->bcd_time_detector, mgr->perf);
+    bcd_freq_detector_set_perf(mgr->bcd_freq_detector, mgr->perf);
+#ifndef WWV_NO_DISPLAY_PATH
+    tone_tracker_set_perf(mgr->tone_carrier, mgr->perf);
+    tone_tracker_set_perf(mgr->tone_500, mgr->perf);
+    tone_tracker_set_perf(mgr->tone_600, mgr->perf);
+    tone_spectrum_set_perf(mgr->tone_spectrum, mgr->perf);
+#endif
+    
+    /* Route every component's UDP telemetry to the manager's context */
+    mgr->telem = config->telemetry;
+    tick_detector_set_telemetry(mgr->tick_detector, mgr->telem);
+    marker_detector_set_telemetry(mgr->marker_detector, mgr->telem);
+    bcd_time_detector_set_telemetry(mgr->bcd_time_detector, mgr->telem);
+    bcd_freq_detector_set_telemetry(mgr->bcd_freq_detector, mgr->telem);
+    tick_correlator_set_telemetry(mgr->tick_correlator, mgr->telem);
+    marker_correlator_set_telemetry(mgr->marker_correlator, mgr->telem);
+    sync_detector_set_telemetry(mgr->sync_detector, mgr->telem);
+    bcd_correlator_set_telemetry(mgr->bcd_correlator, mgr->telem);
+    bcd_path_policy_set_telemetry(mgr->bcd_path, mgr->telem);
+#ifndef WWV_NO_DISPLAY_PATH
+    tone_tracker_set_telemetry(mgr->tone_carrier, mgr->telem);
+    tone_tracker_set_telemetry(mgr->tone_500, mgr->telem);
+    tone_tracker_set_telemetry(mgr->tone_600, mgr->telem);
+    channel_quality_set_telemetry(mgr->channel_quality, mgr->telem);
+#endif
+    
+    printf("[DETECTOR_MGR] Created: tick=%s marker=%s bcd=%s sync=%s tones=%s slow=%s\n",
            mgr->tick_detector ? "YES" : "no",
            mgr->marker_detector ? "YES" : "no",
+           mgr->bcd_time_detector ? "YES" : "no",
            mgr->sync_detector ? "YES" : "no",
            mgr->tone_carrier ? "YES" : "no",
            mgr->slow_marker ? "YES" : "no");
+    wwv_graph_print(g);
     
     return true;
 }
@@ -92,13 +289,33 @@ void wwv_detector_lifecycle_destroy_all(wwv_detector_manager_t *mgr) {
     printf("[DETECTOR_MGR] Destroying...\n");
     
     /* Destroy in reverse order */
+    if (mgr->frontend) sdr_frontend_destroy(mgr->frontend);
+    wwv_duty_destroy(mgr->duty);
+    wwv_carrier_loop_destroy(mgr->carrier);
+    baseband_frontend_destroy(mgr->baseband);
+#ifndef WWV_NO_DISPLAY_PATH
+    if (mgr->tone_spectrum) tone_spectrum_destroy(mgr->tone_spectrum);
+    if (mgr->channel_quality) channel_quality_destroy(mgr->channel_quality);
+#ifndef WWV_NO_SLOW_MARKER
     if (mgr->slow_marker) slow_marker_detector_destroy(mgr->slow_marker);
+#endif
     if (mgr->tone_600) tone_tracker_destroy(mgr->tone_600);
     if (mgr->tone_500) tone_tracker_destroy(mgr->tone_500);
     if (mgr->tone_carrier) tone_tracker_destroy(mgr->tone_carrier);
+#endif
+    wwv_history_destroy(mgr->history);
+    if (mgr->bcd_path) bcd_path_policy_destroy(mgr->bcd_path);
+    if (mgr->bcd_correlator) bcd_correlator_destroy(mgr->bcd_correlator);
+    if (mgr->bcd_time_solver) bcd_time_solver_destroy(mgr->bcd_time_solver);
     if (mgr->sync_detector) sync_detector_destroy(mgr->sync_detector);
     if (mgr->marker_correlator) marker_correlator_destroy(mgr->marker_correlator);
     if (mgr->tick_correlator) tick_correlator_destroy(mgr->tick_correlator);
+    if (mgr->bcd_freq_detector) bcd_freq_detector_destroy(mgr->bcd_freq_detector);
+    if (mgr->bcd_time_detector) bcd_time_detector_destroy(mgr->bcd_time_detector);
     if (mgr->marker_detector) marker_detector_destroy(mgr->marker_detector);
     if (mgr->tick_detector) tick_detector_destroy(mgr->tick_detector);
+    wwv_timer_wheel_destroy(mgr->timers);
+    
+    /* Last: closing the detectors' logs above may still record into it */
+    wwv_perf_destroy(mgr->perf);
 }
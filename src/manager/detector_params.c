@@ -0,0 +1,288 @@
+/**
+ * @file detector_params.c
+ * @brief Runtime tunables addressed by their waterfall.ini names
+ *
+ * Names are "section.key" as in docs/RUNTIME_PARAMETER_TUNING.md. Every
+ * tunable is read on the detector path, which in threaded mode is the
+ * detector worker, so settings are not written into the detectors by the
+ * caller. They are staged in a full parameter block and published through
+ * a three-slot mailbox: the control side fills its back slot and swaps it
+ * into the middle with one atomic exchange, and the detector path swaps
+ * the middle out at the top of its next block and calls the setters
+ * itself. Neither side ever waits on the other, a batch lands between the
+ * same two blocks, and a block that is published over before it is picked
+ * up loses nothing, since each one carries every setting made so far.
+ */
+
+#include "wwv_detector_manager_internal.h"
+#include <math.h>
+#include <stdatomic.h>
+#include <string.h>
+
+/*============================================================================
+ * Parameter Table
+ *============================================================================*/
+
+typedef enum {
+    P_TICK_THRESHOLD,
+    P_TICK_ADAPT_DOWN,
+    P_TICK_ADAPT_UP,
+    P_TICK_MIN_DURATION,
+    P_CORR_CONFIDENCE,
+    P_CORR_MAX_MISSES,
+    P_MARKER_THRESHOLD,
+    P_MARKER_ADAPT_RATE,
+    P_MARKER_MIN_DURATION,
+    P_SYNC_WEIGHT_TICK,
+    P_SYNC_WEIGHT_MARKER,
+    P_SYNC_WEIGHT_P_MARKER,
+    P_SYNC_WEIGHT_TICK_HOLE,
+    P_SYNC_WEIGHT_COMBINED,
+    P_SYNC_LOCKED_THRESHOLD,
+    P_SYNC_MIN_RETAIN,
+    P_SYNC_TENTATIVE_INIT,
+    P_SYNC_DECAY_NORMAL,
+    P_SYNC_DECAY_RECOVERING,
+    P_SYNC_TICK_TOLERANCE,
+    P_SYNC_MARKER_TOLERANCE,
+    P_SYNC_P_MARKER_TOLERANCE,
+    P_COUNT
+} param_id_t;
+
+/* Ranges mirror the detectors' setters, so a batch can be checked whole
+ * before any of it is staged */
+typedef struct {
+    const char *name;
+    float min;
+    float max;
+} param_desc_t;
+
+static const param_desc_t params[P_COUNT] = {
+    [P_TICK_THRESHOLD]          = { "tick_detector.threshold_multiplier",          1.0f,    5.0f    },
+    [P_TICK_ADAPT_DOWN]         = { "tick_detector.adapt_alpha_down",              0.9f,    0.999f  },
+    [P_TICK_ADAPT_UP]           = { "tick_detector.adapt_alpha_up",                0.001f,  0.1f    },
+    [P_TICK_MIN_DURATION]       = { "tick_detector.min_duration_ms",               1.0f,    10.0f   },
+    [P_CORR_CONFIDENCE]         = { "tick_correlator.epoch_confidence_threshold",  0.5f,    0.95f   },
+    [P_CORR_MAX_MISSES]         = { "tick_correlator.max_consecutive_misses",      2.0f,    10.0f   },
+    [P_MARKER_THRESHOLD]        = { "marker_detector.threshold_multiplier",        2.0f,    5.0f    },
+    [P_MARKER_ADAPT_RATE]       = { "marker_detector.noise_adapt_rate",            0.0001f, 0.01f   },
+    [P_MARKER_MIN_DURATION]     = { "marker_detector.min_duration_ms",             300.0f,  700.0f  },
+    [P_SYNC_WEIGHT_TICK]        = { "sync_detector.weight_tick",                   0.01f,   0.2f    },
+    [P_SYNC_WEIGHT_MARKER]      = { "sync_detector.weight_marker",                 0.1f,    0.6f    },
+    [P_SYNC_WEIGHT_P_MARKER]    = { "sync_detector.weight_p_marker",               0.05f,   0.3f    },
+    [P_SYNC_WEIGHT_TICK_HOLE]   = { "sync_detector.weight_tick_hole",              0.05f,   0.4f    },
+    [P_SYNC_WEIGHT_COMBINED]    = { "sync_detector.weight_combined_hole_marker",   0.2f,    0.8f    },
+    [P_SYNC_LOCKED_THRESHOLD]   = { "sync_detector.confidence_locked_threshold",   0.5f,    0.9f    },
+    [P_SYNC_MIN_RETAIN]         = { "sync_detector.confidence_min_retain",         0.01f,   0.2f    },
+    [P_SYNC_TENTATIVE_INIT]     = { "sync_detector.confidence_tentative_init",     0.1f,    0.5f    },
+    [P_SYNC_DECAY_NORMAL]       = { "sync_detector.confidence_decay_normal",       0.99f,   0.9999f },
+    [P_SYNC_DECAY_RECOVERING]   = { "sync_detector.confidence_decay_recovering",   0.90f,   0.99f   },
+    [P_SYNC_TICK_TOLERANCE]     = { "sync_detector.tick_phase_tolerance_ms",       50.0f,   200.0f  },
+    [P_SYNC_MARKER_TOLERANCE]   = { "sync_detector.marker_tolerance_ms",           200.0f,  800.0f  },
+    [P_SYNC_P_MARKER_TOLERANCE] = { "sync_detector.p_marker_tolerance_ms",         100.0f,  400.0f  }
+};
+
+static int param_lookup(const char *name) {
+    if (!name) return -1;
+    for (int p = 0; p < P_COUNT; p++) {
+        if (strcmp(params[p].name, name) == 0) return p;
+    }
+    return -1;
+}
+
+/* Owning component, NULL if it is disabled in this manager */
+static const void *param_owner(const wwv_detector_manager_t *mgr, int p) {
+    if (p <= P_TICK_MIN_DURATION) return mgr->tick_detector;
+    if (p <= P_CORR_MAX_MISSES) return mgr->tick_correlator;
+    if (p <= P_MARKER_MIN_DURATION) return mgr->marker_detector;
+    return mgr->sync_detector;
+}
+
+static float param_read(wwv_detector_manager_t *mgr, int p) {
+    switch ((param_id_t)p) {
+        case P_TICK_THRESHOLD:          return tick_detector_get_threshold_mult(mgr->tick_detector);
+        case P_TICK_ADAPT_DOWN:         return tick_detector_get_adapt_alpha_down(mgr->tick_detector);
+        case P_TICK_ADAPT_UP:           return tick_detector_get_adapt_alpha_up(mgr->tick_detector);
+        case P_TICK_MIN_DURATION:       return tick_detector_get_min_duration_ms(mgr->tick_detector);
+        case P_CORR_CONFIDENCE:         return tick_correlator_get_epoch_confidence(mgr->tick_correlator);
+        case P_CORR_MAX_MISSES:         return (float)tick_correlator_get_max_misses(mgr->tick_correlator);
+        case P_MARKER_THRESHOLD:        return marker_detector_get_threshold_mult(mgr->marker_detector);
+        case P_MARKER_ADAPT_RATE:       return marker_detector_get_noise_adapt_rate(mgr->marker_detector);
+        case P_MARKER_MIN_DURATION:     return marker_detector_get_min_duration_ms(mgr->marker_detector);
+        case P_SYNC_WEIGHT_TICK:        return sync_detector_get_weight_tick(mgr->sync_detector);
+        case P_SYNC_WEIGHT_MARKER:      return sync_detector_get_weight_marker(mgr->sync_detector);
+        case P_SYNC_WEIGHT_P_MARKER:    return sync_detector_get_weight_p_marker(mgr->sync_detector);
+        case P_SYNC_WEIGHT_TICK_HOLE:   return sync_detector_get_weight_tick_hole(mgr->sync_detector);
+        case P_SYNC_WEIGHT_COMBINED:    return sync_detector_get_weight_combined(mgr->sync_detector);
+        case P_SYNC_LOCKED_THRESHOLD:   return sync_detector_get_locked_threshold(mgr->sync_detector);
+        case P_SYNC_MIN_RETAIN:         return sync_detector_get_min_retain(mgr->sync_detector);
+        case P_SYNC_TENTATIVE_INIT:     return sync_detector_get_tentative_init(mgr->sync_detector);
+        case P_SYNC_DECAY_NORMAL:       return sync_detector_get_decay_normal(mgr->sync_detector);
+        case P_SYNC_DECAY_RECOVERING:   return sync_detector_get_decay_recovering(mgr->sync_detector);
+        case P_SYNC_TICK_TOLERANCE:     return sync_detector_get_tick_tolerance(mgr->sync_detector);
+        case P_SYNC_MARKER_TOLERANCE:   return sync_detector_get_marker_tolerance(mgr->sync_detector);
+        case P_SYNC_P_MARKER_TOLERANCE: return sync_detector_get_p_marker_tolerance(mgr->sync_detector);
+        default:                        return 0.0f;
+    }
+}
+
+static void param_write(wwv_detector_manager_t *mgr, int p, float value) {
+    switch ((param_id_t)p) {
+        case P_TICK_THRESHOLD:          tick_detector_set_threshold_mult(mgr->tick_detector, value); break;
+        case P_TICK_ADAPT_DOWN:         tick_detector_set_adapt_alpha_down(mgr->tick_detector, value); break;
+        case P_TICK_ADAPT_UP:           tick_detector_set_adapt_alpha_up(mgr->tick_detector, value); break;
+        case P_TICK_MIN_DURATION:       tick_detector_set_min_duration_ms(mgr->tick_detector, value); break;
+        case P_CORR_CONFIDENCE:         tick_correlator_set_epoch_confidence(mgr->tick_correlator, value); break;
+        case P_CORR_MAX_MISSES:         tick_correlator_set_max_misses(mgr->tick_correlator, (int)lroundf(value)); break;
+        case P_MARKER_THRESHOLD:        marker_detector_set_threshold_mult(mgr->marker_detector, value); break;
+        case P_MARKER_ADAPT_RATE:       marker_detector_set_noise_adapt_rate(mgr->marker_detector, value); break;
+        case P_MARKER_MIN_DURATION:     marker_detector_set_min_duration_ms(mgr->marker_detector, value); break;
+        case P_SYNC_WEIGHT_TICK:        sync_detector_set_weight_tick(mgr->sync_detector, value); break;
+        case P_SYNC_WEIGHT_MARKER:      sync_detector_set_weight_marker(mgr->sync_detector, value); break;
+        case P_SYNC_WEIGHT_P_MARKER:    sync_detector_set_weight_p_marker(mgr->sync_detector, value); break;
+        case P_SYNC_WEIGHT_TICK_HOLE:   sync_detector_set_weight_tick_hole(mgr->sync_detector, value); break;
+        case P_SYNC_WEIGHT_COMBINED:    sync_detector_set_weight_combined(mgr->sync_detector, value); break;
+        case P_SYNC_LOCKED_THRESHOLD:   sync_detector_set_locked_threshold(mgr->sync_detector, value); break;
+        case P_SYNC_MIN_RETAIN:         sync_detector_set_min_retain(mgr->sync_detector, value); break;
+        case P_SYNC_TENTATIVE_INIT:     sync_detector_set_tentative_init(mgr->sync_detector, value); break;
+        case P_SYNC_DECAY_NORMAL:       sync_detector_set_decay_normal(mgr->sync_detector, value); break;
+        case P_SYNC_DECAY_RECOVERING:   sync_detector_set_decay_recovering(mgr->sync_detector, value); break;
+        case P_SYNC_TICK_TOLERANCE:     sync_detector_set_tick_tolerance(mgr->sync_detector, value); break;
+        case P_SYNC_MARKER_TOLERANCE:   sync_detector_set_marker_tolerance(mgr->sync_detector, value); break;
+        case P_SYNC_P_MARKER_TOLERANCE: sync_detector_set_p_marker_tolerance(mgr->sync_detector, value); break;
+        default: break;
+    }
+}
+
+/* Value as the setter will store it */
+static float param_normalize(int p, float value) {
+    return (p == P_CORR_MAX_MISSES) ? roundf(value) : value;
+}
+
+static bool param_in_range(int p, float value) {
+    return value >= params[p].min && value <= params[p].max;
+}
+
+/*============================================================================
+ * Staging Mailbox
+ *============================================================================*/
+
+typedef struct {
+    float value[P_COUNT];
+    uint32_t serial[P_COUNT];       /* Bumped by each setting; 0 = never set */
+} param_block_t;
+
+#define SLOT_FRESH      4u          /* Middle slot holds a block not yet taken */
+#define SLOT_INDEX(m)   ((m) & 3u)
+
+struct wwv_params {
+    param_block_t slot[3];
+
+    /* Control side, under lock */
+    wwv_mutex_t lock;
+    param_block_t staged;           /* Every setting made so far */
+    unsigned back;
+
+    /* Exchanged between the sides: slot index | SLOT_FRESH */
+    atomic_uint middle;
+
+    /* Detector path */
+    unsigned front;
+    uint32_t applied[P_COUNT];      /* Serial of the last setting applied */
+};
+
+wwv_params_t *wwv_params_create(void) {
+    wwv_params_t *pb = wwv_calloc(1, sizeof(*pb));
+    if (!pb) return NULL;
+
+    wwv_mutex_init(&pb->lock);
+    pb->back = 0;
+    atomic_init(&pb->middle, 1u);
+    pb->front = 2;
+    return pb;
+}
+
+void wwv_params_destroy(wwv_params_t *pb) {
+    if (!pb) return;
+    wwv_mutex_destroy(&pb->lock);
+    wwv_free(pb);
+}
+
+/* Control side, under lock: hand the staged block to the detector path */
+static void params_publish(wwv_params_t *pb) {
+    pb->slot[pb->back] = pb->staged;
+    unsigned old = atomic_exchange_explicit(&pb->middle, pb->back | SLOT_FRESH,
+                                            memory_order_acq_rel);
+    pb->back = SLOT_INDEX(old);
+}
+
+void wwv_params_apply(wwv_detector_manager_t *mgr) {
+    wwv_params_t *pb = mgr->params;
+    if (!pb || !(atomic_load_explicit(&pb->middle, memory_order_relaxed) & SLOT_FRESH)) return;
+
+    unsigned old = atomic_exchange_explicit(&pb->middle, pb->front, memory_order_acq_rel);
+    pb->front = SLOT_INDEX(old);
+
+    const param_block_t *blk = &pb->slot[pb->front];
+    for (int p = 0; p < P_COUNT; p++) {
+        if (blk->serial[p] == pb->applied[p]) continue;
+        pb->applied[p] = blk->serial[p];
+        if (param_owner(mgr, p)) param_write(mgr, p, blk->value[p]);
+    }
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+bool wwv_detector_manager_set_params(wwv_detector_manager_t *mgr,
+                                     const wwv_param_setting_t *settings, int count) {
+    if (!mgr || !mgr->params || (!settings && count > 0)) return false;
+
+    /* All or nothing: check the whole batch before staging any of it */
+    for (int k = 0; k < count; k++) {
+        int p = param_lookup(settings[k].name);
+        if (p < 0 || !param_owner(mgr, p) ||
+            !param_in_range(p, param_normalize(p, settings[k].value))) {
+            return false;
+        }
+    }
+
+    wwv_params_t *pb = mgr->params;
+    wwv_mutex_lock(&pb->lock);
+    for (int k = 0; k < count; k++) {
+        int p = param_lookup(settings[k].name);
+        pb->staged.value[p] = param_normalize(p, settings[k].value);
+        pb->staged.serial[p]++;
+    }
+    if (count > 0) params_publish(pb);
+    wwv_mutex_unlock(&pb->lock);
+    return true;
+}
+
+bool wwv_detector_manager_set_param(wwv_detector_manager_t *mgr, const char *name, float value) {
+    wwv_param_setting_t setting = { name, value };
+    return wwv_detector_manager_set_params(mgr, &setting, 1);
+}
+
+bool wwv_detector_manager_get_param(wwv_detector_manager_t *mgr, const char *name, float *value) {
+    if (!mgr || !value || !mgr->params) return false;
+
+    int p = param_lookup(name);
+    if (p < 0 || !param_owner(mgr, p)) return false;
+
+    /* A staged setting is what the detector runs with from its next block;
+     * a tunable never set here still has its create-time value */
+    wwv_params_t *pb = mgr->params;
+    wwv_mutex_lock(&pb->lock);
+    bool staged = pb->staged.serial[p] != 0;
+    *value = staged ? pb->staged.value[p] : 0.0f;
+    wwv_mutex_unlock(&pb->lock);
+
+    if (!staged) *value = param_read(mgr, p);
+    return true;
+}
+
+const char *wwv_detector_manager_param_name(int index) {
+    return (index >= 0 && index < P_COUNT) ? params[index].name : NULL;
+}
@@ -0,0 +1,495 @@
+/**
+ * @file detector_pipeline.c
+ * @brief Optional threaded mode for the detector manager
+ *
+ * The SDR callback thread only copies samples into lock-free SPSC rings.
+ * Each path drains its ring on a dedicated worker:
+ *   - detector worker: tick, marker, BCD time/freq (50 kHz)
+ *   - display worker:  tone trackers (12 kHz), only if the graph runs a
+ *                      display-path node
+ *
+ * The refclock host time is read as a block is pushed, not as the worker
+ * gets to it, and goes through a stamp ring ahead of the samples: each
+ * stamp names the ring position of the block's last sample, and the
+ * worker maps it to its detector sample count before processing.
+ *
+ * External tick/marker/sync callbacks are all raised on the detector
+ * worker; in threaded mode they are queued into a bounded SPSC event ring
+ * instead and delivered on whichever thread calls dispatch_events() (as
+ * one batch per call when event buffers are set).
+ *
+ * Wakeups: a worker sets `sleeping` before re-checking its ring and the
+ * producer checks `sleeping` after publishing, all seq_cst, so the worker
+ * either sees the new samples or the producer sees it asleep and signals.
+ * The producer only touches the mutex when a worker is actually asleep.
+ *
+ * Each worker applies its real-time placement (config.*_cpus, rt_priority)
+ * to itself before its first sample and reads back what the OS granted;
+ * worker_start() waits for that, so mgr->rt is settled once create returns.
+ */
+
+#include "wwv_detector_manager_internal.h"
+#include "wwv_spsc_ring.h"
+#include "wwv_thread.h"
+#include "wwv_arena.h"
+#include "wwv_trace.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+/*============================================================================
+ * Internal State
+ *============================================================================*/
+
+typedef void (*path_process_fn)(wwv_detector_manager_t *mgr, const kiss_fft_cpx *samples, size_t count);
+
+typedef struct {
+    wwv_detector_manager_t *mgr;
+    const char *name;
+    wwv_spsc_ring_t *ring;
+    path_process_fn process;
+
+    wwv_thread_t thread;
+    bool started;
+
+    wwv_rt_worker_t *rt;        /* In mgr->rt, written by the worker before placed */
+
+    wwv_mutex_t lock;
+    wwv_cond_t wake;
+    wwv_cond_t idle;
+    atomic_bool sleeping;
+    bool idle_flag;             /* Guarded by lock */
+    bool placed;                /* Guarded by lock */
+    bool stop;                  /* Guarded by lock */
+
+    uint64_t overruns;          /* Producer side only */
+} path_worker_t;
+
+typedef enum {
+    PIPE_EVENT_TICK,
+    PIPE_EVENT_MARKER,
+    PIPE_EVENT_SYNC
+} pipe_event_type_t;
+
+typedef struct {
+    uint64_t position;          /* Detector samples accepted, up to this block's last */
+    int64_t host_ns;            /* Host clock as it was pushed */
+} pipe_stamp_t;
+
+typedef struct {
+    pipe_event_type_t type;
+    union {
+        wwv_tick_event_t tick;
+        wwv_marker_event_t marker;
+        wwv_sync_status_t sync;
+    } u;
+} pipe_event_t;
+
+struct wwv_pipeline {
+    path_worker_t detector;
+    path_worker_t display;
+    wwv_spsc_ring_t *events;
+    atomic_uint_fast64_t events_dropped;
+
+    wwv_spsc_ring_t *stamps;    /* NULL without config.refclock */
+    uint64_t pushed;            /* Producer side only */
+    uint64_t consumed;          /* Detector worker only */
+};
+
+/*============================================================================
+ * Path Processing (worker side)
+ *============================================================================*/
+
+static void process_detector_path(wwv_detector_manager_t *mgr, const kiss_fft_cpx *samples, size_t count) {
+    struct wwv_pipeline *p = mgr->pipeline;
+
+    /* The latest stamp pushed; a full stamp ring only leaves an older one */
+    pipe_stamp_t stamp;
+    bool stamped = false;
+    while (p->stamps && wwv_spsc_ring_read(p->stamps, &stamp, 1) == 1) stamped = true;
+    if (stamped) {
+        mgr->refclock_host_ns = stamp.host_ns;
+        mgr->refclock_host_sample = mgr->detector_samples - p->consumed + stamp.position;
+    }
+    p->consumed += count;
+    wwv_detector_block_cpx(mgr, samples, count);
+}
+
+static void process_display_path(wwv_detector_manager_t *mgr, const kiss_fft_cpx *samples, size_t count) {
+    float i_chunk[WWV_BLOCK_CHUNK_SAMPLES];
+    float q_chunk[WWV_BLOCK_CHUNK_SAMPLES];
+
+    for (size_t k = 0; k < count; k++) {
+        i_chunk[k] = samples[k].r;
+        q_chunk[k] = samples[k].i;
+    }
+    wwv_detector_manager_process_display_block(mgr, i_chunk, q_chunk, count);
+}
+
+/* Apply the requested placement to this thread and record the outcome */
+static void worker_place(path_worker_t *w) {
+    wwv_rt_worker_t *rt = w->rt;
+    if (rt->cpus_requested) wwv_thread_set_affinity(rt->cpus_requested);
+    if (rt->priority_requested > 0) wwv_thread_set_realtime(rt->priority_requested);
+    rt->cpus = wwv_thread_get_affinity();
+    rt->priority = wwv_thread_get_realtime();
+    rt->started = true;
+
+    wwv_mutex_lock(&w->lock);
+    w->placed = true;
+    wwv_cond_broadcast(&w->idle);
+    wwv_mutex_unlock(&w->lock);
+}
+
+static void worker_main(void *arg) {
+    path_worker_t *w = (path_worker_t *)arg;
+    kiss_fft_cpx chunk[WWV_BLOCK_CHUNK_SAMPLES];
+    WWV_TRACE_THREAD(w->name);
+    worker_place(w);
+
+    for (;;) {
+        size_t n = wwv_spsc_ring_read(w->ring, chunk, WWV_BLOCK_CHUNK_SAMPLES);
+        if (n > 0) {
+            w->process(w->mgr, chunk, n);
+            continue;
+        }
+
+        wwv_mutex_lock(&w->lock);
+        atomic_store(&w->sleeping, true);
+        if (wwv_spsc_ring_available(w->ring) == 0) {
+            if (w->stop) {
+                atomic_store(&w->sleeping, false);
+                w->idle_flag = true;
+                wwv_cond_broadcast(&w->idle);
+                wwv_mutex_unlock(&w->lock);
+                return;
+            }
+            w->idle_flag = true;
+            wwv_cond_broadcast(&w->idle);
+            wwv_cond_wait(&w->wake, &w->lock);
+            w->idle_flag = false;
+        }
+        atomic_store(&w->sleeping, false);
+        wwv_mutex_unlock(&w->lock);
+    }
+}
+
+/*============================================================================
+ * Worker Control
+ *============================================================================*/
+
+static bool worker_start(path_worker_t *w, wwv_detector_manager_t *mgr, const char *name,
+                         size_t ring_samples, path_process_fn process, wwv_rt_worker_t *rt) {
+    w->mgr = mgr;
+    w->name = name;
+    w->process = process;
+    w->rt = rt;
+    w->ring = wwv_spsc_ring_create(sizeof(kiss_fft_cpx), ring_samples);
+    if (!w->ring) return false;
+
+    wwv_mutex_init(&w->lock);
+    wwv_cond_init(&w->wake);
+    wwv_cond_init(&w->idle);
+    atomic_init(&w->sleeping, false);
+
+    w->started = wwv_thread_create(&w->thread, worker_main, w);
+    if (!w->started) return false;
+
+    wwv_mutex_lock(&w->lock);
+    while (!w->placed) wwv_cond_wait(&w->idle, &w->lock);
+    wwv_mutex_unlock(&w->lock);
+    return true;
+}
+
+static void worker_wake(path_worker_t *w) {
+    if (atomic_load(&w->sleeping)) {
+        wwv_mutex_lock(&w->lock);
+        wwv_cond_signal(&w->wake);
+        wwv_mutex_unlock(&w->lock);
+    }
+}
+
+static void worker_flush(path_worker_t *w) {
+    if (!w->started) return;
+
+    wwv_mutex_lock(&w->lock);
+    while (!(w->idle_flag && wwv_spsc_ring_available(w->ring) == 0)) {
+        wwv_cond_wait(&w->idle, &w->lock);
+    }
+    wwv_mutex_unlock(&w->lock);
+}
+
+static void worker_stop(path_worker_t *w) {
+    if (w->started) {
+        wwv_mutex_lock(&w->lock);
+        w->stop = true;
+        wwv_cond_signal(&w->wake);
+        wwv_mutex_unlock(&w->lock);
+        wwv_thread_join(w->thread);
+        w->started = false;
+    }
+    if (w->ring) {
+        wwv_cond_destroy(&w->idle);
+        wwv_cond_destroy(&w->wake);
+        wwv_mutex_destroy(&w->lock);
+        wwv_spsc_ring_destroy(w->ring);
+        w->ring = NULL;
+    }
+}
+
+/* Interleave and enqueue; anything that does not fit is an overrun */
+static size_t worker_push(path_worker_t *w, const float *i_samples, const float *q_samples, size_t count) {
+    kiss_fft_cpx chunk[WWV_BLOCK_CHUNK_SAMPLES];
+    size_t accepted = 0;
+
+    while (accepted < count) {
+        size_t n = count - accepted;
+        if (n > WWV_BLOCK_CHUNK_SAMPLES) n = WWV_BLOCK_CHUNK_SAMPLES;
+        for (size_t k = 0; k < n; k++) {
+            chunk[k].r = i_samples[accepted + k];
+            chunk[k].i = q_samples[accepted + k];
+        }
+
+        size_t written = wwv_spsc_ring_write(w->ring, chunk, n);
+        accepted += written;
+        if (written < n) break;
+    }
+
+    w->overruns += count - accepted;
+    worker_wake(w);
+    return accepted;
+}
+
+/*============================================================================
+ * Internal Interface (wwv_detector_manager_internal.h)
+ *============================================================================*/
+
+bool wwv_pipeline_start(wwv_detector_manager_t *mgr, const wwv_detector_config_t *config) {
+    struct wwv_pipeline *p = wwv_calloc(1, sizeof(*p));
+    if (!p) return false;
+    mgr->pipeline = p;
+
+    size_t det_ring = config->ring_samples ? config->ring_samples : WWV_PIPELINE_DETECTOR_RING;
+    size_t disp_ring = config->ring_samples ? config->ring_samples : WWV_PIPELINE_DISPLAY_RING;
+    size_t events = config->event_queue_size ? config->event_queue_size : WWV_PIPELINE_EVENT_QUEUE;
+
+    p->events = wwv_spsc_ring_create(sizeof(pipe_event_t), events);
+    atomic_init(&p->events_dropped, 0);
+    if (config->refclock) {
+        p->stamps = wwv_spsc_ring_create(sizeof(pipe_stamp_t), WWV_PIPELINE_STAMP_QUEUE);
+    }
+
+    mgr->rt.detector.cpus_requested = config->detector_cpus;
+    mgr->rt.detector.priority_requested = config->rt_priority;
+    mgr->rt.display.cpus_requested = config->display_cpus;
+    mgr->rt.display.priority_requested = config->rt_priority;
+
+    if (!p->events || (config->refclock && !p->stamps) ||
+        !worker_start(&p->detector, mgr, "detector", det_ring, process_detector_path,
+                      &mgr->rt.detector) ||
+        (mgr->graph.display_path &&
+         !worker_start(&p->display, mgr, "display", disp_ring, process_display_path,
+                       &mgr->rt.display))) {
+        wwv_pipeline_stop(mgr);
+        return false;
+    }
+
+    printf("[DETECTOR_MGR] Threaded mode: rings detector=%zu display=%zu, event queue=%zu\n",
+           wwv_spsc_ring_capacity(p->detector.ring),
+           wwv_spsc_ring_capacity(p->display.ring),
+           wwv_spsc_ring_capacity(p->events));
+    return true;
+}
+
+void wwv_pipeline_stop(wwv_detector_manager_t *mgr) {
+    struct wwv_pipeline *p = mgr->pipeline;
+    if (!p) return;
+
+    /* Workers drain their rings before exiting */
+    worker_stop(&p->detector);
+    worker_stop(&p->display);
+
+    printf("[DETECTOR_MGR] Pipeline: overruns detector=%llu display=%llu, events dropped=%llu\n",
+           (unsigned long long)p->detector.overruns,
+           (unsigned long long)p->display.overruns,
+           (unsigned long long)atomic_load(&p->events_dropped));
+    wwv_spsc_ring_destroy(p->events);
+    wwv_spsc_ring_destroy(p->stamps);
+
+    wwv_free(p);
+    mgr->pipeline = NULL;
+}
+
+bool wwv_pipeline_emit_tick(wwv_detector_manager_t *mgr, const wwv_tick_event_t *event) {
+    if (!mgr->pipeline) return false;
+
+    pipe_event_t ev = { .type = PIPE_EVENT_TICK, .u.tick = *event };
+    if (wwv_spsc_ring_write(mgr->pipeline->events, &ev, 1) == 0) {
+        atomic_fetch_add(&mgr->pipeline->events_dropped, 1);
+    }
+    return true;
+}
+
+bool wwv_pipeline_emit_marker(wwv_detector_manager_t *mgr, const wwv_marker_event_t *event) {
+    if (!mgr->pipeline) return false;
+
+    pipe_event_t ev = { .type = PIPE_EVENT_MARKER, .u.marker = *event };
+    if (wwv_spsc_ring_write(mgr->pipeline->events, &ev, 1) == 0) {
+        atomic_fetch_add(&mgr->pipeline->events_dropped, 1);
+    }
+    return true;
+}
+
+bool wwv_pipeline_emit_sync(wwv_detector_manager_t *mgr, const wwv_sync_status_t *status) {
+    if (!mgr->pipeline) return false;
+
+    pipe_event_t ev = { .type = PIPE_EVENT_SYNC, .u.sync = *status };
+    if (wwv_spsc_ring_write(mgr->pipeline->events, &ev, 1) == 0) {
+        atomic_fetch_add(&mgr->pipeline->events_dropped, 1);
+    }
+    return true;
+}
+
+/* "0-3,6" for a CPU mask, "any" for 0 */
+static const char *format_cpus(uint64_t mask, char *buf, size_t size) {
+    if (mask == 0) return "any";
+    size_t len = 0;
+    buf[0] = '\0';
+    for (int cpu = 0; cpu < 64 && len < size; cpu++) {
+        if (!(mask & (1ull << cpu))) continue;
+        int last = cpu;
+        while (last < 63 && (mask & (1ull << (last + 1)))) last++;
+        int n = (last > cpu)
+            ? snprintf(buf + len, size - len, "%s%d-%d", len ? "," : "", cpu, last)
+            : snprintf(buf + len, size - len, "%s%d", len ? "," : "", cpu);
+        if (n < 0) break;
+        len += (size_t)n;
+        cpu = last;
+    }
+    return buf;
+}
+
+static void print_rt_worker(const char *name, const wwv_rt_worker_t *rt) {
+    char want[192], got[192];
+    if (!rt->started) {
+        printf("  %-8s  not running\n", name);
+        return;
+    }
+    bool cpus_ok = !rt->cpus_requested || (rt->cpus && (rt->cpus & ~rt->cpus_requested) == 0);
+    bool prio_ok = rt->priority == rt->priority_requested;
+    printf("  %-8s  cpus %s (asked %s)%s, %s %d (asked %d)%s\n", name,
+           format_cpus(rt->cpus, got, sizeof(got)),
+           format_cpus(rt->cpus_requested, want, sizeof(want)), cpus_ok ? "" : " REFUSED",
+           rt->priority ? "SCHED_FIFO" : "normal", rt->priority,
+           rt->priority_requested, prio_ok ? "" : " REFUSED");
+}
+
+void wwv_pipeline_print_rt(wwv_detector_manager_t *mgr) {
+    const wwv_rt_status_t *rt = &mgr->rt;
+    printf("Real-time: memory %s%s, %.1f KB prefaulted\n",
+           rt->memory_locked ? "locked" : "not locked",
+           rt->lock_requested && !rt->memory_locked ? " (mlockall REFUSED)" : "",
+           (double)rt->prefaulted_bytes / 1024.0);
+    print_rt_worker("detector", &rt->detector);
+    print_rt_worker("display", &rt->display);
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+size_t wwv_detector_manager_push_detector_block(wwv_detector_manager_t *mgr,
+                                                const float *i_samples,
+                                                const float *q_samples,
+                                                size_t count) {
+    if (!mgr || !i_samples || !q_samples || count == 0) return 0;
+
+    if (!mgr->pipeline) {
+        wwv_detector_manager_process_detector_block(mgr, i_samples, q_samples, count);
+        return count;
+    }
+
+    /* Stamped here, so the time the samples wait in the ring is not
+     * counted, and queued ahead of them, so the worker has it before
+     * their events */
+    struct wwv_pipeline *p = mgr->pipeline;
+    pipe_stamp_t stamp = { p->pushed + count, 0 };
+    if (p->stamps) {
+        stamp.host_ns = wwv_refclock_host_ns();
+        wwv_spsc_ring_write(p->stamps, &stamp, 1);
+    }
+    size_t accepted = worker_push(&p->detector, i_samples, q_samples, count);
+    p->pushed += accepted;
+
+    /* An overrun dropped the block's tail: restate it on what went in */
+    if (p->stamps && accepted < count) {
+        stamp.position = p->pushed;
+        wwv_spsc_ring_write(p->stamps, &stamp, 1);
+    }
+    return accepted;
+}
+
+size_t wwv_detector_manager_push_display_block(wwv_detector_manager_t *mgr,
+                                               const float *i_samples,
+                                               const float *q_samples,
+                                               size_t count) {
+    if (!mgr || !i_samples || !q_samples || count == 0) return 0;
+
+    /* Headless graph: no display worker, samples are only counted */
+    if (!mgr->pipeline || !mgr->graph.display_path) {
+        wwv_detector_manager_process_display_block(mgr, i_samples, q_samples, count);
+        return count;
+    }
+    return worker_push(&mgr->pipeline->display, i_samples, q_samples, count);
+}
+
+int wwv_detector_manager_dispatch_events(wwv_detector_manager_t *mgr) {
+    if (!mgr || !mgr->pipeline) return 0;
+
+    int dispatched = 0;
+    pipe_event_t ev;
+
+    while (wwv_spsc_ring_read(mgr->pipeline->events, &ev, 1) == 1) {
+        if (ev.type == PIPE_EVENT_TICK) {
+            wwv_events_tick(mgr, &ev.u.tick);
+        } else if (ev.type == PIPE_EVENT_MARKER) {
+            wwv_events_marker(mgr, &ev.u.marker);
+        } else {
+            wwv_events_sync(mgr, &ev.u.sync);
+        }
+        dispatched++;
+    }
+    wwv_events_deliver(mgr);
+
+    return dispatched;
+}
+
+void wwv_detector_manager_flush(wwv_detector_manager_t *mgr) {
+    if (!mgr || !mgr->pipeline) return;
+    worker_flush(&mgr->pipeline->detector);
+    worker_flush(&mgr->pipeline->display);
+}
+
+bool wwv_detector_manager_is_threaded(wwv_detector_manager_t *mgr) {
+    return mgr ? mgr->pipeline != NULL : false;
+}
+
+wwv_rt_status_t wwv_detector_manager_get_rt_status(wwv_detector_manager_t *mgr) {
+    wwv_rt_status_t status = {0};
+    if (mgr) status = mgr->rt;
+    return status;
+}
+
+wwv_pipeline_stats_t wwv_detector_manager_get_pipeline_stats(wwv_detector_manager_t *mgr) {
+    wwv_pipeline_stats_t stats = {0};
+    if (!mgr || !mgr->pipeline) return stats;
+
+    struct wwv_pipeline *p = mgr->pipeline;
+    stats.detector_overruns = p->detector.overruns;
+    stats.display_overruns = p->display.overruns;
+    stats.events_dropped = atomic_load(&p->events_dropped);
+    stats.detector_backlog = wwv_spsc_ring_available(p->detector.ring);
+    stats.display_backlog = wwv_spsc_ring_available(p->display.ring);
+    stats.events_pending = wwv_spsc_ring_available(p->events);
+    return stats;
+}
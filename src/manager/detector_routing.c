@@ -1,97 +1,486 @@
 /**
  * @file detector_routing.c
- * @brief Internal event routing callbacks
+ * @brief Detector graph description and event sinks
  *
- * Routes detector events to correlators and external callbacks.
+ * The node and edge tables below are the manager's whole event flow (see
+ * detector_graph.h). Producer callbacks only emit on their port; each
+ * edge's sink adapts the event to its consumer.
  */
 
 #include "wwv_detector_manager_internal.h"
+#include "wwv_thread.h"
+#include <math.h>
+#include <time.h>
+
+/* Tick economy: gate epoch ahead of the measured (trailing edge) tick time */
+#define ECONOMY_GATE_LEAD_MS    20.0f
 
 /*============================================================================
- * Tick Event Routing
+ * Node Conditions
  *============================================================================*/
 
-void wwv_routing_on_tick_event(const tick_event_t *event, void *user_data) {
-    wwv_detector_manager_t *mgr = (wwv_detector_manager_t *)user_data;
-    
-    /* NOTE: tick_correlator requires full tick information (12 parameters)
-     * which is only available in tick_detector internals. The correlator
-     * should be fed directly from tick_detector, not through the manager.
-     * Keeping this routing for future implementation. */
-    
-    /* Forward to external callback */
-    if (mgr->tick_callback) {
-        wwv_tick_event_t ext_event = {
-            .tick_number = event->tick_number,
-            .timestamp_ms = event->timestamp_ms,
-            .duration_ms = event->duration_ms,
-            .energy = event->peak_energy
-        };
-        mgr->tick_callback(&ext_event, mgr->tick_callback_data);
+#ifdef WWV_NO_DISPLAY_PATH
+#define DISPLAY_PATH_COMPILED   false
+#else
+#define DISPLAY_PATH_COMPILED   true
+#endif
+
+#if defined(WWV_NO_DISPLAY_PATH) || defined(WWV_NO_SLOW_MARKER)
+#define SLOW_MARKER_COMPILED    false
+#else
+#define SLOW_MARKER_COMPILED    true
+#endif
+
+static bool want_tick(const wwv_detector_config_t *c)     { return c->enable_tick_detector; }
+static bool want_marker(const wwv_detector_config_t *c)   { return c->enable_marker_detector; }
+static bool want_bcd(const wwv_detector_config_t *c)      { return c->enable_bcd_detectors; }
+static bool want_tones(const wwv_detector_config_t *c)    { return c->enable_tone_trackers; }
+static bool want_slow(const wwv_detector_config_t *c)     { return c->enable_slow_marker && !c->marker_template; }
+static bool want_corr(const wwv_detector_config_t *c)     { return c->enable_correlators; }
+static bool want_sync(const wwv_detector_config_t *c)     { return c->enable_sync_detector; }
+static bool want_always(const wwv_detector_config_t *c)   { return true; }
+static bool want_refclock(const wwv_detector_config_t *c) { return c->refclock != NULL; }
+static bool want_history(const wwv_detector_config_t *c)  { return c->history_seconds > 0; }
+static bool fast_acquire(const wwv_detector_config_t *c)  { return c->fast_acquire; }
+
+/* BCD correlator: needs both its pulses and the correlator stage */
+static bool want_bcd_corr(const wwv_detector_config_t *c) {
+    return c->enable_bcd_detectors && c->enable_correlators;
+}
+
+/* A template-mode marker needs no second path to confirm it */
+static bool want_marker_corr(const wwv_detector_config_t *c) {
+    return c->enable_correlators && !c->marker_template;
+}
+
+/* The sliding freq detector has no frame FFT to thin out */
+static bool want_bcd_path(const wwv_detector_config_t *c) {
+    return want_bcd_corr(c) && c->bcd_adaptive && !c->bcd_freq_sliding;
+}
+
+const wwv_node_desc_t WWV_GRAPH_NODES[WWV_NODE_COUNT] = {
+    [WWV_NODE_TICK_DETECTOR]    = { "tick", WWV_PATH_DETECTOR,
+                                    WWV_PORT_BIT(WWV_PORT_TICK) | WWV_PORT_BIT(WWV_PORT_TICK_MARKER),
+                                    false, true, want_tick },
+    [WWV_NODE_MARKER_DETECTOR]  = { "marker", WWV_PATH_DETECTOR, WWV_PORT_BIT(WWV_PORT_MARKER),
+                                    false, true, want_marker },
+    [WWV_NODE_BCD_TIME_DETECTOR] = { "bcd_time", WWV_PATH_DETECTOR, WWV_PORT_BIT(WWV_PORT_BCD_TIME_PULSE),
+                                    true, true, want_bcd },
+    [WWV_NODE_BCD_FREQ_DETECTOR] = { "bcd_freq", WWV_PATH_DETECTOR, WWV_PORT_BIT(WWV_PORT_BCD_FREQ_PULSE),
+                                    true, true, want_bcd },
+    [WWV_NODE_TONE_TRACKERS]    = { "tones", WWV_PATH_DISPLAY, 0,
+                                    false, DISPLAY_PATH_COMPILED, want_tones },
+    [WWV_NODE_SLOW_MARKER]      = { "slow_marker", WWV_PATH_DISPLAY, WWV_PORT_BIT(WWV_PORT_SLOW_MARKER_FRAME),
+                                    true, SLOW_MARKER_COMPILED, want_slow },
+    [WWV_NODE_TICK_CORRELATOR]  = { "tick_corr", WWV_PATH_NONE, 0,
+                                    false, true, want_corr },
+    [WWV_NODE_MARKER_CORRELATOR] = { "marker_corr", WWV_PATH_NONE, 0,
+                                    false, true, want_marker_corr },
+    [WWV_NODE_SYNC_DETECTOR]    = { "sync", WWV_PATH_NONE, 0,
+                                    false, true, want_sync },
+    [WWV_NODE_BCD_CORRELATOR]   = { "bcd_corr", WWV_PATH_NONE, WWV_PORT_BIT(WWV_PORT_BCD_SYMBOL),
+                                    false, true, want_bcd_corr },
+    [WWV_NODE_BCD_TIME_SOLVER]  = { "bcd_solver", WWV_PATH_NONE, 0,
+                                    false, true, want_bcd_corr },
+    [WWV_NODE_BCD_PATH_POLICY]  = { "bcd_path", WWV_PATH_NONE, 0,
+                                    false, true, want_bcd_path },
+    [WWV_NODE_REFCLOCK]         = { "refclock", WWV_PATH_NONE, 0,
+                                    false, true, want_refclock },
+    [WWV_NODE_HISTORY]          = { "history", WWV_PATH_NONE, 0,
+                                    false, true, want_history },
+    /* Callbacks may be registered at any time, so this one always runs */
+    [WWV_NODE_EXTERNAL]         = { "external", WWV_PATH_NONE, 0,
+                                    false, true, want_always },
+};
+
+/*============================================================================
+ * Tick Sinks
+ *============================================================================*/
+
+/* Sync and the tick correlator follow WWV only; two stations' seconds would interleave */
+
+static void tick_to_sync(wwv_detector_manager_t *mgr, const void *ev) {
+    const tick_event_t *event = (const tick_event_t *)ev;
+    if (event->station != WWV_STATION_WWV) return;
+    sync_detector_tick_event(mgr->sync_detector, event->timestamp_ms);
+}
+
+static void tick_to_correlator(wwv_detector_manager_t *mgr, const void *ev) {
+    const tick_event_t *event = (const tick_event_t *)ev;
+    if (event->station != WWV_STATION_WWV) return;
+
+    char time_str[16];
+    time_t now = time(NULL);
+    strftime(time_str, sizeof(time_str), "%H:%M:%S", wwv_localtime(&now));
+
+    tick_correlator_add_tick(mgr->tick_correlator, time_str, event->timestamp_ms,
+                             event->epoch_ms, event->tick_number, wwv_station_name(event->station),
+                             event->peak_energy, event->duration_ms, event->interval_ms,
+                             event->avg_interval_ms, event->noise_floor,
+                             event->corr_peak, event->corr_ratio);
+}
+
+/* External callback (queued in threaded mode) */
+static void tick_to_external(wwv_detector_manager_t *mgr, const void *ev) {
+    const tick_event_t *event = (const tick_event_t *)ev;
+    if (!mgr->tick_callback && !mgr->pipeline && !mgr->batch.enabled) return;
+
+    wwv_tick_event_t ext_event = {
+        .tick_number = event->tick_number,
+        .station = event->station,
+        .timestamp_ms = event->timestamp_ms,
+        .sample_index = event->sample_index,
+        .epoch_ms = event->epoch_ms,
+        .epoch_refined = event->epoch_refined,
+        .duration_ms = event->duration_ms,
+        .energy = event->peak_energy
+    };
+    if (!wwv_pipeline_emit_tick(mgr, &ext_event)) wwv_events_tick(mgr, &ext_event);
+}
+
+/*
+ * Each WWV tick is the start of a second: the BCD solution names the
+ * minute it counts from, sync LOCKED vouches for the second count, and the
+ * tick's leading edge gives the receive time, carried back to the host
+ * clock from the stamp taken as the caller handed over its latest block.
+ */
+#define REFCLOCK_MAX_HOLDOVER_SEC   3600    /* Seconds counted past the last BCD solution */
+#define REFCLOCK_MAX_SLIP_MS        50.0    /* Tick vs the solution's second grid */
+
+static void tick_to_refclock(wwv_detector_manager_t *mgr, const void *ev) {
+    const tick_event_t *event = (const tick_event_t *)ev;
+    if (event->station != WWV_STATION_WWV || !mgr->sync_detector) return;
+
+    bcd_time_solution_t sol;
+    if (sync_detector_get_state(mgr->sync_detector) != SYNC_LOCKED ||
+        !bcd_time_solver_get_solution(mgr->bcd_time_solver, &sol)) {
+        return;
+    }
+
+    double edge_ms = (event->epoch_ms > 0.0) ? event->epoch_ms : event->timestamp_ms;
+    double since_ms = edge_ms - sol.minute_start_ms;
+    long long second = llround(since_ms / 1000.0);
+    if (second < 0 || second > REFCLOCK_MAX_HOLDOVER_SEC ||
+        fabs(since_ms - second * 1000.0) > REFCLOCK_MAX_SLIP_MS) {
+        return;
     }
+
+    double age_ms = wwv_samples_to_ms(mgr->refclock_host_sample, TICK_SAMPLE_RATE) - edge_ms +
+                    mgr->refclock_delay_ms;
+
+    wwv_refclock_sample_t sample = {
+        .utc_sec = wwv_refclock_unix_time(sol.year, sol.day, sol.hour, sol.minute) + second,
+        .receive_ns = mgr->refclock_host_ns - (int64_t)llround(age_ms * 1e6),
+        .leap = sol.leap_warning ? WWV_LEAP_INSERT : WWV_LEAP_NONE
+    };
+    wwv_refclock_publish(mgr->refclock, &sample);
+}
+
+/* Rows are keyed by the leading edge, the second the tick was sent in */
+static void tick_to_history(wwv_detector_manager_t *mgr, const void *ev) {
+    const tick_event_t *event = (const tick_event_t *)ev;
+    if (event->station != WWV_STATION_WWV) return;
+
+    double edge_ms = (event->epoch_ms > 0.0) ? event->epoch_ms : event->timestamp_ms;
+    wwv_history_record(mgr->history, WWV_HIST_TICKS, edge_ms, 1.0f);
+    wwv_history_record(mgr->history, WWV_HIST_TICK_CORR, edge_ms, event->corr_ratio);
+    if (event->peak_energy > 0.0f && event->noise_floor > 0.0f) {
+        wwv_history_record(mgr->history, WWV_HIST_TICK_SNR, edge_ms,
+                           10.0f * log10f(event->peak_energy / event->noise_floor));
+    }
+}
+
+static void tick_marker_to_sync(wwv_detector_manager_t *mgr, const void *ev) {
+    const tick_marker_event_t *event = (const tick_marker_event_t *)ev;
+    if (event->station != WWV_STATION_WWV) return;
+    sync_detector_tick_marker(mgr->sync_detector, event->timestamp_ms,
+                              event->duration_ms, event->corr_ratio);
 }
 
 /*============================================================================
- * Tick Marker Event Routing
+ * Marker Sinks
  *============================================================================*/
 
-void wwv_routing_on_tick_marker_event(const tick_marker_event_t *event, void *user_data) {
-    wwv_detector_manager_t *mgr = (wwv_detector_manager_t *)user_data;
-    
-    /* Feed sync detector */
-    if (mgr->sync_detector) {
-        sync_detector_tick_marker(mgr->sync_detector,
-                                   event->timestamp_ms,
-                                   event->duration_ms,
-                                   event->corr_ratio);
+static void marker_to_correlator(wwv_detector_manager_t *mgr, const void *ev) {
+    const marker_event_t *event = (const marker_event_t *)ev;
+    marker_correlator_fast_event(mgr->marker_correlator, event->timestamp_ms, event->duration_ms);
+}
+
+static void marker_to_external(wwv_detector_manager_t *mgr, const void *ev) {
+    const marker_event_t *event = (const marker_event_t *)ev;
+    if (!mgr->marker_callback && !mgr->pipeline && !mgr->batch.enabled) return;
+
+    wwv_marker_event_t ext_event = {
+        .marker_number = event->marker_number,
+        .timestamp_ms = event->timestamp_ms,
+        .sample_index = event->sample_index,
+        .since_last_sec = event->since_last_marker_sec,
+        .duration_ms = event->duration_ms,
+        .energy = event->accumulated_energy
+    };
+    if (!wwv_pipeline_emit_marker(mgr, &ext_event)) wwv_events_marker(mgr, &ext_event);
+}
+
+static void marker_to_history(wwv_detector_manager_t *mgr, const void *ev) {
+    const marker_event_t *event = (const marker_event_t *)ev;
+    wwv_history_record(mgr->history, WWV_HIST_MARKERS, event->timestamp_ms - event->duration_ms, 1.0f);
+}
+
+/* NOTE: slow_marker's baseline is NOT injected into marker_detector; the FFT
+ * configurations are incompatible (12kHz/2048 vs 50kHz/256) */
+static void slow_frame_to_correlator(wwv_detector_manager_t *mgr, const void *ev) {
+    const slow_marker_frame_t *frame = (const slow_marker_frame_t *)ev;
+    marker_correlator_slow_frame(mgr->marker_correlator, frame->timestamp_ms, frame->energy,
+                                 frame->snr_db, frame->above_threshold);
+}
+
+/*============================================================================
+ * BCD Sinks
+ *============================================================================*/
+
+static void bcd_time_to_correlator(wwv_detector_manager_t *mgr, const void *ev) {
+    const bcd_time_event_t *event = (const bcd_time_event_t *)ev;
+    bcd_correlator_time_event(mgr->bcd_correlator, event->timestamp_ms,
+                              event->duration_ms, event->peak_energy);
+}
+
+/* Position-marker-width pulses for the sync detector's fast acquisition */
+static void bcd_time_to_sync(wwv_detector_manager_t *mgr, const void *ev) {
+    const bcd_time_event_t *event = (const bcd_time_event_t *)ev;
+    if (event->duration_ms <= BCD_SYMBOL_ONE_MAX_MS || event->duration_ms > BCD_SYMBOL_MARKER_MAX_MS) return;
+    sync_detector_p_marker_event(mgr->sync_detector, event->timestamp_ms, event->duration_ms);
+}
+
+static void bcd_freq_to_correlator(wwv_detector_manager_t *mgr, const void *ev) {
+    const bcd_freq_event_t *event = (const bcd_freq_event_t *)ev;
+    bcd_correlator_freq_event(mgr->bcd_correlator, event->timestamp_ms,
+                              event->duration_ms, event->accumulated_energy);
+}
+
+static void bcd_time_to_path(wwv_detector_manager_t *mgr, const void *ev) {
+    bcd_path_policy_time_pulse(mgr->bcd_path, ((const bcd_time_event_t *)ev)->timestamp_ms);
+}
+
+static void bcd_freq_to_path(wwv_detector_manager_t *mgr, const void *ev) {
+    bcd_path_policy_freq_pulse(mgr->bcd_path, ((const bcd_freq_event_t *)ev)->timestamp_ms);
+}
+
+static void bcd_time_to_history(wwv_detector_manager_t *mgr, const void *ev) {
+    const bcd_time_event_t *event = (const bcd_time_event_t *)ev;
+    wwv_history_record(mgr->history, WWV_HIST_BCD_TIME_SNR, event->timestamp_ms, event->snr_db);
+}
+
+static void bcd_freq_to_history(wwv_detector_manager_t *mgr, const void *ev) {
+    const bcd_freq_event_t *event = (const bcd_freq_event_t *)ev;
+    wwv_history_record(mgr->history, WWV_HIST_BCD_FREQ_SNR, event->timestamp_ms, event->snr_db);
+}
+
+static void bcd_symbol_to_solver(wwv_detector_manager_t *mgr, const void *ev) {
+    bcd_time_solver_add_symbol(mgr->bcd_time_solver, (const bcd_symbol_event_t *)ev);
+}
+
+static void bcd_symbol_to_external(wwv_detector_manager_t *mgr, const void *ev) {
+    if (mgr->bcd_symbol_callback) {
+        mgr->bcd_symbol_callback((const bcd_symbol_event_t *)ev, mgr->bcd_symbol_callback_data);
     }
 }
 
 /*============================================================================
- * Marker Event Routing
+ * Edges
  *============================================================================*/
 
+/* Marker correlator is shared with process_display_fft() (slow marker).
+ * History only records BCD pulses the correlator keeps the detectors for. */
+const wwv_edge_desc_t WWV_GRAPH_EDGES[] = {
+    { WWV_PORT_TICK,              WWV_NODE_SYNC_DETECTOR,    tick_to_sync,             WWV_PERF_SYNC,        false, fast_acquire },
+    { WWV_PORT_TICK,              WWV_NODE_TICK_CORRELATOR,  tick_to_correlator,       WWV_PERF_CORRELATION, false, NULL },
+    { WWV_PORT_TICK,              WWV_NODE_EXTERNAL,         tick_to_external,         WWV_PERF_STAGE_COUNT, false, NULL },
+    { WWV_PORT_TICK,              WWV_NODE_REFCLOCK,         tick_to_refclock,         WWV_PERF_STAGE_COUNT, false, NULL },
+    { WWV_PORT_TICK,              WWV_NODE_HISTORY,          tick_to_history,          WWV_PERF_STAGE_COUNT, false, NULL },
+    { WWV_PORT_TICK_MARKER,       WWV_NODE_SYNC_DETECTOR,    tick_marker_to_sync,      WWV_PERF_SYNC,        false, NULL },
+    { WWV_PORT_MARKER,            WWV_NODE_MARKER_CORRELATOR, marker_to_correlator,    WWV_PERF_CORRELATION, true,  NULL },
+    { WWV_PORT_MARKER,            WWV_NODE_EXTERNAL,         marker_to_external,       WWV_PERF_STAGE_COUNT, false, NULL },
+    { WWV_PORT_MARKER,            WWV_NODE_HISTORY,          marker_to_history,        WWV_PERF_STAGE_COUNT, false, NULL },
+    { WWV_PORT_SLOW_MARKER_FRAME, WWV_NODE_MARKER_CORRELATOR, slow_frame_to_correlator, WWV_PERF_CORRELATION, true, NULL },
+    { WWV_PORT_BCD_TIME_PULSE,    WWV_NODE_BCD_CORRELATOR,   bcd_time_to_correlator,   WWV_PERF_CORRELATION, false, NULL },
+    { WWV_PORT_BCD_TIME_PULSE,    WWV_NODE_SYNC_DETECTOR,    bcd_time_to_sync,         WWV_PERF_SYNC,        false, fast_acquire },
+    { WWV_PORT_BCD_TIME_PULSE,    WWV_NODE_BCD_PATH_POLICY,  bcd_time_to_path,         WWV_PERF_STAGE_COUNT, false, NULL },
+    { WWV_PORT_BCD_TIME_PULSE,    WWV_NODE_HISTORY,          bcd_time_to_history,      WWV_PERF_STAGE_COUNT, false, want_bcd_corr },
+    { WWV_PORT_BCD_FREQ_PULSE,    WWV_NODE_BCD_CORRELATOR,   bcd_freq_to_correlator,   WWV_PERF_CORRELATION, false, NULL },
+    { WWV_PORT_BCD_FREQ_PULSE,    WWV_NODE_BCD_PATH_POLICY,  bcd_freq_to_path,         WWV_PERF_STAGE_COUNT, false, NULL },
+    { WWV_PORT_BCD_FREQ_PULSE,    WWV_NODE_HISTORY,          bcd_freq_to_history,      WWV_PERF_STAGE_COUNT, false, want_bcd_corr },
+    { WWV_PORT_BCD_SYMBOL,        WWV_NODE_BCD_TIME_SOLVER,  bcd_symbol_to_solver,     WWV_PERF_CORRELATION, false, NULL },
+    { WWV_PORT_BCD_SYMBOL,        WWV_NODE_EXTERNAL,         bcd_symbol_to_external,   WWV_PERF_STAGE_COUNT, false, NULL },
+};
+
+const int WWV_GRAPH_EDGE_COUNT = (int)(sizeof(WWV_GRAPH_EDGES) / sizeof(WWV_GRAPH_EDGES[0]));
+
+/*============================================================================
+ * Producer Callbacks
+ *============================================================================*/
+
+void wwv_routing_on_tick_event(const tick_event_t *event, void *user_data) {
+    wwv_graph_emit((wwv_detector_manager_t *)user_data, WWV_PORT_TICK, event);
+}
+
+void wwv_routing_on_tick_marker_event(const tick_marker_event_t *event, void *user_data) {
+    wwv_graph_emit((wwv_detector_manager_t *)user_data, WWV_PORT_TICK_MARKER, event);
+}
+
 void wwv_routing_on_marker_event(const marker_event_t *event, void *user_data) {
+    wwv_graph_emit((wwv_detector_manager_t *)user_data, WWV_PORT_MARKER, event);
+}
+
+void wwv_routing_on_slow_marker_frame(const slow_marker_frame_t *frame, void *user_data) {
+    wwv_graph_emit((wwv_detector_manager_t *)user_data, WWV_PORT_SLOW_MARKER_FRAME, frame);
+}
+
+/*
+ * Shared display spectrum tap, called from process_display_block() under
+ * route_lock. The slow marker's frame edge takes that lock itself, so it is
+ * dropped around the call; with a tap every hop is computed, so a getter
+ * meanwhile never rewrites the magnitudes.
+ */
+void wwv_routing_on_tone_spectrum(const float *magnitudes, int fft_size,
+                                  double timestamp_ms, void *user_data) {
+#ifndef WWV_NO_SLOW_MARKER
     wwv_detector_manager_t *mgr = (wwv_detector_manager_t *)user_data;
     
-    /* Feed correlator */
-    if (mgr->marker_correlator) {
-        marker_correlator_fast_event(mgr->marker_correlator,
-                                      event->timestamp_ms,
-                                      event->duration_ms);
+    wwv_mutex_unlock(&mgr->route_lock);
+    slow_marker_detector_process_magnitudes(mgr->slow_marker, magnitudes, fft_size, timestamp_ms);
+    wwv_mutex_lock(&mgr->route_lock);
+#else
+    (void)magnitudes; (void)fft_size; (void)timestamp_ms; (void)user_data;
+#endif
+}
+
+void wwv_routing_on_bcd_time_event(const bcd_time_event_t *event, void *user_data) {
+    wwv_graph_emit((wwv_detector_manager_t *)user_data, WWV_PORT_BCD_TIME_PULSE, event);
+}
+
+void wwv_routing_on_bcd_freq_event(const bcd_freq_event_t *event, void *user_data) {
+    wwv_graph_emit((wwv_detector_manager_t *)user_data, WWV_PORT_BCD_FREQ_PULSE, event);
+}
+
+void wwv_routing_on_bcd_symbol(const bcd_symbol_event_t *event, void *user_data) {
+    wwv_graph_emit((wwv_detector_manager_t *)user_data, WWV_PORT_BCD_SYMBOL, event);
+}
+
+/*
+ * Sync state changes: reported externally as a sync status, and with
+ * config.tick_economy the tick detector gates on its own measured epoch and
+ * runs in economy mode while LOCKED. Sync is fed only from the detector
+ * path, so the tick detector is reconfigured on the thread that drives it.
+ */
+static void sync_state_to_external(wwv_detector_manager_t *mgr, sync_state_t state,
+                                   float confidence) {
+    if (!mgr->sync_callback && !mgr->pipeline && !mgr->batch.enabled) return;
+
+    wwv_sync_status_t status = {
+        .is_synced = (state == SYNC_LOCKED),
+        .confidence = confidence,
+        .drift_ppm = 0.0f,
+        .tick_count = wwv_detector_manager_get_tick_count(mgr),
+        .marker_count = wwv_detector_manager_get_marker_count(mgr)
+    };
+    if (!wwv_pipeline_emit_sync(mgr, &status)) wwv_events_sync(mgr, &status);
+}
+
+void wwv_routing_on_sync_state(sync_state_t old_state, sync_state_t new_state,
+                               float confidence, void *user_data) {
+    wwv_detector_manager_t *mgr = (wwv_detector_manager_t *)user_data;
+    tick_detector_t *td = mgr->tick_detector;
+    static const wwv_station_t stations[] = { WWV_STATION_WWV, WWV_STATION_WWVH };
+    (void)old_state;
+
+    sync_state_to_external(mgr, new_state, confidence);
+    if (!mgr->tick_economy) return;
+
+    if (new_state != SYNC_LOCKED) {
+        if (tick_detector_get_economy(td)) {
+            tick_detector_set_economy(td, false);
+            tick_detector_set_gating_enabled(td, false);
+        }
+        return;
     }
-    
-    /* Forward to external callback */
-    if (mgr->marker_callback) {
-        wwv_marker_event_t ext_event = {
-            .marker_number = event->marker_number,
-            .timestamp_ms = event->timestamp_ms,
-            .since_last_sec = event->since_last_marker_sec,
-            .duration_ms = event->duration_ms,
-            .energy = event->accumulated_energy
-        };
-        mgr->marker_callback(&ext_event, mgr->marker_callback_data);
+
+    /* Every station needs an epoch of its own before the gate can close */
+    float epoch_ms[2];
+    for (int k = 0; k < 2; k++) {
+        if (tick_detector_has_station(td, stations[k]) &&
+            !tick_detector_get_measured_epoch(td, stations[k], &epoch_ms[k])) return;
     }
+    for (int k = 0; k < 2; k++) {
+        if (!tick_detector_has_station(td, stations[k])) continue;
+        tick_detector_set_station_epoch(td, stations[k], epoch_ms[k] - ECONOMY_GATE_LEAD_MS,
+                                        EPOCH_SOURCE_TICK_CHAIN, confidence);
+    }
+    tick_detector_set_gating_enabled(td, true);
+    tick_detector_set_economy(td, true);
 }
 
-/*============================================================================
- * Slow Marker Frame Routing
- *============================================================================*/
+/*
+ * The SNR is the display path's carrier estimate; without one (display
+ * path compiled out or not running) the policy keeps both paths.
+ */
+void wwv_routing_on_bcd_path_timer(wwv_timer_t *timer, double now_ms, void *user_data) {
+    wwv_detector_manager_t *mgr = (wwv_detector_manager_t *)user_data;
 
-void wwv_routing_on_slow_marker_frame(const slow_marker_frame_t *frame, void *user_data) {
+    channel_quality_report_t cq;
+    bool snr_valid = wwv_detector_manager_get_channel_quality(mgr, &cq) && cq.valid;
+    bcd_path_mode_t mode = bcd_path_policy_update(mgr->bcd_path, now_ms,
+                                                  snr_valid ? cq.snr_db : 0.0f, snr_valid);
+    bcd_freq_detector_set_idle(mgr->bcd_freq_detector, mode == BCD_PATH_TIME_ONLY);
+
+    wwv_timer_arm_after_ms(mgr->timers, timer, now_ms + BCD_PATH_EVAL_MS);
+}
+
+/*
+ * Fires once the detector path has passed the end of a stream second.
+ * Ticks and markers arriving after this (a tick sent just before the
+ * boundary is reported after it) still add into that row.
+ *
+ * A second sends a tick unless it is :00, :29 or :59, numbered as the
+ * sync detector numbers seconds while locked or recovering. Its anchor is
+ * a marker's trailing edge, so a hole may be placed a second or two late;
+ * a minute still expects 57.
+ */
+static float history_ticks_expected(wwv_detector_manager_t *mgr, double second_ms) {
+    if (!mgr->sync_detector) return 1.0f;
+    frame_time_t ft = sync_detector_get_frame_time(mgr->sync_detector);
+    if ((ft.state != SYNC_LOCKED && ft.state != SYNC_RECOVERING) || ft.current_second < 0) {
+        return 1.0f;
+    }
+
+    long long k = llround((second_ms + 500.0 - ft.second_start_ms) / 1000.0);
+    int pos = (int)(((ft.current_second + k) % 60 + 60) % 60);
+    return (pos == 0 || pos == 29 || pos == 59) ? 0.0f : 1.0f;
+}
+
+void wwv_routing_on_history_timer(wwv_timer_t *timer, double now_ms, void *user_data) {
     wwv_detector_manager_t *mgr = (wwv_detector_manager_t *)user_data;
-    
-    /* Feed correlator for verification */
-    if (mgr->marker_correlator) {
-        marker_correlator_slow_frame(mgr->marker_correlator,
-                                      frame->timestamp_ms,
-                                      frame->energy,
-                                      frame->snr_db,
-                                      frame->above_threshold);
+    wwv_history_t *h = mgr->history;
+    double second_ms = (floor(now_ms / 1000.0) - 1.0) * 1000.0;
+
+    if (mgr->tick_detector) {
+        wwv_history_record(h, WWV_HIST_TICKS, second_ms, 0.0f);
+        wwv_history_record(h, WWV_HIST_TICKS_EXPECTED, second_ms,
+                           history_ticks_expected(mgr, second_ms));
     }
-    
-    /* NOTE: We do NOT inject slow_marker's baseline into marker_detector!
-     * The FFT configurations are incompatible (12kHz/2048 vs 50kHz/256).
-     * Each detector tracks its own baseline independently.
-     */
+    if (mgr->marker_detector) wwv_history_record(h, WWV_HIST_MARKERS, second_ms, 0.0f);
+    if (mgr->sync_detector) {
+        wwv_history_record(h, WWV_HIST_SYNC_CONFIDENCE, second_ms,
+                           sync_detector_get_confidence(mgr->sync_detector));
+    }
+
+    channel_quality_report_t cq;
+    if (wwv_detector_manager_get_channel_quality(mgr, &cq) && cq.valid) {
+        wwv_history_record(h, WWV_HIST_CARRIER_SNR, second_ms, cq.snr_db);
+    }
+    tone_measurement_t tone;
+    if (wwv_detector_manager_get_tone(mgr, 0.0f, &tone) && tone.valid) {
+        wwv_history_record(h, WWV_HIST_TONE_PPM, second_ms, tone.offset_ppm);
+    }
+
+    wwv_timer_arm_after_ms(mgr->timers, timer, (floor(now_ms / 1000.0) + 1.0) * 1000.0);
 }
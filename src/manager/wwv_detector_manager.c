@@ -12,81 +12,563 @@
 #include "sync_detector.h"
 #include "tone_tracker.h"
 #include "slow_marker_detector.h"
+#include "bcd_time_detector.h"
+#include "bcd_freq_detector.h"
+#include "tick_correlator.h"
+#include "wwv_state.h"
+#include "telemetry.h"
+#include "wwv_timebase.h"
+#include "wwv_arena.h"
+#include "wwv_denormal.h"
+#include "wwv_trace.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <time.h>
 
 /*============================================================================
  * Lifecycle
  *============================================================================*/
 
+static wwv_detector_manager_t *manager_create(const wwv_detector_config_t *config) {
+    wwv_detector_manager_t *mgr = wwv_calloc(1, sizeof(*mgr));
+    if (!mgr) return NULL;
+    
+    wwv_mutex_init(&mgr->route_lock);
+    
+    mgr->params = wwv_params_create();
+    if (!mgr->params || !wwv_detector_lifecycle_create_all(mgr, config)) {
+        wwv_params_destroy(mgr->params);
+        wwv_mutex_destroy(&mgr->route_lock);
+        wwv_free(mgr);
+        return NULL;
+    }
+    
+    if (config->threaded && !wwv_pipeline_start(mgr, config)) {
+        printf("[DETECTOR_MGR] Threaded mode unavailable, running synchronously\n");
+    }
+    
+    return mgr;
+}
+
 wwv_detector_manager_t *wwv_detector_manager_create(const wwv_detector_config_t *config) {
-    wwv_detector_manager_t *mgr = calloc(1, sizeof(*mgr));
+    /* Everything create allocates, pipeline rings included, is written
+     * page by page here rather than on the first frames that use it */
+    bool prev = wwv_alloc_set_prefault(config->prefault);
+    size_t before = wwv_alloc_prefaulted();
+    wwv_detector_manager_t *mgr = manager_create(config);
+    size_t prefaulted = wwv_alloc_prefaulted() - before;
+    wwv_alloc_set_prefault(prev);
     if (!mgr) return NULL;
     
-    if (!wwv_detector_lifecycle_create_all(mgr, config)) {
-        free(mgr);
+    mgr->rt.prefaulted_bytes = prefaulted;
+    mgr->rt.lock_requested = config->lock_memory;
+    if (config->lock_memory) mgr->rt.memory_locked = wwv_memory_lock();
+    
+    if (config->lock_memory || config->prefault || config->rt_priority > 0 ||
+        config->detector_cpus || config->display_cpus) {
+        wwv_pipeline_print_rt(mgr);
+    }
+    return mgr;
+}
+
+/**
+ * Tear down without final stats (shared by destroy and the sizing run)
+ */
+static void manager_teardown(wwv_detector_manager_t *mgr) {
+    wwv_arena_t *arena = mgr->arena;
+    
+    wwv_detector_lifecycle_destroy_all(mgr);
+    wwv_params_destroy(mgr->params);
+    wwv_mutex_destroy(&mgr->route_lock);
+    wwv_free(mgr);
+    
+    /* Arena blocks were no-op frees above; release them in one go */
+    wwv_arena_destroy(arena);
+}
+
+size_t wwv_detector_manager_required_size(const wwv_detector_config_t *config) {
+    if (!config) return 0;
+    
+    wwv_arena_t *measure = wwv_arena_create_measure();
+    if (!measure) return 0;
+    
+    /* The sizing run places nothing: no mlockall, no prefaulting */
+    wwv_detector_config_t sizing = *config;
+    sizing.lock_memory = false;
+    sizing.prefault = false;
+    sizing.rt_priority = 0;
+    
+    wwv_arena_t *prev = wwv_arena_push(measure);
+    wwv_detector_manager_t *mgr = wwv_detector_manager_create(&sizing);
+    wwv_arena_pop(prev);
+    
+    size_t need = mgr ? wwv_arena_used(measure) + wwv_arena_overhead() : 0;
+    if (mgr) {
+        wwv_pipeline_stop(mgr);
+        manager_teardown(mgr);
+    }
+    wwv_arena_destroy(measure);
+    return need;
+}
+
+wwv_detector_manager_t *wwv_detector_manager_create_in(const wwv_detector_config_t *config,
+                                                       void *mem, size_t size) {
+    wwv_arena_t *arena = wwv_arena_create_in(mem, size);
+    if (!arena) return NULL;
+    
+    wwv_arena_t *prev = wwv_arena_push(arena);
+    wwv_detector_manager_t *mgr = wwv_detector_manager_create(config);
+    wwv_arena_pop(prev);
+    
+    /* Running out can also surface as a quiet fallback (e.g. threaded mode
+     * dropping to synchronous), so any exhaustion fails the create */
+    if (mgr && wwv_arena_exhausted(arena)) {
+        wwv_pipeline_stop(mgr);
+        manager_teardown(mgr);
+        mgr = NULL;
+    }
+    
+    if (!mgr) {
+        if (wwv_arena_exhausted(arena)) {
+            printf("[DETECTOR_MGR] Arena of %zu bytes too small (see required_size)\n", size);
+        }
+        wwv_arena_destroy(arena);
         return NULL;
     }
     
+    mgr->arena = arena;
+    
+    /* libc loads zone data on the first localtime(); do it now rather
+     * than on the first tick event */
+    time_t now = time(NULL);
+    wwv_localtime(&now);
+    
+    printf("[DETECTOR_MGR] Created in caller arena: %zu of %zu bytes used\n",
+           wwv_arena_used(arena) + wwv_arena_overhead(), size);
     return mgr;
 }
 
 void wwv_detector_manager_destroy(wwv_detector_manager_t *mgr) {
     if (!mgr) return;
     
+    /* Let workers finish queued samples before stats and teardown */
+    wwv_pipeline_stop(mgr);
+    
     /* Print final stats before cleanup */
     wwv_detector_manager_print_stats(mgr);
     
     /* Destroy all detectors */
-    wwv_detector_lifecycle_destroy_all(mgr);
+    manager_teardown(mgr);
+}
+
+/*============================================================================
+ * Stage Timing Report
+ *============================================================================*/
+
+/**
+ * One TELEM_PERF line per active stage for the interval since the last
+ * report: PERF,timestamp_ms,stage,count,mean_ns,p50_ns,p99_ns,max_ns,budget_pct
+ */
+static void report_perf(wwv_detector_manager_t *mgr) {
+    double interval_sec = (double)(mgr->detector_samples - mgr->perf_next_report +
+                                   WWV_PERF_REPORT_SAMPLES) / TICK_SAMPLE_RATE;
+    mgr->perf_next_report = mgr->detector_samples + WWV_PERF_REPORT_SAMPLES;
+    if (!telem_ctx_is_enabled(mgr->telem, TELEM_PERF)) return;
+    
+    wwv_perf_stats_t now, delta;
+    wwv_perf_get_stats(mgr->perf, &now);
+    wwv_perf_stats_delta(&now, &mgr->perf_reported, &delta);
+    mgr->perf_reported = now;
     
-    free(mgr);
+    double timestamp_ms = wwv_samples_to_ms(mgr->detector_samples, TICK_SAMPLE_RATE);
+    for (int s = 0; s < WWV_PERF_STAGE_COUNT; s++) {
+        const wwv_perf_stage_stats_t *st = &delta.stage[s];
+        if (st->count == 0) continue;
+        
+        telem_ctx_sendf(mgr->telem, TELEM_PERF, "%.1f,%s,%llu,%.0f,%llu,%llu,%llu,%.3f",
+                        timestamp_ms, wwv_perf_stage_name((wwv_perf_stage_t)s),
+                        (unsigned long long)st->count,
+                        (double)st->total_ns / (double)st->count,
+                        (unsigned long long)wwv_perf_percentile_ns(st, 0.50f),
+                        (unsigned long long)wwv_perf_percentile_ns(st, 0.99f),
+                        (unsigned long long)st->max_ns,
+                        100.0 * (double)st->total_ns / (interval_sec * 1e9));
+    }
 }
 
 /*============================================================================
  * Sample Processing
  *============================================================================*/
 
+/* The last of the caller's count samples arrived about now (SDR latency
+ * aside); read once per call, before any chunking */
+static void refclock_stamp(wwv_detector_manager_t *mgr, size_t count) {
+    if (!mgr->refclock) return;
+    mgr->refclock_host_ns = wwv_refclock_host_ns();
+    mgr->refclock_host_sample = mgr->detector_samples + count;
+}
+
+/* One sample through the carrier mixer and every detector */
+static void run_detector_sample(wwv_detector_manager_t *mgr, float i_sample, float q_sample) {
+    if (wwv_carrier_loop_begin(mgr->carrier)) {
+        const float *ci, *cq;
+        wwv_carrier_loop_mix(mgr->carrier, &i_sample, &q_sample, 1, &ci, &cq);
+        i_sample = ci[0];
+        q_sample = cq[0];
+    }
+    
+    if (mgr->baseband) {
+        baseband_frontend_process(mgr->baseband, &i_sample, &q_sample, 1);
+    } else {
+        if (mgr->tick_detector) {
+            tick_detector_process_sample(mgr->tick_detector, i_sample, q_sample);
+        }
+        
+        if (mgr->marker_detector) {
+            marker_detector_process_sample(mgr->marker_detector, i_sample, q_sample);
+        }
+    }
+    
+    if (mgr->bcd_time_detector) {
+        bcd_time_detector_process_sample(mgr->bcd_time_detector, i_sample, q_sample);
+    }
+    
+    if (mgr->bcd_freq_detector) {
+        bcd_freq_detector_process_sample(mgr->bcd_freq_detector, i_sample, q_sample);
+    }
+}
+
 void wwv_detector_manager_process_detector_sample(wwv_detector_manager_t *mgr,
                                                    float i_sample, float q_sample) {
     if (!mgr) return;
     
-    if (mgr->tick_detector) {
-        tick_detector_process_sample(mgr->tick_detector, i_sample, q_sample);
+    wwv_denormal_scope_t fp;
+    wwv_denormal_enter(&fp);
+    wwv_params_apply(mgr);
+    wwv_events_begin(mgr);
+    /* Once a tile, not on every sample */
+    if (mgr->detector_samples % WWV_DETECTOR_TILE_SAMPLES == 0) {
+        refclock_stamp(mgr, 1);
+        /* Records coalesced since the last flush go out within the age bound */
+        if (mgr->detector_samples - mgr->telem_flushed >= WWV_TELEM_FLUSH_SAMPLES) {
+            telem_ctx_flush(mgr->telem);
+            mgr->telem_flushed = mgr->detector_samples;
+        }
     }
     
-    if (mgr->marker_detector) {
-        marker_detector_process_sample(mgr->marker_detector, i_sample, q_sample);
+    /* Duty-cycled sleep: counted, not processed; stream time and the timers run on */
+    if (!wwv_duty_asleep(mgr->duty)) {
+        run_detector_sample(mgr, i_sample, q_sample);
     }
     
     mgr->detector_samples++;
+    wwv_timer_wheel_advance(mgr->timers, mgr->detector_samples);
+    wwv_events_end(mgr);
+    wwv_denormal_leave(&fp);
+}
+
+/* Each detector consumes the whole span before the next one runs.
+ * Detectors are self-contained, so ordering between them within a
+ * span does not change their results; it does order their events. */
+static void run_detector_block(wwv_detector_manager_t *mgr, const float *i_samples,
+                               const float *q_samples, size_t count) {
+    if (mgr->baseband) {
+        baseband_frontend_process(mgr->baseband, i_samples, q_samples, count);
+    } else {
+        if (mgr->tick_detector) {
+            tick_detector_process_block(mgr->tick_detector, i_samples, q_samples, count);
+        }
+        
+        if (mgr->marker_detector) {
+            marker_detector_process_block(mgr->marker_detector, i_samples, q_samples, count);
+        }
+    }
+    
+    if (mgr->bcd_time_detector) {
+        bcd_time_detector_process_block(mgr->bcd_time_detector, i_samples, q_samples, count);
+    }
+    
+    if (mgr->bcd_freq_detector) {
+        bcd_freq_detector_process_block(mgr->bcd_freq_detector, i_samples, q_samples, count);
+    }
+}
+
+_Static_assert(TICK_FFT_SIZE == WWV_DETECTOR_TILE_SAMPLES &&
+               MARKER_FFT_SIZE == WWV_DETECTOR_TILE_SAMPLES &&
+               BCD_TIME_FFT_SIZE == WWV_DETECTOR_TILE_SAMPLES &&
+               BCD_FREQ_FFT_SIZE % WWV_DETECTOR_TILE_SAMPLES == 0,
+               "a detector tile is no longer a whole number of frames");
+
+/* process_detector_block() without the refclock stamp, which the entry
+ * points take once for the caller's whole block */
+static void detector_block(wwv_detector_manager_t *mgr, const float *i_samples,
+                           const float *q_samples, size_t count) {
+    WWV_PERF_BEGIN(mgr->perf, t0);
+    WWV_TRACE_BEGIN(tr);
+    
+    /* Fades and dead bands decay filter state into subnormals */
+    wwv_denormal_scope_t fp;
+    wwv_denormal_enter(&fp);
+    
+    /* Retuning lands between blocks, never inside a detector's frame */
+    wwv_params_apply(mgr);
+    wwv_events_begin(mgr);
+    
+    /* The carrier offset steered so far holds for the whole block */
+    bool correct = wwv_carrier_loop_begin(mgr->carrier);
+    
+    /* Split the block at correlator deadlines so each timer fires once
+     * the detectors have consumed exactly up to its sample, whatever the
+     * caller's block size.
+     *
+     * With tiling, spans also end on the WWV_DETECTOR_TILE_SAMPLES grid:
+     * the tile (2 KB of I/Q) stays in L1 while every detector reads it,
+     * instead of each detector streaming the whole block and evicting the
+     * others' state. A tile completes one tick, marker and BCD time frame,
+     * so each detector runs its FFT in place and its state machine at the
+     * tile's end, and events come out in frame order (tick, marker, BCD
+     * time, BCD freq), as per-sample processing orders them, for any
+     * block size and in threaded mode alike. */
+    while (count > 0) {
+        size_t n = count;
+        bool asleep = wwv_duty_asleep(mgr->duty);
+        if (mgr->detector_tiling && !asleep) {
+            size_t to_edge = WWV_DETECTOR_TILE_SAMPLES -
+                             (size_t)(mgr->detector_samples % WWV_DETECTOR_TILE_SAMPLES);
+            if (to_edge < n) n = to_edge;
+        }
+        wwv_sample_t deadline = wwv_timer_wheel_next_deadline(mgr->timers);
+        if (deadline > mgr->detector_samples && deadline - mgr->detector_samples < n) {
+            n = (size_t)(deadline - mgr->detector_samples);
+        }
+        
+        /* Duty-cycled sleep: the span is counted up to the wake deadline, not processed */
+        if (!asleep) {
+            const float *span_i = i_samples, *span_q = q_samples;
+            if (correct) {
+                if (n > WWV_BLOCK_CHUNK_SAMPLES) n = WWV_BLOCK_CHUNK_SAMPLES;
+                wwv_carrier_loop_mix(mgr->carrier, i_samples, q_samples, n, &span_i, &span_q);
+            }
+            run_detector_block(mgr, span_i, span_q, n);
+        }
+        mgr->detector_samples += n;
+        wwv_timer_wheel_advance(mgr->timers, mgr->detector_samples);
+        
+        i_samples += n;
+        q_samples += n;
+        count -= n;
+    }
+    
+    /* Send binary telemetry records coalesced during this block */
+    WWV_PERF_BEGIN(mgr->perf, t1);
+    WWV_TRACE_BEGIN(tr1);
+    telem_ctx_flush(mgr->telem);
+    mgr->telem_flushed = mgr->detector_samples;
+    WWV_TRACE_END("telemetry", "flush", tr1,
+                  wwv_samples_to_ms(mgr->detector_samples, TICK_SAMPLE_RATE));
+    WWV_PERF_END(mgr->perf, WWV_PERF_TELEMETRY, t1);
+    
+    WWV_PERF_END(mgr->perf, WWV_PERF_DETECTOR_BLOCK, t0);
+    WWV_TRACE_END("manager", "detector_block", tr,
+                  wwv_samples_to_ms(mgr->detector_samples, TICK_SAMPLE_RATE));
+    
+    if (mgr->perf && mgr->detector_samples >= mgr->perf_next_report) {
+        report_perf(mgr);
+    }
+    
+    /* External events raised during this block go out as one batch */
+    wwv_events_end(mgr);
+    wwv_denormal_leave(&fp);
+}
+
+void wwv_detector_manager_process_detector_block(wwv_detector_manager_t *mgr,
+                                                  const float *i_samples,
+                                                  const float *q_samples,
+                                                  size_t count) {
+    if (!mgr || !i_samples || !q_samples || count == 0) return;
+    
+    refclock_stamp(mgr, count);
+    detector_block(mgr, i_samples, q_samples, count);
+}
+
+void wwv_detector_block_cpx(wwv_detector_manager_t *mgr, const kiss_fft_cpx *samples,
+                            size_t count) {
+    float i_chunk[WWV_BLOCK_CHUNK_SAMPLES];
+    float q_chunk[WWV_BLOCK_CHUNK_SAMPLES];
+    
+    wwv_events_begin(mgr);
+    while (count > 0) {
+        size_t n = (count < WWV_BLOCK_CHUNK_SAMPLES) ? count : WWV_BLOCK_CHUNK_SAMPLES;
+        for (size_t k = 0; k < n; k++) {
+            i_chunk[k] = samples[k].r;
+            q_chunk[k] = samples[k].i;
+        }
+        detector_block(mgr, i_chunk, q_chunk, n);
+        samples += n;
+        count -= n;
+    }
+    wwv_events_end(mgr);
+}
+
+void wwv_detector_manager_process_detector_block_cpx(wwv_detector_manager_t *mgr,
+                                                      const kiss_fft_cpx *samples,
+                                                      size_t count) {
+    if (!mgr || !samples || count == 0) return;
+    
+    refclock_stamp(mgr, count);
+    wwv_detector_block_cpx(mgr, samples, count);
+}
+
+void wwv_detector_manager_process_detector_block_s16(wwv_detector_manager_t *mgr,
+                                                      const int16_t *iq,
+                                                      size_t count) {
+    if (!mgr || !iq || count == 0) return;
+    
+    float i_chunk[WWV_BLOCK_CHUNK_SAMPLES];
+    float q_chunk[WWV_BLOCK_CHUNK_SAMPLES];
+    const float scale = 1.0f / 32768.0f;
+    
+    refclock_stamp(mgr, count);
+    wwv_events_begin(mgr);
+    while (count > 0) {
+        size_t n = (count < WWV_BLOCK_CHUNK_SAMPLES) ? count : WWV_BLOCK_CHUNK_SAMPLES;
+        for (size_t k = 0; k < n; k++) {
+            i_chunk[k] = (float)iq[2 * k] * scale;
+            q_chunk[k] = (float)iq[2 * k + 1] * scale;
+        }
+        detector_block(mgr, i_chunk, q_chunk, n);
+        iq += 2 * n;
+        count -= n;
+    }
+    wwv_events_end(mgr);
 }
 
 void wwv_detector_manager_process_display_sample(wwv_detector_manager_t *mgr,
                                                   float i_sample, float q_sample) {
     if (!mgr) return;
     
-    if (mgr->tone_carrier) {
-        tone_tracker_process_sample(mgr->tone_carrier, i_sample, q_sample);
+    wwv_detector_manager_process_display_block(mgr, &i_sample, &q_sample, 1);
+}
+
+void wwv_detector_manager_process_display_block(wwv_detector_manager_t *mgr,
+                                                 const float *i_samples,
+                                                 const float *q_samples,
+                                                 size_t count) {
+    if (!mgr || !i_samples || !q_samples) return;
+    
+    mgr->display_samples += count;
+    
+    /* No display-path node running: nothing to feed */
+    if (!mgr->graph.display_path) return;
+    
+#ifndef WWV_NO_DISPLAY_PATH
+    /* Duty-cycled sleep: counted like the detector path, caught up on waking */
+    uint64_t slept;
+    if (!wwv_duty_display_awake(mgr->duty, count, &slept)) return;
+    
+    WWV_PERF_BEGIN(mgr->perf, t0);
+    WWV_TRACE_BEGIN(tr);
+    wwv_denormal_scope_t fp;
+    wwv_denormal_enter(&fp);
+    wwv_events_begin(mgr);
+    tone_tracker_t *trackers[3] = { mgr->tone_carrier, mgr->tone_500, mgr->tone_600 };
+    
+    /* Getters may measure a deferred estimate from another thread */
+    wwv_mutex_lock(&mgr->route_lock);
+    if (slept > 0) {
+        tone_spectrum_skip(mgr->tone_spectrum, slept);
+        for (int t = 0; t < 3; t++) tone_tracker_skip(trackers[t], slept);
     }
-    if (mgr->tone_500) {
-        tone_tracker_process_sample(mgr->tone_500, i_sample, q_sample);
+    if (mgr->tone_spectrum) {
+        /* One window and FFT for all trackers and the slow marker */
+        tone_spectrum_process_block(mgr->tone_spectrum, i_samples, q_samples, count);
+    } else {
+        for (int t = 0; t < 3; t++) {
+            if (!trackers[t]) continue;
+            for (size_t n = 0; n < count; n++) {
+                tone_tracker_process_sample(trackers[t], i_samples[n], q_samples[n]);
+            }
+        }
     }
-    if (mgr->tone_600) {
-        tone_tracker_process_sample(mgr->tone_600, i_sample, q_sample);
+    wwv_carrier_loop_steer(mgr->carrier, mgr->tone_carrier);
+    wwv_mutex_unlock(&mgr->route_lock);
+    wwv_events_end(mgr);
+    wwv_denormal_leave(&fp);
+    WWV_PERF_END(mgr->perf, WWV_PERF_DISPLAY_BLOCK, t0);
+    WWV_TRACE_END("manager", "display_block", tr,
+                  wwv_samples_to_ms(mgr->display_samples, TONE_SAMPLE_RATE));
+#endif
+}
+
+void wwv_detector_manager_process_sdr_block(wwv_detector_manager_t *mgr,
+                                             const float *i_samples,
+                                             const float *q_samples,
+                                             size_t count) {
+    if (!mgr || !mgr->frontend) return;
+    
+    wwv_denormal_scope_t fp;
+    wwv_denormal_enter(&fp);
+    wwv_events_begin(mgr);
+    sdr_frontend_process(mgr->frontend, i_samples, q_samples, count);
+    wwv_events_end(mgr);
+    wwv_denormal_leave(&fp);
+}
+
+void wwv_detector_manager_process_sdr_block_s16(wwv_detector_manager_t *mgr,
+                                                 const int16_t *iq,
+                                                 size_t count) {
+    if (!mgr || !mgr->frontend) return;
+    
+    wwv_denormal_scope_t fp;
+    wwv_denormal_enter(&fp);
+    wwv_events_begin(mgr);
+    sdr_frontend_process_s16(mgr->frontend, iq, count);
+    wwv_events_end(mgr);
+    wwv_denormal_leave(&fp);
+}
+
+void wwv_frontend_on_detector_block(const float *i_samples, const float *q_samples,
+                                    size_t count, void *user_data) {
+    /* Synchronous unless threaded, where it lands in the detector ring */
+    wwv_detector_manager_push_detector_block((wwv_detector_manager_t *)user_data,
+                                             i_samples, q_samples, count);
+}
+
+void wwv_frontend_on_display_block(const float *i_samples, const float *q_samples,
+                                   size_t count, void *user_data) {
+    wwv_detector_manager_push_display_block((wwv_detector_manager_t *)user_data,
+                                            i_samples, q_samples, count);
+}
+
+/* Runs inside run_detector_block(), so the detectors lag the 50 kHz clock
+ * only by the front end's ~2.2 ms filter delay; timestamps are unaffected */
+void wwv_baseband_on_block(const baseband_block_t *block, void *user_data) {
+    wwv_detector_manager_t *mgr = (wwv_detector_manager_t *)user_data;
+    
+    if (mgr->tick_detector) {
+        tick_detector_process_baseband(mgr->tick_detector, block);
     }
     
-    mgr->display_samples++;
+    if (mgr->marker_detector) {
+        marker_detector_process_baseband(mgr->marker_detector, block);
+    }
 }
 
 void wwv_detector_manager_process_display_fft(wwv_detector_manager_t *mgr,
                                                const kiss_fft_cpx *fft_out,
-                                               float timestamp_ms) {
+                                               double timestamp_ms) {
     if (!mgr || !fft_out) return;
     
-    if (mgr->slow_marker) {
+#if !defined(WWV_NO_DISPLAY_PATH) && !defined(WWV_NO_SLOW_MARKER)
+    if (mgr->slow_marker && !mgr->tone_spectrum) {
+        wwv_denormal_scope_t fp;
+        wwv_denormal_enter(&fp);
+        wwv_events_begin(mgr);
         slow_marker_detector_process_fft(mgr->slow_marker, fft_out, timestamp_ms);
+        wwv_events_end(mgr);
+        wwv_denormal_leave(&fp);
     }
+#endif
 }
 
 /*============================================================================
@@ -114,6 +596,84 @@ void wwv_detector_manager_set_sync_callback(wwv_detector_manager_t *mgr,
     mgr->sync_callback_data = user_data;
 }
 
+void wwv_detector_manager_set_bcd_symbol_callback(wwv_detector_manager_t *mgr,
+                                                  bcd_corr_symbol_callback_fn cb,
+                                                  void *user_data) {
+    if (!mgr) return;
+    mgr->bcd_symbol_callback = cb;
+    mgr->bcd_symbol_callback_data = user_data;
+}
+
+/*============================================================================
+ * Warm Start
+ *============================================================================*/
+
+static double stream_ms(const wwv_detector_manager_t *mgr) {
+    return wwv_samples_to_ms(mgr->detector_samples, TICK_SAMPLE_RATE);
+}
+
+size_t wwv_detector_manager_save_state(wwv_detector_manager_t *mgr, void *buf, size_t capacity) {
+    if (!mgr || !buf) return 0;
+
+    wwv_detector_manager_flush(mgr);
+    wwv_mutex_lock(&mgr->route_lock);
+
+    wwv_state_writer_t w;
+    wwv_state_writer_init(&w, buf, capacity, stream_ms(mgr));
+    tick_detector_save_state(mgr->tick_detector, &w);
+    marker_detector_save_state(mgr->marker_detector, &w);
+    bcd_time_detector_save_state(mgr->bcd_time_detector, &w);
+    bcd_freq_detector_save_state(mgr->bcd_freq_detector, &w);
+    tick_correlator_save_state(mgr->tick_correlator, &w);
+    sync_detector_save_state(mgr->sync_detector, &w);
+    tone_tracker_save_state(mgr->tone_carrier, &w);
+    tone_tracker_save_state(mgr->tone_500, &w);
+    tone_tracker_save_state(mgr->tone_600, &w);
+#if !defined(WWV_NO_DISPLAY_PATH) && !defined(WWV_NO_SLOW_MARKER)
+    slow_marker_detector_save_state(mgr->slow_marker, &w);
+#endif
+    size_t length = wwv_state_writer_finish(&w);
+
+    wwv_mutex_unlock(&mgr->route_lock);
+
+    if (length == 0) {
+        printf("[DETECTOR_MGR] State snapshot does not fit in %zu bytes\n", capacity);
+    }
+    return length;
+}
+
+bool wwv_detector_manager_restore_state(wwv_detector_manager_t *mgr, const void *blob, size_t length) {
+    if (!mgr) return false;
+
+    wwv_detector_manager_flush(mgr);
+
+    wwv_state_reader_t r;
+    if (!wwv_state_reader_init(&r, blob, length, stream_ms(mgr))) {
+        printf("[DETECTOR_MGR] State snapshot rejected (bad header or clock)\n");
+        return false;
+    }
+
+    wwv_mutex_lock(&mgr->route_lock);
+    int restored = 0;
+    restored += tick_detector_restore_state(mgr->tick_detector, &r);
+    restored += marker_detector_restore_state(mgr->marker_detector, &r);
+    restored += bcd_time_detector_restore_state(mgr->bcd_time_detector, &r);
+    restored += bcd_freq_detector_restore_state(mgr->bcd_freq_detector, &r);
+    restored += tick_correlator_restore_state(mgr->tick_correlator, &r);
+    restored += sync_detector_restore_state(mgr->sync_detector, &r);
+    restored += tone_tracker_restore_state(mgr->tone_carrier, &r);
+    restored += tone_tracker_restore_state(mgr->tone_500, &r);
+    restored += tone_tracker_restore_state(mgr->tone_600, &r);
+#if !defined(WWV_NO_DISPLAY_PATH) && !defined(WWV_NO_SLOW_MARKER)
+    restored += slow_marker_detector_restore_state(mgr->slow_marker, &r);
+#endif
+    wwv_mutex_unlock(&mgr->route_lock);
+
+    printf("[DETECTOR_MGR] Warm start: %d of %u sections restored (snapshot %.1f s old)\n",
+           restored, (unsigned)r.section_count, r.elapsed_ms / 1000.0);
+    return restored > 0;
+}
+
 /*============================================================================
  * Status / Diagnostics
  *============================================================================*/
@@ -136,10 +696,87 @@ wwv_sync_status_t wwv_detector_manager_get_sync_status(wwv_detector_manager_t *m
     return status;
 }
 
+wwv_carrier_status_t wwv_detector_manager_get_carrier_status(wwv_detector_manager_t *mgr) {
+    wwv_carrier_status_t status;
+    wwv_carrier_loop_get_status(mgr ? mgr->carrier : NULL, &status);
+    return status;
+}
+
+wwv_duty_status_t wwv_detector_manager_get_duty_status(wwv_detector_manager_t *mgr) {
+    wwv_duty_status_t status;
+    wwv_duty_get_status(mgr ? mgr->duty : NULL, &status);
+    return status;
+}
+
 int wwv_detector_manager_get_tick_count(wwv_detector_manager_t *mgr) {
     return (mgr && mgr->tick_detector) ? tick_detector_get_tick_count(mgr->tick_detector) : 0;
 }
 
+int wwv_detector_manager_get_station_tick_count(wwv_detector_manager_t *mgr,
+                                                wwv_station_t station) {
+    return (mgr && mgr->tick_detector)
+        ? tick_detector_get_station_tick_count(mgr->tick_detector, station) : 0;
+}
+
+uint64_t wwv_detector_manager_get_tick_skipped_frames(wwv_detector_manager_t *mgr) {
+    return mgr ? tick_detector_get_skipped_frames(mgr->tick_detector) : 0;
+}
+
+bool wwv_detector_manager_get_refclock_stamp(wwv_detector_manager_t *mgr, int64_t *host_ns,
+                                             uint64_t *sample) {
+    if (!mgr || !mgr->refclock || mgr->refclock_host_sample == 0) return false;
+    if (host_ns) *host_ns = mgr->refclock_host_ns;
+    if (sample) *sample = mgr->refclock_host_sample;
+    return true;
+}
+
+bool wwv_detector_manager_get_bcd_time(wwv_detector_manager_t *mgr, bcd_time_solution_t *out) {
+    return mgr && bcd_time_solver_get_solution(mgr->bcd_time_solver, out);
+}
+
+bool wwv_detector_manager_get_bcd_integrated(wwv_detector_manager_t *mgr, bcd_integrated_frame_t *out) {
+    return mgr && bcd_correlator_get_integrated_frame(mgr->bcd_correlator, out);
+}
+
+bool wwv_detector_manager_get_tone(wwv_detector_manager_t *mgr, float nominal_hz,
+                                   tone_measurement_t *out) {
+#ifndef WWV_NO_DISPLAY_PATH
+    if (!mgr) return false;
+    
+    tone_tracker_t *tt = (nominal_hz == 500.0f) ? mgr->tone_500 :
+                         (nominal_hz == 600.0f) ? mgr->tone_600 :
+                         (nominal_hz == 0.0f)   ? mgr->tone_carrier : NULL;
+    if (!tt) return false;
+    
+    /* A deferred estimate runs here, against the display worker's samples */
+    wwv_mutex_lock(&mgr->route_lock);
+    bool ok = tone_tracker_get_measurement(tt, out);
+    wwv_mutex_unlock(&mgr->route_lock);
+    return ok;
+#else
+    return false;
+#endif
+}
+
+bool wwv_detector_manager_get_channel_quality(wwv_detector_manager_t *mgr,
+                                              channel_quality_report_t *out) {
+#ifndef WWV_NO_DISPLAY_PATH
+    if (!mgr || !mgr->channel_quality) return false;
+    
+    wwv_mutex_lock(&mgr->route_lock);
+    bool ok = channel_quality_get(mgr->channel_quality, out);
+    wwv_mutex_unlock(&mgr->route_lock);
+    return ok;
+#else
+    (void)out;
+    return false;
+#endif
+}
+
+const wwv_history_t *wwv_detector_manager_get_history(wwv_detector_manager_t *mgr) {
+    return mgr ? mgr->history : NULL;
+}
+
 int wwv_detector_manager_get_marker_count(wwv_detector_manager_t *mgr) {
     return (mgr && mgr->marker_detector) ? marker_detector_get_marker_count(mgr->marker_detector) : 0;
 }
@@ -189,6 +826,24 @@ void wwv_detector_manager_print_stats(wwv_detector_manager_t *mgr) {
     printf("Samples processed: detector=%llu display=%llu\n",
            (unsigned long long)mgr->detector_samples,
            (unsigned long long)mgr->display_samples);
+    if (mgr->tone_spectrum) {
+        printf("Display spectrum: %llu shared FFTs\n",
+               (unsigned long long)tone_spectrum_get_fft_count(mgr->tone_spectrum));
+    }
+    if (mgr->carrier) {
+        wwv_carrier_status_t cs;
+        wwv_carrier_loop_get_status(mgr->carrier, &cs);
+        printf("Carrier correction: %s %+.3f Hz (%u estimates, %u out of range)\n",
+               cs.active ? "correcting" : "not locked", cs.offset_hz, cs.estimates, cs.rejected);
+    }
+    if (mgr->duty) {
+        wwv_duty_status_t ds;
+        wwv_duty_get_status(mgr->duty, &ds);
+        printf("Duty cycling: %u sleeps, %u verified, %u widened, %u reacquired, %.1f%% awake\n",
+               ds.sleeps, ds.verified, ds.widened, ds.reacquired, ds.awake_fraction * 100.0f);
+    }
+    channel_quality_print_stats(mgr->channel_quality);
+    wwv_pipeline_print_rt(mgr);
     printf("\n");
     
     if (mgr->tick_detector) {
@@ -199,7 +854,52 @@ void wwv_detector_manager_print_stats(wwv_detector_manager_t *mgr) {
         marker_detector_print_stats(mgr->marker_detector);
     }
     
-    /* NOTE: sync_detector doesn't have print_stats yet */
+    if (mgr->bcd_time_detector) {
+        bcd_time_detector_print_stats(mgr->bcd_time_detector);
+    }
+    
+    if (mgr->bcd_freq_detector) {
+        bcd_freq_detector_print_stats(mgr->bcd_freq_detector);
+    }
+    
+    if (mgr->bcd_correlator) {
+        bcd_correlator_print_stats(mgr->bcd_correlator);
+    }
+    
+    if (mgr->bcd_time_solver) {
+        bcd_time_solver_print_stats(mgr->bcd_time_solver);
+    }
+    
+    if (mgr->bcd_path) {
+        bcd_path_policy_print_stats(mgr->bcd_path);
+    }
+    
+    if (mgr->sync_detector) {
+        sync_detector_print_stats(mgr->sync_detector);
+    }
+    
+    wwv_history_print_stats(mgr->history);
+    
+    if (mgr->refclock) {
+        printf("Refclock: %llu seconds published, %llu failed\n",
+               (unsigned long long)wwv_refclock_get_published(mgr->refclock),
+               (unsigned long long)wwv_refclock_get_failed(mgr->refclock));
+    }
+    
+    if (mgr->perf) {
+        wwv_perf_stats_t perf;
+        wwv_perf_get_stats(mgr->perf, &perf);
+        wwv_perf_print(&perf, (double)mgr->detector_samples / TICK_SAMPLE_RATE);
+    }
     
     printf("================================================================================\n");
 }
+
+void wwv_detector_manager_get_perf(wwv_detector_manager_t *mgr, wwv_perf_stats_t *stats) {
+    wwv_perf_get_stats(mgr ? mgr->perf : NULL, stats);
+}
+
+void wwv_detector_manager_reset_perf(wwv_detector_manager_t *mgr) {
+    if (!mgr) return;
+    wwv_perf_reset(mgr->perf);
+}
@@ -0,0 +1,318 @@
+/**
+ * @file wwv_multi_manager.c
+ * @brief Multi-receiver engine: per-channel managers on a worker pool
+ *
+ * See wwv_multi_manager.h for the sharing and threading model.
+ *
+ * Worker w owns channels w, w+T, w+2T, ... (T = worker count). A job is
+ * published under the pool lock with a new generation number; each worker
+ * runs it for its channels and decrements `pending`. The caller waits for
+ * pending == 0, so blocks are never still in use when process_*() returns.
+ */
+
+#include "wwv_multi_manager.h"
+#include "wwv_thread.h"
+#include "wwv_arena.h"
+#include "wwv_trace.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/*============================================================================
+ * Internal State
+ *============================================================================*/
+
+typedef enum {
+    JOB_DETECTOR_BLOCK,
+    JOB_DISPLAY_BLOCK
+} job_type_t;
+
+typedef struct {
+    job_type_t type;
+    const float *const *i_blocks;
+    const float *const *q_blocks;
+    size_t count;
+} job_t;
+
+typedef struct {
+    struct wwv_multi_manager *owner;
+    int channel;
+    wwv_detector_manager_t *mgr;
+} channel_t;
+
+typedef struct {
+    struct wwv_multi_manager *owner;
+    int index;
+    wwv_thread_t thread;
+    bool started;
+} worker_t;
+
+struct wwv_multi_manager {
+    int channel_count;
+    channel_t channels[WWV_MULTI_MAX_CHANNELS];
+
+    /* Worker pool */
+    int worker_count;
+    worker_t workers[WWV_MULTI_MAX_CHANNELS];
+    wwv_mutex_t pool_lock;
+    wwv_cond_t job_ready;
+    wwv_cond_t job_done;
+    job_t job;
+    unsigned generation;
+    int pending;
+    bool shutdown;
+
+    /* External callbacks (serialized by callback_lock) */
+    wwv_mutex_t callback_lock;
+    wwv_multi_tick_callback_fn tick_callback;
+    void *tick_callback_data;
+    wwv_multi_marker_callback_fn marker_callback;
+    void *marker_callback_data;
+    wwv_multi_sync_callback_fn sync_callback;
+    void *sync_callback_data;
+};
+
+/*============================================================================
+ * Channel Callback Trampolines
+ *============================================================================*/
+
+static void on_channel_tick(const wwv_tick_event_t *event, void *user_data) {
+    channel_t *ch = (channel_t *)user_data;
+    wwv_multi_manager_t *mm = ch->owner;
+
+    wwv_mutex_lock(&mm->callback_lock);
+    if (mm->tick_callback) mm->tick_callback(ch->channel, event, mm->tick_callback_data);
+    wwv_mutex_unlock(&mm->callback_lock);
+}
+
+static void on_channel_marker(const wwv_marker_event_t *event, void *user_data) {
+    channel_t *ch = (channel_t *)user_data;
+    wwv_multi_manager_t *mm = ch->owner;
+
+    wwv_mutex_lock(&mm->callback_lock);
+    if (mm->marker_callback) mm->marker_callback(ch->channel, event, mm->marker_callback_data);
+    wwv_mutex_unlock(&mm->callback_lock);
+}
+
+static void on_channel_sync(const wwv_sync_status_t *status, void *user_data) {
+    channel_t *ch = (channel_t *)user_data;
+    wwv_multi_manager_t *mm = ch->owner;
+
+    wwv_mutex_lock(&mm->callback_lock);
+    if (mm->sync_callback) mm->sync_callback(ch->channel, status, mm->sync_callback_data);
+    wwv_mutex_unlock(&mm->callback_lock);
+}
+
+/*============================================================================
+ * Worker Pool
+ *============================================================================*/
+
+static void run_job(wwv_multi_manager_t *mm, const job_t *job, int first, int stride) {
+    for (int c = first; c < mm->channel_count; c += stride) {
+        const float *i_blk = job->i_blocks[c];
+        const float *q_blk = job->q_blocks[c];
+        if (!i_blk || !q_blk) continue;
+
+        if (job->type == JOB_DETECTOR_BLOCK) {
+            wwv_detector_manager_process_detector_block(mm->channels[c].mgr, i_blk, q_blk, job->count);
+        } else {
+            wwv_detector_manager_process_display_block(mm->channels[c].mgr, i_blk, q_blk, job->count);
+        }
+    }
+}
+
+static void worker_main(void *arg) {
+    worker_t *w = (worker_t *)arg;
+    wwv_multi_manager_t *mm = w->owner;
+    unsigned seen = 0;
+    WWV_TRACE_THREAD("multi_worker");
+
+    for (;;) {
+        wwv_mutex_lock(&mm->pool_lock);
+        while (!mm->shutdown && mm->generation == seen) {
+            wwv_cond_wait(&mm->job_ready, &mm->pool_lock);
+        }
+        if (mm->shutdown) {
+            wwv_mutex_unlock(&mm->pool_lock);
+            return;
+        }
+        seen = mm->generation;
+        job_t job = mm->job;
+        wwv_mutex_unlock(&mm->pool_lock);
+
+        run_job(mm, &job, w->index, mm->worker_count);
+
+        wwv_mutex_lock(&mm->pool_lock);
+        if (--mm->pending == 0) wwv_cond_signal(&mm->job_done);
+        wwv_mutex_unlock(&mm->pool_lock);
+    }
+}
+
+static void dispatch(wwv_multi_manager_t *mm, job_type_t type,
+                     const float *const *i_blocks, const float *const *q_blocks,
+                     size_t count) {
+    job_t job = { type, i_blocks, q_blocks, count };
+
+    /* Single worker: no hand-off needed */
+    if (mm->worker_count <= 1) {
+        run_job(mm, &job, 0, 1);
+        return;
+    }
+
+    wwv_mutex_lock(&mm->pool_lock);
+    mm->job = job;
+    mm->pending = mm->worker_count;
+    mm->generation++;
+    wwv_cond_broadcast(&mm->job_ready);
+    while (mm->pending > 0) {
+        wwv_cond_wait(&mm->job_done, &mm->pool_lock);
+    }
+    wwv_mutex_unlock(&mm->pool_lock);
+}
+
+/*============================================================================
+ * Lifecycle
+ *============================================================================*/
+
+wwv_multi_manager_t *wwv_multi_manager_create(const wwv_multi_config_t *config) {
+    if (!config || config->channel_count < 1 ||
+        config->channel_count > WWV_MULTI_MAX_CHANNELS) {
+        return NULL;
+    }
+
+    wwv_multi_manager_t *mm = wwv_calloc(1, sizeof(*mm));
+    if (!mm) return NULL;
+
+    wwv_mutex_init(&mm->pool_lock);
+    wwv_mutex_init(&mm->callback_lock);
+    wwv_cond_init(&mm->job_ready);
+    wwv_cond_init(&mm->job_done);
+
+    /* Channels are created serially; shared FFT plans and templates are
+     * built by the first channel and reused by the rest */
+    mm->channel_count = config->channel_count;
+    for (int c = 0; c < mm->channel_count; c++) {
+        channel_t *ch = &mm->channels[c];
+        ch->owner = mm;
+        ch->channel = c;
+        ch->mgr = wwv_detector_manager_create(&config->channels[c]);
+        if (!ch->mgr) {
+            wwv_multi_manager_destroy(mm);
+            return NULL;
+        }
+        wwv_detector_manager_set_tick_callback(ch->mgr, on_channel_tick, ch);
+        wwv_detector_manager_set_marker_callback(ch->mgr, on_channel_marker, ch);
+        wwv_detector_manager_set_sync_callback(ch->mgr, on_channel_sync, ch);
+    }
+
+    int workers = config->worker_threads > 0 ? config->worker_threads : wwv_cpu_count();
+    if (workers > mm->channel_count) workers = mm->channel_count;
+    mm->worker_count = workers;
+
+    if (workers > 1) {
+        for (int w = 0; w < workers; w++) {
+            mm->workers[w].owner = mm;
+            mm->workers[w].index = w;
+            if (!wwv_thread_create(&mm->workers[w].thread, worker_main, &mm->workers[w])) {
+                wwv_multi_manager_destroy(mm);
+                return NULL;
+            }
+            mm->workers[w].started = true;
+        }
+    }
+
+    printf("[MULTI_MGR] Created: %d channels on %d worker%s\n",
+           mm->channel_count, mm->worker_count, mm->worker_count == 1 ? "" : "s");
+
+    return mm;
+}
+
+void wwv_multi_manager_destroy(wwv_multi_manager_t *mm) {
+    if (!mm) return;
+
+    wwv_mutex_lock(&mm->pool_lock);
+    mm->shutdown = true;
+    wwv_cond_broadcast(&mm->job_ready);
+    wwv_mutex_unlock(&mm->pool_lock);
+
+    for (int w = 0; w < WWV_MULTI_MAX_CHANNELS; w++) {
+        if (mm->workers[w].started) wwv_thread_join(mm->workers[w].thread);
+    }
+
+    for (int c = 0; c < mm->channel_count; c++) {
+        if (mm->channels[c].mgr) {
+            printf("[MULTI_MGR] Channel %d:\n", c);
+            wwv_detector_manager_destroy(mm->channels[c].mgr);
+        }
+    }
+
+    wwv_cond_destroy(&mm->job_done);
+    wwv_cond_destroy(&mm->job_ready);
+    wwv_mutex_destroy(&mm->callback_lock);
+    wwv_mutex_destroy(&mm->pool_lock);
+    wwv_free(mm);
+}
+
+/*============================================================================
+ * Sample Processing
+ *============================================================================*/
+
+void wwv_multi_manager_process_detector_blocks(wwv_multi_manager_t *mm,
+                                               const float *const *i_blocks,
+                                               const float *const *q_blocks,
+                                               size_t count) {
+    if (!mm || !i_blocks || !q_blocks || count == 0) return;
+    dispatch(mm, JOB_DETECTOR_BLOCK, i_blocks, q_blocks, count);
+}
+
+void wwv_multi_manager_process_display_blocks(wwv_multi_manager_t *mm,
+                                              const float *const *i_blocks,
+                                              const float *const *q_blocks,
+                                              size_t count) {
+    if (!mm || !i_blocks || !q_blocks || count == 0) return;
+    dispatch(mm, JOB_DISPLAY_BLOCK, i_blocks, q_blocks, count);
+}
+
+/*============================================================================
+ * Callbacks / Access
+ *============================================================================*/
+
+void wwv_multi_manager_set_tick_callback(wwv_multi_manager_t *mm,
+                                         wwv_multi_tick_callback_fn cb, void *user_data) {
+    if (!mm) return;
+    wwv_mutex_lock(&mm->callback_lock);
+    mm->tick_callback = cb;
+    mm->tick_callback_data = user_data;
+    wwv_mutex_unlock(&mm->callback_lock);
+}
+
+void wwv_multi_manager_set_marker_callback(wwv_multi_manager_t *mm,
+                                           wwv_multi_marker_callback_fn cb, void *user_data) {
+    if (!mm) return;
+    wwv_mutex_lock(&mm->callback_lock);
+    mm->marker_callback = cb;
+    mm->marker_callback_data = user_data;
+    wwv_mutex_unlock(&mm->callback_lock);
+}
+
+void wwv_multi_manager_set_sync_callback(wwv_multi_manager_t *mm,
+                                         wwv_multi_sync_callback_fn cb, void *user_data) {
+    if (!mm) return;
+    wwv_mutex_lock(&mm->callback_lock);
+    mm->sync_callback = cb;
+    mm->sync_callback_data = user_data;
+    wwv_mutex_unlock(&mm->callback_lock);
+}
+
+int wwv_multi_manager_get_channel_count(wwv_multi_manager_t *mm) {
+    return mm ? mm->channel_count : 0;
+}
+
+int wwv_multi_manager_get_worker_count(wwv_multi_manager_t *mm) {
+    return mm ? mm->worker_count : 0;
+}
+
+wwv_detector_manager_t *wwv_multi_manager_get_channel(wwv_multi_manager_t *mm, int channel) {
+    if (!mm || channel < 0 || channel >= mm->channel_count) return NULL;
+    return mm->channels[channel].mgr;
+}
@@ -0,0 +1,370 @@
+/**
+ * @file wwv_replay.c
+ * @brief Faster-than-real-time replay of IQ recordings through the detectors
+ *
+ * See wwv_replay.h for the segmentation model. Workers take the next
+ * unclaimed segment from an atomic counter; each segment owns a manager,
+ * block buffers and (at 50 kHz) a display-path resampler, and appends its
+ * kept events to its own vector. Segments are merged in index order once
+ * every worker has been joined, so no locking is needed on the events.
+ */
+
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE     /* clock_gettime(CLOCK_MONOTONIC) under -std=c11 */
+#endif
+
+#include "wwv_replay.h"
+#include "polyphase_resampler.h"
+#include "wwv_thread.h"
+#include "wwv_timebase.h"
+#include "wwv_arena.h"
+#include "wwv_trace.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#define REPLAY_DETECTOR_RATE    50000
+#define REPLAY_SDR_RATE         2000000
+#define REPLAY_MAX_BLOCK        (1u << 20)
+
+/* Segment grid in detector samples: a common multiple of every frame hop on
+ * both paths (256 / 2048 at 50 kHz, 1024 / 4096 at 12 kHz) and of the 6/25
+ * and 40:1 resampling ratios, i.e. 1.024 sec */
+#define REPLAY_GRID_SAMPLES     51200
+
+/* 50 kHz -> 12 kHz display path, as stage 3 of sdr_frontend */
+#define REPLAY_DISPLAY_INTERP   6
+#define REPLAY_DISPLAY_DECIM    25
+#define REPLAY_DISPLAY_TAPS     128
+#define REPLAY_DISPLAY_CUTOFF   6000.0f
+
+/*============================================================================
+ * Internal State
+ *============================================================================*/
+
+typedef struct replay_job replay_job_t;
+
+typedef struct {
+    replay_job_t *job;
+    int index;
+
+    /* Input samples, absolute in the recording */
+    uint64_t run_start;         /* First sample fed (lead-in included) */
+    uint64_t keep_start;        /* Own span [keep_start, keep_end) */
+    uint64_t keep_end;
+    uint64_t run_end;           /* Last sample fed + 1 (tail included) */
+
+    /* Same positions at the 50 kHz detector rate */
+    uint64_t base50;
+    uint64_t keep_start50;
+    uint64_t keep_end50;
+
+    wwv_replay_event_t *events;
+    size_t event_count;
+    size_t event_capacity;
+
+    wwv_sync_status_t final_sync;
+    bool ok;
+} replay_segment_t;
+
+struct replay_job {
+    const wwv_iq_file_t *file;
+    const wwv_replay_config_t *config;
+    uint32_t rate;
+    size_t block;
+    int segment_count;
+    replay_segment_t *segments;
+    atomic_int next_segment;
+
+    /* Sequential mode hands events straight to the caller */
+    bool direct;
+    wwv_replay_event_fn on_event;
+    void *user_data;
+    int ticks;
+    int markers;
+};
+
+static double now_sec(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+/*============================================================================
+ * Event Collection
+ *============================================================================*/
+
+static void deliver(replay_job_t *job, wwv_replay_event_t *ev) {
+    if (ev->type == WWV_REPLAY_EVENT_TICK) {
+        ev->tick.tick_number = ++job->ticks;
+    } else {
+        ev->marker.marker_number = ++job->markers;
+    }
+    if (job->on_event) job->on_event(ev, job->user_data);
+}
+
+static void keep_event(replay_segment_t *seg, wwv_replay_event_t *ev, uint64_t index50) {
+    if (index50 < seg->keep_start50 || index50 >= seg->keep_end50) return;
+
+    if (seg->job->direct) {
+        deliver(seg->job, ev);
+        return;
+    }
+
+    if (seg->event_count == seg->event_capacity) {
+        size_t cap = seg->event_capacity ? seg->event_capacity * 2 : 256;
+        wwv_replay_event_t *grown = realloc(seg->events, cap * sizeof(*grown));
+        if (!grown) {
+            seg->ok = false;
+            return;
+        }
+        seg->events = grown;
+        seg->event_capacity = cap;
+    }
+    seg->events[seg->event_count++] = *ev;
+}
+
+static void on_segment_tick(const wwv_tick_event_t *event, void *user_data) {
+    replay_segment_t *seg = (replay_segment_t *)user_data;
+    wwv_replay_event_t ev = { .type = WWV_REPLAY_EVENT_TICK, .segment = seg->index };
+
+    ev.tick = *event;
+    ev.tick.sample_index += seg->base50;
+    ev.tick.timestamp_ms += wwv_samples_to_ms(seg->base50, REPLAY_DETECTOR_RATE);
+    keep_event(seg, &ev, ev.tick.sample_index);
+}
+
+static void on_segment_marker(const wwv_marker_event_t *event, void *user_data) {
+    replay_segment_t *seg = (replay_segment_t *)user_data;
+    wwv_replay_event_t ev = { .type = WWV_REPLAY_EVENT_MARKER, .segment = seg->index };
+
+    ev.marker = *event;
+    ev.marker.sample_index += seg->base50;
+    ev.marker.timestamp_ms += wwv_samples_to_ms(seg->base50, REPLAY_DETECTOR_RATE);
+    keep_event(seg, &ev, ev.marker.sample_index);
+}
+
+/*============================================================================
+ * Segment Processing
+ *============================================================================*/
+
+static bool run_segment(replay_segment_t *seg) {
+    replay_job_t *job = seg->job;
+    bool sdr = job->rate == REPLAY_SDR_RATE;
+
+    wwv_detector_config_t cfg = job->config->detector;
+    cfg.threaded = false;
+    cfg.enable_sdr_frontend = sdr;
+    if (job->segment_count > 1) cfg.output_dir = NULL;
+
+    wwv_detector_manager_t *mgr = wwv_detector_manager_create(&cfg);
+    polyphase_resampler_t *display = NULL;
+    size_t display_max = 0;
+    if (mgr && !sdr) {
+        display = polyphase_resampler_create(REPLAY_DISPLAY_INTERP, REPLAY_DISPLAY_DECIM,
+                                             REPLAY_DISPLAY_TAPS, REPLAY_DETECTOR_RATE,
+                                             REPLAY_DISPLAY_CUTOFF);
+        if (display) display_max = polyphase_resampler_max_output(display, job->block);
+    }
+
+    float *in_i = wwv_malloc(job->block * sizeof(float));
+    float *in_q = wwv_malloc(job->block * sizeof(float));
+    float *disp_i = display ? wwv_malloc(display_max * sizeof(float)) : NULL;
+    float *disp_q = display ? wwv_malloc(display_max * sizeof(float)) : NULL;
+
+    bool ok = mgr && in_i && in_q && (sdr || (display && disp_i && disp_q));
+    if (ok) {
+        wwv_detector_manager_set_tick_callback(mgr, on_segment_tick, seg);
+        wwv_detector_manager_set_marker_callback(mgr, on_segment_marker, seg);
+
+        seg->ok = true;
+        for (uint64_t pos = seg->run_start; pos < seg->run_end && seg->ok; ) {
+            size_t want = seg->run_end - pos < job->block ? (size_t)(seg->run_end - pos) : job->block;
+            size_t got = wwv_iq_file_read(job->file, pos, want, in_i, in_q);
+            if (got == 0) break;
+
+            if (sdr) {
+                wwv_detector_manager_process_sdr_block(mgr, in_i, in_q, got);
+            } else {
+                wwv_detector_manager_process_detector_block(mgr, in_i, in_q, got);
+                size_t n = polyphase_resampler_process(display, in_i, in_q, got, disp_i, disp_q);
+                wwv_detector_manager_process_display_block(mgr, disp_i, disp_q, n);
+            }
+            pos += got;
+        }
+        seg->final_sync = wwv_detector_manager_get_sync_status(mgr);
+        ok = seg->ok;
+    } else {
+        printf("[REPLAY] Segment %d: failed to create detector manager\n", seg->index);
+    }
+
+    wwv_free(disp_q);
+    wwv_free(disp_i);
+    wwv_free(in_q);
+    wwv_free(in_i);
+    polyphase_resampler_destroy(display);
+    wwv_detector_manager_destroy(mgr);
+    seg->ok = ok;
+    return ok;
+}
+
+static void replay_worker(void *arg) {
+    replay_job_t *job = (replay_job_t *)arg;
+    WWV_TRACE_THREAD("replay_worker");
+
+    for (;;) {
+        int s = atomic_fetch_add_explicit(&job->next_segment, 1, memory_order_relaxed);
+        if (s >= job->segment_count) break;
+        run_segment(&job->segments[s]);
+    }
+}
+
+/*============================================================================
+ * Replay
+ *============================================================================*/
+
+bool wwv_replay_run(const wwv_iq_file_t *file, const wwv_replay_config_t *config,
+                    wwv_replay_event_fn on_event, void *user_data,
+                    wwv_replay_stats_t *stats) {
+    if (!file || !config) return false;
+
+    const wwv_iq_info_t *info = wwv_iq_file_info(file);
+    uint32_t rate = info->sample_rate;
+    if (rate != REPLAY_DETECTOR_RATE && rate != REPLAY_SDR_RATE) {
+        printf("[REPLAY] Unsupported sample rate %u Hz (need %u or %u)\n",
+               rate, REPLAY_DETECTOR_RATE, REPLAY_SDR_RATE);
+        return false;
+    }
+
+    /* Segment boundaries fall on the frame grid, so a segment's detectors
+     * frame the signal exactly as a sequential run would */
+    uint64_t align = (uint64_t)REPLAY_GRID_SAMPLES * (rate / REPLAY_DETECTOR_RATE);
+    uint64_t start = (uint64_t)(config->start_sec > 0 ? config->start_sec * rate : 0);
+    uint64_t end = info->sample_count;
+    if (config->duration_sec > 0) {
+        uint64_t span = (uint64_t)(config->duration_sec * rate);
+        if (start + span < end) end = start + span;
+    }
+    if (start >= end) {
+        printf("[REPLAY] Empty replay span\n");
+        return false;
+    }
+
+    int workers = config->worker_threads > 0 ? config->worker_threads : wwv_cpu_count();
+    if (workers < 1) workers = 1;
+    int segments = config->segments > 0 ? config->segments : workers;
+    if (segments > WWV_REPLAY_MAX_SEGMENTS) segments = WWV_REPLAY_MAX_SEGMENTS;
+    uint64_t max_segments = (end - start) / align;
+    if ((uint64_t)segments > max_segments) segments = max_segments > 0 ? (int)max_segments : 1;
+    if (workers > segments) workers = segments;
+
+    replay_job_t job = {
+        .file = file,
+        .config = config,
+        .rate = rate,
+        .block = config->block_samples ? config->block_samples : rate,
+        .segment_count = segments,
+        .direct = segments == 1,
+        .on_event = on_event,
+        .user_data = user_data
+    };
+    if (job.block > REPLAY_MAX_BLOCK) job.block = REPLAY_MAX_BLOCK;
+    atomic_init(&job.next_segment, 0);
+
+    job.segments = wwv_calloc((size_t)segments, sizeof(replay_segment_t));
+    if (!job.segments) return false;
+
+    /* Lead-in and tail round up to the grid */
+    uint64_t overlap = (uint64_t)(config->overlap_sec > 0 ? config->overlap_sec * rate : 0);
+    uint64_t tail = (uint64_t)(WWV_REPLAY_TAIL_SEC * rate);
+    overlap = (overlap + align - 1) / align * align;
+    tail = (tail + align - 1) / align * align;
+    uint64_t span = end - start;
+    uint64_t input_samples = 0;
+
+    for (int s = 0; s < segments; s++) {
+        replay_segment_t *seg = &job.segments[s];
+        seg->job = &job;
+        seg->index = s;
+        seg->keep_start = start + span * (uint64_t)s / (uint64_t)segments / align * align;
+        seg->keep_end = s + 1 < segments
+                      ? start + span * (uint64_t)(s + 1) / (uint64_t)segments / align * align
+                      : end;
+        seg->run_start = s > 0 && seg->keep_start - start > overlap ? seg->keep_start - overlap : start;
+        seg->run_end = s + 1 < segments && end - seg->keep_end > tail ? seg->keep_end + tail : end;
+
+        seg->base50 = wwv_samples_rescale(seg->run_start, rate, REPLAY_DETECTOR_RATE);
+        seg->keep_start50 = s > 0 ? wwv_samples_rescale(seg->keep_start, rate, REPLAY_DETECTOR_RATE) : 0;
+        seg->keep_end50 = s + 1 < segments
+                        ? wwv_samples_rescale(seg->keep_end, rate, REPLAY_DETECTOR_RATE)
+                        : UINT64_MAX;
+        input_samples += seg->run_end - seg->run_start;
+    }
+
+    printf("[REPLAY] %.1f sec at %u Hz: %d segment%s on %d worker%s, %.0f sec lead-in\n",
+           (double)span / rate, rate, segments, segments == 1 ? "" : "s",
+           workers, workers == 1 ? "" : "s",
+           segments > 1 ? (double)overlap / rate : 0.0);
+
+    double t0 = now_sec();
+
+    bool ok = true;
+    if (workers == 1) {
+        replay_worker(&job);
+    } else {
+        wwv_thread_t threads[WWV_REPLAY_MAX_SEGMENTS];
+        int started = 0;
+        for (int w = 0; w < workers; w++) {
+            if (!wwv_thread_create(&threads[w], replay_worker, &job)) {
+                printf("[REPLAY] Failed to start worker %d\n", w);
+                ok = false;
+                break;
+            }
+            started++;
+        }
+        /* Workers already running drain the remaining segments */
+        if (started == 0) replay_worker(&job);
+        for (int w = 0; w < started; w++) wwv_thread_join(threads[w]);
+    }
+
+    double wall = now_sec() - t0;
+
+    for (int s = 0; s < segments; s++) {
+        replay_segment_t *seg = &job.segments[s];
+        if (!seg->ok) ok = false;
+        for (size_t e = 0; e < seg->event_count; e++) deliver(&job, &seg->events[e]);
+        free(seg->events);
+    }
+
+    if (stats) {
+        memset(stats, 0, sizeof(*stats));
+        stats->input_samples = input_samples;
+        stats->signal_sec = (double)span / rate;
+        stats->wall_sec = wall;
+        stats->realtime_factor = wall > 0 ? stats->signal_sec / wall : 0;
+        stats->segments = segments;
+        stats->workers = workers;
+        stats->ticks = job.ticks;
+        stats->markers = job.markers;
+        stats->final_sync = job.segments[segments - 1].final_sync;
+    }
+
+    printf("[REPLAY] %d ticks, %d markers in %.2f sec wall (%.1fx real time)\n",
+           job.ticks, job.markers, wall, wall > 0 ? (double)span / rate / wall : 0.0);
+
+    wwv_free(job.segments);
+    return ok;
+}
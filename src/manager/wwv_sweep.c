@@ -0,0 +1,629 @@
+/**
+ * @file wwv_sweep.c
+ * @brief Parallel parameter sweep over one recorded capture
+ *
+ * See wwv_sweep.h for the sharing and scoring model.
+ *
+ * Two chunk buffers alternate: while the pool runs every instance over
+ * chunk A, the driver reads and decimates chunk B. A chunk is published
+ * under the pool lock with a new generation number, as in
+ * wwv_multi_manager; each worker decrements `pending` when its instances
+ * are done and the driver waits for zero before reusing the buffer.
+ */
+
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE     /* clock_gettime(CLOCK_MONOTONIC) under -std=c11 */
+#endif
+
+#include "wwv_sweep.h"
+#include "sdr_frontend.h"
+#include "polyphase_resampler.h"
+#include "wwv_thread.h"
+#include "wwv_arena.h"
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#define SWEEP_DETECTOR_RATE     50000
+#define SWEEP_DISPLAY_RATE      12000
+#define SWEEP_SDR_RATE          2000000
+#define SWEEP_CHUNK_SEC         10          /* Signal per published chunk */
+#define SWEEP_READ_SAMPLES      200000      /* Input samples per file read */
+#define SWEEP_FEED_SAMPLES      SWEEP_DETECTOR_RATE  /* Detector samples per manager call */
+#define SWEEP_CHUNK_MARGIN      4096        /* Resampler output slack per chunk */
+
+/* 50 kHz -> 12 kHz display path, as stage 3 of sdr_frontend */
+#define SWEEP_DISPLAY_INTERP    6
+#define SWEEP_DISPLAY_DECIM     25
+#define SWEEP_DISPLAY_TAPS      128
+#define SWEEP_DISPLAY_CUTOFF    6000.0f
+
+#define SWEEP_TICK_PERIOD_MS    1000.0
+#define SWEEP_MARKER_PERIOD_MS  60000.0
+#define SWEEP_TICK_BIN_MS       1.0
+#define SWEEP_MARKER_BIN_MS     10.0
+#define SWEEP_TICKS_PER_MINUTE  57          /* No tick at :00 (marker), :29, :59 */
+
+/*============================================================================
+ * Internal State
+ *============================================================================*/
+
+typedef struct {
+    float *det_i, *det_q;
+    float *disp_i, *disp_q;
+    size_t det_n, disp_n;
+    size_t det_cap, disp_cap;
+} sweep_chunk_t;
+
+typedef struct {
+    const wwv_iq_file_t *file;
+    uint32_t rate;
+    uint64_t pos, end;
+    sdr_frontend_t *frontend;       /* 2 MHz input */
+    polyphase_resampler_t *display; /* 50 kHz input */
+    float *in_i, *in_q;
+    sweep_chunk_t *target;          /* Chunk the sinks append to */
+} sweep_source_t;
+
+typedef struct {
+    double *ms;
+    size_t count, capacity;
+} sweep_times_t;
+
+typedef struct {
+    wwv_detector_manager_t *mgr;
+    double offset_ms;               /* Span start within the recording */
+    sweep_times_t ticks;
+    sweep_times_t markers;
+    double last_event_ms;
+    double lock_ms;
+    bool oom;
+} sweep_instance_t;
+
+typedef struct sweep_pool sweep_pool_t;
+
+typedef struct {
+    sweep_pool_t *pool;
+    int index;
+    wwv_thread_t thread;
+    bool started;
+} sweep_worker_t;
+
+struct sweep_pool {
+    sweep_instance_t *instances;
+    int instance_count;
+    sweep_worker_t *workers;
+    int worker_count;
+
+    wwv_mutex_t lock;
+    wwv_cond_t job_ready;
+    wwv_cond_t job_done;
+    const sweep_chunk_t *chunk;
+    unsigned generation;
+    int pending;
+    bool shutdown;
+};
+
+static double now_sec(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+/*============================================================================
+ * Shared Front End
+ *============================================================================*/
+
+static void append(float *dst_i, float *dst_q, size_t *n, size_t cap,
+                   const float *i_samples, const float *q_samples, size_t count) {
+    if (count > cap - *n) count = cap - *n;
+    memcpy(dst_i + *n, i_samples, count * sizeof(float));
+    memcpy(dst_q + *n, q_samples, count * sizeof(float));
+    *n += count;
+}
+
+static void on_frontend_detector(const float *i_samples, const float *q_samples,
+                                 size_t count, void *user_data) {
+    sweep_chunk_t *c = ((sweep_source_t *)user_data)->target;
+    append(c->det_i, c->det_q, &c->det_n, c->det_cap, i_samples, q_samples, count);
+}
+
+static void on_frontend_display(const float *i_samples, const float *q_samples,
+                                size_t count, void *user_data) {
+    sweep_chunk_t *c = ((sweep_source_t *)user_data)->target;
+    append(c->disp_i, c->disp_q, &c->disp_n, c->disp_cap, i_samples, q_samples, count);
+}
+
+static bool chunk_alloc(sweep_chunk_t *c) {
+    c->det_cap = SWEEP_CHUNK_SEC * SWEEP_DETECTOR_RATE + SWEEP_CHUNK_MARGIN;
+    c->disp_cap = SWEEP_CHUNK_SEC * SWEEP_DISPLAY_RATE + SWEEP_CHUNK_MARGIN;
+    c->det_i = wwv_malloc(c->det_cap * sizeof(float));
+    c->det_q = wwv_malloc(c->det_cap * sizeof(float));
+    c->disp_i = wwv_malloc(c->disp_cap * sizeof(float));
+    c->disp_q = wwv_malloc(c->disp_cap * sizeof(float));
+    return c->det_i && c->det_q && c->disp_i && c->disp_q;
+}
+
+static void chunk_free(sweep_chunk_t *c) {
+    wwv_free(c->det_i);
+    wwv_free(c->det_q);
+    wwv_free(c->disp_i);
+    wwv_free(c->disp_q);
+}
+
+static bool source_open(sweep_source_t *src, const wwv_iq_file_t *file,
+                        uint64_t start, uint64_t end) {
+    memset(src, 0, sizeof(*src));
+    src->file = file;
+    src->rate = wwv_iq_file_info(file)->sample_rate;
+    src->pos = start;
+    src->end = end;
+
+    if (src->rate == SWEEP_SDR_RATE) {
+        src->frontend = sdr_frontend_create();
+        if (!src->frontend) return false;
+        sdr_frontend_set_sink(src->frontend, SDR_TAP_DETECTOR, on_frontend_detector, src);
+        sdr_frontend_set_sink(src->frontend, SDR_TAP_DISPLAY, on_frontend_display, src);
+    } else {
+        src->display = polyphase_resampler_create(SWEEP_DISPLAY_INTERP, SWEEP_DISPLAY_DECIM,
+                                                  SWEEP_DISPLAY_TAPS, SWEEP_DETECTOR_RATE,
+                                                  SWEEP_DISPLAY_CUTOFF);
+        if (!src->display) return false;
+    }
+    src->in_i = wwv_malloc(SWEEP_READ_SAMPLES * sizeof(float));
+    src->in_q = wwv_malloc(SWEEP_READ_SAMPLES * sizeof(float));
+    return src->in_i && src->in_q;
+}
+
+static void source_close(sweep_source_t *src) {
+    if (src->frontend) sdr_frontend_destroy(src->frontend);
+    polyphase_resampler_destroy(src->display);
+    wwv_free(src->in_i);
+    wwv_free(src->in_q);
+}
+
+/**
+ * Read and decimate the next SWEEP_CHUNK_SEC into c
+ * @return false once the span is exhausted
+ */
+static bool source_fill(sweep_source_t *src, sweep_chunk_t *c) {
+    c->det_n = 0;
+    c->disp_n = 0;
+    src->target = c;
+
+    uint64_t want = (uint64_t)SWEEP_CHUNK_SEC * src->rate;
+    while (want > 0 && src->pos < src->end) {
+        size_t n = SWEEP_READ_SAMPLES;
+        if (n > want) n = (size_t)want;
+        if (n > src->end - src->pos) n = (size_t)(src->end - src->pos);
+        n = wwv_iq_file_read(src->file, src->pos, n, src->in_i, src->in_q);
+        if (n == 0) break;
+
+        if (src->frontend) {
+            sdr_frontend_process(src->frontend, src->in_i, src->in_q, n);
+        } else {
+            append(c->det_i, c->det_q, &c->det_n, c->det_cap, src->in_i, src->in_q, n);
+            size_t room = c->disp_cap - c->disp_n;
+            if (polyphase_resampler_max_output(src->display, n) <= room) {
+                c->disp_n += polyphase_resampler_process(src->display, src->in_i, src->in_q, n,
+                                                         c->disp_i + c->disp_n,
+                                                         c->disp_q + c->disp_n);
+            }
+        }
+        src->pos += n;
+        want -= n;
+    }
+    return c->det_n > 0;
+}
+
+/*============================================================================
+ * Instances
+ *============================================================================*/
+
+static void times_push(sweep_instance_t *inst, sweep_times_t *t, double ms) {
+    if (t->count == t->capacity) {
+        size_t cap = t->capacity ? t->capacity * 2 : 1024;
+        double *grown = realloc(t->ms, cap * sizeof(double));
+        if (!grown) {
+            inst->oom = true;
+            return;
+        }
+        t->ms = grown;
+        t->capacity = cap;
+    }
+    t->ms[t->count++] = ms;
+}
+
+static void on_instance_tick(const wwv_tick_event_t *event, void *user_data) {
+    sweep_instance_t *inst = (sweep_instance_t *)user_data;
+    inst->last_event_ms = inst->offset_ms + event->timestamp_ms;
+    times_push(inst, &inst->ticks, inst->last_event_ms);
+}
+
+static void on_instance_marker(const wwv_marker_event_t *event, void *user_data) {
+    sweep_instance_t *inst = (sweep_instance_t *)user_data;
+    inst->last_event_ms = inst->offset_ms + event->timestamp_ms;
+    times_push(inst, &inst->markers, inst->last_event_ms);
+}
+
+static void on_instance_sync(const wwv_sync_status_t *status, void *user_data) {
+    sweep_instance_t *inst = (sweep_instance_t *)user_data;
+    if (status->is_synced && inst->lock_ms < 0) inst->lock_ms = inst->last_event_ms;
+}
+
+/* Apply one parameter set; false (and a note) if any setting is rejected */
+static bool instance_apply(sweep_instance_t *inst, int set_index, const wwv_sweep_set_t *set) {
+    for (int p = 0; p < set->param_count && p < WWV_SWEEP_MAX_PARAMS; p++) {
+        const wwv_sweep_param_t *param = &set->params[p];
+        if (!wwv_detector_manager_set_param(inst->mgr, param->name, param->value)) {
+            printf("[SWEEP] Set %d: %s=%g rejected, skipping set\n",
+                   set_index, param->name ? param->name : "(null)", param->value);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void instance_feed(sweep_instance_t *inst, const sweep_chunk_t *c) {
+    for (size_t off = 0; off < c->det_n; off += SWEEP_FEED_SAMPLES) {
+        size_t n = c->det_n - off < SWEEP_FEED_SAMPLES ? c->det_n - off : SWEEP_FEED_SAMPLES;
+        size_t d0 = off * c->disp_n / c->det_n;
+        size_t d1 = (off + n) * c->disp_n / c->det_n;
+        wwv_detector_manager_process_detector_block(inst->mgr, c->det_i + off, c->det_q + off, n);
+        wwv_detector_manager_process_display_block(inst->mgr, c->disp_i + d0, c->disp_q + d0, d1 - d0);
+    }
+}
+
+/*============================================================================
+ * Worker Pool
+ *============================================================================*/
+
+static void sweep_worker_main(void *arg) {
+    sweep_worker_t *w = (sweep_worker_t *)arg;
+    sweep_pool_t *pool = w->pool;
+    unsigned seen = 0;
+
+    for (;;) {
+        wwv_mutex_lock(&pool->lock);
+        while (!pool->shutdown && pool->generation == seen) {
+            wwv_cond_wait(&pool->job_ready, &pool->lock);
+        }
+        if (pool->shutdown) {
+            wwv_mutex_unlock(&pool->lock);
+            break;
+        }
+        seen = pool->generation;
+        const sweep_chunk_t *chunk = pool->chunk;
+        wwv_mutex_unlock(&pool->lock);
+
+        for (int k = w->index; k < pool->instance_count; k += pool->worker_count) {
+            if (pool->instances[k].mgr) instance_feed(&pool->instances[k], chunk);
+        }
+
+        wwv_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) wwv_cond_signal(&pool->job_done);
+        wwv_mutex_unlock(&pool->lock);
+    }
+}
+
+static void pool_publish(sweep_pool_t *pool, const sweep_chunk_t *chunk) {
+    wwv_mutex_lock(&pool->lock);
+    pool->chunk = chunk;
+    pool->pending = pool->worker_count;
+    pool->generation++;
+    wwv_cond_broadcast(&pool->job_ready);
+    wwv_mutex_unlock(&pool->lock);
+}
+
+static void pool_wait(sweep_pool_t *pool) {
+    wwv_mutex_lock(&pool->lock);
+    while (pool->pending > 0) wwv_cond_wait(&pool->job_done, &pool->lock);
+    wwv_mutex_unlock(&pool->lock);
+}
+
+static void pool_stop(sweep_pool_t *pool) {
+    wwv_mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    wwv_cond_broadcast(&pool->job_ready);
+    wwv_mutex_unlock(&pool->lock);
+    for (int w = 0; w < pool->worker_count; w++) {
+        if (pool->workers[w].started) wwv_thread_join(pool->workers[w].thread);
+    }
+}
+
+/*============================================================================
+ * Scoring
+ *============================================================================*/
+
+/**
+ * Densest phase (mod period) over every instance's events
+ * @param member Offset of the sweep_times_t within sweep_instance_t
+ * @return Phase in [0, period), or -1 with no events
+ */
+static double estimate_phase(const sweep_instance_t *inst, int count, size_t member,
+                             double period, double bin_ms, double window_ms) {
+    int bins = (int)(period / bin_ms);
+    int span = (int)(window_ms / bin_ms);
+    if (span < 1) span = 1;
+    int *hist = wwv_calloc((size_t)bins, sizeof(int));
+    if (!hist) return -1.0;
+
+    size_t total = 0;
+    for (int k = 0; k < count; k++) {
+        const sweep_times_t *t = (const sweep_times_t *)((const char *)&inst[k] + member);
+        for (size_t e = 0; e < t->count; e++) {
+            int b = (int)(fmod(t->ms[e], period) / bin_ms);
+            hist[b < bins ? b : bins - 1]++;
+        }
+        total += t->count;
+    }
+
+    double phase = -1.0;
+    if (total > 0) {
+        /* Circular sliding window, then the mean offset of its members */
+        int best = 0, best_start = 0, sum = 0;
+        for (int b = 0; b < span; b++) sum += hist[b % bins];
+        best = sum;
+        for (int s = 1; s < bins; s++) {
+            sum += hist[(s + span - 1) % bins] - hist[s - 1];
+            if (sum > best) {
+                best = sum;
+                best_start = s;
+            }
+        }
+        double center = (best_start + span * 0.5) * bin_ms;
+        double acc = 0.0;
+        size_t n = 0;
+        for (int k = 0; k < count; k++) {
+            const sweep_times_t *t = (const sweep_times_t *)((const char *)&inst[k] + member);
+            for (size_t e = 0; e < t->count; e++) {
+                double d = remainder(t->ms[e] - center, period);
+                if (fabs(d) <= window_ms * 0.5) {
+                    acc += d;
+                    n++;
+                }
+            }
+        }
+        phase = fmod(center + (n ? acc / n : 0.0) + period, period);
+    }
+    wwv_free(hist);
+    return phase;
+}
+
+/* Grid points phase + k * period inside [start_ms, end_ms) */
+static int grid_points(double phase, double period, double start_ms, double end_ms) {
+    double first = ceil((start_ms - phase) / period);
+    double last = ceil((end_ms - phase) / period) - 1.0;
+    return last >= first ? (int)(last - first + 1.0) : 0;
+}
+
+/* On-grid events, at most one per grid point (times are chronological) */
+static int grid_hits(const sweep_times_t *t, double phase, double period, double window_ms) {
+    int hits = 0;
+    long long last = 0;
+    bool have_last = false;
+    for (size_t e = 0; e < t->count; e++) {
+        double rel = t->ms[e] - phase;
+        if (fabs(remainder(rel, period)) > window_ms) continue;
+        long long k = llround(rel / period);
+        if (have_last && k == last) continue;
+        last = k;
+        have_last = true;
+        hits++;
+    }
+    return hits;
+}
+
+/*============================================================================
+ * Sweep
+ *============================================================================*/
+
+bool wwv_sweep_run(const wwv_iq_file_t *file, const wwv_sweep_config_t *config,
+                   const wwv_sweep_set_t *sets, int set_count,
+                   wwv_sweep_result_t *results, wwv_sweep_stats_t *stats) {
+    if (!file || !config || !sets || !results || set_count < 1) return false;
+    if (set_count > WWV_SWEEP_MAX_SETS) set_count = WWV_SWEEP_MAX_SETS;
+
+    const wwv_iq_info_t *info = wwv_iq_file_info(file);
+    uint32_t rate = info->sample_rate;
+    if (rate != SWEEP_DETECTOR_RATE && rate != SWEEP_SDR_RATE) {
+        printf("[SWEEP] Unsupported sample rate %u Hz (need %u or %u)\n",
+               rate, SWEEP_DETECTOR_RATE, SWEEP_SDR_RATE);
+        return false;
+    }
+
+    uint64_t start = (uint64_t)(config->start_sec > 0 ? config->start_sec * rate : 0);
+    uint64_t end = info->sample_count;
+    if (config->duration_sec > 0) {
+        uint64_t span = (uint64_t)(config->duration_sec * rate);
+        if (start + span < end) end = start + span;
+    }
+    if (start >= end) {
+        printf("[SWEEP] Empty sweep span\n");
+        return false;
+    }
+    double start_ms = (double)start * 1000.0 / rate;
+    double end_ms = (double)end * 1000.0 / rate;
+
+    int workers = config->worker_threads > 0 ? config->worker_threads : wwv_cpu_count();
+    if (workers < 1) workers = 1;
+    if (workers > set_count) workers = set_count;
+
+    sweep_pool_t pool;
+    memset(&pool, 0, sizeof(pool));
+    pool.instance_count = set_count;
+    pool.worker_count = workers;
+    pool.instances = wwv_calloc((size_t)set_count, sizeof(sweep_instance_t));
+    pool.workers = wwv_calloc((size_t)workers, sizeof(sweep_worker_t));
+    sweep_chunk_t chunks[2];
+    memset(chunks, 0, sizeof(chunks));
+    sweep_source_t src;
+    memset(&src, 0, sizeof(src));
+
+    bool ok = pool.instances && pool.workers && chunk_alloc(&chunks[0]) &&
+              chunk_alloc(&chunks[1]) && source_open(&src, file, start, end);
+
+    /* One manager per set; instances share the detector config */
+    wwv_detector_config_t cfg = config->detector;
+    cfg.output_dir = NULL;
+    cfg.threaded = false;
+    cfg.enable_sdr_frontend = false;
+
+    memset(results, 0, (size_t)set_count * sizeof(*results));
+    for (int k = 0; ok && k < set_count; k++) {
+        sweep_instance_t *inst = &pool.instances[k];
+        inst->offset_ms = start_ms;
+        inst->lock_ms = -1.0;
+        inst->mgr = wwv_detector_manager_create(&cfg);
+        if (!inst->mgr) {
+            printf("[SWEEP] Set %d: failed to create detector manager\n", k);
+            ok = false;
+            break;
+        }
+        if (!instance_apply(inst, k, &sets[k])) {
+            wwv_detector_manager_destroy(inst->mgr);
+            inst->mgr = NULL;
+            continue;
+        }
+        results[k].valid = true;
+        wwv_detector_manager_set_tick_callback(inst->mgr, on_instance_tick, inst);
+        wwv_detector_manager_set_marker_callback(inst->mgr, on_instance_marker, inst);
+        wwv_detector_manager_set_sync_callback(inst->mgr, on_instance_sync, inst);
+    }
+
+    bool pool_ready = false;
+    if (ok) {
+        pool_ready = true;
+        wwv_mutex_init(&pool.lock);
+        wwv_cond_init(&pool.job_ready);
+        wwv_cond_init(&pool.job_done);
+        for (int w = 0; w < workers; w++) {
+            pool.workers[w].pool = &pool;
+            pool.workers[w].index = w;
+            pool.workers[w].started = wwv_thread_create(&pool.workers[w].thread,
+                                                        sweep_worker_main, &pool.workers[w]);
+            if (!pool.workers[w].started) {
+                printf("[SWEEP] Failed to start worker %d\n", w);
+                ok = false;
+            }
+        }
+    }
+
+    printf("[SWEEP] %d set%s over %.1f sec at %u Hz on %d worker%s\n",
+           set_count, set_count == 1 ? "" : "s", (end_ms - start_ms) / 1000.0,
+           rate, workers, workers == 1 ? "" : "s");
+
+    double t0 = now_sec();
+    double frontend_sec = 0.0;
+
+    if (ok) {
+        int cur = 0;
+        double f0 = now_sec();
+        bool more = source_fill(&src, &chunks[cur]);
+        frontend_sec += now_sec() - f0;
+        while (more) {
+            pool_publish(&pool, &chunks[cur]);
+            f0 = now_sec();
+            more = source_fill(&src, &chunks[cur ^ 1]);
+            frontend_sec += now_sec() - f0;
+            pool_wait(&pool);
+            cur ^= 1;
+        }
+    }
+    if (pool_ready) {
+        pool_stop(&pool);
+        wwv_cond_destroy(&pool.job_done);
+        wwv_cond_destroy(&pool.job_ready);
+        wwv_mutex_destroy(&pool.lock);
+    }
+
+    double wall = now_sec() - t0;
+
+    /* Epochs from every instance's events pooled */
+    double tick_window = config->tick_window_ms > 0 ? config->tick_window_ms : 20.0;
+    double marker_window = config->marker_window_ms > 0 ? config->marker_window_ms : 250.0;
+    double tick_phase = -1.0, marker_phase = -1.0;
+    int expected_ticks = 0, expected_markers = 0;
+    double minutes = (end_ms - start_ms) / 60000.0;
+
+    if (ok) {
+        tick_phase = estimate_phase(pool.instances, set_count, offsetof(sweep_instance_t, ticks),
+                                    SWEEP_TICK_PERIOD_MS, SWEEP_TICK_BIN_MS, 2.0 * tick_window);
+        marker_phase = estimate_phase(pool.instances, set_count, offsetof(sweep_instance_t, markers),
+                                      SWEEP_MARKER_PERIOD_MS, SWEEP_MARKER_BIN_MS, 2.0 * marker_window);
+        if (tick_phase >= 0) {
+            expected_ticks = grid_points(tick_phase, SWEEP_TICK_PERIOD_MS, start_ms, end_ms)
+                           * SWEEP_TICKS_PER_MINUTE / 60;
+        }
+        if (marker_phase >= 0) {
+            expected_markers = grid_points(marker_phase, SWEEP_MARKER_PERIOD_MS, start_ms, end_ms);
+        }
+
+        for (int k = 0; k < set_count; k++) {
+            sweep_instance_t *inst = &pool.instances[k];
+            wwv_sweep_result_t *r = &results[k];
+            if (!r->valid) continue;
+            if (inst->oom) ok = false;
+
+            r->ticks = (int)inst->ticks.count;
+            r->markers = (int)inst->markers.count;
+            if (tick_phase >= 0) {
+                r->tick_hits = grid_hits(&inst->ticks, tick_phase, SWEEP_TICK_PERIOD_MS, tick_window);
+            }
+            if (marker_phase >= 0) {
+                r->marker_hits = grid_hits(&inst->markers, marker_phase, SWEEP_MARKER_PERIOD_MS,
+                                           marker_window);
+            }
+            r->tick_detection_rate = expected_ticks ? (float)r->tick_hits / expected_ticks : 0.0f;
+            r->marker_detection_rate = expected_markers ? (float)r->marker_hits / expected_markers : 0.0f;
+            r->false_ticks_per_min = minutes > 0 ? (float)((r->ticks - r->tick_hits) / minutes) : 0.0f;
+            r->false_markers_per_hour = minutes > 0
+                                      ? (float)((r->markers - r->marker_hits) * 60.0 / minutes) : 0.0f;
+            r->lock_sec = inst->lock_ms >= 0 ? inst->lock_ms / 1000.0 : -1.0;
+        }
+    }
+
+    if (stats) {
+        memset(stats, 0, sizeof(*stats));
+        stats->signal_sec = (end_ms - start_ms) / 1000.0;
+        stats->wall_sec = wall;
+        stats->frontend_sec = frontend_sec;
+        stats->tick_epoch_ms = tick_phase;
+        stats->marker_epoch_ms = marker_phase;
+        stats->expected_ticks = expected_ticks;
+        stats->expected_markers = expected_markers;
+        stats->sets = set_count;
+        stats->workers = workers;
+    }
+
+    printf("[SWEEP] Done in %.2f sec wall (front end %.2f sec, %.1fx real time per set)\n",
+           wall, frontend_sec, wall > 0 ? set_count * (end_ms - start_ms) / 1000.0 / wall : 0.0);
+
+    if (pool.instances) {
+        for (int k = 0; k < set_count; k++) {
+            wwv_detector_manager_destroy(pool.instances[k].mgr);
+            free(pool.instances[k].ticks.ms);
+            free(pool.instances[k].markers.ms);
+        }
+    }
+    source_close(&src);
+    chunk_free(&chunks[0]);
+    chunk_free(&chunks[1]);
+    wwv_free(pool.workers);
+    wwv_free(pool.instances);
+    return ok;
+}
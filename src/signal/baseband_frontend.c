@@ -0,0 +1,209 @@
+/**
+ * @file baseband_frontend.c
+ * @brief 50 kHz -> 3125 Hz complex-baseband front end
+ *
+ * The first stage decimates the raw detector stream (two real rails), the
+ * NCO then runs at 12.5 kHz, and only the second stage filters all four
+ * rails. Cutoffs sit midway between each stage's passband edge and the
+ * first frequency that would alias into it, so aliases land >= 80 dB down:
+ *
+ *   stage 1: passes |f| <= 1.6 kHz (mix + 3 bins), alias from 10.9 kHz
+ *   stage 2: passes |f| <= 600 Hz around DC, alias from 2525 Hz
+ *
+ * At 12.5 kHz the NCO frequency is exactly 5/64 cycle per sample, so it is
+ * a 64-entry table with no phase drift.
+ */
+
+#include "baseband_frontend.h"
+#include "polyphase_resampler.h"
+#include "wwv_arena.h"
+#include <stdio.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define BB_STAGE1_DECIM     4
+#define BB_STAGE1_TAPS      32
+#define BB_STAGE1_CUTOFF    6000.0f
+#define BB_STAGE2_DECIM     (BASEBAND_DECIMATION / BB_STAGE1_DECIM)
+#define BB_STAGE2_TAPS      48
+#define BB_STAGE2_CUTOFF    1500.0f
+#define BB_MID_RATE         ((float)BASEBAND_INPUT_RATE / BB_STAGE1_DECIM)
+
+#define BB_NCO_SIZE         64      /* Mix period at the 12.5 kHz rate */
+
+/* Group delay in half input samples: (t1 - 1) / 2 + decim1 * (t2 - 1) / 2 */
+#define BB_DELAY_HALVES     ((BB_STAGE1_TAPS - 1) + BB_STAGE1_DECIM * (BB_STAGE2_TAPS - 1))
+/* Outputs dropped at start so the rest sit BASEBAND_SAMPLE_OFFSET after the grid */
+#define BB_LEAD             ((BB_DELAY_HALVES + 2 * BASEBAND_DECIMATION - 1) / (2 * BASEBAND_DECIMATION))
+
+_Static_assert(BB_STAGE1_DECIM * BB_STAGE2_DECIM == BASEBAND_DECIMATION, "stage ratios");
+_Static_assert(2 * BASEBAND_DECIMATION * BB_LEAD - BB_DELAY_HALVES == 5,
+               "BASEBAND_SAMPLE_OFFSET no longer matches the filter delay");
+_Static_assert(BASEBAND_MIX_BIN * BB_NCO_SIZE % (256 / BB_STAGE1_DECIM) == 0,
+               "mix frequency is not a whole number of cycles per NCO table");
+
+struct baseband_frontend {
+    polyphase_resampler_t *stage1;
+    polyphase_resampler_t *upper;
+    polyphase_resampler_t *lower;
+
+    /* Stage 1 output, then the two mixed streams at 12.5 kHz */
+    float *mid_i, *mid_q;
+    float *up_i, *up_q;
+    float *lo_i, *lo_q;
+    size_t mid_capacity;
+
+    /* Baseband output */
+    float *out_up_i, *out_up_q;
+    float *out_lo_i, *out_lo_q;
+
+    float nco_re[BB_NCO_SIZE];          /* cos(2*pi*mix*m/12500) */
+    float nco_im[BB_NCO_SIZE];          /* -sin(...) */
+    int nco_phase;
+    int lead_remaining;                 /* Start-up outputs still to drop */
+
+    baseband_sink_fn sink;
+    void *sink_data;
+};
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+baseband_frontend_t *baseband_frontend_create(void) {
+    baseband_frontend_t *fe = wwv_calloc(1, sizeof(baseband_frontend_t));
+    if (!fe) return NULL;
+
+    fe->stage1 = polyphase_resampler_create(1, BB_STAGE1_DECIM, BB_STAGE1_TAPS,
+                                            (float)BASEBAND_INPUT_RATE, BB_STAGE1_CUTOFF);
+    fe->upper = polyphase_resampler_create(1, BB_STAGE2_DECIM, BB_STAGE2_TAPS,
+                                           BB_MID_RATE, BB_STAGE2_CUTOFF);
+    fe->lower = polyphase_resampler_create(1, BB_STAGE2_DECIM, BB_STAGE2_TAPS,
+                                           BB_MID_RATE, BB_STAGE2_CUTOFF);
+    if (!fe->stage1 || !fe->upper || !fe->lower) {
+        baseband_frontend_destroy(fe);
+        return NULL;
+    }
+
+    fe->mid_capacity = polyphase_resampler_max_output(fe->stage1, BASEBAND_CHUNK);
+    size_t out_capacity = polyphase_resampler_max_output(fe->upper, fe->mid_capacity);
+    float **mid[] = { &fe->mid_i, &fe->mid_q, &fe->up_i, &fe->up_q, &fe->lo_i, &fe->lo_q };
+    float **out[] = { &fe->out_up_i, &fe->out_up_q, &fe->out_lo_i, &fe->out_lo_q };
+    for (size_t b = 0; b < sizeof(mid) / sizeof(mid[0]); b++) {
+        *mid[b] = wwv_malloc(fe->mid_capacity * sizeof(float));
+        if (!*mid[b]) {
+            baseband_frontend_destroy(fe);
+            return NULL;
+        }
+    }
+    for (size_t b = 0; b < sizeof(out) / sizeof(out[0]); b++) {
+        *out[b] = wwv_malloc(out_capacity * sizeof(float));
+        if (!*out[b]) {
+            baseband_frontend_destroy(fe);
+            return NULL;
+        }
+    }
+
+    for (int m = 0; m < BB_NCO_SIZE; m++) {
+        double ph = 2.0 * M_PI * BASEBAND_MIX_HZ * m / BB_MID_RATE;
+        fe->nco_re[m] = (float)cos(ph);
+        fe->nco_im[m] = (float)-sin(ph);
+    }
+    fe->lead_remaining = BB_LEAD;
+
+    printf("[BASEBAND] Created: 50 kHz -> %.1f kHz -> %d Hz, mix %.1f Hz, delay %.1f samples\n",
+           BB_MID_RATE / 1000.0f, BASEBAND_RATE, BASEBAND_MIX_HZ, BB_DELAY_HALVES * 0.5);
+    return fe;
+}
+
+void baseband_frontend_destroy(baseband_frontend_t *fe) {
+    if (!fe) return;
+    polyphase_resampler_destroy(fe->stage1);
+    polyphase_resampler_destroy(fe->upper);
+    polyphase_resampler_destroy(fe->lower);
+    wwv_free(fe->mid_i);
+    wwv_free(fe->mid_q);
+    wwv_free(fe->up_i);
+    wwv_free(fe->up_q);
+    wwv_free(fe->lo_i);
+    wwv_free(fe->lo_q);
+    wwv_free(fe->out_up_i);
+    wwv_free(fe->out_up_q);
+    wwv_free(fe->out_lo_i);
+    wwv_free(fe->out_lo_q);
+    wwv_free(fe);
+}
+
+void baseband_frontend_set_sink(baseband_frontend_t *fe, baseband_sink_fn sink, void *user_data) {
+    if (!fe) return;
+    fe->sink = sink;
+    fe->sink_data = user_data;
+}
+
+/**
+ * Shift +mix (upper) and the mirror of -mix (lower) to DC
+ *   upper = x * p,  lower = conj(x) * p,  p = e^{-j*mix*t}
+ * The four products are shared between the two streams.
+ */
+static void mix(baseband_frontend_t *fe, size_t n) {
+    int ph = fe->nco_phase;
+    for (size_t k = 0; k < n; k++) {
+        float c = fe->nco_re[ph];
+        float s = fe->nco_im[ph];
+        float ic = fe->mid_i[k] * c, qs = fe->mid_q[k] * s;
+        float is = fe->mid_i[k] * s, qc = fe->mid_q[k] * c;
+        fe->up_i[k] = ic - qs;
+        fe->up_q[k] = is + qc;
+        fe->lo_i[k] = ic + qs;
+        fe->lo_q[k] = is - qc;
+        ph = (ph + 1) & (BB_NCO_SIZE - 1);
+    }
+    fe->nco_phase = ph;
+}
+
+void baseband_frontend_process(baseband_frontend_t *fe, const float *i_samples,
+                               const float *q_samples, size_t count) {
+    if (!fe || !i_samples || !q_samples) return;
+
+    while (count > 0) {
+        size_t n = (count < BASEBAND_CHUNK) ? count : BASEBAND_CHUNK;
+        size_t mid_n = polyphase_resampler_process(fe->stage1, i_samples, q_samples, n,
+                                                   fe->mid_i, fe->mid_q);
+        i_samples += n;
+        q_samples += n;
+        count -= n;
+        if (mid_n == 0) continue;
+
+        mix(fe, mid_n);
+        size_t out_n = polyphase_resampler_process(fe->upper, fe->up_i, fe->up_q, mid_n,
+                                                   fe->out_up_i, fe->out_up_q);
+        polyphase_resampler_process(fe->lower, fe->lo_i, fe->lo_q, mid_n,
+                                    fe->out_lo_i, fe->out_lo_q);
+
+        size_t skip = 0;
+        if (fe->lead_remaining > 0) {
+            skip = ((size_t)fe->lead_remaining < out_n) ? (size_t)fe->lead_remaining : out_n;
+            fe->lead_remaining -= (int)skip;
+        }
+        if (out_n > skip && fe->sink) {
+            baseband_block_t block = {
+                fe->out_up_i + skip, fe->out_up_q + skip,
+                fe->out_lo_i + skip, fe->out_lo_q + skip,
+                out_n - skip
+            };
+            fe->sink(&block, fe->sink_data);
+        }
+    }
+}
+
+void baseband_frontend_reset(baseband_frontend_t *fe) {
+    if (!fe) return;
+    polyphase_resampler_reset(fe->stage1);
+    polyphase_resampler_reset(fe->upper);
+    polyphase_resampler_reset(fe->lower);
+    fe->nco_phase = 0;
+    fe->lead_remaining = BB_LEAD;
+}
@@ -1,37 +1,105 @@
 #include "channel_filters.h"
+#include "signal/channel_filters_internal.h"
+#include "wwv_denormal.h"
+#include <math.h>
+#include <stdatomic.h>
 #include <string.h>
 
-// Filter coefficients for fs=50000 Hz
-// Format: [b0, b1, b2, a0(=1), a1, a2]
-
-// Sync channel: 800 Hz Highpass (4th order = 2 cascaded 2nd-order sections)
-static const float sync_hp_sos[2][6] = {
-    // Section 1
-    {0.94280904f, -1.88561808f, 0.94280904f, 1.0f, -1.88345806f, 0.88777810f},
-    // Section 2
-    {0.94280904f, -1.88561808f, 0.94280904f, 1.0f, -1.88345806f, 0.88777810f}
-};
-
-// Sync channel: 1400 Hz Lowpass (4th order = 2 cascaded 2nd-order sections)
-static const float sync_lp_sos[2][6] = {
-    // Section 1
-    {0.00766530f, 0.01533060f, 0.00766530f, 1.0f, -1.73487628f, 0.76553747f},
-    // Section 2
-    {0.00766530f, 0.01533060f, 0.00766530f, 1.0f, -1.73487628f, 0.76553747f}
-};
-
-// Data channel: 150 Hz Lowpass (4th order = 2 cascaded 2nd-order sections)
-static const float data_lp_sos[2][6] = {
-    // Section 1
-    {0.0000352f, 0.0000704f, 0.0000352f, 1.0f, -1.98223f, 0.98230f},
-    // Section 2
-    {0.0000352f, 0.0000704f, 0.0000352f, 1.0f, -1.98223f, 0.98230f}
-};
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+//=============================================================================
+// Butterworth design
+//
+// Analog prototype poles on the unit circle, scaled to the prewarped cutoff
+// and mapped through the bilinear transform, in double. Lowpass and
+// highpass share the poles (1/p of a unit-circle pole is its conjugate);
+// only the zeros (z = -1 or z = +1) and the unity-gain frequency differ.
+// Section layout follows scipy.signal.butter(output='sos'): overall gain in
+// the first section, poles nearest the unit circle last.
+//=============================================================================
+
+int channel_butterworth_design(channel_filter_type_t type, int order, double cutoff_hz,
+                               double sample_rate, double sos[][6]) {
+    if (!sos || order < 1 || order > CHANNEL_MAX_ORDER) return 0;
+    if (!(sample_rate > 0.0) || !(cutoff_hz > 0.0) || cutoff_hz >= 0.5 * sample_rate) return 0;
+
+    double fs2 = 2.0 * sample_rate;
+    double wc = fs2 * tan(M_PI * cutoff_hz / sample_rate);
+    double zero = (type == CHANNEL_HIGHPASS) ? 1.0 : -1.0;
+    int sections = (order + 1) / 2;
+    double radius[CHANNEL_MAX_SECTIONS];
+    double gain = 1.0;
+
+    for (int k = 0; k < sections; k++) {
+        double *c = sos[k];
+        double phi = M_PI / 2.0 + M_PI * (2 * k + 1) / (2.0 * order);
+        double sr = wc * cos(phi), si = wc * sin(phi);
+
+        if (2 * k + 1 == order) {
+            // Real pole, z = (fs2 + s) / (fs2 - s); conjugate pairs below likewise
+            double p = (fs2 + sr) / (fs2 - sr);
+            c[0] = 1.0; c[1] = -zero; c[2] = 0.0;
+            c[3] = 1.0; c[4] = -p;    c[5] = 0.0;
+            radius[k] = fabs(p);
+        } else {
+            double dr = fs2 - sr;
+            double den = dr * dr + si * si;
+            double zr = ((fs2 + sr) * dr - si * si) / den;
+            double zi = (si * dr + (fs2 + sr) * si) / den;
+            c[0] = 1.0; c[1] = -2.0 * zero; c[2] = 1.0;
+            c[3] = 1.0; c[4] = -2.0 * zr;   c[5] = zr * zr + zi * zi;
+            radius[k] = sqrt(c[5]);
+        }
+
+        // Unity gain at DC (lowpass) or Nyquist (highpass)
+        double z = -zero;
+        double num = c[0] + c[1] * z + c[2] * z * z;
+        double dnm = c[3] + c[4] * z + c[5] * z * z;
+        gain *= dnm / num;
+    }
+
+    // Insertion sort by pole radius, ascending
+    for (int i = 1; i < sections; i++) {
+        for (int j = i; j > 0 && radius[j] < radius[j - 1]; j--) {
+            double t = radius[j]; radius[j] = radius[j - 1]; radius[j - 1] = t;
+            for (int n = 0; n < 6; n++) {
+                t = sos[j][n]; sos[j][n] = sos[j - 1][n]; sos[j - 1][n] = t;
+            }
+        }
+    }
+
+    for (int n = 0; n < 3; n++) sos[0][n] *= gain;
+    return sections;
+}
+
+// Design into a channel's float sections; 0 if the rate cannot hold the cutoff
+static int design_sections(float (*out)[6], channel_filter_type_t type, double cutoff_hz,
+                           float sample_rate) {
+    double sos[CHANNEL_MAX_SECTIONS][6];
+    int n = channel_butterworth_design(type, CHANNEL_FILTER_ORDER, cutoff_hz, sample_rate, sos);
+    for (int s = 0; s < n; s++) {
+        for (int k = 0; k < 6; k++) out[s][k] = (float)sos[s][k];
+    }
+    return n == CHANNEL_FILTER_SECTIONS;
+}
+
+static int design_sync(float (*sos)[6], float sample_rate) {
+    return design_sections(sos, CHANNEL_HIGHPASS, CHANNEL_SYNC_HP_HZ, sample_rate) &&
+           design_sections(sos + CHANNEL_FILTER_SECTIONS, CHANNEL_LOWPASS, CHANNEL_SYNC_LP_HZ,
+                           sample_rate);
+}
+
+static int design_data(float (*sos)[6], float sample_rate) {
+    return design_sections(sos, CHANNEL_LOWPASS, CHANNEL_DATA_LP_HZ, sample_rate);
+}
 
 // Process one sample through a biquad section
 static float biquad_process(biquad_state_t *s, float x, const float *coeffs) {
     float y = coeffs[0] * x + coeffs[1] * s->x1 + coeffs[2] * s->x2
             - coeffs[4] * s->y1 - coeffs[5] * s->y2;
+    y = WWV_DENORMAL_FLUSH(y);
     s->x2 = s->x1;
     s->x1 = x;
     s->y2 = s->y1;
@@ -41,12 +109,26 @@ static float biquad_process(biquad_state_t *s, float x, const float *coeffs) {
 
 // Initialize sync channel (800-1400 Hz bandpass)
 void sync_channel_init(sync_channel_t *ch) {
-    memset(ch, 0, sizeof(*ch));
+    sync_channel_init_rate(ch, CHANNEL_DEFAULT_RATE);
 }
 
 // Initialize data channel (0-150 Hz lowpass)
 void data_channel_init(data_channel_t *ch) {
+    data_channel_init_rate(ch, CHANNEL_DEFAULT_RATE);
+}
+
+int sync_channel_init_rate(sync_channel_t *ch, float sample_rate) {
+    if (!ch) return 0;
+    memset(ch, 0, sizeof(*ch));
+    ch->sample_rate = sample_rate;
+    return design_sync(ch->sos, sample_rate);
+}
+
+int data_channel_init_rate(data_channel_t *ch, float sample_rate) {
+    if (!ch) return 0;
     memset(ch, 0, sizeof(*ch));
+    ch->sample_rate = sample_rate;
+    return design_data(ch->sos, sample_rate);
 }
 
 // Process sample through sync channel (800-1400 Hz bandpass)
@@ -54,12 +136,12 @@ float sync_channel_process(sync_channel_t *ch, float x) {
     float y = x;
 
     // Highpass cascade (800 Hz)
-    y = biquad_process(&ch->hp[0], y, sync_hp_sos[0]);
-    y = biquad_process(&ch->hp[1], y, sync_hp_sos[1]);
+    y = biquad_process(&ch->hp[0], y, ch->sos[0]);
+    y = biquad_process(&ch->hp[1], y, ch->sos[1]);
 
     // Lowpass cascade (1400 Hz)
-    y = biquad_process(&ch->lp[0], y, sync_lp_sos[0]);
-    y = biquad_process(&ch->lp[1], y, sync_lp_sos[1]);
+    y = biquad_process(&ch->lp[0], y, ch->sos[2]);
+    y = biquad_process(&ch->lp[1], y, ch->sos[3]);
 
     return y;
 }
@@ -69,18 +151,111 @@ float data_channel_process(data_channel_t *ch, float x) {
     float y = x;
 
     // Lowpass cascade (150 Hz)
-    y = biquad_process(&ch->lp[0], y, data_lp_sos[0]);
-    y = biquad_process(&ch->lp[1], y, data_lp_sos[1]);
+    y = biquad_process(&ch->lp[0], y, ch->sos[0]);
+    y = biquad_process(&ch->lp[1], y, ch->sos[1]);
 
     return y;
 }
 
-// Reset sync channel state
+// Reset sync channel state (the design stays)
 void sync_channel_reset(sync_channel_t *ch) {
-    memset(ch, 0, sizeof(*ch));
+    memset(ch->hp, 0, sizeof(ch->hp));
+    memset(ch->lp, 0, sizeof(ch->lp));
 }
 
 // Reset data channel state
 void data_channel_reset(data_channel_t *ch) {
-    memset(ch, 0, sizeof(*ch));
+    memset(ch->lp, 0, sizeof(ch->lp));
+}
+
+//=============================================================================
+// Multi-lane filter banks
+//=============================================================================
+
+// -1 = not yet detected. Read from every worker thread while set_simd() may
+// write it; detection gives the same answer on every thread, so the first
+// reader to store it wins and a racing detection only repeats it.
+static atomic_int g_simd_level = -1;
+
+channel_simd_t channel_filters_get_simd(void) {
+    int level = atomic_load_explicit(&g_simd_level, memory_order_relaxed);
+    if (level < 0) {
+        int detected = (int)channel_filters_detect_simd();
+        level = -1;
+        if (atomic_compare_exchange_strong_explicit(&g_simd_level, &level, detected,
+                                                    memory_order_relaxed, memory_order_relaxed)) {
+            level = detected;
+        }
+    }
+    return (channel_simd_t)level;
+}
+
+channel_simd_t channel_filters_set_simd(channel_simd_t level) {
+    int set = channel_filters_simd_supported(level) ?
+              (int)level : (int)channel_filters_detect_simd();
+    atomic_store_explicit(&g_simd_level, set, memory_order_relaxed);
+    return (channel_simd_t)set;
+}
+
+const char *channel_filters_simd_name(channel_simd_t level) {
+    switch (level) {
+        case CHANNEL_SIMD_SSE2: return "SSE2";
+        case CHANNEL_SIMD_AVX2: return "AVX2";
+        case CHANNEL_SIMD_NEON: return "NEON";
+        default:                return "scalar";
+    }
+}
+
+// Run cascade: vector kernel for as many lanes as it can take, scalar for the rest
+static void bank_run(biquad_lane_state_t *sec, const float *const *sos, int sections,
+                     int lanes, const float *in, float *out, size_t count) {
+    int done = biquad_bank_kernel_vector(channel_filters_get_simd(), sec, sos, sections,
+                                         lanes, in, out, count);
+    if (done < lanes) {
+        biquad_bank_kernel_scalar(sec, sos, sections, done, lanes, lanes, in, out, count);
+    }
+}
+
+int sync_channel_bank_init(sync_channel_bank_t *bank, int lanes) {
+    return sync_channel_bank_init_rate(bank, lanes, CHANNEL_DEFAULT_RATE);
+}
+
+int data_channel_bank_init(data_channel_bank_t *bank, int lanes) {
+    return data_channel_bank_init_rate(bank, lanes, CHANNEL_DEFAULT_RATE);
+}
+
+int sync_channel_bank_init_rate(sync_channel_bank_t *bank, int lanes, float sample_rate) {
+    if (!bank || lanes < 1 || lanes > CHANNEL_BANK_MAX_LANES) return 0;
+    memset(bank, 0, sizeof(*bank));
+    bank->lanes = lanes;
+    bank->sample_rate = sample_rate;
+    return design_sync(bank->sos, sample_rate);
+}
+
+int data_channel_bank_init_rate(data_channel_bank_t *bank, int lanes, float sample_rate) {
+    if (!bank || lanes < 1 || lanes > CHANNEL_BANK_MAX_LANES) return 0;
+    memset(bank, 0, sizeof(*bank));
+    bank->lanes = lanes;
+    bank->sample_rate = sample_rate;
+    return design_data(bank->sos, sample_rate);
+}
+
+void sync_channel_bank_process(sync_channel_bank_t *bank, const float *in, float *out, size_t count) {
+    if (!bank || !in || !out) return;
+    const float *const sos[4] = { bank->sos[0], bank->sos[1], bank->sos[2], bank->sos[3] };
+    bank_run(bank->sec, sos, 4, bank->lanes, in, out, count);
+}
+
+void data_channel_bank_process(data_channel_bank_t *bank, const float *in, float *out, size_t count) {
+    if (!bank || !in || !out) return;
+    const float *const sos[2] = { bank->sos[0], bank->sos[1] };
+    bank_run(bank->sec, sos, 2, bank->lanes, in, out, count);
+}
+
+void sync_channel_bank_reset(sync_channel_bank_t *bank) {
+    if (bank) memset(bank->sec, 0, sizeof(bank->sec));
+}
+
+void data_channel_bank_reset(data_channel_bank_t *bank) {
+    if (bank) memset(bank->sec, 0, sizeof(bank->sec));
 }
@@ -0,0 +1,200 @@
+// Lane-parallel biquad cascade kernels for channel filter banks
+//
+// Each vector lane is an independent channel. Per sample, a lane group is
+// loaded from the interleaved block, pushed through every section with the
+// same operation order as biquad_process(), and stored back. Mul and add
+// are issued separately (never FMA) so results match the scalar path bit
+// for bit. Every ISA here can set flush-to-zero, so WWV_DENORMAL_FLUSH()
+// in the scalar kernel is an identity wherever the vector kernels build.
+
+#include "signal/channel_filters_internal.h"
+#include "wwv_denormal.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CF_ARCH_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CF_HAVE_SSE2 1
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#define CF_HAVE_AVX2 1
+#define CF_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER)
+#define CF_HAVE_AVX2 1
+#define CF_TARGET_AVX2
+#endif
+#elif defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#define CF_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+#define CF_MAX_SECTIONS 4
+
+//=============================================================================
+// Scalar kernel
+//=============================================================================
+
+void biquad_bank_kernel_scalar(biquad_lane_state_t *sec,
+                               const float *const *sos, int sections,
+                               int lane_begin, int lane_end, int lanes,
+                               const float *in, float *out, size_t count) {
+    for (int k = lane_begin; k < lane_end; k++) {
+        for (size_t n = 0; n < count; n++) {
+            float x = in[n * lanes + k];
+            for (int s = 0; s < sections; s++) {
+                const float *c = sos[s];
+                biquad_lane_state_t *st = &sec[s];
+                float y = c[0] * x + c[1] * st->x1[k] + c[2] * st->x2[k]
+                        - c[4] * st->y1[k] - c[5] * st->y2[k];
+                y = WWV_DENORMAL_FLUSH(y);
+                st->x2[k] = st->x1[k];
+                st->x1[k] = x;
+                st->y2[k] = st->y1[k];
+                st->y1[k] = y;
+                x = y;
+            }
+            out[n * lanes + k] = x;
+        }
+    }
+}
+
+//=============================================================================
+// Vector kernels
+//
+// One template for every ISA: VT = vector type, W = lanes per vector.
+// State for all sections stays in registers for the whole block.
+//=============================================================================
+
+#define CF_DEFINE_KERNEL(NAME, ATTR, VT, W, LOAD, STORE, SET1, MUL, ADD, SUB)     \
+ATTR static int NAME(biquad_lane_state_t *sec, const float *const *sos,          \
+                     int sections, int lane_begin, int lanes,                    \
+                     const float *in, float *out, size_t count) {                \
+    int groups = (lanes - lane_begin) / (W);                                     \
+    for (int g = 0; g < groups; g++) {                                           \
+        int k = lane_begin + g * (W);                                            \
+        VT b0[CF_MAX_SECTIONS], b1[CF_MAX_SECTIONS], b2[CF_MAX_SECTIONS];        \
+        VT a1[CF_MAX_SECTIONS], a2[CF_MAX_SECTIONS];                             \
+        VT x1[CF_MAX_SECTIONS], x2[CF_MAX_SECTIONS];                             \
+        VT y1[CF_MAX_SECTIONS], y2[CF_MAX_SECTIONS];                             \
+        for (int s = 0; s < sections; s++) {                                     \
+            b0[s] = SET1(sos[s][0]); b1[s] = SET1(sos[s][1]);                    \
+            b2[s] = SET1(sos[s][2]);                                             \
+            a1[s] = SET1(sos[s][4]); a2[s] = SET1(sos[s][5]);                    \
+            x1[s] = LOAD(&sec[s].x1[k]); x2[s] = LOAD(&sec[s].x2[k]);            \
+            y1[s] = LOAD(&sec[s].y1[k]); y2[s] = LOAD(&sec[s].y2[k]);            \
+        }                                                                        \
+        for (size_t n = 0; n < count; n++) {                                     \
+            VT x = LOAD(&in[n * lanes + k]);                                     \
+            for (int s = 0; s < sections; s++) {                                 \
+                VT y = ADD(MUL(b0[s], x), MUL(b1[s], x1[s]));                    \
+                y = ADD(y, MUL(b2[s], x2[s]));                                   \
+                y = SUB(y, MUL(a1[s], y1[s]));                                   \
+                y = SUB(y, MUL(a2[s], y2[s]));                                   \
+                x2[s] = x1[s]; x1[s] = x;                                        \
+                y2[s] = y1[s]; y1[s] = y;                                        \
+                x = y;                                                           \
+            }                                                                    \
+            STORE(&out[n * lanes + k], x);                                       \
+        }                                                                        \
+        for (int s = 0; s < sections; s++) {                                     \
+            STORE(&sec[s].x1[k], x1[s]); STORE(&sec[s].x2[k], x2[s]);            \
+            STORE(&sec[s].y1[k], y1[s]); STORE(&sec[s].y2[k], y2[s]);            \
+        }                                                                        \
+    }                                                                            \
+    return lane_begin + groups * (W);                                            \
+}
+
+#ifdef CF_HAVE_SSE2
+CF_DEFINE_KERNEL(kernel_sse2, , __m128, 4,
+                 _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps,
+                 _mm_mul_ps, _mm_add_ps, _mm_sub_ps)
+#endif
+
+#ifdef CF_HAVE_AVX2
+CF_DEFINE_KERNEL(kernel_avx2, CF_TARGET_AVX2, __m256, 8,
+                 _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps,
+                 _mm256_mul_ps, _mm256_add_ps, _mm256_sub_ps)
+#endif
+
+#ifdef CF_HAVE_NEON
+CF_DEFINE_KERNEL(kernel_neon, , float32x4_t, 4,
+                 vld1q_f32, vst1q_f32, vdupq_n_f32,
+                 vmulq_f32, vaddq_f32, vsubq_f32)
+#endif
+
+int biquad_bank_kernel_vector(channel_simd_t level, biquad_lane_state_t *sec,
+                              const float *const *sos, int sections,
+                              int lanes, const float *in, float *out, size_t count) {
+    if (sections > CF_MAX_SECTIONS) return 0;
+
+    switch (level) {
+#ifdef CF_HAVE_AVX2
+        case CHANNEL_SIMD_AVX2: {
+            // 8-lane groups first, then a 4-lane SSE2 group if one remains
+            int done = kernel_avx2(sec, sos, sections, 0, lanes, in, out, count);
+#ifdef CF_HAVE_SSE2
+            done = kernel_sse2(sec, sos, sections, done, lanes, in, out, count);
+#endif
+            return done;
+        }
+#endif
+#ifdef CF_HAVE_SSE2
+        case CHANNEL_SIMD_SSE2:
+            return kernel_sse2(sec, sos, sections, 0, lanes, in, out, count);
+#endif
+#ifdef CF_HAVE_NEON
+        case CHANNEL_SIMD_NEON:
+            return kernel_neon(sec, sos, sections, 0, lanes, in, out, count);
+#endif
+        default:
+            return 0;
+    }
+}
+
+//=============================================================================
+// CPU Feature Detection
+//=============================================================================
+
+static int cpu_has_avx2(void) {
+#if defined(CF_HAVE_AVX2) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(CF_HAVE_AVX2) && defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 1);
+    int osxsave = (regs[2] >> 27) & 1;
+    int avx = (regs[2] >> 28) & 1;
+    if (!osxsave || !avx) return 0;
+    if ((_xgetbv(0) & 0x6) != 0x6) return 0;  // OS saves XMM+YMM state
+    __cpuidex(regs, 7, 0);
+    return (regs[1] >> 5) & 1;
+#else
+    return 0;
+#endif
+}
+
+int channel_filters_simd_supported(channel_simd_t level) {
+    switch (level) {
+        case CHANNEL_SIMD_SCALAR: return 1;
+#ifdef CF_HAVE_SSE2
+        case CHANNEL_SIMD_SSE2:   return 1;
+#endif
+#ifdef CF_HAVE_AVX2
+        case CHANNEL_SIMD_AVX2:   return cpu_has_avx2();
+#endif
+#ifdef CF_HAVE_NEON
+        case CHANNEL_SIMD_NEON:   return 1;
+#endif
+        default:                  return 0;
+    }
+}
+
+channel_simd_t channel_filters_detect_simd(void) {
+    if (channel_filters_simd_supported(CHANNEL_SIMD_AVX2)) return CHANNEL_SIMD_AVX2;
+    if (channel_filters_simd_supported(CHANNEL_SIMD_SSE2)) return CHANNEL_SIMD_SSE2;
+    if (channel_filters_simd_supported(CHANNEL_SIMD_NEON)) return CHANNEL_SIMD_NEON;
+    return CHANNEL_SIMD_SCALAR;
+}
@@ -0,0 +1,239 @@
+/**
+ * @file goertzel_bank.c
+ * @brief Multi-bin complex Goertzel bank
+ *
+ * Generalizes the single-bin helpers in subcarrier_detector.c to complex
+ * input and several bins. Per resonator and sample (real coefficient c):
+ *   s[n] = w[n]*x[n] + c*s[n-1] - s[n-2]      (I and Q independently)
+ * and after N samples
+ *   |X[k]|   = |s1 - e^{-jw} s2|
+ *   |X[N-k]| = |s1 - e^{+jw} s2|
+ * which equals the windowed FFT bin magnitude.
+ */
+
+#include "goertzel_bank.h"
+#include "wwv_arena.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+typedef struct {
+    int resonator;              /* Index into resonator arrays */
+    float sign;                 /* +1 for bin k <= N/2, -1 for N-k */
+} gb_bin_t;
+
+typedef struct {
+    int first_bin, bin_count;   /* Slice of bins[] summed for this band */
+} gb_band_t;
+
+struct goertzel_bank {
+    int block_size;
+    float hz_per_bin;
+    float inv_size;
+
+    const fft_plan_t *plan;     /* Shared window table */
+    const float *window;
+
+    /* Resonators: one per distinct min(k, N-k) */
+    int resonator_count;
+    int resonator_bin[GOERTZEL_BANK_MAX_BINS];
+    float coeff[GOERTZEL_BANK_MAX_BINS];
+    float cos_w[GOERTZEL_BANK_MAX_BINS];
+    float sin_w[GOERTZEL_BANK_MAX_BINS];
+    float s1_i[GOERTZEL_BANK_MAX_BINS], s2_i[GOERTZEL_BANK_MAX_BINS];
+    float s1_q[GOERTZEL_BANK_MAX_BINS], s2_q[GOERTZEL_BANK_MAX_BINS];
+
+    /* Output bins and bands */
+    int bin_count;
+    gb_bin_t bins[GOERTZEL_BANK_MAX_BINS];
+    int band_count;
+    gb_band_t bands[GOERTZEL_BANK_MAX_BANDS];
+    float band_energy[GOERTZEL_BANK_MAX_BANDS];
+
+    int position;               /* Samples into current frame */
+    bool frame_ready;
+};
+
+/*============================================================================
+ * Private Functions
+ *============================================================================*/
+
+static int find_or_add_resonator(goertzel_bank_t *gb, int canonical_bin) {
+    for (int r = 0; r < gb->resonator_count; r++) {
+        if (gb->resonator_bin[r] == canonical_bin) return r;
+    }
+    if (gb->resonator_count >= GOERTZEL_BANK_MAX_BINS) return -1;
+
+    int r = gb->resonator_count++;
+    double w = 2.0 * M_PI * canonical_bin / gb->block_size;
+    gb->resonator_bin[r] = canonical_bin;
+    gb->coeff[r] = (float)(2.0 * cos(w));
+    gb->cos_w[r] = (float)cos(w);
+    gb->sin_w[r] = (float)sin(w);
+    return r;
+}
+
+static bool add_bin(goertzel_bank_t *gb, int k) {
+    if (gb->bin_count >= GOERTZEL_BANK_MAX_BINS) return false;
+
+    int canonical = (k <= gb->block_size / 2) ? k : gb->block_size - k;
+    int r = find_or_add_resonator(gb, canonical);
+    if (r < 0) return false;
+
+    gb->bins[gb->bin_count].resonator = r;
+    gb->bins[gb->bin_count].sign = (k == canonical) ? 1.0f : -1.0f;
+    gb->bin_count++;
+    return true;
+}
+
+static void finish_frame(goertzel_bank_t *gb) {
+    for (int b = 0; b < gb->band_count; b++) {
+        const gb_band_t *band = &gb->bands[b];
+        float sum = 0.0f;
+
+        for (int n = band->first_bin; n < band->first_bin + band->bin_count; n++) {
+            int r = gb->bins[n].resonator;
+            float sw = gb->bins[n].sign * gb->sin_w[r];
+            /* X = s1 - (cos w - j*sign*sin w) * s2, with complex s1, s2 */
+            float re = gb->s1_i[r] - gb->cos_w[r] * gb->s2_i[r] - sw * gb->s2_q[r];
+            float im = gb->s1_q[r] - gb->cos_w[r] * gb->s2_q[r] + sw * gb->s2_i[r];
+            sum += sqrtf(re * re + im * im);
+        }
+        gb->band_energy[b] = sum * gb->inv_size;
+    }
+
+    goertzel_bank_reset(gb);
+    gb->frame_ready = true;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+goertzel_bank_t *goertzel_bank_create(int block_size, float sample_rate, fft_window_t window) {
+    if (block_size <= 1 || sample_rate <= 0.0f) return NULL;
+
+    goertzel_bank_t *gb = (goertzel_bank_t *)wwv_calloc(1, sizeof(goertzel_bank_t));
+    if (!gb) return NULL;
+
+    gb->plan = fft_plan_acquire(block_size, window);
+    if (!gb->plan) {
+        wwv_free(gb);
+        return NULL;
+    }
+    gb->window = fft_plan_get_window(gb->plan);
+    gb->block_size = block_size;
+    gb->hz_per_bin = sample_rate / block_size;
+    gb->inv_size = 1.0f / block_size;
+
+    return gb;
+}
+
+void goertzel_bank_destroy(goertzel_bank_t *gb) {
+    if (!gb) return;
+    fft_plan_release(gb->plan);
+    wwv_free(gb);
+}
+
+int goertzel_bank_add_band(goertzel_bank_t *gb, float target_freq, float bandwidth) {
+    if (!gb || gb->band_count >= GOERTZEL_BANK_MAX_BANDS) return -1;
+
+    int center_bin = (int)(target_freq / gb->hz_per_bin + 0.5f);
+    int bin_span = (int)(bandwidth / gb->hz_per_bin + 0.5f);
+    if (bin_span < 1) bin_span = 1;
+
+    gb_band_t *band = &gb->bands[gb->band_count];
+    band->first_bin = gb->bin_count;
+
+    /* Positive then negative sideband, clipped to [0, N) like the FFT path */
+    for (int side = 0; side < 2; side++) {
+        int base = side ? gb->block_size - center_bin : center_bin;
+        for (int b = -bin_span; b <= bin_span; b++) {
+            int k = base + b;
+            if (k < 0 || k >= gb->block_size) continue;
+            if (!add_bin(gb, k)) return -1;
+        }
+    }
+
+    band->bin_count = gb->bin_count - band->first_bin;
+    return gb->band_count++;
+}
+
+bool goertzel_bank_process(goertzel_bank_t *gb, float i_sample, float q_sample) {
+    if (!gb) return false;
+
+    float w = gb->window[gb->position];
+    float xi = i_sample * w;
+    float xq = q_sample * w;
+
+    for (int r = 0; r < gb->resonator_count; r++) {
+        float s0_i = xi + gb->coeff[r] * gb->s1_i[r] - gb->s2_i[r];
+        float s0_q = xq + gb->coeff[r] * gb->s1_q[r] - gb->s2_q[r];
+        gb->s2_i[r] = gb->s1_i[r];
+        gb->s2_q[r] = gb->s1_q[r];
+        gb->s1_i[r] = s0_i;
+        gb->s1_q[r] = s0_q;
+    }
+
+    gb->frame_ready = false;
+    if (++gb->position >= gb->block_size) {
+        finish_frame(gb);
+    }
+    return gb->frame_ready;
+}
+
+size_t goertzel_bank_process_block(goertzel_bank_t *gb, const float *i_samples,
+                                   const float *q_samples, size_t count) {
+    if (!gb || !i_samples || !q_samples) return 0;
+
+    size_t n = (size_t)(gb->block_size - gb->position);
+    if (n > count) n = count;
+
+    /* Resonator-outer loop keeps each resonator's state in registers */
+    const float *win = &gb->window[gb->position];
+    for (int r = 0; r < gb->resonator_count; r++) {
+        float c = gb->coeff[r];
+        float s1_i = gb->s1_i[r], s2_i = gb->s2_i[r];
+        float s1_q = gb->s1_q[r], s2_q = gb->s2_q[r];
+
+        for (size_t k = 0; k < n; k++) {
+            float s0_i = i_samples[k] * win[k] + c * s1_i - s2_i;
+            float s0_q = q_samples[k] * win[k] + c * s1_q - s2_q;
+            s2_i = s1_i; s1_i = s0_i;
+            s2_q = s1_q; s1_q = s0_q;
+        }
+
+        gb->s1_i[r] = s1_i; gb->s2_i[r] = s2_i;
+        gb->s1_q[r] = s1_q; gb->s2_q[r] = s2_q;
+    }
+
+    gb->frame_ready = false;
+    gb->position += (int)n;
+    if (gb->position >= gb->block_size) {
+        finish_frame(gb);
+    }
+    return n;
+}
+
+bool goertzel_bank_frame_ready(goertzel_bank_t *gb) {
+    return gb ? gb->frame_ready : false;
+}
+
+float goertzel_bank_get_band(goertzel_bank_t *gb, int band_id) {
+    if (!gb || band_id < 0 || band_id >= gb->band_count) return 0.0f;
+    return gb->band_energy[band_id];
+}
+
+void goertzel_bank_reset(goertzel_bank_t *gb) {
+    if (!gb) return;
+    memset(gb->s1_i, 0, sizeof(gb->s1_i));
+    memset(gb->s2_i, 0, sizeof(gb->s2_i));
+    memset(gb->s1_q, 0, sizeof(gb->s1_q));
+    memset(gb->s2_q, 0, sizeof(gb->s2_q));
+    gb->position = 0;
+    gb->frame_ready = false;
+}
@@ -0,0 +1,322 @@
+/**
+ * @file polyphase_resampler.c
+ * @brief Rational L/M polyphase FIR resampler
+ *
+ * Output n sits at upsampled position t = n * decim (units of 1/interp
+ * input sample). With j = t / interp and phase = t % interp it is
+ *
+ *   y = sum_p h[phase + interp * p] * x[j - p],   p = 0..taps_per_phase-1
+ *
+ * Branches are stored reversed so every output is a forward dot product
+ * over x[j - taps_per_phase + 1 .. j].
+ *
+ * The int16 path keeps a Q15 copy of the branches, scaled by 2^q15_shift
+ * with the shift chosen so the largest branch's |taps| sum fits 32767:
+ * the 32-bit accumulator then holds any full-scale input exactly, and the
+ * only rounding is the one back to int16 (or none, to float).
+ */
+
+#include "polyphase_resampler.h"
+#include "signal/polyphase_internal.h"
+#include "wwv_arena.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define PP_KAISER_BETA  7.857   /* ~80 dB stopband (0.1102 * (80 - 8.7)) */
+
+struct polyphase_resampler {
+    int interp;
+    int decim;
+    int taps;                   /* Per branch */
+    float *branches;            /* interp x taps, each reversed */
+
+    int hist_len;               /* taps - 1 */
+    float *bridge_i;            /* hist_len of history + up to hist_len new samples */
+    float *bridge_q;
+
+    long phase;                 /* Upsampled position of next output rel. to block start */
+
+    int16_t *branches_q15;      /* branches * 2^q15_shift */
+    int q15_shift;
+    int16_t *bridge_s16_i;      /* int16 path history, as bridge_i */
+    int16_t *bridge_s16_q;
+};
+
+/*============================================================================
+ * Filter Design
+ *============================================================================*/
+
+static double bessel_i0(double x) {
+    double sum = 1.0, term = 1.0, q = x * x / 4.0;
+    for (int k = 1; k < 50; k++) {
+        term *= q / ((double)k * (double)k);
+        sum += term;
+        if (term < sum * 1e-12) break;
+    }
+    return sum;
+}
+
+/**
+ * Prototype at the upsampled rate, split into reversed branches
+ */
+static bool design_branches(polyphase_resampler_t *r, float in_rate, float cutoff_hz) {
+    int n = r->interp * r->taps;
+    float *proto = wwv_malloc((size_t)n * sizeof(float));
+    if (!proto) return false;
+
+    /* Unity passband gain per output: the taps hit by one output sum to 1 */
+    polyphase_design_lowpass(proto, n, in_rate * (float)r->interp, cutoff_hz, (float)r->interp);
+    for (int ph = 0; ph < r->interp; ph++) {
+        float *b = &r->branches[ph * r->taps];
+        for (int p = 0; p < r->taps; p++) {
+            b[r->taps - 1 - p] = proto[ph + r->interp * p];
+        }
+    }
+    wwv_free(proto);
+    return true;
+}
+
+/**
+ * Q15 branches at the largest scale that keeps every branch's |taps| sum
+ * in 32767 (so the accumulator cannot overflow)
+ */
+static void design_branches_q15(polyphase_resampler_t *r) {
+    double l1_max = 0.0;
+    for (int ph = 0; ph < r->interp; ph++) {
+        double l1 = 0.0;
+        for (int p = 0; p < r->taps; p++) l1 += fabs(r->branches[ph * r->taps + p]);
+        if (l1 > l1_max) l1_max = l1;
+    }
+
+    int shift = 15;
+    while (shift < 30 && l1_max * ldexp(1.0, shift + 1) <= 32767.0) shift++;
+    while (shift > 0 && l1_max * ldexp(1.0, shift) > 32767.0) shift--;
+
+    for (;;) {
+        long worst = 0;
+        for (int ph = 0; ph < r->interp; ph++) {
+            long l1 = 0;
+            for (int p = 0; p < r->taps; p++) {
+                int k = ph * r->taps + p;
+                r->branches_q15[k] = (int16_t)lrint(ldexp(r->branches[k], shift));
+                l1 += labs((long)r->branches_q15[k]);
+            }
+            if (l1 > worst) worst = l1;
+        }
+        /* Rounding can push the sum back over */
+        if (worst <= 32767 || shift == 0) break;
+        shift--;
+    }
+    r->q15_shift = shift;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+void polyphase_design_lowpass(float *taps, int n, float rate, float cutoff_hz, float gain) {
+    if (!taps || n < 1 || rate <= 0.0f) return;
+
+    double fc = (double)cutoff_hz / (double)rate;
+    double mid = (n - 1) / 2.0;
+    double norm = bessel_i0(PP_KAISER_BETA);
+    double sum = 0.0;
+
+    for (int k = 0; k < n; k++) {
+        double m = k - mid;
+        double sinc = (m == 0.0) ? 2.0 * fc : sin(2.0 * M_PI * fc * m) / (M_PI * m);
+        double win = 1.0;
+        if (n > 1) {
+            double w = m / mid;
+            win = bessel_i0(PP_KAISER_BETA * sqrt(1.0 - w * w)) / norm;
+        }
+        taps[k] = (float)(sinc * win);
+        sum += taps[k];
+    }
+
+    double scale = (sum != 0.0) ? (double)gain / sum : 1.0;
+    for (int k = 0; k < n; k++) {
+        taps[k] = (float)(taps[k] * scale);
+    }
+}
+
+polyphase_resampler_t *polyphase_resampler_create(int interp, int decim, int taps_per_phase,
+                                                  float in_rate, float cutoff_hz) {
+    if (interp < 1 || decim < 1 || taps_per_phase < 1 || in_rate <= 0.0f) return NULL;
+
+    polyphase_resampler_t *r = wwv_calloc(1, sizeof(polyphase_resampler_t));
+    if (!r) return NULL;
+
+    r->interp = interp;
+    r->decim = decim;
+    r->taps = taps_per_phase;
+    r->hist_len = taps_per_phase - 1;
+
+    size_t bridge = (size_t)(2 * r->hist_len + 1);
+    r->branches = wwv_calloc((size_t)interp * taps_per_phase, sizeof(float));
+    r->bridge_i = wwv_calloc(bridge, sizeof(float));
+    r->bridge_q = wwv_calloc(bridge, sizeof(float));
+    r->branches_q15 = wwv_calloc((size_t)interp * taps_per_phase, sizeof(int16_t));
+    r->bridge_s16_i = wwv_calloc(bridge, sizeof(int16_t));
+    r->bridge_s16_q = wwv_calloc(bridge, sizeof(int16_t));
+    if (!r->branches || !r->bridge_i || !r->bridge_q ||
+        !r->branches_q15 || !r->bridge_s16_i || !r->bridge_s16_q) {
+        polyphase_resampler_destroy(r);
+        return NULL;
+    }
+
+    if (!design_branches(r, in_rate, cutoff_hz)) {
+        polyphase_resampler_destroy(r);
+        return NULL;
+    }
+    design_branches_q15(r);
+    return r;
+}
+
+void polyphase_resampler_destroy(polyphase_resampler_t *r) {
+    if (!r) return;
+    wwv_free(r->branches);
+    wwv_free(r->bridge_i);
+    wwv_free(r->bridge_q);
+    wwv_free(r->branches_q15);
+    wwv_free(r->bridge_s16_i);
+    wwv_free(r->bridge_s16_q);
+    wwv_free(r);
+}
+
+void polyphase_resampler_reset(polyphase_resampler_t *r) {
+    if (!r) return;
+    memset(r->bridge_i, 0, (size_t)r->hist_len * sizeof(float));
+    memset(r->bridge_q, 0, (size_t)r->hist_len * sizeof(float));
+    memset(r->bridge_s16_i, 0, (size_t)r->hist_len * sizeof(int16_t));
+    memset(r->bridge_s16_q, 0, (size_t)r->hist_len * sizeof(int16_t));
+    r->phase = 0;
+}
+
+size_t polyphase_resampler_max_output(const polyphase_resampler_t *r, size_t count) {
+    if (!r) return 0;
+    return (count * (size_t)r->interp + (size_t)r->decim - 1) / (size_t)r->decim;
+}
+
+size_t polyphase_resampler_process(polyphase_resampler_t *r,
+                                   const float *in_i, const float *in_q, size_t count,
+                                   float *out_i, float *out_q) {
+    if (!r || !in_i || !in_q || !out_i || !out_q || count == 0) return 0;
+
+    polyphase_dot2_fn dot = polyphase_select_kernel(channel_filters_get_simd());
+    const int h = r->hist_len;
+    const long end = (long)count * r->interp;
+    size_t edge = (count < (size_t)h) ? count : (size_t)h;
+    size_t produced = 0;
+    long t = r->phase;
+
+    /* Bridge = history followed by the first samples of this block */
+    memcpy(r->bridge_i + h, in_i, edge * sizeof(float));
+    memcpy(r->bridge_q + h, in_q, edge * sizeof(float));
+
+    for (; t < end; t += r->decim) {
+        long j = t / r->interp;
+        const float *b = &r->branches[(t % r->interp) * r->taps];
+
+        if (j < (long)edge) {
+            dot(b, r->bridge_i + j, r->bridge_q + j, r->taps, &out_i[produced], &out_q[produced]);
+        } else {
+            long s = j - h;
+            dot(b, in_i + s, in_q + s, r->taps, &out_i[produced], &out_q[produced]);
+        }
+        produced++;
+    }
+    r->phase = t - end;
+
+    /* Keep the last hist_len samples of history + block */
+    if (count >= (size_t)h) {
+        memcpy(r->bridge_i, in_i + count - h, (size_t)h * sizeof(float));
+        memcpy(r->bridge_q, in_q + count - h, (size_t)h * sizeof(float));
+    } else {
+        memmove(r->bridge_i, r->bridge_i + count, (size_t)h * sizeof(float));
+        memmove(r->bridge_q, r->bridge_q + count, (size_t)h * sizeof(float));
+    }
+
+    return produced;
+}
+
+/*============================================================================
+ * Fixed-Point Path
+ *============================================================================*/
+
+static inline int16_t q15_saturate(int32_t acc, int shift) {
+    int32_t y = shift > 0 ? (acc + (1 << (shift - 1))) >> shift : acc;
+    if (y > INT16_MAX) return INT16_MAX;
+    if (y < INT16_MIN) return INT16_MIN;
+    return (int16_t)y;
+}
+
+/* Shared by both int16 entry points: exactly one of out16 / outf is set */
+static size_t process_q15(polyphase_resampler_t *r, const int16_t *in_i, const int16_t *in_q,
+                          size_t count, int16_t *out16_i, int16_t *out16_q,
+                          float *outf_i, float *outf_q) {
+    polyphase_dot2_s16_fn dot = polyphase_select_kernel_s16(channel_filters_get_simd());
+    const int h = r->hist_len;
+    const long end = (long)count * r->interp;
+    const float to_float = (float)ldexp(1.0, -(r->q15_shift + 15));
+    size_t edge = (count < (size_t)h) ? count : (size_t)h;
+    size_t produced = 0;
+    long t = r->phase;
+
+    memcpy(r->bridge_s16_i + h, in_i, edge * sizeof(int16_t));
+    memcpy(r->bridge_s16_q + h, in_q, edge * sizeof(int16_t));
+
+    for (; t < end; t += r->decim) {
+        long j = t / r->interp;
+        const int16_t *b = &r->branches_q15[(t % r->interp) * r->taps];
+        int32_t ai, aq;
+
+        if (j < (long)edge) {
+            dot(b, r->bridge_s16_i + j, r->bridge_s16_q + j, r->taps, &ai, &aq);
+        } else {
+            long s = j - h;
+            dot(b, in_i + s, in_q + s, r->taps, &ai, &aq);
+        }
+
+        if (out16_i) {
+            out16_i[produced] = q15_saturate(ai, r->q15_shift);
+            out16_q[produced] = q15_saturate(aq, r->q15_shift);
+        } else {
+            outf_i[produced] = (float)ai * to_float;
+            outf_q[produced] = (float)aq * to_float;
+        }
+        produced++;
+    }
+    r->phase = t - end;
+
+    if (count >= (size_t)h) {
+        memcpy(r->bridge_s16_i, in_i + count - h, (size_t)h * sizeof(int16_t));
+        memcpy(r->bridge_s16_q, in_q + count - h, (size_t)h * sizeof(int16_t));
+    } else {
+        memmove(r->bridge_s16_i, r->bridge_s16_i + count, (size_t)h * sizeof(int16_t));
+        memmove(r->bridge_s16_q, r->bridge_s16_q + count, (size_t)h * sizeof(int16_t));
+    }
+
+    return produced;
+}
+
+size_t polyphase_resampler_process_s16(polyphase_resampler_t *r,
+                                       const int16_t *in_i, const int16_t *in_q, size_t count,
+                                       int16_t *out_i, int16_t *out_q) {
+    if (!r || !in_i || !in_q || !out_i || !out_q || count == 0) return 0;
+    return process_q15(r, in_i, in_q, count, out_i, out_q, NULL, NULL);
+}
+
+size_t polyphase_resampler_process_s16f(polyphase_resampler_t *r,
+                                        const int16_t *in_i, const int16_t *in_q, size_t count,
+                                        float *out_i, float *out_q) {
+    if (!r || !in_i || !in_q || !out_i || !out_q || count == 0) return 0;
+    return process_q15(r, in_i, in_q, count, NULL, NULL, out_i, out_q);
+}
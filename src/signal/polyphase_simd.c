@@ -0,0 +1,301 @@
+// FIR branch dot-product kernels for the polyphase resampler
+//
+// Both rails share the coefficient load; each kernel keeps two
+// accumulators per rail to hide add latency and finishes with a
+// horizontal sum plus a scalar tail. The int16 kernels multiply-add
+// pairs into 32-bit lanes (pmaddwd / vmlal) and are exact.
+
+#include "signal/polyphase_internal.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PP_HAVE_SSE2 1
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#define PP_HAVE_AVX2 1
+#define PP_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER)
+#define PP_HAVE_AVX2 1
+#define PP_TARGET_AVX2
+#endif
+#elif defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#define PP_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+//=============================================================================
+// Scalar kernel
+//=============================================================================
+
+void polyphase_dot2_scalar(const float *h, const float *xi, const float *xq,
+                           int n, float *yi, float *yq) {
+    float ai = 0.0f, aq = 0.0f;
+    for (int k = 0; k < n; k++) {
+        ai += h[k] * xi[k];
+        aq += h[k] * xq[k];
+    }
+    *yi = ai;
+    *yq = aq;
+}
+
+//=============================================================================
+// Vector kernels
+//=============================================================================
+
+#ifdef PP_HAVE_SSE2
+static float hsum_sse2(__m128 v) {
+    __m128 s = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return _mm_cvtss_f32(s);
+}
+
+static void dot2_sse2(const float *h, const float *xi, const float *xq,
+                      int n, float *yi, float *yq) {
+    __m128 ai0 = _mm_setzero_ps(), ai1 = _mm_setzero_ps();
+    __m128 aq0 = _mm_setzero_ps(), aq1 = _mm_setzero_ps();
+    int k = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m128 h0 = _mm_loadu_ps(h + k), h1 = _mm_loadu_ps(h + k + 4);
+        ai0 = _mm_add_ps(ai0, _mm_mul_ps(h0, _mm_loadu_ps(xi + k)));
+        ai1 = _mm_add_ps(ai1, _mm_mul_ps(h1, _mm_loadu_ps(xi + k + 4)));
+        aq0 = _mm_add_ps(aq0, _mm_mul_ps(h0, _mm_loadu_ps(xq + k)));
+        aq1 = _mm_add_ps(aq1, _mm_mul_ps(h1, _mm_loadu_ps(xq + k + 4)));
+    }
+    float ai = hsum_sse2(_mm_add_ps(ai0, ai1));
+    float aq = hsum_sse2(_mm_add_ps(aq0, aq1));
+    for (; k < n; k++) {
+        ai += h[k] * xi[k];
+        aq += h[k] * xq[k];
+    }
+    *yi = ai;
+    *yq = aq;
+}
+#endif
+
+#ifdef PP_HAVE_AVX2
+PP_TARGET_AVX2 static float hsum_avx2(__m256 v) {
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return _mm_cvtss_f32(s);
+}
+
+PP_TARGET_AVX2 static void dot2_avx2(const float *h, const float *xi, const float *xq,
+                                     int n, float *yi, float *yq) {
+    __m256 ai0 = _mm256_setzero_ps(), ai1 = _mm256_setzero_ps();
+    __m256 aq0 = _mm256_setzero_ps(), aq1 = _mm256_setzero_ps();
+    int k = 0;
+    for (; k + 16 <= n; k += 16) {
+        __m256 h0 = _mm256_loadu_ps(h + k), h1 = _mm256_loadu_ps(h + k + 8);
+        ai0 = _mm256_add_ps(ai0, _mm256_mul_ps(h0, _mm256_loadu_ps(xi + k)));
+        ai1 = _mm256_add_ps(ai1, _mm256_mul_ps(h1, _mm256_loadu_ps(xi + k + 8)));
+        aq0 = _mm256_add_ps(aq0, _mm256_mul_ps(h0, _mm256_loadu_ps(xq + k)));
+        aq1 = _mm256_add_ps(aq1, _mm256_mul_ps(h1, _mm256_loadu_ps(xq + k + 8)));
+    }
+    float ai = hsum_avx2(_mm256_add_ps(ai0, ai1));
+    float aq = hsum_avx2(_mm256_add_ps(aq0, aq1));
+    for (; k < n; k++) {
+        ai += h[k] * xi[k];
+        aq += h[k] * xq[k];
+    }
+    *yi = ai;
+    *yq = aq;
+}
+#endif
+
+#ifdef PP_HAVE_NEON
+static void dot2_neon(const float *h, const float *xi, const float *xq,
+                      int n, float *yi, float *yq) {
+    float32x4_t ai0 = vdupq_n_f32(0.0f), ai1 = vdupq_n_f32(0.0f);
+    float32x4_t aq0 = vdupq_n_f32(0.0f), aq1 = vdupq_n_f32(0.0f);
+    int k = 0;
+    for (; k + 8 <= n; k += 8) {
+        float32x4_t h0 = vld1q_f32(h + k), h1 = vld1q_f32(h + k + 4);
+        ai0 = vmlaq_f32(ai0, h0, vld1q_f32(xi + k));
+        ai1 = vmlaq_f32(ai1, h1, vld1q_f32(xi + k + 4));
+        aq0 = vmlaq_f32(aq0, h0, vld1q_f32(xq + k));
+        aq1 = vmlaq_f32(aq1, h1, vld1q_f32(xq + k + 4));
+    }
+    float32x4_t si = vaddq_f32(ai0, ai1), sq = vaddq_f32(aq0, aq1);
+    float32x2_t pi = vadd_f32(vget_low_f32(si), vget_high_f32(si));
+    float32x2_t pq = vadd_f32(vget_low_f32(sq), vget_high_f32(sq));
+    float ai = vget_lane_f32(vpadd_f32(pi, pi), 0);
+    float aq = vget_lane_f32(vpadd_f32(pq, pq), 0);
+    for (; k < n; k++) {
+        ai += h[k] * xi[k];
+        aq += h[k] * xq[k];
+    }
+    *yi = ai;
+    *yq = aq;
+}
+#endif
+
+polyphase_dot2_fn polyphase_select_kernel(channel_simd_t level) {
+    switch (level) {
+#ifdef PP_HAVE_AVX2
+        case CHANNEL_SIMD_AVX2: return dot2_avx2;
+#endif
+#ifdef PP_HAVE_SSE2
+        case CHANNEL_SIMD_SSE2: return dot2_sse2;
+#endif
+#ifdef PP_HAVE_NEON
+        case CHANNEL_SIMD_NEON: return dot2_neon;
+#endif
+        default:                return polyphase_dot2_scalar;
+    }
+}
+
+//=============================================================================
+// Fixed-point kernels
+//=============================================================================
+
+void polyphase_dot2_s16_scalar(const int16_t *h, const int16_t *xi, const int16_t *xq,
+                               int n, int32_t *yi, int32_t *yq) {
+    int32_t ai = 0, aq = 0;
+    for (int k = 0; k < n; k++) {
+        ai += (int32_t)h[k] * xi[k];
+        aq += (int32_t)h[k] * xq[k];
+    }
+    *yi = ai;
+    *yq = aq;
+}
+
+#ifdef PP_HAVE_SSE2
+static int32_t hsum_epi32_sse2(__m128i v) {
+    __m128i s = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(s);
+}
+
+static void dot2_s16_sse2(const int16_t *h, const int16_t *xi, const int16_t *xq,
+                          int n, int32_t *yi, int32_t *yq) {
+    __m128i ai0 = _mm_setzero_si128(), ai1 = _mm_setzero_si128();
+    __m128i aq0 = _mm_setzero_si128(), aq1 = _mm_setzero_si128();
+    int k = 0;
+    for (; k + 16 <= n; k += 16) {
+        __m128i h0 = _mm_loadu_si128((const __m128i *)(h + k));
+        __m128i h1 = _mm_loadu_si128((const __m128i *)(h + k + 8));
+        ai0 = _mm_add_epi32(ai0, _mm_madd_epi16(h0, _mm_loadu_si128((const __m128i *)(xi + k))));
+        ai1 = _mm_add_epi32(ai1, _mm_madd_epi16(h1, _mm_loadu_si128((const __m128i *)(xi + k + 8))));
+        aq0 = _mm_add_epi32(aq0, _mm_madd_epi16(h0, _mm_loadu_si128((const __m128i *)(xq + k))));
+        aq1 = _mm_add_epi32(aq1, _mm_madd_epi16(h1, _mm_loadu_si128((const __m128i *)(xq + k + 8))));
+    }
+    int32_t ai = hsum_epi32_sse2(_mm_add_epi32(ai0, ai1));
+    int32_t aq = hsum_epi32_sse2(_mm_add_epi32(aq0, aq1));
+    for (; k < n; k++) {
+        ai += (int32_t)h[k] * xi[k];
+        aq += (int32_t)h[k] * xq[k];
+    }
+    *yi = ai;
+    *yq = aq;
+}
+#endif
+
+#ifdef PP_HAVE_AVX2
+PP_TARGET_AVX2 static int32_t hsum_epi32_avx2(__m256i v) {
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(s);
+}
+
+PP_TARGET_AVX2 static void dot2_s16_avx2(const int16_t *h, const int16_t *xi, const int16_t *xq,
+                                         int n, int32_t *yi, int32_t *yq) {
+    __m256i ai0 = _mm256_setzero_si256(), ai1 = _mm256_setzero_si256();
+    __m256i aq0 = _mm256_setzero_si256(), aq1 = _mm256_setzero_si256();
+    int k = 0;
+    for (; k + 32 <= n; k += 32) {
+        __m256i h0 = _mm256_loadu_si256((const __m256i *)(h + k));
+        __m256i h1 = _mm256_loadu_si256((const __m256i *)(h + k + 16));
+        ai0 = _mm256_add_epi32(ai0, _mm256_madd_epi16(h0, _mm256_loadu_si256((const __m256i *)(xi + k))));
+        ai1 = _mm256_add_epi32(ai1, _mm256_madd_epi16(h1, _mm256_loadu_si256((const __m256i *)(xi + k + 16))));
+        aq0 = _mm256_add_epi32(aq0, _mm256_madd_epi16(h0, _mm256_loadu_si256((const __m256i *)(xq + k))));
+        aq1 = _mm256_add_epi32(aq1, _mm256_madd_epi16(h1, _mm256_loadu_si256((const __m256i *)(xq + k + 16))));
+    }
+    for (; k + 16 <= n; k += 16) {
+        __m256i h0 = _mm256_loadu_si256((const __m256i *)(h + k));
+        ai0 = _mm256_add_epi32(ai0, _mm256_madd_epi16(h0, _mm256_loadu_si256((const __m256i *)(xi + k))));
+        aq0 = _mm256_add_epi32(aq0, _mm256_madd_epi16(h0, _mm256_loadu_si256((const __m256i *)(xq + k))));
+    }
+    int32_t ai = hsum_epi32_avx2(_mm256_add_epi32(ai0, ai1));
+    int32_t aq = hsum_epi32_avx2(_mm256_add_epi32(aq0, aq1));
+    for (; k < n; k++) {
+        ai += (int32_t)h[k] * xi[k];
+        aq += (int32_t)h[k] * xq[k];
+    }
+    *yi = ai;
+    *yq = aq;
+}
+#endif
+
+#ifdef PP_HAVE_NEON
+static int32_t hsum_s32_neon(int32x4_t v) {
+    int32x2_t p = vadd_s32(vget_low_s32(v), vget_high_s32(v));
+    return vget_lane_s32(vpadd_s32(p, p), 0);
+}
+
+static void dot2_s16_neon(const int16_t *h, const int16_t *xi, const int16_t *xq,
+                          int n, int32_t *yi, int32_t *yq) {
+    int32x4_t ai0 = vdupq_n_s32(0), ai1 = vdupq_n_s32(0);
+    int32x4_t aq0 = vdupq_n_s32(0), aq1 = vdupq_n_s32(0);
+    int k = 0;
+    for (; k + 8 <= n; k += 8) {
+        int16x8_t hv = vld1q_s16(h + k);
+        int16x8_t iv = vld1q_s16(xi + k), qv = vld1q_s16(xq + k);
+        ai0 = vmlal_s16(ai0, vget_low_s16(hv), vget_low_s16(iv));
+        ai1 = vmlal_s16(ai1, vget_high_s16(hv), vget_high_s16(iv));
+        aq0 = vmlal_s16(aq0, vget_low_s16(hv), vget_low_s16(qv));
+        aq1 = vmlal_s16(aq1, vget_high_s16(hv), vget_high_s16(qv));
+    }
+    int32_t ai = hsum_s32_neon(vaddq_s32(ai0, ai1));
+    int32_t aq = hsum_s32_neon(vaddq_s32(aq0, aq1));
+    for (; k < n; k++) {
+        ai += (int32_t)h[k] * xi[k];
+        aq += (int32_t)h[k] * xq[k];
+    }
+    *yi = ai;
+    *yq = aq;
+}
+#endif
+
+polyphase_dot2_s16_fn polyphase_select_kernel_s16(channel_simd_t level) {
+    switch (level) {
+#ifdef PP_HAVE_AVX2
+        case CHANNEL_SIMD_AVX2: return dot2_s16_avx2;
+#endif
+#ifdef PP_HAVE_SSE2
+        case CHANNEL_SIMD_SSE2: return dot2_s16_sse2;
+#endif
+#ifdef PP_HAVE_NEON
+        case CHANNEL_SIMD_NEON: return dot2_s16_neon;
+#endif
+        default:                return polyphase_dot2_s16_scalar;
+    }
+}
+
+void polyphase_deinterleave_s16(const int16_t *iq, int16_t *out_i, int16_t *out_q, size_t count) {
+    size_t k = 0;
+#if defined(PP_HAVE_SSE2)
+    /* Each 32-bit lane is one (I, Q) pair: sign-extend both halves, repack */
+    for (; k + 8 <= count; k += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(iq + 2 * k));
+        __m128i b = _mm_loadu_si128((const __m128i *)(iq + 2 * k + 8));
+        __m128i ai = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+        __m128i bi = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+        _mm_storeu_si128((__m128i *)(out_i + k), _mm_packs_epi32(ai, bi));
+        _mm_storeu_si128((__m128i *)(out_q + k),
+                         _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16)));
+    }
+#elif defined(PP_HAVE_NEON)
+    for (; k + 8 <= count; k += 8) {
+        int16x8x2_t v = vld2q_s16(iq + 2 * k);
+        vst1q_s16(out_i + k, v.val[0]);
+        vst1q_s16(out_q + k, v.val[1]);
+    }
+#endif
+    for (; k < count; k++) {
+        out_i[k] = iq[2 * k];
+        out_q[k] = iq[2 * k + 1];
+    }
+}
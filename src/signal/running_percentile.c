@@ -0,0 +1,193 @@
+/**
+ * @file running_percentile.c
+ * @brief Two-heap sliding-window percentile
+ *
+ * Heaps store ring slot indices; slot_heap/slot_pos record where each
+ * slot currently lives so the oldest value can be overwritten and sifted
+ * without searching.
+ */
+
+#include "running_percentile.h"
+#include "wwv_arena.h"
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define HEAP_LO     0       /* Max-heap: lowest (rank + 1) values */
+#define HEAP_HI     1       /* Min-heap: everything above */
+
+struct running_percentile {
+    int window;
+    int percentile;
+
+    float *values;          /* Ring of the last `window` values */
+    int head;               /* Next slot to write (oldest once full) */
+    int count;
+
+    int *heap[2];           /* Slot indices */
+    int size[2];
+    unsigned char *slot_heap;
+    int *slot_pos;
+};
+
+/*============================================================================
+ * Heap Helpers
+ *============================================================================*/
+
+/* True if slot a belongs above slot b in heap h */
+static inline bool heap_before(const running_percentile_t *rp, int h, int a, int b) {
+    return h == HEAP_LO ? rp->values[a] > rp->values[b] : rp->values[a] < rp->values[b];
+}
+
+static inline void heap_place(running_percentile_t *rp, int h, int pos, int slot) {
+    rp->heap[h][pos] = slot;
+    rp->slot_heap[slot] = (unsigned char)h;
+    rp->slot_pos[slot] = pos;
+}
+
+static void sift_up(running_percentile_t *rp, int h, int pos) {
+    int *heap = rp->heap[h];
+    int slot = heap[pos];
+
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (!heap_before(rp, h, slot, heap[parent])) break;
+        heap_place(rp, h, pos, heap[parent]);
+        pos = parent;
+    }
+    heap_place(rp, h, pos, slot);
+}
+
+static void sift_down(running_percentile_t *rp, int h, int pos) {
+    int *heap = rp->heap[h];
+    int n = rp->size[h];
+    int slot = heap[pos];
+
+    for (;;) {
+        int child = 2 * pos + 1;
+        if (child >= n) break;
+        if (child + 1 < n && heap_before(rp, h, heap[child + 1], heap[child])) child++;
+        if (!heap_before(rp, h, heap[child], slot)) break;
+        heap_place(rp, h, pos, heap[child]);
+        pos = child;
+    }
+    heap_place(rp, h, pos, slot);
+}
+
+static void heap_push(running_percentile_t *rp, int h, int slot) {
+    int pos = rp->size[h]++;
+    heap_place(rp, h, pos, slot);
+    sift_up(rp, h, pos);
+}
+
+static int heap_pop(running_percentile_t *rp, int h) {
+    int top = rp->heap[h][0];
+    int last = rp->heap[h][--rp->size[h]];
+    if (rp->size[h] > 0) {
+        heap_place(rp, h, 0, last);
+        sift_down(rp, h, 0);
+    }
+    return top;
+}
+
+/**
+ * Restore max(lo) <= min(hi) and |lo| = rank + 1 after one value changed
+ */
+static void rebalance(running_percentile_t *rp) {
+    int rank = (rp->count * rp->percentile) / 100;
+    if (rank >= rp->count) rank = rp->count - 1;
+    if (rank < 0) rank = 0;
+
+    while (rp->size[HEAP_LO] > rank + 1) {
+        heap_push(rp, HEAP_HI, heap_pop(rp, HEAP_LO));
+    }
+    while (rp->size[HEAP_LO] < rank + 1 && rp->size[HEAP_HI] > 0) {
+        heap_push(rp, HEAP_LO, heap_pop(rp, HEAP_HI));
+    }
+
+    while (rp->size[HEAP_LO] > 0 && rp->size[HEAP_HI] > 0 &&
+           rp->values[rp->heap[HEAP_LO][0]] > rp->values[rp->heap[HEAP_HI][0]]) {
+        int lo_top = rp->heap[HEAP_LO][0];
+        int hi_top = rp->heap[HEAP_HI][0];
+        heap_place(rp, HEAP_LO, 0, hi_top);
+        heap_place(rp, HEAP_HI, 0, lo_top);
+        sift_down(rp, HEAP_LO, 0);
+        sift_down(rp, HEAP_HI, 0);
+    }
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+running_percentile_t *running_percentile_create(int window, int percentile) {
+    if (window <= 0) return NULL;
+    if (percentile < 0) percentile = 0;
+    if (percentile > 100) percentile = 100;
+
+    running_percentile_t *rp = wwv_calloc(1, sizeof(running_percentile_t));
+    if (!rp) return NULL;
+
+    rp->window = window;
+    rp->percentile = percentile;
+    rp->values = wwv_calloc((size_t)window, sizeof(float));
+    rp->heap[HEAP_LO] = wwv_calloc((size_t)window, sizeof(int));
+    rp->heap[HEAP_HI] = wwv_calloc((size_t)window, sizeof(int));
+    rp->slot_heap = wwv_calloc((size_t)window, sizeof(unsigned char));
+    rp->slot_pos = wwv_calloc((size_t)window, sizeof(int));
+
+    if (!rp->values || !rp->heap[HEAP_LO] || !rp->heap[HEAP_HI] ||
+        !rp->slot_heap || !rp->slot_pos) {
+        running_percentile_destroy(rp);
+        return NULL;
+    }
+    return rp;
+}
+
+void running_percentile_destroy(running_percentile_t *rp) {
+    if (!rp) return;
+    wwv_free(rp->values);
+    wwv_free(rp->heap[HEAP_LO]);
+    wwv_free(rp->heap[HEAP_HI]);
+    wwv_free(rp->slot_heap);
+    wwv_free(rp->slot_pos);
+    wwv_free(rp);
+}
+
+void running_percentile_reset(running_percentile_t *rp) {
+    if (!rp) return;
+    rp->head = 0;
+    rp->count = 0;
+    rp->size[HEAP_LO] = 0;
+    rp->size[HEAP_HI] = 0;
+}
+
+void running_percentile_push(running_percentile_t *rp, float value) {
+    if (!rp) return;
+
+    int slot = rp->head;
+    rp->head = (rp->head + 1) % rp->window;
+
+    if (rp->count < rp->window) {
+        rp->values[slot] = value;
+        rp->count++;
+        heap_push(rp, HEAP_LO, slot);
+    } else {
+        /* Overwrite the oldest value where it sits, then move it */
+        int h = rp->slot_heap[slot];
+        int pos = rp->slot_pos[slot];
+        rp->values[slot] = value;
+        sift_up(rp, h, pos);
+        sift_down(rp, h, rp->slot_pos[slot]);
+    }
+
+    rebalance(rp);
+}
+
+float running_percentile_get(const running_percentile_t *rp) {
+    if (!rp || rp->size[HEAP_LO] == 0) return 0.0f;
+    return rp->values[rp->heap[HEAP_LO][0]];
+}
+
+int running_percentile_count(const running_percentile_t *rp) {
+    return rp ? rp->count : 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * @file sdr_frontend.c
+ * @brief 2 MHz -> 50 kHz / 12 kHz / 2.4 kHz decimation chain
+ *
+ * Cutoffs sit midway between each stage's passband edge and the first
+ * frequency that would alias into it, so aliases land >= 80 dB down.
+ *
+ * int16 input runs the 2 MHz and 250 kHz stages in fixed point and turns
+ * to float at 50 kHz, so the 2 MHz rails move half the bytes and the two
+ * busiest dot products are integer multiply-adds.
+ */
+
+#include "sdr_frontend.h"
+#include "polyphase_resampler.h"
+#include "signal/polyphase_internal.h"
+#include "wwv_arena.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#define FE_STAGES   4
+#define FE_S16_STAGES   2       /* int16 input: stages run in fixed point */
+
+typedef struct {
+    int interp, decim, taps;
+    float in_rate;
+    float cutoff_hz;
+} fe_stage_def_t;
+
+static const fe_stage_def_t fe_stage_defs[FE_STAGES] = {
+    { 1,  8,  48, 2000000.0f, 125000.0f },  /* 2 MHz -> 250 kHz (pass 20k, alias from 230k) */
+    { 1,  5, 128,  250000.0f,  25000.0f },  /* 250 kHz -> 50 kHz (pass 20k, alias from 30k) */
+    { 6, 25, 128,   50000.0f,   6000.0f },  /* 50 kHz -> 12 kHz (pass 5k, alias from 7k) */
+    { 1,  5,  64,   12000.0f,   1200.0f },  /* 12 kHz -> 2.4 kHz (pass 600, alias from 1.8k) */
+};
+
+/* Stage whose output is each tap */
+static const int fe_tap_stage[SDR_TAP_COUNT] = { 1, 2, 3 };
+
+typedef struct {
+    polyphase_resampler_t *rs;
+    float *out_i;
+    float *out_q;
+    size_t capacity;
+} fe_stage_t;
+
+struct sdr_frontend {
+    fe_stage_t stage[FE_STAGES];
+    int16_t *in_s16_i;          /* Deinterleaved int16 chunk */
+    int16_t *in_s16_q;
+    int16_t *mid_s16_i;         /* 250 kHz int16, between the fixed-point stages */
+    int16_t *mid_s16_q;
+    sdr_frontend_sink_fn sink[SDR_TAP_COUNT];
+    void *sink_data[SDR_TAP_COUNT];
+    int last_stage;             /* Deepest stage a sink needs, -1 = none */
+};
+
+static void update_last_stage(sdr_frontend_t *fe) {
+    fe->last_stage = -1;
+    for (int t = 0; t < SDR_TAP_COUNT; t++) {
+        if (fe->sink[t] && fe_tap_stage[t] > fe->last_stage) fe->last_stage = fe_tap_stage[t];
+    }
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+sdr_frontend_t *sdr_frontend_create(void) {
+    sdr_frontend_t *fe = wwv_calloc(1, sizeof(sdr_frontend_t));
+    if (!fe) return NULL;
+
+    size_t in_count = SDR_FRONTEND_CHUNK;
+    for (int s = 0; s < FE_STAGES; s++) {
+        const fe_stage_def_t *d = &fe_stage_defs[s];
+        fe_stage_t *st = &fe->stage[s];
+
+        st->rs = polyphase_resampler_create(d->interp, d->decim, d->taps, d->in_rate, d->cutoff_hz);
+        st->capacity = polyphase_resampler_max_output(st->rs, in_count);
+        st->out_i = wwv_malloc(st->capacity * sizeof(float));
+        st->out_q = wwv_malloc(st->capacity * sizeof(float));
+        if (!st->rs || !st->out_i || !st->out_q) {
+            sdr_frontend_destroy(fe);
+            return NULL;
+        }
+        in_count = st->capacity;
+    }
+
+    fe->in_s16_i = wwv_malloc(SDR_FRONTEND_CHUNK * sizeof(int16_t));
+    fe->in_s16_q = wwv_malloc(SDR_FRONTEND_CHUNK * sizeof(int16_t));
+    fe->mid_s16_i = wwv_malloc(fe->stage[0].capacity * sizeof(int16_t));
+    fe->mid_s16_q = wwv_malloc(fe->stage[0].capacity * sizeof(int16_t));
+    if (!fe->in_s16_i || !fe->in_s16_q || !fe->mid_s16_i || !fe->mid_s16_q) {
+        sdr_frontend_destroy(fe);
+        return NULL;
+    }
+    fe->last_stage = -1;
+
+    printf("[FRONTEND] Created: 2 MHz -> 250 kHz -> 50 kHz -> 12 kHz -> 2.4 kHz, chunk=%d\n",
+           SDR_FRONTEND_CHUNK);
+    return fe;
+}
+
+void sdr_frontend_destroy(sdr_frontend_t *fe) {
+    if (!fe) return;
+    for (int s = 0; s < FE_STAGES; s++) {
+        polyphase_resampler_destroy(fe->stage[s].rs);
+        wwv_free(fe->stage[s].out_i);
+        wwv_free(fe->stage[s].out_q);
+    }
+    wwv_free(fe->in_s16_i);
+    wwv_free(fe->in_s16_q);
+    wwv_free(fe->mid_s16_i);
+    wwv_free(fe->mid_s16_q);
+    wwv_free(fe);
+}
+
+void sdr_frontend_set_sink(sdr_frontend_t *fe, sdr_frontend_tap_t tap,
+                           sdr_frontend_sink_fn sink, void *user_data) {
+    if (!fe || tap < 0 || tap >= SDR_TAP_COUNT) return;
+    fe->sink[tap] = sink;
+    fe->sink_data[tap] = user_data;
+    update_last_stage(fe);
+}
+
+static void emit_taps(sdr_frontend_t *fe, int s, size_t n) {
+    for (int t = 0; t < SDR_TAP_COUNT; t++) {
+        if (fe_tap_stage[t] == s && fe->sink[t] && n > 0) {
+            fe->sink[t](fe->stage[s].out_i, fe->stage[s].out_q, n, fe->sink_data[t]);
+        }
+    }
+}
+
+/* Float stages first..last_stage over one chunk */
+static void run_float_stages(sdr_frontend_t *fe, int first, const float *in_i,
+                             const float *in_q, size_t in_n) {
+    for (int s = first; s <= fe->last_stage && in_n > 0; s++) {
+        fe_stage_t *st = &fe->stage[s];
+        in_n = polyphase_resampler_process(st->rs, in_i, in_q, in_n, st->out_i, st->out_q);
+        in_i = st->out_i;
+        in_q = st->out_q;
+        emit_taps(fe, s, in_n);
+    }
+}
+
+void sdr_frontend_process(sdr_frontend_t *fe, const float *i_samples,
+                          const float *q_samples, size_t count) {
+    if (!fe || !i_samples || !q_samples || fe->last_stage < 0) return;
+
+    while (count > 0) {
+        size_t n = (count < SDR_FRONTEND_CHUNK) ? count : SDR_FRONTEND_CHUNK;
+        run_float_stages(fe, 0, i_samples, q_samples, n);
+
+        i_samples += n;
+        q_samples += n;
+        count -= n;
+    }
+}
+
+void sdr_frontend_process_s16(sdr_frontend_t *fe, const int16_t *iq, size_t count) {
+    if (!fe || !iq || fe->last_stage < 0) return;
+
+    /* Stage 1's output is the detector tap: fixed point ends at 50 kHz */
+    fe_stage_t *s0 = &fe->stage[0];
+    fe_stage_t *s1 = &fe->stage[1];
+
+    while (count > 0) {
+        size_t n = (count < SDR_FRONTEND_CHUNK) ? count : SDR_FRONTEND_CHUNK;
+        polyphase_deinterleave_s16(iq, fe->in_s16_i, fe->in_s16_q, n);
+
+        size_t mid_n = polyphase_resampler_process_s16(s0->rs, fe->in_s16_i, fe->in_s16_q, n,
+                                                       fe->mid_s16_i, fe->mid_s16_q);
+        size_t out_n = polyphase_resampler_process_s16f(s1->rs, fe->mid_s16_i, fe->mid_s16_q,
+                                                        mid_n, s1->out_i, s1->out_q);
+        emit_taps(fe, 1, out_n);
+        run_float_stages(fe, FE_S16_STAGES, s1->out_i, s1->out_q, out_n);
+
+        iq += 2 * n;
+        count -= n;
+    }
+}
+
+void sdr_frontend_reset(sdr_frontend_t *fe) {
+    if (!fe) return;
+    for (int s = 0; s < FE_STAGES; s++) {
+        polyphase_resampler_reset(fe->stage[s].rs);
+    }
+}
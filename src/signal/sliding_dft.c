@@ -0,0 +1,220 @@
+/**
+ * @file sliding_dft.c
+ * @brief Hann-windowed sliding DFT over a few bins
+ *
+ * Resonator r tracks the unwindowed sum over the current window, phase
+ * referenced to the newest sample (p = 0):
+ *   S(w) = sum_{p=0}^{N-1} x[n-p] e^{jwp}
+ * The Hann window 0.5 - 0.5 cos(a p) splits into three such sums, so each
+ * output bin reads three resonators. The reference only rotates the bin by
+ * a constant phase, which the magnitude drops.
+ */
+
+#include "sliding_dft.h"
+#include "wwv_window_ring.h"
+#include "wwv_arena.h"
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define SD_MAX_RESONATORS   (SLIDING_DFT_MAX_BINS * 3)
+
+typedef struct {
+    int first_bin, bin_count;   /* Slice of output bins summed for this band */
+} sd_band_t;
+
+struct sliding_dft {
+    int block_size;
+    float hz_per_bin;
+    float inv_size;
+
+    /* Resonators: bin k uses 3k (w_k), 3k+1 (w_k - a), 3k+2 (w_k + a) */
+    int resonator_count;
+    double rot_re[SD_MAX_RESONATORS], rot_im[SD_MAX_RESONATORS];    /* e^{jw} */
+    double s_re[SD_MAX_RESONATORS], s_im[SD_MAX_RESONATORS];
+    double side_re, side_im;    /* e^{ja}: e^{jwN} at w_k + a, conjugate at w_k - a */
+
+    int bin_count;
+    sd_band_t bands[SLIDING_DFT_MAX_BANDS];
+    int band_count;
+
+    wwv_window_ring_t ring_i;
+    wwv_window_ring_t ring_q;
+    int until_resync;
+};
+
+/*============================================================================
+ * Internal Helpers
+ *============================================================================*/
+
+static void add_resonator(sliding_dft_t *sd, double w) {
+    int r = sd->resonator_count++;
+    sd->rot_re[r] = cos(w);
+    sd->rot_im[r] = sin(w);
+    sd->s_re[r] = 0.0;
+    sd->s_im[r] = 0.0;
+}
+
+/* |X[k]| from its three resonators */
+static float bin_magnitude(const sliding_dft_t *sd, int bin) {
+    int r = bin * 3;
+    float re = (float)(0.5 * sd->s_re[r] - 0.25 * (sd->s_re[r + 1] + sd->s_re[r + 2]));
+    float im = (float)(0.5 * sd->s_im[r] - 0.25 * (sd->s_im[r + 1] + sd->s_im[r + 2]));
+    return sqrtf(re * re + im * im);
+}
+
+/* Recompute every resonator directly from the window */
+static void resync(sliding_dft_t *sd) {
+    const float *wi = wwv_window_ring_window(&sd->ring_i);
+    const float *wq = wwv_window_ring_window(&sd->ring_q);
+    int newest = sd->block_size - 1;
+
+    for (int r = 0; r < sd->resonator_count; r++) {
+        double re = 0.0, im = 0.0;
+        double c = 1.0, s = 0.0;            /* e^{jwp}, stepped by e^{jw} */
+        for (int p = 0; p < sd->block_size; p++) {
+            re += wi[newest - p] * c - wq[newest - p] * s;
+            im += wi[newest - p] * s + wq[newest - p] * c;
+            double next = c * sd->rot_re[r] - s * sd->rot_im[r];
+            s = c * sd->rot_im[r] + s * sd->rot_re[r];
+            c = next;
+        }
+        sd->s_re[r] = re;
+        sd->s_im[r] = im;
+    }
+    sd->until_resync = SLIDING_DFT_RESYNC;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+sliding_dft_t *sliding_dft_create(int block_size, float sample_rate) {
+    if (block_size < 2 || sample_rate <= 0.0f) return NULL;
+
+    sliding_dft_t *sd = wwv_calloc(1, sizeof(sliding_dft_t));
+    if (!sd) return NULL;
+
+    if (!wwv_window_ring_init(&sd->ring_i, block_size) ||
+        !wwv_window_ring_init(&sd->ring_q, block_size)) {
+        sliding_dft_destroy(sd);
+        return NULL;
+    }
+
+    sd->block_size = block_size;
+    sd->hz_per_bin = sample_rate / block_size;
+    sd->inv_size = 1.0f / block_size;
+    sd->side_re = cos(2.0 * M_PI / (block_size - 1));
+    sd->side_im = sin(2.0 * M_PI / (block_size - 1));
+    sd->until_resync = SLIDING_DFT_RESYNC;
+    return sd;
+}
+
+void sliding_dft_destroy(sliding_dft_t *sd) {
+    if (!sd) return;
+    wwv_window_ring_free(&sd->ring_i);
+    wwv_window_ring_free(&sd->ring_q);
+    wwv_free(sd);
+}
+
+int sliding_dft_add_band(sliding_dft_t *sd, float target_freq, float bandwidth) {
+    if (!sd || sd->band_count >= SLIDING_DFT_MAX_BANDS) return -1;
+
+    int n = sd->block_size;
+    int center_bin = (int)(target_freq / sd->hz_per_bin + 0.5f);
+    int bin_span = (int)(bandwidth / sd->hz_per_bin + 0.5f);
+    if (bin_span < 1) bin_span = 1;
+
+    /* Same ranges as fft_processor_add_band(), clipped to 0..N-1 */
+    int ranges[2][2] = {
+        { center_bin - bin_span, center_bin + bin_span },
+        { n - center_bin - bin_span, n - center_bin + bin_span }
+    };
+    int wanted = 0;
+    for (int s = 0; s < 2; s++) {
+        if (ranges[s][0] < 0) ranges[s][0] = 0;
+        if (ranges[s][1] > n - 1) ranges[s][1] = n - 1;
+        if (ranges[s][1] >= ranges[s][0]) wanted += ranges[s][1] - ranges[s][0] + 1;
+    }
+    if (sd->bin_count + wanted > SLIDING_DFT_MAX_BINS) return -1;
+
+    sd_band_t *band = &sd->bands[sd->band_count];
+    band->first_bin = sd->bin_count;
+    band->bin_count = wanted;
+
+    double a = 2.0 * M_PI / (n - 1);
+    for (int s = 0; s < 2; s++) {
+        for (int k = ranges[s][0]; k <= ranges[s][1]; k++) {
+            double w = 2.0 * M_PI * k / n;
+            add_resonator(sd, w);
+            add_resonator(sd, w - a);
+            add_resonator(sd, w + a);
+            sd->bin_count++;
+        }
+    }
+
+    /* Bring the new resonators up to the current window */
+    resync(sd);
+    return sd->band_count++;
+}
+
+void sliding_dft_push(sliding_dft_t *sd, float i_sample, float q_sample) {
+    if (!sd) return;
+
+    /* Oldest sample, about to be overwritten */
+    double old_i = sd->ring_i.data[sd->ring_i.pos];
+    double old_q = sd->ring_q.data[sd->ring_q.pos];
+    wwv_window_ring_push(&sd->ring_i, i_sample);
+    wwv_window_ring_push(&sd->ring_q, q_sample);
+
+    if (--sd->until_resync == 0) {
+        resync(sd);
+        return;
+    }
+
+    /* x[n] - e^{jwN} x[n-N] for the centre, lower and upper resonators */
+    double rot_old_re = old_i * sd->side_re, rot_old_im = old_q * sd->side_im;
+    double cross_re = old_i * sd->side_im, cross_im = old_q * sd->side_re;
+    double in_re[3] = {
+        i_sample - old_i,
+        i_sample - (rot_old_re + rot_old_im),
+        i_sample - (rot_old_re - rot_old_im)
+    };
+    double in_im[3] = {
+        q_sample - old_q,
+        q_sample - (cross_im - cross_re),
+        q_sample - (cross_im + cross_re)
+    };
+
+    for (int r = 0; r < sd->resonator_count; r += 3) {
+        for (int s = 0; s < 3; s++) {
+            double re = sd->s_re[r + s], im = sd->s_im[r + s];
+            sd->s_re[r + s] = re * sd->rot_re[r + s] - im * sd->rot_im[r + s] + in_re[s];
+            sd->s_im[r + s] = re * sd->rot_im[r + s] + im * sd->rot_re[r + s] + in_im[s];
+        }
+    }
+}
+
+float sliding_dft_get_band(const sliding_dft_t *sd, int band_id) {
+    if (!sd || band_id < 0 || band_id >= sd->band_count) return 0.0f;
+
+    const sd_band_t *band = &sd->bands[band_id];
+    float sum = 0.0f;
+    for (int b = 0; b < band->bin_count; b++) {
+        sum += bin_magnitude(sd, band->first_bin + b);
+    }
+    return sum * sd->inv_size;
+}
+
+void sliding_dft_reset(sliding_dft_t *sd) {
+    if (!sd) return;
+    wwv_window_ring_reset(&sd->ring_i);
+    wwv_window_ring_reset(&sd->ring_q);
+    for (int r = 0; r < sd->resonator_count; r++) {
+        sd->s_re[r] = 0.0;
+        sd->s_im[r] = 0.0;
+    }
+    sd->until_resync = SLIDING_DFT_RESYNC;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file sliding_sum.c
+ * @brief Shared-ring sliding sums with compensated accumulation
+ */
+
+#include "sliding_sum.h"
+#include "wwv_arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    int length;
+    int count;                  /* Values in window, saturates at length */
+    double sum;
+    double comp;                /* Kahan compensation */
+} ss_window_t;
+
+struct sliding_sum {
+    float *history;             /* Ring of the last capacity values */
+    int capacity;
+    int pos;                    /* Next write slot */
+    int since_renorm;
+
+    int window_count;
+    ss_window_t windows[SLIDING_SUM_MAX_WINDOWS];
+};
+
+/*============================================================================
+ * Private Functions
+ *============================================================================*/
+
+static void kahan_add(ss_window_t *w, double x) {
+    double y = x - w->comp;
+    double t = w->sum + y;
+    w->comp = (t - w->sum) - y;
+    w->sum = t;
+}
+
+/**
+ * Exact sum of the newest w->count values (pos already advanced)
+ */
+static void renormalize(sliding_sum_t *ss, ss_window_t *w) {
+    double sum = 0.0;
+    int idx = ss->pos;
+    for (int k = 0; k < w->count; k++) {
+        idx = (idx == 0) ? ss->capacity - 1 : idx - 1;
+        sum += ss->history[idx];
+    }
+    w->sum = sum;
+    w->comp = 0.0;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+sliding_sum_t *sliding_sum_create(int capacity) {
+    if (capacity <= 0) return NULL;
+
+    sliding_sum_t *ss = (sliding_sum_t *)wwv_calloc(1, sizeof(sliding_sum_t));
+    if (!ss) return NULL;
+
+    ss->history = (float *)wwv_calloc((size_t)capacity, sizeof(float));
+    if (!ss->history) {
+        wwv_free(ss);
+        return NULL;
+    }
+    ss->capacity = capacity;
+    return ss;
+}
+
+void sliding_sum_destroy(sliding_sum_t *ss) {
+    if (!ss) return;
+    wwv_free(ss->history);
+    wwv_free(ss);
+}
+
+void sliding_sum_reset(sliding_sum_t *ss) {
+    if (!ss) return;
+    memset(ss->history, 0, (size_t)ss->capacity * sizeof(float));
+    ss->pos = 0;
+    ss->since_renorm = 0;
+    for (int w = 0; w < ss->window_count; w++) {
+        ss->windows[w].count = 0;
+        ss->windows[w].sum = 0.0;
+        ss->windows[w].comp = 0.0;
+    }
+}
+
+int sliding_sum_add_window(sliding_sum_t *ss, int length) {
+    if (!ss || length <= 0 || length > ss->capacity) return -1;
+    if (ss->window_count >= SLIDING_SUM_MAX_WINDOWS) return -1;
+
+    ss_window_t *w = &ss->windows[ss->window_count];
+    memset(w, 0, sizeof(*w));
+    w->length = length;
+    return ss->window_count++;
+}
+
+void sliding_sum_push(sliding_sum_t *ss, float value) {
+    if (!ss) return;
+
+    /* Each full window drops the value `length` pushes back */
+    for (int i = 0; i < ss->window_count; i++) {
+        ss_window_t *w = &ss->windows[i];
+        double x = value;
+        if (w->count >= w->length) {
+            int old = ss->pos - w->length;
+            if (old < 0) old += ss->capacity;
+            x -= ss->history[old];
+        } else {
+            w->count++;
+        }
+        kahan_add(w, x);
+    }
+
+    ss->history[ss->pos] = value;
+    if (++ss->pos == ss->capacity) ss->pos = 0;
+
+    if (++ss->since_renorm >= SLIDING_SUM_RENORM) {
+        ss->since_renorm = 0;
+        for (int i = 0; i < ss->window_count; i++) {
+            renormalize(ss, &ss->windows[i]);
+        }
+    }
+}
+
+float sliding_sum_get(const sliding_sum_t *ss, int window) {
+    if (!ss || window < 0 || window >= ss->window_count) return 0.0f;
+    return (float)ss->windows[window].sum;
+}
+
+float sliding_sum_get_mean(const sliding_sum_t *ss, int window) {
+    if (!ss || window < 0 || window >= ss->window_count) return 0.0f;
+    const ss_window_t *w = &ss->windows[window];
+    return (w->count > 0) ? (float)(w->sum / w->count) : 0.0f;
+}
+
+int sliding_sum_get_count(const sliding_sum_t *ss, int window) {
+    if (!ss || window < 0 || window >= ss->window_count) return 0;
+    return ss->windows[window].count;
+}
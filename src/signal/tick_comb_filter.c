@@ -1,4 +1,5 @@
 #include "tick_comb_filter.h"
+#include "wwv_arena.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -11,12 +12,12 @@ void comb_init(comb_filter_t *cf) {
 }
 
 comb_filter_t *comb_create(void) {
-    comb_filter_t *cf = (comb_filter_t *)calloc(1, sizeof(comb_filter_t));
+    comb_filter_t *cf = (comb_filter_t *)wwv_calloc(1, sizeof(comb_filter_t));
     if (!cf) return NULL;
 
-    cf->delay_line = (float *)calloc(COMB_STAGES, sizeof(float));
+    cf->delay_line = (float *)wwv_calloc(COMB_STAGES, sizeof(float));
     if (!cf->delay_line) {
-        free(cf);
+        wwv_free(cf);
         return NULL;
     }
 
@@ -44,7 +45,7 @@ void comb_reset(comb_filter_t *cf) {
 void comb_destroy(comb_filter_t *cf) {
     if (!cf) return;
     if (cf->delay_line) {
-        free(cf->delay_line);
+        wwv_free(cf->delay_line);
     }
-    free(cf);
+    wwv_free(cf);
 }
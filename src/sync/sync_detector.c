@@ -10,6 +10,11 @@
 #include "wwv_clock.h"
 #include "version.h"
 #include "telemetry.h"
+#include "telemetry_wire.h"
+#include "wwv_thread.h"
+#include "wwv_csv_log.h"
+#include "wwv_arena.h"
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -63,26 +68,68 @@
 #define P_MARKER_TOLERANCE_MS        200.0f
 #define LEAP_SECOND_EXTRA_MS         1000.0f
 
+/* Deadlines (timer wheel or polling) */
+#define SYNC_CHECK_INTERVAL_MS       100.0      /* Poll period the decay rates are given per */
+#define MARKER_EXPECT_WINDOW_MS      5000.0     /* Pulse, detector lag and pending timeout after a :59 hole */
+
 /* Debounce */
 #define MIN_TICKS_FOR_HOLE           20
 #define SIGNAL_WEAK_DEBOUNCE         3
 
+/* Resume and warm start */
+#define SYNC_RESTORE_MARGIN          0.9f       /* Confidence cap, fraction of the LOCKED threshold */
+
+/* EVIDENCE_TICK .. EVIDENCE_TICK_HOLE */
+#define SYNC_EVIDENCE_KINDS          4
+
+/* Fast acquisition (batch second-of-minute search) */
+#define FAST_ACQ_MAX_TICKS           64         /* Ticks held, about one minute */
+#define FAST_ACQ_MAX_PULSES          16         /* P-markers and minute markers held */
+#define FAST_ACQ_MAX_SECONDS         64         /* Grid seconds searched */
+#define FAST_ACQ_WINDOW_MS           62000.0    /* Events older than this are dropped */
+#define FAST_ACQ_MIN_SPAN_MS         4000.0     /* Span before the first search */
+#define FAST_ACQ_PHASE_TOLERANCE_MS  40.0f      /* Tick inlier window around the second phase */
+#define FAST_ACQ_MIN_SCORE           5.0f       /* Best hypothesis score to accept */
+#define FAST_ACQ_MIN_MARGIN          3.0f       /* ...and its lead over the runner-up */
+#define FAST_ACQ_MAX_CONTRADICTIONS  2          /* Ticks in predicted holes before reacquiring */
+
+/* Hypothesis scores per grid second */
+#define FAST_SCORE_HOLE              2.0f       /* No tick where none is sent (:00, :29, :59) */
+#define FAST_SCORE_HOLE_TICK        -1.5f       /* A tick where none is sent (tone-edge false ticks happen) */
+#define FAST_SCORE_MARKER            3.0f       /* Minute marker at :00 (negated elsewhere) */
+#define FAST_SCORE_P_MARKER          1.0f       /* P-marker at :09..:59 step 10 (negated elsewhere) */
+
 /*============================================================================
  * Internal State
  *============================================================================*/
 
 typedef struct {
     int consecutive_tick_count;
-    float last_tick_ms;
-    float prev_hole_ms;
-    float last_hole_ms;
+    double last_tick_ms;
+    double prev_hole_ms;
+    double last_hole_ms;
     int hole_count;
 } tick_gap_tracker_t;
 
+/* Events held for the batch search while ACQUIRING */
+typedef struct {
+    bool enabled;
+    bool anchored;                  /* TENTATIVE anchor came from the search, no marker yet */
+    int tick_count;
+    int pulse_count;
+    double ticks_ms[FAST_ACQ_MAX_TICKS];
+    double pulses_ms[FAST_ACQ_MAX_PULSES];      /* Pulse leading edges */
+    bool pulse_is_marker[FAST_ACQ_MAX_PULSES];  /* Minute marker, else P-marker */
+    int contradictions;
+    uint32_t anchors;
+    uint32_t rejected_anchors;
+} fast_acq_t;
+
 typedef struct {
-    float retained_anchor_ms;
-    float signal_lost_ms;
-    float recovery_start_ms;
+    double retained_anchor_ms;
+    double retained_tick_ms;        /* Last tick before the loss: second phase */
+    double signal_lost_ms;
+    double recovery_start_ms;
     bool has_retained_state;
     bool recovery_tick_seen;
     bool recovery_marker_seen;
@@ -90,54 +137,78 @@ typedef struct {
 } recovery_state_t;
 
 struct sync_detector {
-    /* Legacy pending events (backward compat) */
-    float pending_tick_ms;
-    float pending_tick_duration_ms;
-    float pending_tick_corr_ratio;
-    bool tick_pending;
-    float pending_marker_ms;
-    float pending_marker_energy;
-    float pending_marker_duration_ms;
-    bool marker_pending;
-
-    /* Confirmed markers */
-    float last_confirmed_ms;
-    float prev_confirmed_ms;
-    int confirmed_count;
-    int good_intervals;
-
-    /* Enhanced state */
-    sync_state_t state;
+    /*------------------------------------------------------------------
+     * Hot: every tick event and periodic check (gap tracking, evidence,
+     * decay). Two cache lines, checked below.
+     *------------------------------------------------------------------*/
+    _Alignas(WWV_CACHE_LINE) sync_state_t state;
     float confidence;
     uint32_t evidence_mask;
-    float minute_anchor_ms;         /* Authoritative minute boundary */
+    int signal_weak_count;
+    double last_decay_ms;           /* Stream time confidence was last decayed to */
 
     /* Tick gap tracking */
     tick_gap_tracker_t tick_gap;
 
+    double last_confirmed_ms;
+    wwv_clock_t *wwv_clock;         /* Optional: special-minute discount */
+
+    /* Evidence tunables read per event */
+    float weight_tick;                      /* Tick evidence weight (0.01-0.2, default 0.05) */
+    float weight_marker;                    /* Marker evidence weight (0.1-0.6, default 0.40) */
+    float weight_p_marker;                  /* P-marker evidence weight (0.05-0.3, default 0.15) */
+    float weight_tick_hole;                 /* Tick hole evidence weight (0.05-0.4, default 0.20) */
+    float confidence_locked_threshold;      /* Threshold to reach LOCKED (0.5-0.9, default 0.70) */
+    float confidence_decay_normal;          /* Normal decay rate (0.99-0.9999, default 0.9999) */
+    float confidence_decay_recovering;      /* Recovery mode decay (0.90-0.99, default 0.980) */
+
+    /* Statistics */
+    uint32_t evidence_counts[SYNC_EVIDENCE_KINDS];     /* apply_evidence() per EVIDENCE_* bit */
+
+    /*------------------------------------------------------------------
+     * Cold: marker confirmation, recovery, setup
+     *------------------------------------------------------------------*/
+
+    /* Confirmed markers */
+    _Alignas(WWV_CACHE_LINE) double prev_confirmed_ms;
+    int confirmed_count;
+    int good_intervals;
+    double minute_anchor_ms;        /* Authoritative minute boundary */
+
     /* Recovery state */
     recovery_state_t recovery;
 
+    /* Fast acquisition */
+    fast_acq_t fast;
+
     /* Signal loss detection */
-    int signal_weak_count;
     bool expecting_marker_soon;
-    float expected_marker_ms;
+    double expected_marker_ms;
+
+    /* Deadlines, when driven by a timer wheel */
+    wwv_timer_wheel_t *timers;
+    wwv_timer_t check_timer;        /* Signal loss while LOCKED, timeouts while RECOVERING */
+    wwv_timer_t pending_timer;      /* Single-source marker confirmation */
+    wwv_timer_t expect_timer;       /* Marker after a :59 tick hole */
+    bool suspended;                 /* Input paused (sync_detector_suspend()) */
+    double resumed_ms;              /* Input back: signal loss counts from here too */
+
+    /* Legacy pending events (backward compat) */
+    double pending_tick_ms;
+    float pending_tick_duration_ms;
+    float pending_tick_corr_ratio;
+    bool tick_pending;
+    double pending_marker_ms;
+    float pending_marker_energy;
+    float pending_marker_duration_ms;
+    bool marker_pending;
 
-    /* Optional integrations */
-    wwv_clock_t *wwv_clock;
     bool leap_second_pending;
 
     /* Tunable parameters (runtime adjustable via UDP commands) */
-    float weight_tick;                      /* Tick evidence weight (0.01-0.2, default 0.05) */
-    float weight_marker;                    /* Marker evidence weight (0.1-0.6, default 0.40) */
-    float weight_p_marker;                  /* P-marker evidence weight (0.05-0.3, default 0.15) */
-    float weight_tick_hole;                 /* Tick hole evidence weight (0.05-0.4, default 0.20) */
     float weight_combined_hole_marker;      /* Combined hole+marker weight (0.2-0.8, default 0.50) */
-    float confidence_locked_threshold;      /* Threshold to reach LOCKED (0.5-0.9, default 0.70) */
     float confidence_min_retain;            /* Minimum to keep state (0.01-0.2, default 0.05) */
     float confidence_tentative_init;        /* Initial tentative confidence (0.1-0.5, default 0.30) */
-    float confidence_decay_normal;          /* Normal decay rate (0.99-0.9999, default 0.9999) */
-    float confidence_decay_recovering;      /* Recovery mode decay (0.90-0.99, default 0.980) */
     float tick_phase_tolerance_ms;          /* Tick timing tolerance (50.0-200.0, default 100.0) */
     float marker_tolerance_ms;              /* Marker timing tolerance (200.0-800.0, default 500.0) */
     float p_marker_tolerance_ms;            /* P-marker timing tolerance (100.0-400.0, default 200.0) */
@@ -149,11 +220,19 @@ struct sync_detector {
     /* UI feedback */
     int flash_frames_remaining;
 
+    /* Statistics */
+    uint32_t transitions;
+    uint32_t full_resets;
+
     /* Logging */
-    FILE *csv_file;
+    wwv_csv_log_t *csv_log;
+    telem_ctx_t *telem;    /* Telemetry destination, NULL = default context */
     time_t start_time;
 };
 
+_Static_assert(offsetof(struct sync_detector, prev_confirmed_ms) <= 2 * WWV_CACHE_LINE,
+               "sync_detector per-event fields no longer fit in two cache lines");
+
 /*============================================================================
  * Internal Functions
  *============================================================================*/
@@ -162,36 +241,55 @@ struct sync_detector {
 static void transition_state(sync_detector_t *sd, sync_state_t new_state);
 static void apply_evidence(sync_detector_t *sd, uint32_t evidence_type, float weight);
 static float get_evidence_weight(sync_detector_t *sd, uint32_t evidence_type);
-static void sync_detector_hole_detected(sync_detector_t *sd, float hole_timestamp_ms);
+static void sync_detector_hole_detected(sync_detector_t *sd, double hole_timestamp_ms);
 static void sync_detector_full_reset(sync_detector_t *sd);
+static void schedule_checks(sync_detector_t *sd);
+
+static time_t get_wall_time(sync_detector_t *sd, double timestamp_ms) {
+    return sd->start_time + (time_t)(timestamp_ms / 1000.0f);
+}
 
-static void get_wall_time_str(sync_detector_t *sd, float timestamp_ms, char *buf, size_t buflen) {
-    time_t event_time = sd->start_time + (time_t)(timestamp_ms / 1000.0f);
-    struct tm *tm_info = localtime(&event_time);
+static void get_wall_time_str(sync_detector_t *sd, double timestamp_ms, char *buf, size_t buflen) {
+    time_t event_time = get_wall_time(sd, timestamp_ms);
+    struct tm *tm_info = wwv_localtime(&event_time);
     strftime(buf, buflen, "%H:%M:%S", tm_info);
 }
 
-static void log_confirmed_marker(sync_detector_t *sd, float timestamp_ms,
+static void log_confirmed_marker(sync_detector_t *sd, double timestamp_ms,
                                   float interval_ms, float delta_ms,
                                   const char *source) {
-    if (!sd->csv_file) return;
+    if (!sd->csv_log) return;
+
+    wwv_csv_log_row_at(sd->csv_log, get_wall_time(sd, timestamp_ms),
+                       "%.1f,%d,%s,%.1f,%.0f,%.1f,%.1f\n",
+                       timestamp_ms,
+                       sd->confirmed_count,
+                       sync_state_name(sd->state),
+                       interval_ms / 1000.0f,
+                       delta_ms,
+                       sd->pending_tick_duration_ms,
+                       sd->pending_marker_duration_ms);
+
+    /* UDP telemetry broadcast - expanded format */
+    if (telem_ctx_binary_active(sd->telem, TELEM_SYNC)) {
+        telem_rec_sync_t rec = {
+            .confirmed_count = (uint32_t)sd->confirmed_count,
+            .state = (uint8_t)sd->state,
+            .good_intervals = (uint16_t)sd->good_intervals,
+            .interval_sec = interval_ms / 1000.0f,
+            .delta_ms = delta_ms,
+            .tick_duration_ms = sd->pending_tick_duration_ms,
+            .marker_duration_ms = sd->pending_marker_duration_ms,
+            .last_confirmed_ms = (float)sd->last_confirmed_ms
+        };
+        telem_ctx_send_record(sd->telem, TELEM_SYNC, TELEM_REC_SYNC, (uint32_t)get_wall_time(sd, timestamp_ms),
+                          telem_ms_to_us(timestamp_ms), &rec, sizeof(rec));
+        return;
+    }
 
     char time_str[16];
     get_wall_time_str(sd, timestamp_ms, time_str, sizeof(time_str));
-
-    fprintf(sd->csv_file, "%s,%.1f,%d,%s,%.1f,%.0f,%.1f,%.1f\n",
-            time_str,
-            timestamp_ms,
-            sd->confirmed_count,
-            sync_state_name(sd->state),
-            interval_ms / 1000.0f,
-            delta_ms,
-            sd->pending_tick_duration_ms,
-            sd->pending_marker_duration_ms);
-    fflush(sd->csv_file);
-
-    /* UDP telemetry broadcast - expanded format */
-    telem_sendf(TELEM_SYNC, "%s,%.1f,%d,%s,%d,%.1f,%.0f,%.1f,%.1f,%.1f",
+    telem_ctx_sendf(sd->telem, TELEM_SYNC, "%s,%.1f,%d,%s,%d,%.1f,%.0f,%.1f,%.1f,%.1f",
                 time_str, timestamp_ms, sd->confirmed_count,
                 sync_state_name(sd->state), sd->good_intervals,
                 interval_ms / 1000.0f, delta_ms,
@@ -199,7 +297,7 @@ static void log_confirmed_marker(sync_detector_t *sd, float timestamp_ms,
                 sd->last_confirmed_ms);
 }
 
-static void confirm_marker(sync_detector_t *sd, float marker_time, float delta_ms, const char *source) {
+static void confirm_marker(sync_detector_t *sd, double marker_time, float delta_ms, const char *source) {
     /* Calculate interval from previous marker */
     float interval_ms = (sd->last_confirmed_ms > 0) ?
         (marker_time - sd->last_confirmed_ms) : 0.0f;
@@ -220,7 +318,9 @@ static void confirm_marker(sync_detector_t *sd, float marker_time, float delta_m
         sd->prev_confirmed_ms = sd->last_confirmed_ms;
         sd->last_confirmed_ms = marker_time;
         sd->minute_anchor_ms = marker_time;  /* Set authoritative anchor */
+        sd->fast.anchored = false;
         sd->confirmed_count++;
+        if (sd->state == SYNC_RECOVERING) sd->recovery.recovery_marker_seen = true;
 
         /* Track good intervals for lock confidence */
         if (interval_ms >= MARKER_INTERVAL_MIN_MS &&
@@ -233,7 +333,7 @@ static void confirm_marker(sync_detector_t *sd, float marker_time, float delta_m
 
         /* Check if marker confirms :59 tick hole */
         if (sd->expecting_marker_soon) {
-            float delta_from_expected = fabsf(marker_time - sd->expected_marker_ms);
+            float delta_from_expected = (float)fabs(marker_time - sd->expected_marker_ms);
             if (delta_from_expected < 200.0f) {
                 printf("[SYNC] Marker confirms :59 tick hole - high confidence\n");
                 weight = WEIGHT_COMBINED_HOLE_MARKER;
@@ -258,6 +358,9 @@ static void confirm_marker(sync_detector_t *sd, float marker_time, float delta_m
         printf("[SYNC] *** CONFIRMED MARKER #%d *** src=%s delta=%.0fms interval=%.1fs state=%s conf=%.2f\n",
                sd->confirmed_count, source, delta_ms, interval_ms / 1000.0f,
                sync_state_name(sd->state), sd->confidence);
+
+        /* The signal-loss deadline moves with the last confirmed marker */
+        schedule_checks(sd);
     } else {
         printf("[SYNC] Marker rejected (%s): interval=%.1fs (out of range)\n",
                source, interval_ms / 1000.0f);
@@ -268,12 +371,12 @@ static void confirm_marker(sync_detector_t *sd, float marker_time, float delta_m
     sd->marker_pending = false;
 }
 
-static void try_correlate(sync_detector_t *sd, float current_ms) {
+static void try_correlate(sync_detector_t *sd, double current_ms) {
     /* Accept EITHER detector firing - no longer require both */
 
     /* If both are pending, check correlation and use the better source */
     if (sd->tick_pending && sd->marker_pending) {
-        float delta = fabsf(sd->pending_marker_ms - sd->pending_tick_ms);
+        float delta = (float)fabs(sd->pending_marker_ms - sd->pending_tick_ms);
         if (delta < CORRELATION_WINDOW_MS) {
             /* Both detectors agree - use tick detector timestamp (more precise) */
             confirm_marker(sd, sd->pending_tick_ms, delta, "BOTH");
@@ -292,7 +395,7 @@ static void try_correlate(sync_detector_t *sd, float current_ms) {
     /* The timeout handler will confirm if partner doesn't arrive */
 }
 
-static void check_timeout(sync_detector_t *sd, float current_ms) {
+static void check_timeout(sync_detector_t *sd, double current_ms) {
     /* If a single detector fired and partner didn't arrive, confirm from single source */
     if (sd->tick_pending && !sd->marker_pending &&
         (current_ms - sd->pending_tick_ms) > PENDING_TIMEOUT_MS) {
@@ -331,6 +434,9 @@ static float get_evidence_weight(sync_detector_t *sd, uint32_t evidence_type) {
 
 static void apply_evidence(sync_detector_t *sd, uint32_t evidence_type, float weight) {
     sd->evidence_mask |= evidence_type;
+    for (int k = 0; k < SYNC_EVIDENCE_KINDS; k++) {
+        if (evidence_type & (1u << k)) sd->evidence_counts[k]++;
+    }
 
     /* Boost confidence asymptotically toward 1.0 */
     sd->confidence += weight * (1.0f - sd->confidence);
@@ -347,6 +453,7 @@ static void transition_state(sync_detector_t *sd, sync_state_t new_state) {
 
     sync_state_t old_state = sd->state;
     sd->state = new_state;
+    sd->transitions++;
 
     /* State-specific initialization */
     switch (new_state) {
@@ -371,16 +478,28 @@ static void transition_state(sync_detector_t *sd, sync_state_t new_state) {
            sync_state_name(old_state), sync_state_name(new_state), sd->confidence);
 
     /* UDP telemetry */
-    telem_sendf(TELEM_SYNC, "STATE,%s,%s,%.2f",
-                sync_state_name(old_state), sync_state_name(new_state), sd->confidence);
+    if (telem_ctx_binary_active(sd->telem, TELEM_SYNC)) {
+        telem_rec_sync_state_t rec = {
+            .old_state = (uint8_t)old_state,
+            .new_state = (uint8_t)new_state,
+            .confidence = sd->confidence
+        };
+        telem_ctx_send_record(sd->telem, TELEM_SYNC, TELEM_REC_SYNC_STATE, (uint32_t)time(NULL),
+                          0, &rec, sizeof(rec));
+    } else {
+        telem_ctx_sendf(sd->telem, TELEM_SYNC, "STATE,%s,%s,%.2f",
+                    sync_state_name(old_state), sync_state_name(new_state), sd->confidence);
+    }
 
     /* User callback */
     if (sd->state_callback) {
         sd->state_callback(old_state, new_state, sd->confidence, sd->state_callback_user_data);
     }
+
+    schedule_checks(sd);
 }
 
-static void sync_detector_hole_detected(sync_detector_t *sd, float hole_timestamp_ms) {
+static void sync_detector_hole_detected(sync_detector_t *sd, double hole_timestamp_ms) {
     int probable_second = -1;
 
     /* Determine position if locked */
@@ -397,6 +516,10 @@ static void sync_detector_hole_detected(sync_detector_t *sd, float hole_timestam
             probable_second = 59;
             sd->expecting_marker_soon = true;
             sd->expected_marker_ms = hole_timestamp_ms + 1000.0f;
+            if (sd->timers) {
+                wwv_timer_arm_after_ms(sd->timers, &sd->expect_timer,
+                                       sd->expected_marker_ms + MARKER_EXPECT_WINDOW_MS);
+            }
         }
     }
 
@@ -421,8 +544,294 @@ static void sync_detector_hole_detected(sync_detector_t *sd, float hole_timestam
     }
 }
 
+/*============================================================================
+ * Deadlines
+ *
+ * Without a timer wheel the caller polls sync_detector_periodic_check().
+ * With one, the detector arms a timer for the next moment anything in it
+ * can change: the marker-gap limit while LOCKED (then its debounce steps),
+ * the earliest of retention expiry, recovery timeout and confidence
+ * decaying below the retain floor while RECOVERING. Decay is applied per
+ * elapsed time, so the kind and rate of calls do not change it.
+ *============================================================================*/
+
+static void decay_confidence(sync_detector_t *sd, double now_ms) {
+    if (now_ms <= sd->last_decay_ms) return;
+
+    float rate = (sd->state == SYNC_RECOVERING) ?
+                 sd->confidence_decay_recovering : sd->confidence_decay_normal;
+    sd->confidence *= (float)pow(rate, (now_ms - sd->last_decay_ms) / SYNC_CHECK_INTERVAL_MS);
+    sd->last_decay_ms = now_ms;
+}
+
+static void schedule_checks(sync_detector_t *sd) {
+    if (!sd->timers || sd->suspended) return;
+
+    double due_ms = -1.0;
+    if (sd->state == SYNC_LOCKED && sd->last_confirmed_ms > 0) {
+        due_ms = fmax(sd->last_confirmed_ms, sd->resumed_ms) + MARKER_GAP_CRITICAL_MS +
+                 sd->signal_weak_count * SYNC_CHECK_INTERVAL_MS;
+    } else if (sd->state == SYNC_RECOVERING) {
+        due_ms = sd->recovery.signal_lost_ms + SYNC_RETENTION_WINDOW_MS;
+        if (!sd->recovery.recovery_tick_seen && !sd->recovery.recovery_marker_seen) {
+            due_ms = fmin(due_ms, sd->recovery.recovery_start_ms + SYNC_RECOVERY_TIMEOUT_MS);
+        }
+        float rate = sd->confidence_decay_recovering;
+        if (sd->confidence <= CONFIDENCE_MIN_RETAIN ||
+            (sd->recovery.recovery_tick_seen && sd->recovery.recovery_marker_seen)) {
+            due_ms = sd->last_decay_ms;
+        } else if (rate > 0.0f && rate < 1.0f) {
+            double steps = log(CONFIDENCE_MIN_RETAIN / sd->confidence) / log(rate);
+            due_ms = fmin(due_ms, sd->last_decay_ms + steps * SYNC_CHECK_INTERVAL_MS);
+        }
+    }
+
+    if (due_ms < 0.0) {
+        wwv_timer_cancel(sd->timers, &sd->check_timer);
+    } else {
+        wwv_timer_arm_after_ms(sd->timers, &sd->check_timer, due_ms);
+    }
+}
+
+static void on_check_timer(wwv_timer_t *timer, double now_ms, void *user_data) {
+    (void)timer;
+    sync_detector_periodic_check((sync_detector_t *)user_data, now_ms);
+}
+
+static void on_pending_timer(wwv_timer_t *timer, double now_ms, void *user_data) {
+    sync_detector_t *sd = (sync_detector_t *)user_data;
+    (void)timer;
+    decay_confidence(sd, now_ms);
+    check_timeout(sd, now_ms);
+}
+
+static void on_expect_timer(wwv_timer_t *timer, double now_ms, void *user_data) {
+    sync_detector_t *sd = (sync_detector_t *)user_data;
+    (void)timer;
+    if (!sd->expecting_marker_soon) return;
+    printf("[SYNC] No marker confirmed after :59 tick hole (%.0fms)\n", now_ms);
+    sd->expecting_marker_soon = false;
+}
+
+/* A single-source marker is confirmed once its partner can no longer arrive */
+static void schedule_pending(sync_detector_t *sd, double timestamp_ms) {
+    if (sd->timers) {
+        wwv_timer_arm_after_ms(sd->timers, &sd->pending_timer, timestamp_ms + PENDING_TIMEOUT_MS);
+    }
+}
+
+/*============================================================================
+ * Fast Acquisition
+ *
+ * Markers alone need two or three minutes to lock. Instead, hold about a
+ * minute of ticks, P-markers and minute markers and score every
+ * second-of-minute hypothesis at once: the tick grid gives the second
+ * phase, and each hypothesis predicts where ticks are missing (:00, :29,
+ * :59), where P-markers fall (:09..:59 step 10) and where the minute
+ * marker starts. A clear winner becomes a TENTATIVE anchor; confirmed
+ * markers and the normal evidence then take over.
+ *============================================================================*/
+
+static void fast_acq_clear(fast_acq_t *fa) {
+    fa->tick_count = 0;
+    fa->pulse_count = 0;
+    fa->contradictions = 0;
+}
+
+/* Drop events that fell out of the window ending at now_ms */
+static void fast_acq_expire(fast_acq_t *fa, double now_ms) {
+    int keep = 0;
+    for (int k = 0; k < fa->tick_count; k++) {
+        if (now_ms - fa->ticks_ms[k] <= FAST_ACQ_WINDOW_MS) fa->ticks_ms[keep++] = fa->ticks_ms[k];
+    }
+    fa->tick_count = keep;
+
+    keep = 0;
+    for (int k = 0; k < fa->pulse_count; k++) {
+        if (now_ms - fa->pulses_ms[k] <= FAST_ACQ_WINDOW_MS) {
+            fa->pulses_ms[keep] = fa->pulses_ms[k];
+            fa->pulse_is_marker[keep] = fa->pulse_is_marker[k];
+            keep++;
+        }
+    }
+    fa->pulse_count = keep;
+}
+
+static void fast_acq_add_pulse(fast_acq_t *fa, double start_ms, bool is_marker) {
+    if (fa->pulse_count == FAST_ACQ_MAX_PULSES) {
+        memmove(fa->pulses_ms, fa->pulses_ms + 1, (FAST_ACQ_MAX_PULSES - 1) * sizeof(double));
+        memmove(fa->pulse_is_marker, fa->pulse_is_marker + 1, (FAST_ACQ_MAX_PULSES - 1) * sizeof(bool));
+        fa->pulse_count--;
+    }
+    fa->pulses_ms[fa->pulse_count] = start_ms;
+    fa->pulse_is_marker[fa->pulse_count] = is_marker;
+    fa->pulse_count++;
+}
+
+/* Signed distance of a phase from a reference phase, wrapped to +/-500 ms */
+static double phase_diff_ms(double phase_ms, double ref_ms) {
+    double d = fmod(phase_ms - ref_ms, 1000.0);
+    if (d > 500.0) d -= 1000.0;
+    if (d < -500.0) d += 1000.0;
+    return d;
+}
+
+/**
+ * Second phase of the held ticks: the tick with the most neighbours
+ * within FAST_ACQ_PHASE_TOLERANCE_MS, refined by their mean offset
+ * @return Inlier count
+ */
+static int fast_acq_tick_phase(const fast_acq_t *fa, double *phase_ms) {
+    int best = 0;
+    double best_ref = 0.0;
+    for (int j = 0; j < fa->tick_count; j++) {
+        double ref = fmod(fa->ticks_ms[j], 1000.0);
+        int n = 0;
+        for (int k = 0; k < fa->tick_count; k++) {
+            if (fabs(phase_diff_ms(fa->ticks_ms[k], ref)) <= FAST_ACQ_PHASE_TOLERANCE_MS) n++;
+        }
+        if (n > best) {
+            best = n;
+            best_ref = ref;
+        }
+    }
+
+    double sum = 0.0;
+    for (int k = 0; k < fa->tick_count; k++) {
+        double d = phase_diff_ms(fa->ticks_ms[k], best_ref);
+        if (fabs(d) <= FAST_ACQ_PHASE_TOLERANCE_MS) sum += d;
+    }
+    *phase_ms = best ? best_ref + sum / best : 0.0;
+    return best;
+}
+
+static bool is_no_tick_second(int second) {
+    return second == 0 || second == 29 || second == 59;
+}
+
+static bool is_p_marker_second(int second) {
+    return second % 10 == 9;
+}
+
+/**
+ * Score all 60 hypotheses over the held events
+ * @return true and a minute anchor if one hypothesis clearly wins
+ */
+static bool fast_acq_search(sync_detector_t *sd, double now_ms, double *anchor_ms) {
+    fast_acq_t *fa = &sd->fast;
+    if (fa->tick_count < 2 || fa->ticks_ms[fa->tick_count - 1] - fa->ticks_ms[0] < FAST_ACQ_MIN_SPAN_MS) {
+        return false;
+    }
+
+    double phase;
+    if (fast_acq_tick_phase(fa, &phase) < 2) return false;
+
+    /* Grid second n covers phase + n*1000; index 0 = first held tick */
+    long first = lround((fa->ticks_ms[0] - phase) / 1000.0);
+    long last = (long)floor((now_ms - phase + FAST_ACQ_PHASE_TOLERANCE_MS) / 1000.0);
+    int span = (int)(last - first + 1);
+    if (span > FAST_ACQ_MAX_SECONDS) {
+        first = last - FAST_ACQ_MAX_SECONDS + 1;
+        span = FAST_ACQ_MAX_SECONDS;
+    }
+
+    bool tick[FAST_ACQ_MAX_SECONDS] = { false };
+    signed char pulse[FAST_ACQ_MAX_SECONDS] = { 0 };   /* 1 = P-marker, 2 = minute marker */
+    for (int k = 0; k < fa->tick_count; k++) {
+        if (fabs(phase_diff_ms(fa->ticks_ms[k], phase)) > FAST_ACQ_PHASE_TOLERANCE_MS) continue;
+        long n = lround((fa->ticks_ms[k] - phase) / 1000.0) - first;
+        if (n >= 0 && n < span) tick[n] = true;
+    }
+    for (int k = 0; k < fa->pulse_count; k++) {
+        long n = lround((fa->pulses_ms[k] - phase) / 1000.0) - first;
+        if (n < 0 || n >= span) continue;
+        pulse[n] = fa->pulse_is_marker[k] ? 2 : 1;
+    }
+
+    /* h = second of minute at grid index 0 */
+    float best = -1e9f, runner_up = -1e9f;
+    int best_h = -1;
+    for (int h = 0; h < 60; h++) {
+        float score = 0.0f;
+        for (int n = 0; n < span; n++) {
+            int second = (h + n) % 60;
+            if (is_no_tick_second(second)) {
+                bool signal = (n > 0 && tick[n - 1]) || (n + 1 < span && tick[n + 1]);
+                if (tick[n]) score += FAST_SCORE_HOLE_TICK;
+                else if (signal) score += FAST_SCORE_HOLE;
+            }
+            if (pulse[n] == 2) {
+                score += (second == 0) ? FAST_SCORE_MARKER : -FAST_SCORE_MARKER;
+            } else if (pulse[n] == 1) {
+                score += is_p_marker_second(second) ? FAST_SCORE_P_MARKER : -FAST_SCORE_P_MARKER;
+            }
+        }
+        if (score > best) {
+            runner_up = best;
+            best = score;
+            best_h = h;
+        } else if (score > runner_up) {
+            runner_up = score;
+        }
+    }
+
+    if (best < FAST_ACQ_MIN_SCORE || best - runner_up < FAST_ACQ_MIN_MARGIN) return false;
+
+    /* Latest grid second 0 at or before now */
+    long now_second = (best_h + (last - first)) % 60;
+    *anchor_ms = phase + (double)(last - now_second) * 1000.0;
+
+    printf("[SYNC] Fast acquire: second %ld now, anchor %.1fms (score %.1f, margin %.1f, %d ticks over %ds)\n",
+           now_second, *anchor_ms, best, best - runner_up, fa->tick_count, span);
+    return true;
+}
+
+/* Run the search after a new event; on a winner go TENTATIVE on its anchor */
+static void fast_acq_update(sync_detector_t *sd, double now_ms) {
+    if (!sd->fast.enabled || sd->state != SYNC_ACQUIRING) return;
+
+    fast_acq_expire(&sd->fast, now_ms);
+
+    double anchor_ms;
+    if (!fast_acq_search(sd, now_ms, &anchor_ms)) return;
+
+    sd->minute_anchor_ms = anchor_ms;
+    sd->fast.anchored = true;
+    sd->fast.anchors++;
+    fast_acq_clear(&sd->fast);
+
+    transition_state(sd, SYNC_TENTATIVE);
+    apply_evidence(sd, EVIDENCE_TICK_HOLE, get_evidence_weight(sd, EVIDENCE_TICK_HOLE));
+}
+
+/**
+ * Check a tick against a search anchor: repeated ticks in the predicted
+ * holes mean the anchor is wrong, so drop it and search again
+ */
+static void fast_acq_check_tick(sync_detector_t *sd, double timestamp_ms) {
+    if (!sd->fast.anchored || sd->state != SYNC_TENTATIVE) return;
+
+    double since_anchor = fmod(timestamp_ms - sd->minute_anchor_ms, 60000.0);
+    if (since_anchor < 0.0) since_anchor += 60000.0;
+    int second = (int)(since_anchor / 1000.0 + 0.5) % 60;
+    double offset = since_anchor - second * 1000.0;
+    if (offset > 30000.0) offset -= 60000.0;
+
+    if (!is_no_tick_second(second) || fabs(offset) > sd->tick_phase_tolerance_ms) return;
+
+    if (++sd->fast.contradictions >= FAST_ACQ_MAX_CONTRADICTIONS) {
+        printf("[SYNC] Fast anchor contradicted (ticks at :%02d) - reacquiring\n", second);
+        sd->fast.anchored = false;
+        sd->fast.rejected_anchors++;
+        sd->minute_anchor_ms = 0.0;
+        fast_acq_clear(&sd->fast);
+        transition_state(sd, SYNC_ACQUIRING);
+    }
+}
+
 static void sync_detector_full_reset(sync_detector_t *sd) {
     printf("[SYNC] Full reset - clearing all state\n");
+    sd->full_resets++;
 
     memset(&sd->tick_gap, 0, sizeof(tick_gap_tracker_t));
     memset(&sd->recovery, 0, sizeof(recovery_state_t));
@@ -431,6 +840,8 @@ static void sync_detector_full_reset(sync_detector_t *sd) {
     sd->evidence_mask = 0;
     sd->signal_weak_count = 0;
     sd->expecting_marker_soon = false;
+    sd->fast.anchored = false;
+    fast_acq_clear(&sd->fast);
 
     transition_state(sd, SYNC_ACQUIRING);
 }
@@ -440,7 +851,7 @@ static void sync_detector_full_reset(sync_detector_t *sd) {
  *============================================================================*/
 
 sync_detector_t *sync_detector_create(const char *csv_path) {
-    sync_detector_t *sd = (sync_detector_t *)calloc(1, sizeof(sync_detector_t));
+    sync_detector_t *sd = (sync_detector_t *)wwv_aligned_calloc(WWV_CACHE_LINE, sizeof(sync_detector_t));
     if (!sd) return NULL;
 
     sd->state = SYNC_ACQUIRING;
@@ -461,18 +872,21 @@ sync_detector_t *sync_detector_create(const char *csv_path) {
     sd->marker_tolerance_ms = MARKER_TOLERANCE_MS;                      /* 500.0 */
     sd->p_marker_tolerance_ms = P_MARKER_TOLERANCE_MS;                  /* 200.0 */
 
+    wwv_timer_init(&sd->check_timer, on_check_timer, sd);
+    wwv_timer_init(&sd->pending_timer, on_pending_timer, sd);
+    wwv_timer_init(&sd->expect_timer, on_expect_timer, sd);
+
     /* Open CSV file */
     if (csv_path) {
-        sd->csv_file = fopen(csv_path, "w");
-        if (sd->csv_file) {
+        sd->csv_log = wwv_csv_log_open(csv_path);
+        if (sd->csv_log) {
             char time_str[64];
             time_t now = time(NULL);
-            strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", localtime(&now));
+            strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", wwv_localtime(&now));
 
-            fprintf(sd->csv_file, "# Phoenix SDR WWV Sync Log v%s\n", PHOENIX_VERSION_FULL);
-            fprintf(sd->csv_file, "# Started: %s\n", time_str);
-            fprintf(sd->csv_file, "time,timestamp_ms,marker_num,state,interval_sec,delta_ms,tick_dur_ms,marker_dur_ms\n");
-            fflush(sd->csv_file);
+            wwv_csv_log_header(sd->csv_log, "# Phoenix SDR WWV Sync Log v%s\n", PHOENIX_VERSION_FULL);
+            wwv_csv_log_header(sd->csv_log, "# Started: %s\n", time_str);
+            wwv_csv_log_header(sd->csv_log, "time,timestamp_ms,marker_num,state,interval_sec,delta_ms,tick_dur_ms,marker_dur_ms\n");
         }
     }
 
@@ -484,17 +898,19 @@ sync_detector_t *sync_detector_create(const char *csv_path) {
 void sync_detector_destroy(sync_detector_t *sd) {
     if (!sd) return;
 
-    if (sd->csv_file) {
-        fclose(sd->csv_file);
-    }
+    sync_detector_set_timer_wheel(sd, NULL);
+
+    wwv_csv_log_close(sd->csv_log);
 
-    free(sd);
+    wwv_aligned_free(sd);
 }
 
-void sync_detector_tick_marker(sync_detector_t *sd, float timestamp_ms,
+void sync_detector_tick_marker(sync_detector_t *sd, double timestamp_ms,
                                 float duration_ms, float corr_ratio) {
     if (!sd) return;
 
+    decay_confidence(sd, timestamp_ms);
+
     /* Check for timeout on previous pending events */
     check_timeout(sd, timestamp_ms);
 
@@ -503,17 +919,26 @@ void sync_detector_tick_marker(sync_detector_t *sd, float timestamp_ms,
     sd->pending_tick_duration_ms = duration_ms;
     sd->pending_tick_corr_ratio = corr_ratio;
     sd->tick_pending = true;
+    schedule_pending(sd, timestamp_ms);
 
     printf("[SYNC] Tick marker received: %.1fms dur=%.0fms\n", timestamp_ms, duration_ms);
 
+    if (sd->fast.enabled && sd->state == SYNC_ACQUIRING) {
+        fast_acq_add_pulse(&sd->fast, timestamp_ms - duration_ms, true);
+        fast_acq_update(sd, timestamp_ms);
+        if (sd->state != SYNC_ACQUIRING) return;
+    }
+
     /* Try to correlate with pending marker event */
     try_correlate(sd, timestamp_ms);
 }
 
-void sync_detector_marker_event(sync_detector_t *sd, float timestamp_ms,
+void sync_detector_marker_event(sync_detector_t *sd, double timestamp_ms,
                                  float accum_energy, float duration_ms) {
     if (!sd) return;
 
+    decay_confidence(sd, timestamp_ms);
+
     /* Check for timeout on previous pending events */
     check_timeout(sd, timestamp_ms);
 
@@ -522,6 +947,7 @@ void sync_detector_marker_event(sync_detector_t *sd, float timestamp_ms,
     sd->pending_marker_energy = accum_energy;
     sd->pending_marker_duration_ms = duration_ms;
     sd->marker_pending = true;
+    schedule_pending(sd, timestamp_ms);
 
     printf("[SYNC] Marker event received: %.1fms energy=%.0f dur=%.0fms\n",
            timestamp_ms, accum_energy, duration_ms);
@@ -544,7 +970,7 @@ const char *sync_state_name(sync_state_t state) {
     }
 }
 
-float sync_detector_get_last_marker_ms(sync_detector_t *sd) {
+double sync_detector_get_last_marker_ms(sync_detector_t *sd) {
     return sd ? sd->last_confirmed_ms : 0.0f;
 }
 
@@ -566,12 +992,51 @@ int sync_detector_get_good_intervals(sync_detector_t *sd) {
     return sd ? sd->good_intervals : 0;
 }
 
+void sync_detector_print_stats(sync_detector_t *sd) {
+    if (!sd) return;
+
+    printf("\n=== SYNC DETECTOR STATS ===\n");
+    printf("State: %s  Confidence: %.2f  Evidence mask: 0x%X\n",
+           sync_state_name(sd->state), sd->confidence, (unsigned)sd->evidence_mask);
+    printf("Confirmed markers: %d  Good intervals: %d  Tick holes: %d\n",
+           sd->confirmed_count, sd->good_intervals, sd->tick_gap.hole_count);
+    printf("Evidence: tick=%u marker=%u p_marker=%u tick_hole=%u\n",
+           (unsigned)sd->evidence_counts[0], (unsigned)sd->evidence_counts[1],
+           (unsigned)sd->evidence_counts[2], (unsigned)sd->evidence_counts[3]);
+    printf("Transitions: %u  Full resets: %u\n",
+           (unsigned)sd->transitions, (unsigned)sd->full_resets);
+    if (sd->fast.enabled) {
+        printf("Fast acquire: anchors=%u contradicted=%u\n",
+               (unsigned)sd->fast.anchors, (unsigned)sd->fast.rejected_anchors);
+    }
+    printf("===========================\n");
+}
+
 void sync_detector_broadcast_state(sync_detector_t *sd) {
     if (!sd) return;
 
+    if (telem_ctx_binary_active(sd->telem, TELEM_SYNC)) {
+        float interval_sec = 0.0f;
+        if (sd->prev_confirmed_ms > 0 && sd->last_confirmed_ms > 0) {
+            interval_sec = (sd->last_confirmed_ms - sd->prev_confirmed_ms) / 1000.0f;
+        }
+        telem_rec_sync_t rec = {
+            .confirmed_count = (uint32_t)sd->confirmed_count,
+            .state = (uint8_t)sd->state,
+            .good_intervals = (uint16_t)sd->good_intervals,
+            .interval_sec = interval_sec,
+            .tick_duration_ms = sd->pending_tick_duration_ms,
+            .marker_duration_ms = sd->pending_marker_duration_ms,
+            .last_confirmed_ms = (float)sd->last_confirmed_ms
+        };
+        telem_ctx_send_record(sd->telem, TELEM_SYNC, TELEM_REC_SYNC, (uint32_t)time(NULL),
+                          telem_ms_to_us(sd->last_confirmed_ms), &rec, sizeof(rec));
+        return;
+    }
+
     char time_str[16];
     time_t now = time(NULL);
-    struct tm *tm_info = localtime(&now);
+    struct tm *tm_info = wwv_localtime(&now);
     strftime(time_str, sizeof(time_str), "%H:%M:%S", tm_info);
 
     /* Broadcast current state - use 0 for interval/delta when no history */
@@ -580,7 +1045,7 @@ void sync_detector_broadcast_state(sync_detector_t *sd) {
         interval_sec = (sd->last_confirmed_ms - sd->prev_confirmed_ms) / 1000.0f;
     }
 
-    telem_sendf(TELEM_SYNC, "%s,%.1f,%d,%s,%d,%.1f,0,%.1f,%.1f,%.1f",
+    telem_ctx_sendf(sd->telem, TELEM_SYNC, "%s,%.1f,%d,%s,%d,%.1f,0,%.1f,%.1f,%.1f",
                 time_str, sd->last_confirmed_ms, sd->confirmed_count,
                 sync_state_name(sd->state), sd->good_intervals,
                 interval_sec,
@@ -592,9 +1057,11 @@ void sync_detector_broadcast_state(sync_detector_t *sd) {
  * Enhanced API Implementation
  *============================================================================*/
 
-void sync_detector_tick_event(sync_detector_t *sd, float timestamp_ms) {
+void sync_detector_tick_event(sync_detector_t *sd, double timestamp_ms) {
     if (!sd) return;
 
+    decay_confidence(sd, timestamp_ms);
+
     tick_gap_tracker_t *tg = &sd->tick_gap;
 
     if (tg->last_tick_ms > 0) {
@@ -629,6 +1096,33 @@ void sync_detector_tick_event(sync_detector_t *sd, float timestamp_ms) {
 
     tg->last_tick_ms = timestamp_ms;
 
+    /* Recovery validation: a tick back on the retained second phase */
+    if (sd->state == SYNC_RECOVERING && sd->recovery.has_retained_state &&
+        sd->recovery.retained_tick_ms > 0 && !sd->recovery.recovery_tick_seen) {
+        double offset = fmod(timestamp_ms - sd->recovery.retained_tick_ms, 1000.0);
+        if (offset < 0.0) offset += 1000.0;
+        if (offset > 500.0) offset -= 1000.0;
+        if (fabs(offset) <= sd->tick_phase_tolerance_ms) {
+            printf("[SYNC] Recovery: tick at %+.0fms from retained phase\n", offset);
+            sd->recovery.recovery_tick_seen = true;
+            schedule_checks(sd);
+        }
+    }
+
+    if (sd->fast.enabled) {
+        if (sd->state == SYNC_ACQUIRING) {
+            fast_acq_t *fa = &sd->fast;
+            if (fa->tick_count == FAST_ACQ_MAX_TICKS) {
+                memmove(fa->ticks_ms, fa->ticks_ms + 1, (FAST_ACQ_MAX_TICKS - 1) * sizeof(double));
+                fa->tick_count--;
+            }
+            fa->ticks_ms[fa->tick_count++] = timestamp_ms;
+            fast_acq_update(sd, timestamp_ms);
+            return;
+        }
+        fast_acq_check_tick(sd, timestamp_ms);
+    }
+
     /* Apply tick evidence */
     if (sd->state >= SYNC_TENTATIVE) {
         float weight = get_evidence_weight(sd, EVIDENCE_TICK);
@@ -636,12 +1130,20 @@ void sync_detector_tick_event(sync_detector_t *sd, float timestamp_ms) {
     }
 }
 
-void sync_detector_p_marker_event(sync_detector_t *sd, float timestamp_ms,
+void sync_detector_p_marker_event(sync_detector_t *sd, double timestamp_ms,
                                    float duration_ms) {
     if (!sd) return;
 
+    decay_confidence(sd, timestamp_ms);
+
     printf("[SYNC] P-marker: %.1fms dur=%.0fms\n", timestamp_ms, duration_ms);
 
+    if (sd->fast.enabled && sd->state == SYNC_ACQUIRING) {
+        fast_acq_add_pulse(&sd->fast, timestamp_ms, false);
+        fast_acq_update(sd, timestamp_ms);
+        return;
+    }
+
     /* Apply P-marker evidence */
     if (sd->state >= SYNC_TENTATIVE) {
         float weight = get_evidence_weight(sd, EVIDENCE_P_MARKER);
@@ -668,23 +1170,22 @@ void sync_detector_p_marker_event(sync_detector_t *sd, float timestamp_ms,
     }
 }
 
-void sync_detector_periodic_check(sync_detector_t *sd, float current_ms) {
-    if (!sd) return;
+void sync_detector_periodic_check(sync_detector_t *sd, double current_ms) {
+    if (!sd || sd->suspended) return;
 
     /* Confidence decay */
-    float decay_rate = (sd->state == SYNC_RECOVERING) ?
-                       sd->confidence_decay_recovering : sd->confidence_decay_normal;
-    sd->confidence *= decay_rate;
+    decay_confidence(sd, current_ms);
 
     /* Signal loss detection (only when LOCKED) - marker-based authority */
     if (sd->state == SYNC_LOCKED) {
-        float since_last_marker = current_ms - sd->last_confirmed_ms;
+        float since_last_marker = current_ms - fmax(sd->last_confirmed_ms, sd->resumed_ms);
 
         if (since_last_marker > MARKER_GAP_CRITICAL_MS) {
             sd->signal_weak_count++;
             if (sd->signal_weak_count >= SIGNAL_WEAK_DEBOUNCE) {
                 /* Enter recovery */
                 sd->recovery.retained_anchor_ms = sd->minute_anchor_ms;
+                sd->recovery.retained_tick_ms = sd->tick_gap.last_tick_ms;
                 sd->recovery.signal_lost_ms = current_ms;
                 sd->recovery.has_retained_state = true;
                 sd->recovery.recovery_start_ms = current_ms;
@@ -734,6 +1235,8 @@ void sync_detector_periodic_check(sync_detector_t *sd, float current_ms) {
     if (sd->state == SYNC_TENTATIVE && sd->confidence >= CONFIDENCE_LOCKED_THRESHOLD) {
         transition_state(sd, SYNC_LOCKED);
     }
+
+    schedule_checks(sd);
 }
 
 frame_time_t sync_detector_get_frame_time(sync_detector_t *sd) {
@@ -772,6 +1275,34 @@ void sync_detector_set_wwv_clock(sync_detector_t *sd, wwv_clock_t *clk) {
     }
 }
 
+void sync_detector_set_telemetry(sync_detector_t *sd, telem_ctx_t *ctx) {
+    if (!sd) return;
+    sd->telem = ctx;
+}
+
+void sync_detector_set_fast_acquire(sync_detector_t *sd, bool enable) {
+    if (!sd) return;
+    sd->fast.enabled = enable;
+    sd->fast.anchored = false;
+    fast_acq_clear(&sd->fast);
+}
+
+bool sync_detector_get_fast_acquire(sync_detector_t *sd) {
+    return sd ? sd->fast.enabled : false;
+}
+
+void sync_detector_set_timer_wheel(sync_detector_t *sd, wwv_timer_wheel_t *wheel) {
+    if (!sd) return;
+
+    if (sd->timers) {
+        wwv_timer_cancel(sd->timers, &sd->check_timer);
+        wwv_timer_cancel(sd->timers, &sd->pending_timer);
+        wwv_timer_cancel(sd->timers, &sd->expect_timer);
+    }
+    sd->timers = wheel;
+    schedule_checks(sd);
+}
+
 void sync_detector_set_leap_second_pending(sync_detector_t *sd, bool pending) {
     if (sd) {
         sd->leap_second_pending = pending;
@@ -787,7 +1318,7 @@ void sync_detector_set_state_callback(sync_detector_t *sd,
     }
 }
 
-bool sync_detector_get_pending_tick(sync_detector_t *sd, float *timestamp_ms, float *duration_ms) {
+bool sync_detector_get_pending_tick(sync_detector_t *sd, double *timestamp_ms, float *duration_ms) {
     if (!sd || !sd->tick_pending) {
         return false;
     }
@@ -796,6 +1327,116 @@ bool sync_detector_get_pending_tick(sync_detector_t *sd, float *timestamp_ms, fl
     return true;
 }
 
+bool sync_detector_suspend(sync_detector_t *sd) {
+    if (!sd || sd->state != SYNC_LOCKED || sd->suspended) return false;
+
+    if (sd->timers) {
+        wwv_timer_cancel(sd->timers, &sd->check_timer);
+        wwv_timer_cancel(sd->timers, &sd->pending_timer);
+        wwv_timer_cancel(sd->timers, &sd->expect_timer);
+    }
+    sd->tick_pending = false;
+    sd->marker_pending = false;
+    sd->expecting_marker_soon = false;
+    sd->suspended = true;
+    return true;
+}
+
+void sync_detector_resume(sync_detector_t *sd, double now_ms) {
+    if (!sd || !sd->suspended) return;
+
+    sd->suspended = false;
+    sd->resumed_ms = now_ms;
+    decay_confidence(sd, now_ms);
+    float cap = sd->confidence_locked_threshold * SYNC_RESTORE_MARGIN;
+    if (sd->confidence > cap) sd->confidence = cap;
+    sd->signal_weak_count = 0;
+
+    /* The second phase carries across the gap: the first tick is on it */
+    tick_gap_tracker_t *tg = &sd->tick_gap;
+    if (tg->last_tick_ms > 0 && now_ms > tg->last_tick_ms) {
+        tg->last_tick_ms += floor((now_ms - tg->last_tick_ms) / 1000.0) * 1000.0;
+    }
+    tg->consecutive_tick_count = 1;
+    sd->fast.anchored = true;
+    fast_acq_clear(&sd->fast);
+
+    printf("[SYNC] Resumed after %.1f s: anchor %.1fms held TENTATIVE\n",
+           (now_ms - sd->last_confirmed_ms) / 1000.0, sd->minute_anchor_ms);
+    transition_state(sd, SYNC_TENTATIVE);
+}
+
+bool sync_detector_is_suspended(sync_detector_t *sd) {
+    return sd ? sd->suspended : false;
+}
+
+/*============================================================================
+ * Warm Start
+ *============================================================================*/
+
+#define SYNC_STATE_VERSION      1
+
+typedef struct {
+    double minute_anchor_ms;
+    double last_tick_ms;
+    int32_t state;
+    float confidence;
+} sync_snapshot_t;
+
+_Static_assert(sizeof(sync_snapshot_t) == 24, "sync state layout");
+
+bool sync_detector_save_state(sync_detector_t *sd, wwv_state_writer_t *w) {
+    if (!sd || !w) return false;
+
+    double anchor = (sd->state == SYNC_RECOVERING) ? sd->recovery.retained_anchor_ms
+                                                   : sd->minute_anchor_ms;
+    if (sd->state < SYNC_TENTATIVE || anchor <= 0) return false;
+
+    decay_confidence(sd, w->stream_ms);
+    sync_snapshot_t st = {
+        .minute_anchor_ms = anchor,
+        .last_tick_ms = sd->tick_gap.last_tick_ms,
+        .state = sd->state,
+        .confidence = sd->confidence
+    };
+    return wwv_state_put(w, WWV_STATE_SYNC_DETECTOR, SYNC_STATE_VERSION, &st, sizeof(st));
+}
+
+bool sync_detector_restore_state(sync_detector_t *sd, const wwv_state_reader_t *r) {
+    if (!sd || !r || sd->state != SYNC_ACQUIRING || r->elapsed_ms > WWV_STATE_TIMING_MAX_AGE_MS) {
+        return false;
+    }
+
+    sync_snapshot_t st;
+    if (!wwv_state_get(r, WWV_STATE_SYNC_DETECTOR, SYNC_STATE_VERSION, &st, sizeof(st)) ||
+        st.minute_anchor_ms <= 0) {
+        return false;
+    }
+
+    /* Anchors must be positive here; a later minute boundary on the same phase will do */
+    double anchor = wwv_state_carry_phase(r, st.minute_anchor_ms, MARKER_NOMINAL_MS);
+    if (anchor <= 0) anchor += MARKER_NOMINAL_MS;
+
+    float confidence = st.confidence *
+                       (float)pow(sd->confidence_decay_normal, r->elapsed_ms / SYNC_CHECK_INTERVAL_MS);
+    float cap = sd->confidence_locked_threshold * SYNC_RESTORE_MARGIN;
+
+    sd->minute_anchor_ms = anchor;
+    if (st.last_tick_ms > 0) {
+        double tick = wwv_state_carry_phase(r, st.last_tick_ms, 1000.0);
+        if (tick > 0) sd->tick_gap.last_tick_ms = tick;
+    }
+    sd->confidence = (confidence < cap) ? confidence : cap;
+    sd->last_decay_ms = r->stream_ms;
+    sd->fast.anchored = true;
+    fast_acq_clear(&sd->fast);
+
+    printf("[SYNC] Warm start: %s anchor from %.1f s ago carried to %.1fms\n",
+           sync_state_name((sync_state_t)st.state), r->elapsed_ms / 1000.0, anchor);
+    transition_state(sd, SYNC_TENTATIVE);
+    return true;
+}
+
 /*============================================================================
  * Runtime Parameter Tuning
  *============================================================================*/
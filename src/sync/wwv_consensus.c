@@ -0,0 +1,603 @@
+/**
+ * @file wwv_consensus.c
+ * @brief Consensus time from many receivers and nodes
+ *
+ * Each histogram bin keeps its weight and the weighted first and second
+ * moments of its anchors' offsets from the bin centre, so the cluster
+ * mean and spread come from three bins without visiting any source.
+ * best_bin is the centre of the heaviest three-bin cluster; an update
+ * re-scores only the clusters around the bins it touched.
+ */
+
+#include "wwv_consensus.h"
+#include "telemetry_wire.h"
+#include "wwv_arena.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MINUTE_MS           60000.0
+#define BIN_COUNT           (60000 / WWV_CONSENSUS_BIN_MS)
+#define SCORE_EPS           1e-6        /* Rounding left by removing what was added */
+#define NO_MINUTE           INT64_MIN
+
+_Static_assert(60000 % WWV_CONSENSUS_BIN_MS == 0, "bins must tile the minute");
+
+typedef struct {
+    char name[32];
+    double offset_ms;               /* Stream time -> shared time */
+    float quality;                  /* Channel quality factor */
+    float confidence;               /* Last sync confidence */
+    sync_state_t state;
+
+    bool has_anchor;
+    double anchor_ms;               /* Shared time of the last confirmed marker */
+
+    /* Contribution to the histogram while anchored */
+    bool anchored;
+    int bin;
+    float offset_in_bin;            /* Phase minus bin centre */
+    float weight;
+} consensus_source_t;
+
+typedef struct {
+    double w, wd, wdd;              /* Sum of w, w * d, w * d^2 */
+    int count;
+} phase_bin_t;
+
+/* One minute of the BCD vote, keyed by its index on the agreed phase */
+typedef struct {
+    int64_t minute;
+    double start_ms;
+    float ll[60][3];
+    float weight[60];
+} bcd_vote_t;
+
+struct wwv_consensus {
+    wwv_consensus_config_t config;
+
+    consensus_source_t sources[WWV_CONSENSUS_MAX_SOURCES];
+    int source_count;
+    int sweep;                      /* Next source checked for a stale anchor */
+
+    phase_bin_t bins[BIN_COUNT];
+    int best_bin;
+    double best_score;
+    double total_weight;
+    int anchored;
+    double now_ms;                  /* Latest shared time seen */
+
+    bcd_vote_t votes[2];            /* Minute index & 1 */
+    bcd_time_solver_t *solver;
+
+    wwv_consensus_callback_fn callback;
+    void *callback_user_data;
+
+    /* Statistics */
+    uint64_t datagrams;
+    uint64_t bad_datagrams;
+    uint64_t records;
+    uint64_t anchors;
+    uint64_t symbols;
+    uint64_t symbols_rejected;
+    uint64_t minutes_voted;
+    uint64_t rescans;
+    uint64_t retired;
+};
+
+/*============================================================================
+ * Weights
+ *============================================================================*/
+
+static float state_weight(sync_state_t state) {
+    switch (state) {
+        case SYNC_LOCKED:     return 1.0f;
+        case SYNC_TENTATIVE:  return 0.5f;
+        case SYNC_RECOVERING: return 0.25f;
+        default:              return 0.0f;
+    }
+}
+
+static float source_weight(const consensus_source_t *s) {
+    return state_weight(s->state) * s->confidence * s->quality;
+}
+
+/*============================================================================
+ * Phase Histogram
+ *============================================================================*/
+
+static int wrap_bin(int b) {
+    return (b + BIN_COUNT) % BIN_COUNT;
+}
+
+static double cluster_score(const wwv_consensus_t *c, int b) {
+    return c->bins[wrap_bin(b - 1)].w + c->bins[b].w + c->bins[wrap_bin(b + 1)].w;
+}
+
+static void bin_add(wwv_consensus_t *c, int b, float d, float w, int n) {
+    phase_bin_t *bin = &c->bins[b];
+    bin->count += n;
+    if (bin->count <= 0) {
+        memset(bin, 0, sizeof(*bin));
+        return;
+    }
+    bin->w += w;
+    bin->wd += (double)w * d;
+    bin->wdd += (double)w * d * d;
+}
+
+static void rescan(wwv_consensus_t *c) {
+    c->best_bin = 0;
+    c->best_score = cluster_score(c, 0);
+    for (int b = 1; b < BIN_COUNT; b++) {
+        double score = cluster_score(c, b);
+        if (score > c->best_score) {
+            c->best_bin = b;
+            c->best_score = score;
+        }
+    }
+    c->rescans++;
+}
+
+/*
+ * Clusters that do not contain a touched bin kept their score, which was
+ * at most the old best. So the best of the touched clusters wins unless
+ * the leading cluster itself lost weight and nothing touched beats it.
+ */
+static void refresh_best(wwv_consensus_t *c, int bin_a, int bin_b) {
+    double old_score = c->best_score;
+    int best = c->best_bin;
+    int cand = best;
+    double cand_score = cluster_score(c, best);
+    bool touched = false;
+
+    int touched_bins[2] = { bin_a, bin_b };
+    for (int t = 0; t < 2; t++) {
+        if (touched_bins[t] < 0) continue;
+        for (int k = -1; k <= 1; k++) {
+            int b = wrap_bin(touched_bins[t] + k);
+            double score = cluster_score(c, b);
+            if (b == best) touched = true;
+            if (score > cand_score) {
+                cand = b;
+                cand_score = score;
+            }
+        }
+    }
+
+    if (touched && cand_score < old_score - SCORE_EPS) {
+        rescan(c);
+        return;
+    }
+    c->best_bin = cand;
+    c->best_score = cand_score;
+}
+
+/* Weighted mean phase of the leading cluster, and its total weight */
+static double cluster_phase(const wwv_consensus_t *c, double *weight, double *spread,
+                            int *count) {
+    double w = 0.0, wd = 0.0, wdd = 0.0;
+    int n = 0;
+    for (int k = -1; k <= 1; k++) {
+        const phase_bin_t *bin = &c->bins[wrap_bin(c->best_bin + k)];
+        double shift = k * (double)WWV_CONSENSUS_BIN_MS;
+        w += bin->w;
+        wd += bin->wd + shift * bin->w;
+        wdd += bin->wdd + 2.0 * shift * bin->wd + shift * shift * bin->w;
+        n += bin->count;
+    }
+
+    double mean = (w > 0.0) ? wd / w : 0.0;
+    if (weight) *weight = w;
+    if (spread) *spread = (w > 0.0) ? sqrt(fmax(wdd / w - mean * mean, 0.0)) : 0.0;
+    if (count) *count = n;
+
+    double phase = fmod((c->best_bin + 0.5) * WWV_CONSENSUS_BIN_MS + mean, MINUTE_MS);
+    return (phase < 0.0) ? phase + MINUTE_MS : phase;
+}
+
+/* Take the source's contribution out, put its current one back, re-score */
+static void place_source(wwv_consensus_t *c, consensus_source_t *s) {
+    int old_bin = -1, new_bin = -1;
+
+    if (s->anchored) {
+        old_bin = s->bin;
+        bin_add(c, s->bin, s->offset_in_bin, -s->weight, -1);
+        c->total_weight -= s->weight;
+        c->anchored--;
+        s->anchored = false;
+    }
+
+    float w = s->has_anchor ? source_weight(s) : 0.0f;
+    if (w > 0.0f) {
+        double phase = fmod(s->anchor_ms, MINUTE_MS);
+        if (phase < 0.0) phase += MINUTE_MS;
+        int b = (int)(phase / WWV_CONSENSUS_BIN_MS);
+        if (b >= BIN_COUNT) b = BIN_COUNT - 1;
+
+        s->bin = b;
+        s->offset_in_bin = (float)(phase - (b + 0.5) * WWV_CONSENSUS_BIN_MS);
+        s->weight = w;
+        s->anchored = true;
+        bin_add(c, b, s->offset_in_bin, w, 1);
+        c->total_weight += w;
+        c->anchored++;
+        new_bin = b;
+    }
+
+    if (c->anchored == 0) {
+        c->total_weight = 0.0;          /* Clear rounding */
+        c->best_bin = 0;
+        c->best_score = 0.0;
+        return;
+    }
+    refresh_best(c, old_bin, new_bin);
+}
+
+/* One source per record: drop its anchor if it stopped confirming */
+static void sweep_one(wwv_consensus_t *c) {
+    if (c->source_count == 0) return;
+    consensus_source_t *s = &c->sources[c->sweep];
+    c->sweep = (c->sweep + 1) % c->source_count;
+
+    if (s->has_anchor && c->now_ms - s->anchor_ms > WWV_CONSENSUS_ANCHOR_MAX_AGE_MS) {
+        s->has_anchor = false;
+        place_source(c, s);
+        c->retired++;
+    }
+}
+
+static consensus_source_t *get_source(wwv_consensus_t *c, int source) {
+    if (!c || source < 0 || source >= c->source_count) return NULL;
+    return &c->sources[source];
+}
+
+static void touch(wwv_consensus_t *c, double shared_ms) {
+    if (shared_ms > c->now_ms) c->now_ms = shared_ms;
+    c->records++;
+    sweep_one(c);
+}
+
+/*============================================================================
+ * Solution
+ *============================================================================*/
+
+static bool fill_solution(const wwv_consensus_t *c, wwv_consensus_solution_t *out) {
+    memset(out, 0, sizeof(*out));
+    out->total_weight = (float)c->total_weight;
+    out->anchored_sources = c->anchored;
+    out->has_time = bcd_time_solver_get_solution(c->solver, &out->time);
+    if (c->anchored == 0) return false;
+
+    double weight, spread;
+    int count;
+    double phase = cluster_phase(c, &weight, &spread, &count);
+    double since = fmod(c->now_ms - phase, MINUTE_MS);
+    if (since < 0.0) since += MINUTE_MS;
+
+    out->minute_anchor_ms = c->now_ms - since;
+    out->spread_ms = (float)spread;
+    out->agree_weight = (float)weight;
+    out->agree_sources = count;
+
+    return count >= c->config.min_sources &&
+           weight >= c->config.min_weight &&
+           weight >= c->config.min_fraction * c->total_weight;
+}
+
+static void notify(wwv_consensus_t *c) {
+    if (!c->callback) return;
+    wwv_consensus_solution_t solution;
+    if (fill_solution(c, &solution)) c->callback(&solution, c->callback_user_data);
+}
+
+/*============================================================================
+ * BCD Vote
+ *============================================================================*/
+
+static void flush_vote(wwv_consensus_t *c, bcd_vote_t *v) {
+    for (int sec = 0; sec < 60; sec++) {
+        if (v->weight[sec] <= 0.0f) continue;
+
+        int best = 0;
+        for (int k = 1; k < 3; k++) {
+            if (v->ll[sec][k] > v->ll[sec][best]) best = k;
+        }
+        bcd_symbol_event_t event = {
+            .symbol = (bcd_corr_symbol_t)best,
+            .timestamp_ms = v->start_ms + sec * 1000.0 + 500.0,
+            .confidence = fminf(v->weight[sec], 1.0f),
+            .source = "VOTE",
+            .second = sec
+        };
+        for (int k = 0; k < 3; k++) {
+            event.log_likelihood[k] = v->ll[sec][k] - v->ll[sec][best];
+        }
+        bcd_time_solver_add_symbol(c->solver, &event);
+    }
+    v->minute = NO_MINUTE;
+    c->minutes_voted++;
+}
+
+/* Vote slot of minute key, flushing the minutes it completes; NULL if too late */
+static bcd_vote_t *vote_for(wwv_consensus_t *c, int64_t key, double phase) {
+    /* Oldest first, so the solver sees minutes in order */
+    int first = (c->votes[1].minute < c->votes[0].minute) ? 1 : 0;
+    for (int i = 0; i < 2; i++) {
+        bcd_vote_t *v = &c->votes[first ^ i];
+        if (v->minute != NO_MINUTE && v->minute <= key - 2) flush_vote(c, v);
+    }
+
+    bcd_vote_t *v = &c->votes[key & 1];
+    if (v->minute == key) return v;
+    if (v->minute != NO_MINUTE) return NULL;
+
+    memset(v, 0, sizeof(*v));
+    v->minute = key;
+    v->start_ms = key * MINUTE_MS + phase;
+    return v;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+static void on_time_solution(const bcd_time_solution_t *solution, void *user_data) {
+    (void)solution;
+    notify((wwv_consensus_t *)user_data);
+}
+
+wwv_consensus_t *wwv_consensus_create(const wwv_consensus_config_t *config) {
+    wwv_consensus_t *c = wwv_calloc(1, sizeof(wwv_consensus_t));
+    if (!c) return NULL;
+
+    wwv_consensus_config_t defaults = WWV_CONSENSUS_CONFIG_DEFAULT;
+    c->config = config ? *config : defaults;
+    if (c->config.min_sources < 1) c->config.min_sources = 1;
+    if (c->config.full_snr_db <= 0.0f) c->config.full_snr_db = defaults.full_snr_db;
+
+    c->solver = bcd_time_solver_create();
+    if (!c->solver) {
+        wwv_free(c);
+        return NULL;
+    }
+    bcd_time_solver_set_callback(c->solver, on_time_solution, c);
+    c->votes[0].minute = NO_MINUTE;
+    c->votes[1].minute = NO_MINUTE;
+    c->now_ms = -INFINITY;
+
+    printf("[CONSENSUS] Created: %d ms phase bins, solution at %d sources / weight %.2f / %.0f%%\n",
+           WWV_CONSENSUS_BIN_MS, c->config.min_sources, c->config.min_weight,
+           c->config.min_fraction * 100.0f);
+    return c;
+}
+
+void wwv_consensus_destroy(wwv_consensus_t *c) {
+    if (!c) return;
+    bcd_time_solver_destroy(c->solver);
+    wwv_free(c);
+}
+
+int wwv_consensus_add_source(wwv_consensus_t *c, const char *name) {
+    if (!c || c->source_count >= WWV_CONSENSUS_MAX_SOURCES) return -1;
+
+    int id = c->source_count++;
+    consensus_source_t *s = &c->sources[id];
+    memset(s, 0, sizeof(*s));
+    snprintf(s->name, sizeof(s->name), "%s", name ? name : "");
+    s->quality = 1.0f;
+    s->confidence = 1.0f;
+    s->state = SYNC_ACQUIRING;
+    return id;
+}
+
+void wwv_consensus_set_source_offset(wwv_consensus_t *c, int source, double offset_ms) {
+    consensus_source_t *s = get_source(c, source);
+    if (!s) return;
+
+    if (s->has_anchor) s->anchor_ms += offset_ms - s->offset_ms;
+    s->offset_ms = offset_ms;
+    place_source(c, s);
+}
+
+void wwv_consensus_set_source_quality(wwv_consensus_t *c, int source,
+                                      const channel_quality_report_t *quality) {
+    consensus_source_t *s = get_source(c, source);
+    if (!s || !quality) return;
+
+    float q = 1.0f;
+    if (quality->valid) {
+        q = quality->snr_db / c->config.full_snr_db;
+        if (q < WWV_CONSENSUS_MIN_QUALITY) q = WWV_CONSENSUS_MIN_QUALITY;
+        if (q > 1.0f) q = 1.0f;
+    }
+    if (q == s->quality) return;
+    s->quality = q;
+    place_source(c, s);
+}
+
+void wwv_consensus_set_callback(wwv_consensus_t *c, wwv_consensus_callback_fn cb,
+                                void *user_data) {
+    if (!c) return;
+    c->callback = cb;
+    c->callback_user_data = user_data;
+}
+
+void wwv_consensus_add_anchor(wwv_consensus_t *c, int source, double anchor_ms,
+                              sync_state_t state) {
+    consensus_source_t *s = get_source(c, source);
+    if (!s) return;
+
+    s->state = state;
+    if (anchor_ms > 0.0) {
+        s->has_anchor = true;
+        s->anchor_ms = anchor_ms + s->offset_ms;
+        c->anchors++;
+        touch(c, s->anchor_ms);
+    } else {
+        touch(c, c->now_ms);
+    }
+    place_source(c, s);
+    if (anchor_ms > 0.0) notify(c);
+}
+
+void wwv_consensus_add_state(wwv_consensus_t *c, int source, sync_state_t state,
+                             float confidence) {
+    consensus_source_t *s = get_source(c, source);
+    if (!s) return;
+
+    s->state = state;
+    s->confidence = (confidence < 0.0f) ? 0.0f : (confidence > 1.0f) ? 1.0f : confidence;
+    touch(c, c->now_ms);
+    place_source(c, s);
+}
+
+void wwv_consensus_add_symbol(wwv_consensus_t *c, int source, const bcd_symbol_event_t *event) {
+    consensus_source_t *s = get_source(c, source);
+    if (!s || !event || event->second < 0 || event->second > 59) return;
+
+    double t = event->timestamp_ms + s->offset_ms;
+    touch(c, t);
+    c->symbols++;
+
+    float w = source_weight(s);
+    float ll[3];
+    memcpy(ll, event->log_likelihood, sizeof(ll));
+    bool informed = ll[0] != 0.0f || ll[1] != 0.0f || ll[2] != 0.0f;
+    if (!informed && event->symbol >= BCD_CORR_SYM_ZERO && event->symbol <= BCD_CORR_SYM_MARKER) {
+        /* Hard decision only (wire records): the others trail by its confidence */
+        for (int k = 0; k < 3; k++) {
+            ll[k] = (k == (int)event->symbol) ? 0.0f
+                                              : -WWV_CONSENSUS_SYMBOL_NATS * event->confidence;
+        }
+        informed = event->confidence > 0.0f;
+    }
+    if (w <= 0.0f || !informed || c->anchored == 0) {
+        c->symbols_rejected++;
+        return;
+    }
+
+    /* The source's own second must put it on a minute the cluster agrees on */
+    double phase = cluster_phase(c, NULL, NULL, NULL);
+    double start = t - (event->second * 1000.0 + 500.0);
+    int64_t key = (int64_t)floor((start - phase) / MINUTE_MS + 0.5);
+    if (fabs(start - (key * MINUTE_MS + phase)) > WWV_CONSENSUS_SYMBOL_SLOP_MS) {
+        c->symbols_rejected++;
+        return;
+    }
+
+    bcd_vote_t *v = vote_for(c, key, phase);
+    if (!v) {
+        c->symbols_rejected++;
+        return;
+    }
+    for (int k = 0; k < 3; k++) v->ll[event->second][k] += w * ll[k];
+    v->weight[event->second] += w;
+}
+
+bool wwv_consensus_ingest_datagram(wwv_consensus_t *c, int source,
+                                   const void *datagram, size_t length) {
+    if (!c) return false;
+
+    telem_wire_frame_header_t header;
+    if (!telem_wire_parse_header(datagram, length, &header)) {
+        c->bad_datagrams++;
+        return false;
+    }
+    c->datagrams++;
+
+    size_t offset = sizeof(header);
+    telem_wire_record_header_t rec;
+    const uint8_t *payload;
+    while (telem_wire_next_record(datagram, length, &offset, &rec, &payload)) {
+        double stream_ms = rec.sample_us / 1000.0;
+
+        switch (rec.type) {
+            case TELEM_REC_SYNC: {
+                telem_rec_sync_t sync;
+                if (rec.length < sizeof(sync)) break;
+                memcpy(&sync, payload, sizeof(sync));
+                wwv_consensus_add_anchor(c, source, rec.sample_us ? stream_ms : 0.0,
+                                         (sync_state_t)sync.state);
+                break;
+            }
+            case TELEM_REC_SYNC_STATE: {
+                telem_rec_sync_state_t st;
+                if (rec.length < sizeof(st)) break;
+                memcpy(&st, payload, sizeof(st));
+                wwv_consensus_add_state(c, source, (sync_state_t)st.new_state, st.confidence);
+                break;
+            }
+            case TELEM_REC_BCD_SYMBOL: {
+                telem_rec_bcd_symbol_t sym;
+                if (rec.length < sizeof(sym)) break;
+                memcpy(&sym, payload, sizeof(sym));
+                bcd_symbol_event_t event = {
+                    .symbol = (bcd_corr_symbol_t)sym.symbol,
+                    .timestamp_ms = stream_ms,
+                    .duration_ms = sym.duration_ms,
+                    .confidence = sym.confidence,
+                    .source = "WIRE",
+                    .second = sym.second
+                };
+                wwv_consensus_add_symbol(c, source, &event);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return true;
+}
+
+bool wwv_consensus_get_solution(const wwv_consensus_t *c, wwv_consensus_solution_t *out) {
+    if (!c || !out) return false;
+    return fill_solution(c, out);
+}
+
+void wwv_consensus_reset(wwv_consensus_t *c) {
+    if (!c) return;
+    for (int i = 0; i < c->source_count; i++) {
+        c->sources[i].has_anchor = false;
+        c->sources[i].anchored = false;
+    }
+    memset(c->bins, 0, sizeof(c->bins));
+    c->best_bin = 0;
+    c->best_score = 0.0;
+    c->total_weight = 0.0;
+    c->anchored = 0;
+    c->votes[0].minute = NO_MINUTE;
+    c->votes[1].minute = NO_MINUTE;
+    bcd_time_solver_reset(c->solver);
+}
+
+void wwv_consensus_print_stats(const wwv_consensus_t *c) {
+    if (!c) return;
+
+    wwv_consensus_solution_t s;
+    bool ok = fill_solution(c, &s);
+
+    printf("\n=== CONSENSUS STATS ===\n");
+    printf("Datagrams: %llu (bad %llu)  Records: %llu  Anchors: %llu  Retired: %llu\n",
+           (unsigned long long)c->datagrams, (unsigned long long)c->bad_datagrams,
+           (unsigned long long)c->records, (unsigned long long)c->anchors,
+           (unsigned long long)c->retired);
+    printf("Symbols: %llu (rejected %llu)  Minutes voted: %llu  Rescans: %llu\n",
+           (unsigned long long)c->symbols, (unsigned long long)c->symbols_rejected,
+           (unsigned long long)c->minutes_voted, (unsigned long long)c->rescans);
+    printf("Anchor: %s  %d/%d sources  weight %.2f/%.2f  spread %.1f ms\n",
+           ok ? "AGREED" : "none", s.agree_sources, s.anchored_sources,
+           s.agree_weight, s.total_weight, s.spread_ms);
+    for (int i = 0; i < c->source_count; i++) {
+        const consensus_source_t *src = &c->sources[i];
+        printf("  %-16s %-10s w=%.2f q=%.2f%s\n", src->name, sync_state_name(src->state),
+               src->anchored ? src->weight : 0.0f, src->quality,
+               src->anchored ? "" : " (no anchor)");
+    }
+    if (s.has_time) {
+        printf("Time: day %03d %02d:%02d UTC year %02d (frames=%d margin=%.1f)\n",
+               s.time.day, s.time.hour, s.time.minute, s.time.year,
+               s.time.frames_used, s.time.margin);
+    }
+    printf("=======================\n");
+}
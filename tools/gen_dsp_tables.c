@@ -0,0 +1,103 @@
+/**
+ * @file gen_dsp_tables.c
+ * @brief Build-time generator for the baked window / template tables
+ *
+ * Evaluates the dsp_tables.h coefficient expressions for the standard
+ * configurations and writes them as hex-float static const arrays, so the
+ * library's tables are exactly the floats the runtime would have computed.
+ * Run by the build (WWV_BAKED_TABLES); not installed.
+ *
+ * Usage: gen_dsp_tables OUTPUT.c
+ */
+
+#include "core/dsp_tables.h"
+#include "bcd_freq_detector.h"
+#include "bcd_time_detector.h"
+#include "marker_detector.h"
+#include "tick_detector.h"
+#include "tone_tracker.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Every Hann size a detector, tracker or Goertzel bank acquires */
+static const int HANN_SIZES[] = {
+    TICK_FFT_SIZE,                  /* also MARKER_FFT_SIZE, BCD_TIME_FFT_SIZE */
+    TONE_ZOOM_FFT_SIZE,
+    BCD_FREQ_FFT_SIZE,
+    TONE_FFT_SIZE
+};
+#define HANN_COUNT  ((int)(sizeof(HANN_SIZES) / sizeof(HANN_SIZES[0])))
+
+_Static_assert(MARKER_FFT_SIZE == TICK_FFT_SIZE && BCD_TIME_FFT_SIZE == TICK_FFT_SIZE,
+               "50 kHz FFT sizes diverged; add them to HANN_SIZES");
+
+static const int TICK_TEMPLATE_HZ[] = { TICK_TARGET_FREQ_HZ, TICK_WWVH_FREQ_HZ };
+#define TICK_TEMPLATE_COUNT ((int)(sizeof(TICK_TEMPLATE_HZ) / sizeof(TICK_TEMPLATE_HZ[0])))
+
+#define TICK_TAPS   DSP_TEMPLATE_TAPS(TICK_TEMPLATE_SAMPLES)
+#define TICK_PAD    (TICK_TAPS - TICK_TEMPLATE_SAMPLES)
+
+static void write_array(FILE *out, const char *name, const float *v, int n) {
+    fprintf(out, "static const _Alignas(DSP_TABLES_ALIGN) float %s[%d] = {\n", name, n);
+    for (int k = 0; k < n; k++) {
+        fprintf(out, "%s%af,%s", (k % 4) ? " " : "    ", v[k], (k % 4 == 3 || k == n - 1) ? "\n" : "");
+    }
+    fprintf(out, "};\n\n");
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s OUTPUT.c\n", argv[0]);
+        return 2;
+    }
+    FILE *out = fopen(argv[1], "w");
+    if (!out) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    fprintf(out, "/* Generated by tools/gen_dsp_tables.c - do not edit */\n\n");
+    fprintf(out, "#include \"core/dsp_tables.h\"\n\n");
+
+    static float taps[TONE_FFT_SIZE];
+    static float taps_q[TICK_TAPS];
+    char name[64];
+
+    for (int h = 0; h < HANN_COUNT; h++) {
+        int size = HANN_SIZES[h];
+        for (int i = 0; i < size; i++) taps[i] = dsp_hann_coeff(i, size);
+        snprintf(name, sizeof(name), "hann_%d", size);
+        write_array(out, name, taps, size);
+    }
+
+    for (int t = 0; t < TICK_TEMPLATE_COUNT; t++) {
+        for (int i = 0; i < TICK_TAPS; i++) taps[i] = taps_q[i] = 0.0f;
+        for (int i = 0; i < TICK_TEMPLATE_SAMPLES; i++) {
+            dsp_tone_template_coeff(i, TICK_TEMPLATE_SAMPLES, TICK_TEMPLATE_HZ[t], TICK_SAMPLE_RATE,
+                                    &taps[TICK_PAD + i], &taps_q[TICK_PAD + i]);
+        }
+        snprintf(name, sizeof(name), "tick_%d_i", TICK_TEMPLATE_HZ[t]);
+        write_array(out, name, taps, TICK_TAPS);
+        snprintf(name, sizeof(name), "tick_%d_q", TICK_TEMPLATE_HZ[t]);
+        write_array(out, name, taps_q, TICK_TAPS);
+    }
+
+    fprintf(out, "const dsp_baked_window_t dsp_baked_hann[] = {\n");
+    for (int h = 0; h < HANN_COUNT; h++) {
+        fprintf(out, "    { %d, hann_%d },\n", HANN_SIZES[h], HANN_SIZES[h]);
+    }
+    fprintf(out, "};\nconst int dsp_baked_hann_count = %d;\n\n", HANN_COUNT);
+
+    fprintf(out, "const dsp_baked_template_t dsp_baked_tick_template[] = {\n");
+    for (int t = 0; t < TICK_TEMPLATE_COUNT; t++) {
+        fprintf(out, "    { %d, tick_%d_i, tick_%d_q },\n",
+                TICK_TEMPLATE_HZ[t], TICK_TEMPLATE_HZ[t], TICK_TEMPLATE_HZ[t]);
+    }
+    fprintf(out, "};\nconst int dsp_baked_tick_template_count = %d;\n", TICK_TEMPLATE_COUNT);
+
+    if (fclose(out) != 0) {
+        perror(argv[1]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file wwv_logcat.c
+ * @brief Convert binary detector logs back to CSV
+ *
+ * Reads the .wlog files a manager writes with wwv_csv_log_config_t.format
+ * BINARY and prints the CSV the text format would have written. Several
+ * files (the segments of a rotated log, in order) become one CSV with the
+ * first file's header lines.
+ */
+
+#include "wwv_csv_log.h"
+#include <stdio.h>
+#include <string.h>
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [options] LOG.wlog [LOG.wlog ...]\n"
+            "  -o FILE           CSV output (default stdout)\n"
+            "  --all-headers     Repeat each file's header lines\n",
+            argv0);
+}
+
+int main(int argc, char **argv) {
+    const char *out_path = NULL;
+    bool all_headers = false;
+    int first = 0;
+
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "-o") == 0 && a + 1 < argc) {
+            out_path = argv[++a];
+        } else if (strcmp(argv[a], "--all-headers") == 0) {
+            all_headers = true;
+        } else if (argv[a][0] == '-') {
+            usage(argv[0]);
+            return 2;
+        } else {
+            first = a;
+            break;
+        }
+    }
+    if (first == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    FILE *out = out_path ? fopen(out_path, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "[LOGCAT] Cannot write %s\n", out_path);
+        return 1;
+    }
+
+    int status = 0;
+    for (int a = first; a < argc; a++) {
+        if (!wwv_csv_log_convert(argv[a], out, all_headers || a == first)) {
+            fprintf(stderr, "[LOGCAT] %s: not a binary log, or damaged\n", argv[a]);
+            status = 1;
+        }
+    }
+
+    if (out != stdout) fclose(out);
+    return status;
+}
@@ -0,0 +1,257 @@
+/**
+ * @file wwv_sweep.c
+ * @brief Sweep detector tunables over one recording
+ *
+ * Builds parameter sets from --param ranges (cartesian product) and/or
+ * explicit --set lists, runs them all through wwv_sweep in one pass over
+ * the recording and writes one CSV row per set: detection rates, false
+ * event rates and lock time. Names are the waterfall.ini keys (--list).
+ */
+
+#include "wwv_sweep.h"
+#include "wwv_iq_file.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SWEEP_MAX_AXIS_VALUES   64
+#define SWEEP_MAX_EXPLICIT      64
+
+typedef struct {
+    const char *name;
+    int count;
+    float values[SWEEP_MAX_AXIS_VALUES];
+} sweep_axis_t;
+
+typedef struct {
+    const char *path;
+    wwv_iq_raw_params_t raw;
+    bool have_raw;
+    wwv_sweep_config_t sweep;
+    sweep_axis_t axes[WWV_SWEEP_MAX_PARAMS];
+    int axis_count;
+    wwv_sweep_set_t explicit_sets[SWEEP_MAX_EXPLICIT];
+    int explicit_count;
+    const char *csv_path;
+} sweep_options_t;
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [options] RECORDING\n"
+            "  --param NAME=LO:HI:STEP   Sweep axis (also NAME=V1,V2,...); axes multiply\n"
+            "  --set NAME=V[,NAME=V...]  One explicit parameter set (repeatable)\n"
+            "  --list                    Print tunable names and exit\n"
+            "  --format F                Raw files: ci16 | cf32\n"
+            "  --rate HZ                 Raw files: 2000000 | 50000\n"
+            "  --threads N               Worker threads, 0 = one per core (default 0)\n"
+            "  --start SEC               Offset into the recording (default 0)\n"
+            "  --duration SEC            Span to sweep, 0 = to end (default 0)\n"
+            "  --tick-window MS          Tick hit window (default 20)\n"
+            "  --marker-window MS        Marker hit window (default 250)\n"
+            "  --csv FILE                Results, - for stdout (default sweep_results.csv)\n",
+            argv0);
+}
+
+/* "NAME=LO:HI:STEP" or "NAME=V1,V2,..." (NAME points into arg) */
+static bool parse_axis(char *arg, sweep_axis_t *axis) {
+    char *eq = strchr(arg, '=');
+    if (!eq) return false;
+    *eq = '\0';
+    axis->name = arg;
+    axis->count = 0;
+
+    char *spec = eq + 1;
+    if (strchr(spec, ':')) {
+        float lo, hi, step;
+        if (sscanf(spec, "%f:%f:%f", &lo, &hi, &step) != 3 || step <= 0 || hi < lo) return false;
+        for (int k = 0; axis->count < SWEEP_MAX_AXIS_VALUES; k++) {
+            float v = lo + k * step;
+            if (v > hi + step * 1e-3f) break;
+            axis->values[axis->count++] = v;
+        }
+    } else {
+        for (char *tok = strtok(spec, ","); tok && axis->count < SWEEP_MAX_AXIS_VALUES;
+             tok = strtok(NULL, ",")) {
+            axis->values[axis->count++] = (float)atof(tok);
+        }
+    }
+    return axis->count > 0;
+}
+
+/* "NAME=V,NAME=V" */
+static bool parse_set(char *arg, wwv_sweep_set_t *set) {
+    set->param_count = 0;
+    for (char *tok = strtok(arg, ","); tok; tok = strtok(NULL, ",")) {
+        char *eq = strchr(tok, '=');
+        if (!eq || set->param_count == WWV_SWEEP_MAX_PARAMS) return false;
+        *eq = '\0';
+        set->params[set->param_count].name = tok;
+        set->params[set->param_count].value = (float)atof(eq + 1);
+        set->param_count++;
+    }
+    return set->param_count > 0;
+}
+
+static bool parse_options(int argc, char **argv, sweep_options_t *opt) {
+    wwv_sweep_config_t sweep = WWV_SWEEP_CONFIG_DEFAULT;
+    memset(opt, 0, sizeof(*opt));
+    opt->sweep = sweep;
+    opt->raw.format = WWV_IQ_CI16;
+    opt->csv_path = "sweep_results.csv";
+
+    for (int a = 1; a < argc; a++) {
+        char *arg = argv[a];
+        char *val = (a + 1 < argc) ? argv[a + 1] : NULL;
+
+        if (strcmp(arg, "--list") == 0) {
+            for (int p = 0; wwv_detector_manager_param_name(p); p++) {
+                printf("%s\n", wwv_detector_manager_param_name(p));
+            }
+            exit(0);
+        }
+        if (arg[0] != '-') {
+            if (opt->path) {
+                usage(argv[0]);
+                return false;
+            }
+            opt->path = arg;
+            continue;
+        }
+        if (!val) {
+            usage(argv[0]);
+            return false;
+        }
+
+        bool good = true;
+        if (strcmp(arg, "--param") == 0) {
+            good = opt->axis_count < WWV_SWEEP_MAX_PARAMS &&
+                   parse_axis(val, &opt->axes[opt->axis_count++]);
+        }
+        else if (strcmp(arg, "--set") == 0) {
+            good = opt->explicit_count < SWEEP_MAX_EXPLICIT &&
+                   parse_set(val, &opt->explicit_sets[opt->explicit_count++]);
+        }
+        else if (strcmp(arg, "--format") == 0) {
+            opt->raw.format = (strcmp(val, "cf32") == 0) ? WWV_IQ_CF32 : WWV_IQ_CI16;
+            opt->have_raw = true;
+        }
+        else if (strcmp(arg, "--rate") == 0) {
+            opt->raw.sample_rate = (uint32_t)strtoul(val, NULL, 10);
+            opt->have_raw = true;
+        }
+        else if (strcmp(arg, "--threads") == 0) opt->sweep.worker_threads = atoi(val);
+        else if (strcmp(arg, "--start") == 0) opt->sweep.start_sec = atof(val);
+        else if (strcmp(arg, "--duration") == 0) opt->sweep.duration_sec = atof(val);
+        else if (strcmp(arg, "--tick-window") == 0) opt->sweep.tick_window_ms = (float)atof(val);
+        else if (strcmp(arg, "--marker-window") == 0) opt->sweep.marker_window_ms = (float)atof(val);
+        else if (strcmp(arg, "--csv") == 0) opt->csv_path = val;
+        else good = false;
+
+        if (!good) {
+            usage(argv[0]);
+            return false;
+        }
+        a++;
+    }
+
+    if (!opt->path || opt->sweep.worker_threads < 0) {
+        usage(argv[0]);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Cartesian product of the axes, then the explicit sets
+ * @return Set count, or -1 past WWV_SWEEP_MAX_SETS
+ */
+static int build_sets(const sweep_options_t *opt, wwv_sweep_set_t *sets) {
+    int grid = 1;
+    for (int a = 0; a < opt->axis_count; a++) {
+        grid *= opt->axes[a].count;
+        if (grid > WWV_SWEEP_MAX_SETS) return -1;
+    }
+    if (opt->axis_count == 0 && opt->explicit_count > 0) grid = 0;
+    if (grid + opt->explicit_count > WWV_SWEEP_MAX_SETS) return -1;
+
+    for (int s = 0; s < grid; s++) {
+        int rest = s;
+        sets[s].param_count = opt->axis_count;
+        for (int a = opt->axis_count - 1; a >= 0; a--) {
+            sets[s].params[a].name = opt->axes[a].name;
+            sets[s].params[a].value = opt->axes[a].values[rest % opt->axes[a].count];
+            rest /= opt->axes[a].count;
+        }
+    }
+    for (int e = 0; e < opt->explicit_count; e++) sets[grid + e] = opt->explicit_sets[e];
+    return grid + opt->explicit_count;
+}
+
+static void write_set_params(FILE *out, const wwv_sweep_set_t *set) {
+    if (set->param_count == 0) fprintf(out, "default");
+    for (int p = 0; p < set->param_count; p++) {
+        fprintf(out, "%s%s=%g", p ? ";" : "", set->params[p].name, set->params[p].value);
+    }
+}
+
+int main(int argc, char **argv) {
+    static sweep_options_t opt;
+    static wwv_sweep_set_t sets[WWV_SWEEP_MAX_SETS];
+    static wwv_sweep_result_t results[WWV_SWEEP_MAX_SETS];
+
+    if (!parse_options(argc, argv, &opt)) return 2;
+
+    int set_count = build_sets(&opt, sets);
+    if (set_count < 0) {
+        fprintf(stderr, "More than %d parameter sets\n", WWV_SWEEP_MAX_SETS);
+        return 2;
+    }
+
+    wwv_iq_file_t *file = wwv_iq_file_open(opt.path, opt.have_raw ? &opt.raw : NULL);
+    if (!file) return 1;
+
+    wwv_sweep_stats_t stats;
+    bool ok = wwv_sweep_run(file, &opt.sweep, sets, set_count, results, &stats);
+    wwv_iq_file_close(file);
+    if (!ok) return 1;
+
+    FILE *out = (strcmp(opt.csv_path, "-") == 0) ? stdout : fopen(opt.csv_path, "w");
+    if (!out) {
+        fprintf(stderr, "Cannot write %s\n", opt.csv_path);
+        return 1;
+    }
+    fprintf(out, "set,params,valid,ticks,tick_hits,tick_rate,false_ticks_per_min,"
+                 "markers,marker_hits,marker_rate,false_markers_per_hour,lock_sec\n");
+    for (int s = 0; s < set_count; s++) {
+        const wwv_sweep_result_t *r = &results[s];
+        fprintf(out, "%d,", s);
+        write_set_params(out, &sets[s]);
+        fprintf(out, ",%d,%d,%d,%.4f,%.3f,%d,%d,%.4f,%.3f,%.3f\n",
+                r->valid, r->ticks, r->tick_hits, r->tick_detection_rate, r->false_ticks_per_min,
+                r->markers, r->marker_hits, r->marker_detection_rate,
+                r->false_markers_per_hour, r->lock_sec);
+    }
+    if (out != stdout) fclose(out);
+
+    int best = -1;
+    for (int s = 0; s < set_count; s++) {
+        if (!results[s].valid) continue;
+        if (best < 0 || results[s].tick_detection_rate - results[s].false_ticks_per_min / 60.0f >
+                        results[best].tick_detection_rate - results[best].false_ticks_per_min / 60.0f) {
+            best = s;
+        }
+    }
+
+    fprintf(stderr,
+            "[SWEEP] %d sets over %.1f sec on %d workers: %.2f sec wall, front end %.2f sec\n"
+            "[SWEEP] epoch %.1f ms, marker phase %.0f ms, expecting %d ticks / %d markers per set\n",
+            stats.sets, stats.signal_sec, stats.workers, stats.wall_sec, stats.frontend_sec,
+            stats.tick_epoch_ms, stats.marker_epoch_ms, stats.expected_ticks, stats.expected_markers);
+    if (best >= 0) {
+        fprintf(stderr, "[SWEEP] best tick score: set %d (", best);
+        write_set_params(stderr, &sets[best]);
+        fprintf(stderr, ") rate %.3f, %.2f false/min\n",
+                results[best].tick_detection_rate, results[best].false_ticks_per_min);
+    }
+    return best >= 0 ? 0 : 1;
+}